@@ -91,6 +91,12 @@ void libDRAMPower::calcWindowEnergy(int64_t timestamp)
   clearCounters(timestamp);
 }
 
+void libDRAMPower::updateWindowCounters(int64_t timestamp)
+{
+  doCommand(MemCommand::NOP, 0, timestamp);
+  updateCounters(false, timestamp);
+}
+
 
 void libDRAMPower::clearState()
 {
@@ -65,6 +65,11 @@ class libDRAMPower {
 
   void calcWindowEnergy(int64_t timestamp);
 
+  // Evaluate the commands issued up to the timestamp into the counters of
+  // the current window, without calculating its energy. This keeps the
+  // command list short when the window spans a long time.
+  void updateWindowCounters(int64_t timestamp);
+
   const Data::MemoryPowerModel::Energy& getEnergy() const;
   const Data::MemoryPowerModel::Power& getPower() const;
 
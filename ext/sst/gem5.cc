@@ -263,6 +263,10 @@ gem5Component::clockTick(SST::Cycle_t currentCycle)
     // what to do in a SST's cycle
     gem5::GlobalSimLoopExitEvent *event = simulateGem5(currentCycle);
     clocksProcessed++;
+    // hand the requests batched during this quantum over to SST
+    for (auto &port : sstPorts) {
+        port->flushRequests();
+    }
     // gem5 exits due to reasons other than reaching simulation limit
     if (event != gem5::simulate_limit_event) {
         output.output("exiting: curTick()=%lu cause=`%s` code=%d\n",
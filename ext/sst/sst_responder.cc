@@ -55,6 +55,19 @@ SSTResponder::handleRecvTimingReq(gem5::PacketPtr pkt)
     return owner->handleTimingReq(request);
 }
 
+void
+SSTResponder::handleRecvTimingReqs(const std::vector<gem5::PacketPtr> &pkts)
+{
+    std::vector<SST::Interfaces::StandardMem::Request*> requests;
+    requests.reserve(pkts.size());
+    for (auto pkt : pkts) {
+        requests.push_back(Translator::gem5RequestToSSTRequest(
+            pkt, owner->sstRequestIdToPacketMap
+        ));
+    }
+    owner->handleTimingReqs(requests);
+}
+
 void
 SSTResponder::handleRecvRespRetry()
 {
@@ -96,6 +96,20 @@ SSTResponderSubComponent::handleTimingReq(
     return true;
 }
 
+void
+SSTResponderSubComponent::handleTimingReqs(
+    const std::vector<SST::Interfaces::StandardMem::Request*> &requests)
+{
+    for (auto request : requests)
+        memoryInterface->send(request);
+}
+
+void
+SSTResponderSubComponent::flushRequests()
+{
+    responseReceiver->flushRequests();
+}
+
 void
 SSTResponderSubComponent::init(unsigned phase)
 {
@@ -85,6 +85,9 @@ class SSTResponderSubComponent: public SST::SubComponent
     bool findCorrespondingSimObject(gem5::Root* gem5_root);
 
     bool handleTimingReq(SST::Interfaces::StandardMem::Request* request);
+    void handleTimingReqs(
+        const std::vector<SST::Interfaces::StandardMem::Request*> &requests);
+    void flushRequests();
     void handleRecvRespRetry();
     void handleRecvFunctional(gem5::PacketPtr pkt);
     void handleSwapReqResponse(SST::Interfaces::StandardMem::Request* request);
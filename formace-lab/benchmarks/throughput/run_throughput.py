@@ -0,0 +1,231 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Simulator-throughput regression harness.
+
+Runs each formace-lab workload under every requested CPU model and memory
+system, records host-side cost (wall seconds, simulated MIPS, events per
+host second and peak RSS) from gem5's own statistics, and optionally
+compares the numbers against a stored baseline. A run that is slower or
+uses more memory than the baseline by more than the tolerance fails with
+a non-zero exit status so it can gate changes to the hot paths.
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+BENCH = os.path.dirname(HERE)
+
+# (name, path relative to formace-lab/benchmarks, arguments)
+WORKLOADS = [
+    ("mm", "algo/mm.riscv", ""),
+    ("qsort", "algo/qsort.riscv", ""),
+    ("vvadd", "algo/vvadd.riscv", ""),
+    ("stream", "algo/stream.riscv", ""),
+    ("towers", "algo/towers.riscv", ""),
+    ("pointer_chase", "algo/pointer_chase.riscv", ""),
+    ("binary_search", "algo/binary_search.riscv", ""),
+    ("branch_corr", "synthetic/branch-patterns/branch_corr.riscv", ""),
+    ("branch_bias", "synthetic/branch-patterns/branch_bias.riscv", ""),
+    (
+        "cache_thrash",
+        "synthetic/replacement-policy/cache_thrash.riscv",
+        "",
+    ),
+]
+
+# Ruby requires a timing-mode CPU, so the atomic CPU is only run with the
+# classic memory system.
+UNSUPPORTED = {("atomic", "ruby")}
+
+STAT_RE = re.compile(r"^(\S+)\s+([-+0-9.eE]+|nan|inf)\b")
+QUEUE_EVENTS_RE = re.compile(r"^eventQueues\.queue\d+\.events$")
+
+
+def parse_stats(path):
+    """Return the first dump in a stats.txt file as a dict of floats."""
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            if line.startswith("---------- End"):
+                break
+            m = STAT_RE.match(line)
+            if m:
+                stats[m.group(1)] = float(m.group(2))
+    return stats
+
+
+def run_point(args, name, binary, wl_args, cpu, mem):
+    outdir = os.path.join(args.outdir, f"{name}-{cpu}-{mem}")
+    cmd = [
+        args.gem5,
+        "--outdir",
+        outdir,
+        os.path.join(HERE, "se_throughput.py"),
+        binary,
+        "--cpu",
+        cpu,
+        "--mem",
+        mem,
+    ]
+    if wl_args:
+        cmd += ["--args", wl_args]
+    if args.max_ticks is not None:
+        cmd += ["--max-ticks", str(args.max_ticks)]
+
+    # gem5's stderr goes to a file rather than a pipe so that a chatty run
+    # cannot block on a full pipe while we wait for it.
+    os.makedirs(outdir, exist_ok=True)
+    log = os.path.join(outdir, "simerr.txt")
+    start = time.monotonic()
+    with open(log, "w") as err:
+        proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=err)
+        _, status, rusage = os.wait4(proc.pid, 0)
+    wall = time.monotonic() - start
+    code = os.waitstatus_to_exitcode(status)
+    if code != 0:
+        raise RuntimeError(
+            f"{name} on {cpu}/{mem} exited with {code}, see {log}"
+        )
+
+    stats = parse_stats(os.path.join(outdir, "stats.txt"))
+    host_seconds = stats.get("hostSeconds", wall) or wall
+    events = sum(v for k, v in stats.items() if QUEUE_EVENTS_RE.match(k))
+    return {
+        "host_seconds": host_seconds,
+        "wall_seconds": wall,
+        "sim_insts": stats.get("simInsts", 0.0),
+        "sim_mips": stats.get("simInsts", 0.0) / host_seconds / 1e6,
+        "events_per_sec": events / host_seconds,
+        # ru_maxrss is reported in KiB on Linux.
+        "peak_rss_mib": rusage.ru_maxrss / 1024.0,
+    }
+
+
+def best_of(results):
+    """Keep the fastest repetition; host noise only ever adds time."""
+    best = min(results, key=lambda r: r["host_seconds"])
+    best["peak_rss_mib"] = min(r["peak_rss_mib"] for r in results)
+    return best
+
+
+def compare(results, baseline, tolerance):
+    failures = []
+    for key, cur in sorted(results.items()):
+        ref = baseline.get(key)
+        if ref is None:
+            print(f"  {key}: no baseline entry")
+            continue
+        mips = cur["sim_mips"] / ref["sim_mips"] if ref["sim_mips"] else 1.0
+        rss = (
+            cur["peak_rss_mib"] / ref["peak_rss_mib"]
+            if ref["peak_rss_mib"]
+            else 1.0
+        )
+        flag = ""
+        if mips < 1.0 - tolerance:
+            flag += " SLOWER"
+        if rss > 1.0 + tolerance:
+            flag += " BIGGER"
+        if flag:
+            failures.append(key)
+        print(f"  {key}: MIPS x{mips:.3f}, RSS x{rss:.3f}{flag}")
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument(
+        "--gem5",
+        default=os.path.join(BENCH, "..", "..", "build", "RISCV", "gem5.opt"),
+    )
+    parser.add_argument(
+        "--cpus", nargs="+", default=["atomic", "timing", "minor", "o3"]
+    )
+    parser.add_argument("--mems", nargs="+", default=["classic", "ruby"])
+    parser.add_argument(
+        "--workloads",
+        nargs="+",
+        default=None,
+        help="Subset of workload names to run",
+    )
+    parser.add_argument("--repeat", type=int, default=1)
+    parser.add_argument("--max-ticks", type=int, default=None)
+    parser.add_argument("--outdir", default="m5out-throughput")
+    parser.add_argument("--output", default="results.json")
+    parser.add_argument("--baseline", default=None)
+    parser.add_argument("--tolerance", type=float, default=0.10)
+    args = parser.parse_args()
+
+    if not os.path.isfile(args.gem5):
+        sys.exit(f"gem5 binary not found: {args.gem5}")
+
+    results = {}
+    for name, rel, wl_args in WORKLOADS:
+        if args.workloads and name not in args.workloads:
+            continue
+        binary = os.path.join(BENCH, rel)
+        if not os.path.isfile(binary):
+            print(f"warning: skipping {name}, {binary} is not built")
+            continue
+        for cpu in args.cpus:
+            for mem in args.mems:
+                if (cpu, mem) in UNSUPPORTED:
+                    continue
+                key = f"{name}/{cpu}/{mem}"
+                runs = [
+                    run_point(args, name, binary, wl_args, cpu, mem)
+                    for _ in range(args.repeat)
+                ]
+                results[key] = best_of(runs)
+                r = results[key]
+                print(
+                    f"{key}: {r['host_seconds']:.2f}s "
+                    f"{r['sim_mips']:.3f} MIPS "
+                    f"{r['events_per_sec'] / 1e6:.3f} Mevents/s "
+                    f"{r['peak_rss_mib']:.1f} MiB"
+                )
+
+    with open(args.output, "w") as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        print(f"Comparing against {args.baseline}:")
+        failures = compare(results, baseline, args.tolerance)
+        if failures:
+            print(f"{len(failures)} regression(s) beyond {args.tolerance:.0%}")
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,90 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+gem5 configuration used by the throughput suite: one RISC-V core of the
+requested type running a statically linked binary in SE mode, behind
+either classic caches or the Ruby MI_example protocol that the default
+RISCV build includes.
+"""
+
+import argparse
+
+from gem5.components.boards.simple_board import SimpleBoard
+from gem5.components.cachehierarchies.classic.private_l1_private_l2_cache_hierarchy import (
+    PrivateL1PrivateL2CacheHierarchy,
+)
+from gem5.components.cachehierarchies.ruby.mi_example_cache_hierarchy import (
+    MIExampleCacheHierarchy,
+)
+from gem5.components.memory.single_channel import SingleChannelDDR3_1600
+from gem5.components.processors.cpu_types import CPUTypes
+from gem5.components.processors.simple_processor import SimpleProcessor
+from gem5.isas import ISA
+from gem5.resources.resource import BinaryResource
+from gem5.simulate.simulator import Simulator
+
+CPU_TYPES = {
+    "atomic": CPUTypes.ATOMIC,
+    "timing": CPUTypes.TIMING,
+    "minor": CPUTypes.MINOR,
+    "o3": CPUTypes.O3,
+}
+
+parser = argparse.ArgumentParser()
+parser.add_argument("binary", help="Workload to run")
+parser.add_argument("--cpu", choices=CPU_TYPES.keys(), default="atomic")
+parser.add_argument("--mem", choices=["classic", "ruby"], default="classic")
+parser.add_argument(
+    "--args", default="", help="Space separated workload arguments"
+)
+parser.add_argument(
+    "--max-ticks", type=int, default=None, help="Stop after this many ticks"
+)
+args = parser.parse_args()
+
+if args.mem == "classic":
+    cache_hierarchy = PrivateL1PrivateL2CacheHierarchy(
+        l1d_size="32KiB", l1i_size="32KiB", l2_size="256KiB"
+    )
+else:
+    cache_hierarchy = MIExampleCacheHierarchy(size="32KiB", assoc=8)
+
+board = SimpleBoard(
+    clk_freq="3GHz",
+    processor=SimpleProcessor(
+        cpu_type=CPU_TYPES[args.cpu], isa=ISA.RISCV, num_cores=1
+    ),
+    memory=SingleChannelDDR3_1600(size="2GiB"),
+    cache_hierarchy=cache_hierarchy,
+)
+board.set_se_binary_workload(
+    BinaryResource(local_path=args.binary),
+    arguments=args.args.split(),
+)
+
+simulator = Simulator(board=board)
+if args.max_ticks is None:
+    simulator.run()
+else:
+    simulator.run(max_ticks=args.max_ticks)
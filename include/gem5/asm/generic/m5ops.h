@@ -75,6 +75,7 @@
 
 #define M5OP_WORK_BEGIN         0x5a
 #define M5OP_WORK_END           0x5b
+#define M5OP_WORK_MARK          0x5c
 
 #define M5OP_DIST_TOGGLE_SYNC   0x62
 
@@ -107,6 +108,7 @@
     M5OP(m5_panic, M5OP_PANIC)                                  \
     M5OP(m5_work_begin, M5OP_WORK_BEGIN)                        \
     M5OP(m5_work_end, M5OP_WORK_END)                            \
+    M5OP(m5_work_mark, M5OP_WORK_MARK)                          \
     M5OP(m5_dist_toggle_sync, M5OP_DIST_TOGGLE_SYNC)            \
     M5OP(m5_workload, M5OP_WORKLOAD)                            \
     M5OP(m5_hypercall, M5OP_HYPERCALL)                          \
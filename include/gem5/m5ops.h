@@ -66,6 +66,14 @@ void m5_load_symbol();
 void m5_panic(void);
 void m5_work_begin(uint64_t workid, uint64_t threadid);
 void m5_work_end(uint64_t workid, uint64_t threadid);
+/*
+ * Record the current tick and instruction count with a mark id, without
+ * any other work in the simulator. The marks are written to
+ * <system>.work_marks.csv, and util/work_marks.py accounts the time and
+ * instructions between one mark and the next on a CPU to the first mark's
+ * id.
+ */
+void m5_work_mark(uint64_t markid);
 void m5_hypercall(uint64_t hypercall_id);
 /*
  * Send a very generic poke to the workload so it can do something. It's up to
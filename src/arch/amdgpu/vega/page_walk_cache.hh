@@ -108,10 +108,11 @@ class VegaPWCIndexingPolicy : public BaseIndexingPolicy
      */
     ~VegaPWCIndexingPolicy() {};
 
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr &addr) const
-                                                                     override
+    void getPossibleEntries(const Addr &addr,
+        std::vector<ReplaceableEntry*> &entries) const override
     {
-        return sets[extractSet(addr)];
+        const auto &set = sets[extractSet(addr)];
+        entries.assign(set.begin(), set.end());
     }
 
     Addr regenerateAddr(const Addr &tag,
@@ -137,7 +138,8 @@ class PageWalkCache : public AssociativeCache<PWCEntry>
     }
     PWCEntry* findEntry(const KeyType &key) const override
     {
-        for (auto candidate : indexingPolicy->getPossibleEntries(key)) {
+        indexingPolicy->getPossibleEntries(key, candidates);
+        for (auto candidate : candidates) {
         auto entry = static_cast<PWCEntry*>(candidate);
         if (entry->match(key))
             return entry;
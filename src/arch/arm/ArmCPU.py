@@ -28,6 +28,7 @@ from m5.objects.ArmInterrupts import ArmInterrupts
 from m5.objects.ArmISA import ArmISA
 from m5.objects.ArmMMU import ArmMMU
 from m5.objects.BaseAtomicSimpleCPU import BaseAtomicSimpleCPU
+from m5.objects.BaseIntervalSimpleCPU import BaseIntervalSimpleCPU
 from m5.objects.BaseMinorCPU import BaseMinorCPU
 from m5.objects.BaseNonCachingSimpleCPU import BaseNonCachingSimpleCPU
 from m5.objects.BaseO3Checker import BaseO3Checker
@@ -51,6 +52,10 @@ class ArmNonCachingSimpleCPU(BaseNonCachingSimpleCPU, ArmCPU):
     mmu = ArmMMU()
 
 
+class ArmIntervalSimpleCPU(BaseIntervalSimpleCPU, ArmCPU):
+    mmu = ArmMMU()
+
+
 class ArmTimingSimpleCPU(BaseTimingSimpleCPU, ArmCPU):
     mmu = ArmMMU()
 
@@ -90,6 +90,8 @@ class MMU : public BaseMMU
                 PageBytes, start, size, tc, this, mode, flags));
     }
 
+    Addr minPageBytes() const override { return PageBytes; }
+
     enum ArmFlags
     {
         AlignmentMask = 0x7,
@@ -213,11 +213,12 @@ class TLBSetAssociative : public TLBIndexingPolicy
       : TLBIndexingPolicy(p, p.num_entries, 0)
     {}
 
-    std::vector<ReplaceableEntry*>
-    getPossibleEntries(const KeyType &key) const override
+    void
+    getPossibleEntries(const KeyType &key,
+                       std::vector<ReplaceableEntry*> &entries) const override
     {
         Addr set_number = (key.va >> key.pageSize) & setMask;
-        return sets[set_number];
+        entries.assign(sets[set_number].begin(), sets[set_number].end());
     }
 
     Addr
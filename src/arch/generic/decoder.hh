@@ -115,6 +115,25 @@ class InstDecoder : public SimObject
      */
     bool needMoreBytes() const { return outOfBytes; }
 
+    /**
+     * Can an instruction decoded at one PC state be reused at another?
+     *
+     * CPU models that cache decoded instructions use this to check that
+     * decoding the same bytes at pc would give the same instruction and
+     * the same PC state back as it did at decoded. Decoders only return
+     * true if decode() depends on nothing but the instruction bytes and
+     * the PC state, and if nothing but the parts of the PC state decode()
+     * sets itself differ.
+     *
+     * @param pc PC state the instruction is about to be executed at.
+     * @param decoded PC state the instruction was decoded at.
+     */
+    virtual bool
+    canReuseDecode(const PCStateBase &pc, const PCStateBase &decoded) const
+    {
+        return false;
+    }
+
     /**
      * Feed data to the decoder.
      *
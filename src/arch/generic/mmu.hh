@@ -152,6 +152,9 @@ class BaseMMU : public SimObject
     virtual TranslationGenPtr translateFunctional(Addr start, Addr size,
             ThreadContext *tc, BaseMMU::Mode mode, Request::Flags flags) = 0;
 
+    /** Size of the smallest pages this MMU maps. */
+    virtual Addr minPageBytes() const = 0;
+
     virtual Fault
     finalizePhysical(const RequestPtr &req, ThreadContext *tc,
                      Mode mode) const;
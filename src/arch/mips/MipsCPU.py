@@ -24,6 +24,7 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 from m5.objects.BaseAtomicSimpleCPU import BaseAtomicSimpleCPU
+from m5.objects.BaseIntervalSimpleCPU import BaseIntervalSimpleCPU
 from m5.objects.BaseMinorCPU import BaseMinorCPU
 from m5.objects.BaseNonCachingSimpleCPU import BaseNonCachingSimpleCPU
 from m5.objects.BaseO3CPU import BaseO3CPU
@@ -49,6 +50,10 @@ class MipsNonCachingSimpleCPU(BaseNonCachingSimpleCPU, MipsCPU):
     mmu = MipsMMU()
 
 
+class MipsIntervalSimpleCPU(BaseIntervalSimpleCPU, MipsCPU):
+    mmu = MipsMMU()
+
+
 class MipsTimingSimpleCPU(BaseTimingSimpleCPU, MipsCPU):
     mmu = MipsMMU()
 
@@ -61,6 +61,8 @@ class MMU : public BaseMMU
         return TranslationGenPtr(new MMUTranslationGen(
                 PageBytes, start, size, tc, this, mode, flags));
     }
+
+    Addr minPageBytes() const override { return PageBytes; }
 };
 
 } // namespace MipsISA
@@ -24,6 +24,7 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 from m5.objects.BaseAtomicSimpleCPU import BaseAtomicSimpleCPU
+from m5.objects.BaseIntervalSimpleCPU import BaseIntervalSimpleCPU
 from m5.objects.BaseMinorCPU import BaseMinorCPU
 from m5.objects.BaseNonCachingSimpleCPU import BaseNonCachingSimpleCPU
 from m5.objects.BaseO3CPU import BaseO3CPU
@@ -49,6 +50,10 @@ class RiscvNonCachingSimpleCPU(BaseNonCachingSimpleCPU, RiscvCPU):
     mmu = RiscvMMU()
 
 
+class RiscvIntervalSimpleCPU(BaseIntervalSimpleCPU, RiscvCPU):
+    mmu = RiscvMMU()
+
+
 class RiscvTimingSimpleCPU(BaseTimingSimpleCPU, RiscvCPU):
     mmu = RiscvMMU()
 
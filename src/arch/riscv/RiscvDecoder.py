@@ -31,3 +31,10 @@ class RiscvDecoder(InstDecoder):
     type = "RiscvDecoder"
     cxx_class = "gem5::RiscvISA::Decoder"
     cxx_header = "arch/riscv/decoder.hh"
+
+    shared_decode_cache = Param.Bool(
+        False,
+        "Share decoded instructions with the other RISC-V decoders that "
+        "have the same vector configuration. This requires a single event "
+        "queue, as instruction reference counts are not atomic.",
+    )
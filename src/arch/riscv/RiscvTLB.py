@@ -44,6 +44,12 @@ class RiscvPagetableWalker(ClockedObject):
     num_squash_per_cycle = Param.Unsigned(
         4, "Number of outstanding walks that can be squashed per cycle"
     )
+    num_walkers = Param.Unsigned(
+        1, "Number of page table walks that can be in progress at once"
+    )
+    pwc_size = Param.Unsigned(
+        0, "Entries in the page-walk cache for non-leaf PTEs, 0 to disable"
+    )
     # Grab the pma_checker from the MMU
     pma_checker = Param.BasePMAChecker(Parent.any, "PMA Checker")
     pmp = Param.PMP(Parent.any, "PMP")
@@ -55,6 +61,17 @@ class RiscvTLB(BaseTLB):
     cxx_header = "arch/riscv/tlb.hh"
 
     size = Param.Int(64, "TLB size")
+    assoc = Param.Unsigned(0, "TLB associativity, 0 for fully associative")
+    hit_latency = Param.Latency("0ns", "Latency of a hit, in timing mode")
+
+    # An optional second level, probed on a miss in the first one
+    l2_size = Param.Int(0, "L2 TLB size, 0 for a single level TLB")
+    l2_assoc = Param.Unsigned(
+        0, "L2 TLB associativity, 0 for fully associative"
+    )
+    l2_hit_latency = Param.Latency(
+        "0ns", "Additional latency of a hit in the L2 TLB, in timing mode"
+    )
     walker = Param.RiscvPagetableWalker(
         RiscvPagetableWalker(), "page table walker"
     )
@@ -33,6 +33,7 @@
 #include "arch/riscv/types.hh"
 #include "base/bitfield.hh"
 #include "debug/Decode.hh"
+#include "sim/eventq.hh"
 
 namespace gem5
 {
@@ -46,9 +47,29 @@ Decoder::Decoder(const RiscvDecoderParams &p) : InstDecoder(p, &machInst)
     vlen = isa->getVecLenInBits();
     elen = isa->getVecElemLenInBits();
     _enableZcd = isa->enableZcd();
+    if (p.shared_decode_cache) {
+        // The vector instructions depend on the vector lengths, which are
+        // not part of the ExtMachInst.
+        sharedInstMap = &decode_cache::sharedInstMap<ExtMachInst>(
+            (uint64_t(vlen) << 32) | elen);
+    }
     reset();
 }
 
+void
+Decoder::init()
+{
+    InstDecoder::init();
+
+    // Shared instructions are reference counted without atomics, so
+    // sharing them between host threads would race. All the event queues
+    // exist by now, as every SimObject has been constructed.
+    fatal_if(sharedInstMap && numMainEventQueues > 1,
+             "%s: shared_decode_cache can't be used with %d event queues, "
+             "as the simulation runs on several host threads.",
+             name(), numMainEventQueues);
+}
+
 void Decoder::reset()
 {
     aligned = true;
@@ -120,6 +141,46 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
     DPRINTF(Decode, "Decoding instruction 0x%08x at address %#x\n",
             mach_inst.instBits, addr);
 
+    // Code that has not changed since it was last decoded at this PC
+    // hits without hashing the instruction
+    CachedInst &by_pc = pcCache[(addr >> 1) % pcCacheSize];
+    if (by_pc.si && by_pc.addr == addr && by_pc.emi == mach_inst)
+        return by_pc.si;
+
+    StaticInstPtr si;
+    if (compressed(mach_inst)) {
+        CachedInst &by_bits =
+            rvcCache[(mach_inst.instBits >> 2) % rvcCacheSize];
+        if (!by_bits.si || by_bits.emi != mach_inst) {
+            by_bits.emi = mach_inst;
+            by_bits.si = lookupInst(mach_inst);
+        }
+        si = by_bits.si;
+    } else {
+        si = lookupInst(mach_inst);
+    }
+
+    by_pc.addr = addr;
+    by_pc.emi = mach_inst;
+    by_pc.si = si;
+    return si;
+}
+
+StaticInstPtr
+Decoder::lookupInst(ExtMachInst mach_inst)
+{
+    if (sharedInstMap) {
+        if (const StaticInstPtr *shared = sharedInstMap->find(mach_inst))
+            return *shared;
+
+        StaticInstPtr si = decodeInst(mach_inst);
+        // Instructions are immutable once they are shared.
+        si->size(compressed(mach_inst) ? 2 : 4);
+        DPRINTF(Decode, "Decode: Decoded %s instruction: %#x\n",
+                si->getName(), mach_inst);
+        return sharedInstMap->insert(mach_inst, si);
+    }
+
     StaticInstPtr &si = instMap[mach_inst];
     if (!si)
         si = decodeInst(mach_inst);
@@ -171,5 +232,25 @@ Decoder::decode(PCStateBase &_next_pc)
     return decode(emi, next_pc.instAddr());
 }
 
+bool
+Decoder::canReuseDecode(const PCStateBase &_pc,
+                        const PCStateBase &_decoded) const
+{
+    auto &pc = _pc.as<PCState>();
+    auto &decoded = _decoded.as<PCState>();
+
+    // The second fetch of a table jump decodes a table entry, not code.
+    // The vector configuration is compared even when it isn't new, as
+    // decode() then uses its own copy, which is the one in the last PC
+    // state it returned.
+    return !pc.zcmtSecondFetch() && !decoded.zcmtSecondFetch() &&
+        pc.instAddr() == decoded.instAddr() &&
+        pc.upc() == decoded.upc() && pc.nupc() == decoded.nupc() &&
+        pc.rvType() == decoded.rvType() &&
+        pc.new_vconf() == decoded.new_vconf() &&
+        pc.vtype() == decoded.vtype() && pc.vl() == decoded.vl() &&
+        pc.zcmtPc() == decoded.zcmtPc();
+}
+
 } // namespace RiscvISA
 } // namespace gem5
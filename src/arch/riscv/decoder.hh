@@ -30,6 +30,8 @@
 #ifndef __ARCH_RISCV_DECODER_HH__
 #define __ARCH_RISCV_DECODER_HH__
 
+#include <array>
+
 #include "arch/generic/decode_cache.hh"
 #include "arch/generic/decoder.hh"
 #include "arch/riscv/insts/vector.hh"
@@ -52,9 +54,38 @@ class Decoder : public InstDecoder
 {
   private:
     decode_cache::InstMap<ExtMachInst> instMap;
+    /** Decode cache shared with other decoders, if enabled */
+    decode_cache::SharedInstMap<ExtMachInst> *sharedInstMap = nullptr;
     bool aligned;
     bool mid;
 
+    /**
+     * Entry of the direct-mapped caches in front of the decode cache. An
+     * entry only hits if the instruction, including its decoder state
+     * bits, is still the same, so these need no invalidation.
+     */
+    struct CachedInst
+    {
+        Addr addr = MaxAddr;
+        ExtMachInst emi = 0;
+        StaticInstPtr si;
+    };
+
+    /** Instructions last decoded at each PC, indexed by PC */
+    static constexpr size_t pcCacheSize = 4096;
+    std::array<CachedInst, pcCacheSize> pcCache;
+
+    /**
+     * Compressed instructions last decoded, indexed by their bits, so that
+     * common ones hit at any PC
+     */
+    static constexpr size_t rvcCacheSize = 1024;
+    std::array<CachedInst, rvcCacheSize> rvcCache;
+
+    /// Look up a machine instruction in the decode cache, decoding it
+    /// on a miss.
+    StaticInstPtr lookupInst(ExtMachInst mach_inst);
+
   protected:
     //The extended machine instruction being generated
     ExtMachInst emi;
@@ -79,6 +110,8 @@ class Decoder : public InstDecoder
   public:
     Decoder(const RiscvDecoderParams &p);
 
+    void init() override;
+
     void reset() override;
 
     inline bool compressed(ExtMachInst inst) { return inst.quadRant < 0x3; }
@@ -88,6 +121,9 @@ class Decoder : public InstDecoder
     void moreBytes(const PCStateBase &pc, Addr fetchPC) override;
 
     StaticInstPtr decode(PCStateBase &nextPC) override;
+
+    bool canReuseDecode(const PCStateBase &pc,
+                        const PCStateBase &decoded) const override;
 };
 
 } // namespace RiscvISA
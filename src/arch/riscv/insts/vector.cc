@@ -28,6 +28,7 @@
 
 #include "arch/riscv/insts/vector.hh"
 
+#include <cstring>
 #include <sstream>
 #include <string>
 
@@ -44,6 +45,54 @@ namespace gem5
 namespace RiscvISA
 {
 
+namespace
+{
+
+/**
+ * Copy count elements of type T, src_stride elements apart in the source
+ * and dst_stride elements apart in the destination. Each element is a
+ * single fixed size load and store, which the host compiler can turn
+ * into vector code, rather than a memcpy call of a run-time size.
+ */
+template <typename T>
+void
+copyStridedAs(uint8_t *dst, size_t dst_stride, const uint8_t *src,
+              size_t src_stride, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        T elem;
+        std::memcpy(&elem, src + i * src_stride * sizeof(T), sizeof(T));
+        std::memcpy(dst + i * dst_stride * sizeof(T), &elem, sizeof(T));
+    }
+}
+
+void
+copyStrided(uint8_t *dst, size_t dst_stride, const uint8_t *src,
+            size_t src_stride, size_t count, size_t elem_size)
+{
+    switch (elem_size) {
+    case 1:
+        copyStridedAs<uint8_t>(dst, dst_stride, src, src_stride, count);
+        break;
+    case 2:
+        copyStridedAs<uint16_t>(dst, dst_stride, src, src_stride, count);
+        break;
+    case 4:
+        copyStridedAs<uint32_t>(dst, dst_stride, src, src_stride, count);
+        break;
+    case 8:
+        copyStridedAs<uint64_t>(dst, dst_stride, src, src_stride, count);
+        break;
+    default:
+        for (size_t i = 0; i < count; i++) {
+            std::memcpy(dst + i * dst_stride * elem_size,
+                        src + i * src_stride * elem_size, elem_size);
+        }
+    }
+}
+
+} // anonymous namespace
+
 /**
  * This function translates the 3-bit value of vlmul bits to the corresponding
  * lmul value as specified in RVV 1.0 spec p11-12 chapter 3.4.2.
@@ -695,13 +744,29 @@ VlSegDeIntrlvMicroInst::execute(ExecContext* xc, trace::InstRecord* traceData) c
     }
 
     for (uint32_t i = 0; i < numSrcs; i++) {
+        const uint32_t end = (i + 1) * elems_per_vreg;
+        if (index >= end)
+            continue;
+
         xc->getRegOperand(this, i, &tmp_s);
         s = tmp_s.as<uint8_t>();
 
-        while (index < (i + 1) * elems_per_vreg)
+        if (machInst.vm) {
+            // Every numSrcs-th element of this source belongs to the
+            // field, so gather them all at once.
+            const uint32_t count = (end - index + numSrcs - 1) / numSrcs;
+            copyStrided(Vd + elem * sizeOfElement, 1,
+                        s + (index % elems_per_vreg) * sizeOfElement,
+                        numSrcs, count, sizeOfElement);
+            index += count * numSrcs;
+            elem += count;
+            continue;
+        }
+
+        while (index < end)
         {
             size_t ei = elem + micro_vlmax * microIdx;
-            if (machInst.vm || elem_mask(v0, ei)) {
+            if (elem_mask(v0, ei)) {
                 memcpy(Vd + (elem * sizeOfElement),
                        s + ((index % elems_per_vreg) * sizeOfElement),
                        sizeOfElement);
@@ -796,28 +861,26 @@ VsSegIntrlvMicroInst::execute(ExecContext* xc,
     auto Vd = tmp_d0.as<uint8_t>();
 
     vreg_t tmp_s;
-    auto s = tmp_s.as<uint8_t>();
-    xc->getRegOperand(this, 0, &tmp_s);
-    s = tmp_s.as<uint8_t>();
 
-    uint32_t indexVd = 0;
-    uint32_t srcReg = (field * elems_per_vreg) % numSrcs;
-    uint32_t indexs = (field * elems_per_vreg) / numSrcs;
-
-    while (indexVd < elems_per_vreg) {
-        xc->getRegOperand(this, srcReg, &tmp_s);
-        s = tmp_s.as<uint8_t>();
-
-        memcpy(Vd + (indexVd * sizeOfElement),
-                    s + (indexs * sizeOfElement),
-                    sizeOfElement);
-
-        indexVd++;
-        srcReg++;
-        if (srcReg >= numSrcs) {
-            srcReg = 0;
-            indexs++;
-        }
+    // Element indexVd of the destination is element first + indexVd of
+    // the interleaved sources, i.e. element (first + indexVd) / numSrcs
+    // of source (first + indexVd) % numSrcs. Read each source once and
+    // scatter its elements, numSrcs apart, into the destination.
+    const uint32_t first = field * elems_per_vreg;
+    for (uint32_t src_reg = 0; src_reg < numSrcs; src_reg++) {
+        const uint32_t start =
+            (src_reg + numSrcs - first % numSrcs) % numSrcs;
+        if (start >= elems_per_vreg)
+            continue;
+
+        xc->getRegOperand(this, src_reg, &tmp_s);
+        const uint8_t *s = tmp_s.as<uint8_t>();
+
+        const uint32_t count =
+            (elems_per_vreg - start + numSrcs - 1) / numSrcs;
+        copyStrided(Vd + start * sizeOfElement, numSrcs,
+                    s + ((first + start) / numSrcs) * sizeOfElement, 1,
+                    count, sizeOfElement);
     }
 
     if (traceData) {
@@ -40,6 +40,8 @@ Interrupts::Interrupts(const Params &p) : BaseInterrupts(p),
                                           ip(0),
                                           ie(0),
                                           hvip(0),
+                                          nmiMayBePending(true),
+                                          mayBePending(true),
                                           nmi_cause(p.nmi_cause)
 {
     for (uint8_t i = 0;
@@ -223,6 +225,7 @@ Interrupts::post(int int_num, int index)
     DPRINTF(Interrupt, "Interrupt %d:%d posted\n", int_num, index);
     if (int_num != INT_NMI) {
         ip[int_num] = true;
+        updateMayBePending();
     } else {
         postNMI();
     }
@@ -234,6 +237,7 @@ Interrupts::clear(int int_num, int index)
     DPRINTF(Interrupt, "Interrupt %d:%d cleared\n", int_num, index);
     if (int_num != INT_NMI) {
         ip[int_num] = false;
+        updateMayBePending();
     } else {
         clearNMI();
     }
@@ -276,6 +280,10 @@ Interrupts::unserialize(CheckpointIn &cp)
     hvip = hvip_ulong;
     UNSERIALIZE_SCALAR(ie_ulong);
     ie = ie_ulong;
+
+    // NMIP is restored with the misc regs, so find it on the next check
+    nmiMayBePending = true;
+    updateMayBePending();
 }
 
 Port &
@@ -66,6 +66,29 @@ class Interrupts : public BaseInterrupts
     std::bitset<NumInterruptTypes> hvip;
 
     std::vector<gem5::IntSinkPin<Interrupts>*> localInterruptPins;
+
+    /**
+     * Set if an NMI may have been posted. This is cleared once NMIP has
+     * been seen to be clear, since NMIP is part of the misc regs and may
+     * also be restored from a checkpoint.
+     */
+    mutable bool nmiMayBePending;
+
+    /**
+     * Set if an interrupt is both pending and enabled, or an NMI may be
+     * pending. Without one, no global mask can make an interrupt
+     * deliverable, so checkInterrupts() can return right away. This is
+     * recomputed whenever ip, ie or hvip change, or NMIs are posted or
+     * cleared.
+     */
+    mutable bool mayBePending;
+
+    void
+    updateMayBePending() const
+    {
+        mayBePending = nmiMayBePending || ((ip | hvip) & ie).any();
+    }
+
   protected:
     int nmi_cause;
 
@@ -79,7 +102,14 @@ class Interrupts : public BaseInterrupts
     bool
     checkNonMaskableInterrupt() const
     {
-        return tc->readMiscReg(MISCREG_NMIP) & tc->readMiscReg(MISCREG_NMIE);
+        if (!nmiMayBePending)
+            return false;
+        if (!tc->readMiscReg(MISCREG_NMIP)) {
+            nmiMayBePending = false;
+            updateMayBePending();
+            return false;
+        }
+        return tc->readMiscReg(MISCREG_NMIE);
     }
 
     bool checkInterrupt(int num) const {
@@ -88,6 +118,8 @@ class Interrupts : public BaseInterrupts
 
     bool checkInterrupts() const override
     {
+        if (!mayBePending)
+            return false;
         ISA* isa = static_cast<ISA*>(tc->getIsaPtr());
         if (isa->enableSmrnmi() && tc->readMiscReg(MISCREG_NMIE) == 0) {
             return false;
@@ -104,24 +136,38 @@ class Interrupts : public BaseInterrupts
 
     void clear(int int_num, int index) override;
 
-    void postNMI() { tc->setMiscReg(MISCREG_NMIP, 1); }
-    void clearNMI() { tc->setMiscReg(MISCREG_NMIP, 0); }
+    void
+    postNMI()
+    {
+        tc->setMiscReg(MISCREG_NMIP, 1);
+        nmiMayBePending = true;
+        updateMayBePending();
+    }
+
+    void
+    clearNMI()
+    {
+        tc->setMiscReg(MISCREG_NMIP, 0);
+        nmiMayBePending = false;
+        updateMayBePending();
+    }
 
     void clearAll() override;
 
 
     bool isWakeUp() const override
     {
-        return checkNonMaskableInterrupt() || ((ip | hvip) & ie).any();
+        return mayBePending &&
+            (checkNonMaskableInterrupt() || ((ip | hvip) & ie).any());
     }
 
     uint64_t readIP() const { return (uint64_t)ip.to_ulong() | readHVIP(); }
     uint64_t readIE() const { return (uint64_t)ie.to_ulong(); }
     uint64_t readHVIP() const { return (uint64_t)hvip.to_ulong(); }
 
-    void setIP(const uint64_t& val) { ip = val; }
-    void setIE(const uint64_t& val) { ie = val; }
-    void setHVIP(const uint64_t& val) { hvip = val; }
+    void setIP(const uint64_t& val) { ip = val; updateMayBePending(); }
+    void setIE(const uint64_t& val) { ie = val; updateMayBePending(); }
+    void setHVIP(const uint64_t& val) { hvip = val; updateMayBePending(); }
 
     void serialize(CheckpointOut &cp) const override;
 
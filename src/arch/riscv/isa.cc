@@ -499,8 +499,14 @@ ISA::readMiscReg(RegIndex idx)
       case MISCREG_CYCLEH:
             return bits<RegVal>(tc->getCpuPtr()->curCycle(), 63, 32);
       case MISCREG_TIME:
+            if (timeSource) {
+                return _rvType == RV32 ? bits<RegVal>(timeSource(), 31, 0) :
+                                         timeSource();
+            }
             return readMiscRegNoEffect(MISCREG_TIME);
       case MISCREG_TIMEH:
+            if (timeSource)
+                return bits<RegVal>(timeSource(), 63, 32);
             return readMiscRegNoEffect(MISCREG_TIMEH);
       case MISCREG_INSTRET:
             return static_cast<RegVal>(tc->getCpuPtr()->totalInsts());
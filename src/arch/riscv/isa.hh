@@ -35,6 +35,7 @@
 #ifndef __ARCH_RISCV_ISA_HH__
 #define __ARCH_RISCV_ISA_HH__
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -125,6 +126,13 @@ class ISA : public BaseISA
      */
     bool _enableSmrnmi;
 
+    /**
+     * Source of the time CSR. If set, time is read from it rather than
+     * from the misc reg file, so that a timer device need not keep the
+     * misc reg up to date.
+     */
+    std::function<uint64_t()> timeSource;
+
   public:
     using Params = RiscvISAParams;
 
@@ -210,6 +218,12 @@ class ISA : public BaseISA
 
     bool enableSmrnmi() { return _enableSmrnmi; }
 
+    void
+    setTimeSource(std::function<uint64_t()> source)
+    {
+        timeSource = std::move(source);
+    }
+
     virtual Addr getFaultHandlerAddr(
         RegIndex idx, uint64_t cause, bool intr) const;
 
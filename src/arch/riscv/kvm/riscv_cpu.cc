@@ -0,0 +1,249 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "arch/riscv/kvm/riscv_cpu.hh"
+
+#include <linux/kvm.h>
+
+#include "arch/riscv/interrupts.hh"
+#include "arch/riscv/isa.hh"
+#include "arch/riscv/regs/float.hh"
+#include "arch/riscv/regs/int.hh"
+#include "debug/Kvm.hh"
+#include "debug/KvmContext.hh"
+#include "debug/KvmInt.hh"
+#include "params/RiscvKvmCPU.hh"
+
+namespace gem5
+{
+
+using namespace RiscvISA;
+
+// KVM lays out the core registers like the user_regs_struct of the
+// kernel, i.e., the PC followed by x1-x31, followed by the mode.
+#define CORE_REG(name) \
+    (KVM_REG_RISCV | KVM_REG_SIZE_U64 | KVM_REG_RISCV_CORE | \
+     KVM_REG_RISCV_CORE_REG(name))
+
+#define CSR_REG(name) \
+    (KVM_REG_RISCV | KVM_REG_SIZE_U64 | KVM_REG_RISCV_CSR | \
+     KVM_REG_RISCV_CSR_REG(name))
+
+#define FP_D_REG(name, size) \
+    (KVM_REG_RISCV | KVM_REG_SIZE_##size | KVM_REG_RISCV_FP_D | \
+     KVM_REG_RISCV_FP_D_REG(name))
+
+constexpr static unsigned NUM_XREGS = int_reg::NumArchRegs;
+constexpr static unsigned NUM_FREGS = 32;
+
+// SBI error code returned for calls that gem5 does not implement
+constexpr static long SBI_ERR_NOT_SUPPORTED = -2;
+
+static inline uint64_t
+kvmXReg(const int num)
+{
+    // x0 is hardwired to zero, its slot is used by the PC.
+    assert(num > 0 && num < NUM_XREGS);
+    return CORE_REG(regs.pc) + num;
+}
+
+static inline uint64_t
+kvmFReg(const int num)
+{
+    assert(num < NUM_FREGS);
+    return FP_D_REG(f[0], U64) + num;
+}
+
+const std::vector<RiscvKvmCPU::CSRInfo> RiscvKvmCPU::csrMap = {
+    CSRInfo(CSR_REG(sstatus), MISCREG_STATUS,
+            SSTATUS_MASKS[RV64][enums::MSU], "sstatus"),
+    CSRInfo(CSR_REG(sie), MISCREG_IE, SI_MASK[enums::MSU], "sie"),
+    CSRInfo(CSR_REG(stvec), MISCREG_STVEC, mask(64), "stvec"),
+    CSRInfo(CSR_REG(sscratch), MISCREG_SSCRATCH, mask(64), "sscratch"),
+    CSRInfo(CSR_REG(sepc), MISCREG_SEPC, mask(64), "sepc"),
+    CSRInfo(CSR_REG(scause), MISCREG_SCAUSE, mask(64), "scause"),
+    CSRInfo(CSR_REG(stval), MISCREG_STVAL, mask(64), "stval"),
+    CSRInfo(CSR_REG(sip), MISCREG_IP, SI_MASK[enums::MSU], "sip"),
+    CSRInfo(CSR_REG(satp), MISCREG_SATP, mask(64), "satp"),
+    CSRInfo(CSR_REG(scounteren), MISCREG_SCOUNTEREN, mask(32),
+            "scounteren"),
+};
+
+RiscvKvmCPU::RiscvKvmCPU(const RiscvKvmCPUParams &params)
+    : BaseKvmCPU(params), extIrqAsserted(false)
+{
+}
+
+RiscvKvmCPU::~RiscvKvmCPU()
+{
+}
+
+void
+RiscvKvmCPU::dump() const
+{
+    inform("Integer registers:\n");
+    inform("  PC: %s\n", getAndFormatOneReg(CORE_REG(regs.pc)));
+    for (int i = 1; i < NUM_XREGS; ++i)
+        inform("  X%i: %s\n", i, getAndFormatOneReg(kvmXReg(i)));
+    inform("  mode: %s\n", getAndFormatOneReg(CORE_REG(mode)));
+
+    inform("Floating point registers:\n");
+    for (int i = 0; i < NUM_FREGS; ++i)
+        inform("  F%i: %s\n", i, getAndFormatOneReg(kvmFReg(i)));
+    inform("  fcsr: %s\n", getAndFormatOneReg(FP_D_REG(fcsr, U32)));
+
+    inform("Supervisor CSRs:\n");
+    for (const auto &ri : csrMap)
+        inform("  %s: %s\n", ri.name, getAndFormatOneReg(ri.kvm));
+}
+
+Tick
+RiscvKvmCPU::kvmRun(Tick ticks)
+{
+    auto interrupt = static_cast<RiscvISA::Interrupts *>(interrupts[0]);
+    // The guest only sees the supervisor external interrupt, targeting
+    // either context of the simulated interrupt controller raises it.
+    const bool sim_irq(interrupt->readIP() & (SEI_MASK | MEI_MASK));
+
+    if (extIrqAsserted != sim_irq) {
+        DPRINTF(KvmInt, "KVM: Update external IRQ state: %i\n", sim_irq);
+        struct kvm_interrupt kvm_int;
+        kvm_int.irq = sim_irq ? KVM_INTERRUPT_SET : KVM_INTERRUPT_UNSET;
+        kvmInterrupt(kvm_int);
+        extIrqAsserted = sim_irq;
+    }
+
+    return BaseKvmCPU::kvmRun(ticks);
+}
+
+Tick
+RiscvKvmCPU::handleKvmExit()
+{
+    if (getKvmRunState()->exit_reason != KVM_EXIT_RISCV_SBI)
+        return BaseKvmCPU::handleKvmExit();
+
+    assert(_status == RunningService);
+    _status = Running;
+    ++stats.numHypercalls;
+    return handleKvmExitSBI();
+}
+
+Tick
+RiscvKvmCPU::handleKvmExitSBI()
+{
+    auto &sbi = getKvmRunState()->riscv_sbi;
+    DPRINTF(Kvm, "handleKvmExitSBI (ext: %#x, func: %#x)\n",
+            sbi.extension_id, sbi.function_id);
+
+    // The host kernel implements all the extensions needed to boot,
+    // the calls left to user space are reported as unsupported.
+    warn_once("KVM: Unsupported SBI call (ext: %#x, func: %#x)\n",
+              sbi.extension_id, sbi.function_id);
+    sbi.ret[0] = SBI_ERR_NOT_SUPPORTED;
+    sbi.ret[1] = 0;
+
+    return 0;
+}
+
+void
+RiscvKvmCPU::updateKvmState()
+{
+    DPRINTF(KvmContext, "In updateKvmState():\n");
+
+    const RegVal prv(tc->readMiscReg(MISCREG_PRV));
+    panic_if(prv == PRV_M, "KVM: Can't virtualize machine mode.\n");
+    DPRINTF(KvmContext, "  mode := %i\n", prv);
+    setOneReg(CORE_REG(mode), static_cast<uint64_t>(prv));
+
+    for (const auto &ri : csrMap) {
+        const uint64_t value(tc->readMiscReg(ri.idx) & ri.mask);
+        DPRINTF(KvmContext, "  %s := 0x%x\n", ri.name, value);
+        setOneReg(ri.kvm, value);
+    }
+
+    for (int i = 1; i < NUM_XREGS; ++i) {
+        const uint64_t value = tc->getReg(intRegClass[i]);
+        DPRINTF(KvmContext, "  X%i := 0x%x\n", i, value);
+        setOneReg(kvmXReg(i), value);
+    }
+
+    for (int i = 0; i < NUM_FREGS; ++i) {
+        const uint64_t value = tc->getReg(floatRegClass[i]);
+        DPRINTF(KvmContext, "  F%i := 0x%x\n", i, value);
+        setOneReg(kvmFReg(i), value);
+    }
+
+    const uint32_t fcsr = tc->readMiscReg(MISCREG_FFLAGS) |
+        (tc->readMiscReg(MISCREG_FRM) << FRM_OFFSET);
+    DPRINTF(KvmContext, "  fcsr := 0x%x\n", fcsr);
+    setOneReg(FP_D_REG(fcsr, U32), fcsr);
+
+    setOneReg(CORE_REG(regs.pc), tc->pcState().instAddr());
+    DPRINTF(KvmContext, "  PC := 0x%x\n", tc->pcState().instAddr());
+}
+
+void
+RiscvKvmCPU::updateThreadContext()
+{
+    DPRINTF(KvmContext, "In updateThreadContext():\n");
+
+    const uint64_t mode(getOneRegU64(CORE_REG(mode)));
+    DPRINTF(KvmContext, "  mode := %i\n", mode);
+    tc->setMiscRegNoEffect(MISCREG_PRV, mode ? PRV_S : PRV_U);
+
+    // The supervisor CSRs are views of the machine level registers in
+    // gem5, so only update the bits that are visible to the guest.
+    for (const auto &ri : csrMap) {
+        const uint64_t value(getOneRegU64(ri.kvm));
+        DPRINTF(KvmContext, "  %s := 0x%x\n", ri.name, value);
+        const RegVal old(tc->readMiscRegNoEffect(ri.idx));
+        tc->setMiscRegNoEffect(ri.idx,
+                               (old & ~ri.mask) | (value & ri.mask));
+    }
+
+    for (int i = 1; i < NUM_XREGS; ++i) {
+        const uint64_t value(getOneRegU64(kvmXReg(i)));
+        DPRINTF(KvmContext, "  X%i := 0x%x\n", i, value);
+        tc->setReg(intRegClass[i], value);
+    }
+
+    for (int i = 0; i < NUM_FREGS; ++i) {
+        const uint64_t value(getOneRegU64(kvmFReg(i)));
+        DPRINTF(KvmContext, "  F%i := 0x%x\n", i, value);
+        tc->setReg(floatRegClass[i], value);
+    }
+
+    const uint32_t fcsr(getOneRegU32(FP_D_REG(fcsr, U32)));
+    DPRINTF(KvmContext, "  fcsr := 0x%x\n", fcsr);
+    tc->setMiscRegNoEffect(MISCREG_FFLAGS, fcsr & FFLAGS_MASK);
+    tc->setMiscRegNoEffect(MISCREG_FRM, (fcsr >> FRM_OFFSET) & FRM_MASK);
+
+    PCState pc(tc->pcState().as<PCState>());
+    pc.set(getOneRegU64(CORE_REG(regs.pc)));
+    DPRINTF(KvmContext, "  PC := 0x%x\n", pc.instAddr());
+    tc->pcState(pc);
+}
+
+} // namespace gem5
@@ -0,0 +1,117 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_RISCV_KVM_RISCV_CPU_HH__
+#define __ARCH_RISCV_KVM_RISCV_CPU_HH__
+
+#include <vector>
+
+#include "arch/riscv/pcstate.hh"
+#include "arch/riscv/regs/misc.hh"
+#include "cpu/kvm/base.hh"
+
+namespace gem5
+{
+
+struct RiscvKvmCPUParams;
+
+/**
+ * This is an implementation of a KVM-based RISC-V CPU for RV64 hosts
+ * with the H extension.
+ *
+ * The guest runs in the virtualized supervisor mode, so only the
+ * supervisor and user level state is exchanged with the simulated
+ * CPUs. The SBI is provided by the host kernel while the guest runs in
+ * KVM.
+ *
+ * Known limitations:
+ * <ul>
+ *
+ *   <li>Machine mode can not be virtualized. Switching to KVM while the
+ *       simulated CPU is in machine mode (e.g., while firmware runs) is
+ *       not supported.
+ *
+ *   <li>The timer is emulated by the host kernel through the SBI timer
+ *       extension and is not synchronized with the simulated CLINT.
+ *
+ *   <li>External interrupts from the simulated interrupt controller
+ *       are forwarded as a single supervisor external interrupt.
+ *       In-kernel AIA emulation is not supported.
+ *
+ * </ul>
+ */
+class RiscvKvmCPU : public BaseKvmCPU
+{
+  public:
+    RiscvKvmCPU(const RiscvKvmCPUParams &params);
+    virtual ~RiscvKvmCPU();
+
+    void dump() const override;
+
+  protected:
+    Tick kvmRun(Tick ticks) override;
+
+    Tick handleKvmExit() override;
+
+    void
+    stutterPC(PCStateBase &pc) const override
+    {
+        pc.as<RiscvISA::PCState>().npc(pc.instAddr());
+    }
+
+    void updateKvmState() override;
+    void updateThreadContext() override;
+
+    /** Handle an SBI call that the host kernel did not handle itself */
+    Tick handleKvmExitSBI();
+
+  protected:
+    /** Mapping between supervisor CSRs in gem5 and KVM */
+    struct CSRInfo
+    {
+        CSRInfo(uint64_t _kvm, RiscvISA::MiscRegIndex _idx, RegVal _mask,
+                const char *_name)
+            : kvm(_kvm), idx(_idx), mask(_mask), name(_name) {}
+
+        /** Register index in KVM */
+        uint64_t kvm;
+        /** Register index in gem5 */
+        RiscvISA::MiscRegIndex idx;
+        /** Bits of the gem5 register visible through the KVM register */
+        RegVal mask;
+        /** Name to use in debug dumps */
+        const char *name;
+    };
+
+    /** Mapping between gem5 misc registers and CSRs in kvm */
+    static const std::vector<RiscvKvmCPU::CSRInfo> csrMap;
+
+    /** Cached state of the external interrupt line */
+    bool extIrqAsserted;
+};
+
+} // namespace gem5
+
+#endif // __ARCH_RISCV_KVM_RISCV_CPU_HH__
@@ -85,6 +85,8 @@ class MMU : public BaseMMU
                 PageBytes, start, size, tc, this, mode, flags));
     }
 
+    Addr minPageBytes() const override { return PageBytes; }
+
     MemAccessInfo
     getMemAccessInfo(ThreadContext *tc, BaseMMU::Mode mode)
     {
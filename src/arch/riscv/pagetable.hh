@@ -33,7 +33,6 @@
 
 #include "base/bitunion.hh"
 #include "base/logging.hh"
-#include "base/trie.hh"
 #include "base/types.hh"
 #include "sim/serialize.hh"
 
@@ -88,9 +87,6 @@ EndBitUnion(PTESv39)
  */
 Addr getVPNFromVAddr(Addr vaddr, Addr mode);
 
-struct TlbEntry;
-typedef Trie<Addr, TlbEntry> TlbEntryTrie;
-
 struct TlbEntry : public Serializable
 {
     // The base of the physical page.
@@ -107,8 +103,6 @@ struct TlbEntry : public Serializable
 
     PTESv39 gpte;
 
-    TlbEntryTrie::Handle trieHandle;
-
     // A sequence number to keep track of LRU.
     uint64_t lruSeq;
 
@@ -73,13 +73,26 @@ Fault
 Walker::start(ThreadContext * _tc, BaseMMU::Translation *_translation,
     const RequestPtr &_req, BaseMMU::Mode _mode, TlbEntry* result_entry)
 {
-    // TODO: in timing mode, instead of blocking when there are other
-    // outstanding requests, see if this request can be coalesced with
-    // another one (i.e. either coalesce or start walk)
     WalkerState * newState = new WalkerState(this, _translation, _req);
     newState->initState(_tc, _mode, sys->isTimingMode());
     if (currStates.size()) {
         assert(newState->isTiming());
+
+        // A miss on a page that is already being walked waits for that
+        // walk and then retries in the TLB.
+        for (WalkerState *walk : currStates) {
+            if (walk->canMerge(*newState)) {
+                DPRINTF(PageTableWalker, "Merging walk for address %#x\n",
+                        _req->getVaddr());
+                walk->merged.push_back({_translation, _req, _tc, _mode});
+                pagewalkerstats.num_merged_walks++;
+                delete newState;
+                return NoFault;
+            }
+        }
+    }
+
+    if (currStates.size() && (numActive() >= numWalkers || hasPending())) {
         DPRINTF(PageTableWalker, "Walks in progress: %d\n", currStates.size());
         currStates.push_back(newState);
         return NoFault;
@@ -97,13 +110,114 @@ Walker::start(ThreadContext * _tc, BaseMMU::Translation *_translation,
         // In timing we must pop the state in the case of an early fault!
         if (fault != NoFault || !newState->isTiming())
         {
-            currStates.pop_front();
+            currStates.remove(newState);
             delete newState;
         }
         return fault;
     }
 }
 
+unsigned
+Walker::numActive() const
+{
+    unsigned active = 0;
+    for (WalkerState *walk : currStates) {
+        if (walk->wasStarted())
+            active++;
+    }
+    return active;
+}
+
+bool
+Walker::hasPending() const
+{
+    for (WalkerState *walk : currStates) {
+        if (!walk->wasStarted())
+            return true;
+    }
+    return false;
+}
+
+void
+Walker::replayMerged(WalkerState *state)
+{
+    std::vector<MergedTranslation> merged;
+    merged.swap(state->merged);
+    for (const auto &m : merged) {
+        if (m.translation->squashed()) {
+            m.translation->finish(
+                std::make_shared<UnimpFault>("Squashed Inst"),
+                m.req, m.tc, m.mode);
+        } else {
+            tlb->translateTiming(m.req, m.tc, m.translation, m.mode);
+        }
+    }
+}
+
+int
+Walker::pwcLookup(uint16_t asid, Addr root, Addr vaddr, PTESv39 &pte)
+{
+    if (pwc.empty())
+        return -1;
+
+    PwcEntry *hit = nullptr;
+    for (auto &e : pwc) {
+        if (e.valid && e.asid == asid && e.root == root &&
+            e.tag == pwcTag(vaddr, e.level) &&
+            (!hit || e.level < hit->level)) {
+            hit = &e;
+        }
+    }
+
+    if (!hit) {
+        pagewalkerstats.num_pwc_misses++;
+        return -1;
+    }
+    pagewalkerstats.num_pwc_hits++;
+    hit->lruSeq = ++pwcSeq;
+    pte = hit->pte;
+    return hit->level;
+}
+
+void
+Walker::pwcInsert(uint16_t asid, Addr root, Addr vaddr, int level,
+                  PTESv39 pte)
+{
+    if (pwc.empty())
+        return;
+
+    PwcEntry *victim = &pwc[0];
+    for (auto &e : pwc) {
+        if (e.valid && e.asid == asid && e.root == root &&
+            e.level == level && e.tag == pwcTag(vaddr, level)) {
+            victim = &e;
+            break;
+        }
+        if (!e.valid) {
+            victim = &e;
+        } else if (victim->valid && e.lruSeq < victim->lruSeq) {
+            victim = &e;
+        }
+    }
+
+    victim->valid = true;
+    victim->asid = asid;
+    victim->root = root;
+    victim->level = level;
+    victim->tag = pwcTag(vaddr, level);
+    victim->pte = pte;
+    victim->lruSeq = ++pwcSeq;
+}
+
+void
+Walker::flushPwc(uint16_t asid)
+{
+    for (auto &e : pwc) {
+        if (asid == 0 || e.asid == asid)
+            e.valid = false;
+    }
+}
+
 Fault
 Walker::startFunctional(ThreadContext * _tc, Addr &addr, unsigned &logBytes,
               BaseMMU::Mode _mode)
@@ -135,6 +249,7 @@ Walker::recvTimingResp(PacketPtr pkt)
                 break;
             }
         }
+        replayMerged(senderWalk);
         delete senderWalk;
         // Since we block requests when another is outstanding, we
         // need to check if there is a waiting request to be serviced
@@ -237,72 +352,62 @@ void
 Walker::startWalkWrapper()
 {
     unsigned num_squashed = 0;
-    WalkerState *currState = currStates.front();
-
-    // check if we get a tlb hit to skip the walk
-    Addr vaddr = Addr(sext<SV39_VADDR_BITS>(currState->req->getVaddr()));
-    Addr vpn = getVPNFromVAddr(vaddr, currState->satp.mode);
-    TlbEntry *e = tlb->lookup(vpn, currState->satp.asid, currState->mode,
-                              true);
-    Fault fault = NoFault;
-    if (e) {
-       fault = tlb->checkPermissions(currState->tc, currState->memaccess,
-                            e->vaddr, currState->mode, e->pte);
-    }
 
-    while ((num_squashed < numSquashable) && currState &&
-           (currState->translation->squashed() || (e && fault == NoFault))) {
-        currStates.pop_front();
-        num_squashed++;
-
-        DPRINTF(PageTableWalker, "Squashing table walk for address %#x\n",
-            currState->req->getVaddr());
-
-        // finish the translation which will delete the translation object
-        if (currState->translation->squashed()) {
-            currState->translation->finish(
-                std::make_shared<UnimpFault>("Squashed Inst"),
-                currState->req, currState->tc, currState->mode);
-        } else {
-            tlb->translateTiming(currState->req, currState->tc,
-                                 currState->translation, currState->mode);
+    auto iter = currStates.begin();
+    while (iter != currStates.end() && numActive() < numWalkers) {
+        WalkerState *currState = *iter;
+        if (currState->wasStarted()) {
+            iter++;
+            continue;
         }
 
-        // delete the current request if there are no inflight packets.
-        // if there is something in flight, delete when the packets are
-        // received and inflight is zero.
-        if (currState->numInflight() == 0) {
-            delete currState;
-        } else {
-            currState->squash();
+        // check if we get a tlb hit to skip the walk
+        Addr vaddr = Addr(sext<SV39_VADDR_BITS>(currState->req->getVaddr()));
+        Addr vpn = getVPNFromVAddr(vaddr, currState->satp.mode);
+        TlbEntry *e = tlb->lookup(vpn, currState->satp.asid, currState->mode,
+                                  true);
+        Fault fault = NoFault;
+        if (e) {
+           fault = tlb->checkPermissions(currState->tc, currState->memaccess,
+                                e->vaddr, currState->mode, e->pte);
         }
 
-        // check the next translation request, if it exists
-        if (currStates.size()) {
-            currState = currStates.front();
-            vaddr = Addr(sext<SV39_VADDR_BITS>(currState->req->getVaddr()));
-            Addr vpn = getVPNFromVAddr(vaddr, currState->satp.mode);
-            e = tlb->lookup(vpn, currState->satp.asid, currState->mode,
-                            true);
-            if (e) {
-                fault = tlb->checkPermissions(currState->tc,
-                    currState->memaccess, e->vaddr, currState->mode, e->pte);
+        if (currState->translation->squashed() || (e && fault == NoFault)) {
+            if (num_squashed == numSquashable) {
+                schedule(startWalkWrapperEvent, clockEdge(Cycles(1)));
+                return;
             }
-        } else {
-            currState = NULL;
-        }
-    }
-    if (currState && !currState->wasStarted()) {
-        if (!e || fault != NoFault) {
-            Fault timingFault = currState->walk();
-            if (timingFault != NoFault) {
-                currStates.pop_front();
-                delete currState;
-                currState = NULL;
+            iter = currStates.erase(iter);
+            num_squashed++;
+
+            DPRINTF(PageTableWalker, "Squashing table walk for address %#x\n",
+                currState->req->getVaddr());
+
+            // finish the translation which will delete the translation
+            // object
+            if (currState->translation->squashed()) {
+                currState->translation->finish(
+                    std::make_shared<UnimpFault>("Squashed Inst"),
+                    currState->req, currState->tc, currState->mode);
+            } else {
+                tlb->translateTiming(currState->req, currState->tc,
+                                     currState->translation, currState->mode);
             }
+            replayMerged(currState);
+
+            // The walk never started, so nothing can be in flight.
+            assert(currState->numInflight() == 0);
+            delete currState;
+            continue;
         }
-        else {
-            schedule(startWalkWrapperEvent, clockEdge(Cycles(1)));
+
+        Fault timingFault = currState->walk();
+        if (timingFault != NoFault) {
+            iter = currStates.erase(iter);
+            replayMerged(currState);
+            delete currState;
+        } else {
+            iter++;
         }
     }
 }
@@ -393,6 +498,7 @@ Walker::WalkerState::walk()
     Fault fault = NoFault;
     assert(!started);
     started = true;
+    startTick = curTick();
     state = Translate;
     nextState = Ready;
 
@@ -437,6 +543,20 @@ Walker::WalkerState::walkOneStage(Addr vaddr)
 
     Addr pte_addr = setupWalk(vaddr);
     level = SV39_LEVELS - 1;
+
+    // Skip the upper levels whose PTEs are in the page-walk cache.
+    // Functional walks always read the page table.
+    if (!functional) {
+        PTESv39 pte;
+        int pwc_level = walker->pwcLookup(satp.asid, satp.ppn, vaddr, pte);
+        if (pwc_level > 0) {
+            level = pwc_level - 1;
+            Addr shift = PageShift + SV39_LEVEL_BITS * level;
+            Addr idx = (vaddr >> shift) & mask(SV39_LEVEL_BITS);
+            pte_addr = (pte.ppn << PageShift) + (idx * sizeof(pte));
+        }
+    }
+
     // Create physical request for first_pte_addr
     // This is a host physical address
     // In two-stage this gets discarded?
@@ -818,6 +938,13 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
                 idx = (entry.vaddr >> shift) & mask(SV39_LEVEL_BITS);
                 nextRead = (pte.ppn << PageShift) + (idx * sizeof(pte));
                 nextState = Translate;
+
+                // Only first-stage walks read PTEs at host physical
+                // addresses that can be cached.
+                if (walkType == OneStage && !functional) {
+                    walker->pwcInsert(satp.asid, satp.ppn, entry.vaddr,
+                                      level + 1, pte);
+                }
             }
         }
     } else {
@@ -851,7 +978,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
     }
     else {
         //If we didn't return, we're setting up another read.
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = makeRequest(
             nextRead, oldRead->getSize(), flags, walker->requestorId);
 
         delete oldRead;
@@ -1019,7 +1146,7 @@ Walker::WalkerState::stepWalkGStage(PacketPtr &write)
     }
     else {
         //If we didn't return, we're setting up another read.
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = makeRequest(
             nextRead, oldRead->getSize(), flags, walker->requestorId);
 
         delete oldRead;
@@ -1109,6 +1236,7 @@ Walker::WalkerState::recvPacket(PacketPtr pkt)
     if (inflight == 0 && read == NULL && writes.size() == 0) {
         state = Ready;
         nextState = Waiting;
+        walker->pagewalkerstats.walk_latency.sample(curTick() - startTick);
         if (timingFault == NoFault) {
             /*
              * Finish the translation. Now that we know the right entry is
@@ -1182,7 +1310,7 @@ PacketPtr
 Walker::WalkerState::createReqPacket(Addr paddr, MemCmd cmd, size_t bytes)
 {
     Request::Flags flags = Request::PHYSICAL;
-    RequestPtr request = std::make_shared<Request>(
+    RequestPtr request = makeRequest(
         paddr, bytes, flags, walker->requestorId);
     PacketPtr pkt = new Packet(request, cmd);
     pkt->allocate();
@@ -1213,6 +1341,22 @@ Walker::WalkerState::wasStarted()
     return started;
 }
 
+bool
+Walker::WalkerState::canMerge(const WalkerState &other) const
+{
+    if (squashed || !timing || !other.timing || functional ||
+        memaccess.bypassTLB() || other.memaccess.bypassTLB() ||
+        memaccess.virt != other.memaccess.virt ||
+        (RegVal)satp != (RegVal)other.satp) {
+        return false;
+    }
+
+    Addr vaddr = Addr(sext<SV39_VADDR_BITS>(req->getVaddr()));
+    Addr other_vaddr = Addr(sext<SV39_VADDR_BITS>(other.req->getVaddr()));
+    return getVPNFromVAddr(vaddr, satp.mode) ==
+           getVPNFromVAddr(other_vaddr, satp.mode);
+}
+
 void
 Walker::WalkerState::squash()
 {
@@ -1240,8 +1384,20 @@ Walker::PagewalkerStats::PagewalkerStats(statistics::Group *parent)
     ADD_STAT(num_64kb_walks, statistics::units::Count::get(),
              "Completed page walks with 64KB pages"),
     ADD_STAT(num_2mb_walks, statistics::units::Count::get(),
-             "Completed page walks with 2MB pages")
+             "Completed page walks with 2MB pages"),
+    ADD_STAT(num_pwc_hits, statistics::units::Count::get(),
+             "Walks that started below the root from the page-walk cache"),
+    ADD_STAT(num_pwc_misses, statistics::units::Count::get(),
+             "Walks that missed in the page-walk cache"),
+    ADD_STAT(pwc_hit_rate, statistics::units::Ratio::get(),
+             "Page-walk cache hit rate",
+             num_pwc_hits / (num_pwc_hits + num_pwc_misses)),
+    ADD_STAT(num_merged_walks, statistics::units::Count::get(),
+             "Misses merged into a walk of the same page"),
+    ADD_STAT(walk_latency, statistics::units::Tick::get(),
+             "Latency of timing page walks")
 {
+    walk_latency.init(16);
 }
 
 } // namespace RiscvISA
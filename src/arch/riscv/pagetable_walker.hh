@@ -42,10 +42,12 @@
 #include <vector>
 
 #include "arch/generic/mmu.hh"
+#include "arch/riscv/page_size.hh"
 #include "arch/riscv/pagetable.hh"
 #include "arch/riscv/pma_checker.hh"
 #include "arch/riscv/pmp.hh"
 #include "arch/riscv/tlb.hh"
+#include "base/bitfield.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
@@ -82,6 +84,16 @@ namespace RiscvISA
         friend class WalkerPort;
         WalkerPort port;
 
+        // A translation that missed on a page another walk is already
+        // translating, retried in the TLB once that walk ends
+        struct MergedTranslation
+        {
+            BaseMMU::Translation *translation;
+            RequestPtr req;
+            ThreadContext *tc;
+            BaseMMU::Mode mode;
+        };
+
         // State to track each walk of the page table
         class WalkerState
         {
@@ -140,6 +152,8 @@ namespace RiscvISA
             bool retrying;
             bool started;
             bool squashed;
+            Tick startTick;
+            std::vector<MergedTranslation> merged;
           public:
             WalkerState(Walker * _walker, BaseMMU::Translation *_translation,
                         const RequestPtr &_req, bool _isFunctional = false) :
@@ -147,7 +161,8 @@ namespace RiscvISA
                 nextState(Ready), level(0), glevel(0), inflight(0),
                 translation(_translation),
                 functional(_isFunctional), timing(false),
-                retrying(false), started(false), squashed(false)
+                retrying(false), started(false), squashed(false),
+                startTick(0)
             {
             }
             void initState(ThreadContext * _tc, BaseMMU::Mode _mode,
@@ -162,8 +177,15 @@ namespace RiscvISA
             bool isTiming();
             void retry();
             void squash();
+            bool isSquashed() const { return squashed; }
             std::string name() const {return walker->name();}
 
+            /**
+             * Whether a miss described by other can wait for this walk
+             * instead of walking the page table itself.
+             */
+            bool canMerge(const WalkerState &other) const;
+
           private:
             Fault checkPTEPermissions(
               PTESv39 pte, WalkFlags& stepWalkFlags, int level);
@@ -194,7 +216,44 @@ namespace RiscvISA
                 senderWalk(_senderWalk) {}
         };
 
+        // A non-leaf PTE cached by the page-walk cache
+        struct PwcEntry
+        {
+            bool valid = false;
+            uint16_t asid = 0;
+            Addr root = 0;
+            int level = 0;
+            Addr tag = 0;
+            PTESv39 pte = 0;
+            uint64_t lruSeq = 0;
+        };
+
+        // Page-walk cache for the upper levels of first-stage walks
+        std::vector<PwcEntry> pwc;
+        uint64_t pwcSeq;
+
+        static Addr
+        pwcTag(Addr vaddr, int level)
+        {
+            return bits(vaddr, SV39_VADDR_BITS - 1,
+                        PageShift + level * SV39_LEVEL_BITS);
+        }
+
+        /**
+         * Find the deepest cached non-leaf PTE on the walk of vaddr.
+         * @return The level of that PTE, or -1 on a miss.
+         */
+        int pwcLookup(uint16_t asid, Addr root, Addr vaddr, PTESv39 &pte);
+        void pwcInsert(uint16_t asid, Addr root, Addr vaddr, int level,
+                       PTESv39 pte);
+
       public:
+        /**
+         * Drop the page-walk cache entries of an address space, or all
+         * of them if asid is zero.
+         */
+        void flushPwc(uint16_t asid);
+
         // Kick off the state machine.
         Fault start(ThreadContext * _tc, BaseMMU::Translation *translation,
                 const RequestPtr &req, BaseMMU::Mode mode,
@@ -215,6 +274,15 @@ namespace RiscvISA
         // The number of outstanding walks that can be squashed per cycle.
         unsigned numSquashable;
 
+        // The number of walks that can be in progress at the same time.
+        unsigned numWalkers;
+
+        unsigned numActive() const;
+        bool hasPending() const;
+
+        // Retry the translations merged into a walk that has ended.
+        void replayMerged(WalkerState *state);
+
         // Wrapper for checking for squashes before starting a translation.
         void startWalkWrapper();
 
@@ -236,6 +304,12 @@ namespace RiscvISA
             statistics::Scalar num_64kb_walks;
             statistics::Scalar num_2mb_walks;
 
+            statistics::Scalar num_pwc_hits;
+            statistics::Scalar num_pwc_misses;
+            statistics::Formula pwc_hit_rate;
+            statistics::Scalar num_merged_walks;
+            statistics::Histogram walk_latency;
+
         } pagewalkerstats;
 
 
@@ -250,14 +324,18 @@ namespace RiscvISA
 
         Walker(const Params &params) :
             ClockedObject(params), port(name() + ".port", this),
-            funcState(this, NULL, NULL, true), tlb(NULL), sys(params.system),
+            funcState(this, NULL, NULL, true), pwc(params.pwc_size), pwcSeq(0),
+            tlb(NULL), sys(params.system),
             pma(params.pma_checker),
             pmp(params.pmp),
             requestorId(sys->getRequestorId(this)),
             numSquashable(params.num_squash_per_cycle),
+            numWalkers(params.num_walkers),
             startWalkWrapperEvent([this]{ startWalkWrapper(); }, name()),
             pagewalkerstats(this)
         {
+            fatal_if(numWalkers == 0, "%s needs at least one walker",
+                     name());
         }
     };
 
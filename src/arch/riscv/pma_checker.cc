@@ -40,6 +40,7 @@
 #include "arch/riscv/faults.hh"
 #include "arch/riscv/memflags.hh"
 #include "arch/riscv/mmu.hh"
+#include "arch/riscv/page_size.hh"
 #include "base/addr_range.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
@@ -65,7 +66,7 @@ uncacheable(params.uncacheable.begin(), params.uncacheable.end())
 Fault
 PMAChecker::check(const RequestPtr &req, BaseMMU::Mode mode, Addr vaddr)
 {
-    if (isUncacheable(req->getPaddr(), req->getSize())) {
+    if (isUncacheableAccess(req->getPaddr(), req->getSize())) {
         req->setFlags(Request::UNCACHEABLE | Request::STRICT_ORDER);
     }
 
@@ -119,6 +120,34 @@ PMAChecker::isUncacheable(PacketPtr pkt)
     return isUncacheable(pkt->getAddrRange());
 }
 
+bool
+PMAChecker::isUncacheableAccess(const Addr addr, const unsigned size)
+{
+    const Addr page = addr >> PageShift;
+    if (size == 0 || ((addr + size - 1) >> PageShift) != page)
+        return isUncacheable(addr, size);
+
+    PageAttr &attr = pageAttrs[page % pageAttrCacheSize];
+    if (attr.page == page)
+        return attr.uncacheable;
+
+    AddrRange page_range(page << PageShift, (page + 1) << PageShift);
+    if (isUncacheable(page_range)) {
+        attr.page = page;
+        attr.uncacheable = true;
+        return true;
+    }
+    for (auto const &uncacheable_range: uncacheable) {
+        if (page_range.intersects(uncacheable_range)) {
+            // only part of the page is uncacheable
+            return isUncacheable(addr, size);
+        }
+    }
+    attr.page = page;
+    attr.uncacheable = false;
+    return false;
+}
+
 void
 PMAChecker::takeOverFrom(BasePMAChecker *old)
 {
@@ -126,6 +155,7 @@ PMAChecker::takeOverFrom(BasePMAChecker *old)
     assert(derived_old != nullptr);
     uncacheable = derived_old->uncacheable;
     misaligned = derived_old->misaligned;
+    pageAttrs.fill(PageAttr());
 }
 
 Fault
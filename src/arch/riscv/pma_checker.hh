@@ -38,6 +38,8 @@
 #ifndef __ARCH_RISCV_PMA_CHECKER_HH__
 #define __ARCH_RISCV_PMA_CHECKER_HH__
 
+#include <array>
+
 #include "arch/generic/mmu.hh"
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
@@ -133,8 +135,27 @@ class PMAChecker : public BasePMAChecker
      */
     inline bool hasMisaligned();
 
+    /*
+     * Check if an access to a physical address is uncacheable, using
+     * the page attribute cache if the access is within one page
+     */
+    bool isUncacheableAccess(const Addr addr, const unsigned size);
+
     AddrRangeList uncacheable;
     AddrRangeMap<bool, 3> misaligned;
+
+    /*
+     * Cacheability of pages which are entirely inside or entirely
+     * outside of the uncacheable ranges, in a direct-mapped cache
+     */
+    struct PageAttr
+    {
+        Addr page = MaxAddr;
+        bool uncacheable = false;
+    };
+
+    static constexpr int pageAttrCacheSize = 64;
+    std::array<PageAttr, pageAttrCacheSize> pageAttrs;
 };
 
 } // namespace RiscvISA
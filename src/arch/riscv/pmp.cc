@@ -31,6 +31,7 @@
 #include "arch/generic/tlb.hh"
 #include "arch/riscv/faults.hh"
 #include "arch/riscv/isa.hh"
+#include "arch/riscv/page_size.hh"
 #include "arch/riscv/regs/misc.hh"
 #include "base/addr_range.hh"
 #include "base/types.hh"
@@ -73,6 +74,19 @@ PMP::pmpCheck(const RequestPtr &req, BaseMMU::Mode mode,
                 req->getPaddr());
     }
 
+    // accesses within one page can use the cached page verdicts
+    const Addr paddr = req->getPaddr();
+    const Addr page = paddr >> PageShift;
+    const bool in_page = req->getSize() != 0 &&
+        ((paddr + req->getSize() - 1) >> PageShift) == page;
+    if (in_page) {
+        const PageVerdict &verdict = verdictCache[page % verdictCacheSize];
+        if (verdict.page == page && verdict.mode == mode &&
+                verdict.pmode == pmode) {
+            return NoFault;
+        }
+    }
+
     // match_index will be used to identify the pmp entry
     // which matched for the given address
     int match_index = -1;
@@ -93,17 +107,16 @@ PMP::pmpCheck(const RequestPtr &req, BaseMMU::Mode mode,
             && (PMP_OFF != pmpGetAField(pmpTable[match_index].pmpCfg))) {
             uint8_t this_cfg = pmpTable[match_index].pmpCfg;
 
-            if ((pmode == PrivilegeMode::PRV_M) &&
-                                    (PMP_LOCK & this_cfg) == 0) {
-                return NoFault;
-            } else if ((mode == BaseMMU::Mode::Read) &&
-                                        (PMP_READ & this_cfg)) {
-                return NoFault;
-            } else if ((mode == BaseMMU::Mode::Write) &&
-                                        (PMP_WRITE & this_cfg)) {
-                return NoFault;
-            } else if ((mode == BaseMMU::Mode::Execute) &&
-                                        (PMP_EXEC & this_cfg)) {
+            if (((pmode == PrivilegeMode::PRV_M) &&
+                                    (PMP_LOCK & this_cfg) == 0) ||
+                    ((mode == BaseMMU::Mode::Read) &&
+                                        (PMP_READ & this_cfg)) ||
+                    ((mode == BaseMMU::Mode::Write) &&
+                                        (PMP_WRITE & this_cfg)) ||
+                    ((mode == BaseMMU::Mode::Execute) &&
+                                        (PMP_EXEC & this_cfg))) {
+                if (in_page)
+                    pmpCacheVerdict(page, mode, pmode);
                 return NoFault;
             } else {
                 if (req->hasVaddr()) {
@@ -116,6 +129,8 @@ PMP::pmpCheck(const RequestPtr &req, BaseMMU::Mode mode,
     }
     // if no entry matched and we are not in M mode return fault
     if (pmode == PrivilegeMode::PRV_M) {
+        if (in_page)
+            pmpCacheVerdict(page, mode, pmode);
         return NoFault;
     } else if (req->hasVaddr()) {
         return createAddrfault(req->getVaddr(), mode);
@@ -124,6 +139,35 @@ PMP::pmpCheck(const RequestPtr &req, BaseMMU::Mode mode,
     }
 }
 
+bool
+PMP::pmpPageUniform(Addr page)
+{
+    AddrRange page_range(page << PageShift, (page + 1) << PageShift);
+
+    // the first active entry which overlaps the page must cover all of
+    // it, as accesses to the rest of the page would not match it
+    for (const auto &entry : pmpTable) {
+        if (PMP_OFF == pmpGetAField(entry.pmpCfg) ||
+                !entry.pmpAddr.intersects(page_range)) {
+            continue;
+        }
+        return page_range.isSubset(entry.pmpAddr);
+    }
+    return true;
+}
+
+void
+PMP::pmpCacheVerdict(Addr page, BaseMMU::Mode mode, PrivilegeMode pmode)
+{
+    if (!pmpPageUniform(page))
+        return;
+
+    PageVerdict &verdict = verdictCache[page % verdictCacheSize];
+    verdict.page = page;
+    verdict.mode = mode;
+    verdict.pmode = pmode;
+}
+
 Fault
 PMP::createAddrfault(Addr vaddr, BaseMMU::Mode mode)
 {
@@ -212,6 +256,9 @@ PMP::pmpUpdateRule(uint32_t pmp_index)
 
     pmpTable[pmp_index].pmpAddr = this_range;
 
+    // the cached page verdicts may not hold for the new rules
+    verdictCache.fill(PageVerdict());
+
     for (int i = 0; i < pmpEntries; i++) {
         const uint8_t a_field = pmpGetAField(pmpTable[i].pmpCfg);
       if (PMP_OFF != a_field) {
@@ -30,6 +30,8 @@
 #ifndef __ARCH_RISCV_PMP_HH__
 #define __ARCH_RISCV_PMP_HH__
 
+#include <array>
+
 #include "arch/generic/tlb.hh"
 #include "arch/riscv/isa.hh"
 #include "base/addr_range.hh"
@@ -115,6 +117,28 @@ class PMP : public SimObject
     /** a table of pmp entries */
     std::vector<PmpEntry> pmpTable;
 
+    /** number of entries in the page verdict cache */
+    static constexpr int verdictCacheSize = 64;
+
+    /**
+     * A page for which pmpCheck allowed an access with a given mode and
+     * privilege. Only pages that are entirely covered by the rule that
+     * matched them, or by no rule at all, are cached, so that the verdict
+     * holds for any access within the page.
+     */
+    struct PageVerdict
+    {
+        Addr page = MaxAddr;
+        BaseMMU::Mode mode = BaseMMU::Read;
+        PrivilegeMode pmode = PrivilegeMode::PRV_M;
+    };
+
+    /**
+     * Direct-mapped cache of allowed page verdicts, cleared whenever a
+     * pmp rule changes.
+     */
+    std::array<PageVerdict, verdictCacheSize> verdictCache;
+
   public:
     /**
      * pmpCheck checks if a particular memory access
@@ -188,6 +212,23 @@ class PMP : public SimObject
      */
     void pmpUpdateRule(uint32_t pmp_index);
 
+    /**
+     * Checks if all accesses within a page are matched by the same
+     * pmp entry, or by none, so that a verdict for the page can be cached.
+     * @param page page number of the physical address.
+     * @return true or false.
+     */
+    bool pmpPageUniform(Addr page);
+
+    /**
+     * Records that pmpCheck allowed an access to a page, if the verdict
+     * applies to the whole page.
+     * @param page page number of the physical address.
+     * @param mode mode of request (read, write, execute).
+     * @param pmode current privilege mode of memory (U, S, M).
+     */
+    void pmpCacheVerdict(Addr page, BaseMMU::Mode mode, PrivilegeMode pmode);
+
     /**
      * pmpGetAField extracts the A field (address matching mode)
      * from an input pmpcfg register
@@ -43,7 +43,9 @@
 #include "arch/riscv/pmp.hh"
 #include "arch/riscv/pra_constants.hh"
 #include "arch/riscv/utility.hh"
+#include "base/bitfield.hh"
 #include "base/inifile.hh"
+#include "base/intmath.hh"
 #include "base/str.hh"
 #include "base/trace.hh"
 #include "cpu/thread_context.hh"
@@ -77,55 +79,174 @@ buildKey(Addr vpn, uint16_t asid)
     return (static_cast<Addr>(asid) << 48) | vpn;
 }
 
-TLB::TLB(const Params &p) :
-    BaseTLB(p), size(p.size), tlb(size),
-    lruSeq(0), stats(this), pma(p.pma_checker),
-    pmp(p.pmp)
+TLB::Level::Level(TLB *tlb, const char *name, size_t size, size_t _assoc,
+                  Tick _latency)
+    : Named(tlb->name() + "." + name),
+      latency(_latency), stats(tlb, name), entries(size), tags(size),
+      assoc(_assoc ? _assoc : size), used(0), sizeCount(64, 0), sizeMask(0)
 {
-    for (size_t x = 0; x < size; x++) {
-        tlb[x].trieHandle = NULL;
-        freeList.push_back(&tlb[x]);
-    }
+    fatal_if(size == 0, "%s TLB must have at least one entry", name);
+    fatal_if(size % assoc != 0,
+             "%s TLB size %d is not a multiple of its associativity %d",
+             name, size, assoc);
+    fatal_if(!isPowerOf2(size / assoc),
+             "%s TLB must have a power of two number of sets", name);
+    setMask = size / assoc - 1;
+}
 
-    walker = p.walker;
-    walker->setTLB(this);
+TlbEntry *
+TLB::Level::find(Addr vpn, uint16_t asid)
+{
+    // Probe one set per resident page size, smallest pages first.
+    for (uint64_t sizes = sizeMask; sizes; sizes &= sizes - 1) {
+        const unsigned log_bytes = ctz64(sizes);
+        const Addr key = buildKey(vpn >> (log_bytes - PageShift), asid);
+        const size_t base = setBase(vpn, log_bytes);
+        for (size_t way = base; way < base + assoc; way++) {
+            const Tag &tag = tags[way];
+            if (tag.valid && tag.key == key && tag.logBytes == log_bytes)
+                return &entries[way];
+        }
+    }
+    return nullptr;
 }
 
-Walker *
-TLB::getWalker()
+TlbEntry *
+TLB::Level::insert(Addr vpn, const TlbEntry &entry, uint64_t seq)
 {
-    return walker;
+    const size_t base = setBase(vpn, entry.logBytes);
+
+    // Use a free way if there is one, otherwise the least recently used.
+    size_t victim = base;
+    for (size_t way = base; way < base + assoc; way++) {
+        if (!tags[way].valid) {
+            victim = way;
+            break;
+        }
+        if (entries[way].lruSeq < entries[victim].lruSeq)
+            victim = way;
+    }
+    if (tags[victim].valid)
+        remove(victim);
+
+    entries[victim] = entry;
+    entries[victim].lruSeq = seq;
+    tags[victim].key = buildKey(vpn >> (entry.logBytes - PageShift),
+                                entry.asid);
+    tags[victim].logBytes = entry.logBytes;
+    tags[victim].valid = true;
+
+    if (sizeCount[entry.logBytes]++ == 0)
+        sizeMask |= 1ULL << entry.logBytes;
+    used++;
+    return &entries[victim];
 }
 
 void
-TLB::evictLRU()
+TLB::Level::remove(size_t idx)
 {
-    // Find the entry with the lowest (and hence least recently updated)
-    // sequence number.
+    DPRINTF(TLB, "remove(vpn=%#x, asid=%#x): ppn=%#x pte=%#x size=%#x\n",
+        entries[idx].vaddr, entries[idx].asid, entries[idx].paddr,
+        entries[idx].pte, entries[idx].size());
+
+    assert(tags[idx].valid);
+    tags[idx].valid = false;
+    const unsigned log_bytes = tags[idx].logBytes;
+    if (--sizeCount[log_bytes] == 0)
+        sizeMask &= ~(1ULL << log_bytes);
+    used--;
+}
 
-    size_t lru = 0;
-    for (size_t i = 1; i < size; i++) {
-        if (tlb[i].lruSeq < tlb[lru].lruSeq)
-            lru = i;
+void
+TLB::Level::flushAll()
+{
+    for (size_t i = 0; i < size(); i++) {
+        if (tags[i].valid)
+            remove(i);
     }
+}
+
+TLB::Level::LevelStats::LevelStats(statistics::Group *parent,
+                                   const char *name)
+  : statistics::Group(parent, name),
+    ADD_STAT(hits, statistics::units::Count::get(), "hits in this level"),
+    ADD_STAT(misses, statistics::units::Count::get(),
+             "misses in this level"),
+    ADD_STAT(hitLatency, statistics::units::Tick::get(),
+             "total latency of the hits in this level"),
+    ADD_STAT(accesses, statistics::units::Count::get(),
+             "lookups in this level", hits + misses),
+    ADD_STAT(missRate, statistics::units::Ratio::get(),
+             "miss rate of this level", misses / accesses),
+    ADD_STAT(avgHitLatency, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "average latency of a hit in this level", hitLatency / hits)
+{
+}
+
+TLB::TLB(const Params &p) :
+    BaseTLB(p),
+    l1(this, "l1", p.size, p.assoc, p.hit_latency),
+    l2(p.l2_size ? std::make_unique<Level>(this, "l2", p.l2_size,
+                                           p.l2_assoc, p.l2_hit_latency)
+                 : nullptr),
+    lruSeq(0), pendingLatency(0), stats(this), pma(p.pma_checker),
+    pmp(p.pmp)
+{
+    walker = p.walker;
+    walker->setTLB(this);
+}
 
-    remove(lru);
+Walker *
+TLB::getWalker()
+{
+    return walker;
 }
 
 TlbEntry *
 TLB::lookup(Addr vpn, uint16_t asid, BaseMMU::Mode mode, bool hidden)
 {
-    TlbEntry *entry = trie.lookup(buildKey(vpn, asid));
+    TlbEntry *entry = l1.find(vpn, asid);
+    Level *level = entry ? &l1 : nullptr;
+    if (!entry && l2) {
+        entry = l2->find(vpn, asid);
+        level = entry ? l2.get() : nullptr;
+    }
 
     DPRINTF(TLBVerbose, "lookup(vpn=%#x, asid=%#x, key=%#x): "
                         "%s ppn=%#x (%#x) %s\n",
-            vpn, asid, buildKey(vpn, asid), entry ? "hit" : "miss",
+            vpn, asid, buildKey(vpn, asid),
+            entry ? (level == &l1 ? "l1 hit" : "l2 hit") : "miss",
             entry ? entry->paddr : 0, entry ? entry->size() : 0,
             hidden ? "hidden" : "");
 
     if (!hidden) {
-        if (entry)
+        // Every lookup probes the L1, and the L2 is only probed on an
+        // L1 miss.
+        Tick latency = l1.latency;
+        if (level == &l1) {
+            l1.stats.hits++;
+        } else {
+            l1.stats.misses++;
+            if (l2) {
+                latency += l2->latency;
+                if (level)
+                    l2->stats.hits++;
+                else
+                    l2->stats.misses++;
+            }
+        }
+
+        if (entry) {
+            level->stats.hitLatency += latency;
+            pendingLatency = latency;
+            if (level != &l1) {
+                // Refill the L1 from the L2.
+                entry->lruSeq = nextSeq();
+                entry = l1.insert(vpn, *entry, entry->lruSeq);
+            }
             entry->lruSeq = nextSeq();
+        }
 
         if (mode == BaseMMU::Write)
             stats.writeAccesses++;
@@ -158,29 +279,51 @@ TLB::insert(Addr vpn, const TlbEntry &entry)
         entry.pte, entry.size());
 
     // If somebody beat us to it, just use that existing entry.
-    TlbEntry *newEntry = lookup(vpn, entry.asid, BaseMMU::Read, true);
-    if (newEntry) {
-        // update PTE flags (maybe we set the dirty/writable flag)
-        newEntry->pte = entry.pte;
-        assert(newEntry->vaddr == entry.vaddr);
-        assert(newEntry->asid == entry.asid);
-        assert(newEntry->logBytes == entry.logBytes);
-        return newEntry;
-    }
-
-    if (freeList.empty())
-        evictLRU();
-
-    newEntry = freeList.front();
-    freeList.pop_front();
-
-    Addr key = buildKey(vpn, entry.asid);
-    *newEntry = entry;
-    newEntry->lruSeq = nextSeq();
-    newEntry->trieHandle = trie.insert(
-        key, TlbEntryTrie::MaxBits - entry.logBytes + PageShift, newEntry
-    );
-    return newEntry;
+    // update PTE flags (maybe we set the dirty/writable flag) in every
+    // level that holds it.
+    TlbEntry *l1_entry = l1.find(vpn, entry.asid);
+    TlbEntry *l2_entry = l2 ? l2->find(vpn, entry.asid) : nullptr;
+    for (TlbEntry *e : {l1_entry, l2_entry}) {
+        if (e) {
+            e->pte = entry.pte;
+            assert(e->vaddr == entry.vaddr);
+            assert(e->asid == entry.asid);
+            assert(e->logBytes == entry.logBytes);
+        }
+    }
+
+    // Fill both levels; the L2 is neither inclusive nor exclusive of
+    // the L1, so an eviction from one level leaves the other alone.
+    if (l2 && !l2_entry)
+        l2_entry = l2->insert(vpn, entry, nextSeq());
+    if (!l1_entry)
+        l1_entry = l1.insert(vpn, entry, nextSeq());
+    return l1_entry;
+}
+
+void
+TLB::remove(Addr vpn, uint16_t asid)
+{
+    if (TlbEntry *e = l1.find(vpn, asid))
+        l1.remove(l1.index(e));
+    if (l2) {
+        if (TlbEntry *e = l2->find(vpn, asid))
+            l2->remove(l2->index(e));
+    }
+}
+
+void
+TLB::demapLevel(Level &level, Addr vaddr, uint16_t asid)
+{
+    for (size_t i = 0; i < level.size(); i++) {
+        if (level.valid(i)) {
+            const TlbEntry &e = level.entry(i);
+            Addr mask = ~(e.size() - 1);
+            if ((vaddr == 0 || (vaddr & mask) == e.vaddr) &&
+                (asid == 0 || e.asid == asid))
+                level.remove(i);
+        }
+    }
 }
 
 void
@@ -204,23 +347,18 @@ TLB::demapPage(Addr vaddr, uint64_t asid)
         DPRINTF(TLB, "Flushing all TLB entries\n");
         flushAll();
     } else {
+        // Non-leaf PTEs are not tagged with a page, so drop everything
+        // the page-walk cache holds for the address space.
+        walker->flushPwc(asid);
         if (vaddr != 0 && asid != 0) {
             // TODO: When supporting other address translation modes, fix this
             Addr vpn = getVPNFromVAddr(vaddr, AddrXlateMode::SV39);
-            TlbEntry *entry = lookup(vpn, asid, BaseMMU::Read, true);
-            if (entry) {
-                remove(entry - tlb.data());
-            }
+            remove(vpn, asid);
         }
         else {
-            for (size_t i = 0; i < size; i++) {
-                if (tlb[i].trieHandle) {
-                    Addr mask = ~(tlb[i].size() - 1);
-                    if ((vaddr == 0 || (vaddr & mask) == tlb[i].vaddr) &&
-                        (asid == 0 || tlb[i].asid == asid))
-                        remove(i);
-                }
-            }
+            demapLevel(l1, vaddr, asid);
+            if (l2)
+                demapLevel(*l2, vaddr, asid);
         }
     }
 }
@@ -229,23 +367,10 @@ void
 TLB::flushAll()
 {
     DPRINTF(TLB, "flushAll()\n");
-    for (size_t i = 0; i < size; i++) {
-        if (tlb[i].trieHandle)
-            remove(i);
-    }
-}
-
-void
-TLB::remove(size_t idx)
-{
-    DPRINTF(TLB, "remove(vpn=%#x, asid=%#x): ppn=%#x pte=%#x size=%#x\n",
-        tlb[idx].vaddr, tlb[idx].asid, tlb[idx].paddr, tlb[idx].pte,
-        tlb[idx].size());
-
-    assert(tlb[idx].trieHandle);
-    trie.remove(tlb[idx].trieHandle);
-    tlb[idx].trieHandle = NULL;
-    freeList.push_back(&tlb[idx]);
+    walker->flushPwc(0);
+    l1.flushAll();
+    if (l2)
+        l2->flushAll();
 }
 
 Fault
@@ -620,11 +745,20 @@ TLB::translateTiming(const RequestPtr &req, ThreadContext *tc,
 {
     bool delayed;
     assert(translation);
+    pendingLatency = 0;
     Fault fault = translate(req, tc, translation, mode, delayed);
-    if (!delayed)
+    if (delayed) {
+        translation->markDelayed();
+    } else if (pendingLatency == 0) {
         translation->finish(fault, req, tc, mode);
-    else
+    } else {
+        // Deliver the translation once the TLB levels that were probed
+        // have produced it.
         translation->markDelayed();
+        schedule(new EventFunctionWrapper(
+            [=]{ translation->finish(fault, req, tc, mode); },
+            name() + ".hit", true), curTick() + pendingLatency);
+    }
 }
 
 Fault
@@ -689,14 +823,27 @@ void
 TLB::serialize(CheckpointOut &cp) const
 {
     // Only store the entries in use.
-    uint32_t _size = size - freeList.size();
+    uint32_t _size = l1.occupancy();
     SERIALIZE_SCALAR(_size);
     SERIALIZE_SCALAR(lruSeq);
 
     uint32_t _count = 0;
-    for (uint32_t x = 0; x < size; x++) {
-        if (tlb[x].trieHandle != NULL)
-            tlb[x].serializeSection(cp, csprintf("Entry%d", _count++));
+    for (uint32_t x = 0; x < l1.size(); x++) {
+        if (l1.valid(x))
+            l1.entry(x).serializeSection(cp, csprintf("Entry%d", _count++));
+    }
+
+    if (l2) {
+        uint32_t _l2Size = l2->occupancy();
+        SERIALIZE_SCALAR(_l2Size);
+
+        _count = 0;
+        for (uint32_t x = 0; x < l2->size(); x++) {
+            if (l2->valid(x)) {
+                l2->entry(x).serializeSection(
+                    cp, csprintf("L2Entry%d", _count++));
+            }
+        }
     }
 }
 
@@ -706,23 +853,28 @@ TLB::unserialize(CheckpointIn &cp)
     // Do not allow to restore with a smaller tlb.
     uint32_t _size;
     UNSERIALIZE_SCALAR(_size);
-    if (_size > size) {
+    if (_size > l1.size()) {
         fatal("TLB size less than the one in checkpoint!");
     }
 
     UNSERIALIZE_SCALAR(lruSeq);
 
-    for (uint32_t x = 0; x < _size; x++) {
-        TlbEntry *newEntry = freeList.front();
-        freeList.pop_front();
+    auto restore = [&](Level &level, const char *fmt, uint32_t count) {
+        for (uint32_t x = 0; x < count; x++) {
+            TlbEntry entry;
+            entry.unserializeSection(cp, csprintf(fmt, x));
+            // TODO: When supporting other addressing modes fix this
+            Addr vpn = getVPNFromVAddr(entry.vaddr, AddrXlateMode::SV39);
+            level.insert(vpn, entry, entry.lruSeq);
+        }
+    };
 
-        newEntry->unserializeSection(cp, csprintf("Entry%d", x));
-        // TODO: When supporting other addressing modes fix this
-        Addr vpn = getVPNFromVAddr(newEntry->vaddr, AddrXlateMode::SV39);
-        Addr key = buildKey(vpn, newEntry->asid);
-        newEntry->trieHandle = trie.insert(key,
-            TlbEntryTrie::MaxBits - newEntry->logBytes + PageShift, newEntry);
-    }
+    restore(l1, "Entry%d", _size);
+
+    // Checkpoints taken with a single level have no L2 entries.
+    uint32_t _l2Size = 0;
+    if (l2 && UNSERIALIZE_OPT_SCALAR(_l2Size))
+        restore(*l2, "L2Entry%d", _l2Size);
 }
 
 TLB::TlbStats::TlbStats(statistics::Group *parent)
@@ -32,14 +32,17 @@
 #ifndef __ARCH_RISCV_TLB_HH__
 #define __ARCH_RISCV_TLB_HH__
 
-#include <list>
+#include <memory>
+#include <vector>
 
 #include "arch/generic/tlb.hh"
 #include "arch/riscv/isa.hh"
+#include "arch/riscv/page_size.hh"
 #include "arch/riscv/pagetable.hh"
 #include "arch/riscv/pma_checker.hh"
 #include "arch/riscv/regs/misc.hh"
 #include "arch/riscv/utility.hh"
+#include "base/named.hh"
 #include "base/statistics.hh"
 #include "mem/request.hh"
 #include "params/RiscvTLB.hh"
@@ -85,15 +88,88 @@ class Walker;
 
 class TLB : public BaseTLB
 {
-    typedef std::list<TlbEntry *> EntryList;
-
   protected:
-    size_t size;
-    std::vector<TlbEntry> tlb;  // our TLB
-    TlbEntryTrie trie;          // for quick access
-    EntryList freeList;         // free entries
+    /**
+     * One level of the TLB hierarchy. Entries live in a set-associative
+     * array that is indexed with the page number of the page size being
+     * probed, so a lookup reads one set for each page size that is
+     * currently resident in the level.
+     */
+    class Level : public Named
+    {
+      public:
+        Level(TLB *tlb, const char *name, size_t size, size_t assoc,
+              Tick latency);
+
+        /** Find the entry translating vpn in the given address space. */
+        TlbEntry *find(Addr vpn, uint16_t asid);
+
+        /**
+         * Install a copy of entry, replacing the least recently used way
+         * of its set if the set is full.
+         */
+        TlbEntry *insert(Addr vpn, const TlbEntry &entry, uint64_t seq);
+
+        void remove(size_t idx);
+        void flushAll();
+
+        size_t size() const { return entries.size(); }
+        size_t occupancy() const { return used; }
+        bool valid(size_t idx) const { return tags[idx].valid; }
+        TlbEntry &entry(size_t idx) { return entries[idx]; }
+        const TlbEntry &entry(size_t idx) const { return entries[idx]; }
+        size_t index(const TlbEntry *e) const { return e - entries.data(); }
+
+        /** Latency of a hit in this level, in timing mode. */
+        const Tick latency;
+
+        struct LevelStats : public statistics::Group
+        {
+            LevelStats(statistics::Group *parent, const char *name);
+
+            statistics::Scalar hits;
+            statistics::Scalar misses;
+            statistics::Scalar hitLatency;
+
+            statistics::Formula accesses;
+            statistics::Formula missRate;
+            statistics::Formula avgHitLatency;
+        } stats;
+
+      private:
+        struct Tag
+        {
+            Addr key = 0;
+            uint8_t logBytes = 0;
+            bool valid = false;
+        };
+
+        size_t
+        setBase(Addr vpn, unsigned log_bytes) const
+        {
+            return ((vpn >> (log_bytes - PageShift)) & setMask) * assoc;
+        }
+
+        std::vector<TlbEntry> entries;
+        /** Tags kept apart from the entries so that a probe is compact. */
+        std::vector<Tag> tags;
+        size_t assoc;
+        size_t setMask;
+        size_t used;
+
+        /** Resident entries per page size, and a mask of those sizes. */
+        std::vector<uint16_t> sizeCount;
+        uint64_t sizeMask;
+    };
+
+    Level l1;
+    /** The second level, or nullptr when the TLB has a single level. */
+    std::unique_ptr<Level> l2;
     uint64_t lruSeq;
 
+    /** The hit latency charged by the last timing lookup. */
+    Tick pendingLatency;
+
     Walker *walker;
 
     struct TlbStats : public statistics::Group
@@ -125,7 +201,7 @@ class TLB : public BaseTLB
     void takeOverFrom(BaseTLB *old) override {}
 
     /**
-     * Insert an entry into the TLB.
+     * Insert an entry into every level of the TLB.
      * @param vpn The virtual page number extracted from the address.
      *            It is shifted based on the page size. We assume the
      *            smallest defined page size and remove the upper bits of the
@@ -192,7 +268,9 @@ class TLB : public BaseTLB
         return vaddr;
     }
     /**
-     * Perform the tlb lookup
+     * Perform the tlb lookup. The L1 is probed first and the L2 on an
+     * L1 miss; an L2 hit is copied into the L1 unless the lookup is
+     * hidden.
      * @param vpn The virtual page number extracted from the address.
      *            It is shifted based on the page size. We assume the
      *            smallest defined page size and remove the upper bits of the
@@ -206,8 +284,9 @@ class TLB : public BaseTLB
   private:
     uint64_t nextSeq() { return ++lruSeq; }
 
-    void evictLRU();
-    void remove(size_t idx);
+    /** Remove the entry translating vpn from every level. */
+    void remove(Addr vpn, uint16_t asid);
+    void demapLevel(Level &level, Addr vaddr, uint16_t asid);
 
     Fault translate(const RequestPtr &req, ThreadContext *tc,
                     BaseMMU::Translation *translation, BaseMMU::Mode mode,
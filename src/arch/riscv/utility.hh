@@ -316,7 +316,7 @@ template<typename T>
 inline int
 elem_mask_vseg(const T* vs, const int elem, const int num_fields)
 {
-    int index = floor(elem / num_fields);
+    int index = elem / num_fields;
     static_assert(std::is_integral_v<T>);
     int idx = index / (sizeof(T)*8);
     int pos = index % (sizeof(T)*8);
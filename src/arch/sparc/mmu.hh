@@ -64,6 +64,8 @@ class MMU : public BaseMMU
                 PageBytes, start, size, tc, this, mode, flags));
     }
 
+    Addr minPageBytes() const override { return PageBytes; }
+
     void
     insertItlbEntry(Addr vpn, int partition_id, int context_id, bool real,
         const PageTableEntry& PTE, int entry=-1)
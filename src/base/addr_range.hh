@@ -315,6 +315,22 @@ class AddrRange
      */
     uint32_t stripes() const { return 1ULL << masks.size(); }
 
+    /**
+     * Get the masks selecting the interleaving bits, the first mask
+     * giving the least significant bit of sel.
+     *
+     * @ingroup api_addr_range
+     */
+    const std::vector<Addr> &getMasks() const { return masks; }
+
+    /**
+     * Get the value the interleaving bits of an address must have for
+     * the address to be in this range.
+     *
+     * @ingroup api_addr_range
+     */
+    uint8_t getIntlvMatch() const { return intlvMatch; }
+
     /**
      * Get the size of the address range. For a case where
      * interleaving is used we make the simplifying assumption that
@@ -0,0 +1,222 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_ADDR_RANGE_DECODER_HH__
+#define __BASE_ADDR_RANGE_DECODER_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * A read-only decoder from addresses to values, built from the entries
+ * of an AddrRangeMap, for lookups on the critical path such as the
+ * routing of every packet through a crossbar.
+ *
+ * Ranges are kept in a sorted flat array and found with a binary search.
+ * Interleaved ranges that only differ by their interleaving match are
+ * folded into a single segment, and the range an address belongs to is
+ * then decoded from the address's interleaving bits with a table lookup,
+ * so the cost of a lookup does not grow with the number of channels.
+ * Interleaving masks that have a single bit set, the usual bit-select
+ * interleaving, are decoded with shifts rather than a parity per mask.
+ */
+template <typename V>
+class AddrRangeDecoder
+{
+  private:
+    struct Segment
+    {
+        /** Last address of the segment, inclusive, so that it never wraps. */
+        Addr last;
+        /** Interleaving granularity, 0 if not interleaved. */
+        Addr granularity;
+        /** Index of the value of the first stripe. */
+        uint32_t firstValue;
+        /** Number of interleaving bits. */
+        uint8_t numBits;
+        /** Set if every mask selects a single bit. */
+        bool bitSelect;
+        /** The bit each mask selects, when bitSelect is set. */
+        uint8_t shifts[8];
+        /** The interleaving masks, when bitSelect is not set. */
+        Addr masks[8];
+    };
+
+    /** Start of each segment, searched separately to stay cache dense. */
+    std::vector<Addr> starts;
+    std::vector<Segment> segments;
+    std::vector<V> values;
+    /** Whether each stripe of each segment has a value. */
+    std::vector<uint8_t> present;
+
+    static unsigned
+    select(const Segment &seg, Addr a)
+    {
+        unsigned sel = 0;
+        if (seg.bitSelect) {
+            for (unsigned i = 0; i < seg.numBits; i++)
+                sel |= ((a >> seg.shifts[i]) & 1) << i;
+        } else {
+            for (unsigned i = 0; i < seg.numBits; i++)
+                sel |= (popCount(a & seg.masks[i]) & 1) << i;
+        }
+        return sel;
+    }
+
+    /** Find the segment containing an address, or nullptr. */
+    const Segment *
+    findSegment(Addr a) const
+    {
+        auto it = std::upper_bound(starts.begin(), starts.end(), a);
+        if (it == starts.begin())
+            return nullptr;
+        const Segment &seg = segments[it - starts.begin() - 1];
+        return a <= seg.last ? &seg : nullptr;
+    }
+
+    const V *
+    value(const Segment &seg, unsigned sel) const
+    {
+        const uint32_t idx = seg.firstValue + sel;
+        return present[idx] ? &values[idx] : nullptr;
+    }
+
+  public:
+    /**
+     * Rebuild the decoder from the entries of a map, or any sorted
+     * sequence of non-overlapping (AddrRange, V) pairs in which the
+     * ranges of an interleaved group are adjacent.
+     */
+    template <class Map>
+    void
+    build(const Map &map)
+    {
+        clear();
+
+        for (auto it = map.begin(); it != map.end(); ) {
+            const AddrRange &r = it->first;
+            const std::vector<Addr> &masks = r.getMasks();
+            panic_if(masks.size() > 8,
+                     "Cannot decode %s, it has more than 8 interleaving bits",
+                     r.to_string());
+
+            Segment seg = {};
+            seg.last = r.end() - 1;
+            seg.granularity = r.interleaved() ? r.granularity() : 0;
+            seg.firstValue = values.size();
+            seg.numBits = masks.size();
+            seg.bitSelect = true;
+            for (unsigned i = 0; i < masks.size(); i++) {
+                seg.masks[i] = masks[i];
+                seg.bitSelect &= isPowerOf2(masks[i]);
+                seg.shifts[i] = masks[i] ? ctz64(masks[i]) : 0;
+            }
+
+            const uint32_t num_values = 1U << seg.numBits;
+            values.resize(values.size() + num_values);
+            present.resize(present.size() + num_values, false);
+
+            // Fold all the stripes of an interleaved range together
+            auto next = it;
+            do {
+                const uint32_t idx =
+                    seg.firstValue + next->first.getIntlvMatch();
+                values[idx] = next->second;
+                present[idx] = true;
+                ++next;
+            } while (r.interleaved() && next != map.end() &&
+                     next->first.mergesWith(r));
+
+            starts.push_back(r.start());
+            segments.push_back(seg);
+            it = next;
+        }
+    }
+
+    void
+    clear()
+    {
+        starts.clear();
+        segments.clear();
+        values.clear();
+        present.clear();
+    }
+
+    bool empty() const { return segments.empty(); }
+
+    /**
+     * Find the value of the range containing an address.
+     *
+     * @return A pointer to the value, nullptr if no range contains it
+     */
+    const V *
+    contains(Addr a) const
+    {
+        const Segment *seg = findSegment(a);
+        if (!seg)
+            return nullptr;
+        return value(*seg, seg->numBits ? select(*seg, a) : 0);
+    }
+
+    /**
+     * Find the value of the range an address range is a subset of, with
+     * the semantics of AddrRange::isSubset().
+     *
+     * @param r A non-interleaved address range
+     * @return A pointer to the value, nullptr if no range contains r
+     */
+    const V *
+    contains(const AddrRange &r) const
+    {
+        const Segment *seg = findSegment(r.start());
+        const Addr r_last = r.end() - 1;
+        if (!seg || r_last < r.start() || r_last > seg->last)
+            return nullptr;
+
+        if (!seg->numBits)
+            return value(*seg, 0);
+
+        if (r.size() > seg->granularity)
+            return nullptr;
+        const unsigned sel = select(*seg, r.start());
+        if (select(*seg, r_last) != sel)
+            return nullptr;
+        return value(*seg, sel);
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_ADDR_RANGE_DECODER_HH__
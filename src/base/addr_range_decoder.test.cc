@@ -0,0 +1,163 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "base/addr_range_decoder.hh"
+#include "base/addr_range_map.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/**
+ * Check that the decoder agrees with the map it was built from for
+ * random single addresses and cache-line sized ranges.
+ */
+void
+checkAgainstMap(const AddrRangeMap<int> &map, Addr max_addr)
+{
+    AddrRangeDecoder<int> decoder;
+    decoder.build(map);
+
+    std::mt19937_64 rng(42);
+    for (int i = 0; i < 20000; i++) {
+        const Addr a = rng() % max_addr;
+        auto it = map.contains(a);
+        const int *v = decoder.contains(a);
+        ASSERT_EQ(it == map.end(), v == nullptr) << a;
+        if (v) {
+            ASSERT_EQ(*v, it->second) << a;
+        }
+
+        const AddrRange line = RangeSize(a & ~Addr(63), 64);
+        it = map.contains(line);
+        v = decoder.contains(line);
+        ASSERT_EQ(it == map.end(), v == nullptr) << line.to_string();
+        if (v) {
+            ASSERT_EQ(*v, it->second) << line.to_string();
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(AddrRangeDecoderTest, Empty)
+{
+    AddrRangeDecoder<int> decoder;
+    decoder.build(AddrRangeMap<int>());
+    EXPECT_TRUE(decoder.empty());
+    EXPECT_EQ(decoder.contains(0x1000), nullptr);
+    EXPECT_EQ(decoder.contains(RangeSize(0x1000, 64)), nullptr);
+}
+
+/** Contiguous ranges with holes between them. */
+TEST(AddrRangeDecoderTest, Contiguous)
+{
+    AddrRangeMap<int> map;
+    for (int i = 0; i < 16; i++)
+        map.insert(RangeSize(i * 0x20000, 0x10000), i);
+
+    AddrRangeDecoder<int> decoder;
+    decoder.build(map);
+    EXPECT_EQ(*decoder.contains(0x20000), 1);
+    EXPECT_EQ(*decoder.contains(0x2ffff), 1);
+    EXPECT_EQ(decoder.contains(0x30000), nullptr);
+    // A range straddling the end of a range is not a subset of it
+    EXPECT_EQ(decoder.contains(RangeSize(0x2fff0, 0x20)), nullptr);
+
+    checkAgainstMap(map, 0x200000);
+}
+
+/** A range reaching the top of the address space. */
+TEST(AddrRangeDecoderTest, TopOfMemory)
+{
+    AddrRangeMap<int> map;
+    map.insert(AddrRange(0xffff000000000000, 0), 7);
+
+    AddrRangeDecoder<int> decoder;
+    decoder.build(map);
+    EXPECT_EQ(*decoder.contains(MaxAddr), 7);
+    EXPECT_EQ(*decoder.contains(RangeSize(MaxAddr - 63, 64)), 7);
+    EXPECT_EQ(decoder.contains(0x1000), nullptr);
+}
+
+/** 32 channels selected by the address bits above the cache line. */
+TEST(AddrRangeDecoderTest, BitSelectInterleaving)
+{
+    std::vector<Addr> masks;
+    for (int b = 0; b < 5; b++)
+        masks.push_back(1ULL << (6 + b));
+
+    AddrRangeMap<int> map;
+    for (int c = 0; c < 32; c++)
+        map.insert(AddrRange(0x100000, 0x500000, masks, c), c);
+    map.insert(RangeSize(0x800000, 0x1000), 100);
+
+    AddrRangeDecoder<int> decoder;
+    decoder.build(map);
+    EXPECT_EQ(*decoder.contains(0x100000 + 5 * 64), 5);
+    EXPECT_EQ(*decoder.contains(0x800010), 100);
+
+    checkAgainstMap(map, 0x900000);
+}
+
+/** Channels selected by XOR hashes of several address bits. */
+TEST(AddrRangeDecoderTest, HashedInterleaving)
+{
+    const std::vector<Addr> masks = {
+        (1ULL << 8) | (1ULL << 13) | (1ULL << 20),
+        (1ULL << 9) | (1ULL << 14) | (1ULL << 21),
+        (1ULL << 10) | (1ULL << 15),
+    };
+
+    AddrRangeMap<int> map;
+    for (int c = 0; c < 8; c++)
+        map.insert(AddrRange(0, 0x4000000, masks, c), c);
+
+    checkAgainstMap(map, 0x5000000);
+}
+
+/** Interleaved ranges missing some of their stripes. */
+TEST(AddrRangeDecoderTest, PartialInterleaving)
+{
+    const std::vector<Addr> masks = {1ULL << 12, 1ULL << 13};
+
+    AddrRangeMap<int> map;
+    map.insert(AddrRange(0, 0x100000, masks, 0), 0);
+    map.insert(AddrRange(0, 0x100000, masks, 2), 2);
+
+    AddrRangeDecoder<int> decoder;
+    decoder.build(map);
+    EXPECT_EQ(*decoder.contains(0x0), 0);
+    EXPECT_EQ(decoder.contains(0x1000), nullptr);
+    EXPECT_EQ(*decoder.contains(0x2000), 2);
+
+    checkAgainstMap(map, 0x200000);
+}
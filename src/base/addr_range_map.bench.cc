@@ -0,0 +1,106 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/addr_range_decoder.hh"
+#include "base/addr_range_map.hh"
+#include "base/microbench.hh"
+
+using namespace gem5;
+
+/**
+ * Look up random addresses in a map of contiguous ranges, as a crossbar
+ * routing requests to its memory-side ports does.
+ */
+static void
+addrRangeMapLookup(microbench::State &state)
+{
+    const Addr num_ranges = state.range();
+    const Addr range_size = 0x100000;
+
+    AddrRangeMap<int> map;
+    for (Addr i = 0; i < num_ranges; i++)
+        map.insert(RangeSize(i * range_size, range_size), (int)i);
+
+    uint64_t lfsr = 0xace1;
+    for (auto _ : state) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xd0000001u);
+        const Addr addr = lfsr % (num_ranges * range_size);
+        microbench::doNotOptimize(map.contains(addr));
+    }
+}
+GEM5_BENCHMARK(addrRangeMapLookup)->arg(4)->arg(64)->arg(1024);
+
+/** Line-sized ranges spread over channels interleaved at line granularity. */
+template <typename Lookup>
+static void
+interleavedLookup(microbench::State &state, Lookup lookup)
+{
+    uint64_t lfsr = 0xace1;
+    for (auto _ : state) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xd0000001u);
+        const Addr addr = (lfsr << 6) % 0x40000000;
+        microbench::doNotOptimize(lookup(RangeSize(addr, 64)));
+    }
+}
+
+static AddrRangeMap<int, 3>
+interleavedMap(unsigned channels)
+{
+    std::vector<Addr> masks;
+    for (unsigned b = 0; (1U << b) < channels; b++)
+        masks.push_back(1ULL << (6 + b));
+
+    AddrRangeMap<int, 3> map;
+    for (unsigned c = 0; c < channels; c++)
+        map.insert(AddrRange(0, 0x40000000, masks, c), c);
+    return map;
+}
+
+/** The crossbar's range map, with its MRU cache of three entries. */
+static void
+addrRangeMapInterleaved(microbench::State &state)
+{
+    const auto map = interleavedMap(state.range());
+    interleavedLookup(state, [&map](const AddrRange &r) {
+        return map.contains(r)->second;
+    });
+}
+GEM5_BENCHMARK(addrRangeMapInterleaved)->arg(2)->arg(8)->arg(32)->arg(128);
+
+static void
+addrRangeDecoderInterleaved(microbench::State &state)
+{
+    AddrRangeDecoder<int> decoder;
+    decoder.build(interleavedMap(state.range()));
+    interleavedLookup(state, [&decoder](const AddrRange &r) {
+        return *decoder.contains(r);
+    });
+}
+GEM5_BENCHMARK(addrRangeDecoderInterleaved)->arg(2)->arg(8)->arg(32)->arg(128);
@@ -0,0 +1,423 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_trace.hh"
+
+#include <atomic>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+namespace
+{
+
+/** Tells loggers apart in the per-thread cache, even at one address */
+std::atomic<uint64_t> nextLoggerId(1);
+
+struct StateCache
+{
+    uint64_t loggerId = 0;
+    void *state = nullptr;
+};
+
+thread_local StateCache stateCache;
+
+template <typename T>
+void
+putValue(std::vector<uint8_t> &buf, const T &value)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    buf.insert(buf.end(), bytes, bytes + sizeof(T));
+}
+
+void
+putString(std::vector<uint8_t> &buf, const char *str, uint32_t len)
+{
+    putValue(buf, len);
+    buf.insert(buf.end(), str, str + len);
+}
+
+/** Bounds checked reads from a chunk */
+class ChunkReader
+{
+  public:
+    ChunkReader(const std::vector<uint8_t> &chunk)
+        : ptr(chunk.data()), end(chunk.data() + chunk.size())
+    {}
+
+    bool done() const { return ptr == end; }
+
+    template <typename T>
+    T
+    get()
+    {
+        fatal_if(end - ptr < (ptrdiff_t)sizeof(T),
+                 "Binary debug trace is truncated.\n");
+        T value;
+        std::memcpy(&value, ptr, sizeof(T));
+        ptr += sizeof(T);
+        return value;
+    }
+
+    std::string
+    getString()
+    {
+        const uint32_t len = get<uint32_t>();
+        fatal_if(end - ptr < (ptrdiff_t)len,
+                 "Binary debug trace is truncated.\n");
+        std::string str((const char *)ptr, len);
+        ptr += len;
+        return str;
+    }
+
+  private:
+    const uint8_t *ptr;
+    const uint8_t *end;
+};
+
+const std::string &
+lookup(const std::unordered_map<uint32_t, std::string> &map, uint32_t id)
+{
+    auto it = map.find(id);
+    fatal_if(it == map.end(), "Binary debug trace uses undefined ID %d.\n",
+             id);
+    return it->second;
+}
+
+void
+addArg(cp::Print &print, ChunkReader &reader)
+{
+    const auto type = reader.get<uint8_t>();
+    const auto size = reader.get<uint8_t>();
+    const bool sign = type == raw_arg::Signed;
+
+    switch (type) {
+      case raw_arg::Bool:
+        print.addArg(reader.get<bool>());
+        return;
+      case raw_arg::Char:
+        print.addArg(reader.get<char>());
+        return;
+      case raw_arg::Float:
+        print.addArg(reader.get<double>());
+        return;
+      case raw_arg::String:
+        print.addArg(reader.getString());
+        return;
+      case raw_arg::Signed:
+      case raw_arg::Unsigned:
+        switch (size) {
+          case 1:
+            return sign ? print.addArg(reader.get<signed char>()) :
+                print.addArg(reader.get<unsigned char>());
+          case 2:
+            return sign ? print.addArg(reader.get<int16_t>()) :
+                print.addArg(reader.get<uint16_t>());
+          case 4:
+            return sign ? print.addArg(reader.get<int32_t>()) :
+                print.addArg(reader.get<uint32_t>());
+          case 8:
+            return sign ? print.addArg(reader.get<int64_t>()) :
+                print.addArg(reader.get<uint64_t>());
+        }
+        break;
+    }
+    fatal("Binary debug trace has an argument of type %d, size %d.\n",
+          type, size);
+}
+
+} // anonymous namespace
+
+constexpr char BinaryLogger::Magic[8];
+
+BinaryLogger::BinaryLogger(const std::string &filename,
+                           size_t chunk_bytes, size_t max_chunks)
+    : chunkBytes(chunk_bytes), maxChunks(std::max<size_t>(max_chunks, 1)),
+      file(filename, std::ios::out | std::ios::binary | std::ios::trunc),
+      writing(false), stopWriter(false),
+      lineBuf(*this), lineStream(&lineBuf),
+      loggerId(nextLoggerId++)
+{
+    panic_if(!file.good(), "Could not open %s for writing\n", filename);
+
+    const uint32_t version = 1;
+    const uint32_t reserved = 0;
+    file.write(Magic, sizeof(Magic));
+    file.write((const char *)&version, sizeof(version));
+    file.write((const char *)&reserved, sizeof(reserved));
+
+    recordsRaw = true;
+    writer = std::thread(&BinaryLogger::writerMain, this);
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(chunksMutex);
+        stopWriter = true;
+    }
+    chunksCond.notify_all();
+    writer.join();
+}
+
+BinaryLogger::ThreadState &
+BinaryLogger::state()
+{
+    if (stateCache.loggerId == loggerId)
+        return *static_cast<ThreadState *>(stateCache.state);
+
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    threads.emplace_back(new ThreadState);
+    ThreadState &s = *threads.back();
+    s.index = threads.size() - 1;
+    s.buf.reserve(chunkBytes);
+    stateCache.loggerId = loggerId;
+    stateCache.state = &s;
+    return s;
+}
+
+uint32_t
+BinaryLogger::formatId(ThreadState &s, const char *fmt)
+{
+    // Formats are nearly always literals, so their address identifies
+    // them. The text is compared as well in case it was a buffer.
+    auto it = s.formats.find(fmt);
+    if (it != s.formats.end() && it->second.second == fmt)
+        return it->second.first;
+
+    const uint32_t id = s.nextFormatId++;
+    const uint32_t len = std::strlen(fmt);
+    s.buf.push_back(DefineFormat);
+    putValue(s.buf, id);
+    putString(s.buf, fmt, len);
+    s.formats[fmt] = {id, std::string(fmt, len)};
+    return id;
+}
+
+uint32_t
+BinaryLogger::stringId(ThreadState &s, const std::string &str)
+{
+    auto it = s.strings.find(str);
+    if (it != s.strings.end())
+        return it->second;
+
+    const uint32_t id = s.strings.size();
+    s.buf.push_back(DefineString);
+    putValue(s.buf, id);
+    putString(s.buf, str.data(), str.size());
+    s.strings.emplace(str, id);
+    return id;
+}
+
+std::vector<uint8_t> &
+BinaryLogger::beginRaw(Tick when, const std::string &name,
+                       const std::string &flag, const char *fmt,
+                       unsigned num_args)
+{
+    ThreadState &s = state();
+    const uint32_t fmt_id = formatId(s, fmt);
+    const uint32_t name_id = stringId(s, name);
+    const uint32_t flag_id = stringId(s, flag);
+
+    s.buf.push_back(Message);
+    putValue(s.buf, (uint64_t)when);
+    putValue(s.buf, fmt_id);
+    putValue(s.buf, name_id);
+    putValue(s.buf, flag_id);
+    s.buf.push_back(num_args);
+    return s.buf;
+}
+
+void
+BinaryLogger::endRaw()
+{
+    ThreadState &s = state();
+    if (s.buf.size() >= chunkBytes)
+        submit(s);
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!isEnabled(name))
+        return;
+
+    std::vector<uint8_t> &buf = beginRaw(when, name, flag, "%s", 1);
+    raw_arg::put(buf, message);
+    endRaw();
+}
+
+int
+BinaryLogger::LineBuf::overflow(int c)
+{
+    if (c == traits_type::eof())
+        return c;
+
+    line.push_back(c);
+    if (c == '\n') {
+        logger.logMessage(MaxTick, "", "", line);
+        line.clear();
+    }
+    return c;
+}
+
+void
+BinaryLogger::submit(ThreadState &s)
+{
+    std::unique_lock<std::mutex> lock(chunksMutex);
+    chunksCond.wait(lock, [this]{ return chunks.size() < maxChunks; });
+    chunks.emplace_back(s.index, std::move(s.buf));
+    lock.unlock();
+    chunksCond.notify_all();
+
+    s.buf = std::vector<uint8_t>();
+    s.buf.reserve(chunkBytes);
+}
+
+void
+BinaryLogger::flush()
+{
+    {
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        for (auto &s : threads) {
+            if (!s->buf.empty())
+                submit(*s);
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(chunksMutex);
+    chunksCond.wait(lock, [this]{ return chunks.empty() && !writing; });
+    file.flush();
+}
+
+void
+BinaryLogger::writerMain()
+{
+    std::unique_lock<std::mutex> lock(chunksMutex);
+    while (true) {
+        chunksCond.wait(lock, [this]{
+            return !chunks.empty() || stopWriter;
+        });
+        if (chunks.empty())
+            return;
+
+        auto chunk = std::move(chunks.front());
+        chunks.pop_front();
+        writing = true;
+        lock.unlock();
+        chunksCond.notify_all();
+
+        const uint32_t index = chunk.first;
+        const uint64_t size = chunk.second.size();
+        file.write((const char *)&index, sizeof(index));
+        file.write((const char *)&size, sizeof(size));
+        file.write((const char *)chunk.second.data(), size);
+
+        lock.lock();
+        writing = false;
+        chunksCond.notify_all();
+    }
+}
+
+bool
+decodeBinaryTrace(std::istream &in, std::ostream &out)
+{
+    char magic[sizeof(BinaryLogger::Magic)];
+    uint32_t version, reserved;
+    if (!in.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, BinaryLogger::Magic, sizeof(magic)) != 0 ||
+        !in.read((char *)&version, sizeof(version)) ||
+        !in.read((char *)&reserved, sizeof(reserved)) || version != 1) {
+        return false;
+    }
+
+    struct Names
+    {
+        std::unordered_map<uint32_t, std::string> formats;
+        std::unordered_map<uint32_t, std::string> strings;
+    };
+    std::unordered_map<uint32_t, Names> threads;
+    OstreamLogger logger(out);
+
+    uint32_t index;
+    uint64_t size;
+    std::vector<uint8_t> chunk;
+    while (in.read((char *)&index, sizeof(index))) {
+        fatal_if(!in.read((char *)&size, sizeof(size)),
+                 "Binary debug trace is truncated.\n");
+        chunk.resize(size);
+        fatal_if(!in.read((char *)chunk.data(), size),
+                 "Binary debug trace is truncated.\n");
+
+        Names &names = threads[index];
+        ChunkReader reader(chunk);
+        while (!reader.done()) {
+            const auto kind = reader.get<uint8_t>();
+            if (kind == BinaryLogger::DefineFormat) {
+                const auto id = reader.get<uint32_t>();
+                names.formats[id] = reader.getString();
+            } else if (kind == BinaryLogger::DefineString) {
+                const auto id = reader.get<uint32_t>();
+                names.strings[id] = reader.getString();
+            } else if (kind == BinaryLogger::Message) {
+                const Tick when = reader.get<uint64_t>();
+                const std::string &fmt =
+                    lookup(names.formats,
+                                        reader.get<uint32_t>());
+                const std::string &name =
+                    lookup(names.strings,
+                                        reader.get<uint32_t>());
+                const std::string &flag =
+                    lookup(names.strings,
+                                        reader.get<uint32_t>());
+                const auto num_args = reader.get<uint8_t>();
+
+                std::ostringstream line;
+                {
+                    cp::Print print(line, fmt);
+                    for (unsigned i = 0; i < num_args; i++)
+                        addArg(print, reader);
+                    print.endArgs();
+                }
+                logger.logMessage(when, name, flag, line.str());
+            } else {
+                fatal("Binary debug trace has a record of kind %d.\n",
+                      kind);
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace trace
+} // namespace gem5
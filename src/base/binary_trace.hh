@@ -0,0 +1,172 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A debug logger that records messages in a binary trace instead of
+ * formatting them, and the decoder that renders such a trace as text.
+ *
+ * Every thread logs into its own buffer: a message is the ID of its
+ * format string, the IDs of its object name and flag, and the raw
+ * arguments. Format strings and names are defined in the buffer the
+ * first time a thread uses them. Full buffers are handed to a writer
+ * thread that appends them to the trace as chunks. The messages of a
+ * thread stay in order, while chunks of different threads interleave.
+ */
+
+#ifndef __BASE_BINARY_TRACE_HH__
+#define __BASE_BINARY_TRACE_HH__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/trace.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+class BinaryLogger : public Logger
+{
+  public:
+    /** Identifies a binary debug trace, version 1. */
+    static constexpr char Magic[8] = {'g', '5', 'd', 'b', 'g', 't', 'r', '1'};
+
+    /** Record kinds in a chunk */
+    enum Kind : uint8_t
+    {
+        DefineFormat,
+        DefineString,
+        Message,
+    };
+
+    /**
+     * @param filename Path to the trace to create or truncate
+     * @param chunk_bytes Size at which a thread hands its buffer over
+     * @param max_chunks Chunks queued before logging threads wait
+     */
+    BinaryLogger(const std::string &filename,
+                 size_t chunk_bytes = 1 << 20, size_t max_chunks = 16);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    /** Text written here is logged as a message once a line is full. */
+    std::ostream &getOstream() override { return lineStream; }
+
+    /**
+     * Write out the buffers of all threads and wait for the writer.
+     * The other logging threads must be idle.
+     */
+    void flush();
+
+  protected:
+    std::vector<uint8_t> &beginRaw(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            unsigned num_args) override;
+    void endRaw() override;
+
+  private:
+    struct ThreadState
+    {
+        uint32_t index;
+        std::vector<uint8_t> buf;
+        uint32_t nextFormatId = 0;
+        /** Format IDs by string address, with the string to check */
+        std::unordered_map<const char *,
+                           std::pair<uint32_t, std::string>> formats;
+        std::unordered_map<std::string, uint32_t> strings;
+    };
+
+    /** Gathers text written to getOstream() into messages */
+    class LineBuf : public std::streambuf
+    {
+      public:
+        LineBuf(BinaryLogger &_logger) : logger(_logger) {}
+
+      protected:
+        int overflow(int c) override;
+
+      private:
+        BinaryLogger &logger;
+        std::string line;
+    };
+
+    ThreadState &state();
+    uint32_t formatId(ThreadState &s, const char *fmt);
+    uint32_t stringId(ThreadState &s, const std::string &str);
+    void submit(ThreadState &s);
+    void writerMain();
+
+    const size_t chunkBytes;
+    const size_t maxChunks;
+
+    std::ofstream file;
+
+    /** The state of every thread that logged, by thread index */
+    std::vector<std::unique_ptr<ThreadState>> threads;
+    std::mutex threadsMutex;
+
+    /** Chunks waiting for the writer, with their thread index */
+    std::deque<std::pair<uint32_t, std::vector<uint8_t>>> chunks;
+    std::mutex chunksMutex;
+    std::condition_variable chunksCond;
+    bool writing;
+    bool stopWriter;
+    std::thread writer;
+
+    LineBuf lineBuf;
+    std::ostream lineStream;
+
+    /** Finds this logger's state in the cache of each thread */
+    const uint64_t loggerId;
+};
+
+/**
+ * Render a binary debug trace as the text an OstreamLogger would have
+ * written for the same messages.
+ *
+ * @return False if the input is not a binary debug trace
+ */
+bool decodeBinaryTrace(std::istream &in, std::ostream &out);
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __BASE_BINARY_TRACE_HH__
@@ -0,0 +1,169 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "base/binary_trace.hh"
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/trace.hh"
+
+using namespace gem5;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+std::string
+tracePath(const std::string &name)
+{
+    return testing::TempDir() + "binary_trace_" + name;
+}
+
+std::string
+decode(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream out;
+    EXPECT_TRUE(trace::decodeBinaryTrace(in, out));
+    return out.str();
+}
+
+/** Log the same messages to the given logger */
+void
+logMessages(trace::Logger &logger, int count)
+{
+    const std::string name("system.cpu");
+    const std::string object_name("object");
+    for (int i = 0; i < count; i++) {
+        logger.dprintf_flag(i, name, "Flag", "plain message\n");
+        logger.dprintf_flag(i, name, "Flag", "%d %u %#x %c %s\n",
+                            -i, (unsigned)i, (uint64_t)i << 40, 'a' + i % 26,
+                            true);
+        logger.dprintf_flag(i, name, "", "%08.3f %s %s\n", i / 3.0,
+                            "literal", object_name);
+        logger.dprintf(i, "", "%d %d %d\n", (int8_t)-i, (uint16_t)i,
+                       (int64_t)-i);
+    }
+}
+
+} // anonymous namespace
+
+/** Decoding must give the same text as logging to an ostream. */
+TEST(BinaryTraceTest, RoundTrip)
+{
+    std::ostringstream expected;
+    trace::OstreamLogger text_logger(expected);
+    logMessages(text_logger, 100);
+
+    const std::string path = tracePath("round_trip");
+    {
+        trace::BinaryLogger logger(path);
+        logMessages(logger, 100);
+    }
+    ASSERT_EQ(decode(path), expected.str());
+}
+
+/** Small chunks must repeat nothing that was defined earlier. */
+TEST(BinaryTraceTest, SmallChunks)
+{
+    std::ostringstream expected;
+    trace::OstreamLogger text_logger(expected);
+    logMessages(text_logger, 100);
+
+    const std::string path = tracePath("small_chunks");
+    {
+        trace::BinaryLogger logger(path, 16, 1);
+        logMessages(logger, 100);
+    }
+    ASSERT_EQ(decode(path), expected.str());
+}
+
+/** Already formatted messages and the ostream are recorded as text. */
+TEST(BinaryTraceTest, TextMessages)
+{
+    std::ostringstream expected;
+    trace::OstreamLogger text_logger(expected);
+    text_logger.logMessage(10, "name", "Flag", "formatted\n");
+
+    const std::string path = tracePath("text");
+    {
+        trace::BinaryLogger logger(path);
+        logger.logMessage(10, "name", "Flag", "formatted\n");
+        logger.getOstream() << "first " << 2 << " line\n" << "second\n";
+    }
+    ASSERT_EQ(decode(path), expected.str() + "first 2 line\nsecond\n");
+}
+
+/** The messages of each thread must stay in order. */
+TEST(BinaryTraceTest, Threads)
+{
+    const std::string path = tracePath("threads");
+    {
+        trace::BinaryLogger logger(path, 64);
+        auto log = [&logger](const std::string &name) {
+            for (int i = 0; i < 1000; i++)
+                logger.dprintf(i, name, "%d\n", i);
+        };
+        std::thread first(log, "first");
+        std::thread second(log, "second");
+        first.join();
+        second.join();
+    }
+
+    std::istringstream lines(decode(path));
+    std::string line;
+    int next_first = 0, next_second = 0;
+    while (std::getline(lines, line)) {
+        std::ostringstream first, second;
+        trace::OstreamLogger first_logger(first), second_logger(second);
+        first_logger.dprintf(next_first, "first", "%d", next_first);
+        second_logger.dprintf(next_second, "second", "%d", next_second);
+        if (line == first.str()) {
+            next_first++;
+        } else {
+            ASSERT_EQ(line, second.str());
+            next_second++;
+        }
+    }
+    ASSERT_EQ(next_first, 1000);
+    ASSERT_EQ(next_second, 1000);
+}
+
+/** Other files must be rejected. */
+TEST(BinaryTraceTest, NotATrace)
+{
+    std::istringstream in("0: system.cpu: text trace\n");
+    std::ostringstream out;
+    ASSERT_FALSE(trace::decodeBinaryTrace(in, out));
+    ASSERT_TRUE(out.str().empty());
+}
@@ -84,6 +84,12 @@ class AssociativeCache : public Named
 
     const ::gem5::debug::SimpleFlag* debugFlag = nullptr;
 
+    /**
+     * Container reused for the possible entries of an access, so that
+     * lookups do not allocate.
+     */
+    mutable std::vector<ReplaceableEntry*> candidates;
+
   private:
 
     void
@@ -216,7 +222,7 @@ class AssociativeCache : public Named
     virtual Entry*
     findEntry(const KeyType &key) const
     {
-        auto candidates = indexingPolicy->getPossibleEntries(key);
+        indexingPolicy->getPossibleEntries(key, candidates);
 
         for (auto candidate : candidates) {
             Entry *entry = static_cast<Entry*>(candidate);
@@ -236,7 +242,7 @@ class AssociativeCache : public Named
     virtual Entry*
     findVictim(const KeyType &key)
     {
-        auto candidates = indexingPolicy->getPossibleEntries(key);
+        indexingPolicy->getPossibleEntries(key, candidates);
 
         auto victim = static_cast<Entry*>(replPolicy->getVictim(candidates));
 
@@ -0,0 +1,66 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/circular_queue.hh"
+#include "base/microbench.hh"
+
+using namespace gem5;
+
+/** Steady-state push and pop of a queue kept half full. */
+static void
+circularQueuePushPop(microbench::State &state)
+{
+    const size_t capacity = state.range();
+    CircularQueue<uint64_t> queue(capacity);
+    for (size_t i = 0; i < capacity / 2; i++)
+        queue.push_back(i);
+
+    uint64_t v = 0;
+    for (auto _ : state) {
+        queue.push_back(v++);
+        microbench::doNotOptimize(queue.front());
+        queue.pop_front();
+    }
+}
+GEM5_BENCHMARK(circularQueuePushPop)->arg(8)->arg(64)->arg(1024);
+
+/** Walk a full queue with its iterators, as the LSQ and ROB do. */
+static void
+circularQueueIterate(microbench::State &state)
+{
+    const size_t capacity = state.range();
+    CircularQueue<uint64_t> queue(capacity);
+    for (size_t i = 0; i < capacity; i++)
+        queue.push_back(i);
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (auto it = queue.begin(); it != queue.end(); ++it)
+            sum += *it;
+        microbench::doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * capacity);
+}
+GEM5_BENCHMARK(circularQueueIterate)->arg(64)->arg(1024);
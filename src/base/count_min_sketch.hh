@@ -0,0 +1,140 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_COUNT_MIN_SKETCH_HH__
+#define __BASE_COUNT_MIN_SKETCH_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+/**
+ * A Count-Min sketch of saturating counters, to estimate how often
+ * keys out of a large space occur using a fixed amount of storage.
+ *
+ * Each key hashes to one counter in each of depth rows. Estimates are
+ * the minimum of those counters and can only over-estimate the real
+ * count, by at most 2N/width with probability 1 - 2^-depth for N
+ * insertions. The counters can be aged by halving them.
+ */
+template <typename Counter = uint16_t>
+class CountMinSketch
+{
+  private:
+    const unsigned width;
+    const unsigned depth;
+    const unsigned widthBits;
+    std::vector<Counter> counters;
+
+    static constexpr Counter maxCount = std::numeric_limits<Counter>::max();
+
+    size_t
+    index(unsigned row, uint64_t key) const
+    {
+        // Multiply-shift hashing, with an odd multiplier per row
+        static constexpr uint64_t seeds[] = {
+            0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL,
+            0x165667b19e3779f9ULL, 0xd6e8feb86659fd93ULL,
+            0xff51afd7ed558ccdULL, 0xc4ceb9fe1a85ec53ULL,
+            0x94d049bb133111ebULL, 0xbf58476d1ce4e5b9ULL,
+        };
+        const uint64_t h = (key ^ (key >> 29)) * seeds[row];
+        const size_t col = widthBits ? h >> (64 - widthBits) : 0;
+        return size_t(row) * width + col;
+    }
+
+  public:
+    /**
+     * @param width Number of counters per row, a power of 2
+     * @param depth Number of rows, at most 8
+     */
+    CountMinSketch(unsigned width, unsigned depth)
+        : width(width), depth(depth), widthBits(floorLog2(width)),
+          counters(size_t(width) * depth, 0)
+    {
+        fatal_if(!isPowerOf2(width),
+                 "Count-Min sketch width must be a power of 2");
+        fatal_if(depth == 0 || depth > 8,
+                 "Count-Min sketch depth must be between 1 and 8");
+    }
+
+    /**
+     * Count an occurrence of a key.
+     *
+     * Only the counters at the current minimum are incremented
+     * (conservative update), which tightens the estimates of keys
+     * sharing those counters.
+     *
+     * @return The estimated count of the key, including this one
+     */
+    Counter
+    add(uint64_t key)
+    {
+        const Counter est = estimate(key);
+        if (est == maxCount)
+            return est;
+        for (unsigned row = 0; row < depth; row++) {
+            Counter &c = counters[index(row, key)];
+            if (c == est)
+                c++;
+        }
+        return est + 1;
+    }
+
+    /** Estimated count of a key. */
+    Counter
+    estimate(uint64_t key) const
+    {
+        Counter est = maxCount;
+        for (unsigned row = 0; row < depth; row++)
+            est = std::min(est, counters[index(row, key)]);
+        return est;
+    }
+
+    /** Halve all counters, so that old occurrences fade out. */
+    void
+    decay()
+    {
+        for (auto &c : counters)
+            c >>= 1;
+    }
+
+    void
+    clear()
+    {
+        std::fill(counters.begin(), counters.end(), 0);
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_COUNT_MIN_SKETCH_HH__
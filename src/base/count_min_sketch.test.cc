@@ -0,0 +1,88 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "base/count_min_sketch.hh"
+
+using namespace gem5;
+
+TEST(CountMinSketchTest, Empty)
+{
+    CountMinSketch<> s(64, 4);
+    EXPECT_EQ(s.estimate(0), 0);
+    EXPECT_EQ(s.estimate(12345), 0);
+}
+
+TEST(CountMinSketchTest, SingleKey)
+{
+    CountMinSketch<> s(64, 4);
+    for (int i = 1; i <= 10; i++)
+        EXPECT_EQ(s.add(42), i);
+    EXPECT_EQ(s.estimate(42), 10);
+}
+
+/** Estimates never fall below the real count. */
+TEST(CountMinSketchTest, NeverUnderestimates)
+{
+    CountMinSketch<> s(16, 2);
+    for (uint64_t key = 0; key < 100; key++) {
+        for (uint64_t i = 0; i <= key % 7; i++)
+            s.add(key);
+    }
+    for (uint64_t key = 0; key < 100; key++)
+        EXPECT_GE(s.estimate(key), key % 7 + 1);
+}
+
+/** A hot key stands out from many cold ones. */
+TEST(CountMinSketchTest, HotKey)
+{
+    CountMinSketch<> s(1024, 4);
+    for (uint64_t key = 0; key < 1000; key++)
+        s.add(key << 12);
+    for (int i = 0; i < 100; i++)
+        s.add(0x1234000);
+    EXPECT_GE(s.estimate(0x1234000), 100);
+    EXPECT_LT(s.estimate(5 << 12), 10);
+}
+
+TEST(CountMinSketchTest, Saturates)
+{
+    CountMinSketch<uint8_t> s(8, 1);
+    for (int i = 0; i < 300; i++)
+        s.add(7);
+    EXPECT_EQ(s.estimate(7), 255);
+}
+
+TEST(CountMinSketchTest, DecayAndClear)
+{
+    CountMinSketch<> s(64, 4);
+    for (int i = 0; i < 9; i++)
+        s.add(3);
+    s.decay();
+    EXPECT_EQ(s.estimate(3), 4);
+    s.clear();
+    EXPECT_EQ(s.estimate(3), 0);
+}
@@ -129,6 +129,31 @@ Flag::globalDisable()
         i.second->sync();
 }
 
+void
+Flag::setSampleRate(uint64_t rate)
+{
+    _sampleRate = std::max<uint64_t>(rate, 1);
+    _sampleCount = 0;
+    updateLimited();
+}
+
+void
+Flag::setAddrRange(uint64_t start, uint64_t end)
+{
+    panic_if(start >= end, "Empty address range for flag %s.", _name);
+    _addrStart = start;
+    _addrEnd = end;
+    updateLimited();
+}
+
+void
+Flag::clearAddrRange()
+{
+    _addrStart = 0;
+    _addrEnd = UINT64_MAX;
+    updateLimited();
+}
+
 SimpleFlag::SimpleFlag(const char *name, const char *desc, bool is_format)
   : Flag(name, desc), _isFormat(is_format)
 {
@@ -151,6 +176,30 @@ CompoundFlag::disable()
         k->disable();
 }
 
+void
+CompoundFlag::setSampleRate(uint64_t rate)
+{
+    Flag::setSampleRate(rate);
+    for (auto& k : _kids)
+        k->setSampleRate(rate);
+}
+
+void
+CompoundFlag::setAddrRange(uint64_t start, uint64_t end)
+{
+    Flag::setAddrRange(start, end);
+    for (auto& k : _kids)
+        k->setAddrRange(start, end);
+}
+
+void
+CompoundFlag::clearAddrRange()
+{
+    Flag::clearAddrRange();
+    for (auto& k : _kids)
+        k->clearAddrRange();
+}
+
 AllFlagsFlag::AllFlagsFlag() : CompoundFlag("All",
         "Controls all debug flags. It should not be used within C++ code.", {})
 {}
@@ -42,6 +42,7 @@
 #ifndef __BASE_DEBUG_HH__
 #define __BASE_DEBUG_HH__
 
+#include <cstdint>
 #include <initializer_list>
 #include <iostream>
 #include <map>
@@ -68,8 +69,33 @@ class Flag
     const char *_name;
     const char *_desc;
 
+    /** Set when sampling or an address range limits the messages */
+    bool _limited = false;
+    /** Trace one in this many checks of the flag */
+    uint64_t _sampleRate = 1;
+    mutable uint64_t _sampleCount = 0;
+    /** Trace addressed messages in [_addrStart, _addrEnd) only */
+    uint64_t _addrStart = 0;
+    uint64_t _addrEnd = UINT64_MAX;
+
     virtual void sync() { }
 
+    void
+    updateLimited()
+    {
+        _limited = _sampleRate > 1 || _addrStart != 0 ||
+            _addrEnd != UINT64_MAX;
+    }
+
+    bool
+    sample() const
+    {
+        if (++_sampleCount < _sampleRate)
+            return false;
+        _sampleCount = 0;
+        return true;
+    }
+
   public:
     Flag(const char *name, const char *desc);
     virtual ~Flag();
@@ -82,7 +108,37 @@ class Flag
     virtual void enable() = 0;
     virtual void disable() = 0;
 
-    operator bool() const { return tracing(); }
+    /**
+     * Whether a message should be traced now. This is tracing(),
+     * thinned out by the sample rate.
+     */
+    operator bool() const { return tracing() && (!_limited || sample()); }
+
+    /**
+     * Whether a message about an address, or a PC, should be traced
+     * now. Addresses outside of the address range are not sampled.
+     */
+    bool
+    tracing(uint64_t addr) const
+    {
+        if (!tracing())
+            return false;
+        if (!_limited)
+            return true;
+        return addr >= _addrStart && addr < _addrEnd && sample();
+    }
+
+    uint64_t sampleRate() const { return _sampleRate; }
+
+    /** Trace only one in every rate checks, 1 traces all of them. */
+    virtual void setSampleRate(uint64_t rate);
+
+    /**
+     * Drop the messages about addresses outside of [start, end).
+     * Messages without an address are not affected.
+     */
+    virtual void setAddrRange(uint64_t start, uint64_t end);
+    virtual void clearAddrRange();
 
     static void globalEnable();
     static void globalDisable();
@@ -131,6 +187,10 @@ class CompoundFlag : public Flag
 
     void enable() override;
     void disable() override;
+
+    void setSampleRate(uint64_t rate) override;
+    void setAddrRange(uint64_t start, uint64_t end) override;
+    void clearAddrRange() override;
 };
 
 class AllFlagsFlag : public CompoundFlag
@@ -148,6 +148,82 @@ TEST(DebugFlagTest, ConversionOperator)
     flag.disable();
 }
 
+/** Test that a sample rate lets one in every rate checks through. */
+TEST(DebugFlagTest, SampleRate)
+{
+    debug::Flag::globalEnable();
+    debug::SimpleFlag flag("FlagSampleRateTest", "");
+    flag.enable();
+    flag.setSampleRate(4);
+    ASSERT_EQ(flag.sampleRate(), 4);
+
+    int traced = 0;
+    for (int i = 0; i < 100; i++)
+        traced += (bool)flag;
+    ASSERT_EQ(traced, TRACING_ON ? 25 : 0);
+
+    // Sampling doesn't change whether the flag is tracing
+    ASSERT_TRUE(!TRACING_ON || flag.tracing());
+
+    flag.setSampleRate(1);
+    ASSERT_TRUE(!TRACING_ON || flag);
+    ASSERT_TRUE(!TRACING_ON || flag);
+    flag.disable();
+}
+
+/** Test that only addresses in the address range are traced. */
+TEST(DebugFlagTest, AddrRange)
+{
+    debug::Flag::globalEnable();
+    debug::SimpleFlag flag("FlagAddrRangeTest", "");
+    flag.enable();
+    flag.setAddrRange(0x1000, 0x2000);
+
+    ASSERT_FALSE(flag.tracing(0xfff));
+    ASSERT_TRUE(!TRACING_ON || flag.tracing(0x1000));
+    ASSERT_TRUE(!TRACING_ON || flag.tracing(0x1fff));
+    ASSERT_FALSE(flag.tracing(0x2000));
+    // Messages without an address are not filtered
+    ASSERT_TRUE(!TRACING_ON || flag);
+
+    // Addresses outside of the range don't count as samples
+    flag.setSampleRate(2);
+    ASSERT_FALSE(flag.tracing(0x1000));
+    ASSERT_FALSE(flag.tracing(0x3000));
+    ASSERT_TRUE(!TRACING_ON || flag.tracing(0x1000));
+
+    flag.clearAddrRange();
+    flag.setSampleRate(1);
+    ASSERT_TRUE(!TRACING_ON || flag.tracing(0x3000));
+    flag.disable();
+    ASSERT_FALSE(flag.tracing(0x1000));
+}
+
+/** Test that a compound flag limits its kids. */
+TEST(DebugCompoundFlagTest, SampleRateAddrRange)
+{
+    debug::SimpleFlag flag_a("CompoundFlagLimitsTestKidA", "");
+    debug::SimpleFlag flag_b("CompoundFlagLimitsTestKidB", "");
+    debug::CompoundFlag flag("CompoundFlagLimitsTest", "",
+        {&flag_a, &flag_b});
+
+    flag.setSampleRate(8);
+    ASSERT_EQ(flag.sampleRate(), 8);
+    ASSERT_EQ(flag_a.sampleRate(), 8);
+    ASSERT_EQ(flag_b.sampleRate(), 8);
+
+    debug::Flag::globalEnable();
+    flag.enable();
+    flag.setSampleRate(1);
+    flag.setAddrRange(0x100, 0x200);
+    ASSERT_FALSE(flag_a.tracing(0x80));
+    ASSERT_FALSE(flag_b.tracing(0x80));
+    ASSERT_TRUE(!TRACING_ON || flag_b.tracing(0x180));
+    flag.clearAddrRange();
+    ASSERT_TRUE(!TRACING_ON || flag_a.tracing(0x80));
+    flag.disable();
+}
+
 /**
  * Tests that manipulate the kids to change the enablement status of the
  * compound flag.
@@ -30,11 +30,11 @@
 #ifndef __BASE_FILTERS_BASE_HH__
 #define __BASE_FILTERS_BASE_HH__
 
-#include <vector>
+#include <cstddef>
 
 #include "base/compiler.hh"
 #include "base/intmath.hh"
-#include "base/sat_counter.hh"
+#include "base/sat_counter_array.hh"
 #include "base/types.hh"
 #include "params/BloomFilterBase.hh"
 #include "sim/sim_object.hh"
@@ -52,7 +52,7 @@ class Base : public SimObject
     const unsigned offsetBits;
 
     /** The filter itself. */
-    std::vector<SatCounter8> filter;
+    SatCounterArray filter;
 
     /** Number of bits needed to represent the size of the filter. */
     const int sizeBits;
@@ -66,7 +66,7 @@ class Base : public SimObject
      */
     Base(const BloomFilterBaseParams &p)
         : SimObject(p), offsetBits(p.offset_bits),
-          filter(p.size, SatCounter8(p.num_bits)),
+          filter(p.size, p.num_bits),
           sizeBits(floorLog2(p.size)), setThreshold(p.threshold)
     {
         clear();
@@ -78,9 +78,7 @@ class Base : public SimObject
      */
     virtual void clear()
     {
-        for (auto& entry : filter) {
-            entry.reset();
-        }
+        filter.reset();
     }
 
     /**
@@ -106,6 +104,22 @@ class Base : public SimObject
      */
     virtual void set(Addr addr) = 0;
 
+    /**
+     * Set the entries of a batch of addresses. Filters that can hash
+     * several addresses at once override this; by default the addresses
+     * are set one by one.
+     *
+     * @param addrs The addresses being parsed.
+     * @param num_addrs The number of addresses.
+     */
+    virtual void
+    setBatch(const Addr *addrs, std::size_t num_addrs)
+    {
+        for (std::size_t i = 0; i < num_addrs; ++i) {
+            set(addrs[i]);
+        }
+    }
+
     /**
      * Perform the filter specific function to clear the corresponding
      * entries (can be multiple) of an address. By default a bloom
@@ -136,6 +150,23 @@ class Base : public SimObject
      */
     virtual int getCount(Addr addr) const { return 0; }
 
+    /**
+     * Get the values stored in the filter entries of a batch of
+     * addresses. By default the addresses are looked up one by one.
+     *
+     * @param addrs The addresses being parsed.
+     * @param num_addrs The number of addresses.
+     * @param counts Output with the value of each of the addresses.
+     */
+    virtual void
+    getCountBatch(const Addr *addrs, std::size_t num_addrs,
+                  int *counts) const
+    {
+        for (std::size_t i = 0; i < num_addrs; ++i) {
+            counts[i] = getCount(addrs[i]);
+        }
+    }
+
     /**
      * Get the total value stored in the filter entries.
      *
@@ -143,11 +174,7 @@ class Base : public SimObject
      */
     virtual int getTotalCount() const
     {
-        int count = 0;
-        for (const auto& entry : filter) {
-            count += entry;
-        }
-        return count;
+        return filter.sum();
     }
 };
 
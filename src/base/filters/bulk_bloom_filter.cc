@@ -70,6 +70,20 @@ Bulk::hash(Addr addr, int hash_number) const
     return c;
 }
 
+void
+Bulk::hashAll(Addr addr, int *indices) const
+{
+    // The permutation is shared by all the sectors, so only do it once
+    addr = permute(addr);
+
+    const int sector_size = filter.size() / numHashes;
+    for (int i = 0; i < numHashes; i++) {
+        const int c = bits(addr, (offsetBits + (i + 1) * sectorBits) - 1,
+                           offsetBits + i * sectorBits);
+        indices[i] = c + (numHashes - 1 - i) * sector_size;
+    }
+}
+
 Addr
 Bulk::permute(Addr addr) const
 {
@@ -53,6 +53,7 @@ class Bulk : public MultiBitSel
 
   protected:
     int hash(Addr addr, int hash_number) const override;
+    void hashAll(Addr addr, int *indices) const override;
 
   private:
     /** Permutes the address to generate its signature. */
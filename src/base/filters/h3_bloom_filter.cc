@@ -386,10 +386,29 @@ H3::hash(Addr addr, int hash_number) const
         }
     }
 
-    if (isParallel) {
-        return (result % parFilterSize) + hash_number * parFilterSize;
-    } else {
-        return result % filter.size();
+    return filterIndex(result, hash_number);
+}
+
+void
+H3::hashAll(Addr addr, int *indices) const
+{
+    uint64_t val =
+        bits(addr, std::numeric_limits<Addr>::digits - 1, offsetBits);
+
+    // Each set bit of the address selects a row of the matrix, which
+    // holds that bit's contribution to every hash function. XORing whole
+    // rows computes all the functions at once, and lets the compiler
+    // vectorize the inner loop.
+    int results[16] = {};
+    for (; val; val &= val - 1) {
+        const int *row = H3Matrix[ctz64(val)];
+        for (int i = 0; i < 16; i++) {
+            results[i] ^= row[i];
+        }
+    }
+
+    for (int i = 0; i < numHashes; i++) {
+        indices[i] = filterIndex(results[i], i);
     }
 }
 
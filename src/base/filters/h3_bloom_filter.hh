@@ -52,6 +52,7 @@ class H3 : public MultiBitSel
 
   protected:
     int hash(Addr addr, int hash_number) const override;
+    void hashAll(Addr addr, int *indices) const override;
 };
 
 } // namespace bloom_filter
@@ -29,6 +29,7 @@
 
 #include "base/filters/multi_bit_sel_bloom_filter.hh"
 
+#include <algorithm>
 #include <limits>
 
 #include "base/bitfield.hh"
@@ -44,7 +45,8 @@ namespace bloom_filter
 MultiBitSel::MultiBitSel(const BloomFilterMultiBitSelParams &p)
     : Base(p), numHashes(p.num_hashes),
       parFilterSize(p.size / numHashes),
-      isParallel(p.is_parallel), skipBits(p.skip_bits)
+      isParallel(p.is_parallel), skipBits(p.skip_bits),
+      hashIndices(batchSize * numHashes)
 {
     if (p.size % numHashes) {
         fatal("Can't divide filter (%d) in %d equal portions", p.size,
@@ -59,21 +61,64 @@ MultiBitSel::~MultiBitSel()
 void
 MultiBitSel::set(Addr addr)
 {
+    hashAll(addr, hashIndices.data());
     for (int i = 0; i < numHashes; i++) {
-        filter[hash(addr, i)]++;
+        filter[hashIndices[i]]++;
+    }
+}
+
+void
+MultiBitSel::setBatch(const Addr *addrs, std::size_t num_addrs)
+{
+    for (std::size_t base = 0; base < num_addrs; base += batchSize) {
+        const std::size_t n = std::min(batchSize, num_addrs - base);
+        for (std::size_t a = 0; a < n; a++) {
+            hashAll(addrs[base + a], &hashIndices[a * numHashes]);
+        }
+        for (std::size_t i = 0; i < n * numHashes; i++) {
+            filter[hashIndices[i]]++;
+        }
     }
 }
 
 int
 MultiBitSel::getCount(Addr addr) const
 {
+    hashAll(addr, hashIndices.data());
     int count = 0;
-    for (int i=0; i < numHashes; i++) {
-        count += filter[hash(addr, i)];
+    for (int i = 0; i < numHashes; i++) {
+        count += filter[hashIndices[i]];
     }
     return count;
 }
 
+void
+MultiBitSel::getCountBatch(const Addr *addrs, std::size_t num_addrs,
+                           int *counts) const
+{
+    for (std::size_t base = 0; base < num_addrs; base += batchSize) {
+        const std::size_t n = std::min(batchSize, num_addrs - base);
+        for (std::size_t a = 0; a < n; a++) {
+            hashAll(addrs[base + a], &hashIndices[a * numHashes]);
+        }
+        for (std::size_t a = 0; a < n; a++) {
+            int count = 0;
+            for (int i = 0; i < numHashes; i++) {
+                count += filter[hashIndices[a * numHashes + i]];
+            }
+            counts[base + a] = count;
+        }
+    }
+}
+
+void
+MultiBitSel::hashAll(Addr addr, int *indices) const
+{
+    for (int i = 0; i < numHashes; i++) {
+        indices[i] = hash(addr, i);
+    }
+}
+
 int
 MultiBitSel::hash(Addr addr, int hash_number) const
 {
@@ -90,11 +135,7 @@ MultiBitSel::hash(Addr addr, int hash_number) const
         }
     }
 
-    if (isParallel) {
-        return (result % parFilterSize) + hash_number * parFilterSize;
-    } else {
-        return result % filter.size();
-    }
+    return filterIndex(result, hash_number);
 }
 
 } // namespace bloom_filter
@@ -30,6 +30,9 @@
 #ifndef __BASE_FILTERS_MULTI_BIT_SEL_BLOOM_FILTER_HH__
 #define __BASE_FILTERS_MULTI_BIT_SEL_BLOOM_FILTER_HH__
 
+#include <cstddef>
+#include <vector>
+
 #include "base/filters/base.hh"
 
 namespace gem5
@@ -51,7 +54,10 @@ class MultiBitSel : public Base
     ~MultiBitSel();
 
     void set(Addr addr) override;
+    void setBatch(const Addr *addrs, std::size_t num_addrs) override;
     int getCount(Addr addr) const override;
+    void getCountBatch(const Addr *addrs, std::size_t num_addrs,
+                       int *counts) const override;
 
   protected:
     /**
@@ -62,6 +68,31 @@ class MultiBitSel : public Base
      */
     virtual int hash(Addr addr, int hash_number) const;
 
+    /**
+     * Apply all the hash functions to an address. Hashes that share work
+     * between functions override this to compute them together.
+     *
+     * @param addr The address to hash.
+     * @param indices Output with the filter index of each hash function.
+     */
+    virtual void hashAll(Addr addr, int *indices) const;
+
+    /**
+     * Map the result of a hash function to its filter entry.
+     *
+     * @param result The value generated by the hash function.
+     * @param hash_number Index of the hash function used.
+     */
+    int
+    filterIndex(int result, int hash_number) const
+    {
+        if (isParallel) {
+            return (result % parFilterSize) + hash_number * parFilterSize;
+        } else {
+            return result % filter.size();
+        }
+    }
+
     /** Number of hashes. */
     const int numHashes;
 
@@ -77,6 +108,16 @@ class MultiBitSel : public Base
      * on larger than cache-line granularities, by skipping some bits.
      */
     const int skipBits;
+
+    /** Number of addresses hashed together by the batch functions. */
+    static constexpr std::size_t batchSize = 16;
+
+    /**
+     * Filter indices of the addresses being parsed. The batch functions
+     * compute the hashes of all the addresses of a batch before touching
+     * the filter.
+     */
+    mutable std::vector<int> hashIndices;
 };
 
 } // namespace bloom_filter
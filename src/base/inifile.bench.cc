@@ -0,0 +1,72 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/circular_queue.hh"
+
+#include <sstream>
+#include <string>
+
+#include "base/cprintf.hh"
+#include "base/inifile.hh"
+#include "base/microbench.hh"
+
+using namespace gem5;
+
+/**
+ * Load and search a config.ini shaped like a big generated system: many
+ * sections sharing the same keys and values.
+ */
+static void
+iniFileLoadLargeConfig(microbench::State &state)
+{
+    const int objects = state.range();
+    std::ostringstream os;
+    for (int i = 0; i < objects; i++) {
+        os << "[system.cpu" << i << "]\n"
+           << "type=TimingSimpleCPU\n"
+           << "children=dcache icache\n"
+           << "clk_domain=system.cpu_clk_domain\n"
+           << "cpu_id=" << i << "\n"
+           << "eventq_index=0\n"
+           << "numThreads=1\n"
+           << "power_state=system.cpu" << i << ".power_state\n"
+           << "system=system\n"
+           << "workload=\n\n";
+    }
+    const std::string config = os.str();
+
+    for (auto _ : state) {
+        std::istringstream ini(config);
+        IniFile simConfigDB;
+        simConfigDB.load(ini);
+        std::string value;
+        for (int i = 0; i < objects; i++) {
+            simConfigDB.find(csprintf("system.cpu%d", i), "cpu_id", value);
+            microbench::doNotOptimize(value);
+        }
+    }
+    state.setItemsProcessed(state.iterations() * objects);
+}
+GEM5_BENCHMARK(iniFileLoadLargeConfig)->arg(1000)->arg(50000);
@@ -31,7 +31,9 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/str.hh"
@@ -39,6 +41,43 @@
 namespace gem5
 {
 
+namespace
+{
+
+/// Strip the leading and trailing whitespace of a string.
+std::string_view
+trim(std::string_view str)
+{
+    const char *space = " \t\n\v\f\r";
+    const auto start = str.find_first_not_of(space);
+    if (start == std::string_view::npos)
+        return {};
+    const auto end = str.find_last_not_of(space);
+    return str.substr(start, end - start + 1);
+}
+
+} // anonymous namespace
+
+IniFile::StringId
+IniFile::StringPool::intern(std::string_view str)
+{
+    auto it = ids.find(str);
+    if (it != ids.end())
+        return it->second;
+
+    const StringId id = strings.size();
+    const std::string &stored = strings.emplace_back(str);
+    ids.emplace(stored, id);
+    return id;
+}
+
+IniFile::StringId
+IniFile::StringPool::find(std::string_view str) const
+{
+    auto it = ids.find(str);
+    return it == ids.end() ? None : it->second;
+}
+
 IniFile::IniFile()
 {}
 
@@ -55,81 +94,104 @@ IniFile::load(const std::string &file)
 
 
 const std::string &
-IniFile::Entry::getValue() const
+IniFile::getValue(const Entry &entry) const
 {
-    referenced = true;
-    return value;
+    entry.referenced = true;
+    return strings.get(entry.value);
 }
 
 
-void
-IniFile::Section::addEntry(const std::string &entryName,
-                           const std::string &value,
-                           bool append)
+IniFile::Entry *
+IniFile::Section::addEntry(StringId entryName)
 {
-    EntryTable::iterator ei = table.find(entryName);
-
-    if (ei == table.end()) {
-        // new entry
-        table.emplace(entryName, value);
-    }
-    else if (append) {
-        // append new reult to old entry
-        ei->second.appendValue(value);
-    }
-    else {
-        // override old entry
-        ei->second.setValue(value);
+    Entry *entry = findEntry(entryName);
+    if (entry)
+        return entry;
+
+    entries.push_back({entryName, StringPool::None, false});
+    if (!index.empty()) {
+        index.emplace(entryName, entries.size() - 1);
+    } else if (entries.size() == IndexThreshold) {
+        for (uint32_t i = 0; i < entries.size(); i++)
+            index.emplace(entries[i].name, i);
     }
+    return &entries.back();
 }
 
 
 bool
-IniFile::Section::add(const std::string &assignment)
+IniFile::addAssignment(Section &section, std::string_view assignment)
 {
-    std::string::size_type offset = assignment.find('=');
-    if (offset == std::string::npos) {
+    std::string_view::size_type offset = assignment.find('=');
+    if (offset == std::string_view::npos) {
         // no '=' found
         std::cerr << "Can't parse .ini line " << assignment << std::endl;
         return false;
     }
 
     // if "+=" rather than just "=" then append value
-    bool append = (assignment[offset-1] == '+');
-
-    std::string entryName = assignment.substr(0, append ? offset-1 : offset);
-    std::string value = assignment.substr(offset + 1);
+    bool append = offset > 0 && assignment[offset - 1] == '+';
 
-    eat_white(entryName);
-    eat_white(value);
+    std::string_view entryName =
+        trim(assignment.substr(0, append ? offset - 1 : offset));
+    std::string_view value = trim(assignment.substr(offset + 1));
 
-    addEntry(entryName, value, append);
+    Entry *entry = section.addEntry(strings.intern(entryName));
+    if (entry->value != StringPool::None && append) {
+        // append new reult to old entry
+        std::string appended = strings.get(entry->value);
+        appended += " ";
+        appended += value;
+        entry->value = strings.intern(appended);
+    } else {
+        // new entry, or override old entry
+        entry->value = strings.intern(value);
+    }
     return true;
 }
 
 
 IniFile::Entry *
-IniFile::Section::findEntry(const std::string &entryName)
+IniFile::Section::findEntry(StringId entryName)
 {
     return const_cast<IniFile::Entry *>(
         std::as_const(*this).findEntry(entryName));
 }
 
 const IniFile::Entry *
-IniFile::Section::findEntry(const std::string &entryName) const
+IniFile::Section::findEntry(StringId entryName) const
 {
     referenced = true;
 
-    auto ei = table.find(entryName);
+    if (!index.empty()) {
+        auto ei = index.find(entryName);
+        return (ei == index.end()) ? nullptr : &entries[ei->second];
+    }
+
+    for (const auto &entry : entries) {
+        if (entry.name == entryName)
+            return &entry;
+    }
+    return nullptr;
+}
 
-    return (ei == table.end()) ? nullptr : &ei->second;
+const IniFile::Entry *
+IniFile::findEntry(const Section &section, const std::string &entryName) const
+{
+    return section.findEntry(strings.find(entryName));
 }
 
 
 IniFile::Section *
-IniFile::addSection(const std::string &sectionName)
+IniFile::addSection(std::string_view sectionName)
 {
-    return &table[sectionName];
+    const StringId name = strings.intern(sectionName);
+    auto [it, inserted] = sectionIndex.emplace(name, sections.size());
+    if (inserted) {
+        sections.emplace_back();
+        sectionNames.push_back(name);
+    }
+    return &sections[it->second];
 }
 
 IniFile::Section *
@@ -142,9 +204,9 @@ IniFile::findSection(const std::string &sectionName)
 const IniFile::Section *
 IniFile::findSection(const std::string &sectionName) const
 {
-    auto i = table.find(sectionName);
+    auto i = sectionIndex.find(strings.find(sectionName));
 
-    return (i == table.end()) ? nullptr : &i->second;
+    return (i == sectionIndex.end()) ? nullptr : &sections[i->second];
 }
 
 
@@ -158,13 +220,10 @@ IniFile::add(const std::string &str)
     if (offset == std::string::npos)  // no ':' found
         return false;
 
-    std::string sectionName = str.substr(0, offset);
-    std::string rest = str.substr(offset + 1);
+    std::string_view view = str;
+    Section *s = addSection(trim(view.substr(0, offset)));
 
-    eat_white(sectionName);
-    Section *s = addSection(sectionName);
-
-    return s->add(rest);
+    return addAssignment(*s, view.substr(offset + 1));
 }
 
 bool
@@ -172,31 +231,27 @@ IniFile::load(std::istream &f)
 {
     Section *section = NULL;
 
+    std::string line;
     while (!f.eof()) {
         f >> std::ws; // Eat whitespace
         if (f.eof()) {
             break;
         }
 
-        std::string line;
         getline(f, line);
-        if (line.size() == 0)
+        std::string_view view = trim(line);
+        if (view.size() == 0)
             continue;
 
-        eat_end_white(line);
-        int last = line.size() - 1;
-
-        if (line[0] == '[' && line[last] == ']') {
-            std::string sectionName = line.substr(1, last - 1);
-            eat_white(sectionName);
-            section = addSection(sectionName);
+        if (view.front() == '[' && view.back() == ']') {
+            section = addSection(trim(view.substr(1, view.size() - 2)));
             continue;
         }
 
         if (section == NULL)
             continue;
 
-        if (!section->add(line))
+        if (!addAssignment(*section, view))
             return false;
     }
 
@@ -211,11 +266,11 @@ IniFile::find(const std::string &sectionName, const std::string &entryName,
     if (section == NULL)
         return false;
 
-    auto* entry = section->findEntry(entryName);
+    auto* entry = findEntry(*section, entryName);
     if (entry == NULL)
         return false;
 
-    value = entry->getValue();
+    value = getValue(*entry);
 
     return true;
 }
@@ -229,7 +284,7 @@ IniFile::entryExists(const std::string &sectionName,
     if (!section)
         return false;
     else
-        return section->findEntry(entryName);
+        return findEntry(*section, entryName);
 }
 
 bool
@@ -240,23 +295,23 @@ IniFile::sectionExists(const std::string &sectionName) const
 
 
 bool
-IniFile::Section::printUnreferenced(const std::string &sectionName) const
+IniFile::printUnreferenced(const Section &section,
+                           const std::string &sectionName) const
 {
     bool unref = false;
     bool search_unref_entries = false;
     std::vector<std::string> unref_ok_entries;
 
-    auto* entry = findEntry("unref_entries_ok");
+    auto* entry = findEntry(section, "unref_entries_ok");
     if (entry != NULL) {
-        tokenize(unref_ok_entries, entry->getValue(), ' ');
+        tokenize(unref_ok_entries, getValue(*entry), ' ');
         if (unref_ok_entries.size()) {
             search_unref_entries = true;
         }
     }
 
-    for (auto& ei: table) {
-        const std::string &entryName = ei.first;
-        entry = &ei.second;
+    for (auto& ei: section) {
+        const std::string &entryName = strings.get(ei.name);
 
         if (entryName == "unref_section_ok" ||
             entryName == "unref_entries_ok")
@@ -264,7 +319,7 @@ IniFile::Section::printUnreferenced(const std::string &sectionName) const
             continue;
         }
 
-        if (!entry->isReferenced()) {
+        if (!ei.referenced) {
             if (search_unref_entries &&
                 (std::find(unref_ok_entries.begin(), unref_ok_entries.end(),
                            entryName) != unref_ok_entries.end()))
@@ -285,10 +340,8 @@ IniFile::Section::printUnreferenced(const std::string &sectionName) const
 void
 IniFile::getSectionNames(std::vector<std::string> &list) const
 {
-    for (auto& entry: table) {
-        auto& sectionName = entry.first;
-        list.push_back(sectionName);
-    }
+    for (auto name: sectionNames)
+        list.push_back(strings.get(name));
 }
 
 bool
@@ -296,18 +349,19 @@ IniFile::printUnreferenced() const
 {
     bool unref = false;
 
-    for (auto& entry: table) {
-        auto& [sectionName, section] = entry;
+    for (size_t i = 0; i < sections.size(); i++) {
+        const Section &section = sections[i];
+        const std::string &sectionName = strings.get(sectionNames[i]);
 
         if (!section.isReferenced()) {
-            if (section.findEntry("unref_section_ok") == NULL) {
+            if (findEntry(section, "unref_section_ok") == NULL) {
                 std::cerr << "Section " << sectionName << " not referenced."
                           << std::endl;
                 unref = true;
             }
         }
         else {
-            if (section.printUnreferenced(sectionName)) {
+            if (printUnreferenced(section, sectionName)) {
                 unref = true;
             }
         }
@@ -317,43 +371,28 @@ IniFile::printUnreferenced() const
 }
 
 
-void
-IniFile::Section::dump(const std::string &sectionName) const
-{
-    for (auto& ei: table) {
-        std::cout << sectionName << ": " << ei.first << " => "
-                  << ei.second.getValue() << "\n";
-    }
-}
-
 void
 IniFile::dump()
 {
-    for (SectionTable::iterator i = table.begin();
-         i != table.end(); ++i) {
-        i->second.dump(i->first);
+    for (size_t i = 0; i < sections.size(); i++) {
+        const std::string &sectionName = strings.get(sectionNames[i]);
+        for (auto& ei: sections[i]) {
+            std::cout << sectionName << ": " << strings.get(ei.name)
+                      << " => " << getValue(ei) << "\n";
+        }
     }
 }
 
-IniFile::Section::EntryTable::const_iterator
-IniFile::Section::begin() const
-{
-    return table.begin();
-}
-
-IniFile::Section::EntryTable::const_iterator
-IniFile::Section::end() const
-{
-    return table.end();
-}
-
 void
 IniFile::visitSection(const std::string &sectionName,
     IniFile::VisitSectionCallback cb)
 {
-    const auto& section = table.at(sectionName);
-    for (const auto& pair : section) {
-        cb(pair.first, pair.second.getValue());
+    const Section *section = findSection(sectionName);
+    if (!section)
+        throw std::out_of_range("No section " + sectionName);
+
+    for (const auto& entry : *section) {
+        cb(strings.get(entry.name), getValue(entry));
     }
 }
 
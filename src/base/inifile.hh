@@ -29,10 +29,12 @@
 #ifndef __INIFILE_HH__
 #define __INIFILE_HH__
 
+#include <cstdint>
+#include <deque>
 #include <fstream>
 #include <functional>
-#include <list>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -52,113 +54,139 @@ namespace gem5
 /// where each section is a set of key/value pairs.  Section names,
 /// keys, and values are all uninterpreted strings.
 ///
+/// Large configurations repeat the same keys, and many of the same
+/// values, in thousands of sections, so every string is stored once in
+/// a pool and sections and entries refer to it by id.
+///
 class IniFile
 {
   protected:
 
+    /// Index of a string in the string pool.
+    typedef uint32_t StringId;
+
     ///
-    /// A single key/value pair.
+    /// Every distinct string of the file, stored once. Strings never
+    /// move, so references to them stay valid.
     ///
-    class Entry
+    class StringPool
     {
-        std::string     value;          ///< The entry value.
-        mutable bool    referenced;     ///< Has this entry been used?
+        std::deque<std::string> strings;
+        std::unordered_map<std::string_view, StringId> ids;
 
       public:
-        /// Constructor.
-        Entry(const std::string &v)
-            : value(v), referenced(false)
-        {
-        }
+        /// Id returned by find() for strings not in the pool.
+        static constexpr StringId None = UINT32_MAX;
 
-        /// Has this entry been used?
-        bool isReferenced() const { return referenced; }
+        /// Add a string to the pool if it isn't already there.
+        /// @retval Id of the string.
+        StringId intern(std::string_view str);
 
-        /// Fetch the value.
-        const std::string &getValue() const;
+        /// @retval Id of the string, or None if it isn't in the pool.
+        StringId find(std::string_view str) const;
 
-        /// Set the value.
-        void setValue(const std::string &v) { value = v; }
+        const std::string &get(StringId id) const { return strings[id]; }
+    };
 
-        /// Append the given string to the value.  A space is inserted
-        /// between the existing value and the new value.  Since this
-        /// operation is typically used with values that are
-        /// space-separated lists of tokens, this keeps the tokens
-        /// separate.
-        void appendValue(const std::string &v) { value += " "; value += v; }
+    ///
+    /// A single key/value pair.
+    ///
+    struct Entry
+    {
+        StringId        name;           ///< The entry name.
+        StringId        value;          ///< The entry value.
+        mutable bool    referenced;     ///< Has this entry been used?
     };
 
     ///
-    /// A section.
+    /// A section. Most sections only have a few entries, which are
+    /// searched linearly; bigger ones also get a hash index.
     ///
     class Section
     {
-        /// EntryTable type.  Map of strings to Entry object pointers.
-        typedef std::unordered_map<std::string, Entry> EntryTable;
-
-        EntryTable      table;          ///< Table of entries.
+        std::vector<Entry> entries;     ///< Entries in insertion order.
+        /// Entry indices by name, only built for big sections.
+        std::unordered_map<StringId, uint32_t> index;
         mutable bool    referenced;     ///< Has this section been used?
 
       public:
+        /// Number of entries from which the hash index is used.
+        static constexpr size_t IndexThreshold = 16;
+
         /// Constructor.
         Section()
-            : table(), referenced(false)
+            : referenced(false)
         {
         }
 
         /// Has this section been used?
         bool isReferenced() const { return referenced; }
 
-        /// Add an entry to the table.  If an entry with the same name
-        /// already exists, the 'append' parameter is checked If true,
-        /// the new value will be appended to the existing entry.  If
-        /// false, the new value will replace the existing entry.
-        void addEntry(const std::string &entryName, const std::string &value,
-                      bool append);
-
-        /// Add an entry to the table given a string assigment.
-        /// Assignment should be of the form "param=value" or
-        /// "param+=value" (for append).  This funciton parses the
-        /// assignment statment and calls addEntry().
-        /// @retval True for success, false if parse error.
-        bool add(const std::string &assignment);
+        /// Find the entry with the given name, adding an entry with an
+        /// empty value if there is none.
+        /// @retval Pointer to the entry object.
+        Entry *addEntry(StringId entryName);
 
         /// Find the entry with the given name.
         /// @retval Pointer to the entry object, or NULL if none.
-        Entry *findEntry(const std::string &entryName);
-        const Entry *findEntry(const std::string &entryName) const;
+        Entry *findEntry(StringId entryName);
+        const Entry *findEntry(StringId entryName) const;
 
-        /// Print the unreferenced entries in this section to cerr.
-        /// Messages can be suppressed using "unref_section_ok" and
-        /// "unref_entries_ok".
-        /// @param sectionName Name of this section, for use in output message.
-        /// @retval True if any entries were printed.
-        bool printUnreferenced(const std::string &sectionName) const;
+        std::vector<Entry>::const_iterator
+        begin() const { return entries.begin(); }
+        std::vector<Entry>::const_iterator
+        end() const { return entries.end(); }
+    };
 
-        /// Print the contents of this section to cout (for debugging).
-        void dump(const std::string &sectionName) const;
+  protected:
+    /// Section, key and value strings.
+    StringPool strings;
 
-        EntryTable::const_iterator begin() const;
-        EntryTable::const_iterator end() const;
-    };
+    /// Sections in the order in which they first appear.
+    std::vector<Section> sections;
 
-    /// SectionTable type.  Map of strings to Section object pointers.
-    typedef std::unordered_map<std::string, Section> SectionTable;
+    /// Names of the sections in the same order.
+    std::vector<StringId> sectionNames;
 
-  protected:
-    /// Hash of section names to Section object pointers.
-    SectionTable table;
+    /// Map of section names to indices into the section vector.
+    std::unordered_map<StringId, uint32_t> sectionIndex;
 
     /// Look up section with the given name, creating a new section if
     /// not found.
     /// @retval Pointer to section object.
-    Section *addSection(const std::string &sectionName);
+    Section *addSection(std::string_view sectionName);
 
     /// Look up section with the given name.
     /// @retval Pointer to section object, or NULL if not found.
     Section *findSection(const std::string &sectionName);
     const Section *findSection(const std::string &sectionName) const;
 
+    /// Look up the entry with the given name in a section.
+    /// @retval Pointer to the entry object, or NULL if not found.
+    const Entry *findEntry(const Section &section,
+                           const std::string &entryName) const;
+
+    /// Fetch the value of an entry, marking it as used.
+    const std::string &getValue(const Entry &entry) const;
+
+    /// Add an entry to a section given a string assigment.
+    /// Assignment should be of the form "param=value" or
+    /// "param+=value" (for append).  If an entry with the same name
+    /// already exists, the value either replaces it or, when
+    /// appending, is added to it after a space.  Since appending is
+    /// typically used with values that are space-separated lists of
+    /// tokens, this keeps the tokens separate.
+    /// @retval True for success, false if parse error.
+    bool addAssignment(Section &section, std::string_view assignment);
+
+    /// Print the unreferenced entries in a section to cerr.
+    /// Messages can be suppressed using "unref_section_ok" and
+    /// "unref_entries_ok".
+    /// @param sectionName Name of this section, for use in output message.
+    /// @retval True if any entries were printed.
+    bool printUnreferenced(const Section &section,
+                           const std::string &sectionName) const;
+
   public:
     /// Constructor.
     IniFile();
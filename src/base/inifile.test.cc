@@ -33,9 +33,11 @@
 
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include "base/cprintf.hh"
 #include "base/inifile.hh"
 
 using namespace gem5;
@@ -105,3 +107,74 @@ TEST(Initest, MatchNotFound)
     ret = simConfigDB.find("Junk", "test4", value);
     ASSERT_FALSE(ret);
 }
+
+TEST(Initest, AppendAndBigSection)
+{
+    IniFile simConfigDB;
+    std::istringstream ini(R"ini_file(
+[Big]
+list=a
+list+=b
+)ini_file");
+    ASSERT_TRUE(simConfigDB.load(ini));
+
+    for (int i = 0; i < 100; i++)
+        ASSERT_TRUE(simConfigDB.add(csprintf("Big:e%d=%d", i, i)));
+    ASSERT_TRUE(simConfigDB.add("Big: e7 = seven "));
+    ASSERT_FALSE(simConfigDB.add("Big"));
+
+    std::string value;
+    ASSERT_TRUE(simConfigDB.find("Big", "list", value));
+    ASSERT_EQ(value, "a b");
+    ASSERT_TRUE(simConfigDB.find("Big", "e99", value));
+    ASSERT_EQ(value, "99");
+    ASSERT_TRUE(simConfigDB.find("Big", "e7", value));
+    ASSERT_EQ(value, "seven");
+    ASSERT_FALSE(simConfigDB.entryExists("Big", "e100"));
+
+    int visited = 0;
+    simConfigDB.visitSection("Big",
+        [&](const std::string &, const std::string &) { visited++; });
+    ASSERT_EQ(visited, 101);
+}
+
+/**
+ * A config.ini shaped like a generated system, with many sections
+ * sharing the same keys and values, keeps every value and the order of
+ * the sections.
+ */
+TEST(Initest, ManySimilarSections)
+{
+    std::ostringstream os;
+    const int objects = 100;
+    for (int i = 0; i < objects; i++) {
+        os << "[system.cpu" << i << "]\n"
+           << "type=TimingSimpleCPU\n"
+           << "cpu_id=" << i << "\n"
+           << "power_state=system.cpu" << i << ".power_state\n"
+           << "system=system\n\n";
+    }
+    std::istringstream ini(os.str());
+
+    IniFile simConfigDB;
+    ASSERT_TRUE(simConfigDB.load(ini));
+
+    std::string value;
+    for (int i = 0; i < objects; i++) {
+        const std::string section = csprintf("system.cpu%d", i);
+        ASSERT_TRUE(simConfigDB.find(section, "type", value));
+        ASSERT_EQ(value, "TimingSimpleCPU");
+        ASSERT_TRUE(simConfigDB.find(section, "cpu_id", value));
+        ASSERT_EQ(value, std::to_string(i));
+        ASSERT_TRUE(simConfigDB.find(section, "power_state", value));
+        ASSERT_EQ(value, section + ".power_state");
+        ASSERT_TRUE(simConfigDB.find(section, "system", value));
+        ASSERT_EQ(value, "system");
+    }
+
+    std::vector<std::string> names;
+    simConfigDB.getSectionNames(names);
+    ASSERT_EQ(names.size(), objects);
+    for (int i = 0; i < objects; i++)
+        ASSERT_EQ(names[i], csprintf("system.cpu%d", i));
+}
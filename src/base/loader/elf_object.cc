@@ -137,7 +137,6 @@ ElfObject::ElfObject(ImageFileDataPtr ifd) : ObjectFile(ifd)
             ObjectFile *obj = createObjectFile(interp_path);
             interpreter = dynamic_cast<ElfObject *>(obj);
             assert(interpreter != nullptr);
-            _symtab.insert(obj->symtab());
         }
     }
 
@@ -149,11 +148,15 @@ ElfObject::ElfObject(ImageFileDataPtr ifd) : ObjectFile(ifd)
     for ([[maybe_unused]] auto &seg: image.segments())
         DPRINTFR(Loader, "%s\n", seg);
 
-    // We will actually read the sections when we need to load them
+    // We will actually read the sections when we need to load them, and
+    // the symbols when they are first used.
+}
 
-    // check that header matches library version
-    if (elf_version(EV_CURRENT) == EV_NONE)
-        panic("wrong elf version number!");
+void
+ElfObject::loadSymbols() const
+{
+    if (interpreter)
+        _symtab.insert(interpreter->symtab());
 
     // Get the first section
     int sec_idx = 1; // there is a 0 but it is nothing, go figure
@@ -168,6 +171,7 @@ ElfObject::ElfObject(ImageFileDataPtr ifd) : ObjectFile(ifd)
             Elf_Data *data = elf_getdata(section, nullptr);
             int count = shdr.sh_size / shdr.sh_entsize;
             DPRINTF(Loader, "Found Symbol Table, %d symbols present.", count);
+            _symtab.reserve((_symtab.end() - _symtab.begin()) + count);
 
             // Loop through all the symbols.
             for (int i = 0; i < count; ++i) {
@@ -103,6 +103,8 @@ class ElfObject : public ObjectFile
     void getSections();
     bool sectionExists(std::string sec);
 
+    void loadSymbols() const override;
+
     MemoryImage image;
 
   public:
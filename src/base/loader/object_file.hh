@@ -41,6 +41,7 @@
 #ifndef __BASE_LOADER_OBJECT_FILE_HH__
 #define __BASE_LOADER_OBJECT_FILE_HH__
 
+#include <mutex>
 #include <string>
 
 #include "base/compiler.hh"
@@ -100,10 +101,18 @@ class ObjectFile : public ImageFile
     OpSys opSys = UnknownOpSys;
     ByteOrder byteOrder = ByteOrder::little;
 
-    SymbolTable _symtab;
+    /** Filled by loadSymbols() the first time it is used. */
+    mutable SymbolTable _symtab;
 
     ObjectFile(ImageFileDataPtr ifd);
 
+    /**
+     * Read the symbols into _symtab. Big binaries have large symbol
+     * tables that many simulations never use, so they are only read on
+     * the first call to symtab().
+     */
+    virtual void loadSymbols() const {}
+
   public:
     virtual ~ObjectFile() {};
 
@@ -127,7 +136,15 @@ class ObjectFile : public ImageFile
     OpSys getOpSys() const { return opSys; }
     ByteOrder getByteOrder() const { return byteOrder; }
 
-    const SymbolTable &symtab() const { return _symtab; }
+    const SymbolTable &
+    symtab() const
+    {
+        std::call_once(symbolsLoaded, [this]() { loadSymbols(); });
+        return _symtab;
+    }
+
+  private:
+    mutable std::once_flag symbolsLoaded;
 
   protected:
     Addr entry = 0;
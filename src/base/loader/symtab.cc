@@ -54,14 +54,24 @@ namespace loader
 
 SymbolTable debugSymbolTable;
 
+std::atomic<uint64_t> SymbolTable::nextGeneration{0};
+
 void
 SymbolTable::clear()
 {
-    addrMap.clear();
+    addrIndex.invalidate();
+    changed();
     nameMap.clear();
     symbols.clear();
 }
 
+void
+SymbolTable::reserve(size_t count)
+{
+    symbols.reserve(count);
+    nameMap.reserve(count);
+}
+
 bool
 SymbolTable::insert(const Symbol &symbol)
 {
@@ -73,9 +83,10 @@ SymbolTable::insert(const Symbol &symbol)
     if (!nameMap.insert({ symbol.name(), idx }).second)
         return false;
 
-    // There can be multiple symbols for the same address, so always
-    // update the addrTable multimap when we see a new symbol name.
-    addrMap.insert({ symbol.address(), idx });
+    // There can be multiple symbols for the same address, the address
+    // index keeps all of them once it is rebuilt.
+    addrIndex.invalidate();
+    changed();
 
     symbols.emplace_back(symbol);
 
@@ -86,17 +97,16 @@ bool
 SymbolTable::insert(const SymbolTable &other)
 {
     // Check if any symbol in other already exists in our table.
-    NameMap intersection;
-    std::set_intersection(other.nameMap.begin(), other.nameMap.end(),
-                          nameMap.begin(), nameMap.end(),
-                          std::inserter(intersection, intersection.begin()),
-                          nameMap.value_comp());
-    if (!intersection.empty()) {
-        warn("Cannot insert a new symbol table due to name collisions. "
-             "Adding prefix to each symbol's name can resolve this issue.");
-        return false;
+    for (const auto &entry : other.nameMap) {
+        if (nameMap.count(entry.first)) {
+            warn("Cannot insert a new symbol table due to name collisions. "
+                 "Adding prefix to each symbol's name can resolve this "
+                 "issue.");
+            return false;
+        }
     }
 
+    reserve(symbols.size() + other.symbols.size());
     for (const Symbol &symbol: other)
         insert(symbol);
 
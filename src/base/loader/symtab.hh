@@ -42,11 +42,15 @@
 #ifndef __BASE_LOADER_SYMTAB_HH__
 #define __BASE_LOADER_SYMTAB_HH__
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <iosfwd>
-#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "base/compiler.hh"
@@ -156,30 +160,98 @@ class SymbolTable
   private:
     /** Vector containing all the symbols in the table. */
     typedef std::vector<Symbol> SymbolVector;
-    /** Map addresses to an index into the symbol vector. */
-    typedef std::multimap<Addr, int> AddrMap;
+    /** Address of a symbol and its index into the symbol vector. */
+    typedef std::pair<Addr, int> AddrEntry;
     /** Map a symbol name to an index into the symbol vector. */
-    typedef std::map<std::string, int> NameMap;
+    typedef std::unordered_map<std::string, int> NameMap;
+
+    /**
+     * The symbols sorted by address, and by insertion order for the
+     * same address. Big tables are mostly built and rarely searched by
+     * address, so the index is only sorted on the first lookup after a
+     * change. Copies rebuild their own index.
+     */
+    class AddrIndex
+    {
+      public:
+        AddrIndex() {}
+        AddrIndex(const AddrIndex &other) {}
+        AddrIndex &operator=(const AddrIndex &other)
+        {
+            invalidate();
+            return *this;
+        }
+
+        void
+        invalidate()
+        {
+            valid.store(false, std::memory_order_relaxed);
+            entries.clear();
+        }
+
+        const std::vector<AddrEntry> &
+        get(const SymbolVector &symbols)
+        {
+            if (!valid.load(std::memory_order_acquire)) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!valid.load(std::memory_order_relaxed)) {
+                    entries.clear();
+                    entries.reserve(symbols.size());
+                    for (int i = 0; i < (int)symbols.size(); i++)
+                        entries.emplace_back(symbols[i].address(), i);
+                    std::sort(entries.begin(), entries.end());
+                    valid.store(true, std::memory_order_release);
+                }
+            }
+            return entries;
+        }
+
+      private:
+        std::vector<AddrEntry> entries;
+        std::atomic<bool> valid{false};
+        std::mutex mutex;
+    };
 
     SymbolVector symbols;
-    AddrMap addrMap;
     NameMap nameMap;
+    mutable AddrIndex addrIndex;
 
     /**
-     * Get the first address larger than the given address, if any.
+     * Generation of the contents of the table. Every change takes a new
+     * number from a global counter, so two tables with the same
+     * generation hold the same symbols.
+     */
+    uint64_t _generation = 0;
+    static std::atomic<uint64_t> nextGeneration;
+
+    void changed() { _generation = ++nextGeneration; }
+
+    const std::vector<AddrEntry> &
+    addrEntries() const
+    {
+        return addrIndex.get(symbols);
+    }
+
+    /**
+     * Get the first entry with an address larger than the given
+     * address, if any.
      *
      * @param addr The address to compare against.
      * @param iter An iterator to the larger-address entry.
      * @return True if successful; false if no larger addresses exist.
      */
     bool
-    upperBound(Addr addr, AddrMap::const_iterator &iter) const
+    upperBound(Addr addr,
+               std::vector<AddrEntry>::const_iterator &iter) const
     {
+        const auto &entries = addrEntries();
+
         // find first key *larger* than desired address
-        iter = addrMap.upper_bound(addr);
+        iter = std::upper_bound(entries.begin(), entries.end(), addr,
+            [](Addr a, const AddrEntry &entry) { return a < entry.first; });
 
         // if very first key is larger, we're out of luck
-        if (iter == addrMap.begin())
+        if (iter == entries.begin())
             return false;
 
         return true;
@@ -277,9 +349,20 @@ class SymbolTable
     /** @return An iterator to the end of the symbol vector. */
     const_iterator end() const { return symbols.end(); }
 
+    /**
+     * Identify the contents of the table, e.g., to tell whether results
+     * derived from an earlier lookup are still valid.
+     *
+     * @return A number that changes every time the table is modified.
+     */
+    uint64_t generation() const { return _generation; }
+
     /** Clears the table. */
     void clear();
 
+    /** Make room for a number of symbols, e.g., before loading a file. */
+    void reserve(size_t count);
+
     /**
      * Insert a new symbol in the table if it does not already exist. The
      * symbol must have a defined name.
@@ -434,8 +517,10 @@ class SymbolTable
     const_iterator
     find(Addr address) const
     {
-        AddrMap::const_iterator i = addrMap.find(address);
-        if (i == addrMap.end())
+        const auto &entries = addrEntries();
+        auto i = std::lower_bound(entries.begin(), entries.end(), address,
+            [](const AddrEntry &entry, Addr a) { return entry.first < a; });
+        if (i == entries.end() || i->first != address)
             return end();
 
         // There are potentially multiple symbols that map to the same
@@ -473,13 +558,13 @@ class SymbolTable
     const_iterator
     findNearest(Addr addr, Addr &next_addr) const
     {
-        AddrMap::const_iterator i = addrMap.end();
+        std::vector<AddrEntry>::const_iterator i;
         if (!upperBound(addr, i))
             return end();
 
         // If there is no next address, make it 0 since 0 is not larger than
         // any other address, so it is clear that next is not valid
-        if (i == addrMap.end()) {
+        if (i == addrEntries().end()) {
             next_addr = 0;
         } else {
             next_addr = i->first;
@@ -495,7 +580,7 @@ class SymbolTable
     const_iterator
     findNearest(Addr addr) const
     {
-        AddrMap::const_iterator i = addrMap.end();
+        std::vector<AddrEntry>::const_iterator i;
         if (!upperBound(addr, i))
             return end();
 
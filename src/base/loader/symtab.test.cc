@@ -245,6 +245,33 @@ TEST(LoaderSymtabTest, ClearMultiple)
     ASSERT_TRUE(checkTable(symtab, {}));
 }
 
+/**
+ * Test that the generation of a table changes with its contents, and that
+ * a copy shares the generation of the original.
+ */
+TEST(LoaderSymtabTest, Generation)
+{
+    loader::SymbolTable symtab;
+    const uint64_t empty_generation = symtab.generation();
+
+    loader::Symbol symbol = {loader::Symbol::Binding::Local,
+        loader::Symbol::SymbolType::Other, "symbol", 0x10};
+    EXPECT_TRUE(symtab.insert(symbol));
+    const uint64_t insert_generation = symtab.generation();
+    EXPECT_NE(insert_generation, empty_generation);
+
+    // A failed insertion does not change the table
+    EXPECT_FALSE(symtab.insert(symbol));
+    EXPECT_EQ(symtab.generation(), insert_generation);
+
+    loader::SymbolTable copy = symtab;
+    EXPECT_EQ(copy.generation(), insert_generation);
+
+    symtab.clear();
+    EXPECT_NE(symtab.generation(), insert_generation);
+    EXPECT_EQ(copy.generation(), insert_generation);
+}
+
 /**
  * Test the creation of a new table with offsets applied to the original
  * symbols' addresses. Also verifies that the original table is kept the same.
@@ -629,6 +656,42 @@ TEST(LoaderSymtabTest, FindNonUniqueAddress)
     ASSERT_PRED_FORMAT2(checkSymbol, *it, symbols[1]);
 }
 
+/**
+ * Test that address lookups see the symbols inserted after an earlier
+ * lookup, also in a copy of the table.
+ */
+TEST(LoaderSymtabTest, FindAfterInsert)
+{
+    loader::SymbolTable symtab;
+
+    loader::Symbol symbols[] = {
+        {loader::Symbol::Binding::Local, loader::Symbol::SymbolType::Other,
+            "symbol", 0x30},
+        {loader::Symbol::Binding::Local, loader::Symbol::SymbolType::Other,
+            "symbol2", 0x10},
+        {loader::Symbol::Binding::Local, loader::Symbol::SymbolType::Other,
+            "symbol3", 0x20},
+    };
+    EXPECT_TRUE(symtab.insert(symbols[0]));
+    ASSERT_EQ(symtab.findNearest(0x18), symtab.end());
+
+    EXPECT_TRUE(symtab.insert(symbols[1]));
+    auto it = symtab.findNearest(0x18);
+    ASSERT_NE(it, symtab.end());
+    ASSERT_PRED_FORMAT2(checkSymbol, *it, symbols[1]);
+
+    loader::SymbolTable copy;
+    copy = symtab;
+    EXPECT_TRUE(copy.insert(symbols[2]));
+    it = copy.findNearest(0x28);
+    ASSERT_NE(it, copy.end());
+    ASSERT_PRED_FORMAT2(checkSymbol, *it, symbols[2]);
+
+    it = symtab.findNearest(0x28);
+    ASSERT_NE(it, symtab.end());
+    ASSERT_PRED_FORMAT2(checkSymbol, *it, symbols[1]);
+}
+
 /** Test searching for a non-existent name. */
 TEST(LoaderSymtabTest, FindNonExistentName)
 {
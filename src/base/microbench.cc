@@ -0,0 +1,149 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/microbench.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include "base/cprintf.hh"
+
+namespace gem5
+{
+
+namespace microbench
+{
+
+namespace
+{
+
+std::vector<std::unique_ptr<Benchmark>> &
+registry()
+{
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+/** Largest number of iterations a single measurement runs. */
+constexpr uint64_t MaxIters = 1000000000;
+
+/**
+ * Run a benchmark with more and more iterations until a run lasts at
+ * least min_time, and report that run.
+ */
+void
+measure(const Benchmark &bench, const std::string &name, int64_t arg,
+        double min_time)
+{
+    uint64_t iters = 1;
+    while (true) {
+        State state(iters, arg);
+        bench.run(state);
+        const double secs = state.seconds();
+
+        if (secs >= min_time || iters >= MaxIters) {
+            const double items = state.items() ? state.items() : iters;
+            ccprintf(std::cout, "%-40s %12d %12.2f ns %14.3f M/s\n", name,
+                     iters, secs * 1e9 / iters, items / secs / 1e6);
+            return;
+        }
+
+        // Aim slightly past the minimum time from the last estimate, but
+        // grow by at most 10x at a time in case the estimate is noise
+        const double target = secs > 0 ?
+            std::ceil(iters * min_time * 1.4 / secs) : iters * 10.0;
+        iters = std::min<uint64_t>(
+            MaxIters,
+            std::max<double>(iters * 2, std::min(target, iters * 10.0)));
+    }
+}
+
+} // anonymous namespace
+
+Benchmark *
+Benchmark::range(int64_t lo, int64_t hi)
+{
+    for (int64_t a = lo; a < hi; a *= 8)
+        arg(a);
+    return arg(hi);
+}
+
+Benchmark *
+registerBenchmark(const char *name, Function fn)
+{
+    registry().push_back(std::make_unique<Benchmark>(name, fn));
+    return registry().back().get();
+}
+
+int
+runBenchmarks(int argc, char **argv)
+{
+    std::string filter;
+    double min_time = 0.5;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--filter=", 9) == 0) {
+            filter = argv[i] + 9;
+        } else if (std::strncmp(argv[i], "--min-time=", 11) == 0) {
+            min_time = std::atof(argv[i] + 11);
+        } else {
+            ccprintf(std::cerr,
+                     "Usage: %s [--filter=<substring>] "
+                     "[--min-time=<seconds>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    ccprintf(std::cout, "%-40s %12s %15s %16s\n", "Benchmark", "Iterations",
+             "Time/iter", "Throughput");
+    for (const auto &bench : registry()) {
+        std::vector<int64_t> args = bench->args();
+        const bool named_args = !args.empty();
+        if (!named_args)
+            args.push_back(0);
+
+        for (int64_t arg : args) {
+            const std::string name = named_args ?
+                csprintf("%s/%d", bench->name(), arg) : bench->name();
+            if (name.find(filter) == std::string::npos)
+                continue;
+            measure(*bench, name, arg, min_time);
+        }
+    }
+
+    return 0;
+}
+
+} // namespace microbench
+} // namespace gem5
+
+int
+main(int argc, char **argv)
+{
+    return gem5::microbench::runBenchmarks(argc, argv);
+}
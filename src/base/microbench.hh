@@ -0,0 +1,193 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A minimal microbenchmark harness in the style of Google Benchmark, for
+ * timing the simulator's core data structures outside of a simulation.
+ *
+ * A benchmark is a function taking a State, whose range-for loop is the
+ * timed region:
+ *
+ *     static void
+ *     queuePush(microbench::State &state)
+ *     {
+ *         CircularQueue<int> q(state.range());
+ *         for (auto _ : state) {
+ *             ...
+ *         }
+ *     }
+ *     GEM5_BENCHMARK(queuePush)->arg(64)->arg(1024);
+ *
+ * Every executable linking microbench.cc runs all of its benchmarks,
+ * optionally restricted with --filter=<substring>, for at least
+ * --min-time=<seconds> each.
+ */
+
+#ifndef __BASE_MICROBENCH_HH__
+#define __BASE_MICROBENCH_HH__
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gem5
+{
+
+namespace microbench
+{
+
+class State
+{
+  public:
+    State(uint64_t max_iters, int64_t arg)
+        : maxIters(max_iters), arg(arg)
+    {}
+
+    /** The iterator of the timed loop, counting down the iterations. */
+    struct Iterator
+    {
+        State *state;
+        uint64_t remaining;
+
+        /**
+         * Stand-in for the loop variable, which is never used. The
+         * destructor keeps the compiler from warning about that.
+         */
+        struct Value { ~Value() {} };
+
+        Value operator*() const { return {}; }
+        Iterator &operator++() { --remaining; return *this; }
+
+        bool
+        operator!=(const Iterator &) const
+        {
+            if (remaining)
+                return true;
+            state->stop();
+            return false;
+        }
+    };
+
+    Iterator begin() { start(); return {this, maxIters}; }
+    Iterator end() { return {this, 0}; }
+
+    /** The argument the benchmark is run with. */
+    int64_t range() const { return arg; }
+
+    uint64_t iterations() const { return maxIters; }
+
+    /** Exclude setup done inside the timed loop from the measurement. */
+    void
+    pauseTiming()
+    {
+        elapsed += clock::now() - startTime;
+    }
+
+    void resumeTiming() { startTime = clock::now(); }
+
+    /** Report a throughput of this many items instead of iterations. */
+    void setItemsProcessed(int64_t items) { itemsProcessed = items; }
+
+    int64_t items() const { return itemsProcessed; }
+
+    double seconds() const
+    {
+        return std::chrono::duration<double>(elapsed).count();
+    }
+
+  private:
+    using clock = std::chrono::steady_clock;
+
+    void start() { elapsed = {}; startTime = clock::now(); }
+    void stop() { elapsed += clock::now() - startTime; }
+
+    const uint64_t maxIters;
+    const int64_t arg;
+    int64_t itemsProcessed = 0;
+
+    clock::time_point startTime;
+    clock::duration elapsed{};
+};
+
+typedef void (*Function)(State &state);
+
+class Benchmark
+{
+  public:
+    Benchmark(const std::string &name, Function fn) : _name(name), fn(fn)
+    {}
+
+    /** Run the benchmark once more with an additional argument. */
+    Benchmark *arg(int64_t a) { _args.push_back(a); return this; }
+
+    /** Run the benchmark with every power of 8 in [lo, hi], and hi. */
+    Benchmark *range(int64_t lo, int64_t hi);
+
+    const std::string &name() const { return _name; }
+    const std::vector<int64_t> &args() const { return _args; }
+    void run(State &state) const { fn(state); }
+
+  private:
+    const std::string _name;
+    const Function fn;
+    std::vector<int64_t> _args;
+};
+
+/** Register a benchmark, done by GEM5_BENCHMARK. */
+Benchmark *registerBenchmark(const char *name, Function fn);
+
+/** Run the registered benchmarks; called by the harness's main. */
+int runBenchmarks(int argc, char **argv);
+
+/** Make the compiler assume the value is used, so it is computed. */
+template <class T>
+inline void
+doNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/** Make the compiler assume all memory may have been read and written. */
+inline void
+clobberMemory()
+{
+    asm volatile("" : : : "memory");
+}
+
+} // namespace microbench
+} // namespace gem5
+
+#define GEM5_BENCHMARK_CONCAT(a, b) a##b
+#define GEM5_BENCHMARK_NAME(line) \
+    GEM5_BENCHMARK_CONCAT(gem5_benchmark_, line)
+
+#define GEM5_BENCHMARK(fn) \
+    [[maybe_unused]] static ::gem5::microbench::Benchmark * \
+    GEM5_BENCHMARK_NAME(__LINE__) = \
+        ::gem5::microbench::registerBenchmark(#fn, fn)
+
+#endif // __BASE_MICROBENCH_HH__
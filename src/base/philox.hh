@@ -0,0 +1,183 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_PHILOX_HH__
+#define __BASE_PHILOX_HH__
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace gem5
+{
+
+/**
+ * Philox4x32-10 counter-based random number generator (Salmon et al.,
+ * "Parallel Random Numbers: As Easy as 1, 2, 3", SC'11).
+ *
+ * Each block of random bits is a pure function of a 64-bit key and a
+ * 128-bit counter, so a generator carries no state besides its position
+ * in the stream. Generators with different keys, or with the same key
+ * and different stream IDs, produce independent sequences no matter how
+ * their users are scheduled, and any position can be reached in
+ * constant time.
+ *
+ * The class satisfies the UniformRandomBitGenerator requirements, so it
+ * can be used with the std:: distributions.
+ */
+class Philox4x32
+{
+  public:
+    using result_type = uint64_t;
+    using Counter = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    /**
+     * Compute the block of random bits for a counter and a key.
+     */
+    static constexpr Counter
+    generate(Counter ctr, Key key)
+    {
+        for (int round = 0; round < 10; ++round) {
+            const uint64_t p0 = uint64_t(M0) * ctr[0];
+            const uint64_t p1 = uint64_t(M1) * ctr[2];
+            ctr = {uint32_t(p1 >> 32) ^ ctr[1] ^ key[0], uint32_t(p1),
+                   uint32_t(p0 >> 32) ^ ctr[3] ^ key[1], uint32_t(p0)};
+            key = {key[0] + W0, key[1] + W1};
+        }
+        return ctr;
+    }
+
+    /**
+     * Hash a string, such as a SimObject name, into a key or a stream
+     * ID. This is FNV-1a, which, unlike std::hash, gives the same value
+     * on every host and every run.
+     */
+    static constexpr uint64_t
+    hash(const char *str)
+    {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (; *str; ++str)
+            h = (h ^ uint8_t(*str)) * 0x100000001b3ULL;
+        return h;
+    }
+
+    static uint64_t hash(const std::string &str) { return hash(str.c_str()); }
+
+    explicit Philox4x32(uint64_t key = 0, uint64_t stream = 0)
+    {
+        seed(key, stream);
+    }
+
+    /**
+     * Restart the generator at the beginning of a stream.
+     *
+     * @param key Key, usually derived from the simulation seed.
+     * @param stream Stream ID, which selects one of 2^64 independent
+     *        streams under the key.
+     */
+    void
+    seed(uint64_t key, uint64_t stream = 0)
+    {
+        _key = {uint32_t(key), uint32_t(key >> 32)};
+        _stream = stream;
+        _index = 0;
+        used = 2;
+    }
+
+    result_type
+    operator()()
+    {
+        if (used == 2) {
+            block = generate({uint32_t(_index), uint32_t(_index >> 32),
+                              uint32_t(_stream), uint32_t(_stream >> 32)},
+                             _key);
+            ++_index;
+            used = 0;
+        }
+        const int word = 2 * used++;
+        return uint64_t(block[word + 1]) << 32 | block[word];
+    }
+
+    /** Skip the next n values in constant time. */
+    void
+    discard(uint64_t n)
+    {
+        const uint64_t pos = position() + n;
+        _index = pos / 2;
+        used = 2;
+        if (pos % 2) {
+            (*this)();
+        }
+    }
+
+    /** Number of values drawn since the start of the stream. */
+    uint64_t
+    position() const
+    {
+        return used == 2 ? 2 * _index : 2 * (_index - 1) + used;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type
+    max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    bool
+    operator==(const Philox4x32 &other) const
+    {
+        return _key == other._key && _stream == other._stream &&
+            position() == other.position();
+    }
+
+    bool
+    operator!=(const Philox4x32 &other) const
+    {
+        return !(*this == other);
+    }
+
+  private:
+    static constexpr uint32_t M0 = 0xD2511F53;
+    static constexpr uint32_t M1 = 0xCD9E8D57;
+    static constexpr uint32_t W0 = 0x9E3779B9;
+    static constexpr uint32_t W1 = 0xBB67AE85;
+
+    Key _key;
+    uint64_t _stream;
+
+    /** Counter of the next block to generate */
+    uint64_t _index;
+
+    /** The current block, and how many of its two values were used */
+    Counter block;
+    int used;
+};
+
+} // namespace gem5
+
+#endif // __BASE_PHILOX_HH__
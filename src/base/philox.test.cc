@@ -0,0 +1,117 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "base/philox.hh"
+
+using namespace gem5;
+
+/**
+ * Known-answer tests from the Random123 distribution
+ */
+TEST(PhiloxTest, KnownAnswers)
+{
+    using Counter = Philox4x32::Counter;
+
+    EXPECT_EQ(Philox4x32::generate({0, 0, 0, 0}, {0, 0}),
+              (Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(Philox4x32::generate(
+                  {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                  {0xffffffff, 0xffffffff}),
+              (Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    EXPECT_EQ(Philox4x32::generate(
+                  {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                  {0xa4093822, 0x299f31d0}),
+              (Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+/**
+ * Test that the generator returns the blocks of its counters in order
+ */
+TEST(PhiloxTest, StreamLayout)
+{
+    Philox4x32 rng(0x299f31d0a4093822ULL, 0x0370734413198a2eULL);
+    const auto block = Philox4x32::generate(
+        {0, 0, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0});
+
+    EXPECT_EQ(rng(), uint64_t(block[1]) << 32 | block[0]);
+    EXPECT_EQ(rng(), uint64_t(block[3]) << 32 | block[2]);
+    EXPECT_EQ(rng.position(), 2);
+}
+
+/**
+ * Test that discarding values matches drawing them
+ */
+TEST(PhiloxTest, Discard)
+{
+    for (uint64_t skip : {0, 1, 2, 7, 1000}) {
+        Philox4x32 drawn(42, 3);
+        Philox4x32 skipped(42, 3);
+        for (uint64_t i = 0; i < skip; ++i)
+            drawn();
+        skipped.discard(skip);
+        EXPECT_EQ(drawn, skipped);
+        EXPECT_EQ(drawn(), skipped());
+    }
+}
+
+/**
+ * Test that the streams under a key are independent of each other
+ */
+TEST(PhiloxTest, Streams)
+{
+    Philox4x32 a(42, 0);
+    Philox4x32 b(42, 1);
+    EXPECT_NE(a(), b());
+
+    b.seed(42, 0);
+    a.seed(42, 0);
+    EXPECT_EQ(a(), b());
+}
+
+/**
+ * Test that the generator works with the standard distributions
+ */
+TEST(PhiloxTest, Distribution)
+{
+    Philox4x32 rng(Philox4x32::hash("system.cpu"));
+    std::uniform_int_distribution<int> dist(3, 5);
+    for (int i = 0; i < 100; ++i) {
+        const int value = dist(rng);
+        EXPECT_GE(value, 3);
+        EXPECT_LE(value, 5);
+    }
+}
+
+TEST(PhiloxTest, Hash)
+{
+    // FNV-1a reference values
+    EXPECT_EQ(Philox4x32::hash(""), 0xcbf29ce484222325ULL);
+    EXPECT_EQ(Philox4x32::hash("a"), 0xaf63dc4c8601ec8cULL);
+    EXPECT_EQ(Philox4x32::hash(std::string("a")), Philox4x32::hash("a"));
+}
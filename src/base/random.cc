@@ -51,6 +51,12 @@ Random::Random(uint32_t s)
     init(s);
 }
 
+Random::Random(uint32_t s, uint64_t stream_id)
+    : hasStream(true), streamId(stream_id)
+{
+    init(s);
+}
+
 Random::~Random()
 {
     if (instances) {
@@ -73,7 +79,18 @@ Random::~Random()
 void
 Random::init(uint32_t s)
 {
-    gen.seed(s);
+    if (!hasStream) {
+        gen.seed(s);
+        return;
+    }
+
+    // Expand the seed and the stream ID into the generator state with a
+    // counter-based hash, so that streams with nearby IDs or seeds are
+    // not correlated.
+    const auto words = Philox4x32::generate(
+        {uint32_t(streamId), uint32_t(streamId >> 32), 0, 0}, {s, 0});
+    std::seed_seq seq(words.begin(), words.end());
+    gen.seed(seq);
 }
 
 uint64_t Random::globalSeed = 5489;
@@ -52,6 +52,7 @@
 
 #include "base/compiler.hh"
 #include "base/logging.hh"
+#include "base/philox.hh"
 #include "base/types.hh"
 
 namespace gem5
@@ -117,6 +118,25 @@ class Random
         return randpoint;
     }
 
+    /**
+     * Create an RNG with its own stream, derived from the global seed and
+     * the name of the stream, usually the name of the SimObject using it.
+     * The numbers it produces depend only on the seed and the name, not
+     * on which other objects draw numbers or in which order, so they
+     * stay the same however the objects are spread over event queues.
+     */
+    static RandomPtr genRandom(const std::string &stream_name)
+    {
+        if (instances == nullptr)
+            instances = new Instances();
+
+        auto randpoint = std::shared_ptr<Random>(
+            new Random(globalSeed, Philox4x32::hash(stream_name)));
+        instances->emplace_back(randpoint);
+
+        return randpoint;
+    }
+
     static uint64_t globalSeed;
 
     /**
@@ -141,12 +161,17 @@ class Random
     static_assert(nullptr == 0x0, "nullptr is not 0x0, Random instance tracking will fail");
     static Instances* instances;
 
+    /** Whether the generator is seeded per stream, and its stream ID */
+    bool hasStream = false;
+    uint64_t streamId = 0;
+
     /**
      * @ingroup api_base_utils
      * @{
      */
     Random() = delete;
     Random(uint32_t s);
+    Random(uint32_t s, uint64_t stream_id);
 
     Random(const Random& rng) = delete;
     Random& operator=(const Random& rng) = delete;
@@ -283,6 +283,38 @@ TEST(RandomReseed, GlobalReseedFuture)
     ASSERT_EQ(base_rng->random<uint64_t>(), 13930160852258120406llu);
 }
 
+/**
+ * Test that named streams only depend on the seed and the name
+ */
+TEST(RandomStream, SameNameSameStream)
+{
+    RandomPtr a = Random::genRandom(std::string("system.cpu0"));
+    RandomPtr b = Random::genRandom(std::string("system.cpu1"));
+    RandomPtr c = Random::genRandom(std::string("system.cpu0"));
+
+    // Drawing from another stream does not move this one
+    const uint64_t first_b = b->random<uint64_t>();
+    const uint64_t first_a = a->random<uint64_t>();
+    ASSERT_EQ(c->random<uint64_t>(), first_a);
+    ASSERT_NE(first_a, first_b);
+}
+
+/**
+ * Test that global reseeding restarts named streams
+ */
+TEST(RandomStream, GlobalReseed)
+{
+    RandomPtr rng = Random::genRandom(std::string("system.mem"));
+    const uint64_t first = rng->random<uint64_t>();
+
+    Random::reseedAll(RandomTest::getGlobalSeed() + 1);
+    const uint64_t reseeded = rng->random<uint64_t>();
+    ASSERT_NE(reseeded, first);
+
+    RandomPtr fresh = Random::genRandom(std::string("system.mem"));
+    ASSERT_EQ(fresh->random<uint64_t>(), reseeded);
+}
+
 /** Test that the range provided for random
  *  number generation is valid
  */
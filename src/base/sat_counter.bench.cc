@@ -0,0 +1,94 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "base/microbench.hh"
+#include "base/sat_counter.hh"
+#include "base/sat_counter_array.hh"
+
+using namespace gem5;
+
+/**
+ * Train a table of counters with a data-dependent direction, as a branch
+ * predictor does, and read back their prediction.
+ */
+static void
+satCounterUpdate(microbench::State &state)
+{
+    const size_t size = state.range();
+    std::vector<SatCounter8> table(size, SatCounter8(2));
+
+    uint64_t lfsr = 0xace1;
+    for (auto _ : state) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xd0000001u);
+        SatCounter8 &ctr = table[lfsr & (size - 1)];
+        if (lfsr & 0x100)
+            ctr++;
+        else
+            ctr--;
+        microbench::doNotOptimize(ctr.isSaturated());
+    }
+}
+GEM5_BENCHMARK(satCounterUpdate)->arg(1024)->arg(65536)->arg(1 << 22);
+
+/**
+ * Same as above, with the counters packed in a SatCounterArray.
+ */
+static void
+satCounterArrayUpdate(microbench::State &state)
+{
+    const size_t size = state.range();
+    SatCounterArray table(size, 2);
+
+    uint64_t lfsr = 0xace1;
+    for (auto _ : state) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xd0000001u);
+        auto ctr = table[lfsr & (size - 1)];
+        if (lfsr & 0x100)
+            ctr++;
+        else
+            ctr--;
+        microbench::doNotOptimize(ctr.isSaturated());
+    }
+}
+GEM5_BENCHMARK(satCounterArrayUpdate)->arg(1024)->arg(65536)
+    ->arg(1 << 22);
+
+/**
+ * Age a whole table of counters.
+ */
+static void
+satCounterArrayDecay(microbench::State &state)
+{
+    SatCounterArray table(state.range(), 2, 3);
+
+    for (auto _ : state) {
+        table.decay();
+        microbench::doNotOptimize(table[0]);
+    }
+}
+GEM5_BENCHMARK(satCounterArrayDecay)->arg(65536);
@@ -0,0 +1,283 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SAT_COUNTER_ARRAY_HH__
+#define __BASE_SAT_COUNTER_ARRAY_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+/**
+ * A table of n bit saturating counters that share their limits and
+ * initial value. Unlike a vector of SatCounter8, whose every entry holds
+ * its own limits, the counters are packed in 64-bit words, each in a field
+ * whose width is the number of bits rounded up to a power of two, so that
+ * no counter straddles two words. Besides saving memory, this allows bulk
+ * operations on all the counters to work on whole words.
+ *
+ * Indexing a non-const array returns a reference object that supports the
+ * same increment, decrement and read operations as a SatCounter8.
+ */
+class SatCounterArray
+{
+  public:
+    /** A counter of the array, as returned by the subscript operator. */
+    class Reference
+    {
+      private:
+        SatCounterArray &array;
+        const std::size_t index;
+
+      public:
+        Reference(SatCounterArray &_array, std::size_t _index)
+            : array(_array), index(_index)
+        {}
+
+        /** Read the counter's value. */
+        operator uint8_t() const { return array.get(index); }
+
+        Reference &
+        operator++()
+        {
+            array.increment(index);
+            return *this;
+        }
+
+        uint8_t
+        operator++(int)
+        {
+            const uint8_t old_val = *this;
+            array.increment(index);
+            return old_val;
+        }
+
+        Reference &
+        operator--()
+        {
+            array.decrement(index);
+            return *this;
+        }
+
+        uint8_t
+        operator--(int)
+        {
+            const uint8_t old_val = *this;
+            array.decrement(index);
+            return old_val;
+        }
+
+        /** Saturating add-assignment. */
+        Reference &
+        operator+=(long long value)
+        {
+            const long long new_val = (long long)(*this) + value;
+            array.set(index, new_val < 0 ? 0 :
+                std::min<long long>(new_val, array.maxValue()));
+            return *this;
+        }
+
+        /** Saturating subtract-assignment. */
+        Reference &operator-=(long long value) { return *this += -value; }
+
+        /** Reset the counter to the initial value of the array. */
+        void reset() { array.set(index, array.initialValue()); }
+
+        /** Whether the counter has achieved its maximum value or not. */
+        bool
+        isSaturated() const
+        {
+            return array.get(index) == array.maxValue();
+        }
+    };
+
+    /**
+     * @param size Number of counters.
+     * @param bits How many bits each counter has, at most 8.
+     * @param initial_val Starting value for the counters.
+     */
+    SatCounterArray(std::size_t size, unsigned bits, uint8_t initial_val = 0)
+        : numCounters(size), maxVal((1ULL << bits) - 1),
+          initialVal(initial_val), fieldShift(fieldShiftOf(bits)),
+          fieldMask(lowBits(1 << fieldShift)), wordShift(6 - fieldShift),
+          words(divCeil(size, 1ULL << wordShift))
+    {
+        fatal_if(initial_val > maxVal,
+                 "Saturating counter's initial value exceeds max value.");
+        reset();
+    }
+
+    std::size_t size() const { return numCounters; }
+    uint8_t maxValue() const { return maxVal; }
+    uint8_t initialValue() const { return initialVal; }
+
+    /** Read a counter. */
+    uint8_t
+    get(std::size_t index) const
+    {
+        assert(index < numCounters);
+        return (words[index >> wordShift] >> offset(index)) & fieldMask;
+    }
+
+    /** Set a counter to a value within its limits. */
+    void
+    set(std::size_t index, uint8_t value)
+    {
+        assert(index < numCounters && value <= maxVal);
+        uint64_t &word = words[index >> wordShift];
+        word = (word & ~(fieldMask << offset(index))) |
+            (uint64_t(value) << offset(index));
+    }
+
+    /** Increment a counter, unless it is saturated. */
+    void
+    increment(std::size_t index)
+    {
+        assert(index < numCounters);
+        uint64_t &word = words[index >> wordShift];
+        const unsigned off = offset(index);
+        if (((word >> off) & fieldMask) < maxVal)
+            word += uint64_t(1) << off;
+    }
+
+    /** Decrement a counter, unless it is zero. */
+    void
+    decrement(std::size_t index)
+    {
+        assert(index < numCounters);
+        uint64_t &word = words[index >> wordShift];
+        const unsigned off = offset(index);
+        if ((word >> off) & fieldMask)
+            word -= uint64_t(1) << off;
+    }
+
+    Reference
+    operator[](std::size_t index)
+    {
+        return Reference(*this, index);
+    }
+
+    uint8_t operator[](std::size_t index) const { return get(index); }
+
+    /** Reset all the counters to their initial value. */
+    void
+    reset()
+    {
+        const uint64_t pattern = ones() * initialVal;
+        for (auto &word : words)
+            word = pattern;
+        clearUnused();
+    }
+
+    /**
+     * Shift all the counters right, e.g., to age a table. The counters of
+     * a word are shifted all at once, by masking the bits that cross into
+     * the next field.
+     *
+     * @param shift Number of bits to shift the counters by.
+     */
+    void
+    decay(unsigned shift = 1)
+    {
+        if (shift >= (1u << fieldShift)) {
+            for (auto &word : words)
+                word = 0;
+            return;
+        }
+        const uint64_t keep = ones() * (fieldMask >> shift);
+        for (auto &word : words)
+            word = (word >> shift) & keep;
+    }
+
+    /** Get the sum of all the counters. */
+    uint64_t
+    sum() const
+    {
+        uint64_t total = 0;
+        for (std::size_t i = 0; i < numCounters; i++)
+            total += get(i);
+        return total;
+    }
+
+  private:
+    /** Get the log2 of the width of the fields of n bit counters. */
+    static unsigned
+    fieldShiftOf(unsigned bits)
+    {
+        fatal_if(bits == 0 || bits > 8,
+                 "Number of bits exceeds counter size");
+        return ceilLog2(bits);
+    }
+
+    /** Bit offset of a counter within its word. */
+    unsigned
+    offset(std::size_t index) const
+    {
+        return (index & lowBits(wordShift)) << fieldShift;
+    }
+
+    /** A word with a one in the least significant bit of every field. */
+    uint64_t ones() const { return ~uint64_t(0) / fieldMask; }
+
+    /** Zero the fields of the last word that hold no counter. */
+    void
+    clearUnused()
+    {
+        const std::size_t used = numCounters & lowBits(wordShift);
+        if (used)
+            words.back() &= lowBits(used << fieldShift);
+    }
+
+    static uint64_t
+    lowBits(unsigned nbits)
+    {
+        return nbits >= 64 ? ~uint64_t(0) : (uint64_t(1) << nbits) - 1;
+    }
+
+    const std::size_t numCounters;
+    const uint8_t maxVal;
+    const uint8_t initialVal;
+
+    /** Log2 of the width of the field of each counter. */
+    const unsigned fieldShift;
+    const uint64_t fieldMask;
+
+    /** Log2 of the number of counters per word. */
+    const unsigned wordShift;
+
+    std::vector<uint64_t> words;
+};
+
+} // namespace gem5
+
+#endif // __BASE_SAT_COUNTER_ARRAY_HH__
@@ -0,0 +1,159 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "base/gtest/logging.hh"
+#include "base/sat_counter.hh"
+#include "base/sat_counter_array.hh"
+
+using namespace gem5;
+
+/**
+ * Test that an error is triggered when the number of bits exceeds the
+ * size of a counter
+ */
+TEST(SatCounterArrayDeathTest, BitCountExceeds)
+{
+    gtestLogOutput.str("");
+    EXPECT_ANY_THROW(SatCounterArray counters(4, 9));
+    ASSERT_NE(gtestLogOutput.str().find("Number of bits exceeds counter size"),
+        std::string::npos);
+}
+
+/**
+ * Test that the counters saturate at both ends and do not disturb their
+ * neighbours in the same word
+ */
+TEST(SatCounterArrayTest, Saturation)
+{
+    SatCounterArray counters(16, 3, 2);
+    EXPECT_EQ(counters.maxValue(), 7);
+
+    for (int i = 0; i < 10; ++i)
+        counters[5]++;
+    for (int i = 0; i < 10; ++i)
+        counters[6]--;
+
+    EXPECT_EQ(counters[5], 7);
+    EXPECT_TRUE(counters[5].isSaturated());
+    EXPECT_EQ(counters[6], 0);
+    EXPECT_EQ(counters[4], 2);
+    EXPECT_EQ(counters[7], 2);
+}
+
+/**
+ * Test that random updates behave as on a vector of SatCounter8, for
+ * every counter width
+ */
+TEST(SatCounterArrayTest, MatchesSatCounter)
+{
+    for (unsigned bits = 1; bits <= 8; ++bits) {
+        const size_t size = 1000;
+        const uint8_t initial = (1 << bits) / 2;
+        SatCounterArray counters(size, bits, initial);
+        std::vector<SatCounter8> expected(size, SatCounter8(bits, initial));
+
+        uint64_t lfsr = 0xace1;
+        for (int i = 0; i < 100000; ++i) {
+            lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xd0000001u);
+            const size_t index = lfsr % size;
+            if (lfsr & 0x100) {
+                counters[index]++;
+                expected[index]++;
+            } else {
+                counters[index]--;
+                expected[index]--;
+            }
+        }
+
+        uint64_t sum = 0;
+        for (size_t i = 0; i < size; ++i) {
+            ASSERT_EQ(counters[i], (uint8_t)expected[i]) << bits;
+            sum += expected[i];
+        }
+        EXPECT_EQ(counters.sum(), sum);
+    }
+}
+
+/**
+ * Test the saturating add and subtract assignments
+ */
+TEST(SatCounterArrayTest, AddSubtract)
+{
+    SatCounterArray counters(4, 4);
+    counters[1] += 5;
+    EXPECT_EQ(counters[1], 5);
+    counters[1] += 20;
+    EXPECT_EQ(counters[1], 15);
+    counters[1] -= 3;
+    EXPECT_EQ(counters[1], 12);
+    counters[1] -= 20;
+    EXPECT_EQ(counters[1], 0);
+    counters[1] += -1;
+    EXPECT_EQ(counters[1], 0);
+}
+
+/**
+ * Test that all the counters are reset to their initial value, and that
+ * the fields left unused in the last word do not count
+ */
+TEST(SatCounterArrayTest, Reset)
+{
+    SatCounterArray counters(37, 2, 1);
+    for (size_t i = 0; i < counters.size(); ++i)
+        counters[i] += i;
+
+    counters.reset();
+    for (size_t i = 0; i < counters.size(); ++i)
+        EXPECT_EQ(counters[i], 1);
+    EXPECT_EQ(counters.sum(), 37);
+}
+
+/**
+ * Test that decaying shifts every counter right
+ */
+TEST(SatCounterArrayTest, Decay)
+{
+    SatCounterArray counters(20, 3);
+    for (size_t i = 0; i < counters.size(); ++i)
+        counters[i] += i % 8;
+
+    counters.decay();
+    for (size_t i = 0; i < counters.size(); ++i)
+        EXPECT_EQ(counters[i], (i % 8) >> 1);
+
+    counters.decay(2);
+    for (size_t i = 0; i < counters.size(); ++i)
+        EXPECT_EQ(counters[i], (i % 8) >> 3);
+
+    counters.reset();
+    counters[3] += 7;
+    counters.decay(4);
+    EXPECT_EQ(counters.sum(), 0);
+}
@@ -0,0 +1,103 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/slab_pool.hh"
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+size_t
+nextPoolId()
+{
+    static std::atomic<size_t> next_id(0);
+    return next_id++;
+}
+
+} // anonymous namespace
+
+SlabPool::SlabPool(const std::string &name, size_t block_size,
+                   size_t blocks_per_slab)
+    : id(nextPoolId()), _name(name),
+      _blockSize(roundUp(std::max(block_size, sizeof(Block)),
+                         alignof(std::max_align_t))),
+      blocksPerSlab(blocks_per_slab)
+{
+    fatal_if(!blocks_per_slab, "Slab pool %s needs at least one block "
+             "per slab.", name);
+}
+
+SlabPool::ThreadCache &
+SlabPool::newThreadCache(std::vector<ThreadCache *> &caches)
+{
+    if (caches.size() <= id)
+        caches.resize(id + 1, nullptr);
+
+    // Thread caches are never freed, the blocks in their free lists
+    // may still be referenced by other threads.
+    ThreadCache *cache = new ThreadCache;
+    caches[id] = cache;
+
+    std::lock_guard<std::mutex> lock(cachesMutex);
+    allCaches.push_back(cache);
+    return *cache;
+}
+
+void
+SlabPool::newSlab(ThreadCache &cache)
+{
+    cache.slab = static_cast<uint8_t *>(
+        ::operator new(_blockSize * blocksPerSlab));
+    cache.slabLeft = blocksPerSlab;
+}
+
+Counter
+SlabPool::hits() const
+{
+    std::lock_guard<std::mutex> lock(cachesMutex);
+    Counter total = 0;
+    for (const ThreadCache *cache : allCaches)
+        total += cache->hits.load(std::memory_order_relaxed);
+    return total;
+}
+
+Counter
+SlabPool::misses() const
+{
+    std::lock_guard<std::mutex> lock(cachesMutex);
+    Counter total = 0;
+    for (const ThreadCache *cache : allCaches)
+        total += cache->misses.load(std::memory_order_relaxed);
+    return total;
+}
+
+} // namespace gem5
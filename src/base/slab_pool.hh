@@ -0,0 +1,220 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SLAB_POOL_HH__
+#define __BASE_SLAB_POOL_HH__
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Pool of fixed-size memory blocks carved out of large slabs.
+ *
+ * Every thread has its own free list and current slab, so allocating
+ * and freeing blocks never takes a lock. A block freed by a thread
+ * other than the one that allocated it is simply added to the free
+ * list of the freeing thread. Slabs are never returned to the system;
+ * the pool is meant for objects that are allocated and freed at a high
+ * rate throughout the simulation, such as packets.
+ *
+ * The pool counts, per thread, the allocations that reused a freed
+ * block (hits) and the ones that had to carve a new block out of a
+ * slab (misses).
+ */
+class SlabPool
+{
+  public:
+    /**
+     * @param name Name of the pool, used when reporting statistics.
+     * @param block_size Size of the blocks, rounded up to the
+     *        fundamental alignment.
+     * @param blocks_per_slab Number of blocks in each slab.
+     */
+    SlabPool(const std::string &name, size_t block_size,
+             size_t blocks_per_slab = 1024);
+
+    SlabPool(const SlabPool &) = delete;
+    SlabPool &operator=(const SlabPool &) = delete;
+
+    /** Allocate a block of blockSize() bytes. */
+    void *
+    allocate()
+    {
+        ThreadCache &cache = threadCache();
+        if (cache.freeList) {
+            Block *block = cache.freeList;
+            cache.freeList = block->next;
+            increment(cache.hits);
+            return block;
+        }
+
+        increment(cache.misses);
+        if (!cache.slabLeft)
+            newSlab(cache);
+        void *block = cache.slab;
+        cache.slab += _blockSize;
+        cache.slabLeft--;
+        return block;
+    }
+
+    /** Return a block obtained with allocate() to the pool. */
+    void
+    deallocate(void *ptr)
+    {
+        ThreadCache &cache = threadCache();
+        Block *block = static_cast<Block *>(ptr);
+        block->next = cache.freeList;
+        cache.freeList = block;
+    }
+
+    const std::string &name() const { return _name; }
+    size_t blockSize() const { return _blockSize; }
+
+    /** @{ */
+    /** Counters summed over all threads. */
+    Counter hits() const;
+    Counter misses() const;
+    /** @} */
+
+  private:
+    struct Block
+    {
+        Block *next;
+    };
+
+    struct ThreadCache
+    {
+        Block *freeList = nullptr;
+        uint8_t *slab = nullptr;
+        size_t slabLeft = 0;
+        // Only written by the owning thread, read by statistics
+        std::atomic<Counter> hits{0};
+        std::atomic<Counter> misses{0};
+    };
+
+    static void
+    increment(std::atomic<Counter> &counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+    }
+
+    ThreadCache &
+    threadCache()
+    {
+        // Per-thread caches of all pools, indexed by pool id
+        thread_local std::vector<ThreadCache *> caches;
+        if (id < caches.size() && caches[id])
+            return *caches[id];
+        return newThreadCache(caches);
+    }
+
+    ThreadCache &newThreadCache(std::vector<ThreadCache *> &caches);
+    void newSlab(ThreadCache &cache);
+
+    const size_t id;
+    const std::string _name;
+    const size_t _blockSize;
+    const size_t blocksPerSlab;
+
+    /** All thread caches of this pool, for statistics. */
+    mutable std::mutex cachesMutex;
+    std::vector<ThreadCache *> allCaches;
+};
+
+/**
+ * Standard allocator handing out single objects from a SlabPool, e.g.
+ * to allocate an object and its control block with
+ * std::allocate_shared(). Objects that don't fit in a block of the
+ * pool, and arrays, are allocated with the global operator new.
+ */
+template <typename T>
+class SlabAllocator
+{
+  public:
+    using value_type = T;
+
+    explicit SlabAllocator(SlabPool &_pool) : pool(&_pool) {}
+
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U> &other) : pool(other.pool) {}
+
+    T *
+    allocate(size_t n)
+    {
+        if (fits(n))
+            return static_cast<T *>(pool->allocate());
+        return std::allocator<T>().allocate(n);
+    }
+
+    void
+    deallocate(T *ptr, size_t n)
+    {
+        if (fits(n))
+            pool->deallocate(ptr);
+        else
+            std::allocator<T>().deallocate(ptr, n);
+    }
+
+    template <typename U>
+    bool
+    operator==(const SlabAllocator<U> &other) const
+    {
+        return pool == other.pool;
+    }
+
+    template <typename U>
+    bool
+    operator!=(const SlabAllocator<U> &other) const
+    {
+        return pool != other.pool;
+    }
+
+  private:
+    template <typename U>
+    friend class SlabAllocator;
+
+    bool
+    fits(size_t n) const
+    {
+        return n == 1 && sizeof(T) <= pool->blockSize() &&
+            alignof(T) <= alignof(std::max_align_t);
+    }
+
+    SlabPool *pool;
+};
+
+} // namespace gem5
+
+#endif // __BASE_SLAB_POOL_HH__
@@ -0,0 +1,107 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "base/slab_pool.hh"
+
+using namespace gem5;
+
+TEST(SlabPoolTest, BlockSize)
+{
+    SlabPool pool("test", 3);
+    EXPECT_EQ(pool.blockSize() % alignof(std::max_align_t), 0);
+    EXPECT_GE(pool.blockSize(), 3);
+    EXPECT_EQ(pool.name(), "test");
+}
+
+/** Blocks are distinct until freed, and freed blocks are reused. */
+TEST(SlabPoolTest, ReuseFreedBlocks)
+{
+    SlabPool pool("test", 64, 4);
+
+    std::set<void *> blocks;
+    for (int i = 0; i < 10; i++)
+        blocks.insert(pool.allocate());
+    EXPECT_EQ(blocks.size(), 10);
+    EXPECT_EQ(pool.misses(), 10);
+    EXPECT_EQ(pool.hits(), 0);
+
+    for (void *block : blocks)
+        pool.deallocate(block);
+
+    for (int i = 0; i < 10; i++)
+        EXPECT_EQ(blocks.count(pool.allocate()), 1);
+    EXPECT_EQ(pool.misses(), 10);
+    EXPECT_EQ(pool.hits(), 10);
+}
+
+/** Every thread has its own free list, statistics cover all threads. */
+TEST(SlabPoolTest, Threads)
+{
+    SlabPool pool("test", 32, 8);
+
+    auto worker = [&pool]() {
+        for (int i = 0; i < 100; i++)
+            pool.deallocate(pool.allocate());
+    };
+    std::thread t0(worker);
+    std::thread t1(worker);
+    t0.join();
+    t1.join();
+
+    EXPECT_EQ(pool.misses(), 2);
+    EXPECT_EQ(pool.hits(), 198);
+}
+
+TEST(SlabPoolTest, AllocateShared)
+{
+    SlabPool pool("test", 128);
+    SlabAllocator<int> alloc(pool);
+
+    std::weak_ptr<int> weak;
+    {
+        auto ptr = std::allocate_shared<int>(alloc, 42);
+        EXPECT_EQ(*ptr, 42);
+        weak = ptr;
+    }
+    EXPECT_TRUE(weak.expired());
+    weak.reset();
+    EXPECT_EQ(pool.misses(), 1);
+
+    // The released block, holding the control block, is reused
+    auto ptr = std::allocate_shared<int>(alloc, 7);
+    EXPECT_EQ(pool.hits(), 1);
+
+    // Arrays bypass the pool
+    std::vector<int, SlabAllocator<int>> vec(100, 0, alloc);
+    EXPECT_EQ(pool.misses(), 1);
+    EXPECT_EQ(pool.hits(), 1);
+}
@@ -0,0 +1,119 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SPSC_QUEUE_HH__
+#define __BASE_SPSC_QUEUE_HH__
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+/**
+ * Bounded lock-free queue between a single producer thread and a single
+ * consumer thread.
+ *
+ * The head is only written by the consumer and the tail only by the
+ * producer, so each side only needs to synchronize with the index the
+ * other side publishes. Both indices are free running, the capacity is
+ * rounded up to a power of two to map them to slots.
+ *
+ * @tparam T Type of the elements, it must be default constructible and
+ *         copy assignable.
+ */
+template <typename T>
+class SPSCQueue
+{
+  public:
+    explicit SPSCQueue(size_t capacity)
+        : _capacity(capacity ? size_t(1) << ceilLog2(capacity) : 1),
+          slots(new T[_capacity])
+    {
+        fatal_if(capacity == 0, "An SPSC queue can't be empty.");
+    }
+
+    SPSCQueue(const SPSCQueue &) = delete;
+    SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+    size_t capacity() const { return _capacity; }
+
+    /**
+     * Add an element at the tail of the queue. Producer only.
+     *
+     * @return false if the queue is full.
+     */
+    bool
+    tryPush(const T &value)
+    {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == _capacity)
+            return false;
+        slots[tail & (_capacity - 1)] = value;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Remove the element at the head of the queue. Consumer only.
+     *
+     * @return false if the queue is empty.
+     */
+    bool
+    tryPop(T &value)
+    {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire))
+            return false;
+        value = slots[head & (_capacity - 1)];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Whether the queue is empty, exact on the consumer side only. */
+    bool
+    empty() const
+    {
+        return _head.load(std::memory_order_acquire) ==
+            _tail.load(std::memory_order_acquire);
+    }
+
+  private:
+    const size_t _capacity;
+    std::unique_ptr<T[]> slots;
+
+    /** Index of the next element to pop, written by the consumer */
+    alignas(64) std::atomic<size_t> _head{0};
+    /** Index of the next element to push, written by the producer */
+    alignas(64) std::atomic<size_t> _tail{0};
+};
+
+} // namespace gem5
+
+#endif // __BASE_SPSC_QUEUE_HH__
@@ -0,0 +1,118 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+
+#include "base/spsc_queue.hh"
+
+using namespace gem5;
+
+/**
+ * Test that the capacity is rounded up to a power of two
+ */
+TEST(SPSCQueueTest, Capacity)
+{
+    EXPECT_EQ(SPSCQueue<int>(1).capacity(), 1);
+    EXPECT_EQ(SPSCQueue<int>(5).capacity(), 8);
+    EXPECT_EQ(SPSCQueue<int>(64).capacity(), 64);
+}
+
+/**
+ * Test that elements come out in order and that the queue reports
+ * when it is full or empty
+ */
+TEST(SPSCQueueTest, PushPop)
+{
+    SPSCQueue<int> queue(4);
+    int value = 0;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.tryPop(value));
+
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.tryPush(i));
+    EXPECT_FALSE(queue.tryPush(4));
+    EXPECT_FALSE(queue.empty());
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+    EXPECT_TRUE(queue.empty());
+}
+
+/**
+ * Test that the indices wrap around the slots
+ */
+TEST(SPSCQueueTest, WrapAround)
+{
+    SPSCQueue<int> queue(4);
+    int value = 0;
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(queue.tryPush(i));
+        EXPECT_TRUE(queue.tryPush(i + 1000));
+        EXPECT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+        EXPECT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i + 1000);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+/**
+ * Test that a consumer thread sees everything a producer thread pushes,
+ * in order
+ */
+TEST(SPSCQueueTest, Threads)
+{
+    constexpr uint64_t count = 100000;
+    SPSCQueue<uint64_t> queue(16);
+
+    std::thread producer([&queue]() {
+        for (uint64_t i = 0; i < count; ++i) {
+            while (!queue.tryPush(i))
+                std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t value = 0;
+    while (expected < count) {
+        if (queue.tryPop(value)) {
+            EXPECT_EQ(value, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(queue.empty());
+}
@@ -1950,6 +1950,34 @@ class Scalar : public ScalarBase<Scalar, StatStor>
     }
 };
 
+/**
+ * A scalar stat that several threads may update at the same time.
+ * @sa Stat, ScalarBase, ShardedStatStor
+ */
+class ShardedScalar : public ScalarBase<ShardedScalar, ShardedStatStor>
+{
+  public:
+    using ScalarBase<ShardedScalar, ShardedStatStor>::operator=;
+
+    ShardedScalar(Group *parent = nullptr)
+        : ScalarBase<ShardedScalar, ShardedStatStor>(
+                parent, nullptr, units::Unspecified::get(), nullptr)
+    {
+    }
+
+    ShardedScalar(Group *parent, const char *name, const char *desc = nullptr)
+        : ScalarBase<ShardedScalar, ShardedStatStor>(
+                parent, name, units::Unspecified::get(), desc)
+    {
+    }
+
+    ShardedScalar(Group *parent, const char *name, const units::Base *unit,
+                  const char *desc = nullptr)
+        : ScalarBase<ShardedScalar, ShardedStatStor>(parent, name, unit, desc)
+    {
+    }
+};
+
 /**
  * A stat that calculates the per tick average of a value.
  * @sa Stat, ScalarBase, AvgStor
@@ -2024,6 +2052,33 @@ class Vector : public VectorBase<Vector, StatStor>
     }
 };
 
+/**
+ * A vector of scalar stats that several threads may update at the same
+ * time.
+ * @sa Stat, VectorBase, ShardedStatStor
+ */
+class ShardedVector : public VectorBase<ShardedVector, ShardedStatStor>
+{
+  public:
+    ShardedVector(Group *parent = nullptr)
+        : VectorBase<ShardedVector, ShardedStatStor>(
+                parent, nullptr, units::Unspecified::get(), nullptr)
+    {
+    }
+
+    ShardedVector(Group *parent, const char *name, const char *desc = nullptr)
+        : VectorBase<ShardedVector, ShardedStatStor>(
+                parent, name, units::Unspecified::get(), desc)
+    {
+    }
+
+    ShardedVector(Group *parent, const char *name, const units::Base *unit,
+                  const char *desc = nullptr)
+        : VectorBase<ShardedVector, ShardedStatStor>(parent, name, unit, desc)
+    {
+    }
+};
+
 /**
  * A vector of Average stats.
  * @sa Stat, VectorBase, AvgStor
@@ -2118,6 +2173,51 @@ class Distribution : public DistBase<Distribution, DistStor>
     }
 };
 
+/**
+ * A distribution that several threads may sample at the same time.
+ * @sa Stat, DistBase, ShardedDistStor
+ */
+class ShardedDistribution
+    : public DistBase<ShardedDistribution, ShardedDistStor>
+{
+  public:
+    ShardedDistribution(Group *parent = nullptr)
+        : DistBase<ShardedDistribution, ShardedDistStor>(
+                parent, nullptr, units::Unspecified::get(), nullptr)
+    {
+    }
+
+    ShardedDistribution(Group *parent, const char *name,
+                        const char *desc = nullptr)
+        : DistBase<ShardedDistribution, ShardedDistStor>(
+                parent, name, units::Unspecified::get(), desc)
+    {
+    }
+
+    ShardedDistribution(Group *parent, const char *name,
+                        const units::Base *unit, const char *desc = nullptr)
+        : DistBase<ShardedDistribution, ShardedDistStor>(parent, name, unit,
+                                                         desc)
+    {
+    }
+
+    /**
+     * Set the parameters of this distribution. @sa DistStor::Params
+     * @param min The minimum value of the distribution.
+     * @param max The maximum value of the distribution.
+     * @param bkt The number of values in each bucket.
+     * @return A reference to this distribution.
+     */
+    ShardedDistribution &
+    init(Counter min, Counter max, Counter bkt)
+    {
+        DistStor::Params *params = new DistStor::Params(min, max, bkt);
+        this->setParams(params);
+        this->doInit();
+        return this->self();
+    }
+};
+
 /**
  * A simple histogram stat.
  * @sa Stat, DistBase, HistStor
@@ -0,0 +1,399 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/binary.hh"
+
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <memory>
+
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+/** Records queued for the background thread before end() blocks. */
+constexpr size_t MaxQueuedRecords = 4;
+
+constexpr char Magic[8] = {'g', 'e', 'm', '5', 's', 't', 'a', 'b'};
+constexpr uint32_t ByteOrderMark = 0x01020304;
+
+template <typename T>
+void
+put(std::vector<char> &buf, const T &value)
+{
+    const char *ptr = reinterpret_cast<const char *>(&value);
+    buf.insert(buf.end(), ptr, ptr + sizeof(value));
+}
+
+std::string
+subname(const std::vector<std::string> &subnames, size_t i)
+{
+    if (i < subnames.size() && !subnames[i].empty())
+        return subnames[i];
+    return std::to_string(i);
+}
+
+void
+distColumns(const DistData &data, const std::string &prefix,
+            std::vector<double> &values, std::vector<std::string> *names)
+{
+    const double fields[] = {
+        (double)data.samples, (double)data.sum, (double)data.squares,
+        (double)data.min_val, (double)data.max_val, (double)data.underflow,
+        (double)data.overflow, (double)data.min, (double)data.bucket_size,
+    };
+    values.insert(values.end(), std::begin(fields), std::end(fields));
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+
+    if (names) {
+        static const char *field_names[] = {
+            "samples", "sum", "squares", "min_value", "max_value",
+            "underflows", "overflows", "min", "bucket_size",
+        };
+        const std::string base = prefix + Info::separatorString;
+        for (const char *field : field_names)
+            names->push_back(base + field);
+        for (size_t i = 0; i < data.cvec.size(); i++)
+            names->push_back(base + std::to_string(i));
+    }
+}
+
+} // anonymous namespace
+
+Binary::Binary(std::ostream &stream, bool background)
+    : stream(stream), background(background)
+{
+    std::vector<char> header(Magic, Magic + sizeof(Magic));
+    put(header, Version);
+    put(header, ByteOrderMark);
+    stream.write(header.data(), header.size());
+
+    if (background)
+        writer = std::thread([this]() { writerLoop(); });
+}
+
+Binary::~Binary()
+{
+    if (background) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cond.notify_all();
+        writer.join();
+    }
+    stream.flush();
+}
+
+void
+Binary::flush()
+{
+    if (background) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]() { return queue.empty() && !writing; });
+    }
+    stream.flush();
+}
+
+bool
+Binary::valid() const
+{
+    return stream.good();
+}
+
+void
+Binary::begin()
+{
+    groupPaths.clear();
+    pathStack.clear();
+    entries.clear();
+    values.clear();
+
+    // Stats outside of any group
+    groupPaths.emplace_back();
+    pathStack.push_back(0);
+}
+
+void
+Binary::end()
+{
+    // Stats of the same shape may replace each other, so compare which
+    // stats are output, and where, not only the number of columns.
+    bool changed = !haveSchema || entries.size() != schemaEntries.size() ||
+        groupPaths != schemaPaths;
+    for (size_t i = 0; !changed && i < entries.size(); i++) {
+        const Entry &entry = entries[i];
+        const SchemaEntry &last = schemaEntries[i];
+        changed = entry.info->id != last.id || entry.path != last.path ||
+            entry.columns != last.columns;
+    }
+
+    if (changed) {
+        std::vector<std::string> names;
+        std::vector<double> scratch;
+        schemaEntries.clear();
+        for (const auto &entry : entries) {
+            columns(*entry.info, entry.type, statName(entry), scratch,
+                    &names);
+            schemaEntries.push_back(
+                {entry.info->id, entry.path, entry.columns});
+        }
+        schemaPaths = groupPaths;
+        assert(names.size() == values.size());
+
+        std::vector<char> schema;
+        put(schema, SchemaRecord);
+        put(schema, (uint64_t)names.size());
+        for (const auto &name : names) {
+            put(schema, (uint32_t)name.size());
+            schema.insert(schema.end(), name.begin(), name.end());
+        }
+        write(std::move(schema));
+        haveSchema = true;
+    }
+
+    std::vector<char> dump;
+    dump.reserve(3 * sizeof(uint64_t) + values.size() * sizeof(double));
+    put(dump, DumpRecord);
+    put(dump, (uint64_t)curTick());
+    put(dump, (uint64_t)values.size());
+    const char *data = reinterpret_cast<const char *>(values.data());
+    dump.insert(dump.end(), data, data + values.size() * sizeof(double));
+    write(std::move(dump));
+}
+
+void
+Binary::beginGroup(const char *name)
+{
+    const std::string &parent = groupPaths[pathStack.back()];
+    pathStack.push_back(groupPaths.size());
+    groupPaths.push_back(parent.empty() ? name : parent + "." + name);
+}
+
+void
+Binary::endGroup()
+{
+    assert(pathStack.size() > 1);
+    pathStack.pop_back();
+}
+
+std::string
+Binary::statName(const Entry &entry) const
+{
+    const std::string &path = groupPaths[entry.path];
+    return path.empty() ? entry.info->name : path + "." + entry.info->name;
+}
+
+void
+Binary::columns(const Info &info, StatType type, const std::string &prefix,
+                std::vector<double> &values, std::vector<std::string> *names)
+{
+    const std::string &sep = Info::separatorString;
+
+    switch (type) {
+      case ScalarStat:
+        values.push_back(static_cast<const ScalarInfo &>(info).result());
+        if (names)
+            names->push_back(prefix);
+        break;
+      case VectorStat:
+        {
+            auto &vector = static_cast<const VectorInfo &>(info);
+            const VResult &result = vector.result();
+            values.insert(values.end(), result.begin(), result.end());
+            const bool total = info.flags.isSet(statistics::total);
+            if (total)
+                values.push_back(vector.total());
+            if (names) {
+                for (size_t i = 0; i < result.size(); i++)
+                    names->push_back(prefix + sep +
+                                     subname(vector.subnames, i));
+                if (total)
+                    names->push_back(prefix + sep + "total");
+            }
+        }
+        break;
+      case DistStat:
+        distColumns(static_cast<const DistInfo &>(info).data, prefix,
+                    values, names);
+        break;
+      case VectorDistStat:
+        {
+            auto &vector = static_cast<const VectorDistInfo &>(info);
+            for (size_t i = 0; i < vector.data.size(); i++) {
+                distColumns(vector.data[i],
+                            names ? prefix + sep +
+                                subname(vector.subnames, i) : prefix,
+                            values, names);
+            }
+        }
+        break;
+      case Vector2dStat:
+        {
+            auto &vector = static_cast<const Vector2dInfo &>(info);
+            values.insert(values.end(), vector.cvec.begin(),
+                          vector.cvec.end());
+            if (names) {
+                for (size_t x = 0; x < vector.x; x++) {
+                    const std::string row =
+                        prefix + "_" + subname(vector.subnames, x) + sep;
+                    for (size_t y = 0; y < vector.y; y++)
+                        names->push_back(row + subname(vector.y_subnames, y));
+                }
+            }
+        }
+        break;
+    }
+}
+
+void
+Binary::record(const Info &info, StatType type)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    if (filtered()) {
+        const std::string &path = groupPaths[pathStack.back()];
+        if (!selected(path.empty() ? info.name : path + "." + info.name))
+            return;
+    }
+
+    const size_t first = values.size();
+    columns(info, type, "", values, nullptr);
+    entries.push_back({&info, type, pathStack.back(),
+                       (uint32_t)(values.size() - first)});
+}
+
+void
+Binary::visit(const ScalarInfo &info)
+{
+    record(info, ScalarStat);
+}
+
+void
+Binary::visit(const VectorInfo &info)
+{
+    record(info, VectorStat);
+}
+
+void
+Binary::visit(const DistInfo &info)
+{
+    record(info, DistStat);
+}
+
+void
+Binary::visit(const VectorDistInfo &info)
+{
+    record(info, VectorDistStat);
+}
+
+void
+Binary::visit(const Vector2dInfo &info)
+{
+    record(info, Vector2dStat);
+}
+
+void
+Binary::visit(const FormulaInfo &info)
+{
+    record(info, VectorStat);
+}
+
+void
+Binary::visit(const SparseHistInfo &info)
+{
+    warn_once("Sparse histograms are not output by the binary stats "
+              "format, skipping %s\n", info.name);
+}
+
+void
+Binary::write(std::vector<char> &&data)
+{
+    if (!background) {
+        stream.write(data.data(), data.size());
+        stream.flush();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this]() { return queue.size() < MaxQueuedRecords; });
+    queue.push_back(std::move(data));
+    cond.notify_all();
+}
+
+void
+Binary::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cond.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty())
+            return;
+
+        std::vector<char> data = std::move(queue.front());
+        queue.pop_front();
+        writing = true;
+        cond.notify_all();
+
+        lock.unlock();
+        stream.write(data.data(), data.size());
+        stream.flush();
+        lock.lock();
+
+        writing = false;
+        cond.notify_all();
+    }
+}
+
+Output *
+initBinary(const std::string &filename, bool background)
+{
+    // Constructed after simout, so destroyed (and flushed) before it
+    static std::unique_ptr<Binary> binary;
+
+    if (!binary) {
+        binary = std::make_unique<Binary>(
+            *simout.findOrCreate(filename, true)->stream(), background);
+        if (!binary->valid())
+            fatal("Unable to open binary statistics file for writing\n");
+    }
+
+    return binary.get();
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,188 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_BINARY_HH__
+#define __BASE_STATS_BINARY_HH__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+class Info;
+
+/**
+ * Compact, columnar binary stats output.
+ *
+ * Every stat is flattened into a fixed number of double columns. The
+ * names of the columns (the schema) are written once, and every dump
+ * only writes the raw column values, which is much cheaper to produce
+ * and to store than the text output. A new schema is written whenever
+ * the stats or their columns change between dumps.
+ *
+ * The file starts with the 8 byte magic "gem5stab", a uint32_t version
+ * and a uint32_t byte order mark (0x01020304 in host order), followed by
+ * records. Each record starts with a uint32_t tag:
+ *
+ * - Schema: a uint64_t column count, then for every column a uint32_t
+ *   length and the name.
+ * - Dump: the uint64_t tick of the dump, a uint64_t column count and
+ *   the values as doubles.
+ *
+ * Records are built from the stats on the simulation thread, but they
+ * can be written out on a background thread so the simulation continues
+ * while a dump is being written. Sparse histograms
+ * have no fixed number of columns and are not output.
+ */
+class Binary : public Output
+{
+  public:
+    enum RecordTag : uint32_t
+    {
+        SchemaRecord = 1,
+        DumpRecord = 2,
+    };
+
+    static constexpr uint32_t Version = 1;
+
+    /**
+     * @param stream Stream to write to, which must outlive this object.
+     * @param background Write the records on a background thread.
+     */
+    Binary(std::ostream &stream, bool background);
+    ~Binary();
+
+    Binary(const Binary &) = delete;
+    Binary &operator=(const Binary &) = delete;
+
+    /** Wait until all the dumps so far have been written out. */
+    void flush();
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  private:
+    enum StatType
+    {
+        ScalarStat,
+        VectorStat,
+        DistStat,
+        VectorDistStat,
+        Vector2dStat,
+    };
+
+    /** A stat output in the current dump. */
+    struct Entry
+    {
+        const Info *info;
+        StatType type;
+        /** Index of the group path of the stat in groupPaths. */
+        uint32_t path;
+        uint32_t columns;
+    };
+
+    /**
+     * Append the columns of a stat to values and, if names isn't null,
+     * the names of the columns to names.
+     */
+    static void columns(const Info &info, StatType type,
+                        const std::string &prefix, std::vector<double> &values,
+                        std::vector<std::string> *names);
+
+    void record(const Info &info, StatType type);
+
+    std::string statName(const Entry &entry) const;
+
+    /** Write a record, or queue it for the background thread. */
+    void write(std::vector<char> &&data);
+
+    void writerLoop();
+
+    std::ostream &stream;
+
+    /** Group paths of the current dump, and the stack of open groups. */
+    std::vector<std::string> groupPaths;
+    std::vector<uint32_t> pathStack;
+
+    std::vector<Entry> entries;
+    std::vector<double> values;
+
+    /** A stat in the last schema written. */
+    struct SchemaEntry
+    {
+        int id;
+        uint32_t path;
+        uint32_t columns;
+    };
+    std::vector<SchemaEntry> schemaEntries;
+    std::vector<std::string> schemaPaths;
+    bool haveSchema = false;
+
+    const bool background;
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<std::vector<char>> queue;
+    /** Is the background thread writing a record? */
+    bool writing = false;
+    bool stopping = false;
+};
+
+/**
+ * Create the binary stats output writing to a file in the output
+ * directory.
+ */
+Output *initBinary(const std::string &filename, bool background = true);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_BINARY_HH__
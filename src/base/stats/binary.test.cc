@@ -0,0 +1,299 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/stats/binary.hh"
+#include "base/stats/info.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+GTestTickHandler tickHandler;
+
+class TestScalar : public statistics::ScalarInfo
+{
+  public:
+    statistics::Counter counter = 0;
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override { counter = 0; }
+    bool zero() const override { return !counter; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+
+    statistics::Counter value() const override { return counter; }
+    statistics::Result result() const override { return counter; }
+    statistics::Result total() const override { return counter; }
+};
+
+class TestVector : public statistics::VectorInfo
+{
+  public:
+    statistics::VCounter counters;
+    mutable statistics::VResult results;
+    mutable int evaluations = 0;
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+
+    statistics::size_type size() const override { return counters.size(); }
+    const statistics::VCounter &value() const override { return counters; }
+
+    const statistics::VResult &
+    result() const override
+    {
+        evaluations++;
+        results.assign(counters.begin(), counters.end());
+        return results;
+    }
+
+    statistics::Result
+    total() const override
+    {
+        statistics::Result sum = 0;
+        for (auto c : counters)
+            sum += c;
+        return sum;
+    }
+};
+
+/** Reads the records back from the output. */
+class Reader
+{
+  public:
+    Reader(const std::string &data) : data(data) {}
+
+    template <typename T>
+    T
+    get()
+    {
+        T value;
+        EXPECT_LE(pos + sizeof(T), data.size());
+        std::memcpy(&value, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::string
+    getString(size_t len)
+    {
+        std::string str = data.substr(pos, len);
+        pos += len;
+        return str;
+    }
+
+    bool done() const { return pos == data.size(); }
+
+  private:
+    const std::string data;
+    size_t pos = 0;
+};
+
+void
+dump(statistics::Binary &binary, std::vector<statistics::Info *> infos)
+{
+    binary.begin();
+    binary.beginGroup("system");
+    for (auto info : infos)
+        info->visit(binary);
+    binary.endGroup();
+    binary.end();
+}
+
+} // anonymous namespace
+
+TEST(StatsBinaryTest, SchemaOnceThenValues)
+{
+    TestScalar scalar;
+    scalar.setName("insts", false);
+    scalar.flags.set(statistics::display);
+
+    TestVector vector;
+    vector.setName("misses", false);
+    vector.flags.set(statistics::display | statistics::total);
+    vector.subnames = {"read", ""};
+
+    TestScalar hidden;
+    hidden.setName("hidden", false);
+
+    std::ostringstream out;
+    for (bool background : {false, true}) {
+        out.str("");
+        tickHandler.setCurTick(0);
+        {
+            statistics::Binary binary(out, background);
+            scalar.counter = 5;
+            vector.counters = {1, 2};
+            dump(binary, {&scalar, &hidden, &vector});
+            tickHandler.setCurTick(100);
+            scalar.counter = 7;
+            vector.counters[1] = 4;
+            dump(binary, {&scalar, &hidden, &vector});
+        }
+
+        Reader reader(out.str());
+        EXPECT_EQ(reader.getString(8), "gem5stab");
+        EXPECT_EQ(reader.get<uint32_t>(), statistics::Binary::Version);
+        EXPECT_EQ(reader.get<uint32_t>(), 0x01020304);
+
+        EXPECT_EQ(reader.get<uint32_t>(), statistics::Binary::SchemaRecord);
+        ASSERT_EQ(reader.get<uint64_t>(), 4);
+        std::vector<std::string> names;
+        for (int i = 0; i < 4; i++)
+            names.push_back(reader.getString(reader.get<uint32_t>()));
+        EXPECT_EQ(names, std::vector<std::string>({"system.insts",
+                    "system.misses::read", "system.misses::1",
+                    "system.misses::total"}));
+
+        for (auto expected : {std::vector<double>{5, 1, 2, 3},
+                              std::vector<double>{7, 1, 4, 5}}) {
+            EXPECT_EQ(reader.get<uint32_t>(),
+                      statistics::Binary::DumpRecord);
+            EXPECT_EQ(reader.get<uint64_t>(), expected[0] == 5 ? 0 : 100);
+            ASSERT_EQ(reader.get<uint64_t>(), 4);
+            for (double value : expected)
+                EXPECT_EQ(reader.get<double>(), value);
+        }
+        EXPECT_TRUE(reader.done());
+    }
+}
+
+TEST(StatsBinaryTest, NewSchemaWhenColumnsChange)
+{
+    TestVector vector;
+    vector.setName("v", false);
+    vector.flags.set(statistics::display);
+    vector.counters = {1};
+
+    std::ostringstream out;
+    {
+        statistics::Binary binary(out, false);
+        dump(binary, {&vector});
+        vector.counters = {1, 2};
+        dump(binary, {&vector});
+    }
+
+    Reader reader(out.str());
+    reader.getString(16);
+    for (uint64_t columns : {1, 2}) {
+        EXPECT_EQ(reader.get<uint32_t>(), statistics::Binary::SchemaRecord);
+        ASSERT_EQ(reader.get<uint64_t>(), columns);
+        for (uint64_t i = 0; i < columns; i++)
+            reader.getString(reader.get<uint32_t>());
+        EXPECT_EQ(reader.get<uint32_t>(), statistics::Binary::DumpRecord);
+        reader.get<uint64_t>();
+        ASSERT_EQ(reader.get<uint64_t>(), columns);
+        for (uint64_t i = 0; i < columns; i++)
+            EXPECT_EQ(reader.get<double>(), i + 1);
+    }
+    EXPECT_TRUE(reader.done());
+}
+
+TEST(StatsBinaryTest, NewSchemaWhenStatsChange)
+{
+    TestScalar first;
+    first.setName("first", false);
+    first.flags.set(statistics::display);
+    first.counter = 1;
+
+    TestScalar second;
+    second.setName("second", false);
+    second.flags.set(statistics::display);
+    second.counter = 2;
+
+    std::ostringstream out;
+    {
+        statistics::Binary binary(out, false);
+        dump(binary, {&first});
+        dump(binary, {&second});
+        dump(binary, {&second});
+    }
+
+    Reader reader(out.str());
+    reader.getString(16);
+    for (auto name : {"system.first", "system.second"}) {
+        EXPECT_EQ(reader.get<uint32_t>(), statistics::Binary::SchemaRecord);
+        ASSERT_EQ(reader.get<uint64_t>(), 1);
+        EXPECT_EQ(reader.getString(reader.get<uint32_t>()), name);
+        EXPECT_EQ(reader.get<uint32_t>(), statistics::Binary::DumpRecord);
+        reader.get<uint64_t>();
+        ASSERT_EQ(reader.get<uint64_t>(), 1);
+        reader.get<double>();
+    }
+    // The last dump has the same stats and reuses the schema
+    EXPECT_EQ(reader.get<uint32_t>(), statistics::Binary::DumpRecord);
+    reader.get<uint64_t>();
+    ASSERT_EQ(reader.get<uint64_t>(), 1);
+    EXPECT_EQ(reader.get<double>(), 2);
+    EXPECT_TRUE(reader.done());
+}
+
+TEST(StatsBinaryTest, Filter)
+{
+    TestScalar scalar;
+    scalar.setName("insts", false);
+    scalar.flags.set(statistics::display);
+    scalar.counter = 3;
+
+    TestVector vector;
+    vector.setName("misses", false);
+    vector.flags.set(statistics::display);
+    vector.counters = {1, 2};
+
+    std::ostringstream out;
+    {
+        statistics::Binary binary(out, false);
+        binary.setFilter({"system\\.ins.*"});
+        EXPECT_TRUE(binary.filtered());
+        dump(binary, {&scalar, &vector});
+    }
+    // The filtered out stat is not evaluated
+    EXPECT_EQ(vector.evaluations, 0);
+
+    Reader reader(out.str());
+    reader.getString(8);
+    reader.get<uint32_t>();
+    reader.get<uint32_t>();
+    EXPECT_EQ(reader.get<uint32_t>(), statistics::Binary::SchemaRecord);
+    ASSERT_EQ(reader.get<uint64_t>(), 1);
+    EXPECT_EQ(reader.getString(reader.get<uint32_t>()), "system.insts");
+    EXPECT_EQ(reader.get<uint32_t>(), statistics::Binary::DumpRecord);
+    reader.get<uint64_t>();
+    ASSERT_EQ(reader.get<uint64_t>(), 1);
+    EXPECT_EQ(reader.get<double>(), 3);
+    EXPECT_TRUE(reader.done());
+}
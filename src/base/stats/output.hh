@@ -42,7 +42,10 @@
 #define __BASE_STATS_OUTPUT_HH__
 
 #include <list>
+#include <regex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "base/compiler.hh"
 
@@ -79,6 +82,53 @@ struct Output
     virtual void visit(const Vector2dInfo &info) = 0;
     virtual void visit(const FormulaInfo &info) = 0;
     virtual void visit(const SparseHistInfo &info) = 0; // Sparse histogram
+
+    /**
+     * Only output the stats whose full names match one of the regular
+     * expressions. Stats that are filtered out are not evaluated, so
+     * formulas and distributions cost nothing at dump time. All stats
+     * are output if there are no expressions.
+     */
+    void
+    setFilter(const std::vector<std::string> &patterns)
+    {
+        filter.clear();
+        for (const auto &pattern : patterns)
+            filter.emplace_back(pattern, std::regex::optimize);
+        selectedCache.clear();
+    }
+
+    /** Whether a filter is set */
+    bool filtered() const { return !filter.empty(); }
+
+    /**
+     * Whether the stat with the given full name passes the filter.
+     * Names are looked up once, as the stats are the same in every dump.
+     */
+    bool
+    selected(const std::string &name)
+    {
+        if (filter.empty())
+            return true;
+
+        auto it = selectedCache.find(name);
+        if (it != selectedCache.end())
+            return it->second;
+
+        bool match = false;
+        for (const auto &re : filter) {
+            if (std::regex_match(name, re)) {
+                match = true;
+                break;
+            }
+        }
+        selectedCache.emplace(name, match);
+        return match;
+    }
+
+  private:
+    std::vector<std::regex> filter;
+    std::unordered_map<std::string, bool> selectedCache;
 };
 
 } // namespace statistics
@@ -41,6 +41,8 @@
 
 #include "base/stats/storage.hh"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 
 namespace gem5
@@ -49,6 +51,13 @@ namespace gem5
 namespace statistics
 {
 
+unsigned
+newStatShard()
+{
+    static std::atomic<unsigned> next(0);
+    return next++ % MaxStatShards;
+}
+
 void
 DistStor::sample(Counter val, int number)
 {
@@ -226,5 +235,35 @@ HistStor::add(HistStor *hs)
         cvec[i] += hs->cvec[i];
 }
 
+void
+ShardedDistStor::prepare(const StorageParams* const storage_params,
+                         DistData &data)
+{
+    shards[0].stor.prepare(storage_params, data);
+
+    DistData shard_data;
+    for (size_type i = 1; i < shards.size(); ++i) {
+        DistStor &stor = shards[i].stor;
+        if (stor.zero())
+            continue;
+        stor.prepare(storage_params, shard_data);
+
+        if (data.samples == Counter()) {
+            data.min_val = shard_data.min_val;
+            data.max_val = shard_data.max_val;
+        } else {
+            data.min_val = std::min(data.min_val, shard_data.min_val);
+            data.max_val = std::max(data.max_val, shard_data.max_val);
+        }
+        data.underflow += shard_data.underflow;
+        data.overflow += shard_data.overflow;
+        for (size_type b = 0; b < data.cvec.size(); ++b)
+            data.cvec[b] += shard_data.cvec[b];
+        data.sum += shard_data.sum;
+        data.squares += shard_data.squares;
+        data.samples += shard_data.samples;
+    }
+}
+
 } // namespace statistics
 } // namespace gem5
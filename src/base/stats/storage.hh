@@ -30,8 +30,10 @@
 #ifndef __BASE_STATS_STORAGE_HH__
 #define __BASE_STATS_STORAGE_HH__
 
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <vector>
 
 #include "base/cast.hh"
 #include "base/compiler.hh"
@@ -116,6 +118,83 @@ class StatStor
     bool zero() const { return data == Counter(); }
 };
 
+/** Number of threads that sharded storage keeps apart */
+constexpr unsigned MaxStatShards = 16;
+
+/** Pick the shard of a thread that uses sharded storage the first time */
+unsigned newStatShard();
+
+/**
+ * The shard of sharded storage that the calling thread updates. Shards
+ * are handed out to threads in the order they first update a sharded
+ * stat. If there are more threads than shards, shards are reused, and
+ * the threads that share a shard race again.
+ */
+inline unsigned
+statShard()
+{
+    thread_local const unsigned shard = newStatShard();
+    return shard;
+}
+
+/**
+ * Storage for a scalar stat that is updated by several threads, e.g.
+ * by objects on different event queues. Each thread updates a shard
+ * of its own, so updates need no atomics and don't share cache lines,
+ * and the shards are summed when the stat is read. Setting the stat
+ * is meant for resets, and should not race with updates.
+ */
+class ShardedStatStor
+{
+  private:
+    /** A counter padded to a cache line */
+    struct Shard
+    {
+        Counter data = Counter();
+        char pad[64 - sizeof(Counter)];
+    };
+
+    std::array<Shard, MaxStatShards> shards;
+
+  public:
+    struct Params : public StorageParams {};
+
+    ShardedStatStor(const StorageParams* const storage_params) { }
+
+    void
+    set(Counter val)
+    {
+        for (auto &shard : shards)
+            shard.data = Counter();
+        shards[statShard()].data = val;
+    }
+
+    void inc(Counter val) { shards[statShard()].data += val; }
+
+    void dec(Counter val) { shards[statShard()].data -= val; }
+
+    /**
+     * Return the sum of the shards.
+     * @return The value of this stat.
+     */
+    Counter
+    value() const
+    {
+        Counter sum = Counter();
+        for (const auto &shard : shards)
+            sum += shard.data;
+        return sum;
+    }
+
+    Result result() const { return (Result)value(); }
+
+    void prepare(const StorageParams* const storage_params) { }
+
+    void reset(const StorageParams* const storage_params) { set(Counter()); }
+
+    bool zero() const { return value() == Counter(); }
+};
+
 /**
  * Templatized storage and interface to a per-tick average stat. This keeps
  * a current count and updates a total (count * ticks) when this count
@@ -364,6 +443,62 @@ class DistStor
     }
 };
 
+/**
+ * Storage for a distribution that is sampled by several threads. Each
+ * thread samples a DistStor of its own, and the shards are merged when
+ * the distribution is prepared for dumping.
+ */
+class ShardedDistStor
+{
+  private:
+    /** A distribution padded to a cache line */
+    struct Shard
+    {
+        DistStor stor;
+        char pad[64];
+
+        Shard(const StorageParams* const storage_params)
+            : stor(storage_params)
+        {}
+    };
+
+    std::vector<Shard> shards;
+
+  public:
+    typedef DistStor::Params Params;
+
+    ShardedDistStor(const StorageParams* const storage_params)
+        : shards(MaxStatShards, Shard(storage_params))
+    { }
+
+    void
+    sample(Counter val, int number)
+    {
+        shards[statShard()].stor.sample(val, number);
+    }
+
+    size_type size() const { return shards[0].stor.size(); }
+
+    bool
+    zero() const
+    {
+        for (const auto &shard : shards) {
+            if (!shard.stor.zero())
+                return false;
+        }
+        return true;
+    }
+
+    void prepare(const StorageParams* const storage_params, DistData &data);
+
+    void
+    reset(const StorageParams* const storage_params)
+    {
+        for (auto &shard : shards)
+            shard.stor.reset(storage_params);
+    }
+};
+
 /**
  * Templatized storage and interface for a histogram stat.
  *
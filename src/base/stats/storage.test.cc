@@ -30,6 +30,8 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <thread>
+#include <vector>
 
 #include "base/gtest/cur_tick_fake.hh"
 #include "base/gtest/logging.hh"
@@ -129,6 +131,72 @@ TEST(StatsStatStorTest, ZeroReset)
     ASSERT_FALSE(stor.zero());
 }
 
+/** Test that updates from many threads are all counted. */
+TEST(StatsShardedStatStorTest, Threads)
+{
+    statistics::ShardedStatStor stor(nullptr);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&stor]() {
+            for (int i = 0; i < 100000; i++)
+                stor.inc(2);
+            stor.dec(1);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    ASSERT_EQ(stor.value(), 8 * (2 * 100000 - 1));
+    ASSERT_EQ(stor.result(), statistics::Result(8 * (2 * 100000 - 1)));
+    ASSERT_FALSE(stor.zero());
+
+    stor.set(10);
+    ASSERT_EQ(stor.value(), 10);
+    stor.reset(nullptr);
+    ASSERT_TRUE(stor.zero());
+}
+
+/**
+ * Test that the shards of a distribution sampled by many threads merge
+ * into the distribution sampled by one thread.
+ */
+TEST(StatsShardedDistStorTest, Threads)
+{
+    statistics::DistStor::Params params(0, 99, 4);
+    statistics::DistStor expected_stor(&params);
+    statistics::ShardedDistStor stor(&params);
+    ASSERT_TRUE(stor.zero());
+    ASSERT_EQ(stor.size(), expected_stor.size());
+
+    // Each thread samples a different range, some out of bounds
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        for (int i = 0; i < 100; i++)
+            expected_stor.sample(t * 40 - 20 + i, t + 1);
+        threads.emplace_back([&stor, t]() {
+            for (int i = 0; i < 100; i++)
+                stor.sample(t * 40 - 20 + i, t + 1);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    statistics::DistData expected, data;
+    expected_stor.prepare(&params, expected);
+    stor.prepare(&params, data);
+    ASSERT_EQ(data.min_val, expected.min_val);
+    ASSERT_EQ(data.max_val, expected.max_val);
+    ASSERT_EQ(data.underflow, expected.underflow);
+    ASSERT_EQ(data.overflow, expected.overflow);
+    ASSERT_EQ(data.cvec, expected.cvec);
+    ASSERT_EQ(data.sum, expected.sum);
+    ASSERT_EQ(data.squares, expected.squares);
+    ASSERT_EQ(data.samples, expected.samples);
+
+    stor.reset(&params);
+    ASSERT_TRUE(stor.zero());
+}
+
 /** Test setting and getting a value to the storage. */
 TEST(StatsAvgStorTest, SetValueResult)
 {
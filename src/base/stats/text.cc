@@ -174,6 +174,9 @@ Text::noOutput(const Info &info)
     if (info.prereq && info.prereq->zero())
         return true;
 
+    if (filtered() && !selected(statName(info.name)))
+        return true;
+
     return false;
 }
 
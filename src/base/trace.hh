@@ -32,9 +32,13 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <cstdint>
+#include <cstring>
 #include <ostream>
 #include <string>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "base/cprintf.hh"
@@ -54,6 +58,81 @@ namespace gem5
 
 namespace trace {
 
+/**
+ * Encoding of the raw arguments of a message, for loggers that record
+ * messages without formatting them. Each argument is a Type tag and
+ * its size in bytes, followed by the value in host byte order, or the
+ * length and characters of a String.
+ */
+namespace raw_arg
+{
+
+enum Type : uint8_t
+{
+    Bool,
+    Char,
+    Signed,
+    Unsigned,
+    Float,
+    String,
+};
+
+inline void
+putHeader(std::vector<uint8_t> &buf, Type type, uint8_t size)
+{
+    buf.push_back(type);
+    buf.push_back(size);
+}
+
+template <typename T>
+inline void
+putValue(std::vector<uint8_t> &buf, Type type, const T &value)
+{
+    putHeader(buf, type, sizeof(T));
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    buf.insert(buf.end(), bytes, bytes + sizeof(T));
+}
+
+inline void
+putString(std::vector<uint8_t> &buf, const char *str, uint32_t len)
+{
+    putValue(buf, String, len);
+    buf.insert(buf.end(), str, str + len);
+}
+
+/** Append one argument, types without an encoding are stored as the
+ *  text their operator<< produces, which is what cprintf prints. */
+template <typename T>
+void
+put(std::vector<uint8_t> &buf, const T &arg)
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        putValue(buf, Bool, arg);
+    } else if constexpr (std::is_same_v<T, char>) {
+        putValue(buf, Char, arg);
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        putValue(buf, Signed, arg);
+    } else if constexpr (std::is_integral_v<T>) {
+        putValue(buf, Unsigned, arg);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        putValue(buf, Float, (double)arg);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        putString(buf, arg.data(), arg.size());
+    } else if constexpr (std::is_convertible_v<const T &, const char *>) {
+        const char *str = arg;
+        putString(buf, str, str ? std::strlen(str) : 0);
+    } else if constexpr (std::is_pointer_v<T>) {
+        putValue(buf, Unsigned, (uintptr_t)arg);
+    } else {
+        std::ostringstream text;
+        text << arg;
+        const std::string str = text.str();
+        putString(buf, str.data(), str.size());
+    }
+}
+
+} // namespace raw_arg
+
 /** Debug logging base class.  Handles formatting and outputting
  *  time/name/message messages */
 class Logger
@@ -64,6 +143,24 @@ class Logger
     /** Name match for objects to activate log */
     ObjectMatch activate;
 
+    /** Set by loggers that record messages with their raw arguments
+     *  through beginRaw() and endRaw() instead of formatting them */
+    bool recordsRaw = false;
+
+    /**
+     * Start recording a message. The arguments are appended to the
+     * returned buffer, see raw_arg, before endRaw() is called.
+     */
+    virtual std::vector<uint8_t> &
+    beginRaw(Tick when, const std::string &name, const std::string &flag,
+             const char *fmt, unsigned num_args)
+    {
+        panic("This logger doesn't record raw messages.\n");
+    }
+
+    /** Finish the message started by beginRaw(). */
+    virtual void endRaw() {}
+
     bool isEnabled(const std::string &name) const
     {
         if (name.empty()) // Enable the logger with a empty name.
@@ -96,6 +193,13 @@ class Logger
     {
         if (!isEnabled(name))
             return;
+        if (recordsRaw) {
+            std::vector<uint8_t> &buf =
+                beginRaw(when, name, flag, fmt, sizeof...(args));
+            (raw_arg::put(buf, args), ...);
+            endRaw();
+            return;
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -188,11 +292,15 @@ struct StringWrap
  * debug::Flag some_flag = debug::DMA;
  * DPRINTFV(some_flag, ...);
  *
+ * DPRINTFA takes the address, or PC, that the message is about, and
+ * skips the message if it is outside of the address range of the flag.
+ *
  * \def DDUMP(x, data, count)
  * \def DPRINTF(x, ...)
  * \def DPRINTFS(x, s, ...)
  * \def DPRINTFR(x, ...)
  * \def DPRINTFV(x, ...)
+ * \def DPRINTFA(x, addr, ...)
  * \def DPRINTFN(...)
  * \def DPRINTFNR(...)
  *
@@ -234,6 +342,13 @@ struct StringWrap
     }                                                  \
 } while (0)
 
+#define DPRINTFA(x, addr, ...) do {                     \
+    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x.tracing(addr))) { \
+        ::gem5::trace::getDebugLogger()->dprintf_flag(   \
+            ::gem5::curTick(), name(), #x, __VA_ARGS__); \
+    }                                            \
+} while (0)
+
 #define DPRINTFN(...) do {                                                \
     if (TRACING_ON) {                                                     \
         ::gem5::trace::getDebugLogger()->dprintf( \
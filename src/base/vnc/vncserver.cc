@@ -56,11 +56,15 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 
 #include "base/atomicio.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/output.hh"
 #include "base/socket.hh"
@@ -118,7 +122,8 @@ VncServer::DataEvent::process(int revent)
 VncServer::VncServer(const Params &p)
     : VncInput(p), listenEvent(NULL), dataEvent(NULL), number(p.number),
       dataFd(-1), listener(p.port.build(p.name)),
-      sendUpdate(false), supportsRawEnc(false), supportsResizeEnc(false)
+      sendUpdate(false), supportsRawEnc(false), supportsResizeEnc(false),
+      supportsZrleEnc(false), zrleStreamValid(false)
 {
     if (p.port)
         listen();
@@ -152,6 +157,8 @@ VncServer::~VncServer()
 
     if (dataEvent)
         delete dataEvent;
+
+    endZrleStream();
 }
 
 
@@ -197,6 +204,10 @@ VncServer::accept()
 
     dataFd = fd;
 
+    // A new client has seen nothing, and gets a fresh zlib stream
+    invalidateTiles();
+    endZrleStream();
+
     // Send our version number to the client
     write((uint8_t *)vncVersion(), strlen(vncVersion()));
 
@@ -344,6 +355,8 @@ VncServer::detach()
         dataFd = -1;
     }
 
+    endZrleStream();
+
     if (!dataEvent || !dataEvent->queued())
         return;
 
@@ -515,7 +528,7 @@ VncServer::setEncodings()
     pem.num_encodings = betoh(pem.num_encodings);
 
     DPRINTF(VNC, " -- %d encoding present\n", pem.num_encodings);
-    supportsRawEnc = supportsResizeEnc = false;
+    supportsRawEnc = supportsResizeEnc = supportsZrleEnc = false;
 
     for (int x = 0; x < pem.num_encodings; x++) {
         int32_t encoding;
@@ -530,6 +543,9 @@ VncServer::setEncodings()
           case EncodingDesktopSize:
             supportsResizeEnc = true;
             break;
+          case EncodingZRLE:
+            supportsZrleEnc = true;
+            break;
         }
     }
 
@@ -556,6 +572,12 @@ VncServer::requestFbUpdate()
     DPRINTF(VNC, " -- x = %d y = %d w = %d h = %d\n", fbr.x, fbr.y, fbr.width,
             fbr.height);
 
+    // The client wants the whole frame buffer, not just what changed
+    if (!fbr.incremental) {
+        invalidateTiles();
+        sendUpdate = true;
+    }
+
     sendFrameBufferUpdate();
 }
 
@@ -617,6 +639,157 @@ VncServer::recvCutText()
 }
 
 
+void
+VncServer::invalidateTiles()
+{
+    std::fill(tileHashes.begin(), tileHashes.end(), invalidTileHash);
+}
+
+uint64_t
+VncServer::tileHash(unsigned tx, unsigned ty) const
+{
+    const unsigned x = tx * tileSize;
+    const unsigned y = ty * tileSize;
+    const unsigned w = std::min(tileSize, fb->width() - x);
+    const unsigned h = std::min(tileSize, fb->height() - y);
+
+    uLong hash = adler32(0UL, Z_NULL, 0);
+    for (unsigned row = y; row < y + h; ++row) {
+        hash = adler32(hash,
+                       reinterpret_cast<const Bytef *>(&fb->pixel(x, row)),
+                       w * sizeof(Pixel));
+    }
+    return hash;
+}
+
+void
+VncServer::encodeRaw(std::vector<uint8_t> &buf, unsigned x, unsigned y,
+                     unsigned w, unsigned h) const
+{
+    size_t pos = buf.size();
+    buf.resize(pos + w * h * pixelConverter.length);
+    uint8_t *raw_pixel(buf.data() + pos);
+    for (unsigned row = y; row < y + h; ++row) {
+        for (unsigned col = x; col < x + w; ++col) {
+            pixelConverter.fromPixel(raw_pixel, fb->pixel(col, row));
+            raw_pixel += pixelConverter.length;
+        }
+    }
+}
+
+void
+VncServer::encodeZrleTile(std::vector<uint8_t> &buf, unsigned x, unsigned y,
+                          unsigned w, unsigned h) const
+{
+    // Our pixels are little endian with all the channels in the low three
+    // bytes, so ZRLE sends them as those three bytes (a CPIXEL).
+    auto cpixel = [this, &buf](const Pixel &p) {
+        const uint32_t word = pixelConverter.fromPixel(p);
+        buf.push_back(word & 0xff);
+        buf.push_back((word >> 8) & 0xff);
+        buf.push_back((word >> 16) & 0xff);
+    };
+
+    const size_t start = buf.size();
+    const Pixel &first = fb->pixel(x, y);
+
+    // Plain RLE, which collapses into a solid tile if there is a single
+    // run. Fall back to raw pixels if the runs don't pay for themselves.
+    buf.push_back(128);
+    unsigned runs = 0;
+    const Pixel *run_pixel = &first;
+    unsigned run_length = 0;
+    auto end_run = [&]() {
+        cpixel(*run_pixel);
+        unsigned n = run_length - 1;
+        for (; n >= 255; n -= 255)
+            buf.push_back(255);
+        buf.push_back(n);
+        ++runs;
+    };
+    for (unsigned row = y; row < y + h; ++row) {
+        for (unsigned col = x; col < x + w; ++col) {
+            const Pixel &p = fb->pixel(col, row);
+            if (run_length && p == *run_pixel) {
+                ++run_length;
+                continue;
+            }
+            if (run_length)
+                end_run();
+            run_pixel = &p;
+            run_length = 1;
+        }
+    }
+    end_run();
+
+    const size_t raw_size = 1 + w * h * 3;
+    if (runs == 1) {
+        buf.resize(start);
+        buf.push_back(1);
+        cpixel(first);
+    } else if (buf.size() - start > raw_size) {
+        buf.resize(start);
+        buf.push_back(0);
+        for (unsigned row = y; row < y + h; ++row)
+            for (unsigned col = x; col < x + w; ++col)
+                cpixel(fb->pixel(col, row));
+    }
+}
+
+void
+VncServer::encodeZrle(std::vector<uint8_t> &buf, unsigned x, unsigned y,
+                      unsigned w, unsigned h)
+{
+    if (!zrleStreamValid) {
+        zrleStream.zalloc = Z_NULL;
+        zrleStream.zfree = Z_NULL;
+        zrleStream.opaque = Z_NULL;
+        panic_if(deflateInit(&zrleStream, Z_BEST_SPEED) != Z_OK,
+                 "%s: failed to set up the ZRLE zlib stream", name());
+        zrleStreamValid = true;
+    }
+
+    zrleBuffer.clear();
+    for (unsigned ty = y; ty < y + h; ty += tileSize) {
+        for (unsigned tx = x; tx < x + w; tx += tileSize) {
+            encodeZrleTile(zrleBuffer, tx, ty,
+                           std::min(tileSize, x + w - tx),
+                           std::min(tileSize, y + h - ty));
+        }
+    }
+
+    // The compressed data is preceded by its length
+    const size_t length_pos = buf.size();
+    buf.resize(length_pos + sizeof(uint32_t));
+
+    zrleStream.next_in = zrleBuffer.data();
+    zrleStream.avail_in = zrleBuffer.size();
+    do {
+        const size_t pos = buf.size();
+        const size_t chunk = deflateBound(&zrleStream, zrleStream.avail_in);
+        buf.resize(pos + chunk);
+        zrleStream.next_out = buf.data() + pos;
+        zrleStream.avail_out = chunk;
+        const int ret = deflate(&zrleStream, Z_SYNC_FLUSH);
+        panic_if(ret != Z_OK && ret != Z_BUF_ERROR,
+                 "%s: failed to compress ZRLE data", name());
+        buf.resize(pos + chunk - zrleStream.avail_out);
+    } while (zrleStream.avail_out == 0);
+
+    const uint32_t length =
+        htobe<uint32_t>(buf.size() - length_pos - sizeof(uint32_t));
+    std::memcpy(buf.data() + length_pos, &length, sizeof(length));
+}
+
+void
+VncServer::endZrleStream()
+{
+    if (zrleStreamValid) {
+        deflateEnd(&zrleStream);
+        zrleStreamValid = false;
+    }
+}
+
 void
 VncServer::sendFrameBufferUpdate()
 {
@@ -629,43 +802,86 @@ VncServer::sendFrameBufferUpdate()
     // The client will request data constantly, unless we throttle it
     sendUpdate = false;
 
-    DPRINTF(VNC, "Sending framebuffer update\n");
+    assert(fb);
 
-    FrameBufferUpdate fbu;
-    FrameBufferRect fbr;
+    const unsigned tiles_x = divCeil(fb->width(), tileSize);
+    const unsigned tiles_y = divCeil(fb->height(), tileSize);
+    if (tileHashes.size() != tiles_x * tiles_y)
+        tileHashes.assign(tiles_x * tiles_y, invalidTileHash);
+
+    // Find the tiles that changed, and merge the ones next to each other
+    // in a row of tiles into a single rectangle.
+    std::vector<FrameBufferRect> rects;
+    for (unsigned ty = 0; ty < tiles_y; ++ty) {
+        bool in_rect = false;
+        for (unsigned tx = 0; tx < tiles_x; ++tx) {
+            const uint64_t hash = tileHash(tx, ty);
+            uint64_t &last_hash = tileHashes[ty * tiles_x + tx];
+            if (hash == last_hash) {
+                in_rect = false;
+                continue;
+            }
+            last_hash = hash;
+
+            const unsigned w = std::min(tileSize, fb->width() - tx * tileSize);
+            if (in_rect) {
+                rects.back().width += w;
+                continue;
+            }
+
+            FrameBufferRect fbr;
+            fbr.x = tx * tileSize;
+            fbr.y = ty * tileSize;
+            fbr.width = w;
+            fbr.height = std::min(tileSize, fb->height() - ty * tileSize);
+            rects.push_back(fbr);
+            in_rect = true;
+        }
+    }
 
-    fbu.type = ServerFrameBufferUpdate;
-    fbu.num_rects = 1;
-    fbr.x = 0;
-    fbr.y = 0;
-    fbr.width = videoWidth();
-    fbr.height = videoHeight();
-    fbr.encoding = EncodingRaw;
+    if (rects.empty()) {
+        DPRINTF(VNC, "Frame buffer unchanged, NOT sending update\n");
+        return;
+    }
 
-    // fix up endian
-    fbu.num_rects = htobe(fbu.num_rects);
-    fbr.x = htobe(fbr.x);
-    fbr.y = htobe(fbr.y);
-    fbr.width = htobe(fbr.width);
-    fbr.height = htobe(fbr.height);
-    fbr.encoding = htobe(fbr.encoding);
+    // The rectangle count has to fit the update message
+    if (rects.size() > UINT16_MAX) {
+        rects.resize(1);
+        rects[0].x = 0;
+        rects[0].y = 0;
+        rects[0].width = fb->width();
+        rects[0].height = fb->height();
+    }
+
+    const int32_t encoding = supportsZrleEnc ? EncodingZRLE : EncodingRaw;
+    DPRINTF(VNC, "Sending framebuffer update of %d rectangles, "
+            "encoding %d\n", rects.size(), encoding);
+
+    FrameBufferUpdate fbu;
+    fbu.type = ServerFrameBufferUpdate;
+    fbu.num_rects = htobe<uint16_t>(rects.size());
 
     // send headers to client
-    if (!write(&fbu) || !write(&fbr))
+    if (!write(&fbu))
         return;
 
-    assert(fb);
+    for (const auto &rect: rects) {
+        FrameBufferRect fbr;
 
-    std::vector<uint8_t> line_buffer(pixelConverter.length * fb->width());
-    for (int y = 0; y < fb->height(); ++y) {
-        // Convert and send a line at a time
-        uint8_t *raw_pixel(line_buffer.data());
-        for (unsigned x = 0; x < fb->width(); ++x) {
-            pixelConverter.fromPixel(raw_pixel, fb->pixel(x, y));
-            raw_pixel += pixelConverter.length;
-        }
+        // fix up endian
+        fbr.x = htobe(rect.x);
+        fbr.y = htobe(rect.y);
+        fbr.width = htobe(rect.width);
+        fbr.height = htobe(rect.height);
+        fbr.encoding = htobe(encoding);
+
+        rectBuffer.clear();
+        if (encoding == EncodingZRLE)
+            encodeZrle(rectBuffer, rect.x, rect.y, rect.width, rect.height);
+        else
+            encodeRaw(rectBuffer, rect.x, rect.y, rect.width, rect.height);
 
-        if (!write(line_buffer.data(), line_buffer.size()))
+        if (!write(&fbr) || !write(rectBuffer.data(), rectBuffer.size()))
             return;
     }
 }
@@ -715,6 +931,8 @@ VncServer::setDirty()
 void
 VncServer::frameBufferResized()
 {
+    invalidateTiles();
+
     if (dataFd > 0 && curState == NormalPhase) {
         if (supportsResizeEnc)
             sendFrameBufferResized();
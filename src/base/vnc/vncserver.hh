@@ -42,7 +42,10 @@
 #ifndef __BASE_VNC_VNC_SERVER_HH__
 #define __BASE_VNC_VNC_SERVER_HH__
 
+#include <zlib.h>
+
 #include <iostream>
+#include <vector>
 
 #include "base/circlebuf.hh"
 #include "base/compiler.hh"
@@ -89,6 +92,7 @@ class VncServer : public VncInput
         EncodingRaw         = 0,
         EncodingCopyRect    = 1,
         EncodingHextile     = 5,
+        EncodingZRLE        = 16,
         EncodingDesktopSize = -223
     };
 
@@ -211,6 +215,30 @@ class VncServer : public VncInput
     /** If the vnc client supports the desktop resize command */
     bool supportsResizeEnc;
 
+    /** If the vnc client supports receiving ZRLE compressed data */
+    bool supportsZrleEnc;
+
+    /**
+     * The frame buffer is tracked in square tiles of this many pixels, the
+     * same size as ZRLE tiles, and only the tiles that changed since the
+     * client last saw them are sent.
+     */
+    static const unsigned tileSize = 64;
+
+    /** Hash a tile can never have, for tiles the client hasn't seen */
+    static const uint64_t invalidTileHash = ~0ULL;
+
+    /** Hash of each tile as it was last sent to the client, row major */
+    std::vector<uint64_t> tileHashes;
+
+    /** The zlib stream of a ZRLE connection, which lasts as long as it */
+    z_stream zrleStream;
+    bool zrleStreamValid;
+
+    /** Scratch buffers to stage encoded rectangles in */
+    std::vector<uint8_t> rectBuffer;
+    std::vector<uint8_t> zrleBuffer;
+
   protected:
     /**
      * vnc client Interface
@@ -281,11 +309,37 @@ class VncServer : public VncInput
      */
     void sendError(std::string error_msg);
 
-    /** Send a updated frame buffer to the client.
-     * @todo this doesn't do anything smart and just sends the entire image
-     */
+    /** Send the parts of the frame buffer that changed to the client */
     void sendFrameBufferUpdate();
 
+    /** Forget what the client has seen so the next update sends it all */
+    void invalidateTiles();
+
+    /** Hash the pixels of a tile of the frame buffer
+     * @param tx column of the tile
+     * @param ty row of the tile
+     */
+    uint64_t tileHash(unsigned tx, unsigned ty) const;
+
+    /** Append a rectangle of the frame buffer to a buffer encoded as raw
+     * pixels.
+     */
+    void encodeRaw(std::vector<uint8_t> &buf, unsigned x, unsigned y,
+                   unsigned w, unsigned h) const;
+
+    /** Append a rectangle of the frame buffer to a buffer encoded as ZRLE.
+     * This compresses with the zlib stream of the connection.
+     */
+    void encodeZrle(std::vector<uint8_t> &buf, unsigned x, unsigned y,
+                    unsigned w, unsigned h);
+
+    /** Append a ZRLE tile to the uncompressed ZRLE data */
+    void encodeZrleTile(std::vector<uint8_t> &buf, unsigned x, unsigned y,
+                        unsigned w, unsigned h) const;
+
+    /** Tear down the zlib stream of the last ZRLE connection */
+    void endZrleStream();
+
     /** Receive pixel foramt message from client and process it. */
     void setPixelFormat();
 
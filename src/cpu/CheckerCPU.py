@@ -43,6 +43,18 @@ class CheckerCPU(BaseCPU):
         True,
         "If a load result is incorrect, only print a warning and do not exit",
     )
+    sample_period = Param.UInt64(
+        0,
+        "Only check a window of instructions every this many committed "
+        "instructions, copying the architectural state from the checked "
+        "CPU before each window (0: check all of them)",
+    )
+    sample_window = Param.UInt64(
+        1, "Number of consecutive instructions checked per sampling period"
+    )
+    sample_random = Param.Bool(
+        False, "Start each window at a random point of its sampling period"
+    )
 
     def generateDeviceTree(self, state):
         # The CheckerCPU is not a real CPU and shouldn't generate a DTB
@@ -40,7 +40,7 @@ ActivityRecorder::ActivityRecorder(const std::string &name, int num_stages,
     int longest_latency, int activity)
     : _name(name), activityBuffer(longest_latency, 0),
       longestLatency(longest_latency), activityCount(activity),
-      numStages(num_stages)
+      numStages(num_stages), quietCycles(0)
 {
     stageActive = new bool[numStages];
     std::memset(stageActive, 0, numStages);
@@ -70,6 +70,11 @@ ActivityRecorder::activity()
 void
 ActivityRecorder::advance()
 {
+    if (activityBuffer[0])
+        quietCycles = 0;
+    else
+        ++quietCycles;
+
     // If there's a 1 in the slot that is about to be erased once the
     // time buffer advances, then decrement the activityCount.
     if (activityBuffer[-longestLatency]) {
@@ -125,6 +130,7 @@ void
 ActivityRecorder::reset()
 {
     activityCount = 0;
+    quietCycles = 0;
     std::memset(stageActive, 0, numStages);
     for (int i = 0; i < longestLatency + 1; ++i)
         activityBuffer.advance();
@@ -90,6 +90,11 @@ class ActivityRecorder
     /** Returns if the CPU should be active. */
     bool active() { return activityCount; }
 
+    /** Returns the number of consecutive cycles, up to the last
+     *  advance(), in which no activity was recorded.
+     */
+    int getQuietCycles() const { return quietCycles; }
+
     /** Clears the time buffer and the activity count. */
     void reset();
 
@@ -134,6 +139,9 @@ class ActivityRecorder
     /** Number of stages that can be marked as active or inactive. */
     int numStages;
 
+    /** Consecutive cycles without any call to activity(). */
+    int quietCycles;
+
     /** Records which stages are active/inactive. */
     bool *stageActive;
 };
@@ -289,7 +289,7 @@ BaseCPU::mwaitAtomic(ThreadID tid, ThreadContext *tc, BaseMMU *mmu)
     assert(tid < numThreads);
     AddressMonitor &monitor = addressMonitor[tid];
 
-    RequestPtr req = std::make_shared<Request>();
+    RequestPtr req = makeRequest();
 
     Addr addr = monitor.vAddr;
     Addr block_size = cacheLineSize();
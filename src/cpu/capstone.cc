@@ -45,37 +45,48 @@ namespace gem5
 namespace trace
 {
 
-std::string
+const std::string &
 CapstoneDisassembler::disassemble(StaticInstPtr inst,
         const PCStateBase &pc,
         const loader::SymbolTable *symtab) const
 {
-    std::string inst_dist;
     if (inst->isPseudo() || inst->isMicroop()) {
         // Capstone doesn't have any visibility over microops nor over
         // gem5 pseudo ops. Use native disassembler instead
-        inst_dist = InstDisassembler::disassemble(inst, pc, symtab);
-    } else {
+        return InstDisassembler::disassemble(inst, pc, symtab);
+    }
+
+    const csh *curr_handle = currHandle(pc);
+    const CacheKey key{curr_handle, inst->getEMI(), inst->size()};
+    if (auto it = cache.find(key); it != cache.end())
+        return it->second;
+
+    if (cache.size() >= maxCacheSize)
+        cache.clear();
+
+    std::string &inst_dist = cache[key];
+    if (curr_handle != nullptr) {
         // Stripping the extended fields from the ExtMachInst
         auto mach_inst = inst->getEMI() & mask(inst->size() * 8);
 
         cs_insn *insn;
         // capstone disassembler
-        if (const csh *curr_handle = currHandle(pc); curr_handle != nullptr) {
-            size_t count = cs_disasm(*curr_handle, (uint8_t*)&mach_inst,
-                inst->size(), 0, 0, &insn);
+        size_t count = cs_disasm(*curr_handle, (uint8_t*)&mach_inst,
+            inst->size(), 0, 0, &insn);
 
-            // As we are passing only one instruction, we are expecting one instruction only
-            // being disassembled
-            assert(count <= 1);
+        // As we are passing only one instruction, we are expecting one instruction only
+        // being disassembled
+        assert(count <= 1);
 
-            for (int idx = 0; idx < count; idx++) {
-                inst_dist += csprintf("  %s   %s", insn[idx].mnemonic, insn[idx].op_str);
-            }
-        } else {
-            // No valid handle; return an invalid string
-            inst_dist += "  capstone failure";
+        for (int idx = 0; idx < count; idx++) {
+            inst_dist += csprintf("  %s   %s", insn[idx].mnemonic, insn[idx].op_str);
         }
+
+        if (count)
+            cs_free(insn, count);
+    } else {
+        // No valid handle; return an invalid string
+        inst_dist += "  capstone failure";
     }
 
     return inst_dist;
@@ -40,6 +40,9 @@
 
 #include <capstone/capstone.h>
 
+#include <string>
+#include <unordered_map>
+
 #include "params/CapstoneDisassembler.hh"
 #include "sim/insttracer.hh"
 
@@ -75,12 +78,47 @@ class CapstoneDisassembler : public InstDisassembler
     PARAMS(CapstoneDisassembler);
     CapstoneDisassembler(const Params &p);
 
-    std::string
+    const std::string &
     disassemble(StaticInstPtr inst,
                 const PCStateBase &pc,
                 const loader::SymbolTable *symtab) const override;
 
   protected:
+    /**
+     * Capstone output only depends on the handle and on the instruction
+     * encoding, with the extended fields of the ExtMachInst standing in
+     * for the mode of the handle, so it is cached by those. This spares
+     * the library call and the string for every instruction traced
+     * again.
+     */
+    struct CacheKey
+    {
+        const csh *handle;
+        uint64_t emi;
+        size_t size;
+
+        bool
+        operator==(const CacheKey &other) const
+        {
+            return handle == other.handle && emi == other.emi &&
+                size == other.size;
+        }
+    };
+
+    struct CacheKeyHash
+    {
+        size_t
+        operator()(const CacheKey &key) const
+        {
+            return std::hash<uint64_t>()(key.emi) ^
+                (std::hash<const void *>()(key.handle) << 1) ^ key.size;
+        }
+    };
+
+    /** Upper bound on the cached strings, which go away all at once */
+    static constexpr size_t maxCacheSize = 1 << 16;
+    mutable std::unordered_map<CacheKey, std::string, CacheKeyHash> cache;
+
 
     /**
      * Return a pointer to the current capstone handle (csh).
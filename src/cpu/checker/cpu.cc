@@ -86,6 +86,31 @@ CheckerCPU::CheckerCPU(const Params &p)
     workload = p.workload;
 
     updateOnError = true;
+
+    samplePeriod = p.sample_period;
+    sampleWindow = p.sample_window;
+    sampleRandom = p.sample_random;
+    fatal_if(samplePeriod &&
+             (sampleWindow == 0 || sampleWindow > samplePeriod),
+             "The checker's sample window must be between 1 and the sample "
+             "period");
+
+    // Start by skipping up to the window of the first period
+    skipping = samplePeriod != 0;
+    numSkippedInsts = 0;
+    periodStart = 0;
+    windowStart = sampleRandom && samplePeriod ?
+        rng->random<Counter>(0, samplePeriod - sampleWindow) : 0;
+    windowNumInst = 0;
+}
+
+void
+CheckerCPU::nextSamplePeriod()
+{
+    periodStart += samplePeriod;
+    windowStart = periodStart;
+    if (sampleRandom)
+        windowStart += rng->random<Counter>(0, samplePeriod - sampleWindow);
 }
 
 CheckerCPU::~CheckerCPU()
@@ -154,7 +179,7 @@ CheckerCPU::genMemFragmentRequest(Addr frag_addr, int size,
                                                     size_left));
     auto it_end = byte_enable.cbegin() + (size - size_left);
     if (isAnyActiveElement(it_start, it_end)) {
-        mem_req = std::make_shared<Request>(frag_addr, frag_size,
+        mem_req = makeRequest(frag_addr, frag_size,
                 flags, requestorId, thread->pcState().instAddr(),
                 tc->contextId());
         mem_req->setByteEnable(std::vector<bool>(it_start, it_end));
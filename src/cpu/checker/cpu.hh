@@ -47,6 +47,7 @@
 #include <queue>
 
 #include "arch/generic/pcstate.hh"
+#include "base/random.hh"
 #include "base/statistics.hh"
 #include "cpu/base.hh"
 #include "cpu/exec_context.hh"
@@ -435,6 +436,33 @@ class CheckerCPU : public BaseCPU, public ExecContext
     bool warnOnlyOnLoadError;
 
     InstSeqNum youngestSN;
+
+    /**
+     * Sampled checking. If the period is non-zero, only a window of
+     * consecutive instructions is checked in each period. The other
+     * instructions are skipped, and the architectural state is copied
+     * from the checked CPU before each window starts.
+     */
+    uint64_t samplePeriod;
+    uint64_t sampleWindow;
+    bool sampleRandom;
+    Random::RandomPtr rng = Random::genRandom();
+
+    /** Whether the instructions are being skipped, between windows. */
+    bool skipping;
+
+    /** Number of instructions skipped. */
+    Counter numSkippedInsts;
+
+    /** First instruction of the current sampling period and window. */
+    Counter periodStart;
+    Counter windowStart;
+
+    /** Number of instructions checked when the current window started. */
+    Counter windowNumInst;
+
+    /** Move to the next sampling period, and place its window. */
+    void nextSamplePeriod();
 };
 
 /**
@@ -467,6 +495,14 @@ class Checker : public CheckerCPU
     void handlePendingInt();
 
   private:
+    /**
+     * Decide whether an instruction is skipped when checking is sampled,
+     * and copy the state of the checked CPU when a window starts.
+     *
+     * @return Whether the instruction should not be checked.
+     */
+    bool skipSample(const DynInstPtr &inst);
+
     void
     handleError(const DynInstPtr &inst)
     {
@@ -114,12 +114,69 @@ Checker<DynInstPtr>::handlePendingInt()
     curMacroStaticInst = nullStaticInstPtr;
 }
 
+template <class DynInstPtr>
+bool
+Checker<DynInstPtr>::skipSample(const DynInstPtr &inst)
+{
+    if (!skipping) {
+        // Finish checking the instructions waiting in the list before
+        // ending the window, as they must be checked in order
+        if (!instList.empty() || numInst - windowNumInst < sampleWindow)
+            return false;
+
+        DPRINTF(Checker, "Sample window done, skipping instructions\n");
+        skipping = true;
+        nextSamplePeriod();
+    }
+
+    // Stores are seen again when they complete
+    if (inst->seqNum <= youngestSN)
+        return true;
+    youngestSN = inst->seqNum;
+    numSkippedInsts++;
+
+    // Start the window after an instruction that ends cleanly, so that
+    // the state of the checked CPU can be picked up from there
+    if (numInst + numSkippedInsts <= windowStart ||
+        inst->getFault() != NoFault ||
+        (inst->isMicroop() && !inst->isLastMicroop())) {
+        return true;
+    }
+
+    DPRINTF(Checker, "Copying state after [sn:%lli] PC:%s to start a "
+            "sample window\n", inst->seqNum, inst->pcState());
+
+    bool no_squash_from_TC = inst->thread->noSquashFromTC;
+    inst->thread->noSquashFromTC = true;
+    thread->copyArchRegs(inst->tcBase());
+    inst->thread->noSquashFromTC = no_squash_from_TC;
+
+    // The registers are those after the instruction committed, while the
+    // PC still is that of the instruction
+    thread->pcState(inst->pcState());
+    curStaticInst = inst->staticInst;
+    curMacroStaticInst = nullStaticInstPtr;
+    advancePC(NoFault);
+    thread->decoder->reset();
+
+    changedPC = willChangePC = false;
+    while (!miscRegIdxs.empty())
+        miscRegIdxs.pop();
+
+    skipping = false;
+    windowNumInst = numInst;
+    return true;
+}
+
 template <class DynInstPtr>
 void
 Checker<DynInstPtr>::verify(const DynInstPtr &completed_inst)
 {
     DynInstPtr inst;
 
+    if (samplePeriod && skipSample(completed_inst))
+        return;
+
     // Make sure serializing instructions are actually
     // seen as serializing to commit. instList should be
     // empty in these cases.
@@ -230,7 +287,7 @@ Checker<DynInstPtr>::verify(const DynInstPtr &completed_inst)
             // If not in the middle of a macro instruction
             if (!curMacroStaticInst) {
                 // set up memory request for instruction fetch
-                auto mem_req = std::make_shared<Request>(
+                auto mem_req = makeRequest(
                     fetch_PC, decoder->moreBytesSize(), 0, requestorId,
                     fetch_PC, thread->contextId());
 
@@ -0,0 +1,62 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+
+#include "base/microbench.hh"
+#include "cpu/decode_cache.hh"
+
+using namespace gem5;
+
+/** Sequential fetch within a few pages, served by the recent chunks. */
+static void
+decodeCacheSequential(microbench::State &state)
+{
+    decode_cache::AddrMap<uint64_t> map;
+    const Addr footprint = state.range();
+
+    Addr pc = 0;
+    for (auto _ : state) {
+        microbench::doNotOptimize(map.lookup(0x10000 + pc));
+        pc = (pc + 4) % footprint;
+    }
+}
+GEM5_BENCHMARK(decodeCacheSequential)->arg(4096)->arg(8192);
+
+/** Jumps across many pages, which need a hash map lookup. */
+static void
+decodeCacheScattered(microbench::State &state)
+{
+    decode_cache::AddrMap<uint64_t> map;
+    const Addr pages = state.range();
+
+    uint64_t lfsr = 0xace1;
+    for (auto _ : state) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xd0000001u);
+        const Addr pc = ((lfsr % pages) << 12) | (lfsr & 0xffc);
+        microbench::doNotOptimize(map.lookup(pc));
+    }
+}
+GEM5_BENCHMARK(decodeCacheScattered)->arg(16)->arg(1024);
@@ -29,10 +29,17 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include "base/bitfield.hh"
 #include "base/compiler.hh"
+#include "base/types.hh"
 #include "cpu/static_inst_fwd.hh"
 
 namespace gem5
@@ -45,6 +52,125 @@ namespace decode_cache
 template <typename EMI>
 using InstMap = std::unordered_map<EMI, StaticInstPtr>;
 
+/// An insert-only hash map that can be shared by several decoders.
+/// Lookups never take a lock: entries are published with a release store
+/// and are never changed or removed afterwards. Inserts are serialized.
+/// The number of buckets is fixed, so that readers never race with a
+/// rehash.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class SharedMap
+{
+  private:
+    struct Node
+    {
+        const Key key;
+        const Value value;
+        const Node *const next;
+    };
+
+    const size_t mask;
+    std::unique_ptr<std::atomic<const Node *>[]> buckets;
+    std::atomic<size_t> count;
+    std::mutex insertMutex;
+    Hash hash;
+
+    std::atomic<const Node *> &
+    bucket(const Key &key) const
+    {
+        return buckets[hash(key) & mask];
+    }
+
+    static const Node *
+    search(const Node *node, const Key &key)
+    {
+        for (; node; node = node->next) {
+            if (node->key == key)
+                return node;
+        }
+        return nullptr;
+    }
+
+  public:
+    /// @param bucket_shift Log2 of the number of buckets.
+    explicit SharedMap(unsigned bucket_shift = 16)
+        : mask((size_t(1) << bucket_shift) - 1),
+          buckets(new std::atomic<const Node *>[mask + 1]), count(0)
+    {
+        for (size_t i = 0; i <= mask; i++)
+            buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~SharedMap()
+    {
+        for (size_t i = 0; i <= mask; i++) {
+            const Node *node = buckets[i].load(std::memory_order_relaxed);
+            while (node) {
+                const Node *next = node->next;
+                delete node;
+                node = next;
+            }
+        }
+    }
+
+    SharedMap(const SharedMap &) = delete;
+    SharedMap &operator=(const SharedMap &) = delete;
+
+    /// Look a key up.
+    /// @return A pointer to the value, or nullptr if the key isn't there.
+    const Value *
+    find(const Key &key) const
+    {
+        const Node *node =
+            search(bucket(key).load(std::memory_order_acquire), key);
+        return node ? &node->value : nullptr;
+    }
+
+    /// Insert a value unless the key is already there.
+    /// @return The value in the map, which is the one passed in unless
+    ///         another thread inserted the same key first.
+    const Value &
+    insert(const Key &key, const Value &value)
+    {
+        std::lock_guard<std::mutex> lock(insertMutex);
+        auto &head = bucket(key);
+        const Node *first = head.load(std::memory_order_relaxed);
+        if (const Node *node = search(first, key))
+            return node->value;
+        const Node *node = new Node{key, value, first};
+        head.store(node, std::memory_order_release);
+        count.fetch_add(1, std::memory_order_relaxed);
+        return node->value;
+    }
+
+    size_t size() const { return count.load(std::memory_order_relaxed); }
+};
+
+/// A process wide cache of decoded instructions. The map is thread safe,
+/// but copying a StaticInstPtr isn't, so decoders may only share one if
+/// they all run on the same host thread.
+template <typename EMI>
+using SharedInstMap = SharedMap<EMI, StaticInstPtr>;
+
+/// Get the process wide decode cache for a decoder configuration. Decoders
+/// can only share decoded instructions if they would decode every machine
+/// instruction the same way, so anything that affects decoding and is
+/// not part of the EMI must be folded into the configuration key.
+/// @param config Key identifying the decoder configuration.
+template <typename EMI>
+SharedInstMap<EMI> &
+sharedInstMap(uint64_t config)
+{
+    static std::mutex mutex;
+    static std::unordered_map<uint64_t, std::unique_ptr<SharedInstMap<EMI>>>
+        maps;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &map = maps[config];
+    if (!map)
+        map = std::make_unique<SharedInstMap<EMI>>();
+    return *map;
+}
+
 /// A sparse map from an Addr to a Value, stored in page chunks.
 template<class Value, Addr CacheChunkShift = 12>
 class AddrMap
@@ -0,0 +1,85 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "cpu/decode_cache.hh"
+
+using namespace gem5;
+
+TEST(SharedMapTest, InsertAndFind)
+{
+    decode_cache::SharedMap<uint64_t, int> map(4);
+    ASSERT_EQ(map.find(1), nullptr);
+    ASSERT_EQ(map.insert(1, 10), 10);
+    ASSERT_EQ(map.insert(17, 170), 170);
+    ASSERT_EQ(map.size(), 2);
+    ASSERT_NE(map.find(1), nullptr);
+    ASSERT_EQ(*map.find(1), 10);
+    ASSERT_EQ(*map.find(17), 170);
+    ASSERT_EQ(map.find(33), nullptr);
+}
+
+/** The value of a key never changes once inserted. */
+TEST(SharedMapTest, FirstInsertWins)
+{
+    decode_cache::SharedMap<uint64_t, int> map(4);
+    const int *first = &map.insert(5, 1);
+    ASSERT_EQ(map.insert(5, 2), 1);
+    ASSERT_EQ(map.find(5), first);
+    ASSERT_EQ(map.size(), 1);
+}
+
+/** Readers and writers can use the map concurrently. */
+TEST(SharedMapTest, ConcurrentInsertAndFind)
+{
+    constexpr uint64_t num_keys = 4096;
+    constexpr unsigned num_threads = 4;
+    decode_cache::SharedMap<uint64_t, uint64_t> map(8);
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < num_threads; t++) {
+        threads.emplace_back([&map, t] {
+            for (uint64_t i = 0; i < num_keys; i++) {
+                uint64_t key = (i * 7 + t) % num_keys;
+                const uint64_t *found = map.find(key);
+                if (found) {
+                    EXPECT_EQ(*found, key * 3);
+                } else {
+                    EXPECT_EQ(map.insert(key, key * 3), key * 3);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    ASSERT_EQ(map.size(), num_keys);
+    for (uint64_t i = 0; i < num_keys; i++)
+        ASSERT_EQ(*map.find(i), i * 3);
+}
@@ -57,6 +57,35 @@ namespace gem5
 
 namespace trace {
 
+const std::string &
+ExeTracer::symbolText(Addr pc, const loader::SymbolTable &symtab) const
+{
+    if (symbolCache.empty())
+        symbolCache.resize(symbolCacheSize);
+
+    SymbolEntry &entry = symbolCache[(pc >> 1) % symbolCacheSize];
+    if (entry.pc == pc && entry.symtab == &symtab &&
+            entry.generation == symtab.generation()) {
+        return entry.text;
+    }
+
+    entry.pc = pc;
+    entry.symtab = &symtab;
+    entry.generation = symtab.generation();
+    entry.text.clear();
+
+    auto it = symtab.findNearest(pc);
+    if (it != symtab.end()) {
+        Addr delta = pc - it->address();
+        if (delta)
+            entry.text = csprintf(" @%s+%d", it->name(), delta);
+        else
+            entry.text = csprintf(" @%s", it->name());
+    }
+
+    return entry.text;
+}
+
 void
 ExeTracerRecord::traceInst(const StaticInstPtr &inst, bool ran)
 {
@@ -78,17 +107,9 @@ ExeTracerRecord::traceInst(const StaticInstPtr &inst, bool ran)
 
     Addr cur_pc = thread->getMMUPtr()->getValidAddr(
         pc->instAddr(), thread, BaseMMU::Execute);
-    loader::SymbolTable::const_iterator it;
     ccprintf(outs, "%#x", cur_pc);
-    if (debug::ExecSymbol && (!FullSystem || !in_user_mode) &&
-            (it = loader::debugSymbolTable.findNearest(cur_pc)) !=
-                loader::debugSymbolTable.end()) {
-        Addr delta = cur_pc - it->address();
-        if (delta)
-            ccprintf(outs, " @%s+%d", it->name(), delta);
-        else
-            ccprintf(outs, " @%s", it->name());
-    }
+    if (debug::ExecSymbol && (!FullSystem || !in_user_mode))
+        outs << tracer.symbolText(cur_pc, loader::debugSymbolTable);
 
     if (inst->isMicroop()) {
         ccprintf(outs, ".%2d", pc->microPC());
@@ -41,6 +41,9 @@
 #ifndef __CPU_EXETRACE_HH__
 #define __CPU_EXETRACE_HH__
 
+#include <string>
+#include <vector>
+
 #include "base/trace.hh"
 #include "base/types.hh"
 #include "cpu/static_inst.hh"
@@ -85,6 +88,19 @@ class ExeTracer : public InstTracer
     ExeTracer(const Params &params) : InstTracer(params)
     {}
 
+    /**
+     * Get the " @symbol+offset" text printed after a PC, or an empty
+     * string if no symbol precedes it. Traces spend most of their time
+     * in a few loops, so the text is cached per PC for as long as the
+     * symbol table is unchanged.
+     *
+     * @param pc The PC to look up.
+     * @param symtab The table to look it up in.
+     * @return The symbol text, valid until the next call.
+     */
+    const std::string &symbolText(Addr pc,
+                                  const loader::SymbolTable &symtab) const;
+
     InstRecord *
     getInstRecord(Tick when, ThreadContext *tc,
             const StaticInstPtr staticInst, const PCStateBase &pc,
@@ -96,6 +112,19 @@ class ExeTracer : public InstTracer
         return new ExeTracerRecord(when, tc,
                 staticInst, pc, *this, macroStaticInst);
     }
+
+  private:
+    struct SymbolEntry
+    {
+        Addr pc = MaxAddr;
+        const loader::SymbolTable *symtab = nullptr;
+        uint64_t generation = 0;
+        std::string text;
+    };
+
+    /** Symbol text of the PCs traced last, indexed by PC */
+    static constexpr size_t symbolCacheSize = 4096;
+    mutable std::vector<SymbolEntry> symbolCache;
 };
 
 } // namespace trace
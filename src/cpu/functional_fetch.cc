@@ -0,0 +1,82 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/functional_fetch.hh"
+
+#include <cstring>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "mem/port.hh"
+
+namespace gem5
+{
+
+void
+FunctionalFetch::requestBackdoor(AddrRange range)
+{
+    MemBackdoorPtr bd = nullptr;
+    port.sendMemBackdoorReq(MemBackdoorReq(range, MemBackdoor::Readable), bd);
+    if (!bd || !bd->readable() ||
+            backdoors.insert(bd->range(), bd) == backdoors.end()) {
+        backoff = RetryInterval;
+        return;
+    }
+
+    // Forget about this backdoor if it goes away.
+    bd->addInvalidationCallback([this](const MemBackdoor &backdoor) {
+            for (auto it = backdoors.begin(); it != backdoors.end(); it++) {
+                if (it->second == &backdoor) {
+                    backdoors.erase(it);
+                    return;
+                }
+            }
+            panic("Got invalidation for unknown memory backdoor.");
+        });
+}
+
+bool
+FunctionalFetch::read(Addr paddr, unsigned size, void *dst)
+{
+    AddrRange range = RangeSize(paddr, size);
+    auto bd_it = backdoors.contains(range);
+    if (bd_it == backdoors.end()) {
+        if (backoff) {
+            backoff--;
+            return false;
+        }
+        Addr start = roundDown(paddr, RequestBytes);
+        requestBackdoor(RangeEx(start, roundUp(paddr + size, RequestBytes)));
+        bd_it = backdoors.contains(range);
+        if (bd_it == backdoors.end())
+            return false;
+    }
+
+    const MemBackdoor *bd = bd_it->second;
+    std::memcpy(dst, bd->ptr() + (paddr - bd->range().start()), size);
+    return true;
+}
+
+} // namespace gem5
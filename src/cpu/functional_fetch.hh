@@ -0,0 +1,85 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_FUNCTIONAL_FETCH_HH__
+#define __CPU_FUNCTIONAL_FETCH_HH__
+
+#include <cstdint>
+
+#include "base/addr_range_map.hh"
+#include "base/types.hh"
+#include "mem/backdoor.hh"
+
+namespace gem5
+{
+
+class RequestPort;
+
+/**
+ * Instruction fetch through memory backdoors, for timing CPUs that don't
+ * need to model the instruction side of the memory system. A backdoor is
+ * requested from the memory behind the instruction port the first time a
+ * page is fetched from, and is then used to copy instruction bytes
+ * directly. If no backdoor is handed out (e.g. because there is a cache
+ * on the way), the caller falls back on sending packets, and no new
+ * backdoor request is made for a while.
+ */
+class FunctionalFetch
+{
+  public:
+    FunctionalFetch(RequestPort &port) : port(port) {}
+
+    /**
+     * Read instruction bytes through a backdoor.
+     * @param paddr Physical address of the first byte.
+     * @param size Number of bytes to read.
+     * @param dst Where to copy the bytes.
+     * @return True if the bytes were read, false if the fetch has to go
+     *         through the port.
+     */
+    bool read(Addr paddr, unsigned size, void *dst);
+
+  private:
+    /** Granularity of the backdoor requests. */
+    static constexpr Addr RequestBytes = 4096;
+
+    /** Number of fetches before a failed backdoor request is retried. */
+    static constexpr unsigned RetryInterval = 1024;
+
+    /** Ask the memory system for a backdoor covering the given range. */
+    void requestBackdoor(AddrRange range);
+
+    RequestPort &port;
+
+    /** Backdoors handed out so far, removed when invalidated. */
+    AddrRangeMap<MemBackdoorPtr, 1> backdoors;
+
+    /** Fetches left before another backdoor request can be made. */
+    unsigned backoff = 0;
+};
+
+} // namespace gem5
+
+#endif // __CPU_FUNCTIONAL_FETCH_HH__
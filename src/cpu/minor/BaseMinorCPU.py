@@ -317,6 +317,11 @@ class BaseMinorCPU(BaseCPU):
         "Fetch1 maximum fetch size in bytes (0 means use system cache"
         " line size)",
     )
+    fetch1FunctionalFetch = Param.Bool(
+        False,
+        "Fetch lines directly through memory backdoors when the instruction"
+        " side offers one, without modelling the I-side memory system",
+    )
     fetch1ToFetch2ForwardDelay = Param.Cycles(
         1, "Forward cycle delay from Fetch1 to Fetch2 (1 means next cycle)"
     )
@@ -424,6 +429,12 @@ class BaseMinorCPU(BaseCPU):
     enableIdling = Param.Bool(
         True, "Enable cycle skipping when the processor is idle\n"
     )
+    memStallSleepThreshold = Param.Cycles(
+        0,
+        "Stop ticking the pipeline when it has been waiting only on "
+        "outstanding memory accesses for this many cycles, until the next "
+        "response (0 disables). Requires enableIdling.",
+    )
 
     branchPred = Param.BranchPredictor(
         TournamentBP(numThreads=Parent.numThreads), "Branch Predictor"
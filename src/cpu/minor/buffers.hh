@@ -348,12 +348,21 @@ class SelfStallingPipeline : public MinorBuffer<ElemType, ReportTraits>
     /** There's data (not a bubble) at the end of the pipe */
     bool isPopable() { return !BubbleTraits::isBubble(front()); }
 
+    /** Is this pipeline full of only bubbles.  Uses the occupancy count
+     *  rather than examining every slot */
+    bool empty() const { return occupancy == 0; }
+
     /** Try to advance the pipeline.  If we're stalled, don't advance.  If
      *  we're not stalled, advance then check to see if we become stalled
      *  (a non-bubble at the end of the pipe) */
     void
     advance()
     {
+        /* A pipeline of only bubbles looks the same after advancing, so
+         *  don't bother rotating (and rewriting) its slots */
+        if (occupancy == 0)
+            return;
+
         bool data_at_end = isPopable();
 
         if (!stalled) {
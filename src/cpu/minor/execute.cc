@@ -92,7 +92,8 @@ Execute::Execute(const std::string &name_,
             ExecuteThreadInfo(params.executeCommitLimit)),
     interruptPriority(0),
     issuePriority(0),
-    commitPriority(0)
+    commitPriority(0),
+    waitingOnMemory(false)
 {
     if (commitLimit < 1) {
         fatal("%s: executeCommitLimit must be >= 1 (%d)\n", name_,
@@ -1532,19 +1533,30 @@ Execute::evaluate()
          * to be unstalled */
         if (fu->occupancy !=0 && !fu->stalled)
             becoming_stalled = false;
+    }
 
-        /* Could we possibly issue the next instruction from any thread?
-         * This is quite an expensive test and is only used to determine
-         * if the CPU should remain active, only run it if we aren't sure
-         * we are active next cycle yet */
-        for (auto inst : next_issuable_insts) {
-            if (!fu->stalled && fu->provides(inst->staticInst->opClass()) &&
-                scoreboard[inst->id.threadId].canInstIssue(inst,
-                    NULL, NULL, cpu.curCycle() + Cycles(1),
-                    cpu.getContext(inst->id.threadId))) {
-                can_issue_next = true;
-                break;
-            }
+    /* Could we possibly issue the next instruction from any thread?
+     * This is quite an expensive test and is only used to determine
+     * if the CPU should remain active, only run it if we aren't sure
+     * we are active next cycle yet.  The scoreboard test doesn't depend
+     * on the FU so make it once per inst, after finding an FU which
+     * could take the inst */
+    for (auto inst : next_issuable_insts) {
+        if (can_issue_next)
+            break;
+
+        bool fu_available = false;
+        for (unsigned int i = 0; i < numFuncUnits && !fu_available; i++) {
+            FUPipeline *fu = funcUnits[i];
+            fu_available = !fu->stalled &&
+                fu->provides(inst->staticInst->opClass());
+        }
+
+        if (fu_available &&
+            scoreboard[inst->id.threadId].canInstIssue(inst,
+                NULL, NULL, cpu.curCycle() + Cycles(1),
+                cpu.getContext(inst->id.threadId))) {
+            can_issue_next = true;
         }
     }
 
@@ -1595,6 +1607,8 @@ Execute::evaluate()
     if (need_to_tick)
         cpu.wakeupOnEvent(Pipeline::ExecuteStageId);
 
+    waitingOnMemory = !need_to_tick && lsq.accessesInMemorySystem();
+
     /* Note activity of following buffer */
     if (!branch.isBubble())
         cpu.activityRecorder->activity();
@@ -210,6 +210,10 @@ class Execute : public Named
     ThreadID issuePriority;
     ThreadID commitPriority;
 
+    /** Did the last evaluate find nothing to do but wait for responses
+     *  from the memory system? */
+    bool waitingOnMemory;
+
   protected:
     friend std::ostream &operator <<(std::ostream &os, DrainState state);
 
@@ -353,6 +357,9 @@ class Execute : public Named
      *  instructions and memory accesses. */
     bool isDrained();
 
+    /** Can Execute only make progress once a memory response arrives? */
+    bool stalledOnMemory() const { return waitingOnMemory; }
+
     /** Like the drain interface on SimObject */
     unsigned int drain();
     void drainResume();
@@ -117,6 +117,9 @@ Fetch1::Fetch1(const std::string &name_,
         fatal("%s: fetch1FetchLimit must be >= 1 (%d)\n", name_,
             fetchLimit);
     }
+
+    if (params.fetch1FunctionalFetch)
+        functionalFetch = std::make_unique<FunctionalFetch>(icachePort);
 }
 
 inline ThreadID
@@ -311,8 +314,14 @@ Fetch1::tryToSendToTransfers(FetchRequestPtr request)
         /* Ensure that the packet won't delete the request */
         assert(request->packet->needsResponse());
 
-        if (tryToSend(request))
+        if (tryFunctionalFetch(request)) {
             moveFromRequestsToTransfers(request);
+
+            /* No response event will wake the pipeline up */
+            cpu.wakeupOnEvent(Pipeline::Fetch1StageId);
+        } else if (tryToSend(request)) {
+            moveFromRequestsToTransfers(request);
+        }
     } else {
         DPRINTF(Fetch, "Not advancing line fetch\n");
     }
@@ -355,6 +364,31 @@ Fetch1::tryToSend(FetchRequestPtr request)
     return ret;
 }
 
+bool
+Fetch1::tryFunctionalFetch(FetchRequestPtr request)
+{
+    PacketPtr packet = request->packet;
+
+    if (!functionalFetch || !functionalFetch->read(packet->getAddr(),
+        packet->getSize(), packet->getPtr<uint8_t>()))
+    {
+        return false;
+    }
+
+    /* Complete the request as if the response had come back from
+     *  memory, keeping the packet for Fetch2's use */
+    packet->popSenderState();
+    packet->makeResponse();
+    request->state = FetchRequest::Complete;
+
+    DPRINTF(Fetch, "Fetched line through a backdoor: %s\n", request->id);
+
+    if (debug::MinorTrace)
+        minorTraceResponseLine(name(), request);
+
+    return true;
+}
+
 void
 Fetch1::stepQueues()
 {
@@ -45,11 +45,13 @@
 #ifndef __CPU_MINOR_FETCH1_HH__
 #define __CPU_MINOR_FETCH1_HH__
 
+#include <memory>
 #include <vector>
 
 #include "arch/generic/mmu.hh"
 #include "base/named.hh"
 #include "cpu/base.hh"
+#include "cpu/functional_fetch.hh"
 #include "cpu/minor/buffers.hh"
 #include "cpu/minor/cpu.hh"
 #include "cpu/minor/pipe_data.hh"
@@ -182,7 +184,7 @@ class Fetch1 : public Named
             pc(pc_),
             fault(NoFault)
         {
-            request = std::make_shared<Request>();
+            request = makeRequest();
         }
 
         ~FetchRequest();
@@ -224,6 +226,10 @@ class Fetch1 : public Named
     /** Maximum number of fetches allowed in flight (in queues or memory) */
     unsigned int fetchLimit;
 
+    /** Line fetches through memory backdoors, if enabled.  Lines read
+     *  this way complete without a packet being sent to the icache */
+    std::unique_ptr<FunctionalFetch> functionalFetch;
+
   protected:
     /** Cycle-by-cycle state */
 
@@ -357,6 +363,10 @@ class Fetch1 : public Named
      *  sent to memory */
     bool tryToSend(FetchRequestPtr request);
 
+    /** Try to read a translated request's line through a memory backdoor.
+     *  Returns true if the request was completed */
+    bool tryFunctionalFetch(FetchRequestPtr request);
+
     /** Move a request between queues */
     void moveFromRequestsToTransfers(FetchRequestPtr request);
 
@@ -705,6 +705,13 @@ class LSQ : public Named
      *  an actionable transfers or address translation */
     bool needsToTick();
 
+    /** Are any accesses waiting for a response from the memory system? */
+    bool
+    accessesInMemorySystem() const
+    {
+        return numAccessesInMemorySystem != 0;
+    }
+
     /** Complete a barrier instruction.  Where committed, makes a
      *  BarrierDataRequest and pushed it into the store buffer */
     void completeMemBarrierInst(MinorDynInstPtr inst,
@@ -58,6 +58,8 @@ Pipeline::Pipeline(MinorCPU &cpu_, const BaseMinorCPUParams &params) :
     Ticked(cpu_, &(cpu_.BaseCPU::baseStats.numCycles)),
     cpu(cpu_),
     allow_idling(params.enableIdling),
+    memStallSleepThreshold(params.memStallSleepThreshold),
+    memStalled(false),
     f1ToF2(cpu.name() + ".f1ToF2", "lines",
         params.fetch1ToFetch2ForwardDelay),
     f2ToF1(cpu.name() + ".f2ToF1", "prediction",
@@ -127,6 +129,15 @@ Pipeline::evaluate()
     /** We tick the CPU to update the BaseCPU cycle counters */
     cpu.tick();
 
+    if (memStalled) {
+        /* Woken by a memory response, the skipped cycles have already
+         *  been added to numCycles by Ticked::start */
+        Cycles skipped = cpu.curCycle() - memStallStart;
+        if (skipped > 1)
+            cpu.stats.memStallCycles += skipped - 1;
+        memStalled = false;
+    }
+
     /* Note that it's important to evaluate the stages in order to allow
      *  'immediate', 0-time-offset TimeBuffer activity to be visible from
      *  later stages to earlier ones in the same cycle */
@@ -154,6 +165,14 @@ Pipeline::evaluate()
         if (!activityRecorder.active() && !needToSignalDrained) {
             DPRINTF(Quiesce, "Suspending as the processor is idle\n");
             stop();
+        } else if (memStallSleepThreshold != 0 && !needToSignalDrained &&
+            activityRecorder.getQuietCycles() >= memStallSleepThreshold &&
+            execute.stalledOnMemory())
+        {
+            DPRINTF(Quiesce, "Suspending until the next memory response\n");
+            stop();
+            memStalled = true;
+            memStallStart = cpu.curCycle();
         }
 
         /* Deactivate all stages.  Note that the stages *could*
@@ -77,6 +77,16 @@ class Pipeline : public Ticked
     /** Allow cycles to be skipped when the pipeline is idle */
     bool allow_idling;
 
+    /** Cycles without activity after which the pipeline stops while
+     *  Execute waits on memory, 0 to disable */
+    Cycles memStallSleepThreshold;
+
+    /** Is the pipeline stopped until the next memory response? */
+    bool memStalled;
+
+    /** Cycle in which the pipeline stopped on memory */
+    Cycles memStallStart;
+
     Latch<ForwardLineData> f1ToF2;
     Latch<BranchData> f2ToF1;
     Latch<ForwardInstData> f2ToD;
@@ -120,6 +120,8 @@ Scoreboard::markupInstDests(MinorDynInstPtr inst, Cycles retire_time,
 
             inst->flatDestRegIdx[dest_index] = reg;
 
+            if (numResults[index] == 0)
+                setBusy(index);
             numResults[index]++;
             returnCycle[index] = retire_time;
             /* We should be able to rely on only being given accending
@@ -145,7 +147,8 @@ Scoreboard::execSeqNumToWaitFor(MinorDynInstPtr inst,
 {
     InstSeqNum ret = 0;
 
-    if (inst->isFault())
+    /* writingInst is 0 for all registers with no results in flight */
+    if (inst->isFault() || numBusyRegs == 0)
         return ret;
 
     StaticInstPtr staticInst = inst->staticInst;
@@ -157,7 +160,7 @@ Scoreboard::execSeqNumToWaitFor(MinorDynInstPtr inst,
         RegId reg = staticInst->srcRegIdx(src_index).flatten(*isa);
         unsigned short int index;
 
-        if (findIndex(reg, index)) {
+        if (findIndex(reg, index) && isBusy(index)) {
             if (writingInst[index] > ret)
                 ret = writingInst[index];
         }
@@ -192,6 +195,7 @@ Scoreboard::clearInstDests(MinorDynInstPtr inst, bool clear_unpredictable)
             numResults[index] --;
 
             if (numResults[index] == 0) {
+                clearBusy(index);
                 returnCycle[index] = Cycles(0);
                 writingInst[index] = 0;
                 fuIndices[index] = invalidFUIndex;
@@ -236,15 +240,18 @@ Scoreboard::canInstIssue(MinorDynInstPtr inst,
 
     auto *isa = thread_context->getIsaPtr();
 
-    /* For each source register, find the latest result */
+    /* For each source register, find the latest result.  Registers with
+     *  no results in flight can't block issue, so don't even flatten the
+     *  sources if there are none */
     unsigned int src_index = 0;
     while (src_index < num_srcs && /* More registers */
-        ret /* Still possible */)
+        ret && /* Still possible */
+        numBusyRegs != 0 /* Anything to wait for */)
     {
         RegId reg = staticInst->srcRegIdx(src_index).flatten(*isa);
         unsigned short int index;
 
-        if (findIndex(reg, index)) {
+        if (findIndex(reg, index) && isBusy(index)) {
             int src_reg_fu = fuIndices[index];
             bool cant_forward = src_reg_fu != invalidFUIndex &&
                 cant_forward_from_fu_indices &&
@@ -287,6 +294,12 @@ Scoreboard::minorTrace() const
 
     unsigned int i = 0;
     while (i < numRegs) {
+        /* Skip whole words of idle registers */
+        if (i % 64 == 0 && busyRegs[i / 64] == 0) {
+            i += 64;
+            continue;
+        }
+
         unsigned short int num_results = numResults[i];
         unsigned short int num_unpredictable_results =
             numUnpredictableResults[i];
@@ -44,6 +44,7 @@
 #ifndef __CPU_MINOR_SCOREBOARD_HH__
 #define __CPU_MINOR_SCOREBOARD_HH__
 
+#include <cstdint>
 #include <vector>
 
 #include "base/named.hh"
@@ -107,6 +108,14 @@ class Scoreboard : public Named
      *  register value */
     std::vector<InstSeqNum> writingInst;
 
+    /** Bit per register, set while numResults for it is non-zero, so
+     *  that the common case of a source with no result in flight can be
+     *  skipped without looking at the rest of its state */
+    std::vector<uint64_t> busyRegs;
+
+    /** Number of registers with a bit set in busyRegs */
+    unsigned numBusyRegs;
+
   public:
     Scoreboard(const std::string &name,
             const BaseISA::RegClasses& reg_classes) :
@@ -126,9 +135,32 @@ class Scoreboard : public Named
         numUnpredictableResults(numRegs, 0),
         fuIndices(numRegs, invalidFUIndex),
         returnCycle(numRegs, Cycles(0)),
-        writingInst(numRegs, 0)
+        writingInst(numRegs, 0),
+        busyRegs((numRegs + 63) / 64, 0),
+        numBusyRegs(0)
     { }
 
+  protected:
+    bool
+    isBusy(Index index) const
+    {
+        return (busyRegs[index / 64] >> (index % 64)) & 1;
+    }
+
+    void
+    setBusy(Index index)
+    {
+        busyRegs[index / 64] |= uint64_t(1) << (index % 64);
+        numBusyRegs++;
+    }
+
+    void
+    clearBusy(Index index)
+    {
+        busyRegs[index / 64] &= ~(uint64_t(1) << (index % 64));
+        numBusyRegs--;
+    }
+
   public:
     /** Sets scoreboard_index to the index into numResults of the
      *  given register index.  Returns true if the given register
@@ -47,9 +47,13 @@ MinorStats::MinorStats(BaseCPU *base_cpu)
     : statistics::Group(base_cpu),
     ADD_STAT(quiesceCycles, statistics::units::Cycle::get(),
              "Total number of cycles that CPU has spent quiesced or waiting "
-             "for an interrupt")
+             "for an interrupt"),
+    ADD_STAT(memStallCycles, statistics::units::Cycle::get(),
+             "Total number of cycles that the pipeline was stopped waiting "
+             "on outstanding memory accesses")
 {
     quiesceCycles.prereq(quiesceCycles);
+    memStallCycles.prereq(memStallCycles);
 }
 
 } // namespace minor
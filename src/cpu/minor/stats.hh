@@ -62,6 +62,9 @@ struct MinorStats : public statistics::Group
     /** Number of cycles in quiescent state */
     statistics::Scalar quiesceCycles;
 
+    /** Number of cycles stopped waiting on outstanding memory accesses */
+    statistics::Scalar memStallCycles;
+
 };
 
 } // namespace minor
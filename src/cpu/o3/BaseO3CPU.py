@@ -44,6 +44,7 @@ from m5.objects.BranchPredictor import *
 from m5.objects.FUPool import *
 from m5.objects.IndexingPolicies import *
 from m5.objects.ReplacementPolicies import *
+from m5.objects.ValuePredictor import *
 from m5.params import *
 from m5.proxy import *
 from m5.SimObject import *
@@ -61,6 +62,10 @@ class CommitPolicy(ScopedEnum):
     vals = ["RoundRobin", "OldestReady"]
 
 
+class MemDepPredictorType(ScopedEnum):
+    vals = ["StoreSet", "StoreVector", "StoreDistance"]
+
+
 class BaseO3CPU(BaseCPU):
     type = "BaseO3CPU"
     cxx_class = "gem5::o3::CPU"
@@ -91,6 +96,21 @@ class BaseO3CPU(BaseCPU):
     commitToFetchDelay = Param.Cycles(1, "Commit to fetch delay")
     fetchWidth = Param.Unsigned(8, "Fetch width")
     fetchBufferSize = Param.Unsigned(64, "Fetch buffer size in bytes")
+    fetchTargetQueueSize = Param.Unsigned(
+        0,
+        "Fetch buffer blocks a decoupled front end predicts ahead of fetch "
+        "and prefetches into the I-cache (0 disables the run-ahead)",
+    )
+    fetchTargetScanBytes = Param.Unsigned(
+        0,
+        "Granularity at which the run-ahead probes the BTB for branches "
+        "(0 uses the decoder's fetch granule)",
+    )
+    fetchTargetPageBytes = Param.Unsigned(
+        4096,
+        "Run-ahead prefetches are limited to the page of this size of the "
+        "last fetch translation. Must not exceed the smallest page size",
+    )
     fetchQueueSize = Param.Unsigned(
         32, "Fetch queue size in micro-ops per-thread"
     )
@@ -109,6 +129,12 @@ class BaseO3CPU(BaseCPU):
     commitToRenameDelay = Param.Cycles(1, "Commit to rename delay")
     decodeToRenameDelay = Param.Cycles(1, "Decode to rename delay")
     renameWidth = Param.Unsigned(8, "Rename width")
+    numRenameCheckpoints = Param.Unsigned(
+        0,
+        "Number of rename map checkpoints per thread, taken at control "
+        "instructions and restored on a squash instead of undoing the "
+        "rename history entry by entry (0 disables checkpointing)",
+    )
 
     commitToIEWDelay = Param.Cycles(
         1, "Commit to Issue/Execute/Writeback delay"
@@ -150,11 +176,30 @@ class BaseO3CPU(BaseCPU):
         "Should dependency violations be checked for "
         "loads & stores or just stores",
     )
+    LSQFusedTranslationBytes = Param.Unsigned(
+        0,
+        "Translate the cache-line fragments of a split access once per "
+        "aligned block of this many bytes (0 translates every fragment). "
+        "Must not exceed the smallest page size of the ISA",
+    )
+    memDepPredictor = Param.MemDepPredictorType(
+        "StoreSet", "Memory dependence predictor used by the IQ"
+    )
     store_set_clear_period = Param.Unsigned(
         250000,
         "Number of load/store insts before the dep predictor "
         "should be invalidated",
     )
+    memDepTableSize = Param.Unsigned(
+        1024,
+        "Load PC table size of the store vector and store distance "
+        "predictors",
+    )
+    memDepStoreWindow = Param.Unsigned(
+        16,
+        "Number of most recently dispatched stores the store vector and "
+        "store distance predictors can make a load depend on (max 64)",
+    )
     LFSTSize = Param.Unsigned(1024, "Last fetched store table size")
     SSITSize = Param.MemorySize("1024", "Store set ID table size")
     SSITAssoc = Param.Unsigned(1, "SSIT table associativity")
@@ -205,8 +250,21 @@ class BaseO3CPU(BaseCPU):
     branchPred = Param.BranchPredictor(
         TournamentBP(numThreads=Parent.numThreads), "Branch Predictor"
     )
+    valuePredictor = Param.ValuePredictor(
+        NULL,
+        "Load value/address predictor, looked up at rename (NULL disables "
+        "value prediction)",
+    )
     needsTSO = Param.Bool(False, "Enable TSO Memory model")
 
+    memStallSleepThreshold = Param.Cycles(
+        0,
+        "Stop ticking the CPU when it has been waiting only on outstanding "
+        "memory accesses for this many cycles, until the next response, "
+        "finished translation or interrupt (0 disables). Only numCycles "
+        "and memStallCycles are updated for the skipped cycles.",
+    )
+
     recvRespThrottling = Param.Bool(
         False, "Enable load receive response throttling in the LSQ"
     )
@@ -0,0 +1,68 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+
+class ValuePredictor(SimObject):
+    type = "ValuePredictor"
+    cxx_class = "gem5::o3::ValuePredictor"
+    cxx_header = "cpu/o3/value_pred.hh"
+    abstract = True
+
+    numThreads = Param.Unsigned(Parent.numThreads, "Number of threads")
+    confidenceThreshold = Param.Unsigned(
+        7,
+        "Confidence (0-7) an entry needs for its prediction to be used; "
+        "entries gain one for every correct result and restart at 0",
+    )
+
+
+class LastValuePredictor(ValuePredictor):
+    type = "LastValuePredictor"
+    cxx_class = "gem5::o3::LastValuePredictor"
+    cxx_header = "cpu/o3/value_pred.hh"
+
+    tableSize = Param.Unsigned(1024, "Number of entries")
+
+
+class StrideValuePredictor(LastValuePredictor):
+    type = "StrideValuePredictor"
+    cxx_class = "gem5::o3::StrideValuePredictor"
+    cxx_header = "cpu/o3/value_pred.hh"
+
+
+class VTAGEValuePredictor(ValuePredictor):
+    type = "VTAGEValuePredictor"
+    cxx_class = "gem5::o3::VTAGEValuePredictor"
+    cxx_header = "cpu/o3/value_pred.hh"
+
+    baseTableSize = Param.Unsigned(1024, "Entries of the PC indexed table")
+    taggedTableSize = Param.Unsigned(256, "Entries of each tagged table")
+    historyLengths = VectorParam.Unsigned(
+        [2, 4, 8, 16, 32, 64],
+        "Global branch history length of each tagged table (max 64)",
+    )
+    tagBits = Param.Unsigned(12, "Tag size of the tagged tables")
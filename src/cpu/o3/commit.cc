@@ -79,6 +79,7 @@ Commit::processTrapEvent(ThreadID tid)
     // This will get reset by commit if it was switched out at the
     // time of this event processing.
     trapSquash[tid] = true;
+    cpu->wakeCPU();
 }
 
 Commit::Commit(CPU *_cpu, const BaseO3CPUParams &params)
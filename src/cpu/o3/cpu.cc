@@ -72,6 +72,8 @@ namespace o3
 CPU::CPU(const BaseO3CPUParams &params)
     : BaseCPU(params),
       mmu(params.mmu),
+      dynInstPool(params.numROBEntries + params.numIQEntries +
+                  params.LQEntries + params.SQEntries),
       tickEvent([this]{ tick(); }, "O3CPU tick",
                 false, Event::CPU_Tick_Pri),
       threadExitEvent([this]{ exitThreads(); }, "O3CPU exit threads",
@@ -111,6 +113,8 @@ CPU::CPU(const BaseO3CPUParams &params)
                   params.backComSize + params.forwardComSize,
                   params.activity),
 
+      memStallSleepThreshold(params.memStallSleepThreshold),
+      memStallSleeping(false),
       globalSeqNum(1),
       system(params.system),
       lastRunningCycle(curCycle()),
@@ -346,7 +350,16 @@ CPU::CPUStats::CPUStats(CPU *cpu)
                "to idling"),
       ADD_STAT(quiesceCycles, statistics::units::Cycle::get(),
                "Total number of cycles that CPU has spent quiesced or waiting "
-               "for an interrupt")
+               "for an interrupt"),
+      ADD_STAT(memStallCycles, statistics::units::Cycle::get(),
+               "Total number of cycles that the CPU has spent unscheduled "
+               "waiting on outstanding memory accesses"),
+      ADD_STAT(dynInstAllocs, statistics::units::Count::get(),
+               "Number of DynInst buffers allocated from the heap"),
+      ADD_STAT(dynInstReuses, statistics::units::Count::get(),
+               "Number of DynInst buffers reused from the CPU's free lists"),
+      ADD_STAT(dynInstHeapFrees, statistics::units::Count::get(),
+               "Number of DynInst buffers returned to the heap")
 {
     // Register any of the O3CPU's stats here.
     timesIdled
@@ -357,6 +370,14 @@ CPU::CPUStats::CPUStats(CPU *cpu)
 
     quiesceCycles
         .prereq(quiesceCycles);
+
+    memStallCycles
+        .prereq(memStallCycles);
+
+    const DynInstPool &pool = cpu->dynInstPool;
+    dynInstAllocs.functor([&pool]() { return pool.allocs(); });
+    dynInstReuses.functor([&pool]() { return pool.reuses(); });
+    dynInstHeapFrees.functor([&pool]() { return pool.heapFrees(); });
 }
 
 void
@@ -368,6 +389,7 @@ CPU::tick()
 
     ++baseStats.numCycles;
     updateCycleCounters(BaseCPU::CPU_STATE_ON);
+    memStallSleeping = false;
 
 //    activity = false;
 
@@ -405,6 +427,10 @@ CPU::tick()
             DPRINTF(O3CPU, "Idle!\n");
             lastRunningCycle = curCycle();
             cpuStats.timesIdled++;
+        } else if (stalledOnMemory()) {
+            DPRINTF(O3CPU, "Stalled on memory!\n");
+            lastRunningCycle = curCycle();
+            memStallSleeping = true;
         } else {
             schedule(tickEvent, clockEdge(Cycles(1)));
             DPRINTF(O3CPU, "Scheduling next tick!\n");
@@ -807,7 +833,8 @@ CPU::isCpuDrained() const
 {
     bool drained(true);
 
-    if (!instList.empty() || !removeList.empty()) {
+    if (!instList.empty() || !removeList.empty() ||
+        !squashedInstList.empty()) {
         DPRINTF(Drain, "Main CPU structures not drained.\n");
         drained = false;
     }
@@ -1183,25 +1210,10 @@ CPU::removeInstsNotInROB(ThreadID tid)
 
     removeInstsThisCycle = true;
 
-    ListIt inst_it = instList.end();
-
-    inst_it--;
-
-    // Walk through the instruction list, removing any instructions
-    // that were inserted after the given instruction iterator, end_it.
-    while (inst_it != end_it) {
-        assert(!instList.empty());
-
-        squashInstIt(inst_it, tid);
-
-        inst_it--;
-    }
-
-    // If the ROB was empty, then we actually need to remove the first
-    // instruction as well.
-    if (rob_empty) {
-        squashInstIt(inst_it, tid);
-    }
+    // Remove any instructions that were inserted after the given
+    // instruction iterator, end_it. If the ROB was empty, then we
+    // actually need to remove the first instruction as well.
+    squashInstsFrom(rob_empty ? end_it : std::next(end_it), tid);
 }
 
 void
@@ -1219,37 +1231,58 @@ CPU::removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid)
             "list that are from [tid:%i] and above [sn:%lli] (end=%lli).\n",
             tid, seq_num, (*inst_iter)->seqNum);
 
+    // Find the oldest instruction younger than seq_num.
+    ListIt first = instList.end();
     while ((*inst_iter)->seqNum > seq_num) {
-
-        bool break_loop = (inst_iter == instList.begin());
-
-        squashInstIt(inst_iter, tid);
-
-        inst_iter--;
-
-        if (break_loop)
+        first = inst_iter;
+        if (inst_iter == instList.begin())
             break;
+        inst_iter--;
     }
+
+    squashInstsFrom(first, tid);
 }
 
 void
-CPU::squashInstIt(const ListIt &instIt, ThreadID tid)
+CPU::squashInstsFrom(const ListIt &first, ThreadID tid)
 {
-    if ((*instIt)->threadNumber == tid) {
-        DPRINTF(O3CPU, "Squashing instruction, "
-                "[tid:%i] [sn:%lli] PC %s\n",
-                (*instIt)->threadNumber,
-                (*instIt)->seqNum,
-                (*instIt)->pcState());
+    if (first == instList.end())
+        return;
 
-        // Mark it as squashed.
-        (*instIt)->setSquashed();
+    // Mark the instructions squashed youngest first, as they would be
+    // removed one by one.
+    bool whole_tail = true;
+    ListIt inst_it = instList.end();
+    do {
+        inst_it--;
+        if ((*inst_it)->threadNumber == tid) {
+            DPRINTF(O3CPU, "Squashing instruction, "
+                    "[tid:%i] [sn:%lli] PC %s\n",
+                    (*inst_it)->threadNumber,
+                    (*inst_it)->seqNum,
+                    (*inst_it)->pcState());
+            (*inst_it)->setSquashed();
+        } else {
+            whole_tail = false;
+        }
+    } while (inst_it != first);
 
-        // @todo: Formulate a consistent method for deleting
-        // instructions from the instruction list
-        // Remove the instruction from the list.
-        removeList.push(instIt);
+    if (whole_tail) {
+        // Truncate the list in one go; the instructions are released at
+        // the end of the cycle with the rest of the remove list.
+        squashedInstList.splice(squashedInstList.end(), instList,
+                                first, instList.end());
+        return;
     }
+
+    // Other threads have instructions interleaved with the squashed ones,
+    // so they have to be picked out one by one.
+    inst_it = instList.end();
+    do {
+        inst_it--;
+        if ((*inst_it)->threadNumber == tid)
+            removeList.push(inst_it);
+    } while (inst_it != first);
 }
 
 void
@@ -1267,6 +1300,8 @@ CPU::cleanUpRemovedInsts()
         removeList.pop();
     }
 
+    squashedInstList.clear();
+
     removeInstsThisCycle = false;
 }
 /*
@@ -1303,10 +1338,31 @@ CPU::wakeDependents(const DynInstPtr &inst)
     iew.wakeDependents(inst);
 }
 */
+bool
+CPU::stalledOnMemory()
+{
+    if (!memStallSleepThreshold || isDraining() || _status != Running ||
+        activityRec.getQuietCycles() < memStallSleepThreshold) {
+        return false;
+    }
+
+    // Work the stages can still do without a response from memory
+    if (iew.instQueue.hasReadyInsts() || iew.ldstQueue.willWB())
+        return false;
+
+    for (ThreadID tid : activeThreads) {
+        if (checkInterrupts(tid))
+            return false;
+    }
+
+    return iew.ldstQueue.hasOutstandingAccesses() || fetch.waitingOnICache();
+}
+
 void
 CPU::wakeCPU()
 {
-    if (activityRec.active() || tickEvent.scheduled()) {
+    if ((activityRec.active() && !memStallSleeping) ||
+            tickEvent.scheduled()) {
         DPRINTF(Activity, "CPU already running.\n");
         return;
     }
@@ -1317,9 +1373,13 @@ CPU::wakeCPU()
     // @todo: This is an oddity that is only here to match the stats
     if (cycles > 1) {
         --cycles;
-        cpuStats.idleCycles += cycles;
+        if (memStallSleeping)
+            cpuStats.memStallCycles += cycles;
+        else
+            cpuStats.idleCycles += cycles;
         baseStats.numCycles += cycles;
     }
+    memStallSleeping = false;
 
     schedule(tickEvent, clockEdge());
 }
@@ -1327,6 +1387,10 @@ CPU::wakeCPU()
 void
 CPU::wakeup(ThreadID tid)
 {
+    // An interrupt was posted; an active thread sleeping on memory has to
+    // take it now rather than at the next response.
+    wakeFromMemStall();
+
     if (thread[tid]->status() != gem5::ThreadContext::Suspended)
         return;
 
@@ -1448,7 +1512,7 @@ CPU::htmSendAbortSignal(ThreadID tid, uint64_t htm_uid,
 
     // notify l1 d-cache (ruby) that core has aborted transaction
     RequestPtr req =
-        std::make_shared<Request>(addr, size, flags, _dataRequestorId);
+        makeRequest(addr, size, flags, _dataRequestorId);
 
     req->taskId(taskId());
     req->setContext(thread[tid]->contextId());
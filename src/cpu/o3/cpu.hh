@@ -54,6 +54,7 @@
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/commit.hh"
 #include "cpu/o3/decode.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/fetch.hh"
 #include "cpu/o3/free_list.hh"
@@ -108,6 +109,13 @@ class CPU : public BaseCPU
     };
 
     BaseMMU *mmu;
+
+    /**
+     * Buffers of the DynInsts of this CPU. Declared before everything
+     * that may hold a DynInst so that it is destroyed last.
+     */
+    DynInstPool dynInstPool;
+
     using LSQRequest = LSQ::LSQRequest;
 
     using PerThreadUnifiedRenameMap =
@@ -365,8 +373,11 @@ class CPU : public BaseCPU
     /** Remove all instructions younger than the given sequence number. */
     void removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid);
 
-    /** Removes the instruction pointed to by the iterator. */
-    void squashInstIt(const ListIt &instIt, ThreadID tid);
+    /** Squashes the instructions of a thread from the iterator to the
+     *  end of the instruction list. If they are the whole tail of the
+     *  list they are moved to squashedInstList in one go.
+     */
+    void squashInstsFrom(const ListIt &first, ThreadID tid);
 
     /** Cleans up all instructions on the remove list. */
     void cleanUpRemovedInsts();
@@ -388,6 +399,11 @@ class CPU : public BaseCPU
      */
     std::queue<ListIt> removeList;
 
+    /** Tails of the instruction list squashed this cycle, reclaimed
+     *  together with the remove list at the end of the cycle.
+     */
+    std::list<DynInstPtr> squashedInstList;
+
 #ifdef GEM5_DEBUG
     /** Debug structure to keep track of the sequence numbers still in
      * flight.
@@ -504,6 +520,30 @@ class CPU : public BaseCPU
     /** Wakes the CPU, rescheduling the CPU if it's not already active. */
     void wakeCPU();
 
+    /**
+     * Wakes the CPU if it stopped ticking while stalled on memory, for
+     * events other than a D-cache response that it may be waiting on.
+     */
+    void wakeFromMemStall() { if (memStallSleeping) wakeCPU(); }
+
+  private:
+    /**
+     * Can the CPU stop ticking until the next memory response? True when
+     * no stage has communicated for memStallSleepThreshold cycles, there
+     * is nothing left to issue or write back, and accesses are still
+     * outstanding in the memory system. D-TLB translations that finish
+     * and interrupts that are posted wake the CPU as well.
+     */
+    bool stalledOnMemory();
+
+    /** Cycles without activity before sleeping on memory, 0 to disable. */
+    const Cycles memStallSleepThreshold;
+
+    /** Is the CPU sleeping until the next memory response? */
+    bool memStallSleeping;
+
+  public:
+
     virtual void wakeup(ThreadID tid) override;
 
     /** Gets a free thread id. Use if thread ids change across system. */
@@ -584,6 +624,16 @@ class CPU : public BaseCPU
         /** Stat for total number of cycles the CPU spends descheduled due to a
          * quiesce operation or waiting for an interrupt. */
         statistics::Scalar quiesceCycles;
+        /** Stat for total number of cycles the CPU was not ticked while
+         * waiting on outstanding memory accesses. */
+        statistics::Scalar memStallCycles;
+
+        /** @{ */
+        /** Stats of the DynInst buffer pool. */
+        statistics::Value dynInstAllocs;
+        statistics::Value dynInstReuses;
+        statistics::Value dynInstHeapFrees;
+        /** @} */
     } cpuStats;
 
   public:
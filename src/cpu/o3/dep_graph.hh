@@ -128,6 +128,30 @@ class DependencyGraph
      */
     std::vector<DepEntry> dependGraph;
 
+    /** Entries that have been removed from the graph, kept for reuse so
+     *  that building the graph does not allocate in steady state. */
+    DepEntry *freeEntries = nullptr;
+
+    /** Get an entry from the free list, or a new one if it is empty. */
+    DepEntry *
+    allocEntry()
+    {
+        DepEntry *entry = freeEntries;
+        if (!entry)
+            return new DepEntry;
+        freeEntries = entry->next;
+        return entry;
+    }
+
+    /** Put an entry, which must no longer hold an instruction, on the
+     *  free list. */
+    void
+    freeEntry(DepEntry *entry)
+    {
+        entry->next = freeEntries;
+        freeEntries = entry;
+    }
+
     /** Number of linked lists; identical to the number of registers. */
     int numEntries;
 
@@ -144,6 +168,12 @@ class DependencyGraph
 template <class DynInstPtr>
 DependencyGraph<DynInstPtr>::~DependencyGraph()
 {
+    reset();
+    while (freeEntries) {
+        DepEntry *next = freeEntries->next;
+        delete freeEntries;
+        freeEntries = next;
+    }
 }
 
 template <class DynInstPtr>
@@ -172,7 +202,7 @@ DependencyGraph<DynInstPtr>::reset()
             curr = prev->next;
             prev->inst = NULL;
 
-            delete prev;
+            freeEntry(prev);
         }
 
         if (dependGraph[i].inst) {
@@ -192,7 +222,7 @@ DependencyGraph<DynInstPtr>::insert(RegIndex idx, const DynInstPtr &new_inst)
 
     // First create the entry that will be added to the head of the
     // dependency chain.
-    DepEntry *new_entry = new DepEntry;
+    DepEntry *new_entry = allocEntry();
     new_entry->next = dependGraph[idx].next;
     new_entry->inst = new_inst;
 
@@ -238,7 +268,7 @@ DependencyGraph<DynInstPtr>::remove(RegIndex idx,
     // Could push this off to the destructor of DependencyEntry
     curr->inst = NULL;
 
-    delete curr;
+    freeEntry(curr);
 }
 
 template <class DynInstPtr>
@@ -253,7 +283,7 @@ DependencyGraph<DynInstPtr>::pop(RegIndex idx)
         dependGraph[idx].next = node->next;
         node->inst = NULL;
         memAllocCounter--;
-        delete node;
+        freeEntry(node);
     }
     return inst;
 }
@@ -56,6 +56,7 @@
 #include "cpu/inst_res.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/lsq_unit.hh"
 #include "cpu/op_class.hh"
@@ -87,6 +88,9 @@ class DynInst : public ExecContext, public RefCounted
         size_t numSrcs;
         size_t numDests;
 
+        /** Pool the buffer comes from, or null to use the heap. */
+        DynInstPool *pool = nullptr;
+
         RegId *flatDestIdx;
         PhysRegIdPtr *destIdx;
         PhysRegIdPtr *prevDestIdx;
@@ -189,6 +193,9 @@ class DynInst : public ExecContext, public RefCounted
         HtmFromTransaction,
         NoCapableFU,           /// Processor does not have capability to
                                /// execute the instruction
+        VpLookedUp,
+        VpHit,
+        VpUsed,
         MaxFlags
     };
 
@@ -348,6 +355,12 @@ class DynInst : public ExecContext, public RefCounted
     /** Pointer to the data for the memory access. */
     uint8_t *memData = nullptr;
 
+    /** Value predicted for the destination register at rename. */
+    RegVal predictedValue = 0;
+
+    /** Value predictor history the prediction was made with. */
+    uint64_t vpHistory = 0;
+
     /** Load queue index. */
     ssize_t lqIdx = -1;
     typename LSQUnit::LQIterator lqIt;
@@ -443,6 +456,17 @@ class DynInst : public ExecContext, public RefCounted
     bool hitExternalSnoop() const { return instFlags[HitExternalSnoop]; }
     void hitExternalSnoop(bool f) { instFlags[HitExternalSnoop] = f; }
 
+    /** Value prediction state. The predictor was looked up at rename;
+     * it hit; and the predicted value was written to the destination so
+     * dependents could issue early (which requires validation).
+     */
+    bool vpLookedUp() const { return instFlags[VpLookedUp]; }
+    void vpLookedUp(bool f) { instFlags[VpLookedUp] = f; }
+    bool vpHit() const { return instFlags[VpHit]; }
+    void vpHit(bool f) { instFlags[VpHit] = f; }
+    bool vpUsed() const { return instFlags[VpUsed]; }
+    void vpUsed(bool f) { instFlags[VpUsed] = f; }
+
     /**
      * Returns true if the DTB address translation is being delayed due to a hw
      * page table walk.
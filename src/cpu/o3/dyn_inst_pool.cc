@@ -0,0 +1,101 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/dyn_inst_pool.hh"
+
+#include <new>
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+DynInstPool::DynInstPool(size_t capacity) : _capacity(capacity)
+{}
+
+DynInstPool::~DynInstPool()
+{
+    for (auto &list : freeLists) {
+        while (list) {
+            FreeBuffer *buf = list;
+            list = buf->next;
+            ::operator delete(header(buf));
+        }
+    }
+}
+
+void *
+DynInstPool::allocate(DynInstPool *pool, size_t size)
+{
+    unsigned bucket = divCeil(size, BucketGranule) - 1;
+    if (!pool || bucket >= NumBuckets) {
+        bucket = NoBucket;
+    } else if (FreeBuffer *buf = pool->freeLists[bucket]) {
+        pool->freeLists[bucket] = buf->next;
+        pool->cached--;
+        pool->_reuses++;
+        return buf;
+    } else {
+        // Round up so the buffer can be reused by any size in the bucket
+        size = (bucket + 1) * BucketGranule;
+    }
+
+    if (pool)
+        pool->_allocs++;
+
+    Header *hdr = static_cast<Header *>(
+            ::operator new(sizeof(Header) + size));
+    hdr->pool = pool;
+    hdr->bucket = bucket;
+    return hdr + 1;
+}
+
+void
+DynInstPool::release(void *ptr)
+{
+    Header *hdr = header(ptr);
+    DynInstPool *pool = hdr->pool;
+    if (!pool) {
+        ::operator delete(hdr);
+        return;
+    }
+
+    if (hdr->bucket == NoBucket || pool->cached >= pool->_capacity) {
+        pool->_heapFrees++;
+        ::operator delete(hdr);
+        return;
+    }
+
+    FreeBuffer *buf = static_cast<FreeBuffer *>(ptr);
+    buf->next = pool->freeLists[hdr->bucket];
+    pool->freeLists[hdr->bucket] = buf;
+    pool->cached++;
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,122 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_DYN_INST_POOL_HH__
+#define __CPU_O3_DYN_INST_POOL_HH__
+
+#include <array>
+#include <cstddef>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Free lists of DynInst buffers owned by a single CPU.
+ *
+ * A DynInst is allocated together with its operand arrays in one buffer
+ * whose size depends on the number of operands of the instruction.
+ * Buffers are grouped by size into buckets of BucketGranule bytes, and a
+ * freed buffer is kept on the free list of its bucket so the next
+ * instruction of a similar size can reuse it without going to the heap.
+ * The number of buffers kept on the free lists is bounded by the
+ * capacity given to the constructor, which should match the number of
+ * instructions the CPU can hold in flight; buffers freed beyond that
+ * (e.g., after a large squash) are returned to the heap.
+ *
+ * Every buffer is preceded by a small header pointing back to its pool,
+ * so a buffer can be freed without knowing which CPU allocated it.
+ * Buffers allocated without a pool are always returned to the heap.
+ */
+class DynInstPool
+{
+  public:
+    /** @param capacity Maximum number of buffers kept for reuse. */
+    DynInstPool(size_t capacity);
+    ~DynInstPool();
+
+    DynInstPool(const DynInstPool &) = delete;
+    DynInstPool &operator=(const DynInstPool &) = delete;
+
+    /**
+     * Allocate a buffer of at least size bytes from the given pool, or
+     * from the heap if pool is null.
+     */
+    static void *allocate(DynInstPool *pool, size_t size);
+
+    /** Free a buffer obtained with allocate(). */
+    static void release(void *ptr);
+
+    size_t capacity() const { return _capacity; }
+
+    /** @{ */
+    /** Allocations that had to go to the heap. */
+    Counter allocs() const { return _allocs; }
+    /** Allocations that reused a buffer from a free list. */
+    Counter reuses() const { return _reuses; }
+    /** Buffers returned to the heap instead of kept for reuse. */
+    Counter heapFrees() const { return _heapFrees; }
+    /** @} */
+
+  private:
+    static constexpr size_t BucketGranule = 64;
+    static constexpr size_t NumBuckets = 64;
+    static constexpr unsigned NoBucket = NumBuckets;
+
+    struct alignas(alignof(std::max_align_t)) Header
+    {
+        DynInstPool *pool;
+        unsigned bucket;
+    };
+
+    struct FreeBuffer
+    {
+        FreeBuffer *next;
+    };
+
+    static Header *
+    header(void *ptr)
+    {
+        return static_cast<Header *>(ptr) - 1;
+    }
+
+    const size_t _capacity;
+    size_t cached = 0;
+
+    std::array<FreeBuffer *, NumBuckets> freeLists{};
+
+    Counter _allocs = 0;
+    Counter _reuses = 0;
+    Counter _heapFrees = 0;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_DYN_INST_POOL_HH__
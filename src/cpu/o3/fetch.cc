@@ -98,7 +98,12 @@ Fetch::Fetch(CPU *_cpu, const BaseO3CPUParams &params)
       numThreads(params.numThreads),
       numFetchingThreads(params.smtNumFetchingThreads),
       icachePort(this, _cpu),
-      finishTranslationEvent(this), fetchStats(_cpu, this)
+      finishTranslationEvent(this),
+      ftqSize(params.fetchTargetQueueSize),
+      ftqScanBytes(params.fetchTargetScanBytes),
+      ftqPageBytes(params.fetchTargetPageBytes),
+      ftqPrefetchesInFlight(0),
+      fetchStats(_cpu, this)
 {
     if (numThreads > MaxThreads)
         fatal("numThreads (%d) is larger than compiled limit (%d),\n"
@@ -142,6 +147,15 @@ Fetch::Fetch(CPU *_cpu, const BaseO3CPUParams &params)
 
     // Get the size of an instruction.
     instSize = decoder[0]->moreBytesSize();
+
+    if (!ftqScanBytes)
+        ftqScanBytes = instSize;
+    fatal_if(ftqSize && !isPowerOf2(ftqScanBytes),
+             "fetchTargetScanBytes (%d) must be a power of 2.", ftqScanBytes);
+    fatal_if(ftqSize && (!isPowerOf2(ftqPageBytes) ||
+                         ftqPageBytes < fetchBufferSize),
+             "fetchTargetPageBytes (%d) must be a power of 2 no smaller "
+             "than the fetch buffer.", ftqPageBytes);
 }
 
 std::string Fetch::name() const { return cpu->name() + ".fetch"; }
@@ -193,7 +207,24 @@ Fetch::FetchStatGroup::FetchStatGroup(CPU *cpu, Fetch *fetch)
              "Number of instructions fetched each cycle (Total)"),
     ADD_STAT(idleRate, statistics::units::Ratio::get(),
              "Ratio of cycles fetch was idle",
-             idleCycles / cpu->baseStats.numCycles)
+             idleCycles / cpu->baseStats.numCycles),
+    ADD_STAT(btbBubbleCycles, statistics::units::Cycle::get(),
+             "Number of cycles fetch waited for a slow BTB level"),
+    ADD_STAT(ftqOccupancy, statistics::units::Count::get(),
+             "Number of blocks in the fetch target queue each cycle"),
+    ADD_STAT(ftqHits, statistics::units::Count::get(),
+             "Number of fetched blocks the fetch target queue predicted"),
+    ADD_STAT(ftqMisses, statistics::units::Count::get(),
+             "Number of times fetch left the predicted run-ahead path"),
+    ADD_STAT(ftqPrefetches, statistics::units::Count::get(),
+             "Number of run-ahead I-cache prefetches sent"),
+    ADD_STAT(ftqPrefetchesDropped, statistics::units::Count::get(),
+             "Number of run-ahead I-cache prefetches that were not sent"),
+    ADD_STAT(ftqPrefetchesUseful, statistics::units::Count::get(),
+             "Number of prefetched blocks fetch used"),
+    ADD_STAT(ftqPrefetchAccuracy, statistics::units::Ratio::get(),
+             "Fraction of run-ahead prefetches that were used",
+             ftqPrefetchesUseful / ftqPrefetches)
 {
         predictedBranches
             .prereq(predictedBranches);
@@ -232,6 +263,25 @@ Fetch::FetchStatGroup::FetchStatGroup(CPU *cpu, Fetch *fetch)
             .flags(statistics::pdf);
         idleRate
             .prereq(idleRate);
+        btbBubbleCycles
+            .prereq(btbBubbleCycles);
+        ftqOccupancy
+            .init(0, std::max(fetch->ftqSize, 1u), 1)
+            .flags(statistics::pdf);
+        ftqOccupancy
+            .prereq(ftqOccupancy);
+        ftqHits
+            .prereq(ftqHits);
+        ftqMisses
+            .prereq(ftqMisses);
+        ftqPrefetches
+            .prereq(ftqPrefetches);
+        ftqPrefetchesDropped
+            .prereq(ftqPrefetchesDropped);
+        ftqPrefetchesUseful
+            .prereq(ftqPrefetchesUseful);
+        ftqPrefetchAccuracy
+            .prereq(ftqPrefetches);
 }
 void
 Fetch::setTimeBuffer(TimeBuffer<TimeStruct> *time_buffer)
@@ -283,6 +333,8 @@ Fetch::clearStates(ThreadID tid)
     fetchBufferPC[tid] = 0;
     fetchBufferValid[tid] = false;
     fetchQueue[tid].clear();
+    ftqFlush(tid);
+    bubbleEnd[tid] = Cycles(0);
 
     // TODO not sure what to do with priorityList for now
     // priorityList.push_back(tid);
@@ -321,6 +373,9 @@ Fetch::resetStage()
         fetchBufferValid[tid] = false;
 
         fetchQueue[tid].clear();
+        ftqFlush(tid);
+        ftq[tid].pageValid = false;
+        bubbleEnd[tid] = Cycles(0);
 
         priorityList.push_back(tid);
     }
@@ -425,7 +480,17 @@ Fetch::isDrained() const
      * cycle if the finish translation event is scheduled, so make
      * sure that's not the case.
      */
-    return !finishTranslationEvent.scheduled();
+    return !finishTranslationEvent.scheduled() && !ftqPrefetchesInFlight;
+}
+
+bool
+Fetch::waitingOnICache() const
+{
+    for (ThreadID tid = 0; tid < numThreads; tid++) {
+        if (fetchStatus[tid] == IcacheWaitResponse)
+            return true;
+    }
+    return false;
 }
 
 void
@@ -527,6 +592,11 @@ Fetch::lookupAndUpdateNextPC(const DynInstPtr &inst, PCStateBase &next_pc)
 
     if (predict_taken) {
         ++fetchStats.predictedBranches;
+
+        // A target from a slow BTB level keeps fetch from redirecting
+        // right away.
+        if (Cycles bubble = branchPred->fetchBubble(tid))
+            bubbleEnd[tid] = cpu->curCycle() + Cycles(1) + bubble;
     }
 
     return predict_taken;
@@ -561,10 +631,12 @@ Fetch::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
     DPRINTF(Fetch, "[tid:%i] Fetching cache line %#x for addr %#x\n",
             tid, fetchBufferBlockPC, vaddr);
 
+    ftqAdvance(tid, vaddr);
+
     // Setup the memReq to do a read of the first instruction's address.
     // Set the appropriate read size and flags as well.
     // Build request here.
-    RequestPtr mem_req = std::make_shared<Request>(
+    RequestPtr mem_req = makeRequest(
         fetchBufferBlockPC, fetchBufferSize,
         Request::INST_FETCH, cpu->instRequestorId(), pc,
         cpu->thread[tid]->contextId());
@@ -614,6 +686,8 @@ Fetch::finishTranslation(const Fault &fault, const RequestPtr &mem_req)
             return;
         }
 
+        ftqTranslated(tid, mem_req);
+
         // Build packet here.
         PacketPtr data_pkt = new Packet(mem_req, MemCmd::ReadReq);
         data_pkt->dataDynamic(new uint8_t[fetchBufferSize]);
@@ -729,6 +803,8 @@ Fetch::doSquash(const PCStateBase &new_pc, const DynInstPtr squashInst,
 
     // Empty fetch queue
     fetchQueue[tid].clear();
+    ftqFlush(tid);
+    bubbleEnd[tid] = Cycles(0);
 
     // microops are being squashed, it is not known wheather the
     // youngest non-squashed microop was  marked delayed commit
@@ -852,6 +928,10 @@ Fetch::tick()
     // Record number of instructions fetched this cycle for distribution.
     fetchStats.nisnDist.sample(numInst);
 
+    // Let the decoupled front end run ahead of fetch.
+    for (ThreadID tid : *activeThreads)
+        ftqFill(tid);
+
     if (status_change) {
         // Change the fetch stage status if there was a status change.
         _status = updateFetchStatus();
@@ -1024,6 +1104,7 @@ Fetch::buildInst(ThreadID tid, StaticInstPtr staticInst,
     DynInst::Arrays arrays;
     arrays.numSrcs = staticInst->numSrcRegs();
     arrays.numDests = staticInst->numDestRegs();
+    arrays.pool = &cpu->dynInstPool;
 
     // Create a new DynInst from the instruction fetched.
     DynInstPtr instruction = new (arrays) DynInst(
@@ -1128,6 +1209,11 @@ Fetch::fetch(bool &status_change)
             else
                 ++fetchStats.miscStallCycles;
             return;
+        } else if (bubbleEnd[tid] > cpu->curCycle()) {
+            // Waiting for the BTB to provide a taken branch's target.
+            ++fetchStats.btbBubbleCycles;
+            DPRINTF(Fetch, "[tid:%i] Fetch is in a BTB bubble.\n", tid);
+            return;
         } else if (checkInterrupt(this_pc.instAddr()) &&
                 !delayedCommit[tid]) {
             // Stall CPU if an interrupt is posted and we're not issuing
@@ -1352,6 +1438,156 @@ Fetch::recvReqRetry()
     }
 }
 
+void
+Fetch::ftqFill(ThreadID tid)
+{
+    if (!ftqSize)
+        return;
+
+    FetchTargetQueue &q = ftq[tid];
+    fetchStats.ftqOccupancy.sample(q.blocks.size());
+    if (!q.running || q.blocks.size() >= ftqSize || stalls[tid].drain)
+        return;
+
+    const Addr block = fetchBufferAlignPC(q.nextPC);
+    q.blocks.push_back(block);
+    ftqPrefetch(tid, block);
+
+    bool stop = false;
+    q.nextPC = ftqNextPC(tid, q.nextPC, stop);
+    q.running = !stop;
+    DPRINTF(Fetch, "[tid:%i] Run-ahead queued block %#x, next %#x%s.\n",
+            tid, block, q.nextPC, stop ? ", stopped" : "");
+}
+
+void
+Fetch::ftqAdvance(ThreadID tid, Addr vaddr)
+{
+    if (!ftqSize)
+        return;
+
+    FetchTargetQueue &q = ftq[tid];
+    const Addr block = fetchBufferAlignPC(vaddr);
+    if (q.currentValid && q.current == block)
+        return;
+    q.current = block;
+    q.currentValid = true;
+
+    if (!q.blocks.empty()) {
+        if (q.blocks.front() == block) {
+            ++fetchStats.ftqHits;
+            q.blocks.pop_front();
+            return;
+        }
+        ++fetchStats.ftqMisses;
+        q.blocks.clear();
+    }
+
+    // Restart the run-ahead from where fetch is.
+    bool stop = false;
+    q.nextPC = ftqNextPC(tid, vaddr, stop);
+    q.running = !stop;
+}
+
+void
+Fetch::ftqFlush(ThreadID tid)
+{
+    FetchTargetQueue &q = ftq[tid];
+    q.blocks.clear();
+    q.currentValid = false;
+    q.running = false;
+}
+
+void
+Fetch::ftqTranslated(ThreadID tid, const RequestPtr &mem_req)
+{
+    if (!ftqSize)
+        return;
+
+    FetchTargetQueue &q = ftq[tid];
+    q.pageVaddr = roundDown(mem_req->getVaddr(), ftqPageBytes);
+    q.pagePaddr = roundDown(mem_req->getPaddr(), ftqPageBytes);
+    q.pageValid = !mem_req->isUncacheable();
+
+    auto it = std::find(q.prefetched.begin(), q.prefetched.end(),
+                        mem_req->getPaddr());
+    if (it != q.prefetched.end()) {
+        ++fetchStats.ftqPrefetchesUseful;
+        q.prefetched.erase(it);
+    }
+}
+
+Addr
+Fetch::ftqNextPC(ThreadID tid, Addr pc, bool &stop)
+{
+    const Addr end = fetchBufferAlignPC(pc) + fetchBufferSize;
+    for (Addr scan = roundDown(pc, ftqScanBytes); scan < end;
+            scan += ftqScanBytes) {
+        Addr target;
+        switch (branchPred->runAheadLookup(tid, scan, target)) {
+          case branch_prediction::BPredUnit::RunAhead::Taken:
+            return target;
+          case branch_prediction::BPredUnit::RunAhead::Unknown:
+            stop = true;
+            return end;
+          default:
+            break;
+        }
+    }
+    return end;
+}
+
+void
+Fetch::ftqPrefetch(ThreadID tid, Addr vaddr)
+{
+    FetchTargetQueue &q = ftq[tid];
+    if (!q.pageValid || roundDown(vaddr, ftqPageBytes) != q.pageVaddr ||
+        cacheBlocked) {
+        ++fetchStats.ftqPrefetchesDropped;
+        return;
+    }
+
+    const Addr paddr = q.pagePaddr + (vaddr - q.pageVaddr);
+    if (std::find(q.prefetched.begin(), q.prefetched.end(), paddr) !=
+        q.prefetched.end()) {
+        return;
+    }
+    if (!cpu->system->isMemAddr(paddr)) {
+        ++fetchStats.ftqPrefetchesDropped;
+        return;
+    }
+
+    RequestPtr req = makeRequest(paddr, fetchBufferSize,
+                                 Request::INST_FETCH, cpu->instRequestorId());
+    req->taskId(cpu->taskId());
+    PacketPtr pkt = new Packet(req, MemCmd::SoftPFReq);
+    pkt->allocate();
+
+    if (!icachePort.sendTimingReq(pkt)) {
+        // The cache will send a retry, which unblocks demand fetches.
+        delete pkt;
+        cacheBlocked = true;
+        ++fetchStats.ftqPrefetchesDropped;
+        return;
+    }
+
+    DPRINTF(Fetch, "[tid:%i] Prefetching block %#x (%#x).\n",
+            tid, vaddr, paddr);
+    ++fetchStats.ftqPrefetches;
+    ++ftqPrefetchesInFlight;
+    q.prefetched.push_back(paddr);
+    if (q.prefetched.size() > 2 * ftqSize)
+        q.prefetched.pop_front();
+}
+
+void
+Fetch::ftqPrefetchResponse(PacketPtr pkt)
+{
+    assert(ftqPrefetchesInFlight);
+    --ftqPrefetchesInFlight;
+    delete pkt;
+}
+
 ///////////////////////////////////////
 //                                   //
 //  SMT FETCH POLICY MAINTAINED HERE //
@@ -1573,6 +1809,10 @@ bool
 Fetch::IcachePort::recvTimingResp(PacketPtr pkt)
 {
     DPRINTF(O3CPU, "Fetch unit received timing\n");
+    if (pkt->cmd == MemCmd::SoftPFResp) {
+        fetch->ftqPrefetchResponse(pkt);
+        return true;
+    }
     // We shouldn't ever get a cacheable block in Modified state
     assert(pkt->req->isUncacheable() ||
            !(pkt->cacheResponding() && !pkt->hasSharers()));
@@ -244,6 +244,9 @@ class Fetch
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /** Is any thread waiting for a response from the I-cache? */
+    bool waitingOnICache() const;
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
@@ -389,6 +392,41 @@ class Fetch
     /** Profile the reasons of fetch stall. */
     void profileStall(ThreadID tid);
 
+    /** @{ */
+    /**
+     * Decoupled front end. The fetch target queue holds the fetch buffer
+     * blocks predicted to follow the one being fetched. It is filled
+     * ahead of fetch by following taken branches in the BTB, and each
+     * block is prefetched into the I-cache as it is queued.
+     */
+
+    /** Queue one more predicted block and prefetch it. */
+    void ftqFill(ThreadID tid);
+
+    /** Fetch moved on to the block holding vaddr. */
+    void ftqAdvance(ThreadID tid, Addr vaddr);
+
+    /** Drop the predicted blocks, e.g. on a squash. */
+    void ftqFlush(ThreadID tid);
+
+    /** Fetch translated a block, record its page for prefetching. */
+    void ftqTranslated(ThreadID tid, const RequestPtr &mem_req);
+
+    /**
+     * Scan the block holding pc, from pc on, for a branch the BTB
+     * predicts taken.
+     * @param stop Set if the run-ahead can't follow the path further.
+     * @return Where the predicted path continues.
+     */
+    Addr ftqNextPC(ThreadID tid, Addr pc, bool &stop);
+
+    /** Send an I-cache prefetch for the block at vaddr. */
+    void ftqPrefetch(ThreadID tid, Addr vaddr);
+
+    /** Handle the response to a prefetch sent by ftqPrefetch(). */
+    void ftqPrefetchResponse(PacketPtr pkt);
+    /** @} */
+
   private:
     /** Pointer to the O3CPU. */
     CPU *cpu;
@@ -530,6 +568,41 @@ class Fetch
     /** Event used to delay fault generation of translation faults */
     FinishTranslationEvent finishTranslationEvent;
 
+    /** Maximum number of blocks in a fetch target queue. */
+    const unsigned ftqSize;
+
+    /** Granularity of the run-ahead BTB probes. */
+    Addr ftqScanBytes;
+
+    /** Page size assumed when prefetching from the last translation. */
+    const Addr ftqPageBytes;
+
+    struct FetchTargetQueue
+    {
+        /** Predicted blocks following the one being fetched. */
+        std::deque<Addr> blocks;
+        /** The block being fetched. */
+        Addr current = 0;
+        bool currentValid = false;
+        /** Where the run-ahead continues, if running. */
+        Addr nextPC = 0;
+        bool running = false;
+        /** The page of the last fetch translation. */
+        Addr pageVaddr = 0;
+        Addr pagePaddr = 0;
+        bool pageValid = false;
+        /** Physical blocks prefetched and not fetched yet. */
+        std::deque<Addr> prefetched;
+    };
+
+    FetchTargetQueue ftq[MaxThreads];
+
+    /** Cycle until which a BTB bubble holds up fetch of each thread. */
+    Cycles bubbleEnd[MaxThreads];
+
+    /** Prefetches sent whose response has not arrived yet. */
+    unsigned ftqPrefetchesInFlight;
+
   protected:
     struct FetchStatGroup : public statistics::Group
     {
@@ -578,6 +651,22 @@ class Fetch
         statistics::Distribution nisnDist;
         /** Rate of how often fetch was idle. */
         statistics::Formula idleRate;
+        /** Cycles fetch waited for a taken target from a slow BTB level. */
+        statistics::Scalar btbBubbleCycles;
+        /** Blocks queued ahead of fetch, sampled every cycle. */
+        statistics::Distribution ftqOccupancy;
+        /** Blocks fetch found at the head of the fetch target queue. */
+        statistics::Scalar ftqHits;
+        /** Times fetch left the path the fetch target queue predicted. */
+        statistics::Scalar ftqMisses;
+        /** Run-ahead prefetches sent to the I-cache. */
+        statistics::Scalar ftqPrefetches;
+        /** Run-ahead prefetches that could not be sent. */
+        statistics::Scalar ftqPrefetchesDropped;
+        /** Prefetched blocks that fetch later asked for. */
+        statistics::Scalar ftqPrefetchesUseful;
+        /** Fraction of the sent prefetches that were useful. */
+        statistics::Formula ftqPrefetchAccuracy;
     } fetchStats;
 };
 
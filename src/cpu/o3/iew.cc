@@ -51,6 +51,7 @@
 #include "cpu/o3/dyn_inst.hh"
 #include "cpu/o3/fu_pool.hh"
 #include "cpu/o3/limits.hh"
+#include "cpu/o3/value_pred.hh"
 #include "cpu/timebuf.hh"
 #include "debug/Activity.hh"
 #include "debug/Drain.hh"
@@ -70,6 +71,7 @@ IEW::IEW(CPU *_cpu, const BaseO3CPUParams &params)
       instQueue(_cpu, this, params),
       ldstQueue(_cpu, this, params),
       fuPool(params.fuPool),
+      valuePred(params.valuePredictor),
       commitToIEWDelay(params.commitToIEWDelay),
       renameToIEWDelay(params.renameToIEWDelay),
       issueToExecuteDelay(params.issueToExecuteDelay),
@@ -491,6 +493,41 @@ IEW::squashDueToMemOrder(const DynInstPtr& inst, ThreadID tid)
     }
 }
 
+void
+IEW::squashDueToValueMispred(const DynInstPtr& inst, ThreadID tid)
+{
+    DPRINTF(IEW, "[tid:%i] Value mispredicted, squashing insts younger "
+            "than PC: %s [sn:%llu].\n", tid, inst->pcState(), inst->seqNum);
+
+    if (!toCommit->squash[tid] ||
+            inst->seqNum < toCommit->squashedSeqNum[tid]) {
+        toCommit->squash[tid] = true;
+        toCommit->squashedSeqNum[tid] = inst->seqNum;
+        toCommit->branchTaken[tid] = false;
+
+        set(toCommit->pc[tid], inst->pcState());
+        inst->staticInst->advancePC(*toCommit->pc[tid]);
+
+        // The load itself produced the right value and goes on to commit.
+        toCommit->mispredictInst[tid] = NULL;
+        toCommit->includeSquashInst[tid] = false;
+
+        wroteToTimeBuffer = true;
+    }
+}
+
+void
+IEW::validatePrediction(const DynInstPtr &inst, ThreadID tid)
+{
+    const Addr pc = inst->pcState().instAddr();
+    const RegVal actual = cpu->getReg(inst->renamedDestIdx(0), tid);
+
+    if (valuePred->train(pc, inst->vpHistory, actual, inst->vpHit(),
+                         inst->vpUsed(), inst->predictedValue)) {
+        squashDueToValueMispred(inst, tid);
+    }
+}
+
 void
 IEW::block(ThreadID tid)
 {
@@ -1385,6 +1422,9 @@ IEW::writebackInsts()
         // when it's ready to execute the strictly ordered load.
         if (!inst->isSquashed() && inst->isExecuted() &&
                 inst->getFault() == NoFault) {
+            if (inst->vpLookedUp())
+                validatePrediction(inst, tid);
+
             int dependents = instQueue.wakeDependents(inst);
 
             for (int i = 0; i < inst->numDestRegs(); i++) {
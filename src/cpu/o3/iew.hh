@@ -64,6 +64,7 @@ namespace o3
 {
 
 class FUPool;
+class ValuePredictor;
 
 /**
  * IEW handles both single threaded and SMT IEW
@@ -250,6 +251,15 @@ class IEW
      */
     void squashDueToMemOrder(const DynInstPtr &inst, ThreadID tid);
 
+    /** Sends commit proper information for a squash of the instructions
+     * younger than a load whose predicted value was wrong.
+     */
+    void squashDueToValueMispred(const DynInstPtr &inst, ThreadID tid);
+
+    /** Checks a load's value prediction against the executed result,
+     * training the predictor. */
+    void validatePrediction(const DynInstPtr &inst, ThreadID tid);
+
     /** Sets Dispatch to blocked, and signals back to other stages to block. */
     void block(ThreadID tid);
 
@@ -362,6 +372,10 @@ class IEW
 
     /** Pointer to the functional unit pool. */
     FUPool *fuPool;
+
+    /** Load value predictor shared with rename, if any. */
+    ValuePredictor *valuePred;
+
     /** Records if the LSQ needs to be updated on the next cycle, so that
      * IEW knows if there will be activity on the next cycle.
      */
@@ -44,6 +44,7 @@
 #include <limits>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 #include "cpu/o3/dyn_inst.hh"
 #include "cpu/o3/fu_pool.hh"
@@ -418,11 +419,9 @@ InstructionQueue::resetState()
     for (int i = 0; i < Num_OpClasses; ++i) {
         while (!readyInsts[i].empty())
             readyInsts[i].pop();
-        queueOnList[i] = false;
-        readyIt[i] = listOrder.end();
     }
+    readyQueues.fill(0);
     nonSpecInsts.clear();
-    listOrder.clear();
     deferredMemInsts.clear();
     blockedMemInsts.clear();
     retryMemInsts.clear();
@@ -541,12 +540,8 @@ InstructionQueue::isFull(ThreadID tid)
 bool
 InstructionQueue::hasReadyInsts()
 {
-    if (!listOrder.empty()) {
-        return true;
-    }
-
-    for (int i = 0; i < Num_OpClasses; ++i) {
-        if (!readyInsts[i].empty()) {
+    for (uint64_t word : readyQueues) {
+        if (word) {
             return true;
         }
     }
@@ -670,54 +665,40 @@ InstructionQueue::getInstToExecute()
 }
 
 void
-InstructionQueue::addToOrderList(OpClass op_class)
+InstructionQueue::readyQueuePushed(OpClass op_class)
 {
     assert(!readyInsts[op_class].empty());
-
-    ListOrderEntry queue_entry;
-
-    queue_entry.queueType = op_class;
-
-    queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
-
-    ListOrderIt list_it = listOrder.begin();
-    ListOrderIt list_end_it = listOrder.end();
-
-    while (list_it != list_end_it) {
-        if ((*list_it).oldestInst > queue_entry.oldestInst) {
-            break;
-        }
-
-        list_it++;
-    }
-
-    readyIt[op_class] = listOrder.insert(list_it, queue_entry);
-    queueOnList[op_class] = true;
+    readyQueues[op_class / 64] |= 1ULL << (op_class % 64);
+    oldestReady[op_class] = readyInsts[op_class].top()->seqNum;
 }
 
 void
-InstructionQueue::moveToYoungerInst(ListOrderIt list_order_it)
+InstructionQueue::readyQueuePopped(OpClass op_class)
 {
-    // Get iterator of next item on the list
-    // Delete the original iterator
-    // Determine if the next item is either the end of the list or younger
-    // than the new instruction.  If so, then add in a new iterator right here.
-    // If not, then move along.
-    ListOrderEntry queue_entry;
-    OpClass op_class = (*list_order_it).queueType;
-    ListOrderIt next_it = list_order_it;
-
-    ++next_it;
-
-    queue_entry.queueType = op_class;
-    queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
-
-    while (next_it != listOrder.end() &&
-           (*next_it).oldestInst < queue_entry.oldestInst) {
-        ++next_it;
+    if (readyInsts[op_class].empty()) {
+        readyQueues[op_class / 64] &= ~(1ULL << (op_class % 64));
+    } else {
+        oldestReady[op_class] = readyInsts[op_class].top()->seqNum;
     }
+}
 
-    readyIt[op_class] = listOrder.insert(next_it, queue_entry);
+OpClass
+InstructionQueue::oldestReadyQueue(const ReadyMask &skip) const
+{
+    OpClass oldest = Num_OpClasses;
+    for (size_t word = 0; word < ReadyMaskWords; ++word) {
+        uint64_t candidates = readyQueues[word] & ~skip[word];
+        while (candidates) {
+            OpClass op_class =
+                static_cast<OpClass>(word * 64 + findLsbSet(candidates));
+            candidates &= candidates - 1;
+            if (oldest == Num_OpClasses ||
+                    oldestReady[op_class] < oldestReady[oldest]) {
+                oldest = op_class;
+            }
+        }
+    }
+    return oldest;
 }
 
 void
@@ -761,20 +742,21 @@ InstructionQueue::scheduleReadyInsts()
         addReadyMemInst(mem_inst);
     }
 
-    // Have iterator to head of the list
-    // While I haven't exceeded bandwidth or reached the end of the list,
-    // Try to get a FU that can do what this op needs.
-    // If successful, change the oldestInst to the new top of the list, put
-    // the queue in the proper place in the list.
-    // Increment the iterator.
+    // While I haven't exceeded bandwidth or run out of ready queues,
+    // pick the ready queue with the oldest instruction and try to get a FU
+    // that can do what this op needs.
+    // If there is no free FU, skip that op class for the rest of this
+    // cycle.
     // This will avoid trying to schedule a certain op class if there are no
     // FUs that handle it.
     int total_issued = 0;
-    ListOrderIt order_it = listOrder.begin();
-    ListOrderIt order_end_it = listOrder.end();
+    ReadyMask busy_queues{};
 
-    while (total_issued < totalWidth && order_it != order_end_it) {
-        OpClass op_class = (*order_it).queueType;
+    while (total_issued < totalWidth) {
+        OpClass op_class = oldestReadyQueue(busy_queues);
+        if (op_class == Num_OpClasses) {
+            break;
+        }
 
         assert(!readyInsts[op_class].empty());
 
@@ -788,19 +770,11 @@ InstructionQueue::scheduleReadyInsts()
             iqIOStats.intInstQueueReads++;
         }
 
-        assert(issuing_inst->seqNum == (*order_it).oldestInst);
+        assert(issuing_inst->seqNum == oldestReady[op_class]);
 
         if (issuing_inst->isSquashed()) {
             readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
-
-            listOrder.erase(order_it++);
+            readyQueuePopped(op_class);
 
             ++iqStats.squashedInstsIssued;
 
@@ -873,13 +847,7 @@ InstructionQueue::scheduleReadyInsts()
                     issuing_inst->seqNum);
 
             readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
+            readyQueuePopped(op_class);
 
             issuing_inst->setIssued();
             ++total_issued;
@@ -901,13 +869,12 @@ InstructionQueue::scheduleReadyInsts()
                 memDepUnit[tid].issue(issuing_inst);
             }
 
-            listOrder.erase(order_it++);
             iqStats.statIssuedInstType[tid][op_class]++;
         } else {
             assert(idx == FUPool::NoFreeFU);
             iqStats.statFuBusy[op_class]++;
             iqStats.fuBusy[tid]++;
-            ++order_it;
+            busy_queues[op_class / 64] |= 1ULL << (op_class % 64);
         }
     }
 
@@ -1076,16 +1043,7 @@ InstructionQueue::addReadyMemInst(const DynInstPtr &ready_inst)
     OpClass op_class = ready_inst->opClass();
 
     readyInsts[op_class].push(ready_inst);
-
-    // Will need to reorder the list if either a queue is not on the list,
-    // or it has an older instruction than last time.
-    if (!queueOnList[op_class]) {
-        addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
-    }
+    readyQueuePushed(op_class);
 
     DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
             "the ready list, PC %s opclass:%i [sn:%llu].\n",
@@ -1197,19 +1155,20 @@ InstructionQueue::squash(ThreadID tid)
 void
 InstructionQueue::doSquash(ThreadID tid)
 {
-    // Start at the tail.
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
-
     DPRINTF(IQ, "[tid:%i] Squashing until sequence number %i!\n",
             tid, squashedSeqNum[tid]);
 
     // Squash any instructions younger than the squashed sequence number
-    // given.
-    while (squash_it != instList[tid].end() &&
-           (*squash_it)->seqNum > squashedSeqNum[tid]) {
+    // given, starting at the tail. They form the tail [first, end) of the
+    // list, which is truncated in one go once they have been handled.
+    ListIt first = instList[tid].end();
+    while (first != instList[tid].begin()) {
+        ListIt squash_it = std::prev(first);
+        if ((*squash_it)->seqNum <= squashedSeqNum[tid])
+            break;
+        first = squash_it;
 
-        DynInstPtr squashed_inst = (*squash_it);
+        const DynInstPtr &squashed_inst = (*squash_it);
         if (squashed_inst->isFloating()) {
             iqIOStats.fpInstQueueWrites++;
         } else if (squashed_inst->isVector()) {
@@ -1222,7 +1181,6 @@ InstructionQueue::doSquash(ThreadID tid)
         // hasn't already been squashed in the IQ.
         if (squashed_inst->threadNumber != tid ||
             squashed_inst->isSquashedInIQ()) {
-            --squash_it;
             continue;
         }
 
@@ -1331,9 +1289,10 @@ InstructionQueue::doSquash(ThreadID tid)
             assert(dependGraph.empty(dest_reg->flatIndex()));
             dependGraph.clearInst(dest_reg->flatIndex());
         }
-        instList[tid].erase(squash_it--);
         ++iqStats.squashedInstsExamined;
     }
+
+    instList[tid].erase(first, instList[tid].end());
 }
 
 bool
@@ -1451,16 +1410,7 @@ InstructionQueue::addIfReady(const DynInstPtr &inst)
                 inst->pcState(), op_class, inst->seqNum);
 
         readyInsts[op_class].push(inst);
-
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
-        }
+        readyQueuePushed(op_class);
     }
 }
 
@@ -1494,18 +1444,12 @@ InstructionQueue::dumpLists()
 
     cprintf("\n");
 
-    ListOrderIt list_order_it = listOrder.begin();
-    ListOrderIt list_order_end_it = listOrder.end();
-    int i = 1;
+    cprintf("Ready queues: ");
 
-    cprintf("List order: ");
-
-    while (list_order_it != list_order_end_it) {
-        cprintf("%i OpClass:%i [sn:%llu] ", i, (*list_order_it).queueType,
-                (*list_order_it).oldestInst);
-
-        ++list_order_it;
-        ++i;
+    for (int i = 0; i < Num_OpClasses; ++i) {
+        if (!readyInsts[i].empty()) {
+            cprintf("OpClass:%i [sn:%llu] ", i, oldestReady[i]);
+        }
     }
 
     cprintf("\n");
@@ -42,6 +42,8 @@
 #ifndef __CPU_O3_INST_QUEUE_HH__
 #define __CPU_O3_INST_QUEUE_HH__
 
+#include <array>
+#include <cstdint>
 #include <list>
 #include <map>
 #include <queue>
@@ -370,40 +372,33 @@ class InstructionQueue
 
     typedef std::map<InstSeqNum, DynInstPtr>::iterator NonSpecMapIt;
 
-    /** Entry for the list age ordering by op class. */
-    struct ListOrderEntry
-    {
-        OpClass queueType;
-        InstSeqNum oldestInst;
-    };
+    /** Number of 64-bit words in a mask of op classes. */
+    static constexpr size_t ReadyMaskWords = (Num_OpClasses + 63) / 64;
 
-    /** List that contains the age order of the oldest instruction of each
-     *  ready queue.  Used to select the oldest instruction available
-     *  among op classes.
-     *  @todo: Might be better to just move these entries around instead
-     *  of creating new ones every time the position changes due to an
-     *  instruction issuing.  Not sure std::list supports this.
-     */
-    std::list<ListOrderEntry> listOrder;
+    /** A set of op classes, one bit per class. */
+    typedef std::array<uint64_t, ReadyMaskWords> ReadyMask;
 
-    typedef typename std::list<ListOrderEntry>::iterator ListOrderIt;
+    /** Op classes whose ready queue is not empty. */
+    ReadyMask readyQueues;
 
-    /** Tracks if each ready queue is on the age order list. */
-    bool queueOnList[Num_OpClasses];
-
-    /** Iterators of each ready queue.  Points to their spot in the age order
-     *  list.
+    /** Sequence number of the oldest instruction of each non-empty ready
+     *  queue.  Kept next to the mask so that selecting the oldest queue
+     *  does not have to look into the queues themselves.
      */
-    ListOrderIt readyIt[Num_OpClasses];
+    std::array<InstSeqNum, Num_OpClasses> oldestReady;
+
+    /** Update the ready mask and age of a queue after a push. */
+    void readyQueuePushed(OpClass op_class);
 
-    /** Add an op class to the age order list. */
-    void addToOrderList(OpClass op_class);
+    /** Update the ready mask and age of a queue after a pop. */
+    void readyQueuePopped(OpClass op_class);
 
     /**
-     * Called when the oldest instruction has been removed from a ready queue;
-     * this places that ready queue into the proper spot in the age order list.
+     * Select the op class whose ready queue holds the oldest instruction.
+     * @param skip Op classes to ignore.
+     * @return The selected op class, or Num_OpClasses if there is none.
      */
-    void moveToYoungerInst(ListOrderIt age_order_it);
+    OpClass oldestReadyQueue(const ReadyMask &skip) const;
 
     DependencyGraph<DynInstPtr> dependGraph;
 
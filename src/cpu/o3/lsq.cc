@@ -45,7 +45,9 @@
 #include <list>
 #include <string>
 
+#include "arch/generic/mmu.hh"
 #include "base/compiler.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/dyn_inst.hh"
@@ -109,7 +111,7 @@ LSQ::DcachePort::DcachePortStats::DcachePortStats(CPU* _cpu)
 
 LSQ::LSQ(CPU *cpu_ptr, IEW *iew_ptr, const BaseO3CPUParams &params)
     : cpu(cpu_ptr), iewStage(iew_ptr),
-      _cacheBlocked(false),
+      _cacheBlocked(false), outstandingAccesses(0),
       cacheStorePorts(params.cacheStorePorts), usedStorePorts(0),
       cacheLoadPorts(params.cacheLoadPorts), usedLoadPorts(0),
       waitingForStaleTranslation(false),
@@ -123,6 +125,7 @@ LSQ::LSQ(CPU *cpu_ptr, IEW *iew_ptr, const BaseO3CPUParams &params)
                   params.smtLSQThreshold)),
       dcachePort(this, cpu_ptr),
       numThreads(params.numThreads),
+      _fusedTranslationBytes(params.LSQFusedTranslationBytes),
       recvRespThrottling(params.recvRespThrottling),
       recvRespMaxCachelines(params.recvRespMaxCachelines),
       recvRespBufferSize(params.recvRespBufferSize),
@@ -133,6 +136,16 @@ LSQ::LSQ(CPU *cpu_ptr, IEW *iew_ptr, const BaseO3CPUParams &params)
       retryRespEvent([this]{ sendRetryResp(); }, name())
 {
     assert(numThreads > 0 && numThreads <= MaxThreads);
+    fatal_if(_fusedTranslationBytes && !isPowerOf2(_fusedTranslationBytes),
+             "LSQFusedTranslationBytes (%d) must be a power of 2.",
+             _fusedTranslationBytes);
+    // A fused block which crosses a page would give the fragments on the
+    // next page the physical address of the first one
+    fatal_if(params.mmu &&
+             _fusedTranslationBytes > params.mmu->minPageBytes(),
+             "LSQFusedTranslationBytes (%d) must not exceed the smallest "
+             "page size (%d).", _fusedTranslationBytes,
+             params.mmu->minPageBytes());
 
     //**********************************************
     //************ Handle SMT Parameters ***********
@@ -422,6 +435,7 @@ LSQ::recvReqRetry()
 {
     iewStage->cacheUnblocked();
     cacheBlocked(false);
+    cpu->wakeCPU();
 
     for (ThreadID tid : *activeThreads) {
         thread[tid].recvRetry();
@@ -452,6 +466,11 @@ LSQ::recvTimingResp(PacketPtr pkt)
     LSQRequest *request = dynamic_cast<LSQRequest*>(pkt->senderState);
     panic_if(!request, "Got packet back with unknown sender state\n");
 
+    assert(outstandingAccesses > 0);
+    outstandingAccesses--;
+    // The CPU may have gone to sleep waiting for this response.
+    cpu->wakeCPU();
+
     thread[cpu->contextToThread(request->contextId())].recvTimingResp(pkt);
 
     if (pkt->isInvalidate()) {
@@ -813,7 +832,7 @@ LSQ::pushRequest(const DynInstPtr& inst, bool isLoad, uint8_t *data,
             inst->effAddrValid(true);
 
             if (cpu->checker) {
-                inst->reqToVerify = std::make_shared<Request>(*request->req());
+                inst->reqToVerify = makeRequest(*request->req());
             }
             Fault fault;
             if (isLoad)
@@ -844,6 +863,9 @@ void
 LSQ::SingleDataRequest::finish(const Fault &fault, const RequestPtr &request,
         gem5::ThreadContext* tc, BaseMMU::Mode mode)
 {
+    // The CPU may have gone to sleep while the translation was pending.
+    _inst->cpu->wakeFromMemStall();
+
     _fault.push_back(fault);
     numInTranslationFragments = 0;
     numTranslatedFragments = 1;
@@ -876,6 +898,9 @@ void
 LSQ::SplitDataRequest::finish(const Fault &fault, const RequestPtr &req,
         gem5::ThreadContext* tc, BaseMMU::Mode mode)
 {
+    // The CPU may have gone to sleep while the translation was pending.
+    _inst->cpu->wakeFromMemStall();
+
     int i;
     for (i = 0; i < _reqs.size() && _reqs[i] != req; i++);
     assert(i < _reqs.size());
@@ -887,6 +912,8 @@ LSQ::SplitDataRequest::finish(const Fault &fault, const RequestPtr &req,
     if (fault == NoFault)
         _mainReq->setFlags(req->getFlags());
 
+    finishFollowers(i, fault);
+
     if (numTranslatedFragments == _reqs.size()) {
         if (_inst->isSquashed()) {
             squashTranslation();
@@ -920,6 +947,24 @@ LSQ::SplitDataRequest::finish(const Fault &fault, const RequestPtr &req,
     }
 }
 
+void
+LSQ::SplitDataRequest::finishFollowers(uint32_t i, const Fault &fault)
+{
+    const RequestPtr &lead = _reqs[i];
+    for (uint32_t j = i + 1; j < _reqs.size() &&
+            _translationLeader[j] == i; j++) {
+        _fault[j] = fault;
+        numTranslatedFragments++;
+        if (fault != NoFault)
+            continue;
+        const RequestPtr &r = _reqs[j];
+        r->setPaddr(lead->getPaddr() + (r->getVaddr() - lead->getVaddr()));
+        r->setFlags(lead->getFlags());
+        DPRINTF(LSQ, "Fragment %d shares the translation of fragment %d: "
+                "%#x -> %#x\n", j, i, r->getVaddr(), r->getPaddr());
+    }
+}
+
 void
 LSQ::SingleDataRequest::initiateTranslation()
 {
@@ -962,7 +1007,7 @@ LSQ::SplitDataRequest::initiateTranslation()
     Addr final_addr = addrBlockAlign(_addr + _size, cacheLineSize);
     uint32_t size_so_far = 0;
 
-    _mainReq = std::make_shared<Request>(base_addr,
+    _mainReq = makeRequest(base_addr,
                 _size, _flags, _inst->requestorId(),
                 _inst->pcState().instAddr(), _inst->contextId());
     _mainReq->setByteEnable(_byteEnable);
@@ -1014,8 +1059,24 @@ LSQ::SplitDataRequest::initiateTranslation()
         numTranslatedFragments = 0;
         _fault.resize(_reqs.size());
 
+        // Fragments in the same aligned block as an earlier fragment
+        // share its translation rather than each probing the MMU.
+        const Addr fuse_bytes = _port.fusedTranslationBytes();
+        _translationLeader.resize(_reqs.size());
+        for (uint32_t i = 0; i < _reqs.size(); i++) {
+            _translationLeader[i] = i;
+            if (fuse_bytes && i > 0) {
+                const uint32_t lead = _translationLeader[i - 1];
+                if (roundDown(_reqs[lead]->getVaddr(), fuse_bytes) ==
+                    roundDown(_reqs[i]->getVaddr(), fuse_bytes)) {
+                    _translationLeader[i] = lead;
+                }
+            }
+        }
+
         for (uint32_t i = 0; i < _reqs.size(); i++) {
-            sendFragmentToTranslation(i);
+            if (_translationLeader[i] == i)
+                sendFragmentToTranslation(i);
         }
     } else {
         _inst->setMemAccPredicate(false);
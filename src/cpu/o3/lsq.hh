@@ -648,6 +648,12 @@ class LSQ
         uint32_t numReceivedPackets;
         RequestPtr _mainReq;
         PacketPtr _mainPacket;
+        /** For each fragment, the index of the fragment whose translation
+         * it reuses (itself if it is translated on its own). */
+        std::vector<uint32_t> _translationLeader;
+
+        /** Complete the fragments that share fragment i's translation. */
+        void finishFollowers(uint32_t i, const Fault &fault);
 
       public:
         SplitDataRequest(LSQUnit* port, const DynInstPtr& inst,
@@ -910,6 +916,9 @@ class LSQ
     /** The IEW stage pointer. */
     IEW *iewStage;
 
+    /** Granularity at which split accesses share a translation. */
+    unsigned fusedTranslationBytes() const { return _fusedTranslationBytes; }
+
     /** Is D-cache blocked? */
     bool cacheBlocked() const;
     /** Set D-cache blocked status */
@@ -921,11 +930,19 @@ class LSQ
 
     RequestPort &getDataPort() { return dcachePort; }
 
+    /** Are any accesses waiting for a response from the D-cache? */
+    bool hasOutstandingAccesses() const { return outstandingAccesses; }
+
+    /** An access was sent to the D-cache. */
+    void accessSent() { outstandingAccesses++; }
+
     void sendRetryResp();
 
   protected:
     /** D-cache is blocked */
     bool _cacheBlocked;
+    /** Number of accesses sent to the D-cache and not yet replied to. */
+    int outstandingAccesses;
     /** The number of cache ports available each cycle (stores only). */
     int cacheStorePorts;
     /** The number of used cache ports in this cycle by stores. */
@@ -989,6 +1006,10 @@ class LSQ
     /** Number of Threads. */
     ThreadID numThreads;
 
+    /** Fragments of a split access within one aligned block of this
+     * size are translated once, 0 disables the fusion. */
+    const unsigned _fusedTranslationBytes;
+
     /** Enable load receive response throttling in the LSQ. */
     const bool recvRespThrottling;
     const unsigned recvRespMaxCachelines;
@@ -218,6 +218,9 @@ LSQUnit::init(CPU *cpu_ptr, IEW *iew_ptr, const BaseO3CPUParams &params,
     checkLoads = params.LSQCheckLoads;
     needsTSO = params.needsTSO;
 
+    storeFilter.init(depCheckShift);
+    loadFilter.init(depCheckShift);
+
     resetState();
 }
 
@@ -514,6 +517,13 @@ Fault
 LSQUnit::checkViolations(typename LoadQueue::iterator& loadIt,
         const DynInstPtr& inst)
 {
+    // No load in the LQ touches the granules of this access, so the walk
+    // below cannot find a conflict.
+    if (!loadFilter.mayOverlap(inst->effAddr, inst->effSize)) {
+        loadIt = loadQueue.end();
+        return NoFault;
+    }
+
     Addr inst_eff_addr1 = inst->effAddr >> depCheckShift;
     Addr inst_eff_addr2 = (inst->effAddr + inst->effSize - 1) >> depCheckShift;
 
@@ -1227,6 +1237,7 @@ LSQUnit::trySendPacket(bool isLoad, PacketPtr data_pkt)
             isStoreBlocked = false;
         }
         lsq->cachePortBusy(isLoad);
+        lsq->accessSent();
         request->packetSent();
     } else {
         if (cache_got_blocked) {
@@ -1322,6 +1333,12 @@ LSQUnit::cacheLineSize()
     return cpu->cacheLineSize();
 }
 
+unsigned int
+LSQUnit::fusedTranslationBytes() const
+{
+    return lsq->fusedTranslationBytes();
+}
+
 Fault
 LSQUnit::read(LSQRequest *request, ssize_t load_idx)
 {
@@ -1331,6 +1348,8 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
     load_entry.setRequest(request);
     assert(load_inst);
 
+    load_entry.index(loadFilter, load_inst->effAddr, load_inst->effSize);
+
     assert(!load_inst->isExecuted());
 
     // Make sure this isn't a strictly ordered load
@@ -1394,6 +1413,13 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
     // Check the SQ for any previous stores that might lead to forwarding
     auto store_it = load_inst->sqIt;
     assert (store_it >= storeWBIt);
+    // A store can only forward to, or block, a load it overlaps. When no
+    // store data in the SQ touches the load's granules skip the walk.
+    if (request->mainReq()->getSize() != 0 &&
+        !storeFilter.mayOverlap(request->mainReq()->getVaddr(),
+                                request->mainReq()->getSize())) {
+        store_it = storeWBIt;
+    }
     // End once we've reached the top of the LSQ
     while (store_it != storeWBIt && !load_inst->isDataPrefetch()) {
         // Move the index to one younger
@@ -1630,6 +1656,10 @@ LSQUnit::write(LSQRequest *request, uint8_t *data, ssize_t store_idx)
     storeQueue[store_idx].setRequest(request);
     unsigned size = request->_size;
     storeQueue[store_idx].size() = size;
+    if (size != 0) {
+        storeQueue[store_idx].index(storeFilter,
+                storeQueue[store_idx].instruction()->effAddr, size);
+    }
     bool store_no_data =
         request->mainReq()->getFlags() & Request::STORE_NO_DATA;
     storeQueue[store_idx].isAllZeros() = store_no_data;
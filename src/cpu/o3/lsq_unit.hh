@@ -43,6 +43,8 @@
 #define __CPU_O3_LSQ_UNIT_HH__
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstring>
 #include <map>
 #include <memory>
@@ -92,6 +94,89 @@ class LSQUnit
 
     using LSQRequest = LSQ::LSQRequest;
   private:
+    /**
+     * Counting filter over the address granules touched by the entries
+     * of one queue. Each granule (1 << depCheckShift bytes) maps to a
+     * counter; a zero counter proves that no indexed entry touches any
+     * granule hashing to it, which lets the forwarding and violation
+     * scans skip the queue walk for the common, non-aliasing case. A
+     * non-zero counter only means the walk has to be done as before.
+     */
+    class AddrFilter
+    {
+      public:
+        static constexpr unsigned NumBuckets = 1024;
+
+      private:
+        std::array<uint16_t, NumBuckets> counts{};
+        unsigned granuleShift = 0;
+
+      public:
+        void
+        init(unsigned granule_shift)
+        {
+            granuleShift = granule_shift;
+            counts.fill(0);
+        }
+
+        /**
+         * Granules touched by [addr, addr + size). A zero sized access
+         * is treated as touching the granules of addr - 1 and addr,
+         * matching the bounds checkViolations() computes for it.
+         */
+        void
+        granules(Addr addr, uint32_t size, Addr &first, Addr &last) const
+        {
+            first = (size ? addr : addr - 1) >> granuleShift;
+            last = (addr + (size ? size - 1 : 0)) >> granuleShift;
+        }
+
+        void
+        add(Addr first, Addr last)
+        {
+            update(first, last, 1);
+        }
+
+        void
+        remove(Addr first, Addr last)
+        {
+            update(first, last, -1);
+        }
+
+        bool
+        mayOverlap(Addr addr, uint32_t size) const
+        {
+            Addr first, last;
+            granules(addr, size, first, last);
+            if (spansAll(first, last))
+                return true;
+            for (Addr g = first; g != last + 1; g++) {
+                if (counts[g % NumBuckets])
+                    return true;
+            }
+            return false;
+        }
+
+      private:
+        static bool
+        spansAll(Addr first, Addr last)
+        {
+            return last < first || last - first >= NumBuckets - 1;
+        }
+
+        void
+        update(Addr first, Addr last, int delta)
+        {
+            if (spansAll(first, last)) {
+                for (auto &count : counts)
+                    count += delta;
+            } else {
+                for (Addr g = first; g != last + 1; g++)
+                    counts[g % NumBuckets] += delta;
+            }
+        }
+    };
+
     class LSQEntry
     {
       private:
@@ -103,6 +188,11 @@ class LSQUnit
         uint32_t _size = 0;
         /** Valid entry. */
         bool _valid = false;
+        /** Filter this entry is indexed in, if any. */
+        AddrFilter *_filter = nullptr;
+        /** Granules this entry was indexed under. */
+        Addr _filterFirst = 0;
+        Addr _filterLast = 0;
 
       public:
         ~LSQEntry()
@@ -116,6 +206,7 @@ class LSQUnit
         void
         clear()
         {
+            unindex();
             _inst = nullptr;
             if (_request != nullptr) {
                 _request->freeLSQEntry();
@@ -134,6 +225,25 @@ class LSQUnit
             _size = 0;
         }
 
+        /** Index the entry in a filter, replacing any earlier key. */
+        void
+        index(AddrFilter &filter, Addr addr, uint32_t size)
+        {
+            unindex();
+            _filter = &filter;
+            filter.granules(addr, size, _filterFirst, _filterLast);
+            filter.add(_filterFirst, _filterLast);
+        }
+
+        void
+        unindex()
+        {
+            if (_filter) {
+                _filter->remove(_filterFirst, _filterLast);
+                _filter = nullptr;
+            }
+        }
+
         LSQRequest* request() { return _request; }
         void setRequest(LSQRequest* r) { _request = r; }
         bool hasRequest() { return _request != nullptr; }
@@ -362,6 +472,9 @@ class LSQUnit
     void recvRetry();
 
     unsigned int cacheLineSize();
+
+    /** Granularity at which split accesses share a translation. */
+    unsigned int fusedTranslationBytes() const;
   private:
     /** Reset the LSQ state */
     void resetState();
@@ -452,6 +565,12 @@ class LSQUnit
     LoadQueue loadQueue;
 
   private:
+    /** Granules touched by stores in the SQ with their data written. */
+    AddrFilter storeFilter;
+
+    /** Granules touched by loads in the LQ with a valid address. */
+    AddrFilter loadFilter;
+
     /** The number of places to shift addresses in the LSQ before checking
      * for dependency violations
      */
@@ -0,0 +1,182 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/mem_dep_pred.hh"
+
+#include <algorithm>
+
+#include "base/cprintf.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/MemDepPred.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+StoreDistancePredictorBase::StoreDistancePredictorBase(
+        std::string_view name, uint64_t clear_period, unsigned table_size,
+        unsigned window)
+    : MemDepPredictor(name), tableSize(table_size), window(window),
+      clearPeriod(clear_period)
+{
+    fatal_if(!isPowerOf2(tableSize),
+             "%s: memory dependence table size %u is not a power of 2",
+             name, tableSize);
+    fatal_if(window == 0 || window > MaxWindow,
+             "%s: store window must be between 1 and %u stores",
+             name, MaxWindow);
+}
+
+void
+StoreDistancePredictorBase::violation(Addr store_PC, InstSeqNum store_seq_num,
+                                      Addr load_PC, InstSeqNum load_seq_num)
+{
+    // Count the stores between the violating store and the load, skipping
+    // any dispatched after the load.
+    unsigned distance = 0;
+    for (auto seq_num : storeHistory) {
+        if (seq_num > load_seq_num)
+            continue;
+        if (seq_num == store_seq_num) {
+            DPRINTF(MemDepPred, "Load %#x depends on store %#x at "
+                    "distance %u\n", load_PC, store_PC, distance);
+            train(index(load_PC), distance);
+            return;
+        }
+        distance++;
+    }
+
+    DPRINTF(MemDepPred, "Store [sn:%llu] of load %#x is beyond the "
+            "store window\n", store_seq_num, load_PC);
+}
+
+void
+StoreDistancePredictorBase::insertStore(Addr store_PC,
+        InstSeqNum store_seq_num, ThreadID tid)
+{
+    if (++memOpsPred > clearPeriod) {
+        DPRINTF(MemDepPred, "Wiping predictor state because %d stores "
+                "were inserted\n", clearPeriod);
+        memOpsPred = 0;
+        clearTable();
+    }
+
+    storeHistory.push_front(store_seq_num);
+    if (storeHistory.size() > window)
+        storeHistory.pop_back();
+}
+
+void
+StoreDistancePredictorBase::checkInst(Addr PC, bool is_load,
+                                      std::vector<InstSeqNum> &producers)
+{
+    // Only loads are predicted; stores are kept in order by the LSQ.
+    if (!is_load)
+        return;
+
+    uint64_t mask = predicted(index(PC));
+    for (unsigned distance = 0; mask && distance < storeHistory.size();
+            distance++, mask >>= 1) {
+        if (mask & 1) {
+            DPRINTF(MemDepPred, "Load %#x depends on [sn:%llu] at "
+                    "distance %u\n", PC, storeHistory[distance], distance);
+            producers.push_back(storeHistory[distance]);
+        }
+    }
+}
+
+void
+StoreDistancePredictorBase::squash(InstSeqNum squashed_num, ThreadID tid)
+{
+    while (!storeHistory.empty() && storeHistory.front() > squashed_num)
+        storeHistory.pop_front();
+}
+
+void
+StoreDistancePredictorBase::clear()
+{
+    storeHistory.clear();
+    memOpsPred = 0;
+    clearTable();
+}
+
+void
+StoreDistancePredictorBase::dump()
+{
+    cprintf("storeHistory.size(): %i\n", storeHistory.size());
+    for (unsigned distance = 0; distance < storeHistory.size(); distance++)
+        cprintf("%i: [sn:%lli]\n", distance, storeHistory[distance]);
+}
+
+StoreVector::StoreVector(std::string_view name, uint64_t clear_period,
+                         unsigned table_size, unsigned window)
+    : StoreDistancePredictorBase(name, clear_period, table_size, window),
+      vectors(table_size, 0)
+{
+}
+
+void
+StoreVector::train(unsigned idx, unsigned distance)
+{
+    vectors[idx] |= 1ULL << distance;
+}
+
+void
+StoreVector::clearTable()
+{
+    std::fill(vectors.begin(), vectors.end(), 0);
+}
+
+StoreDistance::StoreDistance(std::string_view name, uint64_t clear_period,
+                             unsigned table_size, unsigned window)
+    : StoreDistancePredictorBase(name, clear_period, table_size, window),
+      distances(table_size, 0)
+{
+}
+
+void
+StoreDistance::train(unsigned idx, unsigned distance)
+{
+    distances[idx] = distance + 1;
+}
+
+uint64_t
+StoreDistance::predicted(unsigned idx) const
+{
+    return distances[idx] ? 1ULL << (distances[idx] - 1) : 0;
+}
+
+void
+StoreDistance::clearTable()
+{
+    std::fill(distances.begin(), distances.end(), 0);
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,195 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_MEM_DEP_PRED_HH__
+#define __CPU_O3_MEM_DEP_PRED_HH__
+
+#include <cstdint>
+#include <deque>
+#include <string_view>
+#include <vector>
+
+#include "base/named.hh"
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Interface of the memory dependence predictors the MemDepUnit can use to
+ * decide which older stores a memory instruction has to wait for.
+ */
+class MemDepPredictor : public Named
+{
+  public:
+    MemDepPredictor(std::string_view name) : Named(name) {}
+    virtual ~MemDepPredictor() = default;
+
+    /** Records a memory ordering violation between the younger load
+     * and the older store. */
+    virtual void violation(Addr store_PC, InstSeqNum store_seq_num,
+                           Addr load_PC, InstSeqNum load_seq_num) = 0;
+
+    /** Inserts a load into the predictor. */
+    virtual void insertLoad(Addr load_PC, InstSeqNum load_seq_num) = 0;
+
+    /** Inserts a store into the predictor. Stores are inserted in
+     * program order as they are dispatched. */
+    virtual void insertStore(Addr store_PC, InstSeqNum store_seq_num,
+                             ThreadID tid) = 0;
+
+    /** Appends the sequence numbers of the stores the instruction with
+     * the given PC is predicted to depend upon to producers. */
+    virtual void checkInst(Addr PC, bool is_load,
+                           std::vector<InstSeqNum> &producers) = 0;
+
+    /** Records this PC/sequence number as issued. */
+    virtual void issued(Addr issued_PC, InstSeqNum issued_seq_num,
+                        bool is_store) = 0;
+
+    /** Squashes for a specific thread until the given sequence number. */
+    virtual void squash(InstSeqNum squashed_num, ThreadID tid) = 0;
+
+    /** Resets all tables. */
+    virtual void clear() = 0;
+
+    /** Debug function to dump the predictor state. */
+    virtual void dump() = 0;
+};
+
+/**
+ * Base of the predictors that name producers by their distance from the
+ * load, i.e. the number of stores dispatched between the producer and the
+ * load. It keeps the most recently dispatched stores and a direct mapped,
+ * untagged table indexed by load PC; subclasses decide what an entry of
+ * that table holds.
+ */
+class StoreDistancePredictorBase : public MemDepPredictor
+{
+  public:
+    static constexpr unsigned MaxWindow = 64;
+
+    StoreDistancePredictorBase(std::string_view name, uint64_t clear_period,
+                               unsigned table_size, unsigned window);
+
+    void violation(Addr store_PC, InstSeqNum store_seq_num,
+                   Addr load_PC, InstSeqNum load_seq_num) override;
+    void insertLoad(Addr load_PC, InstSeqNum load_seq_num) override {}
+    void insertStore(Addr store_PC, InstSeqNum store_seq_num,
+                     ThreadID tid) override;
+    void checkInst(Addr PC, bool is_load,
+                   std::vector<InstSeqNum> &producers) override;
+    void issued(Addr issued_PC, InstSeqNum issued_seq_num,
+                bool is_store) override {}
+    void squash(InstSeqNum squashed_num, ThreadID tid) override;
+    void clear() override;
+    void dump() override;
+
+  protected:
+    /** Records that the load in the given entry depended on the store
+     * distance stores before it. */
+    virtual void train(unsigned idx, unsigned distance) = 0;
+
+    /** @return Mask of the store distances predicted for an entry. */
+    virtual uint64_t predicted(unsigned idx) const = 0;
+
+    /** Invalidates all table entries. */
+    virtual void clearTable() = 0;
+
+    const unsigned tableSize;
+
+  private:
+    unsigned
+    index(Addr PC) const
+    {
+        return (PC ^ (PC >> 10)) & (tableSize - 1);
+    }
+
+    /** Sequence numbers of the most recently dispatched stores, youngest
+     * first. */
+    std::deque<InstSeqNum> storeHistory;
+
+    /** Number of stores the history holds. */
+    const unsigned window;
+
+    /** Number of stores to insert before wiping the table. */
+    const uint64_t clearPeriod;
+
+    /** Number of stores inserted since the last clear. */
+    uint64_t memOpsPred = 0;
+};
+
+/**
+ * Store vector predictor, after "Store Vectors for Scalable Memory
+ * Dependence Prediction and Scheduling" by Subramaniam and Loh. Each load
+ * PC has a bit vector over the window of older stores; a load waits for
+ * every store at a distance it has ever conflicted with.
+ */
+class StoreVector : public StoreDistancePredictorBase
+{
+  public:
+    StoreVector(std::string_view name, uint64_t clear_period,
+                unsigned table_size, unsigned window);
+
+  protected:
+    void train(unsigned idx, unsigned distance) override;
+    uint64_t predicted(unsigned idx) const override { return vectors[idx]; }
+    void clearTable() override;
+
+  private:
+    std::vector<uint64_t> vectors;
+};
+
+/**
+ * Store distance predictor, as used by NoSQ ("NoSQ: Store-Load
+ * Communication without a Store Queue" by Sha, Martin and Roth). Each load
+ * PC remembers the distance of the store it last conflicted with and only
+ * waits for the store at that distance.
+ */
+class StoreDistance : public StoreDistancePredictorBase
+{
+  public:
+    StoreDistance(std::string_view name, uint64_t clear_period,
+                  unsigned table_size, unsigned window);
+
+  protected:
+    void train(unsigned idx, unsigned distance) override;
+    uint64_t predicted(unsigned idx) const override;
+    void clearTable() override;
+
+  private:
+    /** Distance plus one of the last conflicting store, 0 if none. */
+    std::vector<uint8_t> distances;
+};
+
+} // namespace o3
+
+} // namespace gem5
+
+#endif // __CPU_O3_MEM_DEP_PRED_HH__
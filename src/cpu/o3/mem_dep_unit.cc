@@ -36,7 +36,9 @@
 #include "cpu/o3/inst_queue.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/mem_dep_unit.hh"
+#include "cpu/o3/store_set.hh"
 #include "debug/MemDepUnit.hh"
+#include "enums/MemDepPredictorType.hh"
 #include "params/BaseO3CPU.hh"
 
 namespace gem5
@@ -51,13 +53,38 @@ int MemDepUnit::MemDepEntry::memdep_insert = 0;
 int MemDepUnit::MemDepEntry::memdep_erase = 0;
 #endif
 
+namespace
+{
+
+MemDepPredictor *
+makeDepPredictor(const std::string &name, const BaseO3CPUParams &params)
+{
+    switch (params.memDepPredictor) {
+      case MemDepPredictorType::StoreSet:
+        return new StoreSet(name + ".storesets",
+                params.store_set_clear_period, params.SSITSize,
+                params.SSITAssoc, params.SSITReplPolicy,
+                params.SSITIndexingPolicy, params.LFSTSize);
+      case MemDepPredictorType::StoreVector:
+        return new StoreVector(name + ".storevector",
+                params.store_set_clear_period, params.memDepTableSize,
+                params.memDepStoreWindow);
+      case MemDepPredictorType::StoreDistance:
+        return new StoreDistance(name + ".storedistance",
+                params.store_set_clear_period, params.memDepTableSize,
+                params.memDepStoreWindow);
+      default:
+        panic("Unknown memory dependence predictor.");
+    }
+}
+
+} // anonymous namespace
+
 MemDepUnit::MemDepUnit() : iqPtr(NULL), stats(nullptr) {}
 
 MemDepUnit::MemDepUnit(const BaseO3CPUParams &params)
     : _name(params.name + ".memdepunit"),
-      depPred(_name + ".storesets", params.store_set_clear_period,
-              params.SSITSize, params.SSITAssoc, params.SSITReplPolicy,
-              params.SSITIndexingPolicy, params.LFSTSize),
+      depPred(makeDepPredictor(_name, params)),
       iqPtr(NULL),
       stats(nullptr)
 {
@@ -97,9 +124,7 @@ MemDepUnit::init(const BaseO3CPUParams &params, ThreadID tid, CPU *cpu)
 
     id = tid;
 
-    depPred.init(params.store_set_clear_period,
-                 params.SSITSize, params.SSITAssoc, params.SSITReplPolicy,
-                 params.SSITIndexingPolicy, params.LFSTSize);
+    depPred.reset(makeDepPredictor(_name, params));
 
     std::string stats_group_name = csprintf("MemDepUnit__%i", tid);
     cpu->addStatGroup(stats_group_name.c_str(), &stats);
@@ -147,7 +172,7 @@ MemDepUnit::takeOverFrom()
     // Be sure to reset all state.
     loadBarrierSNs.clear();
     storeBarrierSNs.clear();
-    depPred.clear();
+    depPred->clear();
 }
 
 void
@@ -222,9 +247,8 @@ MemDepUnit::insert(const DynInstPtr &inst)
                                 std::begin(storeBarrierSNs),
                                 std::end(storeBarrierSNs));
     } else {
-        InstSeqNum dep = depPred.checkInst(inst->pcState().instAddr());
-        if (dep != 0)
-            producing_stores.push_back(dep);
+        depPred->checkInst(inst->pcState().instAddr(), inst->isLoad(),
+                producing_stores);
     }
 
     std::vector<MemDepEntryPtr> store_entries;
@@ -288,7 +312,7 @@ MemDepUnit::insert(const DynInstPtr &inst)
         DPRINTF(MemDepUnit, "Inserting store/atomic PC %s [sn:%lli].\n",
                 inst->pcState(), inst->seqNum);
 
-        depPred.insertStore(inst->pcState().instAddr(), inst->seqNum,
+        depPred->insertStore(inst->pcState().instAddr(), inst->seqNum,
                 inst->threadNumber);
 
         ++stats.insertedStores;
@@ -310,7 +334,7 @@ MemDepUnit::insertNonSpec(const DynInstPtr &inst)
         DPRINTF(MemDepUnit, "Inserting store/atomic PC %s [sn:%lli].\n",
                 inst->pcState(), inst->seqNum);
 
-        depPred.insertStore(inst->pcState().instAddr(), inst->seqNum,
+        depPred->insertStore(inst->pcState().instAddr(), inst->seqNum,
                 inst->threadNumber);
 
         ++stats.insertedStores;
@@ -566,7 +590,7 @@ MemDepUnit::squash(const InstSeqNum &squashed_num, ThreadID tid)
     }
 
     // Tell the dependency predictor to squash as well.
-    depPred.squash(squashed_num, tid);
+    depPred->squash(squashed_num, tid);
 }
 
 void
@@ -577,8 +601,8 @@ MemDepUnit::violation(const DynInstPtr &store_inst,
             " load: %#x, store: %#x\n", violating_load->pcState().instAddr(),
             store_inst->pcState().instAddr());
     // Tell the memory dependence unit of the violation.
-    depPred.violation(store_inst->pcState().instAddr(),
-            violating_load->pcState().instAddr());
+    depPred->violation(store_inst->pcState().instAddr(), store_inst->seqNum,
+            violating_load->pcState().instAddr(), violating_load->seqNum);
 }
 
 void
@@ -587,7 +611,8 @@ MemDepUnit::issue(const DynInstPtr &inst)
     DPRINTF(MemDepUnit, "Issuing instruction PC %#x [sn:%lli].\n",
             inst->pcState().instAddr(), inst->seqNum);
 
-    depPred.issued(inst->pcState().instAddr(), inst->seqNum, inst->isStore());
+    depPred->issued(inst->pcState().instAddr(), inst->seqNum,
+            inst->isStore());
 }
 
 MemDepUnit::MemDepEntryPtr &
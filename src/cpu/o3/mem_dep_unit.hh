@@ -51,7 +51,7 @@
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/limits.hh"
-#include "cpu/o3/store_set.hh"
+#include "cpu/o3/mem_dep_pred.hh"
 #include "debug/MemDepUnit.hh"
 
 namespace gem5
@@ -239,9 +239,9 @@ class MemDepUnit
     /** The memory dependence predictor.  It is accessed upon new
      *  instructions being added to the IQ, and responds by telling
      *  this unit what instruction the newly added instruction is dependent
-     *  upon.
+     *  upon. Selected by the memDepPredictor parameter.
      */
-    StoreSet depPred;
+    std::unique_ptr<MemDepPredictor> depPred;
 
     /** Sequence numbers of outstanding load barriers. */
     std::unordered_set<InstSeqNum> loadBarrierSNs;
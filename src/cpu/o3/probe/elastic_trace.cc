@@ -37,6 +37,8 @@
 
 #include "cpu/o3/probe/elastic_trace.hh"
 
+#include <algorithm>
+
 #include "base/callback.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
@@ -55,7 +57,9 @@ ElasticTrace::ElasticTrace(const ElasticTraceParams &params)
     :  ProbeListenerObject(params),
        regEtraceListenersEvent([this]{ regEtraceListeners(); }, name()),
        firstWin(true),
+       tempStoreBase(0),
        lastClearedSeqNum(0),
+       physRegDepMapSize(0),
        depWindowSize(params.depWindowSize),
        dataTraceStream(nullptr),
        instTraceStream(nullptr),
@@ -187,16 +191,9 @@ ElasticTrace::recordExecTick(const DynInstConstPtr& dyn_inst)
     // instruction had a register dependency recorded in the rename probe
     // listener before entering execute stage or it will not exist and will
     // need to be created here.
-    InstExecInfo* exec_info_ptr;
-    auto itr_exec_info = tempStore.find(dyn_inst->seqNum);
-    if (itr_exec_info != tempStore.end()) {
-        exec_info_ptr = itr_exec_info->second;
-    } else {
-        exec_info_ptr = new InstExecInfo;
-        tempStore[dyn_inst->seqNum] = exec_info_ptr;
-    }
+    InstExecInfo &exec_info = addExecInfo(dyn_inst->seqNum);
 
-    exec_info_ptr->executeTick = curTick();
+    exec_info.executeTick = curTick();
     stats.maxTempStoreSize = std::max(tempStore.size(),
                                 (std::size_t)stats.maxTempStoreSize.value());
 }
@@ -208,8 +205,8 @@ ElasticTrace::recordToCommTick(const DynInstConstPtr& dyn_inst)
     // execution is far enough that we cannot gather info about its past like
     // the tick it started execution. Simply return until we see an instruction
     // that is found in the tempStore.
-    auto itr_exec_info = tempStore.find(dyn_inst->seqNum);
-    if (itr_exec_info == tempStore.end()) {
+    InstExecInfo* exec_info_ptr = findExecInfo(dyn_inst->seqNum);
+    if (!exec_info_ptr) {
         DPRINTFR(ElasticTrace, "recordToCommTick: [sn:%lli] Not in temp store,"
                     " skipping.\n", dyn_inst->seqNum);
         return;
@@ -217,7 +214,6 @@ ElasticTrace::recordToCommTick(const DynInstConstPtr& dyn_inst)
 
     DPRINTFR(ElasticTrace, "[sn:%lli] To Commit Tick = %i\n", dyn_inst->seqNum,
                 curTick());
-    InstExecInfo* exec_info_ptr = itr_exec_info->second;
     exec_info_ptr->toCommitTick = curTick();
 
 }
@@ -233,8 +229,9 @@ ElasticTrace::updateRegDep(const DynInstConstPtr& dyn_inst)
     // Since this is the first probe activated in the pipeline, create
     // a new execution info object to track this instruction as it
     // progresses through the pipeline.
-    InstExecInfo* exec_info_ptr = new InstExecInfo;
-    tempStore[seq_num] = exec_info_ptr;
+    InstExecInfo* exec_info_ptr = &addExecInfo(seq_num);
+    *exec_info_ptr = InstExecInfo();
+    exec_info_ptr->valid = true;
 
     // Loop through the source registers and look up the dependency map. If
     // the source register entry is found in the dependency map, add a
@@ -249,9 +246,10 @@ ElasticTrace::updateRegDep(const DynInstConstPtr& dyn_inst)
             DPRINTFR(ElasticTrace, "[sn:%lli] Check map for src reg"
                      " %i (%s)\n", seq_num,
                      phys_src_reg->flatIndex(), phys_src_reg->className());
-            auto itr_writer = physRegDepMap.find(phys_src_reg->flatIndex());
-            if (itr_writer != physRegDepMap.end()) {
-                InstSeqNum last_writer = itr_writer->second;
+            const RegIndex src_idx_flat = phys_src_reg->flatIndex();
+            InstSeqNum last_writer = src_idx_flat < physRegDepMap.size() ?
+                physRegDepMap[src_idx_flat] : 0;
+            if (last_writer) {
                 // Additionally the dependency distance is kept less than the
                 // window size parameter to limit the memory allocation to
                 // nodes in the graph. If the window were tending to infinite
@@ -259,7 +257,11 @@ ElasticTrace::updateRegDep(const DynInstConstPtr& dyn_inst)
                 // replay.
                 if (seq_num - last_writer < depWindowSize) {
                     // Record a physical register dependency.
-                    exec_info_ptr->physRegDepSet.insert(last_writer);
+                    auto &deps = exec_info_ptr->physRegDepSet;
+                    auto pos = std::lower_bound(deps.begin(), deps.end(),
+                                                last_writer);
+                    if (pos == deps.end() || *pos != last_writer)
+                        deps.insert(pos, last_writer);
                 }
             }
 
@@ -282,10 +284,15 @@ ElasticTrace::updateRegDep(const DynInstConstPtr& dyn_inst)
             DPRINTFR(ElasticTrace, "[sn:%lli] Update map for dest reg"
                      " %i (%s)\n", seq_num, phys_dest_reg->flatIndex(),
                      dest_reg.className());
-            physRegDepMap[phys_dest_reg->flatIndex()] = seq_num;
+            const RegIndex dest_idx_flat = phys_dest_reg->flatIndex();
+            if (dest_idx_flat >= physRegDepMap.size())
+                physRegDepMap.resize(dest_idx_flat + 1, 0);
+            if (!physRegDepMap[dest_idx_flat])
+                physRegDepMapSize++;
+            physRegDepMap[dest_idx_flat] = seq_num;
         }
     }
-    stats.maxPhysRegDepMapSize = std::max(physRegDepMap.size(),
+    stats.maxPhysRegDepMapSize = std::max(physRegDepMapSize,
                             (std::size_t)stats.maxPhysRegDepMapSize.value());
 }
 
@@ -294,9 +301,11 @@ ElasticTrace::removeRegDepMapEntry(const SeqNumRegPair &inst_reg_pair)
 {
     DPRINTFR(ElasticTrace, "Remove Map entry for Reg %i\n",
             inst_reg_pair.second);
-    auto itr_regdep_map = physRegDepMap.find(inst_reg_pair.second);
-    if (itr_regdep_map != physRegDepMap.end())
-        physRegDepMap.erase(itr_regdep_map);
+    const RegIndex reg = inst_reg_pair.second;
+    if (reg < physRegDepMap.size() && physRegDepMap[reg]) {
+        physRegDepMap[reg] = 0;
+        physRegDepMapSize--;
+    }
 }
 
 void
@@ -305,16 +314,14 @@ ElasticTrace::addSquashedInst(const DynInstConstPtr& head_inst)
     // If the squashed instruction was squashed before being processed by
     // execute stage then it will not be in the temporary store. In this case
     // do nothing and return.
-    auto itr_exec_info = tempStore.find(head_inst->seqNum);
-    if (itr_exec_info == tempStore.end())
+    InstExecInfo* exec_info_ptr = findExecInfo(head_inst->seqNum);
+    if (!exec_info_ptr)
         return;
 
     // If there is a squashed load for which a read request was
     // sent before it got squashed then add it to the trace.
     DPRINTFR(ElasticTrace, "Attempt to add squashed inst [sn:%lli]\n",
                 head_inst->seqNum);
-    // Get pointer to the execution info object corresponding to the inst.
-    InstExecInfo* exec_info_ptr = itr_exec_info->second;
     if (head_inst->isLoad() && exec_info_ptr->executeTick != MaxTick &&
         exec_info_ptr->toCommitTick != MaxTick &&
         head_inst->hasRequest() &&
@@ -340,15 +347,13 @@ ElasticTrace::addCommittedInst(const DynInstConstPtr& head_inst)
         // of execution is far enough that we cannot gather info about its past
         // like the tick it started execution. Simply return until we see an
         // instruction that is found in the tempStore.
-        auto itr_temp_store = tempStore.find(head_inst->seqNum);
-        if (itr_temp_store == tempStore.end()) {
+        InstExecInfo* exec_info_ptr = findExecInfo(head_inst->seqNum);
+        if (!exec_info_ptr) {
             DPRINTFR(ElasticTrace, "addCommittedInst: [sn:%lli] Not in temp "
                 "store, skipping.\n", head_inst->seqNum);
             return;
         }
 
-        // Get pointer to the execution info object corresponding to the inst.
-        InstExecInfo* exec_info_ptr = itr_temp_store->second;
         assert(exec_info_ptr->executeTick != MaxTick);
         assert(exec_info_ptr->toCommitTick != MaxTick);
 
@@ -439,7 +444,7 @@ ElasticTrace::addDepTraceRecord(const DynInstConstPtr& head_inst,
     }
 
     // Assign the register dependencies stored in the execution info object
-    std::set<InstSeqNum>::const_iterator dep_set_it;
+    std::vector<InstSeqNum>::const_iterator dep_set_it;
     for (dep_set_it = (exec_info_ptr->physRegDepSet).begin();
          dep_set_it != (exec_info_ptr->physRegDepSet).end();
          ++dep_set_it) {
@@ -654,22 +659,40 @@ ElasticTrace::clearTempStoreUntil(const DynInstConstPtr& head_inst)
     // Clear from temp store starting with the execution info object
     // corresponding the head_inst and continue clearing by decrementing the
     // sequence number until the last cleared sequence number.
-    InstSeqNum temp_sn = (head_inst->seqNum);
-    while (temp_sn > lastClearedSeqNum) {
-        auto itr_exec_info = tempStore.find(temp_sn);
-        if (itr_exec_info != tempStore.end()) {
-            InstExecInfo* exec_info_ptr = itr_exec_info->second;
-            // Free allocated memory for the info object
-            delete exec_info_ptr;
-            // Remove entry from temporary store
-            tempStore.erase(itr_exec_info);
-        }
-        temp_sn--;
+    while (!tempStore.empty() && tempStoreBase <= head_inst->seqNum) {
+        tempStore.pop_front();
+        tempStoreBase++;
     }
     // Update the last cleared sequence number to that of the head_inst
     lastClearedSeqNum = head_inst->seqNum;
 }
 
+ElasticTrace::InstExecInfo *
+ElasticTrace::findExecInfo(InstSeqNum seq_num)
+{
+    if (seq_num < tempStoreBase || seq_num - tempStoreBase >= tempStore.size())
+        return nullptr;
+    InstExecInfo &exec_info = tempStore[seq_num - tempStoreBase];
+    return exec_info.valid ? &exec_info : nullptr;
+}
+
+ElasticTrace::InstExecInfo &
+ElasticTrace::addExecInfo(InstSeqNum seq_num)
+{
+    if (tempStore.empty())
+        tempStoreBase = seq_num;
+    // Instructions which were renamed before tracing started may still
+    // execute after younger ones.
+    for (; seq_num < tempStoreBase; tempStoreBase--)
+        tempStore.emplace_front();
+    if (seq_num - tempStoreBase >= tempStore.size())
+        tempStore.resize(seq_num - tempStoreBase + 1);
+
+    InstExecInfo &exec_info = tempStore[seq_num - tempStoreBase];
+    exec_info.valid = true;
+    return exec_info;
+}
+
 void
 ElasticTrace::compDelayRob(TraceInfo* past_record, TraceInfo* new_record)
 {
@@ -838,20 +861,18 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
             if (temp_ptr->robDepList.empty()) {
                 DPRINTFR(ElasticTrace, "\thas no order (rob) dependencies\n");
             }
-            while (!temp_ptr->robDepList.empty()) {
+            for (InstSeqNum dep : temp_ptr->robDepList) {
                 DPRINTFR(ElasticTrace, "\thas order (rob) dependency on %lli\n",
-                         temp_ptr->robDepList.front());
-                dep_pkt.add_rob_dep(temp_ptr->robDepList.front());
-                temp_ptr->robDepList.pop_front();
+                         dep);
+                dep_pkt.add_rob_dep(dep);
             }
             if (temp_ptr->physRegDepList.empty()) {
                 DPRINTFR(ElasticTrace, "\thas no register dependencies\n");
             }
-            while (!temp_ptr->physRegDepList.empty()) {
+            for (InstSeqNum dep : temp_ptr->physRegDepList) {
                 DPRINTFR(ElasticTrace, "\thas register dependency on %lli\n",
-                         temp_ptr->physRegDepList.front());
-                dep_pkt.add_reg_dep(temp_ptr->physRegDepList.front());
-                temp_ptr->physRegDepList.pop_front();
+                         dep);
+                dep_pkt.add_reg_dep(dep);
             }
             if (num_filtered_nodes != 0) {
                 // Set the weight of this node as the no. of filtered nodes
@@ -46,9 +46,10 @@
 #ifndef __CPU_O3_PROBE_ELASTIC_TRACE_HH__
 #define __CPU_O3_PROBE_ELASTIC_TRACE_HH__
 
-#include <set>
+#include <deque>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
@@ -210,14 +211,19 @@ class ElasticTrace : public ProbeListenerObject
         /**
          * Set of instruction sequence numbers that this instruction depends on
          * due to Read After Write data dependency based on physical register.
+         * It is kept sorted, and only holds a few entries.
          */
-        std::set<InstSeqNum> physRegDepSet;
+        std::vector<InstSeqNum> physRegDepSet;
         /** @} */
 
+        /** If the object belongs to an instruction being tracked */
+        bool valid;
+
         /** Constructor */
         InstExecInfo()
           : executeTick(MaxTick),
-            toCommitTick(MaxTick)
+            toCommitTick(MaxTick),
+            valid(false)
         { }
     };
 
@@ -227,8 +233,25 @@ class ElasticTrace : public ProbeListenerObject
      * the output trace then this information is looked up using the instruction
      * sequence number as the key. If it is not chosen then the entry for it in
      * the store is cleared.
+     *
+     * The store is indexed by the sequence number relative to
+     * tempStoreBase. Instructions leave it in program order, so it only
+     * spans the instructions in flight and is resized at both ends.
      */
-    std::unordered_map<InstSeqNum, InstExecInfo*> tempStore;
+    std::deque<InstExecInfo> tempStore;
+
+    /** Sequence number of the first object in the temporary store */
+    InstSeqNum tempStoreBase;
+
+    /**
+     * Look up the execution info object of an instruction.
+     *
+     * @return The object, or nullptr if the instruction is not tracked.
+     */
+    InstExecInfo *findExecInfo(InstSeqNum seq_num);
+
+    /** Get the execution info object of an instruction, creating it */
+    InstExecInfo &addExecInfo(InstSeqNum seq_num);
 
     /**
      * The last cleared instruction sequence number used to free up the memory
@@ -238,10 +261,14 @@ class ElasticTrace : public ProbeListenerObject
 
     /**
      * Map for recording the producer of a physical register to check Read
-     * After Write dependencies. The key is the renamed physical register and
-     * the value is the instruction sequence number of its last producer.
+     * After Write dependencies. It is indexed by the flat index of the
+     * renamed physical register, and the value is the instruction sequence
+     * number of its last producer, or zero if there is none.
      */
-    std::unordered_map<RegIndex, InstSeqNum> physRegDepMap;
+    std::vector<InstSeqNum> physRegDepMap;
+
+    /** Number of physical registers with a producer in physRegDepMap */
+    size_t physRegDepMapSize;
 
     /**
      * @defgroup TraceInfo Struct for a record in the instruction dependency
@@ -272,9 +299,9 @@ class ElasticTrace : public ProbeListenerObject
         /* If instruction was committed, as against squashed. */
         bool commit;
         /* List of order dependencies. */
-        std::list<InstSeqNum> robDepList;
+        std::vector<InstSeqNum> robDepList;
         /* List of physical register RAW dependencies. */
-        std::list<InstSeqNum> physRegDepList;
+        std::vector<InstSeqNum> physRegDepList;
         /**
          * Computational delay after the last dependent inst. completed.
          * A value of -1 which means instruction has no dependencies.
@@ -46,6 +46,7 @@
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/dyn_inst.hh"
 #include "cpu/o3/limits.hh"
+#include "cpu/o3/value_pred.hh"
 #include "cpu/reg_class.hh"
 #include "debug/Activity.hh"
 #include "debug/O3PipeView.hh"
@@ -64,6 +65,8 @@ Rename::Rename(CPU *_cpu, const BaseO3CPUParams &params)
       decodeToRenameDelay(params.decodeToRenameDelay),
       commitToRenameDelay(params.commitToRenameDelay),
       renameWidth(params.renameWidth),
+      numRenameCheckpoints(params.numRenameCheckpoints),
+      valuePred(params.valuePredictor),
       numThreads(params.numThreads),
       stats(_cpu)
 {
@@ -85,6 +88,9 @@ Rename::Rename(CPU *_cpu, const BaseO3CPUParams &params)
         stalls[tid] = {false, false};
         serializeInst[tid] = nullptr;
         serializeOnNextInst[tid] = false;
+        checkpoints[tid].resize(numRenameCheckpoints);
+        checkpointHead[tid] = 0;
+        checkpointsUsed[tid] = 0;
     }
 }
 
@@ -140,6 +146,8 @@ Rename::RenameStats::RenameStats(statistics::Group *parent)
                "Number of HB maps that are committed"),
       ADD_STAT(undoneMaps, statistics::units::Count::get(),
                "Number of HB maps that are undone due to squashing"),
+      ADD_STAT(checkpointRecoveries, statistics::units::Count::get(),
+               "Number of squashes recovered from a rename map checkpoint"),
       ADD_STAT(serializing, statistics::units::Count::get(),
                "count of serializing insts renamed"),
       ADD_STAT(tempSerializing, statistics::units::Count::get(),
@@ -254,6 +262,8 @@ Rename::clearStates(ThreadID tid)
 
     serializeOnNextInst[tid] = false;
 
+    checkpointsUsed[tid] = 0;
+
     // Clear out any of this thread's instructions being sent to IEW.
     for (int i = -cpu->renameQueue.getPast();
          i <= cpu->renameQueue.getFuture(); ++i) {
@@ -299,6 +309,8 @@ Rename::resetStage()
         storesInProgress[tid] = 0;
 
         serializeOnNextInst[tid] = false;
+
+        checkpointsUsed[tid] = 0;
     }
 }
 
@@ -451,6 +463,10 @@ Rename::tick()
 
             removeFromHistory(fromCommit->commitInfo[tid].doneSeqNum,
                                   tid);
+            if (valuePred) {
+                valuePred->commitHistory(tid,
+                        fromCommit->commitInfo[tid].doneSeqNum);
+            }
         }
     }
 
@@ -729,6 +745,12 @@ Rename::renameInsts(ThreadID tid)
 
         renameDestRegs(inst, inst->threadNumber);
 
+        if (inst->isControl())
+            takeCheckpoint(inst, tid);
+
+        if (valuePred)
+            predictValue(inst, tid);
+
         if (inst->isAtomic() || inst->isStore()) {
             storesInProgress[tid]++;
         } else if (inst->isLoad()) {
@@ -919,6 +941,16 @@ Rename::unblock(ThreadID tid)
 void
 Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
 {
+    // Drop the checkpoints of squashed instructions. The youngest one
+    // left, if any, holds the map as it was at or before the squash point.
+    while (checkpointsUsed[tid] &&
+           checkpoint(tid, checkpointsUsed[tid] - 1).instSeqNum >
+               squashed_seq_num) {
+        checkpointsUsed[tid]--;
+    }
+    RenameCheckpoint *cp = checkpointsUsed[tid] ?
+        &checkpoint(tid, checkpointsUsed[tid] - 1) : nullptr;
+
     auto hb_it = historyBuffer[tid].begin();
 
     // After a syscall squashes everything, the history buffer may be empty
@@ -942,8 +974,10 @@ Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
         // don't want to put these on the free list.
         if (hb_it->newPhysReg != hb_it->prevPhysReg) {
             // Tell the rename map to set the architected register to the
-            // previous physical register that it was renamed to.
-            renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
+            // previous physical register that it was renamed to. With a
+            // checkpoint the whole map is restored below instead.
+            if (!cp)
+                renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
 
             // The phys regs can still be owned by squashing but
             // executing instructions in IEW at this moment. To avoid
@@ -962,6 +996,82 @@ Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
 
         ++stats.undoneMaps;
     }
+
+    if (cp) {
+        DPRINTF(Rename, "[tid:%i] Restoring the rename map checkpoint of "
+                "[sn:%llu].\n", tid, cp->instSeqNum);
+
+        *renameMap[tid] = cp->map;
+
+        // Redo, oldest first, the renames between the checkpoint and the
+        // squash point, which survive the squash.
+        auto replay_it = hb_it;
+        while (replay_it != historyBuffer[tid].end() &&
+               replay_it->instSeqNum > cp->instSeqNum) {
+            ++replay_it;
+        }
+        while (replay_it != hb_it) {
+            --replay_it;
+            if (replay_it->newPhysReg != replay_it->prevPhysReg) {
+                renameMap[tid]->setEntry(replay_it->archReg,
+                                         replay_it->newPhysReg);
+            }
+        }
+
+        ++stats.checkpointRecoveries;
+    }
+}
+
+void
+Rename::takeCheckpoint(const DynInstPtr &inst, ThreadID tid)
+{
+    if (checkpointsUsed[tid] == numRenameCheckpoints)
+        return;
+
+    RenameCheckpoint &cp = checkpoint(tid, checkpointsUsed[tid]++);
+    cp.instSeqNum = inst->seqNum;
+    cp.map = *renameMap[tid];
+}
+
+void
+Rename::predictValue(const DynInstPtr &inst, ThreadID tid)
+{
+    if (inst->isControl()) {
+        valuePred->updateHistory(tid, inst->seqNum, inst->readPredTaken());
+        return;
+    }
+
+    // Only plain loads writing a single integer register are predicted;
+    // anything executing at commit gains nothing from it.
+    if (!inst->isLoad() || inst->isAtomic() || inst->isNonSpeculative() ||
+        inst->isSerializing() || inst->numDestRegs() != 1 ||
+        inst->destRegIdx(0).classValue() != IntRegClass) {
+        return;
+    }
+
+    PhysRegIdPtr dest = inst->renamedDestIdx(0);
+    if (dest->isFixedMapping())
+        return;
+
+    const Addr pc = inst->pcState().instAddr();
+    const uint64_t hist = valuePred->getHistory(tid);
+    RegVal value;
+    bool use;
+
+    inst->vpLookedUp(true);
+    inst->vpHistory = hist;
+    if (valuePred->lookup(pc, hist, value, use)) {
+        inst->vpHit(true);
+        inst->predictedValue = value;
+        if (use) {
+            DPRINTF(Rename, "[tid:%i] [sn:%llu] Predicting value %#x for "
+                    "phys reg %i.\n", tid, inst->seqNum, value,
+                    dest->flatIndex());
+            inst->vpUsed(true);
+            cpu->setReg(dest, value, tid);
+            scoreboard->setReg(dest);
+        }
+    }
 }
 
 void
@@ -971,6 +1081,13 @@ Rename::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
             "history buffer %u (size=%i), until [sn:%llu].\n",
             tid, tid, historyBuffer[tid].size(), inst_seq_num);
 
+    // Checkpoints of committed instructions can no longer be squashed to.
+    while (checkpointsUsed[tid] &&
+           checkpoint(tid, 0).instSeqNum <= inst_seq_num) {
+        checkpointHead[tid] = (checkpointHead[tid] + 1) % numRenameCheckpoints;
+        checkpointsUsed[tid]--;
+    }
+
     auto hb_it = historyBuffer[tid].end();
 
     --hb_it;
@@ -1307,6 +1424,16 @@ Rename::checkSignalsAndUpdate(ThreadID tid)
 
         squash(fromCommit->commitInfo[tid].doneSeqNum, tid);
 
+        if (valuePred) {
+            // A mispredicted branch survives the squash with its actual
+            // direction.
+            const auto &info = fromCommit->commitInfo[tid];
+            const bool mispredicted = info.mispredictInst &&
+                info.mispredictInst->seqNum == info.doneSeqNum;
+            valuePred->squashHistory(tid, info.doneSeqNum, mispredicted,
+                                     info.branchTaken);
+        }
+
         return true;
     } else if (!fromCommit->commitInfo[tid].robSquashing &&
             !freeingInProgress[tid].empty()) {
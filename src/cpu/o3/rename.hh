@@ -63,6 +63,8 @@ struct BaseO3CPUParams;
 namespace o3
 {
 
+class ValuePredictor;
+
 /**
  * Rename handles both single threaded and SMT rename. Its
  * width is specified by the parameters; each cycle it tries to rename
@@ -248,6 +250,14 @@ class Rename
     /** Removes a committed instruction's rename history. */
     void removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid);
 
+    /** Checkpoints the rename map after a control instruction has been
+     * renamed, if a checkpoint is free. */
+    void takeCheckpoint(const DynInstPtr &inst, ThreadID tid);
+
+    /** Looks up the value predictor for a renamed instruction, writing a
+     * confident prediction to its destination and marking it ready. */
+    void predictValue(const DynInstPtr &inst, ThreadID tid);
+
     /** Renames the source registers of an instruction. */
     void renameSrcRegs(const DynInstPtr &inst, ThreadID tid);
 
@@ -320,6 +330,36 @@ class Rename
      */
     std::list<RenameHistory> historyBuffer[MaxThreads];
 
+    /** A copy of the rename map taken right after renaming a control
+     * instruction.
+     */
+    struct RenameCheckpoint
+    {
+        /** The sequence number of the instruction checkpointed. */
+        InstSeqNum instSeqNum = 0;
+        /** The rename map as it was after renaming that instruction. */
+        UnifiedRenameMap map;
+    };
+
+    /** Per-thread ring of numRenameCheckpoints checkpoints. The storage
+     * is kept across uses so that taking one only copies the map.
+     */
+    std::vector<RenameCheckpoint> checkpoints[MaxThreads];
+
+    /** Index of the oldest checkpoint in use, per thread. */
+    unsigned checkpointHead[MaxThreads];
+
+    /** Number of checkpoints in use, per thread. */
+    unsigned checkpointsUsed[MaxThreads];
+
+    /** The i-th oldest checkpoint in use of a thread. */
+    RenameCheckpoint &
+    checkpoint(ThreadID tid, unsigned i)
+    {
+        return checkpoints[tid][(checkpointHead[tid] + i) %
+                                numRenameCheckpoints];
+    }
+
     /** Pointer to CPU. */
     CPU *cpu;
 
@@ -440,6 +480,12 @@ class Rename
     /** Rename width, in instructions. */
     unsigned renameWidth;
 
+    /** Number of rename map checkpoints per thread. */
+    const unsigned numRenameCheckpoints;
+
+    /** Load value predictor, if any. */
+    ValuePredictor *valuePred;
+
     /** The index of the instruction in the time buffer to IEW that rename is
      * currently using.
      */
@@ -530,6 +576,8 @@ class Rename
         /** Stat for total number of mappings that were undone due to a
          *  squash. */
         statistics::Scalar undoneMaps;
+        /** Number of squashes recovered from a rename map checkpoint. */
+        statistics::Scalar checkpointRecoveries;
         /** Number of serialize instructions handled. */
         statistics::Scalar serializing;
         /** Number of instructions marked as temporarily serializing. */
@@ -0,0 +1,312 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/value_pred.hh"
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+StrideTable::StrideTable(unsigned size, bool use_stride)
+    : entries(size), useStride(use_stride)
+{
+    fatal_if(size && !isPowerOf2(size),
+             "Value predictor table size %u is not a power of 2", size);
+}
+
+bool
+StrideTable::lookup(Addr pc, uint64_t &value, unsigned &confidence)
+{
+    Entry &e = entry(pc);
+    if (!e.valid || e.tag != pc)
+        return false;
+
+    if (useStride) {
+        e.spec += e.stride;
+        value = e.spec;
+    } else {
+        value = e.last;
+    }
+    confidence = e.confidence;
+    return true;
+}
+
+void
+StrideTable::update(Addr pc, uint64_t actual, bool hit, uint64_t predicted)
+{
+    Entry &e = entry(pc);
+    if (!e.valid || e.tag != pc) {
+        e = Entry();
+        e.tag = pc;
+        e.valid = true;
+        e.last = e.spec = actual;
+        return;
+    }
+
+    if (actual == e.last + e.stride) {
+        e.confidence = std::min<unsigned>(e.confidence + 1, MaxConfidence);
+    } else {
+        e.stride = useStride ? actual - e.last : 0;
+        e.confidence = 0;
+    }
+    e.last = actual;
+
+    // Restart the speculative chain of in-flight instances from the
+    // actual value when it has gone off track.
+    if (!hit || predicted != actual)
+        e.spec = actual;
+}
+
+ValuePredictor::ValuePredictor(const Params &p)
+    : SimObject(p), confidenceThreshold(p.confidenceThreshold),
+      history(p.numThreads, 0), inFlight(p.numThreads), stats(this)
+{
+    fatal_if(confidenceThreshold > StrideTable::MaxConfidence,
+             "%s: confidenceThreshold must be at most %u", name(),
+             StrideTable::MaxConfidence);
+}
+
+bool
+ValuePredictor::lookup(Addr pc, uint64_t hist, RegVal &value, bool &use)
+{
+    ++stats.lookups;
+
+    unsigned confidence = 0;
+    use = false;
+    if (!predict(pc, hist, value, confidence))
+        return false;
+
+    use = confidence >= confidenceThreshold;
+    if (use)
+        ++stats.predictions;
+    return true;
+}
+
+bool
+ValuePredictor::train(Addr pc, uint64_t hist, RegVal actual, bool hit,
+                      bool used, RegVal predicted)
+{
+    update(pc, hist, actual, hit, predicted);
+
+    if (!used)
+        return false;
+
+    if (predicted == actual) {
+        ++stats.correct;
+        return false;
+    }
+    ++stats.incorrect;
+    return true;
+}
+
+void
+ValuePredictor::updateHistory(ThreadID tid, InstSeqNum seq_num, bool taken)
+{
+    inFlight[tid].push_back({seq_num, history[tid]});
+    history[tid] = (history[tid] << 1) | taken;
+}
+
+void
+ValuePredictor::squashHistory(ThreadID tid, InstSeqNum squash_seq_num,
+                              bool mispredicted, bool taken)
+{
+    auto &entries = inFlight[tid];
+    while (!entries.empty() && entries.back().seqNum > squash_seq_num) {
+        history[tid] = entries.back().history;
+        entries.pop_back();
+    }
+
+    if (mispredicted && !entries.empty() &&
+            entries.back().seqNum == squash_seq_num) {
+        history[tid] = (entries.back().history << 1) | taken;
+    }
+}
+
+void
+ValuePredictor::commitHistory(ThreadID tid, InstSeqNum done_seq_num)
+{
+    auto &entries = inFlight[tid];
+    while (!entries.empty() && entries.front().seqNum <= done_seq_num)
+        entries.pop_front();
+}
+
+ValuePredictor::ValuePredictorStats::ValuePredictorStats(
+        statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(lookups, statistics::units::Count::get(),
+               "Number of loads looked up in the value predictor"),
+      ADD_STAT(predictions, statistics::units::Count::get(),
+               "Number of confident value predictions used"),
+      ADD_STAT(correct, statistics::units::Count::get(),
+               "Number of used value predictions that were correct"),
+      ADD_STAT(incorrect, statistics::units::Count::get(),
+               "Number of used value predictions that were wrong and "
+               "caused a squash"),
+      ADD_STAT(coverage, statistics::units::Ratio::get(),
+               "Fraction of looked up loads whose value was predicted",
+               predictions / lookups),
+      ADD_STAT(accuracy, statistics::units::Ratio::get(),
+               "Fraction of used value predictions that were correct",
+               correct / (correct + incorrect))
+{
+}
+
+LastValuePredictor::LastValuePredictor(const Params &p, bool use_stride)
+    : ValuePredictor(p), table(p.tableSize, use_stride)
+{
+    fatal_if(!p.tableSize, "%s: tableSize must not be 0", name());
+}
+
+bool
+LastValuePredictor::predict(Addr pc, uint64_t hist, RegVal &value,
+                            unsigned &confidence)
+{
+    return table.lookup(pc, value, confidence);
+}
+
+void
+LastValuePredictor::update(Addr pc, uint64_t hist, RegVal actual, bool hit,
+                           RegVal predicted)
+{
+    table.update(pc, actual, hit, predicted);
+}
+
+VTAGEValuePredictor::VTAGEValuePredictor(const Params &p)
+    : ValuePredictor(p), baseTable(p.baseTableSize),
+      taggedTables(p.historyLengths.size(),
+                   std::vector<Entry>(p.taggedTableSize)),
+      historyLengths(p.historyLengths), tagBits(p.tagBits)
+{
+    fatal_if(!isPowerOf2(p.baseTableSize) || !isPowerOf2(p.taggedTableSize),
+             "%s: table sizes must be powers of 2", name());
+    fatal_if(p.taggedTableSize < 2, "%s: taggedTableSize must be at least 2",
+             name());
+    fatal_if(tagBits == 0 || tagBits > 16, "%s: tagBits must be 1-16",
+             name());
+    for (auto length : historyLengths) {
+        fatal_if(length == 0 || length > 64,
+                 "%s: history lengths must be 1-64", name());
+    }
+
+    baseIndexBits = floorLog2(p.baseTableSize);
+    taggedIndexBits = floorLog2(p.taggedTableSize);
+    scratch.index.resize(historyLengths.size());
+    scratch.tag.resize(historyLengths.size());
+}
+
+uint64_t
+VTAGEValuePredictor::fold(uint64_t hist, unsigned length, unsigned bits)
+{
+    if (length < 64)
+        hist &= (1ULL << length) - 1;
+
+    uint64_t folded = 0;
+    for (; hist; hist >>= bits)
+        folded ^= hist & ((1ULL << bits) - 1);
+    return folded;
+}
+
+void
+VTAGEValuePredictor::compute(Addr pc, uint64_t hist, Lookup &lookup) const
+{
+    Addr pc_bits = pc >> 1;
+    uint64_t index_mask = (1ULL << taggedIndexBits) - 1;
+    uint64_t tag_mask = (1ULL << tagBits) - 1;
+
+    lookup.provider = -1;
+    for (unsigned i = 0; i < historyLengths.size(); i++) {
+        unsigned length = historyLengths[i];
+        lookup.index[i] = (pc_bits ^ (pc_bits >> taggedIndexBits) ^
+                fold(hist, length, taggedIndexBits)) & index_mask;
+        lookup.tag[i] = (pc_bits ^ fold(hist, length, tagBits) ^
+                (fold(hist, length, tagBits - 1) << 1)) & tag_mask;
+        if (taggedTables[i][lookup.index[i]].tag == lookup.tag[i])
+            lookup.provider = i;
+    }
+}
+
+bool
+VTAGEValuePredictor::predict(Addr pc, uint64_t hist, RegVal &value,
+                             unsigned &confidence)
+{
+    compute(pc, hist, scratch);
+
+    const Entry &e = scratch.provider >= 0 ?
+        taggedTables[scratch.provider][scratch.index[scratch.provider]] :
+        baseTable[(pc >> 1) & ((1ULL << baseIndexBits) - 1)];
+    value = e.value;
+    confidence = e.confidence;
+    return true;
+}
+
+void
+VTAGEValuePredictor::update(Addr pc, uint64_t hist, RegVal actual, bool hit,
+                            RegVal predicted)
+{
+    compute(pc, hist, scratch);
+
+    int provider = scratch.provider;
+    Entry &e = provider >= 0 ?
+        taggedTables[provider][scratch.index[provider]] :
+        baseTable[(pc >> 1) & ((1ULL << baseIndexBits) - 1)];
+
+    if (e.value == actual) {
+        e.confidence = std::min<unsigned>(e.confidence + 1, MaxConfidence);
+        e.useful = true;
+        return;
+    }
+
+    e.value = actual;
+    e.confidence = 0;
+    e.useful = false;
+
+    // The provider could not tell the instances of the PC apart; give it
+    // an entry in a table using more history.
+    bool allocated = false;
+    for (unsigned i = provider + 1; i < historyLengths.size(); i++) {
+        Entry &victim = taggedTables[i][scratch.index[i]];
+        if (!victim.useful) {
+            victim.tag = scratch.tag[i];
+            victim.value = actual;
+            victim.confidence = 0;
+            allocated = true;
+            break;
+        }
+    }
+    if (!allocated) {
+        for (unsigned i = provider + 1; i < historyLengths.size(); i++)
+            taggedTables[i][scratch.index[i]].useful = false;
+    }
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,279 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Value predictors for the O3 CPU. Rename asks the predictor for the
+ * value a load will return and, if the prediction is confident, writes
+ * it to the load's destination register so that dependents can issue
+ * before the load completes. IEW trains the predictor with the loaded
+ * value and squashes everything after a load whose value was mispredicted.
+ */
+
+#ifndef __CPU_O3_VALUE_PRED_HH__
+#define __CPU_O3_VALUE_PRED_HH__
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+#include "params/LastValuePredictor.hh"
+#include "params/StrideValuePredictor.hh"
+#include "params/VTAGEValuePredictor.hh"
+#include "params/ValuePredictor.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Direct mapped table predicting that the next value produced by a PC is
+ * the last one plus the last observed stride. Several instances of a
+ * PC can be in flight, so lookups advance a speculative value and a
+ * mismatching result moves it back to the actual value.
+ */
+class StrideTable
+{
+  public:
+    /**
+     * @param size Number of entries, a power of 2.
+     * @param use_stride False turns the table into a last value table.
+     */
+    StrideTable(unsigned size, bool use_stride);
+
+    /**
+     * Looks up the next value of a PC.
+     * @param value Set to the predicted value on a hit.
+     * @param confidence Set to the confidence of the prediction on a hit.
+     * @return Whether the table has an entry for the PC.
+     */
+    bool lookup(Addr pc, uint64_t &value, unsigned &confidence);
+
+    /**
+     * Trains the table with the value an instance of the PC produced.
+     * @param hit Whether the lookup of that instance hit.
+     * @param predicted The value predicted for that instance, if it hit.
+     */
+    void update(Addr pc, uint64_t actual, bool hit, uint64_t predicted);
+
+    static constexpr unsigned MaxConfidence = 7;
+
+  private:
+    struct Entry
+    {
+        Addr tag = 0;
+        bool valid = false;
+        uint64_t last = 0;
+        uint64_t spec = 0;
+        uint64_t stride = 0;
+        uint8_t confidence = 0;
+    };
+
+    Entry &
+    entry(Addr pc)
+    {
+        return entries[(pc >> 1) & (entries.size() - 1)];
+    }
+
+    std::vector<Entry> entries;
+    const bool useStride;
+};
+
+class ValuePredictor : public SimObject
+{
+  public:
+    PARAMS(ValuePredictor);
+    ValuePredictor(const Params &p);
+
+    /** Shifts the predicted direction of a renamed control instruction
+     * into the global history of its thread. */
+    void updateHistory(ThreadID tid, InstSeqNum seq_num, bool taken);
+
+    /**
+     * Repairs the global history of a thread after a squash, dropping the
+     * directions of the squashed control instructions.
+     * @param squash_seq_num The youngest instruction that is kept.
+     * @param mispredicted Whether that instruction is a branch whose
+     *        predicted direction was wrong.
+     * @param taken Its actual direction, if mispredicted.
+     */
+    void squashHistory(ThreadID tid, InstSeqNum squash_seq_num,
+                       bool mispredicted, bool taken);
+
+    /** Forgets the repair information of committed instructions. */
+    void commitHistory(ThreadID tid, InstSeqNum done_seq_num);
+
+    /** @return The global history of a thread, to be passed back with
+     * the lookup and the update of a prediction. */
+    uint64_t getHistory(ThreadID tid) const { return history[tid]; }
+
+    /**
+     * Predicts the value produced by the instruction at pc.
+     * @param value Set to the predicted value if the predictor has one.
+     * @param use Set if the prediction is confident enough to be used.
+     * @return Whether the predictor has a value for the instruction.
+     */
+    bool lookup(Addr pc, uint64_t hist, RegVal &value, bool &use);
+
+    /**
+     * Trains the predictor with the value an instruction produced.
+     * @param hit Whether lookup() returned a value for the instruction.
+     * @param used Whether that value was used.
+     * @param predicted The value lookup() returned.
+     * @return Whether a used prediction was wrong.
+     */
+    bool train(Addr pc, uint64_t hist, RegVal actual, bool hit, bool used,
+               RegVal predicted);
+
+  protected:
+    /** Predictor specific lookup, setting the confidence of the value. */
+    virtual bool predict(Addr pc, uint64_t hist, RegVal &value,
+                         unsigned &confidence) = 0;
+
+    /** Predictor specific training. */
+    virtual void update(Addr pc, uint64_t hist, RegVal actual, bool hit,
+                        RegVal predicted) = 0;
+
+    const unsigned confidenceThreshold;
+
+  private:
+    /** Per-thread global branch history. */
+    std::vector<uint64_t> history;
+
+    /** History before an in-flight control instruction. */
+    struct HistoryEntry
+    {
+        InstSeqNum seqNum;
+        uint64_t history;
+    };
+
+    /** Per-thread in-flight control instructions, oldest first. */
+    std::vector<std::deque<HistoryEntry>> inFlight;
+
+    struct ValuePredictorStats : public statistics::Group
+    {
+        ValuePredictorStats(statistics::Group *parent);
+
+        statistics::Scalar lookups;
+        statistics::Scalar predictions;
+        statistics::Scalar correct;
+        statistics::Scalar incorrect;
+        statistics::Formula coverage;
+        statistics::Formula accuracy;
+    } stats;
+};
+
+/** Predicts that an instruction produces the same value as last time. */
+class LastValuePredictor : public ValuePredictor
+{
+  public:
+    PARAMS(LastValuePredictor);
+    LastValuePredictor(const Params &p) : LastValuePredictor(p, false) {}
+
+  protected:
+    LastValuePredictor(const Params &p, bool use_stride);
+
+    bool predict(Addr pc, uint64_t hist, RegVal &value,
+                 unsigned &confidence) override;
+    void update(Addr pc, uint64_t hist, RegVal actual, bool hit,
+                RegVal predicted) override;
+
+    StrideTable table;
+};
+
+/** Predicts that an instruction's values change by a constant stride. */
+class StrideValuePredictor : public LastValuePredictor
+{
+  public:
+    PARAMS(StrideValuePredictor);
+    StrideValuePredictor(const Params &p) : LastValuePredictor(p, true) {}
+};
+
+/**
+ * VTAGE, after "Practical Data Value Speculation for Future
+ * High-end Processors" by Perais and Seznec: a PC indexed last value
+ * table backed by tagged tables indexed with geometric lengths of global
+ * branch history. The longest matching table provides the prediction.
+ * EVES' probabilistic confidence counters are not modelled; counters
+ * saturate deterministically instead.
+ */
+class VTAGEValuePredictor : public ValuePredictor
+{
+  public:
+    PARAMS(VTAGEValuePredictor);
+    VTAGEValuePredictor(const Params &p);
+
+    static constexpr unsigned MaxConfidence = StrideTable::MaxConfidence;
+
+  protected:
+    bool predict(Addr pc, uint64_t hist, RegVal &value,
+                 unsigned &confidence) override;
+    void update(Addr pc, uint64_t hist, RegVal actual, bool hit,
+                RegVal predicted) override;
+
+  private:
+    struct Entry
+    {
+        uint16_t tag = 0;
+        bool useful = false;
+        uint8_t confidence = 0;
+        RegVal value = 0;
+    };
+
+    /** Index and tag of every tagged table for a PC and history. */
+    struct Lookup
+    {
+        std::vector<unsigned> index;
+        std::vector<uint16_t> tag;
+        /** Table providing the prediction, -1 for the base table. */
+        int provider = -1;
+    };
+
+    void compute(Addr pc, uint64_t hist, Lookup &lookup) const;
+
+    /** XOR-folds the given number of history bits down to bits bits. */
+    static uint64_t fold(uint64_t hist, unsigned length, unsigned bits);
+
+    std::vector<Entry> baseTable;
+    std::vector<std::vector<Entry>> taggedTables;
+    const std::vector<unsigned> historyLengths;
+    const unsigned tagBits;
+    unsigned baseIndexBits;
+    unsigned taggedIndexBits;
+
+    /** Scratch space, to avoid allocations on every access. */
+    Lookup scratch;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_VALUE_PRED_HH__
@@ -58,6 +58,7 @@ PCEventQueue::remove(PCEvent *event)
             DPRINTF(PCEvent, "PC based event removed at %#x: %s\n",
                     event->pc(), event->descr());
             i = pcMap.erase(i);
+            --pageFilter[filterBucket(event->pc())];
             ++removed;
         } else {
             i++;
@@ -70,8 +71,10 @@ PCEventQueue::remove(PCEvent *event)
 bool
 PCEventQueue::schedule(PCEvent *event)
 {
-    pcMap.push_back(event);
-    std::sort(pcMap.begin(), pcMap.end(), MapCompare());
+    // keep the map sorted, after any events already at the same PC
+    pcMap.insert(std::upper_bound(pcMap.begin(), pcMap.end(), event,
+                                  MapCompare()), event);
+    ++pageFilter[filterBucket(event->pc())];
 
     DPRINTF(PCEvent, "PC based event scheduled for %#x: %s\n",
             event->pc(), event->descr());
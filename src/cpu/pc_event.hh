@@ -29,6 +29,8 @@
 #ifndef __PC_EVENT_HH__
 #define __PC_EVENT_HH__
 
+#include <array>
+#include <cstdint>
 #include <vector>
 
 #include "base/logging.hh"
@@ -106,6 +108,26 @@ class PCEventQueue : public PCEventScope
   protected:
     Map pcMap;
 
+    /**
+     * Number of pages the page filter folds the address space into, and
+     * the size of the folded pages.
+     */
+    static constexpr int filterBuckets = 4096;
+    static constexpr int filterPageShift = 12;
+
+    /**
+     * Count of the events on the pages folded into each bucket. The
+     * search can be skipped for a PC whose bucket has no events, which is
+     * the case on almost all the code pages.
+     */
+    std::array<uint32_t, filterBuckets> pageFilter = {};
+
+    static int
+    filterBucket(Addr pc)
+    {
+        return (pc >> filterPageShift) % filterBuckets;
+    }
+
     bool doService(Addr pc, ThreadContext *tc);
 
   public:
@@ -116,7 +138,7 @@ class PCEventQueue : public PCEventScope
     bool schedule(PCEvent *event) override;
     bool service(Addr pc, ThreadContext *tc)
     {
-        if (pcMap.empty())
+        if (pcMap.empty() || !pageFilter[filterBucket(pc)])
             return false;
 
         return doService(pc, tc);
@@ -44,7 +44,7 @@
 
 #include <vector>
 
-#include "base/sat_counter.hh"
+#include "base/sat_counter_array.hh"
 #include "base/types.hh"
 #include "cpu/pred/bpred_unit.hh"
 #include "params/LocalBP.hh"
@@ -106,7 +106,7 @@ class LocalBP : public BPredUnit
     const unsigned localPredictorSets;
 
     /** Array of counters that make up the local predictor. */
-    std::vector<SatCounter8> localCtrs;
+    SatCounterArray localCtrs;
 
     /** Mask to get index bits. */
     const unsigned indexMask;
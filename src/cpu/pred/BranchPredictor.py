@@ -143,6 +143,26 @@ class SimpleBTB(BranchTargetBuffer):
     )
 
 
+class MultiLevelBTB(BranchTargetBuffer):
+    type = "MultiLevelBTB"
+    cxx_class = "gem5::branch_prediction::MultiLevelBTB"
+    cxx_header = "cpu/pred/multi_level_btb.hh"
+
+    levels = VectorParam.SimpleBTB(
+        [
+            SimpleBTB(numEntries=16, associativity=16),
+            SimpleBTB(numEntries=512, associativity=4),
+            SimpleBTB(numEntries=4096, associativity=8),
+        ],
+        "BTB levels, smallest and fastest first",
+    )
+    bubbles = VectorParam.Cycles(
+        [0, 1, 2],
+        "Fetch bubble after a taken branch whose target comes from each "
+        "level",
+    )
+
+
 class IndirectPredictor(SimObject):
     type = "IndirectPredictor"
     cxx_class = "gem5::branch_prediction::IndirectPredictor"
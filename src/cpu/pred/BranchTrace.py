@@ -0,0 +1,69 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.Probe import ProbeListenerObject
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+
+class BranchTraceRecorder(ProbeListenerObject):
+    """Records the branches committed by a branch predictor unit to a
+    branch trace. The manager must be the branch predictor. Set the cpu to
+    also record the number of instructions between branches.
+    """
+
+    type = "BranchTraceRecorder"
+    cxx_header = "cpu/pred/branch_trace_recorder.hh"
+    cxx_class = "gem5::branch_prediction::BranchTraceRecorder"
+
+    trace_file = Param.String(
+        "branches.trace.gz",
+        "Trace to write, relative to the output directory. Compressed "
+        "when the name ends in .gz",
+    )
+    cpu = Param.BaseCPU(NULL, "CPU whose retired instructions are counted")
+
+
+class BranchTraceReplayer(SimObject):
+    """Replays a branch trace through the direction predictors of several
+    branch predictor units on parallel host threads, without simulating a
+    CPU, and reports each predictor's mispredictions and MPKI. The
+    predictors must not be used by a CPU at the same time.
+    """
+
+    type = "BranchTraceReplayer"
+    cxx_header = "cpu/pred/branch_trace_replayer.hh"
+    cxx_class = "gem5::branch_prediction::BranchTraceReplayer"
+
+    trace_file = Param.String("Branch trace to replay")
+    predictors = VectorParam.BranchPredictor("Predictors to evaluate")
+    num_threads = Param.Unsigned(
+        0, "Host threads to replay on (0 uses all host cores)"
+    )
+    max_branches = Param.UInt64(
+        0, "Replay at most this many branches (0 replays the whole trace)"
+    )
+    exit_when_done = Param.Bool(
+        True, "Exit the simulation loop when the replay is done"
+    )
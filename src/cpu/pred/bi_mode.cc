@@ -61,9 +61,9 @@ BiModeBP::BiModeBP(const BiModeBPParams &params)
       choiceCtrBits(params.choiceCtrBits),
       globalPredictorSize(params.globalPredictorSize),
       globalCtrBits(params.globalCtrBits),
-      choiceCounters(choicePredictorSize, SatCounter8(choiceCtrBits)),
-      takenCounters(globalPredictorSize, SatCounter8(globalCtrBits)),
-      notTakenCounters(globalPredictorSize, SatCounter8(globalCtrBits))
+      choiceCounters(choicePredictorSize, choiceCtrBits),
+      takenCounters(globalPredictorSize, globalCtrBits),
+      notTakenCounters(globalPredictorSize, globalCtrBits)
 {
     if (!isPowerOf2(choicePredictorSize))
         fatal("Invalid choice predictor size.\n");
@@ -45,8 +45,9 @@
 #ifndef __CPU_PRED_BI_MODE_PRED_HH__
 #define __CPU_PRED_BI_MODE_PRED_HH__
 
-#include "base/sat_counter.hh"
+#include "base/sat_counter_array.hh"
 #include "cpu/pred/bpred_unit.hh"
+#include "cpu/pred/pooled_history.hh"
 #include "params/BiModeBP.hh"
 
 namespace gem5
@@ -86,7 +87,7 @@ class BiModeBP : public BPredUnit
     void updateGlobalHistReg(ThreadID tid, bool taken);
     void uncondBranch(ThreadID tid, Addr pc, void * &bp_history);
 
-    struct BPHistory
+    struct BPHistory : public PooledHistory
     {
         unsigned globalHistoryReg;
         // was the taken array's prediction used?
@@ -119,11 +120,11 @@ class BiModeBP : public BPredUnit
     unsigned globalHistoryMask;
 
     // choice predictors
-    std::vector<SatCounter8> choiceCounters;
+    SatCounterArray choiceCounters;
     // taken direction predictors
-    std::vector<SatCounter8> takenCounters;
+    SatCounterArray takenCounters;
     // not-taken direction predictors
-    std::vector<SatCounter8> notTakenCounters;
+    SatCounterArray notTakenCounters;
 
     unsigned choiceThreshold;
     unsigned takenThreshold;
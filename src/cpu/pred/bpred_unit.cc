@@ -61,6 +61,7 @@ BPredUnit::BPredUnit(const Params &params)
       requiresBTBHit(params.requiresBTBHit),
       instShiftAmt(params.instShiftAmt),
       predHist(numThreads),
+      btbBubble(numThreads, Cycles(0)),
       btb(params.btb),
       ras(params.ras),
       iPred(params.indirectBranchPred),
@@ -83,6 +84,8 @@ BPredUnit::regProbePoints()
 {
     ppBranches = pmuProbePoint("Branches");
     ppMisses = pmuProbePoint("Misses");
+    ppCommittedBranches = new ProbePointArg<CommittedBranch>(
+        getProbeManager(), "CommittedBranches");
 }
 
 void
@@ -184,9 +187,11 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
      */
     stats.BTBLookups++;
     const PCStateBase * btb_target = btb->lookup(tid, pc.instAddr(), brType);
+    btbBubble[tid] = Cycles(0);
     if (btb_target) {
         stats.BTBHits++;
         hist->btbHit = true;
+        btbBubble[tid] = btb->lookupBubble(tid);
 
         if (hist->predTaken) {
             hist->targetProvider = TargetProvider::BTB;
@@ -379,6 +384,10 @@ BPredUnit::commitBranch(ThreadID tid, PredictorHistory* &hist)
                 hist->predTaken, hist->actuallyTaken,
                 hist->target->instAddr());
 
+    ppCommittedBranches->notify(CommittedBranch{tid, hist->pc,
+            hist->target->instAddr(), hist->type, hist->actuallyTaken,
+            hist->mispredict});
+
     // Update the branch predictor with the correct results.
     update(tid, hist->pc,
                 hist->actuallyTaken,
@@ -401,6 +410,62 @@ BPredUnit::commitBranch(ThreadID tid, PredictorHistory* &hist)
 
 
 
+bool
+BPredUnit::replayBranch(ThreadID tid, Addr pc, const StaticInstPtr &inst,
+                        bool taken, Addr target)
+{
+    const BranchType type = getBranchType(inst);
+    const bool uncond = inst->isUncondCtrl();
+    void *bp_history = nullptr;
+
+    stats.lookups[tid][type]++;
+
+    bool pred_taken = true;
+    if (!uncond) {
+        ++stats.condPredicted;
+        pred_taken = lookup(tid, pc, bp_history);
+        if (pred_taken)
+            ++stats.condPredictedTaken;
+    }
+
+    updateHistories(tid, pc, uncond, pred_taken, target, inst, bp_history);
+
+    const bool mispredict = pred_taken != taken;
+    if (mispredict) {
+        ++stats.condIncorrect;
+        // Restore the speculative histories as a squash would.
+        update(tid, pc, taken, bp_history, true, inst, target);
+    }
+
+    stats.committed[tid][type]++;
+    if (mispredict) {
+        stats.mispredicted[tid][type]++;
+        stats.mispredictDueToPredictor[tid][type]++;
+    }
+    update(tid, pc, taken, bp_history, false, inst, target);
+
+    return mispredict;
+}
+
+BPredUnit::RunAhead
+BPredUnit::runAheadLookup(ThreadID tid, Addr pc, Addr &target)
+{
+    if (!btb->valid(tid, pc))
+        return RunAhead::NoBranch;
+
+    const StaticInstPtr inst = btb->getInst(tid, pc);
+    if (inst && inst->isReturn())
+        return RunAhead::Unknown;
+
+    const PCStateBase *btb_target = btb->lookup(tid, pc,
+            inst ? getBranchType(inst) : BranchType::NoBranch);
+    if (!btb_target)
+        return RunAhead::Unknown;
+
+    target = btb_target->instAddr();
+    return RunAhead::Taken;
+}
+
 void
 BPredUnit::squash(const InstSeqNum &squashed_sn, ThreadID tid)
 {
@@ -50,11 +50,13 @@
 #include "cpu/pred/branch_type.hh"
 #include "cpu/pred/btb.hh"
 #include "cpu/pred/indirect.hh"
+#include "cpu/pred/pooled_history.hh"
 #include "cpu/pred/ras.hh"
 #include "cpu/static_inst.hh"
 #include "enums/TargetProvider.hh"
 #include "params/BranchPredictor.hh"
 #include "sim/probe/pmu.hh"
+#include "sim/probe/probe.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -72,6 +74,19 @@ class BPredUnit : public SimObject
     typedef BranchPredictorParams Params;
     typedef enums::TargetProvider TargetProvider;
 
+  public:
+    /** Argument of the CommittedBranches probe point. */
+    struct CommittedBranch
+    {
+        ThreadID tid;
+        Addr pc;
+        /** Resolved target, the fall-through PC when not taken. */
+        Addr target;
+        BranchType type;
+        bool taken;
+        bool mispredicted;
+    };
+
     /** Branch Predictor Unit (BPU) interface functions */
   public:
 
@@ -129,6 +144,50 @@ class BPredUnit : public SimObject
     void squash(const InstSeqNum &squashed_sn, const PCStateBase &corr_target,
                 bool actually_taken, ThreadID tid, bool from_commit=true);
 
+    /**
+     * Runs one resolved branch through the direction predictor only:
+     * lookup, history update, correction if mispredicted, and commit.
+     * The BTB, RAS and indirect predictor are not involved. Used to
+     * replay branch traces without a CPU.
+     * @param tid The thread id.
+     * @param pc The branch's PC.
+     * @param inst Static instruction information of the branch.
+     * @param taken The actual direction.
+     * @param target The resolved target.
+     * @return Whether the direction was mispredicted.
+     */
+    bool replayBranch(ThreadID tid, Addr pc, const StaticInstPtr &inst,
+                      bool taken, Addr target);
+
+    /** Outcome of a run-ahead probe of the BTB. */
+    enum class RunAhead
+    {
+        /** The BTB knows no branch at this PC. */
+        NoBranch,
+        /** A branch predicted taken to the returned target. */
+        Taken,
+        /** A branch whose target the BTB alone can't provide. */
+        Unknown
+    };
+
+    /**
+     * Probes the BTB on behalf of a front end running ahead of fetch.
+     * Branches that hit in the BTB are predicted taken, the direction
+     * predictor and the RAS are not consulted so that no speculative
+     * state is touched. Returns are reported as Unknown.
+     * @param tid The thread id.
+     * @param pc The PC to probe.
+     * @param target Set to the predicted target if the result is Taken.
+     */
+    RunAhead runAheadLookup(ThreadID tid, Addr pc, Addr &target);
+
+    /**
+     * The fetch bubble of the last prediction of a thread, i.e. the
+     * cycles the BTB took to provide the branch beyond what fetch hides.
+     * @param tid The thread id.
+     */
+    Cycles fetchBubble(ThreadID tid) const { return btbBubble[tid]; }
+
   protected:
 
     /** *******************************************************
@@ -338,7 +397,7 @@ class BPredUnit : public SimObject
      *         +-------------------------------------+
      *
      */
-    struct PredictorHistory
+    struct PredictorHistory : public PooledHistory
     {
         /**
          * Makes a predictor history struct that contains any
@@ -480,6 +539,9 @@ class BPredUnit : public SimObject
      */
     std::vector<History> predHist;
 
+    /** The BTB bubble of the last prediction of each thread. */
+    std::vector<Cycles> btbBubble;
+
     /** The BTB. */
     BranchTargetBuffer * btb;
 
@@ -556,6 +618,9 @@ class BPredUnit : public SimObject
     /** Miss-predicted branches */
     probing::PMUUPtr ppMisses;
 
+    /** Branches leaving the predictor at commit, with their outcome */
+    ProbePointArg<CommittedBranch> *ppCommittedBranches;
+
     /** @} */
 };
 
@@ -0,0 +1,137 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/branch_trace.hh"
+
+#include <zfstream.h>
+
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+#include "base/logging.hh"
+#include "sim/byteswap.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace branch_trace
+{
+
+namespace
+{
+
+// Record layout: pc (8), target (8), insts (4), type (1), taken (1)
+// and two bytes of padding.
+constexpr size_t PcOffset = 0;
+constexpr size_t TargetOffset = 8;
+constexpr size_t InstsOffset = 16;
+constexpr size_t TypeOffset = 20;
+constexpr size_t TakenOffset = 21;
+
+template <typename T>
+void
+put(uint8_t *buf, size_t offset, T value)
+{
+    value = htole(value);
+    std::memcpy(buf + offset, &value, sizeof(value));
+}
+
+template <typename T>
+T
+get(const uint8_t *buf, size_t offset)
+{
+    T value;
+    std::memcpy(&value, buf + offset, sizeof(value));
+    return letoh(value);
+}
+
+} // anonymous namespace
+
+void
+writeHeader(std::ostream &os)
+{
+    os.write(Magic, sizeof(Magic));
+}
+
+void
+writeRecord(std::ostream &os, const BranchTraceRecord &rec)
+{
+    uint8_t buf[RecordBytes] = {};
+    put<uint64_t>(buf, PcOffset, rec.pc);
+    put<uint64_t>(buf, TargetOffset, rec.target);
+    put<uint32_t>(buf, InstsOffset, rec.insts);
+    buf[TypeOffset] = static_cast<uint8_t>(rec.type);
+    buf[TakenOffset] = rec.taken;
+    os.write(reinterpret_cast<const char *>(buf), sizeof(buf));
+}
+
+std::vector<BranchTraceRecord>
+read(const std::string &filename, uint64_t max_records)
+{
+    std::unique_ptr<std::istream> is;
+    const bool gz = filename.size() > 3 &&
+        filename.compare(filename.size() - 3, 3, ".gz") == 0;
+    if (gz)
+        is = std::make_unique<gzifstream>(filename.c_str(), std::ios::in);
+    else
+        is = std::make_unique<std::ifstream>(filename, std::ios::binary);
+    fatal_if(!is->good(), "Could not open branch trace %s.", filename);
+
+    char magic[sizeof(Magic)];
+    is->read(magic, sizeof(magic));
+    fatal_if(!is->good() || std::memcmp(magic, Magic, sizeof(Magic)),
+             "%s is not a branch trace.", filename);
+
+    std::vector<BranchTraceRecord> records;
+    uint8_t buf[RecordBytes];
+    while (!max_records || records.size() < max_records) {
+        is->read(reinterpret_cast<char *>(buf), sizeof(buf));
+        if (is->gcount() == 0)
+            break;
+        fatal_if(is->gcount() != sizeof(buf),
+                 "Branch trace %s is truncated.", filename);
+
+        BranchTraceRecord rec;
+        rec.pc = get<uint64_t>(buf, PcOffset);
+        rec.target = get<uint64_t>(buf, TargetOffset);
+        rec.insts = get<uint32_t>(buf, InstsOffset);
+        fatal_if(buf[TypeOffset] >= enums::Num_BranchType,
+                 "Bad branch type %d in branch trace %s.",
+                 buf[TypeOffset], filename);
+        rec.type = static_cast<BranchType>(buf[TypeOffset]);
+        rec.taken = buf[TakenOffset];
+        records.push_back(rec);
+    }
+    return records;
+}
+
+} // namespace branch_trace
+
+} // namespace branch_prediction
+} // namespace gem5
@@ -0,0 +1,87 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_BRANCH_TRACE_HH__
+#define __CPU_PRED_BRANCH_TRACE_HH__
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+#include "cpu/pred/branch_type.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/** One committed branch of a branch trace. */
+struct BranchTraceRecord
+{
+    Addr pc = 0;
+    /** Resolved target, the fall-through PC when not taken. */
+    Addr target = 0;
+    /** Instructions committed since the previous branch, inclusive. */
+    uint32_t insts = 0;
+    BranchType type = BranchType::NoBranch;
+    bool taken = false;
+};
+
+/**
+ * Branch traces are a magic header followed by fixed-size little-endian
+ * records. Files whose name ends in .gz are gzip compressed.
+ */
+namespace branch_trace
+{
+
+/** Identifies a branch trace and its format version. */
+constexpr char Magic[8] = {'g', '5', 'b', 'r', 't', 'r', 'c', '1'};
+
+/** Size of an encoded record in bytes. */
+constexpr size_t RecordBytes = 24;
+
+/** Write the trace header to a new stream. */
+void writeHeader(std::ostream &os);
+
+/** Append one record to a stream started with writeHeader(). */
+void writeRecord(std::ostream &os, const BranchTraceRecord &rec);
+
+/**
+ * Read a whole trace into memory.
+ * @param filename The trace to read.
+ * @param max_records Stop after this many records, 0 reads them all.
+ */
+std::vector<BranchTraceRecord> read(const std::string &filename,
+                                    uint64_t max_records = 0);
+
+} // namespace branch_trace
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_BRANCH_TRACE_HH__
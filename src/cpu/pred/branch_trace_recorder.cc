@@ -0,0 +1,104 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/branch_trace_recorder.hh"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/output.hh"
+#include "cpu/base.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+BranchTraceRecorder::BranchTraceRecorder(const Params &p)
+    : ProbeListenerObject(p), cpu(p.cpu),
+      traceStream(simout.create(p.trace_file, true)), insts(0)
+{
+    fatal_if(!traceStream, "%s: could not create branch trace %s.",
+             name(), p.trace_file);
+    branch_trace::writeHeader(*traceStream->stream());
+    registerExitCallback([this]() { close(); });
+}
+
+void
+BranchTraceRecorder::regProbeListeners()
+{
+    typedef ProbeListenerArg<BranchTraceRecorder,
+                             BPredUnit::CommittedBranch> BranchListener;
+    connectListener<BranchListener>(this, "CommittedBranches",
+                                    &BranchTraceRecorder::committedBranch);
+
+    if (cpu) {
+        typedef ProbeListenerArg<BranchTraceRecorder, uint64_t>
+            InstListener;
+        listeners.push_back(cpu->getProbeManager()->connect<InstListener>(
+            this, "RetiredInsts", &BranchTraceRecorder::retiredInsts));
+    }
+}
+
+void
+BranchTraceRecorder::committedBranch(const BPredUnit::CommittedBranch &branch)
+{
+    if (!traceStream)
+        return;
+
+    BranchTraceRecord rec;
+    rec.pc = branch.pc;
+    rec.target = branch.target;
+    // The branch itself may retire after the predictor commits it, so
+    // count at least one instruction when instructions are counted.
+    if (cpu) {
+        rec.insts = std::min<uint64_t>(std::max<uint64_t>(insts, 1),
+                                       std::numeric_limits<uint32_t>::max());
+    }
+    rec.type = branch.type;
+    rec.taken = branch.taken;
+    branch_trace::writeRecord(*traceStream->stream(), rec);
+    insts = 0;
+}
+
+void
+BranchTraceRecorder::retiredInsts(const uint64_t &count)
+{
+    insts += count;
+}
+
+void
+BranchTraceRecorder::close()
+{
+    if (traceStream) {
+        simout.close(traceStream);
+        traceStream = nullptr;
+    }
+}
+
+} // namespace branch_prediction
+} // namespace gem5
@@ -0,0 +1,74 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_BRANCH_TRACE_RECORDER_HH__
+#define __CPU_PRED_BRANCH_TRACE_RECORDER_HH__
+
+#include "cpu/pred/bpred_unit.hh"
+#include "cpu/pred/branch_trace.hh"
+#include "params/BranchTraceRecorder.hh"
+#include "sim/probe/probe.hh"
+#include "sim/probe/probe_listener_object.hh"
+
+namespace gem5
+{
+
+class BaseCPU;
+class OutputStream;
+
+namespace branch_prediction
+{
+
+/**
+ * Writes the branches committed by a branch predictor unit to a branch
+ * trace, which a BranchTraceReplayer can run through other predictors
+ * without simulating the CPU again. When a CPU is given, each record
+ * also holds the number of instructions committed since the previous
+ * branch, so the replay can report MPKI.
+ */
+class BranchTraceRecorder : public ProbeListenerObject
+{
+  public:
+    using Params = BranchTraceRecorderParams;
+    BranchTraceRecorder(const Params &p);
+
+    void regProbeListeners() override;
+
+  private:
+    void committedBranch(const BPredUnit::CommittedBranch &branch);
+    void retiredInsts(const uint64_t &insts);
+    void close();
+
+    BaseCPU *cpu;
+    OutputStream *traceStream;
+
+    /** Instructions committed since the last recorded branch. */
+    uint64_t insts;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_BRANCH_TRACE_RECORDER_HH__
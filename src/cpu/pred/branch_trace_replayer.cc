@@ -0,0 +1,224 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/branch_trace_replayer.hh"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <thread>
+
+#include "arch/generic/pcstate.hh"
+#include "base/logging.hh"
+#include "debug/Branch.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace
+{
+
+/** Stand-in for the branch instructions of a trace. */
+class ReplayBranchInst : public StaticInst
+{
+  public:
+    ReplayBranchInst(BranchType type)
+        : StaticInst("replay branch", No_OpClass)
+    {
+        flags[IsControl] = true;
+
+        const bool direct = type == BranchType::CallDirect ||
+            type == BranchType::DirectCond ||
+            type == BranchType::DirectUncond;
+        flags[IsDirectControl] = direct;
+        flags[IsIndirectControl] = !direct;
+
+        const bool cond = type == BranchType::DirectCond ||
+            type == BranchType::IndirectCond;
+        flags[IsCondControl] = cond;
+        flags[IsUncondControl] = !cond;
+
+        flags[IsCall] = type == BranchType::CallDirect ||
+            type == BranchType::CallIndirect;
+        flags[IsReturn] = type == BranchType::Return;
+    }
+
+    Fault
+    execute(ExecContext *xc, trace::InstRecord *traceData) const override
+    {
+        panic("Branch trace instructions can't be executed.");
+    }
+
+    void
+    advancePC(PCStateBase &pc) const override
+    {
+        pc.advance();
+    }
+
+    std::string
+    generateDisassembly(Addr pc,
+            const loader::SymbolTable *symtab) const override
+    {
+        return mnemonic;
+    }
+};
+
+} // anonymous namespace
+
+BranchTraceReplayer::BranchTraceReplayer(const Params &p)
+    : SimObject(p), traceFile(p.trace_file), predictors(p.predictors),
+      numThreads(p.num_threads), maxBranches(p.max_branches),
+      exitWhenDone(p.exit_when_done), results(predictors.size()),
+      replayEvent([this]{ replay(); }, name()),
+      stats(*this)
+{
+    fatal_if(predictors.empty(), "%s: no predictors to replay through.",
+             name());
+}
+
+void
+BranchTraceReplayer::startup()
+{
+    schedule(replayEvent, curTick());
+}
+
+void
+BranchTraceReplayer::replay()
+{
+    trace = branch_trace::read(traceFile, maxBranches);
+    inform("%s: replaying %d branches from %s through %d predictors.",
+           name(), trace.size(), traceFile, predictors.size());
+
+    unsigned threads = numThreads ? numThreads :
+        std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<size_t>(threads, predictors.size());
+
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++)
+        workers.emplace_back([this, &next]() { replayWorker(next); });
+    replayWorker(next);
+    for (auto &worker : workers)
+        worker.join();
+
+    uint64_t insts = 0;
+    for (const auto &rec : trace)
+        insts += rec.insts;
+    stats.branches = trace.size();
+    stats.insts = insts;
+    for (size_t i = 0; i < predictors.size(); i++) {
+        stats.condBranches[i] = results[i].condBranches;
+        stats.mispredicted[i] = results[i].mispredicted;
+        stats.hostBranchRate[i] = results[i].hostSeconds > 0 ?
+            trace.size() / results[i].hostSeconds : 0;
+    }
+
+    // The trace is only needed once
+    std::vector<BranchTraceRecord>().swap(trace);
+
+    if (exitWhenDone)
+        exitSimLoop("branch trace replay complete");
+}
+
+void
+BranchTraceReplayer::replayWorker(std::atomic<size_t> &next)
+{
+    // Predictors may look at the current tick, e.g. to trace.
+    curEventQueue(eventQueue());
+
+    // Each thread has its own instructions as they are reference
+    // counted without synchronization.
+    std::array<StaticInstPtr, enums::Num_BranchType> insts;
+    for (int t = 0; t < enums::Num_BranchType; t++) {
+        if (t != BranchType::NoBranch)
+            insts[t] = new ReplayBranchInst(static_cast<BranchType>(t));
+    }
+
+    for (size_t i = next++; i < predictors.size(); i = next++)
+        replayPredictor(i, insts.data());
+}
+
+void
+BranchTraceReplayer::replayPredictor(size_t i, const StaticInstPtr *insts)
+{
+    BPredUnit *bp = predictors[i];
+    Result &result = results[i];
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const auto &rec : trace) {
+        if (rec.type == BranchType::NoBranch)
+            continue;
+        const StaticInstPtr &inst = insts[rec.type];
+        const bool mispredicted =
+            bp->replayBranch(0, rec.pc, inst, rec.taken, rec.target);
+        if (inst->isCondCtrl()) {
+            result.condBranches++;
+            result.mispredicted += mispredicted;
+        }
+    }
+
+    result.hostSeconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    DPRINTF(Branch, "%s: %d of %d conditional branches mispredicted.\n",
+            bp->name(), result.mispredicted, result.condBranches);
+}
+
+BranchTraceReplayer::ReplayerStats::ReplayerStats(BranchTraceReplayer &r)
+    : statistics::Group(&r),
+      ADD_STAT(branches, statistics::units::Count::get(),
+               "Number of branches in the trace"),
+      ADD_STAT(insts, statistics::units::Count::get(),
+               "Number of instructions covered by the trace"),
+      ADD_STAT(condBranches, statistics::units::Count::get(),
+               "Number of conditional branches predicted"),
+      ADD_STAT(mispredicted, statistics::units::Count::get(),
+               "Number of mispredicted conditional branches"),
+      ADD_STAT(mpki, statistics::units::Ratio::get(),
+               "Mispredictions per thousand instructions"),
+      ADD_STAT(hostBranchRate, statistics::units::Rate<
+                    statistics::units::Count,
+                    statistics::units::Second>::get(),
+               "Branches replayed per host second")
+{
+    const size_t n = r.predictors.size();
+    condBranches.init(n);
+    mispredicted.init(n);
+    hostBranchRate.init(n);
+    for (size_t i = 0; i < n; i++) {
+        const std::string &bp = r.predictors[i]->name();
+        condBranches.subname(i, bp);
+        mispredicted.subname(i, bp);
+        hostBranchRate.subname(i, bp);
+    }
+
+    mpki = mispredicted * 1000 / insts;
+}
+
+} // namespace branch_prediction
+} // namespace gem5
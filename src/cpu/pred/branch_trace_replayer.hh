@@ -0,0 +1,108 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_BRANCH_TRACE_REPLAYER_HH__
+#define __CPU_PRED_BRANCH_TRACE_REPLAYER_HH__
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "cpu/pred/branch_trace.hh"
+#include "params/BranchTraceReplayer.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * Replays a branch trace through the direction predictors of a set of
+ * branch predictor units, without a CPU. The trace is read into memory
+ * once and the predictors are run in parallel on host threads, each
+ * predictor by a single thread. Every branch is predicted, corrected
+ * and committed before the next one, i.e. there is no wrong-path or
+ * delayed update. The replay runs at startup and optionally exits the
+ * simulation loop when it is done.
+ */
+class BranchTraceReplayer : public SimObject
+{
+  public:
+    using Params = BranchTraceReplayerParams;
+    BranchTraceReplayer(const Params &p);
+
+    void startup() override;
+
+  private:
+    /** Replay the trace through every predictor. */
+    void replay();
+
+    /** Run predictors taken from next until none is left. */
+    void replayWorker(std::atomic<size_t> &next);
+
+    /** Run the whole trace through predictor i. */
+    void replayPredictor(size_t i, const StaticInstPtr *insts);
+
+    const std::string traceFile;
+    const std::vector<BPredUnit *> predictors;
+    const unsigned numThreads;
+    const uint64_t maxBranches;
+    const bool exitWhenDone;
+
+    std::vector<BranchTraceRecord> trace;
+
+    /** Per-predictor results, written by the thread that ran it. */
+    struct Result
+    {
+        uint64_t condBranches = 0;
+        uint64_t mispredicted = 0;
+        double hostSeconds = 0;
+    };
+    std::vector<Result> results;
+
+    EventFunctionWrapper replayEvent;
+
+    struct ReplayerStats : public statistics::Group
+    {
+        ReplayerStats(BranchTraceReplayer &r);
+
+        statistics::Scalar branches;
+        statistics::Scalar insts;
+        statistics::Vector condBranches;
+        statistics::Vector mispredicted;
+        statistics::Formula mpki;
+        statistics::Vector hostBranchRate;
+    } stats;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_BRANCH_TRACE_REPLAYER_HH__
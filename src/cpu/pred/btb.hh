@@ -98,6 +98,12 @@ class BranchTargetBuffer : public ClockedObject
                           BranchType type = BranchType::NoBranch,
                           StaticInstPtr inst = nullptr) = 0;
 
+    /** The fetch bubble of the target returned by the last lookup(),
+     *  for BTBs whose targets are not all available right away.
+     *  @return The cycles fetch loses before it can redirect.
+     */
+    virtual Cycles lookupBubble(ThreadID tid) const { return Cycles(0); }
+
     /** Update BTB statistics
      */
     virtual void incorrectTarget(Addr inst_pc,
@@ -99,14 +99,15 @@ class BTBSetAssociative : public BTBIndexingPolicy
     /**
      * Find all possible entries for insertion and replacement of an address.
      */
-    std::vector<ReplaceableEntry*>
-    getPossibleEntries(const KeyType &key) const override
+    void
+    getPossibleEntries(const KeyType &key,
+                       std::vector<ReplaceableEntry*> &entries) const override
     {
         auto set_idx = extractSet(key);
 
         assert(set_idx < sets.size());
 
-        return sets[set_idx];
+        entries.assign(sets[set_idx].begin(), sets[set_idx].end());
     }
 
     /**
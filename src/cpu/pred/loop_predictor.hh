@@ -47,6 +47,7 @@
 #include "base/random.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
+#include "cpu/pred/pooled_history.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -140,7 +141,7 @@ class LoopPredictor : public SimObject
     }
   public:
     // Primary branch history entry
-    struct BranchInfo
+    struct BranchInfo : public PooledHistory
     {
         uint16_t loopTag;
         uint16_t currentIter;
@@ -0,0 +1,129 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/multi_level_btb.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/BTB.hh"
+
+namespace gem5::branch_prediction
+{
+
+MultiLevelBTB::MultiLevelBTB(const MultiLevelBTBParams &p)
+    : BranchTargetBuffer(p),
+      levels(p.levels),
+      bubbles(p.bubbles),
+      lastBubble(p.numThreads, Cycles(0)),
+      mlStats(this)
+{
+    fatal_if(levels.empty(), "%s: A multi-level BTB needs a level.", name());
+    fatal_if(bubbles.size() != levels.size(),
+             "%s: %d bubbles given for %d BTB levels.", name(),
+             bubbles.size(), levels.size());
+}
+
+void
+MultiLevelBTB::memInvalidate()
+{
+    for (auto level : levels)
+        level->memInvalidate();
+}
+
+bool
+MultiLevelBTB::valid(ThreadID tid, Addr instPC)
+{
+    for (auto level : levels) {
+        if (level->valid(tid, instPC))
+            return true;
+    }
+    return false;
+}
+
+const PCStateBase *
+MultiLevelBTB::lookup(ThreadID tid, Addr instPC, BranchType type)
+{
+    stats.lookups[type]++;
+    lastBubble[tid] = Cycles(0);
+
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const PCStateBase *target = levels[i]->lookup(tid, instPC, type);
+        if (!target)
+            continue;
+
+        DPRINTF(BTB, "BTB: %#x hit in level %d.\n", instPC, i);
+        mlStats.levelHits[i]++;
+        lastBubble[tid] = bubbles[i];
+
+        // Fill the faster levels, the target lives in level i.
+        const StaticInstPtr inst = levels[i]->getInst(tid, instPC);
+        for (size_t j = 0; j < i; ++j)
+            levels[j]->update(tid, instPC, *target, type, inst);
+        return target;
+    }
+
+    stats.misses[type]++;
+    return nullptr;
+}
+
+const StaticInstPtr
+MultiLevelBTB::getInst(ThreadID tid, Addr instPC)
+{
+    for (auto level : levels) {
+        if (const StaticInstPtr inst = level->getInst(tid, instPC))
+            return inst;
+    }
+    return nullptr;
+}
+
+void
+MultiLevelBTB::update(ThreadID tid, Addr instPC, const PCStateBase &target,
+                      BranchType type, StaticInstPtr inst)
+{
+    stats.updates[type]++;
+
+    for (auto level : levels)
+        level->update(tid, instPC, target, type, inst);
+}
+
+Cycles
+MultiLevelBTB::lookupBubble(ThreadID tid) const
+{
+    return lastBubble[tid];
+}
+
+MultiLevelBTB::MultiLevelBTBStats::MultiLevelBTBStats(MultiLevelBTB *btb)
+    : statistics::Group(btb, "multiLevel"),
+      ADD_STAT(levelHits, statistics::units::Count::get(),
+               "Number of BTB lookups that hit in each level")
+{
+    levelHits
+        .init(btb->levels.size())
+        .flags(statistics::total | statistics::pdf);
+    for (size_t i = 0; i < btb->levels.size(); ++i)
+        levelHits.subname(i, csprintf("L%d", i));
+}
+
+} // namespace gem5::branch_prediction
@@ -0,0 +1,81 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_MULTI_LEVEL_BTB_HH__
+#define __CPU_PRED_MULTI_LEVEL_BTB_HH__
+
+#include <vector>
+
+#include "base/types.hh"
+#include "cpu/pred/btb.hh"
+#include "cpu/pred/simple_btb.hh"
+#include "params/MultiLevelBTB.hh"
+
+namespace gem5::branch_prediction
+{
+
+/**
+ * A hierarchy of BTBs, looked up from the smallest and fastest level
+ * down. A hit in a lower level fills the levels above it, and updates
+ * write all levels. Predicting a taken branch with a target from a
+ * slower level costs fetch the bubble configured for that level.
+ */
+class MultiLevelBTB : public BranchTargetBuffer
+{
+  public:
+    MultiLevelBTB(const MultiLevelBTBParams &params);
+
+    void memInvalidate() override;
+    bool valid(ThreadID tid, Addr instPC) override;
+    const PCStateBase *lookup(ThreadID tid, Addr instPC,
+                              BranchType type = BranchType::NoBranch) override;
+    void update(ThreadID tid, Addr instPC, const PCStateBase &target_pc,
+                BranchType type = BranchType::NoBranch,
+                StaticInstPtr inst = nullptr) override;
+    const StaticInstPtr getInst(ThreadID tid, Addr instPC) override;
+    Cycles lookupBubble(ThreadID tid) const override;
+
+  private:
+    /** The levels, smallest first. */
+    const std::vector<SimpleBTB *> levels;
+
+    /** Fetch bubble of a target found in each level. */
+    const std::vector<Cycles> bubbles;
+
+    /** Bubble of the last lookup of each thread. */
+    std::vector<Cycles> lastBubble;
+
+    struct MultiLevelBTBStats : public statistics::Group
+    {
+        MultiLevelBTBStats(MultiLevelBTB *btb);
+
+        /** Lookups that hit in each level. */
+        statistics::Vector levelHits;
+    } mlStats;
+};
+
+} // namespace gem5::branch_prediction
+
+#endif // __CPU_PRED_MULTI_LEVEL_BTB_HH__
@@ -56,6 +56,7 @@
 
 #include "base/random.hh"
 #include "cpu/pred/bpred_unit.hh"
+#include "cpu/pred/pooled_history.hh"
 #include "params/MultiperspectivePerceptron.hh"
 
 namespace gem5
@@ -70,7 +71,7 @@ class MultiperspectivePerceptron : public BPredUnit
     /**
      * Branch information data
      */
-    class MPPBranchInfo
+    class MPPBranchInfo : public PooledHistory
     {
         /** pc of the branch */
         const unsigned int pc;
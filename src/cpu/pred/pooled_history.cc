@@ -0,0 +1,91 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/pooled_history.hh"
+
+#include <array>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "base/slab_pool.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace
+{
+
+/** Granule and number of the pool size classes. */
+constexpr size_t ClassBytes = 16;
+constexpr size_t NumClasses = 32;
+
+/** Blocks per slab, sized for a few deep pipelines' worth of branches. */
+constexpr size_t BlocksPerSlab = 256;
+
+SlabPool *
+historyPool(size_t size)
+{
+    using Pools = std::array<std::unique_ptr<SlabPool>, NumClasses>;
+    static Pools pools = [] {
+        Pools p;
+        for (size_t i = 0; i < NumClasses; i++) {
+            p[i] = std::make_unique<SlabPool>(
+                "bpHistory" + std::to_string((i + 1) * ClassBytes),
+                (i + 1) * ClassBytes, BlocksPerSlab);
+        }
+        return p;
+    }();
+
+    const size_t cls = (size + ClassBytes - 1) / ClassBytes;
+    if (cls == 0 || cls > NumClasses)
+        return nullptr;
+    return pools[cls - 1].get();
+}
+
+} // anonymous namespace
+
+void *
+PooledHistory::operator new(size_t size)
+{
+    if (SlabPool *pool = historyPool(size))
+        return pool->allocate();
+    return ::operator new(size);
+}
+
+void
+PooledHistory::operator delete(void *ptr, size_t size)
+{
+    if (SlabPool *pool = historyPool(size))
+        pool->deallocate(ptr);
+    else
+        ::operator delete(ptr);
+}
+
+} // namespace branch_prediction
+} // namespace gem5
@@ -44,6 +44,7 @@
 #include "base/statistics.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/pred/indirect.hh"
+#include "cpu/pred/pooled_history.hh"
 #include "params/SimpleIndirectPredictor.hh"
 
 namespace gem5
@@ -109,7 +110,7 @@ class SimpleIndirectPredictor : public IndirectPredictor
     /** Indirect branch history information
      * Used for prediction, update and recovery
      */
-    struct IndirectHistory
+    struct IndirectHistory : public PooledHistory
     {
         /* data */
         Addr pcAddr;
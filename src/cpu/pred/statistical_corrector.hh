@@ -45,6 +45,7 @@
 
 #include "base/statistics.hh"
 #include "base/types.hh"
+#include "cpu/pred/pooled_history.hh"
 #include "cpu/static_inst.hh"
 #include "sim/sim_object.hh"
 
@@ -220,7 +221,7 @@ class StatisticalCorrector : public SimObject
     } stats;
 
   public:
-    struct BranchInfo
+    struct BranchInfo : public PooledHistory
     {
         BranchInfo() : lowConf(false), highConf(false), altConf(false),
               medConf(false), scPred(false), lsum(0), thres(0),
@@ -65,6 +65,7 @@
 #include "base/random.hh"
 #include "base/types.hh"
 #include "cpu/pred/bpred_unit.hh"
+#include "cpu/pred/pooled_history.hh"
 #include "cpu/pred/tage_base.hh"
 #include "params/TAGE.hh"
 
@@ -81,7 +82,7 @@ class TAGE: public BPredUnit
 
     Random::RandomPtr rng = Random::genRandom();
 
-    struct TageBranchInfo
+    struct TageBranchInfo : public PooledHistory
     {
         TAGEBase::BranchInfo *tageBranchInfo;
 
@@ -38,6 +38,8 @@
 
 #include "cpu/pred/tage_base.hh"
 
+#include <cstring>
+
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "debug/Fetch.hh"
@@ -311,29 +313,32 @@ TAGEBase::updateGHist(ThreadID tid, uint64_t bv, uint8_t n)
         // Copy beginning of globalHistoryBuffer to end, such that
         // the last maxHist outcomes are still reachable
         // through globalHist[0 .. maxHist - 1].
-        for (int i = 0; i < maxHist; i++) {
-            tHist.globalHist[histBufferSize - maxHist + i] =
-                tHist.globalHist[tHist.ptGhist + i];
-        }
+        std::memmove(&tHist.globalHist[histBufferSize - maxHist],
+                     &tHist.globalHist[tHist.ptGhist], maxHist);
 
         tHist.ptGhist = histBufferSize - maxHist;
     }
 
     // Update the global history
+    FoldedHistory *indices = tHist.computeIndices;
+    FoldedHistory *tags0 = tHist.computeTags[0];
+    FoldedHistory *tags1 = tHist.computeTags[1];
     for (int i = 0; i < n; i++) {
-        // Shift the next bit of the bit vector into the history
-        // Use `at` to check for out-of-bounds access.
+        // Shift the next bit of the bit vector into the history. The
+        // rollover above guarantees that ptGhist stays in bounds.
+        assert(tHist.ptGhist > 0);
         tHist.ptGhist--;
-        tHist.globalHist.at(tHist.ptGhist) = (bv & 1) ? 1 : 0;
+        const unsigned bit = bv & 1;
+        tHist.globalHist[tHist.ptGhist] = bit;
         bv >>= 1;
 
         // Update the folded histories with the new bit.
-        uint8_t *gh_ptr = &(tHist.globalHist[tHist.ptGhist]);
+        const uint8_t *gh_ptr = &(tHist.globalHist[tHist.ptGhist]);
 
         for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].update(gh_ptr);
-            tHist.computeTags[0][i].update(gh_ptr);
-            tHist.computeTags[1][i].update(gh_ptr);
+            indices[i].update(bit, gh_ptr);
+            tags0[i].update(bit, gh_ptr);
+            tags1[i].update(bit, gh_ptr);
         }
     }
 }
@@ -707,14 +712,18 @@ TAGEBase::restoreHistState(ThreadID tid, BranchInfo* bi)
     //  RESTORE HISTORIES
     // Shift out the inserted bits from the folded history
     // and the global history vector
+    FoldedHistory *indices = tHist.computeIndices;
+    FoldedHistory *tags0 = tHist.computeTags[0];
+    FoldedHistory *tags1 = tHist.computeTags[1];
     for (int n = 0; n < bi->nGhist; n++) {
-        uint8_t *gh_ptr = &(tHist.globalHist[tHist.ptGhist]);
+        const uint8_t *gh_ptr = &(tHist.globalHist[tHist.ptGhist]);
+        const unsigned bit = gh_ptr[0];
 
         // First revert the folded history
         for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].restore(gh_ptr);
-            tHist.computeTags[0][i].restore(gh_ptr);
-            tHist.computeTags[1][i].restore(gh_ptr);
+            indices[i].restore(bit, gh_ptr);
+            tags0[i].restore(bit, gh_ptr);
+            tags1[i].restore(bit, gh_ptr);
         }
         tHist.ptGhist++;
     }
@@ -53,6 +53,7 @@
 
 #include "base/statistics.hh"
 #include "cpu/null_static_inst.hh"
+#include "cpu/pred/pooled_history.hh"
 #include "cpu/static_inst.hh"
 #include "params/TAGEBase.hh"
 #include "sim/sim_object.hh"
@@ -72,13 +73,13 @@ class TAGEBase : public SimObject
   protected:
     // Prediction Structures
 
-    // Tage Entry
+    // Tage Entry, ordered so that an entry packs into 4 bytes
     struct TageEntry
     {
-        int8_t ctr;
         uint16_t tag;
+        int8_t ctr;
         uint8_t u;
-        TageEntry() : ctr(0), tag(0), u(0) { }
+        TageEntry() : tag(0), ctr(0), u(0) { }
     };
 
     // Folded History Table - compressed history
@@ -91,6 +92,7 @@ class TAGEBase : public SimObject
         int origLength;
         int outpoint;
         int bufferSize;
+        unsigned mask;
 
         FoldedHistory()
         {
@@ -102,20 +104,33 @@ class TAGEBase : public SimObject
             origLength = original_length;
             compLength = compressed_length;
             outpoint = original_length % compressed_length;
+            mask = (1ULL << compLength) - 1;
+        }
+
+        void update(const uint8_t * h)
+        {
+            update(h[0], h);
         }
 
-        void update(uint8_t * h)
+        /** Update with the newest bit h[0] already loaded in bit. */
+        void update(unsigned bit, const uint8_t * h)
         {
-            comp = (comp << 1) | h[0];
+            comp = (comp << 1) | bit;
             comp ^= h[origLength] << outpoint;
             comp ^= (comp >> compLength);
-            comp &= (1ULL << compLength) - 1;
+            comp &= mask;
+        }
+
+        void restore(const uint8_t * h)
+        {
+            restore(h[0], h);
         }
 
-        void restore(uint8_t * h)
+        /** Restore with the newest bit h[0] already loaded in bit. */
+        void restore(unsigned bit, const uint8_t * h)
         {
             comp ^= h[origLength] << outpoint;
-            auto tmp = (comp & 1) ^ h[0];
+            auto tmp = (comp & 1) ^ bit;
             comp = (tmp << (compLength-1)) | (comp >> 1);
         }
     };
@@ -133,7 +148,7 @@ class TAGEBase : public SimObject
     };
 
     // Primary branch history entry
-    struct BranchInfo
+    struct BranchInfo : public PooledHistory
     {
         const Addr branchPC;
         const bool condBranch;
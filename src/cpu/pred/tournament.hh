@@ -44,9 +44,10 @@
 
 #include <vector>
 
-#include "base/sat_counter.hh"
+#include "base/sat_counter_array.hh"
 #include "base/types.hh"
 #include "cpu/pred/bpred_unit.hh"
+#include "cpu/pred/pooled_history.hh"
 #include "params/TournamentBP.hh"
 
 namespace gem5
@@ -114,7 +115,7 @@ class TournamentBP : public BPredUnit
      * when the BP can use this information to update/restore its
      * state properly.
      */
-    struct BPHistory
+    struct BPHistory : public PooledHistory
     {
 #ifdef GEM5_DEBUG
         BPHistory()
@@ -144,7 +145,7 @@ class TournamentBP : public BPredUnit
     unsigned localCtrBits;
 
     /** Local counters. */
-    std::vector<SatCounter8> localCtrs;
+    SatCounterArray localCtrs;
 
     /** Array of local history table entries. */
     std::vector<unsigned> localHistoryTable;
@@ -162,7 +163,7 @@ class TournamentBP : public BPredUnit
     unsigned globalCtrBits;
 
     /** Array of counters that make up the global predictor. */
-    std::vector<SatCounter8> globalCtrs;
+    SatCounterArray globalCtrs;
 
     /** Global history register. Contains as much history as specified by
      *  globalHistoryBits. Actual number of bits used is determined by
@@ -192,7 +193,7 @@ class TournamentBP : public BPredUnit
     unsigned choiceCtrBits;
 
     /** Array of counters that make up the choice predictor. */
-    std::vector<SatCounter8> choiceCtrs;
+    SatCounterArray choiceCtrs;
 
     /** Thresholds for the counter value; above the threshold is taken,
      *  equal to or below the threshold is not taken.
@@ -62,3 +62,8 @@ class PcCountTracker(ProbeListenerObject):
     targets = VectorParam.PcCountPair("the target PC Count pairs")
     core = Param.BaseCPU("the connected cpu")
     ptmanager = Param.PcCountTrackerManager("the PcCountTracker manager")
+    use_pc_events = Param.Bool(
+        False,
+        "count the target PCs with PC events on the core's threads rather "
+        "than by checking every committed instruction's PC",
+    )
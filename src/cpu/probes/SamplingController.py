@@ -0,0 +1,112 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+from m5.objects import SimObject
+from m5.params import *
+from m5.util.pybind import *
+
+
+class SamplingController(SimObject):
+    """
+    SMARTS style sampling controller. It alternates functional warming,
+    detailed warming and measurement intervals, raising an exit event with
+    a "sampling: <interval>" cause at the start of each of them, and writes
+    a report with the mean CPI over the samples and its confidence
+    interval.
+
+    The warming CPUs are expected to be AtomicSimpleCPUs, so that the
+    caches are kept warm through atomic accesses. To keep branch
+    predictors warm as well, give each warming CPU the same branchPred
+    object as its detailed counterpart.
+
+    Sampling can start right away (start_sampling) or when the script calls
+    startSampling(), e.g. once a PcCountTracker exit event marks the
+    beginning of the region of interest. A simulation loop looks like:
+
+        while True:
+            cause = m5.simulate().getCause()
+            if not controller.switch_cpus(system, cause):
+                break
+            if controller.getPhase() == "done":
+                break
+    """
+
+    type = "SamplingController"
+    cxx_header = "cpu/probes/sampling_controller.hh"
+    cxx_class = "gem5::SamplingController"
+
+    cxx_exports = [
+        PyBindMethod("startSampling"),
+        PyBindMethod("stopSampling"),
+        PyBindMethod("getPhase"),
+        PyBindMethod("getNumSamples"),
+        PyBindMethod("getMeanCpi"),
+        PyBindMethod("getCpiConfidenceInterval"),
+        PyBindMethod("dumpReport"),
+    ]
+
+    warming_cpus = VectorParam.BaseCPU("CPUs used for functional warming")
+    detailed_cpus = VectorParam.BaseCPU(
+        "CPUs used for detailed warming and measurement, one per warming CPU"
+    )
+    functional_warming_insts = Param.Counter(
+        2000000, "Instructions per functional warming interval"
+    )
+    detailed_warming_insts = Param.Counter(
+        2000, "Instructions per detailed warming interval"
+    )
+    measurement_insts = Param.Counter(
+        1000, "Instructions per measurement interval"
+    )
+    max_samples = Param.Counter(0, "Number of samples to take, 0 for no limit")
+    confidence_z = Param.Float(
+        3.0, "z-score of the reported confidence interval (3.0 is 99.7%)"
+    )
+    target_error = Param.Float(
+        0.03, "Relative error used to suggest a number of samples"
+    )
+    report_file = Param.String("sampling.txt", "Report file name")
+    start_sampling = Param.Bool(True, "Start sampling right away")
+
+    def switch_cpus(self, system, cause):
+        """
+        Perform the CPU switch requested by a sampling exit event. Returns
+        False if the exit cause was not raised by the controller.
+        """
+        import m5
+
+        if not cause.startswith("sampling: "):
+            return False
+
+        warming = list(self.warming_cpus)
+        detailed = list(self.detailed_cpus)
+        detailed_active = not detailed[0].switchedOut()
+        if cause == "sampling: functional warming" and detailed_active:
+            m5.switchCpus(system, list(zip(detailed, warming)))
+        elif (
+            cause in ("sampling: detailed warming", "sampling: measurement")
+            and not detailed_active
+        ):
+            m5.switchCpus(system, list(zip(warming, detailed)))
+        return True
@@ -34,6 +34,7 @@ namespace gem5
 
 PcCountTracker::PcCountTracker(const PcCountTrackerParams &p)
     : ProbeListenerObject(p),
+      usePcEvents(p.use_pc_events),
       cpuptr(p.core),
       manager(p.ptmanager)
 {
@@ -49,6 +50,19 @@ PcCountTracker::PcCountTracker(const PcCountTrackerParams &p)
 void
 PcCountTracker::regProbeListeners()
 {
+    if (usePcEvents) {
+        // arm a PC event on every target PC of each thread of the core,
+        // instead of listening to every committed instruction
+        for (int i = 0; i < cpuptr->numContexts(); i++) {
+            ThreadContext *tc = cpuptr->getContext(i);
+            for (Addr pc : targetPC) {
+                targetEvents.emplace_back(
+                    new TargetPCEvent(tc, pc, manager));
+            }
+        }
+        return;
+    }
+
     // connect the probe listener with the probe "RetriedInstsPC" in the
     // corresponding core.
     // when "RetiredInstsPC" notifies the probe listener, then the function
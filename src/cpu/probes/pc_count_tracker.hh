@@ -29,8 +29,11 @@
 #ifndef __CPU_PROBES_PC_COUNT_TRACKER_HH__
 #define __CPU_PROBES_PC_COUNT_TRACKER_HH__
 
+#include <memory>
 #include <unordered_set>
+#include <vector>
 
+#include "cpu/pc_event.hh"
 #include "cpu/probes/pc_count_tracker_manager.hh"
 #include "params/PcCountTracker.hh"
 #include "sim/probe/probe_listener_object.hh"
@@ -55,12 +58,39 @@ class PcCountTracker : public ProbeListenerObject
     void checkPc(const Addr& pc);
 
   private:
+    /**
+     * A PC event on one of the target PCs, which notifies the
+     * PcCountTrackerManager like checkPc() does for a matching PC
+     */
+    class TargetPCEvent : public PCEvent
+    {
+      private:
+        PcCountTrackerManager *manager;
+
+      public:
+        TargetPCEvent(PCEventScope *s, Addr pc,
+                      PcCountTrackerManager *_manager)
+            : PCEvent(s, "pc count target", pc), manager(_manager)
+        {}
+
+        void process(ThreadContext *tc) override { manager->checkCount(pc()); }
+    };
+
     /**
      * a set of Program Counter addresses that should notify the
      * PcCounterTrackerManager for
      */
     std::unordered_set<Addr> targetPC;
 
+    /**
+     * if true, the target PCs are counted by PC events on the core's
+     * threads, so that other instructions do not cost a callback
+     */
+    bool usePcEvents;
+
+    /** the PC events on the target PCs, if usePcEvents is set */
+    std::vector<std::unique_ptr<TargetPCEvent>> targetEvents;
+
     /** the core this PcCountTracker is tracking at */
     BaseCPU *cpuptr;
 
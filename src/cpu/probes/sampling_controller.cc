@@ -0,0 +1,320 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/probes/sampling_controller.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/trace.hh"
+#include "debug/Sampling.hh"
+#include "sim/cur_tick.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+SamplingController::SamplingController(
+        const SamplingControllerParams &params)
+    : SimObject(params),
+      warmingCpus(params.warming_cpus),
+      detailedCpus(params.detailed_cpus),
+      functionalWarmingInsts(params.functional_warming_insts),
+      detailedWarmingInsts(params.detailed_warming_insts),
+      measurementInsts(params.measurement_insts),
+      maxSamples(params.max_samples),
+      confidenceZ(params.confidence_z),
+      targetError(params.target_error),
+      reportFile(params.report_file),
+      phase(Phase::Idle), phaseInsts(0), measurementStart(0),
+      cpuSampleInsts(detailedCpus.size(), 0),
+      totalMeasuredInsts(0), totalMeasuredCycles(0),
+      cpuMeasuredInsts(detailedCpus.size(), 0),
+      cpuMeasuredCycles(detailedCpus.size(), 0)
+{
+    fatal_if(detailedCpus.empty(),
+             "%s: at least one detailed CPU is needed.", name());
+    fatal_if(warmingCpus.size() != detailedCpus.size(),
+             "%s: there must be one warming CPU per detailed CPU.", name());
+    fatal_if(measurementInsts == 0,
+             "%s: the measurement interval can't be empty.", name());
+    fatal_if(confidenceZ <= 0, "%s: confidence_z must be positive.", name());
+
+    if (params.start_sampling) {
+        startSampling();
+    }
+}
+
+void
+SamplingController::regProbeListeners()
+{
+    // Warming CPU i and detailed CPU i run the same threads, so they
+    // share an index.
+    for (auto *cpus : {&warmingCpus, &detailedCpus}) {
+        for (size_t i = 0; i < cpus->size(); i++) {
+            listeners.push_back(
+                (*cpus)[i]->getProbeManager()->connect<RetiredInstsListener>(
+                    this, i));
+        }
+    }
+}
+
+std::string
+SamplingController::phaseName(Phase phase)
+{
+    switch (phase) {
+      case Phase::Idle:
+        return "idle";
+      case Phase::FunctionalWarming:
+        return "functional warming";
+      case Phase::DetailedWarming:
+        return "detailed warming";
+      case Phase::Measurement:
+        return "measurement";
+      case Phase::Done:
+        return "done";
+      default:
+        panic("Unknown sampling phase %d.", static_cast<int>(phase));
+    }
+}
+
+uint64_t
+SamplingController::phaseLength(Phase phase) const
+{
+    switch (phase) {
+      case Phase::FunctionalWarming:
+        return functionalWarmingInsts;
+      case Phase::DetailedWarming:
+        return detailedWarmingInsts;
+      case Phase::Measurement:
+        return measurementInsts;
+      default:
+        return 0;
+    }
+}
+
+void
+SamplingController::startSampling()
+{
+    if (phase != Phase::Idle && phase != Phase::Done) {
+        return;
+    }
+    sampleCpi.clear();
+    totalMeasuredInsts = 0;
+    totalMeasuredCycles = 0;
+    std::fill(cpuMeasuredInsts.begin(), cpuMeasuredInsts.end(), 0);
+    std::fill(cpuMeasuredCycles.begin(), cpuMeasuredCycles.end(), 0);
+    phase = Phase::FunctionalWarming;
+    phaseInsts = 0;
+    DPRINTF(Sampling, "Sampling started\n");
+}
+
+void
+SamplingController::stopSampling()
+{
+    if (phase == Phase::Idle || phase == Phase::Done) {
+        return;
+    }
+    phase = Phase::Done;
+    DPRINTF(Sampling, "Sampling stopped after %d samples\n",
+            sampleCpi.size());
+    dumpReport();
+}
+
+void
+SamplingController::enterPhase(Phase next)
+{
+    // Intervals of length zero are skipped, but functional warming is
+    // never skipped so that there is always a point to switch CPUs at.
+    while (next != Phase::Done && next != Phase::FunctionalWarming &&
+            phaseLength(next) == 0) {
+        next = next == Phase::DetailedWarming ? Phase::Measurement :
+            Phase::FunctionalWarming;
+    }
+
+    phase = next;
+    phaseInsts = 0;
+    if (next == Phase::Measurement) {
+        measurementStart = curTick();
+        std::fill(cpuSampleInsts.begin(), cpuSampleInsts.end(), 0);
+    }
+    DPRINTF(Sampling, "Entering %s\n", phaseName(next));
+
+    if (next == Phase::Done) {
+        dumpReport();
+    }
+    exitSimLoopNow("sampling: " + phaseName(next));
+}
+
+void
+SamplingController::retiredInsts(size_t cpu, uint64_t insts)
+{
+    if (phase == Phase::Idle || phase == Phase::Done) {
+        return;
+    }
+
+    phaseInsts += insts;
+    if (phase == Phase::Measurement) {
+        cpuSampleInsts[cpu] += insts;
+    }
+    if (phaseInsts < phaseLength(phase)) {
+        return;
+    }
+
+    switch (phase) {
+      case Phase::FunctionalWarming:
+        enterPhase(Phase::DetailedWarming);
+        break;
+      case Phase::DetailedWarming:
+        enterPhase(Phase::Measurement);
+        break;
+      case Phase::Measurement:
+        {
+            // The CPI of the sample is the cycles of every CPU that ran,
+            // each in its own clock, over the instructions they retired.
+            // CPUs that retired nothing (e.g. halted) are left out.
+            const Tick elapsed = curTick() - measurementStart;
+            uint64_t insts = 0;
+            double cycles = 0;
+            for (size_t i = 0; i < detailedCpus.size(); i++) {
+                if (cpuSampleInsts[i] == 0) {
+                    continue;
+                }
+                const double cpu_cycles =
+                    double(elapsed) / detailedCpus[i]->clockPeriod();
+                insts += cpuSampleInsts[i];
+                cycles += cpu_cycles;
+                cpuMeasuredInsts[i] += cpuSampleInsts[i];
+                cpuMeasuredCycles[i] += cpu_cycles;
+            }
+            if (insts > 0) {
+                double cpi = cycles / insts;
+                sampleCpi.push_back(cpi);
+                totalMeasuredInsts += insts;
+                totalMeasuredCycles += cycles;
+                DPRINTF(Sampling, "Sample %d: %d insts, CPI %.4f\n",
+                        sampleCpi.size(), insts, cpi);
+            } else {
+                warn("%s: no detailed CPU retired instructions during a "
+                     "measurement interval, was the switch missed?", name());
+            }
+            if (maxSamples != 0 && sampleCpi.size() >= maxSamples) {
+                enterPhase(Phase::Done);
+            } else {
+                enterPhase(Phase::FunctionalWarming);
+            }
+        }
+        break;
+      default:
+        panic("Unexpected sampling phase %s.", phaseName(phase));
+    }
+}
+
+double
+SamplingController::getMeanCpi() const
+{
+    if (sampleCpi.empty()) {
+        return 0;
+    }
+    double sum = 0;
+    for (double cpi : sampleCpi) {
+        sum += cpi;
+    }
+    return sum / sampleCpi.size();
+}
+
+double
+SamplingController::cpiStdDev() const
+{
+    if (sampleCpi.size() < 2) {
+        return 0;
+    }
+    double mean = getMeanCpi();
+    double sq = 0;
+    for (double cpi : sampleCpi) {
+        sq += (cpi - mean) * (cpi - mean);
+    }
+    return std::sqrt(sq / (sampleCpi.size() - 1));
+}
+
+double
+SamplingController::getCpiConfidenceInterval() const
+{
+    if (sampleCpi.empty()) {
+        return 0;
+    }
+    return confidenceZ * cpiStdDev() / std::sqrt(double(sampleCpi.size()));
+}
+
+void
+SamplingController::dumpReport() const
+{
+    OutputStream *os = simout.create(reportFile);
+    std::ostream &out = *os->stream();
+
+    const size_t n = sampleCpi.size();
+    const double mean = getMeanCpi();
+    const double stddev = cpiStdDev();
+    const double ci = getCpiConfidenceInterval();
+    // Coefficient of variation, and the number of samples needed to get
+    // the mean within targetError of its true value (SMARTS, eq. 1).
+    const double cov = mean > 0 ? stddev / mean : 0;
+    const double needed = targetError > 0 ?
+        std::ceil(std::pow(confidenceZ * cov / targetError, 2)) : 0;
+
+    ccprintf(out, "samples                  %d\n", n);
+    ccprintf(out, "functional_warming_insts %d\n", functionalWarmingInsts);
+    ccprintf(out, "detailed_warming_insts   %d\n", detailedWarmingInsts);
+    ccprintf(out, "measurement_insts        %d\n", measurementInsts);
+    ccprintf(out, "measured_insts           %d\n", totalMeasuredInsts);
+    ccprintf(out, "measured_cycles          %.0f\n", totalMeasuredCycles);
+    ccprintf(out, "cpi_mean                 %.6f\n", mean);
+    ccprintf(out, "cpi_stddev               %.6f\n", stddev);
+    ccprintf(out, "cpi_cov                  %.6f\n", cov);
+    ccprintf(out, "cpi_confidence_z         %.3f\n", confidenceZ);
+    ccprintf(out, "cpi_confidence_interval  %.6f %.6f\n", mean - ci,
+             mean + ci);
+    ccprintf(out, "cpi_relative_error       %.6f\n",
+             mean > 0 ? ci / mean : 0);
+    ccprintf(out, "ipc_mean                 %.6f\n",
+             totalMeasuredCycles > 0 ?
+             totalMeasuredInsts / totalMeasuredCycles : 0);
+    ccprintf(out, "samples_for_target_error %.0f\n", needed);
+    for (size_t i = 0; i < detailedCpus.size(); i++) {
+        ccprintf(out, "cpu[%d].measured_insts %d\n", i, cpuMeasuredInsts[i]);
+        ccprintf(out, "cpu[%d].cpi %.6f\n", i, cpuMeasuredInsts[i] > 0 ?
+                 cpuMeasuredCycles[i] / cpuMeasuredInsts[i] : 0);
+    }
+    for (size_t i = 0; i < n; i++) {
+        ccprintf(out, "sample[%d].cpi %.6f\n", i, sampleCpi[i]);
+    }
+
+    simout.close(os);
+}
+
+} // namespace gem5
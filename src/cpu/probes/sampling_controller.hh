@@ -0,0 +1,190 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PROBES_SAMPLING_CONTROLLER_HH__
+#define __CPU_PROBES_SAMPLING_CONTROLLER_HH__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+#include "cpu/base.hh"
+#include "params/SamplingController.hh"
+#include "sim/probe/probe.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * Drives a SMARTS style sampled simulation. Execution is split into
+ * periods, each made of three intervals, measured in retired
+ * instructions across all the tracked CPUs:
+ * - functional warming: the warming CPUs (usually AtomicSimpleCPUs)
+ *   run the workload, keeping caches and branch predictors up to date;
+ * - detailed warming: the detailed CPUs run, to fill the pipeline and
+ *   other short-lived microarchitectural state, without being measured;
+ * - measurement: the detailed CPUs run and their CPI is sampled.
+ *
+ * At the end of each interval the controller exits the simulation loop
+ * with a "sampling: <next interval>" cause, and the simulation script is
+ * in charge of switching CPUs (see SamplingController.switch_cpus()).
+ * Once all the samples have been taken, or whenever the script asks for
+ * it, the per-sample CPIs are aggregated into a report with the mean, the
+ * confidence interval of the mean and the number of samples needed to
+ * reach the target error.
+ */
+class SamplingController : public SimObject
+{
+  public:
+    enum class Phase
+    {
+        Idle,
+        FunctionalWarming,
+        DetailedWarming,
+        Measurement,
+        Done
+    };
+
+    SamplingController(const SamplingControllerParams &params);
+
+    void regProbeListeners() override;
+
+    /**
+     * Called when one of the tracked CPUs retires instructions.
+     * @param cpu index of the CPU in warming_cpus or detailed_cpus.
+     * @param insts number of retired instructions, usually 1.
+     */
+    void retiredInsts(size_t cpu, uint64_t insts);
+
+    /** Start sampling, beginning with a functional warming interval. */
+    void startSampling();
+
+    /** Stop sampling and write the report. */
+    void stopSampling();
+
+    /** @return the name of the current interval. */
+    std::string getPhase() const { return phaseName(phase); }
+
+    /** @return the number of samples taken so far. */
+    uint64_t getNumSamples() const { return sampleCpi.size(); }
+
+    /** @return the mean CPI over the samples taken so far. */
+    double getMeanCpi() const;
+
+    /**
+     * @return half the width of the confidence interval of the mean CPI,
+     *         in CPI units.
+     */
+    double getCpiConfidenceInterval() const;
+
+    /** Write the report to the configured output file. */
+    void dumpReport() const;
+
+  private:
+    /** Forwards the RetiredInsts probe of one CPU, tagged with its index. */
+    struct RetiredInstsListener : public ProbeListenerArgBase<uint64_t>
+    {
+        RetiredInstsListener(SamplingController *parent, size_t cpu)
+            : ProbeListenerArgBase("RetiredInsts"), parent(parent), cpu(cpu)
+        {}
+
+        void
+        notify(const uint64_t &insts) override
+        {
+            parent->retiredInsts(cpu, insts);
+        }
+
+        SamplingController *const parent;
+        const size_t cpu;
+    };
+
+    static std::string phaseName(Phase phase);
+
+    /** Enter the given interval and raise the matching exit event. */
+    void enterPhase(Phase next);
+
+    /** @return the length of the given interval, in instructions. */
+    uint64_t phaseLength(Phase phase) const;
+
+    /** Sample standard deviation of the per-sample CPIs. */
+    double cpiStdDev() const;
+
+    /** CPUs used for functional warming. */
+    const std::vector<BaseCPU *> warmingCpus;
+
+    /** CPUs used for detailed warming and measurement. */
+    const std::vector<BaseCPU *> detailedCpus;
+
+    /** Length of each interval, in instructions. */
+    const uint64_t functionalWarmingInsts;
+    const uint64_t detailedWarmingInsts;
+    const uint64_t measurementInsts;
+
+    /** Number of samples to take, 0 for no limit. */
+    const uint64_t maxSamples;
+
+    /** z-score of the reported confidence interval. */
+    const double confidenceZ;
+
+    /** Target relative error used to suggest a number of samples. */
+    const double targetError;
+
+    /** Name of the report in the output directory. */
+    const std::string reportFile;
+
+    Phase phase;
+
+    /** Instructions retired in the current interval, over all CPUs. */
+    uint64_t phaseInsts;
+
+    /** Tick at which the current measurement interval started. */
+    Tick measurementStart;
+
+    /** Instructions retired by each CPU in the current measurement. */
+    std::vector<uint64_t> cpuSampleInsts;
+
+    /**
+     * CPI of each sample. These are kept outside of the stats framework
+     * since the script usually resets stats around each measurement.
+     */
+    std::vector<double> sampleCpi;
+
+    /**
+     * Instructions and cycles measured over all the samples, in total and
+     * for each detailed CPU. Cycles are counted in the clock of each CPU.
+     */
+    uint64_t totalMeasuredInsts;
+    double totalMeasuredCycles;
+    std::vector<uint64_t> cpuMeasuredInsts;
+    std::vector<double> cpuMeasuredCycles;
+
+    std::vector<ProbeListenerPtr<>> listeners;
+};
+
+} // namespace gem5
+
+#endif // __CPU_PROBES_SAMPLING_CONTROLLER_HH__
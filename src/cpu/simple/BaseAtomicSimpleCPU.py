@@ -62,6 +62,19 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
 
+    # Functional cache warming: plain reads and writes that hit in these
+    # caches update their tags, replacement state and data directly
+    # through BaseCache::warmAccess, without building a packet or going
+    # down the atomic path. Everything else (misses, upgrades, LL/SC,
+    # uncacheable accesses...) still takes the atomic path, which keeps
+    # the hierarchy coherent and checkpointable.
+    warm_icache = Param.BaseCache(
+        NULL, "L1 instruction cache to warm directly on fetch hits"
+    )
+    warm_dcache = Param.BaseCache(
+        NULL, "L1 data cache to warm directly on load and store hits"
+    )
+
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
         simpoint.interval = interval
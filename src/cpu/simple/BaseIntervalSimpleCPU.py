@@ -0,0 +1,76 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.BaseAtomicSimpleCPU import BaseAtomicSimpleCPU
+from m5.objects.BranchPredictor import *
+from m5.params import *
+from m5.proxy import *
+
+
+class BaseIntervalSimpleCPU(BaseAtomicSimpleCPU):
+    """Simple CPU model based on the atomic CPU that estimates the
+    timing of an out-of-order core using interval analysis.
+
+    Instructions execute functionally as in the atomic CPU and are
+    dispatched at the width of the CPU. Branch mispredictions,
+    instruction fetch latency and long-latency loads add penalties on
+    top of that, long-latency loads that are independent and close
+    enough to fit in the reorder buffer together overlap. The
+    latencies come from the atomic accesses to the configured caches
+    and memories.
+
+    """
+
+    type = "BaseIntervalSimpleCPU"
+    cxx_header = "cpu/simple/interval.hh"
+    cxx_class = "gem5::IntervalSimpleCPU"
+
+    width = 4
+
+    branchPred = Param.BranchPredictor(
+        TournamentBP(numThreads=Parent.numThreads), "Branch Predictor"
+    )
+
+    rob_size = Param.Unsigned(192, "Number of reorder buffer entries")
+    mispredict_penalty = Param.Cycles(
+        12, "Cycles to resolve a mispredicted branch and refill the front end"
+    )
+    hidden_fetch_latency = Param.Cycles(
+        4, "Instruction fetch latency hidden by the front end"
+    )
+    long_latency_threshold = Param.Cycles(
+        12,
+        "Load latency above which a load blocks the head of the reorder "
+        "buffer",
+    )
+
+    timing_thread = Param.Bool(
+        False,
+        "Run the timing model on a separate host thread, behind the "
+        "functional core",
+    )
+    timing_slack = Param.Unsigned(
+        4096,
+        "Instructions the functional core runs ahead of the timing model "
+        "when it has a thread of its own",
+    )
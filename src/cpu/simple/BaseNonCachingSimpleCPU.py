@@ -44,6 +44,20 @@ class BaseNonCachingSimpleCPU(BaseAtomicSimpleCPU):
     is as a substitute for hardware virtualized CPUs when
     stress-testing the memory system.
 
+    Once a memory has handed out a backdoor, instruction fetches and
+    plain data accesses to it are done directly through the backdoor,
+    which makes this model the fastest way to fast-forward to a region
+    of interest before switching to a detailed CPU.
+
+    With cache_blocks set, the basic blocks run from backdoors are also
+    decoded once and replayed without being fetched or decoded again,
+    for the ISAs whose decoders support it. A block is checked against
+    memory each time it is entered and dropped once its code is written,
+    so self-modifying code still works. Instructions with side effects
+    on the CPU (system calls, serializing instructions, microcode) and
+    traps take the regular path. A block runs in one event, with the
+    cycles of its instructions added at its end.
+
     """
 
     type = "BaseNonCachingSimpleCPU"
@@ -52,6 +66,14 @@ class BaseNonCachingSimpleCPU(BaseAtomicSimpleCPU):
 
     numThreads = 1
 
+    cache_blocks = Param.Bool(False, "Replay decoded basic blocks")
+    max_block_insts = Param.Unsigned(
+        64, "Maximum number of instructions in a cached block"
+    )
+    max_cached_blocks = Param.Unsigned(
+        16384, "Number of cached blocks above which the cache is flushed"
+    )
+
     @classmethod
     def memory_mode(cls):
         return "atomic_noncaching"
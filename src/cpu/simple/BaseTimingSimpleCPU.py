@@ -33,6 +33,16 @@ class BaseTimingSimpleCPU(BaseSimpleCPU):
     cxx_header = "cpu/simple/timing.hh"
     cxx_class = "gem5::TimingSimpleCPU"
 
+    functional_fetch = Param.Bool(
+        False,
+        "Fetch instructions directly through memory backdoors when the "
+        "instruction side offers one, without modelling the I-side memory "
+        "system",
+    )
+    functional_fetch_latency = Param.Cycles(
+        1, "Latency of instruction fetches made through a backdoor"
+    )
+
     @classmethod
     def memory_mode(cls):
         return "timing"
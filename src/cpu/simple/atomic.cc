@@ -48,6 +48,7 @@
 #include "debug/Drain.hh"
 #include "debug/ExecFaulting.hh"
 #include "debug/SimpleCPU.hh"
+#include "mem/cache/base.hh"
 #include "mem/packet.hh"
 #include "mem/packet_access.hh"
 #include "mem/physical.hh"
@@ -69,6 +70,10 @@ AtomicSimpleCPU::init()
     data_read_req->setContext(cid);
     data_write_req->setContext(cid);
     data_amo_req->setContext(cid);
+
+    fatal_if((warmICache || warmDCache) && system->bypassCaches(),
+             "%s: Caches can't be warmed when the memory system bypasses "
+             "them.", name());
 }
 
 AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
@@ -78,16 +83,17 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       width(p.width), locked(false),
       simulate_data_stalls(p.simulate_data_stalls),
       simulate_inst_stalls(p.simulate_inst_stalls),
+      warmICache(p.warm_icache), warmDCache(p.warm_dcache),
       icachePort(name() + ".icache_port"),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
       ppCommit(nullptr)
 {
     _status = Idle;
-    ifetch_req = std::make_shared<Request>();
-    data_read_req = std::make_shared<Request>();
-    data_write_req = std::make_shared<Request>();
-    data_amo_req = std::make_shared<Request>();
+    ifetch_req = makeRequest();
+    data_read_req = makeRequest();
+    data_write_req = makeRequest();
+    data_amo_req = makeRequest();
 }
 
 
@@ -274,6 +280,28 @@ AtomicSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
     return port.sendAtomic(pkt);
 }
 
+bool
+AtomicSimpleCPU::warmAccess(BaseCache *cache, const RequestPtr &req,
+                            uint8_t *data, bool is_write)
+{
+    if (!cache)
+        return false;
+
+    // Only plain reads and writes of the whole fragment can skip the
+    // packet. Writes are also snooped by the other threads of this CPU.
+    const MemCmd cmd = is_write ? Packet::makeWriteCmd(req) :
+        Packet::makeReadCmd(req);
+    if (cmd != (is_write ? MemCmd::WriteReq : MemCmd::ReadReq) ||
+        req->isUncacheable() || req->isLocalAccess() || req->isMasked() ||
+        req->getFlags().isSet(Request::STORE_NO_DATA) ||
+        (is_write && numThreads > 1)) {
+        return false;
+    }
+
+    return cache->warmAccess(req->getPaddr(), req->getSize(),
+                             req->isSecure(), is_write, data);
+}
+
 Tick
 AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
 {
@@ -391,6 +419,10 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t *data, unsigned size,
 
         // Now do the access.
         if (predicate && fault == NoFault &&
+            !req->getFlags().isSet(Request::NO_ACCESS) &&
+            warmAccess(warmDCache, req, data, false)) {
+            dcache_access = true;
+        } else if (predicate && fault == NoFault &&
             !req->getFlags().isSet(Request::NO_ACCESS)) {
             Packet pkt(req, Packet::makeReadCmd(req));
             pkt.dataStatic(data);
@@ -491,7 +523,11 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                 }
             }
 
-            if (do_access && !req->getFlags().isSet(Request::NO_ACCESS)) {
+            if (do_access && !req->getFlags().isSet(Request::NO_ACCESS) &&
+                warmAccess(warmDCache, req, data, true)) {
+                dcache_access = true;
+            } else if (do_access &&
+                !req->getFlags().isSet(Request::NO_ACCESS)) {
                 Packet pkt(req, Packet::makeWriteCmd(req));
                 pkt.dataStatic(data);
 
@@ -625,9 +661,6 @@ AtomicSimpleCPU::tick()
         data_amo_req->setContext(cid);
     }
 
-    SimpleExecContext &t_info = *threadInfo[curThread];
-    SimpleThread *thread = t_info.thread;
-
     Tick latency = 0;
 
     for (int i = 0; i < width || locked; ++i) {
@@ -647,95 +680,110 @@ AtomicSimpleCPU::tick()
 
         serviceInstCountEvents();
 
-        Fault fault = NoFault;
+        latency += executeInst();
+    }
 
-        const PCStateBase &pc = thread->pcState();
+    if (tryCompleteDrain())
+        return;
 
-        bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
-        if (needToFetch) {
-            ifetch_req->taskId(taskId());
-            setupFetchRequest(ifetch_req);
-            fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
-                                                 BaseMMU::Execute);
-        }
+    // instruction takes at least one cycle
+    if (latency < clockPeriod())
+        latency = clockPeriod();
 
-        if (fault == NoFault) {
-            Tick icache_latency = 0;
-            bool icache_access = false;
-            dcache_access = false; // assume no dcache access
-
-            if (needToFetch) {
-                // This is commented out because the decoder would act like
-                // a tiny cache otherwise. It wouldn't be flushed when needed
-                // like the I cache. It should be flushed, and when that works
-                // this code should be uncommented.
-                //Fetch more instruction memory if necessary
-                //if (decoder.needMoreBytes())
-                //{
-                    icache_access = true;
-                    icache_latency = fetchInstMem();
-                //}
-            }
+    if (_status != Idle)
+        reschedule(tickEvent, curTick() + latency, true);
+}
+
+Tick
+AtomicSimpleCPU::executeInst()
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
 
-            preExecute();
+    Fault fault = NoFault;
 
-            Tick stall_ticks = 0;
-            if (curStaticInst) {
-                fault = curStaticInst->execute(&t_info, traceData);
+    const PCStateBase &pc = thread->pcState();
 
-                // keep an instruction count
-                if (fault == NoFault) {
-                    countInst();
-                    ppCommit->notify(std::make_pair(thread, curStaticInst));
-                } else if (traceData) {
-                    traceFault();
-                }
+    bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
+    if (needToFetch) {
+        ifetch_req->taskId(taskId());
+        setupFetchRequest(ifetch_req);
+        fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
+                                             BaseMMU::Execute);
+    }
 
-                if (fault != NoFault &&
-                    std::dynamic_pointer_cast<SyscallRetryFault>(fault)) {
-                    // Retry execution of system calls after a delay.
-                    // Prevents immediate re-execution since conditions which
-                    // caused the retry are unlikely to change every tick.
-                    stall_ticks += clockEdge(syscallRetryLatency) - curTick();
-                }
+    Tick stall_ticks = 0;
+    Tick icache_latency = 0;
+    bool icache_access = false;
+    dcache_access = false; // assume no dcache access
 
-                postExecute();
-            }
+    if (fault == NoFault) {
+        if (needToFetch) {
+            // This is commented out because the decoder would act like
+            // a tiny cache otherwise. It wouldn't be flushed when needed
+            // like the I cache. It should be flushed, and when that works
+            // this code should be uncommented.
+            //Fetch more instruction memory if necessary
+            //if (decoder.needMoreBytes())
+            //{
+                icache_access = true;
+                icache_latency = fetchInstMem();
+            //}
+        }
 
-            // @todo remove me after debugging with legion done
-            if (curStaticInst && (!curStaticInst->isMicroop() ||
-                        curStaticInst->isFirstMicroop())) {
-                instCnt++;
-            }
+        preExecute();
 
-            if (simulate_inst_stalls && icache_access)
-                stall_ticks += icache_latency;
+        if (curStaticInst) {
+            fault = curStaticInst->execute(&t_info, traceData);
 
-            if (simulate_data_stalls && dcache_access)
-                stall_ticks += dcache_latency;
+            // keep an instruction count
+            if (fault == NoFault) {
+                countInst();
+                ppCommit->notify(std::make_pair(thread, curStaticInst));
+            } else if (traceData) {
+                traceFault();
+            }
 
-            if (stall_ticks) {
-                // the atomic cpu does its accounting in ticks, so
-                // keep counting in ticks but round to the clock
-                // period
-                latency += divCeil(stall_ticks, clockPeriod()) *
-                    clockPeriod();
+            if (fault != NoFault &&
+                std::dynamic_pointer_cast<SyscallRetryFault>(fault)) {
+                // Retry execution of system calls after a delay.
+                // Prevents immediate re-execution since conditions which
+                // caused the retry are unlikely to change every tick.
+                stall_ticks += clockEdge(syscallRetryLatency) - curTick();
             }
 
+            postExecute();
+        }
+
+        // @todo remove me after debugging with legion done
+        if (curStaticInst && (!curStaticInst->isMicroop() ||
+                    curStaticInst->isFirstMicroop())) {
+            instCnt++;
         }
-        if (fault != NoFault || !t_info.stayAtPC)
-            advancePC(fault);
     }
+    if (fault != NoFault || !t_info.stayAtPC)
+        advancePC(fault);
 
-    if (tryCompleteDrain())
-        return;
+    stall_ticks += instStallTicks(icache_access, icache_latency);
 
-    // instruction takes at least one cycle
-    if (latency < clockPeriod())
-        latency = clockPeriod();
+    // the atomic cpu does its accounting in ticks, so
+    // keep counting in ticks but round to the clock
+    // period
+    return divCeil(stall_ticks, clockPeriod()) * clockPeriod();
+}
 
-    if (_status != Idle)
-        reschedule(tickEvent, curTick() + latency, true);
+Tick
+AtomicSimpleCPU::instStallTicks(bool icache_access, Tick icache_latency)
+{
+    Tick stall_ticks = 0;
+
+    if (simulate_inst_stalls && icache_access)
+        stall_ticks += icache_latency;
+
+    if (simulate_data_stalls && dcache_access)
+        stall_ticks += dcache_latency;
+
+    return stall_ticks;
 }
 
 Tick
@@ -743,6 +791,11 @@ AtomicSimpleCPU::fetchInstMem()
 {
     auto &decoder = threadInfo[curThread]->thread->decoder;
 
+    if (warmAccess(warmICache, ifetch_req,
+                   static_cast<uint8_t *>(decoder->moreBytesPtr()), false)) {
+        return 0;
+    }
+
     Packet pkt = Packet(ifetch_req, MemCmd::ReadReq);
 
     // ifetch_req is initialized to read the instruction
@@ -50,6 +50,8 @@
 namespace gem5
 {
 
+class BaseCache;
+
 class AtomicSimpleCPU : public BaseSimpleCPU
 {
   public:
@@ -67,8 +69,20 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
+    /** Caches warmed directly on hits, if any. */
+    BaseCache *const warmICache;
+    BaseCache *const warmDCache;
+
     // main simulation loop (one cycle)
-    void tick();
+    virtual void tick();
+
+    /**
+     * Fetch, execute and retire one instruction or microop of the
+     * current thread, once its interrupts and events have been handled.
+     *
+     * @return Ticks to stall for, rounded to the clock period.
+     */
+    Tick executeInst();
 
     /**
      * Check if a system is in a drained state.
@@ -104,8 +118,31 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     bool tryCompleteDrain();
 
     virtual Tick sendPacket(RequestPort &port, const PacketPtr &pkt);
+
+    /**
+     * Try to make a translated access through the warming fast path of a
+     * cache, without building a packet.
+     *
+     * @param cache The cache to access, may be null.
+     * @return Whether the access was made. If not, it must be sent as an
+     *         atomic packet.
+     */
+    bool warmAccess(BaseCache *cache, const RequestPtr &req, uint8_t *data,
+                    bool is_write);
+
     virtual Tick fetchInstMem();
 
+    /**
+     * Get the stall of the instruction that was just executed, once the
+     * PC has been advanced past it. The latencies of its memory
+     * accesses are in dcache_access and dcache_latency.
+     *
+     * @param icache_access Whether the instruction was fetched from memory.
+     * @param icache_latency Latency of the instruction fetch.
+     * @return Ticks to stall for, in addition to the cycle of the tick.
+     */
+    virtual Tick instStallTicks(bool icache_access, Tick icache_latency);
+
     /**
      * An AtomicCPUPort overrides the default behaviour of the
      * recvAtomicSnoop and ignores the packet instead of panicking. It
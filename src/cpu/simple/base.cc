@@ -119,16 +119,18 @@ BaseSimpleCPU::BaseSimpleCPU(const BaseSimpleCPUParams &p)
     }
 }
 
-void
+bool
 BaseSimpleCPU::checkPcEventQueue()
 {
+    bool serviced = false;
     Addr oldpc, pc = threadInfo[curThread]->thread->pcState().instAddr();
     do {
         oldpc = pc;
-        threadInfo[curThread]->thread->pcEventQueue.service(
+        serviced |= threadInfo[curThread]->thread->pcEventQueue.service(
                 oldpc, threadContexts[curThread]);
         pc = threadInfo[curThread]->thread->pcState().instAddr();
     } while (oldpc != pc);
+    return serviced;
 }
 
 void
@@ -311,7 +313,8 @@ BaseSimpleCPU::setupFetchRequest(const RequestPtr &req)
     Addr fetchPC = (instAddr & decoder->pcMask()) + t_info.fetchOffset;
 
     // set up memory request for instruction fetch
-    DPRINTF(Fetch, "Fetch: Inst PC:%08p, Fetch PC:%08p\n", instAddr, fetchPC);
+    DPRINTFA(Fetch, instAddr, "Fetch: Inst PC:%08p, Fetch PC:%08p\n",
+             instAddr, fetchPC);
 
     req->setVirt(fetchPC, decoder->moreBytesSize(), Request::INST_FETCH,
                  instRequestorId(), instAddr);
@@ -496,6 +499,7 @@ BaseSimpleCPU::advancePC(const Fault &fault)
     SimpleThread* thread = t_info.thread;
 
     const bool branching = thread->pcState().branching();
+    branchMispredicted = false;
 
     //Since we're moving to a new pc, zero out the offset
     t_info.fetchOffset = 0;
@@ -522,6 +526,7 @@ BaseSimpleCPU::advancePC(const Fault &fault)
             branchPred->squash(cur_sn, thread->pcState(), branching,
                                 curThread);
             ++t_info.execContextStats.numBranchMispred;
+            branchMispredicted = true;
         }
         // Update the branch predictor, this is done whether the
         // prediction was correct or not.
@@ -86,7 +86,16 @@ class BaseSimpleCPU : public BaseCPU
     ThreadID curThread;
     branch_prediction::BPredUnit *branchPred;
 
-    void checkPcEventQueue();
+    /** Set if the last call to advancePC() squashed a misprediction */
+    bool branchMispredicted = false;
+
+    /**
+     * Service the PC events at the PC of the current thread, until they
+     * leave it where it is.
+     *
+     * @return Whether any event was serviced.
+     */
+    bool checkPcEventQueue();
     void swapActiveThread();
 
   public:
@@ -0,0 +1,265 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/interval.hh"
+
+#include <algorithm>
+#include <chrono>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+IntervalSimpleCPU::IntervalSimpleCPU(const BaseIntervalSimpleCPUParams &p)
+    : AtomicSimpleCPU(p), robSize(p.rob_size),
+      mispredictPenalty(p.mispredict_penalty),
+      hiddenFetchLatency(p.hidden_fetch_latency),
+      longLatencyThreshold(p.long_latency_threshold),
+      robFillCycles(divCeil(p.rob_size, p.width)),
+      useTimingThread(p.timing_thread), timingSlack(p.timing_slack),
+      eventQueue(useTimingThread ? timingSlack + 1 : 1),
+      stallQueue(useTimingThread ? timingSlack + 1 : 1),
+      intervalStats(this)
+{
+    fatal_if(p.rob_size == 0, "%s: The reorder buffer can't be empty.",
+             name());
+    fatal_if(useTimingThread && p.numThreads != 1,
+             "%s: The timing thread only supports a single hardware "
+             "thread.", name());
+    warn_if(!branchPred, "%s: No branch predictor, branch mispredictions "
+            "will not be accounted for.", name());
+}
+
+IntervalSimpleCPU::~IntervalSimpleCPU()
+{
+    if (timingThread.joinable()) {
+        stopTiming = true;
+        timingThread.join();
+    }
+}
+
+void
+IntervalSimpleCPU::init()
+{
+    AtomicSimpleCPU::init();
+
+    if (useTimingThread)
+        timingThread = std::thread([this]() { timingMain(); });
+}
+
+DrainState
+IntervalSimpleCPU::drain()
+{
+    // Let the timing model catch up, so that its state is consistent
+    // with the functional state while the simulation is drained.
+    while (pendingEvents)
+        drainedStall += waitForStall();
+
+    return AtomicSimpleCPU::drain();
+}
+
+Tick
+IntervalSimpleCPU::instStallTicks(bool icache_access, Tick icache_latency)
+{
+    // Nothing was dispatched if the fetch faulted
+    if (!curStaticInst)
+        return 0;
+
+    InstEvents events;
+    events.fetched = icache_access;
+    events.fetchLatency = ticksToCycles(icache_latency);
+    events.load = dcache_access && curStaticInst->isLoad();
+    events.loadLatency = ticksToCycles(dcache_latency);
+    events.mispredicted = branchMispredicted;
+    events.numSrcRegs = std::min<int>(curStaticInst->numSrcRegs(),
+                                      maxInstRegs);
+    for (int i = 0; i < events.numSrcRegs; ++i)
+        events.srcRegs[i] = curStaticInst->srcRegIdx(i);
+    events.numDestRegs = std::min<int>(curStaticInst->numDestRegs(),
+                                       maxInstRegs);
+    for (int i = 0; i < events.numDestRegs; ++i)
+        events.destRegs[i] = curStaticInst->destRegIdx(i);
+
+    if (!useTimingThread)
+        return cyclesToTicks(chargeStall(account(events)));
+
+    while (!eventQueue.tryPush(events))
+        std::this_thread::yield();
+    ++pendingEvents;
+
+    Cycles stall = drainedStall;
+    drainedStall = Cycles(0);
+    if (pendingEvents > timingSlack)
+        stall += waitForStall();
+
+    return cyclesToTicks(stall);
+}
+
+Cycles
+IntervalSimpleCPU::waitForStall()
+{
+    assert(pendingEvents);
+
+    InstStall stall;
+    while (!stallQueue.tryPop(stall))
+        std::this_thread::yield();
+    --pendingEvents;
+
+    return chargeStall(stall);
+}
+
+Cycles
+IntervalSimpleCPU::chargeStall(const InstStall &stall)
+{
+    intervalStats.branchStallCycles += stall.branch;
+    intervalStats.fetchStallCycles += stall.fetch;
+    intervalStats.loadStallCycles += stall.load;
+    if (stall.longLatencyLoad)
+        ++intervalStats.longLatencyLoads;
+    if (stall.overlappedLoad)
+        ++intervalStats.overlappedLoads;
+
+    return stall.branch + stall.fetch + stall.load;
+}
+
+void
+IntervalSimpleCPU::timingMain()
+{
+    // Back off to sleeping when the functional core is idle for a while,
+    // e.g., because the simulated thread is suspended.
+    constexpr int spins_before_sleep = 1024;
+    int idle_spins = 0;
+
+    InstEvents events;
+    while (!stopTiming.load(std::memory_order_relaxed)) {
+        if (!eventQueue.tryPop(events)) {
+            if (++idle_spins < spins_before_sleep) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+            continue;
+        }
+        idle_spins = 0;
+
+        // There is always room as there are never more stalls than
+        // events in flight.
+        const bool pushed = stallQueue.tryPush(account(events));
+        panic_if(!pushed, "%s: Timing thread stall queue overflow.",
+                 name());
+    }
+}
+
+IntervalSimpleCPU::InstStall
+IntervalSimpleCPU::account(const InstEvents &events)
+{
+    ++instSeq;
+    if (windowOpen && instSeq - windowStart >= robSize) {
+        // The load of the window has left the reorder buffer
+        windowOpen = false;
+        windowRegs.clear();
+    }
+
+    InstStall stall;
+
+    if (events.fetched && events.fetchLatency > hiddenFetchLatency)
+        stall.fetch = events.fetchLatency - hiddenFetchLatency;
+
+    const bool dependent = windowOpen && dependsOnWindow(events);
+    const Cycles latency = events.loadLatency;
+    if (events.load && latency > longLatencyThreshold) {
+        stall.longLatencyLoad = true;
+        if (windowOpen && !dependent) {
+            // Independent misses in the window are serviced in parallel
+            // with the one that opened it.
+            stall.overlappedLoad = true;
+            for (int i = 0; i < events.numDestRegs; ++i)
+                windowRegs.push_back(events.destRegs[i]);
+            if (latency > windowLatency) {
+                stall.load = latency - windowLatency;
+                windowLatency = latency;
+            }
+        } else {
+            // This load can only issue once the loads it depends on have
+            // completed, so it opens a new window.
+            windowOpen = true;
+            windowStart = instSeq;
+            windowLatency = latency;
+            windowRegs.clear();
+            for (int i = 0; i < events.numDestRegs; ++i)
+                windowRegs.push_back(events.destRegs[i]);
+            if (latency > robFillCycles)
+                stall.load = latency - robFillCycles;
+        }
+    }
+
+    if (events.mispredicted)
+        stall.branch = mispredictPenalty;
+
+    return stall;
+}
+
+bool
+IntervalSimpleCPU::dependsOnWindow(const InstEvents &events)
+{
+    bool dependent = false;
+    for (int i = 0; i < events.numSrcRegs && !dependent; ++i) {
+        dependent = std::find(windowRegs.begin(), windowRegs.end(),
+                              events.srcRegs[i]) != windowRegs.end();
+    }
+
+    for (int i = 0; i < events.numDestRegs; ++i) {
+        const RegId &dest = events.destRegs[i];
+        auto it = std::find(windowRegs.begin(), windowRegs.end(), dest);
+        if (dependent && it == windowRegs.end()) {
+            windowRegs.push_back(dest);
+        } else if (!dependent && it != windowRegs.end()) {
+            // Overwriting a register ends its dependence on the window
+            windowRegs.erase(it);
+        }
+    }
+
+    return dependent;
+}
+
+IntervalSimpleCPU::IntervalStats::IntervalStats(statistics::Group *parent)
+    : statistics::Group(parent, "interval"),
+      ADD_STAT(branchStallCycles, statistics::units::Cycle::get(),
+               "Cycles lost to branch mispredictions"),
+      ADD_STAT(fetchStallCycles, statistics::units::Cycle::get(),
+               "Cycles lost to instruction fetch latency"),
+      ADD_STAT(loadStallCycles, statistics::units::Cycle::get(),
+               "Cycles lost to long-latency loads"),
+      ADD_STAT(longLatencyLoads, statistics::units::Count::get(),
+               "Number of long-latency loads"),
+      ADD_STAT(overlappedLoads, statistics::units::Count::get(),
+               "Number of long-latency loads overlapped with an earlier "
+               "one")
+{
+}
+
+} // namespace gem5
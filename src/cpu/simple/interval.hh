@@ -0,0 +1,197 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_INTERVAL_HH__
+#define __CPU_SIMPLE_INTERVAL_HH__
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "base/spsc_queue.hh"
+#include "base/statistics.hh"
+#include "cpu/reg_class.hh"
+#include "cpu/simple/atomic.hh"
+#include "params/BaseIntervalSimpleCPU.hh"
+
+namespace gem5
+{
+
+/**
+ * The IntervalSimpleCPU is an AtomicSimpleCPU that estimates the
+ * timing of an out-of-order core using interval analysis.
+ *
+ * Instructions are dispatched at the width of the CPU while no miss
+ * event occurs. Each miss event adds a penalty to the steady state:
+ * <ul>
+ *
+ *   <li>A branch misprediction, as reported by the branch predictor of
+ *       the CPU, costs the time to resolve the branch and refill the
+ *       front end.
+ *
+ *   <li>An instruction fetch costs the part of its latency that the
+ *       fetch queue can't hide.
+ *
+ *   <li>A long-latency load blocks the head of the reorder buffer. Its
+ *       penalty is its latency minus the time it takes to fill the
+ *       reorder buffer behind it. The long-latency loads that are
+ *       independent of it and issue within a reorder buffer of it
+ *       overlap with it, and only add the part of their latency that
+ *       exceeds the latency of the window.
+ *
+ * </ul>
+ *
+ * The latencies come from the atomic accesses to the actual memory
+ * system, so caches and memories are modelled as configured.
+ *
+ * The timing model can run on a host thread of its own. The functional
+ * core then hands the miss events of each instruction over through a
+ * queue and runs ahead of it by a fixed number of instructions, the
+ * penalties are charged once they come back. Since the lag is counted
+ * in instructions, the simulated timing does not depend on how the
+ * host schedules the two threads.
+ */
+class IntervalSimpleCPU : public AtomicSimpleCPU
+{
+  public:
+    IntervalSimpleCPU(const BaseIntervalSimpleCPUParams &p);
+    ~IntervalSimpleCPU();
+
+    void init() override;
+
+    DrainState drain() override;
+
+  protected:
+    /** Registers of an instruction tracked for dependences */
+    static constexpr int maxInstRegs = 8;
+
+    /** Miss events of an instruction, as seen by the functional core */
+    struct InstEvents
+    {
+        Cycles fetchLatency = Cycles(0);
+        Cycles loadLatency = Cycles(0);
+        bool fetched = false;
+        bool load = false;
+        bool mispredicted = false;
+        uint8_t numSrcRegs = 0;
+        uint8_t numDestRegs = 0;
+        std::array<RegId, maxInstRegs> srcRegs;
+        std::array<RegId, maxInstRegs> destRegs;
+    };
+
+    /** Penalties charged to an instruction by the timing model */
+    struct InstStall
+    {
+        Cycles branch = Cycles(0);
+        Cycles fetch = Cycles(0);
+        Cycles load = Cycles(0);
+        bool longLatencyLoad = false;
+        bool overlappedLoad = false;
+    };
+
+    Tick instStallTicks(bool icache_access, Tick icache_latency) override;
+
+    /** Run the timing model for an instruction. */
+    InstStall account(const InstEvents &events);
+
+    /**
+     * Check if an instruction reads a register written by a load of the
+     * open miss window, directly or through other instructions. Its
+     * destinations then depend on the window too.
+     */
+    bool dependsOnWindow(const InstEvents &events);
+
+    /** Update the statistics with a stall, and return its total. */
+    Cycles chargeStall(const InstStall &stall);
+
+    /** Wait for the timing thread to account for the oldest event. */
+    Cycles waitForStall();
+
+    /** Main loop of the timing thread. */
+    void timingMain();
+
+    /** Number of instructions in the reorder buffer */
+    const unsigned robSize;
+    /** Penalty of a branch misprediction */
+    const Cycles mispredictPenalty;
+    /** Fetch latency hidden by the front end */
+    const Cycles hiddenFetchLatency;
+    /** Load latency hidden by the out-of-order window */
+    const Cycles longLatencyThreshold;
+
+    /** Cycles it takes to fill the reorder buffer */
+    const Cycles robFillCycles;
+
+    /** Whether the timing model runs on a thread of its own */
+    const bool useTimingThread;
+    /** Instructions the functional core runs ahead of the timing model */
+    const unsigned timingSlack;
+
+    /** Events handed over to the timing thread */
+    SPSCQueue<InstEvents> eventQueue;
+    /** Stalls handed back by the timing thread */
+    SPSCQueue<InstStall> stallQueue;
+    /** Events not accounted for yet */
+    unsigned pendingEvents = 0;
+    /** Stall accounted for while draining, charged on the next tick */
+    Cycles drainedStall = Cycles(0);
+
+    std::thread timingThread;
+    std::atomic<bool> stopTiming{false};
+
+    /**
+     * State of the timing model, only used by the timing thread if there
+     * is one.
+     * @{
+     */
+    /** Sequence number of the last instruction accounted for */
+    uint64_t instSeq = 0;
+    /** Whether a miss window is open */
+    bool windowOpen = false;
+    /** Sequence number of the load that opened the miss window */
+    uint64_t windowStart = 0;
+    /** Latency of the miss window, i.e., of its slowest load */
+    Cycles windowLatency = Cycles(0);
+    /** Registers that depend on a load of the miss window */
+    std::vector<RegId> windowRegs;
+    /** @} */
+
+    struct IntervalStats : public statistics::Group
+    {
+        IntervalStats(statistics::Group *parent);
+
+        statistics::Scalar branchStallCycles;
+        statistics::Scalar fetchStallCycles;
+        statistics::Scalar loadStallCycles;
+        statistics::Scalar longLatencyLoads;
+        statistics::Scalar overlappedLoads;
+    } intervalStats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SIMPLE_INTERVAL_HH__
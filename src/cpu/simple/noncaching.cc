@@ -37,20 +37,29 @@
 
 #include "cpu/simple/noncaching.hh"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 #include "arch/generic/decoder.hh"
+#include "base/intmath.hh"
+#include "debug/SimpleCPU.hh"
 
 namespace gem5
 {
 
 NonCachingSimpleCPU::NonCachingSimpleCPU(
         const BaseNonCachingSimpleCPUParams &p)
-    : AtomicSimpleCPU(p)
+    : AtomicSimpleCPU(p), cacheBlocks(p.cache_blocks),
+      maxBlockInsts(p.max_block_insts),
+      maxCachedBlocks(p.max_cached_blocks), blockCacheStats(this)
 {
     assert(p.numThreads == 1);
     fatal_if(!FullSystem && p.workload.size() != 1,
              "only one workload allowed");
+    fatal_if(cacheBlocks && (!maxBlockInsts || !maxCachedBlocks),
+             "%s: cached blocks need max_block_insts and "
+             "max_cached_blocks to be non-zero.", name());
 }
 
 void
@@ -62,9 +71,53 @@ NonCachingSimpleCPU::verifyMemoryMode() const
     }
 }
 
+bool
+NonCachingSimpleCPU::accessBackdoor(const PacketPtr &pkt)
+{
+    // Only plain reads and writes can bypass the memory system. Anything
+    // with side effects (LL/SC, atomics, uncacheable or masked accesses)
+    // still goes through the port. Memories withdraw their backdoors
+    // while any LL/SC reservation is held, so plain stores made here
+    // can't break one.
+    const bool read = pkt->cmd == MemCmd::ReadReq;
+    const bool write = pkt->cmd == MemCmd::WriteReq;
+    if ((!read && !write) || pkt->req->isUncacheable() ||
+            pkt->isMaskedWrite()) {
+        return false;
+    }
+
+    auto bd_it = memBackdoors.contains(pkt->getAddrRange());
+    if (bd_it == memBackdoors.end())
+        return false;
+
+    auto *bd = bd_it->second;
+    uint8_t *host = bd->ptr() + (pkt->getAddr() - bd->range().start());
+    if (read && bd->readable()) {
+        pkt->setData(host);
+    } else if (write && bd->writeable()) {
+        pkt->writeData(host);
+    } else {
+        return false;
+    }
+    pkt->makeResponse();
+    return true;
+}
+
 Tick
 NonCachingSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
 {
+    if (pkt->isWrite() && !codeRegions.empty()) {
+        const Addr end = pkt->getAddr() + pkt->getSize();
+        for (Addr region = roundDown(pkt->getAddr(), blockRegionBytes);
+                region < end; region += blockRegionBytes) {
+            if (codeRegions.count(region))
+                writtenCode.push_back(region);
+        }
+    }
+
+    if (accessBackdoor(pkt))
+        return 0;
+
     MemBackdoorPtr bd = nullptr;
     Tick latency = port.sendAtomicBackdoor(pkt, bd);
 
@@ -102,4 +155,299 @@ NonCachingSimpleCPU::fetchInstMem()
     return 0;
 }
 
+namespace
+{
+
+/**
+ * Can an instruction be replayed from a block? Instructions which act on
+ * the CPU or on the whole system rather than on registers and memory must
+ * run through the regular path, and end the blocks they would be in.
+ */
+bool
+canCache(const StaticInstPtr &inst)
+{
+    return !(inst->isMacroop() || inst->isMicroop() ||
+             inst->isDelayedCommit() || inst->isSyscall() ||
+             inst->isNonSpeculative() || inst->isQuiesce() ||
+             inst->isSerializeBefore() || inst->isSerializeAfter() ||
+             inst->isSquashAfter() || inst->isPseudo() ||
+             inst->isHtmStart() || inst->isHtmStop() ||
+             inst->isHtmCancel() || inst->isInvalid());
+}
+
+} // anonymous namespace
+
+const NonCachingSimpleCPU::CachedBlock *
+NonCachingSimpleCPU::findBlock()
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+    auto &decoder = thread->decoder;
+    const PCStateBase &pc = thread->pcState();
+
+    if (!writtenCode.empty())
+        invalidateWrittenCode();
+
+    // Blocks start at an instruction boundary and are only replayed if
+    // nothing but execution needs to be modelled.
+    if (curMacroStaticInst || t_info.stayAtPC || t_info.fetchOffset ||
+            locked || branchPred || simulate_data_stalls ||
+            simulate_inst_stalls || warmDCache ||
+            isRomMicroPC(pc.microPC()) ||
+            (curStaticInst && curStaticInst->isDelayedCommit()) ||
+            !decoder->canReuseDecode(pc, pc)) {
+        return nullptr;
+    }
+
+    ifetch_req->taskId(taskId());
+    setupFetchRequest(ifetch_req);
+    Fault fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
+                                               BaseMMU::Execute);
+    if (fault != NoFault || ifetch_req->isUncacheable())
+        return nullptr;
+
+    const Addr paddr = ifetch_req->getPaddr();
+    auto bd_it = memBackdoors.contains(paddr);
+    if (bd_it == memBackdoors.end() || !bd_it->second->readable())
+        return nullptr;
+
+    const MemBackdoor &bd = *bd_it->second;
+    const uint8_t *code = bd.ptr() + (paddr - bd.range().start());
+    const Addr region = roundDown(paddr, blockRegionBytes);
+    const Addr code_size =
+        std::min(region + blockRegionBytes, bd.range().end()) - paddr;
+
+    if (!blocks.count(pc.instAddr()) && blocks.size() >= maxCachedBlocks)
+        flushBlocks();
+
+    auto [it, inserted] = blocks.try_emplace(pc.instAddr());
+    CachedBlock &block = it->second;
+    if (!inserted) {
+        // Anyone may have written to the code, so it is compared with
+        // the copy the block was decoded from on every entry.
+        if (block.paddr == paddr && block.code.size() <= code_size &&
+                std::memcmp(block.code.data(), code,
+                            block.code.size()) == 0 &&
+                decoder->canReuseDecode(pc, *block.pc)) {
+            return block.insts.empty() ? nullptr : &block;
+        }
+
+        ++blockCacheStats.blocksChanged;
+        if (roundDown(block.paddr, blockRegionBytes) != region)
+            inserted = true;
+        block = CachedBlock();
+    }
+    if (inserted)
+        codeRegions[region].push_back(pc.instAddr());
+
+    block.paddr = paddr;
+    buildBlock(block, pc, ifetch_req->getVaddr(), code, code_size);
+    ++blockCacheStats.blocksBuilt;
+
+    DPRINTF(SimpleCPU, "Cached a block of %d instructions at %s\n",
+            block.insts.size(), pc);
+
+    return block.insts.empty() ? nullptr : &block;
+}
+
+void
+NonCachingSimpleCPU::buildBlock(CachedBlock &block, const PCStateBase &pc,
+                                Addr fetch_start, const uint8_t *code,
+                                Addr code_size)
+{
+    auto &decoder = threadInfo[curThread]->thread->decoder;
+    const Addr fetch_size = decoder->moreBytesSize();
+
+    std::unique_ptr<PCStateBase> next_pc(pc.clone());
+    Addr code_end = 0;
+
+    block.pc.reset(pc.clone());
+
+    // Decode the way preExecute() does, from a clean decoder state.
+    decoder->reset();
+    while (block.insts.size() < maxBlockInsts) {
+        std::unique_ptr<PCStateBase> decode_pc(next_pc->clone());
+        StaticInstPtr inst;
+        for (Addr offset = 0; !inst; offset += fetch_size) {
+            Addr fetch_pc =
+                (next_pc->instAddr() & decoder->pcMask()) + offset;
+            if (fetch_pc - fetch_start + fetch_size > code_size)
+                break;
+
+            memcpy(decoder->moreBytesPtr(), code + (fetch_pc - fetch_start),
+                   fetch_size);
+            decoder->moreBytes(*next_pc, fetch_pc);
+            inst = decoder->decode(*next_pc);
+            code_end = std::max(code_end, fetch_pc - fetch_start + fetch_size);
+        }
+
+        if (!inst || !canCache(inst))
+            break;
+
+        block.insts.push_back({inst, std::move(decode_pc),
+                               std::unique_ptr<PCStateBase>(
+                                   next_pc->clone())});
+        if (inst->isControl())
+            break;
+
+        inst->advancePC(*next_pc);
+    }
+    // The decoder is left without any state the instructions of the block
+    // could depend on, as they won't go through it.
+    decoder->reset();
+
+    block.code.assign(code, code + code_end);
+}
+
+void
+NonCachingSimpleCPU::runBlock(const CachedBlock &block)
+{
+    DPRINTF(SimpleCPU, "Tick\n");
+
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+    auto &decoder = thread->decoder;
+    auto &inst_events = thread->comInstEventQueue;
+
+    Tick latency = 0;
+    int executed = 0;
+
+    // Each instruction sees its interrupts and events like it would in
+    // tick(), but all of them run at the tick the block started at.
+    for (const auto &cached : block.insts) {
+        baseStats.numCycles++;
+        updateCycleCounters(BaseCPU::CPU_STATE_ON);
+
+        checkForInterrupts();
+        bool events = checkPcEventQueue();
+
+        // We must have just got suspended by a PC event
+        if (_status == Idle) {
+            decoder->reset();
+            tryCompleteDrain();
+            return;
+        }
+
+        events |= !inst_events.empty() &&
+            inst_events.nextTick() <= t_info.numInst;
+        serviceInstCountEvents();
+
+        ++executed;
+        if (!decoder->canReuseDecode(thread->pcState(), *cached.pc)) {
+            // An interrupt, an event or the last instruction took the PC
+            // out of the block.
+            decoder->reset();
+            latency += executeInst();
+            break;
+        }
+
+        executeCachedInst(cached);
+
+        // Stop where an event may want the simulation to stop, and where
+        // this CPU wrote to cached code, possibly the block's own.
+        if (events || !writtenCode.empty() || locked)
+            break;
+    }
+    decoder->reset();
+
+    if (!writtenCode.empty())
+        invalidateWrittenCode();
+
+    if (tryCompleteDrain())
+        return;
+
+    // Instructions take a cycle per width, as in tick().
+    latency = std::max(latency, divCeil(executed, width) * clockPeriod());
+
+    if (_status != Idle)
+        reschedule(tickEvent, curTick() + latency, true);
+}
+
+void
+NonCachingSimpleCPU::executeCachedInst(const CachedInst &cached)
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+
+    // What preExecute() does once it has decoded an instruction.
+    t_info.setPredicate(true);
+    t_info.setMemAccPredicate(true);
+    t_info.stayAtPC = false;
+    thread->pcState(*cached.decodedPC);
+    curStaticInst = cached.inst;
+
+#if TRACING_ON
+    traceData = tracer->getInstRecord(curTick(), thread->getTC(),
+            curStaticInst, thread->pcState(), curMacroStaticInst);
+#endif // TRACING_ON
+
+    countFetchInst();
+
+    dcache_access = false;
+    Fault fault = curStaticInst->execute(&t_info, traceData);
+    if (fault == NoFault) {
+        countInst();
+        ppCommit->notify(std::make_pair(thread, curStaticInst));
+    } else if (traceData) {
+        traceFault();
+    }
+
+    postExecute();
+    instCnt++;
+    ++blockCacheStats.cachedInsts;
+
+    advancePC(fault);
+}
+
+void
+NonCachingSimpleCPU::invalidateWrittenCode()
+{
+    for (Addr region : writtenCode) {
+        auto it = codeRegions.find(region);
+        if (it == codeRegions.end())
+            continue;
+
+        // Blocks decoded again elsewhere since may be dropped too, which
+        // only costs decoding them once more.
+        for (Addr start : it->second)
+            blockCacheStats.blocksInvalidated += blocks.erase(start);
+        codeRegions.erase(it);
+    }
+    writtenCode.clear();
+}
+
+void
+NonCachingSimpleCPU::flushBlocks()
+{
+    DPRINTF(SimpleCPU, "Flushing %d cached blocks\n", blocks.size());
+    blocks.clear();
+    codeRegions.clear();
+    writtenCode.clear();
+}
+
+void
+NonCachingSimpleCPU::tick()
+{
+    const CachedBlock *block = cacheBlocks ? findBlock() : nullptr;
+    if (block)
+        runBlock(*block);
+    else
+        AtomicSimpleCPU::tick();
+}
+
+NonCachingSimpleCPU::BlockCacheStats::BlockCacheStats(
+        statistics::Group *parent)
+    : statistics::Group(parent, "blockCache"),
+      ADD_STAT(blocksBuilt, statistics::units::Count::get(),
+               "Number of blocks decoded"),
+      ADD_STAT(blocksChanged, statistics::units::Count::get(),
+               "Number of blocks decoded again as their code, translation "
+               "or decoder state changed"),
+      ADD_STAT(blocksInvalidated, statistics::units::Count::get(),
+               "Number of blocks dropped as this CPU wrote to their code"),
+      ADD_STAT(cachedInsts, statistics::units::Count::get(),
+               "Number of instructions replayed from cached blocks")
+{
+}
+
 } // namespace gem5
@@ -38,7 +38,12 @@
 #ifndef __CPU_SIMPLE_NONCACHING_HH__
 #define __CPU_SIMPLE_NONCACHING_HH__
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "base/addr_range_map.hh"
+#include "base/statistics.hh"
 #include "cpu/simple/atomic.hh"
 #include "mem/backdoor.hh"
 #include "params/BaseNonCachingSimpleCPU.hh"
@@ -60,8 +65,111 @@ class NonCachingSimpleCPU : public AtomicSimpleCPU
   protected:
     AddrRangeMap<MemBackdoorPtr, 1> memBackdoors;
 
+    /**
+     * Try to perform a data access directly through a memory backdoor
+     * obtained by a previous access, without sending a packet.
+     * @param pkt The access to perform.
+     * @return True if the access was performed.
+     */
+    bool accessBackdoor(const PacketPtr &pkt);
+
     Tick sendPacket(RequestPort &port, const PacketPtr &pkt) override;
     Tick fetchInstMem() override;
+
+    /** An instruction of a cached block. */
+    struct CachedInst
+    {
+        StaticInstPtr inst;
+        /** PC state the instruction was decoded at. */
+        std::unique_ptr<PCStateBase> pc;
+        /** PC state the decoder returned with the instruction. */
+        std::unique_ptr<PCStateBase> decodedPC;
+    };
+
+    /**
+     * Instructions decoded ahead from the start of a basic block, up to
+     * and including its control instruction. The block stops earlier at
+     * the end of a page, at the size limit or before an instruction it
+     * can't hold. A block without instructions is kept too, so that its
+     * start isn't decoded again on every visit.
+     */
+    struct CachedBlock
+    {
+        /** Physical address of the code the block was decoded from. */
+        Addr paddr = 0;
+        /** Copy of that code, to find out if it changed. */
+        std::vector<uint8_t> code;
+        /** PC state the block was decoded from. */
+        std::unique_ptr<PCStateBase> pc;
+        std::vector<CachedInst> insts;
+    };
+
+    /**
+     * Code of a block is kept within a naturally aligned region of this
+     * size, no larger than the smallest page of the ISAs, so that it is
+     * physically contiguous and has a single translation.
+     */
+    static constexpr Addr blockRegionBytes = 4096;
+
+    const bool cacheBlocks;
+    const unsigned maxBlockInsts;
+    const unsigned maxCachedBlocks;
+
+    /** Cached blocks, by the virtual address of their first instruction. */
+    std::unordered_map<Addr, CachedBlock> blocks;
+
+    /**
+     * Start addresses of the cached blocks, by the region their code is
+     * in, to drop the blocks whose code this CPU writes to.
+     */
+    std::unordered_map<Addr, std::vector<Addr>> codeRegions;
+
+    /** Regions of the cached code written to, not yet invalidated. */
+    std::vector<Addr> writtenCode;
+
+    /**
+     * Find the block starting at the PC of the current thread, decoding
+     * it if needed.
+     *
+     * @return The block, or nullptr if the PC can't start a block.
+     */
+    const CachedBlock *findBlock();
+
+    /**
+     * Decode a block from code in memory.
+     *
+     * @param block Block to fill in.
+     * @param pc PC state to decode the block from.
+     * @param fetch_start Virtual address of the code.
+     * @param code Host pointer to the code.
+     * @param code_size Number of bytes the block may decode.
+     */
+    void buildBlock(CachedBlock &block, const PCStateBase &pc,
+                    Addr fetch_start, const uint8_t *code, Addr code_size);
+
+    /** Run the instructions of a block, until the PC leaves it. */
+    void runBlock(const CachedBlock &block);
+
+    /** Execute and retire an instruction of a block. */
+    void executeCachedInst(const CachedInst &cached);
+
+    /** Drop the blocks whose code has been written to. */
+    void invalidateWrittenCode();
+
+    /** Drop all the cached blocks. */
+    void flushBlocks();
+
+    void tick() override;
+
+    struct BlockCacheStats : public statistics::Group
+    {
+        BlockCacheStats(statistics::Group *parent);
+
+        statistics::Scalar blocksBuilt;
+        statistics::Scalar blocksChanged;
+        statistics::Scalar blocksInvalidated;
+        statistics::Scalar cachedInsts;
+    } blockCacheStats;
 };
 
 } // namespace gem5
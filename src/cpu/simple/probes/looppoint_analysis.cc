@@ -37,8 +37,11 @@ LooppointAnalysis::LooppointAnalysis(const LooppointAnalysisParams &params)
       bbValidAddrRange(params.bb_valid_addr_range),
       markerValidAddrRange(params.marker_valid_addr_range),
       ifListening(params.if_listening),
-      bbInstCounter(0)
+      bbInstCounter(0),
+      pendingInsts(0)
 {
+    lpaManager->registerAnalysis(this);
+
     DPRINTF(LooppointAnalysis, "Start listening from the beginning of the "
                             "simulation? %s\n", ifListening ? "Yes" : "No");
 
@@ -61,16 +64,6 @@ LooppointAnalysis::LooppointAnalysis(const LooppointAnalysisParams &params)
             markerValidAddrRange.start(), markerValidAddrRange.end());
 }
 
-void
-LooppointAnalysis::updateLocalBBV(const Addr pc)
-{
-    if (localBBV.find(pc) == localBBV.end()) {
-        localBBV.insert(std::make_pair(pc, 1));
-    } else {
-        localBBV.find(pc)->second++;
-    }
-}
-
 void
 LooppointAnalysis::checkPc(
     const std::pair<SimpleThread*,const StaticInstPtr>& inst_pair
@@ -89,83 +82,119 @@ LooppointAnalysis::checkPc(
                 thread->getTC()->pcState().as<GenericISA::PCStateWithNext>();
     Addr pc = pcstate.pc();
 
-    if (lpaManager->ifEncountered(pc)) {
-        // if we have already encountered this pc, we should already
-        // categorized it
-        if (lpaManager->ifValidNotControl(pc)) {
-            // if it is categorized as a valid not control instruction
-            bbInstCounter++;
-            lpaManager->incrementGlobalInstCounter();
-        } else if (lpaManager->ifValidControl(pc)) {
-            // if it is categorized as a valid control instruction
-            bbInstCounter ++;
-            lpaManager->incrementGlobalInstCounter();
-            lpaManager->updateBBInstMap(pc, bbInstCounter);
-            updateLocalBBV(pc);
-            lpaManager->updateGlobalBBV(pc);
-            bbInstCounter = 0;
-            if (lpaManager->ifBackwardBranch(pc)) {
-                // if it is categorized as a backward branch
-                lpaManager->countBackwardBranch(pc);
-            }
-        }
+    const LooppointPcKind kind = lookupPc(pc, thread, inst, pcstate);
+    if (kind == LooppointPcKind::Ignored)
         return;
+
+    bbInstCounter++;
+    pendingInsts++;
+
+    if (kind == LooppointPcKind::NotControl)
+        return;
+
+    // the end of a basic block
+    BBCounts &counts = bbCounts[pc];
+    counts.local++;
+    counts.global++;
+    bbInstCounter = 0;
+
+    if (kind == LooppointPcKind::BackwardBranch) {
+        counts.backward++;
+        const uint64_t insts = pendingInsts;
+        pendingInsts = 0;
+        lpaManager->countBackwardBranch(pc, insts);
+    }
+}
+
+LooppointPcKind
+LooppointAnalysis::lookupPc(Addr pc, SimpleThread *thread,
+                            const StaticInstPtr &inst,
+                            const GenericISA::PCStateWithNext &pcstate)
+{
+    CachedPc &cached = pcCache[(pc >> 1) % pcCacheSize];
+    if (cached.pc == pc)
+        return cached.kind;
+
+    LooppointPcKind kind;
+    if (!lpaManager->findPc(pc, kind)) {
+        // if we have not encountered this pc before, we should now update
+        // it to the corresponding category
+        kind = lpaManager->insertPc(pc,
+                categorizePc(pc, thread, inst, pcstate), bbInstCounter + 1);
     }
 
-    lpaManager->updateEncountered(pc);
-    // if we have not encountered this pc before, we should now update it to
-    // the corresponding category
+    cached.pc = pc;
+    cached.kind = kind;
+    return kind;
+}
 
+LooppointPcKind
+LooppointAnalysis::categorizePc(Addr pc, SimpleThread *thread,
+                                const StaticInstPtr &inst,
+                                const GenericISA::PCStateWithNext &pcstate)
+{
     if (!thread->getIsaPtr()->inUserMode()) {
         // ignore this if it is not in user mode
-        return;
+        return LooppointPcKind::Ignored;
     }
 
     if (bbValidAddrRange.end() > 0 && ! bbValidAddrRange.contains(pc)) {
         // ignore this if it is not in the valid address range
-        return;
+        return LooppointPcKind::Ignored;
     }
 
-    if (bbExcludedAddrRanges.size() > 0) {
-        for (int i = 0; i < bbExcludedAddrRanges.size(); i++) {
-            if (bbExcludedAddrRanges[i].contains(pc)) {
-                // ignore this if it is in the excluded address range
-                return;
-            }
+    for (const auto &range : bbExcludedAddrRanges) {
+        if (range.contains(pc)) {
+            // ignore this if it is in the excluded address range
+            return LooppointPcKind::Ignored;
         }
     }
 
-    bbInstCounter++;
-    lpaManager->incrementGlobalInstCounter();
-
-    if (inst->isControl()) {
-        // if it is a control instruction, we see it as the end of a basic
-        // block
-        lpaManager->updateValidControl(pc);
-        lpaManager->updateBBInstMap(pc, bbInstCounter);
-        updateLocalBBV(pc);
-        lpaManager->updateGlobalBBV(pc);
-        bbInstCounter = 0;
-
-        if (markerValidAddrRange.end() > 0
-                && ! markerValidAddrRange.contains(pc)) {
-            // if it is not in the marker valid address range, we do not
-            // consider it as a possible marker used loop branch instruction
-            return;
-        }
+    if (!inst->isControl())
+        return LooppointPcKind::NotControl;
 
-        if (inst->isDirectCtrl()) {
-            // We only consider direct control instructions as possible
-            // loop branch instructions because it is PC-relative and it
-            // excludes return instructions.
-            if (pcstate.npc() < pc) {
-                lpaManager->countBackwardBranch(pc);
-            }
+    // if it is a control instruction, we see it as the end of a basic
+    // block
 
-        }
-    } else {
-        lpaManager->updateValidNotControl(pc);
+    if (markerValidAddrRange.end() > 0
+            && ! markerValidAddrRange.contains(pc)) {
+        // if it is not in the marker valid address range, we do not
+        // consider it as a possible marker used loop branch instruction
+        return LooppointPcKind::Control;
     }
+
+    // We only consider direct control instructions as possible loop
+    // branch instructions because it is PC-relative and it excludes
+    // return instructions.
+    if (inst->isDirectCtrl() && pcstate.npc() < pc)
+        return LooppointPcKind::BackwardBranch;
+
+    return LooppointPcKind::Control;
+}
+
+std::unordered_map<Addr, uint64_t>
+LooppointAnalysis::getLocalBBV() const
+{
+    std::unordered_map<Addr, uint64_t> bbv;
+    for (const auto &[pc, counts] : bbCounts) {
+        if (counts.local)
+            bbv.emplace(pc, counts.local);
+    }
+    return bbv;
+}
+
+void
+LooppointAnalysis::clearLocalBBV()
+{
+    for (auto &entry : bbCounts)
+        entry.second.local = 0;
+}
+
+void
+LooppointAnalysis::clearGlobalBBVShard()
+{
+    for (auto &entry : bbCounts)
+        entry.second.global = 0;
 }
 
 void
@@ -208,38 +237,116 @@ LooppointAnalysisManager::LooppointAnalysisManager(const
 }
 
 void
-LooppointAnalysisManager::countBackwardBranch(const Addr pc)
+LooppointAnalysisManager::countBackwardBranch(const Addr pc, uint64_t insts)
 {
-    if (backwardBranchCounter.find(pc) == backwardBranchCounter.end()) {
-        backwardBranchCounter.insert(std::make_pair(pc, 1));
-    } else {
-        backwardBranchCounter.find(pc)->second++;
-    }
+    mostRecentBackwardBranchPC.store(pc, std::memory_order_relaxed);
 
-    mostRecentBackwardBranchPC = pc;
+    const uint64_t global_insts = globalInstCounter.fetch_add(insts,
+            std::memory_order_relaxed) + insts;
 
-    if (globalInstCounter >= regionLength) {
+    if (global_insts >= regionLength) {
         // note that we do not reset any counter here but only raise an
         // exit event.
         // we can reset the counters through the simulation script using
         // the helper functions in the LooppointAnalysisManager class
         DPRINTF(LooppointAnalysis, "simpoint starting point found\n");
         DPRINTF(LooppointAnalysis, "globalInstCounter = %lu\n",
-                globalInstCounter);
+                global_insts);
         DPRINTF(LooppointAnalysis, "regionLength = %lu\n",
                 regionLength);
         exitSimLoopNow("simpoint starting point found");
     }
 }
 
+bool
+LooppointAnalysisManager::findPc(Addr pc, LooppointPcKind &kind) const
+{
+    std::lock_guard<std::mutex> lock(pcMutex);
+    auto it = pcKinds.find(pc);
+    if (it == pcKinds.end())
+        return false;
+    kind = it->second;
+    return true;
+}
+
+LooppointPcKind
+LooppointAnalysisManager::insertPc(Addr pc, LooppointPcKind kind,
+                                   uint64_t bb_insts)
+{
+    std::lock_guard<std::mutex> lock(pcMutex);
+    auto [it, inserted] = pcKinds.emplace(pc, kind);
+    if (inserted && kind != LooppointPcKind::Ignored &&
+            kind != LooppointPcKind::NotControl) {
+        bbInstMap.emplace(pc, bb_insts);
+    }
+    return it->second;
+}
+
+std::unordered_map<Addr, uint64_t>
+LooppointAnalysisManager::getGlobalBBV() const
+{
+    std::unordered_map<Addr, uint64_t> bbv;
+    for (const auto *analysis : analyses) {
+        for (const auto &[pc, counts] : analysis->getBBCounts()) {
+            if (counts.global)
+                bbv[pc] += counts.global;
+        }
+    }
+    return bbv;
+}
+
+void
+LooppointAnalysisManager::clearGlobalBBV()
+{
+    for (auto *analysis : analyses)
+        analysis->clearGlobalBBVShard();
+    DPRINTF(LooppointAnalysis,"globalBBV is cleared\n");
+}
+
+uint64_t
+LooppointAnalysisManager::getGlobalInstCounter() const
+{
+    uint64_t count = globalInstCounter;
+    for (const auto *analysis : analyses)
+        count += analysis->getPendingInsts();
+    return count;
+}
+
 void
-LooppointAnalysisManager::updateGlobalBBV(const Addr pc)
+LooppointAnalysisManager::clearGlobalInstCounter()
+{
+    globalInstCounter = 0;
+    for (auto *analysis : analyses)
+        analysis->clearPendingInsts();
+    DPRINTF(LooppointAnalysis,"globalInstCounter is cleared\n current "
+        "globalInstCounter = %lu\n", getGlobalInstCounter());
+}
+
+std::unordered_map<Addr, uint64_t>
+LooppointAnalysisManager::getBackwardBranchCounter() const
+{
+    std::unordered_map<Addr, uint64_t> counter;
+    for (const auto *analysis : analyses) {
+        for (const auto &[pc, counts] : analysis->getBBCounts()) {
+            if (counts.backward)
+                counter[pc] += counts.backward;
+        }
+    }
+    return counter;
+}
+
+uint64_t
+LooppointAnalysisManager::getMostRecentBackwardBranchCount() const
 {
-    if (globalBBV.find(pc) == globalBBV.end()) {
-        globalBBV.insert(std::make_pair(pc, 1));
-    } else {
-        globalBBV.find(pc)->second++;
+    const Addr pc = mostRecentBackwardBranchPC;
+    uint64_t count = 0;
+    for (const auto *analysis : analyses) {
+        const auto &bb_counts = analysis->getBBCounts();
+        auto it = bb_counts.find(pc);
+        if (it != bb_counts.end())
+            count += it->second.backward;
     }
+    return count;
 }
 
 }// namespace gem5
@@ -30,9 +30,12 @@
 #define __CPU_SIMPLE_PROBES_LOOPPOINT_ANALYSIS_HH__
 
 // C++ includes
+#include <array>
+#include <atomic>
 #include <list>
+#include <mutex>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 // m5 includes
 #include "arch/generic/pcstate.hh"
@@ -48,6 +51,22 @@
 namespace gem5
 {
 
+/**
+ * How the LoopPoint analysis treats the instructions at a PC. A PC is
+ * categorized when it is first encountered on any core.
+ */
+enum class LooppointPcKind : uint8_t
+{
+    /** Not analyzed, e.g. outside the valid range or not in user mode */
+    Ignored,
+    /** Valid instruction within a basic block */
+    NotControl,
+    /** Valid control instruction, which ends a basic block */
+    Control,
+    /** Valid control instruction which is also a marker candidate */
+    BackwardBranch
+};
+
 class LooppointAnalysis : public ProbeListenerObject
 {
   public:
@@ -120,30 +139,72 @@ class LooppointAnalysis : public ProbeListenerObject
     uint64_t bbInstCounter;
 
     /**
-     * The basic block vector for the current core that the LooppointAnalysis
-     * is attached to.
+     * The instructions executed since they were last added to the
+     * manager's global instruction counter. They are added at every marker
+     * candidate backward branch, so that the cores do not share a counter
+     * at every instruction.
      */
-    std::unordered_map<Addr, uint64_t> localBBV;
+    uint64_t pendingInsts;
 
     /**
-     * This function updates the localBBV for the input PC's basic block.
-     * Specifically, it increments the count of the input PC's basic block in
-     * the localBBV.
+     * The counts of a basic block on the current core that the
+     * LooppointAnalysis is attached to.
      */
-    void updateLocalBBV(const Addr pc);
-
-  public:
-    std::unordered_map<Addr, uint64_t>
-    getLocalBBV() const
+    struct BBCounts
     {
-        return localBBV;
+        /** Count in the local basic block vector */
+        uint64_t local = 0;
+        /** Share of this core in the global basic block vector */
+        uint64_t global = 0;
+        /** Executions of the basic block's branch as a backward branch */
+        uint64_t backward = 0;
     };
 
-    void
-    clearLocalBBV()
+    /**
+     * The counts of the basic blocks executed on this core, by the PC of
+     * their branch instruction. The manager merges these shards when the
+     * global counts are read.
+     */
+    std::unordered_map<Addr, BBCounts> bbCounts;
+
+    /**
+     * Direct-mapped cache of the categories of recently executed PCs, in
+     * front of the manager's shared map.
+     */
+    struct CachedPc
     {
-        localBBV.clear();
+        Addr pc = MaxAddr;
+        LooppointPcKind kind = LooppointPcKind::Ignored;
     };
+    static constexpr size_t pcCacheSize = 4096;
+    std::array<CachedPc, pcCacheSize> pcCache;
+
+    /** Get the category of a PC, categorizing it if it is new */
+    LooppointPcKind lookupPc(Addr pc, SimpleThread *thread,
+                             const StaticInstPtr &inst,
+                             const GenericISA::PCStateWithNext &pcstate);
+
+    /** Categorize a PC that was not encountered before */
+    LooppointPcKind categorizePc(Addr pc, SimpleThread *thread,
+                                 const StaticInstPtr &inst,
+                                 const GenericISA::PCStateWithNext &pcstate);
+
+  public:
+    std::unordered_map<Addr, uint64_t> getLocalBBV() const;
+
+    void clearLocalBBV();
+
+    /** Interface for the manager to merge and reset the shards */
+    const std::unordered_map<Addr, BBCounts> &
+    getBBCounts() const
+    {
+        return bbCounts;
+    }
+
+    void clearGlobalBBVShard();
+
+    uint64_t getPendingInsts() const { return pendingInsts; }
+    void clearPendingInsts() { pendingInsts = 0; }
 };
 
 class LooppointAnalysisManager: public SimObject
@@ -151,37 +212,52 @@ class LooppointAnalysisManager: public SimObject
   public:
     LooppointAnalysisManager(const LooppointAnalysisManagerParams &params);
 
+    /**
+     * Register a LooppointAnalysis whose counts this manager merges.
+     */
+    void
+    registerAnalysis(LooppointAnalysis *analysis)
+    {
+        analyses.push_back(analysis);
+    }
+
     /**
      * This function is called by the LooppointAnalysis probe listener when it
      * finds a valid backward branch that can be used as a marker.
-     * Specifically, it increments the backwardBranchCounter for the input PC.
+     * Specifically, it adds the instructions the core executed since its
+     * last call to the global instruction counter, and raises an exit
+     * event at the end of a region.
      */
-    void countBackwardBranch(const Addr pc);
+    void countBackwardBranch(const Addr pc, uint64_t insts);
 
     /**
-     * This function is called by the LooppointAnalysis probe listener when it
-     * reaches the branch instruction for a valid basic block.
-     * Specifically, it increments the globalBBV for the input PC.
+     * Look up the category of a PC encountered before.
+     *
+     * @return Whether the PC was encountered before.
      */
-    void updateGlobalBBV(const Addr pc);
+    bool findPc(Addr pc, LooppointPcKind &kind) const;
 
-  private:
     /**
-     * This counter is for the valid backward branches that we consider as
-     * candidates for marking the execution points.
-     * The key is the Program Counter address of the backward branch, and the
-     * value is the number of times the backward branch is executed.
+     * Record the category of a newly encountered PC, and the length of
+     * its basic block if it is a control instruction. If another core
+     * categorized the PC first, its category wins.
+     *
+     * @return The category of the PC.
      */
-    std::unordered_map<Addr, uint64_t> backwardBranchCounter;
+    LooppointPcKind insertPc(Addr pc, LooppointPcKind kind,
+                             uint64_t bb_insts);
+
+  private:
+    /** The LooppointAnalysis objects whose counts are merged here */
+    std::vector<LooppointAnalysis *> analyses;
 
     /**
-     * This is the global basic block vector that contains the count of each
-     * basic block that is executed.
-     * The key is the Program Counter address of the basic block's branch
-     * instruction, and the value is the number of times the basic block is
-     * executed.
+     * This map stores the categories of the encountered instructions.
+     * The key is the Program Counter address of the instruction. The cores
+     * cache the categories, so this is only accessed, under pcMutex, the
+     * first time a core executes a PC.
      */
-    std::unordered_map<Addr, uint64_t> globalBBV;
+    std::unordered_map<Addr, LooppointPcKind> pcKinds;
 
     /**
      * This map stores the number of instructions in each basic block.
@@ -191,6 +267,8 @@ class LooppointAnalysisManager: public SimObject
      */
     std::unordered_map<Addr, uint64_t> bbInstMap;
 
+    mutable std::mutex pcMutex;
+
     /**
      * This variable stores the number of instructions that we used to define
      * a region. For example, if the regionLength is 100, then every time when
@@ -200,123 +278,40 @@ class LooppointAnalysisManager: public SimObject
     uint64_t regionLength;
 
     /**
-     * This is a counter for the globally executed instructions. We use this to
-     * compare with the regionLength to determine if we reach the end of a
-     * region.
+     * This is a counter for the globally executed instructions, up to the
+     * last backward branch of each core. We use this to compare with the
+     * regionLength to determine if we reach the end of a region.
      */
-    uint64_t globalInstCounter;
+    std::atomic<uint64_t> globalInstCounter;
 
     /**
      * This variable stores the Program Counter address of the most recent
      * valid backward branch that we consider as a marker.
      */
-    Addr mostRecentBackwardBranchPC;
-
-    /**
-     * This set stores the Program Counter addresses of the valid not control
-     * instructions.
-     */
-    std::unordered_set<Addr> validNotControlPC;
-    /**
-     * This set stores the Program Counter addresses of the valid control
-     * instructions.
-     */
-    std::unordered_set<Addr> validControlPC;
-    /**
-     * This set stores the Program Counter addresses of the encountered
-     * instructions.
-     */
-    std::unordered_set<Addr> encounteredPC;
+    std::atomic<Addr> mostRecentBackwardBranchPC;
 
   public:
-    bool
-    ifBackwardBranch(const Addr pc) const
-    {
-        return backwardBranchCounter.find(pc) != backwardBranchCounter.end();
-    };
-
-    bool
-    ifValidNotControl(const Addr pc) const
-    {
-        return validNotControlPC.find(pc) != validNotControlPC.end();
-    };
-
-    bool
-    ifValidControl(const Addr pc) const
-    {
-        return validControlPC.find(pc) != validControlPC.end();
-    };
-
-    bool
-    ifEncountered(const Addr pc) const
-    {
-        return encounteredPC.find(pc) != encounteredPC.end();
-    };
-
-    void
-    updateValidNotControl(const Addr pc)
-    {
-        validNotControlPC.insert(pc);
-    };
-
-    void
-    updateValidControl(const Addr pc)
-    {
-        validControlPC.insert(pc);
-    };
-
-    void
-    updateEncountered(const Addr pc)
-    {
-        encounteredPC.insert(pc);
-    };
-
-    void
-    updateBBInstMap(Addr pc, uint64_t inst_ount)
-    {
-        if (bbInstMap.find(pc) == bbInstMap.end())
-        {
-            bbInstMap.insert(std::make_pair(pc, inst_ount));
-        }
-    };
-
-    std::unordered_map<Addr, uint64_t> getBBInstMap() const
-    {
-        return bbInstMap;
-    };
-
     std::unordered_map<Addr, uint64_t>
-    getGlobalBBV() const
+    getBBInstMap() const
     {
-        return globalBBV;
+        std::lock_guard<std::mutex> lock(pcMutex);
+        return bbInstMap;
     };
 
-    void
-    clearGlobalBBV()
-    {
-        globalBBV.clear();
-        DPRINTF(LooppointAnalysis,"globalBBV is cleared\n");
-    };
+    /**
+     * This is the global basic block vector that contains the count of each
+     * basic block that is executed.
+     * The key is the Program Counter address of the basic block's branch
+     * instruction, and the value is the number of times the basic block is
+     * executed.
+     */
+    std::unordered_map<Addr, uint64_t> getGlobalBBV() const;
 
-    uint64_t
-    getGlobalInstCounter() const
-    {
-        return globalInstCounter;
-    };
+    void clearGlobalBBV();
 
-    void
-    clearGlobalInstCounter()
-    {
-        globalInstCounter = 0;
-        DPRINTF(LooppointAnalysis,"globalInstCounter is cleared\n current "
-            "globalInstCounter = %lu\n", globalInstCounter);
-    };
+    uint64_t getGlobalInstCounter() const;
 
-    void
-    incrementGlobalInstCounter()
-    {
-        globalInstCounter++;
-    };
+    void clearGlobalInstCounter();
 
     Addr
     getMostRecentBackwardBranchPC() const
@@ -324,17 +319,15 @@ class LooppointAnalysisManager: public SimObject
         return mostRecentBackwardBranchPC;
     };
 
-    std::unordered_map<Addr, uint64_t>
-    getBackwardBranchCounter() const
-    {
-        return backwardBranchCounter;
-    };
+    /**
+     * This counter is for the valid backward branches that we consider as
+     * candidates for marking the execution points.
+     * The key is the Program Counter address of the backward branch, and the
+     * value is the number of times the backward branch is executed.
+     */
+    std::unordered_map<Addr, uint64_t> getBackwardBranchCounter() const;
 
-    uint64_t
-    getMostRecentBackwardBranchCount() const
-    {
-        return backwardBranchCounter.find(mostRecentBackwardBranchPC)->second;
-    };
+    uint64_t getMostRecentBackwardBranchCount() const;
 };
 
 } // namespace gem5
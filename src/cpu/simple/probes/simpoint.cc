@@ -37,6 +37,8 @@
 
 #include "cpu/simple/probes/simpoint.hh"
 
+#include <algorithm>
+
 #include "base/output.hh"
 
 namespace gem5
@@ -92,48 +94,18 @@ SimPoint::profile(const std::pair<SimpleThread*, const StaticInstPtr>& p)
     if (inst->isControl()) {
         currentBBV.second = thread->pcState().instAddr();
 
-        auto map_itr = bbMap.find(currentBBV);
-        if (map_itr == bbMap.end()){
-            // If a new (previously unseen) basic block is found,
-            // add a new unique id, record num of insts and insert
-            // into bbMap.
-            BBInfo info;
-            info.id = bbMap.size() + 1;
-            info.insts = currentBBVInstCount;
-            info.count = currentBBVInstCount;
-            bbMap.insert(std::make_pair(currentBBV, info));
-        } else {
-            // If basic block is seen before, just increment the count by the
-            // number of insts in basic block.
-            BBInfo& info = map_itr->second;
-            info.count += currentBBVInstCount;
-        }
+        const uint64_t id = bbId(currentBBV, currentBBVInstCount);
+        uint64_t &count = bbCounts[id - 1];
+        if (!count)
+            touchedBBs.push_back(id);
+        count += currentBBVInstCount;
         currentBBVInstCount = 0;
 
         // Reached end of interval if the sum of the current inst count
         // (intervalCount) and the excessive inst count from the previous
         // interval (intervalDrift) is greater than/equal to the interval size.
         if (intervalCount + intervalDrift >= intervalSize) {
-            // summarize interval and display BBV info
-            std::vector<std::pair<uint64_t, uint64_t> > counts;
-            for (auto map_itr = bbMap.begin(); map_itr != bbMap.end();
-                    ++map_itr) {
-                BBInfo& info = map_itr->second;
-                if (info.count != 0) {
-                    counts.push_back(std::make_pair(info.id, info.count));
-                    info.count = 0;
-                }
-            }
-            std::sort(counts.begin(), counts.end());
-
-            // Print output BBV info
-            *simpointStream->stream() << "T";
-            for (auto cnt_itr = counts.begin(); cnt_itr != counts.end();
-                    ++cnt_itr) {
-                *simpointStream->stream() << ":" << cnt_itr->first
-                                << ":" << cnt_itr->second << " ";
-            }
-            *simpointStream->stream() << "\n";
+            dumpInterval();
 
             intervalDrift = (intervalCount + intervalDrift) - intervalSize;
             intervalCount = 0;
@@ -141,4 +113,45 @@ SimPoint::profile(const std::pair<SimpleThread*, const StaticInstPtr>& p)
     }
 }
 
+uint64_t
+SimPoint::bbId(const BasicBlockRange &range, uint64_t insts)
+{
+    CachedBB &cached = bbCache[(range.second >> 1) % bbCacheSize];
+    if (cached.range == range)
+        return cached.id;
+
+    auto map_itr = bbMap.find(range);
+    if (map_itr == bbMap.end()) {
+        // If a new (previously unseen) basic block is found,
+        // add a new unique id, record num of insts and insert
+        // into bbMap.
+        BBInfo info;
+        info.id = bbMap.size() + 1;
+        info.insts = insts;
+        map_itr = bbMap.insert(std::make_pair(range, info)).first;
+        bbCounts.push_back(0);
+    }
+
+    cached.range = range;
+    cached.id = map_itr->second.id;
+    return cached.id;
+}
+
+void
+SimPoint::dumpInterval()
+{
+    // Only the blocks executed in this interval have non-zero counts.
+    std::sort(touchedBBs.begin(), touchedBBs.end());
+
+    std::ostream &os = *simpointStream->stream();
+    os << "T";
+    for (uint64_t id : touchedBBs) {
+        os << ":" << id << ":" << bbCounts[id - 1] << " ";
+        bbCounts[id - 1] = 0;
+    }
+    os << "\n";
+
+    touchedBBs.clear();
+}
+
 } // namespace gem5
@@ -38,7 +38,9 @@
 #ifndef __CPU_SIMPLE_PROBES_SIMPOINT_HH__
 #define __CPU_SIMPLE_PROBES_SIMPOINT_HH__
 
+#include <array>
 #include <unordered_map>
+#include <vector>
 
 #include "base/output.hh"
 #include "cpu/simple_thread.hh"
@@ -114,12 +116,36 @@ class SimPoint : public ProbeListenerObject
         uint64_t id;
         /** Num of static insts in BB */
         uint64_t insts;
-        /** Accumulated dynamic inst count executed by BB */
-        uint64_t count;
     };
 
     /** Hash table containing all previously seen basic blocks */
     std::unordered_map<BasicBlockRange, BBInfo> bbMap;
+
+    /**
+     * Direct-mapped cache of the IDs of recently executed basic blocks,
+     * indexed by the PC of their last instruction, in front of bbMap.
+     */
+    struct CachedBB
+    {
+        BasicBlockRange range = {MaxAddr, MaxAddr};
+        uint64_t id = 0;
+    };
+    static constexpr size_t bbCacheSize = 4096;
+    std::array<CachedBB, bbCacheSize> bbCache;
+
+    /**
+     * Accumulated dynamic inst count executed by each basic block in the
+     * current interval, indexed by ID - 1
+     */
+    std::vector<uint64_t> bbCounts;
+    /** IDs of the basic blocks executed in the current interval */
+    std::vector<uint64_t> touchedBBs;
+
+    /** Get the ID of a basic block, assigning a new one if it is new */
+    uint64_t bbId(const BasicBlockRange &range, uint64_t insts);
+
+    /** Write the BBV of the interval which just ended */
+    void dumpInterval();
     /** Currently executing basic block */
     BasicBlockRange currentBBV;
     /** inst count in current basic block */
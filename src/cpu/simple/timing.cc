@@ -76,9 +76,14 @@ TimingSimpleCPU::TimingCPUPort::TickEvent::schedule(PacketPtr _pkt, Tick t)
 TimingSimpleCPU::TimingSimpleCPU(const BaseTimingSimpleCPUParams &p)
     : BaseSimpleCPU(p), fetchTranslation(this), icachePort(this),
       dcachePort(this), ifetch_pkt(NULL), dcache_pkt(NULL), previousCycle(0),
+      functionalFetchLatency(p.functional_fetch_latency),
+      functionalFetchEvent([this]{ completeIfetch(NULL); },
+                           name() + ".functionalFetch"),
       fetchEvent([this]{ fetch(); }, name())
 {
     _status = Idle;
+    if (p.functional_fetch)
+        functionalFetch = std::make_unique<FunctionalFetch>(icachePort);
 }
 
 
@@ -463,7 +468,7 @@ TimingSimpleCPU::initiateMemRead(Addr addr, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         addr, size, flags, dataRequestorId(), pc, thread->contextId());
     req->setByteEnable(byte_enable);
 
@@ -545,7 +550,7 @@ TimingSimpleCPU::writeMem(uint8_t *data, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         addr, size, flags, dataRequestorId(), pc, thread->contextId());
     req->setByteEnable(byte_enable);
 
@@ -601,7 +606,7 @@ TimingSimpleCPU::initiateMemAMO(Addr addr, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(addr, size, flags,
+    RequestPtr req = makeRequest(addr, size, flags,
                             dataRequestorId(), pc, thread->contextId(),
                             std::move(amo_op));
 
@@ -698,7 +703,7 @@ TimingSimpleCPU::fetch()
 
     if (needToFetch) {
         _status = BaseSimpleCPU::Running;
-        RequestPtr ifetch_req = std::make_shared<Request>();
+        RequestPtr ifetch_req = makeRequest();
         ifetch_req->taskId(taskId());
         ifetch_req->setContext(thread->contextId());
         setupFetchRequest(ifetch_req);
@@ -722,6 +727,17 @@ TimingSimpleCPU::sendFetch(const Fault &fault, const RequestPtr &req,
     auto &decoder = threadInfo[curThread]->thread->decoder;
 
     if (fault == NoFault) {
+        if (functionalFetch && functionalFetch->read(req->getPaddr(),
+                    req->getSize(), decoder->moreBytesPtr())) {
+            DPRINTF(SimpleCPU, "Fetched addr %#x(pa: %#x) through a "
+                    "backdoor\n", req->getVaddr(), req->getPaddr());
+            _status = IcacheWaitResponse;
+            schedule(functionalFetchEvent, clockEdge(functionalFetchLatency));
+            updateCycleCounts();
+            updateCycleCounters(BaseCPU::CPU_STATE_ON);
+            return;
+        }
+
         DPRINTF(SimpleCPU, "Sending fetch for addr %#x(pa: %#x)\n",
                 req->getVaddr(), req->getPaddr());
         ifetch_pkt = new Packet(req, MemCmd::ReadReq);
@@ -1244,7 +1260,7 @@ TimingSimpleCPU::initiateMemMgmtCmd(Request::Flags flags)
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         addr, size, flags, dataRequestorId());
 
     req->setPC(pc);
@@ -1299,7 +1315,7 @@ TimingSimpleCPU::htmSendAbortSignal(ThreadID tid, uint64_t htm_uid,
 
     // notify l1 d-cache (ruby) that core has aborted transaction
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         addr, size, flags, dataRequestorId());
 
     req->setPC(pc);
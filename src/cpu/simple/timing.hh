@@ -41,7 +41,10 @@
 #ifndef __CPU_SIMPLE_TIMING_HH__
 #define __CPU_SIMPLE_TIMING_HH__
 
+#include <memory>
+
 #include "arch/generic/mmu.hh"
+#include "cpu/functional_fetch.hh"
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
 #include "cpu/translation.hh"
@@ -263,6 +266,15 @@ class TimingSimpleCPU : public BaseSimpleCPU
 
     Cycles previousCycle;
 
+    /**
+     * Instruction fetch through memory backdoors, if enabled. Fetches
+     * served this way don't send packets and complete after
+     * functionalFetchLatency cycles.
+     */
+    std::unique_ptr<FunctionalFetch> functionalFetch;
+    const Cycles functionalFetchLatency;
+    EventFunctionWrapper functionalFetchEvent;
+
   protected:
 
      /** Return a reference to the data port. */
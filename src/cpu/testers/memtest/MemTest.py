@@ -56,6 +56,11 @@ class MemTest(ClockedObject):
         0x800000, "Start of the uncacheable testing region"
     )
     max_loads = Param.Counter(0, "Number of loads to execute before exiting")
+    sampled_lines = Param.Unsigned(
+        0,
+        "Number of lines, spread evenly over each testing region, to "
+        "test (0 tests all lines)",
+    )
 
     # Control the mix of packets and if functional accesses are part of
     # the mix or not
@@ -41,6 +41,7 @@
 #include "cpu/testers/memtest/memtest.hh"
 
 #include "base/compiler.hh"
+#include "base/intmath.hh"
 #include "base/statistics.hh"
 #include "base/trace.hh"
 #include "debug/MemTest.hh"
@@ -95,6 +96,8 @@ MemTest::MemTest(const Params &p)
       percentUncacheable(p.percent_uncacheable),
       percentAtomic(p.percent_atomic),
       requestorId(p.system->getRequestorId(this)),
+      sampledLines(p.sampled_lines),
+      numGroups(1), group(0), linesPerRegion(0), numOutstanding(0),
       blockSize(p.system->cacheLineSize()),
       blockAddrMask(blockSize - 1),
       sizeBlocks(size / blockSize),
@@ -109,8 +112,14 @@ MemTest::MemTest(const Params &p)
       suppressFuncErrors(p.suppress_func_errors), stats(this)
 {
     id = TESTER_ALLOCATOR++;
-    fatal_if(id >= blockSize, "Too many testers, only %d allowed\n",
-             blockSize - 1);
+
+    // test all the lines unless asked to sample them
+    if (sampledLines == 0)
+        sampledLines = sizeBlocks;
+    fatal_if(sampledLines > sizeBlocks,
+             "%s: Cannot sample %d lines out of %d\n", name(),
+             sampledLines, sizeBlocks);
+    lineStride = sizeBlocks / sampledLines;
 
     // set up counters
     numReads = 0;
@@ -131,6 +140,60 @@ MemTest::getPort(const std::string &if_name, PortID idx)
         return ClockedObject::getPort(if_name, idx);
 }
 
+void
+MemTest::init()
+{
+    ClockedObject::init();
+
+    // All the testers exist by now. The ones that share a byte offset
+    // are in different groups, which test disjoint sets of lines.
+    numGroups = divCeil(TESTER_ALLOCATOR, (unsigned)blockSize);
+    group = id / blockSize;
+    fatal_if(group >= sampledLines,
+             "%s: Too many testers, %d lines are not enough for %d groups\n",
+             name(), sampledLines, numGroups);
+    linesPerRegion = (sampledLines - group + numGroups - 1) / numGroups;
+
+    const unsigned num_slots = 3 * linesPerRegion;
+    outstanding.assign(num_slots, false);
+    atomicPendingData.assign(num_slots, 0);
+    referenceData.assign(num_slots, 0);
+}
+
+Addr
+MemTest::byteAddr(unsigned region, unsigned line) const
+{
+    const Addr base = region == 0 ? baseAddr1 :
+        region == 1 ? baseAddr2 : uncacheAddr;
+    const Addr region_line = (line * numGroups + group) * lineStride;
+
+    // use the tester id as offset within the block for false sharing
+    return base + region_line * blockSize + id % blockSize;
+}
+
+unsigned
+MemTest::slot(Addr addr) const
+{
+    unsigned region;
+    Addr offset;
+    if (addr >= baseAddr1 && addr - baseAddr1 < size) {
+        region = 0;
+        offset = addr - baseAddr1;
+    } else if (addr >= baseAddr2 && addr - baseAddr2 < size) {
+        region = 1;
+        offset = addr - baseAddr2;
+    } else {
+        assert(addr >= uncacheAddr && addr - uncacheAddr < size);
+        region = 2;
+        offset = addr - uncacheAddr;
+    }
+
+    const Addr region_line = offset / blockSize;
+    assert(region_line % lineStride == 0);
+    assert((region_line / lineStride) % numGroups == group);
+    return region * linesPerRegion + region_line / lineStride / numGroups;
+}
+
 void
 MemTest::completeRequest(PacketPtr pkt, bool functional)
 {
@@ -138,9 +201,10 @@ MemTest::completeRequest(PacketPtr pkt, bool functional)
     assert(req->getSize() == 1);
 
     // this address is no longer outstanding
-    auto remove_addr = outstandingAddrs.find(req->getPaddr());
-    assert(remove_addr != outstandingAddrs.end());
-    outstandingAddrs.erase(remove_addr);
+    const unsigned s = slot(req->getPaddr());
+    assert(outstanding[s]);
+    outstanding[s] = false;
+    --numOutstanding;
 
     DPRINTF(MemTest, "Completing %s at address %x (blk %x) %s\n",
             pkt->isWrite() ? pkt->isAtomicOp() ? "atomic" : "write" : "read",
@@ -155,7 +219,7 @@ MemTest::completeRequest(PacketPtr pkt, bool functional)
                 pkt->isWrite() ? "Write" : "Read", req->getPaddr());
     } else {
         if (pkt->isAtomicOp()) {
-            uint8_t ref_data = referenceData[req->getPaddr()];
+            uint8_t ref_data = referenceData[s];
             if (pkt_data[0] != ref_data) {
                 panic("%s: read of %x (blk %x) @ cycle %d "
                       "returns %x, expected %x\n", name(),
@@ -167,13 +231,12 @@ MemTest::completeRequest(PacketPtr pkt, bool functional)
                     req->getPaddr(), blockAlign(req->getPaddr()),
                     pkt_data[0]);
 
-            referenceData[req->getPaddr()] =
-                   atomicPendingData[req->getPaddr()];
+            referenceData[s] = atomicPendingData[s];
 
             numAtomics++;
             stats.numAtomics++;
         } else if (pkt->isRead()) {
-            uint8_t ref_data = referenceData[req->getPaddr()];
+            uint8_t ref_data = referenceData[s];
             if (pkt_data[0] != ref_data) {
                 panic("%s: read of %x (blk %x) @ cycle %d "
                       "returns %x, expected %x\n", name(),
@@ -198,7 +261,7 @@ MemTest::completeRequest(PacketPtr pkt, bool functional)
             assert(pkt->isWrite());
 
             // update the reference data
-            referenceData[req->getPaddr()] = pkt_data[0];
+            referenceData[s] = pkt_data[0];
             numWrites++;
             stats.numWrites++;
         }
@@ -209,7 +272,7 @@ MemTest::completeRequest(PacketPtr pkt, bool functional)
 
     // finally shift the response timeout forward if we are still
     // expecting responses; deschedule it otherwise
-    if (outstandingAddrs.size() != 0)
+    if (numOutstanding != 0)
         reschedule(noResponseEvent, clockEdge(progressCheck));
     else if (noResponseEvent.scheduled())
         deschedule(noResponseEvent);
@@ -247,55 +310,46 @@ MemTest::tick()
                      !uncacheable;
     unsigned base = rng->random(0, 1);
     Request::Flags flags;
-    Addr paddr;
 
     // halt until we clear outstanding requests, otherwise it won't be able to
     // find a new unique address
-    if (outstandingAddrs.size() >= sizeBlocks) {
+    if (numOutstanding >= linesPerRegion) {
         waitResponse = true;
         return;
     }
 
-    // generate a unique address
+    // generate a unique address, the slot goes by the address in case
+    // the regions overlap
+    unsigned region = uncacheable ? 2 : base ? 0 : 1;
+    Addr paddr;
+    unsigned s;
     do {
-        unsigned offset = rng->random<unsigned>(0, size - 1);
-
-        // use the tester id as offset within the block for false sharing
-        offset = blockAlign(offset);
-        offset += id;
+        paddr = byteAddr(region,
+                         rng->random<unsigned>(0, linesPerRegion - 1));
+        s = slot(paddr);
+    } while (outstanding[s]);
 
-        if (uncacheable) {
-            flags.set(Request::UNCACHEABLE);
-            paddr = uncacheAddr + offset;
-        } else  {
-            paddr = ((base) ? baseAddr1 : baseAddr2) + offset;
-        }
-    } while (outstandingAddrs.find(paddr) != outstandingAddrs.end());
+    if (uncacheable)
+        flags.set(Request::UNCACHEABLE);
 
     bool do_functional = (rng->random(0, 100) < percentFunctional) &&
         !uncacheable;
-    RequestPtr req = std::make_shared<Request>(paddr, 1, flags, requestorId);
+    RequestPtr req = makeRequest(paddr, 1, flags, requestorId);
     req->setContext(id);
 
-    outstandingAddrs.insert(paddr);
+    outstanding[s] = true;
+    ++numOutstanding;
 
     // sanity check
-    panic_if(outstandingAddrs.size() > 100,
+    panic_if(numOutstanding > 100,
              "Tester %s has more than 100 outstanding requests\n", name());
 
     PacketPtr pkt = nullptr;
     uint8_t *pkt_data = new uint8_t[1];
 
     if (cmd < percentReads) {
-        // start by ensuring there is a reference value if we have not
-        // seen this address before
-        [[maybe_unused]] uint8_t ref_data = 0;
-        auto ref = referenceData.find(req->getPaddr());
-        if (ref == referenceData.end()) {
-            referenceData[req->getPaddr()] = 0;
-        } else {
-            ref_data = ref->second;
-        }
+        // the bytes we have not written yet are expected to be zero
+        [[maybe_unused]] uint8_t ref_data = referenceData[s];
 
         DPRINTF(MemTest,
                 "Initiating %sread at addr %x (blk %x) expecting %x\n",
@@ -324,7 +378,7 @@ MemTest::tick()
             pkt = new Packet(req, MemCmd::WriteReq);
             pkt->dataDynamic(pkt_data);
             pkt_data[0] = data;
-            atomicPendingData[req->getPaddr()] = data;
+            atomicPendingData[s] = data;
         } else {
             DPRINTF(MemTest,
                     "Initiating %swrite at addr %x (blk %x) value %x\n",
@@ -359,7 +413,7 @@ MemTest::tick()
     }
 
     // Schedule noResponseEvent now if we are expecting a response
-    if (!noResponseEvent.scheduled() && (outstandingAddrs.size() != 0))
+    if (!noResponseEvent.scheduled() && (numOutstanding != 0))
         schedule(noResponseEvent, clockEdge(progressCheck));
 }
 
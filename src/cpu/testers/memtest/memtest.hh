@@ -41,8 +41,7 @@
 #ifndef __CPU_MEMTEST_MEMTEST_HH__
 #define __CPU_MEMTEST_MEMTEST_HH__
 
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 #include "base/random.hh"
 #include "base/statistics.hh"
@@ -62,7 +61,13 @@ namespace gem5
  * and writes a specific byte in a cache line, as determined by its
  * unique id. Thus, all requests issued by the MemTest instance are a
  * single byte and a specific address is only ever touched by a single
- * tester.
+ * tester. If there are more testers than bytes in a cache line, the
+ * testers are split into groups that each use their own set of lines.
+ *
+ * The reference is a shadow of the bytes the tester owns, with one
+ * entry per line it tests, so it stays small with many testers and
+ * large regions. The lines tested can also be sampled evenly over the
+ * regions.
  *
  * In addition to verifying the data, the tester also has timeouts for
  * both requests and responses, thus checking that the memory-system
@@ -80,6 +85,8 @@ class MemTest : public ClockedObject
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
 
+    void init() override;
+
   protected:
 
     void tick();
@@ -139,11 +146,45 @@ class MemTest : public ClockedObject
 
     unsigned int id;
 
-    std::unordered_set<Addr> outstandingAddrs;
-    std::unordered_map<Addr, uint8_t> atomicPendingData;
+    /** Number of lines, spread evenly over a region, that are tested */
+    unsigned sampledLines;
+
+    /**
+     * Number of tester groups sharing the lines, and the group of this
+     * tester. Set up in init, once all testers exist.
+     */
+    unsigned numGroups;
+    unsigned group;
 
-    // store the expected value for the addresses we have touched
-    std::unordered_map<Addr, uint8_t> referenceData;
+    /** Number of lines in each region that this tester uses */
+    unsigned linesPerRegion;
+
+    /**
+     * Shadow memory of the bytes this tester owns, indexed by their
+     * slot. Which bytes have a request outstanding, the data of the
+     * pending atomics, and the expected value of each byte.
+     */
+    std::vector<bool> outstanding;
+    unsigned numOutstanding;
+    std::vector<uint8_t> atomicPendingData;
+    std::vector<uint8_t> referenceData;
+
+    /**
+     * Get the address of a byte this tester owns.
+     *
+     * @param region The testing region: first, second or uncacheable
+     * @param line Line of the tester in the region
+     * @return The address of the byte
+     */
+    Addr byteAddr(unsigned region, unsigned line) const;
+
+    /**
+     * Get the slot of a byte this tester owns in the shadow memory.
+     *
+     * @param addr The address of the byte
+     * @return Index into the shadow memory
+     */
+    unsigned slot(Addr addr) const;
 
     const Addr blockSize;
 
@@ -151,6 +192,9 @@ class MemTest : public ClockedObject
 
     const unsigned sizeBlocks;
 
+    /** Distance in lines between sampled lines */
+    unsigned lineStride;
+
     /**
      * Get the block aligned address.
      *
@@ -111,7 +111,7 @@ Check::initiatePrefetch(Cycles current_time)
     }
 
     // Prefetches are assumed to be 0 sized
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
             m_address, 0, flags, m_tester_ptr->requestorId());
     req->setPC(m_pc);
     req->setContext(index);
@@ -152,7 +152,7 @@ Check::initiateFlush(Cycles current_time)
 
     Request::Flags flags;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
             m_address, CHECK_SIZE, flags, m_tester_ptr->requestorId());
     req->setPC(m_pc);
 
@@ -188,7 +188,7 @@ Check::initiateAction(Cycles current_time)
     Addr writeAddr(m_address + m_store_count);
 
     // Stores are assumed to be 1 byte-sized
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         writeAddr, 1, flags, m_tester_ptr->requestorId());
     req->setPC(m_pc);
 
@@ -255,7 +255,7 @@ Check::initiateCheck(Cycles current_time)
     }
 
     // Checks are sized depending on the number of bytes written
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
             m_address, CHECK_SIZE, flags, m_tester_ptr->requestorId());
     req->setPC(m_pc);
 
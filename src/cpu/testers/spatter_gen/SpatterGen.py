@@ -51,7 +51,10 @@ class SpatterGen(ClockedObject):
         "Whether to synchronize on kernel boundaries or not."
     )
 
-    port = RequestPort("Port to send memory requests.")
+    port = VectorRequestPort(
+        "Ports to send memory requests. The requests sent in parallel, "
+        "see send_rate, are spread over the ports round robin."
+    )
 
     int_regfile_size = Param.Int("Size of the integer register file.")
     fp_regfile_size = Param.Int("Size of the floating point register file.")
@@ -35,6 +35,7 @@
 #include "enums/SpatterProcessingMode.hh"
 #include "mem/packet.hh"
 #include "sim/sim_exit.hh"
+#include "sim/stats.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -50,7 +51,6 @@ SpatterGen::SpatterGen(const Params& params):
     numPendingMemRequests(0),
     stats(this),
     mode(params.processing_mode),
-    port(this, name() + ".port"),
     intRegFileSize(params.int_regfile_size), intRegUsed(0),
     fpRegFileSize(params.fp_regfile_size), fpRegUsed(0),
     requestGenLatency(params.request_gen_latency),
@@ -72,13 +72,21 @@ SpatterGen::SpatterGen(const Params& params):
     );
     generatorBusyUntil.resize(requestGenRate, 0);
     portBusyUntil.resize(sendRate, 0);
+
+    for (size_t i = 0; i < params.port_port_connection_count; ++i) {
+        ports.emplace_back(new SpatterGenPort(
+            this, csprintf("%s.port[%d]", name(), i), i));
+    }
+    fatal_if(ports.empty(), "%s: The port is not connected.", name());
 }
 
 Port&
 SpatterGen::getPort(const std::string& if_name, PortID idx)
 {
     if (if_name == "port") {
-        return port;
+        fatal_if(idx < 0 || idx >= (PortID)ports.size(),
+                 "%s: Invalid port index %d.", name(), idx);
+        return *ports[idx];
     } else {
         return ClockedObject::getPort(if_name, idx);
     }
@@ -135,20 +143,20 @@ SpatterGen::recvReqRetry()
 
 bool
 SpatterGen::SpatterGenPort::recvTimingResp(PacketPtr pkt) {
-    return owner->recvTimingResp(pkt);
+    return owner->recvTimingResp(id, pkt);
 }
 
 bool
-SpatterGen::recvTimingResp(PacketPtr pkt)
+SpatterGen::recvTimingResp(PortID port_id, PacketPtr pkt)
 {
     DPRINTF(SpatterGen, "%s: Received pkt: %s.\n", __func__, pkt->print());
     assert(pkt->isResponse());
 
     // record trip time.
     SpatterAccess* spatter_access = pkt->findNextSenderState<SpatterAccess>();
-    Tick trip_time = (curTick() - requestDepartureTime[pkt->req]);
-    requestDepartureTime.erase(pkt->req);
+    Tick trip_time = (curTick() - spatter_access->departureTime);
     spatter_access->recordTripTime(trip_time);
+    stats.portBytes[port_id] += pkt->getSize();
 
     int trips_left = spatter_access->tripsLeft();
     assert(trips_left >= 0);
@@ -462,6 +470,16 @@ SpatterGen::processNextGenEvent()
     }
 }
 
+bool
+SpatterGen::allPortsBlocked() const
+{
+    for (const auto &port : ports) {
+        if (!port->blocked())
+            return false;
+    }
+    return true;
+}
+
 void
 SpatterGen::scheduleNextSendEvent(Tick when)
 {
@@ -500,23 +518,31 @@ SpatterGen::processNextSendEvent()
             );
             break;
         }
+        SpatterGenPort &port = *ports[i % ports.size()];
+        if (port.blocked()) {
+            // Only if all the memory ports are blocked there is no point
+            // in continuing the loop or in scheduling nextSendEvent.
+            if (allPortsBlocked()) {
+                nextSendEvent.sleep();
+                break;
+            }
+            continue;
+        }
         PacketPtr pkt = requestBuffer.front();
         DPRINTF(
             SpatterGen,
             "%s: Sending pkt: %s to port[%d].\n",
             __func__, pkt->print(), i
         );
+        // record packet departure time
+        pkt->findNextSenderState<SpatterAccess>()->departureTime = curTick();
         // NOTE: We assume the port will be busy for 1 cycle.
         portBusyUntil[i] = clockEdge(Cycles(1));
         port.sendPacket(pkt);
         requestBuffer.pop();
         // increase numPendingMemRequests
         numPendingMemRequests++;
-        // record packet departure time
-        requestDepartureTime[pkt->req] = curTick();
-        // Now if we put the port in blocked state no point in continuing
-        // the loop. also no point in scheduling nextSendEvent.
-        if (port.blocked()) {
+        if (allPortsBlocked()) {
             nextSendEvent.sleep();
             break;
         }
@@ -569,7 +595,12 @@ SpatterGen::SpatterGenStats::SpatterGenStats(SpatterGen* spatter_gen):
     ADD_STAT(valueAccessLatency, statistics::units::Tick::get(),
         "Distribution of latency for accessing the values array."),
     ADD_STAT(totalIndirectAccessLatency, statistics::units::Tick::get(),
-        "Distribution of total latency for indirect accesses.")
+        "Distribution of total latency for indirect accesses."),
+    ADD_STAT(portBytes, statistics::units::Byte::get(),
+        "Number of bytes read and written through each port."),
+    ADD_STAT(portBandwidth, statistics::units::Rate<
+                statistics::units::Byte, statistics::units::Second>::get(),
+        "Bandwidth of the reads and writes through each port.")
 {}
 
 void
@@ -579,6 +610,13 @@ SpatterGen::SpatterGenStats::regStats()
     indexAccessLatency.init(8);
     valueAccessLatency.init(16);
     totalIndirectAccessLatency.init(16);
+
+    const int num_ports = spatterGen->ports.size();
+    portBytes.init(num_ports);
+    for (int i = 0; i < num_ports; i++)
+        portBytes.subname(i, csprintf("port%d", i));
+    portBandwidth.precision(2);
+    portBandwidth = portBytes / simSeconds;
 }
 
 } // namespace gem5
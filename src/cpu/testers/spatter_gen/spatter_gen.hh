@@ -29,8 +29,8 @@
 #ifndef __CPU_TESTERS_SPATTER_GEN_SPATTER_GEN_HH__
 #define __CPU_TESTERS_SPATTER_GEN_SPATTER_GEN_HH__
 
+#include <memory>
 #include <queue>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -111,8 +111,9 @@ class SpatterGen: public ClockedObject
         PacketPtr blockedPacket;
 
       public:
-        SpatterGenPort(SpatterGen* owner, const std::string& name):
-            RequestPort(name), owner(owner), blockedPacket(nullptr) {}
+        SpatterGenPort(SpatterGen* owner, const std::string& name,
+                       PortID id):
+            RequestPort(name, id), owner(owner), blockedPacket(nullptr) {}
 
         void sendPacket(PacketPtr pkt);
         bool blocked() const { return blockedPacket != nullptr; }
@@ -147,6 +148,10 @@ class SpatterGen: public ClockedObject
         statistics::Histogram valueAccessLatency;
         statistics::Histogram totalIndirectAccessLatency;
 
+        // bytes read and written through each port
+        statistics::Vector portBytes;
+        statistics::Formula portBandwidth;
+
         virtual void regStats() override;
 
         SpatterGenStats(SpatterGen* spatter_gen);
@@ -165,7 +170,6 @@ class SpatterGen: public ClockedObject
     // non param related members
     SpatterGenState state;
     std::queue<SpatterKernel> kernels;
-    std::unordered_map<RequestPtr, Tick> requestDepartureTime;
 
     RequestorID requestorId;
     int numPendingMemRequests;
@@ -180,7 +184,9 @@ class SpatterGen: public ClockedObject
 
     // param related members (not necessarily one-to-one with params)
     SpatterProcessingMode mode;
-    SpatterGenPort port;
+    // the memory ports, the "dcache ports" emulated by sendRate are
+    // spread over them round robin.
+    std::vector<std::unique_ptr<SpatterGenPort>> ports;
     // size of the register files,
     // for every memory instruction we need to allocate one register.
     int intRegFileSize;
@@ -213,6 +219,7 @@ class SpatterGen: public ClockedObject
     std::vector<Tick> portBusyUntil;
     SpatterGenEvent nextSendEvent;
     void processNextSendEvent();
+    bool allPortsBlocked() const;
     // if nextSendEvent has to be schedule at tick when then schedule it.
     // this function should only be called when nextSendEvent is not pending.
     void scheduleNextSendEvent(Tick when);
@@ -233,7 +240,7 @@ class SpatterGen: public ClockedObject
     virtual void startup() override;
 
     void recvReqRetry();
-    bool recvTimingResp(PacketPtr pkt);
+    bool recvTimingResp(PortID port_id, PacketPtr pkt);
     // PyBindMethod to interface adding a kernel with python JSON frontend.
     void addKernel(
         uint32_t id, uint32_t delta, uint32_t count,
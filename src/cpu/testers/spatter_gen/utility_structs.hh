@@ -93,6 +93,8 @@ struct SpatterAccess : public Packet::SenderState
     RequestorID requestorId;
     SpatterKernelType _kernelType;
     Tick accTripTime;
+    // departure time of the packet in flight, there is only ever one
+    Tick departureTime;
     std::queue<AccessPair> accessPairs;
 
     SpatterAccess(
@@ -101,7 +103,7 @@ struct SpatterAccess : public Packet::SenderState
         const std::queue<AccessPair>& access_pairs
     ):
         requestorId(requestor_id), _kernelType(kernel_type),
-        accTripTime(0), accessPairs(access_pairs)
+        accTripTime(0), departureTime(0), accessPairs(access_pairs)
     {}
 
     SpatterKernelType type() const { return _kernelType; }
@@ -137,7 +139,7 @@ struct SpatterAccess : public Packet::SenderState
 
     PacketPtr createPacket(Addr addr, size_t size, MemCmd cmd) const
     {
-        RequestPtr req = std::make_shared<Request>(addr, size, 0, requestorId);
+        RequestPtr req = makeRequest(addr, size, 0, requestorId);
 
         // Dummy PC to have PC-based prefetchers latch on;
         // get entropy into higher bits
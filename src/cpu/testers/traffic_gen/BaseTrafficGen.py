@@ -79,6 +79,12 @@ class BaseTrafficGen(ClockedObject):
         0, "Maximum number of outstanding requests"
     )
 
+    # Maximum number of packets issued in one update when several are
+    # due at the same tick, e.g. with a zero period or when a
+    # non-elastic generator catches up after back-pressure. Combine with
+    # max_outstanding_reqs to keep a bounded window of requests in flight.
+    issue_batch = Param.Unsigned(1, "Maximum number of packets per update")
+
     # Let the user know if we have waited for a retry and not made any
     # progress for a long period of time. The default value is
     # somewhat arbitrary and may well have to be tuned.
@@ -42,7 +42,10 @@ class GUPSGen(ClockedObject):
 
     system = Param.System(Parent.any, "System this generator is a part of")
 
-    port = RequestPort("Port that should be connected to other components")
+    port = VectorRequestPort(
+        "Ports that should be connected to other components, every port "
+        "runs its own window of outstanding updates"
+    )
 
     start_addr = Param.Addr(
         0,
@@ -62,7 +65,11 @@ class GUPSGen(ClockedObject):
     )
 
     request_queue_size = Param.Int(
-        1024, "Maximum number of parallel outstanding requests"
+        1024, "Maximum number of parallel outstanding updates per port"
+    )
+
+    requests_per_cycle = Param.Int(
+        1, "Number of requests every port creates and sends per cycle"
     )
 
     init_memory = Param.Bool(
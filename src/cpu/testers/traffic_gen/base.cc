@@ -76,6 +76,7 @@ BaseTrafficGen::BaseTrafficGen(const BaseTrafficGenParams &p)
       nextTransitionTick(0),
       nextPacketTick(0),
       maxOutstandingReqs(p.max_outstanding_reqs),
+      issueBatch(std::max(p.issue_batch, 1u)),
       port(name() + ".port", *this),
       retryPkt(NULL),
       retryPktTick(0), blockedWaitingResp(false),
@@ -176,44 +177,19 @@ BaseTrafficGen::update()
     if (curTick() >= nextTransitionTick) {
         transition();
     } else {
-        assert(curTick() >= nextPacketTick);
-        // get the next packet and try to send it
-        PacketPtr pkt = activeGenerator->getNextPacket();
-
-        // If generating stream/substream IDs are enabled,
-        // try to pick and assign them to the new packet
-        if (streamGenerator) {
-            auto sid = streamGenerator->pickStreamID();
-            auto ssid = streamGenerator->pickSubstreamID();
-
-            pkt->req->setStreamId(sid);
-
-            if (streamGenerator->ssidValid()) {
-                pkt->req->setSubstreamId(ssid);
-            }
-        }
-
-        // suppress packets that are not destined for a memory, such as
-        // device accesses that could be part of a trace
-        if (pkt && system->isMemAddr(pkt->getAddr())) {
-            stats.numPackets++;
-            // Only attempts to send if not blocked by pending responses
-            blockedWaitingResp = allocateWaitingRespSlot(pkt);
-            if (blockedWaitingResp || !port.sendTimingReq(pkt)) {
-                retryPkt = pkt;
-                retryPktTick = curTick();
+        // issue the packets that are due now, up to a batch
+        for (unsigned issued = 1; ; ++issued) {
+            assert(curTick() >= nextPacketTick);
+            issuePacket();
+            if (retryPkt != NULL || issued == issueBatch)
+                break;
+
+            nextPacketTick = activeGenerator->nextPacketTick(elasticReq, 0);
+            if (nextPacketTick > curTick() ||
+                curTick() >= nextTransitionTick) {
+                scheduleUpdate();
+                return;
             }
-        } else if (pkt) {
-            DPRINTF(TrafficGen, "Suppressed packet %s 0x%x\n",
-                    pkt->cmdString(), pkt->getAddr());
-
-            ++stats.numSuppressed;
-            if (!(static_cast<int>(stats.numSuppressed.value()) % 10000))
-                warn("%s suppressed %d packets with non-memory addresses\n",
-                     name(), stats.numSuppressed.value());
-
-            delete pkt;
-            pkt = nullptr;
         }
     }
 
@@ -226,6 +202,50 @@ BaseTrafficGen::update()
     }
 }
 
+void
+BaseTrafficGen::issuePacket()
+{
+    // get the next packet and try to send it
+    PacketPtr pkt = activeGenerator->getNextPacket();
+
+    // If generating stream/substream IDs are enabled,
+    // try to pick and assign them to the new packet
+    if (streamGenerator) {
+        auto sid = streamGenerator->pickStreamID();
+        auto ssid = streamGenerator->pickSubstreamID();
+
+        pkt->req->setStreamId(sid);
+
+        if (streamGenerator->ssidValid()) {
+            pkt->req->setSubstreamId(ssid);
+        }
+    }
+
+    // suppress packets that are not destined for a memory, such as
+    // device accesses that could be part of a trace
+    if (pkt && system->isMemAddr(pkt->getAddr())) {
+        stats.numPackets++;
+        stats.bytesRequested += pkt->getSize();
+        // Only attempts to send if not blocked by pending responses
+        blockedWaitingResp = allocateWaitingRespSlot(pkt);
+        if (blockedWaitingResp || !port.sendTimingReq(pkt)) {
+            retryPkt = pkt;
+            retryPktTick = curTick();
+        }
+    } else if (pkt) {
+        DPRINTF(TrafficGen, "Suppressed packet %s 0x%x\n",
+                pkt->cmdString(), pkt->getAddr());
+
+        ++stats.numSuppressed;
+        if (!(static_cast<int>(stats.numSuppressed.value()) % 10000))
+            warn("%s suppressed %d packets with non-memory addresses\n",
+                 name(), stats.numSuppressed.value());
+
+        delete pkt;
+        pkt = nullptr;
+    }
+}
+
 void
 BaseTrafficGen::transition()
 {
@@ -362,8 +382,28 @@ BaseTrafficGen::StatGroup::StatGroup(statistics::Group *parent)
                "Read bandwidth", bytesRead / simSeconds),
       ADD_STAT(writeBW, statistics::units::Rate<
                     statistics::units::Byte, statistics::units::Second>::get(),
-               "Write bandwidth", bytesWritten / simSeconds)
+               "Write bandwidth", bytesWritten / simSeconds),
+      ADD_STAT(bytesRequested, statistics::units::Byte::get(),
+               "Number of bytes in the generated requests"),
+      ADD_STAT(requestedBW, statistics::units::Rate<
+                    statistics::units::Byte, statistics::units::Second>::get(),
+               "Bandwidth requested by the generators",
+               bytesRequested / simSeconds),
+      ADD_STAT(achievedBW, statistics::units::Rate<
+                    statistics::units::Byte, statistics::units::Second>::get(),
+               "Bandwidth achieved for the completed requests",
+               (bytesRead + bytesWritten) / simSeconds),
+      ADD_STAT(readLatencyDist, statistics::units::Tick::get(),
+               "Distribution of the read request latencies"),
+      ADD_STAT(writeLatencyDist, statistics::units::Tick::get(),
+               "Distribution of the write request latencies")
 {
+    readLatencyDist
+        .init(32)
+        .flags(statistics::nozero);
+    writeLatencyDist
+        .init(32)
+        .flags(statistics::nozero);
 }
 
 std::shared_ptr<BaseGen>
@@ -570,10 +610,12 @@ BaseTrafficGen::recvTimingResp(PacketPtr pkt)
         ++stats.totalWrites;
         stats.bytesWritten += pkt->req->getSize();
         stats.totalWriteLatency += curTick() - iter->second;
+        stats.writeLatencyDist.sample(curTick() - iter->second);
     } else {
         ++stats.totalReads;
         stats.bytesRead += pkt->req->getSize();
         stats.totalReadLatency += curTick() - iter->second;
+        stats.readLatencyDist.sample(curTick() - iter->second);
     }
 
     waitingResp.erase(iter);
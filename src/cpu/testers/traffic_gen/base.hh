@@ -125,6 +125,9 @@ class BaseTrafficGen : public ClockedObject
 
     const int maxOutstandingReqs;
 
+    /** Maximum number of packets issued in one update. */
+    const unsigned issueBatch;
+
 
     /** Request port specialisation for the traffic generator */
     class TrafficGenPort : public RequestPort
@@ -160,6 +163,12 @@ class BaseTrafficGen : public ClockedObject
      */
     void update();
 
+    /**
+     * Get the next packet from the active generator and try to send
+     * it, leaving it in retryPkt if it can't be sent.
+     */
+    void issuePacket();
+
     /** The instance of request port used by the traffic generator. */
     TrafficGenPort port;
 
@@ -239,6 +248,21 @@ class BaseTrafficGen : public ClockedObject
 
         /** Write bandwidth in bytes/s  */
         statistics::Formula writeBW;
+
+        /** Count the bytes of the generated packets. */
+        statistics::Scalar bytesRequested;
+
+        /** Bandwidth the generators asked for in bytes/s */
+        statistics::Formula requestedBW;
+
+        /** Bandwidth the memory system delivered in bytes/s */
+        statistics::Formula achievedBW;
+
+        /** Distribution of the read latencies */
+        statistics::Histogram readLatencyDist;
+
+        /** Distribution of the write latencies */
+        statistics::Histogram writeLatencyDist;
     } stats;
 
   public:
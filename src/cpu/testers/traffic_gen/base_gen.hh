@@ -73,7 +73,7 @@ class BaseGen
     /** The RequestorID used for generating requests */
     const RequestorID requestorId;
 
-    mutable Random::RandomPtr rng = Random::genRandom();
+    mutable Random::RandomPtr rng = Random::genRandom(_name);
 
     /**
      * Generate a new request and associated packet
@@ -31,6 +31,7 @@
 #include <cstring>
 #include <string>
 
+#include "base/cprintf.hh"
 #include "debug/GUPSGen.hh"
 #include "sim/sim_exit.hh"
 
@@ -43,15 +44,25 @@ GUPSGen::GUPSGen(const GUPSGenParams& params):
     nextSendEvent([this]{ sendNextReq(); }, name()),
     system(params.system),
     requestorId(system->getRequestorId(this)),
-    port(name() + ".port", this),
     startAddr(params.start_addr),
     memSize(params.mem_size),
     updateLimit(params.update_limit),
     elementSize(sizeof(uint64_t)), // every element in the table is a uint64_t
     reqQueueSize(params.request_queue_size),
+    requestsPerCycle(params.requests_per_cycle),
     initMemory(params.init_memory),
     stats(this)
-{}
+{
+    fatal_if(reqQueueSize < 1, "%s: request_queue_size must be at least 1.",
+             name());
+    fatal_if(requestsPerCycle < 1,
+             "%s: requests_per_cycle must be at least 1.", name());
+
+    for (size_t i = 0; i < params.port_port_connection_count; ++i) {
+        ports.emplace_back(new GenPort(csprintf("%s.port[%d]", name(), i),
+                                       this, i, reqQueueSize));
+    }
+}
 
 Port&
 GUPSGen::getPort(const std::string &if_name, PortID idx)
@@ -59,15 +70,20 @@ GUPSGen::getPort(const std::string &if_name, PortID idx)
     if (if_name != "port") {
         return ClockedObject::getPort(if_name, idx);
     } else {
-        return port;
+        fatal_if(idx < 0 || idx >= (PortID)ports.size(),
+                 "%s: Invalid port index %d.", name(), idx);
+        return *ports[idx];
     }
 }
 
 void
 GUPSGen::init()
 {
+    fatal_if(ports.empty(), "%s: The port is not connected.", name());
+
     doneReading = false;
     onTheFlyRequests = 0;
+    pendingUpdates = 0;
     readRequests = 0;
 
     tableSize = memSize / elementSize;
@@ -90,7 +106,7 @@ GUPSGen::startup()
             }
             Addr addr = indexToAddr(start_index);
             PacketPtr pkt = getWritePacket(addr, block_size, write_data.get());
-            port.sendFunctionalPacket(pkt);
+            ports[0]->sendFunctionalPacket(pkt);
             delete pkt;
         }
     }
@@ -107,7 +123,7 @@ GUPSGen::indexToAddr (uint64_t index)
 PacketPtr
 GUPSGen::getReadPacket(Addr addr, unsigned int size)
 {
-    RequestPtr req = std::make_shared<Request>(addr, size, 0, requestorId);
+    RequestPtr req = makeRequest(addr, size, 0, requestorId);
     // Dummy PC to have PC-based prefetchers latch on; get entropy into higher
     // bits
     req->setPC(((Addr)requestorId) << 2);
@@ -122,8 +138,8 @@ GUPSGen::getReadPacket(Addr addr, unsigned int size)
 PacketPtr
 GUPSGen::getWritePacket(Addr addr, unsigned int size, uint8_t *data)
 {
-    RequestPtr req = std::make_shared<Request>(addr, size, 0,
-                                               requestorId);
+    RequestPtr req = makeRequest(addr, size, 0,
+                                 requestorId);
     // Dummy PC to have PC-based prefetchers latch on; get entropy into higher
     // bits
     req->setPC(((Addr)requestorId) << 2);
@@ -136,11 +152,14 @@ GUPSGen::getWritePacket(Addr addr, unsigned int size, uint8_t *data)
 }
 
 void
-GUPSGen::handleResponse(PacketPtr pkt)
+GUPSGen::handleResponse(GenPort &port, PacketPtr pkt)
 {
     onTheFlyRequests--;
     DPRINTF(GUPSGen, "%s: onTheFlyRequests: %d.\n",
                 __func__, onTheFlyRequests);
+
+    UpdateSlot *slot = static_cast<UpdateSlot *>(pkt->popSenderState());
+    Tick latency = curTick() - slot->exitTime;
     if (pkt->isWrite()) {
         DPRINTF(GUPSGen, "%s: received a write resp. pkt->addr_range: %s,"
                         " pkt->data: %d\n", __func__,
@@ -149,9 +168,12 @@ GUPSGen::handleResponse(PacketPtr pkt)
         stats.totalUpdates++;
         stats.totalWrites++;
         stats.totalBytesWritten += elementSize;
-        stats.totalWriteLat += curTick() - exitTimes[pkt->req];
+        stats.totalWriteLat += latency;
+        stats.portUpdates[port.getId()]++;
+        stats.portBytes[port.getId()] += elementSize;
 
-        exitTimes.erase(pkt->req);
+        port.freeSlot(slot);
+        pendingUpdates--;
         delete pkt;
     } else {
         DPRINTF(GUPSGen, "%s: received a read resp. pkt->addr_range: %s\n",
@@ -159,122 +181,149 @@ GUPSGen::handleResponse(PacketPtr pkt)
 
         stats.totalReads++;
         stats.totalBytesRead += elementSize;
-        stats.totalReadLat += curTick() - exitTimes[pkt->req];
+        stats.totalReadLat += latency;
+        stats.portBytes[port.getId()] += elementSize;
 
-        exitTimes.erase(pkt->req);
-
-        responsePool.push(pkt);
+        // keep the slot with the packet for the write of the update
+        pkt->pushSenderState(slot);
+        port.responsePool.push(pkt);
     }
-    if (doneReading && requestPool.empty() && onTheFlyRequests == 0) {
+    if (doneReading && pendingUpdates == 0) {
         exitSimLoop(name() + " is finished updating the memory.\n");
         return;
     }
 
-    if ((requestPool.size() < reqQueueSize) &&
-        (!doneReading || !responsePool.empty()) &&
-        !nextCreateEvent.scheduled())
-    {
-        schedule(nextCreateEvent, nextCycle());
-    }
+    scheduleCreate();
 }
 
 void
 GUPSGen::wakeUp()
 {
-    if (!nextSendEvent.scheduled() && !requestPool.empty()) {
-        schedule(nextSendEvent, nextCycle());
-    }
+    scheduleSend();
+}
+
+bool
+GUPSGen::canCreate(const GenPort &port) const
+{
+    return !port.responsePool.empty() ||
+        (!doneReading && port.hasFreeSlot());
 }
 
 void
-GUPSGen::createNextReq()
+GUPSGen::scheduleCreate()
 {
-    // Prioritize pending writes over reads
-    // Write as soon as the data is read
-    if (!responsePool.empty()) {
-        PacketPtr pkt = responsePool.front();
-        responsePool.pop();
-
-        uint64_t *updated_value = pkt->getPtr<uint64_t>();
-        DPRINTF(GUPSGen, "%s: Read value %lu from address %s", __func__,
-                            *updated_value, pkt->getAddrRange().to_string());
-        *updated_value ^= updateTable[pkt->req];
-        updateTable.erase(pkt->req);
-        Addr addr = pkt->getAddr();
-        PacketPtr new_pkt = getWritePacket(addr,
-                            elementSize, (uint8_t*) updated_value);
-        delete pkt;
-        requestPool.push(new_pkt);
-    } else if (!doneReading) {
-        // If no writes then read
-        // Check to make sure we're not reading more than we should.
-        assert (readRequests < numUpdates);
-
-        uint64_t value = readRequests;
-        uint64_t index = rng->random<int64_t>((int64_t) 0, tableSize);
-        Addr addr = indexToAddr(index);
-        PacketPtr pkt = getReadPacket(addr, elementSize);
-        updateTable[pkt->req] = value;
-        requestPool.push(pkt);
-        readRequests++;
-
-        if (readRequests >= numUpdates) {
-            DPRINTF(GUPSGen, "%s: Done creating reads.\n", __func__);
-            doneReading = true;
-        }
-        else if (readRequests == updateLimit && updateLimit != 0) {
-            DPRINTF(GUPSGen, "%s: Update limit reached.\n", __func__);
-            doneReading = true;
+    if (nextCreateEvent.scheduled())
+        return;
+
+    for (const auto &port : ports) {
+        if (canCreate(*port)) {
+            schedule(nextCreateEvent, nextCycle());
+            return;
         }
     }
+}
 
-    if (!nextCreateEvent.scheduled() &&
-        (requestPool.size() < reqQueueSize) &&
-        (!doneReading || !responsePool.empty()))
-    {
-        schedule(nextCreateEvent, nextCycle());
-    }
+void
+GUPSGen::scheduleSend()
+{
+    if (nextSendEvent.scheduled())
+        return;
 
-    if (!nextSendEvent.scheduled() && !requestPool.empty()) {
-        schedule(nextSendEvent, nextCycle());
+    for (const auto &port : ports) {
+        if (!port->blocked() && !port->requestPool.empty()) {
+            schedule(nextSendEvent, nextCycle());
+            return;
+        }
     }
 }
 
 void
-GUPSGen::sendNextReq()
+GUPSGen::createNextReq()
 {
-    if (!port.blocked()) {
-        PacketPtr pkt = requestPool.front();
-
-        exitTimes[pkt->req] = curTick();
-        if (pkt->isWrite()) {
-            DPRINTF(GUPSGen, "%s: Sent write pkt, pkt->addr_range: "
-                    "%s, pkt->data: %lu.\n", __func__,
-                    pkt->getAddrRange().to_string(),
-                    *pkt->getPtr<uint64_t>());
-        } else {
-            DPRINTF(GUPSGen, "%s: Sent read pkt, pkt->addr_range: %s.\n",
-                    __func__, pkt->getAddrRange().to_string());
+    for (auto &port : ports) {
+        for (int i = 0; i < requestsPerCycle && canCreate(*port); i++) {
+            // Prioritize pending writes over reads
+            // Write as soon as the data is read
+            if (!port->responsePool.empty()) {
+                PacketPtr pkt = port->responsePool.front();
+                port->responsePool.pop();
+
+                UpdateSlot *slot =
+                    static_cast<UpdateSlot *>(pkt->popSenderState());
+                uint64_t *updated_value = pkt->getPtr<uint64_t>();
+                DPRINTF(GUPSGen, "%s: Read value %lu from address %s",
+                        __func__, *updated_value,
+                        pkt->getAddrRange().to_string());
+                *updated_value ^= slot->value;
+                Addr addr = pkt->getAddr();
+                PacketPtr new_pkt = getWritePacket(addr,
+                                    elementSize, (uint8_t*) updated_value);
+                new_pkt->pushSenderState(slot);
+                delete pkt;
+                port->requestPool.push(new_pkt);
+            } else {
+                // If no writes then read
+                // Check to make sure we're not reading more than we should.
+                assert (readRequests < numUpdates);
+
+                UpdateSlot *slot = port->allocSlot();
+                slot->value = readRequests;
+                uint64_t index = rng->random<int64_t>((int64_t) 0,
+                                                      tableSize);
+                Addr addr = indexToAddr(index);
+                PacketPtr pkt = getReadPacket(addr, elementSize);
+                pkt->pushSenderState(slot);
+                port->requestPool.push(pkt);
+                readRequests++;
+                pendingUpdates++;
+
+                if (readRequests >= numUpdates) {
+                    DPRINTF(GUPSGen, "%s: Done creating reads.\n",
+                            __func__);
+                    doneReading = true;
+                }
+                else if (readRequests == updateLimit && updateLimit != 0) {
+                    DPRINTF(GUPSGen, "%s: Update limit reached.\n",
+                            __func__);
+                    doneReading = true;
+                }
+            }
         }
-        port.sendTimingPacket(pkt);
-        onTheFlyRequests++;
-        DPRINTF(GUPSGen, "%s: onTheFlyRequests: %d.\n",
-                __func__, onTheFlyRequests);
-        requestPool.pop();
     }
 
-    if (!nextCreateEvent.scheduled() &&
-        (requestPool.size() < reqQueueSize) &&
-        (!doneReading || !responsePool.empty()))
-    {
-        schedule(nextCreateEvent, nextCycle());
-    }
+    scheduleCreate();
+    scheduleSend();
+}
 
-    if (!nextSendEvent.scheduled()) {
-        if (!requestPool.empty()) {
-            schedule(nextSendEvent, nextCycle());
+void
+GUPSGen::sendNextReq()
+{
+    for (auto &port : ports) {
+        for (int i = 0; i < requestsPerCycle && !port->blocked() &&
+                 !port->requestPool.empty(); i++) {
+            PacketPtr pkt = port->requestPool.front();
+
+            static_cast<UpdateSlot *>(pkt->senderState)->exitTime =
+                curTick();
+            if (pkt->isWrite()) {
+                DPRINTF(GUPSGen, "%s: Sent write pkt, pkt->addr_range: "
+                        "%s, pkt->data: %lu.\n", __func__,
+                        pkt->getAddrRange().to_string(),
+                        *pkt->getPtr<uint64_t>());
+            } else {
+                DPRINTF(GUPSGen, "%s: Sent read pkt, pkt->addr_range: %s.\n",
+                        __func__, pkt->getAddrRange().to_string());
+            }
+            port->sendTimingPacket(pkt);
+            onTheFlyRequests++;
+            DPRINTF(GUPSGen, "%s: onTheFlyRequests: %d.\n",
+                    __func__, onTheFlyRequests);
+            port->requestPool.pop();
         }
     }
+
+    scheduleCreate();
+    scheduleSend();
 }
 
 
@@ -319,12 +368,12 @@ GUPSGen::GenPort::recvReqRetry()
 bool
 GUPSGen::GenPort::recvTimingResp(PacketPtr pkt)
 {
-    owner->handleResponse(pkt);
+    owner->handleResponse(*this, pkt);
     return true;
 }
 
 GUPSGen::GUPSGenStat::GUPSGenStat(GUPSGen* parent) :
-    statistics::Group(parent),
+    statistics::Group(parent), gups(parent),
     ADD_STAT(totalUpdates, statistics::units::Count::get(),
         "Total number of updates the generator made in the memory"),
     ADD_STAT(GUPS, statistics::units::Rate<statistics::units::Count,
@@ -351,7 +400,17 @@ GUPSGen::GUPSGenStat::GUPSGenStat(GUPSGen* parent) :
     ADD_STAT(totalWriteLat, statistics::units::Tick::get(),
         "Total latency of write requests."),
     ADD_STAT(avgWriteLat, statistics::units::Tick::get(),
-        "Average latency for write requests")
+        "Average latency for write requests"),
+    ADD_STAT(portUpdates, statistics::units::Count::get(),
+        "Number of updates made through each port"),
+    ADD_STAT(portGUPS, statistics::units::Rate<statistics::units::Count,
+                statistics::units::Second>::get(),
+        "Rate of billion updates per second through each port"),
+    ADD_STAT(portBytes, statistics::units::Byte::get(),
+        "Number of bytes read and written through each port"),
+    ADD_STAT(portBW, statistics::units::Rate<statistics::units::Byte,
+                statistics::units::Second>::get(),
+        "Bandwidth of the reads and writes through each port")
 {}
 
 void
@@ -370,6 +429,19 @@ GUPSGen::GUPSGenStat::regStats()
 
     avgWriteBW = totalBytesWritten / simSeconds;
     avgWriteLat = (totalWriteLat) / totalWrites;
+
+    const int num_ports = gups->ports.size();
+    portUpdates.init(num_ports);
+    portBytes.init(num_ports);
+    for (int i = 0; i < num_ports; i++) {
+        portUpdates.subname(i, csprintf("port%d", i));
+        portBytes.subname(i, csprintf("port%d", i));
+    }
+
+    portGUPS.precision(8);
+    portBW.precision(2);
+    portGUPS = (portUpdates / 1e9) / simSeconds;
+    portBW = portBytes / simSeconds;
 }
 
 }
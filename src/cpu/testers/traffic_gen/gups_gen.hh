@@ -37,8 +37,8 @@
  * Find more details: [https://icl.cs.utk.edu/projectsfiles/hpcc/RandomAccess/]
  */
 
+#include <memory>
 #include <queue>
-#include <unordered_map>
 #include <vector>
 
 #include "base/random.hh"
@@ -55,6 +55,26 @@ class GUPSGen : public ClockedObject
 {
   private:
 
+    /**
+     * @brief State of an update that is being done. The update reads the
+     * element, and then writes it back xor'ed with the value. It rides
+     * along the packets of the update as their sender state, so that the
+     * responses find it without a lookup.
+     */
+    struct UpdateSlot : public Packet::SenderState
+    {
+        /**
+         * @brief The value to update the element with.
+         */
+        uint64_t value = 0;
+
+        /**
+         * @brief The time at which the current request of the update
+         * exited the GUPSGen, used to compute its latency.
+         */
+        Tick exitTime = 0;
+    };
+
     /**
      * @brief definition of the GenPort class which is of the type RequestPort.
      * It defines the functionalities required for outside communication of
@@ -85,12 +105,68 @@ class GUPSGen : public ClockedObject
          */
         PacketPtr blockedPacket;
 
+        /**
+         * @brief The updates slots of this port, allocated once for the
+         * whole window of outstanding updates.
+         */
+        std::vector<UpdateSlot> slots;
+
+        /**
+         * @brief The slots that are not used by an update.
+         */
+        std::vector<UpdateSlot *> freeSlots;
+
       public:
 
-        GenPort(const std::string& name, GUPSGen *owner) :
-            RequestPort(name), owner(owner), _blocked(false),
-            blockedPacket(nullptr)
-        {}
+        /**
+         * @brief A queue to store the requests of this port whether read or
+         * write. The element at the front of the queue is sent to outside
+         * everytime nextSendEvent is scheduled.
+         */
+        std::queue<PacketPtr> requestPool;
+
+        /**
+         * @brief A queue to store response packets from reads. each
+         * response in the response pool will generate a write request. The
+         * write request updates the value of data in the response packet
+         * with the value of its update.
+         */
+        std::queue<PacketPtr> responsePool;
+
+        GenPort(const std::string& name, GUPSGen *owner, PortID id,
+                int window) :
+            RequestPort(name, id), owner(owner), _blocked(false),
+            blockedPacket(nullptr), slots(window)
+        {
+            freeSlots.reserve(window);
+            for (auto &slot : slots)
+                freeSlots.push_back(&slot);
+        }
+
+        /**
+         * @brief Claim a slot for a new update.
+         *
+         * @return A free slot, or nullptr if the window is full.
+         */
+        UpdateSlot *
+        allocSlot()
+        {
+            if (freeSlots.empty())
+                return nullptr;
+            UpdateSlot *slot = freeSlots.back();
+            freeSlots.pop_back();
+            return slot;
+        }
+
+        /**
+         * @brief Release the slot of an update that is done.
+         */
+        void freeSlot(UpdateSlot *slot) { freeSlots.push_back(slot); }
+
+        /**
+         * @brief Return whether the window has room for another update.
+         */
+        bool hasFreeSlot() const { return !freeSlots.empty(); }
 
         /**
          * @brief Return whether the port is blocked.
@@ -158,9 +234,10 @@ class GUPSGen : public ClockedObject
 
     /**
      * @brief Handles the incoming responses from the outside.
+     * @param port The port that received the response.
      * @param pkt Pointer to the packet that includes the response.
      */
-    void handleResponse(PacketPtr pkt);
+    void handleResponse(GenPort &port, PacketPtr pkt);
 
     /**
      * @brief This function allows the port to wake its owner GUPSGen object
@@ -170,56 +247,42 @@ class GUPSGen : public ClockedObject
     void wakeUp();
 
     /**
-     * @brief Create the next request and store in the requestPool.
+     * @brief Return whether a port has a request to create.
      */
-    void createNextReq();
+    bool canCreate(const GenPort &port) const;
 
     /**
-     * @brief Corresponding event to the createNextReq function. Scheduled
-     * whenever a request needs to and can be created.
+     * @brief Schedule nextCreateEvent if any port has a request to create.
      */
-    EventFunctionWrapper nextCreateEvent;
+    void scheduleCreate();
 
     /**
-     * @brief Send outstanding requests from requestPool to the port.
+     * @brief Schedule nextSendEvent if any port has a request to send.
      */
-    void sendNextReq();
+    void scheduleSend();
 
     /**
-     * @brief Corresponding event to the sendNextReq function. Scheduled
-     * whenever a request needs to and can be sent.
+     * @brief Create the next requests of every port and store them in the
+     * requestPool of the port.
      */
-    EventFunctionWrapper nextSendEvent;
-
-    /**
-     * @brief Use an unordered map to store future updates on current reads
-     * as the updated value depends on the index which is know when a read
-     * request is created. The respective write will use the value stored to
-     * update the value.
-     */
-    std::unordered_map<RequestPtr, uint64_t> updateTable;
+    void createNextReq();
 
     /**
-     * @brief Use an unordered map to track the time at which each request
-     * exits the GUPSGen. This is useful when we need to compute request
-     * latency.
+     * @brief Corresponding event to the createNextReq function. Scheduled
+     * whenever a request needs to and can be created.
      */
-    std::unordered_map<RequestPtr, Tick> exitTimes;
+    EventFunctionWrapper nextCreateEvent;
 
     /**
-     * @brief A queue to store the outstanding requests whether read or write.
-     * The element at the front of the queue is sent to outside everytime
-     * nextSendEvent is scheduled.
+     * @brief Send outstanding requests from the requestPool of every port.
      */
-    std::queue<PacketPtr> requestPool;
+    void sendNextReq();
 
     /**
-     * @brief A queue to store response packets from reads. each response in
-     * the response pool will generate a write request. The write request
-     * updates the value of data in the response packet with its corresponding
-     * value in the update table.
+     * @brief Corresponding event to the sendNextReq function. Scheduled
+     * whenever a request needs to and can be sent.
      */
-    std::queue<PacketPtr> responsePool;
+    EventFunctionWrapper nextSendEvent;
 
     /**
      * @brief The total number of updates (one read and one write) to do for
@@ -245,9 +308,10 @@ class GUPSGen : public ClockedObject
     const RequestorID requestorId;
 
     /**
-     * @brief An instance of GenPort to communicate with the outside.
+     * @brief The ports to communicate with the outside. Every port has
+     * its own window of outstanding updates.
      */
-    GenPort port;
+    std::vector<std::unique_ptr<GenPort>> ports;
 
     /**
      * @brief The beginning address for allocating the array.
@@ -271,11 +335,16 @@ class GUPSGen : public ClockedObject
     const int elementSize;
 
     /**
-     * @brief  The maximum number of outstanding requests (i.e. maximum length
-     * of the requestPool), specified as 1024 by the HPCC benchmark.
+     * @brief  The maximum number of outstanding updates per port, specified
+     * as 1024 by the HPCC benchmark.
      */
     int reqQueueSize;
 
+    /**
+     * @brief The number of requests every port creates and sends per cycle.
+     */
+    const int requestsPerCycle;
+
     /**
      * @brief Boolean value to determine whether we need to initialize the
      * array with the right values, as we don't care about the values, this
@@ -297,6 +366,11 @@ class GUPSGen : public ClockedObject
      */
     int onTheFlyRequests;
 
+    /**
+     * @brief The number of updates that are not done yet, over all ports.
+     */
+    int pendingUpdates;
+
     /**
      * @brief The number of read requests currently created.
      */
@@ -309,6 +383,8 @@ class GUPSGen : public ClockedObject
         GUPSGenStat(GUPSGen* parent);
         void regStats() override;
 
+        GUPSGen *gups;
+
         statistics::Scalar totalUpdates;
         statistics::Formula GUPS;
 
@@ -323,6 +399,12 @@ class GUPSGen : public ClockedObject
         statistics::Formula avgWriteBW;
         statistics::Scalar totalWriteLat;
         statistics::Formula avgWriteLat;
+
+        /** Updates and bytes moved by each port */
+        statistics::Vector portUpdates;
+        statistics::Formula portGUPS;
+        statistics::Vector portBytes;
+        statistics::Formula portBW;
     } stats;
 
   public:
@@ -44,9 +44,12 @@
 #ifndef __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 #define __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 
+#include <memory>
+
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base_gen.hh"
+#include "mem/binary_packet_trace.hh"
 #include "mem/packet.hh"
 #include "proto/protoio.hh"
 
@@ -104,15 +107,19 @@ class TraceGen : public BaseGen
     /**
      * The InputStream encapsulates a trace file and the
      * internal buffers and populates TraceElements based on
-     * the input.
+     * the input. The trace is either a protobuf packet trace or a
+     * binary packet trace.
      */
     class InputStream
     {
 
       private:
 
-        /// Input file stream for the protobuf trace
-        ProtoInputStream trace;
+        /// Input file stream for a protobuf trace
+        std::unique_ptr<ProtoInputStream> protoTrace;
+
+        /// Mapped binary trace
+        std::unique_ptr<binary_packet_trace::Reader> binaryTrace;
 
       public:
 
@@ -120,7 +120,7 @@ class TrafficGen : public BaseTrafficGen
     /** Map of generator states */
     std::unordered_map<uint32_t, std::shared_ptr<BaseGen>> states;
 
-    Random::RandomPtr rng = Random::genRandom();
+    Random::RandomPtr rng = Random::genRandom(name());
 
   protected: // BaseTrafficGen
     std::shared_ptr<BaseGen> nextGenerator() override;
@@ -51,6 +51,7 @@
 #include "debug/Quiesce.hh"
 #include "mem/port.hh"
 #include "params/BaseCPU.hh"
+#include "sim/eventq.hh"
 #include "sim/full_system.hh"
 
 namespace gem5
@@ -264,4 +265,18 @@ takeOverFrom(ThreadContext &ntc, ThreadContext &otc)
     otc.setStatus(ThreadContext::Halted);
 }
 
+void
+runOnContextQueue(ThreadContext *tc, std::function<void()> update)
+{
+    EventQueue *eq = tc->getCpuPtr()->eventQueue();
+    if (!inParallelMode || eq == curEventQueue()) {
+        update();
+        return;
+    }
+
+    eq->schedule(new EventFunctionWrapper(std::move(update),
+                                          "runOnContextQueue", true),
+                 curTick() + simQuantum);
+}
+
 } // namespace gem5
@@ -42,6 +42,7 @@
 #ifndef __CPU_THREAD_CONTEXT_HH__
 #define __CPU_THREAD_CONTEXT_HH__
 
+#include <functional>
 #include <iostream>
 #include <string>
 
@@ -263,6 +264,20 @@ void unserialize(ThreadContext &tc, CheckpointIn &cp);
  */
 void takeOverFrom(ThreadContext &new_tc, ThreadContext &old_tc);
 
+/**
+ * Apply a change, such as an activation, to a thread context on behalf of
+ * the one being simulated, e.g. from a syscall.
+ *
+ * In parallel mode the target may be simulated by another event queue,
+ * whose thread must be the one touching it. The change is then deferred
+ * to an event of that queue one simulation quantum later, which keeps
+ * the queues in sync the way global events do.
+ *
+ * @param tc Thread context to change.
+ * @param update The change to apply.
+ */
+void runOnContextQueue(ThreadContext *tc, std::function<void()> update);
+
 } // namespace gem5
 
 #endif
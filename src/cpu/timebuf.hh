@@ -49,6 +49,14 @@ class TimeBuffer
     std::vector<char *> index;
     unsigned base;
 
+    /**
+     * Slots which may have been written since they were last cleared.
+     * Any non-const access marks a slot, as writes through a wire cannot
+     * be told apart from reads. Clean slots need not be cleared again
+     * when they are recycled by advance().
+     */
+    std::vector<bool> dirty;
+
     void valid(int idx) const
     {
         assert (idx >= -past && idx <= future);
@@ -139,7 +147,8 @@ class TimeBuffer
   public:
     TimeBuffer(int p, int f)
         : past(p), future(f), size(past + future + 1),
-          data(new char[size * sizeof(T)]), index(size), base(0)
+          data(new char[size * sizeof(T)]), index(size), base(0),
+          dirty(size, false)
     {
         assert(past >= 0 && future >= 0);
         char *ptr = data;
@@ -184,6 +193,9 @@ class TimeBuffer
         int ptr = base + future;
         if (ptr >= (int)size)
             ptr -= size;
+        if (!dirty[ptr])
+            return;
+        dirty[ptr] = false;
         (reinterpret_cast<T *>(index[ptr]))->~T();
         std::memset(index[ptr], 0, sizeof(T));
         new (index[ptr]) T;
@@ -211,6 +223,7 @@ class TimeBuffer
     T *access(int idx)
     {
         int vector_index = calculateVectorIndex(idx);
+        dirty[vector_index] = true;
 
         return reinterpret_cast<T *>(index[vector_index]);
     }
@@ -218,6 +231,7 @@ class TimeBuffer
     T &operator[](int idx)
     {
         int vector_index = calculateVectorIndex(idx);
+        dirty[vector_index] = true;
 
         return reinterpret_cast<T &>(*index[vector_index]);
     }
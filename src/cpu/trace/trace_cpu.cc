@@ -593,7 +593,7 @@ TraceCPU::ElasticDataGen::executeMemReq(GraphNode* node_ptr)
     }
 
     // Create a request and the packet containing request
-    auto req = std::make_shared<Request>(
+    auto req = makeRequest(
         node_ptr->physAddr, node_ptr->size, node_ptr->flags, requestorId);
     req->setReqInstSeqNum(node_ptr->seqNum);
 
@@ -1084,7 +1084,7 @@ TraceCPU::FixedRetryGen::send(Addr addr, unsigned size, const MemCmd& cmd,
 {
 
     // Create new request
-    auto req = std::make_shared<Request>(addr, size, flags, requestorId);
+    auto req = makeRequest(addr, size, flags, requestorId);
     req->setPC(pc);
 
     // If this is not done it triggers assert in L1 cache for invalid contextId
@@ -1204,7 +1204,7 @@ TraceCPU::DcachePort::recvReqRetry()
 
 TraceCPU::ElasticDataGen::InputStream::InputStream(
         const std::string& filename, const double time_multiplier) :
-    trace(filename),
+    trace(filename, true),
     timeMultiplier(time_multiplier),
     microOpCount(0)
 {
@@ -1387,11 +1387,20 @@ TraceCPU::ElasticDataGen::GraphNode::typeToStr() const
 }
 
 TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
 {
+    if (binary_packet_trace::isTrace(filename)) {
+        binaryTrace.reset(new binary_packet_trace::Reader(filename));
+        panic_if(binaryTrace->header().tickFreq != sim_clock::Frequency,
+                 "Trace %s was recorded with a different tick frequency %d\n",
+                 filename, binaryTrace->header().tickFreq);
+        return;
+    }
+
+    protoTrace.reset(new ProtoInputStream(filename, true));
+
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
-    if (!trace.read(header_msg)) {
+    if (!protoTrace->read(header_msg)) {
         panic("Failed to read packet header from %s\n", filename);
 
         if (header_msg.tick_freq() != sim_clock::Frequency) {
@@ -1404,14 +1413,30 @@ TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
 void
 TraceCPU::FixedRetryGen::InputStream::reset()
 {
-    trace.reset();
+    if (binaryTrace)
+        binaryTrace->reset();
+    else
+        protoTrace->reset();
 }
 
 bool
 TraceCPU::FixedRetryGen::InputStream::read(TraceElement* element)
 {
+    if (binaryTrace) {
+        binary_packet_trace::Record record;
+        if (!binaryTrace->read(record))
+            return false;
+        element->cmd = (MemCmd::Command)record.cmd;
+        element->addr = record.addr;
+        element->blocksize = record.size;
+        element->tick = record.tick;
+        element->flags = record.flags;
+        element->pc = record.pc;
+        return true;
+    }
+
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (protoTrace->read(pkt_msg)) {
         element->cmd = pkt_msg.cmd();
         element->addr = pkt_msg.addr();
         element->blocksize = pkt_msg.size();
@@ -40,6 +40,7 @@
 
 #include <cstdint>
 #include <list>
+#include <memory>
 #include <queue>
 #include <set>
 #include <unordered_map>
@@ -47,6 +48,7 @@
 #include "base/statistics.hh"
 #include "debug/TraceCPUData.hh"
 #include "debug/TraceCPUInst.hh"
+#include "mem/binary_packet_trace.hh"
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/request.hh"
@@ -354,13 +356,17 @@ class TraceCPU : public ClockedObject
         /**
          * The InputStream encapsulates a trace file and the
          * internal buffers and populates TraceElements based on
-         * the input.
+         * the input. The trace is either a protobuf packet trace or
+         * a binary packet trace.
          */
         class InputStream
         {
           private:
-            // Input file stream for the protobuf trace
-            ProtoInputStream trace;
+            // Input file stream for a protobuf trace
+            std::unique_ptr<ProtoInputStream> protoTrace;
+
+            // Mapped binary trace
+            std::unique_ptr<binary_packet_trace::Reader> binaryTrace;
 
           public:
             /**
@@ -109,6 +109,19 @@ class DmaDevice(PioDevice):
         "several devices attached to it",
     )
 
+    dma_backdoor = Param.Bool(
+        False,
+        "In timing mode, move DMA data through memory backdoors when one "
+        "covers a whole request, modeling only aggregate latency and "
+        "bandwidth instead of sending one packet per cache line",
+    )
+    dma_backdoor_latency = Param.Latency(
+        "0ns", "Fixed latency of a DMA transfer through a backdoor"
+    )
+    dma_backdoor_bandwidth = Param.MemoryBandwidth(
+        "16GiB/s", "Aggregate bandwidth of DMA transfers through backdoors"
+    )
+
     def addIommuProperty(self, state, node):
         """
         This method takes an FdtState and a FdtNode as parameters, and
@@ -59,11 +59,21 @@ namespace gem5
 DmaPort::DmaPort(ClockedObject *dev, System *s,
                  std::optional<uint32_t> sid, std::optional<uint32_t> ssid)
     : RequestPort(dev->name() + ".dma"),
+      bdDoneEvent([this]{ completeBdTransfers(); },
+                  dev->name() + ".dma.bdDone"),
       device(dev), sys(s), requestorId(s->getRequestorId(dev)),
       sendEvent([this]{ sendDma(); }, dev->name()),
       defaultSid(sid), defaultSSid(ssid), cacheLineSize(s->cacheLineSize())
 { }
 
+void
+DmaPort::enableTimingBackdoor(Tick latency, double ticks_per_byte)
+{
+    timingBackdoor = true;
+    backdoorLatency = latency;
+    backdoorTicksPerByte = ticks_per_byte;
+}
+
 void
 DmaPort::handleRespPacket(PacketPtr pkt, Tick delay)
 {
@@ -128,7 +138,7 @@ DmaPort::handleResp(DmaReqState *state, Addr addr, Addr size, Tick delay)
 PacketPtr
 DmaPort::DmaReqState::createPacket()
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
             gen.addr(), gen.size(), flags, id);
     if (sid.has_value()) {
         req->setStreamId(sid.value());
@@ -161,7 +171,11 @@ DmaPort::recvTimingResp(PacketPtr pkt)
 
 DmaDevice::DmaDevice(const Params &p)
     : PioDevice(p), dmaPort(this, sys, p.sid, p.ssid)
-{ }
+{
+    if (p.dma_backdoor)
+        dmaPort.enableTimingBackdoor(p.dma_backdoor_latency,
+                                     p.dma_backdoor_bandwidth);
+}
 
 void
 DmaDevice::init()
@@ -252,6 +266,11 @@ DmaPort::abortPending()
     if (sendEvent.scheduled())
         device->deschedule(sendEvent);
 
+    // Backdoor transfers have already moved their data, but they still
+    // count as in flight until their modeled completion time.
+    for (auto &transfer : bdTransfers)
+        transfer.second->aborted = true;
+
     if (pendingCount == 0)
         signalDrainDone();
 }
@@ -299,6 +318,95 @@ DmaPort::trySendTimingReq()
             transmitList.size(), retryPending ? 1 : 0);
 }
 
+void
+DmaPort::recordBackdoor(MemBackdoorPtr bd)
+{
+    if (!bd || memBackdoors.insert(bd->range(), bd) == memBackdoors.end())
+        return;
+
+    // Invalidation callback which finds this backdoor and removes it.
+    auto callback = [this](const MemBackdoor &backdoor) {
+        for (auto it = memBackdoors.begin();
+                it != memBackdoors.end(); it++) {
+            if (it->second == &backdoor) {
+                memBackdoors.erase(it);
+                return;
+            }
+        }
+        panic("Got invalidation for unknown memory backdoor.");
+    };
+    bd->addInvalidationCallback(callback);
+}
+
+bool
+DmaPort::trySendTimingBd(DmaReqState *state)
+{
+    // Only whole requests which have not started sending packets yet, and
+    // which touch memory rather than a device, are candidates.
+    if (state->gen.complete() != 0 || state->totBytes == 0 ||
+            state->flags.isSet(Request::UNCACHEABLE)) {
+        return false;
+    }
+
+    const bool is_read = MemCmd(state->cmd).isRead();
+    const Addr start = state->gen.addr();
+    const AddrRange range = RangeSize(start, state->totBytes);
+
+    auto bd_it = memBackdoors.contains(range);
+    if (bd_it == memBackdoors.end()) {
+        MemBackdoorPtr bd = nullptr;
+        sendMemBackdoorReq(MemBackdoorReq(range, is_read ?
+                    MemBackdoor::Readable : MemBackdoor::Writeable), bd);
+        recordBackdoor(bd);
+        bd_it = memBackdoors.contains(range);
+        if (bd_it == memBackdoors.end())
+            return false;
+    }
+
+    const auto *bd = bd_it->second;
+    if (is_read ? !bd->readable() : !bd->writeable())
+        return false;
+
+    DPRINTF(DMA, "Handling timing DMA for addr: %#x size %d through "
+            "backdoor\n", start, state->totBytes);
+
+    if (state->data) {
+        uint8_t *bd_data = bd->ptr() + (start - bd->range().start());
+        if (is_read)
+            memcpy(state->data, bd_data, state->totBytes);
+        else
+            memcpy(bd_data, state->data, state->totBytes);
+    }
+    state->gen.setNext(start + state->totBytes);
+    transmitList.pop_front();
+    pendingCount++;
+
+    // Transfers are serialized on the backdoor path, so their completion
+    // ticks are monotonic and a single event suffices.
+    const Tick begin = std::max(curTick(), backdoorFreeAt);
+    backdoorFreeAt = begin + Tick(state->totBytes * backdoorTicksPerByte);
+    const Tick when = backdoorFreeAt + backdoorLatency;
+    bdTransfers.emplace_back(when, state);
+    if (!bdDoneEvent.scheduled())
+        device->schedule(bdDoneEvent, when);
+
+    return true;
+}
+
+void
+DmaPort::completeBdTransfers()
+{
+    while (!bdTransfers.empty() && bdTransfers.front().first <= curTick()) {
+        DmaReqState *state = bdTransfers.front().second;
+        bdTransfers.pop_front();
+        handleResp(state, state->gen.addr() - state->totBytes,
+                   state->totBytes);
+    }
+
+    if (!bdTransfers.empty())
+        device->schedule(bdDoneEvent, bdTransfers.front().first);
+}
+
 bool
 DmaPort::sendAtomicReq(DmaReqState *state)
 {
@@ -332,20 +440,7 @@ DmaPort::sendAtomicBdReq(DmaReqState *state)
         Tick lat = sendAtomicBackdoor(pkt, bd);
 
         // If we got a backdoor, record it.
-        if (bd && memBackdoors.insert(bd->range(), bd) != memBackdoors.end()) {
-            // Invalidation callback which finds this backdoor and removes it.
-            auto callback = [this](const MemBackdoor &backdoor) {
-                for (auto it = memBackdoors.begin();
-                        it != memBackdoors.end(); it++) {
-                    if (it->second == &backdoor) {
-                        memBackdoors.erase(it);
-                        return;
-                    }
-                }
-                panic("Got invalidation for unknown memory backdoor.");
-            };
-            bd->addInvalidationCallback(callback);
-        }
+        recordBackdoor(bd);
 
         // Check if we're done now, since handleResp may delete state.
         done = !state->gen.next();
@@ -402,6 +497,14 @@ DmaPort::sendDma()
             return;
         }
 
+        // Requests fully covered by a backdoor don't need any packets.
+        if (timingBackdoor) {
+            while (!transmitList.empty() &&
+                    trySendTimingBd(transmitList.front()));
+            if (transmitList.empty())
+                return;
+        }
+
         trySendTimingReq();
     } else if (sys->isAtomicMode()) {
         const bool bypass = sys->bypassCaches();
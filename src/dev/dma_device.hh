@@ -153,6 +153,47 @@ class DmaPort : public RequestPort, public Drainable
     void handleRespPacket(PacketPtr pkt, Tick delay=0);
     void handleResp(DmaReqState *state, Addr addr, Addr size, Tick delay=0);
 
+    /**
+     * Record a backdoor handed to us by the memory system, and arrange
+     * for it to be forgotten again when it is invalidated.
+     */
+    void recordBackdoor(MemBackdoorPtr bd);
+
+    /**
+     * Look up (or request) a backdoor which covers the whole of a timing
+     * mode DMA request, and if there is one, move the data through it in
+     * a single copy. The transfer then completes once the aggregate
+     * latency and bandwidth of the backdoor path have elapsed.
+     *
+     * @param state DMA request at the head of the transmit list
+     * @return true if the request was handled through a backdoor
+     */
+    bool trySendTimingBd(DmaReqState *state);
+
+    /** Complete the backdoor transfers whose modeled time has elapsed. */
+    void completeBdTransfers();
+
+    /** Whether timing mode requests may be satisfied through backdoors. */
+    bool timingBackdoor = false;
+
+    /** Fixed latency of a transfer through a backdoor. */
+    Tick backdoorLatency = 0;
+
+    /** Ticks per byte of the aggregate backdoor bandwidth. */
+    double backdoorTicksPerByte = 0;
+
+    /** Tick at which the backdoor path is free to start a transfer. */
+    Tick backdoorFreeAt = 0;
+
+    /**
+     * Backdoor transfers which have been copied but are yet to be
+     * reported as complete, ordered by their completion tick.
+     */
+    std::deque<std::pair<Tick, DmaReqState *>> bdTransfers;
+
+    /** Event used to signal the completion of backdoor transfers. */
+    EventFunctionWrapper bdDoneEvent;
+
   public:
     /** The device that owns this port. */
     ClockedObject *const device;
@@ -200,6 +241,16 @@ class DmaPort : public RequestPort, public Drainable
     DmaPort(ClockedObject *dev, System *s, std::optional<uint32_t> sid=0,
             std::optional<uint32_t> ssid=0);
 
+    /**
+     * Let timing mode requests bypass the packet based memory system
+     * whenever a backdoor covers the whole request. Only the aggregate
+     * latency and bandwidth of such a transfer are modeled.
+     *
+     * @param latency Fixed latency added to every backdoor transfer
+     * @param ticks_per_byte Inverse bandwidth of the backdoor path
+     */
+    void enableTimingBackdoor(Tick latency, double ticks_per_byte);
+
     void
     dmaAction(Packet::Command cmd, Addr addr, int size, Event *event,
               uint8_t *data, Tick delay, Request::Flags flag=0);
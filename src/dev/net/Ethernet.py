@@ -71,6 +71,12 @@ class EtherLink(SimObject):
     delay_var = Param.Latency("0ns", "packet transmit delay variability")
     speed = Param.NetworkBandwidth("1Gbps", "link speed")
     dump = Param.EtherDump(NULL, "dump object")
+    burst_window = Param.Latency(
+        "0ns",
+        "Packets arriving within the same window of this length are "
+        "delivered in one burst at its end (0 delivers every packet on "
+        "its own)",
+    )
 
 
 class DistEtherLink(SimObject):
@@ -87,8 +93,22 @@ class DistEtherLink(SimObject):
     dist_size = Param.UInt32("1", "Number of gem5 processes (dist run)")
     sync_start = Param.Latency("5200000000000t", "first dist sync barrier")
     sync_repeat = Param.Latency("10us", "dist sync barrier repeat")
+    sync_repeat_max = Param.Latency(
+        "0us",
+        "Upper bound for the dist sync barrier repeat when it adapts to "
+        "link traffic (0 disables adaptation). Intervals longer than the "
+        "link delay may deliver packets later than their receive tick",
+    )
     server_name = Param.String("localhost", "Message server name")
     server_port = Param.UInt32("2200", "Message server port")
+    shm_name = Param.String(
+        "",
+        "If set, talk to the gem5 peers on the same host through shared "
+        "memory segments with this name prefix instead of TCP",
+    )
+    shm_ring_size = Param.MemorySize(
+        "4MiB", "Size of each direction of a shared memory link"
+    )
     is_switch = Param.Bool(False, "true if this a link in etherswitch")
     dist_sync_on_pseudo_op = Param.Bool(False, "Start sync with pseudo_op")
     num_nodes = Param.UInt32("2", "Number of simulate nodes")
@@ -120,6 +140,12 @@ class EtherSwitch(SimObject):
     delay = Param.Latency("0us", "packet transmit delay")
     delay_var = Param.Latency("0ns", "packet transmit delay variability")
     time_to_live = Param.Latency("10ms", "time to live of MAC address maping")
+    burst_window = Param.Latency(
+        "0ns",
+        "Packets that would leave an output port within this window of "
+        "the head of its queue are sent together in one burst (0 sends "
+        "every packet on its own)",
+    )
 
 
 class EtherTapBase(SimObject):
@@ -145,6 +171,30 @@ if buildEnv["HAVE_TUNTAP"]:
         )
         tap_device_name = Param.String("gem5-tap", "Tap device name")
 
+if buildEnv["HAVE_PACKET_MMAP"]:
+
+    class EtherPacketRing(EtherTapBase):
+        type = "EtherPacketRing"
+        cxx_header = "dev/net/ethertap.hh"
+        cxx_class = "gem5::EtherPacketRing"
+
+        device_name = Param.String(
+            "Host network interface to attach to, e.g., one end of a veth "
+            "pair with the other end bridged to the host network"
+        )
+        block_size = Param.Unsigned(
+            65536, "Size of the ring blocks, a multiple of the page size"
+        )
+        num_blocks = Param.Unsigned(16, "Number of blocks in each ring")
+        frame_size = Param.Unsigned(
+            2048, "Size of the ring frames, including their headers"
+        )
+        block_timeout = Param.Unsigned(
+            1,
+            "Milliseconds of host time after which the kernel hands a "
+            "partially filled block over",
+        )
+
 
 class EtherTapStub(EtherTapBase):
     type = "EtherTapStub"
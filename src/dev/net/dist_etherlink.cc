@@ -59,6 +59,7 @@
 #include "dev/net/etherint.hh"
 #include "dev/net/etherlink.hh"
 #include "dev/net/etherpkt.hh"
+#include "dev/net/shm_iface.hh"
 #include "dev/net/tcp_iface.hh"
 #include "params/EtherLink.hh"
 #include "sim/cur_tick.hh"
@@ -69,7 +70,7 @@ namespace gem5
 {
 
 DistEtherLink::DistEtherLink(const Params &p)
-    : SimObject(p), linkDelay(p.delay)
+    : SimObject(p), linkDelay(p.delay), stats(this)
 {
     DPRINTF(DistEthernet,"DistEtherLink::DistEtherLink() "
             "link delay:%llu ticksPerByte:%f\n", p.delay, p.speed);
@@ -88,12 +89,26 @@ DistEtherLink::DistEtherLink(const Params &p)
         sync_repeat = p.delay;
     }
 
-    // create the dist (TCP) interface to talk to the peer gem5 processes.
-    distIface = new TCPIface(p.server_name, p.server_port,
-                             p.dist_rank, p.dist_size,
-                             p.sync_start, sync_repeat, this,
-                             p.dist_sync_on_pseudo_op, p.is_switch,
-                             p.num_nodes);
+    fatal_if(p.sync_repeat_max != 0 && p.sync_repeat_max < sync_repeat,
+             "DistEtherLink(): sync_repeat_max (%lu) is smaller than the "
+             "sync interval (%lu)", p.sync_repeat_max, sync_repeat);
+
+    // create the dist interface to talk to the peer gem5 processes.
+    if (p.shm_name.empty()) {
+        distIface = new TCPIface(p.server_name, p.server_port,
+                                 p.dist_rank, p.dist_size,
+                                 p.sync_start, sync_repeat, p.sync_repeat_max,
+                                 this,
+                                 p.dist_sync_on_pseudo_op, p.is_switch,
+                                 p.num_nodes);
+    } else {
+        distIface = new ShmIface(p.shm_name, p.shm_ring_size,
+                                 p.dist_rank, p.dist_size,
+                                 p.sync_start, sync_repeat, p.sync_repeat_max,
+                                 this,
+                                 p.dist_sync_on_pseudo_op, p.is_switch,
+                                 p.num_nodes);
+    }
 
     localIface = new LocalIface(name() + ".int0", txLink, rxLink, distIface);
 }
@@ -114,6 +129,21 @@ DistEtherLink::getPort(const std::string &if_name, PortID idx)
     return SimObject::getPort(if_name, idx);
 }
 
+DistEtherLink::DistEtherLinkStats::DistEtherLinkStats(DistEtherLink *parent)
+    : statistics::Group(parent),
+      ADD_STAT(syncs, statistics::units::Count::get(),
+               "Number of periodic dist syncs completed by this process"),
+      ADD_STAT(syncWaitTime, statistics::units::Second::get(),
+               "Host time this process spent waiting for dist syncs"),
+      ADD_STAT(lateArrivals, statistics::units::Count::get(),
+               "Packets received after their receive tick because of a "
+               "stretched sync interval")
+{
+    syncs.functor(DistIface::syncCount);
+    syncWaitTime.functor(DistIface::syncWaitTime);
+    lateArrivals.functor(DistIface::lateArrivalCount);
+}
+
 void
 DistEtherLink::serialize(CheckpointOut &cp) const
 {
@@ -52,6 +52,7 @@
 #include <iostream>
 
 #include "base/random.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "dev/net/etherlink.hh"
 #include "params/DistEtherLink.hh"
@@ -220,6 +221,18 @@ class DistEtherLink : public SimObject
 
     Tick linkDelay;
 
+    struct DistEtherLinkStats : public statistics::Group
+    {
+        DistEtherLinkStats(DistEtherLink *parent);
+
+        /** Completed periodic syncs of this gem5 process */
+        statistics::Value syncs;
+        /** Host time this gem5 process spent waiting in syncs */
+        statistics::Value syncWaitTime;
+        /** Packets delivered after their receive tick */
+        statistics::Value lateArrivals;
+    } stats;
+
   public:
     using Params = DistEtherLinkParams;
     DistEtherLink(const Params &p);
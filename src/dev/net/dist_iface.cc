@@ -41,6 +41,8 @@
 
 #include "dev/net/dist_iface.hh"
 
+#include <algorithm>
+#include <chrono>
 #include <queue>
 #include <thread>
 
@@ -66,7 +68,7 @@ DistIface *DistIface::primary = nullptr;
 bool DistIface::isSwitch = false;
 
 void
-DistIface::Sync::init(Tick start_tick, Tick repeat_tick)
+DistIface::Sync::init(Tick start_tick, Tick repeat_tick, Tick repeat_max)
 {
     if (start_tick < nextAt) {
         nextAt = start_tick;
@@ -81,6 +83,24 @@ DistIface::Sync::init(Tick start_tick, Tick repeat_tick)
         inform("Dist synchronisation interval is changed to %lu.\n",
                nextRepeat);
     }
+
+    baseRepeat = std::min(baseRepeat, repeat_tick);
+    maxRepeat = std::min(maxRepeat, std::max(repeat_max, repeat_tick));
+}
+
+Tick
+DistIface::Sync::requestRepeat()
+{
+    if (!relaxed())
+        return baseRepeat;
+
+    // Any traffic in the last interval means that packets may be in
+    // flight, so go back to the safe interval. Otherwise keep doubling.
+    if (quantumPackets.exchange(0) != 0 || adaptRepeat < baseRepeat)
+        adaptRepeat = baseRepeat;
+    else
+        adaptRepeat = std::min(2 * adaptRepeat, maxRepeat);
+    return adaptRepeat;
 }
 
 void
@@ -100,6 +120,7 @@ DistIface::SyncSwitch::SyncSwitch(int num_nodes)
     numExitReq = 0;
     numCkptReq = 0;
     numStopSyncReq = 0;
+    reqRepeat = std::numeric_limits<Tick>::max();
     doExit = false;
     doCkpt = false;
     doStopSync = false;
@@ -134,7 +155,7 @@ DistIface::SyncNode::run(bool same_tick)
     // initiate the global synchronisation
     header.msgType = MsgType::cmdSyncReq;
     header.sendTick = curTick();
-    header.syncRepeat = nextRepeat;
+    header.syncRepeat = requestRepeat();
     header.needCkpt = needCkpt;
     header.needStopSync = needStopSync;
     if (needCkpt != ReqType::none)
@@ -169,6 +190,9 @@ DistIface::SyncSwitch::run(bool same_tick)
         return false;
     assert(!same_tick || (nextAt == curTick()));
     waitNum = numNodes;
+    // The agreed interval is the smallest one asked for by anyone
+    nextRepeat = std::min(reqRepeat, requestRepeat());
+    reqRepeat = std::numeric_limits<Tick>::max();
     // Complete the global synchronisation
     header.msgType = MsgType::cmdSyncAck;
     header.sendTick = nextAt;
@@ -211,8 +235,8 @@ DistIface::SyncSwitch::progress(Tick send_tick,
 
     if (send_tick > nextAt)
         nextAt = send_tick;
-    if (nextRepeat > sync_repeat)
-        nextRepeat = sync_repeat;
+    if (reqRepeat > sync_repeat)
+        reqRepeat = sync_repeat;
 
     if (need_ckpt == ReqType::collective)
         numCkptReq++;
@@ -338,6 +362,8 @@ DistIface::SyncEvent::start()
     // we have a local minimum of the start tick and repeat for the periodic
     // sync.
     repeat = DistIface::sync->nextRepeat;
+    // Start over from the safe interval, so that all peers agree on it.
+    DistIface::sync->adaptRepeat = 0;
     // Do a global barrier to agree on a common repeat value (the smallest
     // one from all participating nodes.
     if (!DistIface::sync->run(false))
@@ -391,11 +417,16 @@ DistIface::SyncEvent::process()
      */
     {
         EventQueue::ScopedRelease sr(curEventQueue());
+        const auto wait_start = std::chrono::steady_clock::now();
         // we do a global sync here that is supposed to happen at the same
         // tick in all gem5 peers
         if (!DistIface::sync->run(true))
             return; // global sync aborted
         // global sync completed
+        const std::chrono::duration<double> waited =
+            std::chrono::steady_clock::now() - wait_start;
+        DistIface::sync->waitTime += waited.count();
+        DistIface::sync->numSyncs++;
     }
     if (DistIface::sync->doCkpt)
         exitSimLoop("checkpoint");
@@ -445,6 +476,17 @@ DistIface::RecvScheduler::calcReceiveTick(Tick send_tick,
                                           Tick prev_recv_tick)
 {
     Tick recv_tick = send_tick + send_delay + linkDelay;
+    if (sync->relaxed()) {
+        // With a stretched sync interval, the receiver may already be past
+        // the receive tick. Deliver the packet as soon as possible then.
+        const Tick earliest = std::max(curTick() + 1,
+                                       prev_recv_tick + send_delay);
+        if (recv_tick < earliest) {
+            sync->lateArrivals++;
+            recv_tick = earliest;
+        }
+        return recv_tick;
+    }
     // sanity check (we need atleast a send delay long window)
     assert(recv_tick >= prev_recv_tick + send_delay);
     panic_if(prev_recv_tick + send_delay > recv_tick,
@@ -499,6 +541,7 @@ DistIface::RecvScheduler::pushPacket(EthPacketPtr new_packet,
 {
     // Note : this is called from the receiver thread
     curEventQueue()->lock();
+    sync->quantumPackets++;
     Tick recv_tick = calcReceiveTick(send_tick, send_delay, prevRecvTick);
 
     DPRINTF(DistEthernetPkt, "DistIface::recvScheduler::pushPacket "
@@ -508,7 +551,8 @@ DistIface::RecvScheduler::pushPacket(EthPacketPtr new_packet,
     assert(send_tick > primary->syncEvent->when() -
            primary->syncEvent->repeat);
     // No packet may be scheduled for receive in the arrival quantum
-    assert(send_tick + send_delay + linkDelay > primary->syncEvent->when());
+    assert(sync->relaxed() ||
+           send_tick + send_delay + linkDelay > primary->syncEvent->when());
 
     // Now we are about to schedule a recvDone event for the new data packet.
     // We use the same recvDone object for all incoming data packets. Packet
@@ -605,10 +649,12 @@ DistIface::DistIface(unsigned dist_rank,
                      unsigned dist_size,
                      Tick sync_start,
                      Tick sync_repeat,
+                     Tick sync_repeat_max,
                      EventManager *em,
                      bool use_pseudo_op,
                      bool is_switch, int num_nodes) :
     syncStart(sync_start), syncRepeat(sync_repeat),
+    syncRepeatMax(sync_repeat_max),
     recvThread(nullptr), recvScheduler(em), syncStartOnPseudoOp(use_pseudo_op),
     rank(dist_rank), size(dist_size)
 {
@@ -653,6 +699,7 @@ DistIface::packetOut(EthPacketPtr pkt, Tick send_delay)
     // Prepare a dist header packet for the Ethernet packet we want to
     // send out.
     header.msgType = MsgType::dataDescriptor;
+    sync->quantumPackets++;
     header.sendTick  = curTick();
     header.sendDelay = send_delay;
 
@@ -799,7 +846,7 @@ DistIface::init(const Event *done_event, Tick link_delay)
     // might have different requirements. The singleton sync object
     // will select the minimum values for both params.
     assert(sync != nullptr);
-    sync->init(syncStart, syncRepeat);
+    sync->init(syncStart, syncRepeat, syncRepeatMax);
 
     // Initialize the seed for random generator to avoid the same sequence
     // in all gem5 peer processes
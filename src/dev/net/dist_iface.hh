@@ -66,7 +66,14 @@
  * transmission delay to ensure that a corresponding receive event can always
  * be scheduled for any message coming in from a peer gem5 process.
  *
- *
+ * Optionally, the barrier interval adapts to the observed link traffic.
+ * Each process asks for a longer interval at every barrier where it has
+ * neither sent nor received a data packet since the last one, up to a
+ * configured maximum, and falls back to the link delay as soon as it sees
+ * traffic again. The agreed interval is the smallest one requested. A
+ * packet which arrives after its receive tick inside a stretched interval
+ * is delivered as soon as possible instead, and counted as a late
+ * arrival.
  *
  * This interface is an abstract class. It can work with various low level
  * send/receive service implementations (e.g. TCP/IP, MPI,...). A TCP
@@ -76,6 +83,8 @@
 #define __DEV_DIST_IFACE_HH__
 
 #include <array>
+#include <atomic>
+#include <limits>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -158,18 +167,60 @@ class DistIface : public Drainable, public Serializable
          *  Flag is set if the sync is aborted (e.g. due to connection lost)
          */
         bool isAbort;
+        /**
+         * The smallest sync interval required by the local links
+         */
+        Tick baseRepeat = std::numeric_limits<Tick>::max();
+        /**
+         * The upper bound for an adaptively stretched sync interval
+         */
+        Tick maxRepeat = std::numeric_limits<Tick>::max();
+        /**
+         * The sync interval this process asked for at the last sync
+         */
+        Tick adaptRepeat = 0;
 
         friend class SyncEvent;
 
+        /**
+         * Pick the sync interval to ask for at the next sync, based on
+         * the traffic seen since the previous one.
+         */
+        Tick requestRepeat();
+
       public:
+        /**
+         * Number of data packets sent or received since the last sync
+         */
+        std::atomic<uint64_t> quantumPackets{0};
+        /**
+         * Number of packets delivered later than their receive tick
+         */
+        std::atomic<uint64_t> lateArrivals{0};
+        /**
+         * Number of completed periodic syncs
+         */
+        uint64_t numSyncs = 0;
+        /**
+         * Host time (in seconds) the simulation thread spent waiting for
+         * periodic syncs to complete
+         */
+        double waitTime = 0;
+
         /**
          * Initialize periodic sync params.
          *
          * @param start Start tick for dist synchronisation
          * @param repeat Frequency of dist synchronisation
+         * @param repeat_max Upper bound for an adaptively stretched sync
+         * interval (no larger than repeat disables adaptation)
          *
          */
-        void init(Tick start, Tick repeat);
+        void init(Tick start, Tick repeat, Tick repeat_max);
+        /**
+         * Whether the sync interval may grow beyond the link delay
+         */
+        bool relaxed() const { return maxRepeat > baseRepeat; }
         /**
          *  Core method to perform a full dist sync.
          *
@@ -257,6 +308,11 @@ class DistIface : public Drainable, public Serializable
          *  Number of connected simulated nodes
          */
         unsigned numNodes;
+        /**
+         * Smallest sync interval requested by the nodes for the
+         * ongoing sync
+         */
+        Tick reqRepeat;
 
       public:
         SyncSwitch(int num_nodes);
@@ -462,6 +518,10 @@ class DistIface : public Drainable, public Serializable
      * Frequency of dist sync events in ticks.
      */
     Tick syncRepeat;
+    /**
+     * Upper bound in ticks for an adaptively stretched sync interval.
+     */
+    Tick syncRepeatMax;
     /**
      * Receiver thread pointer.
      * Each DistIface object must have exactly one receiver thread.
@@ -574,12 +634,14 @@ class DistIface : public Drainable, public Serializable
      * @param dist_rank Rank of this gem5 process within the dist run
      * @param sync_start Start tick for dist synchronisation
      * @param sync_repeat Frequency for dist synchronisation
+     * @param sync_repeat_max Upper bound for an adaptive sync interval
      * @param em The event manager associated with the simulated Ethernet link
      */
     DistIface(unsigned dist_rank,
               unsigned dist_size,
               Tick sync_start,
               Tick sync_repeat,
+              Tick sync_repeat_max,
               EventManager *em,
               bool use_pseudo_op,
               bool is_switch,
@@ -639,6 +701,16 @@ class DistIface : public Drainable, public Serializable
      * Getter for the dist size param.
      */
     static uint64_t sizeParam();
+    /**
+     * Getters for the sync statistics of this gem5 process.
+     */
+    static uint64_t syncCount() { return sync ? sync->numSyncs : 0; }
+    static double syncWaitTime() { return sync ? sync->waitTime : 0; }
+    static uint64_t
+    lateArrivalCount()
+    {
+        return sync ? sync->lateArrivals.load() : 0;
+    }
     /**
      * Trigger the primary to start/stop synchronization.
      */
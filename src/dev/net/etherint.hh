@@ -35,6 +35,7 @@
 #define __DEV_NET_ETHERINT_HH__
 
 #include <string>
+#include <vector>
 
 #include "dev/net/etherpkt.hh"
 #include "mem/port.hh"
@@ -74,6 +75,35 @@ class EtherInt : public Port
     { return peer ? peer->recvPacket(packet) : true; }
     virtual bool recvPacket(EthPacketPtr packet) = 0;
 
+    /**
+     * Hand several packets to the peer in one go.
+     *
+     * @return The number of leading packets of the burst the peer
+     * accepted.
+     */
+    size_t
+    sendBurst(const std::vector<EthPacketPtr> &burst)
+    {
+        return peer ? peer->recvBurst(burst) : burst.size();
+    }
+
+    /**
+     * Receive a burst of packets. Interfaces which can take a whole burst
+     * at once may override this, by default the packets are received one
+     * by one until one of them is refused.
+     */
+    virtual size_t
+    recvBurst(const std::vector<EthPacketPtr> &burst)
+    {
+        size_t accepted = 0;
+        for (const auto &packet : burst) {
+            if (!recvPacket(packet))
+                break;
+            accepted++;
+        }
+        return accepted;
+    }
+
     bool askBusy() {return peer->isBusy(); }
     virtual bool isBusy() { return false; }
 };
@@ -50,6 +50,7 @@
 #include <string>
 #include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/Ethernet.hh"
@@ -66,18 +67,30 @@ namespace gem5
 {
 
 EtherLink::EtherLink(const Params &p)
-    : SimObject(p)
+    : SimObject(p), stats(this)
 {
     link[0] = new Link(name() + ".link0", this, 0, p.speed,
-                       p.delay, p.delay_var, p.dump);
+                       p.delay, p.delay_var, p.burst_window, p.dump);
     link[1] = new Link(name() + ".link1", this, 1, p.speed,
-                       p.delay, p.delay_var, p.dump);
+                       p.delay, p.delay_var, p.burst_window, p.dump);
 
     interface[0] = new Interface(name() + ".int0", link[0], link[1]);
     interface[1] = new Interface(name() + ".int1", link[1], link[0]);
 }
 
 
+EtherLink::EtherLinkStats::EtherLinkStats(EtherLink *parent)
+    : statistics::Group(parent),
+      ADD_STAT(burstSize, statistics::units::Count::get(),
+               "Number of packets delivered together")
+{
+    burstSize
+        .init(2, 1, 64, 1)
+        .subname(0, "link0")
+        .subname(1, "link1")
+        .flags(statistics::nozero);
+}
+
 EtherLink::~EtherLink()
 {
     delete link[0];
@@ -106,9 +119,11 @@ EtherLink::Interface::Interface(const std::string &name, Link *tx, Link *rx)
 }
 
 EtherLink::Link::Link(const std::string &name, EtherLink *p, int num,
-                      double rate, Tick delay, Tick delay_var, EtherDump *d)
+                      double rate, Tick delay, Tick delay_var,
+                      Tick burst_window, EtherDump *d)
     : objName(name), parent(p), number(num), txint(NULL), rxint(NULL),
-      ticksPerByte(rate), linkDelay(delay), delayVar(delay_var), dump(d),
+      ticksPerByte(rate), linkDelay(delay), delayVar(delay_var),
+      burstWindow(burst_window), dump(d),
       doneEvent([this]{ txDone(); }, name),
       txQueueEvent([this]{ processTxQueue(); }, name)
 { }
@@ -143,7 +158,12 @@ EtherLink::Link::txDone()
 
     if (linkDelay > 0) {
         DPRINTF(Ethernet, "packet delayed: delay=%d\n", linkDelay);
-        txQueue.emplace_back(std::make_pair(curTick() + linkDelay, packet));
+        // In burst mode, hold the packet until the end of its window so
+        // that it gets delivered together with its neighbours.
+        Tick when = curTick() + linkDelay;
+        if (burstWindow > 0)
+            when = divCeil(when, burstWindow) * burstWindow;
+        txQueue.emplace_back(std::make_pair(when, packet));
         if (!txQueueEvent.scheduled())
             parent->schedule(txQueueEvent, txQueue.front().first);
     } else {
@@ -160,18 +180,47 @@ EtherLink::Link::txDone()
 void
 EtherLink::Link::processTxQueue()
 {
-    auto cur(txQueue.front());
-    txQueue.pop_front();
-
-    // Schedule a new event to process the next packet in the queue.
-    if (!txQueue.empty()) {
-        auto next(txQueue.front());
-        assert(next.first > curTick());
-        parent->schedule(txQueueEvent, next.first);
+    assert(txQueue.front().first == curTick());
+
+    if (burstWindow == 0) {
+        auto cur(txQueue.front());
+        txQueue.pop_front();
+
+        // Schedule a new event to process the next packet in the queue.
+        if (!txQueue.empty()) {
+            auto next(txQueue.front());
+            assert(next.first > curTick());
+            parent->schedule(txQueueEvent, next.first);
+        }
+
+        parent->stats.burstSize[number].sample(1);
+        txComplete(cur.second);
+        return;
     }
 
-    assert(cur.first == curTick());
-    txComplete(cur.second);
+    // Deliver everything that arrives now in a single burst. The packets
+    // are shared with the sender, nothing is copied.
+    std::vector<EthPacketPtr> burst;
+    while (!txQueue.empty() && txQueue.front().first == curTick()) {
+        burst.push_back(txQueue.front().second);
+        txQueue.pop_front();
+    }
+
+    if (!txQueue.empty())
+        parent->schedule(txQueueEvent, txQueue.front().first);
+
+    DPRINTF(Ethernet, "burst received: packets=%d\n", burst.size());
+    for ([[maybe_unused]] const auto &packet : burst)
+        DDUMP(EthernetData, packet->data, packet->length);
+    parent->stats.burstSize[number].sample(burst.size());
+    // As for single packets, whatever the receiver refuses is lost. A
+    // receiver which refuses a packet won't take the rest of the burst
+    // in the same tick either.
+    const size_t accepted = rxint->sendBurst(burst);
+    if (accepted != burst.size()) {
+        DPRINTF(Ethernet, "burst receiver busy, dropped %d packets\n",
+                burst.size() - accepted);
+    }
 }
 
 bool
@@ -47,8 +47,10 @@
 
 #include <queue>
 #include <utility>
+#include <vector>
 
 #include "base/random.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "dev/net/etherint.hh"
 #include "dev/net/etherpkt.hh"
@@ -86,6 +88,8 @@ class EtherLink : public SimObject
         const double ticksPerByte;
         const Tick linkDelay;
         const Tick delayVar;
+        /** Packets arriving in the same window are delivered together */
+        const Tick burstWindow;
         EtherDump *const dump;
 
         Random::RandomPtr rng = Random::genRandom();
@@ -100,8 +104,9 @@ class EtherLink : public SimObject
 
         /**
          * Maintain a queue of in-flight packets. Assume that the
-         * delay is non-zero and constant (i.e., at most one packet
-         * per tick).
+         * delay is non-zero and constant, so that packets arrive in
+         * order. Several packets may arrive in the same tick when they
+         * are batched into bursts.
          */
         std::deque<std::pair<Tick, EthPacketPtr>> txQueue;
 
@@ -112,7 +117,8 @@ class EtherLink : public SimObject
 
       public:
         Link(const std::string &name, EtherLink *p, int num,
-             double rate, Tick delay, Tick delay_var, EtherDump *dump);
+             double rate, Tick delay, Tick delay_var, Tick burst_window,
+             EtherDump *dump);
         ~Link() {}
 
         const std::string name() const { return objName; }
@@ -145,6 +151,14 @@ class EtherLink : public SimObject
     Link *link[2];
     Interface *interface[2];
 
+    struct EtherLinkStats : public statistics::Group
+    {
+        EtherLinkStats(EtherLink *parent);
+
+        /** Number of packets delivered per event, for each direction */
+        statistics::VectorDistribution burstSize;
+    } stats;
+
   public:
     using Params = EtherLinkParams;
     EtherLink(const Params &p);
@@ -41,7 +41,8 @@ namespace gem5
 {
 
 EtherSwitch::EtherSwitch(const Params &p)
-    : SimObject(p), ttl(p.time_to_live)
+    : SimObject(p), ttl(p.time_to_live), burstWindow(p.burst_window),
+      stats(this, p.port_interface_connection_count)
 {
     for (int i = 0; i < p.port_interface_connection_count; ++i) {
         std::string interfaceName = csprintf("%s.interface%d", name(), i);
@@ -52,6 +53,19 @@ EtherSwitch::EtherSwitch(const Params &p)
     }
 }
 
+EtherSwitch::EtherSwitchStats::EtherSwitchStats(EtherSwitch *parent,
+                                                unsigned num_ports)
+    : statistics::Group(parent),
+      ADD_STAT(burstSize, statistics::units::Count::get(),
+               "Number of packets sent together by a port")
+{
+    burstSize
+        .init(num_ports, 1, 64, 1)
+        .flags(statistics::nozero);
+    for (unsigned i = 0; i < num_ports; ++i)
+        burstSize.subname(i, csprintf("interface%d", i));
+}
+
 EtherSwitch::~EtherSwitch()
 {
     for (auto it : interfaces)
@@ -182,12 +196,18 @@ EtherSwitch::Interface::transmit()
     // there should be something in the output queue
     assert(!outputFifo.empty());
 
+    if (parent->burstWindow > 0) {
+        transmitBurst();
+        return;
+    }
+
     if (!sendPacket(outputFifo.front())) {
         DPRINTF(Ethernet, "output port busy...retry later\n");
         if (!txEvent.scheduled())
             parent->schedule(txEvent, curTick() + sim_clock::as_int::ns);
     } else {
         DPRINTF(Ethernet, "packet sent: len=%d\n", outputFifo.front()->length);
+        parent->stats.burstSize[interfaceId].sample(1);
         outputFifo.pop();
         // schedule an event to send the pkt at
         // the head of queue, if there is any
@@ -197,11 +217,58 @@ EtherSwitch::Interface::transmit()
     }
 }
 
+void
+EtherSwitch::Interface::transmitBurst()
+{
+    // The head of the queue is due now. The packets behind it which would
+    // leave within the burst window go along with it, and delays[i] is the
+    // switching delay that would precede packet i.
+    std::vector<EthPacketPtr> burst;
+    std::vector<Tick> delays;
+    Tick burst_delay = 0;
+    for (const auto &entry : outputFifo) {
+        const Tick delay = burst.empty() ? 0 : switchingDelay(entry.packet);
+        delays.push_back(delay);
+        if (burst_delay + delay > parent->burstWindow)
+            break;
+        burst_delay += delay;
+        burst.push_back(entry.packet);
+    }
+
+    // The packets are shared with the receiver, nothing is copied.
+    const size_t sent = sendBurst(burst);
+    if (sent == 0) {
+        DPRINTF(Ethernet, "output port busy...retry later\n");
+        if (!txEvent.scheduled())
+            parent->schedule(txEvent, curTick() + sim_clock::as_int::ns);
+        return;
+    }
+
+    parent->stats.burstSize[interfaceId].sample(sent);
+    DPRINTF(Ethernet, "burst sent: packets=%d\n", sent);
+
+    // The next packet leaves after the delays of everything sent with
+    // this burst, and its own.
+    Tick next = curTick();
+    for (size_t i = 0; i < sent; ++i) {
+        outputFifo.pop();
+        if (i + 1 < delays.size())
+            next += delays[i + 1];
+    }
+    if (!outputFifo.empty())
+        parent->schedule(txEvent, next);
+}
+
 Tick
 EtherSwitch::Interface::switchingDelay()
 {
-    Tick delay = (Tick)ceil(((double)outputFifo.front()->simLength
-                                     * ticksPerByte) + 1.0);
+    return switchingDelay(outputFifo.front());
+}
+
+Tick
+EtherSwitch::Interface::switchingDelay(const EthPacketPtr &packet)
+{
+    Tick delay = (Tick)ceil(((double)packet->simLength * ticksPerByte) + 1.0);
     if (delayVar != 0)
                 delay += rng->random<Tick>(0, delayVar);
     delay += switchDelay;
@@ -40,6 +40,7 @@
 
 #include "base/inet.hh"
 #include "base/random.hh"
+#include "base/statistics.hh"
 #include "dev/net/etherint.hh"
 #include "dev/net/etherlink.hh"
 #include "dev/net/etherpkt.hh"
@@ -84,6 +85,7 @@ class EtherSwitch : public SimObject
         void enqueue(EthPacketPtr packet, unsigned senderId);
         void sendDone() {}
         Tick switchingDelay();
+        Tick switchingDelay(const EthPacketPtr &packet);
 
         Interface* lookupDestPort(networking::EthAddr destAddr);
         void learnSenderAddr(networking::EthAddr srcMacAddr, Interface *sender);
@@ -153,6 +155,8 @@ class EtherSwitch : public SimObject
             int avail() const { return _maxsize - _size; }
 
             EthPacketPtr front() { return fifo.begin()->packet; }
+            auto begin() const { return fifo.begin(); }
+            auto end() const { return fifo.end(); }
             bool empty() const { return _size == 0; }
             unsigned size() const { return _size; }
 
@@ -174,6 +178,8 @@ class EtherSwitch : public SimObject
          */
         PortFifo outputFifo;
         void transmit();
+        /** Send the head of the output queue and its burst window */
+        void transmitBurst();
         EventFunctionWrapper txEvent;
     };
 
@@ -186,11 +192,21 @@ class EtherSwitch : public SimObject
   private:
     // time to live for MAC address mappings
     const double ttl;
+    // packets leaving a port within this window are sent as one burst
+    const Tick burstWindow;
     // all interfaces of the switch
     std::vector<Interface*> interfaces;
     // table that maps MAC address to interfaces
     std::map<uint64_t, SwitchTableEntry> forwardingTable;
 
+    struct EtherSwitchStats : public statistics::Group
+    {
+        EtherSwitchStats(EtherSwitch *parent, unsigned num_ports);
+
+        /** Number of packets sent per transmit event, for each port */
+        statistics::VectorDistribution burstSize;
+    } stats;
+
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 };
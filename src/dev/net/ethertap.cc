@@ -37,17 +37,28 @@
 
 #endif
 
-#if HAVE_TUNTAP && defined(__linux__)
+#if (HAVE_TUNTAP || HAVE_PACKET_MMAP) && defined(__linux__)
 #if 1 // Hide from the style checker since these have to be out of order.
 #include <sys/socket.h> // Has to be included before if.h for some reason.
 
 #endif
 
 #include <linux/if.h>
+
+#endif
+
+#if HAVE_TUNTAP && defined(__linux__)
 #include <linux/if_tun.h>
 
 #endif
 
+#if HAVE_PACKET_MMAP
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <sys/mman.h>
+
+#endif
+
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <sys/ioctl.h>
@@ -193,6 +204,12 @@ EtherTapBase::sendSimulated(void *data, size_t len)
     packet->simLength = len;
     memcpy(packet->data, data, len);
 
+    sendSimulated(packet);
+}
+
+void
+EtherTapBase::sendSimulated(EthPacketPtr packet)
+{
     DPRINTF(Ethernet, "EtherTap real->sim len=%d\n", packet->length);
     DDUMP(EthernetData, packet->data, packet->length);
     if (!packetBuffer.empty() || !interface->sendPacket(packet)) {
@@ -432,15 +449,21 @@ EtherTap::recvReal(int revent)
     if (!(revent & POLLIN))
         return;
 
-    ssize_t ret;
-    while ((ret = read(tap, buffer, buflen))) {
+    // Read each frame straight into the packet handed to the simulation.
+    while (true) {
+        auto packet = std::make_shared<EthPacketData>(buflen);
+        ssize_t ret = read(tap, packet->data, buflen);
+        if (ret == 0)
+            break;
         if (ret < 0) {
             if (errno == EAGAIN)
                 break;
             panic("Failed to read from tap device.\n");
         }
 
-        sendSimulated(buffer, ret);
+        packet->length = ret;
+        packet->simLength = ret;
+        sendSimulated(packet);
     }
 }
 
@@ -470,4 +493,184 @@ EtherTap::sendReal(const void *data, size_t len)
 
 #endif // HAVE_TUNTAP
 
+
+#if HAVE_PACKET_MMAP
+
+EtherPacketRing::EtherPacketRing(const Params &p)
+    : EtherTapBase(p), socket(-1), blockSize(p.block_size),
+      numBlocks(p.num_blocks), frameSize(p.frame_size), ring(nullptr),
+      ringSize(0), rxRing(nullptr), rxBlock(0), txRing(nullptr),
+      numTxFrames(0), txFrame(0), txPending(0),
+      txFlushEvent([this]{ flushTx(false); }, name() + ".txFlush")
+{
+    fatal_if(frameSize < TPACKET3_HDRLEN ||
+             frameSize % TPACKET_ALIGNMENT != 0,
+             "%s: The frame size must be a multiple of %d of at least %d.",
+             name(), TPACKET_ALIGNMENT, TPACKET3_HDRLEN);
+    fatal_if(blockSize % sysconf(_SC_PAGESIZE) != 0 ||
+             blockSize % frameSize != 0,
+             "%s: The block size must be a multiple of the page and frame "
+             "sizes.", name());
+    fatal_if(numBlocks == 0, "%s: The rings need at least one block.",
+             name());
+
+    socket = ::socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    if (socket < 0)
+        panic("Couldn't open a packet socket: %s.\n", strerror(errno));
+
+    int version = TPACKET_V3;
+    if (setsockopt(socket, SOL_PACKET, PACKET_VERSION, &version,
+                   sizeof(version)) < 0) {
+        panic("Packet socket doesn't support TPACKET_V3.\n");
+    }
+
+    tpacket_req3 req;
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = blockSize;
+    req.tp_block_nr = numBlocks;
+    req.tp_frame_size = frameSize;
+    req.tp_frame_nr = blockSize / frameSize * numBlocks;
+    req.tp_retire_blk_tov = p.block_timeout;
+    if (setsockopt(socket, SOL_PACKET, PACKET_RX_RING, &req,
+                   sizeof(req)) < 0) {
+        panic("Failed to set up the receive ring: %s.\n", strerror(errno));
+    }
+
+    // The transmit ring is made of frames, and has no block timeout.
+    req.tp_retire_blk_tov = 0;
+    if (setsockopt(socket, SOL_PACKET, PACKET_TX_RING, &req,
+                   sizeof(req)) < 0) {
+        panic("Failed to set up the transmit ring: %s.\n", strerror(errno));
+    }
+    numTxFrames = req.tp_frame_nr;
+
+    ringSize = 2 * size_t(blockSize) * numBlocks;
+    void *map = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     socket, 0);
+    if (map == MAP_FAILED)
+        panic("Failed to map the packet rings: %s.\n", strerror(errno));
+    ring = (uint8_t *)map;
+    rxRing = ring;
+    txRing = ring + size_t(blockSize) * numBlocks;
+
+    struct ifreq ifr;
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, p.device_name.c_str(), IFNAMSIZ - 1);
+    if (ioctl(socket, SIOCGIFINDEX, &ifr) < 0)
+        panic("Couldn't find network interface %s.\n", ifr.ifr_name);
+
+    sockaddr_ll addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_ALL);
+    addr.sll_ifindex = ifr.ifr_ifindex;
+    if (bind(socket, (sockaddr *)&addr, sizeof(addr)) < 0)
+        panic("Failed to bind to %s: %s.\n", ifr.ifr_name, strerror(errno));
+
+    // The simulated devices have their own addresses, so receive the
+    // frames sent to any of them.
+    packet_mreq mreq;
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.mr_ifindex = ifr.ifr_ifindex;
+    mreq.mr_type = PACKET_MR_PROMISC;
+    if (setsockopt(socket, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq,
+                   sizeof(mreq)) < 0) {
+        warn("Couldn't put %s in promiscuous mode.\n", ifr.ifr_name);
+    }
+
+    pollFd(socket);
+}
+
+EtherPacketRing::~EtherPacketRing()
+{
+    stopPolling();
+    munmap(ring, ringSize);
+    close(socket);
+    socket = -1;
+}
+
+void
+EtherPacketRing::flushTx(bool wait)
+{
+    if (!txPending && !wait)
+        return;
+
+    // The kernel sends all the frames marked for it, and may leave some
+    // for later if its queues are full.
+    if (send(socket, nullptr, 0, wait ? 0 : MSG_DONTWAIT) < 0 &&
+            errno != EAGAIN && errno != ENOBUFS) {
+        panic("Failed to send frames to the packet ring: %s.\n",
+              strerror(errno));
+    }
+    txPending = 0;
+}
+
+void
+EtherPacketRing::recvReal(int revent)
+{
+    if (revent & POLLERR)
+        panic("Error polling for packet ring data.\n");
+
+    if (!(revent & POLLIN))
+        return;
+
+    const size_t addr_offset = TPACKET_ALIGN(sizeof(tpacket3_hdr));
+    while (true) {
+        auto *block = (tpacket_block_desc *)(rxRing + size_t(rxBlock) *
+                                             blockSize);
+        auto &status = block->hdr.bh1.block_status;
+        if (!(__atomic_load_n(&status, __ATOMIC_ACQUIRE) & TP_STATUS_USER))
+            break;
+
+        auto *frame = (uint8_t *)block + block->hdr.bh1.offset_to_first_pkt;
+        for (unsigned i = 0; i < block->hdr.bh1.num_pkts; i++) {
+            auto *hdr = (tpacket3_hdr *)frame;
+            auto *sll = (sockaddr_ll *)(frame + addr_offset);
+            // Skip the copies of the frames sent by this interface.
+            if (sll->sll_pkttype != PACKET_OUTGOING)
+                sendSimulated(frame + hdr->tp_mac, hdr->tp_snaplen);
+            frame += hdr->tp_next_offset;
+        }
+
+        __atomic_store_n(&status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+        rxBlock = (rxBlock + 1) % numBlocks;
+    }
+}
+
+bool
+EtherPacketRing::sendReal(const void *data, size_t len)
+{
+    const size_t data_offset = TPACKET_ALIGN(sizeof(tpacket3_hdr));
+    if (len > frameSize - data_offset) {
+        warn_once("%s: Dropping frames larger than the ring frames.\n",
+                  name());
+        return false;
+    }
+
+    auto *hdr = (tpacket3_hdr *)(txRing + size_t(txFrame) * frameSize);
+    // Wait for the kernel to be done with the frame if the ring is full.
+    while (__atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE) !=
+            TP_STATUS_AVAILABLE) {
+        panic_if(hdr->tp_status == TP_STATUS_WRONG_FORMAT,
+                 "The packet ring rejected a frame.\n");
+        flushTx(true);
+    }
+
+    memcpy((uint8_t *)hdr + data_offset, data, len);
+    hdr->tp_len = len;
+    hdr->tp_next_offset = 0;
+    __atomic_store_n(&hdr->tp_status, TP_STATUS_SEND_REQUEST,
+                     __ATOMIC_RELEASE);
+    txFrame = (txFrame + 1) % numTxFrames;
+    txPending++;
+
+    // Send all the frames of this tick at once.
+    if (!txFlushEvent.scheduled())
+        schedule(txFlushEvent, curTick());
+
+    return true;
+}
+
+#endif // HAVE_PACKET_MMAP
+
 } // namespace gem5
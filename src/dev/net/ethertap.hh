@@ -37,6 +37,7 @@
 #include <string>
 
 #include "base/pollevent.hh"
+#include "config/have_packet_mmap.hh"
 #include "config/have_tuntap.hh"
 #include "dev/net/etherint.hh"
 #include "dev/net/etherpkt.hh"
@@ -46,6 +47,11 @@
 
 #endif
 
+#if HAVE_PACKET_MMAP
+#include "params/EtherPacketRing.hh"
+
+#endif
+
 #include "params/EtherTapStub.hh"
 #include "sim/eventq.hh"
 #include "sim/sim_object.hh"
@@ -100,6 +106,7 @@ class EtherTapBase : public SimObject
 
     bool recvSimulated(EthPacketPtr packet);
     void sendSimulated(void *data, size_t len);
+    void sendSimulated(EthPacketPtr packet);
 
   protected:
     std::queue<EthPacketPtr> packetBuffer;
@@ -175,6 +182,52 @@ class EtherTap : public EtherTapBase
 };
 #endif
 
+#if HAVE_PACKET_MMAP
+/*
+ * Interface to connect a simulated ethernet device to a host network
+ * interface, e.g., one end of a veth pair, through the memory mapped
+ * TPACKET_V3 rings of a raw packet socket. The kernel fills whole blocks
+ * of received frames, which are handed to the simulation at once, and
+ * frames sent during a tick go out with a single system call.
+ */
+class EtherPacketRing : public EtherTapBase
+{
+  public:
+    using Params = EtherPacketRingParams;
+    EtherPacketRing(const Params &p);
+    ~EtherPacketRing();
+
+  protected:
+    int socket;
+
+    const unsigned blockSize;
+    const unsigned numBlocks;
+    const unsigned frameSize;
+
+    /** Both rings, which are mapped together, receive ring first */
+    uint8_t *ring;
+    size_t ringSize;
+
+    uint8_t *rxRing;
+    /** Next receive block to hand to the simulation */
+    unsigned rxBlock;
+
+    uint8_t *txRing;
+    unsigned numTxFrames;
+    /** Next transmit frame to fill */
+    unsigned txFrame;
+    /** Frames filled since the last flush */
+    unsigned txPending;
+
+    /** Ask the kernel to send the filled frames, optionally waiting. */
+    void flushTx(bool wait);
+    EventFunctionWrapper txFlushEvent;
+
+    void recvReal(int revent) override;
+    bool sendReal(const void *data, size_t len) override;
+};
+#endif
+
 } // namespace gem5
 
 #endif // __DEV_NET_ETHERTAP_HH__
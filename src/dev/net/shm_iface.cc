@@ -0,0 +1,306 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory based interface class for dist-gem5 runs.
+ */
+
+#include "dev/net/shm_iface.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/DistEthernet.hh"
+#include "debug/DistEthernetCmd.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/**
+ * Sleep until the given word no longer holds val. Spurious wakeups are
+ * fine, callers always re-check their condition.
+ */
+void
+futexWait(std::atomic<uint32_t> &word, uint32_t val)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT, val,
+            nullptr, nullptr, 0);
+#else
+    if (word.load() == val)
+        std::this_thread::yield();
+#endif
+}
+
+void
+futexWake(std::atomic<uint32_t> &word)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE,
+            INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+/** Size of the segment header, which keeps the ring data page aligned. */
+constexpr uint64_t segHeaderSize = 4096;
+
+} // anonymous namespace
+
+std::vector<ShmIface::Sender *> ShmIface::senderRegistry;
+
+ShmIface::ShmIface(std::string shm_name, uint64_t ring_size,
+                   unsigned dist_rank, unsigned dist_size,
+                   Tick sync_start, Tick sync_repeat, Tick sync_repeat_max,
+                   EventManager *em, bool use_pseudo_op, bool is_switch,
+                   int num_nodes) :
+    DistIface(dist_rank, dist_size, sync_start, sync_repeat, sync_repeat_max,
+              em, use_pseudo_op, is_switch, num_nodes),
+    ringSize(ring_size), isSwitch(is_switch), txRing(is_switch ? 1 : 0)
+{
+    static_assert(sizeof(Segment) <= segHeaderSize,
+                  "Shared segment header does not fit its page");
+    fatal_if(ringSize < sizeof(Header),
+             "Dist shared memory ring size (%d) is too small", ringSize);
+
+    // Switch port i is connected to the compute node of rank i.
+    segName = csprintf("/%s.%d", shm_name, is_switch ? distIfaceId : rank);
+}
+
+ShmIface::~ShmIface()
+{
+    if (segment) {
+        // Let both the peer and our own receiver thread know that the link
+        // is gone.
+        for (auto &ring : segment->rings) {
+            ring.closed.store(1);
+            ring.dataSeq.fetch_add(1);
+            ring.spaceSeq.fetch_add(1);
+            futexWake(ring.dataSeq);
+            futexWake(ring.spaceSeq);
+        }
+        munmap(segment, segHeaderSize + 2 * ringSize);
+    }
+
+    senderRegistry.erase(std::remove(senderRegistry.begin(),
+                                     senderRegistry.end(), sender),
+                         senderRegistry.end());
+    delete sender;
+}
+
+void
+ShmIface::establishConnection()
+{
+    const unsigned side = isSwitch ? 1 : 0;
+    const uint64_t seg_size = segHeaderSize + 2 * ringSize;
+
+    int fd = shm_open(segName.c_str(), O_CREAT | O_RDWR, 0600);
+    panic_if(fd < 0, "shm_open(%s) failed: %s", segName, strerror(errno));
+
+    // Whichever end comes first sizes the (zero filled) segment.
+    struct stat st;
+    panic_if(fstat(fd, &st) != 0, "fstat(%s) failed: %s", segName,
+             strerror(errno));
+    fatal_if(st.st_size != 0 && st.st_size != seg_size,
+             "Dist shared memory segment %s has size %d instead of %d, do "
+             "all gem5 processes use the same ring size?", segName,
+             st.st_size, seg_size);
+    panic_if(ftruncate(fd, seg_size) != 0, "ftruncate(%s) failed: %s",
+             segName, strerror(errno));
+
+    void *ptr = mmap(nullptr, seg_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     fd, 0);
+    panic_if(ptr == MAP_FAILED, "mmap(%s) failed: %s", segName,
+             strerror(errno));
+    close(fd);
+
+    segment = static_cast<Segment *>(ptr);
+    ringData[0] = static_cast<uint8_t *>(ptr) + segHeaderSize;
+    ringData[1] = ringData[0] + ringSize;
+
+    fatal_if(segment->attached[side].load(),
+             "Dist shared memory segment %s is already in use (left over "
+             "from an earlier run?)", segName);
+    segment->attached[side].store(1);
+    futexWake(segment->attached[side]);
+
+    DPRINTF(DistEthernet, "Attached to %s, waiting for peer\n", segName);
+    while (!segment->attached[1 - side].load())
+        futexWait(segment->attached[1 - side], 0);
+
+    // Both ends hold a mapping now, so the name is not needed anymore.
+    if (isSwitch)
+        shm_unlink(segName.c_str());
+
+    if (isSwitch)
+        inform("Link okay  (iface:%d -> node:%d)", distIfaceId, distIfaceId);
+    else
+        inform("Link okay  (iface:%d -> switch iface:%d)", distIfaceId, rank);
+
+    sender = new Sender;
+    sender->iface = this;
+    senderRegistry.push_back(sender);
+}
+
+void
+ShmIface::writeRing(unsigned r, const void *buf, uint64_t length)
+{
+    Ring &ring = segment->rings[r];
+    const uint8_t *src = static_cast<const uint8_t *>(buf);
+
+    while (length > 0) {
+        const uint64_t head = ring.head.load(std::memory_order_relaxed);
+        const uint64_t space = ringSize - (head - ring.tail.load());
+        if (space == 0) {
+            // The peer is gone, so nobody is going to read this anyway.
+            if (ring.closed.load())
+                return;
+            const uint32_t seq = ring.spaceSeq.load();
+            ring.spaceWaiters.fetch_add(1);
+            if (ring.tail.load() + ringSize == head && !ring.closed.load())
+                futexWait(ring.spaceSeq, seq);
+            ring.spaceWaiters.fetch_sub(1);
+            continue;
+        }
+
+        const uint64_t offset = head % ringSize;
+        const uint64_t chunk = std::min({length, space, ringSize - offset});
+        memcpy(ringData[r] + offset, src, chunk);
+        ring.head.store(head + chunk);
+        ring.dataSeq.fetch_add(1);
+        if (ring.dataWaiters.load())
+            futexWake(ring.dataSeq);
+
+        src += chunk;
+        length -= chunk;
+    }
+}
+
+bool
+ShmIface::readRing(unsigned r, void *buf, uint64_t length)
+{
+    Ring &ring = segment->rings[r];
+    uint8_t *dst = static_cast<uint8_t *>(buf);
+
+    while (length > 0) {
+        const uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+        const uint64_t avail = ring.head.load() - tail;
+        if (avail == 0) {
+            if (ring.closed.load()) {
+                inform("Dist shared memory link %s closed", segName);
+                return false;
+            }
+            const uint32_t seq = ring.dataSeq.load();
+            ring.dataWaiters.fetch_add(1);
+            if (ring.head.load() == tail && !ring.closed.load())
+                futexWait(ring.dataSeq, seq);
+            ring.dataWaiters.fetch_sub(1);
+            continue;
+        }
+
+        const uint64_t offset = tail % ringSize;
+        const uint64_t chunk = std::min({length, avail, ringSize - offset});
+        memcpy(dst, ringData[r] + offset, chunk);
+        ring.tail.store(tail + chunk);
+        ring.spaceSeq.fetch_add(1);
+        if (ring.spaceWaiters.load())
+            futexWake(ring.spaceSeq);
+
+        dst += chunk;
+        length -= chunk;
+    }
+    return true;
+}
+
+void
+ShmIface::sendPacket(const Header &header, const EthPacketPtr &packet)
+{
+    std::lock_guard<std::mutex> send_lock(sender->lock);
+    writeRing(txRing, &header, sizeof(header));
+    writeRing(txRing, packet->data, packet->length);
+}
+
+void
+ShmIface::sendCmd(const Header &header)
+{
+    DPRINTF(DistEthernetCmd, "ShmIface::sendCmd() type: %d\n",
+            static_cast<int>(header.msgType));
+    // Global commands (i.e. sync request) are always sent by the primary
+    // DistIface, as point-to-point messages over every link.
+    for (auto *s : senderRegistry) {
+        std::lock_guard<std::mutex> send_lock(s->lock);
+        s->iface->writeRing(s->iface->txRing, &header, sizeof(header));
+    }
+}
+
+bool
+ShmIface::recvHeader(Header &header)
+{
+    bool ret = readRing(1 - txRing, &header, sizeof(header));
+    DPRINTF(DistEthernetCmd, "ShmIface::recvHeader() type: %d ret: %d\n",
+            static_cast<int>(header.msgType), ret);
+    return ret;
+}
+
+void
+ShmIface::recvPacket(const Header &header, EthPacketPtr &packet)
+{
+    packet = std::make_shared<EthPacketData>(header.dataPacketLength);
+    bool ret = readRing(1 - txRing, packet->data, header.dataPacketLength);
+    panic_if(!ret, "Error while reading shared memory link %s", segName);
+    packet->simLength = header.simLength;
+    packet->length = header.dataPacketLength;
+}
+
+void
+ShmIface::initTransport()
+{
+    // Like for the TCP transport, the number of dist interfaces per process
+    // is only known in the init phase.
+    fatal_if(!isSwitch && distIfaceNum != 1,
+             "The dist shared memory transport supports a single "
+             "DistEtherLink per compute node (got %d)", distIfaceNum);
+    establishConnection();
+}
+
+} // namespace gem5
@@ -0,0 +1,170 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory based interface class for dist-gem5 runs.
+ *
+ * For a high level description about dist-gem5 see comments in
+ * header file dist_iface.hh.
+ *
+ * This is an alternative to the TCP transport for gem5 processes that all
+ * run on the same host. Every link between a compute node and the switch
+ * process is a POSIX shared memory segment holding one single producer,
+ * single consumer ring buffer per direction. Readers and writers only
+ * enter the kernel (through a futex) when they have to wait for their
+ * peer.
+ */
+#ifndef __DEV_NET_SHM_IFACE_HH__
+#define __DEV_NET_SHM_IFACE_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dev/net/dist_iface.hh"
+
+namespace gem5
+{
+
+class EventManager;
+
+class ShmIface : public DistIface
+{
+  private:
+    /**
+     * Control block of a ring buffer. Positions are free running byte
+     * counts, and the sequence words are the ones waited on with futexes.
+     */
+    struct Ring
+    {
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+        alignas(64) std::atomic<uint32_t> dataSeq;
+        std::atomic<uint32_t> dataWaiters;
+        alignas(64) std::atomic<uint32_t> spaceSeq;
+        std::atomic<uint32_t> spaceWaiters;
+        std::atomic<uint32_t> closed;
+    };
+
+    /**
+     * Layout of the start of a shared segment. The ring data areas follow
+     * it. A freshly created (zero filled) segment is in a valid state.
+     */
+    struct Segment
+    {
+        /** Set by the node (0) and by the switch (1) once attached */
+        std::atomic<uint32_t> attached[2];
+        /** Node to switch (0) and switch to node (1) rings */
+        Ring rings[2];
+    };
+
+    /** Name of the shared memory segment of this link */
+    std::string segName;
+    /** Size in bytes of the data area of each ring */
+    const uint64_t ringSize;
+
+    bool isSwitch;
+
+    /** The mapped segment */
+    Segment *segment = nullptr;
+    uint8_t *ringData[2] = {nullptr, nullptr};
+
+    /** Index of the ring this end produces into */
+    unsigned txRing;
+
+    /**
+     * Send side state shared by all links of this gem5 process. Commands
+     * are broadcast over every link, so the senders have to be serialised
+     * with the data packets sent by the owning link.
+     */
+    struct Sender
+    {
+        ShmIface *iface;
+        std::mutex lock;
+    };
+    static std::vector<Sender *> senderRegistry;
+    Sender *sender = nullptr;
+
+  private:
+    /**
+     * Copy a message into a ring, waiting for space as needed.
+     *
+     * @param r Index of the ring to write.
+     * @param buf Start address of the message.
+     * @param length Size of the message in bytes.
+     */
+    void writeRing(unsigned r, const void *buf, uint64_t length);
+
+    /**
+     * Copy the next message out of a ring, waiting for data as needed.
+     *
+     * @param r Index of the ring to read.
+     * @param buf Start address of buffer to store the message.
+     * @param length Exact size of the expected message in bytes.
+     * @return false if the ring got closed before the message was read.
+     */
+    bool readRing(unsigned r, void *buf, uint64_t length);
+
+    /** Map the segment of this link and wait for the peer to attach. */
+    void establishConnection();
+
+  protected:
+
+    void sendPacket(const Header &header,
+                    const EthPacketPtr &packet) override;
+
+    void sendCmd(const Header &header) override;
+
+    bool recvHeader(Header &header) override;
+
+    void recvPacket(const Header &header, EthPacketPtr &packet) override;
+
+    void initTransport() override;
+
+  public:
+    /**
+     * @param shm_name Prefix for the names of the shared memory segments.
+     * All gem5 processes of a dist run must use the same prefix.
+     * @param ring_size Size in bytes of the ring buffer in each direction.
+     * @param sync_start The tick for the first dist synchronisation.
+     * @param sync_repeat The frequency of dist synchronisation.
+     * @param sync_repeat_max Upper bound for an adaptive sync interval.
+     * @param em The EventManager object associated with the simulated
+     * Ethernet link.
+     */
+    ShmIface(std::string shm_name, uint64_t ring_size,
+             unsigned dist_rank, unsigned dist_size,
+             Tick sync_start, Tick sync_repeat, Tick sync_repeat_max,
+             EventManager *em,
+             bool use_pseudo_op, bool is_switch, int num_nodes);
+
+    ~ShmIface() override;
+};
+
+} // namespace gem5
+
+#endif // __DEV_NET_SHM_IFACE_HH__
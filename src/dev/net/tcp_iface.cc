@@ -81,11 +81,12 @@ bool TCPIface::anyListening = false;
 
 TCPIface::TCPIface(std::string server_name, unsigned server_port,
                    unsigned dist_rank, unsigned dist_size,
-                   Tick sync_start, Tick sync_repeat,
+                   Tick sync_start, Tick sync_repeat, Tick sync_repeat_max,
                    EventManager *em, bool use_pseudo_op, bool is_switch,
                    int num_nodes) :
-    DistIface(dist_rank, dist_size, sync_start, sync_repeat, em, use_pseudo_op,
-              is_switch, num_nodes), serverName(server_name),
+    DistIface(dist_rank, dist_size, sync_start, sync_repeat, sync_repeat_max,
+              em, use_pseudo_op, is_switch, num_nodes),
+    serverName(server_name),
     serverPort(server_port), isSwitch(is_switch), listening(false)
 {
     if (is_switch && isPrimary) {
@@ -147,7 +147,8 @@ class TCPIface : public DistIface
      */
     TCPIface(std::string server_name, unsigned server_port,
              unsigned dist_rank, unsigned dist_size,
-             Tick sync_start, Tick sync_repeat, EventManager *em,
+             Tick sync_start, Tick sync_repeat, Tick sync_repeat_max,
+             EventManager *em,
              bool use_pseudo_op, bool is_switch, int num_nodes);
 
     ~TCPIface() override;
@@ -63,6 +63,15 @@ class Clint(BasicPioDevice):
     mtimecmp_reset_value = Param.UInt64(
         0xFFFFFFFFFFFFFFFF, "mtimecmp reset value"
     )
+    # In tickless mode, RTC ticks are ignored and the RTC need not be
+    # connected at all. Timer interrupts are raised by one event per hart
+    # at its mtimecmp deadline, so idle harts cost no events.
+    tickless = Param.Bool(
+        False, "Compute mtime from the current tick instead of RTC ticks"
+    )
+    mtime_frequency = Param.Frequency(
+        "10MHz", "Rate at which mtime advances in tickless mode"
+    )
 
     def generateDeviceTree(self, state):
         node = self.generateBasicPioDeviceNode(
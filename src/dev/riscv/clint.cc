@@ -56,6 +56,8 @@ Clint::Clint(const Params &params) :
     signal(params.name + ".signal", 0, this, INT_RTC),
     reset(params.name + ".reset"),
     resetMtimecmp(params.reset_mtimecmp),
+    tickless(params.tickless),
+    mtimePeriod(params.mtime_frequency),
     registers(params.name + ".registers", params.pio_addr, this,
               params.mtimecmp_reset_value)
 {
@@ -64,11 +66,29 @@ Clint::Clint(const Params &params) :
               doReset();
           }
       });
+
+    if (tickless) {
+        for (int i = 0; i < nThread; i++) {
+            mtipEvents.emplace_back(new EventFunctionWrapper(
+                [this, i]{ updateMTIP(i); },
+                csprintf("%s.mtip%d", name(), i)));
+        }
+    }
 }
 
 void
 Clint::raiseInterruptPin(int id)
 {
+    // In tickless mode, mtime does not count RTC ticks and timer
+    // interrupts are raised by the deadline events
+    if (tickless) {
+        if (id == INT_RESET) {
+            for (int context_id = 0; context_id < nThread; context_id++)
+                updateMTIP(context_id);
+        }
+        return;
+    }
+
     // Increment mtime when received RTC signal
     uint64_t& mtime = registers.mtime.get();
     if (id == INT_RTC) {
@@ -105,6 +125,53 @@ Clint::raiseInterruptPin(int id)
     }
 }
 
+uint64_t
+Clint::readMtime() const
+{
+    if (!tickless)
+        return registers.mtime.get();
+    return mtimeBase + (curTick() - mtimeBaseTick) / mtimePeriod;
+}
+
+void
+Clint::rebaseMtime(uint64_t mtime)
+{
+    mtimeBase = mtime;
+    mtimeBaseTick = curTick();
+}
+
+void
+Clint::updateMTIP(const int thread_id)
+{
+    auto tc = system->threads[thread_id];
+    EventFunctionWrapper &event = *mtipEvents[thread_id];
+    const uint64_t mtime = readMtime();
+    const uint64_t mtimecmp = registers.mtimecmp[thread_id].get();
+
+    if (mtime >= mtimecmp) {
+        DPRINTF(Clint, "MTIP posted - thread: %d, mtime: %d, mtimecmp: %d\n",
+                thread_id, mtime, mtimecmp);
+        tc->getCpuPtr()->postInterrupt(tc->threadId(),
+                ExceptionCode::INT_TIMER_MACHINE, 0);
+        if (event.scheduled())
+            deschedule(event);
+        return;
+    }
+
+    tc->getCpuPtr()->clearInterrupt(tc->threadId(),
+            ExceptionCode::INT_TIMER_MACHINE, 0);
+
+    // mtime reaches mtimecmp at that tick exactly, unless that is beyond
+    // the end of time (e.g. mtimecmp is all ones while the timer is off)
+    const uint64_t delta = mtimecmp - mtimeBase;
+    if (delta > (MaxTick - mtimeBaseTick) / mtimePeriod) {
+        if (event.scheduled())
+            deschedule(event);
+        return;
+    }
+    reschedule(event, mtimeBaseTick + delta * mtimePeriod, true);
+}
+
 void
 Clint::ClintRegisters::init()
 {
@@ -140,10 +207,17 @@ Clint::ClintRegisters::init()
     }
     addRegister(reserved[0]);
     for (int i = 0; i < clint->nThread; i++) {
+        if (clint->tickless) {
+            auto write_cb = std::bind(&Clint::writeMtimecmp, clint, _1, _2, i);
+            mtimecmp[i].writer(write_cb);
+        }
         addRegister(mtimecmp[i]);
     }
     addRegister(reserved[1]);
     mtime.readonly();
+    if (clint->tickless) {
+        mtime.reader([this](Register64 &reg) { return clint->readMtime(); });
+    }
     addRegister(mtime);
     if (reserved2_size > 0) {
         addRegister(reserved[2]);
@@ -157,6 +231,14 @@ Clint::writeMSIP(Register32& reg, const uint32_t& data, const int thread_id)
     updateMSIP(thread_id);
 };
 
+void
+Clint::writeMtimecmp(Register64& reg, const uint64_t& data,
+                     const int thread_id)
+{
+    reg.update(data);
+    updateMTIP(thread_id);
+}
+
 Tick
 Clint::read(PacketPtr pkt)
 {
@@ -200,6 +282,23 @@ Clint::init()
     BasicPioDevice::init();
 }
 
+void
+Clint::startup()
+{
+    BasicPioDevice::startup();
+
+    if (!tickless)
+        return;
+
+    // The time CSR of the harts follows mtime without being updated
+    for (int context_id = 0; context_id < nThread; context_id++) {
+        auto tc = system->threads[context_id];
+        ISA* isa = dynamic_cast<ISA*>(tc->getIsaPtr());
+        isa->setTimeSource([this]{ return readMtime(); });
+        updateMTIP(context_id);
+    }
+}
+
 Port &
 Clint::getPort(const std::string &if_name, PortID idx)
 {
@@ -220,7 +319,7 @@ Clint::serialize(CheckpointOut &cp) const
     for (auto const &reg: registers.mtimecmp) {
         paramOut(cp, reg.name(), reg);
     }
-    paramOut(cp, "mtime", registers.mtime);
+    paramOut(cp, "mtime", readMtime());
 }
 
 void
@@ -233,6 +332,7 @@ Clint::unserialize(CheckpointIn &cp)
         paramIn(cp, reg.name(), reg);
     }
     paramIn(cp, "mtime", registers.mtime);
+    rebaseMtime(registers.mtime.get());
 }
 
 void
@@ -253,6 +353,7 @@ Clint::updateMSIP(const int thread_id)
 void
 Clint::doReset() {
     registers.mtime.reset();
+    rebaseMtime(registers.mtime.get());
     for (int i = 0; i < nThread; i++) {
         // According to the spec, the mtimecmp is in unknown state
         // Assume we will change the mtimecmp registers to specify value
@@ -38,6 +38,9 @@
 #ifndef __DEV_RISCV_CLINT_HH__
 #define __DEV_RISCV_CLINT_HH__
 
+#include <memory>
+#include <vector>
+
 #include "arch/riscv/interrupts.hh"
 #include "dev/intpin.hh"
 #include "dev/io_device.hh"
@@ -46,6 +49,7 @@
 #include "mem/packet.hh"
 #include "mem/packet_access.hh"
 #include "params/Clint.hh"
+#include "sim/eventq.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -77,6 +81,12 @@ class Clint : public BasicPioDevice
     SignalSinkPort<bool> reset;
     bool resetMtimecmp;
 
+    /** Compute mtime from curTick() instead of counting RTC ticks */
+    bool tickless;
+
+    /** Ticks per mtime increment in tickless mode */
+    Tick mtimePeriod;
+
   public:
     typedef ClintParams Params;
     Clint(const Params &params);
@@ -136,8 +146,36 @@ class Clint : public BasicPioDevice
     } registers;
 
     using Register32 = ClintRegisters::Register32;
+    using Register64 = ClintRegisters::Register64;
 
     void writeMSIP(Register32& reg, const uint32_t& data, const int thread_id);
+    void writeMtimecmp(Register64& reg, const uint64_t& data,
+                       const int thread_id);
+
+  // Tickless timer
+  protected:
+    /** mtime at tick mtimeBaseTick, from which mtime is extrapolated */
+    uint64_t mtimeBase = 0;
+    Tick mtimeBaseTick = 0;
+
+    /** Per-hart events raising MTIP at the mtimecmp deadline */
+    std::vector<std::unique_ptr<EventFunctionWrapper>> mtipEvents;
+
+    /** Restart the extrapolation of mtime at the current tick */
+    void rebaseMtime(uint64_t mtime);
+
+  public:
+    /**
+     * Current value of mtime, computed from the current tick in
+     * tickless mode
+     */
+    uint64_t readMtime() const;
+
+    /**
+     * Post or clear MTIP of a hart in tickless mode, and schedule its
+     * deadline event if mtimecmp is still ahead
+     */
+    void updateMTIP(const int thread_id);
 
   // External API
   public:
@@ -151,6 +189,7 @@ class Clint : public BasicPioDevice
      * SimObject functions
      */
     void init() override;
+    void startup() override;
     Port & getPort(const std::string &if_name,
                    PortID idx=InvalidPortID) override;
     void serialize(CheckpointOut &cp) const override;
@@ -50,3 +50,13 @@ class CowDiskImage(DiskImage):
     child = Param.DiskImage(RawDiskImage(read_only=True), "child image")
     table_size = Param.Int(65536, "initial table size")
     image_file = ""
+
+
+class ChunkedCowDiskImage(DiskImage):
+    type = "ChunkedCowDiskImage"
+    cxx_header = "dev/storage/disk_image.hh"
+    cxx_class = "gem5::ChunkedCowDiskImage"
+    child = Param.DiskImage(RawDiskImage(read_only=True), "child image")
+    chunk_size = Param.MemorySize("64KiB", "Size of the overlay chunks")
+    # Sparse overlay file; the overlay is kept in memory if empty
+    image_file = ""
@@ -32,16 +32,25 @@
 
 #include "dev/storage/disk_image.hh"
 
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
+#ifdef __linux__
+#include <linux/fs.h>
+#endif
+
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <fstream>
 #include <string>
 
 #include "base/callback.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/DiskImageRead.hh"
@@ -53,6 +62,40 @@
 namespace gem5
 {
 
+////////////////////////////////////////////////////////////////////////
+//
+// Disk image
+//
+std::streampos
+DiskImage::readSectors(uint8_t *data, std::streampos offset,
+                       size_t count) const
+{
+    const uint64_t first = offset;
+    std::streampos bytes = 0;
+    for (size_t i = 0; i < count; ++i) {
+        std::streampos ret = read(data + i * SectorSize, first + i);
+        bytes += ret;
+        if (ret != SectorSize)
+            break;
+    }
+    return bytes;
+}
+
+std::streampos
+DiskImage::writeSectors(const uint8_t *data, std::streampos offset,
+                        size_t count)
+{
+    const uint64_t first = offset;
+    std::streampos bytes = 0;
+    for (size_t i = 0; i < count; ++i) {
+        std::streampos ret = write(data + i * SectorSize, first + i);
+        bytes += ret;
+        if (ret != SectorSize)
+            break;
+    }
+    return bytes;
+}
+
 ////////////////////////////////////////////////////////////////////////
 //
 // Raw Disk image
@@ -161,6 +204,63 @@ RawDiskImage::write(const uint8_t *data, std::streampos offset)
     return stream.tellp() - pos;
 }
 
+std::streampos
+RawDiskImage::readSectors(uint8_t *data, std::streampos offset,
+                          size_t count) const
+{
+    if (!initialized)
+        panic("RawDiskImage not initialized");
+
+    if (!stream.is_open())
+        panic("file not open!\n");
+
+    // A single host access covers all the sectors
+    stream.seekg(offset * SectorSize, std::ios::beg);
+    if (!stream.good())
+        panic("Could not seek to location in file");
+
+    std::streampos pos = stream.tellg();
+    stream.read((char *)data, count * SectorSize);
+
+    DPRINTF(DiskImageRead, "read: offset=%d count=%d\n", (uint64_t)offset,
+            count);
+    DDUMP(DiskImageRead, data, count * SectorSize);
+
+    // The stream is left in a failed state if the image ends early
+    if (!stream.good()) {
+        std::streampos bytes = stream.gcount();
+        stream.clear();
+        return bytes;
+    }
+    return stream.tellg() - pos;
+}
+
+std::streampos
+RawDiskImage::writeSectors(const uint8_t *data, std::streampos offset,
+                           size_t count)
+{
+    if (!initialized)
+        panic("RawDiskImage not initialized");
+
+    if (readonly)
+        panic("Cannot write to a read only disk image");
+
+    if (!stream.is_open())
+        panic("file not open!\n");
+
+    stream.seekp(offset * SectorSize, std::ios::beg);
+    if (!stream.good())
+        panic("Could not seek to location in file");
+
+    DPRINTF(DiskImageWrite, "write: offset=%d count=%d\n", (uint64_t)offset,
+            count);
+    DDUMP(DiskImageWrite, data, count * SectorSize);
+
+    std::streampos pos = stream.tellp();
+    stream.write((const char *)data, count * SectorSize);
+    return stream.tellp() - pos;
+}
+
 ////////////////////////////////////////////////////////////////////////
 //
 // Copy on Write Disk image
@@ -438,4 +538,311 @@ CowDiskImage::unserialize(CheckpointIn &cp)
     open(cowFilename);
 }
 
+////////////////////////////////////////////////////////////////////////
+//
+// Chunked, memory-mapped copy on write disk image
+//
+const uint32_t ChunkedCowDiskImage::VersionMajor = 1;
+const uint32_t ChunkedCowDiskImage::VersionMinor = 0;
+
+namespace
+{
+
+const char ChunkedCowMagic[8] = {'C', 'O', 'W', 'C', 'H', 'U', 'N', 'K'};
+
+/** Write a whole buffer at the given file offset. */
+void
+writeAll(int fd, const void *buf, uint64_t count, uint64_t offset,
+         const std::string &file)
+{
+    const uint8_t *ptr = static_cast<const uint8_t *>(buf);
+    while (count > 0) {
+        ssize_t ret = pwrite(fd, ptr, count, offset);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        panic_if(ret <= 0, "Error writing %s: %s", file, strerror(errno));
+        ptr += ret;
+        count -= ret;
+        offset += ret;
+    }
+}
+
+/** Read a whole buffer from the given file offset. */
+void
+readAll(int fd, void *buf, uint64_t count, uint64_t offset,
+        const std::string &file)
+{
+    uint8_t *ptr = static_cast<uint8_t *>(buf);
+    while (count > 0) {
+        ssize_t ret = pread(fd, ptr, count, offset);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        panic_if(ret < 0, "Error reading %s: %s", file, strerror(errno));
+        panic_if(ret == 0, "Premature end-of-file in %s", file);
+        ptr += ret;
+        count -= ret;
+        offset += ret;
+    }
+}
+
+} // anonymous namespace
+
+ChunkedCowDiskImage::ChunkedCowDiskImage(const Params &p)
+    : DiskImage(p), filename(p.image_file), child(p.child),
+      chunkSize(p.chunk_size), sectorsPerChunk(p.chunk_size / SectorSize),
+      wordsPerChunk(divCeil(sectorsPerChunk, 64)), sectors(0),
+      numChunks(0), indexOffset(0), dataOffset(0), mappedSize(0), fd(-1),
+      sharedMapping(false), mapping(nullptr), index(nullptr), chunks(nullptr)
+{
+    fatal_if(!isPowerOf2(chunkSize) || chunkSize < SectorSize,
+        "%s: the chunk size must be a power of 2 of at least a sector",
+        name());
+
+    computeLayout();
+    mapOverlay(p.read_only);
+}
+
+ChunkedCowDiskImage::~ChunkedCowDiskImage()
+{
+    if (mapping) {
+        if (sharedMapping)
+            msync(mapping, mappedSize, MS_SYNC);
+        munmap(mapping, mappedSize);
+    }
+    if (fd >= 0)
+        ::close(fd);
+}
+
+void
+ChunkedCowDiskImage::computeLayout()
+{
+    sectors = child->size();
+    numChunks = divCeil(sectors, sectorsPerChunk);
+
+    const uint64_t page_size = sysconf(_SC_PAGE_SIZE);
+    indexOffset = roundUp(sizeof(Header), page_size);
+    const uint64_t index_bytes = numChunks * wordsPerChunk * sizeof(uint64_t);
+    // Chunks are aligned, so that each one can be a hole in the file
+    dataOffset = roundUp(indexOffset + index_bytes,
+                         std::max<uint64_t>(chunkSize, page_size));
+    mappedSize = dataOffset + numChunks * chunkSize;
+}
+
+ChunkedCowDiskImage::Header
+ChunkedCowDiskImage::makeHeader() const
+{
+    Header header;
+    memcpy(header.magic, ChunkedCowMagic, sizeof(header.magic));
+    header.versionMajor = htole(VersionMajor);
+    header.versionMinor = htole(VersionMinor);
+    header.chunkSize = htole(chunkSize);
+    header.sectors = htole(sectors);
+    header.indexOffset = htole(indexOffset);
+    header.dataOffset = htole(dataOffset);
+    return header;
+}
+
+void
+ChunkedCowDiskImage::checkHeader(const Header &header,
+                                 const std::string &file) const
+{
+    panic_if(memcmp(header.magic, ChunkedCowMagic, sizeof(header.magic)),
+        "Could not open %s: Invalid magic", file);
+    panic_if(letoh(header.versionMajor) != VersionMajor,
+        "Could not open %s: invalid version %d.%d != %d.%d", file,
+        letoh(header.versionMajor), letoh(header.versionMinor),
+        VersionMajor, VersionMinor);
+    panic_if(letoh(header.chunkSize) != chunkSize ||
+        letoh(header.sectors) != sectors ||
+        letoh(header.indexOffset) != indexOffset ||
+        letoh(header.dataOffset) != dataOffset,
+        "Could not open %s: the overlay does not match the child image "
+        "and chunk size", file);
+}
+
+void
+ChunkedCowDiskImage::mapOverlay(bool read_only)
+{
+    int prot = PROT_READ | PROT_WRITE;
+    int flags;
+    if (filename.empty()) {
+        // Anonymous pages are only allocated when written
+        flags = MAP_ANON | MAP_PRIVATE;
+    } else {
+        fd = ::open(filename.c_str(), read_only ? O_RDONLY : O_RDWR);
+        if (fd >= 0) {
+            Header header;
+            readAll(fd, &header, sizeof(header), 0, filename);
+            checkHeader(header, filename);
+        } else {
+            fatal_if(read_only, "%s: could not open read-only overlay %s",
+                name(), filename);
+            fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0664);
+            fatal_if(fd < 0, "%s: could not create overlay %s: %s", name(),
+                filename, strerror(errno));
+            // Extending the file only creates a hole
+            fatal_if(ftruncate(fd, mappedSize) != 0,
+                "%s: could not size overlay %s: %s", name(), filename,
+                strerror(errno));
+            const Header header = makeHeader();
+            writeAll(fd, &header, sizeof(header), 0, filename);
+        }
+        sharedMapping = !read_only;
+        flags = sharedMapping ? MAP_SHARED : MAP_PRIVATE;
+    }
+
+    void *ptr = mmap(nullptr, mappedSize, prot, flags, fd, 0);
+    fatal_if(ptr == MAP_FAILED, "%s: could not map the overlay: %s", name(),
+        strerror(errno));
+    mapping = static_cast<uint8_t *>(ptr);
+    index = reinterpret_cast<uint64_t *>(mapping + indexOffset);
+    chunks = mapping + dataOffset;
+
+    if (fd < 0) {
+        const Header header = makeHeader();
+        memcpy(mapping, &header, sizeof(header));
+    }
+
+    initialized = true;
+}
+
+bool
+ChunkedCowDiskImage::chunkWritten(uint64_t chunk) const
+{
+    const uint64_t *bitmap = &index[chunk * wordsPerChunk];
+    for (uint64_t i = 0; i < wordsPerChunk; i++) {
+        if (bitmap[i] != 0)
+            return true;
+    }
+    return false;
+}
+
+void
+ChunkedCowDiskImage::notifyFork()
+{
+    if (!sharedMapping)
+        return;
+
+    // Keep the overlay of the parent intact: map the file privately, so
+    // the writes of the child process are only visible to itself
+    inform("Disabling saving of COW image in forked child process.\n");
+    msync(mapping, mappedSize, MS_SYNC);
+    void *ptr = mmap(mapping, mappedSize, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_FIXED, fd, 0);
+    panic_if(ptr == MAP_FAILED, "%s: could not remap the overlay: %s",
+        name(), strerror(errno));
+    sharedMapping = false;
+}
+
+void
+ChunkedCowDiskImage::save(const std::string &file) const
+{
+    if (!initialized)
+        panic("ChunkedCowDiskImage not initialized");
+
+    int out = ::open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    panic_if(out < 0, "Error opening %s: %s", file, strerror(errno));
+
+#ifdef FICLONE
+    if (sharedMapping) {
+        msync(mapping, mappedSize, MS_SYNC);
+        if (ioctl(out, FICLONE, fd) == 0) {
+            ::close(out);
+            return;
+        }
+    }
+#endif
+
+    // Unwritten chunks are left as holes
+    panic_if(ftruncate(out, mappedSize) != 0, "Error sizing %s: %s", file,
+        strerror(errno));
+    writeAll(out, mapping, dataOffset, 0, file);
+    for (uint64_t chunk = 0; chunk < numChunks; chunk++) {
+        if (chunkWritten(chunk)) {
+            writeAll(out, chunks + chunk * chunkSize, chunkSize,
+                     dataOffset + chunk * chunkSize, file);
+        }
+    }
+    ::close(out);
+}
+
+void
+ChunkedCowDiskImage::serialize(CheckpointOut &cp) const
+{
+    std::string cowFilename = name() + ".cowchunks";
+    SERIALIZE_SCALAR(cowFilename);
+    save(CheckpointIn::dir() + "/" + cowFilename);
+}
+
+void
+ChunkedCowDiskImage::unserialize(CheckpointIn &cp)
+{
+    std::string cowFilename;
+    UNSERIALIZE_SCALAR(cowFilename);
+    cowFilename = cp.getCptDir() + "/" + cowFilename;
+
+    // The checkpoint is copied into the overlay, so that restoring never
+    // modifies the checkpoint itself
+    int in = ::open(cowFilename.c_str(), O_RDONLY);
+    panic_if(in < 0, "Error opening %s: %s", cowFilename, strerror(errno));
+    Header header;
+    readAll(in, &header, sizeof(header), 0, cowFilename);
+    checkHeader(header, cowFilename);
+
+    readAll(in, mapping + indexOffset, dataOffset - indexOffset,
+            indexOffset, cowFilename);
+    for (uint64_t chunk = 0; chunk < numChunks; chunk++) {
+        if (chunkWritten(chunk)) {
+            readAll(in, chunks + chunk * chunkSize, chunkSize,
+                    dataOffset + chunk * chunkSize, cowFilename);
+        }
+    }
+    ::close(in);
+}
+
+std::streampos
+ChunkedCowDiskImage::size() const
+{ return child->size(); }
+
+std::streampos
+ChunkedCowDiskImage::read(uint8_t *data, std::streampos offset) const
+{
+    if (!initialized)
+        panic("ChunkedCowDiskImage not initialized");
+
+    if (offset >= sectors)
+        panic("access out of bounds");
+
+    if (!sectorWritten(offset))
+        return child->read(data, offset);
+
+    memcpy(data, chunks + (uint64_t)offset * SectorSize, SectorSize);
+    DPRINTF(DiskImageRead, "read: offset=%d\n", (uint64_t)offset);
+    DDUMP(DiskImageRead, data, SectorSize);
+    return SectorSize;
+}
+
+std::streampos
+ChunkedCowDiskImage::write(const uint8_t *data, std::streampos offset)
+{
+    if (!initialized)
+        panic("ChunkedCowDiskImage not initialized");
+
+    if (offset >= sectors)
+        panic("access out of bounds");
+
+    const uint64_t sector = offset;
+    memcpy(chunks + sector * SectorSize, data, SectorSize);
+
+    const uint64_t bit = sector % sectorsPerChunk;
+    uint64_t &word =
+        index[(sector / sectorsPerChunk) * wordsPerChunk + bit / 64];
+    word = htole(letoh(word) | (1ULL << (bit % 64)));
+
+    DPRINTF(DiskImageWrite, "write: offset=%d\n", (uint64_t)offset);
+    DDUMP(DiskImageWrite, data, SectorSize);
+
+    return SectorSize;
+}
+
 } // namespace gem5
@@ -36,9 +36,11 @@
 #include <fstream>
 #include <unordered_map>
 
+#include "params/ChunkedCowDiskImage.hh"
 #include "params/CowDiskImage.hh"
 #include "params/DiskImage.hh"
 #include "params/RawDiskImage.hh"
+#include "sim/byteswap.hh"
 #include "sim/sim_object.hh"
 
 #define SectorSize (512)
@@ -65,6 +67,33 @@ class DiskImage : public SimObject
                                 std::streampos offset) const = 0;
     virtual std::streampos write(const uint8_t *data,
                                  std::streampos offset) = 0;
+
+    /**
+     * Read consecutive sectors. Images that can access several sectors
+     * at once should override this; by default sectors are read one at
+     * a time.
+     *
+     * @param data Destination buffer, of count * SectorSize bytes.
+     * @param offset First sector to read.
+     * @param count Number of sectors to read.
+     * @return Number of bytes read.
+     */
+    virtual std::streampos readSectors(uint8_t *data, std::streampos offset,
+                                       size_t count) const;
+
+    /**
+     * Write consecutive sectors.
+     *
+     * @see readSectors
+     *
+     * @param data Source buffer, of count * SectorSize bytes.
+     * @param offset First sector to write.
+     * @param count Number of sectors to write.
+     * @return Number of bytes written.
+     */
+    virtual std::streampos writeSectors(const uint8_t *data,
+                                        std::streampos offset,
+                                        size_t count);
 };
 
 /**
@@ -92,6 +121,11 @@ class RawDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
+
+    std::streampos readSectors(uint8_t *data, std::streampos offset,
+                               size_t count) const override;
+    std::streampos writeSectors(const uint8_t *data, std::streampos offset,
+                                size_t count) override;
 };
 
 /**
@@ -144,6 +178,128 @@ class CowDiskImage : public DiskImage
     std::streampos write(const uint8_t *data, std::streampos offset) override;
 };
 
+/**
+ * Copy-on-write disk image layer stored in a sparse, memory-mapped
+ * overlay file. The overlay covers the whole child image and is split in
+ * chunks; an on-disk index records which sectors of each chunk have been
+ * written. Chunks that are never written are holes in the file, so an
+ * overlay is cheap to create, and checkpoints only copy the written
+ * chunks (or reflink the whole file when the filesystem supports it).
+ *
+ * Without an overlay file the layer lives in anonymous memory, which is
+ * only allocated as chunks are written. A read-only overlay file is
+ * mapped privately, so writes are not persisted.
+ */
+class ChunkedCowDiskImage : public DiskImage
+{
+  public:
+    static const uint32_t VersionMajor;
+    static const uint32_t VersionMinor;
+
+  protected:
+    /** Overlay file header, stored in little endian at offset 0 */
+    struct Header
+    {
+        char magic[8];
+        uint32_t versionMajor;
+        uint32_t versionMinor;
+        /** Size of a chunk, in bytes */
+        uint64_t chunkSize;
+        /** Number of sectors of the image */
+        uint64_t sectors;
+        /** Offset of the index, in bytes */
+        uint64_t indexOffset;
+        /** Offset of the first chunk, in bytes */
+        uint64_t dataOffset;
+    };
+
+    std::string filename;
+    DiskImage *child;
+
+    /** Size of a chunk, in bytes */
+    const uint64_t chunkSize;
+    /** Number of sectors in a chunk */
+    const uint64_t sectorsPerChunk;
+    /** Number of 64-bit index words holding the bitmap of a chunk */
+    const uint64_t wordsPerChunk;
+
+    /** Number of sectors of the image */
+    uint64_t sectors;
+    /** Number of chunks covering the image */
+    uint64_t numChunks;
+    /** Offset of the index in the overlay, in bytes */
+    uint64_t indexOffset;
+    /** Offset of the first chunk in the overlay, in bytes */
+    uint64_t dataOffset;
+    /** Size of the whole overlay, in bytes */
+    uint64_t mappedSize;
+
+    /** Overlay file descriptor, -1 if the overlay is anonymous */
+    int fd;
+    /** Whether writes to the mapping reach the overlay file */
+    bool sharedMapping;
+    /** Start of the overlay mapping */
+    uint8_t *mapping;
+    /** Bitmaps of the written sectors of each chunk */
+    uint64_t *index;
+    /** Contents of the chunks */
+    uint8_t *chunks;
+
+    /** Compute the layout of the overlay for the given child image. */
+    void computeLayout();
+
+    /** Build the header describing the current layout. */
+    Header makeHeader() const;
+
+    /**
+     * Check that a header describes an overlay of the current layout.
+     * @param header The header read from an overlay
+     * @param file The file it comes from, for error messages
+     */
+    void checkHeader(const Header &header, const std::string &file) const;
+
+    /**
+     * Map the overlay, creating its file if needed.
+     * @param read_only Whether changes must not reach the file
+     */
+    void mapOverlay(bool read_only);
+
+    /** Whether any sector of a chunk has been written. */
+    bool chunkWritten(uint64_t chunk) const;
+
+    /** Whether a sector has been written to the overlay. */
+    bool
+    sectorWritten(uint64_t sector) const
+    {
+        const uint64_t bit = sector % sectorsPerChunk;
+        const uint64_t word = letoh(index[(sector / sectorsPerChunk) *
+            wordsPerChunk + bit / 64]);
+        return (word >> (bit % 64)) & 1;
+    }
+
+  public:
+    typedef ChunkedCowDiskImageParams Params;
+    ChunkedCowDiskImage(const Params &p);
+    ~ChunkedCowDiskImage();
+
+    void notifyFork() override;
+
+    /**
+     * Save the overlay to a file, by reflink if possible, or else by
+     * copying the header, the index and the written chunks.
+     * @param file Destination file
+     */
+    void save(const std::string &file) const;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+    std::streampos size() const override;
+
+    std::streampos read(uint8_t *data, std::streampos offset) const override;
+    std::streampos write(const uint8_t *data, std::streampos offset) override;
+};
+
 void SafeRead(std::ifstream &stream, void *data, int count);
 
 template<class T>
@@ -56,6 +56,13 @@ class VirtIO9PProxy(VirtIO9PBase):
     cxx_header = "dev/virtio/fs9p.hh"
     cxx_class = "gem5::VirtIO9PProxy"
 
+    hostIOThreads = Param.Bool(
+        False,
+        "Exchange messages with the 9p server on host threads, so that "
+        "the simulation does not wait for the server and several "
+        "requests can be outstanding",
+    )
+
 
 class VirtIO9PDiod(VirtIO9PProxy):
     type = "VirtIO9PDiod"
@@ -46,5 +46,6 @@ class VirtIOBlock(VirtIODeviceBase):
     cxx_class = "gem5::VirtIOBlock"
 
     queueSize = Param.Unsigned(128, "Output queue size (pages)")
+    numQueues = Param.Unsigned(1, "Number of request queues")
 
     image = Param.DiskImage("Disk image")
@@ -49,7 +49,7 @@ namespace gem5
 VirtDescriptor::VirtDescriptor(PortProxy &_memProxy, ByteOrder bo,
                                VirtQueue &_queue, Index descIndex)
     : memProxy(&_memProxy), queue(&_queue), byteOrder(bo), _index(descIndex),
-      desc{0, 0, 0, 0}
+      desc{0, 0, 0, 0}, table(NULL)
 {
 }
 
@@ -70,6 +70,11 @@ VirtDescriptor::operator=(VirtDescriptor &&rhs) noexcept
     byteOrder = std::move(rhs.byteOrder);
     _index = std::move(rhs._index);
     desc = std::move(rhs.desc);
+    table = std::move(rhs.table);
+    indirect = std::move(rhs.indirect);
+    // The indirect descriptors must refer to their new table
+    for (VirtDescriptor &d : indirect)
+        d.table = &indirect;
 
     return *this;
 }
@@ -103,6 +108,61 @@ VirtDescriptor::updateChain()
 
     if (desc == this)
         panic("Loop in descriptor chain!\n");
+
+    if (isIndirect())
+        updateIndirect();
+}
+
+void
+VirtDescriptor::updateIndirect()
+{
+    if (hasNext())
+        panic("Indirect descriptor %i is chained\n", _index);
+    if (table)
+        panic("Nested indirect descriptor table\n");
+
+    const size_t count(desc.len / sizeof(vring_desc));
+    if (count == 0 || desc.len % sizeof(vring_desc) != 0)
+        panic("Invalid indirect descriptor table size: %i\n", desc.len);
+
+    // Fetch the whole table at once rather than one descriptor at a time
+    std::vector<vring_desc> guest_table(count);
+    memProxy->readBlob(desc.addr, guest_table.data(), desc.len);
+
+    indirect.clear();
+    indirect.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        indirect.emplace_back(*memProxy, byteOrder, *queue, i);
+        VirtDescriptor &d(indirect.back());
+        d.table = &indirect;
+        d.desc = gtoh(guest_table[i], byteOrder);
+        if (d.isIndirect())
+            panic("Nested indirect descriptor table\n");
+        DPRINTF(VIO,
+                "VirtDescriptor(%i.%i): Addr: 0x%x, Len: %i, Flags: 0x%x, "
+                "Next: 0x%x\n",
+                _index, i, d.desc.addr, d.desc.len, d.desc.flags,
+                d.desc.next);
+    }
+
+    // A chain without loops visits each descriptor at most once
+    size_t visited(0);
+    for (const VirtDescriptor *d = &indirect[0]; d != NULL; d = d->next()) {
+        if (++visited > count)
+            panic("Loop in indirect descriptor chain!\n");
+    }
+}
+
+const VirtDescriptor *
+VirtDescriptor::chainHead() const
+{
+    return isIndirect() && !indirect.empty() ? &indirect[0] : this;
+}
+
+VirtDescriptor *
+VirtDescriptor::chainHead()
+{
+    return isIndirect() && !indirect.empty() ? &indirect[0] : this;
 }
 
 void
@@ -128,7 +188,7 @@ VirtDescriptor::dumpChain() const
     if (!debug::VIO)
         return;
 
-    const VirtDescriptor *desc(this);
+    const VirtDescriptor *desc(chainHead());
     do {
         desc->dump();
     } while ((desc = desc->next()) != NULL);
@@ -137,10 +197,14 @@ VirtDescriptor::dumpChain() const
 VirtDescriptor *
 VirtDescriptor::next() const
 {
-    if (hasNext()) {
-        return queue->getDescriptor(desc.next);
-    } else {
+    if (!hasNext()) {
         return NULL;
+    } else if (table) {
+        if (desc.next >= table->size())
+            panic("Invalid indirect descriptor index: %i\n", desc.next);
+        return &(*table)[desc.next];
+    } else {
+        return queue->getDescriptor(desc.next);
     }
 }
 
@@ -171,7 +235,7 @@ VirtDescriptor::write(size_t offset, const uint8_t *src, size_t size)
 void
 VirtDescriptor::chainRead(size_t offset, uint8_t *dst, size_t size) const
 {
-    const VirtDescriptor *desc(this);
+    const VirtDescriptor *desc(chainHead());
     const size_t full_size(size);
     do {
         if (offset < desc->size()) {
@@ -194,7 +258,7 @@ VirtDescriptor::chainRead(size_t offset, uint8_t *dst, size_t size) const
 void
 VirtDescriptor::chainWrite(size_t offset, const uint8_t *src, size_t size)
 {
-    VirtDescriptor *desc(this);
+    VirtDescriptor *desc(chainHead());
     const size_t full_size(size);
     do {
         if (offset < desc->size()) {
@@ -218,7 +282,7 @@ size_t
 VirtDescriptor::chainSize() const
 {
     size_t size(0);
-    const VirtDescriptor *desc(this);
+    const VirtDescriptor *desc(chainHead());
     do {
         size += desc->size();
     } while ((desc = desc->next()) != NULL);
@@ -252,6 +316,8 @@ VirtQueue::unserialize(CheckpointIn &cp)
 
     paramIn(cp, "_address", addr_in);
     UNSERIALIZE_SCALAR(_last_avail);
+    // Make the next consumeDescriptor() fetch the guest's index
+    avail.header.index = _last_avail;
 
     // Use the address setter to ensure that the ring buffer addresses
     // are updated as well.
@@ -284,14 +350,24 @@ VirtQueue::setAddress(Addr address)
 VirtDescriptor *
 VirtQueue::consumeDescriptor()
 {
-    avail.read();
+    // Only fetch the index of the guest once all the descriptors seen
+    // so far have been consumed, and only fetch the ring elements that
+    // are consumed
+    if (_last_avail == avail.header.index) {
+        avail.readHeader();
+        if (_last_avail == avail.header.index) {
+            DPRINTF(VIO, "consumeDescriptor: _last_avail: %i, empty\n",
+                    _last_avail);
+            return NULL;
+        }
+    }
+
+    const uint16_t slot(_last_avail % avail.ring.size());
+    avail.readElement(slot);
     DPRINTF(VIO, "consumeDescriptor: _last_avail: %i, avail.idx: %i (->%i)\n",
-            _last_avail, avail.header.index,
-            avail.ring[_last_avail % used.ring.size()]);
-    if (_last_avail == avail.header.index)
-        return NULL;
+            _last_avail, avail.header.index, avail.ring[slot]);
 
-    VirtDescriptor::Index index(avail.ring[_last_avail % used.ring.size()]);
+    VirtDescriptor::Index index(avail.ring[slot]);
     ++_last_avail;
 
     VirtDescriptor *d(&descriptors[index]);
@@ -307,11 +383,14 @@ VirtQueue::produceDescriptor(VirtDescriptor *desc, uint32_t len)
     DPRINTF(VIO, "produceDescriptor: dscIdx: %i, len: %i, used.idx: %i\n",
             desc->index(), len, used.header.index);
 
-    struct vring_used_elem &e(used.ring[used.header.index % used.ring.size()]);
+    const uint16_t slot(used.header.index % used.ring.size());
+    struct vring_used_elem &e(used.ring[slot]);
     e.id = desc->index();
     e.len = len;
     used.header.index += 1;
-    used.write();
+    // Only the new element and the index need to reach the guest
+    used.writeElement(slot);
+    used.writeHeader();
 }
 
 void
@@ -226,6 +226,14 @@ class VirtDescriptor
      */
     VirtDescriptor *next() const;
 
+    /**
+     * Does this descriptor point to a table of indirect descriptors?
+     *
+     * The chain accessors (e.g., chainRead()) transparently follow
+     * the indirect table of such a descriptor.
+     */
+    bool isIndirect() const { return desc.flags & VRING_DESC_F_INDIRECT; }
+
     /** Check if this is a read-only descriptor (incoming data). */
     bool isIncoming() const { return !isOutgoing(); }
     /** Check if this is a write-only descriptor (outgoing data). */
@@ -275,6 +283,17 @@ class VirtDescriptor
     // Prevent copying
     VirtDescriptor(const VirtDescriptor &other);
 
+    /**
+     * Get the first descriptor holding data of the chain starting at
+     * this descriptor, which is the first entry of its indirect table
+     * if it has one.
+     */
+    const VirtDescriptor *chainHead() const;
+    VirtDescriptor *chainHead();
+
+    /** Read the indirect table pointed to by this descriptor. */
+    void updateIndirect();
+
     /** Pointer to memory proxy */
     PortProxy *memProxy;
     /** Pointer to virtqueue owning this descriptor */
@@ -288,6 +307,15 @@ class VirtDescriptor
 
     /** Underlying descriptor */
     vring_desc desc;
+
+    /**
+     * Indirect table this descriptor belongs to, or NULL if it is in
+     * the descriptor table of the virtqueue.
+     */
+    std::vector<VirtDescriptor> *table;
+
+    /** Indirect descriptors pointed to by this descriptor */
+    std::vector<VirtDescriptor> indirect;
 };
 
 /**
@@ -529,6 +557,27 @@ class VirtQueue : public Serializable
                 ring[i] = gtoh(temp[i], byteOrder);
         }
 
+        /** Update a single element of the ring with data from the guest. */
+        void
+        readElement(Index idx)
+        {
+            assert(_base != 0);
+            T temp;
+            _proxy.readBlob(_base + sizeof(header) + sizeof(T) * idx,
+                            &temp, sizeof(T));
+            ring[idx] = gtoh(temp, byteOrder);
+        }
+
+        /** Write a single element of the ring to the guest. */
+        void
+        writeElement(Index idx)
+        {
+            assert(_base != 0);
+            T temp = htog(ring[idx], byteOrder);
+            _proxy.writeBlob(_base + sizeof(header) + sizeof(T) * idx,
+                             &temp, sizeof(T));
+        }
+
         void
         write()
         {
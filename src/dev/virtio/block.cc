@@ -37,6 +37,8 @@
 
 #include "dev/virtio/block.hh"
 
+#include <cstring>
+
 #include "debug/VIOBlock.hh"
 #include "params/VirtIOBlock.hh"
 #include "sim/system.hh"
@@ -45,14 +47,22 @@ namespace gem5
 {
 
 VirtIOBlock::VirtIOBlock(const Params &params)
-    : VirtIODeviceBase(params, ID_BLOCK, sizeof(Config), 0),
-      qRequests(params.system->physProxy, byteOrder,
-                params.queueSize, *this),
+    : VirtIODeviceBase(params, ID_BLOCK, sizeof(Config),
+                       F_INDIRECT_DESC | (params.numQueues > 1 ? F_MQ : 0)),
       image(*params.image)
 {
-    registerQueue(qRequests);
+    fatal_if(params.numQueues == 0, "%s: at least one request queue is "
+             "needed", name());
+
+    for (QueueID i = 0; i < params.numQueues; ++i) {
+        qRequests.emplace_back(new RequestQueue(params.system->physProxy,
+            byteOrder, params.queueSize, *this, i));
+        registerQueue(*qRequests.back());
+    }
 
+    memset(&config, 0, sizeof(config));
     config.capacity = image.size();
+    config.numQueues = params.numQueues;
 }
 
 
@@ -63,8 +73,9 @@ VirtIOBlock::~VirtIOBlock()
 void
 VirtIOBlock::readConfig(PacketPtr pkt, Addr cfgOffset)
 {
-    Config cfg_out;
+    Config cfg_out = config;
     cfg_out.capacity = htog(config.capacity, byteOrder);
+    cfg_out.numQueues = htog(config.numQueues, byteOrder);
 
     readConfigBlob(pkt, cfgOffset, (uint8_t *)&cfg_out);
 }
@@ -82,12 +93,11 @@ VirtIOBlock::read(const BlkRequest &req, VirtDescriptor *desc_chain,
     if (size % SectorSize != 0)
         panic("Unexpected request/sector size relationship\n");
 
-    for (Addr offset = 0; offset < size; offset += SectorSize) {
-        if (image.read(&data[offset], sector) != SectorSize) {
-            warn("Failed to read sector %i\n", sector);
-            return S_IOERR;
-        }
-        ++sector;
+    // Read all the sectors of the request with a single image access
+    const size_t count(size / SectorSize);
+    if (image.readSectors(data.data(), sector, count) != size) {
+        warn("Failed to read sectors %i-%i\n", sector, sector + count - 1);
+        return S_IOERR;
     }
 
     desc_chain->chainWrite(off_data, &data[0], size);
@@ -111,12 +121,10 @@ VirtIOBlock::write(const BlkRequest &req, VirtDescriptor *desc_chain,
 
     desc_chain->chainRead(off_data, &data[0], size);
 
-    for (Addr offset = 0; offset < size; offset += SectorSize) {
-        if (image.write(&data[offset], sector) != SectorSize) {
-            warn("Failed to write sector %i\n", sector);
-            return S_IOERR;
-        }
-        ++sector;
+    const size_t count(size / SectorSize);
+    if (image.writeSectors(data.data(), sector, count) != size) {
+        warn("Failed to write sectors %i-%i\n", sector, sector + count - 1);
+        return S_IOERR;
     }
 
     return S_OK;
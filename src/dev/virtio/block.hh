@@ -38,7 +38,11 @@
 #ifndef __DEV_VIRTIO_BLOCK_HH__
 #define __DEV_VIRTIO_BLOCK_HH__
 
+#include <memory>
+#include <vector>
+
 #include "base/compiler.hh"
+#include "base/cprintf.hh"
 #include "dev/storage/disk_image.hh"
 #include "dev/virtio/base.hh"
 
@@ -88,6 +92,20 @@ class VirtIOBlock : public VirtIODeviceBase
     struct GEM5_PACKED Config
     {
         uint64_t capacity;
+        uint32_t sizeMax;
+        uint32_t segMax;
+        uint16_t cylinders;
+        uint8_t heads;
+        uint8_t sectors;
+        uint32_t blkSize;
+        uint8_t physicalBlockExp;
+        uint8_t alignmentOffset;
+        uint16_t minIoSize;
+        uint32_t optIoSize;
+        uint8_t writeback;
+        uint8_t unused0;
+        /** Number of request queues, valid with F_MQ */
+        uint16_t numQueues;
     };
     Config config;
 
@@ -100,6 +118,9 @@ class VirtIOBlock : public VirtIODeviceBase
     static const FeatureBits F_RO = (1 << 5);
     static const FeatureBits F_BLK_SIZE = (1 << 6);
     static const FeatureBits F_TOPOLOGY = (1 << 10);
+    static const FeatureBits F_MQ = (1 << 12);
+    static const FeatureBits F_INDIRECT_DESC =
+        (1 << VIRTIO_RING_F_INDIRECT_DESC);
     /** @} */
 
     /** @{
@@ -168,20 +189,27 @@ class VirtIOBlock : public VirtIODeviceBase
     {
       public:
         RequestQueue(PortProxy &proxy, ByteOrder bo,
-                uint16_t size, VirtIOBlock &_parent)
-            : VirtQueue(proxy, bo, size), parent(_parent) {}
+                uint16_t size, VirtIOBlock &_parent, QueueID index)
+            : VirtQueue(proxy, bo, size), parent(_parent),
+              _name(index == 0 ? parent.name() + ".qRequests" :
+                    csprintf("%s.qRequests%d", parent.name(), index))
+        {}
         virtual ~RequestQueue() {}
 
         void onNotifyDescriptor(VirtDescriptor *desc);
 
-        std::string name() const { return parent.name() + ".qRequests"; }
+        std::string name() const { return _name; }
 
       protected:
         VirtIOBlock &parent;
+        const std::string _name;
     };
 
-    /** Device I/O request queue */
-    RequestQueue qRequests;
+    /**
+     * Device I/O request queues. The guest may submit requests to any
+     * of them, e.g., one per CPU.
+     */
+    std::vector<std::unique_ptr<RequestQueue>> qRequests;
 
     /** Image backing this device */
     DiskImage &image;
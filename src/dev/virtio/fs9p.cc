@@ -217,7 +217,8 @@ VirtIO9PBase::dumpMsg(const P9MsgHeader &header, const uint8_t *data, size_t siz
 
 
 VirtIO9PProxy::VirtIO9PProxy(const Params &params)
-  : VirtIO9PBase(params), deviceUsed(false)
+  : VirtIO9PBase(params), deviceUsed(false),
+    hostIOThreads(params.hostIOThreads)
 {
 }
 
@@ -264,32 +265,142 @@ VirtIO9PProxy::recvTMsg(const P9MsgHeader &header,
                 buf_size, sizeof(header), size);
     // While technically not needed, we send the packet as one
     // contiguous segment to make some packet dissectors happy.
-    auto buf = static_cast<uint8_t*>(malloc(buf_size));
+    std::vector<uint8_t> buf(buf_size);
     P9MsgHeader header_out(htop9(header));
-    memcpy(buf, &header_out, sizeof(header_out));
-    memcpy(buf + sizeof(header_out), data, size);
-    writeAll(buf, buf_size);
-    free(buf);
+    memcpy(buf.data(), &header_out, sizeof(header_out));
+    memcpy(buf.data() + sizeof(header_out), data, size);
+
+    if (hostIOThreads) {
+        std::lock_guard<std::mutex> lock(hostIOMutex);
+        requests.push_back(std::move(buf));
+        requestsReady.notify_one();
+    } else {
+        writeAll(buf.data(), buf_size);
+    }
 }
 
 void
 VirtIO9PProxy::serverDataReady()
 {
     P9MsgHeader header;
-    readAll((uint8_t *)&header, sizeof(header));
+    panic_if(!readAll((uint8_t *)&header, sizeof(header)),
+             "The 9p server closed the connection.\n");
     header = p9toh(header);
 
     const ssize_t payload_len = header.len - sizeof(header);
     if (payload_len < 0)
         panic("Payload length is negative!\n");
     auto data = std::make_unique<uint8_t[]>(payload_len);
-    readAll(data.get(), payload_len);
+    panic_if(!readAll(data.get(), payload_len),
+             "The 9p server closed the connection.\n");
 
     sendRMsg(header, data.get(), payload_len);
 }
 
+void
+VirtIO9PProxy::startHostIO()
+{
+    panic_if(pipe(replyPipe) == -1, "Failed to create 9p reply pipe: %s",
+             strerror(errno));
+    fcntl(replyPipe[0], F_SETFL, fcntl(replyPipe[0], F_GETFL) | O_NONBLOCK);
+
+    replyEvent.reset(new ReplyEvent(*this, replyPipe[0], POLLIN));
+    pollQueue.schedule(replyEvent.get());
+
+    // The threads live as long as the server, they are blocked on it
+    // when the simulator exits.
+    writerThread = std::thread([this]() { writerMain(); });
+    writerThread.detach();
+    readerThread = std::thread([this]() { readerMain(); });
+    readerThread.detach();
+}
 
 void
+VirtIO9PProxy::writerMain()
+{
+    std::vector<uint8_t> batch;
+    std::unique_lock<std::mutex> lock(hostIOMutex);
+    while (true) {
+        requestsReady.wait(lock, [this]() { return !requests.empty(); });
+
+        batch.clear();
+        for (const auto &msg : requests)
+            batch.insert(batch.end(), msg.begin(), msg.end());
+        requests.clear();
+
+        lock.unlock();
+        writeAll(batch.data(), batch.size());
+        lock.lock();
+    }
+}
+
+void
+VirtIO9PProxy::readerMain()
+{
+    while (true) {
+        P9MsgHeader header;
+        if (!readAll((uint8_t *)&header, sizeof(header)))
+            return;
+
+        const uint32_t len = p9toh(header.len);
+        panic_if(len < sizeof(header), "Payload length is negative!\n");
+        std::vector<uint8_t> msg(len);
+        memcpy(msg.data(), &header, sizeof(header));
+        if (!readAll(msg.data() + sizeof(header), len - sizeof(header)))
+            return;
+
+        bool wake;
+        {
+            std::lock_guard<std::mutex> lock(hostIOMutex);
+            wake = replies.empty();
+            replies.push_back(std::move(msg));
+        }
+
+        // One wake up covers all the replies received before the
+        // simulation takes them.
+        if (wake) {
+            const uint8_t token = 0;
+            while (::write(replyPipe[1], &token, 1) == -1 && errno == EINTR)
+                ;
+        }
+    }
+}
+
+void
+VirtIO9PProxy::deliverReplies()
+{
+    // Replies may arrive while any event queue is running.
+    EventQueue::ScopedMigration migrate(eventQueue());
+
+    // Consume the wake ups before the replies, so that no reply can be
+    // left behind without one.
+    uint8_t tokens[64];
+    while (::read(replyPipe[0], tokens, sizeof(tokens)) > 0)
+        ;
+
+    std::deque<std::vector<uint8_t>> done;
+    {
+        std::lock_guard<std::mutex> lock(hostIOMutex);
+        done.swap(replies);
+    }
+
+    for (const auto &msg : done) {
+        P9MsgHeader header;
+        memcpy(&header, msg.data(), sizeof(header));
+        header = p9toh(header);
+        sendRMsg(header, msg.data() + sizeof(header),
+                 msg.size() - sizeof(header));
+    }
+}
+
+void
+VirtIO9PProxy::ReplyEvent::process(int revent)
+{
+    parent.deliverReplies();
+}
+
+
+bool
 VirtIO9PProxy::readAll(uint8_t *data, size_t len)
 {
     while (len) {
@@ -298,10 +409,14 @@ VirtIO9PProxy::readAll(uint8_t *data, size_t len)
             ;
         if (ret < 0)
             panic("readAll: Read failed: %i\n", -ret);
+        if (ret == 0)
+            return false;
 
         len -= ret;
         data += ret;
     }
+
+    return true;
 }
 
 void
@@ -337,8 +452,12 @@ void
 VirtIO9PDiod::startup()
 {
     startDiod();
-    dataEvent.reset(new DiodDataEvent(*this, fd_from_diod, POLLIN));
-    pollQueue.schedule(dataEvent.get());
+    if (hostIOThreads) {
+        startHostIO();
+    } else {
+        dataEvent.reset(new DiodDataEvent(*this, fd_from_diod, POLLIN));
+        pollQueue.schedule(dataEvent.get());
+    }
 }
 
 void
@@ -490,8 +609,12 @@ void
 VirtIO9PSocket::startup()
 {
     connectSocket();
-    dataEvent.reset(new SocketDataEvent(*this, fdSocket, POLLIN));
-    pollQueue.schedule(dataEvent.get());
+    if (hostIOThreads) {
+        startHostIO();
+    } else {
+        dataEvent.reset(new SocketDataEvent(*this, fdSocket, POLLIN));
+        pollQueue.schedule(dataEvent.get());
+    }
 }
 
 void
@@ -38,9 +38,14 @@
 #ifndef __DEV_VIRTIO_FS9P_HH__
 #define __DEV_VIRTIO_FS9P_HH__
 
+#include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "base/pollevent.hh"
@@ -232,6 +237,13 @@ class VirtIO9PProxy : public VirtIO9PBase
     /** Notification of pending data from server */
     void serverDataReady();
 
+    /**
+     * Start the host threads that exchange messages with the server,
+     * once it is connected. The server data events of the proxies are
+     * not used in that case.
+     */
+    void startHostIO();
+
     /**
      * Read data from the server behind the proxy.
      *
@@ -262,8 +274,9 @@ class VirtIO9PProxy : public VirtIO9PBase
      *
      * @param data Memory location to store results in.
      * @param len Number of bytes to read.
+     * @return False if the server closed the connection, true otherwise.
      */
-    void readAll(uint8_t *data, size_t len);
+    bool readAll(uint8_t *data, size_t len);
     /**
      * Convenience function that writes exactly len bytes.
      *
@@ -286,6 +299,52 @@ class VirtIO9PProxy : public VirtIO9PBase
      * host and guest.
      */
      bool deviceUsed;
+
+    /** Whether messages are exchanged on the host threads */
+    const bool hostIOThreads;
+
+  private:
+    /**
+     * @{
+     * @name Host I/O
+     *
+     * The writer thread sends the queued T messages to the server,
+     * batched into one write, and the reader thread receives R messages
+     * as they complete. The arrival of replies is signalled to the
+     * simulation through a pipe watched by the poll queue, which hands
+     * all the replies received so far to the guest at once.
+     */
+    class ReplyEvent : public PollEvent
+    {
+      public:
+        ReplyEvent(VirtIO9PProxy &_parent, int fd, int event)
+            : PollEvent(fd, event), parent(_parent) {}
+
+        void process(int revent) override;
+
+      private:
+        VirtIO9PProxy &parent;
+    };
+
+    void writerMain();
+    void readerMain();
+    /** Hand the replies received by the reader to the guest. */
+    void deliverReplies();
+
+    std::mutex hostIOMutex;
+    std::condition_variable requestsReady;
+    /** T messages waiting for the writer, in p9 byte order */
+    std::deque<std::vector<uint8_t>> requests;
+    /** R messages received by the reader, in p9 byte order */
+    std::deque<std::vector<uint8_t>> replies;
+
+    /** Pipe the reader wakes up the simulation through */
+    int replyPipe[2] = {-1, -1};
+    std::unique_ptr<ReplyEvent> replyEvent;
+
+    std::thread writerThread;
+    std::thread readerThread;
+    /** @} */
 };
 
 struct VirtIO9PDiodParams;
@@ -94,6 +94,12 @@ class VectorRegisterFile(RegisterFile):
     cxx_class = "gem5::VectorRegisterFile"
     cxx_header = "gpu-compute/vector_register_file.hh"
 
+    num_banks = Param.Int(
+        0,
+        "Number of VRF banks modelled by the operand collector, "
+        "0 disables bank conflict modelling",
+    )
+
 
 class RegisterFileCache(SimObject):
     type = "RegisterFileCache"
@@ -246,6 +252,13 @@ class ComputeUnit(ClockedObject):
     execPolicy = Param.String("OLDEST-FIRST", "WF execution selection policy")
     debugSegFault = Param.Bool(False, "enable debugging GPU seg faults")
     functionalTLB = Param.Bool(False, "Assume TLB causes no delay")
+    functional_backdoor = Param.Bool(
+        False,
+        "When not simulating timing, perform plain vector loads and stores "
+        "directly on the host memory backing the guest physical memory "
+        "instead of through Ruby. Only use this if no cache holds dirty "
+        "data, e.g. in functional-first runs",
+    )
 
     localMemBarrier = Param.Bool(
         False, "Assume Barriers do not wait on kernel end"
@@ -35,6 +35,7 @@
 
 #include "arch/amdgpu/common/gpu_translation_state.hh"
 #include "arch/amdgpu/common/tlb.hh"
+#include "base/intmath.hh"
 #include "base/output.hh"
 #include "debug/GPUDisp.hh"
 #include "debug/GPUExec.hh"
@@ -59,8 +60,10 @@
 #include "gpu-compute/vector_register_file.hh"
 #include "gpu-compute/wavefront.hh"
 #include "mem/page_table.hh"
+#include "mem/physical.hh"
 #include "sim/process.hh"
 #include "sim/sim_exit.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
@@ -99,7 +102,9 @@ ComputeUnit::ComputeUnit(const Params &p) : ClockedObject(p),
     perLaneTLB(p.perLaneTLB), prefetchDepth(p.prefetch_depth),
     prefetchStride(p.prefetch_stride), prefetchType(p.prefetch_prev_type),
     debugSegFault(p.debugSegFault),
-    functionalTLB(p.functionalTLB), localMemBarrier(p.localMemBarrier),
+    functionalTLB(p.functionalTLB),
+    functionalBackdoor(p.functional_backdoor),
+    localMemBarrier(p.localMemBarrier),
     countPages(p.countPages),
     req_tick_latency(p.mem_req_latency * p.clk_domain->clockPeriod()),
     resp_tick_latency(p.mem_resp_latency * p.clk_domain->clockPeriod()),
@@ -223,6 +228,8 @@ ComputeUnit::ComputeUnit(const Params &p) : ClockedObject(p),
     idleWfs = p.n_wf * numVectorALUs;
     lastVaddrWF.resize(numVectorALUs);
     wfList.resize(numVectorALUs);
+    activeWfMask.resize(numVectorALUs,
+                        std::vector<uint64_t>(divCeil(p.n_wf, 64), 0));
 
     wfBarrierSlots.resize(p.num_barrier_slots, WFBarrier());
 
@@ -1404,7 +1411,8 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt)
         new_pkt->dataStatic(pkt->getPtr<uint8_t>());
 
         // Translation is done. It is safe to send the packet to memory.
-        memPort[0].sendFunctional(new_pkt);
+        if (!functionalBackdoorAccess(new_pkt))
+            memPort[0].sendFunctional(new_pkt);
 
         DPRINTF(GPUMem, "Functional sendRequest\n");
         DPRINTF(GPUMem, "CU%d: WF[%d][%d]: index %d: addr %#x\n", cu_id,
@@ -1422,6 +1430,39 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt)
     }
 }
 
+bool
+ComputeUnit::functionalBackdoorAccess(PacketPtr pkt)
+{
+    // Atomics and memory syncs need the full memory system semantics.
+    if (!functionalBackdoor ||
+            (pkt->cmd != MemCmd::ReadReq && pkt->cmd != MemCmd::WriteReq)) {
+        return false;
+    }
+
+    if (backdoorStores.empty()) {
+        auto &phys_mem = shader->gpuTc->getSystemPtr()->getPhysMem();
+        for (const auto &store : phys_mem.getBackingStore())
+            backdoorStores.emplace_back(store.range, store.pmem);
+    }
+
+    const AddrRange range = RangeSize(pkt->getAddr(), pkt->getSize());
+    for (const auto &[store_range, store_pmem] : backdoorStores) {
+        if (!store_pmem || !range.isSubset(store_range))
+            continue;
+
+        uint8_t *host = store_pmem + (range.start() - store_range.start());
+        if (pkt->isRead())
+            pkt->setData(host);
+        else
+            pkt->writeData(host);
+        ++stats.functionalBackdoorAccesses;
+        return true;
+    }
+
+    // Not backed by host memory (e.g. device memory), use Ruby.
+    return false;
+}
+
 void
 ComputeUnit::sendScalarRequest(GPUDynInstPtr gpuDynInst, PacketPtr pkt)
 {
@@ -2528,6 +2569,9 @@ ComputeUnit::ComputeUnitStats::ComputeUnitStats(statistics::Group *parent,
       ADD_STAT(tlbRequests, "number of uncoalesced requests"),
       ADD_STAT(tlbCycles,
                "total number of cycles for all uncoalesced requests"),
+      ADD_STAT(functionalBackdoorAccesses,
+               "number of untimed data accesses done on the memory backing "
+               "store"),
       ADD_STAT(tlbLatency, "Avg. translation latency for data translations"),
       ADD_STAT(hitsPerTLBLevel,
                "TLB hits distribution (0 for page table, x for Lx-TLB)"),
@@ -291,6 +291,19 @@ class ComputeUnit : public ClockedObject
 
     typedef ComputeUnitParams Params;
     std::vector<std::vector<Wavefront*>> wfList;
+    /**
+     * Per SIMD bitmaps of the WF slots whose wavefront is not stopped,
+     * maintained by the wavefronts on every status change. The pipeline
+     * stages scan these instead of every WF slot.
+     */
+    std::vector<std::vector<uint64_t>> activeWfMask;
+    void
+    setWfActive(int simd_id, int wf_slot, bool active)
+    {
+        uint64_t &word = activeWfMask[simd_id][wf_slot / 64];
+        const uint64_t bit = 1ULL << (wf_slot % 64);
+        word = active ? (word | bit) : (word & ~bit);
+    }
     int cu_id;
 
     // array of vector register files, one per SIMD
@@ -349,6 +362,13 @@ class ComputeUnit : public ClockedObject
     Tick idleCUTimeout;
     int idleWfs;
     bool functionalTLB;
+    /**
+     * Service untimed vector memory accesses through the host memory
+     * backing the guest physical memory rather than Ruby.
+     */
+    bool functionalBackdoor;
+    /** Guest physical ranges and the host memory backing them */
+    std::vector<std::pair<AddrRange, uint8_t *>> backdoorStores;
     bool localMemBarrier;
 
     /*
@@ -467,6 +487,13 @@ class ComputeUnit : public ClockedObject
 
     virtual void init() override;
     void sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt);
+    /**
+     * Try to perform an untimed, translated data access directly on the
+     * memory backing store, without going through Ruby.
+     *
+     * @return true if the access was performed.
+     */
+    bool functionalBackdoorAccess(PacketPtr pkt);
     void sendScalarRequest(GPUDynInstPtr gpuDynInst, PacketPtr pkt);
     void injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
                               bool kernelMemSync,
@@ -1121,6 +1148,8 @@ class ComputeUnit : public ClockedObject
         // uncoalesced request (only for data)
         statistics::Scalar tlbRequests;
         statistics::Scalar tlbCycles;
+        // untimed data accesses done directly on the memory backing store
+        statistics::Scalar functionalBackdoorAccesses;
         statistics::Formula tlbLatency;
         // hitsPerTLBLevel[x] are the hits in Level x TLB.
         // x = 0 is the page table.
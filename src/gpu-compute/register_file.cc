@@ -198,6 +198,16 @@ RegisterFile::RegisterFileStats::RegisterFileStats(statistics::Group *parent)
               "Total number of DWORDs read from register file cache"),
       ADD_STAT(rfc_cache_write_hits,
               "Total number of writes to existing registers in the rfc"),
+      ADD_STAT(rfcOperandReads,
+              "Number of source registers looked up in the rfc"),
+      ADD_STAT(rfcOperandHits,
+              "Number of source registers found in the rfc"),
+      ADD_STAT(rfcHitRate,
+              "Fraction of source registers found in the rfc"),
+      ADD_STAT(bankConflicts,
+              "Number of operand reads delayed by a register bank conflict"),
+      ADD_STAT(bankConflictCycles,
+              "Total cycles added to operand collection by bank conflicts"),
       ADD_STAT(registerWrites,
               "Total number of DWORDS written to register file"),
       ADD_STAT(sramReads,
@@ -205,6 +215,7 @@ RegisterFile::RegisterFileStats::RegisterFileStats(statistics::Group *parent)
       ADD_STAT(sramWrites,
               "Total number of register file bank SRAM activations for writes")
 {
+    rfcHitRate = rfcOperandHits / rfcOperandReads;
 }
 
 } // namespace gem5
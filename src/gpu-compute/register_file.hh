@@ -162,6 +162,17 @@ class RegisterFile : public SimObject
         statistics::Scalar rfc_cache_read_hits;
         statistics::Scalar rfc_cache_write_hits;
 
+        // Number of unique source registers looked up in the rfc when
+        // scheduling operand reads, and how many of them hit
+        statistics::Scalar rfcOperandReads;
+        statistics::Scalar rfcOperandHits;
+        statistics::Formula rfcHitRate;
+
+        // Number of operand reads delayed by a busy bank, and the
+        // total number of cycles added to operand collection
+        statistics::Scalar bankConflicts;
+        statistics::Scalar bankConflictCycles;
+
         // Total number of register writes per DWORD per thread
         statistics::Scalar registerWrites;
 
@@ -31,6 +31,7 @@
 
 #include "gpu-compute/scoreboard_check_stage.hh"
 
+#include "base/bitfield.hh"
 #include "debug/GPUExec.hh"
 #include "debug/GPUSched.hh"
 #include "debug/GPUSync.hh"
@@ -161,8 +162,12 @@ ScoreboardCheckStage::ready(Wavefront *w, nonrdytype_e *rdyStatus,
 
     DPRINTF(GPUExec, "CU%d: WF[%d][%d]: Checking Ready for Inst : %s\n",
             computeUnit.cu_id, w->simdId, w->wfSlotId, ii->disassemble());
-    w->lastInstSeqNum = ii->seqNum();
-    w->lastInstDisasm = ii->disassemble();
+    // A wave may be checked for the same instruction over many cycles,
+    // only copy its disassembly once.
+    if (w->lastInstSeqNum != ii->seqNum()) {
+        w->lastInstSeqNum = ii->seqNum();
+        w->lastInstDisasm = ii->disassemble();
+    }
 
     // Non-scalar (i.e., vector) instructions may use VGPRs
     if (!ii->isScalar()) {
@@ -269,6 +274,29 @@ ScoreboardCheckStage::mapWaveToExeUnit(Wavefront *w)
     return computeUnit.numExeUnits();
 }
 
+void
+ScoreboardCheckStage::checkWave(Wavefront *curWave, int wfSlot)
+{
+    assert(curWave->getStatus() != Wavefront::S_STOPPED);
+    nonrdytype_e rdyStatus = NRDY_ILLEGAL;
+    int exeResType = -1;
+    // check WF readiness: If the WF's oldest
+    // instruction is ready to issue then add the WF to the ready list
+    if (ready(curWave, &rdyStatus, &exeResType, wfSlot)) {
+        curWave->lastInstRdyStatus = rdyStatusStr(rdyStatus);
+        DPRINTF(GPUSched,
+                "Adding to readyList[%d]: SIMD[%d] WV[%d]: %d: %s\n",
+                exeResType,
+                curWave->simdId, curWave->wfDynId,
+                curWave->nextInstr()->seqNum(),
+                curWave->nextInstr()->disassemble());
+        toSchedule.markWFReady(curWave, exeResType);
+    } else {
+        curWave->lastInstRdyStatus = rdyStatusStr(rdyStatus);
+    }
+    collectStatistics(rdyStatus);
+}
+
 void
 ScoreboardCheckStage::exec()
 {
@@ -278,30 +306,24 @@ ScoreboardCheckStage::exec()
      */
     toSchedule.reset();
 
-    // Iterate over all WF slots across all SIMDs.
+    // Iterate over the WF slots holding a wavefront across all SIMDs, in
+    // slot order.
     for (int simdId = 0; simdId < computeUnit.numVectorALUs; ++simdId) {
-        for (int wfSlot = 0; wfSlot < computeUnit.shader->n_wf; ++wfSlot) {
-            // reset the ready status of each wavefront
-            Wavefront *curWave = computeUnit.wfList[simdId][wfSlot];
-            nonrdytype_e rdyStatus = NRDY_ILLEGAL;
-            int exeResType = -1;
-            // check WF readiness: If the WF's oldest
-            // instruction is ready to issue then add the WF to the ready list
-            if (ready(curWave, &rdyStatus, &exeResType, wfSlot)) {
-                curWave->lastInstRdyStatus = rdyStatusStr(rdyStatus);
+        int num_checked = 0;
+        const auto &mask = computeUnit.activeWfMask[simdId];
+        for (int word = 0; word < mask.size(); ++word) {
+            for (uint64_t bits = mask[word]; bits; bits &= bits - 1) {
+                const int wfSlot = word * 64 + findLsbSet(bits);
+                Wavefront *curWave = computeUnit.wfList[simdId][wfSlot];
                 assert(curWave->simdId == simdId);
-                DPRINTF(GPUSched,
-                        "Adding to readyList[%d]: SIMD[%d] WV[%d]: %d: %s\n",
-                        exeResType,
-                        curWave->simdId, curWave->wfDynId,
-                        curWave->nextInstr()->seqNum(),
-                        curWave->nextInstr()->disassemble());
-                toSchedule.markWFReady(curWave, exeResType);
-            } else {
-                curWave->lastInstRdyStatus = rdyStatusStr(rdyStatus);
+                checkWave(curWave, wfSlot);
+                ++num_checked;
             }
-            collectStatistics(rdyStatus);
         }
+        // Stopped wavefronts are never ready, account for all of them at
+        // once.
+        stats.stallCycles[NRDY_WF_STOP] +=
+            computeUnit.shader->n_wf - num_checked;
     }
 }
 
@@ -89,6 +89,8 @@ class ScoreboardCheckStage
     int mapWaveToExeUnit(Wavefront *w);
     bool ready(Wavefront *w, nonrdytype_e *rdyStatus,
                int *exeResType, int wfSlot);
+    /** Check one wavefront and add it to the ready list if it is ready */
+    void checkWave(Wavefront *w, int wfSlot);
     ComputeUnit &computeUnit;
 
     /**
@@ -100,7 +102,7 @@ class ScoreboardCheckStage
 
     const std::string _name;
 
-    std::string rdyStatusStr(const nonrdytype_e& rdyStatus) {
+    const char *rdyStatusStr(const nonrdytype_e& rdyStatus) {
         switch (rdyStatus) {
             case NRDY_ILLEGAL: return "NRDY_ILLEGAL";
             case NRDY_WF_STOP: return "NRDY_WF_STOP";
@@ -31,6 +31,7 @@
 
 #include "gpu-compute/vector_register_file.hh"
 
+#include <algorithm>
 #include <string>
 
 #include "base/logging.hh"
@@ -47,9 +48,12 @@ namespace gem5
 {
 
 VectorRegisterFile::VectorRegisterFile(const VectorRegisterFileParams &p)
-    : RegisterFile(p)
+    : RegisterFile(p), numBanks(p.num_banks)
 {
+    fatal_if(numBanks < 0, "Illegal number of VRF banks: %d", numBanks);
+
     regFile.resize(numRegs());
+    bankFreeCycle.resize(numBanks, Cycles(0));
 
     for (auto &reg : regFile) {
         reg.zero();
@@ -95,6 +99,64 @@ VectorRegisterFile::operandsReady(Wavefront *w, GPUDynInstPtr ii) const
     return src_ready && dst_ready;
 }
 
+void
+VectorRegisterFile::scheduleReadOperands(Wavefront *w, GPUDynInstPtr ii)
+{
+    srcRegs.clear();
+    for (const auto& srcVecOp : ii->srcVecRegOperands()) {
+        for (const auto& physIdx : srcVecOp.physIndices()) {
+            srcRegs.push_back(physIdx);
+        }
+    }
+    // A register named by several operands is only read once
+    std::sort(srcRegs.begin(), srcRegs.end());
+    srcRegs.erase(std::unique(srcRegs.begin(), srcRegs.end()),
+                  srcRegs.end());
+
+    Cycles now = computeUnit->curCycle();
+    Cycles ready = now;
+    for (const auto& physIdx : srcRegs) {
+        stats.rfcOperandReads++;
+        if (computeUnit->rfc[simdId]->inRFC(physIdx)) {
+            stats.rfcOperandHits++;
+            continue;
+        }
+        if (numBanks == 0) {
+            continue;
+        }
+
+        Cycles &bank_free = bankFreeCycle[physIdx % numBanks];
+        Cycles slot = std::max(now, bank_free);
+        if (slot > now) {
+            stats.bankConflicts++;
+        }
+        bank_free = slot + Cycles(1);
+        ready = std::max(ready, slot);
+    }
+
+    if (ready > now) {
+        DPRINTF(GPUVRF, "WV[%d]: %s: operands collected in %d cycles due "
+                "to bank conflicts\n", w->wfDynId, ii->disassemble(),
+                (int)(ready - now));
+        stats.bankConflictCycles += ready - now;
+        operandReadyCycle[ii->seqNum()] = ready;
+    }
+}
+
+bool
+VectorRegisterFile::operandReadComplete(Wavefront *w, GPUDynInstPtr ii)
+{
+    auto it = operandReadyCycle.find(ii->seqNum());
+    return it == operandReadyCycle.end() ||
+        computeUnit->curCycle() >= it->second;
+}
+
+void
+VectorRegisterFile::dispatchInstruction(GPUDynInstPtr ii)
+{
+    operandReadyCycle.erase(ii->seqNum());
+}
+
 void
 VectorRegisterFile::scheduleWriteOperands(Wavefront *w, GPUDynInstPtr ii)
 {
@@ -32,6 +32,9 @@
 #ifndef __VECTOR_REGISTER_FILE_HH__
 #define __VECTOR_REGISTER_FILE_HH__
 
+#include <unordered_map>
+#include <vector>
+
 #include "arch/gpu_isa.hh"
 #include "config/the_gpu_isa.hh"
 #include "debug/GPUTrace.hh"
@@ -54,11 +57,16 @@ class VectorRegisterFile : public RegisterFile
     ~VectorRegisterFile() { }
 
     virtual bool operandsReady(Wavefront *w, GPUDynInstPtr ii) const override;
+    virtual void scheduleReadOperands(Wavefront *w,
+                                      GPUDynInstPtr ii) override;
+    virtual bool operandReadComplete(Wavefront *w,
+                                     GPUDynInstPtr ii) override;
     virtual void scheduleWriteOperands(Wavefront *w,
                                        GPUDynInstPtr ii) override;
     virtual void scheduleWriteOperandsFromLoad(Wavefront *w,
                                                GPUDynInstPtr ii) override;
     virtual void waveExecuteInst(Wavefront *w, GPUDynInstPtr ii) override;
+    virtual void dispatchInstruction(GPUDynInstPtr ii) override;
 
     void
     setParent(ComputeUnit *_computeUnit) override
@@ -109,6 +117,20 @@ class VectorRegisterFile : public RegisterFile
 
   private:
     std::vector<VecRegContainer> regFile;
+
+    // Operand collector model. Source registers that miss in the RFC
+    // are read from bank (physIdx % numBanks), one read per bank per
+    // cycle. The cycle in which the last operand is collected is
+    // computed once when the reads are scheduled, so no per-operand
+    // events are needed. A numBanks of 0 disables the model.
+    int numBanks;
+    // First cycle in which each bank can accept a new read
+    std::vector<Cycles> bankFreeCycle;
+    // Cycle in which the operands of each scheduled instruction
+    // have been collected, keyed by instruction sequence number
+    std::unordered_map<InstSeqNum, Cycles> operandReadyCycle;
+    // Scratch space used to collect unique source registers
+    std::vector<int> srcRegs;
 };
 
 } // namespace gem5
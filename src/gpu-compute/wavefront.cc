@@ -629,6 +629,8 @@ Wavefront::setStatus(status_e newStatus)
             assert(computeUnit->idleWfs >= 0);
         }
     }
+    if ((status == S_STOPPED) != (newStatus == S_STOPPED))
+        computeUnit->setWfActive(simdId, wfSlotId, newStatus != S_STOPPED);
     status = newStatus;
 }
 
@@ -638,6 +640,8 @@ Wavefront::start(uint64_t _wf_dyn_id, Addr init_pc)
     wfDynId = _wf_dyn_id;
     _pc = init_pc;
 
+    if (status == S_STOPPED)
+        computeUnit->setWfActive(simdId, wfSlotId, true);
     status = S_RUNNING;
 
     vecReads.resize(maxVgprs, 0);
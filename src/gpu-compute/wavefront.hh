@@ -326,7 +326,7 @@ class Wavefront : public SimObject
     // Tracking variables for periodic progress
     InstSeqNum lastInstSeqNum;
     std::string lastInstDisasm;
-    std::string lastInstRdyStatus;
+    const char *lastInstRdyStatus = "";
     bool lastVrfStatus, lastSrfStatus;
 
   private:
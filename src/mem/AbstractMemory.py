@@ -64,6 +64,13 @@ class AbstractMemory(ClockedObject):
     # are not accessible by the CPU.
     kvm_map = Param.Bool(True, "Should KVM map this memory for the guest")
 
+    # On hosts with several NUMA nodes, the backing store is best placed
+    # on the node of the host CPU that the simulator thread running this
+    # memory's event queue is pinned to, see Root.sim_thread_cpus.
+    host_numa_node = Param.Int(
+        -1, "Host NUMA node to place the backing store on (-1: any)"
+    )
+
     # Should the bootloader include this memory when passing
     # configuration information about the physical memory layout to
     # the kernel, e.g. using ATAG or ACPI
@@ -0,0 +1,53 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.DRAMInterface import DRAMInterface
+from m5.params import *
+
+
+class AnalyticalDRAMInterface(DRAMInterface):
+    """Fast DRAM model for design-space exploration
+
+    Takes the same parameters as DRAMInterface, but instead of modelling
+    the timing of every bank and the refresh and power state machines of
+    every rank, only tracks the open row of each bank. Bank parallelism
+    is modelled as an average activation rate, and refresh as a loss of
+    bandwidth and a mean extra latency. Power is not modelled.
+
+    An existing DRAM configuration can be turned into an analytical one
+    with analytical_dram(), e.g. analytical_dram(DDR4_2400_16x4()).
+    """
+
+    type = "AnalyticalDRAMInterface"
+    cxx_header = "mem/analytical_dram_interface.hh"
+    cxx_class = "gem5::memory::AnalyticalDRAMInterface"
+
+
+def analytical_dram(interface):
+    """Create an AnalyticalDRAMInterface with the parameter values of a
+    DRAMInterface instance."""
+    fast = AnalyticalDRAMInterface()
+    for name in interface._params:
+        if name in interface._values:
+            setattr(fast, name, interface._values[name])
+    return fast
@@ -115,3 +115,7 @@ class CommMonitor(SimObject):
     read_addr_mask = Param.Addr(MaxAddr, "Address mask for read address")
     write_addr_mask = Param.Addr(MaxAddr, "Address mask for write address")
     disable_addr_dists = Param.Bool(True, "Disable address distributions")
+
+    # per-requestor traffic, latency distributions (log-linear buckets
+    # of fixed size) and peak bandwidth per sample period
+    per_requestor_stats = Param.Bool(False, "Enable per-requestor stats")
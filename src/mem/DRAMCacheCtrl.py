@@ -0,0 +1,45 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.MemCtrl import *
+from m5.params import *
+from m5.proxy import *
+
+
+# DRAMCacheCtrl uses its dram interface as a direct-mapped cache of
+# the far memory connected to its far_port. It only models timing, so
+# the dram interface should set null = True and in_addr_map = False.
+class DRAMCacheCtrl(MemCtrl):
+    type = "DRAMCacheCtrl"
+    cxx_header = "mem/dram_cache_ctrl.hh"
+    cxx_class = "gem5::memory::DRAMCacheCtrl"
+
+    far_port = RequestPort("Port to the far memory")
+
+    range = Param.AddrRange("Address range cached, held by the far memory")
+    block_size = Param.Unsigned(64, "Size of a block of the cache")
+    predictor_entries = Param.Unsigned(
+        256,
+        "Number of entries of the miss predictor, 0 to always wait for "
+        "the tag check before reading the far memory",
+    )
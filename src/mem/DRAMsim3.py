@@ -56,6 +56,13 @@ class DRAMsim3(AbstractMemory):
     filePath = Param.String(
         "ext/dramsim3/DRAMsim3/", "Directory to prepend to file names"
     )
+    batch_cycles = Param.Unsigned(
+        1,
+        "Maximum number of DRAMsim3 cycles to simulate per event. With "
+        "more than one cycle, DRAMsim3 runs ahead of gem5 until its next "
+        "event or the next completion, and is not clocked at all while "
+        "it has no transactions",
+    )
 
 
 add_citation(
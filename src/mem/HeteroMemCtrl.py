@@ -54,3 +54,32 @@ class HeteroMemCtrl(MemCtrl):
     # The dram interface `dram` used by HeteroMemCtrl is defined in
     # the MemCtrl
     nvm = Param.NVMInterface("NVM memory interface to use")
+
+    # Page migration between the interfaces, disabled by default
+    migration_interval = Param.Latency(
+        "0ns", "Interval between migration decisions, 0 to disable"
+    )
+    page_size = Param.MemorySize("4KiB", "Granularity of page migration")
+    migration_bandwidth = Param.MemoryBandwidth(
+        "4GiB/s", "Bandwidth of the engine copying migrated pages"
+    )
+    hot_threshold = Param.Unsigned(
+        8,
+        "Sampled accesses in an interval after which an NVM page is "
+        "considered for migration",
+    )
+    max_migrations = Param.Unsigned(
+        16, "Maximum number of page swaps started per interval"
+    )
+    sample_interval = Param.Unsigned(
+        1, "Count one in this many accesses to track hot pages"
+    )
+    sketch_width = Param.Unsigned(
+        4096, "Counters per row of the page access sketch, a power of 2"
+    )
+    sketch_depth = Param.Unsigned(
+        4, "Rows of the page access sketch, at most 8"
+    )
+    victim_samples = Param.Unsigned(
+        8, "DRAM pages sampled when looking for a page to demote"
+    )
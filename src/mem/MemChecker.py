@@ -43,6 +43,14 @@ class MemChecker(SimObject):
     cxx_header = "mem/mem_checker.hh"
     cxx_class = "gem5::MemChecker"
 
+    line_size = Param.Unsigned(64, "Size of the lines bytes are tracked in")
+    prune_interval = Param.Latency(
+        "0ns", "Minimum time between prunings of completed transactions"
+    )
+    sample_period = Param.Unsigned(
+        1, "Only check one line out of this many"
+    )
+
 
 class MemCheckerMonitor(SimObject):
     type = "MemCheckerMonitor"
@@ -89,6 +89,12 @@ class MemCtrl(QoSMemCtrl):
         16, "Minimum read bursts before switching to writes"
     )
 
+    # issue the bursts of a split read that go to the same row in one
+    # scheduling decision, rather than one scheduling event per burst
+    coalesce_bursts = Param.Bool(
+        False, "Issue same-row bursts of a split read back to back"
+    )
+
     # scheduler, address map and page policy
     mem_sched_policy = Param.MemSched("frfcfs", "Memory scheduling policy")
 
@@ -78,3 +78,16 @@ class SerialLink(ClockedObject):
         "Gb/s Speed of each parallel lane inside the"
         "serial link. (aka. lane speed)",
     )
+    # A non-zero FLIT size packetizes the link: packets are framed into
+    # FLITs that are serialized back to back on each direction of the link
+    flit_size = Param.Unsigned(
+        0, "Size of a FLIT in bytes, or 0 to not packetize the link"
+    )
+    flit_overhead = Param.Unsigned(
+        1, "FLITs of header and tail in each packet on a packetized link"
+    )
+    credits = Param.Unsigned(
+        0,
+        "FLITs of request buffering at the receiving end of a packetized "
+        "link, which requests are sent against as credits (0 is unlimited)",
+    )
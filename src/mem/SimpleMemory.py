@@ -53,6 +53,15 @@ class SimpleMemory(AbstractMemory):
     bandwidth = Param.MemoryBandwidth(
         "12.8GiB/s", "Combined read and write bandwidth"
     )
+    # Rather than holding off requests until the previous one has been
+    # transferred, the token bucket accepts requests as long as no more
+    # than burst_size bytes are waiting for the data path, and computes
+    # the response tick on arrival. Atomic accesses are charged the
+    # same queueing delay.
+    token_bucket = Param.Bool(False, "Use a token-bucket bandwidth model")
+    burst_size = Param.MemorySize(
+        "1KiB", "Bytes the token bucket accepts ahead of the data path"
+    )
 
     def controller(self):
         # Simple memory doesn't use a MemCtrl
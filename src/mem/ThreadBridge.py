@@ -39,8 +39,11 @@ class ThreadBridge(SimObject):
     the issue. The receiver side is expected to use the same EventQueue that
     the ThreadBridge is using.
 
-    Given that this is only used for simulation speed accelerating, only the
-    atomic and functional access are supported.
+    Atomic and functional accesses migrate to the EventQueue of the
+    ThreadBridge for the duration of the access. Timing requests and
+    responses are buffered and delivered on the other side's EventQueue
+    after the bridge delay, which is never shorter than the simulation
+    quantum so that the crossing is safe when the queues run in parallel.
 
     Example:
 
@@ -50,6 +53,15 @@ class ThreadBridge(SimObject):
 
     sys.initator.out_port = sys.bridge.in_port
     sys.bridge.out_port = sys.target.in_port
+
+    A multi-channel memory can run every channel on its own EventQueue by
+    putting a bridge between the address interleaver and each channel:
+
+    for i, ctrl in enumerate(mem_ctrls):
+        ctrl.eventq_index = i + 1
+        bridge = ThreadBridge(eventq_index=i + 1)
+        membus.mem_side_ports = bridge.in_port
+        bridge.out_port = ctrl.port
     """
 
     type = "ThreadBridge"
@@ -58,3 +70,9 @@ class ThreadBridge(SimObject):
 
     in_port = ResponsePort("Incoming port")
     out_port = RequestPort("Outgoing port")
+
+    req_size = Param.Unsigned(16, "The number of timing requests to buffer")
+    delay = Param.Latency(
+        "0ns",
+        "The latency of a timing crossing, at least the simulation quantum",
+    )
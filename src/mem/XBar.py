@@ -154,6 +154,12 @@ class SnoopFilter(SimObject):
     # Sanity check on max capacity to track, adjust if needed.
     max_capacity = Param.MemorySize("8MiB", "Maximum capacity of snoop filter")
 
+    # Instead of treating an overflow of the capacity as an error, make
+    # room by cleaning and invalidating a tracked line in the caches above.
+    back_invalidate = Param.Bool(
+        False, "Back-invalidate lines when the snoop filter is full"
+    )
+
 
 # We use a coherent crossbar to connect multiple requestors to the L2
 # caches. Normally this crossbar would be part of the cache itself.
@@ -63,7 +63,8 @@ AbstractMemory::AbstractMemory(const Params &p) :
                  MemBackdoor::Readable | MemBackdoor::Writeable :
                  MemBackdoor::Readable)),
     confTableReported(p.conf_table_reported), inAddrMap(p.in_addr_map),
-    kvmMap(p.kvm_map), writeable(p.writeable), collectStats(p.collect_stats),
+    kvmMap(p.kvm_map), hostNumaNode(p.host_numa_node),
+    writeable(p.writeable), collectStats(p.collect_stats),
     _system(NULL), stats(*this)
 {
     panic_if(!range.valid() || !range.size(),
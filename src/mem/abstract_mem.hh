@@ -129,6 +129,9 @@ class AbstractMemory : public ClockedObject
     // Should KVM map this memory for the guest
     const bool kvmMap;
 
+    // Host NUMA node for the backing store, or -1 for any
+    const int hostNumaNode;
+
     // Are writes allowed to this memory
     const bool writeable;
 
@@ -341,6 +344,13 @@ class AbstractMemory : public ClockedObject
      */
     bool isKvmMap() const { return kvmMap; }
 
+    /**
+     * Host NUMA node the backing store of this memory should be on.
+     *
+     * @return the node, or -1 if it can be on any node
+     */
+    int getHostNumaNode() const { return hostNumaNode; }
+
     /**
      * Perform an untimed memory access and update all the state
      * (e.g. locked addresses) and statistics accordingly. The packet
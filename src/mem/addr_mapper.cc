@@ -138,7 +138,7 @@ AddrMapper::recvTimingReq(PacketPtr pkt)
     bool cacheResponding = pkt->cacheResponding();
 
     if (needsResponse && !cacheResponding) {
-        pkt->pushSenderState(new AddrMapperSenderState(orig_addr));
+        pkt->emplaceSenderState<AddrMapperSenderState>(orig_addr);
     }
 
     pkt->setAddr(remapAddr(orig_addr));
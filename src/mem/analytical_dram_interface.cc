@@ -0,0 +1,312 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/analytical_dram_interface.hh"
+
+#include <algorithm>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/DRAM.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+AnalyticalDRAMInterface::AnalyticalDRAMInterface(
+        const AnalyticalDRAMInterfaceParams &_p)
+    : MemInterface(_p),
+      tRL(_p.tCL), tWL(_p.tCWL),
+      tRCD_RD(_p.tRCD), tRCD_WR(_p.tRCD_WR), tRP(_p.tRP),
+      actInterval(std::max({_p.tRRD, _p.tXAW / _p.activation_limit,
+                            (_p.tRAS + _p.tRP) /
+                            (_p.banks_per_rank * _p.ranks_per_channel)})),
+      burstGap(tBURST * _p.tREFI / (_p.tREFI - _p.tRFC)),
+      refreshWait(_p.tRFC * _p.tRFC / (2 * _p.tREFI)),
+      pageMgmt(_p.page_policy),
+      maxAccessesPerRow(_p.max_accesses_per_row),
+      openRows(_p.banks_per_rank * _p.ranks_per_channel, Bank::NO_ROW),
+      rowAccesses(_p.banks_per_rank * _p.ranks_per_channel, 0),
+      stats(*this)
+{
+    fatal_if(!isPowerOf2(burstSize), "DRAM burst size %d is not allowed, "
+             "must be a power of two\n", burstSize);
+    fatal_if(!isPowerOf2(ranksPerChannel), "DRAM rank count of %d is "
+             "not allowed, must be a power of two\n", ranksPerChannel);
+    fatal_if(_p.tREFI <= _p.tRP || _p.tREFI <= _p.tRFC,
+             "tREFI (%d) must be larger than tRP (%d) and tRFC (%d)\n",
+             _p.tREFI, _p.tRP, _p.tRFC);
+
+    uint64_t capacity = 1ULL << ceilLog2(AbstractMemory::size());
+    rowsPerBank = capacity / (rowBufferSize * banksPerRank * ranksPerChannel);
+}
+
+MemPacket *
+AnalyticalDRAMInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
+                                      unsigned size, bool is_read,
+                                      uint8_t pseudo_channel)
+{
+    // decode the address based on the address mapping scheme, with
+    // Ro, Ra, Co, Ba and Ch denoting row, rank, column, bank and
+    // channel, respectively, in the same way as DRAMInterface
+    uint8_t rank;
+    uint8_t bank;
+    uint64_t row;
+
+    // Get packed address, starting at 0, truncated to a memory burst
+    Addr addr = getCtrlAddr(pkt_addr) / burstSize;
+
+    if (addrMapping == enums::RoRaBaChCo || addrMapping == enums::RoRaBaCoCh) {
+        addr = addr / burstsPerRowBuffer;
+
+        bank = addr % banksPerRank;
+        addr = addr / banksPerRank;
+
+        rank = addr % ranksPerChannel;
+        addr = addr / ranksPerChannel;
+
+        row = addr % rowsPerBank;
+    } else if (addrMapping == enums::RoCoRaBaCh) {
+        if (burstsPerStripe > burstsPerRowBuffer)
+            addr = addr / burstsPerRowBuffer;
+        else
+            addr = addr / burstsPerStripe;
+
+        bank = addr % banksPerRank;
+        addr = addr / banksPerRank;
+
+        rank = addr % ranksPerChannel;
+        addr = addr / ranksPerChannel;
+
+        if (burstsPerStripe < burstsPerRowBuffer)
+            addr = addr / (burstsPerRowBuffer / burstsPerStripe);
+
+        row = addr % rowsPerBank;
+    } else {
+        panic("Unknown address mapping policy chosen!");
+    }
+
+    assert(rank < ranksPerChannel);
+    assert(bank < banksPerRank);
+    assert(row < Bank::NO_ROW);
+
+    DPRINTF(DRAM, "Address: %#x Rank %d Bank %d Row %d\n",
+            pkt_addr, rank, bank, row);
+
+    uint16_t bank_id = banksPerRank * rank + bank;
+
+    return new MemPacket(pkt, is_read, true, pseudo_channel, rank, bank, row,
+                         bank_id, pkt_addr, size);
+}
+
+std::pair<MemPacketQueue::iterator, Tick>
+AnalyticalDRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue,
+                                          Tick min_col_at) const
+{
+    const MemPacketQueue::Entry *selected = nullptr;
+    for (int i = 0; i < ranksPerChannel; i++) {
+        for (int j = 0; j < banksPerRank; j++) {
+            const auto *bank_queue =
+                queue.bankQueue(true, pseudoChannel, i, j);
+            if (!bank_queue)
+                continue;
+            const auto *hit =
+                bank_queue->oldest(openRows[i * banksPerRank + j]);
+            if (hit && (!selected || hit->order < selected->order))
+                selected = hit;
+        }
+    }
+
+    if (selected)
+        return std::make_pair(queue.find(*selected), min_col_at);
+
+    for (auto i = queue.begin(); i != queue.end(); ++i) {
+        if ((*i)->isDram() && (*i)->pseudoChannel == pseudoChannel)
+            return std::make_pair(i, min_col_at + commandOffset());
+    }
+
+    DPRINTF(DRAM, "%s no DRAM packets found\n", __func__);
+    return std::make_pair(queue.end(), MaxTick);
+}
+
+std::pair<Tick, Tick>
+AnalyticalDRAMInterface::doBurstAccess(MemPacket *mem_pkt,
+                                       Tick next_burst_at,
+                                       const std::vector<MemPacketQueue>&
+                                           queue)
+{
+    const size_t bank = bankIndex(mem_pkt);
+    const bool is_read = mem_pkt->isRead();
+    const bool row_hit = openRows[bank] == mem_pkt->row;
+
+    // the data bus serves one burst at a time, with a turnaround when
+    // the direction or the rank changes
+    Tick cmd_at = std::max({next_burst_at, curTick(), rankDelayUntil});
+    if (is_read != lastWasRead) {
+        cmd_at = std::max(cmd_at, lastBurstAt + (is_read ?
+                          writeToReadDelay() : readToWriteDelay()));
+    } else if (mem_pkt->rank != lastRank) {
+        cmd_at = std::max(cmd_at, lastBurstAt + rankToRankDelay());
+    }
+
+    if (!row_hit) {
+        // a row miss needs an activation, after closing any open row,
+        // activations are limited to the rate all banks can sustain
+        const Tick pre_done_at = curTick() +
+            (openRows[bank] == Bank::NO_ROW ? 0 : tRP);
+        const Tick act_at = std::max(pre_done_at, nextActAt);
+        nextActAt = act_at + actInterval;
+        cmd_at = std::max(cmd_at, act_at + (is_read ? tRCD_RD : tRCD_WR));
+
+        openRows[bank] = mem_pkt->row;
+        rowAccesses[bank] = 0;
+        ++stats.activations;
+    }
+    ++rowAccesses[bank];
+
+    mem_pkt->readyTime = cmd_at + (is_read ? tRL : tWL) + tBURST +
+        refreshWait;
+
+    DPRINTF(DRAM, "Analytical access to addr %#x, rank/bank/row %d %d %d, "
+            "%s, ready at %d\n", mem_pkt->addr, mem_pkt->rank,
+            mem_pkt->bank, mem_pkt->row, row_hit ? "hit" : "miss",
+            mem_pkt->readyTime);
+
+    // close the row as the page policy asks, deciding on the adaptive
+    // policies from the row hits and conflicts still queued
+    bool auto_precharge = pageMgmt == enums::close ||
+        rowAccesses[bank] == maxAccessesPerRow;
+    if (!auto_precharge && (pageMgmt == enums::open_adaptive ||
+                            pageMgmt == enums::close_adaptive)) {
+        bool got_more_hits = false;
+        bool got_bank_conflict = false;
+        for (const auto &prio_queue : queue) {
+            const auto *bank_queue = prio_queue.bankQueue(
+                true, pseudoChannel, mem_pkt->rank, mem_pkt->bank);
+            if (!bank_queue)
+                continue;
+            got_more_hits |= bank_queue->hasOther(mem_pkt->row, mem_pkt);
+            got_bank_conflict |=
+                bank_queue->oldestExcept(mem_pkt->row) != nullptr;
+        }
+        auto_precharge = !got_more_hits &&
+            (got_bank_conflict || pageMgmt == enums::close_adaptive);
+    }
+    if (auto_precharge)
+        openRows[bank] = Bank::NO_ROW;
+
+    lastWasRead = is_read;
+    lastRank = mem_pkt->rank;
+    lastBurstAt = cmd_at;
+
+    if (is_read) {
+        ++stats.readBursts;
+        if (row_hit)
+            ++stats.readRowHits;
+        stats.dramBytesRead += burstSize;
+
+        // Update latency stats
+        stats.totMemAccLat += mem_pkt->readyTime - mem_pkt->entryTime;
+        stats.totQLat += cmd_at - mem_pkt->entryTime;
+    } else {
+        ++stats.writeBursts;
+        if (row_hit)
+            ++stats.writeRowHits;
+        stats.dramBytesWritten += burstSize;
+    }
+
+    return std::make_pair(cmd_at, cmd_at + burstGap);
+}
+
+void
+AnalyticalDRAMInterface::addRankToRankDelay(Tick cmd_at)
+{
+    rankDelayUntil = std::max(rankDelayUntil, cmd_at + rankToRankDelay());
+}
+
+AnalyticalDRAMInterface::AnalyticalDRAMStats::AnalyticalDRAMStats(
+        AnalyticalDRAMInterface &_dram)
+    : statistics::Group(&_dram),
+    dram(_dram),
+
+    ADD_STAT(readBursts, statistics::units::Count::get(),
+             "Number of DRAM read bursts"),
+    ADD_STAT(writeBursts, statistics::units::Count::get(),
+             "Number of DRAM write bursts"),
+
+    ADD_STAT(readRowHits, statistics::units::Count::get(),
+             "Number of row buffer hits during reads"),
+    ADD_STAT(writeRowHits, statistics::units::Count::get(),
+             "Number of row buffer hits during writes"),
+    ADD_STAT(readRowHitRate, statistics::units::Ratio::get(),
+             "Row buffer hit rate for reads"),
+    ADD_STAT(writeRowHitRate, statistics::units::Ratio::get(),
+             "Row buffer hit rate for writes"),
+
+    ADD_STAT(activations, statistics::units::Count::get(),
+             "Number of row activations"),
+
+    ADD_STAT(totQLat, statistics::units::Tick::get(),
+             "Total ticks spent queuing"),
+    ADD_STAT(totMemAccLat, statistics::units::Tick::get(),
+             "Total ticks spent from burst creation until serviced "
+             "by the DRAM"),
+
+    ADD_STAT(avgQLat, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Average queueing delay per DRAM burst"),
+    ADD_STAT(avgMemAccLat, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Average memory access latency per DRAM burst"),
+
+    ADD_STAT(dramBytesRead, statistics::units::Byte::get(),
+            "Total bytes read"),
+    ADD_STAT(dramBytesWritten, statistics::units::Byte::get(),
+            "Total bytes written")
+{
+}
+
+void
+AnalyticalDRAMInterface::AnalyticalDRAMStats::regStats()
+{
+    avgQLat.precision(2);
+    avgMemAccLat.precision(2);
+
+    readRowHitRate.precision(2);
+    writeRowHitRate.precision(2);
+
+    avgQLat = totQLat / readBursts;
+    avgMemAccLat = totMemAccLat / readBursts;
+
+    readRowHitRate = (readRowHits / readBursts) * 100;
+    writeRowHitRate = (writeRowHits / writeBursts) * 100;
+}
+
+} // namespace memory
+} // namespace gem5
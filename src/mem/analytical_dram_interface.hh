@@ -0,0 +1,195 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * AnalyticalDRAMInterface declaration
+ */
+
+#ifndef __MEM_ANALYTICAL_DRAM_INTERFACE_HH__
+#define __MEM_ANALYTICAL_DRAM_INTERFACE_HH__
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "enums/PageManage.hh"
+#include "mem/mem_interface.hh"
+#include "params/AnalyticalDRAMInterface.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * A fast, analytical DRAM model that takes the same timing parameters
+ * as DRAMInterface. Rather than tracking the timing of every bank and
+ * running the refresh and power state machines of every rank, it only
+ * remembers the open row of each bank and models the rest with a few
+ * shared resources:
+ *
+ * - the data bus, occupied for tBURST by every burst, plus the
+ *   read/write turnaround when the direction changes,
+ * - the activations, which a row miss needs and which are issued no
+ *   faster than the rate sustained by tRRD, tXAW and the bank cycle
+ *   time tRC spread over all banks,
+ * - refresh, accounted for as a loss of bandwidth of tRFC/tREFI and
+ *   the mean wait of a burst that arrives during a refresh.
+ *
+ * The interface schedules no events of its own, a burst is costed in a
+ * single call when the controller issues it.
+ */
+class AnalyticalDRAMInterface : public MemInterface
+{
+  private:
+    struct AnalyticalDRAMStats : public statistics::Group
+    {
+        AnalyticalDRAMStats(AnalyticalDRAMInterface &dram);
+
+        void regStats() override;
+
+        AnalyticalDRAMInterface &dram;
+
+        statistics::Scalar readBursts;
+        statistics::Scalar writeBursts;
+
+        statistics::Scalar readRowHits;
+        statistics::Scalar writeRowHits;
+        statistics::Formula readRowHitRate;
+        statistics::Formula writeRowHitRate;
+
+        statistics::Scalar activations;
+
+        // Latencies summed over all requests
+        statistics::Scalar totQLat;
+        statistics::Scalar totMemAccLat;
+
+        // Average latencies per request
+        statistics::Formula avgQLat;
+        statistics::Formula avgMemAccLat;
+
+        statistics::Scalar dramBytesRead;
+        statistics::Scalar dramBytesWritten;
+    };
+
+    /** Read and write CAS latencies */
+    const Tick tRL;
+    const Tick tWL;
+
+    const Tick tRCD_RD;
+    const Tick tRCD_WR;
+    const Tick tRP;
+
+    /** Average interval between activations */
+    const Tick actInterval;
+
+    /** Bus occupancy of a burst, stretched by the time lost to refresh */
+    const Tick burstGap;
+
+    /** Mean wait of a burst that arrives during a refresh */
+    const Tick refreshWait;
+
+    const enums::PageManage pageMgmt;
+    const uint32_t maxAccessesPerRow;
+
+    /** Open row and number of accesses to it, for each bank */
+    std::vector<uint32_t> openRows;
+    std::vector<uint32_t> rowAccesses;
+
+    /** When the next activation can issue */
+    Tick nextActAt = 0;
+
+    /** Direction, rank and issue time of the last burst */
+    bool lastWasRead = true;
+    uint8_t lastRank = 0;
+    Tick lastBurstAt = 0;
+
+    /** Earliest burst after an access to another interface */
+    Tick rankDelayUntil = 0;
+
+    AnalyticalDRAMStats stats;
+
+    /** Bank index of a packet */
+    size_t
+    bankIndex(const MemPacket *pkt) const
+    {
+        return pkt->rank * banksPerRank + pkt->bank;
+    }
+
+  public:
+    AnalyticalDRAMInterface(const AnalyticalDRAMInterfaceParams &_p);
+
+    MemPacket *decodePacket(const PacketPtr pkt, Addr pkt_addr,
+                            unsigned int size, bool is_read,
+                            uint8_t pseudo_channel = 0) override;
+
+    /**
+     * Prefer the oldest packet to an open row, otherwise the oldest
+     * packet.
+     */
+    std::pair<MemPacketQueue::iterator, Tick>
+    chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const override;
+
+    std::pair<Tick, Tick>
+    doBurstAccess(MemPacket *mem_pkt, Tick next_burst_at,
+                  const std::vector<MemPacketQueue>& queue) override;
+
+    Tick accessLatency() const override { return tRP + tRCD_RD + tRL; }
+
+    Tick
+    commandOffset() const override
+    {
+        return tRP + std::max(tRCD_RD, tRCD_WR);
+    }
+
+    Tick writeToReadDelay() const override { return tBURST + tWTR + tWL; }
+
+    void addRankToRankDelay(Tick cmd_at) override;
+
+    /** @{ */
+    /** There are no refresh or power states, ranks are always ready. */
+    bool burstReady(MemPacket *pkt) const override { return true; }
+    bool isBusy(bool read_queue_empty, bool all_writes_nvm) override
+    {
+        return false;
+    }
+    void setupRank(const uint8_t rank, const bool is_read) override {}
+    bool allRanksDrained() const override { return true; }
+    void respondEvent(uint8_t rank) override {}
+    void checkRefreshState(uint8_t rank) override {}
+    void drainRanks() override {}
+    void suspend() override {}
+    /** @} */
+
+    bool readsWaitingToIssue() const override { return false; }
+    void chooseRead(MemPacketQueue& queue) override {}
+    bool writeRespQueueFull() const override { return false; }
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_ANALYTICAL_DRAM_INTERFACE_HH__
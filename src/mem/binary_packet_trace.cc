@@ -0,0 +1,201 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/binary_packet_trace.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "base/logging.hh"
+#include "sim/byteswap.hh"
+
+namespace gem5
+{
+
+namespace binary_packet_trace
+{
+
+bool
+isTrace(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    char magic[sizeof(Magic)];
+    return file.read(magic, sizeof(magic)) &&
+        std::memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+Reader::Reader(const std::string &filename)
+    : fileName(filename), data(nullptr), len(0), hdr(nullptr),
+      records(nullptr), index(nullptr), pos(0)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Failed to open binary trace %s.\n", filename);
+
+    off_t off = lseek(fd, 0, SEEK_END);
+    fatal_if(off < 0, "Failed to determine size of file %s.\n", filename);
+    len = static_cast<size_t>(off);
+    fatal_if(len < sizeof(Header), "%s is not a binary trace.\n", filename);
+
+    data = (const uint8_t *)mmap(NULL, len, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    panic_if(data == MAP_FAILED, "Failed to mmap file %s.\n", filename);
+    madvise((void *)data, len, MADV_SEQUENTIAL);
+
+    hdr = reinterpret_cast<const Header *>(data);
+    fatal_if(std::memcmp(hdr->magic, Magic, sizeof(Magic)) != 0,
+             "%s is not a binary trace.\n", filename);
+    fatal_if(letoh(hdr->recordBytes) != sizeof(Record),
+             "%s has %d byte records, expected %d.\n", filename,
+             letoh(hdr->recordBytes), sizeof(Record));
+
+    const uint64_t num = letoh(hdr->numRecords);
+    const uint64_t offset = letoh(hdr->recordsOffset);
+    fatal_if(offset % alignof(Record) ||
+             offset + num * sizeof(Record) > len,
+             "Binary trace %s is truncated.\n", filename);
+    records = reinterpret_cast<const Record *>(data + offset);
+
+    if (const uint64_t index_offset = letoh(hdr->indexOffset)) {
+        const uint32_t stride = letoh(hdr->indexStride);
+        fatal_if(!stride, "Binary trace %s has an empty index stride.\n",
+                 filename);
+        const uint64_t entries = (num + stride - 1) / stride;
+        fatal_if(index_offset % alignof(uint64_t) ||
+                 index_offset + entries * sizeof(uint64_t) > len,
+                 "Binary trace %s index is truncated.\n", filename);
+        index = reinterpret_cast<const uint64_t *>(data + index_offset);
+    }
+}
+
+Reader::~Reader()
+{
+    munmap((void *)data, len);
+}
+
+bool
+Reader::read(Record &record)
+{
+    if (pos == letoh(hdr->numRecords))
+        return false;
+
+    const Record &r = records[pos++];
+    record.tick = letoh(r.tick);
+    record.addr = letoh(r.addr);
+    record.pc = letoh(r.pc);
+    record.size = letoh(r.size);
+    record.cmd = letoh(r.cmd);
+    record.flags = letoh(r.flags);
+    record.reserved = 0;
+    return true;
+}
+
+uint64_t
+Reader::seek(Tick tick)
+{
+    const uint64_t num = letoh(hdr->numRecords);
+    uint64_t first = 0;
+    uint64_t last = num;
+
+    // Narrow the search down to one block with the index
+    if (index) {
+        const uint32_t stride = letoh(hdr->indexStride);
+        const uint64_t entries = (num + stride - 1) / stride;
+        const uint64_t *block = std::upper_bound(index, index + entries,
+            tick, [](Tick t, uint64_t e) { return t <= letoh(e); });
+        const uint64_t b = block - index;
+        first = b ? (b - 1) * stride : 0;
+        last = std::min(num, b * stride + 1);
+    }
+
+    const Record *r = std::lower_bound(records + first, records + last,
+        tick, [](const Record &e, Tick t) { return letoh(e.tick) < t; });
+    pos = r - records;
+    return pos;
+}
+
+Writer::Writer(const std::string &filename, uint64_t tick_freq,
+               uint32_t index_stride)
+    : file(filename, std::ios::out | std::ios::binary | std::ios::trunc)
+{
+    panic_if(!file.good(), "Could not open %s for writing\n", filename);
+
+    std::memset(&hdr, 0, sizeof(hdr));
+    std::memcpy(hdr.magic, Magic, sizeof(Magic));
+    hdr.version = 1;
+    hdr.recordBytes = sizeof(Record);
+    hdr.tickFreq = tick_freq;
+    hdr.recordsOffset = sizeof(Header);
+    hdr.indexStride = index_stride;
+
+    // The header is written again once the record count is known
+    file.write((const char *)&hdr, sizeof(hdr));
+}
+
+void
+Writer::write(const Record &record)
+{
+    if (hdr.indexStride && hdr.numRecords % hdr.indexStride == 0)
+        indexTicks.push_back(htole(record.tick));
+
+    Record r;
+    r.tick = htole(record.tick);
+    r.addr = htole(record.addr);
+    r.pc = htole(record.pc);
+    r.size = htole(record.size);
+    r.cmd = htole(record.cmd);
+    r.flags = htole(record.flags);
+    r.reserved = 0;
+    file.write((const char *)&r, sizeof(r));
+    hdr.numRecords++;
+}
+
+Writer::~Writer()
+{
+    if (!indexTicks.empty()) {
+        hdr.indexOffset = hdr.recordsOffset +
+            hdr.numRecords * sizeof(Record);
+        file.write((const char *)indexTicks.data(),
+                   indexTicks.size() * sizeof(uint64_t));
+    }
+
+    Header le = hdr;
+    le.version = htole(hdr.version);
+    le.recordBytes = htole(hdr.recordBytes);
+    le.tickFreq = htole(hdr.tickFreq);
+    le.numRecords = htole(hdr.numRecords);
+    le.recordsOffset = htole(hdr.recordsOffset);
+    le.indexOffset = htole(hdr.indexOffset);
+    le.indexStride = htole(hdr.indexStride);
+    file.seekp(0);
+    file.write((const char *)&le, sizeof(le));
+    file.close();
+}
+
+} // namespace binary_packet_trace
+} // namespace gem5
@@ -0,0 +1,174 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A fixed-width binary packet trace format. Traces are mapped into
+ * memory and read record by record without any decoding, as opposed
+ * to the varint-encoded protobuf packet traces.
+ *
+ * The file starts with a Header, followed by the records. An optional
+ * index holds the tick of the first record of every indexStride
+ * records, to find the position of a tick without a scan. All fields
+ * are little endian.
+ */
+
+#ifndef __MEM_BINARY_PACKET_TRACE_HH__
+#define __MEM_BINARY_PACKET_TRACE_HH__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace binary_packet_trace
+{
+
+/** Identifies a binary packet trace, version 1. */
+constexpr char Magic[8] = {'g', '5', 'p', 'k', 'b', 'i', 'n', '1'};
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    /** Size of a Record, to catch mismatched readers. */
+    uint32_t recordBytes;
+    /** Ticks per second of the record ticks. */
+    uint64_t tickFreq;
+    uint64_t numRecords;
+    /** Byte offset of the first record. */
+    uint64_t recordsOffset;
+    /** Byte offset of the index, 0 if the trace has none. */
+    uint64_t indexOffset;
+    /** Records per index entry. */
+    uint32_t indexStride;
+    uint32_t reserved0;
+    uint64_t reserved1;
+};
+
+static_assert(sizeof(Header) == 64, "Unexpected binary trace header size");
+
+struct Record
+{
+    uint64_t tick;
+    uint64_t addr;
+    uint64_t pc;
+    uint32_t size;
+    /** A MemCmd::Command. */
+    uint32_t cmd;
+    /** Request::FlagsType, truncated to 32 bits as in the protobuf. */
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(Record) == 40, "Unexpected binary trace record size");
+
+/** Check whether a file is a binary packet trace. */
+bool isTrace(const std::string &filename);
+
+/**
+ * Reads a binary packet trace mapped into memory.
+ */
+class Reader
+{
+  public:
+    /**
+     * Map a trace. Fails if the file is not a valid binary trace.
+     *
+     * @param filename Path to the file to read from
+     */
+    Reader(const std::string &filename);
+    ~Reader();
+
+    Reader(const Reader &) = delete;
+    Reader &operator=(const Reader &) = delete;
+
+    const Header &header() const { return *hdr; }
+
+    /**
+     * Read the next record.
+     *
+     * @param record Record to populate
+     * @return True if a record was read, false at the end of the trace
+     */
+    bool read(Record &record);
+
+    /** Go back to the first record. */
+    void reset() { pos = 0; }
+
+    /**
+     * Move to the first record with a tick no earlier than the given
+     * one, assuming the records are sorted by tick.
+     *
+     * @return The number of the record now next to be read
+     */
+    uint64_t seek(Tick tick);
+
+  private:
+    const std::string fileName;
+    const uint8_t *data;
+    size_t len;
+    const Header *hdr;
+    const Record *records;
+    const uint64_t *index;
+    uint64_t pos;
+};
+
+/**
+ * Writes a binary packet trace. The header is completed and the index
+ * appended when the writer is destroyed.
+ */
+class Writer
+{
+  public:
+    /**
+     * @param filename Path to the file to create or truncate
+     * @param tick_freq Ticks per second of the record ticks
+     * @param index_stride Records per index entry, 0 for no index
+     */
+    Writer(const std::string &filename, uint64_t tick_freq,
+           uint32_t index_stride = 0);
+    ~Writer();
+
+    Writer(const Writer &) = delete;
+    Writer &operator=(const Writer &) = delete;
+
+    void write(const Record &record);
+
+  private:
+    std::ofstream file;
+    Header hdr;
+    std::vector<uint64_t> indexTicks;
+};
+
+} // namespace binary_packet_trace
+} // namespace gem5
+
+#endif // __MEM_BINARY_PACKET_TRACE_HH__
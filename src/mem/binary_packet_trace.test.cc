@@ -0,0 +1,135 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+
+#include "mem/binary_packet_trace.hh"
+
+using namespace gem5;
+using namespace gem5::binary_packet_trace;
+
+namespace
+{
+
+class BinaryPacketTraceTest : public testing::Test
+{
+  protected:
+    void
+    SetUp() override
+    {
+        char tmpl[] = "/tmp/binary_packet_trace.test.XXXXXX";
+        int fd = mkstemp(tmpl);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        file = tmpl;
+    }
+
+    void TearDown() override { unlink(file.c_str()); }
+
+    /** Write records with ticks 0, 10, 20, ... */
+    void
+    writeTrace(uint64_t num, uint32_t stride)
+    {
+        Writer writer(file, 1000, stride);
+        for (uint64_t i = 0; i < num; i++) {
+            Record r = {};
+            r.tick = i * 10;
+            r.addr = 0x1000 + i * 64;
+            r.pc = 0x400000 + i * 4;
+            r.size = 64;
+            r.cmd = i % 2;
+            r.flags = i;
+            writer.write(r);
+        }
+    }
+
+    std::string file;
+};
+
+} // anonymous namespace
+
+TEST_F(BinaryPacketTraceTest, RoundTrip)
+{
+    writeTrace(100, 0);
+    ASSERT_TRUE(isTrace(file));
+
+    Reader reader(file);
+    EXPECT_EQ(reader.header().tickFreq, 1000);
+    EXPECT_EQ(reader.header().numRecords, 100);
+    EXPECT_EQ(reader.header().indexOffset, 0);
+
+    for (int pass = 0; pass < 2; pass++) {
+        Record r;
+        for (uint64_t i = 0; i < 100; i++) {
+            ASSERT_TRUE(reader.read(r));
+            EXPECT_EQ(r.tick, i * 10);
+            EXPECT_EQ(r.addr, 0x1000 + i * 64);
+            EXPECT_EQ(r.pc, 0x400000 + i * 4);
+            EXPECT_EQ(r.size, 64);
+            EXPECT_EQ(r.cmd, i % 2);
+            EXPECT_EQ(r.flags, i);
+        }
+        EXPECT_FALSE(reader.read(r));
+        reader.reset();
+    }
+}
+
+TEST_F(BinaryPacketTraceTest, Empty)
+{
+    writeTrace(0, 16);
+    Reader reader(file);
+    Record r;
+    EXPECT_FALSE(reader.read(r));
+    EXPECT_EQ(reader.seek(5), 0);
+}
+
+TEST_F(BinaryPacketTraceTest, NotATrace)
+{
+    EXPECT_FALSE(isTrace(file));
+    EXPECT_FALSE(isTrace(file + ".missing"));
+}
+
+TEST_F(BinaryPacketTraceTest, Seek)
+{
+    for (uint32_t stride : {0, 1, 7, 16, 1000}) {
+        writeTrace(100, stride);
+        Reader reader(file);
+        EXPECT_EQ(reader.header().indexOffset != 0, stride != 0);
+
+        for (Tick tick = 0; tick <= 990; tick += 3) {
+            const uint64_t expected = (tick + 9) / 10;
+            ASSERT_EQ(reader.seek(tick), expected) << stride << " " << tick;
+            Record r;
+            ASSERT_TRUE(reader.read(r));
+            EXPECT_EQ(r.tick, expected * 10);
+        }
+        EXPECT_EQ(reader.seek(1000), 100);
+    }
+}
@@ -36,6 +36,7 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+from m5.objects.BypassPredictors import BaseBypassPredictor
 from m5.objects.ClockedObject import ClockedObject
 from m5.objects.Compressors import BaseCacheCompressor
 from m5.objects.Prefetcher import BasePrefetcher
@@ -102,6 +103,11 @@ class BaseCache(ClockedObject):
     demand_mshr_reserve = Param.Unsigned(1, "MSHRs reserved for demand access")
     tgts_per_mshr = Param.Unsigned("Max number of accesses per MSHR")
     write_buffers = Param.Unsigned(8, "Number of write buffers")
+    queue_hash_index = Param.Bool(
+        False,
+        "Index the MSHRs and write buffers by block address, rather than "
+        "searching them linearly on every access",
+    )
 
     is_read_only = Param.Bool(False, "Is this cache read only (e.g. inst)")
 
@@ -114,8 +120,16 @@ class BaseCache(ClockedObject):
     partitioning_manager = Param.PartitionManager(
         NULL, "Cache partitioning manager"
     )
+    bypass_predictor = Param.BaseBypassPredictor(
+        NULL, "Predictor of the fills that should not be allocated"
+    )
 
     compressor = Param.BaseCacheCompressor(NULL, "Cache compressor.")
+    compression_dueling = Param.SetDueling(
+        NULL,
+        "Duel between compressing blocks (A) and storing them uncompressed "
+        "(B). Requires a compressor",
+    )
     replace_expansions = Param.Bool(
         True,
         "Apply replacement policy to "
@@ -169,6 +183,22 @@ class BaseCache(ClockedObject):
     # data cache.
     write_allocator = Param.WriteAllocator(NULL, "Write allocator")
 
+    # Warming accesses (see BaseCache::warmAccess) update the tags and
+    # replacement state of hits without a packet, and so without notifying
+    # hit listeners such as the prefetcher. Setting this sends warming hits
+    # down the atomic path whenever something listens to hits, so that the
+    # prefetcher is trained as well, at the cost of warming speed.
+    warm_notify_hits = Param.Bool(
+        False, "Notify hit listeners (e.g. prefetchers) of warming hits"
+    )
+
+    # Checkpointing the tags lets the cache be restored warm. The cache
+    # must be clean when checkpointing (i.e., written back), the data of
+    # the restored blocks is read back from below on startup.
+    checkpoint_tags = Param.Bool(
+        False, "Checkpoint the tags and replacement state of the cache"
+    )
+
 
 class Cache(BaseCache):
     type = "Cache"
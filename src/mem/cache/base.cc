@@ -45,6 +45,11 @@
 
 #include "mem/cache/base.hh"
 
+#include <zlib.h>
+
+#include <climits>
+#include <cstring>
+
 #include "base/compiler.hh"
 #include "base/logging.hh"
 #include "debug/Cache.hh"
@@ -83,11 +88,15 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       cpuSidePort (p.name + ".cpu_side_port", *this, "CpuSidePort"),
       memSidePort(p.name + ".mem_side_port", this, "MemSidePort"),
       accessor(*this),
-      mshrQueue("MSHRs", p.mshrs, 0, p.demand_mshr_reserve, p.name),
-      writeBuffer("write buffer", p.write_buffers, p.mshrs, p.name),
+      mshrQueue("MSHRs", p.mshrs, 0, p.demand_mshr_reserve, p.name,
+                p.queue_hash_index),
+      writeBuffer("write buffer", p.write_buffers, p.mshrs, p.name,
+                  p.queue_hash_index),
       tags(p.tags),
       compressor(p.compressor),
+      compressionDueling(p.compression_dueling),
       partitionManager(p.partitioning_manager),
+      bypassPredictor(p.bypass_predictor),
       prefetcher(p.prefetcher),
       writeAllocator(p.write_allocator),
       writebackClean(p.writeback_clean),
@@ -108,6 +117,8 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       isReadOnly(p.is_read_only),
       replaceExpansions(p.replace_expansions),
       moveContractions(p.move_contractions),
+      warmNotifyHits(p.warm_notify_hits),
+      checkpointTags(p.checkpoint_tags),
       blocked(0),
       order(0),
       noTargetMSHR(nullptr),
@@ -139,6 +150,8 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
         "Compressed cache %s does not have a compression algorithm", name());
     if (compressor)
         compressor->setCache(this);
+    fatal_if(compressionDueling && !compressor,
+        "Cache %s duels compression without a compressor", name());
 }
 
 BaseCache::~BaseCache()
@@ -202,6 +215,15 @@ BaseCache::init()
     forwardSnoops = cpuSidePort.isSnooping();
 }
 
+void
+BaseCache::startup()
+{
+    ClockedObject::startup();
+
+    if (!restoredBlks.empty())
+        restoreTags();
+}
+
 Port &
 BaseCache::getPort(const std::string &if_name, PortID idx)
 {
@@ -250,7 +272,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
+            RequestPtr req2 = makeRequest(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -351,6 +373,13 @@ BaseCache::handleTimingReqMiss(PacketPtr pkt, MSHR *mshr, CacheBlk *blk,
                 // buffer and to schedule an event to the queued
                 // port and also takes into account the additional
                 // delay of the xbar.
+                // A demand joining an in-flight prefetch means the
+                // prefetch was issued too late to fully hide the miss
+                if (prefetcher && pkt->isDemand() &&
+                    mshr->getTarget()->pkt->cmd == MemCmd::HardPFReq) {
+                    prefetcher->prefetchLate();
+                }
+
                 mshr->allocateTarget(pkt, forward_time, order++,
                                      allocOnFill(pkt->cmd));
                 if (mshr->getNumTargets() >= numTarget) {
@@ -367,8 +396,10 @@ BaseCache::handleTimingReqMiss(PacketPtr pkt, MSHR *mshr, CacheBlk *blk,
         // no MSHR
         assert(pkt->req->requestorId() < system->maxRequestors());
         stats.cmdStats(pkt).mshrMisses[pkt->req->requestorId()]++;
-        if (prefetcher && pkt->isDemand())
+        if (prefetcher && pkt->isDemand()) {
             prefetcher->incrDemandMhsrMisses();
+            prefetcher->notifyDemandMiss(pkt->getBlockAddr(blkSize));
+        }
 
         if (pkt->isEviction() || pkt->cmd == MemCmd::WriteClean) {
             // We use forward_time here because there is an
@@ -715,6 +746,44 @@ BaseCache::recvAtomic(PacketPtr pkt)
     return lat * clockPeriod();
 }
 
+bool
+BaseCache::warmAccess(Addr addr, unsigned size, bool is_secure,
+                      bool is_write, uint8_t *data)
+{
+    // Listeners need the packet of the access
+    if (warmNotifyHits && ppHit->hasListeners())
+        return false;
+    if (is_write && (compressor || ppDataUpdate->hasListeners()))
+        return false;
+
+    CacheBlk *blk = tags->findBlock({addr, is_secure});
+
+    // Misses and upgrades need the coherence actions of the atomic path,
+    // and the first use of a prefetched block is reported to the
+    // prefetcher
+    if (!blk || blk->wasPrefetched() || !blk->isSet(CacheBlk::ReadableBit))
+        return false;
+    if (is_write &&
+        (!blk->isSet(CacheBlk::WritableBit) || blk->hasLoadLocks())) {
+        return false;
+    }
+
+    if (!tags->touchBlock(blk))
+        return false;
+
+    const unsigned offset = addr & (blkSize - 1);
+    assert(offset + size <= blkSize);
+    if (is_write) {
+        std::memcpy(blk->data + offset, data, size);
+        blk->setCoherenceBits(CacheBlk::DirtyBit);
+    } else {
+        std::memcpy(data, blk->data + offset, size);
+    }
+
+    stats.warmHits++;
+    return true;
+}
+
 void
 BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
 {
@@ -935,6 +1004,8 @@ BaseCache::getNextQueueEntry()
                 assert(pkt->req->requestorId() < system->maxRequestors());
                 stats.cmdStats(pkt).mshrMisses[pkt->req->requestorId()]++;
 
+                ppPrefetchIssue->notify(CacheAccessProbeArg(pkt, accessor));
+
                 // allocate an MSHR and return it, note
                 // that we send the packet straight away, so do not
                 // schedule the send
@@ -996,9 +1067,12 @@ BaseCache::updateCompressionData(CacheBlk *&blk, const uint64_t* data,
     // metadata can be updated.
     Cycles compression_lat = Cycles(0);
     Cycles decompression_lat = Cycles(0);
-    const auto comp_data =
-        compressor->compress(data, compression_lat, decompression_lat);
-    std::size_t compression_size = comp_data->getSizeBits();
+    std::size_t compression_size = blkSize * CHAR_BIT;
+    if (!isCompressionDisabled(regenerateBlkAddr(blk))) {
+        const auto comp_data =
+            compressor->compress(data, compression_lat, decompression_lat);
+        compression_size = comp_data->getSizeBits();
+    }
 
     // Get previous compressed size
     CompressionBlk* compression_blk = static_cast<CompressionBlk*>(blk);
@@ -1255,8 +1329,15 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
     Cycles tag_latency(0);
     blk = tags->accessBlock(pkt, tag_latency);
 
-    DPRINTF(Cache, "%s for %s %s\n", __func__, pkt->print(),
-            blk ? "hit " + blk->print() : "miss");
+    // Train the bypass predictor with the demand stream, ignoring
+    // the evictions coming from the caches above
+    if (bypassPredictor && !pkt->isEviction() &&
+        !pkt->req->isCacheMaintenance()) {
+        bypassPredictor->notifyAccess(pkt, blk && blk->isValid());
+    }
+
+    DPRINTFA(Cache, pkt->getAddr(), "%s for %s %s\n", __func__,
+             pkt->print(), blk ? "hit " + blk->print() : "miss");
 
     if (pkt->req->isCacheMaintenance()) {
         // A cache maintenance operation is always forwarded to the
@@ -1539,6 +1620,16 @@ BaseCache::handleFill(PacketPtr pkt, CacheBlk *blk, PacketList &writebacks,
         // better have read new data...
         assert(pkt->hasData() || pkt->cmd == MemCmd::InvalidateResp);
 
+        // Let the bypass predictor veto the allocation of clean read
+        // fills that are unlikely to be reused. Dirty fills would have
+        // to be written back right away, and prefetches and LLSC
+        // accesses rely on the line staying in the cache.
+        if (allocate && bypassPredictor && pkt->isRead() &&
+            !pkt->cacheResponding() && pkt->cmd != MemCmd::HardPFResp &&
+            !pkt->req->isLLSC() && bypassPredictor->bypass(pkt)) {
+            allocate = false;
+        }
+
         // need to do a replacement if allocating, otherwise we stick
         // with the temporary storage
         blk = allocate ? allocateBlock(pkt, writebacks) : nullptr;
@@ -1638,7 +1729,7 @@ BaseCache::allocateBlock(const PacketPtr pkt, PacketList &writebacks)
     // compressor is used, the compression/decompression methods are called to
     // calculate the amount of extra cycles needed to read or write compressed
     // blocks.
-    if (compressor && pkt->hasData()) {
+    if (compressor && pkt->hasData() && !isCompressionDisabled(addr)) {
         const auto comp_data = compressor->compress(
             pkt->getConstPtr<uint64_t>(), compression_lat, decompression_lat);
         blk_size_bits = comp_data->getSizeBits();
@@ -1659,6 +1750,16 @@ BaseCache::allocateBlock(const PacketPtr pkt, PacketList &writebacks)
     // Print victim block's information
     DPRINTF(CacheRepl, "Replacement victim: %s\n", victim->print());
 
+    // Let the prefetcher know which blocks its prefetches displace, so
+    // that it can tell whether it is polluting the cache
+    if (prefetcher && pkt->cmd == MemCmd::HardPFResp) {
+        for (const auto& blk : evict_blks) {
+            if (blk->isValid()) {
+                prefetcher->notifyPrefetchEviction(regenerateBlkAddr(blk));
+            }
+        }
+    }
+
     // Try to evict blocks; if it fails, give up on allocation
     if (!handleEvictions(evict_blks, writebacks)) {
         return nullptr;
@@ -1716,7 +1817,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1759,7 +1860,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1833,7 +1934,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = makeRequest(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
@@ -2025,6 +2126,67 @@ BaseCache::serialize(CheckpointOut &cp) const
     // cache contains dirty data.
     bool bad_checkpoint(dirty);
     SERIALIZE_SCALAR(bad_checkpoint);
+
+    bool has_tags = checkpointTags && !dirty;
+    if (has_tags && !tags->canRestoreBlocks()) {
+        warn("%s: The tags of this tag store can't be checkpointed.\n",
+             name());
+        has_tags = false;
+    }
+    SERIALIZE_SCALAR(has_tags);
+    if (has_tags)
+        serializeTags(cp);
+}
+
+void
+BaseCache::serializeTags(CheckpointOut &cp) const
+{
+    std::vector<CheckpointedBlk> blks;
+    tags->forEachBlk([this, &blks](CacheBlk &blk) {
+        if (!blk.isValid())
+            return;
+
+        CheckpointedBlk cblk = {};
+        cblk.addr = tags->regenerateBlkAddr(&blk);
+        cblk.replacementState = tags->getReplacementState(&blk);
+        cblk.set = blk.getSet();
+        cblk.way = blk.getWay();
+        cblk.srcRequestorId = blk.getSrcRequestorId();
+        cblk.taskId = blk.getTaskId();
+        cblk.coherence = blk.isSet(CacheBlk::WritableBit) ?
+            CacheBlk::WritableBit : 0;
+        cblk.coherence |= blk.isSet(CacheBlk::ReadableBit) ?
+            CacheBlk::ReadableBit : 0;
+        cblk.secure = blk.isSecure();
+        blks.push_back(cblk);
+    });
+
+    const std::string tags_file = name() + ".tags";
+    const uint64_t num_blocks = tags->getNumBlocks();
+    const uint64_t num_valid = blks.size();
+    const uint64_t blk_size = blkSize;
+    const uint64_t num_sets = tags->getNumSets();
+    const uint64_t assoc = tags->getAssoc();
+    const std::string indexing_policy = tags->getIndexingPolicyType();
+    SERIALIZE_SCALAR(tags_file);
+    SERIALIZE_SCALAR(num_blocks);
+    SERIALIZE_SCALAR(num_valid);
+    SERIALIZE_SCALAR(blk_size);
+    SERIALIZE_SCALAR(num_sets);
+    SERIALIZE_SCALAR(assoc);
+    SERIALIZE_SCALAR(indexing_policy);
+
+    const std::string filepath = CheckpointIn::dir() + "/" + tags_file;
+    gzFile file = gzopen(filepath.c_str(), "wb");
+    fatal_if(!file, "Can't open cache tags checkpoint file '%s'\n",
+             tags_file);
+
+    const size_t len = blks.size() * sizeof(CheckpointedBlk);
+    fatal_if(len > INT_MAX, "Too many blocks in '%s'\n", tags_file);
+    if (len && gzwrite(file, blks.data(), len) != (int)len)
+        fatal("Write failed on cache tags checkpoint file '%s'\n", tags_file);
+    if (gzclose(file))
+        fatal("Close failed on cache tags checkpoint file '%s'\n", tags_file);
 }
 
 void
@@ -2037,6 +2199,100 @@ BaseCache::unserialize(CheckpointIn &cp)
               "supported in the classic memory system. Please remove any "
               "caches or drain them properly before taking checkpoints.\n");
     }
+
+    // Checkpoints taken without tags restore the cache cold
+    bool has_tags = false;
+    UNSERIALIZE_OPT_SCALAR(has_tags);
+    if (has_tags && checkpointTags)
+        unserializeTags(cp);
+}
+
+void
+BaseCache::unserializeTags(CheckpointIn &cp)
+{
+    std::string tags_file;
+    uint64_t num_blocks;
+    uint64_t num_valid;
+    uint64_t blk_size;
+    UNSERIALIZE_SCALAR(tags_file);
+    UNSERIALIZE_SCALAR(num_blocks);
+    UNSERIALIZE_SCALAR(num_valid);
+    UNSERIALIZE_SCALAR(blk_size);
+    uint64_t num_sets = 0;
+    uint64_t assoc = 0;
+    std::string indexing_policy;
+    UNSERIALIZE_OPT_SCALAR(num_sets);
+    UNSERIALIZE_OPT_SCALAR(assoc);
+    UNSERIALIZE_OPT_SCALAR(indexing_policy);
+
+    if (num_blocks != tags->getNumBlocks() || blk_size != blkSize ||
+            num_sets != tags->getNumSets() || assoc != tags->getAssoc() ||
+            indexing_policy != tags->getIndexingPolicyType() ||
+            num_valid > num_blocks || !tags->canRestoreBlocks()) {
+        warn("%s: The cache configuration changed since the checkpoint "
+             "was taken, it is restored cold.\n", name());
+        return;
+    }
+
+    const std::string filepath = cp.getCptDir() + "/" + tags_file;
+    gzFile file = gzopen(filepath.c_str(), "rb");
+    fatal_if(!file, "Can't open cache tags checkpoint file '%s'\n",
+             tags_file);
+
+    restoredBlks.resize(num_valid);
+    const size_t len = num_valid * sizeof(CheckpointedBlk);
+    if (len && gzread(file, restoredBlks.data(), len) != (int)len)
+        fatal("Read failed on cache tags checkpoint file '%s'\n", tags_file);
+    if (gzclose(file))
+        fatal("Close failed on cache tags checkpoint file '%s'\n", tags_file);
+}
+
+void
+BaseCache::restoreTags()
+{
+    uint64_t rejected = 0;
+    for (const auto &cblk : restoredBlks) {
+        // Don't trust the positions read from the file: a block must be
+        // in the tag store, at a position its address maps to, and can't
+        // share it or its address with another block.
+        const CacheBlk::KeyType key = {cblk.addr, bool(cblk.secure)};
+        if (!tags->isValidBlockPosition(key, cblk.set, cblk.way) ||
+                tags->findBlock(key)) {
+            rejected++;
+            continue;
+        }
+        CacheBlk *blk = static_cast<CacheBlk*>(
+            tags->findBlockBySetAndWay(cblk.set, cblk.way));
+        if (blk->isValid()) {
+            rejected++;
+            continue;
+        }
+
+        const RequestorID requestor =
+            cblk.srcRequestorId < system->maxRequestors() ?
+            cblk.srcRequestorId : Request::funcRequestorId;
+        RequestPtr req = std::make_shared<Request>(
+            cblk.addr, blkSize, cblk.secure ? Request::SECURE : 0,
+            requestor);
+        req->taskId(cblk.taskId);
+
+        // The checkpointed cache was clean, so the data below is up to
+        // date.
+        Packet pkt(req, MemCmd::ReadReq);
+        pkt.dataStatic(blk->data);
+        memSidePort.sendFunctional(&pkt);
+
+        tags->insertBlock(&pkt, blk);
+        blk->setCoherenceBits(cblk.coherence);
+        tags->setReplacementState(blk, cblk.replacementState);
+    }
+
+    warn_if(rejected, "%s: Ignored %d checkpointed blocks that don't fit "
+            "the tag store.\n", name(), rejected);
+    DPRINTF(Cache, "Restored %d blocks from the checkpoint\n",
+            restoredBlks.size() - rejected);
+    restoredBlks.clear();
+    restoredBlks.shrink_to_fit();
 }
 
 
@@ -2290,6 +2546,8 @@ BaseCache::CacheStats::CacheStats(BaseCache &c)
              "number of data expansions"),
     ADD_STAT(dataContractions, statistics::units::Count::get(),
              "number of data contractions"),
+    ADD_STAT(warmHits, statistics::units::Count::get(),
+             "number of CPU accesses handled by the warming fast path"),
     cmd(MemCmd::NUM_MEM_CMDS)
 {
     for (int idx = 0; idx < MemCmd::NUM_MEM_CMDS; ++idx)
@@ -2530,6 +2788,8 @@ BaseCache::regProbePoints()
         this->getProbeManager(), "Miss");
     ppFill = new ProbePointArg<CacheAccessProbeArg>(
         this->getProbeManager(), "Fill");
+    ppPrefetchIssue = new ProbePointArg<CacheAccessProbeArg>(
+        this->getProbeManager(), "PrefetchIssue");
     ppDataUpdate =
         new ProbePointArg<CacheDataUpdateProbeArg>(
             this->getProbeManager(), "Data Update");
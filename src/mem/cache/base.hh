@@ -58,11 +58,13 @@
 #include "debug/Cache.hh"
 #include "debug/CachePort.hh"
 #include "enums/Clusivity.hh"
+#include "mem/cache/bypass/base.hh"
 #include "mem/cache/cache_blk.hh"
 #include "mem/cache/cache_probe_arg.hh"
 #include "mem/cache/compressors/base.hh"
 #include "mem/cache/mshr_queue.hh"
 #include "mem/cache/tags/base.hh"
+#include "mem/cache/tags/set_dueling.hh"
 #include "mem/cache/write_queue.hh"
 #include "mem/cache/write_queue_entry.hh"
 #include "mem/packet.hh"
@@ -355,9 +357,18 @@ class BaseCache : public ClockedObject
     /** Compression method being used. */
     compression::Base* compressor;
 
+    /**
+     * Optional duel deciding whether the blocks of each set are compressed
+     * (option A) or stored uncompressed (option B).
+     */
+    SetDueling* compressionDueling;
+
     /** Partitioning manager */
     partitioning_policy::PartitionManager* partitionManager;
 
+    /** Predictor of the fills that should bypass the cache, if any */
+    bypass_predictor::Base *bypassPredictor;
+
     /** Prefetcher */
     prefetch::Base *prefetcher;
 
@@ -370,6 +381,9 @@ class BaseCache : public ClockedObject
     /** To probe when a cache fill occurs */
     ProbePointArg<CacheAccessProbeArg> *ppFill;
 
+    /** To probe when a hardware prefetch is sent to the next level */
+    ProbePointArg<CacheAccessProbeArg> *ppPrefetchIssue;
+
     /**
      * To probe when the contents of a block are updated. Content updates
      * include data fills, overwrites, and invalidations, which means that
@@ -708,6 +722,19 @@ class BaseCache : public ClockedObject
      */
     EventFunctionWrapper writebackTempBlockAtomicEvent;
 
+    /**
+     * Check if the blocks of an address must be stored uncompressed because
+     * the compression duel selected so for its set.
+     *
+     * @param addr The block's address.
+     * @return Whether compression is disabled for this address.
+     */
+    bool
+    isCompressionDisabled(Addr addr)
+    {
+        return compressionDueling && compressionDueling->selectB(addr);
+    }
+
     /**
      * When a block is overwriten, its compression information must be updated,
      * and it may need to be recompressed. If the compression size changes, the
@@ -964,6 +991,35 @@ class BaseCache : public ClockedObject
      */
     const bool moveContractions;
 
+    /**
+     * Send warming hits down the atomic path when hits have listeners.
+     * @sa warmAccess
+     */
+    const bool warmNotifyHits;
+
+    /**
+     * Checkpoint the tags of the cache, so that it is restored warm.
+     * @sa serializeTags
+     */
+    const bool checkpointTags;
+
+    /** A valid block as stored in a tags checkpoint */
+    struct CheckpointedBlk
+    {
+        uint64_t addr;
+        uint64_t replacementState;
+        uint32_t set;
+        uint32_t way;
+        uint32_t srcRequestorId;
+        uint32_t taskId;
+        uint8_t coherence;
+        uint8_t secure;
+        uint8_t pad[6];
+    };
+
+    /** Blocks restored from a checkpoint, inserted on startup */
+    std::vector<CheckpointedBlk> restoredBlks;
+
     /**
      * Bit vector of the blocking reasons for the access path.
      * @sa #BlockedCause
@@ -1148,6 +1204,9 @@ class BaseCache : public ClockedObject
          */
         statistics::Scalar dataContractions;
 
+        /** Number of accesses handled by warmAccess(). */
+        statistics::Scalar warmHits;
+
         /** Per-command statistics */
         std::vector<std::unique_ptr<CacheCmdStats>> cmd;
     } stats;
@@ -1161,6 +1220,8 @@ class BaseCache : public ClockedObject
 
     void init() override;
 
+    void startup() override;
+
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
 
@@ -1282,6 +1343,12 @@ class BaseCache : public ClockedObject
         memSidePort.schedSendEvent(time);
     }
 
+    /**
+     * Get the accessor other components use to look up this cache, e.g.,
+     * prefetchers of lower-level caches.
+     */
+    CacheAccessor &getCacheAccessor() { return accessor; }
+
     bool inCache(Addr addr, bool is_secure) const {
         return tags->findBlock({addr, is_secure});
     }
@@ -1298,6 +1365,26 @@ class BaseCache : public ClockedObject
                (block->getSrcRequestorId() == requestor);
     }
 
+    /**
+     * Functional warming fast path for a CPU access, used instead of
+     * sending it an atomic packet. Only hits on blocks with the needed
+     * permission are handled: the tags and replacement state are updated,
+     * and data copied, as the atomic path would, but without a packet,
+     * latency or access stats. Anything that could need a coherence
+     * action, an allocation or the packet itself (misses, upgrades, LL/SC
+     * locks, compression, listeners) is refused, and the caller must then
+     * fall back to the atomic path. The access must not cross a block.
+     *
+     * @param addr Physical address of the access.
+     * @param size Size of the access in bytes.
+     * @param is_secure Whether the access is to secure memory.
+     * @param is_write Whether data is written to, or read from, the cache.
+     * @param data Data to write, or buffer to read into.
+     * @return Whether the access was performed.
+     */
+    bool warmAccess(Addr addr, unsigned size, bool is_secure, bool is_write,
+                    uint8_t *data);
+
     bool inMissQueue(Addr addr, bool is_secure) const {
         return mshrQueue.findMatch(addr, is_secure);
     }
@@ -1307,6 +1394,9 @@ class BaseCache : public ClockedObject
         assert(pkt->req->requestorId() < system->maxRequestors());
         stats.cmdStats(pkt).misses[pkt->req->requestorId()]++;
         pkt->req->incAccessDepth();
+        if (compressionDueling) {
+            compressionDueling->sampleMiss(pkt->getAddr());
+        }
         if (missCount) {
             --missCount;
             if (missCount == 0)
@@ -1363,10 +1453,28 @@ class BaseCache : public ClockedObject
     /**
      * Serialize the state of the caches
      *
-     * We currently don't support checkpointing cache state, so this panics.
+     * Dirty data can't be checkpointed, the cache has to be written back
+     * first. The tags of a clean cache are checkpointed if enabled.
      */
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
+
+    /**
+     * Write the valid blocks of a clean cache to a compressed binary file
+     * in the checkpoint directory: their addresses, coherence and
+     * replacement state, and their position in the tag store. Their data
+     * is not stored, it is up to date in memory once the cache is clean.
+     */
+    void serializeTags(CheckpointOut &cp) const;
+
+    /**
+     * Read the blocks stored by serializeTags(). They are inserted on
+     * startup, once the memories have been restored.
+     */
+    void unserializeTags(CheckpointIn &cp);
+
+    /** Insert the restored blocks, reading their data from below. */
+    void restoreTags();
 };
 
 /**
@@ -0,0 +1,91 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+
+class BaseBypassPredictor(SimObject):
+    type = "BaseBypassPredictor"
+    abstract = True
+    cxx_class = "gem5::bypass_predictor::Base"
+    cxx_header = "mem/cache/bypass/base.hh"
+
+    block_size = Param.Int(Parent.cache_line_size, "Block size in bytes")
+    filter_entries = Param.Unsigned(
+        1024,
+        "Number of recently bypassed blocks tracked to detect bypassed "
+        "blocks that are referenced again",
+    )
+
+
+class SamplingBypassPredictor(BaseBypassPredictor):
+    type = "SamplingBypassPredictor"
+    abstract = True
+    cxx_class = "gem5::bypass_predictor::Sampling"
+    cxx_header = "mem/cache/bypass/sampling.hh"
+
+    size = Param.MemorySize(Parent.size, "Size of the cache")
+    assoc = Param.Unsigned(Parent.assoc, "Associativity of the cache")
+
+    sampled_sets = Param.Unsigned(32, "Number of cache sets sampled")
+    sampler_assoc = Param.Unsigned(
+        12, "Associativity of the sampler of each sampled set"
+    )
+    table_entries = Param.Unsigned(
+        4096, "Number of entries of the signature-indexed prediction table"
+    )
+    counter_bits = Param.Unsigned(
+        2, "Number of bits of the prediction saturating counters"
+    )
+
+
+class SamplingDeadBlockBypass(SamplingBypassPredictor):
+    """
+    Sampling dead block predictor, as described in "Sampling Dead Block
+    Prediction for Last-Level Caches", by Khan et al. A fill bypasses the
+    cache if the blocks last touched by the same signature tend to be evicted
+    from the sampler without further reuse.
+    """
+
+    type = "SamplingDeadBlockBypass"
+    cxx_class = "gem5::bypass_predictor::SamplingDeadBlock"
+    cxx_header = "mem/cache/bypass/sampling.hh"
+
+    threshold = Param.Unsigned(
+        2, "Counter value from which a fill is predicted dead"
+    )
+
+
+class SHiPBypass(SamplingBypassPredictor):
+    """
+    Bypass predictor based on the signature history counter table of "SHiP:
+    Signature-based Hit Predictor for High Performance Caching", by Wu et al.
+    A fill bypasses the cache if none of the recent blocks inserted by the
+    same signature were reused.
+    """
+
+    type = "SHiPBypass"
+    cxx_class = "gem5::bypass_predictor::SHiP"
+    cxx_header = "mem/cache/bypass/sampling.hh"
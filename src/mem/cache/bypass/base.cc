@@ -0,0 +1,106 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/bypass/base.hh"
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/CacheBypass.hh"
+#include "params/BaseBypassPredictor.hh"
+
+namespace gem5
+{
+
+namespace bypass_predictor
+{
+
+Base::Base(const Params &p)
+  : SimObject(p), blkSize(p.block_size), blkShift(floorLog2(p.block_size)),
+    bypassedBlocks(p.filter_entries, MaxAddr), stats(*this)
+{
+    fatal_if(!isPowerOf2(blkSize), "Block size must be a power of two");
+    fatal_if(bypassedBlocks.empty(),
+             "The bypass filter must have at least one entry");
+}
+
+bool
+Base::bypass(const PacketPtr pkt)
+{
+    stats.predictions++;
+    if (!predictBypass(pkt))
+        return false;
+
+    const Addr blk_addr = pkt->getBlockAddr(blkSize);
+    DPRINTF(CacheBypass, "Bypassing fill of %#llx (signature %#llx)\n",
+            blk_addr, signature(pkt));
+
+    filterEntry(blk_addr) = blk_addr;
+    stats.bypasses++;
+    stats.bypassedBytes += blkSize;
+    return true;
+}
+
+void
+Base::notifyAccess(const PacketPtr pkt, bool hit)
+{
+    if (!hit) {
+        const Addr blk_addr = pkt->getBlockAddr(blkSize);
+        Addr &entry = filterEntry(blk_addr);
+        if (entry == blk_addr) {
+            DPRINTF(CacheBypass, "Bypassed block %#llx accessed again\n",
+                    blk_addr);
+            entry = MaxAddr;
+            stats.wrongBypasses++;
+            stats.refetchedBytes += blkSize;
+        }
+    }
+
+    train(pkt);
+}
+
+Base::BypassStats::BypassStats(Base &parent)
+  : statistics::Group(&parent),
+    ADD_STAT(predictions, statistics::units::Count::get(),
+             "Number of fills the predictor was consulted on"),
+    ADD_STAT(bypasses, statistics::units::Count::get(),
+             "Number of fills that bypassed the cache"),
+    ADD_STAT(wrongBypasses, statistics::units::Count::get(),
+             "Number of bypassed blocks that were accessed again"),
+    ADD_STAT(accuracy, statistics::units::Ratio::get(),
+             "Fraction of the bypassed blocks that were not accessed again",
+             (bypasses - wrongBypasses) / bypasses),
+    ADD_STAT(bypassedBytes, statistics::units::Byte::get(),
+             "Bytes of the fills that bypassed the cache"),
+    ADD_STAT(refetchedBytes, statistics::units::Byte::get(),
+             "Bytes fetched again because of wrong bypasses"),
+    ADD_STAT(bytesSaved, statistics::units::Byte::get(),
+             "Fill bandwidth saved by the bypasses",
+             bypassedBytes - refetchedBytes)
+{
+}
+
+} // namespace bypass_predictor
+} // namespace gem5
@@ -0,0 +1,156 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * Definition of the interface of the predictors that decide, on a fill,
+ * whether the block is better not allocated in the cache.
+ */
+
+#ifndef __MEM_CACHE_BYPASS_BASE_HH__
+#define __MEM_CACHE_BYPASS_BASE_HH__
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+struct BaseBypassPredictorParams;
+
+namespace bypass_predictor
+{
+
+/**
+ * Base bypass predictor. The cache consults it on every fill that would
+ * allocate a block, and skips the allocation if the block is predicted to
+ * be dead on arrival; the response is then served from the temporary block,
+ * as it is for a mostly exclusive cache. The predictor sees every access to
+ * the cache so that it can train itself.
+ *
+ * Bypassed blocks are remembered in a small filter, so that a miss on a
+ * block that was recently bypassed is counted as a wrong bypass. The bytes
+ * of the bypassed fills, minus those fetched again because of wrong
+ * bypasses, give the fill bandwidth the predictor saved.
+ */
+class Base : public SimObject
+{
+  protected:
+    /** Cache block size in bytes. */
+    const unsigned blkSize;
+
+    /** Number of bits of the block offset. */
+    const unsigned blkShift;
+
+    /** Block addresses of the recently bypassed fills. */
+    std::vector<Addr> bypassedBlocks;
+
+    /** Get the filter entry of a block address. */
+    Addr &
+    filterEntry(Addr blk_addr)
+    {
+        return bypassedBlocks[(blk_addr >> blkShift) % bypassedBlocks.size()];
+    }
+
+    /**
+     * Get the signature of the access. The PC of the instruction is used
+     * when it is known, and the requestor otherwise.
+     */
+    static Addr
+    signature(const PacketPtr pkt)
+    {
+        return pkt->req->hasPC() ? pkt->req->getPC() :
+            pkt->req->requestorId();
+    }
+
+    /**
+     * Predict whether the block being filled will not be reused.
+     *
+     * @param pkt The response filling the block.
+     * @return Whether the fill should bypass the cache.
+     */
+    virtual bool predictBypass(const PacketPtr pkt) = 0;
+
+    /**
+     * Train the predictor with an access to the cache.
+     *
+     * @param pkt The request accessing the cache.
+     */
+    virtual void train(const PacketPtr pkt) = 0;
+
+    struct BypassStats : public statistics::Group
+    {
+        BypassStats(Base &parent);
+
+        /** Number of fills the predictor was consulted on. */
+        statistics::Scalar predictions;
+
+        /** Number of fills that bypassed the cache. */
+        statistics::Scalar bypasses;
+
+        /** Number of bypassed blocks that were accessed again. */
+        statistics::Scalar wrongBypasses;
+
+        /** Fraction of the bypasses that were not accessed again. */
+        statistics::Formula accuracy;
+
+        /** Bytes of the fills that bypassed the cache. */
+        statistics::Scalar bypassedBytes;
+
+        /** Bytes fetched again because of wrong bypasses. */
+        statistics::Scalar refetchedBytes;
+
+        /** Fill bandwidth saved by the bypasses. */
+        statistics::Formula bytesSaved;
+    } stats;
+
+  public:
+    typedef BaseBypassPredictorParams Params;
+    Base(const Params &p);
+
+    /**
+     * Decide whether a fill should bypass the cache.
+     *
+     * @param pkt The response filling the block.
+     * @return Whether the block should not be allocated.
+     */
+    bool bypass(const PacketPtr pkt);
+
+    /**
+     * Notify the predictor of an access to the cache.
+     *
+     * @param pkt The request accessing the cache.
+     * @param hit Whether the access hit in the cache.
+     */
+    void notifyAccess(const PacketPtr pkt, bool hit);
+};
+
+} // namespace bypass_predictor
+} // namespace gem5
+
+#endif //__MEM_CACHE_BYPASS_BASE_HH__
@@ -0,0 +1,154 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/bypass/sampling.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "params/SHiPBypass.hh"
+#include "params/SamplingBypassPredictor.hh"
+#include "params/SamplingDeadBlockBypass.hh"
+
+namespace gem5
+{
+
+namespace bypass_predictor
+{
+
+Sampling::Sampling(const Params &p, uint8_t initial_counter)
+  : Base(p),
+    numSets(std::max<uint64_t>(1, p.size / (p.block_size * p.assoc))),
+    setStride(numSets / std::max<uint64_t>(1,
+        std::min<uint64_t>(p.sampled_sets, numSets))),
+    sampledSets(numSets / setStride), samplerAssoc(p.sampler_assoc),
+    sampler(sampledSets * samplerAssoc),
+    table(p.table_entries, SatCounter8(p.counter_bits, initial_counter))
+{
+    fatal_if(p.sampled_sets == 0 || samplerAssoc == 0,
+             "The sampler must have at least one entry");
+    fatal_if(table.empty(), "The prediction table must have entries");
+}
+
+SatCounter8 &
+Sampling::counter(Addr signature)
+{
+    return table[(signature ^ (signature >> 2) ^ (signature >> 16)) %
+                 table.size()];
+}
+
+void
+Sampling::train(const PacketPtr pkt)
+{
+    const Addr blk_addr = pkt->getBlockAddr(blkSize);
+    const uint64_t set = (blk_addr >> blkShift) % numSets;
+    if (set % setStride != 0 || set / setStride >= sampledSets)
+        return;
+
+    const Addr sig = signature(pkt);
+    auto begin = sampler.begin() + (set / setStride) * samplerAssoc;
+    auto end = begin + samplerAssoc;
+    samplerTicks++;
+
+    auto hit = std::find_if(begin, end, [blk_addr](const SamplerEntry &e)
+        { return e.valid && e.blkAddr == blk_addr; });
+    if (hit != end) {
+        sampleHit(*hit, sig);
+        hit->reused = true;
+        hit->lastTouch = samplerTicks;
+        return;
+    }
+
+    // Replace an invalid entry if there is one, and the LRU one otherwise
+    auto victim = std::min_element(begin, end,
+        [](const SamplerEntry &a, const SamplerEntry &b)
+        {
+            return a.valid != b.valid ? !a.valid :
+                a.lastTouch < b.lastTouch;
+        });
+    if (victim->valid)
+        sampleEvict(*victim);
+
+    victim->valid = true;
+    victim->reused = false;
+    victim->blkAddr = blk_addr;
+    victim->signature = sig;
+    victim->lastTouch = samplerTicks;
+}
+
+SamplingDeadBlock::SamplingDeadBlock(const Params &p)
+  : Sampling(p, 0), threshold(p.threshold)
+{
+    fatal_if(threshold == 0 || threshold >= (1ULL << p.counter_bits),
+             "The dead block threshold must be a non-zero counter value");
+}
+
+bool
+SamplingDeadBlock::predictBypass(const PacketPtr pkt)
+{
+    return counter(signature(pkt)) >= threshold;
+}
+
+void
+SamplingDeadBlock::sampleHit(SamplerEntry &entry, Addr signature)
+{
+    // The block was not dead after its previous access
+    counter(entry.signature)--;
+    entry.signature = signature;
+}
+
+void
+SamplingDeadBlock::sampleEvict(const SamplerEntry &entry)
+{
+    // The previous access was the last one
+    counter(entry.signature)++;
+}
+
+SHiP::SHiP(const Params &p)
+  : Sampling(p, 1)
+{
+}
+
+bool
+SHiP::predictBypass(const PacketPtr pkt)
+{
+    return counter(signature(pkt)) == 0;
+}
+
+void
+SHiP::sampleHit(SamplerEntry &entry, Addr signature)
+{
+    counter(entry.signature)++;
+}
+
+void
+SHiP::sampleEvict(const SamplerEntry &entry)
+{
+    if (!entry.reused)
+        counter(entry.signature)--;
+}
+
+} // namespace bypass_predictor
+} // namespace gem5
@@ -0,0 +1,164 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * Declaration of the bypass predictors trained by a sampler of the cache
+ * sets: a sampling dead block predictor and a SHiP-style signature
+ * predictor.
+ */
+
+#ifndef __MEM_CACHE_BYPASS_SAMPLING_HH__
+#define __MEM_CACHE_BYPASS_SAMPLING_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/sat_counter.hh"
+#include "base/types.hh"
+#include "mem/cache/bypass/base.hh"
+#include "mem/packet.hh"
+
+namespace gem5
+{
+
+struct SamplingBypassPredictorParams;
+struct SamplingDeadBlockBypassParams;
+struct SHiPBypassParams;
+
+namespace bypass_predictor
+{
+
+/**
+ * A predictor trained by a sampler: a small LRU tag array that mirrors a
+ * few sets of the cache, and keeps a signature for each of its blocks.
+ * Training only happens on the sampled sets, while predictions use the
+ * table of counters indexed by the signature of any fill.
+ */
+class Sampling : public Base
+{
+  protected:
+    /** An entry of the sampler. */
+    struct SamplerEntry
+    {
+        bool valid = false;
+
+        /** Whether the block was accessed since it was inserted. */
+        bool reused = false;
+
+        Addr blkAddr = 0;
+
+        Addr signature = 0;
+
+        /** Last access to the entry, for the LRU replacement. */
+        uint64_t lastTouch = 0;
+    };
+
+    /** Number of sets of the cache. */
+    const uint64_t numSets;
+
+    /** Distance between two sampled sets. */
+    const uint64_t setStride;
+
+    /** Number of sampled sets. */
+    const unsigned sampledSets;
+
+    /** Associativity of each sampled set. */
+    const unsigned samplerAssoc;
+
+    /** The sampled sets' entries, one set after another. */
+    std::vector<SamplerEntry> sampler;
+
+    /** Accesses to the sampler, to order its entries. */
+    uint64_t samplerTicks = 0;
+
+    /** Counters of the prediction table, indexed by signature. */
+    std::vector<SatCounter8> table;
+
+    /** Get the counter of a signature. */
+    SatCounter8 &counter(Addr signature);
+
+    /**
+     * Update the prediction table on a sampler hit.
+     *
+     * @param entry The entry hit, before it is updated.
+     * @param signature The signature of the access.
+     */
+    virtual void sampleHit(SamplerEntry &entry, Addr signature) = 0;
+
+    /**
+     * Update the prediction table on the eviction of a sampler entry.
+     *
+     * @param entry The valid entry being evicted.
+     */
+    virtual void sampleEvict(const SamplerEntry &entry) = 0;
+
+    void train(const PacketPtr pkt) override;
+
+  public:
+    typedef SamplingBypassPredictorParams Params;
+    Sampling(const Params &p, uint8_t initial_counter);
+};
+
+/**
+ * Sampling dead block predictor. The signature of a sampler entry is that
+ * of its last access, so a counter measures how often blocks die after
+ * being touched by its signature.
+ */
+class SamplingDeadBlock : public Sampling
+{
+  protected:
+    /** Counter value from which a fill is predicted dead. */
+    const unsigned threshold;
+
+    bool predictBypass(const PacketPtr pkt) override;
+    void sampleHit(SamplerEntry &entry, Addr signature) override;
+    void sampleEvict(const SamplerEntry &entry) override;
+
+  public:
+    typedef SamplingDeadBlockBypassParams Params;
+    SamplingDeadBlock(const Params &p);
+};
+
+/**
+ * SHiP bypass predictor. The signature of a sampler entry is that of the
+ * fill that inserted it, and a counter measures how often blocks inserted
+ * by its signature are reused.
+ */
+class SHiP : public Sampling
+{
+  protected:
+    bool predictBypass(const PacketPtr pkt) override;
+    void sampleHit(SamplerEntry &entry, Addr signature) override;
+    void sampleEvict(const SamplerEntry &entry) override;
+
+  public:
+    typedef SHiPBypassParams Params;
+    SHiP(const Params &p);
+};
+
+} // namespace bypass_predictor
+} // namespace gem5
+
+#endif //__MEM_CACHE_BYPASS_SAMPLING_HH__
@@ -169,7 +169,8 @@ Cache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
                     "Should never see a write in a read-only cache %s\n",
                     name());
 
-        DPRINTF(Cache, "%s for %s\n", __func__, pkt->print());
+        DPRINTFA(Cache, pkt->getAddr(), "%s for %s\n", __func__,
+                 pkt->print());
 
         // flush and invalidate any existing block
         CacheBlk *old_blk(tags->findBlock({pkt->getAddr(), pkt->isSecure()}));
@@ -266,7 +267,7 @@ Cache::doWritebacksAtomic(PacketList& writebacks)
 void
 Cache::recvTimingSnoopResp(PacketPtr pkt)
 {
-    DPRINTF(Cache, "%s for %s\n", __func__, pkt->print());
+    DPRINTFA(Cache, pkt->getAddr(), "%s for %s\n", __func__, pkt->print());
 
     // determine if the response is from a snoop request we created
     // (in which case it should be in the outstandingSnoop), or if we
@@ -390,7 +391,7 @@ Cache::handleTimingReqMiss(PacketPtr pkt, CacheBlk *blk, Tick forward_time,
 
         if (!mshr) {
             // copy the request and create a new SoftPFReq packet
-            RequestPtr req = std::make_shared<Request>(pkt->req->getPaddr(),
+            RequestPtr req = makeRequest(pkt->req->getPaddr(),
                                                     pkt->req->getSize(),
                                                     pkt->req->getFlags(),
                                                     pkt->req->requestorId());
@@ -870,7 +871,7 @@ Cache::serviceMSHRTargets(MSHR *mshr, const PacketPtr pkt, CacheBlk *blk)
                         assert(pkt->matchAddr(tgt_pkt));
                         assert(pkt->getSize() >= tgt_pkt->getSize());
 
-                        tgt_pkt->setData(pkt->getConstPtr<uint8_t>());
+                        tgt_pkt->setData(pkt);
                     } else {
                         // MSHR targets can read data either from the
                         // block or the response pkt. If we can't get data
@@ -975,7 +976,7 @@ Cache::cleanEvictBlk(CacheBlk *blk)
     assert(blk && blk->isValid() && !blk->isSet(CacheBlk::DirtyBit));
 
     // Creating a zero sized write, a message to the snoop filter
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -158,6 +158,9 @@ class CacheBlk : public TaggedEntry
         invalidate();
     }
 
+    /** @return Whether any context holds a load-locked on the block. */
+    bool hasLoadLocks() const { return !lockList.empty(); }
+
     CacheBlk(const CacheBlk&) = delete;
     CacheBlk& operator=(const CacheBlk&) = delete;
     CacheBlk(const CacheBlk&&) = delete;
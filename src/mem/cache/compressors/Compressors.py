@@ -63,6 +63,11 @@ class BaseCacheCompressor(SimObject):
         "Number of extra cycles required "
         "to finish decompression (e.g., due to shifting and packaging).",
     )
+    memo_entries = Param.Unsigned(
+        0,
+        "Number of recently compressed lines whose results are reused "
+        "when the same data is compressed again (0 disables it)",
+    )
 
 
 class BaseDictionaryCompressor(BaseCacheCompressor):
@@ -36,6 +36,7 @@
 #include <climits>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <string>
 
 #include "base/logging.hh"
@@ -81,6 +82,34 @@ Base::CompressionData::getSize() const
     return std::ceil(_size/(float)CHAR_BIT);
 }
 
+/** Holds a copy of the line, which is all decompression needs. */
+class Base::MemoCompData : public CompressionData
+{
+  public:
+    std::vector<uint64_t> line;
+
+    MemoCompData(const uint64_t* data, std::size_t words)
+        : line(data, data + words)
+    {}
+};
+
+namespace
+{
+
+uint64_t
+hashLine(const uint64_t* data, std::size_t words)
+{
+    // Independent per word so that the loop vectorizes
+    uint64_t hash = 0;
+    for (std::size_t i = 0; i < words; i++) {
+        hash += (data[i] ^ (i * 0x9e3779b97f4a7c15ULL)) *
+            0xbf58476d1ce4e5b9ULL;
+    }
+    return hash ^ (hash >> 31);
+}
+
+} // anonymous namespace
+
 Base::Base(const Params &p)
   : SimObject(p), blkSize(p.block_size), chunkSizeBits(p.chunk_size_bits),
     sizeThreshold((blkSize * p.size_threshold_percentage) / 100),
@@ -88,7 +117,8 @@ Base::Base(const Params &p)
     compExtraLatency(p.comp_extra_latency),
     decompChunksPerCycle(p.decomp_chunks_per_cycle),
     decompExtraLatency(p.decomp_extra_latency),
-    cache(nullptr), stats(*this)
+    cache(nullptr), memo(p.memo_entries),
+    memoLines(p.memo_entries * (blkSize / sizeof(uint64_t))), stats(*this)
 {
     fatal_if(64 % chunkSizeBits,
         "64 must be a multiple of the chunk granularity.");
@@ -113,20 +143,33 @@ Base::setCache(BaseCache *_cache)
 std::vector<Base::Chunk>
 Base::toChunks(const uint64_t* data) const
 {
+    std::vector<Chunk> chunks;
+    toChunks(data, chunks);
+    return chunks;
+}
+
+void
+Base::toChunks(const uint64_t* data, std::vector<Chunk>& chunks) const
+{
+    chunks.resize((blkSize * CHAR_BIT) / chunkSizeBits);
+
+    // Special case the whole-word chunks, which are a plain copy
+    if (chunkSizeBits == 64) {
+        std::memcpy(chunks.data(), data, blkSize);
+        return;
+    }
+
     // Number of chunks in a 64-bit value
     const unsigned num_chunks_per_64 =
         (sizeof(uint64_t) * CHAR_BIT) / chunkSizeBits;
+    const uint64_t chunk_mask = mask(chunkSizeBits);
 
     // Turn a 64-bit array into a chunkSizeBits-array
-    std::vector<Chunk> chunks((blkSize * CHAR_BIT) / chunkSizeBits, 0);
-    for (int i = 0; i < chunks.size(); i++) {
-        const int index_64 = std::floor(i / (double)num_chunks_per_64);
+    for (std::size_t i = 0; i < chunks.size(); i++) {
         const unsigned start = i % num_chunks_per_64;
-        chunks[i] = bits(data[index_64],
-            (start + 1) * chunkSizeBits - 1, start * chunkSizeBits);
+        chunks[i] = (data[i / num_chunks_per_64] >> (start * chunkSizeBits)) &
+            chunk_mask;
     }
-
-    return chunks;
 }
 
 void
@@ -138,20 +181,54 @@ Base::fromChunks(const std::vector<Chunk>& chunks, uint64_t* data) const
 
     // Turn a chunkSizeBits-array into a 64-bit array
     std::memset(data, 0, blkSize);
-    for (int i = 0; i < chunks.size(); i++) {
-        const int index_64 = std::floor(i / (double)num_chunks_per_64);
+    for (std::size_t i = 0; i < chunks.size(); i++) {
         const unsigned start = i % num_chunks_per_64;
-        replaceBits(data[index_64], (start + 1) * chunkSizeBits - 1,
-            start * chunkSizeBits, chunks[i]);
+        replaceBits(data[i / num_chunks_per_64],
+            (start + 1) * chunkSizeBits - 1, start * chunkSizeBits, chunks[i]);
+    }
+}
+
+void
+Base::decompressLine(const CompressionData* comp_data, uint64_t* cache_line)
+{
+    auto* memo_data = dynamic_cast<const MemoCompData*>(comp_data);
+    if (memo_data) {
+        std::memcpy(cache_line, memo_data->line.data(), blkSize);
+    } else {
+        decompress(comp_data, cache_line);
     }
 }
 
 std::unique_ptr<Base::CompressionData>
 Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
 {
-    // Apply compression
-    std::unique_ptr<CompressionData> comp_data =
-        compress(toChunks(data), comp_lat, decomp_lat);
+    const std::size_t words = blkSize / sizeof(uint64_t);
+    MemoEntry* memo_entry = nullptr;
+    uint64_t* memo_line = nullptr;
+    if (!memo.empty()) {
+        const std::size_t index = hashLine(data, words) % memo.size();
+        memo_entry = &memo[index];
+        memo_line = &memoLines[index * words];
+    }
+
+    // Apply compression, unless this line was compressed recently
+    std::unique_ptr<CompressionData> comp_data;
+    if (memo_entry && memo_entry->valid &&
+        !std::memcmp(memo_line, data, blkSize)) {
+        comp_data = std::make_unique<MemoCompData>(data, words);
+        comp_data->setSizeBits(memo_entry->sizeBits);
+        comp_lat = memo_entry->compLat;
+        decomp_lat = memo_entry->decompLat;
+        stats.memoHits++;
+    } else {
+        toChunks(data, chunkBuffer);
+        comp_data = compress(chunkBuffer, comp_lat, decomp_lat);
+        if (memo_entry) {
+            *memo_entry = {true, comp_data->getSizeBits(), comp_lat,
+                           decomp_lat};
+            std::memcpy(memo_line, data, blkSize);
+        }
+    }
 
     // If we are in debug mode apply decompression just after the compression.
     // If the results do not match, we've got an error
@@ -159,7 +236,7 @@ Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
     uint64_t decomp_data[blkSize/8];
 
     // Apply decompression
-    decompress(comp_data.get(), decomp_data);
+    decompressLine(comp_data.get(), decomp_data);
 
     // Check if decompressed line matches original cache line
     fatal_if(std::memcmp(data, decomp_data, blkSize),
@@ -245,7 +322,10 @@ Base::BaseStats::BaseStats(Base& _compressor)
                 statistics::units::Bit, statistics::units::Count>::get(),
              "Average compression size"),
     ADD_STAT(decompressions, statistics::units::Count::get(),
-             "Total number of decompressions")
+             "Total number of decompressions"),
+    ADD_STAT(memoHits, statistics::units::Count::get(),
+             "Number of compressions whose result was reused from a "
+             "recent compression of the same data")
 {
 }
 
@@ -37,6 +37,7 @@
 #define __MEM_CACHE_COMPRESSORS_BASE_HH__
 
 #include <cstdint>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "base/statistics.hh"
@@ -128,6 +129,31 @@ class Base : public SimObject
     /** Pointer to the parent cache. */
     BaseCache* cache;
 
+    /** Compression result of a recently compressed line. */
+    struct MemoEntry
+    {
+        bool valid = false;
+        std::size_t sizeBits = 0;
+        Cycles compLat;
+        Cycles decompLat;
+    };
+
+    /**
+     * Direct-mapped table of recent results, indexed by a hash of the
+     * line. Lines such as zero pages are compressed over and over, and
+     * always give the same result.
+     */
+    std::vector<MemoEntry> memo;
+
+    /** The lines of the memo entries, blkSize bytes each. */
+    std::vector<uint64_t> memoLines;
+
+    /** Chunks of the line being compressed, reused between lines. */
+    std::vector<Chunk> chunkBuffer;
+
+    /** Compression data of a line whose result was found in the memo. */
+    class MemoCompData;
+
     struct BaseStats : public statistics::Group
     {
         const Base& compressor;
@@ -153,6 +179,9 @@ class Base : public SimObject
 
         /** Number of decompressions performed. */
         statistics::Scalar decompressions;
+
+        /** Number of compressions whose result was found in the memo. */
+        statistics::Scalar memoHits;
     } stats;
 
     /**
@@ -164,6 +193,15 @@ class Base : public SimObject
      */
     std::vector<Chunk> toChunks(const uint64_t* data) const;
 
+    /**
+     * Split the raw data into chunks without allocating, reusing the
+     * storage of the given vector.
+     *
+     * @param data The raw pointer to the data being compressed.
+     * @param chunks Filled with the sequential chunks of the data.
+     */
+    void toChunks(const uint64_t* data, std::vector<Chunk>& chunks) const;
+
     /**
      * This function re-joins the chunks to recreate the original data.
      *
@@ -197,6 +235,16 @@ class Base : public SimObject
     virtual void decompress(const CompressionData* comp_data,
                               uint64_t* cache_line) = 0;
 
+    /**
+     * Decompress data returned by compress(), which may come from the
+     * memo rather than the compressor itself.
+     *
+     * @param comp_data Compressed cache line.
+     * @param cache_line The cache line to be decompressed.
+     */
+    void decompressLine(const CompressionData* comp_data,
+                        uint64_t* cache_line);
+
   public:
     typedef BaseCacheCompressorParams Params;
     Base(const Params &p);
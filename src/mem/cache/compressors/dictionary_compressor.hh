@@ -167,6 +167,22 @@ class DictionaryCompressor : public BaseDictionaryCompressor
                                                     match_location);
             }
         }
+
+        /**
+         * Get the size of the pattern the input would match, without
+         * allocating it. The pattern is built on the stack instead.
+         */
+        static std::size_t
+        getSizeBits(const DictionaryEntry& bytes,
+            const DictionaryEntry& dict_bytes, const int match_location)
+        {
+            if (Head::isPattern(bytes, dict_bytes, match_location)) {
+                return Head(bytes, match_location).getSizeBits();
+            } else {
+                return Factory<Tail...>::getSizeBits(bytes, dict_bytes,
+                                                     match_location);
+            }
+        }
     };
 
     /**
@@ -188,6 +204,13 @@ class DictionaryCompressor : public BaseDictionaryCompressor
         {
             return std::unique_ptr<Pattern>(new Head(bytes, match_location));
         }
+
+        static std::size_t
+        getSizeBits(const DictionaryEntry& bytes,
+            const DictionaryEntry& dict_bytes, const int match_location)
+        {
+            return Head(bytes, match_location).getSizeBits();
+        }
     };
 
     /** The dictionary. */
@@ -202,6 +225,19 @@ class DictionaryCompressor : public BaseDictionaryCompressor
     getPattern(const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
         const int match_location) const = 0;
 
+    /**
+     * Get the size, in bits, of the pattern getPattern() would return.
+     * Used to choose the best dictionary match before allocating any
+     * pattern. Classes that inherit from this base class should override
+     * it with the call to their factory's getSizeBits.
+     */
+    virtual std::size_t
+    getPatternSizeBits(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes, const int match_location) const
+    {
+        return getPattern(bytes, dict_bytes, match_location)->getSizeBits();
+    }
+
     /**
      * Compress data.
      *
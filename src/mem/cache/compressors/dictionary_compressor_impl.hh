@@ -99,21 +99,26 @@ DictionaryCompressor<T>::compressValue(const T data)
 
     // Start as a no-match pattern. A negative match location is used so that
     // patterns that depend on the dictionary entry don't match
-    std::unique_ptr<Pattern> pattern =
-        getPattern(bytes, toDictionaryEntry(0), -1);
+    const DictionaryEntry no_match = toDictionaryEntry(0);
+    int best_location = -1;
+    std::size_t best_size = getPatternSizeBits(bytes, no_match, -1);
 
-    // Search for word on dictionary
+    // Search for word on dictionary. Only the sizes are compared here, so
+    // that a single pattern is allocated per value
     for (std::size_t i = 0; i < numEntries; i++) {
-        // Try matching input with possible patterns
-        std::unique_ptr<Pattern> temp_pattern =
-            getPattern(bytes, dictionary[i], i);
+        const std::size_t size = getPatternSizeBits(bytes, dictionary[i], i);
 
         // Check if found pattern is better than previous
-        if (temp_pattern->getSizeBits() < pattern->getSizeBits()) {
-            pattern = std::move(temp_pattern);
+        if (size < best_size) {
+            best_size = size;
+            best_location = i;
         }
     }
 
+    std::unique_ptr<Pattern> pattern = (best_location < 0) ?
+        getPattern(bytes, no_match, -1) :
+        getPattern(bytes, dictionary[best_location], best_location);
+
     // Update stats
     dictionaryStats.patterns[pattern->getPatternNumber()]++;
 
@@ -137,6 +142,7 @@ DictionaryCompressor<T>::compress(const std::vector<Chunk>& chunks)
 
     // Compress every value sequentially
     CompData* const comp_data_ptr = static_cast<CompData*>(comp_data.get());
+    comp_data_ptr->entries.reserve(chunks.size());
     for (const auto& value : chunks) {
         std::unique_ptr<Pattern> pattern = compressValue(value);
         DPRINTF(CacheComp, "Compressed %016x to %s\n", value,
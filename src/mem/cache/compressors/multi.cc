@@ -138,8 +138,9 @@ Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
 
     // Each sub-compressor can have its own chunk size; therefore, revert
     // the chunks to raw data, so that they handle the conversion internally
-    auto data = std::make_unique<uint64_t[]>(blkSize/8);
-    fromChunks(chunks, data.get());
+    lineBuffer.resize(blkSize/8);
+    uint64_t* const data = lineBuffer.data();
+    fromChunks(chunks, data);
 
     // Find the ranking of the compressor outputs
     std::priority_queue<std::shared_ptr<Results>,
@@ -148,7 +149,7 @@ Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
     for (unsigned i = 0; i < compressors.size(); i++) {
         Cycles temp_decomp_lat;
         auto temp_comp_data =
-            compressors[i]->compress(data.get(), comp_lat, temp_decomp_lat);
+            compressors[i]->compress(data, comp_lat, temp_decomp_lat);
         temp_comp_data->setSizeBits(temp_comp_data->getSizeBits() +
             numEncodingBits);
         results.push(std::make_shared<Results>(i, std::move(temp_comp_data),
@@ -184,7 +185,7 @@ Multi::decompress(const CompressionData* comp_data,
 {
     const MultiCompData* casted_comp_data =
         static_cast<const MultiCompData*>(comp_data);
-    compressors[casted_comp_data->getIndex()]->decompress(
+    compressors[casted_comp_data->getIndex()]->decompressLine(
         casted_comp_data->compData.get(), cache_line);
 }
 
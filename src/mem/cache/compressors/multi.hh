@@ -86,6 +86,9 @@ class Multi : public Base
      */
     const Cycles extraDecompressionLatency;
 
+    /** The line being compressed, rebuilt from its chunks. */
+    std::vector<uint64_t> lineBuffer;
+
     struct MultiStats : public statistics::Group
     {
         const Multi& compressor;
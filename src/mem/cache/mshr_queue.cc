@@ -54,8 +54,10 @@ namespace gem5
 
 MSHRQueue::MSHRQueue(const std::string &_label,
                      int num_entries, int reserve,
-                     int demand_reserve, std::string cache_name = "")
-    : Queue<MSHR>(_label, num_entries, reserve, cache_name + ".mshr_queue"),
+                     int demand_reserve, std::string cache_name,
+                     bool hash_index)
+    : Queue<MSHR>(_label, num_entries, reserve, cache_name + ".mshr_queue",
+                  hash_index),
       demandReserve(demand_reserve)
 {}
 
@@ -72,7 +74,7 @@ MSHRQueue::allocate(Addr blk_addr, unsigned blk_size, PacketPtr pkt,
             allocatedList.size() + 1, numEntries);
 
     mshr->allocate(blk_addr, blk_size, pkt, when_ready, order, alloc_on_fill);
-    mshr->allocIter = allocatedList.insert(allocatedList.end(), mshr);
+    mshr->allocIter = addToAllocatedList(mshr);
     mshr->readyIter = addToReadyList(mshr);
 
     allocated += 1;
@@ -36,6 +36,7 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+from m5.objects.BloomFilters import *
 from m5.objects.ClockedObject import ClockedObject
 from m5.objects.IndexingPolicies import *
 from m5.objects.ReplacementPolicies import *
@@ -64,7 +65,11 @@ class BasePrefetcher(ClockedObject):
     abstract = True
     cxx_class = "gem5::prefetch::Base"
     cxx_header = "mem/cache/prefetch/base.hh"
-    cxx_exports = [PyBindMethod("addEventProbe"), PyBindMethod("addMMU")]
+    cxx_exports = [
+        PyBindMethod("addEventProbe"),
+        PyBindMethod("addMMU"),
+        PyBindMethod("addUpperCache"),
+    ]
     sys = Param.System(Parent.any, "System this prefetcher belongs to")
 
     # Get the block size from the parent (system)
@@ -94,6 +99,7 @@ class BasePrefetcher(ClockedObject):
         super().__init__(**kwargs)
         self._events = []
         self._mmus = []
+        self._upper_caches = []
 
     def addEvent(self, newObject):
         self._events.append(newObject)
@@ -105,6 +111,8 @@ class BasePrefetcher(ClockedObject):
             self.getCCObject().addMMU(mmu.getCCObject())
         for event in self._events:
             event.register()
+        for cache in self._upper_caches:
+            self.getCCObject().addUpperCache(cache.getCCObject())
         self.getCCObject().regProbeListeners()
 
     def listenFromProbe(self, simObj, *probeNames):
@@ -114,6 +122,14 @@ class BasePrefetcher(ClockedObject):
             raise TypeError("probeNames must have at least one element")
         self.addEvent(HWPProbeEvent(self, simObj, *probeNames))
 
+    # Train on the misses and issued prefetches of an upper-level cache,
+    # and drop the prefetches it is already fetching. The parent cache
+    # still notifies this prefetcher as usual.
+    def hintFromCache(self, simObj):
+        if not isinstance(simObj, SimObject):
+            raise TypeError("argument must be a SimObject type")
+        self._upper_caches.append(simObj)
+
     def registerMMU(self, simObj):
         if not isinstance(simObj, SimObject):
             raise TypeError("argument must be a SimObject type")
@@ -128,6 +144,18 @@ class MultiPrefetcher(BasePrefetcher):
     prefetchers = VectorParam.BasePrefetcher([], "Array of prefetchers")
 
 
+class DuelingPrefetcher(BasePrefetcher):
+    type = "DuelingPrefetcher"
+    cxx_class = "gem5::prefetch::Dueling"
+    cxx_header = "mem/cache/prefetch/dueling.hh"
+
+    dueling = Param.SetDueling(
+        SetDueling(), "Duel deciding which prefetcher each set uses"
+    )
+    prefetcher_a = Param.BasePrefetcher("Sub-prefetcher A")
+    prefetcher_b = Param.BasePrefetcher("Sub-prefetcher B")
+
+
 class QueuedPrefetcher(BasePrefetcher):
     type = "QueuedPrefetcher"
     abstract = True
@@ -164,6 +192,42 @@ class QueuedPrefetcher(BasePrefetcher):
         that can be throttled depending on the accuracy of the prefetcher.",
     )
 
+    # Feedback-directed prefetching: every epoch the accuracy, lateness and
+    # cache pollution of the prefetcher are estimated, and the maximum
+    # number of prefetches generated per access is chosen among
+    # fdp_degrees accordingly
+    use_feedback = Param.Bool(
+        False, "Throttle the prefetch degree with accuracy feedback"
+    )
+    fdp_epoch = Param.Unsigned(
+        4096, "Number of observed accesses per feedback epoch"
+    )
+    fdp_accuracy_high = Param.Float(
+        0.75, "Accuracy from which the prefetcher is accurate"
+    )
+    fdp_accuracy_low = Param.Float(
+        0.40, "Accuracy below which the prefetcher is inaccurate"
+    )
+    fdp_lateness_threshold = Param.Float(
+        0.01, "Fraction of late useful prefetches deemed late"
+    )
+    fdp_pollution_threshold = Param.Float(
+        0.005, "Fraction of demand misses caused by prefetches deemed "
+        "polluting",
+    )
+    fdp_degrees = VectorParam.Unsigned(
+        [1, 2, 4, 8, 16], "Prefetch degree of each aggressiveness level"
+    )
+    fdp_initial_level = Param.Unsigned(
+        2, "Aggressiveness level used before the first epoch ends"
+    )
+    fdp_pollution_filter = Param.BloomFilterBase(
+        BloomFilterBlock(
+            size=4096, masks_lsbs=[0, 12], masks_sizes=[12, 12]
+        ),
+        "Filter of the blocks evicted by prefetch fills",
+    )
+
 
 class GHBPrefetcher(QueuedPrefetcher):
     type = "GHBPrefetcher"
@@ -179,6 +243,15 @@ class GHBPrefetcher(QueuedPrefetcher):
     confidence_threshold = Param.Percent(
         60, "Minimum percentage for delta correlation confidence"
     )
+    index_table_size = Param.MemorySize(
+        "2KiB", "Storage of the index table of each correlation key"
+    )
+    pattern_table_size = Param.MemorySize(
+        "16KiB", "Storage of the delta pattern table"
+    )
+    table_assoc = Param.Unsigned(
+        8, "Associativity of the index and pattern tables"
+    )
 
 
 class StridePrefetcherHashedSetAssociative(TaggedSetAssociative):
@@ -620,9 +693,45 @@ class SmsPrefetcher(QueuedPrefetcher):
     type = "SmsPrefetcher"
     cxx_class = "gem5::prefetch::Sms"
     cxx_header = "mem/cache/prefetch/sms.hh"
+    region_size = Param.Unsigned(4096, "Spatial region size")
+
     ft_size = Param.Unsigned(64, "Size of Filter and Active generation table")
+    ft_assoc = Param.Unsigned(Self.ft_size, "Associativity of the FT")
+    ft_indexing_policy = Param.TaggedIndexingPolicy(
+        TaggedSetAssociative(
+            entry_size=1, assoc=Parent.ft_assoc, size=Parent.ft_size
+        ),
+        "Indexing policy of the filter table",
+    )
+    ft_replacement_policy = Param.BaseReplacementPolicy(
+        FIFORP(), "Replacement policy of the filter table"
+    )
+
+    agt_size = Param.Unsigned(
+        Self.ft_size, "Size of the active generation table"
+    )
+    agt_assoc = Param.Unsigned(Self.agt_size, "Associativity of the AGT")
+    agt_indexing_policy = Param.TaggedIndexingPolicy(
+        TaggedSetAssociative(
+            entry_size=1, assoc=Parent.agt_assoc, size=Parent.agt_size
+        ),
+        "Indexing policy of the active generation table",
+    )
+    agt_replacement_policy = Param.BaseReplacementPolicy(
+        LRURP(), "Replacement policy of the active generation table"
+    )
+
     pht_size = Param.Unsigned(16384, "Size of pattern history table")
-    region_size = Param.Unsigned(4096, "Spatial region size")
+    pht_assoc = Param.Unsigned(16, "Associativity of the PHT")
+    pht_indexing_policy = Param.TaggedIndexingPolicy(
+        TaggedSetAssociative(
+            entry_size=1, assoc=Parent.pht_assoc, size=Parent.pht_size
+        ),
+        "Indexing policy of the pattern history table",
+    )
+    pht_replacement_policy = Param.BaseReplacementPolicy(
+        LRURP(), "Replacement policy of the pattern history table"
+    )
 
     queue_squash = True
     queue_filter = True
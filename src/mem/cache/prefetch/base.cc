@@ -92,6 +92,12 @@ Base::PrefetchListener::notify(const CacheAccessProbeArg &arg)
     }
 }
 
+void
+Base::HintListener::notify(const CacheAccessProbeArg &arg)
+{
+    parent.hintNotify(arg);
+}
+
 void
 Base::PrefetchEvictListener::notify(const EvictionInfo &info)
 {
@@ -110,7 +116,7 @@ Base::Base(const BasePrefetcherParams &p)
       prefetchOnPfHit(p.prefetch_on_pf_hit),
       useVirtualAddresses(p.use_virtual_addresses),
       prefetchStats(this), issuedPrefetches(0),
-      usefulPrefetches(0), mmu(nullptr)
+      usefulPrefetches(0), latePrefetches(0), mmu(nullptr)
 {
 }
 
@@ -149,7 +155,13 @@ Base::StatGroup::StatGroup(statistics::Group *parent)
     ADD_STAT(pfHitInWB, statistics::units::Count::get(),
         "number of prefetches hit in the Write Buffer"),
     ADD_STAT(pfLate, statistics::units::Count::get(),
-        "number of late prefetches (hitting in cache, MSHR or WB)")
+        "number of late prefetches (hitting in cache, MSHR or WB)"),
+    ADD_STAT(pfLateDemand, statistics::units::Count::get(),
+        "number of demands that found their prefetch still in flight"),
+    ADD_STAT(pfHints, statistics::units::Count::get(),
+        "number of upper-level misses and prefetches trained on"),
+    ADD_STAT(pfInUpperMSHR, statistics::units::Count::get(),
+        "number of prefetches filtered by an upper-level MSHR")
 {
     using namespace statistics;
 
@@ -268,6 +280,42 @@ Base::probeNotify(const CacheAccessProbeArg &acc, bool miss)
     }
 }
 
+void
+Base::hintNotify(const CacheAccessProbeArg &acc)
+{
+    const PacketPtr pkt = acc.pkt;
+
+    if (pkt->cmd.isSWPrefetch()) return;
+    if (pkt->req->isCacheMaintenance()) return;
+    if (pkt->isEviction()) return;
+    if (pkt->isWrite() && acc.cache.coalesce()) return;
+    if (!pkt->req->hasPaddr()) return;
+
+    // Both the misses and the prefetches of the upper level will reach
+    // this cache, so they are observed as misses
+    if (!observeAccess(pkt, true, false)) return;
+
+    prefetchStats.pfHints++;
+    if (useVirtualAddresses && pkt->req->hasVaddr()) {
+        PrefetchInfo pfi(pkt, pkt->req->getVaddr(), true);
+        notify(acc, pfi);
+    } else if (!useVirtualAddresses) {
+        PrefetchInfo pfi(pkt, pkt->req->getPaddr(), true);
+        notify(acc, pfi);
+    }
+}
+
+bool
+Base::inUpperMissQueue(Addr addr, bool is_secure) const
+{
+    for (const CacheAccessor *cache : upperCaches) {
+        if (cache->inMissQueue(addr, is_secure)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void
 Base::regProbeListeners()
 {
@@ -295,6 +343,19 @@ Base::addEventProbe(SimObject *obj, const char *name)
     listeners.push_back(pm->connect<PrefetchListener>(*this, name));
 }
 
+void
+Base::addUpperCache(SimObject *obj)
+{
+    BaseCache *cache = dynamic_cast<BaseCache *>(obj);
+    fatal_if(!cache, "%s: hints can only come from a cache", obj->name());
+    upperCaches.push_back(&cache->getCacheAccessor());
+
+    ProbeManager *pm = obj->getProbeManager();
+    hintListeners.push_back(pm->connect<HintListener>(*this, "Miss"));
+    hintListeners.push_back(
+        pm->connect<HintListener>(*this, "PrefetchIssue"));
+}
+
 void
 Base::addMMU(BaseMMU *m)
 {
@@ -101,8 +101,26 @@ class Base : public ClockedObject
         Base &parent;
     };
 
+    /**
+     * Listener of the miss stream and of the issued prefetches of an
+     * upper-level cache.
+     */
+    class HintListener : public ProbeListenerArgBase<CacheAccessProbeArg>
+    {
+      public:
+        HintListener(Base &_parent, std::string name)
+            : ProbeListenerArgBase(std::move(name)), parent(_parent)
+        {}
+        void notify(const CacheAccessProbeArg &arg) override;
+      protected:
+        Base &parent;
+    };
+
     std::vector<ProbeListenerPtr<>> listeners;
 
+    /** Listeners of the upper-level caches, kept apart from listeners */
+    std::vector<ProbeListenerPtr<>> hintListeners;
+
   public:
 
     /**
@@ -368,16 +386,41 @@ class Base : public ClockedObject
         /** The number of times a HW-prefetch is late
          * (hit in cache, MSHR, WB). */
         statistics::Formula pfLate;
+
+        /** The number of demand accesses that coalesced with an in-flight
+         * prefetch. */
+        statistics::Scalar pfLateDemand;
+
+        /** The number of upper-level misses and prefetches trained on. */
+        statistics::Scalar pfHints;
+
+        /** The number of prefetches dropped because an upper-level cache
+         * was already fetching the block. */
+        statistics::Scalar pfInUpperMSHR;
     } prefetchStats;
 
     /** Total prefetches issued */
     uint64_t issuedPrefetches;
     /** Total prefetches that has been useful */
     uint64_t usefulPrefetches;
+    /** Total demand accesses that found their prefetch still in flight */
+    uint64_t latePrefetches;
 
     /** Registered mmu for address translations */
     BaseMMU * mmu;
 
+    /** Upper-level caches sending hints to this prefetcher */
+    std::vector<CacheAccessor *> upperCaches;
+
+    /**
+     * Determine whether an upper-level cache is already fetching a block,
+     * in which case prefetching it here is redundant.
+     * @param addr Address of the block
+     * @param is_secure Whether the block is in the secure space
+     * @return True if the block is in the miss queue of an upper cache
+     */
+    bool inUpperMissQueue(Addr addr, bool is_secure) const;
+
   public:
     Base(const BasePrefetcherParams &p);
     virtual ~Base() = default;
@@ -400,6 +443,20 @@ class Base : public ClockedObject
     virtual void notifyEvict(const EvictionInfo &info)
     {}
 
+    /**
+     * Notify prefetcher that a prefetch fill is evicting a valid block.
+     * @param addr Block address of the evicted block
+     */
+    virtual void notifyPrefetchEviction(Addr addr)
+    {}
+
+    /**
+     * Notify prefetcher of a demand miss that did not hit in an MSHR.
+     * @param addr Block address of the missing access
+     */
+    virtual void notifyDemandMiss(Addr addr)
+    {}
+
     virtual PacketPtr getPacket() = 0;
 
     virtual Tick nextPrefetchReadyTime() const = 0;
@@ -410,6 +467,13 @@ class Base : public ClockedObject
         prefetchStats.pfUnused++;
     }
 
+    void
+    prefetchLate()
+    {
+        prefetchStats.pfLateDemand++;
+        latePrefetches++;
+    }
+
     void
     incrDemandMhsrMisses()
     {
@@ -446,6 +510,13 @@ class Base : public ClockedObject
      */
     void probeNotify(const CacheAccessProbeArg &acc, bool miss);
 
+    /**
+     * Process a miss or an issued prefetch of an upper-level cache. They
+     * train this prefetcher as if they were misses of its own cache.
+     * @param acc probe arg encapsulating the upper-level request
+     */
+    void hintNotify(const CacheAccessProbeArg &acc);
+
     /**
      * Add a SimObject and a probe name to listen events from
      * @param obj The SimObject pointer to listen from
@@ -453,6 +524,14 @@ class Base : public ClockedObject
      */
     void addEventProbe(SimObject *obj, const char *name);
 
+    /**
+     * Train on the miss stream and on the issued prefetches of an
+     * upper-level cache, and do not prefetch blocks it is already
+     * fetching. The listeners of the parent cache are kept.
+     * @param obj The upper-level cache
+     */
+    void addUpperCache(SimObject *obj);
+
     /**
      * Add a BaseMMU object to be used whenever a translation is needed.
      * This is generally required when the prefetcher is allowed to generate
@@ -0,0 +1,112 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/prefetch/dueling.hh"
+
+#include <algorithm>
+
+#include "base/logging.hh"
+#include "mem/cache/tags/set_dueling.hh"
+#include "params/DuelingPrefetcher.hh"
+
+namespace gem5
+{
+
+namespace prefetch
+{
+
+Dueling::Dueling(const DuelingPrefetcherParams &p)
+  : Base(p), dueling(p.dueling), prefetcherA(p.prefetcher_a),
+    prefetcherB(p.prefetcher_b), lastChoseB(false), duelingStats(this)
+{
+    fatal_if(!dueling || !prefetcherA || !prefetcherB,
+        "The dueling prefetcher requires a duel and two prefetchers");
+}
+
+void
+Dueling::setParentInfo(System *sys, ProbeManager *pm, unsigned blk_size)
+{
+    // This prefetcher listens to the cache too, to sample its misses
+    Base::setParentInfo(sys, pm, blk_size);
+    prefetcherA->setParentInfo(sys, pm, blk_size);
+    prefetcherB->setParentInfo(sys, pm, blk_size);
+}
+
+Tick
+Dueling::nextPrefetchReadyTime() const
+{
+    return std::min(prefetcherA->nextPrefetchReadyTime(),
+                    prefetcherB->nextPrefetchReadyTime());
+}
+
+void
+Dueling::notify(const CacheAccessProbeArg &arg, const PrefetchInfo &pfi)
+{
+    if (pfi.isCacheMiss()) {
+        dueling->sampleMiss(pfi.getAddr());
+    }
+}
+
+PacketPtr
+Dueling::getPacket()
+{
+    // Alternate priority between the prefetchers, and keep draining the
+    // candidates that belong to the losing prefetcher
+    lastChoseB = !lastChoseB;
+    bool is_b = lastChoseB;
+    for (int tries = 0; tries < 2; tries++, is_b = !is_b) {
+        Base *pf = is_b ? prefetcherB : prefetcherA;
+        while (pf->nextPrefetchReadyTime() <= curTick()) {
+            PacketPtr pkt = pf->getPacket();
+            panic_if(!pkt, "Prefetcher is ready but didn't return a packet.");
+            if (dueling->selectB(pkt->getAddr()) == is_b) {
+                prefetchStats.pfIssued++;
+                issuedPrefetches++;
+                return pkt;
+            }
+
+            if (is_b) {
+                duelingStats.pfDroppedB++;
+            } else {
+                duelingStats.pfDroppedA++;
+            }
+            delete pkt;
+        }
+    }
+
+    return nullptr;
+}
+
+Dueling::DuelingStats::DuelingStats(statistics::Group *parent)
+  : statistics::Group(parent, "dueling"),
+    ADD_STAT(pfDroppedA, statistics::units::Count::get(),
+             "Prefetches of A dropped since their set uses B"),
+    ADD_STAT(pfDroppedB, statistics::units::Count::get(),
+             "Prefetches of B dropped since their set uses A")
+{
+}
+
+} // namespace prefetch
+} // namespace gem5
@@ -0,0 +1,92 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_PREFETCH_DUELING_HH__
+#define __MEM_CACHE_PREFETCH_DUELING_HH__
+
+#include "base/statistics.hh"
+#include "mem/cache/prefetch/base.hh"
+
+namespace gem5
+{
+
+class SetDueling;
+struct DuelingPrefetcherParams;
+
+namespace prefetch
+{
+
+/**
+ * Choose at runtime between two prefetchers through set dueling. Both
+ * sub-prefetchers are trained on every access, but a prefetch is only
+ * issued if it was generated by the prefetcher selected for the set of
+ * its address; the other prefetcher's candidates are dropped. The misses
+ * of the sampled sets decide which prefetcher the follower sets use.
+ */
+class Dueling : public Base
+{
+  public: // SimObject
+    Dueling(const DuelingPrefetcherParams &p);
+
+  public:
+    void
+    setParentInfo(System *sys, ProbeManager *pm, unsigned blk_size) override;
+    PacketPtr getPacket() override;
+    Tick nextPrefetchReadyTime() const override;
+
+    /**
+     * The sub-prefetchers get their notifications through their own
+     * probes, so this is only used to feed the misses to the duel.
+     */
+    void
+    notify(const CacheAccessProbeArg &arg, const PrefetchInfo &pfi) override;
+
+    void notifyFill(const CacheAccessProbeArg &arg) override {};
+
+  protected:
+    /** The duel between the prefetchers. */
+    SetDueling *dueling;
+
+    /** The sub-prefetchers: A is team "false", B is team "true". */
+    Base *prefetcherA;
+    Base *prefetcherB;
+
+    /** Whether B had priority in the last getPacket() call. */
+    bool lastChoseB;
+
+    struct DuelingStats : public statistics::Group
+    {
+        DuelingStats(statistics::Group *parent);
+
+        /** Prefetches dropped because their set uses the other one. */
+        statistics::Scalar pfDroppedA;
+        statistics::Scalar pfDroppedB;
+    } duelingStats;
+};
+
+} // namespace prefetch
+} // namespace gem5
+
+#endif //__MEM_CACHE_PREFETCH_DUELING_HH__
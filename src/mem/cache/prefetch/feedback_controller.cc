@@ -0,0 +1,114 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/prefetch/feedback_controller.hh"
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace prefetch
+{
+
+namespace
+{
+
+/** Average the count of the last epoch with its smoothed history. */
+double
+smooth(double history, uint64_t total, uint64_t last)
+{
+    return (history + double(total - last)) / 2;
+}
+
+} // anonymous namespace
+
+FeedbackController::FeedbackController(const Config &_config)
+  : config(_config), _level(_config.initialLevel)
+{
+    fatal_if(config.numLevels == 0,
+        "Feedback-directed prefetching requires at least one level");
+    fatal_if(config.initialLevel >= config.numLevels,
+        "The initial prefetching level must be below %d", config.numLevels);
+    fatal_if(config.accuracyLow > config.accuracyHigh,
+        "The low accuracy threshold must not exceed the high one");
+}
+
+double
+FeedbackController::accuracy() const
+{
+    return (issued > 0) ? (useful / issued) : 0;
+}
+
+double
+FeedbackController::lateness() const
+{
+    return (useful > 0) ? (late / useful) : 0;
+}
+
+double
+FeedbackController::pollution() const
+{
+    return (demandMisses > 0) ? (polluting / demandMisses) : 0;
+}
+
+int
+FeedbackController::endEpoch(const Counts &totals)
+{
+    issued = smooth(issued, totals.issued, last.issued);
+    useful = smooth(useful, totals.useful, last.useful);
+    late = smooth(late, totals.late, last.late);
+    demandMisses = smooth(demandMisses, totals.demandMisses,
+                          last.demandMisses);
+    polluting = smooth(polluting, totals.polluting, last.polluting);
+    last = totals;
+
+    // Nothing was prefetched, so there is nothing to judge
+    if (issued == 0) {
+        return 0;
+    }
+
+    const bool is_late = lateness() >= config.latenessThreshold;
+    const bool is_polluting = pollution() >= config.pollutionThreshold;
+    int change = 0;
+    if (accuracy() >= config.accuracyHigh) {
+        change = is_late ? 1 : 0;
+    } else if (accuracy() >= config.accuracyLow) {
+        change = is_polluting ? -1 : (is_late ? 1 : 0);
+    } else {
+        change = -1;
+    }
+
+    // Saturate at the extreme levels
+    if ((change > 0 && _level + 1 == config.numLevels) ||
+        (change < 0 && _level == 0)) {
+        return 0;
+    }
+    _level += change;
+    return change;
+}
+
+} // namespace prefetch
+} // namespace gem5
@@ -0,0 +1,126 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_PREFETCH_FEEDBACK_CONTROLLER_HH__
+#define __MEM_CACHE_PREFETCH_FEEDBACK_CONTROLLER_HH__
+
+#include <cstdint>
+
+namespace gem5
+{
+
+namespace prefetch
+{
+
+/**
+ * Feedback-directed prefetching (Srinath et al., HPCA 2007). At the end of
+ * every epoch the accuracy, lateness and pollution of a prefetcher are
+ * estimated, and its aggressiveness level is moved up or down:
+ *
+ * - High accuracy: prefetches are useful, so go up if they are late.
+ * - Medium accuracy: go down if the prefetcher pollutes the cache, and up
+ *   if it is late but harmless.
+ * - Low accuracy: go down; most prefetches waste bandwidth.
+ *
+ * Each metric is smoothed across epochs by averaging the count of the last
+ * epoch with the previous smoothed value.
+ */
+class FeedbackController
+{
+  public:
+    struct Config
+    {
+        /** Accuracy from which a prefetcher is accurate. */
+        double accuracyHigh;
+        /** Accuracy below which a prefetcher is inaccurate. */
+        double accuracyLow;
+        /** Fraction of late useful prefetches from which it is late. */
+        double latenessThreshold;
+        /** Fraction of demand misses it caused from which it pollutes. */
+        double pollutionThreshold;
+        /** Number of levels of aggressiveness. */
+        unsigned numLevels;
+        /** Level used before the first epoch ends. */
+        unsigned initialLevel;
+    };
+
+    /** Cumulative event counts, as seen by the prefetcher. */
+    struct Counts
+    {
+        /** Prefetches issued to the memory system. */
+        uint64_t issued = 0;
+        /** Prefetched blocks referenced by a demand access. */
+        uint64_t useful = 0;
+        /** Demand accesses that found their prefetch still in flight. */
+        uint64_t late = 0;
+        /** Demand misses. */
+        uint64_t demandMisses = 0;
+        /** Demand misses to blocks evicted by a prefetch. */
+        uint64_t polluting = 0;
+    };
+
+    FeedbackController(const Config &config);
+
+    /**
+     * End an epoch and update the aggressiveness level.
+     *
+     * @param totals Cumulative counts up to the end of the epoch.
+     * @return The change of level: -1, 0 or 1.
+     */
+    int endEpoch(const Counts &totals);
+
+    /** Get the current aggressiveness level, from 0 to numLevels - 1. */
+    unsigned level() const { return _level; }
+
+    /** @{ */
+    /** Smoothed metrics used by the last decision. */
+    double accuracy() const;
+    double lateness() const;
+    double pollution() const;
+    /** @} */
+
+  private:
+    const Config config;
+
+    /** Current aggressiveness level. */
+    unsigned _level;
+
+    /** Totals at the end of the previous epoch. */
+    Counts last;
+
+    /** @{ */
+    /** Smoothed per-epoch counts. */
+    double issued = 0;
+    double useful = 0;
+    double late = 0;
+    double demandMisses = 0;
+    double polluting = 0;
+    /** @} */
+};
+
+} // namespace prefetch
+} // namespace gem5
+
+#endif // __MEM_CACHE_PREFETCH_FEEDBACK_CONTROLLER_HH__
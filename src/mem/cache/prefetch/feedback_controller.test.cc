@@ -0,0 +1,127 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mem/cache/prefetch/feedback_controller.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+prefetch::FeedbackController::Config
+config()
+{
+    return {0.75, 0.40, 0.10, 0.05, 5, 2};
+}
+
+/**
+ * Build the cumulative counts of a prefetcher that, every epoch, issues
+ * 100 prefetches and has 100 demand misses.
+ */
+prefetch::FeedbackController::Counts
+after(unsigned epochs, unsigned useful, unsigned late, unsigned polluting)
+{
+    prefetch::FeedbackController::Counts counts;
+    counts.issued = 100 * epochs;
+    counts.useful = useful * epochs;
+    counts.late = late * epochs;
+    counts.demandMisses = 100 * epochs;
+    counts.polluting = polluting * epochs;
+    return counts;
+}
+
+} // anonymous namespace
+
+/** Nothing changes while nothing is prefetched. */
+TEST(FeedbackControllerTest, Idle)
+{
+    prefetch::FeedbackController fdp(config());
+    ASSERT_EQ(fdp.endEpoch({}), 0);
+    ASSERT_EQ(fdp.level(), 2);
+}
+
+/** Accurate and late prefetchers become more aggressive, up to the top. */
+TEST(FeedbackControllerTest, AccurateAndLate)
+{
+    prefetch::FeedbackController fdp(config());
+    ASSERT_EQ(fdp.endEpoch(after(1, 90, 40, 0)), 1);
+    ASSERT_EQ(fdp.level(), 3);
+    ASSERT_EQ(fdp.endEpoch(after(2, 90, 40, 0)), 1);
+    ASSERT_EQ(fdp.endEpoch(after(3, 90, 40, 0)), 0);
+    ASSERT_EQ(fdp.level(), 4);
+    ASSERT_DOUBLE_EQ(fdp.accuracy(), 0.9);
+}
+
+/** Accurate and timely prefetchers are left alone. */
+TEST(FeedbackControllerTest, AccurateAndTimely)
+{
+    prefetch::FeedbackController fdp(config());
+    ASSERT_EQ(fdp.endEpoch(after(1, 90, 0, 20)), 0);
+    ASSERT_EQ(fdp.level(), 2);
+}
+
+/** Medium accuracy prefetchers back off if they pollute the cache. */
+TEST(FeedbackControllerTest, MediumAccuracy)
+{
+    prefetch::FeedbackController polluting(config());
+    ASSERT_EQ(polluting.endEpoch(after(1, 50, 40, 20)), -1);
+    ASSERT_EQ(polluting.level(), 1);
+
+    prefetch::FeedbackController harmless(config());
+    ASSERT_EQ(harmless.endEpoch(after(1, 50, 40, 0)), 1);
+    ASSERT_EQ(harmless.level(), 3);
+}
+
+/** Inaccurate prefetchers back off, down to the lowest level. */
+TEST(FeedbackControllerTest, Inaccurate)
+{
+    prefetch::FeedbackController fdp(config());
+    ASSERT_EQ(fdp.endEpoch(after(1, 10, 0, 0)), -1);
+    ASSERT_EQ(fdp.endEpoch(after(2, 10, 0, 0)), -1);
+    ASSERT_EQ(fdp.endEpoch(after(3, 10, 0, 0)), 0);
+    ASSERT_EQ(fdp.level(), 0);
+}
+
+/** Metrics are averaged with the previous epochs. */
+TEST(FeedbackControllerTest, Smoothing)
+{
+    prefetch::FeedbackController::Config cfg = config();
+    cfg.initialLevel = 0;
+    prefetch::FeedbackController fdp(cfg);
+
+    // 100 issued, 90 useful: smoothed 50 issued / 45 useful
+    fdp.endEpoch(after(1, 90, 0, 0));
+    ASSERT_DOUBLE_EQ(fdp.accuracy(), 0.9);
+
+    // Then 100 issued, 10 useful: smoothed 75 issued / 27.5 useful
+    prefetch::FeedbackController::Counts counts = after(1, 90, 0, 0);
+    counts.issued += 100;
+    counts.useful += 10;
+    counts.demandMisses += 100;
+    fdp.endEpoch(counts);
+    ASSERT_DOUBLE_EQ(fdp.accuracy(), 27.5 / 75);
+}
@@ -22,7 +22,8 @@ GHBPrefetcher::GHBPrefetcher(const GHBPrefetcherParams &p)
                    std::max(0u, static_cast<unsigned>(p.confidence_threshold)))),
       historyHelper(historySize, patternLength, degree, usePC,
                     static_cast<unsigned>(pageBytes),
-                    confidenceThreshold)
+                    confidenceThreshold, p.index_table_size,
+                    p.pattern_table_size, p.table_assoc)
 {
 }
 
@@ -5,6 +5,7 @@
 #include "mem/cache/prefetch/ghb_history.hh"
 
 #include <algorithm>
+#include <unordered_map>
 
 #include "base/logging.hh"
 
@@ -16,7 +17,9 @@ namespace prefetch
 
 GHBHistory::GHBHistory(unsigned history_size, unsigned pattern_length,
                        unsigned degree_, bool use_pc, unsigned page_bytes,
-                       unsigned confidence_threshold)
+                       unsigned confidence_threshold,
+                       size_t index_table_bytes, size_t pattern_table_bytes,
+                       unsigned table_assoc)
     : historySize(std::max(1u, history_size)),
       patternLength(std::max(1u, pattern_length)),
       degree(std::max(1u, degree_)),
@@ -24,12 +27,55 @@ GHBHistory::GHBHistory(unsigned history_size, unsigned pattern_length,
       pageBytes(std::max(1u, page_bytes)),
       confidenceThreshold(std::min(100u, confidence_threshold)),
       history(historySize),
+      lastIndex{IndexTable(index_table_bytes, IndexEntryBytes, table_assoc),
+                IndexTable(index_table_bytes, IndexEntryBytes, table_assoc)},
       head(0),
       filled(false),
-      sequenceCounter(1)
+      sequenceCounter(1),
+      patternTable(pattern_table_bytes, PatternEntryBytes, table_assoc)
 {
 }
 
+void
+GHBHistory::PatternEntry::record(int64_t delta, uint32_t weight)
+{
+    Count *slot = nullptr;
+    for (unsigned i = 0; i < counts.used; ++i) {
+        if (counts.slots[i].first == delta) {
+            slot = &counts.slots[i];
+            break;
+        }
+    }
+
+    if (!slot) {
+        if (counts.used < NumSuccessors) {
+            slot = &counts.slots[counts.used++];
+        } else {
+            // Replace the least frequent successor
+            slot = &counts.slots[0];
+            for (auto &candidate : counts.slots) {
+                if (candidate.second < slot->second) {
+                    slot = &candidate;
+                }
+            }
+            total -= slot->second;
+        }
+        *slot = {delta, 0};
+    }
+
+    slot->second += weight;
+    total += weight;
+
+    // Age all counts rather than letting them grow without bound
+    if (total > MaxTotal) {
+        total = 0;
+        for (unsigned i = 0; i < counts.used; ++i) {
+            counts.slots[i].second /= 2;
+            total += counts.slots[i].second;
+        }
+    }
+}
+
 void
 GHBHistory::reset()
 {
@@ -40,8 +86,8 @@ GHBHistory::reset()
             link = LinkInfo{};
         }
     }
-    for (auto &map : lastIndex) {
-        map.clear();
+    for (auto &table : lastIndex) {
+        table.clear();
     }
     head = 0;
     filled = false;
@@ -63,10 +109,10 @@ GHBHistory::removeIndexMappings(int32_t slot)
         if (!victim.links[i].keyValid) {
             continue;
         }
-        auto &indexMap = lastIndex[i];
-        auto it = indexMap.find(victim.links[i].keyValue);
-        if (it != indexMap.end() && it->second == slot) {
-            indexMap.erase(it);
+        auto &index_table = lastIndex[i];
+        const IndexEntry *mapped = index_table.find(victim.links[i].keyValue);
+        if (mapped && mapped->slot == slot) {
+            index_table.erase(victim.links[i].keyValue);
         }
         victim.links[i].keyValid = false;
     }
@@ -83,13 +129,12 @@ GHBHistory::assignCorrelation(GHBEntry &entry, int32_t slot,
     link.keyValid = true;
     link.keyValue = value;
 
-    auto &indexMap = lastIndex[idx];
-    auto it = indexMap.find(value);
-    if (it != indexMap.end()) {
-        link.prev = it->second;
-        link.prevSeq = history[it->second].seq;
+    IndexEntry &mapped = lastIndex[idx].findOrInsert(value);
+    if (mapped.slot >= 0) {
+        link.prev = mapped.slot;
+        link.prevSeq = history[mapped.slot].seq;
     }
-    indexMap[value] = slot;
+    mapped.slot = slot;
 }
 
 int32_t
@@ -169,7 +214,7 @@ GHBHistory::updatePatternTable(const std::vector<int64_t> &chronological)
     // This helps learn patterns faster
     for (size_t i = 0; i + 2 < chronological.size(); ++i) {
         DeltaPair key{chronological[i], chronological[i + 1]};
-        auto &entry = patternTable[key];
+        auto &entry = patternTable.findOrInsert(key);
         int64_t next_delta = chronological[i + 2];
         
         // Recency weighting: more recent patterns get higher weight
@@ -186,11 +231,8 @@ GHBHistory::updatePatternTable(const std::vector<int64_t> &chronological)
             recency_weight = 1;
         }
         
-        // Apply recency weight by incrementing multiple times
-        for (size_t w = 0; w < recency_weight; w++) {
-            entry.counts[next_delta]++;
-            entry.total++;
-        }
+        // Apply recency weight
+        entry.record(next_delta, recency_weight);
         
         // Also learn longer patterns (3-delta, 4-delta sequences) for better prediction
         // This helps with complex access patterns
@@ -198,23 +240,20 @@ GHBHistory::updatePatternTable(const std::vector<int64_t> &chronological)
             // Learn the pattern: (delta[i], delta[i+1]) -> delta[i+2] -> delta[i+3]
             // This creates a chain of predictions
             DeltaPair chain_key{chronological[i + 1], chronological[i + 2]};
-            auto &chain_entry = patternTable[chain_key];
-            chain_entry.counts[chronological[i + 3]]++;
-            chain_entry.total++;
+            auto &chain_entry = patternTable.findOrInsert(chain_key);
+            chain_entry.record(chronological[i + 3]);
             
             // Learn 4-delta sequences for even more complex patterns
             if (i + 4 < chronological.size()) {
                 DeltaPair chain_key2{chronological[i + 2], chronological[i + 3]};
-                auto &chain_entry2 = patternTable[chain_key2];
-                chain_entry2.counts[chronological[i + 4]]++;
-                chain_entry2.total++;
+                auto &chain_entry2 = patternTable.findOrInsert(chain_key2);
+                chain_entry2.record(chronological[i + 4]);
                 
                 // Learn 5-delta sequences for very complex patterns
                 if (i + 5 < chronological.size()) {
                     DeltaPair chain_key3{chronological[i + 3], chronological[i + 4]};
-                    auto &chain_entry3 = patternTable[chain_key3];
-                    chain_entry3.counts[chronological[i + 5]]++;
-                    chain_entry3.total++;
+                    auto &chain_entry3 = patternTable.findOrInsert(chain_key3);
+                    chain_entry3.record(chronological[i + 5]);
                 }
             }
         }
@@ -224,16 +263,14 @@ GHBHistory::updatePatternTable(const std::vector<int64_t> &chronological)
         if (i + 3 < chronological.size() && i > 0) {
             // Learn pattern from previous delta to current sequence
             DeltaPair overlap_key{chronological[i - 1], chronological[i]};
-            auto &overlap_entry = patternTable[overlap_key];
-            overlap_entry.counts[chronological[i + 2]]++;
-            overlap_entry.total++;
+            auto &overlap_entry = patternTable.findOrInsert(overlap_key);
+            overlap_entry.record(chronological[i + 2]);
             
             // Learn even more overlapping patterns for better coverage
             if (i > 1 && i + 4 < chronological.size()) {
                 DeltaPair overlap_key2{chronological[i - 2], chronological[i - 1]};
-                auto &overlap_entry2 = patternTable[overlap_key2];
-                overlap_entry2.counts[chronological[i + 2]]++;
-                overlap_entry2.total++;
+                auto &overlap_entry2 = patternTable.findOrInsert(overlap_key2);
+                overlap_entry2.record(chronological[i + 2]);
             }
         }
         
@@ -243,9 +280,8 @@ GHBHistory::updatePatternTable(const std::vector<int64_t> &chronological)
             int64_t reverse_delta1 = -chronological[i];
             int64_t reverse_delta2 = -chronological[i + 1];
             DeltaPair reverse_key{reverse_delta1, reverse_delta2};
-            auto &reverse_entry = patternTable[reverse_key];
-            reverse_entry.counts[-chronological[i + 2]]++;
-            reverse_entry.total++;
+            auto &reverse_entry = patternTable.findOrInsert(reverse_key);
+            reverse_entry.record(-chronological[i + 2]);
         }
     }
 }
@@ -285,12 +321,12 @@ GHBHistory::findPatternMatch(const std::vector<int64_t> &chronological,
     
     for (size_t key_idx = 0; key_idx < pattern_keys.size(); key_idx++) {
         const auto &key = pattern_keys[key_idx];
-        auto it = patternTable.find(key);
-        if (it == patternTable.end()) {
+        const PatternEntry *it = patternTable.find(key);
+        if (!it) {
             continue;
         }
 
-        const PatternEntry &entry = it->second;
+        const PatternEntry &entry = *it;
         // Require minimum pattern strength for reliability
         if (entry.total < 2) {
             continue;
@@ -429,9 +465,9 @@ GHBHistory::findPatternMatch(const std::vector<int64_t> &chronological,
     // If we still don't have enough predictions, be extremely lenient with thresholds
     // This helps fill the effective_degree for moderate-confidence patterns
     if (predicted.size() < effective_degree && !pattern_keys.empty()) {
-        auto it = patternTable.find(pattern_keys[0]);
-        if (it != patternTable.end()) {
-            const PatternEntry &entry = it->second;
+        const PatternEntry *it = patternTable.find(pattern_keys[0]);
+        if (it) {
+            const PatternEntry &entry = *it;
             // Use a lower threshold to get more candidates - be more aggressive
             unsigned lenient_threshold = std::max(20u, best_adaptive_threshold - 12);
             for (const auto &count_pair : entry.counts) {
@@ -456,9 +492,9 @@ GHBHistory::findPatternMatch(const std::vector<int64_t> &chronological,
         // Also try secondary patterns if we still need more
         if (predicted.size() < effective_degree && pattern_keys.size() > 1) {
             for (size_t key_idx = 1; key_idx < pattern_keys.size() && predicted.size() < effective_degree; key_idx++) {
-                auto it = patternTable.find(pattern_keys[key_idx]);
-                if (it != patternTable.end()) {
-                    const PatternEntry &entry = it->second;
+                const PatternEntry *it = patternTable.find(pattern_keys[key_idx]);
+                if (it) {
+                    const PatternEntry &entry = *it;
                     // Require stronger evidence for secondary patterns
                     if (entry.total < 3) continue;
                     unsigned lenient_threshold = std::max(25u, best_adaptive_threshold - 5);
@@ -500,10 +536,10 @@ GHBHistory::findPatternMatch(const std::vector<int64_t> &chronological,
             
             // Try to find next pattern in chain
             DeltaPair chain_key{chain_prev, chain_base};
-            auto chain_it = patternTable.find(chain_key);
+            const PatternEntry *chain_it = patternTable.find(chain_key);
             
-            if (chain_it != patternTable.end()) {
-                const PatternEntry &chain_entry = chain_it->second;
+            if (chain_it) {
+                const PatternEntry &chain_entry = *chain_it;
                 // Be extremely lenient for chained predictions to get more coverage
                 unsigned min_total = 1u; // Very lenient - only need 1 occurrence
                 if (chain_entry.total >= min_total) {
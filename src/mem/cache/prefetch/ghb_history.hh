@@ -6,9 +6,11 @@
 #ifndef __MEM_CACHE_PREFETCH_GHB_HISTORY_HH__
 #define __MEM_CACHE_PREFETCH_GHB_HISTORY_HH__
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <optional>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "base/types.hh"
@@ -35,9 +37,37 @@ class GHBHistory
         std::optional<Addr> pc;
     };
 
+    /**
+     * Storage budget of one index table entry: a 32-bit key tag and a
+     * 16-bit GHB pointer, rounded up.
+     */
+    static constexpr size_t IndexEntryBytes = 8;
+
+    /** Number of successor deltas counted per pattern table entry. */
+    static constexpr size_t NumSuccessors = 8;
+
+    /**
+     * Storage budget of one pattern table entry: two 16-bit key deltas,
+     * NumSuccessors 16-bit deltas with 8-bit counts and a 16-bit total.
+     */
+    static constexpr size_t PatternEntryBytes = 4 + NumSuccessors * 3 + 2;
+
+    static constexpr size_t DefaultIndexTableBytes = 2048;
+    static constexpr size_t DefaultPatternTableBytes = 16384;
+    static constexpr unsigned DefaultTableAssoc = 8;
+
+    /**
+     * @param index_table_bytes Capacity of the index table of each
+     *        correlation key.
+     * @param pattern_table_bytes Capacity of the pattern table.
+     * @param table_assoc Associativity of the index and pattern tables.
+     */
     GHBHistory(unsigned history_size, unsigned pattern_length, unsigned degree,
                bool use_pc, unsigned page_bytes,
-               unsigned confidence_threshold);
+               unsigned confidence_threshold,
+               size_t index_table_bytes = DefaultIndexTableBytes,
+               size_t pattern_table_bytes = DefaultPatternTableBytes,
+               unsigned table_assoc = DefaultTableAssoc);
 
     bool empty() const { return historySize == 0; }
     void reset();
@@ -78,19 +108,154 @@ class GHBHistory
         }
     };
 
+    /** Spread the bits of a key so that strided keys use all sets. */
+    static uint64_t
+    mixKey(uint64_t key)
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return key;
+    }
+
+    struct KeyHash
+    {
+        uint64_t operator()(uint64_t key) const { return mixKey(key); }
+    };
+
     struct DeltaPairHash
     {
-        std::size_t operator()(const DeltaPair &p) const
+        uint64_t operator()(const DeltaPair &p) const
         {
-            return std::hash<int64_t>{}(p.first) ^
-                   (std::hash<int64_t>{}(p.second) << 1);
+            return mixKey(p.first ^ mixKey(p.second));
         }
     };
 
+    /**
+     * A fixed-capacity, set associative table with LRU replacement.
+     * Iteration order within a set is the order of its ways, so results
+     * do not depend on hashing details of the host library.
+     */
+    template <class Key, class Value, class Hash>
+    class SetAssocTable
+    {
+      private:
+        struct Way
+        {
+            Key key{};
+            Value value{};
+            uint64_t lastUse = 0;
+            bool valid = false;
+        };
+
+        unsigned assoc;
+        size_t numSets;
+        std::vector<Way> ways;
+        uint64_t useCounter = 0;
+
+        Way *
+        setBegin(const Key &key)
+        {
+            return &ways[(Hash{}(key) % numSets) * assoc];
+        }
+
+        const Way *
+        setBegin(const Key &key) const
+        {
+            return &ways[(Hash{}(key) % numSets) * assoc];
+        }
+
+      public:
+        SetAssocTable(size_t bytes, size_t entry_bytes, unsigned _assoc)
+            : assoc(std::max(1u, _assoc)),
+              numSets(std::max<size_t>(1, bytes / entry_bytes / assoc)),
+              ways(numSets * assoc)
+        {}
+
+        const Value *
+        find(const Key &key) const
+        {
+            const Way *set = setBegin(key);
+            for (unsigned i = 0; i < assoc; ++i) {
+                if (set[i].valid && set[i].key == key) {
+                    return &set[i].value;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * Find the entry of a key, allocating it over the least recently
+         * used way of its set if it is not present.
+         */
+        Value &
+        findOrInsert(const Key &key)
+        {
+            Way *set = setBegin(key);
+            Way *victim = &set[0];
+            for (unsigned i = 0; i < assoc; ++i) {
+                if (set[i].valid && set[i].key == key) {
+                    set[i].lastUse = ++useCounter;
+                    return set[i].value;
+                }
+                if (victim->valid &&
+                    (!set[i].valid || set[i].lastUse < victim->lastUse)) {
+                    victim = &set[i];
+                }
+            }
+            victim->key = key;
+            victim->value = Value{};
+            victim->valid = true;
+            victim->lastUse = ++useCounter;
+            return victim->value;
+        }
+
+        void
+        erase(const Key &key)
+        {
+            Way *set = setBegin(key);
+            for (unsigned i = 0; i < assoc; ++i) {
+                if (set[i].valid && set[i].key == key) {
+                    set[i].valid = false;
+                    return;
+                }
+            }
+        }
+
+        void
+        clear()
+        {
+            for (auto &way : ways) {
+                way = Way{};
+            }
+            useCounter = 0;
+        }
+    };
+
+    /**
+     * Successor deltas observed after a delta pair, with their counts.
+     * When all slots are in use the least frequent successor is
+     * replaced, and counts are halved before the total overflows.
+     */
     struct PatternEntry
     {
-        std::unordered_map<int64_t, uint32_t> counts;
+        using Count = std::pair<int64_t, uint32_t>;
+
+        struct Counts
+        {
+            std::array<Count, NumSuccessors> slots{};
+            unsigned used = 0;
+
+            const Count *begin() const { return slots.data(); }
+            const Count *end() const { return slots.data() + used; }
+        };
+
+        static constexpr uint32_t MaxTotal = 0xffff;
+
+        Counts counts;
         uint32_t total = 0;
+
+        void record(int64_t delta, uint32_t weight = 1);
     };
 
     unsigned historySize;
@@ -101,12 +266,20 @@ class GHBHistory
     unsigned confidenceThreshold;
 
     std::vector<GHBEntry> history;
-    std::array<std::unordered_map<uint64_t, int32_t>, NumCorrelationKeys>
-        lastIndex;
+    struct IndexEntry
+    {
+        int32_t slot = -1;
+    };
+
+    using IndexTable = SetAssocTable<uint64_t, IndexEntry, KeyHash>;
+    using PatternTable = SetAssocTable<DeltaPair, PatternEntry, DeltaPairHash>;
+
+    /** Most recent GHB slot of each key, one table per correlation key. */
+    std::array<IndexTable, NumCorrelationKeys> lastIndex;
     int32_t head;
     bool filled;
     uint64_t sequenceCounter;
-    std::unordered_map<DeltaPair, PatternEntry, DeltaPairHash> patternTable;
+    PatternTable patternTable;
 
     void evictIndex(int32_t slot);
     void removeIndexMappings(int32_t slot);
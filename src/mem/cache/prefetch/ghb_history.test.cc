@@ -86,4 +86,23 @@ TEST(GHBHistoryTest, FallbackUsesRecentDeltas)
     EXPECT_EQ(predicted[0], 4);
 }
 
+TEST(GHBHistoryTest, PatternTableIsBounded)
+{
+    // Room for a single pattern table entry
+    GHBHistory history(/*history_size=*/16, /*pattern_length=*/4,
+                       /*degree=*/2, /*use_pc=*/true, /*page_bytes=*/64,
+                       /*confidence_threshold=*/50,
+                       GHBHistory::DefaultIndexTableBytes,
+                       GHBHistory::PatternEntryBytes, /*table_assoc=*/1);
+    std::vector<int64_t> predicted;
+
+    history.updatePatternTable({64, 64, 64});
+    ASSERT_TRUE(history.findPatternMatch({64, 64}, predicted));
+
+    // Learning another pattern replaces the only entry
+    history.updatePatternTable({8, 8, 8});
+    EXPECT_TRUE(history.findPatternMatch({8, 8}, predicted));
+    EXPECT_FALSE(history.findPatternMatch({64, 64}, predicted));
+}
+
 } // anonymous namespace
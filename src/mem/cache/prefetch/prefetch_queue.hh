@@ -0,0 +1,305 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Priority ordered queue of pending prefetches with an address index.
+ */
+
+#ifndef __MEM_CACHE_PREFETCH_PREFETCH_QUEUE_HH__
+#define __MEM_CACHE_PREFETCH_PREFETCH_QUEUE_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <map>
+#include <unordered_map>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace prefetch
+{
+
+/**
+ * A queue of prefetch entries kept in descending priority order, with
+ * entries of the same priority kept in insertion order. Entries live in
+ * a list so that their address never changes while they are queued (a
+ * queued entry may be the target of an in-flight translation), and two
+ * side structures make the common operations cheap:
+ * - a map from each priority level present to the first and last entry
+ *   of that level, so that insertion and eviction of the oldest entry of
+ *   the lowest priority are logarithmic in the number of levels;
+ * - a hash index from the entry key (usually its block address) to the
+ *   entries holding it, so that duplicate filtering and demand squashing
+ *   do not walk the whole queue.
+ *
+ * @tparam Entry Type of the queued entries. It must have an int32_t
+ *         priority member, which must only be changed via raise().
+ * @tparam KeyOf Functor returning the index key of an entry.
+ */
+template <typename Entry, typename KeyOf>
+class PrefetchQueue
+{
+  public:
+    using iterator = typename std::list<Entry>::iterator;
+    using const_iterator = typename std::list<Entry>::const_iterator;
+
+  private:
+    /** First and last entry of a priority level. */
+    struct Level
+    {
+        iterator first;
+        iterator last;
+        size_t count;
+    };
+
+    /** The entries, in issue order. */
+    std::list<Entry> entries;
+
+    /** Priority levels present in the queue, highest first. */
+    std::map<int32_t, Level, std::greater<int32_t>> levels;
+
+    /** Entries holding each key. */
+    std::unordered_multimap<Addr, iterator> index;
+
+    KeyOf keyOf;
+
+    /**
+     * Find the position where a new entry of the given priority must be
+     * inserted: right after the youngest entry of the same or a higher
+     * priority.
+     */
+    iterator
+    insertPosition(int32_t priority)
+    {
+        auto level = levels.find(priority);
+        if (level != levels.end()) {
+            return std::next(level->second.last);
+        }
+        auto lower = levels.upper_bound(priority);
+        return lower == levels.end() ? entries.end() : lower->second.first;
+    }
+
+    /** Account an entry that has just been placed in the list. */
+    void
+    linkLevel(iterator it)
+    {
+        auto level = levels.find(it->priority);
+        if (level == levels.end()) {
+            levels.emplace(it->priority, Level{it, it, 1});
+        } else {
+            auto &lvl = level->second;
+            assert(std::next(lvl.last) == it);
+            lvl.last = it;
+            lvl.count++;
+        }
+    }
+
+    /** Remove an entry from its priority level. */
+    void
+    unlinkLevel(iterator it)
+    {
+        auto level = levels.find(it->priority);
+        assert(level != levels.end());
+        auto &lvl = level->second;
+        if (--lvl.count == 0) {
+            levels.erase(level);
+        } else if (lvl.first == it) {
+            lvl.first = std::next(it);
+        } else if (lvl.last == it) {
+            lvl.last = std::prev(it);
+        }
+    }
+
+    /** Remove an entry from the address index. */
+    void
+    unlinkIndex(iterator it)
+    {
+        auto range = index.equal_range(keyOf(*it));
+        for (auto i = range.first; i != range.second; ++i) {
+            if (i->second == it) {
+                index.erase(i);
+                return;
+            }
+        }
+        assert(false);
+    }
+
+  public:
+    PrefetchQueue(KeyOf key_of = KeyOf()) : keyOf(key_of) {}
+
+    iterator begin() { return entries.begin(); }
+    iterator end() { return entries.end(); }
+    const_iterator begin() const { return entries.begin(); }
+    const_iterator end() const { return entries.end(); }
+    const_iterator cbegin() const { return entries.cbegin(); }
+    const_iterator cend() const { return entries.cend(); }
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+
+    Entry &front() { return entries.front(); }
+    const Entry &front() const { return entries.front(); }
+
+    /**
+     * Queue a copy of an entry behind all the entries that have the same
+     * or a higher priority.
+     * @param entry The entry to queue.
+     * @return An iterator to the queued entry.
+     */
+    iterator
+    push(const Entry &entry)
+    {
+        iterator it = entries.insert(insertPosition(entry.priority), entry);
+        linkLevel(it);
+        index.emplace(keyOf(*it), it);
+        return it;
+    }
+
+    /**
+     * Remove an entry from the queue.
+     * @param it The entry to remove.
+     * @return An iterator to the entry that followed it.
+     */
+    iterator
+    erase(iterator it)
+    {
+        unlinkLevel(it);
+        unlinkIndex(it);
+        return entries.erase(it);
+    }
+
+    /** Remove the entry at the head of the queue. */
+    void pop_front() { erase(entries.begin()); }
+
+    /**
+     * Increase the priority of a queued entry, moving it behind the
+     * youngest entry of its new priority. The entry itself is not moved in
+     * memory.
+     * @param it The entry to update.
+     * @param priority The new priority, higher than the current one.
+     */
+    void
+    raise(iterator it, int32_t priority)
+    {
+        assert(priority > it->priority);
+        unlinkLevel(it);
+        it->priority = priority;
+        entries.splice(insertPosition(priority), entries, it);
+        linkLevel(it);
+    }
+
+    /**
+     * @return The oldest entry among those with the lowest priority, or
+     *         end() if the queue is empty.
+     */
+    iterator
+    lowestOldest()
+    {
+        return levels.empty() ? entries.end() : levels.rbegin()->second.first;
+    }
+
+    /**
+     * Find the queued entry closest to the head that has the given key and
+     * satisfies a predicate.
+     * @param key The index key to look up.
+     * @param match Predicate that the entry must satisfy.
+     * @return The matching entry, or end() if there is none.
+     */
+    template <typename Pred>
+    iterator
+    find(Addr key, Pred match)
+    {
+        iterator found = entries.end();
+        auto range = index.equal_range(key);
+        for (auto i = range.first; i != range.second; ++i) {
+            if (match(*i->second) &&
+                    (found == entries.end() || before(i->second, found))) {
+                found = i->second;
+            }
+        }
+        return found;
+    }
+
+    /**
+     * Remove all queued entries that have the given key and satisfy a
+     * predicate.
+     * @param key The index key to look up.
+     * @param match Predicate that the entries must satisfy.
+     * @param on_erase Called on each entry right before it is removed.
+     * @return The number of removed entries.
+     */
+    template <typename Pred, typename Fn>
+    size_t
+    eraseMatching(Addr key, Pred match, Fn on_erase)
+    {
+        size_t removed = 0;
+        auto range = index.equal_range(key);
+        for (auto i = range.first; i != range.second;) {
+            iterator it = i->second;
+            if (match(*it)) {
+                on_erase(*it);
+                unlinkLevel(it);
+                i = index.erase(i);
+                entries.erase(it);
+                removed++;
+            } else {
+                ++i;
+            }
+        }
+        return removed;
+    }
+
+  private:
+    /**
+     * Whether entry a is closer to the head of the queue than entry b. Only
+     * needed when several entries share a key, which is rare.
+     */
+    bool
+    before(const_iterator a, const_iterator b) const
+    {
+        if (a->priority != b->priority) {
+            return a->priority > b->priority;
+        }
+        for (const_iterator it = a; it != entries.end() &&
+                it->priority == a->priority; ++it) {
+            if (it == b) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace prefetch
+} // namespace gem5
+
+#endif // __MEM_CACHE_PREFETCH_PREFETCH_QUEUE_HH__
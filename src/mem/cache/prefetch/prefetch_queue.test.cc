@@ -0,0 +1,129 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "mem/cache/prefetch/prefetch_queue.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct TestEntry
+{
+    Addr addr;
+    int32_t priority;
+    int id;
+};
+
+struct TestKey
+{
+    Addr operator()(const TestEntry &e) const { return e.addr; }
+};
+
+using TestQueue = prefetch::PrefetchQueue<TestEntry, TestKey>;
+
+std::vector<int>
+order(const TestQueue &queue)
+{
+    std::vector<int> ids;
+    for (const auto &e : queue) {
+        ids.push_back(e.id);
+    }
+    return ids;
+}
+
+} // anonymous namespace
+
+/** Entries are sorted by priority, and FIFO within a priority. */
+TEST(PrefetchQueueTest, PriorityThenInsertionOrder)
+{
+    TestQueue queue;
+    queue.push({0x00, 1, 0});
+    queue.push({0x40, 3, 1});
+    queue.push({0x80, 1, 2});
+    queue.push({0xc0, 2, 3});
+    queue.push({0x100, 3, 4});
+    ASSERT_EQ(order(queue), (std::vector<int>{1, 4, 3, 0, 2}));
+
+    queue.pop_front();
+    ASSERT_EQ(queue.front().id, 4);
+    ASSERT_EQ(queue.size(), 4);
+}
+
+/** The eviction candidate is the oldest entry of the lowest priority. */
+TEST(PrefetchQueueTest, LowestOldest)
+{
+    TestQueue queue;
+    ASSERT_EQ(queue.lowestOldest(), queue.end());
+    queue.push({0x00, 2, 0});
+    queue.push({0x40, 1, 1});
+    queue.push({0x80, 1, 2});
+    ASSERT_EQ(queue.lowestOldest()->id, 1);
+    queue.erase(queue.lowestOldest());
+    ASSERT_EQ(queue.lowestOldest()->id, 2);
+    queue.erase(queue.lowestOldest());
+    ASSERT_EQ(queue.lowestOldest()->id, 0);
+}
+
+/** Raising a priority moves the entry behind the youngest of its level. */
+TEST(PrefetchQueueTest, RaiseKeepsEntryInPlace)
+{
+    TestQueue queue;
+    queue.push({0x00, 3, 0});
+    queue.push({0x40, 2, 1});
+    auto it = queue.push({0x80, 1, 2});
+    const TestEntry *addr = &*it;
+    queue.raise(it, 3);
+    ASSERT_EQ(order(queue), (std::vector<int>{0, 2, 1}));
+    ASSERT_EQ(&*queue.find(0x80, [](const TestEntry &) { return true; }),
+              addr);
+    ASSERT_EQ(queue.lowestOldest()->id, 1);
+}
+
+/** Lookups and removals by key only touch the matching entries. */
+TEST(PrefetchQueueTest, FindAndEraseByKey)
+{
+    TestQueue queue;
+    auto any = [](const TestEntry &) { return true; };
+    queue.push({0x40, 1, 0});
+    queue.push({0x80, 2, 1});
+    queue.push({0x40, 2, 2});
+    ASSERT_EQ(queue.find(0x40, any)->id, 2);
+    ASSERT_EQ(queue.find(0xc0, any), queue.end());
+    ASSERT_EQ(queue.find(0x40,
+        [](const TestEntry &e) { return e.priority == 1; })->id, 0);
+
+    int removed = 0;
+    ASSERT_EQ(queue.eraseMatching(0x40, any,
+        [&removed](TestEntry &) { removed++; }), 2);
+    ASSERT_EQ(removed, 2);
+    ASSERT_EQ(order(queue), (std::vector<int>{1}));
+    ASSERT_EQ(queue.find(0x40, any), queue.end());
+    ASSERT_EQ(queue.lowestOldest()->id, 1);
+}
@@ -37,6 +37,7 @@
 
 #include "mem/cache/prefetch/queued.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "arch/generic/tlb.hh"
@@ -60,7 +61,7 @@ Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
                                             bool tag_prefetch,
                                             Tick t) {
     /* Create a prefetch memory request */
-    RequestPtr req = std::make_shared<Request>(paddr, blk_size,
+    RequestPtr req = makeRequest(paddr, blk_size,
                                                 0, requestor_id);
 
     if (pfInfo.isSecure()) {
@@ -104,8 +105,24 @@ Queued::Queued(const QueuedPrefetcherParams &p)
       latency(p.latency), queueSquash(p.queue_squash),
       queueFilter(p.queue_filter), cacheSnoop(p.cache_snoop),
       tagPrefetch(p.tag_prefetch),
-      throttleControlPct(p.throttle_control_percentage), statsQueued(this)
+      throttleControlPct(p.throttle_control_percentage),
+      fdpDegrees(p.fdp_degrees), fdpEpoch(p.fdp_epoch),
+      pollutionFilter(p.fdp_pollution_filter), epochAccesses(0),
+      demandMisses(0), pollutingMisses(0), statsQueued(this)
 {
+    if (p.use_feedback) {
+        fatal_if(fdpEpoch == 0, "The feedback epoch must not be empty");
+        fatal_if(!pollutionFilter, "Feedback-directed prefetching requires "
+            "a pollution filter");
+        for (unsigned degree : fdpDegrees) {
+            fatal_if(degree == 0, "Feedback prefetch degrees must be "
+                "positive");
+        }
+        feedback.reset(new FeedbackController({
+            p.fdp_accuracy_high, p.fdp_accuracy_low,
+            p.fdp_lateness_threshold, p.fdp_pollution_threshold,
+            unsigned(fdpDegrees.size()), p.fdp_initial_level}));
+    }
 }
 
 Queued::~Queued()
@@ -117,7 +134,7 @@ Queued::~Queued()
 }
 
 void
-Queued::printQueue(const std::list<DeferredPacket> &queue) const
+Queued::printQueue(const DeferredQueue &queue) const
 {
     int pos = 0;
     std::string queue_name = "";
@@ -168,6 +185,52 @@ Queued::getMaxPermittedPrefetches(size_t total) const
     return max_pfs;
 }
 
+void
+Queued::endFeedbackEpoch()
+{
+    const unsigned old_level = feedback->level();
+    const int change = feedback->endEpoch({issuedPrefetches,
+        usefulPrefetches, latePrefetches, demandMisses, pollutingMisses});
+    if (change > 0) {
+        statsQueued.pfThrottleUp++;
+    } else if (change < 0) {
+        statsQueued.pfThrottleDown++;
+    }
+    if (change != 0) {
+        DPRINTF(HWPrefetch, "Feedback level %d -> %d (accuracy %.3f, "
+                "lateness %.3f, pollution %.3f), degree %d\n", old_level,
+                feedback->level(), feedback->accuracy(),
+                feedback->lateness(), feedback->pollution(),
+                fdpDegrees[feedback->level()]);
+    }
+
+    // Only track the pollution caused by recent prefetches
+    pollutionFilter->clear();
+    epochAccesses = 0;
+}
+
+void
+Queued::notifyPrefetchEviction(Addr addr)
+{
+    if (feedback) {
+        pollutionFilter->set(addr);
+    }
+}
+
+void
+Queued::notifyDemandMiss(Addr addr)
+{
+    if (!feedback) {
+        return;
+    }
+    demandMisses++;
+    if (pollutionFilter->isSet(addr)) {
+        pollutionFilter->unset(addr);
+        pollutingMisses++;
+        statsQueued.pfPolluting++;
+    }
+}
+
 void
 Queued::notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi)
 {
@@ -178,21 +241,20 @@ Queued::notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi)
 
     // Squash queued prefetches if demand miss to same line
     if (queueSquash) {
-        auto itr = pfq.begin();
-        while (itr != pfq.end()) {
-            if (blockAddress(itr->pfInfo.getAddr()) == blk_addr &&
-                itr->pfInfo.isSecure() == is_secure) {
+        pfq.eraseMatching(blk_addr,
+            [is_secure](const DeferredPacket &dp)
+            {
+                return dp.pfInfo.isSecure() == is_secure;
+            },
+            [this](DeferredPacket &dp)
+            {
                 DPRINTF(HWPrefetch, "Removing pf candidate addr: %#x "
                         "(cl: %#x), demand request going to the same addr\n",
-                        itr->pfInfo.getAddr(),
-                        blockAddress(itr->pfInfo.getAddr()));
-                delete itr->pkt;
-                itr = pfq.erase(itr);
+                        dp.pfInfo.getAddr(),
+                        blockAddress(dp.pfInfo.getAddr()));
+                delete dp.pkt;
                 statsQueued.pfRemovedDemand++;
-            } else {
-                ++itr;
-            }
-        }
+            });
     }
 
     // Calculate prefetches given this access
@@ -201,6 +263,12 @@ Queued::notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi)
 
     // Get the maximu number of prefetches that we are allowed to generate
     size_t max_pfs = getMaxPermittedPrefetches(addresses.size());
+    if (feedback) {
+        max_pfs = std::min<size_t>(max_pfs, fdpDegrees[feedback->level()]);
+        if (++epochAccesses == fdpEpoch) {
+            endFeedbackEpoch();
+        }
+    }
 
     // Queue up generated prefetches
     size_t num_pfs = 0;
@@ -279,7 +347,13 @@ Queued::QueuedStats::QueuedStats(statistics::Group *parent)
     ADD_STAT(pfSpanPage, statistics::units::Count::get(),
              "number of prefetches that crossed the page"),
     ADD_STAT(pfUsefulSpanPage, statistics::units::Count::get(),
-             "number of prefetches that is useful and crossed the page")
+             "number of prefetches that is useful and crossed the page"),
+    ADD_STAT(pfThrottleUp, statistics::units::Count::get(),
+             "number of times feedback made the prefetcher more aggressive"),
+    ADD_STAT(pfThrottleDown, statistics::units::Count::get(),
+             "number of times feedback made the prefetcher less aggressive"),
+    ADD_STAT(pfPolluting, statistics::units::Count::get(),
+             "number of demand misses to blocks evicted by prefetches")
 {
 }
 
@@ -303,13 +377,8 @@ void
 Queued::translationComplete(DeferredPacket *dp, bool failed,
                             const CacheAccessor &cache)
 {
-    auto it = pfqMissingTranslation.begin();
-    while (it != pfqMissingTranslation.end()) {
-        if (&(*it) == dp) {
-            break;
-        }
-        it++;
-    }
+    auto it = pfqMissingTranslation.find(dp->pfInfo.getAddr(),
+        [dp](const DeferredPacket &queued) { return &queued == dp; });
     assert(it != pfqMissingTranslation.end());
     if (!failed) {
         DPRINTF(HWPrefetch, "%s Translation of vaddr %#x succeeded: "
@@ -324,6 +393,10 @@ Queued::translationComplete(DeferredPacket *dp, bool failed,
             statsQueued.pfInCache++;
             DPRINTF(HWPrefetch, "Dropping redundant in "
                     "cache/MSHR prefetch addr:%#x\n", target_paddr);
+        } else if (inUpperMissQueue(target_paddr, it->pfInfo.isSecure())) {
+            prefetchStats.pfInUpperMSHR++;
+            DPRINTF(HWPrefetch, "Dropping prefetch addr:%#x, already "
+                    "fetched by an upper-level cache\n", target_paddr);
         } else {
             Tick pf_time = curTick() + clockPeriod() * latency;
             it->createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
@@ -339,45 +412,34 @@ Queued::translationComplete(DeferredPacket *dp, bool failed,
 }
 
 bool
-Queued::alreadyInQueue(std::list<DeferredPacket> &queue,
+Queued::alreadyInQueue(DeferredQueue &queue,
                                  const PrefetchInfo &pfi, int32_t priority)
 {
-    bool found = false;
-    iterator it;
-    for (it = queue.begin(); it != queue.end() && !found; it++) {
-        found = it->pfInfo.sameAddr(pfi);
+    iterator it = queue.find(pfi.getAddr(),
+        [&pfi](const DeferredPacket &dp) { return dp.pfInfo.sameAddr(pfi); });
+    if (it == queue.end()) {
+        return false;
     }
 
-    /* If the address is already in the queue, update priority and leave */
-    if (it != queue.end()) {
-        statsQueued.pfBufferHit++;
-        if (it->priority < priority) {
-            /* Update priority value and position in the queue */
-            it->priority = priority;
-            iterator prev = it;
-            while (prev != queue.begin()) {
-                prev--;
-                /* If the packet has higher priority, swap */
-                if (*it > *prev) {
-                    std::swap(*it, *prev);
-                    it = prev;
-                }
-            }
-            DPRINTF(HWPrefetch, "Prefetch addr already in "
-                "prefetch queue, priority updated\n");
-        } else {
-            DPRINTF(HWPrefetch, "Prefetch addr already in "
-                "prefetch queue\n");
-        }
+    /* The address is already in the queue, update priority and leave */
+    statsQueued.pfBufferHit++;
+    if (it->priority < priority) {
+        /* Update priority value and position in the queue */
+        queue.raise(it, priority);
+        DPRINTF(HWPrefetch, "Prefetch addr already in "
+            "prefetch queue, priority updated\n");
+    } else {
+        DPRINTF(HWPrefetch, "Prefetch addr already in "
+            "prefetch queue\n");
     }
-    return found;
+    return true;
 }
 
 RequestPtr
 Queued::createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt)
 {
-    RequestPtr translation_req = std::make_shared<Request>(
+    RequestPtr translation_req = makeRequest(
             addr, blkSize, pkt->req->getFlags(), requestorId, pfi.getPC(),
             pkt->req->contextId());
     translation_req->setFlags(Request::PREFETCH);
@@ -462,6 +524,12 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
                 "cache/MSHR prefetch addr:%#x\n", target_paddr);
         return;
     }
+    if (has_target_pa && inUpperMissQueue(target_paddr, new_pfi.isSecure())) {
+        prefetchStats.pfInUpperMSHR++;
+        DPRINTF(HWPrefetch, "Dropping prefetch addr:%#x, already fetched "
+                "by an upper-level cache\n", target_paddr);
+        return;
+    }
 
     /* Create the packet and find the spot to insert it */
     DeferredPacket dpp(this, new_pfi, 0, priority, cache);
@@ -484,50 +552,23 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
 }
 
 void
-Queued::addToQueue(std::list<DeferredPacket> &queue,
-                             DeferredPacket &dpp)
+Queued::addToQueue(DeferredQueue &queue, DeferredPacket &dpp)
 {
     /* Verify prefetch buffer space for request */
     if (queue.size() == queueSize) {
         statsQueued.pfRemovedFull++;
-        /* Lowest priority packet */
-        iterator it = queue.end();
-        panic_if (it == queue.begin(),
-            "Prefetch queue is both full and empty!");
-        --it;
-        /* Look for oldest in that level of priority */
-        panic_if (it == queue.begin(),
+        panic_if (queue.empty(), "Prefetch queue is both full and empty!");
+        panic_if (queue.size() == 1,
             "Prefetch queue is full with 1 element!");
-        iterator prev = it;
-        bool cont = true;
-        /* While not at the head of the queue */
-        while (cont && prev != queue.begin()) {
-            prev--;
-            /* While at the same level of priority */
-            cont = prev->priority == it->priority;
-            if (cont)
-                /* update pointer */
-                it = prev;
-        }
+        /* Oldest packet of the lowest level of priority */
+        iterator it = queue.lowestOldest();
         DPRINTF(HWPrefetch, "Prefetch queue full, removing lowest priority "
                             "oldest packet, addr: %#x\n",it->pfInfo.getAddr());
         delete it->pkt;
         queue.erase(it);
     }
 
-    if ((queue.size() == 0) || (dpp <= queue.back())) {
-        queue.emplace_back(dpp);
-    } else {
-        iterator it = queue.end();
-        do {
-            --it;
-        } while (it != queue.begin() && dpp > *it);
-        /* If we reach the head, we have to see if the new element is new head
-         * or not */
-        if (it == queue.begin() && dpp <= *it)
-            it++;
-        queue.insert(it, dpp);
-    }
+    queue.push(dpp);
 
     if (debug::HWPrefetchQueue)
         printQueue(queue);
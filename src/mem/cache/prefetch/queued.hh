@@ -39,13 +39,17 @@
 #define __MEM_CACHE_PREFETCH_QUEUED_HH__
 
 #include <cstdint>
-#include <list>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "arch/generic/mmu.hh"
+#include "base/filters/base.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/cache/prefetch/base.hh"
+#include "mem/cache/prefetch/feedback_controller.hh"
+#include "mem/cache/prefetch/prefetch_queue.hh"
 #include "mem/packet.hh"
 
 namespace gem5
@@ -141,11 +145,23 @@ class Queued : public Base
         void startTranslation(BaseMMU *mmu);
     };
 
-    std::list<DeferredPacket> pfq;
-    std::list<DeferredPacket> pfqMissingTranslation;
+    /** Deferred packets are indexed by their prefetch address. */
+    struct DeferredPacketKey
+    {
+        Addr
+        operator()(const DeferredPacket &dp) const
+        {
+            return dp.pfInfo.getAddr();
+        }
+    };
+
+    using DeferredQueue = PrefetchQueue<DeferredPacket, DeferredPacketKey>;
 
-    using const_iterator = std::list<DeferredPacket>::const_iterator;
-    using iterator = std::list<DeferredPacket>::iterator;
+    DeferredQueue pfq;
+    DeferredQueue pfqMissingTranslation;
+
+    using const_iterator = DeferredQueue::const_iterator;
+    using iterator = DeferredQueue::iterator;
 
     // PARAMETERS
 
@@ -176,6 +192,30 @@ class Queued : public Base
     /** Percentage of requests that can be throttled */
     const unsigned int throttleControlPct;
 
+    /**
+     * Feedback-directed throttling of the number of prefetches generated
+     * per access. Null if disabled.
+     */
+    std::unique_ptr<FeedbackController> feedback;
+
+    /** Maximum number of prefetches per access at each feedback level */
+    const std::vector<unsigned> fdpDegrees;
+
+    /** Number of observed accesses per feedback epoch */
+    const unsigned fdpEpoch;
+
+    /** Filter of the blocks evicted by prefetch fills */
+    bloom_filter::Base *pollutionFilter;
+
+    /** Accesses observed during the current feedback epoch */
+    unsigned epochAccesses;
+
+    /** Total demand misses seen by the feedback controller */
+    uint64_t demandMisses;
+
+    /** Total demand misses to blocks evicted by a prefetch fill */
+    uint64_t pollutingMisses;
+
     struct QueuedStats : public statistics::Group
     {
         QueuedStats(statistics::Group *parent);
@@ -187,6 +227,9 @@ class Queued : public Base
         statistics::Scalar pfRemovedFull;
         statistics::Scalar pfSpanPage;
         statistics::Scalar pfUsefulSpanPage;
+        statistics::Scalar pfThrottleUp;
+        statistics::Scalar pfThrottleDown;
+        statistics::Scalar pfPolluting;
     } statsQueued;
   public:
     using AddrPriority = std::pair<Addr, int32_t>;
@@ -197,6 +240,9 @@ class Queued : public Base
     void
     notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi) override;
 
+    void notifyPrefetchEviction(Addr addr) override;
+    void notifyDemandMiss(Addr addr) override;
+
     void insert(const PacketPtr &pkt, PrefetchInfo &new_pfi, int32_t priority,
                 const CacheAccessor &cache);
 
@@ -210,7 +256,7 @@ class Queued : public Base
         return pfq.empty() ? MaxTick : pfq.front().tick;
     }
 
-    void printQueue(const std::list<DeferredPacket> &queue) const;
+    void printQueue(const DeferredQueue &queue) const;
 
   private:
 
@@ -219,7 +265,7 @@ class Queued : public Base
      * @param queue selected queue to use
      * @param dpp DeferredPacket to add
      */
-    void addToQueue(std::list<DeferredPacket> &queue, DeferredPacket &dpp);
+    void addToQueue(DeferredQueue &queue, DeferredPacket &dpp);
 
     /**
      * Starts the translations of the queued prefetches with a
@@ -249,7 +295,7 @@ class Queued : public Base
      * @param priority priority of the prefetch request to be added
      * @return True if the prefetch request was found in the queue
      */
-    bool alreadyInQueue(std::list<DeferredPacket> &queue,
+    bool alreadyInQueue(DeferredQueue &queue,
                         const PrefetchInfo &pfi, int32_t priority);
 
     /**
@@ -262,6 +308,12 @@ class Queued : public Base
      */
     size_t getMaxPermittedPrefetches(size_t total) const;
 
+    /**
+     * Feed the counts of the last epoch to the feedback controller, and
+     * adapt the prefetch degree to its decision.
+     */
+    void endFeedbackEpoch();
+
     RequestPtr createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt);
 };
@@ -33,6 +33,8 @@
 
 #include "mem/cache/prefetch/sms.hh"
 
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
 #include "debug/HWPrefetch.hh"
 #include "params/SmsPrefetcher.hh"
 
@@ -43,118 +45,123 @@ namespace prefetch
 {
 
 Sms::Sms(const SmsPrefetcherParams &p)
-    : Queued(p), Max_Contexts(p.ft_size), MAX_PHTSize(p.pht_size),
-      Region_Size(p.region_size)
+    : Queued(p), regionSize(p.region_size),
+      regionBlocksBits(floorLog2(p.region_size / blkSize)),
+      filterTable((name() + ".FilterTable").c_str(),
+          p.ft_size, p.ft_assoc, p.ft_replacement_policy,
+          p.ft_indexing_policy,
+          GenerationEntry(genTagExtractor(p.ft_indexing_policy))),
+      activeGenerationTable((name() + ".ActiveGenerationTable").c_str(),
+          p.agt_size, p.agt_assoc, p.agt_replacement_policy,
+          p.agt_indexing_policy,
+          GenerationEntry(genTagExtractor(p.agt_indexing_policy))),
+      patternHistoryTable((name() + ".PatternHistoryTable").c_str(),
+          p.pht_size, p.pht_assoc, p.pht_replacement_policy,
+          p.pht_indexing_policy,
+          PatternEntry(genTagExtractor(p.pht_indexing_policy)))
 {
-    AGT.clear();
-    AGTPC.clear();
-    FT.clear();
-    PHT.clear();
-    fifoFT.clear();
-    lruAGT.clear();
-    lruPHT.clear();
-
+    fatal_if(!isPowerOf2(regionSize) || regionSize < blkSize,
+        "The spatial region size must be a power of 2 of at least a block");
+    fatal_if((regionSize / blkSize) > 64,
+        "The spatial patterns can only hold 64 blocks per region");
 }
+
 void
-Sms::notifyEvict(const EvictionInfo &info)
+Sms::endGeneration(GenerationEntry &entry)
 {
-    //Check if any active generation has ended
-    Addr region_base = roundDown(info.addr, Region_Size);
-    std::pair <Addr,Addr> pc_offset = AGTPC[region_base];
-    if (AGT.find(region_base) != AGT.end()) {
-        //remove old recording
-        if (PHT.find(pc_offset) != PHT.end()) {
-            PHT[pc_offset].clear();
-        }
-        //Move from AGT to PHT
-        for (std::set<Addr>::iterator it = AGT[region_base].begin();
-         it != AGT[region_base].end(); it ++) {
-            PHT[pc_offset].insert(*it);
-        }
-        lruPHT.push_front(pc_offset);
+    const PatternEntry::KeyType key =
+        patternKey(entry.pc, entry.triggerOffset);
+    PatternEntry *pht_entry = patternHistoryTable.findEntry(key);
+    if (pht_entry == nullptr) {
+        pht_entry = patternHistoryTable.findVictim(key);
+        assert(pht_entry != nullptr);
+        patternHistoryTable.insertEntry(key, pht_entry);
+    } else {
+        patternHistoryTable.accessEntry(pht_entry);
     }
+    // The last generation replaces the previous recording
+    pht_entry->pattern = entry.pattern;
 
-    while (PHT.size() > MAX_PHTSize) {
-        PHT.erase(lruPHT.back());
-        lruPHT.pop_back();
-    }
+    activeGenerationTable.invalidate(&entry);
+}
 
-    AGTPC.erase(region_base);
-    AGT.erase(region_base);
+void
+Sms::notifyEvict(const EvictionInfo &info)
+{
+    // Evicting any block of a region ends its generation
+    const GenerationEntry::KeyType key{info.addr / regionSize,
+        info.isSecure};
+    if (GenerationEntry *agt_entry = activeGenerationTable.findEntry(key)) {
+        endGeneration(*agt_entry);
+    } else if (GenerationEntry *ft_entry = filterTable.findEntry(key)) {
+        // A single access does not make a pattern worth recording
+        filterTable.invalidate(ft_entry);
+    }
 }
+
 void
 Sms::calculatePrefetch(const PrefetchInfo &pfi,
     std::vector<AddrPriority> &addresses,
     const CacheAccessor &cache)
 {
-
     if (!pfi.hasPC()) {
         DPRINTF(HWPrefetch, "Ignoring request with no PC.\n");
         return;
     }
 
-    Addr blk_addr = blockAddress(pfi.getAddr());
-    Addr pc = pfi.getPC();
-    Addr region_base = roundDown(blk_addr, Region_Size);
-    Addr offset = blk_addr - region_base;
-
-    //Training
-    if (AGT.find(region_base) != AGT.end()) {
-        assert (FT.find(region_base) == FT.end());
-        // Record Pattern
-        AGT[region_base].insert(offset);
-        //update LRU
-        for (std::deque <Addr>::iterator lit = lruAGT.begin();
-         lit != lruAGT.end(); lit ++) {
-            if ((*lit) == region_base) {
-                lruAGT.erase(lit);
-                lruAGT.push_front(region_base);
-                break;
-            }
-        }
-    } else if (FT.find(region_base) != FT.end()) {
-        //move entry from FT to AGT
-        AGT[region_base].insert(FT[region_base].second);
-        AGTPC[region_base] = FT[region_base];
-        lruAGT.push_front(region_base);
-        //Record latest offset
-        AGT[region_base].insert(offset);
-        //Recycle FT entry
-        FT.erase(region_base);
-        //Make space for next entry
-        while (AGT.size() > Max_Contexts) {
-            AGT.erase(lruAGT.back());
-            AGTPC.erase(lruAGT.back());
-            lruAGT.pop_back();
-        }
-    } else {
-        // Trigger Access
-        FT[region_base] = std::make_pair (pc,offset);
-        fifoFT.push_front(region_base);
-        while (FT.size() > Max_Contexts) {
-            FT.erase(fifoFT.back());
-            fifoFT.pop_back();
-        }
+    const Addr pc = pfi.getPC();
+    const Addr region = pfi.getAddr() / regionSize;
+    const Addr region_base = region * regionSize;
+    const unsigned offset = (pfi.getAddr() - region_base) / blkSize;
+    const GenerationEntry::KeyType key{region, pfi.isSecure()};
+
+    // Training
+    if (GenerationEntry *agt_entry = activeGenerationTable.findEntry(key)) {
+        // Record the access in the active generation
+        activeGenerationTable.accessEntry(agt_entry);
+        agt_entry->pattern |= 1ULL << offset;
+        return;
     }
 
-    //Prediction
-    std::pair <Addr, Addr> pc_offset = std::make_pair(pc,offset);
-    if (PHT.find(pc_offset) != PHT.end()) {
-        for (std::set<Addr>::iterator it = PHT[pc_offset].begin();
-         it != PHT[pc_offset].end(); it ++) {
-            Addr pref_addr = blockAddress(region_base + (*it));
-            addresses.push_back(AddrPriority(pref_addr,0));
-        }
-        for (std::deque < std::pair <Addr,Addr> >::iterator lit
-         = lruPHT.begin(); lit != lruPHT.end(); lit ++) {
-            if ((*lit) == pc_offset) {
-                    lruPHT.erase(lit);
-                    lruPHT.push_front(pc_offset);
-                    break;
-            }
+    if (GenerationEntry *ft_entry = filterTable.findEntry(key)) {
+        if (offset == ft_entry->triggerOffset) {
+            return;
         }
+
+        // A second distinct block was accessed: move the region to the AGT
+        GenerationEntry *agt_entry = activeGenerationTable.findVictim(key);
+        assert(agt_entry != nullptr);
+        activeGenerationTable.insertEntry(key, agt_entry);
+        agt_entry->pc = ft_entry->pc;
+        agt_entry->triggerOffset = ft_entry->triggerOffset;
+        agt_entry->pattern = ft_entry->pattern | (1ULL << offset);
+        filterTable.invalidate(ft_entry);
+        return;
     }
 
+    // Trigger access: start a new generation in the FT
+    GenerationEntry *ft_entry = filterTable.findVictim(key);
+    assert(ft_entry != nullptr);
+    filterTable.insertEntry(key, ft_entry);
+    ft_entry->pc = pc;
+    ft_entry->triggerOffset = offset;
+    ft_entry->pattern = 1ULL << offset;
+
+    // Prediction: replay the last pattern recorded for this trigger
+    PatternEntry *pht_entry =
+        patternHistoryTable.findEntry(patternKey(pc, offset));
+    if (pht_entry == nullptr) {
+        return;
+    }
+    patternHistoryTable.accessEntry(pht_entry);
+
+    uint64_t pattern = pht_entry->pattern & ~(1ULL << offset);
+    while (pattern != 0) {
+        const int blk_offset = findLsbSet(pattern);
+        pattern &= pattern - 1;
+        addresses.push_back(
+            AddrPriority(region_base + blk_offset * blkSize, 0));
+    }
 }
 
 } // namespace prefetch
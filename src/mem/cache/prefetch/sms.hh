@@ -34,9 +34,12 @@
 #ifndef __MEM_CACHE_PREFETCH_SMS_HH__
 #define __MEM_CACHE_PREFETCH_SMS_HH__
 
-#include <set>
+#include <cstdint>
+#include <vector>
 
+#include "base/cache/associative_cache.hh"
 #include "mem/cache/prefetch/queued.hh"
+#include "mem/cache/tags/tagged_entry.hh"
 #include "mem/packet.hh"
 
 namespace gem5
@@ -47,22 +50,99 @@ struct SmsPrefetcherParams;
 namespace prefetch
 {
 
-
+/**
+ * Spatial Memory Streaming (Somogyi et al., ISCA 2006). Accesses to a
+ * spatial region are recorded as a bit vector while the region is active,
+ * which is from its first (trigger) access until one of its blocks is
+ * evicted. The pattern is then stored in the pattern history table, indexed
+ * by the PC and region offset of the trigger access, and replayed the next
+ * time that PC and offset trigger a region.
+ *
+ * All tables are bounded associative structures, sized as in hardware.
+ */
 class Sms : public Queued
 {
-
   private:
-    const int Max_Contexts; //= 64;
-    const uint64_t MAX_PHTSize; //= 512;
-    const Addr Region_Size; //= 4096;
-
-    std::map< Addr, std::set<Addr> > AGT;
-    std::map< Addr, std::pair<Addr,Addr> > AGTPC;
-    std::map< Addr, std::pair<Addr,Addr> > FT;
-    std::map< std::pair <Addr,Addr> , std::set<Addr> > PHT;
-    std::deque<Addr> fifoFT;
-    std::deque<Addr> lruAGT;
-    std::deque< std::pair <Addr,Addr> > lruPHT;
+    /** Size of each spatial region, in bytes */
+    const Addr regionSize;
+
+    /** log_2 of the number of blocks in a spatial region */
+    const unsigned regionBlocksBits;
+
+    /** Entry of the filter and active generation tables */
+    struct GenerationEntry : public TaggedEntry
+    {
+        /** PC of the trigger access */
+        Addr pc;
+        /** Offset, in blocks, of the trigger access within the region */
+        unsigned triggerOffset;
+        /** Blocks of the region accessed during this generation */
+        uint64_t pattern;
+
+        GenerationEntry(TagExtractor ext)
+          : TaggedEntry(), pc(0), triggerOffset(0), pattern(0)
+        {
+            registerTagExtractor(ext);
+        }
+
+        void
+        invalidate() override
+        {
+            TaggedEntry::invalidate();
+            pc = 0;
+            triggerOffset = 0;
+            pattern = 0;
+        }
+    };
+
+    /** Entry of the pattern history table */
+    struct PatternEntry : public TaggedEntry
+    {
+        /** Blocks accessed during the last generation of this trigger */
+        uint64_t pattern;
+
+        PatternEntry(TagExtractor ext)
+          : TaggedEntry(), pattern(0)
+        {
+            registerTagExtractor(ext);
+        }
+
+        void
+        invalidate() override
+        {
+            TaggedEntry::invalidate();
+            pattern = 0;
+        }
+    };
+
+    /** Filter table (FT): regions that have seen a single access */
+    AssociativeCache<GenerationEntry> filterTable;
+
+    /** Accumulation table (AGT): regions with an active generation */
+    AssociativeCache<GenerationEntry> activeGenerationTable;
+
+    /** Pattern history table (PHT) */
+    AssociativeCache<PatternEntry> patternHistoryTable;
+
+    /**
+     * Build the key used to index the pattern history table.
+     * @param pc PC of the trigger access
+     * @param offset Offset, in blocks, of the trigger access
+     * @return The PHT key
+     */
+    PatternEntry::KeyType
+    patternKey(Addr pc, unsigned offset) const
+    {
+        // The secure bit is unused, as the PHT is indexed with the PC
+        return {(pc << regionBlocksBits) | offset, false};
+    }
+
+    /**
+     * End the generation of an active region, and store its pattern in
+     * the pattern history table.
+     * @param entry The AGT entry of the region
+     */
+    void endGeneration(GenerationEntry &entry);
 
     using EvictionInfo = CacheDataUpdateProbeArg;
     void notifyEvict(const EvictionInfo &info) override;
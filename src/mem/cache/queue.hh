@@ -48,7 +48,9 @@
 #include <cassert>
 #include <string>
 #include <type_traits>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
@@ -101,6 +103,41 @@ class Queue : public Drainable, public Named
     /** Holds non allocated entries. */
     typename Entry::List freeList;
 
+    /**
+     * Optional block address index of the allocated entries, empty if
+     * disabled. Each bucket chains its entries through indexNext in
+     * allocation order, so the first match in a bucket is also the
+     * first match in allocatedList.
+     */
+    std::vector<Entry*> indexBuckets;
+    /** Next entry in the bucket chain, indexed by entry position. */
+    std::vector<Entry*> indexNext;
+    /** Shift applied to the hashed block address to get a bucket. */
+    int indexShift;
+
+    std::size_t
+    indexBucket(Addr blk_addr) const
+    {
+        return (blk_addr * 0x9e3779b97f4a7c15ULL) >> indexShift;
+    }
+
+    /**
+     * Append a newly allocated entry to allocatedList and to the block
+     * address index.
+     */
+    typename Entry::Iterator addToAllocatedList(Entry* entry)
+    {
+        if (!indexBuckets.empty()) {
+            Entry **link = &indexBuckets[indexBucket(entry->blkAddr)];
+            while (*link) {
+                link = &indexNext[*link - entries.data()];
+            }
+            *link = entry;
+            indexNext[entry - entries.data()] = nullptr;
+        }
+        return allocatedList.insert(allocatedList.end(), entry);
+    }
+
     typename Entry::Iterator addToReadyList(Entry* entry)
     {
         if (readyList.empty() ||
@@ -129,17 +166,26 @@ class Queue : public Drainable, public Named
      *
      * @param num_entries The number of entries in this queue.
      * @param reserve The extra overflow entries needed.
+     * @param hash_index Index the allocated entries by block address.
      */
     Queue(const std::string &_label, int num_entries, int reserve,
-            const std::string &name) :
+            const std::string &name, bool hash_index = false) :
         Named(name),
         label(_label), numEntries(num_entries + reserve),
         numReserve(reserve), entries(numEntries, name + ".entry"),
-        _numInService(0), allocated(0)
+        indexShift(0), _numInService(0), allocated(0)
     {
         for (int i = 0; i < numEntries; ++i) {
             freeList.push_back(&entries[i]);
         }
+
+        if (hash_index && numEntries > 0) {
+            // Keep the buckets at most half full
+            const int bits = ceilLog2(numEntries) + 1;
+            indexBuckets.assign(1ULL << bits, nullptr);
+            indexNext.assign(numEntries, nullptr);
+            indexShift = 64 - bits;
+        }
     }
 
     bool isEmpty() const
@@ -168,6 +214,17 @@ class Queue : public Drainable, public Named
     Entry* findMatch(Addr blk_addr, bool is_secure,
                      bool ignore_uncacheable = true) const
     {
+        if (!indexBuckets.empty()) {
+            for (Entry *entry = indexBuckets[indexBucket(blk_addr)]; entry;
+                 entry = indexNext[entry - entries.data()]) {
+                if (!(ignore_uncacheable && entry->isUncacheable()) &&
+                    entry->matchBlockAddr(blk_addr, is_secure)) {
+                    return entry;
+                }
+            }
+            return nullptr;
+        }
+
         for (const auto& entry : allocatedList) {
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
@@ -240,6 +297,14 @@ class Queue : public Drainable, public Named
     virtual void
     deallocate(Entry *entry)
     {
+        if (!indexBuckets.empty()) {
+            Entry **link = &indexBuckets[indexBucket(entry->blkAddr)];
+            while (*link != entry) {
+                assert(*link);
+                link = &indexNext[*link - entries.data()];
+            }
+            *link = indexNext[entry - entries.data()];
+        }
         allocatedList.erase(entry->allocIter);
         freeList.push_front(entry);
         allocated--;
@@ -80,6 +80,12 @@ class Base : public SimObject
     virtual void touch(const std::shared_ptr<ReplacementData>&
         replacement_data) const = 0;
 
+    /**
+     * Whether touching without the packet of the access loses information
+     * the policy relies on (e.g., the PC of the access).
+     */
+    virtual bool touchNeedsPacket() const { return false; }
+
     /**
      * Reset replacement data. Used when it's holder is inserted/validated.
      *
@@ -94,6 +100,33 @@ class Base : public SimObject
     virtual void reset(const std::shared_ptr<ReplacementData>&
         replacement_data) const = 0;
 
+    /**
+     * Get the replacement state of an entry as a single word, e.g., to
+     * checkpoint warm caches. Policies that can't express their state
+     * this way return 0, their entries are reset when restored instead.
+     *
+     * @param replacement_data Replacement data to be saved.
+     * @return The state of the entry.
+     */
+    virtual uint64_t
+    getState(const std::shared_ptr<ReplacementData>& replacement_data) const
+    {
+        return 0;
+    }
+
+    /**
+     * Restore the replacement state of a valid entry, as returned by
+     * getState().
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param state The state of the entry.
+     */
+    virtual void
+    setState(const std::shared_ptr<ReplacementData>& replacement_data,
+             uint64_t state) const
+    {
+    }
+
     /**
      * Find replacement victim among candidates.
      *
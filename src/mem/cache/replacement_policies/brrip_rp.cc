@@ -50,8 +50,8 @@ BRRIP::BRRIP(const Params &p)
 void
 BRRIP::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
-    std::shared_ptr<BRRIPReplData> casted_replacement_data =
-        std::static_pointer_cast<BRRIPReplData>(replacement_data);
+    BRRIPReplData *casted_replacement_data =
+        replDataCast<BRRIPReplData>(replacement_data);
 
     // Invalidate entry
     casted_replacement_data->valid = false;
@@ -60,8 +60,8 @@ BRRIP::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 void
 BRRIP::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
-    std::shared_ptr<BRRIPReplData> casted_replacement_data =
-        std::static_pointer_cast<BRRIPReplData>(replacement_data);
+    BRRIPReplData *casted_replacement_data =
+        replDataCast<BRRIPReplData>(replacement_data);
 
     // Update RRPV if not 0 yet
     // Every hit in HP mode makes the entry the last to be evicted, while
@@ -76,8 +76,8 @@ BRRIP::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 void
 BRRIP::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
-    std::shared_ptr<BRRIPReplData> casted_replacement_data =
-        std::static_pointer_cast<BRRIPReplData>(replacement_data);
+    BRRIPReplData *casted_replacement_data =
+        replDataCast<BRRIPReplData>(replacement_data);
 
     // Reset RRPV
     // Replacement data is inserted as "long re-reference" if lower than btp,
@@ -91,6 +91,25 @@ BRRIP::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
     casted_replacement_data->valid = true;
 }
 
+uint64_t
+BRRIP::getState(const std::shared_ptr<ReplacementData>& replacement_data)
+    const
+{
+    return replDataCast<BRRIPReplData>(replacement_data)->rrpv;
+}
+
+void
+BRRIP::setState(const std::shared_ptr<ReplacementData>& replacement_data,
+                uint64_t state) const
+{
+    BRRIPReplData *casted_replacement_data =
+        replDataCast<BRRIPReplData>(replacement_data);
+
+    casted_replacement_data->rrpv.reset();
+    casted_replacement_data->rrpv += state;
+    casted_replacement_data->valid = true;
+}
+
 ReplaceableEntry*
 BRRIP::getVictim(const ReplacementCandidates& candidates) const
 {
@@ -101,14 +120,13 @@ BRRIP::getVictim(const ReplacementCandidates& candidates) const
     ReplaceableEntry* victim = candidates[0];
 
     // Store victim->rrpv in a variable to improve code readability
-    int victim_RRPV = std::static_pointer_cast<BRRIPReplData>(
+    int victim_RRPV = replDataCast<BRRIPReplData>(
                         victim->replacementData)->rrpv;
 
     // Visit all candidates to find victim
     for (const auto& candidate : candidates) {
-        std::shared_ptr<BRRIPReplData> candidate_repl_data =
-            std::static_pointer_cast<BRRIPReplData>(
-                candidate->replacementData);
+        BRRIPReplData *candidate_repl_data =
+            replDataCast<BRRIPReplData>(candidate->replacementData);
 
         // Stop searching for victims if an invalid entry is found
         if (!candidate_repl_data->valid) {
@@ -125,14 +143,14 @@ BRRIP::getVictim(const ReplacementCandidates& candidates) const
 
     // Get difference of victim's RRPV to the highest possible RRPV in
     // order to update the RRPV of all the other entries accordingly
-    int diff = std::static_pointer_cast<BRRIPReplData>(
+    int diff = replDataCast<BRRIPReplData>(
         victim->replacementData)->rrpv.saturate();
 
     // No need to update RRPV if there is no difference
     if (diff > 0){
         // Update RRPV of all candidates
         for (const auto& candidate : candidates) {
-            std::static_pointer_cast<BRRIPReplData>(
+            replDataCast<BRRIPReplData>(
                 candidate->replacementData)->rrpv += diff;
         }
     }
@@ -143,7 +161,7 @@ BRRIP::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 BRRIP::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new BRRIPReplData(numRRPVBits));
+    return replData.allocate(numRRPVBits);
 }
 
 } // namespace replacement_policy
@@ -55,6 +55,7 @@
 #include "base/random.hh"
 #include "base/sat_counter.hh"
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
 
 namespace gem5
 {
@@ -114,6 +115,12 @@ class BRRIP : public Base
 
     mutable Random::RandomPtr rng = Random::genRandom();
 
+    /**
+     * Storage of the replacement data of all entries. Derived policies
+     * allocate their own BRRIPReplData subclass from it.
+     */
+    ReplacementDataArena<BRRIPReplData> replData;
+
   public:
     typedef BRRIPRPParams Params;
     BRRIP(const Params &p);
@@ -145,6 +152,24 @@ class BRRIP : public Base
     void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
                                                                      override;
 
+    /**
+     * Get the re-reference prediction value of an entry as its replacement state.
+     *
+     * @param replacement_data Replacement data to be saved.
+     * @return The state of the entry.
+     */
+    uint64_t getState(const std::shared_ptr<ReplacementData>&
+                      replacement_data) const override;
+
+    /**
+     * Restore the re-reference prediction value of an entry.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param state The state of the entry.
+     */
+    void setState(const std::shared_ptr<ReplacementData>& replacement_data,
+                  uint64_t state) const override;
+
     /**
      * Find replacement victim using rrpv.
      *
@@ -103,6 +103,12 @@ class Dueling : public Base
         const PacketPtr pkt) override;
     void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
                                                                      override;
+    bool
+    touchNeedsPacket() const override
+    {
+        return replPolicyA->touchNeedsPacket() ||
+            replPolicyB->touchNeedsPacket();
+    }
     void reset(const std::shared_ptr<ReplacementData>& replacement_data,
         const PacketPtr pkt) override;
     void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
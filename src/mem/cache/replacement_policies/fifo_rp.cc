@@ -28,6 +28,7 @@
 
 #include "mem/cache/replacement_policies/fifo_rp.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 
@@ -67,6 +68,23 @@ FIFO::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
         replacement_data)->tickInserted = ++timeTicks;
 }
 
+uint64_t
+FIFO::getState(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    return std::static_pointer_cast<FIFOReplData>(
+        replacement_data)->tickInserted;
+}
+
+void
+FIFO::setState(const std::shared_ptr<ReplacementData>& replacement_data,
+               uint64_t state) const
+{
+    std::static_pointer_cast<FIFOReplData>(
+        replacement_data)->tickInserted = state;
+    // Entries inserted from now on must be younger than restored ones
+    timeTicks = std::max<uint64_t>(timeTicks, state);
+}
+
 ReplaceableEntry*
 FIFO::getVictim(const ReplacementCandidates& candidates) const
 {
@@ -65,6 +65,20 @@ LFU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
     std::static_pointer_cast<LFUReplData>(replacement_data)->refCount = 1;
 }
 
+uint64_t
+LFU::getState(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    return std::static_pointer_cast<LFUReplData>(replacement_data)->refCount;
+}
+
+void
+LFU::setState(const std::shared_ptr<ReplacementData>& replacement_data,
+              uint64_t state) const
+{
+    std::static_pointer_cast<LFUReplData>(replacement_data)->refCount =
+        state;
+}
+
 ReplaceableEntry*
 LFU::getVictim(const ReplacementCandidates& candidates) const
 {
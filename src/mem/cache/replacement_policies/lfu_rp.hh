@@ -94,6 +94,24 @@ class LFU : public Base
     void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
                                                                      override;
 
+    /**
+     * Get the reference count of an entry as its replacement state.
+     *
+     * @param replacement_data Replacement data to be saved.
+     * @return The state of the entry.
+     */
+    uint64_t getState(const std::shared_ptr<ReplacementData>&
+                      replacement_data) const override;
+
+    /**
+     * Restore the reference count of an entry.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param state The state of the entry.
+     */
+    void setState(const std::shared_ptr<ReplacementData>& replacement_data,
+                  uint64_t state) const override;
+
     /**
      * Find replacement victim using reference frequency.
      *
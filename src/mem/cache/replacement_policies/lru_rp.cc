@@ -49,24 +49,34 @@ void
 LRU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Reset last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = Tick(0);
+    replDataCast<LRUReplData>(replacement_data)->lastTouchTick = Tick(0);
 }
 
 void
 LRU::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Update last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = curTick();
+    replDataCast<LRUReplData>(replacement_data)->lastTouchTick = curTick();
 }
 
 void
 LRU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
     // Set last touch timestamp
-    std::static_pointer_cast<LRUReplData>(
-        replacement_data)->lastTouchTick = curTick();
+    replDataCast<LRUReplData>(replacement_data)->lastTouchTick = curTick();
+}
+
+uint64_t
+LRU::getState(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    return replDataCast<LRUReplData>(replacement_data)->lastTouchTick;
+}
+
+void
+LRU::setState(const std::shared_ptr<ReplacementData>& replacement_data,
+              uint64_t state) const
+{
+    replDataCast<LRUReplData>(replacement_data)->lastTouchTick = state;
 }
 
 ReplaceableEntry*
@@ -79,9 +89,9 @@ LRU::getVictim(const ReplacementCandidates& candidates) const
     ReplaceableEntry* victim = candidates[0];
     for (const auto& candidate : candidates) {
         // Update victim entry if necessary
-        if (std::static_pointer_cast<LRUReplData>(
+        if (replDataCast<LRUReplData>(
                     candidate->replacementData)->lastTouchTick <
-                std::static_pointer_cast<LRUReplData>(
+                replDataCast<LRUReplData>(
                     victim->replacementData)->lastTouchTick) {
             victim = candidate;
         }
@@ -93,7 +103,7 @@ LRU::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 LRU::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new LRUReplData());
+    return replData.allocate();
 }
 
 } // namespace replacement_policy
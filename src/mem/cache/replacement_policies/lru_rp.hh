@@ -36,6 +36,7 @@
 #define __MEM_CACHE_REPLACEMENT_POLICIES_LRU_RP_HH__
 
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
 
 namespace gem5
 {
@@ -60,6 +61,9 @@ class LRU : public Base
         LRUReplData() : lastTouchTick(0) {}
     };
 
+    /** Storage of the replacement data of all entries. */
+    ReplacementDataArena<LRUReplData> replData;
+
   public:
     typedef LRURPParams Params;
     LRU(const Params &p);
@@ -92,6 +96,24 @@ class LRU : public Base
     void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
                                                                      override;
 
+    /**
+     * Get the last touch tick of an entry as its replacement state.
+     *
+     * @param replacement_data Replacement data to be saved.
+     * @return The state of the entry.
+     */
+    uint64_t getState(const std::shared_ptr<ReplacementData>&
+                      replacement_data) const override;
+
+    /**
+     * Restore the last touch tick of an entry.
+     *
+     * @param replacement_data Replacement data to be restored.
+     * @param state The state of the entry.
+     */
+    void setState(const std::shared_ptr<ReplacementData>& replacement_data,
+                  uint64_t state) const override;
+
     /**
      * Find replacement victim using LRU timestamps.
      *
@@ -341,8 +341,8 @@ Mockingjay::checkEvictedReuse(Addr pc, Tick currentTick)
 void
 Mockingjay::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
-    std::shared_ptr<MockingjayReplData> casted_replacement_data =
-        std::static_pointer_cast<MockingjayReplData>(replacement_data);
+    MockingjayReplData *casted_replacement_data =
+        replDataCast<MockingjayReplData>(replacement_data);
 
     // Reset all fields
     casted_replacement_data->pc = 0;
@@ -360,8 +360,8 @@ void
 Mockingjay::touch(const std::shared_ptr<ReplacementData>& replacement_data,
                   const PacketPtr pkt)
 {
-    std::shared_ptr<MockingjayReplData> casted_replacement_data =
-        std::static_pointer_cast<MockingjayReplData>(replacement_data);
+    MockingjayReplData *casted_replacement_data =
+        replDataCast<MockingjayReplData>(replacement_data);
 
     // Update access count
     casted_replacement_data->accessCount++;
@@ -390,14 +390,14 @@ Mockingjay::touch(const std::shared_ptr<ReplacementData>& replacement_data,
 
     // Recompute priority
     casted_replacement_data->priority = computePriority(
-        casted_replacement_data.get());
+        casted_replacement_data);
 }
 
 void
 Mockingjay::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
-    std::shared_ptr<MockingjayReplData> casted_replacement_data =
-        std::static_pointer_cast<MockingjayReplData>(replacement_data);
+    MockingjayReplData *casted_replacement_data =
+        replDataCast<MockingjayReplData>(replacement_data);
 
     // Update access count
     casted_replacement_data->accessCount++;
@@ -407,15 +407,15 @@ Mockingjay::touch(const std::shared_ptr<ReplacementData>& replacement_data) cons
 
     // Recompute priority (note: this modifies mutable state)
     casted_replacement_data->priority = computePriority(
-        casted_replacement_data.get());
+        casted_replacement_data);
 }
 
 void
 Mockingjay::reset(const std::shared_ptr<ReplacementData>& replacement_data,
                   const PacketPtr pkt)
 {
-    std::shared_ptr<MockingjayReplData> casted_replacement_data =
-        std::static_pointer_cast<MockingjayReplData>(replacement_data);
+    MockingjayReplData *casted_replacement_data =
+        replDataCast<MockingjayReplData>(replacement_data);
 
     // Initialize with current time
     Tick currentTick = curTick();
@@ -440,14 +440,14 @@ Mockingjay::reset(const std::shared_ptr<ReplacementData>& replacement_data,
 
     // Compute initial priority
     casted_replacement_data->priority = computePriority(
-        casted_replacement_data.get());
+        casted_replacement_data);
 }
 
 void
 Mockingjay::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
-    std::shared_ptr<MockingjayReplData> casted_replacement_data =
-        std::static_pointer_cast<MockingjayReplData>(replacement_data);
+    MockingjayReplData *casted_replacement_data =
+        replDataCast<MockingjayReplData>(replacement_data);
 
     // Initialize with current time
     Tick currentTick = curTick();
@@ -458,7 +458,7 @@ Mockingjay::reset(const std::shared_ptr<ReplacementData>& replacement_data) cons
 
     // Compute initial priority
     casted_replacement_data->priority = computePriority(
-        casted_replacement_data.get());
+        casted_replacement_data);
 }
 
 ReplaceableEntry*
@@ -470,21 +470,19 @@ Mockingjay::getVictim(const ReplacementCandidates& candidates) const
     // Bug #2 Fix: First pass - recompute all priorities to ensure they reflect
     // current state (tick/age) rather than stale values from last access
     for (const auto& candidate : candidates) {
-        std::shared_ptr<MockingjayReplData> cand_data =
-            std::static_pointer_cast<MockingjayReplData>(
-                candidate->replacementData);
-        cand_data->priority = computePriority(cand_data.get());
+        MockingjayReplData *cand_data =
+            replDataCast<MockingjayReplData>(candidate->replacementData);
+        cand_data->priority = computePriority(cand_data);
     }
 
     // Second pass: Visit all candidates to find victim with highest priority
     ReplaceableEntry* victim = candidates[0];
-    double maxPriority = std::static_pointer_cast<MockingjayReplData>(
+    double maxPriority = replDataCast<MockingjayReplData>(
         victim->replacementData)->priority;
 
     for (const auto& candidate : candidates) {
-        std::shared_ptr<MockingjayReplData> cand_data =
-            std::static_pointer_cast<MockingjayReplData>(
-                candidate->replacementData);
+        MockingjayReplData *cand_data =
+            replDataCast<MockingjayReplData>(candidate->replacementData);
 
         // Update victim entry if this candidate has higher priority
         if (cand_data->priority > maxPriority) {
@@ -495,9 +493,8 @@ Mockingjay::getVictim(const ReplacementCandidates& candidates) const
 
     // Track this eviction for online learning
     if (enableOnlineLearning) {
-        std::shared_ptr<MockingjayReplData> victim_data =
-            std::static_pointer_cast<MockingjayReplData>(
-                victim->replacementData);
+        MockingjayReplData *victim_data =
+            replDataCast<MockingjayReplData>(victim->replacementData);
 
         double features[4];
         features[0] = computePcHashFeature(victim_data->pc);
@@ -515,7 +512,7 @@ Mockingjay::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 Mockingjay::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new MockingjayReplData());
+    return replData.allocate();
 }
 
 } // namespace replacement_policy
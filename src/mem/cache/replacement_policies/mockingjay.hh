@@ -43,6 +43,7 @@
 #include <unordered_map>
 
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
 #include "params/MockingjayRP.hh"
 
 namespace gem5
@@ -173,6 +174,9 @@ class Mockingjay : public Base
      */
     void checkEvictedReuse(Addr pc, Tick currentTick);
 
+    /** Storage of the replacement data of all entries. */
+    ReplacementDataArena<MockingjayReplData> replData;
+
   public:
     typedef MockingjayRPParams Params;
     Mockingjay(const Params &p);
@@ -198,6 +202,7 @@ class Mockingjay : public Base
 
     void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
                                                                      override;
+    bool touchNeedsPacket() const override { return true; }
 
     /**
      * Reset replacement data. Used when an entry is inserted.
@@ -69,6 +69,21 @@ MRU::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
         replacement_data)->lastTouchTick = curTick();
 }
 
+uint64_t
+MRU::getState(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    return std::static_pointer_cast<MRUReplData>(
+        replacement_data)->lastTouchTick;
+}
+
+void
+MRU::setState(const std::shared_ptr<ReplacementData>& replacement_data,
+              uint64_t state) const
+{
+    std::static_pointer_cast<MRUReplData>(
+        replacement_data)->lastTouchTick = state;
+}
+
 ReplaceableEntry*
 MRU::getVictim(const ReplacementCandidates& candidates) const
 {
@@ -49,7 +49,7 @@ namespace replacement_policy
 class Random : public Base
 {
   protected:
-    mutable gem5::Random::RandomPtr rng = gem5::Random::genRandom();
+    mutable gem5::Random::RandomPtr rng = gem5::Random::genRandom(name());
 
     /** Random-specific implementation of replacement data. */
     struct RandomReplData : ReplacementData
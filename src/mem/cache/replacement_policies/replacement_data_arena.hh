@@ -0,0 +1,138 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Contiguous, policy-owned storage for replacement data.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEMENT_DATA_ARENA_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEMENT_DATA_ARENA_HH__
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "base/logging.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+
+namespace gem5
+{
+
+namespace replacement_policy
+{
+
+/**
+ * Array-backed storage for the replacement data of a policy.
+ *
+ * Instead of heap-allocating every entry's data, a policy hands out
+ * slots of chunks it owns. Tables instantiate their entries in index
+ * order, so the data of the ways of a set end up next to each other and
+ * a victim scan walks contiguous memory. The returned pointers alias
+ * the chunk, so all entries of a chunk share a single control block and
+ * no per-entry allocation takes place.
+ *
+ * A policy derived from another one may store a type derived from the
+ * base policy's data in the inherited arena, so that there is a single
+ * arena per policy. All entries of an arena must have the same type.
+ *
+ * @tparam Data The policy-specific replacement data type.
+ */
+template <class Data>
+class ReplacementDataArena
+{
+  private:
+    /** Size of the first chunk; later chunks double up to MaxChunkSize. */
+    static constexpr std::size_t MinChunkSize = 64;
+    static constexpr std::size_t MaxChunkSize = 4096;
+
+    /**
+     * The chunk entries are currently being allocated from, a
+     * std::vector of the type given to the first allocate call.
+     */
+    std::shared_ptr<void> chunk;
+
+    /** Type stored in the chunks, set by the first allocation. */
+    const std::type_info *type = nullptr;
+
+  public:
+    /**
+     * Allocate the replacement data of a new entry.
+     *
+     * @tparam T The type of the data, Data or a type derived from it.
+     * @param args Arguments to construct the data with.
+     * @return A pointer to the data, sharing ownership of its chunk.
+     */
+    template <class T = Data, typename... Args>
+    std::shared_ptr<ReplacementData>
+    allocate(Args&&... args)
+    {
+        static_assert(std::is_base_of_v<Data, T>,
+                      "Arena entries must derive from the arena's type");
+        using Chunk = std::vector<T>;
+
+        if (!type) {
+            type = &typeid(T);
+        }
+        panic_if(*type != typeid(T),
+                 "Replacement data of different types in a single arena.");
+
+        auto *current = static_cast<Chunk *>(chunk.get());
+        if (!current || current->size() == current->capacity()) {
+            const std::size_t size = current ?
+                std::min(current->capacity() * 2, MaxChunkSize) :
+                MinChunkSize;
+            auto next = std::make_shared<Chunk>();
+            next->reserve(size);
+            current = next.get();
+            chunk = std::move(next);
+        }
+
+        // The chunk never grows past its reserved capacity, so pointers
+        // to its elements remain valid
+        current->emplace_back(std::forward<Args>(args)...);
+        return std::shared_ptr<ReplacementData>(chunk, &current->back());
+    }
+};
+
+/**
+ * Access replacement data as a policy-specific type, without the
+ * reference count updates of std::static_pointer_cast.
+ */
+template <class Data>
+inline Data *
+replDataCast(const std::shared_ptr<ReplacementData> &replacement_data)
+{
+    return static_cast<Data *>(replacement_data.get());
+}
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEMENT_DATA_ARENA_HH__
@@ -0,0 +1,118 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "mem/cache/replacement_policies/replacement_data_arena.hh"
+
+using namespace gem5;
+using namespace gem5::replacement_policy;
+
+namespace
+{
+
+struct TestReplData : ReplacementData
+{
+    TestReplData(int value) : value(value) { ++alive; }
+    TestReplData(const TestReplData &other) : value(other.value) { ++alive; }
+    ~TestReplData() { --alive; }
+
+    int value;
+    static int alive;
+};
+
+int TestReplData::alive = 0;
+
+} // anonymous namespace
+
+/** Arguments are forwarded to the data's constructor. */
+TEST(ReplacementDataArenaTest, Construct)
+{
+    ReplacementDataArena<TestReplData> arena;
+    auto data = arena.allocate(42);
+    ASSERT_EQ(replDataCast<TestReplData>(data)->value, 42);
+}
+
+/** Consecutive entries are stored next to each other. */
+TEST(ReplacementDataArenaTest, Contiguous)
+{
+    ReplacementDataArena<TestReplData> arena;
+    std::vector<std::shared_ptr<ReplacementData>> entries;
+    for (int i = 0; i < 16; ++i) {
+        entries.push_back(arena.allocate(i));
+    }
+    for (int i = 1; i < 16; ++i) {
+        ASSERT_EQ(replDataCast<TestReplData>(entries[i]),
+                  replDataCast<TestReplData>(entries[i - 1]) + 1);
+    }
+}
+
+/** Data stays valid across chunks and is destroyed with its last user. */
+TEST(ReplacementDataArenaTest, Lifetime)
+{
+    std::vector<std::shared_ptr<ReplacementData>> entries;
+    {
+        ReplacementDataArena<TestReplData> arena;
+        for (int i = 0; i < 10000; ++i) {
+            entries.push_back(arena.allocate(i));
+        }
+    }
+    ASSERT_EQ(TestReplData::alive, 10000);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(replDataCast<TestReplData>(entries[i])->value, i);
+    }
+
+    entries.clear();
+    ASSERT_EQ(TestReplData::alive, 0);
+}
+
+/** Data derived from the arena's type can be stored in the arena. */
+TEST(ReplacementDataArenaTest, Derived)
+{
+    struct DerivedReplData : TestReplData
+    {
+        DerivedReplData(int value, int extra)
+            : TestReplData(value), extra(extra)
+        {}
+
+        int extra;
+    };
+
+    ReplacementDataArena<TestReplData> arena;
+    std::vector<std::shared_ptr<ReplacementData>> entries;
+    for (int i = 0; i < 100; ++i) {
+        entries.push_back(arena.allocate<DerivedReplData>(i, -i));
+    }
+    for (int i = 0; i < 100; ++i) {
+        auto *data = replDataCast<DerivedReplData>(entries[i]);
+        ASSERT_EQ(data->value, i);
+        ASSERT_EQ(data->extra, -i);
+    }
+    ASSERT_EQ(replDataCast<DerivedReplData>(entries[1]),
+              replDataCast<DerivedReplData>(entries[0]) + 1);
+}
@@ -78,8 +78,8 @@ SHiP::SHiP(const Params &p)
 void
 SHiP::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
-    std::shared_ptr<SHiPReplData> casted_replacement_data =
-        std::static_pointer_cast<SHiPReplData>(replacement_data);
+    SHiPReplData *casted_replacement_data =
+        replDataCast<SHiPReplData>(replacement_data);
 
     // The predictor is detrained when an entry that has not been re-
     // referenced since insertion is invalidated
@@ -94,8 +94,8 @@ void
 SHiP::touch(const std::shared_ptr<ReplacementData>& replacement_data,
     const PacketPtr pkt)
 {
-    std::shared_ptr<SHiPReplData> casted_replacement_data =
-        std::static_pointer_cast<SHiPReplData>(replacement_data);
+    SHiPReplData *casted_replacement_data =
+        replDataCast<SHiPReplData>(replacement_data);
 
     // When a hit happens the SHCT entry indexed by the signature is
     // incremented
@@ -117,8 +117,8 @@ void
 SHiP::reset(const std::shared_ptr<ReplacementData>& replacement_data,
     const PacketPtr pkt)
 {
-    std::shared_ptr<SHiPReplData> casted_replacement_data =
-        std::static_pointer_cast<SHiPReplData>(replacement_data);
+    SHiPReplData *casted_replacement_data =
+        replDataCast<SHiPReplData>(replacement_data);
 
     // Get signature
     const SignatureType signature = getSignature(pkt);
@@ -144,7 +144,7 @@ SHiP::reset(const std::shared_ptr<ReplacementData>& replacement_data)
 std::shared_ptr<ReplacementData>
 SHiP::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new SHiPReplData(numRRPVBits));
+    return replData.allocate<SHiPReplData>(numRRPVBits);
 }
 
 SHiPMem::SHiPMem(const SHiPMemRPParams &p) : SHiP(p) {}
@@ -139,6 +139,7 @@ class SHiP : public BRRIP
         const PacketPtr pkt) override;
     void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
         override;
+    bool touchNeedsPacket() const override { return true; }
 
     /**
      * Reset replacement data. Used when an entry is inserted.
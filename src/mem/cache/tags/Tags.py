@@ -122,6 +122,12 @@ class BaseSetAssoc(BaseTags):
     )
 
 
+class FlatSetAssoc(BaseSetAssoc):
+    type = "FlatSetAssoc"
+    cxx_header = "mem/cache/tags/flat_set_assoc.hh"
+    cxx_class = "gem5::FlatSetAssoc"
+
+
 class SectorTags(BaseTags):
     type = "SectorTags"
     cxx_header = "mem/cache/tags/sector_tags.hh"
@@ -171,3 +177,29 @@ class FALRU(BaseTags):
 
     # This tag uses its own embedded indexing
     indexing_policy = NULL
+
+
+class SetDueling(SimObject):
+    type = "SetDueling"
+    cxx_header = "mem/cache/tags/set_dueling.hh"
+    cxx_class = "gem5::SetDueling"
+
+    size = Param.MemorySize(Parent.size, "capacity in bytes")
+    assoc = Param.Int(Parent.assoc, "associativity")
+    blk_size = Param.Int(Parent.cache_line_size, "block size in bytes")
+
+    constituency_size = Param.Unsigned(
+        32, "Number of sets in a region containing one sample of each team"
+    )
+    team_size = Param.Unsigned(
+        1, "Number of sets in a constituency that belong to each team"
+    )
+    num_bits = Param.Unsigned(10, "Number of bits of the selector counter")
+    low_threshold = Param.Float(
+        0.5, "Selector saturation below which option B is selected, as A "
+        "misses more"
+    )
+    high_threshold = Param.Float(
+        0.5, "Selector saturation above which option A is selected, as B "
+        "misses more"
+    )
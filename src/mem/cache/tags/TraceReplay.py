@@ -0,0 +1,87 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.ReplacementPolicies import *
+from m5.objects.Tags import *
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+
+class TagsReplayCache(SimObject):
+    """
+    A cache configuration replayed by a TagsTraceReplayer. It provides
+    the parameters tags normally take from their cache, so the tags,
+    indexing and replacement policies are the ones used in simulation.
+    """
+
+    type = "TagsReplayCache"
+    cxx_header = "mem/cache/tags/trace_replay.hh"
+    cxx_class = "gem5::TagsReplayCache"
+
+    size = Param.MemorySize("1MiB", "Capacity")
+    assoc = Param.Unsigned(16, "Associativity")
+    cache_line_size = Param.Unsigned(64, "Block size in bytes")
+    tag_latency = Param.Cycles(1, "Tag lookup latency")
+    warmup_percentage = Param.Percent(
+        0, "Percentage of tags to be touched to warm up the cache"
+    )
+    sequential_access = Param.Bool(
+        False, "Whether to access tags and data sequentially"
+    )
+    replacement_policy = Param.BaseReplacementPolicy(
+        LRURP(), "Replacement policy"
+    )
+    partitioning_manager = Param.PartitionManager(
+        NULL, "Cache partitioning manager"
+    )
+    tags = Param.BaseTags(BaseSetAssoc(), "Tag store")
+
+
+class TagsTraceReplayer(SimObject):
+    """
+    Replay a packet trace, protobuf or binary, through a set of cache
+    configurations in parallel host threads at startup, then exit. For
+    example, to compare replacement policies on the miss stream of an L2
+    recorded with a MemTraceProbe:
+
+        replayer = TagsTraceReplayer(
+            trace_file="l2_misses.trc.gz",
+            caches=[
+                TagsReplayCache(size=size, replacement_policy=rp())
+                for size in ["1MiB", "2MiB"]
+                for rp in [LRURP, SHiPPCRP, BRRIPRP, MockingjayRP]
+            ],
+        )
+    """
+
+    type = "TagsTraceReplayer"
+    cxx_header = "mem/cache/tags/trace_replay.hh"
+    cxx_class = "gem5::TagsTraceReplayer"
+
+    system = Param.System(Parent.any, "System the replayer belongs to")
+    trace_file = Param.String("Packet trace to replay")
+    caches = VectorParam.TagsReplayCache("Cache configurations to evaluate")
+    num_threads = Param.Unsigned(
+        0, "Host threads replaying configurations, 0 for all host CPUs"
+    )
@@ -45,7 +45,9 @@
 
 #include "mem/cache/tags/base.hh"
 
+#include <algorithm>
 #include <cassert>
+#include <typeinfo>
 
 #include "base/types.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
@@ -78,15 +80,33 @@ BaseTags::findBlockBySetAndWay(int set, int way) const
     return indexingPolicy->getEntry(set, way);
 }
 
+std::string
+BaseTags::getIndexingPolicyType() const
+{
+    return typeid(*indexingPolicy).name();
+}
+
+bool
+BaseTags::isValidBlockPosition(const CacheBlk::KeyType &key, uint32_t set,
+                               uint32_t way) const
+{
+    if (set >= getNumSets() || way >= getAssoc())
+        return false;
+
+    const ReplaceableEntry *entry = indexingPolicy->getEntry(set, way);
+    indexingPolicy->getPossibleEntries(key, lookupEntries);
+    return std::find(lookupEntries.begin(), lookupEntries.end(), entry) !=
+        lookupEntries.end();
+}
+
 CacheBlk*
 BaseTags::findBlock(const CacheBlk::KeyType &key) const
 {
     // Find possible entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
-        indexingPolicy->getPossibleEntries(key);
+    indexingPolicy->getPossibleEntries(key, lookupEntries);
 
     // Search for block
-    for (const auto& location : entries) {
+    for (const auto& location : lookupEntries) {
         CacheBlk* blk = static_cast<CacheBlk*>(location);
         if (blk->match(key)) {
             return blk;
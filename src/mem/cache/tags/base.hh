@@ -88,6 +88,13 @@ class BaseTags : public ClockedObject
     /** Indexing policy */
     TaggedIndexingPolicy *indexingPolicy;
 
+    /**
+     * Containers reused for the possible entries of a lookup and of a
+     * victim selection, so that accesses do not allocate.
+     */
+    mutable std::vector<ReplaceableEntry*> lookupEntries;
+    std::vector<ReplaceableEntry*> victimEntries;
+
     /** Partitioning manager */
     partitioning_policy::PartitionManager *partitionManager;
 
@@ -176,6 +183,21 @@ class BaseTags : public ClockedObject
      */
     virtual void tagsInit() = 0;
 
+    /** Get the number of blocks of the tag store. */
+    unsigned getNumBlocks() const { return numBlocks; }
+
+    /** Get the number of sets of the indexing policy. */
+    uint32_t getNumSets() const { return indexingPolicy->getNumSets(); }
+
+    /** Get the associativity of the indexing policy. */
+    unsigned getAssoc() const { return indexingPolicy->getAssoc(); }
+
+    /**
+     * Get the type of the indexing policy, as the blocks of a checkpoint
+     * can only be restored with the policy that placed them.
+     */
+    std::string getIndexingPolicyType() const;
+
     /**
      * Average in the reference count for valid blocks when the simulation
      * exits.
@@ -210,6 +232,45 @@ class BaseTags : public ClockedObject
      */
     virtual ReplaceableEntry* findBlockBySetAndWay(int set, int way) const;
 
+    /**
+     * Whether the blocks of this tag store can be restored at the set and
+     * way they were checkpointed at, with their replacement state.
+     */
+    virtual bool canRestoreBlocks() const { return false; }
+
+    /**
+     * Check that a checkpointed block can be restored at its checkpointed
+     * set and way: they must be within the tag store, and the block's
+     * address must map to them.
+     *
+     * @param key The address and security state of the block.
+     * @param set The set of the block.
+     * @param way The way of the block.
+     * @return Whether the block can be restored there.
+     */
+    bool isValidBlockPosition(const CacheBlk::KeyType &key, uint32_t set,
+                              uint32_t way) const;
+
+    /**
+     * Get the replacement state of a valid block, to checkpoint it.
+     *
+     * @param blk The block.
+     * @return The replacement state, 0 if there is none.
+     */
+    virtual uint64_t getReplacementState(const CacheBlk *blk) const
+    {
+        return 0;
+    }
+
+    /**
+     * Restore the replacement state of a block that has just been
+     * inserted, as returned by getReplacementState().
+     *
+     * @param blk The block.
+     * @param state The replacement state.
+     */
+    virtual void setReplacementState(CacheBlk *blk, uint64_t state) {}
+
     /**
      * Align an address to the block size.
      * @param addr the address to align.
@@ -299,6 +360,17 @@ class BaseTags : public ClockedObject
      */
     virtual CacheBlk* accessBlock(const PacketPtr pkt, Cycles &lat) = 0;
 
+    /**
+     * Update the replacement data of a block as a hit would, for an
+     * access made without a packet (see BaseCache::warmAccess). Tag
+     * lookup statistics are not updated.
+     *
+     * @param blk The valid block being accessed.
+     * @return False if the packet is needed to do so, e.g., by the
+     *         replacement policy, in which case nothing is updated.
+     */
+    virtual bool touchBlock(CacheBlk *blk) { return false; }
+
     /**
      * Generate the tag from the given address.
      *
@@ -141,6 +141,11 @@ class BaseSetAssoc : public BaseTags
             stats.dataAccesses += allocAssoc;
         }
 
+        // Let the partitioning policies monitor the access stream
+        if (partitionManager) {
+            partitionManager->notifyAccess(pkt);
+        }
+
         // If a cache hit
         if (blk != nullptr) {
             // Update number of references to accessed block
@@ -156,6 +161,17 @@ class BaseSetAssoc : public BaseTags
         return blk;
     }
 
+    bool
+    touchBlock(CacheBlk *blk) override
+    {
+        if (partitionManager || replacementPolicy->touchNeedsPacket())
+            return false;
+
+        blk->increaseRefCount();
+        replacementPolicy->touch(blk->replacementData);
+        return true;
+    }
+
     /**
      * Find replacement victim based on address. The list of evicted blocks
      * only contains the victim.
@@ -173,8 +189,8 @@ class BaseSetAssoc : public BaseTags
                          const uint64_t partition_id=0) override
     {
         // Get possible entries to be victimized
-        std::vector<ReplaceableEntry*> entries =
-            indexingPolicy->getPossibleEntries(key);
+        std::vector<ReplaceableEntry*> &entries = victimEntries;
+        indexingPolicy->getPossibleEntries(key, entries);
 
         // Filter entries based on PartitionID
         if (partitionManager) {
@@ -216,6 +232,20 @@ class BaseSetAssoc : public BaseTags
 
     void moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk) override;
 
+    bool canRestoreBlocks() const override { return true; }
+
+    uint64_t
+    getReplacementState(const CacheBlk *blk) const override
+    {
+        return replacementPolicy->getState(blk->replacementData);
+    }
+
+    void
+    setReplacementState(CacheBlk *blk, uint64_t state) override
+    {
+        replacementPolicy->setState(blk->replacementData, state);
+    }
+
     /**
      * Limit the allocation for the cache ways.
      * @param ways The maximum number of ways available for replacement.
@@ -121,8 +121,8 @@ CompressedTags::findVictim(const CacheBlk::KeyType& key,
                            const uint64_t partition_id=0)
 {
     // Get all possible locations of this superblock
-    std::vector<ReplaceableEntry*> superblock_entries =
-        indexingPolicy->getPossibleEntries(key);
+    std::vector<ReplaceableEntry*> &superblock_entries = victimEntries;
+    indexingPolicy->getPossibleEntries(key, superblock_entries);
 
     // Filter entries based on PartitionID
     if (partitionManager){
@@ -163,11 +163,7 @@ CompressedTags::findVictim(const CacheBlk::KeyType& key,
             replacementPolicy->getVictim(superblock_entries));
 
         // The whole superblock must be evicted to make room for the new one
-        for (const auto& blk : victim_superblock->blks){
-            if (blk->isValid()) {
-                evict_blks.push_back(blk);
-            }
-        }
+        victim_superblock->getValidBlks(evict_blks);
     }
 
     // Get the location of the victim block within the superblock
@@ -189,6 +185,51 @@ CompressedTags::findVictim(const CacheBlk::KeyType& key,
     return victim;
 }
 
+SectorBlk*
+CompressedTags::findSectorVictim(const CacheBlk::KeyType& key,
+                                 std::vector<CacheBlk*>& evict_blks,
+                                 const uint64_t partition_id)
+{
+    // Get all possible locations of this superblock
+    std::vector<ReplaceableEntry*> &superblock_entries = victimEntries;
+    indexingPolicy->getPossibleEntries(key, superblock_entries);
+
+    // Filter entries based on PartitionID
+    if (partitionManager){
+        partitionManager->filterByPartition(superblock_entries,
+            partition_id);
+    }
+
+    // A present superblock must be the victim, otherwise there would be
+    // two superblocks with the same tag
+    SuperBlk* victim_superblock = nullptr;
+    for (const auto& entry : superblock_entries){
+        SuperBlk* superblock = static_cast<SuperBlk*>(entry);
+        if (superblock->match(key)) {
+            victim_superblock = superblock;
+            break;
+        }
+    }
+
+    if (victim_superblock == nullptr){
+        if (superblock_entries.size() == 0){
+            return nullptr;
+        }
+
+        // Choose replacement victim from replacement candidates
+        victim_superblock = static_cast<SuperBlk*>(
+            replacementPolicy->getVictim(superblock_entries));
+    }
+
+    // The whole superblock is evicted to make room for the new blocks
+    victim_superblock->getValidBlks(evict_blks);
+
+    // Update number of sub-blocks evicted due to a replacement
+    sectorStats.evictionsReplacement[evict_blks.size()]++;
+
+    return victim_superblock;
+}
+
 bool
 CompressedTags::anyBlk(std::function<bool(CacheBlk &)> visitor)
 {
@@ -122,6 +122,22 @@ class CompressedTags : public SectorTags
                          std::vector<CacheBlk*>& evict_blks,
                          const uint64_t partition_id) override;
 
+    /**
+     * Find a superblock to be filled as a whole. Since co-allocation
+     * depends on the compressed size of every new block, a present
+     * superblock is not refilled in place: it becomes the victim itself,
+     * and all of its valid sub-blocks are listed for eviction. The caller
+     * must make sure the blocks it fills satisfy the compression factor.
+     *
+     * @param key The key of any address within the superblock.
+     * @param evict_blks Cache blocks to be evicted.
+     * @param partition_id Partition ID for resource management.
+     * @return The superblock to fill, or nullptr if there is no candidate.
+     */
+    SectorBlk* findSectorVictim(const CacheBlk::KeyType& key,
+                                std::vector<CacheBlk*>& evict_blks,
+                                const uint64_t partition_id) override;
+
     /**
      * Find if any of the sub-blocks satisfies a condition.
      *
@@ -63,7 +63,7 @@ Dueler::isSample(uint64_t id, bool& team) const
 DuelingMonitor::DuelingMonitor(std::size_t constituency_size,
     std::size_t team_size, unsigned num_bits, double low_threshold,
     double high_threshold)
-  : id(1 << numInstances), constituencySize(constituency_size),
+  : id(1ULL << numInstances), constituencySize(constituency_size),
     teamSize(team_size), lowThreshold(low_threshold),
     highThreshold(high_threshold), selector(num_bits), regionCounter(0),
     winner(true)
@@ -166,6 +166,15 @@ FALRU::accessBlock(const PacketPtr pkt, Cycles &lat,
     return blk;
 }
 
+bool
+FALRU::touchBlock(CacheBlk *blk)
+{
+    FALRUBlk *fa_blk = static_cast<FALRUBlk*>(blk);
+    moveToHead(fa_blk);
+    cacheTracking.recordAccess(fa_blk);
+    return true;
+}
+
 CacheBlk*
 FALRU::findBlock(const CacheBlk::KeyType &lookup) const
 {
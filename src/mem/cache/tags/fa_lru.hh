@@ -191,6 +191,8 @@ class FALRU : public BaseTags
      */
     CacheBlk* accessBlock(const PacketPtr pkt, Cycles &lat) override;
 
+    bool touchBlock(CacheBlk *blk) override;
+
     /**
      * Find the block in the cache, do not update the replacement data.
      * @param addr The address to look for.
@@ -0,0 +1,136 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of a set associative tag store with a flat tag array.
+ */
+
+#include "mem/cache/tags/flat_set_assoc.hh"
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "mem/cache/tags/tag_match.hh"
+#include "mem/cache/tags/tagged_entry.hh"
+
+namespace gem5
+{
+
+FlatSetAssoc::FlatSetAssoc(const Params &p)
+    : BaseSetAssoc(p), assoc(p.assoc),
+      setShift(floorLog2(p.entry_size)),
+      setMask(numBlocks / p.assoc - 1),
+      tagShift(setShift + floorLog2(numBlocks / p.assoc)),
+      tags(numBlocks, MaxAddr),
+      validWays(numBlocks / p.assoc, 0),
+      secureWays(numBlocks / p.assoc, 0)
+{
+    fatal_if(assoc > 64, "%s: at most 64 ways are supported, got %d",
+             name(), assoc);
+    fatal_if(p.entry_size != blkSize,
+             "%s: the indexing entry size must match the block size",
+             name());
+    fatal_if(!dynamic_cast<TaggedSetAssociative *>(p.indexing_policy),
+             "%s: requires a TaggedSetAssociative indexing policy", name());
+}
+
+void
+FlatSetAssoc::tagsInit()
+{
+    BaseSetAssoc::tagsInit();
+
+    // The flat arrays are indexed with the block's position in blks, so
+    // the indexing policy must have laid the blocks out by set
+    for (unsigned blk_index = 0; blk_index < numBlocks; blk_index++) {
+        const CacheBlk &blk = blks[blk_index];
+        panic_if(blk.getSet() != blk_index / assoc ||
+                 blk.getWay() != blk_index % assoc,
+                 "%s: unexpected placement of block %d", name(), blk_index);
+    }
+}
+
+void
+FlatSetAssoc::updateEntry(const CacheBlk *blk)
+{
+    const unsigned blk_index = blk - blks.data();
+    const unsigned set = blk_index / assoc;
+    const uint64_t way_bit = 1ULL << (blk_index % assoc);
+
+    tags[blk_index] = blk->getTag();
+    if (blk->isValid()) {
+        validWays[set] |= way_bit;
+    } else {
+        validWays[set] &= ~way_bit;
+    }
+    if (blk->isSecure()) {
+        secureWays[set] |= way_bit;
+    } else {
+        secureWays[set] &= ~way_bit;
+    }
+}
+
+CacheBlk *
+FlatSetAssoc::findBlock(const CacheBlk::KeyType &key) const
+{
+    const unsigned set = (key.address >> setShift) & setMask;
+    const Addr tag = key.address >> tagShift;
+
+    uint64_t ways = matchTags(&tags[set * assoc], assoc, tag) &
+        validWays[set] &
+        (key.secure ? secureWays[set] : ~secureWays[set]);
+
+    if (ways == 0) {
+        return nullptr;
+    }
+
+    CacheBlk *blk = const_cast<CacheBlk *>(&blks[set * assoc + ctz64(ways)]);
+    assert(blk->match(key));
+    return blk;
+}
+
+void
+FlatSetAssoc::insertBlock(const PacketPtr pkt, CacheBlk *blk)
+{
+    BaseSetAssoc::insertBlock(pkt, blk);
+    updateEntry(blk);
+}
+
+void
+FlatSetAssoc::invalidate(CacheBlk *blk)
+{
+    BaseSetAssoc::invalidate(blk);
+    updateEntry(blk);
+}
+
+void
+FlatSetAssoc::moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk)
+{
+    BaseSetAssoc::moveBlock(src_blk, dest_blk);
+    updateEntry(src_blk);
+    updateEntry(dest_blk);
+}
+
+} // namespace gem5
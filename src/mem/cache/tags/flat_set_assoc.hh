@@ -0,0 +1,103 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a set associative tag store with a flat tag array.
+ */
+
+#ifndef __MEM_CACHE_TAGS_FLAT_SET_ASSOC_HH__
+#define __MEM_CACHE_TAGS_FLAT_SET_ASSOC_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/cache/cache_blk.hh"
+#include "mem/cache/tags/base_set_assoc.hh"
+#include "mem/packet.hh"
+#include "params/FlatSetAssoc.hh"
+
+namespace gem5
+{
+
+/**
+ * A set associative tag store that mirrors the tag, valid and secure
+ * state of its blocks in a struct-of-arrays layout. The tags of a set
+ * are contiguous, so a lookup compares the whole set at once (see
+ * matchTags()) and never builds a candidate vector.
+ *
+ * The mirror is updated whenever the tag store changes a block
+ * (insertion, invalidation and moves), which are the only places a
+ * block's tag or valid bit change. Only the TaggedSetAssociative
+ * indexing policy is supported, as the set of an address is computed
+ * locally; associativities of up to 64 ways are supported.
+ */
+class FlatSetAssoc : public BaseSetAssoc
+{
+  protected:
+    /** The full associativity of the cache. */
+    const unsigned assoc;
+
+    /** The amount to shift an address to get its set. */
+    const int setShift;
+
+    /** Mask of the set index bits once shifted. */
+    const Addr setMask;
+
+    /** The amount to shift an address to get its tag. */
+    const int tagShift;
+
+    /** Tags of all blocks, assoc consecutive entries per set. */
+    std::vector<Addr> tags;
+
+    /** Per-set mask of the valid ways. */
+    std::vector<uint64_t> validWays;
+
+    /** Per-set mask of the ways holding secure blocks. */
+    std::vector<uint64_t> secureWays;
+
+    /** Copy the state of a block into the flat arrays. */
+    void updateEntry(const CacheBlk *blk);
+
+  public:
+    PARAMS(FlatSetAssoc);
+
+    FlatSetAssoc(const Params &p);
+
+    void tagsInit() override;
+
+    CacheBlk *findBlock(const CacheBlk::KeyType &key) const override;
+
+    void insertBlock(const PacketPtr pkt, CacheBlk *blk) override;
+
+    void invalidate(CacheBlk *blk) override;
+
+    void moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk) override;
+};
+
+} // namespace gem5
+
+#endif //__MEM_CACHE_TAGS_FLAT_SET_ASSOC_HH__
@@ -170,6 +170,12 @@ class IndexingPolicyTemplate : public SimObject
         return sets[set][way];
     }
 
+    /** Get the number of sets. */
+    uint32_t getNumSets() const { return numSets; }
+
+    /** Get the associativity. */
+    unsigned getAssoc() const { return assoc; }
+
     /**
      * Generate the tag from the given address.
      *
@@ -188,11 +194,30 @@ class IndexingPolicyTemplate : public SimObject
      * Should be called immediately before ReplacementPolicy's findVictim()
      * not to break cache resizing.
      *
-     * @param addr The addr to a find possible entries for.
+     * The entries are written to a container provided by the caller, which
+     * is cleared first. Callers on the access path keep the container
+     * around so that lookups do not allocate once it has grown to the
+     * associativity.
+     *
+     * @param key The key to a find possible entries for.
+     * @param entries The container to fill with the possible entries.
+     */
+    virtual void getPossibleEntries(const KeyType &key,
+        std::vector<ReplaceableEntry*> &entries) const = 0;
+
+    /**
+     * Find all possible entries for insertion and replacement of an address.
+     *
+     * @param key The key to a find possible entries for.
      * @return The possible entries.
      */
-    virtual std::vector<ReplaceableEntry*> getPossibleEntries(const KeyType &key)
-                                                                    const = 0;
+    std::vector<ReplaceableEntry*>
+    getPossibleEntries(const KeyType &key) const
+    {
+        std::vector<ReplaceableEntry*> entries;
+        getPossibleEntries(key, entries);
+        return entries;
+    }
 
     /**
      * Regenerate an entry's address from its tag and assigned indexing bits.
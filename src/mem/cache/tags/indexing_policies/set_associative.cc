@@ -69,10 +69,12 @@ SetAssociative::regenerateAddr(const Addr &tag,
     return (tag << tagShift) | (entry->getSet() << setShift);
 }
 
-std::vector<ReplaceableEntry*>
-SetAssociative::getPossibleEntries(const Addr &addr) const
+void
+SetAssociative::getPossibleEntries(const Addr &addr,
+    std::vector<ReplaceableEntry*> &entries) const
 {
-    return sets[extractSet(addr)];
+    const auto &set = sets[extractSet(addr)];
+    entries.assign(set.begin(), set.end());
 }
 
 } // namespace gem5
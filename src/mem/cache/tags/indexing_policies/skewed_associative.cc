@@ -207,18 +207,17 @@ SkewedAssociative::regenerateAddr(const Addr &tag,
            ((deskew(addr_set, entry->getWay()) & setMask) << setShift);
 }
 
-std::vector<ReplaceableEntry*>
-SkewedAssociative::getPossibleEntries(const Addr &addr) const
+void
+SkewedAssociative::getPossibleEntries(const Addr &addr,
+    std::vector<ReplaceableEntry*> &entries) const
 {
-    std::vector<ReplaceableEntry*> entries;
+    entries.clear();
 
     // Parse all ways
     for (uint32_t way = 0; way < assoc; ++way) {
         // Apply hash to get set, and get way entry in it
         entries.push_back(sets[extractSet(addr, way)][way]);
     }
-
-    return entries;
 }
 
 } // namespace gem5
@@ -158,10 +158,10 @@ class SkewedAssociative : public BaseIndexingPolicy
      * not to break cache resizing.
      *
      * @param addr The addr to a find possible entries for.
-     * @return The possible entries.
+     * @param entries The container to fill with the possible entries.
      */
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr &addr) const
-                                                                   override;
+    void getPossibleEntries(const Addr &addr,
+        std::vector<ReplaceableEntry*> &entries) const override;
 
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
@@ -115,3 +115,27 @@ class MaxCapacityPartitioningPolicy(BasePartitioningPolicy):
         "Format: [<max_capacity>,<max_capacity>,...]"
         "Example: [0.5, 0.75]"
     )
+
+
+class UtilityPartitioningPolicy(BasePartitioningPolicy):
+    type = "UtilityPartitioningPolicy"
+    cxx_header = "mem/cache/tags/partitioning_policies/utility_pp.hh"
+    cxx_class = "gem5::partitioning_policy::UtilityPartitioningPolicy"
+
+    cache_associativity = Param.Unsigned(Parent.assoc, "Associativity")
+    cache_size = Param.MemorySize(Parent.size, "Cache size in bytes")
+    blk_size = Param.Int(Parent.cache_line_size, "Cache block size in bytes")
+
+    partition_ids = VectorParam.UInt64(
+        "PartitionIDs that share the cache ways"
+        "Format: [<partition_id>,<partition_id>, ...]"
+        "Example: [0, 1]"
+    )
+
+    sampled_sets = Param.Unsigned(
+        32, "Number of sets monitored by each partition's shadow tags"
+    )
+    min_ways = Param.Unsigned(1, "Minimum number of ways of a partition")
+    repartition_period = Param.Latency(
+        "5ms", "Time between two recomputations of the way allocation"
+    )
@@ -40,6 +40,7 @@
 
 #include <vector>
 
+#include "base/types.hh"
 #include "params/BasePartitioningPolicy.hh"
 #include "sim/sim_object.hh"
 
@@ -92,6 +93,15 @@ class BasePartitioningPolicy : public SimObject
     */
     virtual void
     notifyRelease(const uint64_t partition_id) = 0;
+
+    /**
+    * Notify of a lookup in the cache, hit or miss. Policies that monitor
+    * the utility of the cache for each partition use it; others ignore it.
+    * @param addr Address of the accessed block
+    * @param partition_id PartitionID of the upstream memory request
+    */
+    virtual void
+    notifyAccess(const Addr addr, const uint64_t partition_id) {}
 };
 
 } // namespace partitioning_policy
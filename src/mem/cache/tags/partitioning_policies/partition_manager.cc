@@ -69,6 +69,15 @@ PartitionManager::notifyRelease(uint64_t partition_id)
     }
 }
 
+void
+PartitionManager::notifyAccess(PacketPtr pkt)
+{
+    const uint64_t partition_id = readPacketPartitionID(pkt);
+    for (auto partitioning_policy : partitioningPolicies) {
+        partitioning_policy->notifyAccess(pkt->getAddr(), partition_id);
+    }
+}
+
 void
 PartitionManager::filterByPartition(
     std::vector<ReplaceableEntry *> &entries,
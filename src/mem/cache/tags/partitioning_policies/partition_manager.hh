@@ -79,6 +79,12 @@ class PartitionManager : public SimObject
 
     void notifyRelease(uint64_t partition_id);
 
+    /**
+    * Notify of a lookup in the cache
+    * @param pkt The packet that accessed the cache
+    */
+    void notifyAccess(PacketPtr pkt);
+
     void filterByPartition(std::vector<ReplaceableEntry *> &entries,
         const uint64_t partition_id) const;
 
@@ -0,0 +1,266 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/tags/partitioning_policies/utility_pp.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/PartitionPolicy.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace partitioning_policy
+{
+
+UtilityPartitioningPolicy::UtilityPartitioningPolicy(
+    const UtilityPartitioningPolicyParams &params)
+  : BasePartitioningPolicy(params), assoc(params.cache_associativity),
+    blkShift(floorLog2(params.blk_size)),
+    numSets(params.cache_size / (params.blk_size * assoc)),
+    sampleStride(std::max(1u, numSets / std::max(1u,
+        params.sampled_sets))),
+    minWays(params.min_ways), period(params.repartition_period),
+    partitionIDs(params.partition_ids),
+    repartitionEvent([this]{ repartition(); }, name()),
+    stats(*this)
+{
+    fatal_if(assoc == 0 || assoc > 64, "Utility Partitioning Policy "
+        "supports associativities from 1 to 64, not %d", assoc);
+    fatal_if(!isPowerOf2(params.blk_size) || !isPowerOf2(numSets),
+        "Utility Partitioning Policy requires a power of 2 number of sets "
+        "and block size");
+    fatal_if(partitionIDs.empty(),
+        "Utility Partitioning Policy requires at least one PartitionID");
+    fatal_if(minWays == 0 || partitionIDs.size() * minWays > assoc,
+        "Utility Partitioning Policy cannot give %d ways to each of %d "
+        "partitions in a %d-way cache", minWays, partitionIDs.size(),
+        assoc);
+    fatal_if(period == 0,
+        "Utility Partitioning Policy requires a non-zero period");
+
+    const unsigned num_sampled = numSets / sampleStride;
+    monitors.resize(partitionIDs.size());
+    for (unsigned i = 0; i < partitionIDs.size(); i++) {
+        fatal_if(partitionIndex.count(partitionIDs[i]),
+            "Duplicate PartitionID %d in Utility Partitioning Policy",
+            partitionIDs[i]);
+        partitionIndex[partitionIDs[i]] = i;
+        monitors[i].shadowTags.assign(num_sampled * assoc, MaxAddr);
+        monitors[i].hits.assign(assoc, 0);
+    }
+
+    // Start with an even split of the ways
+    std::vector<unsigned> ways(partitionIDs.size(),
+        assoc / partitionIDs.size());
+    for (unsigned i = 0; i < assoc % partitionIDs.size(); i++) {
+        ways[i]++;
+    }
+    applyAllocation(ways);
+}
+
+void
+UtilityPartitioningPolicy::startup()
+{
+    for (unsigned p = 0; p < wayMasks.size(); p++) {
+        stats.allocatedWays[p] = popCount(wayMasks[p]);
+    }
+    schedule(repartitionEvent, curTick() + period);
+}
+
+void
+UtilityPartitioningPolicy::filterByPartition(
+    std::vector<ReplaceableEntry *> &entries,
+    const uint64_t partition_id) const
+{
+    const auto it = partitionIndex.find(partition_id);
+    if (entries.empty() || it == partitionIndex.end()) {
+        // This partition_id is not policed
+        return;
+    }
+
+    const uint64_t way_mask = wayMasks[it->second];
+    const auto entries_to_remove = std::remove_if(
+        entries.begin(), entries.end(),
+        [way_mask] (ReplaceableEntry *entry)
+        {
+            return !((way_mask >> entry->getWay()) & 1);
+        });
+    entries.erase(entries_to_remove, entries.end());
+}
+
+void
+UtilityPartitioningPolicy::notifyAccess(const Addr addr,
+                                        const uint64_t partition_id)
+{
+    const auto it = partitionIndex.find(partition_id);
+    if (it == partitionIndex.end()) {
+        return;
+    }
+
+    // Only a few sets are monitored
+    const Addr blk_addr = addr >> blkShift;
+    const unsigned set = blk_addr & (numSets - 1);
+    if (set % sampleStride) {
+        return;
+    }
+
+    UtilityMonitor &monitor = monitors[it->second];
+    const auto first = monitor.shadowTags.begin() +
+        (set / sampleStride) * assoc;
+    const auto last = first + assoc;
+    auto pos = std::find(first, last, blk_addr);
+
+    // A hit at stack position p would miss with p ways or less; a miss
+    // misses with any number of ways
+    const unsigned depth = (pos == last) ? assoc : (pos - first);
+    if (pos == last) {
+        pos = last - 1;
+    } else {
+        monitor.hits[depth]++;
+    }
+    for (unsigned w = 0; w <= depth; w++) {
+        stats.missCurve[it->second][w]++;
+    }
+    stats.sampledAccesses[it->second]++;
+
+    // Move the block to the MRU position
+    std::rotate(first, pos, pos + 1);
+    *first = blk_addr;
+}
+
+std::vector<unsigned>
+UtilityPartitioningPolicy::lookahead() const
+{
+    std::vector<unsigned> ways(monitors.size(), minWays);
+    unsigned balance = assoc - monitors.size() * minWays;
+
+    while (balance > 0) {
+        double best_utility = -1;
+        unsigned winner = 0;
+        unsigned winner_ways = 1;
+        for (unsigned p = 0; p < monitors.size(); p++) {
+            // Find the number of extra ways that maximizes the hits gained
+            // per way for this partition
+            const std::vector<uint64_t> &hits = monitors[p].hits;
+            uint64_t gained = 0;
+            for (unsigned k = 1; k <= balance; k++) {
+                gained += hits[ways[p] + k - 1];
+                const double utility = double(gained) / k;
+                if (utility > best_utility) {
+                    best_utility = utility;
+                    winner = p;
+                    winner_ways = k;
+                }
+            }
+        }
+        ways[winner] += winner_ways;
+        balance -= winner_ways;
+    }
+
+    return ways;
+}
+
+void
+UtilityPartitioningPolicy::applyAllocation(const std::vector<unsigned> &ways)
+{
+    wayMasks.assign(ways.size(), 0);
+    unsigned first_way = 0;
+    for (unsigned p = 0; p < ways.size(); p++) {
+        wayMasks[p] = mask(ways[p]) << first_way;
+        first_way += ways[p];
+        DPRINTF(PartitionPolicy, "Allocated ways [%d, %d) in "
+            "UtilityPartitioningPolicy to PartitionID: %d\n",
+            first_way - ways[p], first_way, partitionIDs[p]);
+    }
+    assert(first_way == assoc);
+}
+
+void
+UtilityPartitioningPolicy::repartition()
+{
+    const std::vector<unsigned> ways = lookahead();
+    applyAllocation(ways);
+
+    stats.repartitions++;
+    for (unsigned p = 0; p < monitors.size(); p++) {
+        stats.allocatedWays[p] = ways[p];
+
+        // Halve the counters so that older periods weigh less
+        for (auto &hits : monitors[p].hits) {
+            hits /= 2;
+        }
+    }
+
+    schedule(repartitionEvent, curTick() + period);
+}
+
+UtilityPartitioningPolicy::UtilityStats::UtilityStats(
+    UtilityPartitioningPolicy &_policy)
+  : statistics::Group(&_policy), policy(_policy),
+    ADD_STAT(repartitions, statistics::units::Count::get(),
+             "Number of times the ways were repartitioned"),
+    ADD_STAT(allocatedWays, statistics::units::Count::get(),
+             "Number of ways allocated to each partition"),
+    ADD_STAT(sampledAccesses, statistics::units::Count::get(),
+             "Number of accesses to the monitored sets per partition"),
+    ADD_STAT(missCurve, statistics::units::Count::get(),
+             "Misses in the monitored sets each partition would have had "
+             "with a given number of ways")
+{
+}
+
+void
+UtilityPartitioningPolicy::UtilityStats::regStats()
+{
+    statistics::Group::regStats();
+
+    const unsigned num_partitions = policy.partitionIDs.size();
+    allocatedWays.init(num_partitions);
+    sampledAccesses.init(num_partitions);
+    missCurve.init(num_partitions, policy.assoc + 1);
+    for (unsigned p = 0; p < num_partitions; p++) {
+        const std::string name =
+            "partition" + std::to_string(policy.partitionIDs[p]);
+        allocatedWays.subname(p, name);
+        sampledAccesses.subname(p, name);
+        missCurve.subname(p, name);
+    }
+    for (unsigned w = 0; w <= policy.assoc; w++) {
+        missCurve.ysubname(w, std::to_string(w));
+    }
+}
+
+} // namespace partitioning_policy
+
+} // namespace gem5
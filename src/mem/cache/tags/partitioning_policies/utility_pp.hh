@@ -0,0 +1,193 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_TAGS_PARTITIONING_POLICIES_UTILITY_HH__
+#define __MEM_CACHE_TAGS_PARTITIONING_POLICIES_UTILITY_HH__
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/tags/partitioning_policies/base_pp.hh"
+#include "params/UtilityPartitioningPolicy.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace partitioning_policy
+{
+
+/**
+ * A UtilityPartitioningPolicy (Qureshi and Patt, 2006) splits the ways of
+ * the cache among its PartitionIDs, and periodically repartitions them based
+ * on how much each partition benefits from every extra way.
+ *
+ * The utility of each partition is measured by a utility monitor (UMON):
+ * a set of LRU-managed shadow tags for a few sampled sets, as if the
+ * partition had the whole cache to itself. Every hit at LRU stack position
+ * p means the access would have hit had the partition been given more than
+ * p ways. At the end of each period the lookahead algorithm uses these
+ * counters to choose the new allocation, and the counters are halved so
+ * that the monitors follow phase changes.
+ *
+ * Like WayPartitioningPolicy, victims are restricted to the ways of the
+ * request's partition, and requests with unregistered PartitionIDs are not
+ * affected.
+ *
+ * @see BasePartitioningPolicy
+ */
+class UtilityPartitioningPolicy : public BasePartitioningPolicy
+{
+  public:
+    UtilityPartitioningPolicy(const UtilityPartitioningPolicyParams &params);
+
+    void startup() override;
+
+    void
+    filterByPartition(std::vector<ReplaceableEntry *> &entries,
+                      const uint64_t partition_id) const override;
+
+    /**
+    * Empty implementation as allocations only depend on the utility of
+    * the partitions
+    * @param partition_id PartitionID of the upstream memory request
+    */
+    void notifyAcquire(const uint64_t partition_id) override {};
+
+    /**
+    * Empty implementation as allocations only depend on the utility of
+    * the partitions
+    * @param partition_id PartitionID of the upstream memory request
+    */
+    void notifyRelease(const uint64_t partition_id) override {};
+
+    /**
+    * Update the utility monitor of the partition if the access maps to a
+    * sampled set
+    * @param addr Address of the accessed block
+    * @param partition_id PartitionID of the upstream memory request
+    */
+    void notifyAccess(const Addr addr, const uint64_t partition_id) override;
+
+    /**
+    * Compute a new way allocation from the utility monitors and apply it.
+    */
+    void repartition();
+
+  private:
+    /** Shadow tags and hit counters of a single partition. */
+    struct UtilityMonitor
+    {
+        /**
+        * Block addresses of the sampled sets, each set ordered from MRU
+        * to LRU. Empty entries hold MaxAddr.
+        */
+        std::vector<Addr> shadowTags;
+
+        /**
+        * Hits at each LRU stack position, halved at every repartition so
+        * that older periods weigh less.
+        */
+        std::vector<uint64_t> hits;
+    };
+
+    /**
+    * Lookahead allocation: repeatedly hand the remaining ways to the
+    * partition with the highest marginal utility per way.
+    * @return The number of ways of each partition.
+    */
+    std::vector<unsigned> lookahead() const;
+
+    /**
+    * Restrict every partition to a contiguous range of ways.
+    * @param ways The number of ways of each partition.
+    */
+    void applyAllocation(const std::vector<unsigned> &ways);
+
+    /** Associativity of the cache. */
+    const unsigned assoc;
+
+    /** log2 of the cache block size. */
+    const unsigned blkShift;
+
+    /** Number of sets of the cache. */
+    const unsigned numSets;
+
+    /** Distance between two sampled sets. */
+    const unsigned sampleStride;
+
+    /** Minimum number of ways a partition is given. */
+    const unsigned minWays;
+
+    /** Time between two repartitions. */
+    const Tick period;
+
+    /** Map of policied PartitionIDs and their monitor index. */
+    std::unordered_map<uint64_t, unsigned> partitionIndex;
+
+    /** PartitionIDs the policy operates on, by monitor index. */
+    const std::vector<uint64_t> partitionIDs;
+
+    /** Utility monitors, by partition index. */
+    std::vector<UtilityMonitor> monitors;
+
+    /** Mask of the ways each partition may allocate in. */
+    std::vector<uint64_t> wayMasks;
+
+    EventFunctionWrapper repartitionEvent;
+
+    struct UtilityStats : public statistics::Group
+    {
+        UtilityStats(UtilityPartitioningPolicy &policy);
+
+        void regStats() override;
+
+        const UtilityPartitioningPolicy &policy;
+
+        /** Number of repartitions. */
+        statistics::Scalar repartitions;
+
+        /** Number of ways currently allocated to each partition. */
+        statistics::Vector allocatedWays;
+
+        /** Number of accesses to the sampled sets per partition. */
+        statistics::Vector sampledAccesses;
+
+        /**
+        * Misses in the sampled sets each partition would have had with
+        * every possible number of ways, accumulated over all periods.
+        */
+        statistics::Vector2d missCurve;
+    } stats;
+};
+
+} // namespace partitioning_policy
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_PARTITIONING_POLICIES_UTILITY_HH__
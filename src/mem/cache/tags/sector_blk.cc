@@ -79,7 +79,7 @@ void
 SectorSubBlk::setValid()
 {
     CacheBlk::setValid();
-    _sectorBlk->validateSubBlk();
+    _sectorBlk->validateSubBlk(_sectorOffset);
 }
 
 void
@@ -101,7 +101,7 @@ void
 SectorSubBlk::invalidate()
 {
     CacheBlk::invalidate();
-    _sectorBlk->invalidateSubBlk();
+    _sectorBlk->invalidateSubBlk(_sectorOffset);
 }
 
 std::string
@@ -112,7 +112,7 @@ SectorSubBlk::print() const
 }
 
 SectorBlk::SectorBlk()
-    : TaggedEntry(), _validCounter(0)
+    : TaggedEntry(), _validMask(0)
 {
 }
 
@@ -120,27 +120,31 @@ bool
 SectorBlk::isValid() const
 {
     // If any of the blocks in the sector is valid, so is the sector
-    return _validCounter > 0;
+    return _validMask != 0;
 }
 
 uint8_t
 SectorBlk::getNumValid() const
 {
-    return _validCounter;
+    return popCount(_validMask);
 }
 
 void
-SectorBlk::validateSubBlk()
+SectorBlk::validateSubBlk(const int sector_offset)
 {
-    _validCounter++;
+    assert(sector_offset < MaxSubBlks);
+    _validMask |= (1ULL << sector_offset);
 }
 
 void
-SectorBlk::invalidateSubBlk()
+SectorBlk::invalidateSubBlk(const int sector_offset)
 {
+    assert(_validMask & (1ULL << sector_offset));
+    _validMask &= ~(1ULL << sector_offset);
+
     // If all sub-blocks have been invalidated, the sector becomes invalid,
     // so clear secure bit
-    if (--_validCounter == 0) {
+    if (_validMask == 0) {
         invalidate();
     }
 }
@@ -158,10 +162,8 @@ std::string
 SectorBlk::print() const
 {
     std::string sub_blk_print;
-    for (const auto& sub_blk : blks) {
-        if (sub_blk->isValid()) {
-            sub_blk_print += "\t[" + sub_blk->print() + "]\n";
-        }
+    for (uint64_t mask = _validMask; mask; mask &= mask - 1) {
+        sub_blk_print += "\t[" + blks[findLsbSet(mask)]->print() + "]\n";
     }
     return csprintf("%s valid sub-blks (%d):\n%s",
         TaggedEntry::print(), getNumValid(), sub_blk_print);
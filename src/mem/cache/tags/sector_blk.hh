@@ -34,8 +34,10 @@
 #ifndef __MEM_CACHE_TAGS_SECTOR_BLK_HH__
 #define __MEM_CACHE_TAGS_SECTOR_BLK_HH__
 
+#include <cstdint>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "mem/cache/cache_blk.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 
@@ -136,12 +138,16 @@ class SectorBlk : public TaggedEntry
 {
   private:
     /**
-     * Counter of the number of valid sub-blocks. The sector is valid if any
-     * of its sub-blocks is valid.
+     * Mask of the valid sub-blocks, indexed by sector offset. The sector is
+     * valid if any of its sub-blocks is valid. Scanning this mask avoids
+     * walking the virtual sub-block entries.
      */
-    uint8_t _validCounter;
+    uint64_t _validMask;
 
   public:
+    /** Maximum number of sub-blocks a sector can track. */
+    static constexpr unsigned MaxSubBlks = 64;
+
     SectorBlk();
     SectorBlk(const SectorBlk&) = delete;
     SectorBlk& operator=(const SectorBlk&) = delete;
@@ -165,14 +171,42 @@ class SectorBlk : public TaggedEntry
     uint8_t getNumValid() const;
 
     /**
-     * Increase the number of valid sub-blocks.
+     * Get the mask of valid sub-blocks. Bit i is set if the sub-block at
+     * sector offset i is valid.
+     *
+     * @return The valid sub-blocks mask.
+     */
+    uint64_t getValidMask() const { return _validMask; }
+
+    /**
+     * Mark a sub-block as valid.
+     *
+     * @param sector_offset The offset of the sub-block in the sector.
      */
-    void validateSubBlk();
+    void validateSubBlk(const int sector_offset);
 
     /**
-     * Decrease the number of valid sub-blocks.
+     * Mark a sub-block as invalid. The sector is invalidated when its last
+     * valid sub-block is.
+     *
+     * @param sector_offset The offset of the sub-block in the sector.
      */
-    void invalidateSubBlk();
+    void invalidateSubBlk(const int sector_offset);
+
+    /**
+     * Append the valid sub-blocks of this sector to a list, in sector
+     * offset order.
+     *
+     * @param blk_list The list to fill.
+     */
+    template <typename BlkList>
+    void
+    getValidBlks(BlkList& blk_list) const
+    {
+        for (uint64_t mask = _validMask; mask; mask &= mask - 1) {
+            blk_list.push_back(blks[findLsbSet(mask)]);
+        }
+    }
 
     /**
      * Sets the position of the sub-entries, besides its own.
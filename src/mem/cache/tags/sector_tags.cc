@@ -48,6 +48,7 @@
 #include <memory>
 #include <string>
 
+#include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/types.hh"
@@ -56,6 +57,8 @@
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/cache/tags/indexing_policies/base.hh"
 #include "mem/cache/tags/partitioning_policies/partition_manager.hh"
+#include "sim/cur_tick.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
@@ -77,6 +80,9 @@ SectorTags::SectorTags(const SectorTagsParams &p)
              "Block size must be at least 4 and a power of 2");
     fatal_if(!isPowerOf2(numBlocksPerSector),
              "# of blocks per sector must be non-zero and a power of 2");
+    fatal_if(numBlocksPerSector > SectorBlk::MaxSubBlks,
+             "# of blocks per sector must be at most %d",
+             SectorBlk::MaxSubBlks);
     warn_if(partitionManager,
              "Using cache partitioning policies with sector and/or compressed "
              "tags is not fully tested.");
@@ -190,6 +196,20 @@ SectorTags::accessBlock(const PacketPtr pkt, Cycles &lat)
     return blk;
 }
 
+bool
+SectorTags::touchBlock(CacheBlk *blk)
+{
+    if (replacementPolicy->touchNeedsPacket())
+        return false;
+
+    blk->increaseRefCount();
+
+    const SectorBlk* sector_blk =
+        static_cast<SectorSubBlk*>(blk)->getSectorBlock();
+    replacementPolicy->touch(sector_blk->replacementData);
+    return true;
+}
+
 void
 SectorTags::insertBlock(const PacketPtr pkt, CacheBlk *blk)
 {
@@ -269,11 +289,10 @@ SectorTags::findBlock(const CacheBlk::KeyType &key) const
     const Addr offset = extractSectorOffset(key.address);
 
     // Find all possible sector entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
-        indexingPolicy->getPossibleEntries(key);
+    indexingPolicy->getPossibleEntries(key, lookupEntries);
 
     // Search for block
-    for (const auto& sector : entries) {
+    for (const auto& sector : lookupEntries) {
         auto blk = static_cast<SectorBlk*>(sector)->blks[offset];
         if (blk->match(key)) {
             return blk;
@@ -289,10 +308,32 @@ SectorTags::findVictim(const CacheBlk::KeyType &key,
                        const std::size_t size,
                        std::vector<CacheBlk*>& evict_blks,
                        const uint64_t partition_id)
+{
+    SectorBlk* victim_sector =
+        SectorTags::findSectorVictim(key, evict_blks, partition_id);
+    if (victim_sector == nullptr) {
+        return nullptr;
+    }
+
+    // Get the entry of the victim block within the sector
+    SectorSubBlk* victim = victim_sector->blks[
+        extractSectorOffset(key.address)];
+
+    // It would be a hit if victim was valid in a present sector, and
+    // upgrades do not call findVictim, so it cannot happen
+    assert(!victim_sector->match(key) || !victim->isValid());
+
+    return victim;
+}
+
+SectorBlk*
+SectorTags::findSectorVictim(const CacheBlk::KeyType &key,
+                             std::vector<CacheBlk*>& evict_blks,
+                             const uint64_t partition_id)
 {
     // Get possible entries to be victimized
-    std::vector<ReplaceableEntry*> sector_entries =
-        indexingPolicy->getPossibleEntries(key);
+    std::vector<ReplaceableEntry*> &sector_entries = victimEntries;
+    indexingPolicy->getPossibleEntries(key, sector_entries);
 
     // Filter entries based on PartitionID
     if (partitionManager)
@@ -319,31 +360,63 @@ SectorTags::findVictim(const CacheBlk::KeyType &key,
         // Choose replacement victim from replacement candidates
         victim_sector = static_cast<SectorBlk*>(replacementPolicy->getVictim(
                                                 sector_entries));
+
+        // The whole sector must be evicted to make room for the new sector.
+        // Blocks are only evicted if the sectors mismatch and the currently
+        // existing sector is valid.
+        victim_sector->getValidBlks(evict_blks);
     }
 
-    // Get the entry of the victim block within the sector
-    SectorSubBlk* victim = victim_sector->blks[
-        extractSectorOffset(key.address)];
+    // Update number of sub-blocks evicted due to a replacement
+    sectorStats.evictionsReplacement[evict_blks.size()]++;
+
+    return victim_sector;
+}
+
+void
+SectorTags::insertSector(const PacketPtr pkt, SectorBlk* sector_blk,
+                         const uint64_t fill_mask)
+{
+    assert((fill_mask & sector_blk->getValidMask()) == 0);
+    assert((fill_mask >> numBlocksPerSector) == 0);
+    if (fill_mask == 0) {
+        return;
+    }
 
-    // Get evicted blocks. Blocks are only evicted if the sectors mismatch and
-    // the currently existing sector is valid.
-    if (victim_sector->match(key)) {
-        // It would be a hit if victim was valid, and upgrades do not call
-        // findVictim, so it cannot happen
-        assert(!victim->isValid());
+    // The replacement data is shared by the whole sector, so it is only
+    // updated once, as if a single sub-block had been inserted
+    if (sector_blk->isValid()) {
+        replacementPolicy->touch(sector_blk->replacementData, pkt);
     } else {
-        // The whole sector must be evicted to make room for the new sector
-        for (const auto& blk : victim_sector->blks){
-            if (blk->isValid()) {
-                evict_blks.push_back(blk);
-            }
-        }
+        stats.tagsInUse++;
+        assert(stats.tagsInUse.value() <= numSectors);
+        replacementPolicy->reset(sector_blk->replacementData, pkt);
     }
 
-    // Update number of sub-blocks evicted due to a replacement
-    sectorStats.evictionsReplacement[evict_blks.size()]++;
+    const RequestorID requestor_id = pkt->req->requestorId();
+    assert(requestor_id < system->maxRequestors());
+    const auto partition_id = partitionManager ?
+        partitionManager->readPacketPartitionID(pkt) : 0;
+    const unsigned num_filled = popCount(fill_mask);
+    stats.occupancies[requestor_id] += num_filled;
+
+    // All sub-blocks share the sector's tag, so any address in the sector
+    // can be used to insert them
+    for (uint64_t mask = fill_mask; mask; mask &= mask - 1) {
+        CacheBlk* blk = sector_blk->blks[findLsbSet(mask)];
+        blk->insert({pkt->getAddr(), pkt->isSecure()}, requestor_id,
+                    pkt->req->taskId(), partition_id);
+    }
 
-    return victim;
+    // Check if cache warm up is done
+    if (!warmedUp && stats.tagsInUse.value() >= warmupBound) {
+        warmedUp = true;
+        stats.warmupTick = curTick();
+    }
+
+    // A single tag is written, along with the data of every sub-block
+    stats.tagAccesses += 1;
+    stats.dataAccesses += num_filled;
 }
 
 int
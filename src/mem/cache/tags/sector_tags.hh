@@ -155,6 +155,8 @@ class SectorTags : public BaseTags
      */
     CacheBlk* accessBlock(const PacketPtr pkt, Cycles &lat) override;
 
+    bool touchBlock(CacheBlk *blk) override;
+
     /**
      * Insert the new block into the cache and update replacement data.
      *
@@ -190,6 +192,35 @@ class SectorTags : public BaseTags
                          std::vector<CacheBlk*>& evict_blks,
                          const uint64_t partition_id) override;
 
+    /**
+     * Find a sector to be filled as a whole. If the sector the address
+     * belongs to is present it is returned, and nothing is evicted.
+     * Otherwise a replacement victim is chosen, and all of its valid
+     * sub-blocks are listed for eviction.
+     *
+     * @param key The key of any address within the sector.
+     * @param evict_blks Cache blocks to be evicted.
+     * @param partition_id Partition ID for resource management.
+     * @return The sector to fill, or nullptr if there is no candidate.
+     */
+    virtual SectorBlk* findSectorVictim(const CacheBlk::KeyType &key,
+                                        std::vector<CacheBlk*>& evict_blks,
+                                        const uint64_t partition_id);
+
+    /**
+     * Insert several sub-blocks of a sector at once. The replacement data,
+     * which is shared by the whole sector, and the tag statistics are only
+     * updated once. The evicted sub-blocks must have been invalidated
+     * before.
+     *
+     * @param pkt Packet holding any address within the sector.
+     * @param sector_blk The sector, as returned by findSectorVictim().
+     * @param fill_mask Mask of the sector offsets to fill. None of them
+     *        may be valid.
+     */
+    void insertSector(const PacketPtr pkt, SectorBlk* sector_blk,
+                      const uint64_t fill_mask);
+
     /**
      * Calculate a block's offset in a sector from the address.
      *
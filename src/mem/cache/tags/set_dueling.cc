@@ -0,0 +1,98 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/tags/set_dueling.hh"
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+SetDueling::SetDueling(const Params &p)
+  : SimObject(p), setShift(floorLog2(p.blk_size)),
+    setMask(p.size / (p.blk_size * p.assoc) - 1),
+    duelers(p.size / (p.blk_size * p.assoc)),
+    duelingMonitor(p.constituency_size, p.team_size, p.num_bits,
+                   p.low_threshold, p.high_threshold),
+    stats(this)
+{
+    fatal_if(!isPowerOf2(p.blk_size) || !isPowerOf2(duelers.size()),
+        "Set dueling requires a power of 2 block size and number of sets");
+    fatal_if(duelers.size() < p.constituency_size,
+        "Set dueling requires at least one full constituency");
+
+    for (auto &dueler : duelers) {
+        duelingMonitor.initEntry(&dueler);
+    }
+}
+
+bool
+SetDueling::selectB(Addr addr)
+{
+    // The team with the most misses loses. Team A is "false", and team B
+    // is "true"
+    bool team;
+    if (!duelingMonitor.isSample(&duelers[getSet(addr)], team)) {
+        team = !duelingMonitor.getWinner();
+    }
+
+    if (team) {
+        stats.selectedB++;
+    } else {
+        stats.selectedA++;
+    }
+    return team;
+}
+
+void
+SetDueling::sampleMiss(Addr addr)
+{
+    const Dueler *dueler = &duelers[getSet(addr)];
+    bool team;
+    if (duelingMonitor.isSample(dueler, team)) {
+        if (team) {
+            stats.sampledMissesB++;
+        } else {
+            stats.sampledMissesA++;
+        }
+        duelingMonitor.sample(dueler);
+    }
+}
+
+SetDueling::SetDuelingStats::SetDuelingStats(statistics::Group *parent)
+  : statistics::Group(parent),
+    ADD_STAT(selectedA, statistics::units::Count::get(),
+             "Number of times option A was selected"),
+    ADD_STAT(selectedB, statistics::units::Count::get(),
+             "Number of times option B was selected"),
+    ADD_STAT(sampledMissesA, statistics::units::Count::get(),
+             "Number of misses in the sets sampling option A"),
+    ADD_STAT(sampledMissesB, statistics::units::Count::get(),
+             "Number of misses in the sets sampling option B")
+{
+}
+
+} // namespace gem5
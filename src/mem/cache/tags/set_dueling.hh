@@ -0,0 +1,107 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_TAGS_SET_DUELING_HH__
+#define __MEM_CACHE_TAGS_SET_DUELING_HH__
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/tags/dueling.hh"
+#include "params/SetDueling.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * Set dueling between two arbitrary options of a cache, such as two
+ * prefetchers or whether to compress. Each set of the cache is a Dueler:
+ * a few sampled sets always use option A, a few always use option B, and
+ * the misses in those sets decide which option the remaining (follower)
+ * sets use.
+ *
+ * Unlike the dueling replacement policy, the duel is driven by addresses
+ * rather than by entries, so any component of the cache that knows the
+ * address of an access can take part in it.
+ *
+ * @see DuelingMonitor
+ */
+class SetDueling : public SimObject
+{
+  public:
+    PARAMS(SetDueling);
+    SetDueling(const Params &p);
+
+    /**
+     * Select the option to use for an address. Sampled sets always use
+     * their team's option; followers use the option that misses the least.
+     *
+     * @param addr The address being accessed.
+     * @return True if option B must be used, false for option A.
+     */
+    bool selectB(Addr addr);
+
+    /**
+     * Account for a miss. Only misses in sampled sets affect the duel.
+     *
+     * @param addr The address that missed.
+     */
+    void sampleMiss(Addr addr);
+
+  private:
+    /** Get the set an address maps to. */
+    unsigned getSet(Addr addr) const { return (addr >> setShift) & setMask; }
+
+    /** The amount to shift an address to get its set. */
+    const unsigned setShift;
+
+    /** Mask out all bits that aren't part of the set index. */
+    const unsigned setMask;
+
+    /** One dueler per set. */
+    std::vector<Dueler> duelers;
+
+    /** The duel between option A (team false) and B (team true). */
+    DuelingMonitor duelingMonitor;
+
+    struct SetDuelingStats : public statistics::Group
+    {
+        SetDuelingStats(statistics::Group *parent);
+
+        /** Number of times each option was selected. */
+        statistics::Scalar selectedA;
+        statistics::Scalar selectedB;
+
+        /** Number of misses in the sampled sets of each option. */
+        statistics::Scalar sampledMissesA;
+        statistics::Scalar sampledMissesB;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_SET_DUELING_HH__
@@ -183,9 +183,10 @@ SuperBlk::invalidate()
 bool
 SuperBlk::isCompressed(const CompressionBlk* ignored_blk) const
 {
-    for (const auto& blk : blks) {
-        if (blk->isValid() && (blk != ignored_blk)) {
-            return static_cast<CompressionBlk*>(blk)->isCompressed();
+    for (uint64_t mask = getValidMask(); mask; mask &= mask - 1) {
+        const auto blk = static_cast<CompressionBlk*>(blks[findLsbSet(mask)]);
+        if (blk != ignored_blk) {
+            return blk->isCompressed();
         }
     }
 
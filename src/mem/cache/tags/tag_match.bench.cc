@@ -0,0 +1,92 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+
+#include "base/microbench.hh"
+#include "mem/cache/tags/tag_match.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Lookup of a set without matchTags(), one way at a time. */
+uint64_t
+wayByWay(const Addr *tags, unsigned assoc, Addr tag)
+{
+    for (unsigned i = 0; i < assoc; ++i) {
+        if (tags[i] == tag)
+            return 1ULL << i;
+    }
+    return 0;
+}
+
+constexpr unsigned NumSets = 1024;
+
+/** A tag array with a distinct tag in every way. */
+std::vector<Addr>
+makeTags(unsigned assoc)
+{
+    std::vector<Addr> tags(NumSets * assoc);
+    for (size_t i = 0; i < tags.size(); ++i)
+        tags[i] = i * 0x9e3779b97f4a7c15ULL >> 20;
+    return tags;
+}
+
+template <uint64_t (*Match)(const Addr *, unsigned, Addr)>
+void
+setLookup(microbench::State &state)
+{
+    const unsigned assoc = state.range();
+    const std::vector<Addr> tags = makeTags(assoc);
+
+    // Alternate hits in a pseudo-random way and misses
+    uint64_t lfsr = 0xace1;
+    for (auto _ : state) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xd0000001u);
+        const Addr *set = &tags[(lfsr % NumSets) * assoc];
+        const Addr tag = (lfsr & 1) ? set[(lfsr >> 1) % assoc] : MaxAddr;
+        microbench::doNotOptimize(Match(set, assoc, tag));
+    }
+}
+
+} // anonymous namespace
+
+/** The tag lookup of FlatSetAssoc::accessBlock(). */
+static void
+tagLookupMatchTags(microbench::State &state)
+{
+    setLookup<matchTags>(state);
+}
+GEM5_BENCHMARK(tagLookupMatchTags)->arg(4)->arg(8)->arg(16)->arg(32);
+
+/** The same lookup done way by way, as BaseSetAssoc::findBlock() does. */
+static void
+tagLookupWayByWay(microbench::State &state)
+{
+    setLookup<wayByWay>(state);
+}
+GEM5_BENCHMARK(tagLookupWayByWay)->arg(4)->arg(8)->arg(16)->arg(32);
@@ -0,0 +1,90 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Vectorised comparison of a set's tags against a lookup tag.
+ */
+
+#ifndef __MEM_CACHE_TAGS_TAG_MATCH_HH__
+#define __MEM_CACHE_TAGS_TAG_MATCH_HH__
+
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Compare up to 64 contiguous tags against a single tag.
+ *
+ * Uses AVX2 or NEON when the host compiler targets them; the scalar
+ * tail is written without branches so that it vectorises as well.
+ *
+ * @param tags Pointer to the first tag of the set.
+ * @param num_tags Number of tags to compare, at most 64.
+ * @param tag The tag to look for.
+ * @return A mask with bit i set if tags[i] == tag.
+ */
+inline uint64_t
+matchTags(const Addr *tags, unsigned num_tags, Addr tag)
+{
+    uint64_t mask = 0;
+    unsigned i = 0;
+
+#if defined(__AVX2__)
+    const __m256i key = _mm256_set1_epi64x(tag);
+    for (; i + 4 <= num_tags; i += 4) {
+        const __m256i eq = _mm256_cmpeq_epi64(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tags + i)),
+            key);
+        mask |= uint64_t(_mm256_movemask_pd(_mm256_castsi256_pd(eq))) << i;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint64x2_t key = vdupq_n_u64(tag);
+    for (; i + 2 <= num_tags; i += 2) {
+        const uint64x2_t eq = vceqq_u64(vld1q_u64(tags + i), key);
+        mask |= (vgetq_lane_u64(eq, 0) & 1) << i;
+        mask |= (vgetq_lane_u64(eq, 1) & 1) << (i + 1);
+    }
+#endif
+
+    for (; i < num_tags; ++i) {
+        mask |= uint64_t(tags[i] == tag) << i;
+    }
+
+    return mask;
+}
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_TAG_MATCH_HH__
@@ -0,0 +1,84 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "mem/cache/tags/tag_match.hh"
+
+using namespace gem5;
+
+/** Reference implementation of matchTags(). */
+static uint64_t
+scalarMatch(const std::vector<Addr> &tags, unsigned num_tags, Addr tag)
+{
+    uint64_t mask = 0;
+    for (unsigned i = 0; i < num_tags; ++i) {
+        if (tags[i] == tag) {
+            mask |= 1ULL << i;
+        }
+    }
+    return mask;
+}
+
+/** No tag matches. */
+TEST(TagMatchTest, NoMatch)
+{
+    std::vector<Addr> tags(16, MaxAddr);
+    ASSERT_EQ(matchTags(tags.data(), tags.size(), 0x42), 0);
+}
+
+/** Every way of every associativity up to 64 matches on its own. */
+TEST(TagMatchTest, SingleMatch)
+{
+    for (unsigned assoc = 1; assoc <= 64; ++assoc) {
+        std::vector<Addr> tags(assoc);
+        for (unsigned i = 0; i < assoc; ++i) {
+            tags[i] = i + 0x1000;
+        }
+        for (unsigned way = 0; way < assoc; ++way) {
+            ASSERT_EQ(matchTags(tags.data(), assoc, way + 0x1000),
+                      1ULL << way) << "assoc " << assoc;
+        }
+    }
+}
+
+/** Duplicated tags set all their bits; tags past num_tags are ignored. */
+TEST(TagMatchTest, MultipleMatches)
+{
+    std::vector<Addr> tags = {7, 3, 7, 7, 1, 7, 0, 7, 7};
+    ASSERT_EQ(matchTags(tags.data(), 8, 7), scalarMatch(tags, 8, 7));
+    ASSERT_EQ(matchTags(tags.data(), 8, 7), 0xadULL);
+}
+
+/** Upper tag bits take part in the comparison. */
+TEST(TagMatchTest, FullWidth)
+{
+    std::vector<Addr> tags = {1ULL << 63, 1, (1ULL << 63) | 1, 0};
+    ASSERT_EQ(matchTags(tags.data(), 4, 1), 0x2);
+    ASSERT_EQ(matchTags(tags.data(), 4, 1ULL << 63), 0x1);
+}
@@ -88,10 +88,12 @@ class TaggedSetAssociative : public TaggedIndexingPolicy
       : TaggedIndexingPolicy(p, p.size / p.entry_size, floorLog2(p.entry_size))
     {}
 
-    std::vector<ReplaceableEntry*>
-    getPossibleEntries(const KeyType &key) const override
+    void
+    getPossibleEntries(const KeyType &key,
+                       std::vector<ReplaceableEntry*> &entries) const override
     {
-        return sets[extractSet(key)];
+        const auto &set = sets[extractSet(key)];
+        entries.assign(set.begin(), set.end());
     }
 
     Addr
@@ -0,0 +1,220 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/tags/trace_replay.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "mem/cache/cache_blk.hh"
+#include "mem/cache/tags/base.hh"
+#include "mem/packet.hh"
+#include "params/TagsReplayCache.hh"
+#include "params/TagsTraceReplayer.hh"
+#include "proto/packet.pb.h"
+#include "proto/protoio.hh"
+#include "sim/core.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_exit.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+TagsReplayCache::TagsReplayCache(const Params &p)
+    : SimObject(p), tags(p.tags), blkMask(~Addr(p.cache_line_size - 1)),
+      stats(this)
+{
+    tags->tagsInit();
+}
+
+void
+TagsReplayCache::replay(
+    const std::vector<binary_packet_trace::Record> &trace, bool use_pc,
+    EventQueue &eq, RequestorID id)
+{
+    const unsigned blk_size = ~blkMask + 1;
+
+    // One request and packet per security state are reused for every
+    // access, only their address, command and PC change.
+    RequestPtr reqs[2] = {
+        std::make_shared<Request>(0, blk_size, 0, id),
+        std::make_shared<Request>(0, blk_size, Request::SECURE, id),
+    };
+    Packet pkts[2] = {
+        Packet(reqs[0], MemCmd::ReadReq), Packet(reqs[1], MemCmd::ReadReq)
+    };
+
+    std::vector<CacheBlk*> evict_blks;
+    Tick tick = 0;
+    Counter hits = 0, misses = 0, evictions = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto &r : trace) {
+        const MemCmd cmd((MemCmd::Command)r.cmd);
+        // Clean evictions only tell the level below that a block left the
+        // level above, they do not access it
+        if (cmd == MemCmd::CleanEvict)
+            continue;
+
+        eq.setCurTick(++tick);
+
+        const bool secure = r.flags & Request::SECURE;
+        Packet &pkt = pkts[secure];
+        const Addr addr = r.addr & blkMask;
+        reqs[secure]->setPaddr(addr);
+        if (use_pc)
+            reqs[secure]->setPC(r.pc);
+        pkt.cmd = cmd;
+        pkt.setAddr(addr);
+
+        Cycles lat;
+        if (tags->accessBlock(&pkt, lat)) {
+            ++hits;
+            continue;
+        }
+
+        ++misses;
+        CacheBlk *victim = tags->findVictim({addr, secure}, blk_size * 8,
+                                            evict_blks);
+        // Nothing can be replaced, e.g. all ways are reserved
+        if (!victim)
+            continue;
+
+        for (auto *blk : evict_blks) {
+            if (blk->isValid()) {
+                ++evictions;
+                tags->invalidate(blk);
+            }
+        }
+        tags->insertBlock(&pkt, victim);
+    }
+    stats.hostSeconds += std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    stats.hits += hits;
+    stats.misses += misses;
+    stats.evictions += evictions;
+}
+
+TagsReplayCache::TagsReplayCacheStats::TagsReplayCacheStats(
+    TagsReplayCache *parent)
+    : statistics::Group(parent),
+      ADD_STAT(hits, statistics::units::Count::get(),
+               "Number of replayed accesses that hit"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of replayed accesses that missed"),
+      ADD_STAT(evictions, statistics::units::Count::get(),
+               "Number of valid blocks evicted"),
+      ADD_STAT(missRate, statistics::units::Ratio::get(),
+               "Miss rate of the replayed accesses", misses / (hits + misses)),
+      ADD_STAT(hostSeconds, statistics::units::Second::get(),
+               "Host time spent replaying the trace"),
+      ADD_STAT(accessRate, statistics::units::Rate<
+                   statistics::units::Count, statistics::units::Second>::get(),
+               "Replayed accesses per host second",
+               (hits + misses) / hostSeconds)
+{
+}
+
+TagsTraceReplayer::TagsTraceReplayer(const Params &p)
+    : SimObject(p), traceFile(p.trace_file), caches(p.caches),
+      numThreads(p.num_threads),
+      requestorId(p.system->getRequestorId(this)), tracePCs(false)
+{
+    fatal_if(caches.empty(), "%s: No caches to replay the trace through.",
+             name());
+}
+
+void
+TagsTraceReplayer::loadTrace()
+{
+    if (binary_packet_trace::isTrace(traceFile)) {
+        binary_packet_trace::Reader reader(traceFile);
+        trace.reserve(reader.header().numRecords);
+        binary_packet_trace::Record record;
+        while (reader.read(record))
+            trace.push_back(record);
+    } else {
+        ProtoInputStream stream(traceFile, true);
+        ProtoMessage::PacketHeader header_msg;
+        panic_if(!stream.read(header_msg),
+                 "%s: Failed to read packet header from %s.", name(),
+                 traceFile);
+
+        ProtoMessage::Packet pkt_msg;
+        while (stream.read(pkt_msg)) {
+            binary_packet_trace::Record record = {};
+            record.tick = pkt_msg.tick();
+            record.addr = pkt_msg.addr();
+            record.pc = pkt_msg.has_pc() ? pkt_msg.pc() : 0;
+            record.size = pkt_msg.size();
+            record.cmd = pkt_msg.cmd();
+            record.flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
+            trace.push_back(record);
+        }
+    }
+
+    tracePCs = std::any_of(trace.begin(), trace.end(),
+                           [](const auto &r) { return r.pc != 0; });
+}
+
+void
+TagsTraceReplayer::startup()
+{
+    loadTrace();
+    inform("%s: Replaying %d accesses through %d caches.", name(),
+           trace.size(), caches.size());
+
+    unsigned num_threads = numThreads;
+    if (!num_threads)
+        num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    num_threads = std::min<size_t>(num_threads, caches.size());
+
+    // The caches are independent, each is replayed on a single thread
+    // with an event queue of its own to provide curTick()
+    std::atomic<size_t> next(0);
+    auto worker = [this, &next](unsigned id) {
+        EventQueue eq(csprintf("%s.worker%d", name(), id));
+        curEventQueue(&eq);
+        for (size_t i; (i = next++) < caches.size(); )
+            caches[i]->replay(trace, tracePCs, eq, requestorId);
+        curEventQueue(nullptr);
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < num_threads; t++)
+        threads.emplace_back(worker, t);
+    for (auto &thread : threads)
+        thread.join();
+
+    exitSimLoop("trace replay complete");
+}
+
+} // namespace gem5
@@ -0,0 +1,130 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Trace-driven replay of memory accesses through cache tags.
+ */
+
+#ifndef __MEM_CACHE_TAGS_TRACE_REPLAY_HH__
+#define __MEM_CACHE_TAGS_TRACE_REPLAY_HH__
+
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/binary_packet_trace.hh"
+#include "mem/request.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+struct TagsReplayCacheParams;
+struct TagsTraceReplayerParams;
+
+class BaseTags;
+class EventQueue;
+class System;
+
+/**
+ * One cache configuration evaluated by a TagsTraceReplayer. It only holds
+ * the tags, with their indexing and replacement policies, and the
+ * parameters the tags take from their cache; there is no data, no MSHRs
+ * and no timing.
+ */
+class TagsReplayCache : public SimObject
+{
+  public:
+    PARAMS(TagsReplayCache);
+    TagsReplayCache(const Params &p);
+
+    /**
+     * Replay a trace through the tags. Each access looks the block up and,
+     * on a miss, evicts the victim chosen by the replacement policy and
+     * inserts the block, as a cache allocating on every miss would.
+     *
+     * Accesses are one tick apart on the given event queue, so that
+     * policies ordering blocks by their last touch see a strict order.
+     *
+     * @param trace The accesses to replay.
+     * @param use_pc Whether the trace records the PC of the accesses.
+     * @param eq Event queue private to the calling thread.
+     * @param id Requestor ID of the accesses.
+     */
+    void replay(const std::vector<binary_packet_trace::Record> &trace,
+                bool use_pc, EventQueue &eq, RequestorID id);
+
+  private:
+    BaseTags *const tags;
+
+    const Addr blkMask;
+
+    struct TagsReplayCacheStats : public statistics::Group
+    {
+        TagsReplayCacheStats(TagsReplayCache *parent);
+
+        statistics::Scalar hits;
+        statistics::Scalar misses;
+        statistics::Scalar evictions;
+        statistics::Formula missRate;
+        statistics::Scalar hostSeconds;
+        statistics::Formula accessRate;
+    } stats;
+};
+
+/**
+ * Replay a captured packet trace, e.g. the miss stream of an L2 recorded
+ * by a MemTraceProbe, through any number of cache configurations. The
+ * configurations are independent, so they are replayed in parallel host
+ * threads. This happens at startup; the simulation then exits.
+ */
+class TagsTraceReplayer : public SimObject
+{
+  public:
+    PARAMS(TagsTraceReplayer);
+    TagsTraceReplayer(const Params &p);
+
+    void startup() override;
+
+  private:
+    /** Read the whole trace, protobuf or binary, into memory. */
+    void loadTrace();
+
+    const std::string traceFile;
+    const std::vector<TagsReplayCache *> caches;
+    const unsigned numThreads;
+    const RequestorID requestorId;
+
+    std::vector<binary_packet_trace::Record> trace;
+
+    /** Set if any access of the trace has a PC. */
+    bool tracePCs;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_TRACE_REPLAY_HH__
@@ -52,9 +52,10 @@ namespace gem5
 {
 
 WriteQueue::WriteQueue(const std::string &_label,
-                       int num_entries, int reserve, const std::string &name)
+                       int num_entries, int reserve, const std::string &name,
+                       bool hash_index)
     : Queue<WriteQueueEntry>(_label, num_entries, reserve,
-            name + ".write_queue")
+            name + ".write_queue", hash_index)
 {}
 
 WriteQueueEntry *
@@ -67,7 +68,7 @@ WriteQueue::allocate(Addr blk_addr, unsigned blk_size, PacketPtr pkt,
     freeList.pop_front();
 
     entry->allocate(blk_addr, blk_size, pkt, when_ready, order);
-    entry->allocIter = allocatedList.insert(allocatedList.end(), entry);
+    entry->allocIter = addToAllocatedList(entry);
     entry->readyIter = addToReadyList(entry);
 
     allocated += 1;
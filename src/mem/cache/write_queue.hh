@@ -67,9 +67,10 @@ class WriteQueue : public Queue<WriteQueueEntry>
      * @param num_entries The number of entries in this queue.
      * @param reserve The maximum number of entries needed to satisfy
      *        any access.
+     * @param hash_index Index the allocated entries by block address.
      */
     WriteQueue(const std::string &_label, int num_entries, int reserve,
-            const std::string &name);
+            const std::string &name, bool hash_index = false);
 
     /**
      * Allocates a new WriteQueueEntry for the request and size. This
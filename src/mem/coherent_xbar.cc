@@ -305,6 +305,7 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     if (snoopFilter && snoop_caches) {
         // Let the snoop filter know about the success of the send operation
         snoopFilter->finishRequest(!success, addr, pkt->isSecure());
+        backInvalidate();
     }
 
     // check if we were successful in sending the packet onwards
@@ -724,6 +725,44 @@ CoherentXBar::forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
     snoopFanout.sample(fanout);
 }
 
+void
+CoherentXBar::backInvalidate()
+{
+    Addr addr;
+    bool is_secure;
+    const auto holders = snoopFilter->selectVictim(addr, is_secure);
+    if (holders.empty())
+        return;
+
+    // Clean and invalidate the line in the caches holding it, as the
+    // behaviour is the same as for a cache maintenance operation: the
+    // caches write back dirty copies with a WriteClean and do not
+    // respond. The writebacks are on behalf of the caches, hence the
+    // requestor id.
+    RequestPtr req = std::make_shared<Request>(addr, system->cacheLineSize(),
+                                               0, Request::wbRequestorId);
+    if (is_secure)
+        req->setFlags(Request::SECURE);
+    Packet pkt(req, MemCmd::CleanInvalidReq);
+
+    DPRINTF(CoherentXBar, "%s: %s\n", __func__, pkt.print());
+
+    bool written_back = false;
+    if (system->isTimingMode()) {
+        pkt.setExpressSnoop();
+        forwardTiming(&pkt, InvalidPortID, holders);
+        // a WriteClean that is still on its way may be snooped until it
+        // leaves the cache, keep tracking the line until then
+        written_back = pkt.satisfied();
+    } else {
+        // atomic writebacks are done by the time the snoop returns
+        forwardAtomic(&pkt, InvalidPortID, InvalidPortID, holders);
+    }
+
+    if (!written_back)
+        snoopFilter->finishBackInvalidate(addr, is_secure);
+}
+
 void
 CoherentXBar::recvReqRetry(PortID mem_side_port_id)
 {
@@ -772,6 +811,7 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
             // avoid situations where atomic upward snoops sneak in
             // between and change the filter state
             snoopFilter->finishRequest(false, pkt->getAddr(), pkt->isSecure());
+            backInvalidate();
 
             if (pkt->isEviction()) {
                 // for block-evicting packets, i.e. writebacks and
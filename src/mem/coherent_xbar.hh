@@ -412,6 +412,12 @@ class CoherentXBar : public BaseXBar
      */
     bool forwardPacket(const PacketPtr pkt);
 
+    /**
+     * Clean and invalidate a line in the caches above if the snoop
+     * filter has to drop one to stay within its capacity.
+     */
+    void backInvalidate();
+
     /**
      * Determine if the packet's destination is the memory below
      *
@@ -39,11 +39,15 @@
 
 #include "mem/comm_monitor.hh"
 
+#include <algorithm>
+
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/CommMonitor.hh"
 #include "sim/core.hh"
 #include "sim/cur_tick.hh"
 #include "sim/stats.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
@@ -172,7 +176,32 @@ CommMonitor::MonitorStats::MonitorStats(statistics::Group *parent,
       ADD_STAT(readAddrDist, statistics::units::Count::get(),
                "Read address distribution"),
       ADD_STAT(writeAddrDist, statistics::units::Count::get(),
-               "Write address distribution")
+               "Write address distribution"),
+      perRequestorStats(params.per_requestor_stats),
+      system(params.system),
+      ADD_STAT(requestorTotalReadBytes, statistics::units::Byte::get(),
+               "Number of bytes read per requestor"),
+      ADD_STAT(requestorTotalWrittenBytes, statistics::units::Byte::get(),
+               "Number of bytes written per requestor"),
+      ADD_STAT(requestorPeakReadBandwidth, statistics::units::Rate<
+                    statistics::units::Byte, statistics::units::Second>::get(),
+               "Highest read bandwidth in a sample period per requestor"),
+      ADD_STAT(requestorPeakWriteBandwidth, statistics::units::Rate<
+                    statistics::units::Byte, statistics::units::Second>::get(),
+               "Highest write bandwidth in a sample period per requestor"),
+      ADD_STAT(requestorReadResps, statistics::units::Count::get(),
+               "Number of read responses per requestor"),
+      ADD_STAT(requestorTotalReadLatency, statistics::units::Tick::get(),
+               "Total read latency per requestor"),
+      ADD_STAT(requestorAvgReadLatency, statistics::units::Rate<
+                    statistics::units::Tick, statistics::units::Count>::get(),
+               "Average read latency per requestor"),
+      ADD_STAT(requestorReadLatencyDist, statistics::units::Count::get(),
+               "Read latency distribution per requestor, by bucket base "
+               "latency in ticks"),
+      ADD_STAT(requestorWriteLatencyDist, statistics::units::Count::get(),
+               "Write latency distribution per requestor, by bucket base "
+               "latency in ticks")
 {
     using namespace statistics;
 
@@ -255,6 +284,88 @@ CommMonitor::MonitorStats::MonitorStats(statistics::Group *parent,
         .flags(disableAddrDists ? nozero : pdf);
 }
 
+int
+CommMonitor::MonitorStats::latencyBucket(Tick latency)
+{
+    if (latency < 4)
+        return latency;
+    int log = floorLog2(latency);
+    int bucket = 4 * (log - 1) + ((latency >> (log - 2)) & 3);
+    return std::min(bucket, latencyBuckets - 1);
+}
+
+Tick
+CommMonitor::MonitorStats::latencyBucketBase(int bucket)
+{
+    if (bucket < 4)
+        return bucket;
+    int log = bucket / 4 + 1;
+    return (Tick(4) | (bucket & 3)) << (log - 2);
+}
+
+void
+CommMonitor::MonitorStats::regStats()
+{
+    using namespace statistics;
+
+    statistics::Group::regStats();
+
+    const int num_requestors = perRequestorStats ? system->maxRequestors() : 0;
+    requestorReadBytes.assign(num_requestors, 0);
+    requestorWrittenBytes.assign(num_requestors, 0);
+    if (!perRequestorStats)
+        return;
+
+    for (auto *stat : {&requestorTotalReadBytes, &requestorTotalWrittenBytes,
+                       &requestorPeakReadBandwidth,
+                       &requestorPeakWriteBandwidth, &requestorReadResps,
+                       &requestorTotalReadLatency}) {
+        stat->init(num_requestors).flags(total | nozero | nonan);
+    }
+    requestorAvgReadLatency.flags(nozero | nonan);
+    requestorAvgReadLatency = requestorTotalReadLatency / requestorReadResps;
+
+    requestorReadLatencyDist.init(num_requestors, latencyBuckets)
+        .flags(nozero);
+    requestorWriteLatencyDist.init(num_requestors, latencyBuckets)
+        .flags(nozero);
+    for (int b = 0; b < latencyBuckets; b++) {
+        std::string base = std::to_string(latencyBucketBase(b));
+        requestorReadLatencyDist.ysubname(b, base);
+        requestorWriteLatencyDist.ysubname(b, base);
+    }
+
+    for (int i = 0; i < num_requestors; i++) {
+        const std::string requestor = system->getRequestorName(i);
+        for (auto *stat : {&requestorTotalReadBytes,
+                           &requestorTotalWrittenBytes,
+                           &requestorPeakReadBandwidth,
+                           &requestorPeakWriteBandwidth,
+                           &requestorReadResps,
+                           &requestorTotalReadLatency}) {
+            stat->subname(i, requestor);
+        }
+        requestorAvgReadLatency.subname(i, requestor);
+        requestorReadLatencyDist.subname(i, requestor);
+        requestorWriteLatencyDist.subname(i, requestor);
+    }
+}
+
+void
+CommMonitor::MonitorStats::samplePerRequestor(double sample_period)
+{
+    for (int i = 0; i < requestorReadBytes.size(); i++) {
+        double read_bw = requestorReadBytes[i] / sample_period;
+        double write_bw = requestorWrittenBytes[i] / sample_period;
+        if (read_bw > requestorPeakReadBandwidth[i].value())
+            requestorPeakReadBandwidth[i] = read_bw;
+        if (write_bw > requestorPeakWriteBandwidth[i].value())
+            requestorPeakWriteBandwidth[i] = write_bw;
+    }
+    std::fill(requestorReadBytes.begin(), requestorReadBytes.end(), 0);
+    std::fill(requestorWrittenBytes.begin(), requestorWrittenBytes.end(), 0);
+}
+
 void
 CommMonitor::MonitorStats::updateReqStats(
     const probing::PacketInfo& pkt_info, bool is_atomic,
@@ -319,6 +430,12 @@ CommMonitor::MonitorStats::updateReqStats(
 
         if (!is_atomic && !disableOutstandingHists && expects_response)
             ++outstandingWriteReqs;
+
+        // Written bytes are counted on requests, like writtenBytes
+        if (pkt_info.id < requestorWrittenBytes.size()) {
+            requestorWrittenBytes[pkt_info.id] += pkt_info.size;
+            requestorTotalWrittenBytes[pkt_info.id] += pkt_info.size;
+        }
     }
 }
 
@@ -342,6 +459,17 @@ CommMonitor::MonitorStats::updateRespStats(
             totalReadBytes += pkt_info.size;
         }
 
+        if (pkt_info.id < requestorReadBytes.size()) {
+            requestorReadBytes[pkt_info.id] += pkt_info.size;
+            requestorTotalReadBytes[pkt_info.id] += pkt_info.size;
+            if (!disableLatencyHists) {
+                requestorReadResps[pkt_info.id]++;
+                requestorTotalReadLatency[pkt_info.id] += latency;
+                requestorReadLatencyDist[pkt_info.id]
+                    [latencyBucket(latency)]++;
+            }
+        }
+
     } else if (pkt_info.cmd.isWrite()) {
         // Decrement number of outstanding write requests
         if (!is_atomic && !disableOutstandingHists) {
@@ -349,8 +477,13 @@ CommMonitor::MonitorStats::updateRespStats(
             --outstandingWriteReqs;
         }
 
-        if (!disableLatencyHists)
+        if (!disableLatencyHists) {
             writeLatencyHist.sample(latency);
+            if (pkt_info.id < requestorWrittenBytes.size()) {
+                requestorWriteLatencyDist[pkt_info.id]
+                    [latencyBucket(latency)]++;
+            }
+        }
     }
 }
 
@@ -399,7 +532,7 @@ CommMonitor::recvTimingReq(PacketPtr pkt)
     // would not come back from the memory. Therefore we additionally
     // have to check the cacheResponding flag
     if (expects_response && !stats.disableLatencyHists) {
-        pkt->pushSenderState(new CommMonitorSenderState(curTick()));
+        pkt->emplaceSenderState<CommMonitorSenderState>(curTick());
     }
 
     // Attempt to send the packet
@@ -555,6 +688,9 @@ CommMonitor::samplePeriodic()
         }
     }
 
+    // The per-requestor window counters are reset either way
+    stats.samplePerRequestor(samplePeriod);
+
     // reset the sampled values
     stats.readTrans = 0;
     stats.writeTrans = 0;
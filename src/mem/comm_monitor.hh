@@ -40,6 +40,8 @@
 #ifndef __MEM_COMM_MONITOR_HH__
 #define __MEM_COMM_MONITOR_HH__
 
+#include <vector>
+
 #include "base/statistics.hh"
 #include "mem/port.hh"
 #include "params/CommMonitor.hh"
@@ -49,6 +51,8 @@
 namespace gem5
 {
 
+class System;
+
 /**
  * The communication monitor is a SimObject which can monitor statistics of
  * the communication happening between two ports in the memory system.
@@ -378,6 +382,43 @@ class CommMonitor : public SimObject
          */
         statistics::SparseHistogram writeAddrDist;
 
+        /** Enable flag for the per-requestor stats */
+        bool perRequestorStats;
+
+        /** System used to size and name the per-requestor stats */
+        System *system;
+
+        /**
+         * Number of per-requestor latency buckets. Latencies below 4
+         * ticks get a bucket each, then every power of two is split
+         * into 4 buckets, like an HDR histogram with 2 bits of
+         * precision. The last bucket also counts anything larger.
+         */
+        static constexpr int latencyBuckets = 160;
+
+        /** Bucket of a latency, and the smallest latency it counts */
+        static int latencyBucket(Tick latency);
+        static Tick latencyBucketBase(int bucket);
+
+        /** Bytes read and written per requestor in this sample period */
+        std::vector<uint64_t> requestorReadBytes;
+        std::vector<uint64_t> requestorWrittenBytes;
+
+        statistics::Vector requestorTotalReadBytes;
+        statistics::Vector requestorTotalWrittenBytes;
+
+        /** Highest bandwidth seen in a sample period, per requestor */
+        statistics::Vector requestorPeakReadBandwidth;
+        statistics::Vector requestorPeakWriteBandwidth;
+
+        statistics::Vector requestorReadResps;
+        statistics::Vector requestorTotalReadLatency;
+        statistics::Formula requestorAvgReadLatency;
+
+        /** Latency distributions, indexed by requestor and bucket */
+        statistics::Vector2d requestorReadLatencyDist;
+        statistics::Vector2d requestorWriteLatencyDist;
+
         /**
          * Create the monitor stats and initialise all the members
          * that are not statistics themselves, but used to control the
@@ -390,6 +431,11 @@ class CommMonitor : public SimObject
                             bool expects_response);
         void updateRespStats(const probing::PacketInfo& pkt, Tick latency,
                              bool is_atomic);
+
+        void regStats() override;
+
+        /** Sample and reset the per-requestor sample period counters */
+        void samplePerRequestor(double sample_period);
     };
 
     /** This function is called periodically at the end of each time bin */
@@ -0,0 +1,491 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/dram_cache_ctrl.hh"
+
+#include "base/intmath.hh"
+#include "base/trace.hh"
+#include "debug/DRAMCache.hh"
+#include "debug/Drain.hh"
+#include "mem/mem_interface.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+DRAMCacheCtrl::DRAMCacheCtrl(const DRAMCacheCtrlParams &p) :
+    MemCtrl(p),
+    farPort(name() + ".far_port", *this),
+    range(p.range),
+    blockSizeLg2(floorLog2(p.block_size)),
+    setsLg2(floorLog2(p.dram->getAddrRange().size() / p.block_size)),
+    requestorId(p.system->getRequestorId(this)),
+    tagChunks(divCeil(uint64_t(1) << setsLg2, uint64_t(1) << chunkLg2)),
+    predictor(p.predictor_entries, SatCounter8(3)),
+    cacheStats(*this)
+{
+    const AddrRange &dram_range = dram->getAddrRange();
+
+    fatal_if(!isPowerOf2(p.block_size),
+             "DRAMCacheCtrl's block size must be a power of 2.\n");
+    fatal_if(dram_range.interleaved(),
+             "DRAMCacheCtrl's DRAM range %s can't be interleaved.\n",
+             dram_range.to_string());
+    fatal_if(dram_range.size() != uint64_t(1) << (setsLg2 + blockSizeLg2),
+             "DRAMCacheCtrl's DRAM size must be a power of 2 multiple of "
+             "the block size.\n");
+    fatal_if(range.size() >> (setsLg2 + blockSizeLg2) > TagMask + 1,
+             "DRAMCacheCtrl's range %s is more than %d times the size of "
+             "the cache.\n", range.to_string(), TagMask + 1);
+}
+
+DRAMCacheCtrl::FarMemoryPort::FarMemoryPort(const std::string &name,
+                                            DRAMCacheCtrl &_ctrl) :
+    QueuedRequestPort(name, reqQueue, snoopRespQueue),
+    reqQueue(_ctrl, *this), snoopRespQueue(_ctrl, *this), ctrl(_ctrl)
+{
+    // The far memory accesses in flight are bounded by the read and
+    // write buffers of the controller
+    reqQueue.disableSanityCheck();
+}
+
+bool
+DRAMCacheCtrl::FarMemoryPort::recvTimingResp(PacketPtr pkt)
+{
+    ctrl.recvFarTimingResp(pkt);
+    return true;
+}
+
+void
+DRAMCacheCtrl::init()
+{
+    MemCtrl::init();
+
+    fatal_if(!farPort.isConnected(), "DRAMCacheCtrl %s's far_port is "
+             "unconnected!\n", name());
+}
+
+Port &
+DRAMCacheCtrl::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "far_port")
+        return farPort;
+    return MemCtrl::getPort(if_name, idx);
+}
+
+AddrRangeList
+DRAMCacheCtrl::getAddrRanges()
+{
+    return AddrRangeList({range});
+}
+
+Addr
+DRAMCacheCtrl::mediaAddr(Addr addr) const
+{
+    // Every block has one place in the cache
+    return dram->getAddrRange().start() + (setOf(addr) << blockSizeLg2) +
+        (addr & mask(blockSizeLg2));
+}
+
+DRAMCacheCtrl::TagEntry &
+DRAMCacheCtrl::tagEntry(uint64_t set)
+{
+    auto &chunk = tagChunks[set >> chunkLg2];
+    if (!chunk)
+        chunk.reset(new TagEntry[uint64_t(1) << chunkLg2]());
+    return chunk[set & mask(chunkLg2)];
+}
+
+Addr
+DRAMCacheCtrl::blockAddr(uint64_t set, TagEntry entry) const
+{
+    const Addr offset = (Addr(entry & TagMask) << (blockSizeLg2 + setsLg2)) |
+        (set << blockSizeLg2);
+    if (range.interleaved()) {
+        return range.addIntlvBits(offset +
+                                  range.removeIntlvBits(range.start()));
+    }
+    return range.start() + offset;
+}
+
+SatCounter8 &
+DRAMCacheCtrl::predictorEntry(PacketPtr pkt)
+{
+    const uint64_t key =
+        pkt->req->hasPC() ? pkt->req->getPC() : pkt->requestorId();
+    return predictor[(key ^ (key >> 12)) % predictor.size()];
+}
+
+bool
+DRAMCacheCtrl::bypass(PacketPtr pkt) const
+{
+    const Addr last = pkt->getAddr() + pkt->getSize() - 1;
+    return !(pkt->isRead() || pkt->isWrite()) ||
+        pkt->req->isUncacheable() || pkt->isLLSC() || pkt->isAtomicOp() ||
+        (pkt->getAddr() >> blockSizeLg2) != (last >> blockSizeLg2);
+}
+
+PacketPtr
+DRAMCacheCtrl::blockPacket(Addr block_addr, MemCmd cmd) const
+{
+    RequestPtr req = makeRequest(block_addr, 1 << blockSizeLg2, 0,
+                                 requestorId);
+    PacketPtr pkt = new Packet(req, cmd);
+    pkt->allocate();
+    return pkt;
+}
+
+void
+DRAMCacheCtrl::accessFarMemory(PacketPtr pkt)
+{
+    // The commands caches send can't all be used functionally, so
+    // use a plain read or write of the same bytes
+    RequestPtr req = makeRequest(pkt->getAddr(), pkt->getSize(), 0,
+                                 requestorId);
+    Packet func_pkt(req, pkt->isWrite() ? MemCmd::WriteReq :
+                                          MemCmd::ReadReq);
+    func_pkt.dataStatic(pkt->getPtr<uint8_t>());
+    farPort.sendFunctional(&func_pkt);
+}
+
+DRAMCacheCtrl::FarRead &
+DRAMCacheCtrl::readFarBlock(Addr block_addr)
+{
+    auto [it, inserted] = farReads.try_emplace(block_addr);
+    if (inserted) {
+        DPRINTF(DRAMCache, "Reading block %#x from far memory\n",
+                block_addr);
+        farPort.schedTimingReq(blockPacket(block_addr, MemCmd::ReadReq),
+                               curTick());
+    }
+    return it->second;
+}
+
+void
+DRAMCacheCtrl::insertBlock(Addr addr, bool dirty, bool fill)
+{
+    const uint64_t set = setOf(addr);
+    const TagEntry tag = tagOf(addr);
+    TagEntry &entry = tagEntry(set);
+
+    if ((entry & Valid) && (entry & TagMask) == tag) {
+        if (dirty)
+            entry |= Dirty;
+        return;
+    }
+
+    const TagEntry victim = entry;
+    entry = Valid | (dirty ? Dirty : 0) | tag;
+
+    if (!isTimingMode)
+        return;
+
+    if ((victim & Valid) && (victim & Dirty)) {
+        // The data of the victim is already in the far memory, so the
+        // write-back only takes its time there
+        const Addr victim_addr = blockAddr(set, victim);
+        DPRINTF(DRAMCache, "Writing back block %#x\n", victim_addr);
+        cacheStats.writebacks++;
+        farPort.schedTimingReq(
+            blockPacket(victim_addr, MemCmd::WritebackClean), curTick());
+    }
+
+    if (fill) {
+        const Addr block_addr = addr & ~mask(blockSizeLg2);
+        const unsigned pkt_count =
+            divCeil(1 << blockSizeLg2, dram->bytesPerBurst());
+        if (writeQueueFull(pkt_count)) {
+            DPRINTF(DRAMCache, "Write queue full, not timing fill of "
+                    "%#x\n", block_addr);
+            cacheStats.droppedFills++;
+            return;
+        }
+        cacheStats.fills++;
+        addToWriteQueue(blockPacket(block_addr, MemCmd::WritebackClean),
+                        pkt_count, dram);
+        if (!nextReqEvent.scheduled())
+            schedule(nextReqEvent, curTick());
+    }
+}
+
+bool
+DRAMCacheCtrl::recvTimingReq(PacketPtr pkt)
+{
+    panic_if(!range.contains(pkt->getAddr()),
+             "Can't handle address range for packet %s\n", pkt->print());
+
+    if (bypass(pkt)) {
+        DPRINTF(DRAMCache, "Bypassing %s\n", pkt->print());
+        cacheStats.bypasses++;
+        farPort.schedTimingReq(pkt, curTick() + frontendLatency);
+        return true;
+    }
+
+    const bool predict_miss = pkt->isRead() && !predictor.empty() &&
+        predictorEntry(pkt).calcSaturation() > 0.5;
+
+    if (!MemCtrl::recvTimingReq(pkt))
+        return false;
+
+    // Reads serviced by the write queue have been checked already
+    if (predict_miss && !pkt->isResponse()) {
+        cacheStats.predictedMisses++;
+        readFarBlock(pkt->getAddr() & ~mask(blockSizeLg2)).predicted++;
+        predictedMisses.insert(pkt);
+    }
+
+    return true;
+}
+
+void
+DRAMCacheCtrl::accessAndRespond(PacketPtr pkt, Tick static_latency,
+                                MemInterface* mem_intr)
+{
+    // Fills are done once they are in the write queue
+    if (isOwnPacket(pkt)) {
+        respond(pkt, static_latency, false);
+        return;
+    }
+
+    const bool needs_response = pkt->needsResponse();
+    const TagEntry entry = tagEntry(setOf(pkt->getAddr()));
+    const bool hit =
+        (entry & Valid) && (entry & TagMask) == tagOf(pkt->getAddr());
+
+    if (pkt->isWrite()) {
+        const bool dirty = pkt->cmd != MemCmd::WritebackClean;
+        if (hit)
+            cacheStats.writeHits++;
+        else
+            cacheStats.writeMisses++;
+        if (dirty)
+            accessFarMemory(pkt);
+        // The write itself is timed as the fill
+        insertBlock(pkt->getAddr(), dirty, false);
+        if (needs_response)
+            pkt->makeResponse();
+        respond(pkt, static_latency, needs_response);
+        return;
+    }
+
+    // The tag-and-data burst tells whether the block is present
+    const Addr block_addr = pkt->getAddr() & ~mask(blockSizeLg2);
+    const bool predicted = predictedMisses.erase(pkt);
+    if (!predictor.empty()) {
+        SatCounter8 &counter = predictorEntry(pkt);
+        if (hit)
+            counter--;
+        else
+            counter++;
+    }
+
+    if (hit) {
+        cacheStats.readHits++;
+        if (predicted) {
+            cacheStats.wastedFarReads++;
+            auto it = farReads.find(block_addr);
+            assert(it != farReads.end());
+            if (--it->second.predicted == 0 && it->second.done)
+                farReads.erase(it);
+        }
+        accessFarMemory(pkt);
+        if (needs_response)
+            pkt->makeResponse();
+        respond(pkt, static_latency, needs_response);
+        return;
+    }
+
+    DPRINTF(DRAMCache, "Read miss on %#x%s\n", pkt->getAddr(),
+            predicted ? ", predicted" : "");
+    cacheStats.readMisses++;
+    if (!predicted)
+        cacheStats.unpredictedMisses++;
+
+    FarRead &far = readFarBlock(block_addr);
+    if (predicted)
+        far.predicted--;
+
+    if (!far.done) {
+        far.waiting.push_back(pkt);
+        return;
+    }
+
+    // The far memory was faster than the DRAM
+    insertBlock(block_addr, false, true);
+    accessFarMemory(pkt);
+    if (needs_response)
+        pkt->makeResponse();
+    respond(pkt, static_latency, needs_response);
+    if (far.predicted == 0)
+        farReads.erase(block_addr);
+}
+
+void
+DRAMCacheCtrl::recvFarTimingResp(PacketPtr pkt)
+{
+    if (!isOwnPacket(pkt)) {
+        // A bypassed request
+        pkt->headerDelay = pkt->payloadDelay = 0;
+        port.schedTimingResp(pkt, curTick() + frontendLatency);
+        return;
+    }
+
+    const Addr block_addr = pkt->getAddr();
+    delete pkt;
+
+    auto it = farReads.find(block_addr);
+    assert(it != farReads.end());
+    FarRead &far = it->second;
+    far.done = true;
+
+    if (!far.waiting.empty()) {
+        insertBlock(block_addr, false, true);
+        for (PacketPtr demand : far.waiting) {
+            const bool needs_response = demand->needsResponse();
+            accessFarMemory(demand);
+            if (needs_response)
+                demand->makeResponse();
+            respond(demand, frontendLatency, needs_response);
+        }
+        far.waiting.clear();
+    }
+
+    // Reads that started this far read ahead of their tag check may
+    // still need it
+    if (far.predicted)
+        return;
+    farReads.erase(it);
+
+    if (drainState() == DrainState::Draining && !totalWriteQueueSize &&
+        !totalReadQueueSize && respQEmpty() && allIntfDrained()) {
+        DPRINTF(Drain, "DRAMCacheCtrl done draining\n");
+        signalDrainDone();
+    }
+}
+
+bool
+DRAMCacheCtrl::allIntfDrained() const
+{
+    return MemCtrl::allIntfDrained() && farReads.empty();
+}
+
+Tick
+DRAMCacheCtrl::recvAtomic(PacketPtr pkt)
+{
+    panic_if(!range.contains(pkt->getAddr()),
+             "Can't handle address range for packet %s\n", pkt->print());
+
+    if (bypass(pkt)) {
+        cacheStats.bypasses++;
+        return farPort.sendAtomic(pkt);
+    }
+
+    const TagEntry entry = tagEntry(setOf(pkt->getAddr()));
+    const bool hit =
+        (entry & Valid) && (entry & TagMask) == tagOf(pkt->getAddr());
+    const bool is_read = pkt->isRead();
+
+    if (is_read) {
+        if (hit)
+            cacheStats.readHits++;
+        else
+            cacheStats.readMisses++;
+        if (!hit)
+            insertBlock(pkt->getAddr(), false, false);
+    } else {
+        if (hit)
+            cacheStats.writeHits++;
+        else
+            cacheStats.writeMisses++;
+        insertBlock(pkt->getAddr(), pkt->cmd != MemCmd::WritebackClean,
+                    false);
+    }
+
+    // The far memory holds the data, whether the block hit or not
+    const Tick far_latency = farPort.sendAtomic(pkt);
+    return dram->accessLatency() + (is_read && !hit ? far_latency : 0);
+}
+
+Tick
+DRAMCacheCtrl::recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor)
+{
+    // No backdoor, the cache has to see every access
+    return recvAtomic(pkt);
+}
+
+void
+DRAMCacheCtrl::recvMemBackdoorReq(const MemBackdoorReq &req,
+                                  MemBackdoorPtr &backdoor)
+{
+}
+
+void
+DRAMCacheCtrl::recvFunctional(PacketPtr pkt)
+{
+    farPort.sendFunctional(pkt);
+}
+
+DRAMCacheCtrl::DRAMCacheStats::DRAMCacheStats(DRAMCacheCtrl &ctrl)
+    : statistics::Group(&ctrl, "dramCache"),
+      ADD_STAT(readHits, statistics::units::Count::get(),
+               "Number of reads that hit in the DRAM cache"),
+      ADD_STAT(readMisses, statistics::units::Count::get(),
+               "Number of reads that missed in the DRAM cache"),
+      ADD_STAT(writeHits, statistics::units::Count::get(),
+               "Number of writes that hit in the DRAM cache"),
+      ADD_STAT(writeMisses, statistics::units::Count::get(),
+               "Number of writes that missed in the DRAM cache"),
+      ADD_STAT(hitRate, statistics::units::Ratio::get(),
+               "Hit rate of the DRAM cache",
+               (readHits + writeHits) /
+               (readHits + writeHits + readMisses + writeMisses)),
+      ADD_STAT(bypasses, statistics::units::Count::get(),
+               "Number of requests sent to the far memory uncached"),
+      ADD_STAT(writebacks, statistics::units::Count::get(),
+               "Number of dirty blocks written back to the far memory"),
+      ADD_STAT(fills, statistics::units::Count::get(),
+               "Number of blocks written to the DRAM after a miss"),
+      ADD_STAT(droppedFills, statistics::units::Count::get(),
+               "Number of fills not timed because the write queue was "
+               "full"),
+      ADD_STAT(predictedMisses, statistics::units::Count::get(),
+               "Number of far memory reads started ahead of the tag "
+               "check"),
+      ADD_STAT(wastedFarReads, statistics::units::Count::get(),
+               "Number of far memory reads started ahead of a tag check "
+               "that hit"),
+      ADD_STAT(unpredictedMisses, statistics::units::Count::get(),
+               "Number of misses that read the far memory after the tag "
+               "check")
+{
+    using namespace statistics;
+    hitRate.flags(nozero | nonan);
+}
+
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,247 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * DRAMCacheCtrl declaration
+ */
+
+#ifndef __MEM_DRAM_CACHE_CTRL_HH__
+#define __MEM_DRAM_CACHE_CTRL_HH__
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "base/sat_counter.hh"
+#include "base/statistics.hh"
+#include "mem/mem_ctrl.hh"
+#include "mem/qport.hh"
+#include "params/DRAMCacheCtrl.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * A memory-side DRAM cache in front of a far memory.
+ *
+ * The cache is direct mapped and keeps every tag next to its block in
+ * the DRAM, as in the Alloy cache (Qureshi and Loh, "Fundamental
+ * Latency Trade-off in Architecting DRAM Caches", MICRO 2012): a read
+ * is a single tag-and-data burst of the DRAM interface, after which
+ * the tag tells whether the block has to be fetched from the far
+ * memory. A miss predictor indexed by PC, or by requestor when there
+ * is no PC, starts the far memory read in parallel with the DRAM burst
+ * for reads that are likely to miss.
+ *
+ * Writes allocate, and dirty blocks are written back to the far memory
+ * when evicted. Fills and write-backs are timed on the DRAM and on the
+ * far memory respectively.
+ *
+ * The controller only models timing. The data is always kept in the
+ * far memory, which writes are propagated to functionally when they
+ * are accepted, and the DRAM interface should not be backed (null =
+ * True) nor be part of the address map. This keeps the tag store,
+ * which is only allocated for the parts of the cache that are used, at
+ * two bytes per block.
+ */
+class DRAMCacheCtrl : public MemCtrl
+{
+  private:
+
+    class FarMemoryPort : public QueuedRequestPort
+    {
+      private:
+        ReqPacketQueue reqQueue;
+        SnoopRespPacketQueue snoopRespQueue;
+        DRAMCacheCtrl &ctrl;
+
+      public:
+        FarMemoryPort(const std::string &name, DRAMCacheCtrl &_ctrl);
+
+      protected:
+        bool recvTimingResp(PacketPtr pkt) override;
+    };
+
+    /** Port to the far memory */
+    FarMemoryPort farPort;
+
+    /** Address range cached */
+    const AddrRange range;
+    /** Cache block size (log2) */
+    const unsigned blockSizeLg2;
+    /** Number of sets (log2), one block each */
+    const unsigned setsLg2;
+
+    /** Requestor ID of fills, write-backs and far memory reads */
+    const RequestorID requestorId;
+
+    /**
+     * @{
+     * A tag store entry holds the tag of the block in bits 0-13, and
+     * the valid and dirty bits.
+     */
+    using TagEntry = uint16_t;
+    static constexpr TagEntry Valid = 1 << 15;
+    static constexpr TagEntry Dirty = 1 << 14;
+    static constexpr TagEntry TagMask = Dirty - 1;
+    /** @} */
+
+    /** Number of sets in a tag store chunk (log2) */
+    static constexpr unsigned chunkLg2 = 16;
+    /** Tag store, allocated a chunk at a time on first use */
+    std::vector<std::unique_ptr<TagEntry[]>> tagChunks;
+
+    /** Tag store entry of a set */
+    TagEntry &tagEntry(uint64_t set);
+
+    /** Set and tag of an address */
+    uint64_t
+    setOf(Addr addr) const
+    {
+        return (range.getOffset(addr) >> blockSizeLg2) & mask(setsLg2);
+    }
+
+    TagEntry
+    tagOf(Addr addr) const
+    {
+        return range.getOffset(addr) >> (blockSizeLg2 + setsLg2);
+    }
+
+    /** Address of the block cached in a set */
+    Addr blockAddr(uint64_t set, TagEntry entry) const;
+
+    /** Miss predictor counters, empty if there is no predictor */
+    std::vector<SatCounter8> predictor;
+
+    SatCounter8 &predictorEntry(PacketPtr pkt);
+
+    /** A read of a block from the far memory */
+    struct FarRead
+    {
+        /** The block arrived from the far memory */
+        bool done = false;
+        /** Reads that missed and wait for the block */
+        std::vector<PacketPtr> waiting;
+        /**
+         * Reads that started this far read ahead of their tag check
+         * and haven't been checked yet
+         */
+        unsigned predicted = 0;
+    };
+
+    /** Far memory reads in flight, keyed on block address */
+    std::unordered_map<Addr, FarRead> farReads;
+
+    /** Reads that started a far memory read ahead of their tag check */
+    std::unordered_set<PacketPtr> predictedMisses;
+
+    /** Start a far memory read of a block, if there is none yet */
+    FarRead &readFarBlock(Addr block_addr);
+
+    /** A packet of the controller itself for a block */
+    PacketPtr blockPacket(Addr block_addr, MemCmd cmd) const;
+
+    /**
+     * Make a block present in the cache, writing back the block it
+     * evicts if that is dirty.
+     *
+     * @param addr Address in the block
+     * @param dirty Whether the block is written
+     * @param fill Whether to time writing the block to the DRAM
+     */
+    void insertBlock(Addr addr, bool dirty, bool fill);
+
+    /** Read or write the data of a packet in the far memory */
+    void accessFarMemory(PacketPtr pkt);
+
+    /** Whether a packet goes to the far memory without being cached */
+    bool bypass(PacketPtr pkt) const;
+
+    bool isOwnPacket(PacketPtr pkt) const
+    {
+        return pkt->requestorId() == requestorId;
+    }
+
+    void recvFarTimingResp(PacketPtr pkt);
+
+    struct DRAMCacheStats : public statistics::Group
+    {
+        DRAMCacheStats(DRAMCacheCtrl &ctrl);
+
+        statistics::Scalar readHits;
+        statistics::Scalar readMisses;
+        statistics::Scalar writeHits;
+        statistics::Scalar writeMisses;
+        statistics::Formula hitRate;
+        /** Requests sent to the far memory without being cached */
+        statistics::Scalar bypasses;
+        /** Dirty blocks written back to the far memory */
+        statistics::Scalar writebacks;
+        /** Blocks written to the DRAM after a miss */
+        statistics::Scalar fills;
+        /** Fills not timed because the write queue was full */
+        statistics::Scalar droppedFills;
+        /** Far memory reads started ahead of the tag check */
+        statistics::Scalar predictedMisses;
+        /** Far memory reads started ahead of a tag check that hit */
+        statistics::Scalar wastedFarReads;
+        /** Misses predicted to hit, which read the far memory late */
+        statistics::Scalar unpredictedMisses;
+    } cacheStats;
+
+  protected:
+
+    Addr mediaAddr(Addr addr) const override;
+    void accessAndRespond(PacketPtr pkt, Tick static_latency,
+                          MemInterface* mem_intr) override;
+    AddrRangeList getAddrRanges() override;
+    bool allIntfDrained() const override;
+
+    Tick recvAtomic(PacketPtr pkt) override;
+    Tick recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor) override;
+    void recvFunctional(PacketPtr pkt) override;
+    void recvMemBackdoorReq(const MemBackdoorReq &req,
+                            MemBackdoorPtr &backdoor) override;
+    bool recvTimingReq(PacketPtr pkt) override;
+
+  public:
+
+    DRAMCacheCtrl(const DRAMCacheCtrlParams &p);
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    void init() override;
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif //__MEM_DRAM_CACHE_CTRL_HH__
@@ -59,116 +59,109 @@ namespace memory
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
-    std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
+    typedef MemPacketQueue::Entry Entry;
+
+    // The selection is equivalent to walking the queue in order:
+    // - the oldest row hit that can issue seamlessly wins outright,
+    // - otherwise the oldest packet to one of the earliest banks, when
+    //   that bank can be prepped without impacting utilization,
+    // - otherwise the oldest row hit that is prepped but not seamless,
+    // - and finally the oldest packet to one of the earliest banks.
+    // The per-bank index of the queue gives the oldest candidates of
+    // each bank, so only the banks have to be visited
+    const Entry *seamless_hit = nullptr;
+    const Entry *prepped_hit = nullptr;
+
+    // oldest packet of each bank that is not a row hit
+    std::vector<const Entry *> misses(ranksPerChannel * banksPerRank,
+                                      nullptr);
+    bool found_miss = false;
+
+    auto older = [](const Entry *entry, const Entry *than) {
+        return !than || entry->order < than->order;
+    };
 
-    // Has minBankPrep been called to populate earliest_banks?
-    bool filled_earliest_banks = false;
-    // can the PRE/ACT sequence be done without impacting utlization?
-    bool hidden_bank_prep = false;
+    for (int i = 0; i < ranksPerChannel; i++) {
+        // check if rank is not doing a refresh and thus is available,
+        // if not, none of its packets can be selected
+        if (!ranks[i]->inRefIdleState()) {
+            DPRINTF(DRAM, "%s Rank %d not available\n", __func__, i);
+            continue;
+        }
 
-    // search for seamless row hits first, if no seamless row hit is
-    // found then determine if there are other packets that can be issued
-    // without incurring additional bus delay due to bank timing
-    // Will select closed rows first to enable more open row possibilies
-    // in future selections
-    bool found_hidden_bank = false;
-
-    // remember if we found a row hit, not seamless, but bank prepped
-    // and ready
-    bool found_prepped_pkt = false;
-
-    // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
-
-    Tick selected_col_at = MaxTick;
-    auto selected_pkt_it = queue.end();
-
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        MemPacket* pkt = *i;
-
-        // select optimal DRAM packet in Q
-        if (pkt->isDram() && (pkt->pseudoChannel == pseudoChannel)) {
-            const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
-            const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
-                                                        bank.wrAllowedAt;
-
-            DPRINTF(DRAM, "%s checking DRAM packet in bank %d, row %d\n",
-                    __func__, pkt->bank, pkt->row);
-
-            // check if rank is not doing a refresh and thus is available,
-            // if not, jump to the next packet
-            if (burstReady(pkt)) {
-
-                DPRINTF(DRAM,
-                        "%s bank %d - Rank %d available\n", __func__,
-                        pkt->bank, pkt->rank);
-
-                // check if it is a row hit
-                if (bank.openRow == pkt->row) {
-                    // no additional rank-to-rank or same bank-group
-                    // delays, or we switched read/write and might as well
-                    // go for the row hit
-                    if (col_allowed_at <= min_col_at) {
-                        // FCFS within the hits, giving priority to
-                        // commands that can issue seamlessly, without
-                        // additional delay, such as same rank accesses
-                        // and/or different bank-group accesses
-                        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        // no need to look through the remaining queue entries
-                        break;
-                    } else if (!found_hidden_bank && !found_prepped_pkt) {
-                        // if we did not find a packet to a closed row that can
-                        // issue the bank commands without incurring delay, and
-                        // did not yet find a packet to a prepped row, remember
-                        // the current one
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        found_prepped_pkt = true;
-                        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
-                    }
-                } else if (!found_earliest_pkt) {
-                    // if we have not initialised the bank status, do it
-                    // now, and only once per scheduling decisions
-                    if (!filled_earliest_banks) {
-                        // determine entries with earliest bank delay
-                        std::tie(earliest_banks, hidden_bank_prep) =
-                            minBankPrep(queue, min_col_at);
-                        filled_earliest_banks = true;
-                    }
+        for (int j = 0; j < banksPerRank; j++) {
+            const auto *bank_queue =
+                queue.bankQueue(true, pseudoChannel, i, j);
+            if (!bank_queue || bank_queue->empty())
+                continue;
+
+            const Bank& bank = ranks[i]->banks[j];
+
+            if (const Entry *hit = bank_queue->oldest(bank.openRow)) {
+                const Tick col_allowed_at = hit->pkt->isRead() ?
+                    bank.rdAllowedAt : bank.wrAllowedAt;
+                // no additional rank-to-rank or same bank-group
+                // delays, or we switched read/write and might as well
+                // go for the row hit
+                const Entry *&selected = col_allowed_at <= min_col_at ?
+                    seamless_hit : prepped_hit;
+                if (older(hit, selected))
+                    selected = hit;
+            }
 
-                    // bank is amongst first available banks
-                    // minBankPrep will give priority to packets that can
-                    // issue seamlessly
-                    if (bits(earliest_banks[pkt->rank],
-                             pkt->bank, pkt->bank)) {
-                        found_earliest_pkt = true;
-                        found_hidden_bank = hidden_bank_prep;
-
-                        // give priority to packets that can issue
-                        // bank commands 'behind the scenes'
-                        // any additional delay if any will be due to
-                        // col-to-col command requirements
-                        if (hidden_bank_prep || !found_prepped_pkt) {
-                            selected_pkt_it = i;
-                            selected_col_at = col_allowed_at;
-                        }
-                    }
+            if (const Entry *miss = bank_queue->oldestExcept(bank.openRow)) {
+                misses[i * banksPerRank + j] = miss;
+                found_miss = true;
+            }
+        }
+    }
+
+    const Entry *selected = seamless_hit;
+    if (seamless_hit) {
+        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
+    } else if (found_miss) {
+        // determine entries with earliest bank delay, minBankPrep will
+        // give priority to packets that can issue seamlessly
+        std::vector<uint32_t> earliest_banks;
+        bool hidden_bank_prep;
+        std::tie(earliest_banks, hidden_bank_prep) =
+            minBankPrep(queue, min_col_at);
+
+        const Entry *earliest = nullptr;
+        for (int i = 0; i < ranksPerChannel; i++) {
+            for (int j = 0; j < banksPerRank; j++) {
+                const Entry *miss = misses[i * banksPerRank + j];
+                if (miss && bits(earliest_banks[i], j, j) &&
+                    older(miss, earliest)) {
+                    earliest = miss;
                 }
-            } else {
-                DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
-                        pkt->bank, pkt->rank);
             }
         }
+
+        // give priority to packets that can issue bank commands
+        // 'behind the scenes', any additional delay if any will be due
+        // to col-to-col command requirements
+        if (earliest && (hidden_bank_prep || !prepped_hit))
+            selected = earliest;
+        else
+            selected = prepped_hit;
+    } else {
+        selected = prepped_hit;
     }
 
-    if (selected_pkt_it == queue.end()) {
+    if (!selected) {
         DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+        return std::make_pair(queue.end(), MaxTick);
     }
 
-    return std::make_pair(selected_pkt_it, selected_col_at);
+    const MemPacket *pkt = selected->pkt;
+    const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
+    DPRINTF(DRAM, "%s selected DRAM packet in bank %d, row %d\n",
+            __func__, pkt->bank, pkt->row);
+
+    return std::make_pair(queue.find(*selected),
+                          pkt->isRead() ? bank.rdAllowedAt :
+                                          bank.wrAllowedAt);
 }
 
 void
@@ -508,32 +501,22 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
         bool got_bank_conflict = false;
 
         for (uint8_t i = 0; i < ctrl->numPriorities(); ++i) {
-            auto p = queue[i].begin();
-            // keep on looking until we find a hit or reach the end of the
-            // queue
             // 1) if a hit is found, then both open and close adaptive
             //    policies keep the page open
             // 2) if no hit is found, got_bank_conflict is set to true if a
             //    bank conflict request is waiting in the queue
             // 3) make sure we are not considering the packet that we are
             //    currently dealing with
-            while (!got_more_hits && p != queue[i].end()) {
-
-                if ((*p)->pseudoChannel != pseudoChannel) {
-                    // only consider if this pkt belongs to this interface
-                    ++p;
+            // Packets of any interface sharing the rank and bank count
+            for (bool dram : {true, false}) {
+                const auto *bank_queue = queue[i].bankQueue(
+                    dram, pseudoChannel, mem_pkt->rank, mem_pkt->bank);
+                if (!bank_queue)
                     continue;
-                }
 
-                if (mem_pkt != (*p)) {
-                    bool same_rank_bank = (mem_pkt->rank == (*p)->rank) &&
-                                          (mem_pkt->bank == (*p)->bank);
-
-                    bool same_row = mem_pkt->row == (*p)->row;
-                    got_more_hits |= same_rank_bank && same_row;
-                    got_bank_conflict |= same_rank_bank && !same_row;
-                }
-                ++p;
+                got_more_hits |= bank_queue->hasOther(mem_pkt->row, mem_pkt);
+                got_bank_conflict |=
+                    bank_queue->oldestExcept(mem_pkt->row) != nullptr;
             }
 
             if (got_more_hits)
@@ -1041,11 +1024,15 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     // determine if we have queued transactions targetting the
     // bank in question
     std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->pseudoChannel != pseudoChannel)
+    for (int i = 0; i < ranksPerChannel; i++) {
+        if (!ranks[i]->inRefIdleState())
             continue;
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
-            got_waiting[p->bankId] = true;
+        for (int j = 0; j < banksPerRank; j++) {
+            const auto *bank_queue =
+                queue.bankQueue(true, pseudoChannel, i, j);
+            got_waiting[i * banksPerRank + j] =
+                bank_queue && !bank_queue->empty();
+        }
     }
 
     // Find command with optimal bank timing
@@ -1413,8 +1400,9 @@ DRAMInterface::Rank::processRefreshEvent()
         // at the moment this affects all ranks
         cmdList.push_back(Command(MemCommand::REF, 0, curTick()));
 
-        // Update the stats
-        updatePowerStats();
+        // Keep the command lists short, the energy is calculated when the
+        // stats are needed
+        updatePowerCounters();
 
         DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(curTick(), dram.tCK) -
                 dram.timeStampOffset, rank);
@@ -1806,6 +1794,14 @@ DRAMInterface::Rank::updatePowerStats()
                     (sim_clock::Frequency / 1000000000.0);
 }
 
+void
+DRAMInterface::Rank::updatePowerCounters()
+{
+    flushCmdList();
+    power.powerlib.updateWindowCounters(divCeil(curTick(), dram.tCK) -
+                                        dram.timeStampOffset);
+}
+
 void
 DRAMInterface::Rank::computeStats()
 {
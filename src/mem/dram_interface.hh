@@ -261,6 +261,13 @@ class DRAMInterface : public MemInterface
          */
         void updatePowerStats();
 
+        /**
+         * Hand the completed commands to DRAMPower, which accounts for
+         * them in the counters of the current energy window. The energy
+         * of the window is only calculated by updatePowerStats().
+         */
+        void updatePowerCounters();
+
         /**
          * Schedule a power state transition in the future, and
          * potentially override an already scheduled transition.
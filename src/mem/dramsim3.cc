@@ -37,6 +37,8 @@
 
 #include "mem/dramsim3.hh"
 
+#include <algorithm>
+
 #include "base/callback.hh"
 #include "base/trace.hh"
 #include "debug/DRAMsim3.hh"
@@ -52,23 +54,36 @@ namespace memory
 DRAMsim3::DRAMsim3(const Params &p) :
     AbstractMemory(p),
     port(name() + ".port", *this),
-    read_cb(std::bind(&DRAMsim3::readComplete,
-                      this, 0, std::placeholders::_1)),
-    write_cb(std::bind(&DRAMsim3::writeComplete,
-                       this, 0, std::placeholders::_1)),
+    read_cb(std::bind(&DRAMsim3::transactionComplete,
+                      this, std::placeholders::_1, false)),
+    write_cb(std::bind(&DRAMsim3::transactionComplete,
+                       this, std::placeholders::_1, true)),
     wrapper(p.configFile, p.filePath, read_cb, write_cb),
     retryReq(false), retryResp(false), startTick(0),
     nbrOutstandingReads(0), nbrOutstandingWrites(0),
+    batchCycles(p.batch_cycles), cyclePeriod(0), nextCycleTick(0),
+    modelTick(0),
+    completionEvent([this]{ deliverCompletions(); }, name()),
     sendResponseEvent([this]{ sendResponse(); }, name()),
-    tickEvent([this]{ tick(); }, name())
+    // when batching, tick after everything else in the same tick so
+    // that nothing can send a request earlier than the next event
+    tickEvent([this]{ tick(); }, name(), false,
+              p.batch_cycles > 1 ? Event::Maximum_Pri : Event::Default_Pri)
 {
+    fatal_if(batchCycles == 0, "%s: batch_cycles must be at least 1\n",
+             name());
+
     DPRINTF(DRAMsim3,
             "Instantiated DRAMsim3 with clock %d ns and queue size %d\n",
             wrapper.clockPeriod(), wrapper.queueSize());
 
     // Register a callback to compensate for the destructor not
     // being called. The callback prints the DRAMsim3 stats.
-    registerExitCallback([this]() { wrapper.printStats(); });
+    registerExitCallback([this]() {
+        if (batchCycles > 1 && !tickEvent.scheduled())
+            catchUp();
+        wrapper.printStats();
+    });
 }
 
 void
@@ -91,13 +106,18 @@ void
 DRAMsim3::startup()
 {
     startTick = curTick();
+    cyclePeriod = wrapper.clockPeriod() * sim_clock::as_int::ns;
+    nextCycleTick = clockEdge();
 
     // kick off the clock ticks
-    schedule(tickEvent, clockEdge());
+    schedule(tickEvent, nextCycleTick);
 }
 
 void
 DRAMsim3::resetStats() {
+    // the skipped idle cycles belong to the stats being reset
+    if (batchCycles > 1 && !tickEvent.scheduled())
+        catchUp();
     wrapper.resetStats();
 }
 
@@ -120,6 +140,10 @@ DRAMsim3::sendResponse()
         if (!responseQueue.empty() && !sendResponseEvent.scheduled())
             schedule(sendResponseEvent, curTick());
 
+        // the retry is sent on the next cycle, so make sure there is one
+        if (retryReq && !tickEvent.scheduled())
+            wakeUp();
+
         if (nbrOutstanding() == 0)
             signalDrainDone();
     } else {
@@ -137,12 +161,62 @@ DRAMsim3::nbrOutstanding() const
     return nbrOutstandingReads + nbrOutstandingWrites + responseQueue.size();
 }
 
+void
+DRAMsim3::clockModel()
+{
+    modelTick = nextCycleTick;
+    nextCycleTick += cyclePeriod;
+    wrapper.tick();
+}
+
+void
+DRAMsim3::catchUp()
+{
+    assert(!tickEvent.scheduled());
+
+    // DRAMsim3 has no transactions, so the cycles it missed cannot
+    // complete anything, but they still refresh and count in its stats
+    while (nextCycleTick < curTick()) {
+        if (system()->isTimingMode())
+            clockModel();
+        else
+            nextCycleTick += cyclePeriod;
+    }
+}
+
+void
+DRAMsim3::wakeUp()
+{
+    catchUp();
+    schedule(tickEvent, nextCycleTick);
+}
+
 void
 DRAMsim3::tick()
 {
+    assert(nextCycleTick == curTick());
+
     // Only tick when it's timing mode
     if (system()->isTimingMode()) {
-        wrapper.tick();
+        clockModel();
+
+        // Requests can only come from events, and this is the last
+        // event of the tick, so run ahead up to the next event. Stop
+        // at the first completion, as responding may cause requests.
+        if (batchCycles > 1) {
+            Tick limit = curTick() + batchCycles * cyclePeriod;
+            if (!eventQueue()->empty())
+                limit = std::min(limit, eventQueue()->nextTick());
+            while (completions.empty() && nextCycleTick < limit)
+                clockModel();
+
+            if (!completions.empty()) {
+                if (modelTick == curTick())
+                    deliverCompletions();
+                else
+                    schedule(completionEvent, modelTick);
+            }
+        }
 
         // is the connected port waiting for a retry, if so check the
         // state and send a retry if conditions have changed
@@ -150,10 +224,14 @@ DRAMsim3::tick()
             retryReq = false;
             port.sendRetryReq();
         }
+    } else {
+        nextCycleTick += cyclePeriod;
     }
 
-    schedule(tickEvent,
-        curTick() + wrapper.clockPeriod() * sim_clock::as_int::ns);
+    // with batching, the clock is stopped while DRAMsim3 is idle and
+    // restarted by the next request
+    if (batchCycles == 1 || !modelIdle())
+        schedule(tickEvent, nextCycleTick);
 }
 
 Tick
@@ -230,6 +308,11 @@ DRAMsim3::recvTimingReq(PacketPtr pkt)
 
         DPRINTF(DRAMsim3, "Enqueueing address %lld\n", pkt->getAddr());
 
+        // catch up with the cycles skipped while idle before adding
+        // the transaction
+        if (!tickEvent.scheduled())
+            wakeUp();
+
         // @todo what about the granularity here, implicit assumption that
         // a transaction matches the burst size of the memory (which we
         // cannot determine without parsing the ini file ourselves)
@@ -289,6 +372,42 @@ DRAMsim3::accessAndRespond(PacketPtr pkt)
     }
 }
 
+void
+DRAMsim3::transactionComplete(Addr addr, bool is_write)
+{
+    // completions of a batch are delivered together, once gem5 has
+    // caught up with the cycle they happened in
+    if (batchCycles > 1) {
+        completions.push_back({addr, is_write});
+        return;
+    }
+
+    if (is_write)
+        writeComplete(0, addr);
+    else
+        readComplete(0, addr);
+}
+
+void
+DRAMsim3::deliverCompletions()
+{
+    DPRINTF(DRAMsim3, "Delivering %d completions\n", completions.size());
+
+    std::vector<Completion> batch;
+    batch.swap(completions);
+    for (const auto &c : batch) {
+        if (c.isWrite)
+            writeComplete(0, c.addr);
+        else
+            readComplete(0, c.addr);
+    }
+
+    if (retryReq && nbrOutstanding() < wrapper.queueSize()) {
+        retryReq = false;
+        port.sendRetryReq();
+    }
+}
+
 void DRAMsim3::readComplete(unsigned id, uint64_t addr)
 {
 
@@ -350,6 +469,10 @@ DRAMsim3::getPort(const std::string &if_name, PortID idx)
 DrainState
 DRAMsim3::drain()
 {
+    // bring DRAMsim3 up to date before the memory mode can change
+    if (batchCycles > 1 && !tickEvent.scheduled())
+        catchUp();
+
     // check our outstanding reads and writes and if any they need to
     // drain
     return nbrOutstanding() != 0 ? DrainState::Draining : DrainState::Drained;
@@ -46,6 +46,7 @@
 #include <functional>
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
 #include "mem/abstract_mem.hh"
 #include "mem/dramsim3_wrapper.hh"
@@ -144,9 +145,81 @@ class DRAMsim3 : public AbstractMemory
      */
     std::deque<PacketPtr> responseQueue;
 
+    /**
+     * Maximum number of DRAMsim3 cycles simulated per tick event. If
+     * more than one, DRAMsim3 is clocked in a loop up to the next
+     * event that could interact with it, and its completions are
+     * handed over in batches.
+     */
+    const unsigned int batchCycles;
+
+    /** Period of the DRAMsim3 clock in ticks */
+    Tick cyclePeriod;
+
+    /** Tick of the next DRAMsim3 cycle to simulate */
+    Tick nextCycleTick;
+
+    /** Tick of the DRAMsim3 cycle being simulated */
+    Tick modelTick;
+
+    /** A completed DRAMsim3 transaction */
+    struct Completion
+    {
+        Addr addr;
+        bool isWrite;
+    };
+
+    /**
+     * Completions of the cycle the batch stopped at, which are
+     * delivered once gem5 has caught up with that cycle.
+     */
+    std::vector<Completion> completions;
 
     unsigned int nbrOutstanding() const;
 
+    /**
+     * Callback for completions from DRAMsim3, which queues them when
+     * simulating a batch of cycles.
+     */
+    void transactionComplete(Addr addr, bool is_write);
+
+    /**
+     * Deliver the queued completions.
+     */
+    void deliverCompletions();
+
+    /**
+     * Event to deliver completions that DRAMsim3 produced ahead of gem5
+     */
+    EventFunctionWrapper completionEvent;
+
+    /**
+     * Simulate one DRAMsim3 cycle.
+     */
+    void clockModel();
+
+    /**
+     * Simulate the cycles that the DRAMsim3 clock skipped while the
+     * model was idle, up to the current tick.
+     */
+    void catchUp();
+
+    /**
+     * Catch up with the skipped cycles and restart the clock.
+     */
+    void wakeUp();
+
+    /**
+     * Check if DRAMsim3 can stop being clocked, as it has no
+     * transactions and we are not waiting to send a retry.
+     */
+    bool
+    modelIdle() const
+    {
+        return nbrOutstandingReads + nbrOutstandingWrites == 0 &&
+            completions.empty() && !retryReq;
+    }
+
     /**
      * When a packet is ready, use the "access()" method in
      * AbstractMemory to actually create the response packet, and send
@@ -164,7 +237,8 @@ class DRAMsim3 : public AbstractMemory
     EventFunctionWrapper sendResponseEvent;
 
     /**
-     * Progress the controller one clock cycle.
+     * Progress the controller one clock cycle, or a batch of cycles if
+     * batching is enabled.
      */
     void tick();
 
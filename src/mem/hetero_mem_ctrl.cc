@@ -40,6 +40,11 @@
 
 #include "mem/hetero_mem_ctrl.hh"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/DRAM.hh"
 #include "debug/Drain.hh"
@@ -59,7 +64,20 @@ namespace memory
 
 HeteroMemCtrl::HeteroMemCtrl(const HeteroMemCtrlParams &p) :
     MemCtrl(p),
-    nvm(p.nvm)
+    nvm(p.nvm),
+    pageSizeLg2(floorLog2(p.page_size)),
+    migrationInterval(p.migration_interval),
+    migrationTicksPerByte(p.migration_bandwidth),
+    hotThreshold(p.hot_threshold),
+    maxMigrations(p.max_migrations),
+    sampleInterval(p.sample_interval),
+    victimSamples(p.victim_samples),
+    sketch(p.sketch_width, p.sketch_depth),
+    accessesToSample(0),
+    copyEngineFreeAt(0),
+    migrationEvent([this] { processMigrationEvent(); }, name()),
+    migrationDoneEvent([this] { processMigrationDoneEvent(); }, name()),
+    tieringStats(*this)
 {
     DPRINTF(MemCtrl, "Setting up controller\n");
     readQueue.resize(p.qos_priorities);
@@ -85,6 +103,166 @@ HeteroMemCtrl::HeteroMemCtrl(const HeteroMemCtrlParams &p) :
         fatal("Write buffer low threshold %d must be smaller than the "
               "high threshold %d\n", p.write_low_thresh_perc,
               p.write_high_thresh_perc);
+
+    if (migrationInterval) {
+        fatal_if(!isPowerOf2(p.page_size),
+                 "HeteroMemCtrl's page size must be a power of 2.\n");
+        fatal_if(p.sample_interval == 0,
+                 "HeteroMemCtrl's sample interval must be at least 1.\n");
+        for (MemInterface *mem_intr : {(MemInterface *)dram,
+                                       (MemInterface *)nvm}) {
+            const AddrRange &range = mem_intr->getAddrRange();
+            fatal_if(range.interleaved(), "HeteroMemCtrl can't migrate "
+                     "pages of the interleaved range %s.\n",
+                     range.to_string());
+            fatal_if((range.start() | range.size()) & mask(pageSizeLg2),
+                     "HeteroMemCtrl's range %s isn't page aligned.\n",
+                     range.to_string());
+        }
+    }
+}
+
+void
+HeteroMemCtrl::startup()
+{
+    MemCtrl::startup();
+
+    if (migrationInterval && isTimingMode && !migrationEvent.scheduled())
+        schedule(migrationEvent, curTick() + migrationInterval);
+}
+
+Addr
+HeteroMemCtrl::mediaAddr(Addr addr) const
+{
+    if (toMedia.empty())
+        return addr;
+    const Addr media_page = mediaPage(addr >> pageSizeLg2);
+    return (media_page << pageSizeLg2) | (addr & mask(pageSizeLg2));
+}
+
+void
+HeteroMemCtrl::remap(Addr page, Addr media_page)
+{
+    if (page == media_page) {
+        toMedia.erase(page);
+        toAddr.erase(media_page);
+    } else {
+        toMedia[page] = media_page;
+        toAddr[media_page] = page;
+    }
+}
+
+void
+HeteroMemCtrl::sampleAccess(Addr addr)
+{
+    if (!migrationInterval || ++accessesToSample < sampleInterval)
+        return;
+    accessesToSample = 0;
+
+    const Addr page = addr >> pageSizeLg2;
+    const unsigned count = sketch.add(page);
+    const bool in_dram =
+        dram->getAddrRange().contains(mediaPage(page) << pageSizeLg2);
+    if (count >= hotThreshold && !in_dram && hotPages.insert(page).second)
+        tieringStats.hotPages++;
+}
+
+Addr
+HeteroMemCtrl::findVictim(unsigned hot_count)
+{
+    const AddrRange &range = dram->getAddrRange();
+    const Addr first_page = range.start() >> pageSizeLg2;
+    const Addr num_pages = range.size() >> pageSizeLg2;
+
+    // Pick the coldest of a few random DRAM pages, which is much
+    // cheaper than keeping the DRAM pages ordered by hotness
+    Addr victim = MaxAddr;
+    unsigned victim_count = hot_count;
+    for (unsigned i = 0; i < victimSamples; i++) {
+        const Addr media_page =
+            first_page + rng->random<Addr>(0, num_pages - 1);
+        const Addr page = addrPage(media_page);
+        if (migrating.count(page))
+            continue;
+        const unsigned count = sketch.estimate(page);
+        if (count < victim_count) {
+            victim = page;
+            victim_count = count;
+        }
+    }
+    return victim;
+}
+
+void
+HeteroMemCtrl::processMigrationEvent()
+{
+    // Migrate the hottest pages first
+    std::vector<std::pair<unsigned, Addr>> hot;
+    for (Addr page : hotPages) {
+        if (!migrating.count(page))
+            hot.emplace_back(sketch.estimate(page), page);
+    }
+    std::sort(hot.begin(), hot.end(), std::greater<>());
+
+    const Tick copy_time = std::ceil(2 * (Addr(1) << pageSizeLg2) *
+                                     migrationTicksPerByte);
+    unsigned started = 0;
+    for (auto [count, page] : hot) {
+        if (started == maxMigrations)
+            break;
+
+        const Addr victim = findVictim(count);
+        if (victim == MaxAddr) {
+            tieringStats.noVictim++;
+            continue;
+        }
+
+        // Swaps are copied one after the other by the copy engine
+        copyEngineFreeAt = std::max(copyEngineFreeAt, curTick()) + copy_time;
+        migrations.push_back({page, victim, curTick(), copyEngineFreeAt});
+        migrating.insert(page);
+        migrating.insert(victim);
+        started++;
+
+        DPRINTF(MemCtrl, "Migrating page %#x (%d accesses) to DRAM, "
+                "page %#x (%d accesses) to NVM, done at %d\n",
+                page << pageSizeLg2, count, victim << pageSizeLg2,
+                sketch.estimate(victim), copyEngineFreeAt);
+    }
+
+    if (!migrations.empty() && !migrationDoneEvent.scheduled())
+        schedule(migrationDoneEvent, migrations.front().done);
+
+    // Age the counts so that the next interval sees recent hotness
+    hotPages.clear();
+    sketch.decay();
+
+    schedule(migrationEvent, curTick() + migrationInterval);
+}
+
+void
+HeteroMemCtrl::processMigrationDoneEvent()
+{
+    while (!migrations.empty() && migrations.front().done <= curTick()) {
+        const Migration &m = migrations.front();
+
+        // Swap the media pages of the two pages
+        const Addr hot_media = mediaPage(m.hot);
+        const Addr cold_media = mediaPage(m.cold);
+        remap(m.hot, cold_media);
+        remap(m.cold, hot_media);
+        migrating.erase(m.hot);
+        migrating.erase(m.cold);
+
+        tieringStats.migrations++;
+        tieringStats.migratedBytes += 2 * (Addr(1) << pageSizeLg2);
+        tieringStats.migrationLatency.sample(curTick() - m.start);
+
+        migrations.pop_front();
+    }
+
+    if (!migrations.empty())
+        schedule(migrationDoneEvent, migrations.front().done);
 }
 
 Tick
@@ -122,11 +300,16 @@ HeteroMemCtrl::recvTimingReq(PacketPtr pkt)
     }
     prevArrival = curTick();
 
+    panic_if(migrationInterval && (pkt->getAddr() >> pageSizeLg2) !=
+             ((pkt->getAddr() + pkt->getSize() - 1) >> pageSizeLg2),
+             "Packet %s crosses a migration page boundary\n", pkt->print());
+
     // What type of media does this packet access?
+    const Addr media_addr = mediaAddr(pkt->getAddr());
     bool is_dram;
-    if (dram->getAddrRange().contains(pkt->getAddr())) {
+    if (dram->getAddrRange().contains(media_addr)) {
         is_dram = true;
-    } else if (nvm->getAddrRange().contains(pkt->getAddr())) {
+    } else if (nvm->getAddrRange().contains(media_addr)) {
         is_dram = false;
     } else {
         panic("Can't handle address range for packet %s\n",
@@ -189,12 +372,29 @@ HeteroMemCtrl::recvTimingReq(PacketPtr pkt)
         }
     }
 
+    sampleAccess(pkt->getAddr());
+    if (is_dram)
+        tieringStats.dramAccesses++;
+    else
+        tieringStats.nvmAccesses++;
+
     return true;
 }
 
+void
+HeteroMemCtrl::accessAndRespond(PacketPtr pkt, Tick static_latency,
+                                MemInterface* mem_intr)
+{
+    // The data stays with the memory that owns the address, whichever
+    // media the access was timed on
+    MemInterface *owner =
+        dram->getAddrRange().contains(pkt->getAddr()) ? dram : nvm;
+    MemCtrl::accessAndRespond(pkt, static_latency, owner);
+}
+
 void
 HeteroMemCtrl::processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req)
 {
@@ -450,6 +650,8 @@ HeteroMemCtrl::drainResume()
         // if we switch from timing mode, stop the refresh events to
         // not cause issues with KVM
         dram->suspend();
+        if (migrationEvent.scheduled())
+            deschedule(migrationEvent);
     }
 
     // update the mode
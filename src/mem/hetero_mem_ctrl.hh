@@ -46,6 +46,14 @@
 #ifndef __HETERO_MEM_CTRL_HH__
 #define __HETERO_MEM_CTRL_HH__
 
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "base/count_min_sketch.hh"
+#include "base/random.hh"
+#include "base/statistics.hh"
 #include "mem/mem_ctrl.hh"
 #include "params/HeteroMemCtrl.hh"
 
@@ -54,6 +62,22 @@ namespace gem5
 
 namespace memory
 {
+
+/**
+ * A controller for a DRAM and an NVM interface sharing a channel.
+ *
+ * Optionally, the controller migrates hot pages from NVM to DRAM. Page
+ * accesses are sampled into a Count-Min sketch, and at the end of each
+ * migration interval the hottest NVM pages are swapped with colder
+ * DRAM pages. A swap occupies a copy engine of limited bandwidth and
+ * takes effect when the copy completes. From then on, accesses to the
+ * two pages are timed on the media they were moved to, through the
+ * remapping table of the controller.
+ *
+ * Only the timing of the accesses follows the remapping. The data
+ * stays in the backing store of the memory that owns the address, so
+ * functional and atomic accesses are not affected.
+ */
 class HeteroMemCtrl : public MemCtrl
 {
   private:
@@ -62,6 +86,115 @@ class HeteroMemCtrl : public MemCtrl
      * Create pointer to interface of the actual nvm media when connected.
      */
     NVMInterface* nvm;
+
+    /** Page size the migration works at (log2) */
+    const unsigned pageSizeLg2;
+    /** Length of a migration interval, 0 if migration is disabled */
+    const Tick migrationInterval;
+    /** Time the copy engine takes per byte copied */
+    const double migrationTicksPerByte;
+    /** Sampled accesses after which an NVM page is a candidate */
+    const unsigned hotThreshold;
+    /** Maximum number of page swaps started per interval */
+    const unsigned maxMigrations;
+    /** One in this many accesses is counted */
+    const unsigned sampleInterval;
+    /** Number of DRAM pages sampled when looking for a victim */
+    const unsigned victimSamples;
+
+    /** Page access counts, keyed on the page number of the address */
+    CountMinSketch<uint16_t> sketch;
+    /** Accesses since the last sampled one */
+    unsigned accessesToSample;
+    /** NVM pages that became hot in the current interval */
+    std::unordered_set<Addr> hotPages;
+
+    /**
+     * @{
+     * Remapping table between address pages and media pages, as page
+     * numbers. Pages that were never moved are not in the table.
+     */
+    std::unordered_map<Addr, Addr> toMedia;
+    std::unordered_map<Addr, Addr> toAddr;
+    /** @} */
+
+    struct Migration
+    {
+        /** Pages swapped, as address page numbers */
+        Addr hot;
+        Addr cold;
+        /** When the swap was started */
+        Tick start;
+        /** When the copy completes */
+        Tick done;
+    };
+    /** Swaps in flight on the copy engine, in completion order */
+    std::deque<Migration> migrations;
+    /** Pages of the swaps in flight */
+    std::unordered_set<Addr> migrating;
+    /** When the copy engine is done with the swaps in flight */
+    Tick copyEngineFreeAt;
+
+    Random::RandomPtr rng = Random::genRandom();
+
+    void processMigrationEvent();
+    EventFunctionWrapper migrationEvent;
+
+    void processMigrationDoneEvent();
+    EventFunctionWrapper migrationDoneEvent;
+
+    /** Media page of an address page */
+    Addr
+    mediaPage(Addr page) const
+    {
+        auto it = toMedia.find(page);
+        return it == toMedia.end() ? page : it->second;
+    }
+
+    /** Address page stored in a media page */
+    Addr
+    addrPage(Addr media_page) const
+    {
+        auto it = toAddr.find(media_page);
+        return it == toAddr.end() ? media_page : it->second;
+    }
+
+    /** Set the media page of an address page */
+    void remap(Addr page, Addr media_page);
+
+    /** Count an access to an address for the hot page tracking */
+    void sampleAccess(Addr addr);
+
+    /**
+     * Find a DRAM page that is colder than a hot page.
+     *
+     * @param hot_count Estimated accesses of the hot page
+     * @return The address page stored in a cold DRAM page, or MaxAddr
+     */
+    Addr findVictim(unsigned hot_count);
+
+    struct TieringStats : public statistics::Group
+    {
+        TieringStats(HeteroMemCtrl &ctrl);
+
+        /** Accesses served by each media */
+        statistics::Scalar dramAccesses;
+        statistics::Scalar nvmAccesses;
+        /** NVM pages that became hot */
+        statistics::Scalar hotPages;
+        /** Page swaps completed */
+        statistics::Scalar migrations;
+        /** Hot pages not migrated because no colder DRAM page was found */
+        statistics::Scalar noVictim;
+        /** Bytes copied by the copy engine */
+        statistics::Scalar migratedBytes;
+        /** Time from starting a swap to its completion */
+        statistics::Histogram migrationLatency;
+    } tieringStats;
+
+    Addr mediaAddr(Addr addr) const override;
+    void accessAndRespond(PacketPtr pkt, Tick static_latency,
+                          MemInterface* mem_intr) override;
     MemPacketQueue::iterator chooseNext(MemPacketQueue& queue,
                       Tick extra_col_delay, MemInterface* mem_int) override;
     virtual std::pair<MemPacketQueue::iterator, Tick>
@@ -94,7 +227,7 @@ class HeteroMemCtrl : public MemCtrl
     pktSizeCheck(MemPacket* mem_pkt, MemInterface* mem_intr) const override;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req) override;
 
@@ -125,6 +258,8 @@ class HeteroMemCtrl : public MemCtrl
 
     HeteroMemCtrl(const HeteroMemCtrlParams &p);
 
+    void startup() override;
+
     bool allIntfDrained() const override;
     DrainState drain() override;
     void drainResume() override;
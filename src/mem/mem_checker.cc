@@ -224,7 +224,7 @@ MemChecker::ByteTracker::inExpectedData(Tick start, Tick complete,
 
 bool
 MemChecker::ByteTracker::completeRead(MemChecker::Serial serial,
-                                      Tick complete, uint8_t data)
+                                      Tick complete, uint8_t data, bool prune)
 {
     auto it = outstandingReads.find(serial);
 
@@ -242,7 +242,8 @@ MemChecker::ByteTracker::completeRead(MemChecker::Serial serial,
     const bool result = inExpectedData(start, complete, data);
 
     readObservations.emplace_back(serial, start, complete, data);
-    pruneTransactions();
+    if (prune)
+        pruneTransactions();
 
     return result;
 }
@@ -266,10 +267,11 @@ MemChecker::ByteTracker::startWrite(MemChecker::Serial serial, Tick start,
 
 void
 MemChecker::ByteTracker::completeWrite(MemChecker::Serial serial,
-    Tick complete)
+    Tick complete, bool prune)
 {
     getIncompleteWriteCluster()->completeWrite(serial, complete);
-    pruneTransactions();
+    if (prune)
+        pruneTransactions();
 }
 
 void
@@ -308,10 +310,17 @@ MemChecker::completeRead(MemChecker::Serial serial, Tick complete,
             "completing read: serial = %d, complete = %d, "
             "addr = %#llx, size = %d\n", serial, complete, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        ByteTracker *tracker = getByteTracker(addr + i);
+    LineTracker *last_line = nullptr;
+    bool prune = false;
+    forEachByte(addr, size, [&](LineTracker &line, Addr byte_addr,
+                                unsigned offset, size_t i) {
+        if (&line != last_line) {
+            last_line = &line;
+            prune = prunePending(line);
+        }
+        ByteTracker *tracker = line.getByteTracker(byte_addr, offset, this);
 
-        if (!tracker->completeRead(serial, complete, data[i])) {
+        if (!tracker->completeRead(serial, complete, data[i], prune)) {
             // Generate error message, and aggregate all failures for the bytes
             // considered in this transaction in one message.
             if (result) {
@@ -323,7 +332,7 @@ MemChecker::completeRead(MemChecker::Serial serial, Tick complete,
 
             errorMessage += csprintf("  Read transaction for address %#llx "
                                      "failed: received %#x, expected ",
-                                     (unsigned long long)(addr + i), data[i]);
+                                     (unsigned long long)byte_addr, data[i]);
 
             for (size_t j = 0; j < tracker->lastExpectedData().size(); ++j) {
                 errorMessage +=
@@ -333,7 +342,7 @@ MemChecker::completeRead(MemChecker::Serial serial, Tick complete,
                              ? "" : "|");
             }
         }
-    }
+    });
 
     if (!result) {
         DPRINTF(MemChecker, "read of %#llx @ cycle %d failed:\n%s\n", addr,
@@ -346,8 +355,18 @@ MemChecker::completeRead(MemChecker::Serial serial, Tick complete,
 void
 MemChecker::reset(Addr addr, size_t size)
 {
-    for (size_t i = 0; i < size; ++i) {
-        byte_trackers.erase(addr + i);
+    for (size_t i = 0; i < size; ) {
+        const Addr line_addr = roundDown(addr + i, lineSize);
+        const size_t end = std::min<size_t>(size,
+                                            line_addr + lineSize - addr);
+        auto it = line_trackers.find(line_addr);
+        if (it != line_trackers.end()) {
+            for (; i < end; ++i)
+                it->second.reset((addr + i) - line_addr);
+            if (it->second.empty())
+                line_trackers.erase(it);
+        }
+        i = end;
     }
 }
 
@@ -38,20 +38,27 @@
 #ifndef __MEM_MEM_CHECKER_HH__
 #define __MEM_MEM_CHECKER_HH__
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "base/cprintf.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
 #include "base/types.hh"
 #include "debug/MemChecker.hh"
 #include "params/MemChecker.hh"
+#include "sim/cur_tick.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -70,6 +77,11 @@ namespace gem5
  * on the particular location, and we do not consider the effect of multi-byte
  * reads or writes. This precludes us from discovering single-copy atomicity
  * violations.
+ *
+ * The per-byte state is kept in line-sized groups, so that an access costs a
+ * single lookup per line it touches. To keep the checker affordable in long
+ * runs, pruning of completed transactions can be limited to once per
+ * interval, and only a sample of the lines can be tracked.
 */
 class MemChecker : public SimObject
 {
@@ -258,8 +270,10 @@ class MemChecker : public SimObject
          * @param serial   Unique identifier of a read *previously started*.
          * @param complete When the read got a response.
          * @param data     The data returned by the memory subsystem.
+         * @param prune    Prune completed transactions afterwards.
          */
-        bool completeRead(Serial serial, Tick complete, uint8_t data);
+        bool completeRead(Serial serial, Tick complete, uint8_t data,
+                          bool prune = true);
 
         /**
          * Starts a write transaction. Wrapper to startWrite of WriteCluster
@@ -278,8 +292,9 @@ class MemChecker : public SimObject
          *
          * @param serial   Unique identifier of a write *previously started*.
          * @param complete When the write was sent off to the memory subsystem.
+         * @param prune    Prune completed transactions afterwards.
          */
-        void completeWrite(Serial serial, Tick complete);
+        void completeWrite(Serial serial, Tick complete, bool prune = true);
 
         /**
          * Aborts a write transaction. Wrapper to abortWrite of WriteCluster
@@ -301,6 +316,17 @@ class MemChecker : public SimObject
         const std::vector<uint8_t>& lastExpectedData() const
         { return _lastExpectedData; }
 
+        /**
+         * Prunes no longer needed transactions. We only keep up to the last /
+         * most recent of each, readObservations and writeClusters, before the
+         * first outstanding read.
+         *
+         * It depends on the contention / overlap between memory operations to
+         * the same location of a particular workload how large each of them
+         * would grow.
+         */
+        void pruneTransactions();
+
       private:
 
         /**
@@ -335,17 +361,6 @@ class MemChecker : public SimObject
             return it;
         }
 
-        /**
-         * Prunes no longer needed transactions. We only keep up to the last /
-         * most recent of each, readObservations and writeClusters, before the
-         * first outstanding read.
-         *
-         * It depends on the contention / overlap between memory operations to
-         * the same location of a particular workload how large each of them
-         * would grow.
-         */
-        void pruneTransactions();
-
       private:
 
         /**
@@ -372,12 +387,80 @@ class MemChecker : public SimObject
         std::vector<uint8_t> _lastExpectedData;
     };
 
+    /** Largest supported line size, the width of the validity mask */
+    static const unsigned MAX_LINE_SIZE = 64;
+
+    /**
+     * The LineTracker groups the ByteTrackers of one line. A validity mask
+     * records which bytes of the line are being tracked; the others have not
+     * been accessed since the line was created or reset.
+     */
+    class LineTracker
+    {
+      public:
+        LineTracker() : valid(0), lastPrune(TICK_INITIAL) {}
+
+        /**
+         * Returns the ByteTracker for a byte of the line, creating it if the
+         * byte is not being tracked yet.
+         *
+         * @param addr   Address of the byte.
+         * @param offset Offset of the byte in the line.
+         * @param parent MemChecker the tracker belongs to.
+         */
+        ByteTracker*
+        getByteTracker(Addr addr, unsigned offset, const MemChecker *parent)
+        {
+            if (!bits(valid, offset)) {
+                bytes[offset].reset(new ByteTracker(addr, parent));
+                valid |= mask(1) << offset;
+            }
+            return bytes[offset].get();
+        }
+
+        /**
+         * Stops tracking a byte of the line.
+         *
+         * @param offset Offset of the byte in the line.
+         */
+        void
+        reset(unsigned offset)
+        {
+            bytes[offset].reset();
+            valid &= ~(mask(1) << offset);
+        }
+
+        /**
+         * @return true if no byte of this line is being tracked.
+         */
+        bool empty() const { return valid == 0; }
+
+      public:
+        /** Mask of the bytes of the line that are being tracked */
+        uint64_t valid;
+
+        /** Last time the transactions of this line were pruned */
+        Tick lastPrune;
+
+      private:
+        std::array<std::unique_ptr<ByteTracker>, MAX_LINE_SIZE> bytes;
+    };
+
   public:
 
     MemChecker(const MemCheckerParams &p)
         : SimObject(p),
+          lineSize(p.line_size),
+          pruneInterval(p.prune_interval),
+          samplePeriod(p.sample_period),
           nextSerial(SERIAL_INITIAL)
-    {}
+    {
+        fatal_if(!isPowerOf2(lineSize) || lineSize > MAX_LINE_SIZE,
+                 "%s: line_size must be a power of 2 of at most %d bytes",
+                 name(), MAX_LINE_SIZE);
+        fatal_if(samplePeriod == 0, "%s: sample_period must not be 0",
+                 name());
+    }
 
     virtual ~MemChecker() {}
 
@@ -452,7 +535,7 @@ class MemChecker : public SimObject
      * the reset with serial S.
      */
     void reset()
-    { byte_trackers.clear(); }
+    { line_trackers.clear(); }
 
     /**
      * Resets an address-range. This may be useful in case other unmonitored
@@ -477,19 +560,63 @@ class MemChecker : public SimObject
 
   private:
     /**
-     * Returns the instance of ByteTracker for the requested location.
+     * Calls fn(line_tracker, addr, offset, index) for each byte of an access
+     * that falls into a sampled line, where index is the position of the
+     * byte in the access. The line lookup is done once per line.
      */
-    ByteTracker* getByteTracker(Addr addr)
+    template <typename Fn>
+    void forEachByte(Addr addr, size_t size, Fn fn)
     {
-        auto it = byte_trackers.find(addr);
-        if (it == byte_trackers.end()) {
-            it = byte_trackers.insert(
-                std::make_pair(addr, ByteTracker(addr, this))).first;
+        size_t i = 0;
+        while (i < size) {
+            const Addr line_addr = roundDown(addr + i, lineSize);
+            const size_t end = std::min<size_t>(size,
+                                                line_addr + lineSize - addr);
+            if (isSampled(line_addr)) {
+                LineTracker &line = line_trackers[line_addr];
+                for (; i < end; ++i)
+                    fn(line, addr + i, (addr + i) - line_addr, i);
+            } else {
+                i = end;
+            }
         }
-        return &it->second;
-    };
+    }
+
+    /**
+     * Returns true if the line starting at line_addr is checked. The lines
+     * are sampled with a hash of their address, so that strided access
+     * patterns do not all fall into or out of the sample.
+     */
+    bool isSampled(Addr line_addr) const
+    {
+        if (samplePeriod == 1)
+            return true;
+        const uint64_t line = line_addr / lineSize;
+        return ((line * 0x9e3779b97f4a7c15ULL) >> 32) % samplePeriod == 0;
+    }
+
+    /**
+     * Returns true if the transactions in a line are due to be pruned, and
+     * if so, restarts the interval.
+     */
+    bool prunePending(LineTracker &line)
+    {
+        if (curTick() < line.lastPrune + pruneInterval)
+            return false;
+        line.lastPrune = curTick();
+        return true;
+    }
 
   private:
+    /** Size of the lines in which bytes are grouped */
+    const unsigned lineSize;
+
+    /** Minimum number of ticks between two prunings of a line */
+    const Tick pruneInterval;
+
+    /** One line out of samplePeriod is checked */
+    const unsigned samplePeriod;
+
     /**
      * Detailed error message of the last violation in completeRead.
      */
@@ -502,7 +629,7 @@ class MemChecker : public SimObject
     Serial nextSerial;
 
     /**
-     * Maintain a map of address --> byte-tracker. Per-byte entries are
+     * Maintain a map of line address --> line-tracker. Per-byte entries are
      * initialized as needed.
      *
      * The required space for this obviously grows with the number of distinct
@@ -510,9 +637,9 @@ class MemChecker : public SimObject
      * the number of nodes in the system, those may affect the size of per-byte
      * tracking information.
      *
-     * Access via getByteTracker()!
+     * Access via forEachByte()!
      */
-    std::unordered_map<Addr, ByteTracker> byte_trackers;
+    std::unordered_map<Addr, LineTracker> line_trackers;
 };
 
 inline MemChecker::Serial
@@ -522,9 +649,11 @@ MemChecker::startRead(Tick start, Addr addr, size_t size)
             "starting read: serial = %d, start = %d, addr = %#llx, "
             "size = %d\n", nextSerial, start, addr , size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->startRead(nextSerial, start);
-    }
+    forEachByte(addr, size, [&](LineTracker &line, Addr byte_addr,
+                                unsigned offset, size_t) {
+        line.getByteTracker(byte_addr, offset, this)->startRead(nextSerial,
+                                                                start);
+    });
 
     return nextSerial++;
 }
@@ -536,9 +665,12 @@ MemChecker::startWrite(Tick start, Addr addr, size_t size, const uint8_t *data)
             "starting write: serial = %d, start = %d, addr = %#llx, "
             "size = %d\n", nextSerial, start, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->startWrite(nextSerial, start, data[i]);
-    }
+    forEachByte(addr, size, [&](LineTracker &line, Addr byte_addr,
+                                unsigned offset, size_t i) {
+        line.getByteTracker(byte_addr, offset, this)->startWrite(nextSerial,
+                                                                 start,
+                                                                 data[i]);
+    });
 
     return nextSerial++;
 }
@@ -551,9 +683,17 @@ MemChecker::completeWrite(MemChecker::Serial serial, Tick complete,
             "completing write: serial = %d, complete = %d, "
             "addr = %#llx, size = %d\n", serial, complete, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->completeWrite(serial, complete);
-    }
+    LineTracker *last_line = nullptr;
+    bool prune = false;
+    forEachByte(addr, size, [&](LineTracker &line, Addr byte_addr,
+                                unsigned offset, size_t) {
+        if (&line != last_line) {
+            last_line = &line;
+            prune = prunePending(line);
+        }
+        line.getByteTracker(byte_addr, offset, this)->completeWrite(
+                serial, complete, prune);
+    });
 }
 
 inline void
@@ -563,9 +703,10 @@ MemChecker::abortWrite(MemChecker::Serial serial, Addr addr, size_t size)
             "aborting write: serial = %d, addr = %#llx, size = %d\n",
             serial, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->abortWrite(serial);
-    }
+    forEachByte(addr, size, [&](LineTracker &line, Addr byte_addr,
+                                unsigned offset, size_t) {
+        line.getByteTracker(byte_addr, offset, this)->abortWrite(serial);
+    });
 }
 
 } // namespace gem5
@@ -40,6 +40,8 @@
 
 #include "mem/mem_ctrl.hh"
 
+#include <algorithm>
+
 #include "base/trace.hh"
 #include "debug/DRAM.hh"
 #include "debug/Drain.hh"
@@ -57,6 +59,96 @@ namespace gem5
 namespace memory
 {
 
+const MemPacketQueue::Entry *
+MemPacketQueue::BankQueue::oldest(uint32_t row) const
+{
+    auto it = rows.find(row);
+    return it == rows.end() ? nullptr : &it->second.front();
+}
+
+const MemPacketQueue::Entry *
+MemPacketQueue::BankQueue::oldestExcept(uint32_t row) const
+{
+    // Only the oldest of all rows can be to the excluded row
+    for (auto it = fronts.begin(); it != fronts.end(); ++it) {
+        if (it->second != row)
+            return &rows.at(it->second).front();
+    }
+    return nullptr;
+}
+
+bool
+MemPacketQueue::BankQueue::hasOther(uint32_t row, const MemPacket *pkt) const
+{
+    auto it = rows.find(row);
+    if (it == rows.end())
+        return false;
+    return it->second.size() > 1 || it->second.front().pkt != pkt;
+}
+
+void
+MemPacketQueue::push_back(MemPacket *pkt)
+{
+    const uint64_t order = nextOrder++;
+    packets.push_back(pkt);
+    orders.push_back(order);
+
+    BankQueue &bank_queue =
+        banks[bankKey(pkt->isDram(), pkt->pseudoChannel, pkt->rank,
+                      pkt->bank)];
+    auto &row = bank_queue.rows[pkt->row];
+    if (row.empty())
+        bank_queue.fronts.emplace(order, pkt->row);
+    row.push_back({order, pkt});
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::erase(iterator it)
+{
+    const auto idx = it - packets.begin();
+    const uint64_t order = orders[idx];
+    MemPacket *pkt = *it;
+
+    BankQueue &bank_queue =
+        banks.at(bankKey(pkt->isDram(), pkt->pseudoChannel, pkt->rank,
+                         pkt->bank));
+    auto row_it = bank_queue.rows.find(pkt->row);
+    assert(row_it != bank_queue.rows.end());
+    auto &row = row_it->second;
+    if (row.front().order == order) {
+        bank_queue.fronts.erase({order, pkt->row});
+        row.pop_front();
+        if (row.empty())
+            bank_queue.rows.erase(row_it);
+        else
+            bank_queue.fronts.emplace(row.front().order, pkt->row);
+    } else {
+        auto entry = std::find_if(row.begin(), row.end(),
+            [order](const Entry &e) { return e.order == order; });
+        assert(entry != row.end());
+        row.erase(entry);
+    }
+
+    orders.erase(orders.begin() + idx);
+    return packets.erase(it);
+}
+
+const MemPacketQueue::BankQueue *
+MemPacketQueue::bankQueue(bool dram, uint8_t pseudo_channel, uint8_t rank,
+                          uint8_t bank) const
+{
+    auto it = banks.find(bankKey(dram, pseudo_channel, rank, bank));
+    return it == banks.end() ? nullptr : &it->second;
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::find(const Entry &entry)
+{
+    auto it = std::lower_bound(orders.begin(), orders.end(), entry.order);
+    assert(it != orders.end() && *it == entry.order);
+    return packets.begin() + (it - orders.begin());
+}
+
 MemCtrl::MemCtrl(const MemCtrlParams &p) :
     qos::MemCtrl(p),
     port(name() + ".port", *this), isTimingMode(false),
@@ -72,6 +164,7 @@ MemCtrl::MemCtrl(const MemCtrlParams &p) :
     writeLowThreshold(writeBufferSize * p.write_low_thresh_perc / 100.0),
     minWritesPerSwitch(p.min_writes_per_switch),
     minReadsPerSwitch(p.min_reads_per_switch),
+    coalesceBursts(p.coalesce_bursts),
     memSchedPolicy(p.mem_sched_policy),
     frontendLatency(p.static_frontend_latency),
     backendLatency(p.static_backend_latency),
@@ -201,7 +294,7 @@ MemCtrl::addToReadQueue(PacketPtr pkt,
     // address of first packet is kept unaliged. Subsequent packets
     // are aligned to burst size boundaries. This is to ensure we accurately
     // check read packets against packets in write queue.
-    const Addr base_addr = pkt->getAddr();
+    const Addr base_addr = mediaAddr(pkt->getAddr());
     Addr addr = base_addr;
     unsigned pktsServicedByWrQ = 0;
     BurstHelper* burst_helper = NULL;
@@ -310,7 +403,7 @@ MemCtrl::addToWriteQueue(PacketPtr pkt, unsigned int pkt_count,
 
     // if the request size is larger than burst size, the pkt is split into
     // multiple packets
-    const Addr base_addr = pkt->getAddr();
+    const Addr base_addr = mediaAddr(pkt->getAddr());
     Addr addr = base_addr;
     uint32_t burst_size = mem_intr->bytesPerBurst();
 
@@ -422,7 +515,7 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
     }
     prevArrival = curTick();
 
-    panic_if(!(dram->getAddrRange().contains(pkt->getAddr())),
+    panic_if(!(dram->getAddrRange().contains(mediaAddr(pkt->getAddr()))),
              "Can't handle address range for packet %s\n", pkt->print());
 
     // Find out how many memory packets a pkt translates to
@@ -486,7 +579,7 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
 
 void
 MemCtrl::processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req)
 {
@@ -496,13 +589,15 @@ MemCtrl::processRespondEvent(MemInterface* mem_intr,
 
     MemPacket* mem_pkt = queue.front();
 
-    // media specific checks and functions when read response is complete
+    // media specific checks and functions when read response is complete,
+    // once for each burst completing here
     // DRAM only
-    mem_intr->respondEvent(mem_pkt->rank);
+    for (unsigned int i = 0; i <= mem_pkt->coalescedBursts; i++)
+        mem_intr->respondEvent(mem_pkt->rank);
 
     if (mem_pkt->burstHelper) {
         // it is a split packet
-        mem_pkt->burstHelper->burstsServiced++;
+        mem_pkt->burstHelper->burstsServiced += 1 + mem_pkt->coalescedBursts;
         if (mem_pkt->burstHelper->burstsServiced ==
             mem_pkt->burstHelper->burstCount) {
             // we have now serviced all children packets of a system packet
@@ -618,6 +713,61 @@ MemCtrl::chooseNextFRFCFS(MemPacketQueue& queue, Tick extra_col_delay,
     return std::make_pair(selected_pkt_it, col_allowed_at);
 }
 
+void
+MemCtrl::coalesceReadBursts(MemPacket* mem_pkt, MemPacketQueue& queue,
+                            MemPacketQueue::iterator next,
+                            MemInterface* mem_intr,
+                            std::deque<MemPacket*>& resp_queue,
+                            EventFunctionWrapper& resp_event)
+{
+    assert(resp_queue.back() == mem_pkt);
+
+    while (next != queue.end()) {
+        MemPacket* next_pkt = *next;
+
+        // only the bursts of the same packet to the same row qualify,
+        // and they have to be ready to issue
+        if (next_pkt->burstHelper != mem_pkt->burstHelper ||
+            next_pkt->pseudoChannel != mem_pkt->pseudoChannel ||
+            next_pkt->rank != mem_pkt->rank ||
+            next_pkt->bank != mem_pkt->bank ||
+            next_pkt->row != mem_pkt->row ||
+            !packetReady(next_pkt, mem_intr)) {
+            break;
+        }
+
+        // leave the decision of switching to writes to the scheduler
+        if (mem_intr->writeQueueSize > writeHighThreshold &&
+            mem_intr->readsThisTime >= minReadsPerSwitch) {
+            break;
+        }
+
+        Tick cmd_at = doBurstAccess(next_pkt, mem_intr);
+        DPRINTF(MemCtrl, "Coalesced command for %#x, issued at %lld.\n",
+                next_pkt->addr, cmd_at);
+
+        assert(pktSizeCheck(next_pkt, mem_intr));
+        assert(next_pkt->readyTime >= mem_pkt->readyTime);
+
+        logResponse(MemCtrl::READ, next_pkt->requestorId(),
+                    next_pkt->qosValue(), next_pkt->getAddr(), 1,
+                    next_pkt->readyTime - next_pkt->entryTime);
+
+        mem_intr->readQueueSize--;
+        next = queue.erase(next);
+
+        // the new burst completes the earlier ones along with it
+        next_pkt->coalescedBursts = mem_pkt->coalescedBursts + 1;
+        resp_queue.back() = next_pkt;
+        if (resp_queue.size() == 1)
+            reschedule(resp_event, next_pkt->readyTime);
+
+        ++stats.coalescedBursts;
+        delete mem_pkt;
+        mem_pkt = next_pkt;
+    }
+}
+
 void
 MemCtrl::accessAndRespond(PacketPtr pkt, Tick static_latency,
                                                 MemInterface* mem_intr)
@@ -631,8 +781,14 @@ MemCtrl::accessAndRespond(PacketPtr pkt, Tick static_latency,
              "Can't handle address range for packet %s\n", pkt->print());
     mem_intr->access(pkt);
 
+    respond(pkt, static_latency, needsResponse);
+}
+
+void
+MemCtrl::respond(PacketPtr pkt, Tick static_latency, bool needs_response)
+{
     // turn packet around to go back to requestor if response expected
-    if (needsResponse) {
+    if (needs_response) {
         // access already turned the packet into a response
         assert(pkt->isResponse());
         // response_time consumes the static latency and is charged also
@@ -879,7 +1035,7 @@ MemCtrl::nonDetermReads(MemInterface* mem_intr) {
 
 void
 MemCtrl::processNextReqEvent(MemInterface* mem_intr,
-                        MemPacketQueue& resp_queue,
+                        std::deque<MemPacket*>& resp_queue,
                         EventFunctionWrapper& resp_event,
                         EventFunctionWrapper& next_req_event,
                         bool& retry_wr_req) {
@@ -967,9 +1123,10 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
 
             bool read_found = false;
             MemPacketQueue::iterator to_read;
-            uint8_t prio = numPriorities();
+            // Skip the priorities above the highest one with reads queued
+            uint8_t prio = queuedPriorities(READ);
 
-            for (auto queue = readQueue.rbegin();
+            for (auto queue = readQueue.rbegin() + (numPriorities() - prio);
                  queue != readQueue.rend(); ++queue) {
 
                 prio--;
@@ -1031,6 +1188,16 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
 
             resp_queue.push_back(mem_pkt);
 
+            // remove the request from the queue
+            // the iterator is no longer valid .
+            auto& prio_queue = readQueue[mem_pkt->qosValue()];
+            auto next = prio_queue.erase(to_read);
+
+            if (coalesceBursts && mem_pkt->burstHelper) {
+                coalesceReadBursts(mem_pkt, prio_queue, next, mem_intr,
+                                   resp_queue, resp_event);
+            }
+
             // we have so many writes that we have to transition
             // don't transition if the writeRespQueue is full and
             // there are no other writes that can issue
@@ -1042,10 +1209,6 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
                && !(nvmWriteBlock(mem_intr))) {
                 switch_to_writes = true;
             }
-
-            // remove the request from the queue
-            // the iterator is no longer valid .
-            readQueue[mem_pkt->qosValue()].erase(to_read);
         }
 
         // switching to writes, either because the read queue is empty
@@ -1059,9 +1222,10 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
 
         bool write_found = false;
         MemPacketQueue::iterator to_write;
-        uint8_t prio = numPriorities();
+        // Skip the priorities above the highest one with writes queued
+        uint8_t prio = queuedPriorities(WRITE);
 
-        for (auto queue = writeQueue.rbegin();
+        for (auto queue = writeQueue.rbegin() + (numPriorities() - prio);
              queue != writeQueue.rend(); ++queue) {
 
             prio--;
@@ -1197,6 +1361,9 @@ MemCtrl::CtrlStats::CtrlStats(MemCtrl &_ctrl)
              "Number of controller read bursts serviced by the write queue"),
     ADD_STAT(mergedWrBursts, statistics::units::Count::get(),
              "Number of controller write bursts merged with an existing one"),
+    ADD_STAT(coalescedBursts, statistics::units::Count::get(),
+             "Number of read bursts issued back to back with the previous "
+             "burst of the same packet"),
 
     ADD_STAT(neitherReadNorWriteReqs, statistics::units::Count::get(),
              "Number of requests that are neither read nor write"),
@@ -47,7 +47,9 @@
 #define __MEM_CTRL_HH__
 
 #include <deque>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -151,6 +153,12 @@ class MemPacket
      */
     BurstHelper* burstHelper;
 
+    /**
+     * Number of earlier bursts of the same split packet that were
+     * issued together with this one and complete with it
+     */
+    unsigned int coalescedBursts;
+
     /**
      * QoS value of the encapsulated packet read at queuing time
      */
@@ -210,14 +218,115 @@ class MemPacket
           _requestorId(pkt->requestorId()),
           read(is_read), dram(is_dram), pseudoChannel(_channel), rank(_rank),
           bank(_bank), row(_row), bankId(bank_id), addr(_addr), size(_size),
-          burstHelper(NULL), _qosValue(_pkt->qosValue())
+          burstHelper(NULL), coalescedBursts(0),
+          _qosValue(_pkt->qosValue())
     { }
 
 };
 
-// The memory packets are store in a multiple dequeue structure,
-// based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
+/**
+ * A queue of memory packets in arrival order, as used for each QoS
+ * priority of the read and write queues. Alongside the plain sequence
+ * of packets the queue keeps an index of the packets per bank, bucketed
+ * by row, so that the FR-FCFS schedulers can find the oldest row hit
+ * or the oldest access to a bank without walking the whole queue.
+ *
+ * Packets are only ever appended and removed, so the order in which
+ * they were appended is also their position in the queue.
+ */
+class MemPacketQueue
+{
+  public:
+    typedef std::deque<MemPacket*>::iterator iterator;
+    typedef std::deque<MemPacket*>::const_iterator const_iterator;
+
+    /** A queued packet along with its position in the queue */
+    struct Entry
+    {
+        uint64_t order;
+        MemPacket *pkt;
+    };
+
+    /** The packets queued for a single bank */
+    class BankQueue
+    {
+      public:
+        /**
+         * Get the oldest packet to a row.
+         *
+         * @param row Row to look for
+         * @return The oldest entry for the row, nullptr if there is none
+         */
+        const Entry *oldest(uint32_t row) const;
+
+        /**
+         * Get the oldest packet that does not access a row.
+         *
+         * @param row Row to exclude
+         * @return The oldest entry for any other row, nullptr if there
+         *         is none
+         */
+        const Entry *oldestExcept(uint32_t row) const;
+
+        /**
+         * Check for queued packets to a row, other than a given one.
+         *
+         * @param row Row to look for
+         * @param pkt Packet to ignore
+         */
+        bool hasOther(uint32_t row, const MemPacket *pkt) const;
+
+        bool empty() const { return fronts.empty(); }
+
+      private:
+        friend class MemPacketQueue;
+
+        /** Queued packets for each row, in queue order */
+        std::unordered_map<uint32_t, std::deque<Entry>> rows;
+
+        /** Position of the oldest packet of each row, and the row */
+        std::set<std::pair<uint64_t, uint32_t>> fronts;
+    };
+
+    iterator begin() { return packets.begin(); }
+    iterator end() { return packets.end(); }
+    const_iterator begin() const { return packets.begin(); }
+    const_iterator end() const { return packets.end(); }
+
+    size_t size() const { return packets.size(); }
+    bool empty() const { return packets.empty(); }
+
+    void push_back(MemPacket *pkt);
+    iterator erase(iterator it);
+
+    /**
+     * Get the packets queued for a bank.
+     *
+     * @return The bank queue, nullptr if no packet was ever queued for
+     *         the bank
+     */
+    const BankQueue *bankQueue(bool dram, uint8_t pseudo_channel,
+                               uint8_t rank, uint8_t bank) const;
+
+    /** Find the queue position of an entry from a bank queue */
+    iterator find(const Entry &entry);
+
+  private:
+    static uint32_t
+    bankKey(bool dram, uint8_t pseudo_channel, uint8_t rank, uint8_t bank)
+    {
+        return (dram << 24) | (pseudo_channel << 16) | (rank << 8) | bank;
+    }
+
+    std::deque<MemPacket*> packets;
+
+    /** Order of each packet, parallel to packets */
+    std::deque<uint64_t> orders;
+
+    uint64_t nextOrder = 0;
+
+    std::unordered_map<uint32_t, BankQueue> banks;
+};
 
 
 /**
@@ -300,14 +409,14 @@ class MemCtrl : public qos::MemCtrl
      * in these methods
      */
     virtual void processNextReqEvent(MemInterface* mem_intr,
-                          MemPacketQueue& resp_queue,
+                          std::deque<MemPacket*>& resp_queue,
                           EventFunctionWrapper& resp_event,
                           EventFunctionWrapper& next_req_event,
                           bool& retry_wr_req);
     EventFunctionWrapper nextReqEvent;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req);
     EventFunctionWrapper respondEvent;
@@ -371,6 +480,26 @@ class MemCtrl : public qos::MemCtrl
      */
     virtual Tick doBurstAccess(MemPacket* mem_pkt, MemInterface* mem_intr);
 
+    /**
+     * Issue the bursts that follow a read burst in the queue as long as
+     * they are to the same row of the same split packet. The bursts are
+     * timed one by one by the interface, but in the same scheduling
+     * decision, and only the last one goes to the response queue,
+     * completing the others along with it.
+     *
+     * @param mem_pkt The burst just issued, last in the response queue
+     * @param queue The queue the burst was taken from
+     * @param next The position following the burst in the queue
+     * @param mem_intr The memory interface to access
+     * @param resp_queue The response queue of the interface
+     * @param resp_event The response event of the interface
+     */
+    void coalesceReadBursts(MemPacket* mem_pkt, MemPacketQueue& queue,
+                            MemPacketQueue::iterator next,
+                            MemInterface* mem_intr,
+                            std::deque<MemPacket*>& resp_queue,
+                            EventFunctionWrapper& resp_event);
+
     /**
      * When a packet reaches its "readyTime" in the response Q,
      * use the "access()" method in AbstractMemory to actually
@@ -384,6 +513,26 @@ class MemCtrl : public qos::MemCtrl
     virtual void accessAndRespond(PacketPtr pkt, Tick static_latency,
                                                 MemInterface* mem_intr);
 
+    /**
+     * Send a packet that was accessed back to the outside world, or
+     * delete it if no response is expected.
+     *
+     * @param pkt The packet, turned into a response if one is expected
+     * @param static_latency Static latency to add before sending the packet
+     * @param needs_response Whether the request expected a response
+     */
+    void respond(PacketPtr pkt, Tick static_latency, bool needs_response);
+
+    /**
+     * Translate the address of a packet to the address of the media
+     * location that serves it, which is what the read and write queues
+     * hold. By default this is the address itself.
+     *
+     * @param addr The address of the packet from the outside world
+     * @return The address of the media location
+     */
+    virtual Addr mediaAddr(Addr addr) const { return addr; }
+
     /**
      * Determine if there is a packet that can issue.
      *
@@ -518,6 +667,9 @@ class MemCtrl : public qos::MemCtrl
     const uint32_t minWritesPerSwitch;
     const uint32_t minReadsPerSwitch;
 
+    /** Issue same-row bursts of a split read back to back */
+    const bool coalesceBursts;
+
     /**
      * Memory controller configuration initialized based on parameter
      * values.
@@ -574,6 +726,7 @@ class MemCtrl : public qos::MemCtrl
         statistics::Scalar writeBursts;
         statistics::Scalar servicedByWrQ;
         statistics::Scalar mergedWrBursts;
+        statistics::Scalar coalescedBursts;
         statistics::Scalar neitherReadNorWriteReqs;
         // Average queue lengths
         statistics::Average avgRdQLen;
@@ -399,6 +399,16 @@ Packet::matchBlockAddr(const PacketPtr pkt, const int blk_size) const
                           blk_size);
 }
 
+void
+Packet::unshareData()
+{
+    uint8_t *copy = PacketPayload::allocate(getSize());
+    std::memcpy(copy, data, getSize());
+    PacketPayload::countCopied(getSize());
+    PacketPayload::unref(data);
+    data = copy;
+}
+
 bool
 Packet::matchAddr(const Addr addr, const bool is_secure) const
 {
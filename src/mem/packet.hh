@@ -51,6 +51,7 @@
 #include <cassert>
 #include <initializer_list>
 #include <list>
+#include <utility>
 
 #include "base/addr_range.hh"
 #include "base/cast.hh"
@@ -61,6 +62,7 @@
 #include "base/printable.hh"
 #include "base/types.hh"
 #include "mem/htm.hh"
+#include "mem/packet_pool.hh"
 #include "mem/request.hh"
 #include "sim/byteswap.hh"
 
@@ -353,6 +355,10 @@ class Packet : public Printable, public Extensible<Packet>
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The dynamic data is a reference-counted PacketPayload,
+        /// which may be shared with other packets and is copied before
+        /// it is modified while shared.
+        SHARED_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -386,6 +392,9 @@ class Packet : public Printable, public Extensible<Packet>
     */
     PacketDataPtr data;
 
+    /** Replace the shared payload with a private copy of it. */
+    void unshareData();
+
     /// The address of the request.  This address could be virtual or
     /// physical, depending on the system configuration.
     Addr addr;
@@ -470,6 +479,30 @@ class Packet : public Printable, public Extensible<Packet>
         SenderState* predecessor;
         SenderState() : predecessor(NULL) {}
         virtual ~SenderState() {}
+
+        /**
+         * @{
+         * Sender states are pushed and popped at every hop that needs
+         * one, so the small ones are allocated from a per-thread pool,
+         * see mem/packet_pool.hh. Larger ones use the global heap.
+         */
+        static void *
+        operator new(size_t size)
+        {
+            if (size > SenderStateBlockSize)
+                return ::operator new(size);
+            return senderStatePool().allocate();
+        }
+
+        static void
+        operator delete(void *ptr, size_t size)
+        {
+            if (size > SenderStateBlockSize)
+                ::operator delete(ptr);
+            else
+                senderStatePool().deallocate(ptr);
+        }
+        /** @} */
     };
 
     /**
@@ -564,6 +597,33 @@ class Packet : public Printable, public Extensible<Packet>
      */
     SenderState *popSenderState();
 
+    /**
+     * Create a sender state of type T and push it on the stack.
+     *
+     * @param args Arguments of the constructor of T
+     * @return The new top of the stack
+     */
+    template <typename T, typename... Args>
+    T *
+    emplaceSenderState(Args&&... args)
+    {
+        T *t = new T(std::forward<Args>(args)...);
+        pushSenderState(t);
+        return t;
+    }
+
+    /**
+     * Pop the top of the state stack, which must be of type T.
+     *
+     * @return The current top of the stack
+     */
+    template <typename T>
+    T *
+    popSenderState()
+    {
+        return safe_cast<T *>(popSenderState());
+    }
+
     /**
      * Go through the sender state stack and return the first instance
      * that is of type T (as determined by a dynamic_cast). If there
@@ -980,6 +1040,12 @@ class Packet : public Printable, public Extensible<Packet>
             if (pkt->flags.isSet(STATIC_DATA)) {
                 data = pkt->data;
                 flags.set(STATIC_DATA);
+            } else if (pkt->flags.isSet(SHARED_DATA) && hasData()) {
+                // the copy carries the same payload, which is only
+                // copied if either packet modifies it
+                data = PacketPayload::ref(pkt->data);
+                flags.set(DYNAMIC_DATA|SHARED_DATA);
+                PacketPayload::countShared(getSize());
             } else {
                 allocate();
             }
@@ -1054,6 +1120,29 @@ class Packet : public Printable, public Extensible<Packet>
         deleteData();
     }
 
+    /**
+     * @{
+     * Packets are allocated from a per-thread pool, see
+     * mem/packet_pool.hh.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        if (size != sizeof(Packet))
+            return ::operator new(size);
+        return packetPool().allocate();
+    }
+
+    static void
+    operator delete(void *ptr, size_t size)
+    {
+        if (size != sizeof(Packet))
+            ::operator delete(ptr);
+        else
+            packetPool().deallocate(ptr);
+    }
+    /** @} */
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1226,6 +1315,8 @@ class Packet : public Printable, public Extensible<Packet>
     {
         assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA));
         assert(!isMaskedWrite());
+        if (flags.isSet(SHARED_DATA) && PacketPayload::shared(data))
+            unshareData();
         return (T*)data;
     }
 
@@ -1295,12 +1386,40 @@ class Packet : public Printable, public Extensible<Packet>
         // we should never be copying data onto itself, which means we
         // must idenfity packets with static data, as they carry the
         // same pointer from source to destination and back
-        assert(p != getPtr<uint8_t>() || flags.isSet(STATIC_DATA));
-
-        if (p != getPtr<uint8_t>()) {
+        assert(p != getConstPtr<uint8_t>() || flags.isSet(STATIC_DATA));
+
+        if (p != getConstPtr<uint8_t>()) {
+            if (flags.isSet(SHARED_DATA) && PacketPayload::shared(data)) {
+                // the contents are overwritten, so rather than making
+                // a private copy, start over with a fresh payload
+                PacketPayload::unref(data);
+                data = PacketPayload::allocate(getSize());
+            }
             // for packet with allocated dynamic data, we copy data from
             // one to the other, e.g. a forwarded response to a response
-            std::memcpy(getPtr<uint8_t>(), p, getSize());
+            std::memcpy(data, p, getSize());
+            PacketPayload::countCopied(getSize());
+        }
+    }
+
+    /**
+     * Copy data into the packet from another packet for the same
+     * address. If both packets hold reference-counted payloads of the
+     * same size, the payload is shared rather than copied.
+     */
+    void
+    setData(const Packet *other)
+    {
+        assert(other->getAddr() == getAddr());
+        if (flags.isSet(SHARED_DATA) && other->flags.isSet(SHARED_DATA) &&
+            other->getSize() == getSize()) {
+            if (data != other->data) {
+                PacketPayload::unref(data);
+                data = PacketPayload::ref(other->data);
+            }
+            PacketPayload::countShared(getSize());
+        } else {
+            setData(other->getConstPtr<uint8_t>());
         }
     }
 
@@ -1323,6 +1442,7 @@ class Packet : public Printable, public Extensible<Packet>
     {
         if (!isMaskedWrite()) {
             std::memcpy(p, getConstPtr<uint8_t>(), getSize());
+            PacketPayload::countCopied(getSize());
         } else {
             assert(req->getByteEnable().size() == getSize());
             // Write only the enabled bytes
@@ -1355,10 +1475,12 @@ class Packet : public Printable, public Extensible<Packet>
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(SHARED_DATA))
+            PacketPayload::unref(data);
+        else if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|SHARED_DATA);
         data = NULL;
     }
 
@@ -1370,8 +1492,8 @@ class Packet : public Printable, public Extensible<Packet>
         // payload, actually allocate space
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
-            flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            flags.set(DYNAMIC_DATA|SHARED_DATA);
+            data = PacketPayload::allocate(getSize());
         }
     }
 
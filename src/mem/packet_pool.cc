@@ -0,0 +1,215 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/packet_pool.hh"
+
+#include <new>
+
+#include "base/statistics.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "sim/stats.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/**
+ * Room left in each request block for the shared_ptr control block
+ * created by std::allocate_shared() in makeRequest().
+ */
+constexpr size_t RequestControlBlockSize = 64;
+
+struct PoolStats : public statistics::Group
+{
+    PoolStats(statistics::Group *parent, SlabPool &pool)
+        : statistics::Group(parent, pool.name().c_str()),
+          ADD_STAT(hits, statistics::units::Count::get(),
+                   "Number of allocations that reused a freed block"),
+          ADD_STAT(misses, statistics::units::Count::get(),
+                   "Number of allocations of a new block from a slab")
+    {
+        hits.functor([&pool]() { return pool.hits(); });
+        misses.functor([&pool]() { return pool.misses(); });
+    }
+
+    statistics::Value hits;
+    statistics::Value misses;
+};
+
+struct PayloadStats : public statistics::Group
+{
+    PayloadStats(statistics::Group *parent)
+        : statistics::Group(parent, "packetPayload"),
+          ADD_STAT(copiedBytes, statistics::units::Byte::get(),
+                   "Number of payload bytes copied"),
+          ADD_STAT(sharedBytes, statistics::units::Byte::get(),
+                   "Number of payload bytes shared instead of copied"),
+          ADD_STAT(copiedBytesRate, statistics::units::Rate<
+                       statistics::units::Byte, statistics::units::Second
+                   >::get(),
+                   "Payload bytes copied per simulated second",
+                   copiedBytes / simSeconds)
+    {
+        copiedBytes.functor([]() { return PacketPayload::copiedBytes(); });
+        sharedBytes.functor([]() { return PacketPayload::sharedBytes(); });
+    }
+
+    statistics::Value copiedBytes;
+    statistics::Value sharedBytes;
+    statistics::Formula copiedBytesRate;
+};
+
+struct PacketPoolStats : public statistics::Group
+{
+    PacketPoolStats()
+        : statistics::Group(nullptr),
+          packet(this, packetPool()),
+          packetData(this, packetDataPool()),
+          request(this, requestPool()),
+          senderState(this, senderStatePool()),
+          payload(this)
+    {}
+
+    PoolStats packet;
+    PoolStats packetData;
+    PoolStats request;
+    PoolStats senderState;
+    PayloadStats payload;
+};
+
+} // anonymous namespace
+
+SlabPool &
+packetPool()
+{
+    static SlabPool pool("packet", sizeof(Packet));
+    return pool;
+}
+
+SlabPool &
+packetDataPool()
+{
+    static SlabPool pool("packetData",
+                         PacketPayload::HeaderSize + PacketDataBlockSize);
+    return pool;
+}
+
+SlabPool &
+requestPool()
+{
+    static SlabPool pool("request",
+                         sizeof(Request) + RequestControlBlockSize);
+    return pool;
+}
+
+SlabPool &
+senderStatePool()
+{
+    static SlabPool pool("senderState", SenderStateBlockSize);
+    return pool;
+}
+
+uint8_t *
+PacketPayload::allocate(size_t size)
+{
+    void *block = size <= PacketDataBlockSize ?
+        packetDataPool().allocate() : ::operator new(HeaderSize + size);
+    uint8_t *data = static_cast<uint8_t *>(block) + HeaderSize;
+    Header *hdr = new (block) Header;
+    hdr->refs.store(1, std::memory_order_relaxed);
+    hdr->size = size;
+    return data;
+}
+
+void
+PacketPayload::free(uint8_t *data)
+{
+    Header &hdr = header(data);
+    const bool pooled = hdr.size <= PacketDataBlockSize;
+    hdr.~Header();
+    if (pooled)
+        packetDataPool().deallocate(data - HeaderSize);
+    else
+        ::operator delete(data - HeaderSize);
+}
+
+std::vector<PacketPayload::Counters *> &
+PacketPayload::allCounters()
+{
+    static std::vector<Counters *> counters;
+    return counters;
+}
+
+std::mutex &
+PacketPayload::countersMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+PacketPayload::Counters &
+PacketPayload::newCounters()
+{
+    // Never freed, so that the statistics can still read the counts of
+    // threads that are gone
+    Counters *counters = new Counters;
+    std::lock_guard<std::mutex> lock(countersMutex());
+    allCounters().push_back(counters);
+    return *counters;
+}
+
+Counter
+PacketPayload::sum(std::atomic<Counter> Counters::*counter)
+{
+    std::lock_guard<std::mutex> lock(countersMutex());
+    Counter total = 0;
+    for (const Counters *counters : allCounters())
+        total += (counters->*counter).load(std::memory_order_relaxed);
+    return total;
+}
+
+Counter
+PacketPayload::copiedBytes()
+{
+    return sum(&Counters::copied);
+}
+
+Counter
+PacketPayload::sharedBytes()
+{
+    return sum(&Counters::shared);
+}
+
+statistics::Group &
+packetPoolStats()
+{
+    static PacketPoolStats stats;
+    return stats;
+}
+
+} // namespace gem5
@@ -0,0 +1,185 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Per-thread slab pools for packets, requests and packet payloads.
+ *
+ * Packets are allocated from packetPool() by Packet::operator new,
+ * payloads of up to PacketDataBlockSize bytes from packetDataPool() by
+ * Packet::allocate(), and requests created with makeRequest() share a
+ * block of requestPool() with their shared_ptr control block.
+ *
+ * Payloads allocated by Packet::allocate() are reference counted, see
+ * PacketPayload, so that packets can share a payload rather than copy
+ * it.
+ */
+
+#ifndef __MEM_PACKET_POOL_HH__
+#define __MEM_PACKET_POOL_HH__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "base/slab_pool.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+class Group;
+} // namespace statistics
+
+/** Largest payload allocated from the packet data pool. */
+constexpr size_t PacketDataBlockSize = 64;
+
+/** Largest Packet::SenderState allocated from the sender state pool. */
+constexpr size_t SenderStateBlockSize = 64;
+
+SlabPool &packetPool();
+SlabPool &packetDataPool();
+SlabPool &requestPool();
+SlabPool &senderStatePool();
+
+/**
+ * Reference-counted packet payloads. The reference count lives in a
+ * header in front of the payload, so a payload is identified by its
+ * data pointer alone and packets keep a plain pointer to it.
+ */
+class PacketPayload
+{
+  public:
+    /** Room taken by the header, keeping the payload aligned. */
+    static constexpr size_t HeaderSize = alignof(std::max_align_t);
+
+    /** Allocate a payload of the given size with a single reference. */
+    static uint8_t *allocate(size_t size);
+
+    /** Add a reference to a payload. */
+    static uint8_t *
+    ref(uint8_t *data)
+    {
+        header(data).refs.fetch_add(1, std::memory_order_relaxed);
+        return data;
+    }
+
+    /** Drop a reference to a payload, freeing it with the last one. */
+    static void
+    unref(uint8_t *data)
+    {
+        if (header(data).refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            free(data);
+    }
+
+    /** @return True if more than one packet refers to the payload. */
+    static bool
+    shared(const uint8_t *data)
+    {
+        return header(data).refs.load(std::memory_order_acquire) > 1;
+    }
+
+    /** @{ */
+    /**
+     * Count payload bytes copied between packets and memories, and
+     * bytes passed on by sharing a payload instead of copying it.
+     */
+    static void
+    countCopied(size_t bytes)
+    {
+        increment(threadCounters().copied, bytes);
+    }
+
+    static void
+    countShared(size_t bytes)
+    {
+        increment(threadCounters().shared, bytes);
+    }
+    /** @} */
+
+    /** @{ */
+    /** Counters summed over all threads. */
+    static Counter copiedBytes();
+    static Counter sharedBytes();
+    /** @} */
+
+  private:
+    struct Header
+    {
+        std::atomic<uint32_t> refs;
+        uint32_t size;
+    };
+    static_assert(sizeof(Header) <= HeaderSize);
+
+    struct Counters
+    {
+        // Only written by the owning thread, read by statistics
+        std::atomic<Counter> copied{0};
+        std::atomic<Counter> shared{0};
+    };
+
+    static Header &
+    header(const uint8_t *data)
+    {
+        return *reinterpret_cast<Header *>(
+            const_cast<uint8_t *>(data) - HeaderSize);
+    }
+
+    static void
+    increment(std::atomic<Counter> &counter, size_t bytes)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + bytes,
+                      std::memory_order_relaxed);
+    }
+
+    static Counters &
+    threadCounters()
+    {
+        thread_local Counters &counters = newCounters();
+        return counters;
+    }
+
+    /** All per-thread counters, guarded by countersMutex(). */
+    static std::vector<Counters *> &allCounters();
+    static std::mutex &countersMutex();
+
+    static Counters &newCounters();
+    static Counter sum(std::atomic<Counter> Counters::*counter);
+    static void free(uint8_t *data);
+};
+
+/**
+ * Statistics (hits and misses) of the packet pools. The group is
+ * registered under the root object.
+ */
+statistics::Group &packetPoolStats();
+
+} // namespace gem5
+
+#endif // __MEM_PACKET_POOL_HH__
@@ -56,6 +56,9 @@ PacketQueue::PacketQueue(EventManager& _em, const std::string& _label,
       forceOrder(force_order),
       label(_label), waitingOnRetry(false)
 {
+    // Most queues are empty at any point in time, so only drain the busy
+    // ones.
+    trackDrain();
 }
 
 PacketQueue::~PacketQueue()
@@ -148,6 +151,7 @@ PacketQueue::schedSendTiming(PacketPtr pkt, Tick when)
     // either the packet list is empty or this has to be inserted
     // before every other packet
     transmitList.emplace_front(when, pkt);
+    drainBusy(true);
     schedSendEvent(when);
 }
 
@@ -210,6 +214,7 @@ PacketQueue::sendDeferredPacket()
     // if we succeeded and are not waiting for a retry, schedule the
     // next send
     if (!waitingOnRetry) {
+        drainBusy(!transmitList.empty());
         schedSendEvent(deferredPacketReadyTime());
     } else {
         // put the packet back at the front of the list
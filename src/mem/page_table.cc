@@ -48,11 +48,15 @@ void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
     bool clobber = flags & Clobber;
+    // Only a clobbering map can change a translation that exists.
+    if (clobber)
+        _generation++;
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
+    std::unique_lock lock(tableMutex);
     while (size > 0) {
         auto it = pTable.find(vaddr);
         if (it != pTable.end()) {
@@ -76,10 +80,12 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 {
     assert(pageOffset(vaddr) == 0);
     assert(pageOffset(new_vaddr) == 0);
+    _generation++;
 
     DPRINTF(MMU, "moving pages from vaddr %08p to %08p, size = %d\n", vaddr,
             new_vaddr, size);
 
+    std::unique_lock lock(tableMutex);
     while (size > 0) {
         [[maybe_unused]] auto new_it = pTable.find(new_vaddr);
         auto old_it = pTable.find(vaddr);
@@ -96,6 +102,7 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
+    std::shared_lock lock(tableMutex);
     for (auto &iter : pTable)
         addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
 }
@@ -104,9 +111,11 @@ void
 EmulationPageTable::unmap(Addr vaddr, int64_t size)
 {
     assert(pageOffset(vaddr) == 0);
+    _generation++;
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
+    std::unique_lock lock(tableMutex);
     while (size > 0) {
         auto it = pTable.find(vaddr);
         assert(it != pTable.end());
@@ -122,6 +131,7 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
+    std::shared_lock lock(tableMutex);
     for (int64_t offset = 0; offset < size; offset += _pageSize)
         if (pTable.find(vaddr + offset) != pTable.end())
             return false;
@@ -133,6 +143,7 @@ const EmulationPageTable::Entry *
 EmulationPageTable::lookup(Addr vaddr)
 {
     Addr page_addr = pageAlign(vaddr);
+    std::shared_lock lock(tableMutex);
     PTableItr iter = pTable.find(page_addr);
     if (iter == pTable.end())
         return nullptr;
@@ -186,6 +197,7 @@ void
 EmulationPageTable::serialize(CheckpointOut &cp) const
 {
     ScopedCheckpointSection sec(cp, "ptable");
+    std::shared_lock lock(tableMutex);
     paramOut(cp, "size", pTable.size());
 
     PTable::size_type count = 0;
@@ -204,8 +216,10 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
 {
     int count;
     ScopedCheckpointSection sec(cp, "ptable");
+    _generation++;
     paramIn(cp, "size", count);
 
+    std::unique_lock lock(tableMutex);
     for (int i = 0; i < count; ++i) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", i));
 
@@ -224,6 +238,7 @@ const std::string
 EmulationPageTable::externalize() const
 {
     std::stringstream ss;
+    std::shared_lock lock(tableMutex);
     for (PTable::const_iterator it=pTable.begin(); it != pTable.end(); ++it) {
         ss << std::hex << it->first << ":" << it->second.paddr << ";";
     }
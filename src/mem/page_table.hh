@@ -35,6 +35,9 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 
@@ -67,24 +70,40 @@ class EmulationPageTable : public Serializable
     typedef PTable::iterator PTableItr;
     PTable pTable;
 
+    /**
+     * Guards pTable. Lookups may run concurrently from the threads of
+     * several event queues in parallel mode, while updates, which come
+     * from syscalls and fault fixups, are exclusive.
+     */
+    mutable std::shared_mutex tableMutex;
+
     const Addr _pageSize;
     const Addr offsetMask;
 
     const uint64_t _pid;
     const std::string _name;
 
+    /** Bumped whenever an existing translation may have changed. */
+    std::atomic<uint64_t> _generation;
+
   public:
 
     EmulationPageTable(
             const std::string &__name, uint64_t _pid, Addr _pageSize) :
             _pageSize(_pageSize), offsetMask(mask(floorLog2(_pageSize))),
-            _pid(_pid), _name(__name), shared(false)
+            _pid(_pid), _name(__name), _generation(0), shared(false)
     {
         assert(isPowerOf2(_pageSize));
     }
 
     uint64_t pid() const { return _pid; };
 
+    /**
+     * A counter that changes every time the table is modified, so that
+     * users caching translations can tell when to drop them.
+     */
+    uint64_t generation() const { return _generation; }
+
     virtual ~EmulationPageTable() {};
 
     /* generic page table mapping flags
@@ -137,7 +156,8 @@ class EmulationPageTable : public Serializable
     /**
      * Lookup function
      * @param vaddr The virtual address.
-     * @return The page table entry corresponding to vaddr.
+     * @return The page table entry corresponding to vaddr. It stays valid
+     *         until the page is unmapped.
      */
     const Entry *lookup(Addr vaddr);
 
@@ -39,22 +39,29 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <sys/user.h>
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
+#include "mem/store_image.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_exit.hh"
 
@@ -70,6 +77,10 @@
 #endif
 #endif
 
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
 namespace gem5
 {
 
@@ -80,11 +91,33 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               bool chunked_checkpoint,
+                               const std::string& checkpoint_base,
+                               unsigned checkpoint_threads,
+                               bool mmap_checkpoint,
+                               bool mmap_populate,
+                               bool mmap_huge_pages,
+                               uint64_t huge_page_size) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), chunkedCheckpoint(chunked_checkpoint),
+    checkpointBase(checkpoint_base), checkpointThreads(checkpoint_threads),
+    mmapCheckpoint(mmap_checkpoint), mmapPopulate(mmap_populate),
+    mmapHugePages(mmap_huge_pages), hugePageSize(huge_page_size)
 {
+    fatal_if(hugePageSize && !isPowerOf2(hugePageSize),
+             "Huge page size %d is not a power of 2", hugePageSize);
+#if !defined(MAP_HUGETLB)
+    fatal_if(hugePageSize, "Explicit huge pages are not supported on this "
+             "host");
+#endif
+
+    fatal_if(!checkpointBase.empty() && !chunkedCheckpoint,
+             "Memory checkpoint deltas need the chunked checkpoint format");
+    fatal_if(chunkedCheckpoint && mmapCheckpoint,
+             "Memory checkpoints can't be both chunked and mappable");
+
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
         registerExitCallback([=]() { shm_unlink(shared_backstore.c_str()); });
@@ -238,7 +271,17 @@ PhysicalMemory::createBackingStore(
         map_flags |= MAP_NORESERVE;
     }
 
-    uint8_t* pmem = (uint8_t*) mmap(NULL, range.size(),
+#if defined(MAP_HUGETLB)
+    // Explicit huge pages come from the pool the host reserved for them,
+    // so they are only used if asked for.
+    if (hugePageSize) {
+        fatal_if(!sharedBackstore.empty(),
+                 "Explicit huge pages can't be used with a shared backstore");
+        map_flags |= MAP_HUGETLB | (floorLog2(hugePageSize) << MAP_HUGE_SHIFT);
+    }
+#endif
+
+    uint8_t* pmem = (uint8_t*) mmap(NULL, mappedSize(range),
                                     PROT_READ | PROT_WRITE,
                                     map_flags, shm_fd, map_offset);
 
@@ -248,6 +291,32 @@ PhysicalMemory::createBackingStore(
               range.to_string());
     }
 
+#ifdef MADV_HUGEPAGE
+    // Large memories touched all over by the simulated system take many
+    // host TLB misses with small pages.
+    if (mmapHugePages && madvise(pmem, range.size(), MADV_HUGEPAGE) != 0)
+        warn("Could not use huge pages for range %s\n", range.to_string());
+#else
+    warn_if(mmapHugePages, "Huge pages are not supported on this host\n");
+#endif
+
+    // Bind the store before it is faulted in, as the pages don't move
+    // once they are allocated.
+    int node = _memories.empty() ? -1 : _memories[0]->getHostNumaNode();
+    for (const auto& m : _memories) {
+        if (m->getHostNumaNode() != node) {
+            warn("Memories in range %s want different host NUMA nodes\n",
+                 range.to_string());
+            node = -1;
+            break;
+        }
+    }
+    if (node >= 0)
+        bindBackingStore(pmem, mappedSize(range), node);
+
+    if (mmapPopulate)
+        populateBackingStore(pmem, range.size());
+
     // remember this backing store so we can checkpoint it and unmap
     // it appropriately
     backingStore.emplace_back(range, pmem,
@@ -262,11 +331,71 @@ PhysicalMemory::createBackingStore(
     }
 }
 
+uint64_t
+PhysicalMemory::mappedSize(const AddrRange &range) const
+{
+    return hugePageSize ? roundUp(range.size(), hugePageSize) : range.size();
+}
+
+void
+PhysicalMemory::bindBackingStore(uint8_t *pmem, uint64_t len, int node) const
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    // Use the system call rather than libnuma, which isn't a dependency.
+    // A preferred node still lets the host fall back to other nodes when
+    // the node is full, where binding would kill the simulator.
+    constexpr int mpol_preferred = 1;
+    constexpr unsigned long bits = sizeof(unsigned long) * 8;
+    std::vector<unsigned long> mask(node / bits + 1, 0);
+    mask[node / bits] = 1UL << (node % bits);
+    if (syscall(SYS_mbind, pmem, len, mpol_preferred, mask.data(),
+                mask.size() * bits, 0) != 0) {
+        warn("Could not place backing store on host NUMA node %d: %s\n",
+             node, strerror(errno));
+    }
+#else
+    warn_once("Backing stores can only be placed on NUMA nodes on Linux\n");
+#endif
+}
+
+void
+PhysicalMemory::populateBackingStore(uint8_t *pmem, uint64_t len) const
+{
+    // Each thread faults in a contiguous part of the backing store, large
+    // enough for huge pages to be used.
+    constexpr uint64_t chunk = 64 * 1024 * 1024;
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t per_thread = roundUp(divCeil(len, threads), chunk);
+
+    auto populate = [this](uint8_t *start, uint64_t size) {
+#ifdef MADV_POPULATE_WRITE
+        if (madvise(start, size, MADV_POPULATE_WRITE) == 0)
+            return;
+#endif
+        // Writing back what is there faults the pages in writable without
+        // changing a shared backing store.
+        for (uint64_t off = 0; off < size; off += pageSize) {
+            volatile uint8_t *p = start + off;
+            *p = *p;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (uint64_t off = 0; off < len; off += per_thread) {
+        pool.emplace_back(populate, pmem + off,
+                          std::min(per_thread, len - off));
+    }
+
+    for (auto &thread : pool)
+        thread.join();
+}
+
 PhysicalMemory::~PhysicalMemory()
 {
     // unmap the backing store
     for (auto& s : backingStore)
-        munmap((char*)s.pmem, s.range.size());
+        munmap((char*)s.pmem, mappedSize(s.range));
 }
 
 bool
@@ -378,6 +507,26 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 
     // write memory file
     std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
+
+    if (chunkedCheckpoint) {
+        std::string format = "chunked";
+        SERIALIZE_SCALAR(format);
+
+        std::string base_path;
+        if (!checkpointBase.empty())
+            base_path = checkpointBase + "/" + filename;
+        writeStoreImage(filepath, pmem, range_size, base_path,
+                        checkpointThreads);
+        return;
+    }
+
+    if (mmapCheckpoint) {
+        std::string format = "mmap";
+        SERIALIZE_SCALAR(format);
+        serializeMappableStore(filepath, pmem, range_size);
+        return;
+    }
+
     gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
     if (compressed_mem == NULL)
         fatal("Can't open physical memory checkpoint file '%s'\n",
@@ -443,11 +592,6 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
-
     // we've already got the actual backing store mapped
     uint8_t* pmem = backingStore[store_id].pmem;
     AddrRange range = backingStore[store_id].range;
@@ -462,6 +606,24 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    // Checkpoints without a format were written with gzip
+    std::string format;
+    UNSERIALIZE_OPT_SCALAR(format);
+    if (format == "chunked") {
+        readStoreImage(filepath, pmem, range_size, checkpointThreads);
+        return;
+    } else if (format == "mmap") {
+        unserializeMappableStore(filepath, store_id);
+        return;
+    }
+    fatal_if(!format.empty(), "Unknown physical memory checkpoint format "
+             "'%s'", format);
+
+    // mmap memoryfile
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filename);
+
     uint64_t curr_size = 0;
     uint32_t bytes_read;
     while (curr_size < range.size()) {
@@ -477,5 +639,85 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
               filename);
 }
 
+void
+PhysicalMemory::serializeMappableStore(const std::string &filepath,
+                                       const uint8_t *pmem, Addr size) const
+{
+    int fd = open(filepath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1)
+        fatal("Can't open physical memory checkpoint file '%s'\n", filepath);
+
+    // Zero pages are left as holes, which read back as zeros
+    for (Addr offset = 0; offset < size; offset += pageSize) {
+        const uint8_t *page = pmem + offset;
+        Addr len = std::min<Addr>(pageSize, size - offset);
+        if (page[0] == 0 && !memcmp(page, page + 1, len - 1))
+            continue;
+
+        for (Addr done = 0; done < len; ) {
+            ssize_t ret = pwrite(fd, page + done, len - done, offset + done);
+            if (ret <= 0) {
+                fatal("Write failed on physical memory checkpoint file "
+                      "'%s'\n", filepath);
+            }
+            done += ret;
+        }
+    }
+
+    if (ftruncate(fd, size) || close(fd))
+        fatal("Close failed on physical memory checkpoint file '%s'\n",
+              filepath);
+}
+
+void
+PhysicalMemory::unserializeMappableStore(const std::string &filepath,
+                                         unsigned int store_id)
+{
+    const BackingStoreEntry &entry = backingStore[store_id];
+    Addr size = entry.range.size();
+
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd == -1)
+        fatal("Can't open physical memory checkpoint file '%s'\n", filepath);
+
+    struct stat st;
+    if (fstat(fd, &st) || (Addr)st.st_size != size)
+        fatal("Physical memory checkpoint file '%s' has the wrong size\n",
+              filepath);
+
+    // A shared backing store has to keep its mapping so other processes
+    // see the restored contents, so it is read instead
+    if (entry.shmFd == -1 && size % pageSize == 0) {
+        int map_flags = MAP_PRIVATE | MAP_FIXED;
+        if (mmapUsingNoReserve)
+            map_flags |= MAP_NORESERVE;
+
+        // Replacing the mapping in place keeps the host pointers of the
+        // memories valid
+        void *pmem = mmap(entry.pmem, size, PROT_READ | PROT_WRITE,
+                          map_flags, fd, 0);
+        if (pmem == MAP_FAILED) {
+            perror("mmap");
+            fatal("Could not mmap physical memory checkpoint file '%s'\n",
+                  filepath);
+        }
+        assert(pmem == entry.pmem);
+
+        DPRINTF(Checkpoint, "Mapped physical memory checkpoint %s\n",
+                filepath);
+    } else {
+        for (Addr done = 0; done < size; ) {
+            ssize_t ret = pread(fd, entry.pmem + done, size - done, done);
+            if (ret <= 0) {
+                fatal("Read failed on physical memory checkpoint file "
+                      "'%s'\n", filepath);
+            }
+            done += ret;
+        }
+    }
+
+    close(fd);
+}
+
 } // namespace memory
 } // namespace gem5
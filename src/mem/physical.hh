@@ -158,6 +158,27 @@ class PhysicalMemory : public Serializable
 
     long pageSize;
 
+    // Store checkpoints in the chunked image format of store_image.hh
+    const bool chunkedCheckpoint;
+
+    // Checkpoint directory to write memory images as deltas against
+    const std::string checkpointBase;
+
+    // Number of threads compressing and decompressing memory images
+    const unsigned checkpointThreads;
+
+    // Store checkpoints uncompressed so they can be mapped on restore
+    const bool mmapCheckpoint;
+
+    // Fault in the whole backing store when creating it
+    const bool mmapPopulate;
+
+    // Ask the host to back the backing store with huge pages
+    const bool mmapHugePages;
+
+    // Size of the explicit huge pages of the backing store, or 0
+    const uint64_t hugePageSize;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
@@ -182,6 +203,21 @@ class PhysicalMemory : public Serializable
                             bool conf_table_reported,
                             bool in_addr_map, bool kvm_map);
 
+    /**
+     * Fault in all the pages of a backing store, on all host cores,
+     * rather than one by one as simulation first touches them.
+     */
+    void populateBackingStore(uint8_t *pmem, uint64_t len) const;
+
+    /**
+     * Place a backing store on a host NUMA node. The pages are allocated
+     * on other nodes if the node is full.
+     */
+    void bindBackingStore(uint8_t *pmem, uint64_t len, int node) const;
+
+    /** Size of the mapping of the backing store of a range */
+    uint64_t mappedSize(const AddrRange &range) const;
+
   public:
 
     /**
@@ -191,7 +227,14 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   bool chunked_checkpoint=false,
+                   const std::string& checkpoint_base="",
+                   unsigned checkpoint_threads=0,
+                   bool mmap_checkpoint=false,
+                   bool mmap_populate=false,
+                   bool mmap_huge_pages=false,
+                   uint64_t huge_page_size=0);
 
     /**
      * Unmap all the backing store we have used.
@@ -296,6 +339,22 @@ class PhysicalMemory : public Serializable
      */
     void unserializeStore(CheckpointIn &cp);
 
+  private:
+
+    /**
+     * Write a store uncompressed, leaving holes for zero pages.
+     */
+    void serializeMappableStore(const std::string &filepath,
+                                const uint8_t *pmem, Addr size) const;
+
+    /**
+     * Restore a store written by serializeMappableStore by mapping the
+     * file copy-on-write over the backing store, or by reading it if the
+     * store can't be remapped.
+     */
+    void unserializeMappableStore(const std::string &filepath,
+                                  unsigned int store_id);
+
 };
 
 } // namespace memory
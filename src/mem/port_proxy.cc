@@ -37,7 +37,13 @@
 
 #include "mem/port_proxy.hh"
 
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
 #include "base/chunk_generator.hh"
+#include "base/intmath.hh"
 #include "cpu/thread_context.hh"
 #include "mem/port.hh"
 
@@ -54,14 +60,73 @@ PortProxy::PortProxy(const RequestPort &port, Addr cache_line_size) :
         cache_line_size)
 {}
 
+uint8_t *
+PortProxy::backdoorPtr(Addr addr, Request::Flags flags, uint64_t size,
+                       bool write, uint64_t &len) const
+{
+    // Accesses within a line cost a single packet anyway.
+    if (!sendMemBackdoor || size <= _cacheLineSize ||
+            flags.isSet(Request::UNCACHEABLE)) {
+        return nullptr;
+    }
+
+    MemBackdoorPtr bd = nullptr;
+    sendMemBackdoor(MemBackdoorReq(RangeSize(addr, size),
+                write ? MemBackdoor::Writeable : MemBackdoor::Readable), bd);
+    if (!bd || !bd->range().contains(addr) ||
+            !(write ? bd->writeable() : bd->readable())) {
+        return nullptr;
+    }
+
+    len = std::min<uint64_t>(size, bd->range().end() - addr);
+    return bd->ptr() + (addr - bd->range().start());
+}
+
+void
+PortProxy::backdoorCopy(void *dst, const void *src, uint64_t len)
+{
+    // Below this, starting threads costs more than it saves.
+    constexpr uint64_t chunk = 64 * 1024 * 1024;
+
+    unsigned threads = std::min<uint64_t>(
+        std::max(1u, std::thread::hardware_concurrency()), len / chunk);
+    if (threads <= 1) {
+        std::memcpy(dst, src, len);
+        return;
+    }
+
+    uint64_t per_thread = divCeil(len, threads);
+    std::vector<std::thread> pool;
+    for (uint64_t off = 0; off < len; off += per_thread) {
+        pool.emplace_back([=]() {
+            std::memcpy(static_cast<uint8_t *>(dst) + off,
+                        static_cast<const uint8_t *>(src) + off,
+                        std::min(per_thread, len - off));
+        });
+    }
+
+    for (auto &thread : pool)
+        thread.join();
+}
+
 void
 PortProxy::readBlobPhys(Addr addr, Request::Flags flags,
                         void *p, uint64_t size) const
 {
+    // Copy as much as possible straight out of the memories, which may
+    // take several back doors if the access spans several of them.
+    uint64_t len;
+    while (const uint8_t *host = backdoorPtr(addr, flags, size, false, len)) {
+        backdoorCopy(p, host, len);
+        p = static_cast<uint8_t *>(p) + len;
+        addr += len;
+        size -= len;
+    }
+
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
-        auto req = std::make_shared<Request>(
+        auto req = makeRequest(
             gen.addr(), gen.size(), flags, Request::funcRequestorId);
 
         Packet pkt(req, MemCmd::ReadReq);
@@ -75,10 +140,18 @@ void
 PortProxy::writeBlobPhys(Addr addr, Request::Flags flags,
                          const void *p, uint64_t size) const
 {
+    uint64_t len;
+    while (uint8_t *host = backdoorPtr(addr, flags, size, true, len)) {
+        backdoorCopy(host, p, len);
+        p = static_cast<const uint8_t *>(p) + len;
+        addr += len;
+        size -= len;
+    }
+
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
-        auto req = std::make_shared<Request>(
+        auto req = makeRequest(
             gen.addr(), gen.size(), flags, Request::funcRequestorId);
 
         Packet pkt(req, MemCmd::WriteReq);
@@ -92,6 +165,16 @@ void
 PortProxy::memsetBlobPhys(Addr addr, Request::Flags flags,
                           uint8_t v, uint64_t size) const
 {
+    uint64_t len;
+    while (uint8_t *host = backdoorPtr(addr, flags, size, true, len)) {
+        std::memset(host, v, len);
+        addr += len;
+        size -= len;
+    }
+
+    if (!size)
+        return;
+
     // quick and dirty...
     uint8_t *buf = new uint8_t[size];
 
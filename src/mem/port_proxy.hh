@@ -87,13 +87,39 @@ class PortProxy : FunctionalRequestProtocol
 {
   public:
     typedef std::function<void(PacketPtr pkt)> SendFunctionalFunc;
+    typedef std::function<void(const MemBackdoorReq &req,
+                               MemBackdoorPtr &backdoor)> SendMemBackdoorFunc;
 
   private:
     SendFunctionalFunc sendFunctional;
 
+    /**
+     * Back door requests for accesses which span several cache lines, if
+     * the owner of the proxy supports them. The owner must only grant a
+     * back door when the memory is not cached.
+     */
+    SendMemBackdoorFunc sendMemBackdoor;
+
     /** Granularity of any transactions issued through this proxy. */
     const Addr _cacheLineSize;
 
+    /**
+     * Get a back door to the start of an access.
+     *
+     * @param len Set to the number of bytes the back door covers.
+     * @return Pointer to the host memory at addr, or nullptr if the
+     *         access has to go through packets.
+     */
+    uint8_t *backdoorPtr(Addr addr, Request::Flags flags, uint64_t size,
+                         bool write, uint64_t &len) const;
+
+    /**
+     * Copy through a back door. Copies of whole images, which can be
+     * gigabytes, are spread over several threads, as most of their time
+     * goes into faulting in the pages of the backing store.
+     */
+    static void backdoorCopy(void *dst, const void *src, uint64_t len);
+
     void
     recvFunctionalSnoop(PacketPtr pkt) override
     {
@@ -107,6 +133,12 @@ class PortProxy : FunctionalRequestProtocol
         sendFunctional(func), _cacheLineSize(cache_line_size)
     {}
 
+    PortProxy(SendFunctionalFunc func, SendMemBackdoorFunc backdoor_func,
+              Addr cache_line_size) :
+        sendFunctional(func), sendMemBackdoor(backdoor_func),
+        _cacheLineSize(cache_line_size)
+    {}
+
     // Helpers which create typical SendFunctionalFunc-s from other objects.
     PortProxy(ThreadContext *tc, Addr cache_line_size);
     PortProxy(const RequestPort &port, Addr cache_line_size);
@@ -48,3 +48,8 @@ class MemFootprintProbe(BaseMemProbe):
         Parent.any, "System pointer to get cache line and mem size"
     )
     page_size = Param.Unsigned(4096, "Page size for page-level footprint")
+    heatmap_file = Param.String(
+        "",
+        "File to write per-page access counts to on every stats dump, "
+        "split by requestor and by demand vs. prefetch (empty to disable)",
+    )
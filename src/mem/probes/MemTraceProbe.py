@@ -52,5 +52,12 @@ class MemTraceProbe(BaseMemProbe):
     # packet trace output file, disabled by default
     trace_file = Param.String("", "Packet trace output file")
 
+    # Packets are captured in batches, which a writer thread encodes and
+    # compresses while the next batch fills up
+    batch_size = Param.Unsigned(4096, "Packets per batch")
+    threaded_writer = Param.Bool(
+        True, "Encode and compress batches on a writer thread"
+    )
+
     # System object to look up the name associated with a requestor ID
     system = Param.System(Parent.any, "System the probe belongs to")
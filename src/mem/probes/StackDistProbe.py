@@ -58,6 +58,13 @@ class StackDistProbe(BaseMemProbe):
         False, "Verify behaviuor with reference implementation"
     )
 
+    # spatial sampling of the lines
+    sample_rate = Param.Float(
+        1.0,
+        "Fraction of the lines to track, distances are scaled up and "
+        "counts are of the sampled accesses only",
+    )
+
     # linear histogram bins and enable/disable
     linear_hist_bins = Param.Unsigned("16", "Bins in linear histograms")
     disable_linear_hists = Param.Bool(False, "Disable linear histograms")
@@ -38,6 +38,8 @@
 
 #include "mem/probes/mem_footprint.hh"
 
+#include <algorithm>
+
 #include "base/intmath.hh"
 #include "params/MemFootprintProbe.hh"
 
@@ -50,17 +52,39 @@ MemFootprintProbe::MemFootprintProbe(const MemFootprintProbeParams &p)
       pageSizeLg2(floorLog2(p.page_size)),
       totalCacheLinesInMem(p.system->memSize() / p.system->cacheLineSize()),
       totalPagesInMem(p.system->memSize() / p.page_size),
-      cacheLines(),
-      cacheLinesAll(),
-      pages(),
-      pagesAll(),
+      lineWords(divCeil(p.page_size / p.system->cacheLineSize(), 64)),
+      cacheLines(0),
+      cacheLinesAll(0),
+      pages(0),
+      pagesAll(0),
+      pagesPrefetchOnly(0),
       system(p.system),
+      heatmapStream(nullptr),
+      heatmapInterval(0),
       stats(this)
 {
     fatal_if(!isPowerOf2(system->cacheLineSize()),
              "MemFootprintProbe expects cache line size is power of 2.");
     fatal_if(!isPowerOf2(p.page_size),
              "MemFootprintProbe expects page size parameter is power of 2");
+    fatal_if(p.page_size < system->cacheLineSize(),
+             "MemFootprintProbe expects page size to be at least the cache "
+             "line size");
+
+    if (!p.heatmap_file.empty()) {
+        heatmapStream = simout.create(p.heatmap_file, false);
+        fatal_if(!heatmapStream, "Unable to open heatmap file '%s'",
+                 p.heatmap_file);
+        *heatmapStream->stream()
+            << "interval,tick,page,requestor,demand,prefetch\n";
+        statistics::registerDumpCallback([this]() { dumpHeatmap(); });
+    }
+}
+
+MemFootprintProbe::~MemFootprintProbe()
+{
+    if (heatmapStream)
+        simout.close(heatmapStream);
 }
 
 MemFootprintProbe::MemFootprintProbeStats::MemFootprintProbeStats(
@@ -75,7 +99,14 @@ MemFootprintProbe::MemFootprintProbeStats::MemFootprintProbeStats(
                "Memory footprint at page granularity"),
       ADD_STAT(pageTotal, statistics::units::Count::get(),
                "Total memory footprint at page granularity since simulation "
-               "begin")
+               "begin"),
+      ADD_STAT(pagePrefetchOnly, statistics::units::Count::get(),
+               "Memory footprint at page granularity of pages only touched "
+               "by prefetches"),
+      ADD_STAT(demandAccesses, statistics::units::Count::get(),
+               "Number of demand accesses"),
+      ADD_STAT(prefetchAccesses, statistics::units::Count::get(),
+               "Number of prefetch accesses")
 {
     using namespace statistics;
     // clang-format off
@@ -83,15 +114,29 @@ MemFootprintProbe::MemFootprintProbeStats::MemFootprintProbeStats(
     cacheLineTotal.flags(nozero | nonan);
     page.flags(nozero | nonan);
     pageTotal.flags(nozero | nonan);
+    pagePrefetchOnly.flags(nozero | nonan);
     // clang-format on
     registerResetCallback([parent]() { parent->statReset(); });
 }
 
 void
-MemFootprintProbe::insertAddr(Addr addr, AddrSet *set, uint64_t limit)
+MemFootprintProbe::countAccess(PageInfo &page, RequestorID id,
+                               bool prefetch)
 {
-    set->insert(addr);
-    assert(set->size() <= limit);
+    if (!heatmapStream)
+        return;
+
+    // Only a handful of requestors touch any given page, so a linear
+    // search beats a map here
+    auto it = std::find_if(page.counts.begin(), page.counts.end(),
+        [id](const PageCount &c) { return c.id == id; });
+    if (it == page.counts.end())
+        it = page.counts.insert(it, PageCount{id, 0, 0});
+
+    if (prefetch)
+        it->prefetch++;
+    else
+        it->demand++;
 }
 
 void
@@ -100,27 +145,92 @@ MemFootprintProbe::handleRequest(const probing::PacketInfo &pi)
     if (!pi.cmd.isRequest() || !system->isMemAddr(pi.addr))
         return;
 
-    const Addr cl_addr = (pi.addr >> cacheLineSizeLg2) << cacheLineSizeLg2;
-    const Addr page_addr = (pi.addr >> pageSizeLg2) << pageSizeLg2;
-    insertAddr(cl_addr, &cacheLines, totalCacheLinesInMem);
-    insertAddr(cl_addr, &cacheLinesAll, totalCacheLinesInMem);
-    insertAddr(page_addr, &pages, totalPagesInMem);
-    insertAddr(page_addr, &pagesAll, totalPagesInMem);
+    const bool prefetch = pi.cmd.isPrefetch();
+    const Addr page_num = pi.addr >> pageSizeLg2;
+    const unsigned line =
+        (pi.addr & mask(pageSizeLg2)) >> cacheLineSizeLg2;
+
+    auto [it, inserted] = pageTable.try_emplace(page_num);
+    PageInfo &page = it->second;
+    if (inserted) {
+        page.lines.resize(lineWords, 0);
+        page.linesAll.resize(lineWords, 0);
+        pagesAll++;
+        assert(pagesAll <= totalPagesInMem);
+    }
 
-    assert(cacheLines.size() <= cacheLinesAll.size());
-    assert(pages.size() <= pagesAll.size());
+    if (!page.touched) {
+        page.touched = true;
+        pages++;
+        if (prefetch)
+            pagesPrefetchOnly++;
+        else
+            page.demanded = true;
+    } else if (!prefetch && !page.demanded) {
+        page.demanded = true;
+        pagesPrefetchOnly--;
+    }
+
+    if (setLine(page.lines, line))
+        cacheLines++;
+    if (setLine(page.linesAll, line)) {
+        cacheLinesAll++;
+        assert(cacheLinesAll <= totalCacheLinesInMem);
+    }
+
+    assert(cacheLines <= cacheLinesAll);
+    assert(pages <= pagesAll);
+
+    countAccess(page, pi.id, prefetch);
+    if (prefetch)
+        stats.prefetchAccesses++;
+    else
+        stats.demandAccesses++;
+
+    stats.cacheLine = cacheLines << cacheLineSizeLg2;
+    stats.cacheLineTotal = cacheLinesAll << cacheLineSizeLg2;
+    stats.page = pages << pageSizeLg2;
+    stats.pageTotal = pagesAll << pageSizeLg2;
+    stats.pagePrefetchOnly = pagesPrefetchOnly << pageSizeLg2;
+}
+
+void
+MemFootprintProbe::dumpHeatmap()
+{
+    // Sort the pages so that heatmaps of different runs can be diffed
+    std::vector<std::pair<Addr, PageInfo *>> hot;
+    for (auto &[page_num, page] : pageTable) {
+        if (!page.counts.empty())
+            hot.emplace_back(page_num, &page);
+    }
+    std::sort(hot.begin(), hot.end(),
+        [](const auto &a, const auto &b) { return a.first < b.first; });
 
-    stats.cacheLine = cacheLines.size() << cacheLineSizeLg2;
-    stats.cacheLineTotal = cacheLinesAll.size() << cacheLineSizeLg2;
-    stats.page = pages.size() << pageSizeLg2;
-    stats.pageTotal = pagesAll.size() << pageSizeLg2;
+    std::ostream &os = *heatmapStream->stream();
+    for (auto &[page_num, page] : hot) {
+        for (const auto &c : page->counts) {
+            ccprintf(os, "%d,%d,%#x,%s,%d,%d\n", heatmapInterval, curTick(),
+                     page_num << pageSizeLg2, system->getRequestorName(c.id),
+                     c.demand, c.prefetch);
+        }
+        page->counts.clear();
+    }
+    os.flush();
+    heatmapInterval++;
 }
 
 void
 MemFootprintProbe::statReset()
 {
-    cacheLines.clear();
-    pages.clear();
+    for (auto &[page_num, page] : pageTable) {
+        std::fill(page.lines.begin(), page.lines.end(), 0);
+        page.touched = false;
+        page.demanded = false;
+        page.counts.clear();
+    }
+    cacheLines = 0;
+    pages = 0;
+    pagesPrefetchOnly = 0;
 }
 
 } // namespace gem5
@@ -39,9 +39,11 @@
 #ifndef __MEM_PROBES_MEM_FOOTPRINT_HH__
 #define __MEM_PROBES_MEM_FOOTPRINT_HH__
 
-#include <unordered_set>
+#include <unordered_map>
+#include <vector>
 
 #include "base/callback.hh"
+#include "base/output.hh"
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
 #include "sim/stats.hh"
@@ -54,12 +56,15 @@ struct MemFootprintProbeParams;
 
 /// Probe to track footprint of accessed memory
 /// Two granularity of footprint measurement i.e. cache line and page
+///
+/// Touched lines are kept as one bitmap per page. Optionally, per-page
+/// access counts split by requestor and by demand vs. prefetch are
+/// written out as a heatmap every time stats are dumped.
 class MemFootprintProbe : public BaseMemProbe
 {
   public:
-    typedef std::unordered_set<Addr> AddrSet;
-
     MemFootprintProbe(const MemFootprintProbeParams &p);
+    ~MemFootprintProbe();
     // Fix footprint tracking state on stat reset
     void statReset();
 
@@ -70,10 +75,52 @@ class MemFootprintProbe : public BaseMemProbe
     const uint8_t pageSizeLg2;
     const uint64_t totalCacheLinesInMem;
     const uint64_t totalPagesInMem;
+    /// Number of 64-bit words in the line bitmap of a page
+    const unsigned lineWords;
+
+    /// Accesses to a page in the current heatmap interval
+    struct PageCount
+    {
+        RequestorID id;
+        uint64_t demand;
+        uint64_t prefetch;
+    };
 
-    void insertAddr(Addr addr, AddrSet *set, uint64_t limit);
+    struct PageInfo
+    {
+        /// Lines touched since the last stat reset
+        std::vector<uint64_t> lines;
+        /// Lines touched since simulation begin
+        std::vector<uint64_t> linesAll;
+        /// Page touched since the last stat reset
+        bool touched = false;
+        /// Page touched by a demand access since the last stat reset
+        bool demanded = false;
+        /// Accesses per requestor since the last heatmap dump
+        std::vector<PageCount> counts;
+    };
+
+    /**
+     * Set the bit of a line in a page bitmap.
+     *
+     * @return true if the line was not set before
+     */
+    static bool
+    setLine(std::vector<uint64_t> &bitmap, unsigned line)
+    {
+        uint64_t &word = bitmap[line / 64];
+        const uint64_t bit = 1ULL << (line % 64);
+        const bool was_set = word & bit;
+        word |= bit;
+        return !was_set;
+    }
+
+    void countAccess(PageInfo &page, RequestorID id, bool prefetch);
     void handleRequest(const probing::PacketInfo &pkt_info) override;
 
+    /// Write the per-page access counts of the interval ending now
+    void dumpHeatmap();
+
     struct MemFootprintProbeStats : public statistics::Group
     {
         MemFootprintProbeStats(MemFootprintProbe *parent);
@@ -86,18 +133,33 @@ class MemFootprintProbe : public BaseMemProbe
         statistics::Scalar page;
         /// Footprint at page granularity, since simulation begin
         statistics::Scalar pageTotal;
+        /// Footprint at page granularity of pages only prefetched
+        statistics::Scalar pagePrefetchOnly;
+        /// Number of demand accesses
+        statistics::Scalar demandAccesses;
+        /// Number of prefetch accesses
+        statistics::Scalar prefetchAccesses;
     };
 
-    // Addr set to track unique cache lines accessed
-    AddrSet cacheLines;
-    // Addr set to track unique cache lines accessed since simulation begin
-    AddrSet cacheLinesAll;
-    // Addr set to track unique pages accessed
-    AddrSet pages;
-    // Addr set to track unique pages accessed since simulation begin
-    AddrSet pagesAll;
+    /// Pages touched since simulation begin, keyed on page number
+    std::unordered_map<Addr, PageInfo> pageTable;
+    /// Unique cache lines accessed
+    uint64_t cacheLines;
+    /// Unique cache lines accessed since simulation begin
+    uint64_t cacheLinesAll;
+    /// Unique pages accessed
+    uint64_t pages;
+    /// Unique pages accessed since simulation begin
+    uint64_t pagesAll;
+    /// Pages accessed only by prefetches
+    uint64_t pagesPrefetchOnly;
     System *system;
 
+    /// Heatmap output, nullptr if disabled
+    OutputStream *heatmapStream;
+    /// Number of heatmap intervals written so far
+    uint64_t heatmapInterval;
+
     MemFootprintProbeStats stats;
 };
 
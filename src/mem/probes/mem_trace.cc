@@ -37,6 +37,8 @@
 
 #include "mem/probes/mem_trace.hh"
 
+#include <chrono>
+
 #include "base/callback.hh"
 #include "base/output.hh"
 #include "params/MemTraceProbe.hh"
@@ -52,8 +54,15 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
     : BaseMemProbe(p),
       traceStream(nullptr),
       system(p.system),
-      withPC(p.with_pc)
+      withPC(p.with_pc),
+      batchSize(p.batch_size),
+      threadedWriter(p.threaded_writer),
+      writePending(false),
+      writerStop(false),
+      stats(this)
 {
+    fatal_if(!batchSize, "%s: batch_size must not be 0.", name());
+
     std::string filename;
     if (p.trace_file != "") {
         // If the trace file is not specified as an absolute path,
@@ -98,30 +107,126 @@ MemTraceProbe::startup()
     }
 
     traceStream->write(header_msg);
+
+    fillBatch.reserve(batchSize);
+    if (threadedWriter) {
+        pendingBatch.reserve(batchSize);
+        writer = std::thread(&MemTraceProbe::writerMain, this);
+    }
 }
 
 void
 MemTraceProbe::closeStreams()
 {
-    if (traceStream != NULL)
-        delete traceStream;
+    if (traceStream == NULL)
+        return;
+
+    if (!fillBatch.empty())
+        flushBatch();
+
+    if (writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            writerStop = true;
+        }
+        writerCond.notify_all();
+        writer.join();
+    }
+
+    delete traceStream;
+    traceStream = NULL;
 }
 
 void
 MemTraceProbe::handleRequest(const probing::PacketInfo &pkt_info)
+{
+    fillBatch.push_back({curTick(), pkt_info.addr,
+                         withPC ? pkt_info.pc : 0, pkt_info.id,
+                         (uint32_t)pkt_info.cmd.toInt(),
+                         (uint32_t)pkt_info.flags, pkt_info.size});
+    ++stats.packets;
+
+    if (fillBatch.size() == batchSize)
+        flushBatch();
+}
+
+void
+MemTraceProbe::flushBatch()
+{
+    ++stats.batches;
+
+    if (!threadedWriter) {
+        writeBatch(fillBatch);
+        fillBatch.clear();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(writerMutex);
+    if (writePending) {
+        // The writer is behind, wait for it to free its batch
+        ++stats.writerStalls;
+        const auto start = std::chrono::steady_clock::now();
+        writerCond.wait(lock, [this]{ return !writePending; });
+        stats.writerStallTime += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+    fillBatch.swap(pendingBatch);
+    writePending = true;
+    lock.unlock();
+    writerCond.notify_all();
+
+    fillBatch.clear();
+}
+
+void
+MemTraceProbe::writeBatch(const std::vector<Record> &batch)
 {
     ProtoMessage::Packet pkt_msg;
+    for (const auto &r : batch) {
+        pkt_msg.Clear();
+        pkt_msg.set_tick(r.tick);
+        pkt_msg.set_cmd(r.cmd);
+        pkt_msg.set_flags(r.flags);
+        pkt_msg.set_addr(r.addr);
+        pkt_msg.set_size(r.size);
+        if (r.pc != 0)
+            pkt_msg.set_pc(r.pc);
+        pkt_msg.set_pkt_id(r.id);
+
+        traceStream->write(pkt_msg);
+    }
+}
+
+void
+MemTraceProbe::writerMain()
+{
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (true) {
+        writerCond.wait(lock, [this]{ return writePending || writerStop; });
+        if (!writePending)
+            return;
 
-    pkt_msg.set_tick(curTick());
-    pkt_msg.set_cmd(pkt_info.cmd.toInt());
-    pkt_msg.set_flags(pkt_info.flags);
-    pkt_msg.set_addr(pkt_info.addr);
-    pkt_msg.set_size(pkt_info.size);
-    if (withPC && pkt_info.pc != 0)
-        pkt_msg.set_pc(pkt_info.pc);
-    pkt_msg.set_pkt_id(pkt_info.id);
+        // The batch is ours until writePending is cleared
+        lock.unlock();
+        writeBatch(pendingBatch);
+        lock.lock();
 
-    traceStream->write(pkt_msg);
+        writePending = false;
+        writerCond.notify_all();
+    }
+}
+
+MemTraceProbe::MemTraceProbeStats::MemTraceProbeStats(MemTraceProbe *parent)
+    : statistics::Group(parent),
+      ADD_STAT(packets, statistics::units::Count::get(),
+               "Number of packets captured"),
+      ADD_STAT(batches, statistics::units::Count::get(),
+               "Number of packet batches written"),
+      ADD_STAT(writerStalls, statistics::units::Count::get(),
+               "Number of batches that waited for the writer thread"),
+      ADD_STAT(writerStallTime, statistics::units::Second::get(),
+               "Host time simulation waited for the writer thread")
+{
 }
 
 } // namespace gem5
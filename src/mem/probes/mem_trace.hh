@@ -38,6 +38,12 @@
 #ifndef __MEM_PROBES_MEM_TRACE_HH__
 #define __MEM_PROBES_MEM_TRACE_HH__
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "base/statistics.hh"
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
 #include "proto/protoio.hh"
@@ -73,8 +79,70 @@ class MemTraceProbe : public BaseMemProbe
 
   private:
 
+    /** A captured packet, encoded later by the writer */
+    struct Record
+    {
+        Tick tick;
+        Addr addr;
+        Addr pc;
+        uint64_t id;
+        uint32_t cmd;
+        uint32_t flags;
+        uint32_t size;
+    };
+
+    /** Hand the filled batch over to the writer and start a new one */
+    void flushBatch();
+
+    /** Encode a batch of records into the trace */
+    void writeBatch(const std::vector<Record> &batch);
+
+    /** Body of the writer thread */
+    void writerMain();
+
     /** Include the Program Counter in the memory trace */
     const bool withPC;
+
+    /** Number of records in a batch */
+    const unsigned batchSize;
+
+    /** Whether batches are written by a writer thread */
+    const bool threadedWriter;
+
+    /** The batch being filled by the simulation thread */
+    std::vector<Record> fillBatch;
+
+    /** The batch owned by the writer while writePending is set */
+    std::vector<Record> pendingBatch;
+
+    /** The writer thread */
+    std::thread writer;
+
+    /** Protects the hand-over of a batch */
+    std::mutex writerMutex;
+
+    /** Signalled when a batch is handed over or written */
+    std::condition_variable writerCond;
+
+    /** The writer has a batch to write */
+    bool writePending;
+
+    /** The writer is asked to exit once done */
+    bool writerStop;
+
+    struct MemTraceProbeStats : public statistics::Group
+    {
+        MemTraceProbeStats(MemTraceProbe *parent);
+
+        /** Packets captured */
+        statistics::Scalar packets;
+        /** Batches handed to the writer */
+        statistics::Scalar batches;
+        /** Batch hand-overs that had to wait for the writer */
+        statistics::Scalar writerStalls;
+        /** Host time the simulation waited for the writer */
+        statistics::Scalar writerStallTime;
+    } stats;
 };
 
 } // namespace gem5
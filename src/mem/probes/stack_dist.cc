@@ -48,7 +48,7 @@ StackDistProbe::StackDistProbe(const StackDistProbeParams &p)
       lineSize(p.line_size),
       disableLinearHists(p.disable_linear_hists),
       disableLogHists(p.disable_log_hists),
-      calc(p.verify),
+      calc(p.verify, p.sample_rate),
       stats(this)
 {
     fatal_if(p.system->cacheLineSize() > p.line_size,
@@ -105,6 +105,8 @@ StackDistProbe::handleRequest(const probing::PacketInfo &pkt_info)
 
     // Align the address to a cache line size
     const Addr aligned_addr(roundDown(pkt_info.addr, lineSize));
+    if (!calc.sampled(aligned_addr))
+        return;
 
     // Calculate the stack distance
     const uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
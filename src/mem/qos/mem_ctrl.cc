@@ -37,6 +37,7 @@
 
 #include "mem/qos/mem_ctrl.hh"
 
+#include "base/bitfield.hh"
 #include "mem/qos/policy.hh"
 #include "mem/qos/q_policy.hh"
 #include "mem/qos/turnaround_policy.hh"
@@ -81,6 +82,8 @@ MemCtrl::MemCtrl(const QoSMemCtrlParams &p)
 
     readQueueSizes.resize(_numPriorities);
     writeQueueSizes.resize(_numPriorities);
+    readPrioMask.resize(divCeil(_numPriorities, 64));
+    writePrioMask.resize(divCeil(_numPriorities, 64));
     serviceTick.resize(_numPriorities);
 }
 
@@ -110,6 +113,7 @@ MemCtrl::logRequest(BusState dir, RequestorID id, uint8_t _qos,
         writeQueueSizes[_qos] += entries;
         totalWriteQueueSize += entries;
     }
+    updatePrioMask(dir, _qos);
 
     packetPriorities[id][_qos] += entries;
     for (auto j = 0; j < entries; ++j) {
@@ -166,6 +170,7 @@ MemCtrl::logResponse(BusState dir, RequestorID id, uint8_t _qos,
         writeQueueSizes[_qos] -= entries;
         totalWriteQueueSize -= entries;
     }
+    updatePrioMask(dir, _qos);
 
     panic_if(packetPriorities[id][_qos] == 0,
              "qos::MemCtrl::logResponse requestor %s negative packets "
@@ -372,6 +377,17 @@ MemCtrl::recordTurnaroundStats(BusState busState, BusState busStateNext)
     }
 }
 
+uint8_t
+MemCtrl::queuedPriorities(BusState dir) const
+{
+    const auto &mask = dir == READ ? readPrioMask : writePrioMask;
+    for (int word = mask.size() - 1; word >= 0; --word) {
+        if (mask[word])
+            return word * 64 + findMsbSet(mask[word]) + 1;
+    }
+    return 0;
+}
+
 } // namespace qos
 } // namespace memory
 } // namespace gem5
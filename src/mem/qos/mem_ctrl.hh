@@ -126,6 +126,15 @@ class MemCtrl : public ClockedObject
     /** Write request packets queue length in #packets, per QoS priority */
     std::vector<uint64_t> writeQueueSizes;
 
+    /**
+     * @{
+     * Bitmaps of the QoS priorities with a non-empty queue, so that the
+     * highest one is found without walking all the priorities
+     */
+    std::vector<uint64_t> readPrioMask;
+    std::vector<uint64_t> writePrioMask;
+    /** @} */
+
     /** Total read request packets queue length in #packets */
     uint64_t totalReadQueueSize;
 
@@ -244,6 +253,33 @@ class MemCtrl : public ClockedObject
      */
     void recordTurnaroundStats(BusState busState, BusState busStateNext);
 
+    /**
+     * Refresh the priority bitmap of a direction after the queue size
+     * of a priority changed
+     *
+     * @param dir direction of the queue
+     * @param prio QoS priority of the queue
+     */
+    void
+    updatePrioMask(BusState dir, uint8_t prio)
+    {
+        auto &sizes = dir == READ ? readQueueSizes : writeQueueSizes;
+        uint64_t &word = (dir == READ ? readPrioMask : writePrioMask)[
+            prio / 64];
+        const uint64_t bit = 1ULL << (prio % 64);
+        word = sizes[prio] ? (word | bit) : (word & ~bit);
+    }
+
+    /**
+     * Number of QoS priorities a scheduler has to walk, from the highest
+     * down, to find every queued packet of a direction
+     *
+     * @param dir direction of the queues
+     * @return one past the highest priority with a non-empty queue, 0
+     *         if all the queues are empty
+     */
+    uint8_t queuedPriorities(BusState dir) const;
+
     /**
      * Escalates/demotes priority of all packets
      * belonging to the passed requestor to given
@@ -412,6 +448,8 @@ MemCtrl::escalateQueues(Queues& queues, uint64_t queue_entry_size,
                         requestors[id], tgt_prio);
                 readQueueSizes[curr_prio] -= moved_entries;
                 readQueueSizes[tgt_prio] += moved_entries;
+                updatePrioMask(READ, curr_prio);
+                updatePrioMask(READ, tgt_prio);
             } else if (pkt->isWrite()) {
                 panic_if(writeQueueSizes[curr_prio] < moved_entries,
                          "qos::MemCtrl::escalateQueues requestor %s negative "
@@ -419,6 +457,8 @@ MemCtrl::escalateQueues(Queues& queues, uint64_t queue_entry_size,
                         requestors[id], tgt_prio);
                 writeQueueSizes[curr_prio] -= moved_entries;
                 writeQueueSizes[tgt_prio] += moved_entries;
+                updatePrioMask(WRITE, curr_prio);
+                updatePrioMask(WRITE, tgt_prio);
             }
 
             // Change QoS priority and move packet
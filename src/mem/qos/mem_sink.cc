@@ -245,9 +245,10 @@ MemSinkCtrl::processNextReqEvent()
         }
     }
 
-    uint8_t curr_prio = numPriorities();
+    // Start from the highest priority with packets queued
+    uint8_t curr_prio = queuedPriorities(busState);
 
-    for (auto queue = (*queue_ptr).rbegin();
+    for (auto queue = (*queue_ptr).rbegin() + (numPriorities() - curr_prio);
          queue != (*queue_ptr).rend(); ++queue) {
 
         curr_prio--;
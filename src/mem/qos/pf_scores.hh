@@ -0,0 +1,159 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_QOS_PF_SCORES_HH__
+#define __MEM_QOS_PF_SCORES_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "mem/request.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace qos
+{
+
+/**
+ * Requestor scores of the proportional fair policy, kept sorted by
+ * decreasing score.
+ *
+ * Every requestor's score decays by (1 - weight) on each scheduling
+ * decision, and the served requestor additionally gains
+ * weight * served_bytes. The decay is common to all requestors and
+ * does not change their order, so it is applied lazily through a
+ * global scale factor: the stored scores are real scores divided by
+ * the scale. Each decision then only touches the served requestor,
+ * which moves towards the front of the order, instead of decaying
+ * every score and sorting them again.
+ */
+class PropFairScores
+{
+  public:
+    explicit PropFairScores(double _weight) : weight(_weight) {}
+
+    /**
+     * Add a requestor at the back of the order, with its initial score.
+     * The requestor is moved forward to its sorted position.
+     */
+    void
+    add(RequestorID id, double score)
+    {
+        if (id >= rank.size())
+            rank.resize(id + 1, Unranked);
+        assert(rank[id] == Unranked);
+        rank[id] = order.size();
+        order.emplace_back(id, score / scale);
+        promote(rank[id]);
+    }
+
+    /** Number of requestors with a score. */
+    size_t size() const { return order.size(); }
+
+    /**
+     * Decide the priority of a request and update the scores.
+     *
+     * @param id Requestor of the request.
+     * @param served_bytes Bytes served by the request.
+     * @return Position of the requestor in the order before the update,
+     *         i.e. its QoS priority, or 0 if it has no score.
+     */
+    uint8_t
+    schedule(RequestorID id, uint64_t served_bytes)
+    {
+        scale *= 1.0 - weight;
+
+        if (id >= rank.size() || rank[id] == Unranked)
+            return 0;
+
+        const unsigned pos = rank[id];
+
+        // Fold the scale into the stored scores before adding to them
+        // would lose precision or overflow
+        if (scale < MinScale)
+            renormalize();
+
+        order[pos].second += weight * served_bytes / scale;
+        promote(pos);
+
+        return pos;
+    }
+
+    /** Current score of a requestor, which must have one. */
+    double
+    score(RequestorID id) const
+    {
+        assert(id < rank.size() && rank[id] != Unranked);
+        return order[rank[id]].second * scale;
+    }
+
+  private:
+    static constexpr unsigned Unranked = ~0U;
+    static constexpr double MinScale = 1e-100;
+
+    /** Move the entry at pos up while its score beats its predecessor. */
+    void
+    promote(unsigned pos)
+    {
+        while (pos > 0 && order[pos].second > order[pos - 1].second) {
+            std::swap(order[pos], order[pos - 1]);
+            rank[order[pos].first] = pos;
+            --pos;
+        }
+        rank[order[pos].first] = pos;
+    }
+
+    void
+    renormalize()
+    {
+        for (auto &entry : order)
+            entry.second *= scale;
+        scale = 1.0;
+    }
+
+    /** PF Policy weight */
+    const double weight;
+
+    /** Factor turning stored scores into real scores */
+    double scale = 1.0;
+
+    /** Requestors and their stored scores, by decreasing score */
+    std::vector<std::pair<RequestorID, double>> order;
+
+    /** Position of each requestor in the order, indexed by id */
+    std::vector<unsigned> rank;
+};
+
+} // namespace qos
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_QOS_PF_SCORES_HH__
@@ -37,8 +37,6 @@
 
 #include "mem/qos/policy_pf.hh"
 
-#include <algorithm>
-
 #include "base/logging.hh"
 #include "params/QoSPropFairPolicy.hh"
 
@@ -52,7 +50,7 @@ namespace qos
 {
 
 PropFairPolicy::PropFairPolicy(const Params &p)
-  : Policy(p), weight(p.weight)
+  : Policy(p), weight(p.weight), history(weight)
 {
     fatal_if(weight < 0 || weight > 1,
         "weight must be a value between 0 and 1");
@@ -70,7 +68,7 @@ PropFairPolicy::initRequestor(const Requestor requestor, const double score)
     assert(id != Request::invldRequestorId);
 
     // Setting the Initial score for the selected requestor.
-    history.push_back(std::make_pair(id, score));
+    history.add(id, score);
 
     fatal_if(history.size() > memCtrl->numPriorities(),
         "Policy's maximum number of requestors is currently dictated "
@@ -89,44 +87,13 @@ PropFairPolicy::initRequestorObj(const SimObject* requestor, const double score)
     initRequestor(requestor, score);
 }
 
-double
-PropFairPolicy::updateScore(
-    const double old_score, const uint64_t served_bytes) const
-{
-    return ((1.0 - weight) * old_score) + (weight * served_bytes);
-}
-
 uint8_t
 PropFairPolicy::schedule(const RequestorID pkt_id, const uint64_t pkt_size)
 {
-    auto sort_pred =
-    [] (const RequestorHistory& lhs, const RequestorHistory& rhs)
-    { return lhs.second > rhs.second; };
-
-    // Sorting in reverse in base of personal history:
-    // First elements have higher history/score -> lower priority.
-    // The qos priority is the position in the sorted vector.
-    std::sort(history.begin(), history.end(), sort_pred);
-
-    const double served_bytes = static_cast<double>(pkt_size);
-
-    uint8_t pkt_priority = 0;
-    for (auto m_hist = history.begin(); m_hist != history.end(); m_hist++) {
-
-        RequestorID curr_id = m_hist->first;
-        double& curr_score = m_hist->second;
-
-        if (curr_id == pkt_id) {
-            // The qos priority is the position in the sorted vector.
-            pkt_priority = std::distance(history.begin(), m_hist);
-
-            curr_score = updateScore(curr_score, served_bytes);
-        } else {
-            curr_score = updateScore(curr_score, 0);
-        }
-    }
-
-    return pkt_priority;
+    // The history is sorted in reverse in base of personal history:
+    // first elements have higher history/score -> lower priority.
+    // The qos priority is the position in the sorted history.
+    return history.schedule(pkt_id, pkt_size);
 }
 
 } // namespace qos
@@ -38,9 +38,8 @@
 #ifndef __MEM_QOS_POLICY_PF_HH__
 #define __MEM_QOS_POLICY_PF_HH__
 
-#include <vector>
-
 #include "base/compiler.hh"
+#include "mem/qos/pf_scores.hh"
 #include "mem/qos/policy.hh"
 #include "mem/request.hh"
 
@@ -65,6 +64,9 @@ namespace qos
  *
  * This is the formula used by the policy
  * ((1.0 - weight) * old_score) + (weight * served_bytes);
+ *
+ * The scores are kept sorted as they are updated, so that a
+ * scheduling decision only touches the served requestor.
  */
 class PropFairPolicy : public Policy
 {
@@ -108,16 +110,12 @@ class PropFairPolicy : public Policy
     template <typename Requestor>
     void initRequestor(const Requestor requestor, const double score);
 
-    inline double
-    updateScore(const double old_score, const uint64_t served_bytes) const;
-
   protected:
     /** PF Policy weight */
     const double weight;
 
     /** history is keeping track of every requestor's score */
-    using RequestorHistory = std::pair<RequestorID, double>;
-    std::vector<RequestorHistory> history;
+    PropFairScores history;
 };
 
 } // namespace qos
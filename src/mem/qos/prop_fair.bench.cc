@@ -0,0 +1,113 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/microbench.hh"
+#include "mem/qos/pf_scores.hh"
+
+using namespace gem5;
+using namespace gem5::memory::qos;
+
+namespace
+{
+
+constexpr double Weight = 0.5;
+
+/**
+ * The scores as PropFairPolicy::schedule() used to update them: sort
+ * all of them, then decay every one of them.
+ */
+class SortedHistory
+{
+  public:
+    void add(RequestorID id, double score) { history.emplace_back(id, score); }
+
+    uint8_t
+    schedule(RequestorID id, uint64_t served_bytes)
+    {
+        std::sort(history.begin(), history.end(),
+            [](const auto &lhs, const auto &rhs)
+            { return lhs.second > rhs.second; });
+
+        uint8_t prio = 0;
+        for (size_t i = 0; i < history.size(); ++i) {
+            double &score = history[i].second;
+            if (history[i].first == id) {
+                prio = i;
+                score = (1.0 - Weight) * score + Weight * served_bytes;
+            } else {
+                score = (1.0 - Weight) * score;
+            }
+        }
+        return prio;
+    }
+
+  private:
+    std::vector<std::pair<RequestorID, double>> history;
+};
+
+/**
+ * Schedule a stream of requests from a set of requestors, a quarter of
+ * which issue most of the traffic.
+ */
+template <class Scores>
+void
+arbitrate(microbench::State &state, Scores &scores)
+{
+    const unsigned requestors = state.range();
+    for (unsigned id = 0; id < requestors; ++id)
+        scores.add(id, 0);
+
+    uint64_t lfsr = 0xace1;
+    for (auto _ : state) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xd0000001u);
+        const unsigned group = (lfsr & 3) ? requestors / 4 : requestors;
+        const RequestorID id = (lfsr >> 2) % std::max(group, 1U);
+        microbench::doNotOptimize(scores.schedule(id, 64));
+    }
+}
+
+} // anonymous namespace
+
+/** Priority decisions of PropFairPolicy with a sort per decision. */
+static void
+propFairSort(microbench::State &state)
+{
+    SortedHistory scores;
+    arbitrate(state, scores);
+}
+GEM5_BENCHMARK(propFairSort)->arg(8)->arg(32)->arg(128)->arg(255);
+
+/** The same decisions with PropFairScores. */
+static void
+propFairScores(microbench::State &state)
+{
+    PropFairScores scores(Weight);
+    arbitrate(state, scores);
+}
+GEM5_BENCHMARK(propFairScores)->arg(8)->arg(32)->arg(128)->arg(255);
@@ -60,9 +60,11 @@
 #include "base/compiler.hh"
 #include "base/extensible.hh"
 #include "base/flags.hh"
+#include "base/slab_pool.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
 #include "mem/htm.hh"
+#include "mem/packet_pool.hh"
 #include "sim/cur_tick.hh"
 
 namespace gem5
@@ -92,6 +94,10 @@ class Request;
 class ThreadContext;
 
 typedef std::shared_ptr<Request> RequestPtr;
+
+template <typename... Args>
+RequestPtr makeRequest(Args&&... args);
+
 typedef uint16_t RequestorID;
 
 class Request : public Extensible<Request>
@@ -537,7 +543,7 @@ class Request : public Extensible<Request>
     static RequestPtr
     createMemManagement(Flags flags, RequestorID id)
     {
-        auto mgmt_req = std::make_shared<Request>();
+        auto mgmt_req = makeRequest();
         mgmt_req->_flags.set(flags);
         mgmt_req->_requestorId = id;
         mgmt_req->_time = curTick();
@@ -619,8 +625,8 @@ class Request : public Extensible<Request>
         assert(hasVaddr());
         assert(!hasPaddr());
         assert(split_addr > _vaddr && split_addr < _vaddr + _size);
-        req1 = std::make_shared<Request>(*this);
-        req2 = std::make_shared<Request>(*this);
+        req1 = makeRequest(*this);
+        req2 = makeRequest(*this);
         req1->_size = split_addr - _vaddr;
         req2->_vaddr = split_addr;
         req2->_size = _size - req1->_size;
@@ -1141,6 +1147,18 @@ class Request : public Extensible<Request>
     }
 };
 
+/**
+ * Create a request, like std::make_shared<Request>(), but allocate the
+ * request and its control block from the per-thread request pool.
+ */
+template <typename... Args>
+RequestPtr
+makeRequest(Args&&... args)
+{
+    return std::allocate_shared<Request>(
+        SlabAllocator<Request>(requestPool()), std::forward<Args>(args)...);
+}
+
 } // namespace gem5
 
 #endif // __MEM_REQUEST_HH__
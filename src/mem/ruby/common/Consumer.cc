@@ -40,18 +40,28 @@
 
 #include "mem/ruby/common/Consumer.hh"
 
+#include "mem/ruby/network/MessageBuffer.hh"
+
 namespace gem5
 {
 
 namespace ruby
 {
 
+uint64_t Consumer::m_wakeup_count = 0;
+
 Consumer::Consumer(ClockedObject *_em, Event::Priority ev_prio)
     : m_wakeup_event([this]{ processCurrentEvent(); },
                     "Consumer Event", false, ev_prio),
       em(_em)
 { }
 
+void
+Consumer::notifyEnqueue(MessageBuffer *buffer)
+{
+    storeEventInfo(buffer->getVnet());
+}
+
 void
 Consumer::scheduleEvent(Cycles timeDelta)
 {
@@ -91,6 +101,7 @@ Consumer::processCurrentEvent()
     // remove the current tick from the wakeup list, wake up, and then schedule
     // the next wakeup
     m_wakeup_ticks.erase(curr);
+    m_wakeup_count++;
     wakeup();
     scheduleNextWakeup();
 }
@@ -58,6 +58,8 @@ namespace gem5
 namespace ruby
 {
 
+class MessageBuffer;
+
 class Consumer
 {
   public:
@@ -72,6 +74,10 @@ class Consumer
     virtual void print(std::ostream& out) const = 0;
     virtual void storeEventInfo(int info) {}
 
+    // Called when a message is enqueued in one of the buffers this
+    // consumes. By default, passes the buffer's vnet to storeEventInfo().
+    virtual void notifyEnqueue(MessageBuffer *buffer);
+
     bool
     alreadyScheduled(Tick time)
     {
@@ -87,7 +93,16 @@ class Consumer
     void scheduleEventAbsolute(Tick timeAbs);
     void scheduleEvent(Cycles timeDelta);
 
+    /**
+     * Number of scheduled wakeups processed by all consumers so far.
+     * Controllers only change the state of their lines while woken
+     * up, so state observed while this is unchanged is still current.
+     */
+    static uint64_t wakeupCount() { return m_wakeup_count; }
+
   private:
+    static uint64_t m_wakeup_count;
+
     std::set<Tick> m_wakeup_ticks;
     EventFunctionWrapper m_wakeup_event;
     ClockedObject *em;
@@ -137,7 +137,7 @@ MessageBuffer::getSize(Tick curTime)
 {
     if (m_time_last_time_size_checked != curTime) {
         m_time_last_time_size_checked = curTime;
-        m_size_last_time_size_checked = m_prio_heap.size();
+        m_size_last_time_size_checked = m_msg_queue.size();
     }
 
     return m_size_last_time_size_checked;
@@ -152,6 +152,13 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
         return true;
     }
 
+    // the occupancy is only known on the consumer side, so there is no
+    // way for a producer on another event queue to get it right
+    fatal_if(m_consumer &&
+             m_consumer->getObject()->eventQueue() != curEventQueue(),
+             "%s: a finite buffer can't cross event queues, use an "
+             "infinite buffer and the flow control of the network", name());
+
     // determine the correct size for the current cycle
     // pop operations shouldn't effect the network's visible size
     // until schd cycle, but enqueue operations effect the visible
@@ -161,7 +168,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
 
     if (m_time_last_time_pop < current_time) {
         // no pops this cycle - heap and stall queue size is correct
-        current_size = m_prio_heap.size();
+        current_size = m_msg_queue.size();
         current_stall_size = m_stall_map_size;
     } else {
         if (m_time_last_time_enqueue < current_time) {
@@ -184,7 +191,7 @@ MessageBuffer::areNSlotsAvailable(unsigned int n, Tick current_time)
         DPRINTF(RubyQueue, "n: %d, current_size: %d, heap size: %d, "
                 "m_max_size: %d\n",
                 n, current_size + current_stall_size,
-                m_prio_heap.size(), m_max_size);
+                m_msg_queue.size(), m_max_size);
         m_not_avail_count++;
         return false;
     }
@@ -194,7 +201,7 @@ const Message*
 MessageBuffer::peek() const
 {
     DPRINTF(RubyQueue, "Peeking at head of queue.\n");
-    const Message* msg_ptr = m_prio_heap.front().get();
+    const Message* msg_ptr = m_msg_queue.front().get();
     assert(msg_ptr);
 
     DPRINTF(RubyQueue, "Message: %s\n", (*msg_ptr));
@@ -203,13 +210,12 @@ MessageBuffer::peek() const
 
 // FIXME - move me somewhere else
 Tick
-random_time()
+random_time(Random &rng)
 {
-    static Random::RandomPtr rng(Random::genRandom());
     Tick time = 1;
-    time += rng->random(0, 3);  // [0...3]
-    if (rng->random(0, 7) == 0) {  // 1 in 8 chance
-        time += 100 + rng->random(1, 15); // 100 + [1...15]
+    time += rng.random(0, 3);  // [0...3]
+    if (rng.random(0, 7) == 0) {  // 1 in 8 chance
+        time += 100 + rng.random(1, 15); // 100 + [1...15]
     }
     return time;
 }
@@ -247,9 +253,9 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
             if (m_last_arrival_time < current_time) {
                 m_last_arrival_time = current_time;
             }
-            arrival_time = m_last_arrival_time + random_time();
+            arrival_time = m_last_arrival_time + random_time(*rng);
         } else {
-            arrival_time = current_time + random_time();
+            arrival_time = current_time + random_time(*rng);
         }
     }
 
@@ -283,22 +289,49 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
     msg_ptr->setLastEnqueueTime(arrival_time);
     msg_ptr->setMsgCounter(m_msg_counter);
 
-    // Insert the message into the priority heap
-    m_prio_heap.push_back(message);
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    DPRINTF(RubyQueue, "Enqueue arrival_time: %lld, Message: %s\n",
+            arrival_time, *msg_ptr);
+
+    assert(m_consumer != NULL);
+    EventQueue *consumer_queue = m_consumer->getObject()->eventQueue();
+    if (consumer_queue == curEventQueue()) {
+        deliver(std::move(message), arrival_time);
+        return;
+    }
+
+    // The consumer runs on another event queue. The message is handed
+    // over by an event on that queue, which is inserted asynchronously
+    // and so can only be relied on from the next quantum on. That is
+    // fine as long as the message doesn't arrive before then, i.e., as
+    // long as the quantum doesn't exceed the latency of the crossing.
+    Tick deliver_at = curTick() + simQuantum;
+    panic_if(arrival_time < deliver_at,
+             "%s: message crosses event queues with a delay of %d ticks, "
+             "below the simulation quantum of %d ticks", name(),
+             arrival_time - curTick(), simQuantum);
+
+    consumer_queue->schedule(new EventFunctionWrapper(
+            [this, message, arrival_time]() mutable {
+                deliver(std::move(message), arrival_time);
+            },
+            name() + ".deliver", true, Event::Default_Pri - 1),
+        deliver_at);
+}
+
+void
+MessageBuffer::deliver(MsgPtr &&message, Tick arrival_time)
+{
+    // Insert the message into the queue
+    insertMessage(std::move(message));
     // Increment the number of messages statistic
     m_buf_msgs++;
 
     assert((m_max_size == 0) ||
-           ((m_prio_heap.size() + m_stall_map_size) <= m_max_size));
-
-    DPRINTF(RubyQueue, "Enqueue arrival_time: %lld, Message: %s\n",
-            arrival_time, *(message.get()));
+           ((m_msg_queue.size() + m_stall_map_size) <= m_max_size));
 
     // Schedule the wakeup
-    assert(m_consumer != NULL);
     m_consumer->scheduleEventAbsolute(arrival_time);
-    m_consumer->storeEventInfo(m_vnet_id);
+    m_consumer->notifyEnqueue(this);
 }
 
 Tick
@@ -307,8 +340,8 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     DPRINTF(RubyQueue, "Popping\n");
     assert(isReady(current_time));
 
-    // get MsgPtr of the message about to be dequeued
-    MsgPtr message = m_prio_heap.front();
+    // get the message about to be dequeued
+    Message *message = m_msg_queue.front().get();
 
     // get the delay cycles
     message->updateDelayedTicks(current_time);
@@ -317,15 +350,13 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     // record previous size and time so the current buffer size isn't
     // adjusted until schd cycle
     if (m_time_last_time_pop < current_time) {
-        m_size_at_cycle_start = m_prio_heap.size();
+        m_size_at_cycle_start = m_msg_queue.size();
         m_stalled_at_cycle_start = m_stall_map_size;
         m_time_last_time_pop = current_time;
         m_dequeues_this_cy = 0;
     }
     ++m_dequeues_this_cy;
 
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
-    m_prio_heap.pop_back();
     if (decrement_messages) {
         // Record how much time is passed since the message was enqueued
         m_stall_time += curTick() - message->getLastEnqueueTime();
@@ -335,6 +366,7 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
         // number of message in the queue.
         m_buf_msgs--;
     }
+    m_msg_queue.pop_front();
 
     // if a dequeue callback was requested, call it now
     if (m_dequeue_callback) {
@@ -359,7 +391,7 @@ MessageBuffer::unregisterDequeueCallback()
 void
 MessageBuffer::clear()
 {
-    m_prio_heap.clear();
+    m_msg_queue.clear();
 
     m_msg_counter = 0;
     m_time_last_time_enqueue = 0;
@@ -374,33 +406,46 @@ MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
 {
     DPRINTF(RubyQueue, "Recycling.\n");
     assert(isReady(current_time));
-    MsgPtr node = m_prio_heap.front();
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    MsgPtr node = std::move(m_msg_queue.front());
+    m_msg_queue.pop_front();
 
     Tick future_time = current_time + recycle_latency;
     node->setLastEnqueueTime(future_time);
 
-    m_prio_heap.back() = node;
-    push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    insertMessage(std::move(node));
     m_consumer->scheduleEventAbsolute(future_time);
 }
 
+void
+MessageBuffer::insertMessage(MsgPtr &&message)
+{
+    // fast path: the message arrives after all the queued ones
+    if (m_msg_queue.empty() || message > m_msg_queue.back()) {
+        m_msg_queue.push_back(std::move(message));
+        return;
+    }
+
+    auto pos = std::upper_bound(m_msg_queue.begin(), m_msg_queue.end(),
+                                message,
+                                [](const MsgPtr &lhs, const MsgPtr &rhs)
+                                { return rhs > lhs; });
+    m_msg_queue.insert(pos, std::move(message));
+}
+
 void
 MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
 {
     while (!lt.empty()) {
-        MsgPtr m = lt.front();
+        MsgPtr &m = lt.front();
         assert(m->getLastEnqueueTime() <= schdTick);
 
-        m_prio_heap.push_back(m);
-        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                  std::greater<MsgPtr>());
-
-        m_consumer->scheduleEventAbsolute(schdTick);
-
         DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
             schdTick, *(m.get()));
 
+        insertMessage(std::move(m));
+
+        m_consumer->scheduleEventAbsolute(schdTick);
+
         lt.pop_front();
     }
 }
@@ -413,7 +458,7 @@ MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
 
     //
     // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // message queue.  The reanalyzeList call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle
     //
@@ -430,7 +475,7 @@ MessageBuffer::reanalyzeAllMessages(Tick current_time)
 
     //
     // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // message queue.  The reanalyzeList call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle.
     //
@@ -448,7 +493,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
 {
     DPRINTF(RubyQueue, "Stalling due to %#x\n", addr);
     assert(isReady(current_time));
-    MsgPtr message = m_prio_heap.front();
+    MsgPtr message = m_msg_queue.front();
 
     // Since the message will just be moved to stall map, indicate that the
     // buffer should not decrement the m_buf_msgs statistic
@@ -459,7 +504,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     // Instead the controller is responsible to call reanalyzeMessages when
     // these addresses change state.
     //
-    (m_stall_msg_map[addr]).push_back(message);
+    (m_stall_msg_map[addr]).push_back(std::move(message));
     m_stall_map_size++;
     m_stall_count++;
 }
@@ -475,7 +520,7 @@ MessageBuffer::deferEnqueueingMessage(Addr addr, MsgPtr message)
 {
     DPRINTF(RubyQueue, "Deferring enqueueing message: %s, Address %#x\n",
             *(message.get()), addr);
-    (m_deferred_msg_map[addr]).push_back(message);
+    (m_deferred_msg_map[addr]).push_back(std::move(message));
 }
 
 void
@@ -487,8 +532,8 @@ MessageBuffer::enqueueDeferredMessages(Addr addr, Tick curTime, Tick delay,
     assert(msg_vec.size() > 0);
 
     // enqueue all deferred messages associated with this address
-    for (MsgPtr m : msg_vec) {
-        enqueue(m, curTime, delay, ruby_is_random, ruby_warmup);
+    for (MsgPtr &m : msg_vec) {
+        enqueue(std::move(m), curTime, delay, ruby_is_random, ruby_warmup);
     }
 
     msg_vec.clear();
@@ -509,9 +554,7 @@ MessageBuffer::print(std::ostream& out) const
         ccprintf(out, " consumer-yes ");
     }
 
-    std::vector<MsgPtr> copy(m_prio_heap);
-    std::sort_heap(copy.begin(), copy.end(), std::greater<MsgPtr>());
-    ccprintf(out, "%s] %s", copy, name());
+    ccprintf(out, "%s] %s", m_msg_queue, name());
 }
 
 bool
@@ -521,8 +564,8 @@ MessageBuffer::isReady(Tick current_time) const
     bool can_dequeue = (m_max_dequeue_rate == 0) ||
                        (m_time_last_time_pop < current_time) ||
                        (m_dequeues_this_cy < m_max_dequeue_rate);
-    bool is_ready = (m_prio_heap.size() > 0) &&
-                   (m_prio_heap.front()->getLastEnqueueTime() <= current_time);
+    bool is_ready = (m_msg_queue.size() > 0) &&
+                   (m_msg_queue.front()->getLastEnqueueTime() <= current_time);
     if (!can_dequeue && is_ready) {
         // Make sure the Consumer executes next cycle to dequeue the ready msg
         m_consumer->scheduleEvent(Cycles(1));
@@ -533,10 +576,10 @@ MessageBuffer::isReady(Tick current_time) const
 Tick
 MessageBuffer::readyTime() const
 {
-    if (m_prio_heap.empty())
+    if (m_msg_queue.empty())
         return MaxTick;
     else
-        return m_prio_heap.front()->getLastEnqueueTime();
+        return m_msg_queue.front()->getLastEnqueueTime();
 }
 
 uint32_t
@@ -547,10 +590,10 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
 
     uint32_t num_functional_accesses = 0;
 
-    // Check the priority heap and write any messages that may
+    // Check the message queue and write any messages that may
     // correspond to the address in the packet.
-    for (unsigned int i = 0; i < m_prio_heap.size(); ++i) {
-        Message *msg = m_prio_heap[i].get();
+    for (const MsgPtr &msg_ptr : m_msg_queue) {
+        Message *msg = msg_ptr.get();
         if (is_read && !mask && msg->functionalRead(pkt))
             return 1;
         else if (is_read && mask && msg->functionalRead(pkt, *mask))
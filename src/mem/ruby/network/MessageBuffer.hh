@@ -48,12 +48,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/RubyQueue.hh"
 #include "mem/packet.hh"
@@ -63,6 +65,7 @@
 #include "mem/ruby/network/dummy_port.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 #include "params/MessageBuffer.hh"
+#include "sim/eventq.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -93,11 +96,10 @@ class MessageBuffer : public SimObject
     delayHead(Tick current_time, Tick delta, bool ruby_is_random,
               bool ruby_warmup)
     {
-        MsgPtr m = m_prio_heap.front();
-        std::pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                      std::greater<MsgPtr>());
-        m_prio_heap.pop_back();
-        enqueue(m, current_time, delta, ruby_is_random, ruby_warmup);
+        MsgPtr m = std::move(m_msg_queue.front());
+        m_msg_queue.pop_front();
+        enqueue(std::move(m), current_time, delta, ruby_is_random,
+                ruby_warmup);
     }
 
     bool areNSlotsAvailable(unsigned int n, Tick curTime);
@@ -122,7 +124,7 @@ class MessageBuffer : public SimObject
     //! message queue.  The function assumes that the queue is nonempty.
     const Message* peek() const;
 
-    const MsgPtr &peekMsgPtr() const { return m_prio_heap.front(); }
+    const MsgPtr &peekMsgPtr() const { return m_msg_queue.front(); }
 
     void enqueue(MsgPtr message, Tick curTime, Tick delta,
                 bool ruby_is_random, bool ruby_warmup,
@@ -149,7 +151,7 @@ class MessageBuffer : public SimObject
     void unregisterDequeueCallback();
 
     void recycle(Tick current_time, Tick recycle_latency);
-    bool isEmpty() const { return m_prio_heap.size() == 0; }
+    bool isEmpty() const { return m_msg_queue.empty(); }
     bool isStallMapEmpty() { return m_stall_msg_map.size() == 0; }
     unsigned int getStallMapSize() { return m_stall_msg_map.size(); }
 
@@ -199,13 +201,34 @@ class MessageBuffer : public SimObject
   private:
     void reanalyzeList(std::list<MsgPtr> &, Tick);
 
+    /**
+     * Insert a message in m_msg_queue at the position given by its
+     * arrival time and message counter.
+     */
+    void insertMessage(MsgPtr &&message);
+
+    /**
+     * Make an enqueued message visible to the consumer. This runs on the
+     * event queue of the consumer, which may not be the one of the
+     * producer that enqueued the message.
+     */
+    void deliver(MsgPtr &&message, Tick arrival_time);
+
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
   private:
     // Data Members (m_ prefix)
     //! Consumer to signal a wakeup(), can be NULL
     Consumer* m_consumer;
-    std::vector<MsgPtr> m_prio_heap;
+
+    /**
+     * The messages in the buffer, sorted by arrival time and then by
+     * message counter, i.e., in the order they will be dequeued. Almost
+     * all messages are enqueued with the same delay, so they arrive in
+     * order and are appended at the back; messages that arrive earlier
+     * than the last one are inserted at their position.
+     */
+    std::deque<MsgPtr> m_msg_queue;
 
     std::function<void()> m_dequeue_callback;
 
@@ -216,14 +239,14 @@ class MessageBuffer : public SimObject
     /**
      * A map from line addresses to lists of stalled messages for that line.
      * If this buffer allows the receiver to stall messages, on a stall
-     * request, the stalled message is removed from the m_prio_heap and placed
+     * request, the stalled message is removed from the m_msg_queue and placed
      * in the m_stall_msg_map. Messages are held there until the receiver
      * requests they be reanalyzed, at which point they are moved back to
-     * m_prio_heap.
+     * m_msg_queue.
      *
      * NOTE: The stall map holds messages in the order in which they were
      * initially received, and when a line is unblocked, the messages are
-     * moved back to the m_prio_heap in the same order. This prevents starving
+     * moved back to the m_msg_queue in the same order. This prevents starving
      * older requests with younger ones.
      */
     StallMsgMapType m_stall_msg_map;
@@ -240,7 +263,7 @@ class MessageBuffer : public SimObject
      * Current size of the stall map.
      * Track the number of messages held in stall map lists. This is used to
      * ensure that if the buffer is finite-sized, it blocks further requests
-     * when the m_prio_heap and m_stall_msg_map contain m_max_size messages.
+     * when the m_msg_queue and m_stall_msg_map contain m_max_size messages.
      */
     int m_stall_map_size;
 
@@ -284,6 +307,9 @@ class MessageBuffer : public SimObject
 
     const int m_routing_priority;
 
+    /** Stream for the randomized arrival times of this buffer */
+    Random::RandomPtr rng = Random::genRandom(name());
+
     int m_input_link_id;
     int m_vnet_id;
 
@@ -297,7 +323,7 @@ class MessageBuffer : public SimObject
     statistics::Formula m_occupancy;
 };
 
-Tick random_time();
+Tick random_time(Random &rng);
 
 inline std::ostream&
 operator<<(std::ostream& out, const MessageBuffer& obj)
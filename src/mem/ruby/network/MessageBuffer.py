@@ -49,6 +49,11 @@ class MessageRandomization(ScopedEnum):
     vals = ["disabled", "enabled", "ruby_system"]
 
 
+# The producer and consumer of a MessageBuffer may run on different event
+# queues (see eventq_index). Messages then cross over through the
+# asynchronous event insertion path, which requires the buffer to be
+# infinite and every message delay across it to be at least the
+# simulation quantum.
 class MessageBuffer(SimObject):
     type = "MessageBuffer"
     cxx_class = "gem5::ruby::MessageBuffer"
@@ -38,6 +38,11 @@ class CDCType(Enum):
     vals = ["LINK_OBJECT", "OBJECT_LINK"]
 
 
+# A NetworkLink has to use the event queue of its source, but its consumer
+# may be on another event queue if the link latency is at least the
+# simulation quantum. This allows partitioning a Garnet network across
+# event queues along its links, with each network interface on the event
+# queue of its controller.
 class NetworkLink(ClockedObject):
     type = "NetworkLink"
     cxx_header = "mem/ruby/network/garnet/NetworkLink.hh"
@@ -33,6 +33,7 @@
 #define __MEM_RUBY_NETWORK_GARNET_0_GARNETNETWORK_HH__
 
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 #include "mem/ruby/network/Network.hh"
@@ -117,6 +118,20 @@ class GarnetNetwork : public Network
     void resetStats();
     void print(std::ostream& out) const;
 
+    /**
+     * The network interfaces update the counters below and may run on
+     * different event queues, so the updates are serialized when
+     * simulating in parallel. Hold the lock across a group of updates.
+     */
+    std::unique_lock<std::mutex>
+    lockStats()
+    {
+        std::unique_lock<std::mutex> lock(statsMutex, std::defer_lock);
+        if (inParallelMode)
+            lock.lock();
+        return lock;
+    }
+
     // increment counters
     void increment_injected_packets(int vnet) { m_packets_injected[vnet]++; }
     void increment_received_packets(int vnet) { m_packets_received[vnet]++; }
@@ -154,7 +169,7 @@ class GarnetNetwork : public Network
         m_total_hops += hops;
     }
 
-    void update_traffic_distribution(RouteInfo route);
+    void update_traffic_distribution(const RouteInfo &route);
     int getNextPacketID() { return m_next_packet_id++; }
 
   protected:
@@ -214,6 +229,7 @@ class GarnetNetwork : public Network
     std::vector<CreditLink *> m_creditlinks; // All credit links in the network
     std::vector<NetworkInterface *> m_nis;   // All NI's in Network
     int m_next_packet_id; // static vairable for packet id allocation
+    std::mutex statsMutex;
 };
 
 inline std::ostream&
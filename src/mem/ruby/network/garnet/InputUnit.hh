@@ -116,9 +116,14 @@ class InputUnit : public Consumer
     inline flit*
     getTopFlit(int vc)
     {
+        assert(m_num_buffered_flits > 0);
+        m_num_buffered_flits--;
         return virtualChannels[vc].getTopFlit();
     }
 
+    // True if any input VC holds a flit
+    bool hasBufferedFlits() const { return m_num_buffered_flits > 0; }
+
     inline bool
     need_stage(int vc, flit_stage stage, Tick time)
     {
@@ -168,6 +173,7 @@ class InputUnit : public Consumer
 
     // Input Virtual channels
     std::vector<VirtualChannel> virtualChannels;
+    int m_num_buffered_flits;
 
     // Statistical variables
     std::vector<double> m_num_buffer_writes;
@@ -155,6 +155,7 @@ void
 NetworkInterface::incrementStats(flit *t_flit)
 {
     int vnet = t_flit->get_vnet();
+    auto lock = m_net_ptr->lockStats();
 
     // Latency
     m_net_ptr->increment_received_flits(vnet);
@@ -439,6 +440,7 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         // so that the first router increments it to 0
         route.hops_traversed = -1;
 
+        auto lock = m_net_ptr->lockStats();
         m_net_ptr->increment_injected_packets(vnet);
         m_net_ptr->update_traffic_distribution(route);
         int packet_id = m_net_ptr->getNextPacketID();
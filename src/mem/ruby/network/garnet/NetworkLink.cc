@@ -48,7 +48,8 @@ namespace garnet
 NetworkLink::NetworkLink(const Params &p)
     : ClockedObject(p), Consumer(this), m_id(p.link_id),
       m_type(NUM_LINK_TYPES_),
-      m_latency(p.link_latency), m_link_utilized(0),
+      m_latency(p.link_latency), src_object(nullptr), m_cross_queue(false),
+      m_link_utilized(0),
       m_virt_nets(p.virt_nets), linkBuffer(),
       link_consumer(nullptr), link_srcQueue(nullptr)
 {
@@ -60,10 +61,33 @@ NetworkLink::NetworkLink(const Params &p)
     }
 }
 
+void
+NetworkLink::checkEventQueues()
+{
+    if (!src_object || !link_consumer)
+        return;
+
+    // The source pushes flits to the link and wakes it up directly, so
+    // the link has to share the event queue of its source. The consumer
+    // may be elsewhere, as long as the link latency covers the quantum.
+    fatal_if(src_object->eventQueue() != eventQueue(),
+             "%s must use the event queue of its source %s", name(),
+             src_object->name());
+
+    m_cross_queue = link_consumer->getObject()->eventQueue() != eventQueue();
+    fatal_if(m_cross_queue && cyclesToTicks(m_latency) < simQuantum,
+             "%s crosses event queues but its latency of %d ticks is below "
+             "the simulation quantum of %d ticks", name(),
+             cyclesToTicks(m_latency), simQuantum);
+    if (m_cross_queue)
+        declareQuantumLookahead(cyclesToTicks(m_latency));
+}
+
 void
 NetworkLink::setLinkConsumer(Consumer *consumer)
 {
     link_consumer = consumer;
+    checkEventQueues();
 }
 
 void
@@ -77,6 +101,7 @@ NetworkLink::setSourceQueue(flitBuffer *src_queue, ClockedObject *srcClockObj)
 {
     link_srcQueue = src_queue;
     src_object = srcClockObj;
+    checkEventQueues();
 }
 
 void
@@ -97,9 +122,14 @@ NetworkLink::wakeup()
                 t_flit->get_vnet()) != mVnets.end()) ||
                 (mVnets.size() == 0));
         }
-        t_flit->set_time(clockEdge(m_latency));
-        linkBuffer.insert(t_flit);
-        link_consumer->scheduleEventAbsolute(clockEdge(m_latency));
+        Tick arrival = clockEdge(m_latency);
+        t_flit->set_time(arrival);
+        if (m_cross_queue) {
+            sendAcross(t_flit, arrival);
+        } else {
+            linkBuffer.insert(t_flit);
+            link_consumer->scheduleEventAbsolute(arrival);
+        }
         m_link_utilized++;
         m_vc_load[t_flit->get_vc()]++;
     }
@@ -109,6 +139,23 @@ NetworkLink::wakeup()
     }
 }
 
+void
+NetworkLink::sendAcross(flit *t_flit, Tick arrival)
+{
+    // The link buffer belongs to the consumer side. Events scheduled on
+    // another queue are inserted asynchronously and only show up from
+    // the next quantum on, which checkEventQueues() made sure is no
+    // later than the arrival.
+    link_consumer->getObject()->eventQueue()->schedule(
+        new EventFunctionWrapper(
+            [this, t_flit, arrival]() {
+                linkBuffer.insert(t_flit);
+                link_consumer->scheduleEventAbsolute(arrival);
+            },
+            name() + ".deliver", true, Event::Default_Pri - 1),
+        curTick() + simQuantum);
+}
+
 void
 NetworkLink::resetStats()
 {
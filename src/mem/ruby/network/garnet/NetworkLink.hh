@@ -95,6 +95,18 @@ class NetworkLink : public ClockedObject, public Consumer
 
     ClockedObject *src_object;
 
+    /**
+     * True if the consumer of the link runs on another event queue than
+     * the link and its source, in which case flits are handed over by
+     * events on the event queue of the consumer.
+     */
+    bool m_cross_queue;
+
+    /** Check the event queues once both ends of the link are known. */
+    void checkEventQueues();
+
+    void sendAcross(flit *t_flit, Tick arrival);
+
     // Statistical variables
     unsigned int m_link_utilized;
     std::vector<unsigned int> m_vc_load;
@@ -75,8 +75,10 @@ Router::wakeup()
     assert(clockEdge() == curTick());
 
     // check for incoming flits
+    bool buffered_flits = false;
     for (int inport = 0; inport < m_input_unit.size(); inport++) {
         m_input_unit[inport]->wakeup();
+        buffered_flits |= m_input_unit[inport]->hasBufferedFlits();
     }
 
     // check for incoming credits
@@ -90,7 +92,10 @@ Router::wakeup()
     }
 
     // Switch Allocation
-    switchAllocator.wakeup();
+    // A router woken up only to receive credits, or to let flits traverse
+    // the switch, has no flit in its input VCs to allocate the switch to
+    if (buffered_flits)
+        switchAllocator.wakeup();
 
     // Switch Traversal
     crossbarSwitch.wakeup();
@@ -159,7 +164,8 @@ Router::getInportDirection(int inport)
 }
 
 int
-Router::route_compute(RouteInfo route, int inport, PortDirection inport_dirn)
+Router::route_compute(const RouteInfo &route, int inport,
+                      PortDirection inport_dirn)
 {
     return routingUnit.outportCompute(route, inport, inport_dirn);
 }
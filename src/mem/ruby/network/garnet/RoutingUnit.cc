@@ -34,6 +34,7 @@
 #include "base/compiler.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/InputUnit.hh"
+#include "mem/ruby/network/garnet/OutputUnit.hh"
 #include "mem/ruby/network/garnet/Router.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 
@@ -94,7 +95,7 @@ RoutingUnit::supportsVnet(int vnet, std::vector<int> sVnets)
  * Correct weight assignments are critical to provide deadlock avoidance.
  */
 int
-RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
+RoutingUnit::lookupRoutingTable(int vnet, const NetDest &msg_destination)
 {
     // First find all possible output link candidates
     // For ordered vnet, just choose the first
@@ -144,6 +145,47 @@ RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
     return output_link;
 }
 
+const std::vector<int> &
+RoutingUnit::routeCandidates(int vnet, int dest_ni, const NetDest &net_dest)
+{
+    if (m_route_candidates.size() <= vnet)
+        m_route_candidates.resize(m_routing_table.size());
+    auto &vnet_candidates = m_route_candidates[vnet];
+    if (vnet_candidates.size() <= dest_ni)
+        vnet_candidates.resize(m_router->get_net_ptr()->getNumNodes());
+
+    std::vector<int> &candidates = vnet_candidates[dest_ni];
+    if (!candidates.empty())
+        return candidates;
+
+    int min_weight = INFINITE_;
+    for (int link = 0; link < m_routing_table[vnet].size(); link++) {
+        if (!net_dest.intersectionIsNotEmpty(m_routing_table[vnet][link]))
+            continue;
+        if (m_weight_table[link] < min_weight) {
+            min_weight = m_weight_table[link];
+            candidates.clear();
+        }
+        if (m_weight_table[link] == min_weight)
+            candidates.push_back(link);
+    }
+
+    if (candidates.empty())
+        fatal("Fatal Error:: No Route exists from this Router.");
+    return candidates;
+}
+
+int
+RoutingUnit::lookupRouteCandidates(const RouteInfo &route)
+{
+    // Same choice as lookupRoutingTable(), without scanning the table
+    const std::vector<int> &candidates =
+        routeCandidates(route.vnet, route.dest_ni, route.net_dest);
+    if (m_router->get_net_ptr()->isVNetOrdered(route.vnet))
+        return candidates[0];
+    return candidates[rand() % candidates.size()];
+}
+
 
 void
 RoutingUnit::addInDirection(PortDirection inport_dirn, int inport_idx)
@@ -166,7 +208,7 @@ RoutingUnit::addOutDirection(PortDirection outport_dirn, int outport_idx)
 // table is provided here.
 
 int
-RoutingUnit::outportCompute(RouteInfo route, int inport,
+RoutingUnit::outportCompute(const RouteInfo &route, int inport,
                             PortDirection inport_dirn)
 {
     int outport = -1;
@@ -176,8 +218,7 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
         // Multiple NIs may be connected to this router,
         // all with output port direction = "Local"
         // Get exact outport id from table
-        outport = lookupRoutingTable(route.vnet, route.net_dest);
-        return outport;
+        return lookupRouteCandidates(route);
     }
 
     // Routing Algorithm set in GarnetNetwork.py
@@ -185,14 +226,24 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
     RoutingAlgorithm routing_algorithm =
         (RoutingAlgorithm) m_router->get_net_ptr()->getRoutingAlgorithm();
 
+    // Adaptive routes may reorder packets, keep ordered vnets on XY
+    if ((routing_algorithm == WEST_FIRST_ ||
+         routing_algorithm == ODD_EVEN_) &&
+        m_router->get_net_ptr()->isVNetOrdered(route.vnet)) {
+        routing_algorithm = XY_;
+    }
+
     switch (routing_algorithm) {
-        case TABLE_:  outport =
-            lookupRoutingTable(route.vnet, route.net_dest); break;
+        case TABLE_:  outport = lookupRouteCandidates(route); break;
         case XY_:     outport =
             outportComputeXY(route, inport, inport_dirn); break;
         // any custom algorithm
         case CUSTOM_: outport =
             outportComputeCustom(route, inport, inport_dirn); break;
+        case WEST_FIRST_: outport =
+            outportComputeWestFirst(route, inport, inport_dirn); break;
+        case ODD_EVEN_: outport =
+            outportComputeOddEven(route, inport, inport_dirn); break;
         default: outport =
             lookupRoutingTable(route.vnet, route.net_dest); break;
     }
@@ -205,7 +256,7 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
 // Only for reference purpose in a Mesh
 // By default Garnet uses the routing table
 int
-RoutingUnit::outportComputeXY(RouteInfo route,
+RoutingUnit::outportComputeXY(const RouteInfo &route,
                               int inport,
                               PortDirection inport_dirn)
 {
@@ -263,13 +314,108 @@ RoutingUnit::outportComputeXY(RouteInfo route,
 // Template for implementing custom routing algorithm
 // using port directions. (Example adaptive)
 int
-RoutingUnit::outportComputeCustom(RouteInfo route,
+RoutingUnit::outportComputeCustom(const RouteInfo &route,
                                  int inport,
                                  PortDirection inport_dirn)
 {
     panic("%s placeholder executed", __FUNCTION__);
 }
 
+int
+RoutingUnit::selectAdaptive(const std::vector<PortDirection> &dirns,
+                            int vnet)
+{
+    assert(!dirns.empty());
+    const int vc_per_vnet = m_router->get_vc_per_vnet();
+    const int vc_base = vnet * vc_per_vnet;
+
+    int best_outport = -1;
+    int best_credits = -1;
+    for (const auto &dirn : dirns) {
+        auto it = m_outports_dirn2idx.find(dirn);
+        panic_if(it == m_outports_dirn2idx.end(),
+                 "Router %d has no %s outport for adaptive routing",
+                 m_router->get_id(), dirn);
+        OutputUnit *output_unit = m_router->getOutputUnit(it->second);
+        int credits = 0;
+        for (int vc = vc_base; vc < vc_base + vc_per_vnet; vc++)
+            credits += output_unit->get_credit_count(vc);
+        if (credits > best_credits) {
+            best_credits = credits;
+            best_outport = it->second;
+        }
+    }
+    return best_outport;
+}
+
+// West-first: packets that need to go West do so first, after which
+// any minimal direction may be taken
+int
+RoutingUnit::outportComputeWestFirst(const RouteInfo &route,
+                                     int inport,
+                                     PortDirection inport_dirn)
+{
+    int num_cols = m_router->get_net_ptr()->getNumCols();
+    assert(num_cols > 0);
+
+    int my_id = m_router->get_id();
+    int dx = route.dest_router % num_cols - my_id % num_cols;
+    int dy = route.dest_router / num_cols - my_id / num_cols;
+    assert(dx != 0 || dy != 0);
+
+    std::vector<PortDirection> dirns;
+    if (dx < 0) {
+        dirns.push_back("West");
+    } else {
+        if (dx > 0)
+            dirns.push_back("East");
+        if (dy > 0)
+            dirns.push_back("North");
+        else if (dy < 0)
+            dirns.push_back("South");
+    }
+    return selectAdaptive(dirns, route.vnet);
+}
+
+// Odd-even turn model (Chiu): no East to North/South turns in even
+// columns and no North/South to West turns in odd columns
+int
+RoutingUnit::outportComputeOddEven(const RouteInfo &route,
+                                   int inport,
+                                   PortDirection inport_dirn)
+{
+    int num_cols = m_router->get_net_ptr()->getNumCols();
+    assert(num_cols > 0);
+
+    int my_id = m_router->get_id();
+    int my_x = my_id % num_cols;
+    int src_x = route.src_router % num_cols;
+    int dest_x = route.dest_router % num_cols;
+    int dx = dest_x - my_x;
+    int dy = route.dest_router / num_cols - my_id / num_cols;
+    assert(dx != 0 || dy != 0);
+
+    PortDirection y_dirn = dy > 0 ? "North" : "South";
+    std::vector<PortDirection> dirns;
+    if (dx == 0) {
+        dirns.push_back(y_dirn);
+    } else if (dx > 0) {
+        if (dy == 0) {
+            dirns.push_back("East");
+        } else {
+            if (my_x % 2 == 1 || my_x == src_x)
+                dirns.push_back(y_dirn);
+            if (dest_x % 2 == 1 || dx != 1)
+                dirns.push_back("East");
+        }
+    } else {
+        dirns.push_back("West");
+        if (dy != 0 && my_x % 2 == 0)
+            dirns.push_back(y_dirn);
+    }
+    return selectAdaptive(dirns, route.vnet);
+}
+
 } // namespace garnet
 } // namespace ruby
 } // namespace gem5
@@ -53,7 +53,7 @@ class RoutingUnit
 {
   public:
     RoutingUnit(Router *router);
-    int outportCompute(RouteInfo route,
+    int outportCompute(const RouteInfo &route,
                       int inport,
                       PortDirection inport_dirn);
 
@@ -62,34 +62,57 @@ class RoutingUnit
     void addWeight(int link_weight);
 
     // get output port from routing table
-    int  lookupRoutingTable(int vnet, NetDest net_dest);
+    int  lookupRoutingTable(int vnet, const NetDest &net_dest);
+    // same, memoizing the candidate links per destination
+    int lookupRouteCandidates(const RouteInfo &route);
 
     // Topology-specific direction based routing
     void addInDirection(PortDirection inport_dirn, int inport);
     void addOutDirection(PortDirection outport_dirn, int outport);
 
     // Routing for Mesh
-    int outportComputeXY(RouteInfo route,
+    int outportComputeXY(const RouteInfo &route,
                          int inport,
                          PortDirection inport_dirn);
 
     // Custom Routing Algorithm using Port Directions
-    int outportComputeCustom(RouteInfo route,
+    int outportComputeCustom(const RouteInfo &route,
                              int inport,
                              PortDirection inport_dirn);
 
+    // Minimal adaptive routing for Mesh, using the turn model: among
+    // the directions allowed towards the destination, pick the one
+    // with the most downstream credits for the vnet
+    int outportComputeWestFirst(const RouteInfo &route,
+                                int inport,
+                                PortDirection inport_dirn);
+    int outportComputeOddEven(const RouteInfo &route,
+                              int inport,
+                              PortDirection inport_dirn);
+
     // Returns true if vnet is present in the vector
     // of vnets or if the vector supports all vnets.
     bool supportsVnet(int vnet, std::vector<int> sVnets);
 
 
   private:
+    // Output links with the minimum weight towards a destination
+    const std::vector<int> &routeCandidates(int vnet, int dest_ni,
+                                            const NetDest &net_dest);
+
+    // The least congested of the allowed outport directions
+    int selectAdaptive(const std::vector<PortDirection> &dirns, int vnet);
+
     Router *m_router;
 
     // Routing Table
     std::vector<std::vector<NetDest>> m_routing_table;
     std::vector<int> m_weight_table;
 
+    // Candidate links per vnet and destination NI, filled on demand;
+    // packets have a single destination once injected
+    std::vector<std::vector<std::vector<int>>> m_route_candidates;
+
     // Inport and Outport direction to idx maps
     std::map<PortDirection, int> m_inports_dirn2idx;
     std::map<int, PortDirection> m_inports_idx2dirn;
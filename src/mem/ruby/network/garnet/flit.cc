@@ -30,6 +30,9 @@
 
 #include "mem/ruby/network/garnet/flit.hh"
 
+#include <new>
+#include <vector>
+
 #include "base/intmath.hh"
 #include "debug/RubyNetwork.hh"
 
@@ -42,9 +45,93 @@ namespace ruby
 namespace garnet
 {
 
+namespace
+{
+
+/**
+ * Free lists of flit memory, one per object size. There are only as
+ * many sizes as flit types. The lists are per thread so that routers
+ * on different event queues don't need to synchronize.
+ */
+class FlitFreeLists
+{
+  public:
+    ~FlitFreeLists()
+    {
+        destroyed = true;
+        for (auto &list: lists) {
+            for (void *ptr: list.free)
+                ::operator delete(ptr);
+        }
+    }
+
+    std::vector<void *> &
+    get(std::size_t size)
+    {
+        for (auto &list: lists) {
+            if (list.size == size)
+                return list.free;
+        }
+        lists.push_back({size, {}});
+        return lists.back().free;
+    }
+
+    // Flits destroyed after the free lists, e.g., at exit, bypass them
+    static thread_local bool destroyed;
+
+    /**
+     * Most flits a list keeps. Flits crossing event queues are allocated
+     * on one thread and freed on another, so the list of the freeing
+     * thread would otherwise grow with the traffic. This is well above
+     * what the VC buffers of a network hold at once.
+     */
+    static constexpr std::size_t maxFree = 4096;
+
+  private:
+    struct List
+    {
+        std::size_t size;
+        std::vector<void *> free;
+    };
+    std::vector<List> lists;
+};
+
+thread_local bool FlitFreeLists::destroyed = false;
+thread_local FlitFreeLists flitFreeLists;
+
+} // anonymous namespace
+
+void *
+flit::operator new(std::size_t size)
+{
+    if (FlitFreeLists::destroyed)
+        return ::operator new(size);
+    std::vector<void *> &free = flitFreeLists.get(size);
+    if (free.empty())
+        return ::operator new(size);
+    void *ptr = free.back();
+    free.pop_back();
+    return ptr;
+}
+
+void
+flit::operator delete(void *ptr, std::size_t size)
+{
+    if (FlitFreeLists::destroyed) {
+        ::operator delete(ptr);
+        return;
+    }
+    std::vector<void *> &free = flitFreeLists.get(size);
+    if (free.size() >= FlitFreeLists::maxFree) {
+        ::operator delete(ptr);
+        return;
+    }
+    free.push_back(ptr);
+}
+
 // Constructor for the flit
-flit::flit(int packet_id, int id, int  vc, int vnet, RouteInfo route, int size,
-    MsgPtr msg_ptr, int MsgSize, uint32_t bWidth, Tick curTime)
+flit::flit(int packet_id, int id, int  vc, int vnet, const RouteInfo &route,
+    int size, MsgPtr msg_ptr, int MsgSize, uint32_t bWidth, Tick curTime)
 {
     m_size = size;
     m_msg_ptr = msg_ptr;
@@ -42,6 +42,7 @@
 
 #include <algorithm>
 
+#include "base/bitfield.hh"
 #include "base/cast.hh"
 #include "base/cprintf.hh"
 #include "base/random.hh"
@@ -99,6 +100,8 @@ PerfectSwitch::updatePriorityGroups(int vnet, MessageBuffer* in_buf)
     while (m_in_prio.size() <= vnet) {
         m_in_prio.emplace_back();
         m_in_prio_groups.emplace_back();
+        m_in_slots.emplace_back();
+        m_in_pending.emplace_back();
     }
 
     m_in_prio[vnet].push_back(in_buf);
@@ -116,6 +119,42 @@ PerfectSwitch::updatePriorityGroups(int vnet, MessageBuffer* in_buf)
             m_in_prio_groups[vnet].emplace_back();
         m_in_prio_groups[vnet].back().push_back(buf);
     }
+
+    // reset the slots and the pending bitmaps to match the new groups
+    m_in_slots[vnet].resize(m_in.size());
+    m_in_pending[vnet].clear();
+    for (int group = 0; group < m_in_prio_groups[vnet].size(); ++group) {
+        auto &in = m_in_prio_groups[vnet][group];
+        m_in_pending[vnet].emplace_back(divCeil(in.size(), 64), 0);
+        for (int i = 0; i < in.size(); ++i) {
+            m_in_slots[vnet][in[i]->getIncomingLink()] = {group, i};
+            setPending(vnet, in[i], !in[i]->isEmpty());
+        }
+    }
+}
+
+int
+PerfectSwitch::nextPending(const std::vector<uint64_t> &pending, int from)
+{
+    int word = from / 64;
+    if (word >= pending.size())
+        return -1;
+    uint64_t bits = pending[word] & (~0ULL << (from % 64));
+    while (bits == 0) {
+        if (++word >= pending.size())
+            return -1;
+        bits = pending[word];
+    }
+    return word * 64 + ctz64(bits);
+}
+
+void
+PerfectSwitch::setPending(int vnet, const MessageBuffer *buf, bool pending)
+{
+    const InputSlot &slot = m_in_slots[vnet][buf->getIncomingLink()];
+    uint64_t &word = m_in_pending[vnet][slot.group][slot.index / 64];
+    uint64_t bit = 1ULL << (slot.index % 64);
+    word = pending ? (word | bit) : (word & ~bit);
 }
 
 void
@@ -155,29 +194,38 @@ PerfectSwitch::operateVnet(int vnet)
     if (m_pending_message_count[vnet] == 0)
         return;
 
-    for (auto &in : m_in_prio_groups[vnet]) {
-        // first check the port with the oldest message
-        unsigned start_in_port = 0;
+    for (int group = 0; group < m_in_prio_groups[vnet].size(); ++group) {
+        auto &in = m_in_prio_groups[vnet][group];
+        auto &pending = m_in_pending[vnet][group];
+
+        // first check the port with the oldest message; only the ports
+        // holding messages need to be looked at
+        int start_in_port = nextPending(pending, 0);
+        if (start_in_port < 0)
+            continue;
         Tick lowest_tick = MaxTick;
-        for (int i = 0; i < in.size(); ++i) {
-            MessageBuffer *buffer = in[i];
-            if (buffer) {
-                Tick ready_time = buffer->readyTime();
-                if (ready_time < lowest_tick){
-                    lowest_tick = ready_time;
-                    start_in_port = i;
-                }
+        for (int i = start_in_port; i >= 0; i = nextPending(pending, i + 1)) {
+            Tick ready_time = in[i]->readyTime();
+            if (ready_time < lowest_tick){
+                lowest_tick = ready_time;
+                start_in_port = i;
             }
         }
         DPRINTF(RubyNetwork, "vnet %d: %d pending msgs. "
                             "Checking port %d first\n",
                 vnet, m_pending_message_count[vnet], start_in_port);
-        // check all ports starting with the one with the oldest message
-        for (int i = 0; i < in.size(); ++i) {
-            int in_port = (i + start_in_port) % in.size();
-            MessageBuffer *buffer = in[in_port];
-            if (buffer)
-                operateMessageBuffer(buffer, vnet);
+        // check all ports starting with the one with the oldest message,
+        // wrapping around to the ones before it
+        auto operate = [&](int i) {
+            operateMessageBuffer(in[i], vnet);
+            if (in[i]->isEmpty())
+                setPending(vnet, in[i], false);
+        };
+        for (int i = start_in_port; i >= 0; i = nextPending(pending, i + 1))
+            operate(i);
+        for (int i = nextPending(pending, 0); i >= 0 && i < start_in_port;
+             i = nextPending(pending, i + 1)) {
+            operate(i);
         }
     }
 }
@@ -300,9 +348,11 @@ PerfectSwitch::wakeup()
 }
 
 void
-PerfectSwitch::storeEventInfo(int info)
+PerfectSwitch::notifyEnqueue(MessageBuffer *buffer)
 {
-    m_pending_message_count[info]++;
+    int vnet = buffer->getVnet();
+    m_pending_message_count[vnet]++;
+    setPending(vnet, buffer, true);
 }
 
 void
@@ -87,7 +87,7 @@ class PerfectSwitch : public Consumer
     int getOutLinks() const { return m_out.size(); }
 
     void wakeup();
-    void storeEventInfo(int info);
+    void notifyEnqueue(MessageBuffer *buffer);
 
     void clearStats();
     void collateStats();
@@ -122,6 +122,21 @@ class PerfectSwitch : public Consumer
 
     void updatePriorityGroups(int vnet, MessageBuffer* buf);
 
+    // Position of an input buffer within the priority groups of its vnet
+    struct InputSlot
+    {
+        int group;
+        int index;
+    };
+    // indexed by vnet,in_port
+    std::vector<std::vector<InputSlot>> m_in_slots;
+    // Bitmap of the buffers in each priority group that hold messages,
+    // so that only those are visited on a wakeup; indexed by vnet,prio_lv
+    std::vector<std::vector<std::vector<uint64_t>>> m_in_pending;
+
+    static int nextPending(const std::vector<uint64_t> &pending, int from);
+    void setPending(int vnet, const MessageBuffer *buf, bool pending);
+
     uint32_t m_virtual_networks;
     int m_wakeups_wo_switch;
 
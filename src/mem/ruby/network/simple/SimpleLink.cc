@@ -47,7 +47,7 @@ namespace ruby
 {
 
 SimpleExtLink::SimpleExtLink(const Params &p)
-    : BasicExtLink(p)
+    : BasicExtLink(p), m_analytical(p.analytical)
 {
     // For the simple links, the bandwidth factor translates to the
     // bandwidth multiplier.  The multipiler, in combination with the
@@ -65,6 +65,7 @@ SimpleExtLink::print(std::ostream& out) const
 SimpleIntLink::SimpleIntLink(const Params &p)
     : BasicIntLink(p),
       m_bw_multiplier(p.bandwidth_factor),
+      m_analytical(p.analytical),
       m_buffers(p.buffers)
 {
 
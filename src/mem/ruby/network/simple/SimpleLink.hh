@@ -65,6 +65,7 @@ class SimpleExtLink : public BasicExtLink
     void print(std::ostream& out) const;
 
     int m_bw_multiplier;
+    const bool m_analytical;
 };
 
 inline std::ostream&
@@ -85,6 +86,7 @@ class SimpleIntLink : public BasicIntLink
     void print(std::ostream& out) const;
 
     int m_bw_multiplier;
+    const bool m_analytical;
     const std::vector<MessageBuffer*> m_buffers;
 };
 
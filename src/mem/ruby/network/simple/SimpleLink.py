@@ -52,12 +52,24 @@ class SimpleExtLink(BasicExtLink):
     cxx_header = "mem/ruby/network/simple/SimpleLink.hh"
     cxx_class = "gem5::ruby::SimpleExtLink"
 
+    analytical = Param.Bool(
+        False,
+        "Model contention on this link analytically (M/D/1 queueing) "
+        "instead of cycle by cycle",
+    )
+
 
 class SimpleIntLink(BasicIntLink):
     type = "SimpleIntLink"
     cxx_header = "mem/ruby/network/simple/SimpleLink.hh"
     cxx_class = "gem5::ruby::SimpleIntLink"
 
+    analytical = Param.Bool(
+        False,
+        "Model contention on this link analytically (M/D/1 queueing) "
+        "instead of cycle by cycle, e.g., for links between clusters",
+    )
+
     # Buffers for this internal link.
     # One buffer is allocated per vnet when setup_buffers is called.
     # These are created by setup_buffers and the user should not
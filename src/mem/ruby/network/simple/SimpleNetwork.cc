@@ -123,7 +123,8 @@ SimpleNetwork::makeExtOutLink(SwitchID src, NodeID global_dest,
                                 m_fromNetQueues[local_dest],
                                 routing_table_entry[0],
                                 simple_link->m_latency, 0,
-                                simple_link->m_bw_multiplier, true);
+                                simple_link->m_bw_multiplier, true, "",
+                                simple_link->m_analytical);
 }
 
 // From an endpoint node to a switch
@@ -153,7 +154,8 @@ SimpleNetwork::makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
                                 simple_link->m_weight,
                                 simple_link->m_bw_multiplier,
                                 false,
-                                dst_inport);
+                                dst_inport,
+                                simple_link->m_analytical);
     // Maitain a global list of buffers (used for functional accesses only)
     m_int_link_buffers.insert(m_int_link_buffers.end(),
             simple_link->m_buffers.begin(), simple_link->m_buffers.end());
@@ -91,7 +91,8 @@ Switch::addOutPort(std::string link_name,
                    Cycles link_latency, int link_weight,
                    int bw_multiplier,
                    bool is_external,
-                   PortDirection dst_inport)
+                   PortDirection dst_inport,
+                   bool analytical)
 {
     const std::vector<int> &physical_vnets_channels =
         m_network_ptr->params().physical_vnets_channels;
@@ -114,6 +115,8 @@ Switch::addOutPort(std::string link_name,
             m_network_ptr->getEndpointBandwidth(), this, link_name);
     }
 
+    throttles.back().setAnalytical(analytical);
+
     // Create one buffer per vnet (these are intermediaryQueues)
     std::vector<MessageBuffer*> intermediateBuffers;
 
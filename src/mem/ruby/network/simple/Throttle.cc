@@ -40,7 +40,9 @@
 
 #include "mem/ruby/network/simple/Throttle.hh"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 #include "base/cast.hh"
 #include "base/cprintf.hh"
@@ -62,6 +64,10 @@ const int MESSAGE_SIZE_MULTIPLIER = 1000;
 //const int BROADCAST_SCALING = 4; // Have a 16p system act like a 64p systems
 const int BROADCAST_SCALING = 1;
 const int PRIORITY_SWITCH_LIMIT = 128;
+// Cycles over which the load of analytical links is measured
+const Cycles ANALYTICAL_LOAD_WINDOW = Cycles(100);
+// Keeps the M/D/1 delay finite when the link is overloaded
+const double ANALYTICAL_MAX_LOAD = 0.95;
 
 static int network_message_to_size(Message* net_msg_ptr);
 
@@ -119,11 +125,14 @@ Throttle::addLinks(const std::vector<MessageBuffer*>& in_vec,
         MessageBuffer *out_ptr = out_vec[vnet];
 
         m_units_remaining.emplace_back(getChannelCnt(vnet),0);
+        m_last_arrival.push_back(0);
+        m_vnet_pending.push_back(!in_ptr->isEmpty());
         m_in.push_back(in_ptr);
         m_out.push_back(out_ptr);
 
         // Set consumer and description
         in_ptr->setConsumer(this);
+        in_ptr->setVnet(vnet);
         std::string desc = "[Queue to Throttle " +
             std::to_string(m_switch_id) + " " + std::to_string(m_node) + "]";
     }
@@ -204,18 +213,7 @@ Throttle::operateVnet(int vnet, int channel, int &total_bw_remaining,
                          m_ruby_system->getRandomization(),
                          m_ruby_system->getWarmupEnabled());
 
-            // Count the message
-            (*(throttleStats.
-                msg_counts[net_msg_ptr->getMessageSize()]))[vnet]++;
-            throttleStats.total_msg_count += 1;
-            uint32_t total_size =
-                Network::MessageSizeType_to_int(net_msg_ptr->getMessageSize());
-            throttleStats.total_msg_bytes += total_size;
-            total_size -=
-                Network::MessageSizeType_to_int(MessageSizeType_Control);
-            throttleStats.total_data_msg_bytes += total_size;
-            throttleStats.total_msg_wait_time +=
-                current_time - msg_enqueue_time;
+            recordMessage(vnet, net_msg_ptr, current_time - msg_enqueue_time);
             DPRINTF(RubyNetwork, "%s\n", *out);
         }
 
@@ -242,9 +240,122 @@ Throttle::operateVnet(int vnet, int channel, int &total_bw_remaining,
     }
 }
 
+void
+Throttle::operateVnet(int vnet, int &total_bw_remaining,
+                      bool &bw_saturated, bool &output_blocked)
+{
+    if (!m_vnet_pending[vnet])
+        return;
+
+    bool units_remaining = false;
+    for (int channel = 0; channel < getChannelCnt(vnet); ++channel) {
+        operateVnet(vnet, channel, total_bw_remaining,
+                    bw_saturated, output_blocked,
+                    m_in[vnet], m_out[vnet]);
+        units_remaining = units_remaining ||
+            m_units_remaining[vnet][channel] > 0;
+    }
+    m_vnet_pending[vnet] = units_remaining || !m_in[vnet]->isEmpty();
+}
+
+void
+Throttle::recordMessage(int vnet, Message *net_msg_ptr, Tick wait_time)
+{
+    (*(throttleStats.msg_counts[net_msg_ptr->getMessageSize()]))[vnet]++;
+    throttleStats.total_msg_count += 1;
+    uint32_t total_size =
+        Network::MessageSizeType_to_int(net_msg_ptr->getMessageSize());
+    throttleStats.total_msg_bytes += total_size;
+    total_size -= Network::MessageSizeType_to_int(MessageSizeType_Control);
+    throttleStats.total_data_msg_bytes += total_size;
+    throttleStats.total_msg_wait_time += wait_time;
+}
+
+void
+Throttle::updateAnalyticalLoad()
+{
+    Cycles now = m_switch->curCycle();
+    Cycles elapsed = now - m_window_start;
+    if (elapsed < ANALYTICAL_LOAD_WINDOW)
+        return;
+
+    double window_load = double(m_window_units) /
+        (double(elapsed) * getTotalLinkBandwidth());
+    m_analytical_load = (m_analytical_load + window_load) / 2;
+    m_window_units = 0;
+    m_window_start = now;
+}
+
+void
+Throttle::operateAnalytical(int vnet, bool &output_blocked)
+{
+    MessageBuffer *in = m_in[vnet];
+    MessageBuffer *out = m_out[vnet];
+    if (out == nullptr || in == nullptr)
+        return;
+
+    Tick current_time = m_switch->clockEdge();
+    while (in->isReady(current_time) &&
+           out->areNSlotsAvailable(1, current_time)) {
+        MsgPtr msg_ptr = in->peekMsgPtr();
+        Message *net_msg_ptr = msg_ptr.get();
+        Tick msg_enqueue_time = msg_ptr->getLastEnqueueTime();
+        int units = network_message_to_size(net_msg_ptr);
+
+        // M/D/1 mean waiting time: rho * S / (2 * (1 - rho))
+        double service = double(units) / getLinkBandwidth(vnet);
+        double load = std::min(m_analytical_load, ANALYTICAL_MAX_LOAD);
+        double wait = load * service / (2 * (1 - load));
+
+        Tick arrival = current_time + m_switch->cyclesToTicks(
+            m_link_latency + Cycles(std::lround(wait)));
+        arrival = std::max(arrival, m_last_arrival[vnet]);
+        m_last_arrival[vnet] = arrival;
+
+        DPRINTF(RubyNetwork, "throttle: %d analytical load %.2f "
+                "wait %.1f cycles for net msg %d time: %lld.\n",
+                m_node, load, wait, units, m_ruby_system->curCycle());
+
+        in->dequeue(current_time);
+        out->enqueue(msg_ptr, current_time, arrival - current_time,
+                     m_ruby_system->getRandomization(),
+                     m_ruby_system->getWarmupEnabled());
+
+        m_window_units += units;
+        throttleStats.acc_link_utilization +=
+            double(units) / getTotalLinkBandwidth();
+        recordMessage(vnet, net_msg_ptr, current_time - msg_enqueue_time);
+    }
+
+    if (in->isReady(current_time))
+        output_blocked = true;
+}
+
+void
+Throttle::notifyEnqueue(MessageBuffer *buffer)
+{
+    m_vnet_pending[buffer->getVnet()] = true;
+}
+
 void
 Throttle::wakeup()
 {
+    if (m_analytical) {
+        updateAnalyticalLoad();
+        bool output_blocked = false;
+        for (int vnet = 0; vnet < m_vnets; ++vnet) {
+            if (!m_vnet_pending[vnet])
+                continue;
+            operateAnalytical(vnet, output_blocked);
+            m_vnet_pending[vnet] = !m_in[vnet]->isEmpty();
+        }
+        if (output_blocked) {
+            throttleStats.total_stall_cy += 1;
+            scheduleEvent(Cycles(1));
+        }
+        return;
+    }
+
     // Limits the number of message sent to a limited number of bytes/cycle.
     assert(getTotalLinkBandwidth() > 0);
     int bw_remaining = getTotalLinkBandwidth();
@@ -264,21 +375,11 @@ Throttle::wakeup()
     }
 
     if (iteration_direction) {
-        for (int vnet = 0; vnet < m_vnets; ++vnet) {
-            for (int channel = 0; channel < getChannelCnt(vnet); ++channel) {
-                operateVnet(vnet, channel, bw_remaining,
-                            bw_saturated, output_blocked,
-                            m_in[vnet], m_out[vnet]);
-            }
-        }
+        for (int vnet = 0; vnet < m_vnets; ++vnet)
+            operateVnet(vnet, bw_remaining, bw_saturated, output_blocked);
     } else {
-        for (int vnet = m_vnets-1; vnet >= 0; --vnet) {
-            for (int channel = 0; channel < getChannelCnt(vnet); ++channel) {
-                operateVnet(vnet, channel, bw_remaining,
-                            bw_saturated, output_blocked,
-                            m_in[vnet], m_out[vnet]);
-            }
-        }
+        for (int vnet = m_vnets-1; vnet >= 0; --vnet)
+            operateVnet(vnet, bw_remaining, bw_saturated, output_blocked);
     }
 
     // We should only wake up when we use the bandwidth
@@ -88,6 +88,7 @@ class Throttle : public Consumer
     void addLinks(const std::vector<MessageBuffer*>& in_vec,
                   const std::vector<MessageBuffer*>& out_vec);
     void wakeup();
+    void notifyEnqueue(MessageBuffer *buffer);
 
     // The average utilization (a fraction) since last clearStats()
     const statistics::Formula & getUtilization() const
@@ -103,6 +104,11 @@ class Throttle : public Consumer
 
     Cycles getLatency() const { return m_link_latency; }
 
+    // Forward messages as soon as they are ready instead of accounting
+    // for the link bandwidth cycle by cycle. Contention is charged as
+    // the M/D/1 queueing delay for the link's recent load.
+    void setAnalytical(bool analytical) { m_analytical = analytical; }
+
     void print(std::ostream& out) const;
 
   private:
@@ -111,6 +117,11 @@ class Throttle : public Consumer
     void operateVnet(int vnet, int channel, int &total_bw_remaining,
                      bool &bw_saturated, bool &output_blocked,
                      MessageBuffer *in, MessageBuffer *out);
+    void operateVnet(int vnet, int &total_bw_remaining,
+                     bool &bw_saturated, bool &output_blocked);
+    void operateAnalytical(int vnet, bool &output_blocked);
+    void updateAnalyticalLoad();
+    void recordMessage(int vnet, Message *net_msg_ptr, Tick wait_time);
 
     // Private copy constructor and assignment operator
     Throttle(const Throttle& obj);
@@ -120,6 +131,9 @@ class Throttle : public Consumer
     std::vector<MessageBuffer*> m_out;
     unsigned int m_vnets;
     std::vector<std::vector<int>> m_units_remaining;
+    // Vnets with messages queued or still being sent, so that only those
+    // are visited on a wakeup
+    std::vector<bool> m_vnet_pending;
 
     const int m_switch_id;
     Switch *m_switch;
@@ -133,6 +147,15 @@ class Throttle : public Consumer
     int m_endpoint_bandwidth;
     RubySystem *m_ruby_system;
 
+    bool m_analytical = false;
+    // Smoothed link load, as a fraction of its bandwidth
+    double m_analytical_load = 0;
+    // Size units sent since the start of the current load window
+    uint64_t m_window_units = 0;
+    Cycles m_window_start = Cycles(0);
+    // Keeps deliveries in order on each (ordered) output buffer
+    std::vector<Tick> m_last_arrival;
+
     std::string link_name;
 
     struct ThrottleStats : public statistics::Group
@@ -51,6 +51,8 @@ AccessTraceForAddress::print(std::ostream& out) const
 
     if (m_histogram_ptr == NULL) {
         out << " " << m_total;
+        if (m_error)
+            out << " (+" << m_error << ")";
         out << " | " << m_loads;
         out << " " << m_stores;
         out << " " << m_atomics;
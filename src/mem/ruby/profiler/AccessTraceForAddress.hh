@@ -49,7 +49,7 @@ class AccessTraceForAddress
   public:
     AccessTraceForAddress()
         : m_loads(0), m_stores(0), m_atomics(0), m_total(0), m_user(0),
-          m_sharing(0), m_histogram_ptr(NULL)
+          m_sharing(0), m_error(0), m_histogram_ptr(NULL)
     { }
     ~AccessTraceForAddress();
 
@@ -62,13 +62,23 @@ class AccessTraceForAddress
     Addr getAddress() const { return m_addr; }
     void addSample(int value);
 
+    /**
+     * Accesses that may have gone to this address before it was tracked,
+     * when it replaced another address in a bounded table.
+     */
+    uint64_t getError() const { return m_error; }
+    void setError(uint64_t error) { m_error = error; }
+
+    /** Upper bound on the accesses to this address */
+    uint64_t getEstimate() const { return getTotal() + m_error; }
+
     void print(std::ostream& out) const;
 
     static inline bool
-    less_equal(const AccessTraceForAddress* n1,
+    greater(const AccessTraceForAddress* n1,
         const AccessTraceForAddress* n2)
     {
-        return n1->getTotal() <= n2->getTotal();
+        return n1->getTotal() > n2->getTotal();
     }
 
   private:
@@ -79,6 +89,7 @@ class AccessTraceForAddress
     uint64_t m_total;
     uint64_t m_user;
     uint64_t m_sharing;
+    uint64_t m_error;
     Set m_touched_by;
     Histogram* m_histogram_ptr;
 };
@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "base/bitfield.hh"
+#include "base/logging.hh"
 #include "base/stl_helpers.hh"
 #include "mem/ruby/profiler/Profiler.hh"
 #include "mem/ruby/protocol/RubyRequest.hh"
@@ -42,8 +43,6 @@ namespace gem5
 namespace ruby
 {
 
-typedef AddressProfiler::AddressMap AddressMap;
-
 using gem5::stl_helpers::operator<<;
 
 // Helper functions
@@ -69,11 +68,80 @@ lookupTraceForAddress(Addr addr, AddressMap& record_map)
     return access_trace;
 }
 
+void
+AddressTraceTable::setCapacity(size_t capacity)
+{
+    m_capacity = capacity;
+    if (m_capacity)
+        m_traces.reserve(m_capacity);
+}
+
+AccessTraceForAddress &
+AddressTraceTable::beginUpdate(Addr addr)
+{
+    if (!m_capacity)
+        return lookupTraceForAddress(addr, m_traces);
+
+    auto i = m_traces.find(addr);
+    if (i != m_traces.end()) {
+        m_by_count.erase({i->second.getEstimate(), addr});
+        return i->second;
+    }
+
+    uint64_t error = 0;
+    if (m_traces.size() >= m_capacity) {
+        auto victim = m_by_count.begin();
+        error = victim->first;
+        m_traces.erase(victim->second);
+        m_by_count.erase(victim);
+        m_evictions++;
+    }
+
+    AccessTraceForAddress &access_trace =
+        lookupTraceForAddress(addr, m_traces);
+    access_trace.setError(error);
+    return access_trace;
+}
+
+void
+AddressTraceTable::endUpdate(const AccessTraceForAddress &trace)
+{
+    if (m_capacity)
+        m_by_count.emplace(trace.getEstimate(), trace.getAddress());
+}
+
+void
+AddressTraceTable::update(Addr addr, RubyRequestType type,
+                          RubyAccessMode access_mode, NodeID id,
+                          bool sharing_miss)
+{
+    AccessTraceForAddress &access_trace = beginUpdate(addr);
+    access_trace.update(type, access_mode, id, sharing_miss);
+    endUpdate(access_trace);
+}
+
+void
+AddressTraceTable::addSample(Addr addr, int value)
+{
+    AccessTraceForAddress &access_trace = beginUpdate(addr);
+    access_trace.addSample(value);
+    endUpdate(access_trace);
+}
+
+void
+AddressTraceTable::clear()
+{
+    m_traces.clear();
+    m_by_count.clear();
+    m_evictions = 0;
+}
+
 void
 printSorted(std::ostream& out, int num_of_sequencers,
-        const AddressMap &record_map, std::string description,
+        const AddressTraceTable &table, std::string description,
         Profiler *profiler)
 {
+    const AddressMap &record_map = table.getTraces();
     const int records_printed = 100;
 
     uint64_t misses = 0;
@@ -86,10 +154,14 @@ printSorted(std::ostream& out, int num_of_sequencers,
         misses += record->getTotal();
         sorted.push_back(record);
     }
-    sort(sorted.begin(), sorted.end(), AccessTraceForAddress::less_equal);
+    sort(sorted.begin(), sorted.end(), AccessTraceForAddress::greater);
 
     out << "Total_entries_" << description << ": " << record_map.size()
         << std::endl;
+    if (table.getEvictions()) {
+        out << "Evicted_entries_" << description << ": "
+            << table.getEvictions() << std::endl;
+    }
     if (profiler->getAllInstructions()) {
         out << "Total_Instructions_" << description << ": " << misses
             << std::endl;
@@ -136,6 +208,7 @@ printSorted(std::ostream& out, int num_of_sequencers,
         remaining_records.add(record->getTotal());
         all_records_log.add(record->getTotal());
         remaining_records_log.add(record->getTotal());
+        counter++;
         m_touched_vec[record->getTouchedBy()]++;
         m_touched_weighted_vec[record->getTouchedBy()] += record->getTotal();
     }
@@ -156,7 +229,7 @@ printSorted(std::ostream& out, int num_of_sequencers,
 }
 
 AddressProfiler::AddressProfiler(int num_of_sequencers, Profiler *profiler)
-    : m_profiler(profiler)
+    : m_profiler(profiler), m_table_size(0), m_sampling_ratio(1)
 {
     m_num_of_sequencers = num_of_sequencers;
     clearStats();
@@ -178,6 +251,37 @@ AddressProfiler::setAllInstructions(bool all_instructions)
     m_all_instructions = all_instructions;
 }
 
+void
+AddressProfiler::setTableSize(size_t table_size)
+{
+    m_table_size = table_size;
+    m_dataAccessTrace.setCapacity(table_size);
+    m_macroBlockAccessTrace.setCapacity(table_size);
+    m_programCounterAccessTrace.setCapacity(table_size);
+    m_retryProfileMap.setCapacity(table_size);
+}
+
+void
+AddressProfiler::setSamplingRatio(unsigned sampling_ratio)
+{
+    fatal_if(sampling_ratio == 0,
+             "The address profiler sampling ratio must be at least 1.");
+    m_sampling_ratio = sampling_ratio;
+}
+
+bool
+AddressProfiler::isSampled(Addr line_addr) const
+{
+    if (m_sampling_ratio == 1)
+        return true;
+
+    // Select lines by a hash of their address, so that every access to a
+    // sampled line is seen, and the line strides of a program do not
+    // alias with the ratio.
+    uint64_t hash = (line_addr * 0x9e3779b97f4a7c15ULL) >> 32;
+    return hash % m_sampling_ratio == 0;
+}
+
 void
 AddressProfiler::printStats(std::ostream& out) const
 {
@@ -187,6 +291,12 @@ AddressProfiler::printStats(std::ostream& out) const
         out << "---------------------" << std::endl;
 
         out << std::endl;
+        if (m_sampling_ratio > 1) {
+            out << "sampled_lines: 1/" << m_sampling_ratio << std::endl;
+        }
+        if (m_table_size) {
+            out << "table_size: " << m_table_size << std::endl;
+        }
         out << "sharing_misses: " << m_sharing_miss_counter << std::endl;
         out << "getx_sharing_histogram: " << m_getx_sharing_histogram
             << std::endl;
@@ -302,35 +412,38 @@ AddressProfiler::addTraceSample(Addr data_addr, Addr pc_addr,
                                 RubyAccessMode access_mode, NodeID id,
                                 bool sharing_miss)
 {
-    if (m_all_instructions) {
+    int block_size_bits = m_profiler->m_ruby_system->getBlockSizeBits();
+    data_addr = makeLineAddress(data_addr, block_size_bits);
+    if (!isSampled(data_addr))
+        return;
+
+    if (m_hot_lines) {
         if (sharing_miss) {
             m_sharing_miss_counter++;
         }
 
         // record data address trace info
-        int block_size_bits = m_profiler->m_ruby_system->getBlockSizeBits();
-        data_addr = makeLineAddress(data_addr, block_size_bits);
-        lookupTraceForAddress(data_addr, m_dataAccessTrace).
-            update(type, access_mode, id, sharing_miss);
+        m_dataAccessTrace.update(data_addr, type, access_mode, id,
+                                 sharing_miss);
 
         // record macro data address trace info
 
         // 6 for datablock, 4 to make it 16x more coarse
         Addr macro_addr = mbits<Addr>(data_addr, 63, 10);
-        lookupTraceForAddress(macro_addr, m_macroBlockAccessTrace).
-            update(type, access_mode, id, sharing_miss);
+        m_macroBlockAccessTrace.update(macro_addr, type, access_mode, id,
+                                       sharing_miss);
 
         // record program counter address trace info
-        lookupTraceForAddress(pc_addr, m_programCounterAccessTrace).
-            update(type, access_mode, id, sharing_miss);
+        m_programCounterAccessTrace.update(pc_addr, type, access_mode, id,
+                                           sharing_miss);
     }
 
     if (m_all_instructions) {
         // This code is used if the address profiler is an
         // all-instructions profiler record program counter address
         // trace info
-        lookupTraceForAddress(pc_addr, m_programCounterAccessTrace).
-            update(type, access_mode, id, sharing_miss);
+        m_programCounterAccessTrace.update(pc_addr, type, access_mode, id,
+                                           sharing_miss);
     }
 }
 
@@ -344,7 +457,7 @@ AddressProfiler::profileRetry(Addr data_addr, AccessType type, int count)
         m_retryProfileHistoWrite.add(count);
     }
     if (count > 1) {
-        lookupTraceForAddress(data_addr, m_retryProfileMap).addSample(count);
+        m_retryProfileMap.addSample(data_addr, count);
     }
 }
 
@@ -30,7 +30,9 @@
 #define __MEM_RUBY_PROFILER_ADDRESSPROFILER_HH__
 
 #include <iostream>
+#include <set>
 #include <unordered_map>
+#include <utility>
 
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/Histogram.hh"
@@ -47,10 +49,48 @@ namespace ruby
 
 class Set;
 
+typedef std::unordered_map<Addr, AccessTraceForAddress> AddressMap;
+
+/**
+ * The access traces of the addresses seen by a profiler. The table can be
+ * bounded, in which case a new address replaces the tracked address with
+ * the fewest accesses and inherits its count as error (Space-Saving). This
+ * keeps the most accessed addresses, with their count overestimated by at
+ * most the error, in fixed memory.
+ */
+class AddressTraceTable
+{
+  public:
+    /** @param capacity Limit on the addresses tracked, or 0 for none */
+    void setCapacity(size_t capacity);
+
+    void update(Addr addr, RubyRequestType type, RubyAccessMode access_mode,
+                NodeID id, bool sharing_miss);
+    void addSample(Addr addr, int value);
+    void clear();
+
+    const AddressMap &getTraces() const { return m_traces; }
+    uint64_t getEvictions() const { return m_evictions; }
+
+  private:
+    /**
+     * Get the trace of an address, replacing another one if the table is
+     * full, and take it out of the count index until endUpdate().
+     */
+    AccessTraceForAddress &beginUpdate(Addr addr);
+    void endUpdate(const AccessTraceForAddress &trace);
+
+    size_t m_capacity = 0;
+    AddressMap m_traces;
+    /** Tracked addresses by estimated count, if the table is bounded */
+    std::set<std::pair<uint64_t, Addr>> m_by_count;
+    uint64_t m_evictions = 0;
+};
+
 class AddressProfiler
 {
   public:
-    typedef std::unordered_map<Addr, AccessTraceForAddress> AddressMap;
+    typedef ruby::AddressMap AddressMap;
 
   public:
     AddressProfiler(int num_of_sequencers, Profiler *profiler);
@@ -73,6 +113,8 @@ class AddressProfiler
     //added by SS
     void setHotLines(bool hot_lines);
     void setAllInstructions(bool all_instructions);
+    void setTableSize(size_t table_size);
+    void setSamplingRatio(unsigned sampling_ratio);
     void regStats(const std::string &name) {}
     void collateStats() {}
 
@@ -83,10 +125,12 @@ class AddressProfiler
 
     int64_t m_sharing_miss_counter;
 
-    AddressMap m_dataAccessTrace;
-    AddressMap m_macroBlockAccessTrace;
-    AddressMap m_programCounterAccessTrace;
-    AddressMap m_retryProfileMap;
+    bool isSampled(Addr line_addr) const;
+
+    AddressTraceTable m_dataAccessTrace;
+    AddressTraceTable m_macroBlockAccessTrace;
+    AddressTraceTable m_programCounterAccessTrace;
+    AddressTraceTable m_retryProfileMap;
     Histogram m_retryProfileHisto;
     Histogram m_retryProfileHistoWrite;
     Histogram m_retryProfileHistoRead;
@@ -99,6 +143,11 @@ class AddressProfiler
     bool m_hot_lines;
     bool m_all_instructions;
 
+    /** Limit on the addresses in each table, or 0 for none */
+    size_t m_table_size;
+    /** Only the accesses to one in this many lines are profiled */
+    unsigned m_sampling_ratio;
+
     int m_num_of_sequencers;
 };
 
@@ -107,7 +156,7 @@ AccessTraceForAddress& lookupTraceForAddress(Addr addr,
                                              record_map);
 
 void printSorted(std::ostream& out, int num_of_sequencers,
-                 const AddressProfiler::AddressMap &record_map,
+                 const AddressTraceTable &table,
                  std::string description, Profiler *profiler);
 
 inline std::ostream&
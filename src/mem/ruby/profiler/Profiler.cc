@@ -95,11 +95,15 @@ Profiler::Profiler(const RubySystemParams &p, RubySystem *rs)
     m_address_profiler_ptr = new AddressProfiler(p.num_of_sequencers, this);
     m_address_profiler_ptr->setHotLines(m_hot_lines);
     m_address_profiler_ptr->setAllInstructions(m_all_instructions);
+    m_address_profiler_ptr->setTableSize(p.hot_lines_table_size);
+    m_address_profiler_ptr->setSamplingRatio(p.hot_lines_sampling);
 
     if (m_all_instructions) {
         m_inst_profiler_ptr = new AddressProfiler(p.num_of_sequencers, this);
         m_inst_profiler_ptr->setHotLines(m_hot_lines);
         m_inst_profiler_ptr->setAllInstructions(m_all_instructions);
+        m_inst_profiler_ptr->setTableSize(p.hot_lines_table_size);
+        m_inst_profiler_ptr->setSamplingRatio(p.hot_lines_sampling);
     }
 }
 
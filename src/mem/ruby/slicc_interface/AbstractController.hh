@@ -170,6 +170,15 @@ class AbstractController : public ClockedObject, public Consumer
                                  const bool& was_miss)
     { }
 
+    //! Installs a block of a cache warmup trace directly in the state it
+    //! was recorded in, so no request has to be issued to fetch it.
+    //! Returns false if the block must be fetched through the sequencer,
+    //! which is the default. Behavior is protocol-specific
+    virtual bool installWarmupBlock(const Addr& addr,
+                                    const RubyRequestType& type,
+                                    const uint8_t *data)
+    { return false; }
+
     //! Function for collating statistics from all the controllers of this
     //! particular type. This function should only be called from the
     //! version 0 of this controller type.
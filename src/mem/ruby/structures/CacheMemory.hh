@@ -43,10 +43,10 @@
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
+#include "base/types.hh"
 #include "mem/cache/replacement_policies/base.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/ruby/common/DataBlock.hh"
@@ -77,6 +77,9 @@ class CacheMemory : public SimObject
 
     void init();
 
+    // Only sets up the tag and replacement data arrays
+    bool parallelInitSafe() const override { return true; }
+
     // Public Methods
     // perform a cache access and see if we hit or not.  Return true on a hit.
     bool tryCacheAccess(Addr address, RubyRequestType type,
@@ -179,10 +182,18 @@ class CacheMemory : public SimObject
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
-    // The first index is the # of cache lines.
-    // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
-    std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    // Both arrays are indexed by set and way through cacheIndex(), so the
+    // ways of a set are contiguous. m_tags holds the line address of each
+    // way, or MaxAddr if the way is empty, so tag lookups only touch the
+    // tag array.
+    std::vector<AbstractCacheEntry*> m_cache;
+    std::vector<Addr> m_tags;
+
+    int64_t
+    cacheIndex(int64_t set, int64_t way) const
+    {
+        return set * m_cache_assoc + way;
+    }
 
     /** We use the replacement policies from the Classic memory system. */
     replacement_policy::Base *m_replacementPolicy_ptr;
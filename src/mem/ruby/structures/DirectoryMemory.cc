@@ -42,7 +42,9 @@
 #include "mem/ruby/structures/DirectoryMemory.hh"
 
 #include "base/addr_range.hh"
+#include "base/bitfield.hh"
 #include "base/intmath.hh"
+#include "base/logging.hh"
 #include "debug/RubyCache.hh"
 #include "debug/RubyStats.hh"
 #include "mem/ruby/slicc_interface/RubySlicc_Util.hh"
@@ -56,7 +58,8 @@ namespace ruby
 {
 
 DirectoryMemory::DirectoryMemory(const Params &p)
-    : SimObject(p), addrRanges(p.addr_ranges.begin(), p.addr_ranges.end())
+    : SimObject(p), m_max_entries(p.max_entries),
+      addrRanges(p.addr_ranges.begin(), p.addr_ranges.end())
 {
     m_size_bytes = 0;
     for (const auto &r: addrRanges) {
@@ -64,28 +67,31 @@ DirectoryMemory::DirectoryMemory(const Params &p)
     }
     m_size_bits = floorLog2(m_size_bytes);
     m_num_entries = 0;
+    m_num_allocated = 0;
     m_block_size = p.block_size;
     m_ruby_system = p.ruby_system;
+
+    fatal_if(!isPowerOf2(p.page_size) || p.page_size < m_block_size,
+             "%s: page_size must be a power of two of at least one block",
+             name());
+    m_page_bits = floorLog2(p.page_size / m_block_size);
 }
 
 void
 DirectoryMemory::init()
 {
     m_num_entries = m_size_bytes / m_block_size;
-    m_entries = new AbstractCacheEntry*[m_num_entries];
-    for (int i = 0; i < m_num_entries; i++)
-        m_entries[i] = NULL;
 }
 
 DirectoryMemory::~DirectoryMemory()
 {
     // free up all the directory entries
-    for (uint64_t i = 0; i < m_num_entries; i++) {
-        if (m_entries[i] != NULL) {
-            delete m_entries[i];
+    const uint64_t page_entries = 1ULL << m_page_bits;
+    for (auto &page: m_pages) {
+        for (uint64_t i = 0; i < page_entries; i++) {
+            delete page.second.entries[i];
         }
     }
-    delete [] m_entries;
 }
 
 bool
@@ -113,6 +119,24 @@ DirectoryMemory::mapAddressToLocalIdx(Addr address)
     return ret >> (floorLog2(m_block_size));
 }
 
+AbstractCacheEntry *&
+DirectoryMemory::entrySlot(uint64_t idx)
+{
+    Page &page = m_pages[idx >> m_page_bits];
+    if (!page.entries) {
+        page.entries.reset(new AbstractCacheEntry*[1ULL << m_page_bits]());
+    }
+    return page.entries[idx & mask(m_page_bits)];
+}
+
+void
+DirectoryMemory::touch(Addr address)
+{
+    auto it = m_lru_pos.find(address);
+    assert(it != m_lru_pos.end());
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+}
+
 AbstractCacheEntry*
 DirectoryMemory::lookup(Addr address)
 {
@@ -121,7 +145,15 @@ DirectoryMemory::lookup(Addr address)
 
     uint64_t idx = mapAddressToLocalIdx(address);
     assert(idx < m_num_entries);
-    return m_entries[idx];
+
+    auto it = m_pages.find(idx >> m_page_bits);
+    if (it == m_pages.end())
+        return NULL;
+
+    AbstractCacheEntry *entry = it->second.entries[idx & mask(m_page_bits)];
+    if (entry && m_max_entries)
+        touch(address);
+    return entry;
 }
 
 AbstractCacheEntry*
@@ -131,13 +163,25 @@ DirectoryMemory::allocate(Addr address, AbstractCacheEntry *entry)
     uint64_t idx;
     DPRINTF(RubyCache, "Looking up address: %#x\n", address);
 
+    panic_if(!cacheAvail(address),
+             "%s: no free entry for %#x, the protocol has to evict the "
+             "entry returned by cacheProbe() first", name(), address);
+
     idx = mapAddressToLocalIdx(address);
     assert(idx < m_num_entries);
-    assert(m_entries[idx] == NULL);
+    AbstractCacheEntry *&slot = entrySlot(idx);
+    assert(slot == NULL);
     entry->changePermission(AccessPermission_Read_Only);
     entry->initBlockSize(m_block_size);
     entry->setRubySystem(m_ruby_system);
-    m_entries[idx] = entry;
+    slot = entry;
+
+    m_pages[idx >> m_page_bits].numAllocated++;
+    m_num_allocated++;
+    if (m_max_entries) {
+        m_lru.push_front(address);
+        m_lru_pos[address] = m_lru.begin();
+    }
 
     return entry;
 }
@@ -151,9 +195,38 @@ DirectoryMemory::deallocate(Addr address)
 
     idx = mapAddressToLocalIdx(address);
     assert(idx < m_num_entries);
-    assert(m_entries[idx] != NULL);
-    delete m_entries[idx];
-    m_entries[idx] = NULL;
+    auto it = m_pages.find(idx >> m_page_bits);
+    assert(it != m_pages.end());
+    Page &page = it->second;
+    AbstractCacheEntry *&slot = page.entries[idx & mask(m_page_bits)];
+    assert(slot != NULL);
+    delete slot;
+    slot = NULL;
+
+    m_num_allocated--;
+    if (--page.numAllocated == 0)
+        m_pages.erase(it);
+
+    if (m_max_entries) {
+        auto pos = m_lru_pos.find(address);
+        assert(pos != m_lru_pos.end());
+        m_lru.erase(pos->second);
+        m_lru_pos.erase(pos);
+    }
+}
+
+bool
+DirectoryMemory::cacheAvail(Addr address) const
+{
+    return m_max_entries == 0 || m_num_allocated < m_max_entries;
+}
+
+Addr
+DirectoryMemory::cacheProbe(Addr address) const
+{
+    assert(!cacheAvail(address));
+    assert(!m_lru.empty());
+    return m_lru.back();
 }
 
 void
@@ -42,7 +42,10 @@
 #define __MEM_RUBY_STRUCTURES_DIRECTORYMEMORY_HH__
 
 #include <iostream>
+#include <list>
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "base/addr_range.hh"
 #include "mem/ruby/common/Address.hh"
@@ -88,6 +91,30 @@ class DirectoryMemory : public SimObject
     // Explicitly free up this address
     void deallocate(Addr address);
 
+    /**
+     * Check if an entry can be allocated for an address. This is always
+     * the case unless the directory has a bounded number of entries and
+     * all of them are in use.
+     *
+     * @param address the address an entry is needed for
+     * @return true if allocate() can be called for the address
+     */
+    bool cacheAvail(Addr address) const;
+
+    /**
+     * Pick the entry to evict to make room for an address in a bounded
+     * directory. The least recently looked up entry is chosen. The
+     * protocol has to invalidate the sharers of the returned address and
+     * deallocate its entry before allocating the new one.
+     *
+     * @param address the address an entry is needed for
+     * @return the address of the victim entry
+     */
+    Addr cacheProbe(Addr address) const;
+
+    /** Number of entries currently allocated. */
+    uint64_t getNumAllocated() const { return m_num_allocated; }
+
     void print(std::ostream& out) const;
     void recordRequestType(DirectoryRequestType requestType);
 
@@ -97,8 +124,23 @@ class DirectoryMemory : public SimObject
     DirectoryMemory& operator=(const DirectoryMemory& obj);
 
   private:
+    /**
+     * A page of directory entries. Pages are only allocated once an
+     * entry in them is, and freed when their last entry is deallocated,
+     * so the footprint follows the memory that is actually touched.
+     */
+    struct Page
+    {
+        std::unique_ptr<AbstractCacheEntry*[]> entries;
+        uint64_t numAllocated = 0;
+    };
+
+    AbstractCacheEntry *&entrySlot(uint64_t idx);
+
+    void touch(Addr address);
+
     const std::string m_name;
-    AbstractCacheEntry **m_entries;
+    std::unordered_map<uint64_t, Page> m_pages;
     // int m_size;  // # of memory module blocks this directory is
                     // responsible for
     uint64_t m_size_bytes;
@@ -106,6 +148,17 @@ class DirectoryMemory : public SimObject
     uint64_t m_num_entries;
     uint32_t m_block_size;
 
+    /** Number of entries per page, as a power of two. */
+    uint64_t m_page_bits;
+    uint64_t m_num_allocated;
+
+    /** Maximum number of allocated entries, 0 if unbounded. */
+    const uint64_t m_max_entries;
+
+    /** Recency order of the entries of a bounded directory, MRU first. */
+    std::list<Addr> m_lru;
+    std::unordered_map<Addr, std::list<Addr>::iterator> m_lru_pos;
+
     RubySystem *m_ruby_system = nullptr;
 
     /**
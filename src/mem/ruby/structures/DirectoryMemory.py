@@ -53,3 +53,13 @@ class RubyDirectoryMemory(SimObject):
         "Size of a block in bytes. Usually same as cache line size."
     )
     ruby_system = Param.RubySystem(Parent.any, "")
+    page_size = Param.MemorySize(
+        "4KiB",
+        "Granularity at which directory entries are allocated on first use",
+    )
+    max_entries = Param.UInt64(
+        0,
+        "Maximum number of allocated entries, or 0 for an unbounded "
+        "directory. When bounded, the protocol has to evict the entry "
+        "chosen by cacheProbe() before allocating a new one.",
+    )
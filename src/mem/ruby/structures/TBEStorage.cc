@@ -44,10 +44,11 @@ namespace ruby
 {
 
 TBEStorage::TBEStorage(statistics::Group *parent, int number_of_TBEs)
-    : m_reserved(0), m_stats(parent)
+    : m_reserved(0), m_slot_entries(number_of_TBEs, 0), m_stats(parent)
 {
+    m_slots_avail.reserve(number_of_TBEs);
     for (int i = 0; i < number_of_TBEs; ++i)
-        m_slots_avail.push(i);
+        m_slots_avail.push_back(i);
 }
 
 TBEStorage::TBEStorageStats::TBEStorageStats(statistics::Group *parent)
@@ -39,8 +39,7 @@
 #define __MEM_RUBY_STRUCTURES_TBESTORAGE_HH__
 
 #include <cassert>
-#include <stack>
-#include <unordered_map>
+#include <vector>
 
 #include <base/statistics.hh>
 
@@ -82,10 +81,10 @@ class TBEStorage
     TBEStorage(statistics::Group *parent, int number_of_TBEs);
 
     // Returns the current number of slots allocated
-    int size() const { return m_slots_used.size(); }
+    int size() const { return capacity() - m_slots_avail.size(); }
 
     // Returns the total capacity of this TBEStorage table
-    int capacity() const { return m_slots_used.size() + m_slots_avail.size(); }
+    int capacity() const { return m_slot_entries.size(); }
 
     // Returns number of slots currently reserved
     int reserved() const { return m_reserved; }
@@ -121,8 +120,10 @@ class TBEStorage
 
   private:
     int m_reserved;
-    std::stack<int> m_slots_avail;
-    std::unordered_map<int, int> m_slots_used;
+    // Free slots, the next one to be assigned at the back
+    std::vector<int> m_slots_avail;
+    // Number of entries assigned to each slot, 0 if the slot is free
+    std::vector<int> m_slot_entries;
 
     struct TBEStorageStats : public statistics::Group
     {
@@ -161,9 +162,10 @@ TBEStorage::addEntryToNewSlot()
 {
     assert(slotsAvailable() > 0);
     assert(m_slots_avail.size() > 0);
-    int slot = m_slots_avail.top();
-    m_slots_used[slot] = 1;
-    m_slots_avail.pop();
+    int slot = m_slots_avail.back();
+    assert(m_slot_entries[slot] == 0);
+    m_slot_entries[slot] = 1;
+    m_slots_avail.pop_back();
     m_stats.avg_size = size();
     m_stats.avg_util = utilization();
     return slot;
@@ -172,22 +174,16 @@ TBEStorage::addEntryToNewSlot()
 inline void
 TBEStorage::addEntryToSlot(int slot)
 {
-    auto iter = m_slots_used.find(slot);
-    assert(iter != m_slots_used.end());
-    iter->second += 1;
+    assert(m_slot_entries[slot] > 0);
+    m_slot_entries[slot] += 1;
 }
 
 inline void
 TBEStorage::removeEntryFromSlot(int slot)
 {
-    auto iter = m_slots_used.find(slot);
-    assert(iter != m_slots_used.end());
-    assert(iter->second > 0);
-    iter->second -= 1;
-    if (iter->second == 0) {
-        m_slots_used.erase(iter);
-        m_slots_avail.push(slot);
-    }
+    assert(m_slot_entries[slot] > 0);
+    if (--m_slot_entries[slot] == 0)
+        m_slots_avail.push_back(slot);
     m_stats.avg_size = size();
     m_stats.avg_util = utilization();
 }
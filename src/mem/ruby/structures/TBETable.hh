@@ -41,9 +41,12 @@
 #ifndef __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 #define __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 
+#include <algorithm>
 #include <iostream>
-#include <unordered_map>
+#include <optional>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
@@ -58,8 +61,17 @@ class TBETable
 {
   public:
     TBETable(int number_of_TBEs)
-        : m_number_of_TBEs(number_of_TBEs)
+        : m_entries(number_of_TBEs), m_slot_addr(number_of_TBEs),
+          m_number_of_TBEs(number_of_TBEs)
     {
+        // Keep the index at most half full so probe sequences stay short
+        int index_bits = std::max(1, ceilLog2(2 * number_of_TBEs));
+        m_index.resize(size_t(1) << index_bits, -1);
+        m_index_shift = 64 - index_bits;
+
+        m_free_slots.reserve(number_of_TBEs);
+        for (int slot = number_of_TBEs - 1; slot >= 0; slot--)
+            m_free_slots.push_back(slot);
     }
 
     bool isPresent(Addr address) const;
@@ -68,7 +80,7 @@ class TBETable
     bool
     areNSlotsAvailable(int n, Tick current_time) const
     {
-        return (m_number_of_TBEs - m_map.size()) >= n;
+        return (int)m_free_slots.size() >= n;
     }
 
     void setRubySystem(RubySystem* rs);
@@ -85,9 +97,28 @@ class TBETable
     TBETable& operator=(const TBETable& obj);
 
     // Data Members (m_prefix)
-    std::unordered_map<Addr, ENTRY> m_map;
+    // One slot per TBE, engaged while the TBE is allocated. Entries
+    // never move, so pointers returned by lookup() stay valid until
+    // the TBE is deallocated.
+    std::vector<std::optional<ENTRY>> m_entries;
 
   private:
+    size_t
+    indexOf(Addr address) const
+    {
+        return (address * 0x9E3779B97F4A7C15ULL) >> m_index_shift;
+    }
+
+    // Position of an address in m_index, or -1 if not present
+    int findIndex(Addr address) const;
+
+    // Line address held by each slot
+    std::vector<Addr> m_slot_addr;
+    std::vector<int> m_free_slots;
+    // Open-addressed map from line address to slot, -1 if empty
+    std::vector<int> m_index;
+    unsigned m_index_shift = 0;
+
     int m_number_of_TBEs = 0;
     int m_block_size = 0;
     RubySystem* m_ruby_system = nullptr;
@@ -113,13 +144,24 @@ void TBETable<ENTRY>::setRubySystem(RubySystem* rs)
     m_block_size = rs->getBlockSizeBytes();
 }
 
+template<class ENTRY>
+inline int
+TBETable<ENTRY>::findIndex(Addr address) const
+{
+    const size_t mask = m_index.size() - 1;
+    for (size_t i = indexOf(address); m_index[i] >= 0; i = (i + 1) & mask) {
+        if (m_slot_addr[m_index[i]] == address)
+            return i;
+    }
+    return -1;
+}
+
 template<class ENTRY>
 inline bool
 TBETable<ENTRY>::isPresent(Addr address) const
 {
     assert(address == makeLineAddress(address, floorLog2(m_block_size)));
-    assert(m_map.size() <= m_number_of_TBEs);
-    return !!m_map.count(address);
+    return findIndex(address) >= 0;
 }
 
 template<class ENTRY>
@@ -127,20 +169,47 @@ inline void
 TBETable<ENTRY>::allocate(Addr address)
 {
     assert(!isPresent(address));
-    assert(m_map.size() < m_number_of_TBEs);
+    assert(!m_free_slots.empty());
     assert(m_block_size > 0);
-    ENTRY new_entry = ENTRY(m_block_size);
-    new_entry.setRubySystem(m_ruby_system);
-    m_map.emplace(address, new_entry);
+
+    int slot = m_free_slots.back();
+    m_free_slots.pop_back();
+    m_entries[slot].emplace(m_block_size);
+    m_entries[slot]->setRubySystem(m_ruby_system);
+    m_slot_addr[slot] = address;
+
+    const size_t mask = m_index.size() - 1;
+    size_t i = indexOf(address);
+    while (m_index[i] >= 0)
+        i = (i + 1) & mask;
+    m_index[i] = slot;
 }
 
 template<class ENTRY>
 inline void
 TBETable<ENTRY>::deallocate(Addr address)
 {
-    assert(isPresent(address));
-    assert(m_map.size() > 0);
-    m_map.erase(address);
+    int pos = findIndex(address);
+    assert(pos >= 0);
+    size_t i = pos;
+    int slot = m_index[i];
+    m_entries[slot].reset();
+    m_free_slots.push_back(slot);
+    m_index[i] = -1;
+
+    // Shift back the entries that follow in the probe sequence so that
+    // lookups never have to skip over the hole
+    const size_t mask = m_index.size() - 1;
+    for (size_t j = (i + 1) & mask; m_index[j] >= 0; j = (j + 1) & mask) {
+        const size_t home = indexOf(m_slot_addr[m_index[j]]);
+        const bool reachable = (i <= j) ? (i < home && home <= j) :
+                                          (i < home || home <= j);
+        if (!reachable) {
+            m_index[i] = m_index[j];
+            m_index[j] = -1;
+            i = j;
+        }
+    }
 }
 
 template<class ENTRY>
@@ -155,8 +224,8 @@ template<class ENTRY>
 inline ENTRY*
 TBETable<ENTRY>::lookup(Addr address)
 {
-  if (m_map.find(address) != m_map.end()) return &(m_map.find(address)->second);
-  return NULL;
+    int i = findIndex(address);
+    return i >= 0 ? &*m_entries[m_index[i]] : nullptr;
 }
 
 
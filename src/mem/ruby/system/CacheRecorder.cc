@@ -29,8 +29,12 @@
 
 #include "mem/ruby/system/CacheRecorder.hh"
 
+#include <algorithm>
+#include <numeric>
+
 #include "debug/RubyCacheTrace.hh"
 #include "mem/packet.hh"
+#include "mem/ruby/slicc_interface/AbstractController.hh"
 #include "mem/ruby/system/RubySystem.hh"
 #include "mem/ruby/system/Sequencer.hh"
 #include "sim/sim_exit.hh"
@@ -52,11 +56,14 @@ TraceRecord::print(std::ostream& out) const
 CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
                              uint64_t uncompressed_trace_size,
                              std::vector<RubyPort*>& ruby_port_map,
+                             const std::vector<AbstractController*>&
+                                 controllers,
                              uint64_t trace_block_size_bytes,
                              uint64_t system_block_size_bytes)
-    : m_uncompressed_trace(uncompressed_trace),
+    : m_num_records(0), m_uncompressed_trace(uncompressed_trace),
       m_uncompressed_trace_size(uncompressed_trace_size),
-      m_ruby_port_map(ruby_port_map), m_bytes_read(0),
+      m_ruby_port_map(ruby_port_map), m_controllers(controllers),
+      m_bytes_read(0),
       m_records_read(0), m_records_flushed(0),
       m_block_size_bytes(trace_block_size_bytes)
 
@@ -84,12 +91,12 @@ CacheRecorder::~CacheRecorder()
 void
 CacheRecorder::enqueueNextFlushRequest()
 {
-    if (m_records_flushed < m_records.size()) {
-        TraceRecord* rec = m_records[m_records_flushed];
+    if (m_records_flushed < m_num_records) {
+        TraceRecord* rec = getRecord(m_records_flushed);
         m_records_flushed++;
-        auto req = std::make_shared<Request>(rec->m_data_address,
-                                             m_block_size_bytes, 0,
-                                             Request::funcRequestorId);
+        auto req = makeRequest(rec->m_data_address,
+                               m_block_size_bytes, 0,
+                               Request::funcRequestorId);
         MemCmd::Command requestType = MemCmd::FlushReq;
         Packet *pkt = new Packet(req, requestType);
         pkt->req->setReqInstSeqNum(m_records_flushed);
@@ -112,6 +119,22 @@ CacheRecorder::enqueueNextFlushRequest()
 void
 CacheRecorder::enqueueNextFetchRequest()
 {
+    // Install the blocks that don't need a request right away
+    while (m_bytes_read < m_uncompressed_trace_size) {
+        TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
+                                                                m_bytes_read);
+        AbstractController *cntrl = m_controllers[traceRecord->m_cntrl_id];
+        if (!cntrl->installWarmupBlock(traceRecord->m_data_address,
+                                       traceRecord->m_type,
+                                       traceRecord->m_data)) {
+            break;
+        }
+
+        DPRINTF(RubyCacheTrace, "Installed %s\n", *traceRecord);
+        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
+        m_records_read++;
+    }
+
     if (m_bytes_read < m_uncompressed_trace_size) {
         TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
                                                                 m_bytes_read);
@@ -125,19 +148,19 @@ CacheRecorder::enqueueNextFetchRequest()
 
             if (traceRecord->m_type == RubyRequestType_LD) {
                 requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
+                req = makeRequest(
                     traceRecord->m_data_address + rec_bytes_read,
                     m_block_size_bytes, 0,
                                     Request::funcRequestorId);
             }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
                 requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
+                req = makeRequest(
                         traceRecord->m_data_address + rec_bytes_read,
                         m_block_size_bytes,
                         Request::INST_FETCH, Request::funcRequestorId);
             }   else {
                 requestType = MemCmd::WriteReq;
-                req = std::make_shared<Request>(
+                req = makeRequest(
                     traceRecord->m_data_address + rec_bytes_read,
                     m_block_size_bytes, 0,
                                 Request::funcRequestorId);
@@ -166,8 +189,8 @@ void
 CacheRecorder::addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                          RubyRequestType type, Tick time, DataBlock& data)
 {
-    TraceRecord* rec = (TraceRecord*)malloc(sizeof(TraceRecord) +
-                                            m_block_size_bytes);
+    m_records.resize(m_records.size() + recordSize());
+    TraceRecord* rec = getRecord(m_num_records++);
     rec->m_cntrl_id     = cntrl;
     rec->m_time         = time;
     rec->m_data_address = data_addr;
@@ -178,49 +201,51 @@ CacheRecorder::addRecord(int cntrl, Addr data_addr, Addr pc_addr,
 
     DPRINTF(RubyCacheTrace, "Inside addRecord with cntrl id %d and type %d\n",
             cntrl, type);
-    m_records.push_back(rec);
 }
 
 uint64_t
-CacheRecorder::aggregateRecords(uint8_t **buf, uint64_t total_size)
+CacheRecorder::writeRecords(
+    const std::function<void(const uint8_t *, uint64_t)> &write)
 {
-    std::sort(m_records.begin(), m_records.end(), compareTraceRecords);
-
-    int size = m_records.size();
-    uint64_t current_size = 0;
-    int record_size = sizeof(TraceRecord) + m_block_size_bytes;
-
-    for (int i = 0; i < size; ++i) {
-        // Determine if we need to expand the buffer size
-        if (current_size + record_size > total_size) {
-            uint8_t* new_buf = new (std::nothrow) uint8_t[total_size * 2];
-            if (new_buf == NULL) {
-                fatal("Unable to allocate buffer of size %s\n",
-                      total_size * 2);
-            }
-            total_size = total_size * 2;
-            uint8_t* old_buf = *buf;
-            memcpy(new_buf, old_buf, current_size);
-            *buf = new_buf;
-            delete [] old_buf;
+    // Order the records by last access, most recent first
+    std::vector<uint64_t> order(m_num_records);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](uint64_t a, uint64_t b)
+              { return getRecord(a)->m_time > getRecord(b)->m_time; });
+
+    // Gather runs of records into a bounded staging buffer, so the writer
+    // sees large chunks without the trace being duplicated in memory
+    const uint64_t record_size = recordSize();
+    const uint64_t chunk_records = std::max<uint64_t>(1,
+        (1 << 20) / record_size);
+    std::vector<uint8_t> chunk;
+    chunk.reserve(chunk_records * record_size);
+
+    uint64_t total_size = 0;
+    for (uint64_t idx : order) {
+        const uint8_t *rec = (const uint8_t *)getRecord(idx);
+        chunk.insert(chunk.end(), rec, rec + record_size);
+        if (chunk.size() == chunk_records * record_size) {
+            write(chunk.data(), chunk.size());
+            total_size += chunk.size();
+            chunk.clear();
         }
-
-        // Copy the current record into the buffer
-        memcpy(&((*buf)[current_size]), m_records[i], record_size);
-        current_size += record_size;
-
-        free(m_records[i]);
-        m_records[i] = NULL;
+    }
+    if (!chunk.empty()) {
+        write(chunk.data(), chunk.size());
+        total_size += chunk.size();
     }
 
     m_records.clear();
-    return current_size;
+    m_records.shrink_to_fit();
+    m_num_records = 0;
+    return total_size;
 }
 
 uint64_t
 CacheRecorder::getNumRecords() const
 {
-    return m_records.size();
+    return m_num_records;
 }
 
 } // namespace ruby
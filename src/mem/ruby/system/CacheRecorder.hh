@@ -35,6 +35,7 @@
 #ifndef __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 #define __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 
+#include <functional>
 #include <vector>
 
 #include "base/types.hh"
@@ -49,6 +50,7 @@ namespace gem5
 namespace ruby
 {
 
+class AbstractController;
 class Sequencer;
 class RubyPort;
 /*!
@@ -78,6 +80,7 @@ class CacheRecorder
     CacheRecorder(uint8_t* uncompressed_trace,
                   uint64_t uncompressed_trace_size,
                   std::vector<RubyPort*>& ruby_port_map,
+                  const std::vector<AbstractController*>& controllers,
                   uint64_t trace_block_size_bytes,
                   uint64_t system_block_size_bytes);
     ~CacheRecorder();
@@ -85,7 +88,16 @@ class CacheRecorder
     void addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                    RubyRequestType type, Tick time, DataBlock& data);
 
-    uint64_t aggregateRecords(uint8_t **data, uint64_t size);
+    /*!
+     * Write the recorded trace, most recently accessed blocks first, and
+     * drop the records. The records are passed to the writer in chunks as
+     * they are stored, so the trace is never copied as a whole.
+     *
+     * @param write called with each chunk of the trace to write
+     * @return the size of the trace in bytes
+     */
+    uint64_t writeRecords(
+        const std::function<void(const uint8_t *, uint64_t)> &write);
 
     uint64_t getNumRecords() const;
 
@@ -104,7 +116,9 @@ class CacheRecorder
      * through the recorded contents of the caches, as available in the
      * checkpoint and issues fetch requests. Except for the first one, a
      * fetch request is issued only after the previous one has completed.
-     * It should be possible to use this with any protocol.
+     * It should be possible to use this with any protocol. Blocks that the
+     * controller that recorded them can install directly, see
+     * AbstractController::installWarmupBlock(), need no request.
      */
     void enqueueNextFetchRequest();
 
@@ -113,22 +127,31 @@ class CacheRecorder
     CacheRecorder(const CacheRecorder& obj);
     CacheRecorder& operator=(const CacheRecorder& obj);
 
-    std::vector<TraceRecord*> m_records;
+    TraceRecord *
+    getRecord(uint64_t idx)
+    {
+        return (TraceRecord *)&m_records[idx * recordSize()];
+    }
+
+    uint64_t
+    recordSize() const
+    {
+        return sizeof(TraceRecord) + m_block_size_bytes;
+    }
+
+    // The recorded trace, records of recordSize() bytes back to back
+    std::vector<uint8_t> m_records;
+    uint64_t m_num_records;
     uint8_t* m_uncompressed_trace;
     uint64_t m_uncompressed_trace_size;
     std::vector<RubyPort*> m_ruby_port_map;
+    std::vector<AbstractController*> m_controllers;
     uint64_t m_bytes_read;
     uint64_t m_records_read;
     uint64_t m_records_flushed;
     uint64_t m_block_size_bytes;
 };
 
-inline bool
-compareTraceRecords(const TraceRecord* n1, const TraceRecord* n2)
-{
-    return n1->m_time > n2->m_time;
-}
-
 inline std::ostream&
 operator<<(std::ostream& out, const TraceRecord& obj)
 {
@@ -173,9 +173,9 @@ HTMSequencer::htmCallback(Addr address,
                mode == HtmCallbackMode_ST_FAIL) {
         // transaction failed
         assert(address == makeLineAddress(address));
-        assert(m_RequestTable.find(address) != m_RequestTable.end());
+        assert(m_RequestTable.find(address));
 
-        auto &seq_req_list = m_RequestTable[address];
+        auto &seq_req_list = *m_RequestTable.find(address);
         while (!seq_req_list.empty()) {
             SequencerRequest &request = seq_req_list.front();
 
@@ -198,12 +198,10 @@ HTMSequencer::htmCallback(Addr address,
             rubyHtmCallback(pkt, htm_return_code);
             testDrainComplete();
             pkt = nullptr;
-            seq_req_list.pop_front();
+            m_RequestTable.popFront(seq_req_list);
         }
         // free all outstanding requests corresponding to this address
-        if (seq_req_list.empty()) {
-            m_RequestTable.erase(address);
-        }
+        m_RequestTable.releaseIfEmpty(seq_req_list);
     } else {
         panic("unrecognised HTM callback mode\n");
     }
@@ -220,7 +218,7 @@ HTMSequencer::rubyHtmCallback(PacketPtr pkt,
 
     // First retrieve the request port from the sender State
     RubyPort::SenderState *senderState =
-        safe_cast<RubyPort::SenderState *>(pkt->popSenderState());
+        pkt->popSenderState<RubyPort::SenderState>();
 
     MemResponsePort *port = safe_cast<MemResponsePort*>(senderState->port);
     assert(port != nullptr);
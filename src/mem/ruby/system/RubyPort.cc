@@ -193,7 +193,7 @@ bool RubyPort::MemRequestPort::recvTimingResp(PacketPtr pkt)
 
     // First we must retrieve the request port from the sender State
     RubyPort::SenderState *senderState =
-        safe_cast<RubyPort::SenderState *>(pkt->popSenderState());
+        pkt->popSenderState<RubyPort::SenderState>();
     MemResponsePort *port = senderState->port;
     assert(port != NULL);
     delete senderState;
@@ -276,7 +276,7 @@ RubyPort::MemResponsePort::recvTimingReq(PacketPtr pkt)
 
             // Save the port in the sender state object to be used later to
             // route the response
-            pkt->pushSenderState(new SenderState(this));
+            pkt->emplaceSenderState<SenderState>(this);
 
             // send next cycle
             RubySystem *rs = owner.m_ruby_system;
@@ -288,7 +288,7 @@ RubyPort::MemResponsePort::recvTimingReq(PacketPtr pkt)
 
     // Save the port in the sender state object to be used later to
     // route the response
-    pkt->pushSenderState(new SenderState(this));
+    pkt->emplaceSenderState<SenderState>(this);
 
     // Submit the ruby request
     RequestStatus requestStatus = owner.makeRequest(pkt);
@@ -303,7 +303,7 @@ RubyPort::MemResponsePort::recvTimingReq(PacketPtr pkt)
     }
 
     // pop off sender state as this request failed to issue
-    SenderState *ss = safe_cast<SenderState *>(pkt->popSenderState());
+    SenderState *ss = pkt->popSenderState<SenderState>();
     delete ss;
 
     if (pkt->cmd != MemCmd::MemSyncReq) {
@@ -338,7 +338,7 @@ RubyPort::MemResponsePort::recvAtomic(PacketPtr pkt)
 
             // Save the port in the sender state object to be used later to
             // route the response
-            pkt->pushSenderState(new SenderState(this));
+            pkt->emplaceSenderState<SenderState>(this);
 
             // send next cycle
             Tick req_ticks = owner.memRequestPort.sendAtomic(pkt);
@@ -473,7 +473,7 @@ RubyPort::ruby_hit_callback(PacketPtr pkt)
 
     // First we must retrieve the request port from the sender State
     RubyPort::SenderState *senderState =
-        safe_cast<RubyPort::SenderState *>(pkt->popSenderState());
+        pkt->popSenderState<RubyPort::SenderState>();
     MemResponsePort *port = senderState->port;
     assert(port != NULL);
     delete senderState;
@@ -492,7 +492,7 @@ RubyPort::ruby_unaddressed_callback(PacketPtr pkt)
 
     // First we must retrieve the request port from the sender State
     RubyPort::SenderState *senderState =
-        safe_cast<RubyPort::SenderState *>(pkt->popSenderState());
+        pkt->popSenderState<RubyPort::SenderState>();
     MemResponsePort *port = senderState->port;
     assert(port != NULL);
     delete senderState;
@@ -510,7 +510,7 @@ RubyPort::ruby_stale_translation_callback(Addr txnId)
     // Allocate the invalidate request and packet on the stack, as it is
     // assumed they will not be modified or deleted by receivers.
     // TODO: should this really be using funcRequestorId?
-    auto request = std::make_shared<Request>(
+    auto request = gem5::makeRequest(
         0, m_ruby_system->getBlockSizeBytes(), Request::TLBI_EXT_SYNC,
         Request::funcRequestorId);
     // Store the txnId in extraData instead of the address
@@ -710,7 +710,7 @@ RubyPort::ruby_eviction_callback(Addr address)
     // Allocate the invalidate request and packet on the stack, as it is
     // assumed they will not be modified or deleted by receivers.
     // TODO: should this really be using funcRequestorId?
-    auto request = std::make_shared<Request>(
+    auto request = gem5::makeRequest(
         address, m_ruby_system->getBlockSizeBytes(), 0,
         Request::funcRequestorId);
 
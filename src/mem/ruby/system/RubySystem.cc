@@ -43,6 +43,7 @@
 #include <fcntl.h>
 #include <zlib.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <list>
 
@@ -216,7 +217,8 @@ RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
 
     // Create the CacheRecorder and record the cache trace
     m_cache_recorder = new CacheRecorder(uncompressed_trace, cache_trace_size,
-                                         ruby_port_map, block_size_bytes,
+                                         ruby_port_map, m_abs_cntrl_vec,
+                                         block_size_bytes,
                                          m_block_size_bytes);
 }
 
@@ -300,9 +302,9 @@ RubySystem::memWriteback()
     // checkpoint is immediately taken.
 }
 
-void
-RubySystem::writeCompressedTrace(uint8_t *raw_data, std::string filename,
-                                 uint64_t uncompressed_trace_size)
+uint64_t
+RubySystem::writeCompressedTrace(CacheRecorder *recorder,
+                                 std::string filename)
 {
     // Create the checkpoint file for the memory
     std::string thefile = CheckpointIn::dir() + "/" + filename.c_str();
@@ -318,15 +320,19 @@ RubySystem::writeCompressedTrace(uint8_t *raw_data, std::string filename,
         fatal("Insufficient memory to allocate compression state for %s\n",
               filename);
 
-    if (gzwrite(compressedMemory, raw_data, uncompressed_trace_size) !=
-        uncompressed_trace_size) {
-        fatal("Write failed on memory trace file '%s'\n", filename);
-    }
+    uint64_t uncompressed_trace_size = recorder->writeRecords(
+        [&](const uint8_t *data, uint64_t size)
+        {
+            if (gzwrite(compressedMemory, data, size) != size) {
+                fatal("Write failed on memory trace file '%s'\n",
+                      filename);
+            }
+        });
 
     if (gzclose(compressedMemory)) {
         fatal("Close failed on memory trace file '%s'\n", filename);
     }
-    delete[] raw_data;
+    return uncompressed_trace_size;
 }
 
 void
@@ -346,12 +352,10 @@ RubySystem::serialize(CheckpointOut &cp) const
                 "ruby trace");
     }
 
-    // Aggregate the trace entries together into a single array
-    uint8_t *raw_data = new uint8_t[4096];
-    uint64_t cache_trace_size = m_cache_recorder->aggregateRecords(
-                                                        &raw_data, 4096);
+    // Stream the trace entries straight into the compressed file
     std::string cache_trace_file = name() + ".cache.gz";
-    writeCompressedTrace(raw_data, cache_trace_file, cache_trace_size);
+    uint64_t cache_trace_size = writeCompressedTrace(m_cache_recorder,
+                                                     cache_trace_file);
 
     SERIALIZE_SCALAR(cache_trace_file);
     SERIALIZE_SCALAR(cache_trace_size);
@@ -513,6 +517,40 @@ RubySystem::functionalRead(PacketPtr pkt) {
     }
 }
 
+const RubySystem::LineHolders &
+RubySystem::functionalHolders(Addr line_addr, int net_id)
+{
+    // Bound the cache for long runs of functional accesses with no
+    // simulation in between, e.g., while loading a workload
+    const size_t max_cached_lines = 4096;
+
+    if (m_func_holders_wakeups != Consumer::wakeupCount() ||
+        m_num_func_holders >= max_cached_lines) {
+        m_func_holders.clear();
+        m_num_func_holders = 0;
+        m_func_holders_wakeups = Consumer::wakeupCount();
+    }
+
+    auto &net_holders = m_func_holders[net_id];
+    auto it = net_holders.find(line_addr);
+    if (it != net_holders.end())
+        return it->second;
+
+    LineHolders &holders = net_holders[line_addr];
+    m_num_func_holders++;
+    const auto &cntrls =
+        net_id < 0 ? m_abs_cntrl_vec : netCntrls[net_id];
+    for (auto cntrl : cntrls) {
+        AccessPermission access_perm =
+            cntrl->getAccessPermission(line_addr);
+        if (access_perm != AccessPermission_Invalid &&
+            access_perm != AccessPermission_NotPresent) {
+            holders.emplace_back(cntrl, access_perm);
+        }
+    }
+    return holders;
+}
+
 bool
 RubySystem::simpleFunctionalRead(PacketPtr pkt)
 {
@@ -528,7 +566,6 @@ RubySystem::simpleFunctionalRead(PacketPtr pkt)
     unsigned int num_busy = 0;
     unsigned int num_maybe_stale = 0;
     unsigned int num_backing_store = 0;
-    unsigned int num_invalid = 0;
 
     // Only send functional requests within the same network.
     assert(requestorToNetwork.count(pkt->requestorId()));
@@ -542,8 +579,11 @@ RubySystem::simpleFunctionalRead(PacketPtr pkt)
 
     // In this loop we count the number of controllers that have the given
     // address in read only, read write and busy states.
-    for (auto& cntrl : netCntrls[request_net_id]) {
-        access_perm = cntrl-> getAccessPermission(line_address);
+    const LineHolders &holders =
+        functionalHolders(line_address, request_net_id);
+    for (auto& holder : holders) {
+        AbstractController *cntrl = holder.first;
+        access_perm = holder.second;
         if (access_perm == AccessPermission_Read_Only){
             num_ro++;
             if (ctrl_ro == nullptr) ctrl_ro = cntrl;
@@ -581,9 +621,6 @@ RubySystem::simpleFunctionalRead(PacketPtr pkt)
             if (ctrl_backing_store == nullptr)
                 ctrl_backing_store = cntrl;
         }
-        else if (access_perm == AccessPermission_Invalid ||
-                 access_perm == AccessPermission_NotPresent)
-            num_invalid++;
     }
 
     // This if case is meant to capture what happens in a Broadcast/Snoop
@@ -595,6 +632,7 @@ RubySystem::simpleFunctionalRead(PacketPtr pkt)
     // there are copies floating around the cache hierarchy, so you want to read
     // it only if it's not in the cache hierarchy at all.
     int num_controllers = netCntrls[request_net_id].size();
+    int num_invalid = num_controllers - holders.size();
     if (num_invalid == (num_controllers - 1) && num_backing_store == 1) {
         DPRINTF(RubySystem,
                 "only copy in Backing_Store memory, read from it\n");
@@ -669,8 +707,10 @@ RubySystem::partialFunctionalRead(PacketPtr pkt)
     AbstractController *ctrl_bs = nullptr;
 
     // Build lists of controllers that have line
-    for (auto ctrl : m_abs_cntrl_vec) {
-        switch(ctrl->getAccessPermission(line_address)) {
+    const LineHolders &holders = functionalHolders(line_address, -1);
+    for (auto& holder : holders) {
+        AbstractController *ctrl = holder.first;
+        switch(holder.second) {
             case AccessPermission_Read_Only:
                 ctrl_ro.push_back(ctrl);
                 break;
@@ -738,10 +778,20 @@ RubySystem::partialFunctionalRead(PacketPtr pkt)
         for (auto& network : m_networks) {
             network->functionalRead(pkt, bytes);
         }
+        // Controllers in other states, including the ones that do not
+        // hold the line at all
         for (auto ctrl : ctrl_others) {
             ctrl->functionalRead(line_address, pkt, bytes);
             ctrl->functionalReadBuffers(pkt, bytes);
         }
+        for (auto ctrl : m_abs_cntrl_vec) {
+            auto held = std::find_if(holders.begin(), holders.end(),
+                [ctrl](const auto &holder) { return holder.first == ctrl; });
+            if (held == holders.end()) {
+                ctrl->functionalRead(line_address, pkt, bytes);
+                ctrl->functionalReadBuffers(pkt, bytes);
+            }
+        }
     }
     // we either got the full line or couldn't find anything at this point
     panic_if(!(bytes.isFull() || bytes.isEmpty()),
@@ -760,7 +810,6 @@ RubySystem::functionalWrite(PacketPtr pkt)
 {
     Addr addr(pkt->getAddr());
     Addr line_addr = makeLineAddress(addr, m_block_size_bits);
-    AccessPermission access_perm = AccessPermission_NotPresent;
 
     DPRINTF(RubySystem, "Functional Write request for %#x\n", addr);
 
@@ -771,16 +820,15 @@ RubySystem::functionalWrite(PacketPtr pkt)
     int request_net_id = requestorToNetwork[pkt->requestorId()];
     assert(netCntrls.count(request_net_id));
 
+    // Only the controllers holding the line have a copy to update
+    for (auto& holder : functionalHolders(line_addr, request_net_id)) {
+        num_functional_writes +=
+            holder.first->functionalWrite(line_addr, pkt);
+    }
+
     for (auto& cntrl : netCntrls[request_net_id]) {
         num_functional_writes += cntrl->functionalWriteBuffers(pkt);
 
-        access_perm = cntrl->getAccessPermission(line_addr);
-        if (access_perm != AccessPermission_Invalid &&
-            access_perm != AccessPermission_NotPresent) {
-            num_functional_writes +=
-                cntrl->functionalWrite(line_addr, pkt);
-        }
-
         // Also updates requests pending in any sequencer associated
         // with the controller
         if (cntrl->getCPUSequencer()) {
@@ -36,6 +36,8 @@
 #define __MEM_RUBY_SYSTEM_RUBYSYSTEM_HH__
 
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "base/callback.hh"
 #include "base/output.hh"
@@ -133,8 +135,8 @@ class RubySystem : public ClockedObject
     static void readCompressedTrace(std::string filename,
                                     uint8_t *&raw_data,
                                     uint64_t &uncompressed_trace_size);
-    static void writeCompressedTrace(uint8_t *raw_data, std::string file,
-                                     uint64_t uncompressed_trace_size);
+    static uint64_t writeCompressedTrace(CacheRecorder *recorder,
+                                         std::string file);
 
     void processRubyEvent();
 
@@ -143,6 +145,16 @@ class RubySystem : public ClockedObject
     bool simpleFunctionalRead(PacketPtr pkt);
     bool partialFunctionalRead(PacketPtr pkt);
 
+    typedef std::vector<std::pair<AbstractController *, AccessPermission>>
+        LineHolders;
+
+    // The controllers of a network (of all networks for net_id -1)
+    // that hold a line in any state but Invalid or NotPresent. A scan
+    // is reused until the next consumer wakeup, so back to back
+    // functional accesses to a line (e.g., a syscall copying a buffer
+    // through a PortProxy) do not query every controller again.
+    const LineHolders &functionalHolders(Addr line_addr, int net_id);
+
   private:
     // configuration parameters
     bool m_randomization;
@@ -166,6 +178,12 @@ class RubySystem : public ClockedObject
 
     std::unique_ptr<ProtocolInfo> protocolInfo;
 
+    // Cached functionalHolders() scans, per network and line
+    std::unordered_map<int, std::unordered_map<Addr, LineHolders>>
+        m_func_holders;
+    size_t m_num_func_holders = 0;
+    uint64_t m_func_holders_wakeups = 0;
+
   public:
     Profiler* m_profiler;
     CacheRecorder* m_cache_recorder;
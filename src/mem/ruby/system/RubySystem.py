@@ -60,5 +60,15 @@ class RubySystem(ClockedObject):
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
+    hot_lines_table_size = Param.Unsigned(
+        0,
+        "Maximum number of addresses in each address profiler table, "
+        "keeping the most accessed ones (0 for no limit)",
+    )
+    hot_lines_sampling = Param.Unsigned(
+        1,
+        "Profile the accesses to one in this many lines, selected by "
+        "address",
+    )
     num_of_sequencers = Param.Int("")
     number_of_virtual_networks = Param.Unsigned("")
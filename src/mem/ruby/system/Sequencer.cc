@@ -68,7 +68,10 @@ namespace ruby
 {
 
 Sequencer::Sequencer(const Params &p)
-    : RubyPort(p), m_IncompleteTimes(MachineType_NUM),
+    : RubyPort(p), m_RequestTable(p.max_outstanding_requests),
+      m_fast_read_hits(p.fast_read_hits),
+      m_fast_read_hit_latency(p.fast_read_hit_latency),
+      m_IncompleteTimes(MachineType_NUM),
       deadlockCheckEvent([this]{ wakeup(); }, "Sequencer deadlock check")
 {
     m_outstanding_count = 0;
@@ -236,21 +239,21 @@ Sequencer::wakeup()
     // Check across all outstanding requests
     [[maybe_unused]] int total_outstanding = 0;
 
-    for (const auto &table_entry : m_RequestTable) {
-        for (const auto &seq_req : table_entry.second) {
+    m_RequestTable.forEachLine([&](const SequencerRequestTable::Line &line) {
+        for (const auto &seq_req : line) {
             if (current_time - seq_req.issue_time < m_deadlock_threshold)
                 continue;
 
             panic("Possible Deadlock detected. Aborting!\n version: %d "
                   "request.paddr: 0x%x m_readRequestTable: %d current time: "
                   "%u issue_time: %d difference: %d\n", m_version,
-                  seq_req.pkt->getAddr(), table_entry.second.size(),
+                  seq_req.pkt->getAddr(), line.size(),
                   current_time * clockPeriod(), seq_req.issue_time
                   * clockPeriod(), (current_time * clockPeriod())
                   - (seq_req.issue_time * clockPeriod()));
         }
-        total_outstanding += table_entry.second.size();
-    }
+        total_outstanding += line.size();
+    });
 
     assert(m_outstanding_count == total_outstanding);
 
@@ -265,12 +268,12 @@ Sequencer::functionalWrite(Packet *func_pkt)
 {
     int num_written = RubyPort::functionalWrite(func_pkt);
 
-    for (const auto &table_entry : m_RequestTable) {
-        for (const auto& seq_req : table_entry.second) {
+    m_RequestTable.forEachLine([&](const SequencerRequestTable::Line &line) {
+        for (const auto& seq_req : line) {
             if (seq_req.functionalWrite(func_pkt))
                 ++num_written;
         }
-    }
+    });
     // Functional writes to addresses being monitored
     // will fail (remove) the monitor entry.
     llscClearMonitor(makeLineAddress(func_pkt->getAddr()));
@@ -366,10 +369,9 @@ Sequencer::insertRequest(PacketPtr pkt, RubyRequestType primary_type,
 
     Addr line_addr = makeLineAddress(pkt->getAddr());
     // Check if there is any outstanding request for the same cache line.
-    auto &seq_req_list = m_RequestTable[line_addr];
-    // Create a default entry
-    seq_req_list.emplace_back(pkt, primary_type,
-        secondary_type, curCycle());
+    // Requests to the same line are chained behind the first one
+    auto &seq_req_list = m_RequestTable.push(line_addr,
+        SequencerRequest(pkt, primary_type, secondary_type, curCycle()));
     m_outstanding_count++;
 
     if (seq_req_list.size() > 1) {
@@ -473,8 +475,8 @@ Sequencer::writeCallback(Addr address, DataBlock& data,
     // to this cache line when response for the write comes back
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
-    auto &seq_req_list = m_RequestTable[address];
+    assert(m_RequestTable.find(address));
+    auto &seq_req_list = *m_RequestTable.find(address);
 
     // Perform hitCallback on every cpu request made to this cache block while
     // ruby request was outstanding. Since only 1 ruby request was made,
@@ -555,13 +557,11 @@ Sequencer::writeCallback(Addr address, DataBlock& data,
                         initialRequestTime, forwardRequestTime,
                         firstResponseTime, !ruby_request);
         }
-        seq_req_list.pop_front();
+        m_RequestTable.popFront(seq_req_list);
     }
 
     // free all outstanding requests corresponding to this address
-    if (seq_req_list.empty()) {
-        m_RequestTable.erase(address);
-    }
+    m_RequestTable.releaseIfEmpty(seq_req_list);
 }
 
 bool
@@ -603,8 +603,8 @@ Sequencer::readCallback(Addr address, DataBlock& data,
     // or end of the corresponding list.
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
-    auto &seq_req_list = m_RequestTable[address];
+    assert(m_RequestTable.find(address));
+    auto &seq_req_list = *m_RequestTable.find(address);
 
     // Perform hitCallback on every cpu request made to this cache block while
     // ruby request was outstanding. Since only 1 ruby request was made,
@@ -627,13 +627,11 @@ Sequencer::readCallback(Addr address, DataBlock& data,
                     initialRequestTime, forwardRequestTime,
                     firstResponseTime, !ruby_request);
         ruby_request = false;
-        seq_req_list.pop_front();
+        m_RequestTable.popFront(seq_req_list);
     }
 
     // free all outstanding requests corresponding to this address
-    if (seq_req_list.empty()) {
-        m_RequestTable.erase(address);
-    }
+    m_RequestTable.releaseIfEmpty(seq_req_list);
 }
 
 void
@@ -650,8 +648,8 @@ Sequencer::atomicCallback(Addr address, DataBlock& data,
     // (the opperation could be performed remotly)
     //
     assert(address == makeLineAddress(address));
-    assert(m_RequestTable.find(address) != m_RequestTable.end());
-    auto &seq_req_list = m_RequestTable[address];
+    assert(m_RequestTable.find(address));
+    auto &seq_req_list = *m_RequestTable.find(address);
 
     // Perform hitCallback only on the first cpu request that
     // issued the ruby request
@@ -683,13 +681,11 @@ Sequencer::atomicCallback(Addr address, DataBlock& data,
         hitCallback(&seq_req, data, true, mach, externalHit,
                     initialRequestTime, forwardRequestTime,
                     firstResponseTime, false);
-        seq_req_list.pop_front();
+        m_RequestTable.popFront(seq_req_list);
     }
 
     // free all outstanding requests corresponding to this address
-    if (seq_req_list.empty()) {
-        m_RequestTable.erase(address);
-    }
+    m_RequestTable.releaseIfEmpty(seq_req_list);
 }
 
 void
@@ -1068,13 +1064,65 @@ Sequencer::makeRequest(PacketPtr pkt)
         return status;
     // non-aliased with any existing request in the request table, just issue
     // to the cache
-    if (status != RequestStatus_Aliased)
+    if (status != RequestStatus_Aliased &&
+        !tryFastReadHit(pkt, primary_type)) {
         issueRequest(pkt, secondary_type);
+    }
 
     // TODO: issue hardware prefetches here
     return RequestStatus_Issued;
 }
 
+bool
+Sequencer::tryFastReadHit(PacketPtr pkt, RubyRequestType primary_type)
+{
+    // Only plain loads: anything that may change the line's state,
+    // monitors or transactions must go through the protocol
+    if (!m_fast_read_hits || !m_dataCache_ptr ||
+        primary_type != RubyRequestType_LD || pkt->isHtmTransactional() ||
+        pkt->req->isPrefetch()) {
+        return false;
+    }
+
+    Addr line_addr = makeLineAddress(pkt->getAddr());
+    const AbstractCacheEntry *entry = m_dataCache_ptr->lookup(line_addr);
+    if (!entry ||
+        (entry->getPermission() != AccessPermission_Read_Only &&
+         entry->getPermission() != AccessPermission_Read_Write)) {
+        return false;
+    }
+
+    DPRINTF(RubySequencer, "Fast read hit for %#x\n", pkt->getAddr());
+    schedule(new EventFunctionWrapper(
+                 [this, line_addr]{ fastReadHit(line_addr); },
+                 name() + ".fastReadHit", true),
+             clockEdge(m_fast_read_hit_latency));
+    return true;
+}
+
+void
+Sequencer::fastReadHit(Addr line_addr)
+{
+    auto *seq_req_list = m_RequestTable.find(line_addr);
+    assert(seq_req_list && !seq_req_list->empty());
+
+    // The line may have been invalidated or downgraded to a transient
+    // state since the lookup; in that case take the normal path
+    AbstractCacheEntry *entry = m_dataCache_ptr->lookup(line_addr);
+    if (!entry ||
+        (entry->getPermission() != AccessPermission_Read_Only &&
+         entry->getPermission() != AccessPermission_Read_Write)) {
+        SequencerRequest &seq_req = seq_req_list->front();
+        issueRequest(seq_req.pkt, seq_req.m_second_type);
+        return;
+    }
+
+    m_dataCache_ptr->setMRU(entry);
+    // Requests to the line made in the meantime are coalesced with
+    // this one, as if it had come back from the controller
+    readCallback(line_addr, entry->getDataBlk());
+}
+
 void
 Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
 {
@@ -52,6 +52,7 @@
 #include "mem/ruby/protocol/SequencerRequestType.hh"
 #include "mem/ruby/structures/CacheMemory.hh"
 #include "mem/ruby/system/RubyPort.hh"
+#include "mem/ruby/system/SequencerRequestTable.hh"
 #include "params/RubySequencer.hh"
 
 namespace gem5
@@ -60,28 +61,6 @@ namespace gem5
 namespace ruby
 {
 
-struct SequencerRequest
-{
-    PacketPtr pkt;
-    RubyRequestType m_type;
-    RubyRequestType m_second_type;
-    Cycles issue_time;
-    SequencerRequest(PacketPtr _pkt, RubyRequestType _m_type,
-                     RubyRequestType _m_second_type, Cycles _issue_time)
-                : pkt(_pkt), m_type(_m_type), m_second_type(_m_second_type),
-                  issue_time(_issue_time)
-    {}
-
-    bool functionalWrite(Packet *func_pkt) const
-    {
-        // Follow-up on RubyRequest::functionalWrite
-        // This makes sure the hitCallback won't overrite the value we
-        // expect to find
-        assert(func_pkt->isWrite());
-        return func_pkt->trySatisfyFunctional(pkt);
-    }
-};
-
 class Sequencer : public RubyPort
 {
   public:
@@ -241,7 +220,7 @@ class Sequencer : public RubyPort
 
   protected:
     // RequestTable contains both read and write requests, handles aliasing
-    std::unordered_map<Addr, std::list<SequencerRequest>> m_RequestTable;
+    SequencerRequestTable m_RequestTable;
     // UnadressedRequestTable contains "unaddressed" requests,
     // guaranteed not to alias each other
     std::unordered_map<uint64_t, SequencerRequest> m_UnaddressedRequestTable;
@@ -252,6 +231,21 @@ class Sequencer : public RubyPort
                                         RubyRequestType primary_type,
                                         RubyRequestType secondary_type);
 
+    /**
+     * Try to complete a load that hit a readable line in the data cache
+     * without sending it through the L1 controller.
+     *
+     * @return true if the hit was scheduled. The request must then not
+     * be issued to the controller.
+     */
+    bool tryFastReadHit(PacketPtr pkt, RubyRequestType primary_type);
+
+    /**
+     * Complete the fast hit scheduled for a line, or issue the request
+     * normally if the line is no longer readable.
+     */
+    void fastReadHit(Addr line_addr);
+
     RubySystem *m_ruby_system;
 
   private:
@@ -280,6 +274,10 @@ class Sequencer : public RubyPort
 
     bool m_runningGarnetStandalone;
 
+    // Loads hitting a readable line in dcache bypass the controller
+    const bool m_fast_read_hits;
+    const Cycles m_fast_read_hit_latency;
+
     //! Histogram for number of outstanding requests per cycle.
     statistics::Histogram m_outstandReqHist;
 
@@ -112,6 +112,14 @@ class RubySequencer(RubyPort):
         "before deadlock/livelock declared",
     )
     garnet_standalone = Param.Bool(False, "")
+    fast_read_hits = Param.Bool(
+        False,
+        "Complete loads to lines that are readable in dcache directly from "
+        "the sequencer, without going through the L1 controller",
+    )
+    fast_read_hit_latency = Param.Cycles(
+        2, "Latency of a load completed by the sequencer fast hit path"
+    )
     # id used by protocols that support multiple sequencers per controller
     # 99 is the dummy default value
     coreid = Param.Int(99, "CorePair core id")
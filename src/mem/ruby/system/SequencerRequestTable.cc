@@ -0,0 +1,215 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/system/SequencerRequestTable.hh"
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+SequencerRequestTable::SequencerRequestTable(unsigned capacity)
+{
+    assert(capacity > 0);
+
+    // Every outstanding request can be to a different line. Keep the
+    // index at most half full so probe sequences stay short.
+    index.resize(size_t(1) << std::max(3, ceilLog2(2 * capacity)),
+                 nullptr);
+    indexShift = 64 - floorLog2(index.size());
+
+    SequencerRequest unused(nullptr, RubyRequestType_NULL,
+                            RubyRequestType_NULL, Cycles(0));
+    for (unsigned i = 0; i < capacity; i++) {
+        slots.emplace_back(unused);
+        slots.back().next = freeSlots;
+        freeSlots = &slots.back();
+
+        lines.emplace_back();
+        lines.back().nextFree = freeLines;
+        freeLines = &lines.back();
+    }
+}
+
+size_t
+SequencerRequestTable::bucketOf(Addr line_addr) const
+{
+    // Fibonacci hashing; the top bits do not depend on the block
+    // offset bits, which are always zero for line addresses
+    return (line_addr * 0x9E3779B97F4A7C15ULL) >> indexShift;
+}
+
+SequencerRequestTable::Line *
+SequencerRequestTable::find(Addr line_addr) const
+{
+    const size_t mask = index.size() - 1;
+    for (size_t i = bucketOf(line_addr); index[i]; i = (i + 1) & mask) {
+        if (index[i]->addr == line_addr)
+            return index[i];
+    }
+    return nullptr;
+}
+
+SequencerRequestTable::Slot *
+SequencerRequestTable::allocSlot(const SequencerRequest &req)
+{
+    if (!freeSlots) {
+        slots.emplace_back(req);
+        return &slots.back();
+    }
+    Slot *slot = freeSlots;
+    freeSlots = slot->next;
+    slot->req = req;
+    slot->next = nullptr;
+    return slot;
+}
+
+SequencerRequestTable::Line *
+SequencerRequestTable::allocLine(Addr line_addr)
+{
+    Line *line;
+    if (freeLines) {
+        line = freeLines;
+        freeLines = line->nextFree;
+    } else {
+        lines.emplace_back();
+        line = &lines.back();
+    }
+    line->addr = line_addr;
+    line->head = line->tail = nullptr;
+    line->count = 0;
+    line->nextFree = nullptr;
+    return line;
+}
+
+void
+SequencerRequestTable::indexInsert(Line *line)
+{
+    if (2 * (numLines + 1) > index.size()) {
+        std::vector<Line *> old_index(2 * index.size(), nullptr);
+        old_index.swap(index);
+        indexShift--;
+        numLines = 0;
+        for (Line *old_line : old_index) {
+            if (old_line)
+                indexInsert(old_line);
+        }
+    }
+
+    const size_t mask = index.size() - 1;
+    size_t i = bucketOf(line->addr);
+    while (index[i])
+        i = (i + 1) & mask;
+    index[i] = line;
+    numLines++;
+}
+
+void
+SequencerRequestTable::indexErase(Line *line)
+{
+    const size_t mask = index.size() - 1;
+    size_t i = bucketOf(line->addr);
+    while (index[i] != line) {
+        assert(index[i]);
+        i = (i + 1) & mask;
+    }
+    index[i] = nullptr;
+    numLines--;
+
+    // Shift back the lines that follow in the probe sequence so that
+    // lookups never have to skip over the hole
+    for (size_t j = (i + 1) & mask; index[j]; j = (j + 1) & mask) {
+        const size_t home = bucketOf(index[j]->addr);
+        const bool reachable = (i <= j) ? (i < home && home <= j) :
+                                          (i < home || home <= j);
+        if (!reachable) {
+            index[i] = index[j];
+            index[j] = nullptr;
+            i = j;
+        }
+    }
+}
+
+SequencerRequestTable::Line &
+SequencerRequestTable::push(Addr line_addr, const SequencerRequest &req)
+{
+    Line *line = find(line_addr);
+    if (!line) {
+        line = allocLine(line_addr);
+        indexInsert(line);
+    }
+
+    Slot *slot = allocSlot(req);
+    if (line->tail)
+        line->tail->next = slot;
+    else
+        line->head = slot;
+    line->tail = slot;
+    line->count++;
+    return *line;
+}
+
+void
+SequencerRequestTable::popFront(Line &line)
+{
+    Slot *slot = line.head;
+    assert(slot);
+    line.head = slot->next;
+    if (!line.head)
+        line.tail = nullptr;
+    line.count--;
+
+    slot->next = freeSlots;
+    freeSlots = slot;
+}
+
+void
+SequencerRequestTable::releaseIfEmpty(Line &line)
+{
+    if (!line.empty())
+        return;
+    indexErase(&line);
+    line.nextFree = freeLines;
+    freeLines = &line;
+}
+
+void
+SequencerRequestTable::print(std::ostream &out) const
+{
+    out << "[";
+    forEachLine([&out](const Line &line) {
+        out << " " << std::hex << line.address() << std::dec
+            << ": " << line.size() << " requests";
+    });
+    out << " ]";
+}
+
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,215 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_SYSTEM_SEQUENCERREQUESTTABLE_HH__
+#define __MEM_RUBY_SYSTEM_SEQUENCERREQUESTTABLE_HH__
+
+#include <cassert>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "mem/ruby/protocol/RubyRequestType.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+struct SequencerRequest
+{
+    PacketPtr pkt;
+    RubyRequestType m_type;
+    RubyRequestType m_second_type;
+    Cycles issue_time;
+    SequencerRequest(PacketPtr _pkt, RubyRequestType _m_type,
+                     RubyRequestType _m_second_type, Cycles _issue_time)
+                : pkt(_pkt), m_type(_m_type), m_second_type(_m_second_type),
+                  issue_time(_issue_time)
+    {}
+
+    bool functionalWrite(Packet *func_pkt) const
+    {
+        // Follow-up on RubyRequest::functionalWrite
+        // This makes sure the hitCallback won't overrite the value we
+        // expect to find
+        assert(func_pkt->isWrite());
+        return func_pkt->trySatisfyFunctional(pkt);
+    }
+};
+
+/**
+ * The outstanding requests of a Sequencer, grouped by cache line.
+ *
+ * Requests live in a pool of slots sized to the sequencer's
+ * max_outstanding_requests and are chained per line in arrival order,
+ * so making a request and retiring it through a callback never touch
+ * the heap. Lines are found through an open-addressed hash index. The
+ * pool only grows past its initial size when requests bypass the
+ * outstanding limit (e.g., HTM aborts).
+ *
+ * Slots and lines are never moved once allocated: callbacks hold
+ * references to both while calling back into the CPU, which may make
+ * new requests before returning.
+ */
+class SequencerRequestTable
+{
+  private:
+    struct Slot
+    {
+        Slot(const SequencerRequest &_req) : req(_req) {}
+
+        SequencerRequest req;
+        Slot *next = nullptr;
+    };
+
+  public:
+    /** The requests to one cache line, oldest first. */
+    class Line
+    {
+      public:
+        class const_iterator
+        {
+          public:
+            explicit const_iterator(const Slot *_slot) : slot(_slot) {}
+
+            const SequencerRequest &operator*() const { return slot->req; }
+            const SequencerRequest *operator->() const { return &slot->req; }
+
+            const_iterator &
+            operator++()
+            {
+                slot = slot->next;
+                return *this;
+            }
+
+            bool
+            operator!=(const const_iterator &other) const
+            {
+                return slot != other.slot;
+            }
+
+          private:
+            const Slot *slot;
+        };
+
+        Addr address() const { return addr; }
+        bool empty() const { return head == nullptr; }
+        unsigned size() const { return count; }
+
+        SequencerRequest &
+        front()
+        {
+            assert(head);
+            return head->req;
+        }
+
+        const_iterator begin() const { return const_iterator(head); }
+        const_iterator end() const { return const_iterator(nullptr); }
+
+      private:
+        friend class SequencerRequestTable;
+
+        Addr addr = 0;
+        Slot *head = nullptr;
+        Slot *tail = nullptr;
+        unsigned count = 0;
+        /** Next line on the free list */
+        Line *nextFree = nullptr;
+    };
+
+    /** @param capacity Number of requests the table holds up front. */
+    explicit SequencerRequestTable(unsigned capacity);
+
+    /** @return The requests to a line, or nullptr if there are none. */
+    Line *find(Addr line_addr) const;
+
+    /**
+     * Append a request to the chain of its line, creating the line if
+     * needed.
+     */
+    Line &push(Addr line_addr, const SequencerRequest &req);
+
+    /**
+     * Retire the oldest request of a line. The line stays in the table,
+     * even when left empty, until it is released.
+     */
+    void popFront(Line &line);
+
+    /** Drop a line from the table if it has no requests left. */
+    void releaseIfEmpty(Line &line);
+
+    bool empty() const { return numLines == 0; }
+
+    /** Call f on every line with outstanding requests. */
+    template <typename F>
+    void
+    forEachLine(F f) const
+    {
+        for (const Line *line : index) {
+            if (line)
+                f(*line);
+        }
+    }
+
+    void print(std::ostream &out) const;
+
+  private:
+    size_t bucketOf(Addr line_addr) const;
+
+    Slot *allocSlot(const SequencerRequest &req);
+    Line *allocLine(Addr line_addr);
+
+    /** Insert a line in the index, growing it if it gets too full */
+    void indexInsert(Line *line);
+    void indexErase(Line *line);
+
+    /** Backing storage; deques keep elements in place as they grow */
+    std::deque<Slot> slots;
+    std::deque<Line> lines;
+
+    Slot *freeSlots = nullptr;
+    Line *freeLines = nullptr;
+
+    /** Open-addressed index of the lines, a power of two in size */
+    std::vector<Line *> index;
+    unsigned indexShift;
+    unsigned numLines = 0;
+};
+
+inline std::ostream &
+operator<<(std::ostream &out, const SequencerRequestTable &table)
+{
+    table.print(out);
+    return out;
+}
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_SYSTEM_SEQUENCERREQUESTTABLE_HH__
@@ -40,6 +40,13 @@
 
 #include "mem/se_translating_port_proxy.hh"
 
+#include <cstring>
+
+#include "base/chunk_generator.hh"
+#include "cpu/base.hh"
+#include "cpu/thread_context.hh"
+#include "mem/page_table.hh"
+#include "mem/port.hh"
 #include "sim/process.hh"
 #include "sim/system.hh"
 
@@ -70,4 +77,165 @@ SETranslatingPortProxy::fixupRange(const TranslationGen::Range &range,
     return false;
 }
 
+bool
+SETranslatingPortProxy::tryOnPages(BaseMMU::Mode mode, Addr addr,
+        uint64_t size, const PageFunc &func) const
+{
+    EmulationPageTable *table = _tc->getProcessPtr()->pTable;
+    const Addr page_size = table->pageSize();
+
+    for (ChunkGenerator gen(addr, size, page_size); !gen.done(); gen.next()) {
+        const Addr vpage = table->pageAlign(gen.addr());
+        auto &cached = xlateCache[(vpage / page_size) % xlateCache.size()];
+        if (cached.table == table &&
+                cached.generation == table->generation() &&
+                cached.mode == mode && cached.vpage == vpage) {
+            func(cached.ppage + table->pageOffset(gen.addr()), cached.flags,
+                 gen.addr() - addr, gen.size());
+            continue;
+        }
+
+        // Translate through the MMU so that the ISA's rules for
+        // functional translations and the fixups still apply.
+        bool ok = tryOnBlob(mode, _tc->getMMUPtr()->translateFunctional(
+                gen.addr(), gen.size(), _tc, mode, flags),
+            [&](const auto &range) {
+                func(range.paddr, range.flags, range.vaddr - addr,
+                     range.size);
+                if (range.size == gen.size()) {
+                    cached.table = table;
+                    cached.generation = table->generation();
+                    cached.mode = mode;
+                    cached.vpage = vpage;
+                    cached.ppage =
+                        range.paddr - table->pageOffset(range.vaddr);
+                    cached.flags = range.flags;
+                }
+        });
+        if (!ok)
+            return false;
+    }
+    return true;
+}
+
+uint8_t *
+SETranslatingPortProxy::hostPtr(Addr paddr, Request::Flags req_flags,
+        uint64_t size, bool write, MemBackdoorPtr &bd, bool &denied) const
+{
+    // Packets may be queued on their way to memory in timing mode, and
+    // uncacheable accesses may target devices, so both use packets.
+    if (denied || !_tc->getSystemPtr()->isAtomicMode() ||
+            req_flags.isSet(Request::UNCACHEABLE)) {
+        return nullptr;
+    }
+
+    const AddrRange range(paddr, paddr + size);
+    auto covers = [&](MemBackdoorPtr backdoor) {
+        return backdoor && !backdoor->range().interleaved() &&
+            range.isSubset(backdoor->range()) &&
+            (write ? backdoor->writeable() : backdoor->readable());
+    };
+
+    if (!covers(bd)) {
+        auto *port = dynamic_cast<RequestPort *>(
+                &_tc->getCpuPtr()->getDataPort());
+        bd = nullptr;
+        if (port) {
+            port->sendMemBackdoorReq(MemBackdoorReq(range,
+                write ? MemBackdoor::Writeable : MemBackdoor::Readable), bd);
+        }
+        if (!covers(bd)) {
+            // Do not ask again for the rest of this blob.
+            denied = true;
+            bd = nullptr;
+            return nullptr;
+        }
+    }
+    return bd->ptr() + (paddr - bd->range().start());
+}
+
+bool
+SETranslatingPortProxy::hostRanges(Addr addr, uint64_t size, bool write,
+        std::vector<struct iovec> &iov) const
+{
+    MemBackdoorPtr bd = nullptr;
+    bool denied = false;
+    const size_t old_size = iov.size();
+    bool ok = tryOnPages(write ? BaseMMU::Write : BaseMMU::Read, addr, size,
+        [&](Addr paddr, Request::Flags req_flags, uint64_t offset,
+                uint64_t len) {
+            uint8_t *host = hostPtr(paddr, req_flags, len, write, bd,
+                                    denied);
+            if (!host)
+                return;
+            if (iov.size() > old_size && static_cast<uint8_t *>(
+                        iov.back().iov_base) + iov.back().iov_len == host) {
+                iov.back().iov_len += len;
+            } else {
+                iov.push_back({host, len});
+            }
+    });
+
+    if (!ok || denied) {
+        iov.resize(old_size);
+        return false;
+    }
+    return true;
+}
+
+bool
+SETranslatingPortProxy::tryReadBlob(Addr addr, void *p, uint64_t size) const
+{
+    MemBackdoorPtr bd = nullptr;
+    bool denied = false;
+    return tryOnPages(BaseMMU::Read, addr, size,
+        [&](Addr paddr, Request::Flags req_flags, uint64_t offset,
+                uint64_t len) {
+            uint8_t *dst = static_cast<uint8_t *>(p) + offset;
+            if (uint8_t *host = hostPtr(paddr, req_flags, len, false, bd,
+                        denied)) {
+                std::memcpy(dst, host, len);
+            } else {
+                PortProxy::readBlobPhys(paddr, req_flags, dst, len);
+            }
+    });
+}
+
+bool
+SETranslatingPortProxy::tryWriteBlob(
+        Addr addr, const void *p, uint64_t size) const
+{
+    MemBackdoorPtr bd = nullptr;
+    bool denied = false;
+    return tryOnPages(BaseMMU::Write, addr, size,
+        [&](Addr paddr, Request::Flags req_flags, uint64_t offset,
+                uint64_t len) {
+            const uint8_t *src = static_cast<const uint8_t *>(p) + offset;
+            if (uint8_t *host = hostPtr(paddr, req_flags, len, true, bd,
+                        denied)) {
+                std::memcpy(host, src, len);
+            } else {
+                PortProxy::writeBlobPhys(paddr, req_flags, src, len);
+            }
+    });
+}
+
+bool
+SETranslatingPortProxy::tryMemsetBlob(
+        Addr addr, uint8_t v, uint64_t size) const
+{
+    MemBackdoorPtr bd = nullptr;
+    bool denied = false;
+    return tryOnPages(BaseMMU::Write, addr, size,
+        [&](Addr paddr, Request::Flags req_flags, uint64_t offset,
+                uint64_t len) {
+            if (uint8_t *host = hostPtr(paddr, req_flags, len, true, bd,
+                        denied)) {
+                std::memset(host, v, len);
+            } else {
+                PortProxy::memsetBlobPhys(paddr, req_flags, v, len);
+            }
+    });
+}
+
 } // namespace gem5
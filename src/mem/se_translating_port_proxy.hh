@@ -41,11 +41,28 @@
 #ifndef __MEM_SE_TRANSLATING_PORT_PROXY_HH__
 #define __MEM_SE_TRANSLATING_PORT_PROXY_HH__
 
+#include <sys/uio.h>
+
+#include <array>
+#include <functional>
+#include <vector>
+
+#include "mem/backdoor.hh"
 #include "mem/translating_port_proxy.hh"
 
 namespace gem5
 {
 
+class EmulationPageTable;
+
+/**
+ * A translating proxy for SE mode. Translations come from the process'
+ * page table, which only changes through the simulator, so the proxy
+ * keeps the translations of the last few pages it touched until the
+ * table is modified. In atomic mode, whole pages are copied through a
+ * host pointer when the memory grants a back door on the CPU's data
+ * path, which it does not when a cache sits in between.
+ */
 class SETranslatingPortProxy : public TranslatingPortProxy
 {
 
@@ -60,6 +77,36 @@ class SETranslatingPortProxy : public TranslatingPortProxy
   private:
     AllocType allocating;
 
+    struct CachedTranslation
+    {
+        const EmulationPageTable *table = nullptr;
+        uint64_t generation = 0;
+        BaseMMU::Mode mode = BaseMMU::Read;
+        Addr vpage = MaxAddr;
+        Addr ppage = 0;
+        Request::Flags flags = 0;
+    };
+
+    static constexpr size_t NumCachedTranslations = 8;
+    mutable std::array<CachedTranslation, NumCachedTranslations> xlateCache;
+
+    using PageFunc = std::function<void(Addr paddr, Request::Flags flags,
+                                        uint64_t offset, uint64_t size)>;
+
+    /**
+     * Translate [addr, addr + size) page by page and call func with the
+     * physical address of each piece and its offset in the blob.
+     */
+    bool tryOnPages(BaseMMU::Mode mode, Addr addr, uint64_t size,
+                    const PageFunc &func) const;
+
+    /**
+     * Get a host pointer to size bytes at paddr, reusing or refreshing
+     * the back door in bd, or nullptr if the access has to use packets.
+     */
+    uint8_t *hostPtr(Addr paddr, Request::Flags flags, uint64_t size,
+                     bool write, MemBackdoorPtr &bd, bool &denied) const;
+
   protected:
     bool fixupRange(const TranslationGen::Range &range,
             BaseMMU::Mode mode) const override;
@@ -67,6 +114,22 @@ class SETranslatingPortProxy : public TranslatingPortProxy
   public:
     SETranslatingPortProxy(ThreadContext *tc, AllocType alloc=NextPage,
                            Request::Flags _flags=0);
+
+    /**
+     * Resolve [addr, addr + size) to host memory that, for instance, a
+     * host syscall can access in place. The pieces are appended to iov,
+     * merged where they are contiguous on the host.
+     *
+     * @param write Whether the memory will be written.
+     * @return Whether every byte of the range has a host pointer. iov is
+     *         left as it was if not.
+     */
+    bool hostRanges(Addr addr, uint64_t size, bool write,
+                    std::vector<struct iovec> &iov) const;
+
+    bool tryReadBlob(Addr addr, void *p, uint64_t size) const override;
+    bool tryWriteBlob(Addr addr, const void *p, uint64_t size) const override;
+    bool tryMemsetBlob(Addr addr, uint8_t v, uint64_t size) const override;
 };
 
 } // namespace gem5
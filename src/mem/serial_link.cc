@@ -65,7 +65,7 @@ SerialLinkResponsePort(const std::string& _name,
       mem_side_port(_mem_side_port), delay(_delay),
       ranges(_ranges.begin(), _ranges.end()),
       outstandingResponses(0), retryReq(false),
-      respQueueLimit(_resp_limit),
+      respQueueLimit(_resp_limit), linkFree(0),
       sendEvent([this]{ trySendTiming(); }, _name)
 {
 }
@@ -74,9 +74,11 @@ SerialLink::SerialLinkRequestPort::SerialLinkRequestPort(const std::string&
                                            _name, SerialLink& _serial_link,
                                            SerialLinkResponsePort&
                                            _cpu_side_port, Cycles _delay,
-                                           int _req_limit)
+                                           int _req_limit, int _credits)
     : RequestPort(_name), serial_link(_serial_link),
       cpu_side_port(_cpu_side_port), delay(_delay), reqQueueLimit(_req_limit),
+      linkFree(0), maxCredits(_credits), credits(_credits),
+      creditEvent([this]{ returnCredits(); }, _name),
       sendEvent([this]{ trySendTiming(); }, _name)
 {
 }
@@ -86,10 +88,17 @@ SerialLink::SerialLink(const SerialLinkParams &p)
       cpu_side_port(p.name + ".cpu_side_port", *this, mem_side_port,
                 ticksToCycles(p.delay), p.resp_size, p.ranges),
       mem_side_port(p.name + ".mem_side_port", *this, cpu_side_port,
-                 ticksToCycles(p.delay), p.req_size),
+                 ticksToCycles(p.delay), p.req_size, p.credits),
       num_lanes(p.num_lanes),
-      link_speed(p.link_speed)
+      link_speed(p.link_speed),
+      flitSize(p.flit_size),
+      flitOverhead(p.flit_overhead)
 {
+    fatal_if(p.credits && !packetized(),
+             "%s: Credits are only used on a packetized link.\n", name());
+    fatal_if(packetized() && !flitOverhead,
+             "%s: Packets need a FLIT of header on a packetized link.\n",
+             name());
 }
 
 Port&
@@ -115,6 +124,25 @@ SerialLink::init()
     cpu_side_port.sendRangeChange();
 }
 
+unsigned int
+SerialLink::packetFlits(PacketPtr pkt) const
+{
+    unsigned int data_flits = pkt->hasData() ?
+        divCeil(pkt->getSize(), flitSize) : 0;
+    return flitOverhead + data_flits;
+}
+
+Tick
+SerialLink::serialize(unsigned int flits, Tick &link_free, Cycles delay) const
+{
+    // the FLITs follow the ones already on the link, and the packet is
+    // only delivered once its last FLIT has been deserialized
+    Tick start = std::max(clockEdge(), link_free);
+    link_free = start + cyclesToTicks(Cycles(divCeil(flits * flitSize * 8,
+                                                     num_lanes * link_speed)));
+    return link_free + cyclesToTicks(delay);
+}
+
 bool
 SerialLink::SerialLinkResponsePort::respQueueFull() const
 {
@@ -127,6 +155,53 @@ SerialLink::SerialLinkRequestPort::reqQueueFull() const
     return transmitList.size() == reqQueueLimit;
 }
 
+bool
+SerialLink::SerialLinkRequestPort::hasCredits(unsigned int flits) const
+{
+    fatal_if(flits > maxCredits && maxCredits,
+             "%s: A %d FLIT packet does not fit in %d credits.\n", name(),
+             flits, maxCredits);
+    return !maxCredits || flits <= credits;
+}
+
+Tick
+SerialLink::SerialLinkRequestPort::transmit(unsigned int flits)
+{
+    if (maxCredits) {
+        assert(flits <= credits);
+        credits -= flits;
+    }
+
+    return serial_link.serialize(flits, linkFree, delay);
+}
+
+Tick
+SerialLink::SerialLinkResponsePort::transmit(unsigned int flits)
+{
+    // the space for the response is already reserved at this end, so
+    // there are no credits to wait for
+    return serial_link.serialize(flits, linkFree, delay);
+}
+
+void
+SerialLink::SerialLinkRequestPort::returnCredits()
+{
+    while (!creditReturns.empty() &&
+           creditReturns.front().first <= curTick()) {
+        credits += creditReturns.front().second;
+        creditReturns.pop_front();
+    }
+
+    assert(credits <= maxCredits);
+    DPRINTF(SerialLink, "Credits returned, %d available\n", credits);
+
+    if (!creditReturns.empty())
+        serial_link.schedule(creditEvent, creditReturns.front().first);
+
+    // a request may have been stalled waiting for the credits
+    cpu_side_port.retryStalledReq();
+}
+
 bool
 SerialLink::SerialLinkRequestPort::recvTimingResp(PacketPtr pkt)
 {
@@ -145,10 +220,15 @@ SerialLink::SerialLinkRequestPort::recvTimingResp(PacketPtr pkt)
     // first flit, but the deserializer (at the host side in this case), will
     // have to wait to receive the whole packet. So we only account for the
     // deserialization latency.
-    Cycles cycles = delay;
-    cycles += Cycles(divCeil(pkt->getSize() * 8, serial_link.num_lanes
-                * serial_link.link_speed));
-     Tick t = serial_link.clockEdge(cycles);
+    Tick t;
+    if (serial_link.packetized()) {
+        t = cpu_side_port.transmit(serial_link.packetFlits(pkt));
+    } else {
+        Cycles cycles = delay;
+        cycles += Cycles(divCeil(pkt->getSize() * 8, serial_link.num_lanes
+                    * serial_link.link_speed));
+        t = serial_link.clockEdge(cycles);
+    }
 
     //@todo: If the processor sends two uncached requests towards HMC and the
     // second one is smaller than the first one. It may happen that the second
@@ -176,6 +256,10 @@ SerialLink::SerialLinkResponsePort::recvTimingReq(PacketPtr pkt)
     if (mem_side_port.reqQueueFull()) {
         DPRINTF(SerialLink, "Request queue full\n");
         retryReq = true;
+    } else if (serial_link.packetized() &&
+               !mem_side_port.hasCredits(serial_link.packetFlits(pkt))) {
+        DPRINTF(SerialLink, "Out of credits\n");
+        retryReq = true;
     } else if ( !retryReq ) {
         // look at the response queue if we expect to see a response
         bool expects_response = pkt->needsResponse() &&
@@ -206,10 +290,15 @@ SerialLink::SerialLinkResponsePort::recvTimingReq(PacketPtr pkt)
             // to check its integrity first. So everytime a packet crosses a
             // serial link, we should account for its deserialization latency
             // only.
-            Cycles cycles = delay;
-            cycles += Cycles(divCeil(pkt->getSize() * 8,
-                    serial_link.num_lanes * serial_link.link_speed));
-            Tick t = serial_link.clockEdge(cycles);
+            Tick t;
+            if (serial_link.packetized()) {
+                t = mem_side_port.transmit(serial_link.packetFlits(pkt));
+            } else {
+                Cycles cycles = delay;
+                cycles += Cycles(divCeil(pkt->getSize() * 8,
+                        serial_link.num_lanes * serial_link.link_speed));
+                t = serial_link.clockEdge(cycles);
+            }
 
             //@todo: If the processor sends two uncached requests towards HMC
             // and the second one is smaller than the first one. It may happen
@@ -273,6 +362,11 @@ SerialLink::SerialLinkRequestPort::trySendTiming()
 {
     assert(!transmitList.empty());
 
+    if (serial_link.packetized()) {
+        trySendBatch();
+        return;
+    }
+
     DeferredPacket req = transmitList.front();
 
     assert(req.tick <= curTick());
@@ -316,6 +410,11 @@ SerialLink::SerialLinkResponsePort::trySendTiming()
 {
     assert(!transmitList.empty());
 
+    if (serial_link.packetized()) {
+        trySendBatch();
+        return;
+    }
+
     DeferredPacket resp = transmitList.front();
 
     assert(resp.tick <= curTick());
@@ -359,6 +458,73 @@ SerialLink::SerialLinkResponsePort::trySendTiming()
     // and therefore there is no need to take any action
 }
 
+void
+SerialLink::SerialLinkRequestPort::trySendBatch()
+{
+    // the arrival times already account for the serialization, so
+    // deliver all the requests that have arrived in one go
+    bool blocked = false;
+    while (!transmitList.empty() && transmitList.front().tick <= curTick()) {
+        PacketPtr pkt = transmitList.front().pkt;
+        unsigned int flits = serial_link.packetFlits(pkt);
+
+        DPRINTF(SerialLink, "trySend request addr 0x%x, queue size %d\n",
+                pkt->getAddr(), transmitList.size());
+
+        if (!sendTimingReq(pkt)) {
+            // try again once we receive a retry
+            blocked = true;
+            break;
+        }
+
+        transmitList.pop_front();
+
+        // the freed buffer space is credited back over the link
+        if (maxCredits) {
+            creditReturns.emplace_back(serial_link.clockEdge(delay), flits);
+            if (!creditEvent.scheduled())
+                serial_link.schedule(creditEvent,
+                                     creditReturns.front().first);
+        }
+    }
+
+    if (!blocked && !transmitList.empty())
+        serial_link.schedule(sendEvent, transmitList.front().tick);
+
+    cpu_side_port.retryStalledReq();
+}
+
+void
+SerialLink::SerialLinkResponsePort::trySendBatch()
+{
+    bool blocked = false;
+    while (!transmitList.empty() && transmitList.front().tick <= curTick()) {
+        PacketPtr pkt = transmitList.front().pkt;
+
+        DPRINTF(SerialLink, "trySend response addr 0x%x, outstanding %d\n",
+                pkt->getAddr(), outstandingResponses);
+
+        if (!sendTimingResp(pkt)) {
+            blocked = true;
+            break;
+        }
+
+        transmitList.pop_front();
+
+        assert(outstandingResponses != 0);
+        --outstandingResponses;
+    }
+
+    if (!blocked && !transmitList.empty())
+        serial_link.schedule(sendEvent, transmitList.front().tick);
+
+    if (!mem_side_port.reqQueueFull() && retryReq) {
+        DPRINTF(SerialLink, "Request waiting for retry, now retrying\n");
+        retryReq = false;
+        sendRetryReq();
+    }
+}
+
 void
 SerialLink::SerialLinkRequestPort::recvReqRetry()
 {
@@ -49,6 +49,7 @@
 #define __MEM_SERIAL_LINK_HH__
 
 #include <deque>
+#include <utility>
 
 #include "base/types.hh"
 #include "mem/port.hh"
@@ -64,6 +65,12 @@ namespace gem5
  * serializer component at the transmitter side does not need to receive the
  * whole packet to start the serialization. But the deserializer waits for the
  * complete packet to check its integrity first.
+ *
+ * With a non-zero FLIT size the link is packetized instead: packets are
+ * framed into FLITs and serialized back to back on each direction of the
+ * link, requests are sent against credits for the FLIT buffer at the
+ * receiving end, and all packets that arrive in the same link cycle are
+ * delivered by a single event.
   */
 class SerialLink : public ClockedObject
 {
@@ -130,6 +137,9 @@ class SerialLink : public ClockedObject
         /** Max queue size for reserved responses. */
         unsigned int respQueueLimit;
 
+        /** Tick when the response direction of the link is free */
+        Tick linkFree;
+
         /**
          * Is this side blocked from accepting new response packets.
          *
@@ -144,6 +154,12 @@ class SerialLink : public ClockedObject
          */
         void trySendTiming();
 
+        /**
+         * Send all the responses that have arrived, when the link is
+         * packetized.
+         */
+        void trySendBatch();
+
         /** Send event for the response queue. */
         EventFunctionWrapper sendEvent;
 
@@ -181,6 +197,14 @@ class SerialLink : public ClockedObject
          */
         void retryStalledReq();
 
+        /**
+         * Serialize a response onto the link.
+         *
+         * @param flits the size of the response in FLITs
+         * @return tick when the response has arrived at the other end
+         */
+        Tick transmit(unsigned int flits);
+
       protected:
 
         /** When receiving a timing request from the peer port,
@@ -238,6 +262,30 @@ class SerialLink : public ClockedObject
         /** Max queue size for request packets */
         const unsigned int reqQueueLimit;
 
+        /** Tick when the request direction of the link is free */
+        Tick linkFree;
+
+        /**
+         * Credits for the FLIT buffer at the receiving end, zero if the
+         * buffer is not limited.
+         */
+        const unsigned int maxCredits;
+
+        /** Credits that are available to send requests */
+        unsigned int credits;
+
+        /**
+         * Credits freed at the receiving end that are on their way back
+         * over the link, with the tick they arrive.
+         */
+        std::deque<std::pair<Tick, unsigned int>> creditReturns;
+
+        /** Make the credits that are back available again */
+        void returnCredits();
+
+        /** Event for the next credit return. */
+        EventFunctionWrapper creditEvent;
+
         /**
          * Handle send event, scheduled when the packet at the head of
          * the outbound queue is ready to transmit (for timing
@@ -245,6 +293,12 @@ class SerialLink : public ClockedObject
          */
         void trySendTiming();
 
+        /**
+         * Send all the requests that have arrived, when the link is
+         * packetized.
+         */
+        void trySendBatch();
+
         /** Send event for the request queue. */
         EventFunctionWrapper sendEvent;
 
@@ -259,10 +313,11 @@ class SerialLink : public ClockedObject
          * side of the serial_link
          * @param _delay the delay in cycles from receiving to sending
          * @param _req_limit the size of the request queue
+         * @param _credits the credits for the FLIT buffer
          */
         SerialLinkRequestPort(const std::string& _name, SerialLink&
                          _serial_link, SerialLinkResponsePort& _cpu_side_port,
-                         Cycles _delay, int _req_limit);
+                         Cycles _delay, int _req_limit, int _credits);
 
         /**
          * Is this side blocked from accepting new request packets.
@@ -271,6 +326,22 @@ class SerialLink : public ClockedObject
          */
         bool reqQueueFull() const;
 
+        /**
+         * Are there enough credits to send a request.
+         *
+         * @param flits the size of the request in FLITs
+         * @return true if the FLITs fit in the receive buffer
+         */
+        bool hasCredits(unsigned int flits) const;
+
+        /**
+         * Serialize a request onto the link, consuming its credits.
+         *
+         * @param flits the size of the request in FLITs
+         * @return tick when the request has arrived at the other end
+         */
+        Tick transmit(unsigned int flits);
+
         /**
          * Queue a request packet to be sent out later and also schedule
          * a send if necessary.
@@ -313,6 +384,34 @@ class SerialLink : public ClockedObject
     /** Speed of each link (Gb/s) in this serial link */
     uint64_t link_speed;
 
+    /** Size of a FLIT in bytes, zero if the link is not packetized */
+    const unsigned int flitSize;
+
+    /** FLITs of header and tail in each packet */
+    const unsigned int flitOverhead;
+
+    /** Is the link packetized into FLITs */
+    bool packetized() const { return flitSize != 0; }
+
+    /**
+     * Get the size of a packet on the link.
+     *
+     * @param pkt the packet to send
+     * @return the number of FLITs including header and tail
+     */
+    unsigned int packetFlits(PacketPtr pkt) const;
+
+    /**
+     * Serialize FLITs onto one direction of the link after any FLITs
+     * already on it.
+     *
+     * @param flits the number of FLITs to send
+     * @param link_free tick when the link is free, which is updated
+     * @param delay the latency of the link
+     * @return tick when the last FLIT has arrived at the other end
+     */
+    Tick serialize(unsigned int flits, Tick &link_free, Cycles delay) const;
+
   public:
 
     Port &getPort(const std::string &if_name,
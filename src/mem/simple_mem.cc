@@ -53,7 +53,9 @@ namespace memory
 SimpleMemory::SimpleMemory(const SimpleMemoryParams &p) :
     AbstractMemory(p),
     port(name() + ".port", *this), latency(p.latency),
-    latency_var(p.latency_var), bandwidth(p.bandwidth), isBusy(false),
+    latency_var(p.latency_var), bandwidth(p.bandwidth),
+    tokenBucket(p.token_bucket), burstTicks(p.burst_size * p.bandwidth),
+    busyUntil(0), isBusy(false),
     retryReq(false), retryResp(false),
     releaseEvent([this]{ release(); }, name()),
     dequeueEvent([this]{ dequeue(); }, name())
@@ -79,7 +81,11 @@ SimpleMemory::recvAtomic(PacketPtr pkt)
              "is responding");
 
     access(pkt);
-    return getLatency();
+
+    // in the token bucket, atomic accesses queue for the data path
+    // just like timing ones do
+    Tick queue_delay = tokenBucket ? reserveBandwidth(pkt) - curTick() : 0;
+    return queue_delay + getLatency();
 }
 
 Tick
@@ -144,34 +150,49 @@ SimpleMemory::recvTimingReq(PacketPtr pkt)
     Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
     pkt->headerDelay = pkt->payloadDelay = 0;
 
-    // update the release time according to the bandwidth limit, and
-    // do so with respect to the time it takes to finish this request
-    // rather than long term as it is the short term data rate that is
-    // limited for any real memory
-
-    // calculate an appropriate tick to release to not exceed
-    // the bandwidth limit
-    Tick duration = pkt->getSize() * bandwidth;
-
-    // only consider ourselves busy if there is any need to wait
-    // to avoid extra events being scheduled for (infinitely) fast
-    // memories
-    if (duration != 0) {
-        schedule(releaseEvent, curTick() + duration);
-        isBusy = true;
+    // tick at which the data path starts on the request, and the
+    // response latency starts counting
+    Tick start = curTick();
+
+    if (tokenBucket) {
+        start = reserveBandwidth(pkt);
+
+        // stop accepting requests once the bucket has run dry, and
+        // take them again once there is room for another burst
+        if (busyUntil > curTick() + burstTicks) {
+            schedule(releaseEvent, busyUntil - burstTicks);
+            isBusy = true;
+        }
+    } else {
+        // update the release time according to the bandwidth limit,
+        // and do so with respect to the time it takes to finish this
+        // request rather than long term as it is the short term data
+        // rate that is limited for any real memory
+
+        // calculate an appropriate tick to release to not exceed
+        // the bandwidth limit
+        Tick duration = pkt->getSize() * bandwidth;
+
+        // only consider ourselves busy if there is any need to wait
+        // to avoid extra events being scheduled for (infinitely) fast
+        // memories
+        if (duration != 0) {
+            schedule(releaseEvent, curTick() + duration);
+            isBusy = true;
+        }
     }
 
     // go ahead and deal with the packet and put the response in the
     // queue if there is one
     bool needsResponse = pkt->needsResponse();
-    recvAtomic(pkt);
+    access(pkt);
     // turn packet around to go back to requestor if response expected
     if (needsResponse) {
-        // recvAtomic() should already have turned packet into
+        // access() should already have turned packet into
         // atomic response
         assert(pkt->isResponse());
 
-        Tick when_to_send = curTick() + receive_delay + getLatency();
+        Tick when_to_send = start + receive_delay + getLatency();
 
         // typically this should be added at the end, so start the
         // insertion sort with the last element, also make sure not to
@@ -212,24 +233,27 @@ void
 SimpleMemory::dequeue()
 {
     assert(!packetQueue.empty());
-    DeferredPacket deferred_pkt = packetQueue.front();
 
-    retryResp = !port.sendTimingResp(deferred_pkt.pkt);
-
-    if (!retryResp) {
+    // with the token bucket, send all the responses that are due in
+    // one go rather than with an event each
+    do {
+        retryResp = !port.sendTimingResp(packetQueue.front().pkt);
+        if (retryResp)
+            return;
         packetQueue.pop_front();
+    } while (tokenBucket && !packetQueue.empty() &&
+             packetQueue.front().tick <= curTick());
 
-        // if the queue is not empty, schedule the next dequeue event,
-        // otherwise signal that we are drained if we were asked to do so
-        if (!packetQueue.empty()) {
-            // if there were packets that got in-between then we
-            // already have an event scheduled, so use re-schedule
-            reschedule(dequeueEvent,
-                       std::max(packetQueue.front().tick, curTick()), true);
-        } else if (drainState() == DrainState::Draining) {
-            DPRINTF(Drain, "Draining of SimpleMemory complete\n");
-            signalDrainDone();
-        }
+    // if the queue is not empty, schedule the next dequeue event,
+    // otherwise signal that we are drained if we were asked to do so
+    if (!packetQueue.empty()) {
+        // if there were packets that got in-between then we
+        // already have an event scheduled, so use re-schedule
+        reschedule(dequeueEvent,
+                   std::max(packetQueue.front().tick, curTick()), true);
+    } else if (drainState() == DrainState::Draining) {
+        DPRINTF(Drain, "Draining of SimpleMemory complete\n");
+        signalDrainDone();
     }
 }
 
@@ -240,6 +264,14 @@ SimpleMemory::getLatency() const
         (latency_var ? rng->random<Tick>(0, latency_var) : 0);
 }
 
+Tick
+SimpleMemory::reserveBandwidth(PacketPtr pkt)
+{
+    Tick start = std::max(curTick(), busyUntil);
+    busyUntil = start + pkt->getSize() * bandwidth;
+    return start;
+}
+
 void
 SimpleMemory::recvRespRetry()
 {
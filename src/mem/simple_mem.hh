@@ -133,6 +133,24 @@ class SimpleMemory : public AbstractMemory
      */
     const double bandwidth;
 
+    /**
+     * Use a token bucket rather than the busy/release handshake to
+     * model the bandwidth. Each request reserves the data path from
+     * the tick it becomes free, and its response is due a latency
+     * after that, so the bandwidth costs no events unless the bucket
+     * runs out of tokens.
+     */
+    const bool tokenBucket;
+
+    /**
+     * Depth of the token bucket, in ticks of data path time that may
+     * be reserved ahead of the current tick.
+     */
+    const Tick burstTicks;
+
+    /** Tick at which the data path is done with all accepted requests */
+    Tick busyUntil;
+
     /**
      * Track the state of the memory as either idle or busy, no need
      * for an enum with only two states.
@@ -176,6 +194,13 @@ class SimpleMemory : public AbstractMemory
      */
     Tick getLatency() const;
 
+    /**
+     * Reserve the data path for a packet in the token bucket.
+     *
+     * @return the tick at which the transfer of the packet starts
+     */
+    Tick reserveBandwidth(PacketPtr pkt);
+
     /**
      * Upstream caches need this packet until true is returned, so
      * hold it for deletion until a subsequent call
@@ -42,6 +42,9 @@
 
 #include "mem/snoop_filter.hh"
 
+#include <algorithm>
+
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/SnoopFilter.hh"
@@ -52,12 +55,103 @@ namespace gem5
 
 const int SnoopFilter::SNOOP_MASK_SIZE;
 
+SnoopFilter::SnoopFilterCache::SnoopFilterCache()
+{
+    resize(KeysPerBucket * 8);
+}
+
+size_t
+SnoopFilter::SnoopFilterCache::find(Addr line_addr) const
+{
+    const size_t mask = slots() - 1;
+    for (size_t slot = home(line_addr); ; slot = (slot + 1) & mask) {
+        const Addr key = keyRef(slot);
+        if (key == line_addr)
+            return slot;
+        if (key == Empty)
+            return npos;
+    }
+}
+
+size_t
+SnoopFilter::SnoopFilterCache::insert(Addr line_addr)
+{
+    assert(line_addr != Empty);
+    assert(find(line_addr) == npos);
+
+    // Keep the table at most half full, so that probe sequences and
+    // thus lookups stay short
+    if (2 * (numEntries + 1) > slots())
+        resize(2 * slots());
+
+    const size_t mask = slots() - 1;
+    size_t slot = home(line_addr);
+    while (keyRef(slot) != Empty)
+        slot = (slot + 1) & mask;
+
+    keyRef(slot) = line_addr;
+    items[slot] = SnoopItem();
+    numEntries++;
+    return slot;
+}
+
+void
+SnoopFilter::SnoopFilterCache::erase(size_t slot)
+{
+    assert(occupied(slot));
+    const size_t mask = slots() - 1;
+
+    // Shift back the following entries of the probe sequence that could
+    // live in the freed slot, so that no tombstones are needed
+    size_t hole = slot;
+    for (size_t next = (slot + 1) & mask; keyRef(next) != Empty;
+         next = (next + 1) & mask) {
+        // The entry can move to the hole only if the hole lies between
+        // its home slot and its current slot, cyclically
+        if (((next - home(keyRef(next))) & mask) >= ((next - hole) & mask)) {
+            keyRef(hole) = keyRef(next);
+            items[hole] = items[next];
+            hole = next;
+        }
+    }
+    keyRef(hole) = Empty;
+    numEntries--;
+}
+
+void
+SnoopFilter::SnoopFilterCache::clear()
+{
+    for (auto &bucket : buckets)
+        std::fill(std::begin(bucket.keys), std::end(bucket.keys), Empty);
+    numEntries = 0;
+}
+
+void
+SnoopFilter::SnoopFilterCache::resize(size_t num_slots)
+{
+    assert(isPowerOf2(num_slots) && num_slots % KeysPerBucket == 0);
+
+    std::vector<Bucket> old_buckets(num_slots / KeysPerBucket);
+    std::vector<SnoopItem> old_items(num_slots);
+    buckets.swap(old_buckets);
+    items.swap(old_items);
+    hashShift = 64 - floorLog2(num_slots);
+    clear();
+
+    for (size_t slot = 0; slot < old_items.size(); ++slot) {
+        const Addr key =
+            old_buckets[slot / KeysPerBucket].keys[slot % KeysPerBucket];
+        if (key != Empty)
+            item(insert(key)) = old_items[slot];
+    }
+}
+
 void
-SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
+SnoopFilter::eraseIfNullEntry(size_t sf_slot)
 {
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = cachedLocations.item(sf_slot);
     if ((sf_item.requested | sf_item.holder).none()) {
-        cachedLocations.erase(sf_it);
+        cachedLocations.erase(sf_slot);
         DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
                 __func__);
     }
@@ -78,8 +172,8 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         line_addr |= LineSecure;
     }
     SnoopMask req_port = portToMask(cpu_side_port);
-    reqLookupResult.it = cachedLocations.find(line_addr);
-    bool is_hit = (reqLookupResult.it != cachedLocations.end());
+    reqLookupResult.slot = cachedLocations.find(line_addr);
+    bool is_hit = (reqLookupResult.slot != SnoopFilterCache::npos);
 
     // If the snoop filter has no entry, and we should not allocate,
     // do not create a new snoop filter entry, simply return a NULL
@@ -87,12 +181,11 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
     if (!is_hit && !allocate)
         return snoopDown(lookupLatency);
 
-    // If no hit in snoop filter create a new element and update iterator
+    // If no hit in snoop filter create a new element and update slot
     if (!is_hit) {
-        reqLookupResult.it =
-            cachedLocations.emplace(line_addr, SnoopItem()).first;
+        reqLookupResult.slot = cachedLocations.insert(line_addr);
     }
-    SnoopItem& sf_item = reqLookupResult.it->second;
+    SnoopItem& sf_item = cachedLocations.item(reqLookupResult.slot);
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -159,24 +252,31 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
-    if (reqLookupResult.it != cachedLocations.end()) {
-        // since we rely on the caller, do a basic check to ensure
-        // that finishRequest is being called following lookupRequest
-        assert(reqLookupResult.it->first == \
-                (is_secure ? ((addr & ~(Addr(linesize - 1))) | LineSecure) : \
-                 (addr & ~(Addr(linesize - 1)))));
+    if (reqLookupResult.slot != SnoopFilterCache::npos) {
+        // Lines move between slots when others are inserted or erased,
+        // which snoops coming back up while an atomic request is sent
+        // down may do, so look the line up again.
+        Addr line_addr = addr & ~(Addr(linesize - 1));
+        if (is_secure) {
+            line_addr |= LineSecure;
+        }
+        size_t sf_slot = cachedLocations.find(line_addr);
+
         if (will_retry) {
             SnoopItem retry_item = reqLookupResult.retryItem;
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult.it->second = retry_item;
+            if (sf_slot == SnoopFilterCache::npos)
+                sf_slot = cachedLocations.insert(line_addr);
+            cachedLocations.item(sf_slot) = retry_item;
 
             DPRINTF(SnoopFilter, "%s:   restored SF value %x.%x\n",
                     __func__,  retry_item.requested, retry_item.holder);
         }
 
-        eraseIfNullEntry(reqLookupResult.it);
+        if (sf_slot != SnoopFilterCache::npos)
+            eraseIfNullEntry(sf_slot);
     }
 }
 
@@ -191,10 +291,11 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = (sf_it != cachedLocations.end());
+    size_t sf_slot = cachedLocations.find(line_addr);
+    bool is_hit = (sf_slot != SnoopFilterCache::npos);
 
-    panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
+    panic_if(!is_hit && !backInvalidate &&
+             (cachedLocations.size() >= maxEntryCount),
              "snoop filter exceeded capacity of %d cache blocks\n",
              maxEntryCount);
 
@@ -204,7 +305,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (!is_hit)
         return snoopDown(lookupLatency);
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = cachedLocations.item(sf_slot);
 
     SnoopMask interested = (sf_item.holder | sf_item.requested);
 
@@ -234,7 +335,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         sf_item.holder = 0;
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(sf_slot);
     }
 
     return snoopSelected(maskToPortList(interested), lookupLatency);
@@ -264,7 +365,10 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     }
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    size_t sf_slot = cachedLocations.find(line_addr);
+    if (sf_slot == SnoopFilterCache::npos)
+        sf_slot = cachedLocations.insert(line_addr);
+    SnoopItem& sf_item = cachedLocations.item(sf_slot);
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -311,8 +415,8 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = sf_it != cachedLocations.end();
+    size_t sf_slot = cachedLocations.find(line_addr);
+    bool is_hit = sf_slot != SnoopFilterCache::npos;
 
     // Nothing to do if it is not a hit
     if (!is_hit)
@@ -322,7 +426,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     // Modified state, and we know that there are no other copies, or
     // they will all be invalidated imminently
     if (!cpkt->hasSharers()) {
-        SnoopItem& sf_item = sf_it->second;
+        SnoopItem& sf_item = cachedLocations.item(sf_slot);
 
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
@@ -330,7 +434,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
 
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(sf_slot);
     }
 }
 
@@ -353,12 +457,12 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    if (sf_it == cachedLocations.end())
+    size_t sf_slot = cachedLocations.find(line_addr);
+    if (sf_slot == SnoopFilterCache::npos)
         return;
 
     SnoopMask response_mask = portToMask(cpu_side_port);
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = cachedLocations.item(sf_slot);
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -377,7 +481,7 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
         if (cpkt->isInvalidate()) {
             sf_item.holder &= ~response_mask;
         }
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(sf_slot);
     } else {
         // Any other response implies that a cache above will have the
         // block.
@@ -388,6 +492,57 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
             __func__, sf_item.requested, sf_item.holder);
 }
 
+SnoopFilter::SnoopList
+SnoopFilter::selectVictim(Addr &addr, bool &is_secure)
+{
+    if (!backInvalidate || cachedLocations.size() <= maxEntryCount)
+        return SnoopList();
+
+    // Sweep the table from where the last search stopped, so that all
+    // lines get their turn as a victim
+    for (size_t i = 0; i < cachedLocations.slots(); ++i) {
+        size_t slot = (victimPos + i) % cachedLocations.slots();
+        if (!cachedLocations.occupied(slot))
+            continue;
+        const SnoopItem &sf_item = cachedLocations.item(slot);
+        if (sf_item.requested.any() || sf_item.holder.none())
+            continue;
+
+        victimPos = slot + 1;
+        Addr line_addr = cachedLocations.key(slot);
+        addr = line_addr & ~Addr(linesize - 1);
+        is_secure = line_addr & LineSecure;
+        stats.backInvalidations++;
+        DPRINTF(SnoopFilter, "%s: back-invalidating %#llx (%s) SF value "
+                "%x.%x\n", __func__, addr, is_secure ? "s" : "ns",
+                sf_item.requested, sf_item.holder);
+        return maskToPortList(sf_item.holder);
+    }
+    return SnoopList();
+}
+
+void
+SnoopFilter::finishBackInvalidate(Addr addr, bool is_secure)
+{
+    Addr line_addr = addr | (is_secure ? LineSecure : 0);
+    size_t sf_slot = cachedLocations.find(line_addr);
+    if (sf_slot == SnoopFilterCache::npos)
+        return;
+
+    SnoopItem& sf_item = cachedLocations.item(sf_slot);
+    sf_item.holder = 0;
+    eraseIfNullEntry(sf_slot);
+}
+
+void
+SnoopFilter::memInvalidate()
+{
+    DPRINTF(SnoopFilter, "%s: dropping %d SF entries\n", __func__,
+            cachedLocations.size());
+    cachedLocations.clear();
+    reqLookupResult.slot = SnoopFilterCache::npos;
+}
+
 SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
     : statistics::Group(parent),
       ADD_STAT(totRequests, statistics::units::Count::get(),
@@ -405,7 +560,10 @@ SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
                "holder of the requested data."),
       ADD_STAT(hitMultiSnoops, statistics::units::Count::get(),
                "Number of snoops hitting in the snoop filter with multiple "
-               "(>1) holders of the requested data.")
+               "(>1) holders of the requested data."),
+      ADD_STAT(backInvalidations, statistics::units::Count::get(),
+               "Number of lines back-invalidated to stay within the "
+               "capacity of the snoop filter.")
 {}
 
 void
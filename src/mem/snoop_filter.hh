@@ -44,8 +44,8 @@
 #define __MEM_SNOOP_FILTER_HH__
 
 #include <bitset>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "mem/packet.hh"
 #include "mem/port.hh"
@@ -96,9 +96,10 @@ class SnoopFilter : public SimObject
     typedef std::vector<QueuedResponsePort*> SnoopList;
 
     SnoopFilter (const SnoopFilterParams &p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()),
+        SimObject(p), reqLookupResult(SnoopFilterCache::npos),
         linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
         maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
+        backInvalidate(p.back_invalidate), victimPos(0),
         stats(this)
     {
     }
@@ -149,7 +150,7 @@ class SnoopFilter : public SimObject
      * reqLookupResult.
      *
      * @param will_retry    This request will retry on this bus / snoop filter
-     * @param addr          Packet address, merely for sanity checking
+     * @param addr          Packet address, to find the line again
      */
     void finishRequest(bool will_retry, Addr addr, bool is_secure);
 
@@ -200,6 +201,34 @@ class SnoopFilter : public SimObject
      */
     void updateResponse(const Packet *cpkt, const ResponsePort& cpu_side_port);
 
+    /**
+     * Pick a line to back-invalidate if the filter tracks more lines
+     * than its capacity and back-invalidation is enabled. Only lines
+     * without outstanding requests are picked. The caller is expected to
+     * invalidate the line in the returned ports and then call
+     * finishBackInvalidate.
+     *
+     * @param addr      Block address of the victim line.
+     * @param is_secure Security state of the victim line.
+     * @return List of ports holding the victim line, empty if none.
+     */
+    SnoopList selectVictim(Addr &addr, bool &is_secure);
+
+    /**
+     * Stop tracking a back-invalidated line.
+     *
+     * @param addr      Block address of the victim line.
+     * @param is_secure Security state of the victim line.
+     */
+    void finishBackInvalidate(Addr addr, bool is_secure);
+
+    /**
+     * Drop the tracking state of all lines, as the caches above
+     * are invalidated in bulk. Writing back the caches does not change
+     * residency, so memWriteback needs no counterpart.
+     */
+    void memInvalidate() override;
+
     virtual void regStats();
 
   protected:
@@ -221,9 +250,82 @@ class SnoopFilter : public SimObject
         SnoopMask holder;
     };
     /**
-     * HashMap of SnoopItems indexed by line address
+     * Hash table of SnoopItems indexed by line address, using open
+     * addressing with linear probing. The line addresses are kept apart
+     * from the items, in buckets of one cache line each, so that probing
+     * only touches the addresses until the line is found. Entries are
+     * identified by their slot, which stays valid until the next insert
+     * or erase.
      */
-    typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
+    class SnoopFilterCache
+    {
+      public:
+        static constexpr size_t npos = ~size_t(0);
+
+        SnoopFilterCache();
+
+        /** @return Slot of the line, npos if the line is not tracked */
+        size_t find(Addr line_addr) const;
+
+        /**
+         * Start tracking an untracked line with an empty item.
+         * @return Slot of the line
+         */
+        size_t insert(Addr line_addr);
+
+        /** Stop tracking the line in a slot. */
+        void erase(size_t slot);
+
+        /** Stop tracking all lines. */
+        void clear();
+
+        Addr key(size_t slot) const { return keyRef(slot); }
+        SnoopItem &item(size_t slot) { return items[slot]; }
+
+        /** @return Number of tracked lines */
+        size_t size() const { return numEntries; }
+
+        /** @return Number of slots, occupied or not */
+        size_t slots() const { return items.size(); }
+
+        bool occupied(size_t slot) const { return keyRef(slot) != Empty; }
+
+      private:
+        /** Key of an empty slot, never a line address */
+        static constexpr Addr Empty = MaxAddr;
+        static constexpr size_t KeysPerBucket = 64 / sizeof(Addr);
+
+        struct alignas(64) Bucket
+        {
+            Addr keys[KeysPerBucket];
+        };
+
+        Addr &
+        keyRef(size_t slot)
+        {
+            return buckets[slot / KeysPerBucket].keys[slot % KeysPerBucket];
+        }
+
+        const Addr &
+        keyRef(size_t slot) const
+        {
+            return buckets[slot / KeysPerBucket].keys[slot % KeysPerBucket];
+        }
+
+        size_t
+        home(Addr line_addr) const
+        {
+            return (line_addr * 0x9E3779B97F4A7C15ULL) >> hashShift;
+        }
+
+        /** Rebuild the table with the given number of slots. */
+        void resize(size_t num_slots);
+
+        std::vector<Bucket> buckets;
+        std::vector<SnoopItem> items;
+        size_t numEntries;
+        unsigned hashShift;
+    };
 
     /**
      * Simple factory methods for standard return values.
@@ -261,9 +363,9 @@ class SnoopFilter : public SimObject
     /**
      * Removes snoop filter items which have no requestors and no holders.
      */
-    void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
+    void eraseIfNullEntry(size_t sf_slot);
 
-    /** Simple hash set of cached addresses. */
+    /** Table of cached addresses. */
     SnoopFilterCache cachedLocations;
 
     /**
@@ -274,8 +376,11 @@ class SnoopFilter : public SimObject
      */
     struct ReqLookupResult
     {
-        /** Iterator used to store the result from lookupRequest. */
-        SnoopFilterCache::iterator it;
+        /**
+         * Slot of the line when lookupRequest ran, npos if it didn't
+         * track the line. Only valid until the next insert or erase.
+         */
+        size_t slot;
 
         /**
          * Variable to temporarily store value of snoopfilter entry
@@ -285,13 +390,14 @@ class SnoopFilter : public SimObject
         SnoopItem retryItem;
 
         /**
-         * The constructor must be informed of the internal cache's end
-         * iterator, so do not allow the compiler to implictly define it.
+         * The constructor must be informed of the internal cache's
+         * invalid slot, so do not allow the compiler to implictly define
+         * it.
          *
-         * @param end_it Iterator to the end of the internal cache.
+         * @param no_slot Slot denoting an untracked line.
          */
-        ReqLookupResult(SnoopFilterCache::iterator end_it)
-            : it(end_it), retryItem{0, 0}
+        ReqLookupResult(size_t no_slot)
+            : slot(no_slot), retryItem{0, 0}
         {
         }
         ReqLookupResult() = delete;
@@ -305,8 +411,15 @@ class SnoopFilter : public SimObject
     const Addr linesize;
     /** Latency for doing a lookup in the filter */
     const Cycles lookupLatency;
-    /** Max capacity in terms of cache blocks tracked, for sanity checking */
+    /**
+     * Max capacity in terms of cache blocks tracked, for sanity checking
+     * or, if back-invalidation is enabled, for picking victims
+     */
     const unsigned maxEntryCount;
+    /** Back-invalidate lines rather than exceed the capacity */
+    const bool backInvalidate;
+    /** Slot to resume the search for the next victim from */
+    size_t victimPos;
 
     /**
      * Use the lower bits of the address to keep track of the line status
@@ -329,6 +442,8 @@ class SnoopFilter : public SimObject
         statistics::Scalar totSnoops;
         statistics::Scalar hitSingleSnoops;
         statistics::Scalar hitMultiSnoops;
+
+        statistics::Scalar backInvalidations;
     } stats;
 };
 
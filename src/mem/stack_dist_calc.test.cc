@@ -0,0 +1,163 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "mem/stack_dist_calc.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** A naive stack, with the most recent address at the back */
+class NaiveStack
+{
+  public:
+    uint64_t
+    dist(Addr addr) const
+    {
+        for (size_t i = stack.size(); i-- > 0; ) {
+            if (stack[i] == addr)
+                return stack.size() - 1 - i;
+        }
+        return StackDistCalc::Infinity;
+    }
+
+    void
+    remove(Addr addr)
+    {
+        for (auto it = stack.begin(); it != stack.end(); ++it) {
+            if (*it == addr) {
+                stack.erase(it);
+                return;
+            }
+        }
+    }
+
+    void
+    access(Addr addr)
+    {
+        remove(addr);
+        stack.push_back(addr);
+    }
+
+  private:
+    std::vector<Addr> stack;
+};
+
+} // anonymous namespace
+
+/** Distances of repeated accesses to a few addresses. */
+TEST(StackDistCalcTest, Simple)
+{
+    StackDistCalc calc(true);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0x0).first,
+              StackDistCalc::Infinity);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0x40).first,
+              StackDistCalc::Infinity);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0x80).first,
+              StackDistCalc::Infinity);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0x0).first, 2);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0x0).first, 0);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0x40).first, 2);
+    EXPECT_EQ(calc.calcStackDist(0x80).first, 2);
+    EXPECT_EQ(calc.calcStackDist(0xc0).first, StackDistCalc::Infinity);
+}
+
+/** Marks are returned by the next lookup of the address. */
+TEST(StackDistCalcTest, Marks)
+{
+    StackDistCalc calc;
+    calc.calcStackDistAndUpdate(0x0);
+    calc.calcStackDistAndUpdate(0x40);
+
+    EXPECT_FALSE(calc.calcStackDist(0x0, true).second);
+    EXPECT_TRUE(calc.calcStackDist(0x0).second);
+    EXPECT_FALSE(calc.calcStackDist(0x0).second);
+
+    calc.calcStackDist(0x40, true);
+    auto removed = calc.calcStackDistAndUpdate(0x40, false);
+    EXPECT_EQ(removed.first, 0);
+    EXPECT_TRUE(removed.second);
+    EXPECT_EQ(calc.calcStackDist(0x40).first, StackDistCalc::Infinity);
+    EXPECT_EQ(calc.calcStackDist(0x0).first, 0);
+}
+
+/**
+ * Random accesses, lookups and removals must match a naive stack,
+ * across many renumberings of the timestamps.
+ */
+TEST(StackDistCalcTest, MatchesNaiveStack)
+{
+    StackDistCalc calc;
+    NaiveStack naive;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<Addr> line(0, 3000);
+    std::uniform_int_distribution<int> op(0, 19);
+
+    for (int i = 0; i < 100000; i++) {
+        const Addr addr = line(rng) * 64;
+        const int o = op(rng);
+        if (o == 0) {
+            ASSERT_EQ(calc.calcStackDistAndUpdate(addr, false).first,
+                      naive.dist(addr));
+            naive.remove(addr);
+        } else if (o == 1) {
+            ASSERT_EQ(calc.calcStackDist(addr).first, naive.dist(addr));
+        } else {
+            ASSERT_EQ(calc.calcStackDistAndUpdate(addr).first,
+                      naive.dist(addr));
+            naive.access(addr);
+        }
+    }
+}
+
+/** A sample of the addresses gives scaled distances. */
+TEST(StackDistCalcTest, Sampling)
+{
+    StackDistCalc calc(false, 0.25);
+
+    std::vector<Addr> sampled;
+    for (Addr addr = 0; addr < 64 * 40000; addr += 64) {
+        if (calc.sampled(addr))
+            sampled.push_back(addr);
+    }
+    EXPECT_NEAR(sampled.size(), 10000, 500);
+
+    for (Addr addr : sampled)
+        calc.calcStackDistAndUpdate(addr);
+    // All other sampled addresses were accessed after the first one
+    EXPECT_EQ(calc.calcStackDist(sampled[0]).first,
+              4 * (sampled.size() - 1));
+
+    StackDistCalc all;
+    for (Addr addr = 0; addr < 64 * 1000; addr += 64)
+        EXPECT_TRUE(all.sampled(addr));
+}
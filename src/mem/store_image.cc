@@ -0,0 +1,360 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/store_image.hh"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace
+{
+
+constexpr char Magic[8] = {'g', 'e', 'm', '5', 'p', 'm', 'e', 'm'};
+constexpr uint32_t Version = 1;
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t chunkSize;
+    uint64_t size;
+    uint64_t numChunks;
+    uint64_t indexOffset;
+    uint32_t basePathLength;
+    uint32_t reserved;
+};
+
+enum ChunkType : uint32_t
+{
+    ZeroChunk,
+    DataChunk,
+    RawChunk,
+    BaseChunk
+};
+
+struct ChunkEntry
+{
+    uint64_t offset;
+    uint32_t length;
+    uint32_t type;
+};
+
+unsigned
+numThreads(unsigned threads, uint64_t work)
+{
+    if (!threads)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    return std::max<uint64_t>(1, std::min<uint64_t>(threads, work));
+}
+
+/** Call f(i) for every i in [begin, end) from a number of threads. */
+template <typename F>
+void
+parallelFor(uint64_t begin, uint64_t end, unsigned threads, F &&f)
+{
+    std::atomic<uint64_t> next(begin);
+    auto worker = [&]() {
+        for (uint64_t i = next++; i < end; i = next++)
+            f(i);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < numThreads(threads, end - begin); t++)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &thread : pool)
+        thread.join();
+}
+
+bool
+readAt(int fd, void *buf, size_t len, uint64_t offset)
+{
+    uint8_t *ptr = static_cast<uint8_t *>(buf);
+    while (len) {
+        ssize_t ret = pread(fd, ptr, len, offset);
+        if (ret <= 0)
+            return false;
+        ptr += ret;
+        len -= ret;
+        offset += ret;
+    }
+    return true;
+}
+
+bool
+writeAt(int fd, const void *buf, size_t len, uint64_t offset)
+{
+    const uint8_t *ptr = static_cast<const uint8_t *>(buf);
+    while (len) {
+        ssize_t ret = pwrite(fd, ptr, len, offset);
+        if (ret <= 0)
+            return false;
+        ptr += ret;
+        len -= ret;
+        offset += ret;
+    }
+    return true;
+}
+
+bool
+isZero(const uint8_t *data, size_t len)
+{
+    return !len || (data[0] == 0 && !std::memcmp(data, data + 1, len - 1));
+}
+
+/** An open image and, recursively, the images it is a delta against. */
+class ImageReader
+{
+  public:
+    ImageReader(const std::string &path) : path(path)
+    {
+        fd = open(path.c_str(), O_RDONLY);
+        fatal_if(fd < 0, "Can't open memory image '%s'", path);
+
+        fatal_if(!readAt(fd, &header, sizeof(header), 0) ||
+                 std::memcmp(header.magic, Magic, sizeof(Magic)),
+                 "'%s' is not a memory image", path);
+        fatal_if(header.version != Version,
+                 "Unsupported version %d of memory image '%s'",
+                 header.version, path);
+
+        index.resize(header.numChunks);
+        fatal_if(!readAt(fd, index.data(), index.size() * sizeof(ChunkEntry),
+                         header.indexOffset),
+                 "Can't read the index of memory image '%s'", path);
+
+        if (header.basePathLength) {
+            std::string base_path(header.basePathLength, '\0');
+            fatal_if(!readAt(fd, base_path.data(), base_path.size(),
+                             sizeof(Header)),
+                     "Can't read the base of memory image '%s'", path);
+
+            namespace fs = std::filesystem;
+            fs::path resolved(base_path);
+            if (resolved.is_relative())
+                resolved = fs::path(path).parent_path() / resolved;
+            base = std::make_unique<ImageReader>(resolved.string());
+            fatal_if(base->size() != size() ||
+                     base->chunkSize() != chunkSize(),
+                     "Memory image '%s' doesn't match its base '%s'",
+                     path, base->path);
+        }
+    }
+
+    ~ImageReader() { close(fd); }
+
+    uint64_t size() const { return header.size; }
+    uint32_t chunkSize() const { return header.chunkSize; }
+    uint64_t numChunks() const { return header.numChunks; }
+
+    size_t
+    chunkLength(uint64_t idx) const
+    {
+        return std::min<uint64_t>(chunkSize(), size() - idx * chunkSize());
+    }
+
+    /**
+     * Decompress a chunk. Safe to call from several threads at once.
+     * @return False if the image is corrupt.
+     */
+    bool
+    readChunk(uint64_t idx, uint8_t *dst) const
+    {
+        const ChunkEntry &entry = index[idx];
+        const size_t len = chunkLength(idx);
+
+        switch (entry.type) {
+          case ZeroChunk:
+            std::memset(dst, 0, len);
+            return true;
+          case RawChunk:
+            return entry.length == len &&
+                readAt(fd, dst, len, entry.offset);
+          case DataChunk:
+            {
+                std::vector<uint8_t> buf(entry.length);
+                if (!readAt(fd, buf.data(), buf.size(), entry.offset))
+                    return false;
+                uLongf out_len = len;
+                return uncompress(dst, &out_len, buf.data(), buf.size()) ==
+                    Z_OK && out_len == len;
+            }
+          case BaseChunk:
+            return base && base->readChunk(idx, dst);
+          default:
+            return false;
+        }
+    }
+
+    const std::string path;
+
+  private:
+    int fd;
+    Header header;
+    std::vector<ChunkEntry> index;
+    std::unique_ptr<ImageReader> base;
+};
+
+} // anonymous namespace
+
+void
+writeStoreImage(const std::string &path, const uint8_t *data, uint64_t size,
+                const std::string &base_path, unsigned threads,
+                uint32_t chunk_size)
+{
+    fatal_if(!chunk_size, "Memory image chunk size can't be zero");
+
+    std::unique_ptr<ImageReader> base;
+    std::string stored_base_path;
+    if (!base_path.empty()) {
+        base = std::make_unique<ImageReader>(base_path);
+        fatal_if(base->size() != size || base->chunkSize() != chunk_size,
+                 "Base memory image '%s' doesn't match the store", base_path);
+
+        // Refer to the base relative to the new image where possible so
+        // checkpoint directories can be moved together
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        fs::path abs_base = fs::absolute(base_path);
+        fs::path rel_base = fs::relative(
+                abs_base, fs::absolute(path).parent_path(), ec);
+        stored_base_path = ec || rel_base.empty() ?
+            abs_base.string() : rel_base.string();
+    }
+
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    fatal_if(fd < 0, "Can't open memory image '%s'", path);
+
+    Header header = {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.chunkSize = chunk_size;
+    header.size = size;
+    header.numChunks = (size + chunk_size - 1) / chunk_size;
+    header.basePathLength = stored_base_path.size();
+
+    std::vector<ChunkEntry> index(header.numChunks);
+    uint64_t offset = sizeof(Header) + stored_base_path.size();
+
+    // Compress a batch of chunks in parallel, then append them in order
+    const uint64_t batch_size = numThreads(threads, header.numChunks) * 16;
+    std::vector<std::vector<uint8_t>> batch(batch_size);
+    for (uint64_t first = 0; first < header.numChunks; first += batch_size) {
+        const uint64_t last =
+            std::min<uint64_t>(first + batch_size, header.numChunks);
+
+        parallelFor(first, last, threads, [&](uint64_t i) {
+            const uint8_t *chunk = data + i * chunk_size;
+            const size_t len =
+                std::min<uint64_t>(chunk_size, size - i * chunk_size);
+            ChunkEntry &entry = index[i];
+            std::vector<uint8_t> &buf = batch[i - first];
+            buf.clear();
+
+            if (isZero(chunk, len)) {
+                entry.type = ZeroChunk;
+                return;
+            }
+
+            if (base) {
+                std::vector<uint8_t> base_chunk(len);
+                if (base->readChunk(i, base_chunk.data()) &&
+                    !std::memcmp(base_chunk.data(), chunk, len)) {
+                    entry.type = BaseChunk;
+                    return;
+                }
+            }
+
+            uLongf out_len = compressBound(len);
+            buf.resize(out_len);
+            if (compress2(buf.data(), &out_len, chunk, len,
+                          Z_BEST_SPEED) == Z_OK && out_len < len) {
+                buf.resize(out_len);
+                entry.type = DataChunk;
+            } else {
+                buf.assign(chunk, chunk + len);
+                entry.type = RawChunk;
+            }
+            entry.length = buf.size();
+        });
+
+        for (uint64_t i = first; i < last; i++) {
+            const std::vector<uint8_t> &buf = batch[i - first];
+            if (buf.empty())
+                continue;
+            fatal_if(!writeAt(fd, buf.data(), buf.size(), offset),
+                     "Write failed on memory image '%s'", path);
+            index[i].offset = offset;
+            offset += buf.size();
+        }
+    }
+
+    header.indexOffset = offset;
+    fatal_if(!writeAt(fd, index.data(), index.size() * sizeof(ChunkEntry),
+                      offset) ||
+             !writeAt(fd, stored_base_path.data(), stored_base_path.size(),
+                      sizeof(Header)) ||
+             !writeAt(fd, &header, sizeof(header), 0),
+             "Write failed on memory image '%s'", path);
+
+    fatal_if(close(fd), "Close failed on memory image '%s'", path);
+}
+
+void
+readStoreImage(const std::string &path, uint8_t *data, uint64_t size,
+               unsigned threads)
+{
+    ImageReader image(path);
+    fatal_if(image.size() != size,
+             "Memory image '%s' has size %lld, expected %lld",
+             path, image.size(), size);
+
+    std::atomic<bool> failed(false);
+    parallelFor(0, image.numChunks(), threads, [&](uint64_t i) {
+        if (!image.readChunk(i, data + i * image.chunkSize()))
+            failed = true;
+    });
+    fatal_if(failed, "Memory image '%s' is corrupt", path);
+}
+
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,91 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_STORE_IMAGE_HH__
+#define __MEM_STORE_IMAGE_HH__
+
+#include <cstdint>
+#include <string>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * @file
+ * Chunked image format for checkpointing memory backing stores.
+ *
+ * The store is split into fixed-size chunks that are compressed
+ * independently with zlib, so they can be compressed and decompressed in
+ * parallel. Chunks that only contain zeros are not stored at all. An
+ * image can also be written as a delta against a base image: chunks
+ * identical to the same chunk in the base are stored as a reference to
+ * it, which keeps many checkpoints of the same workload cheap on disk.
+ *
+ * The file starts with a header and the path of the base image (if
+ * any), followed by the compressed chunks and an index with one entry
+ * per chunk. A relative base path is relative to the directory of the
+ * image referring to it.
+ */
+
+/** Default size of the chunks of an image. */
+constexpr uint32_t StoreImageChunkSize = 64 * 1024;
+
+/**
+ * Write a store to an image.
+ *
+ * @param path File to write.
+ * @param data Contents of the store.
+ * @param size Size of the store in bytes.
+ * @param base_path Image to write a delta against, empty for none. It
+ *        must hold a store of the same size and chunk size.
+ * @param threads Number of threads compressing chunks, 0 to use all
+ *        the host's cores.
+ * @param chunk_size Size of the chunks.
+ */
+void writeStoreImage(const std::string &path, const uint8_t *data,
+                     uint64_t size, const std::string &base_path,
+                     unsigned threads,
+                     uint32_t chunk_size = StoreImageChunkSize);
+
+/**
+ * Restore a store from an image written by writeStoreImage(), including
+ * the chunks it references in its base images.
+ *
+ * @param path File to read.
+ * @param data Store to fill in.
+ * @param size Size of the store in bytes, which must match the image.
+ * @param threads Number of threads decompressing chunks, 0 to use all
+ *        the host's cores.
+ */
+void readStoreImage(const std::string &path, uint8_t *data, uint64_t size,
+                    unsigned threads);
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_STORE_IMAGE_HH__
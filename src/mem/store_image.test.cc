@@ -0,0 +1,150 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mem/store_image.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+constexpr uint32_t ChunkSize = 4096;
+
+class StoreImageTest : public testing::Test
+{
+  protected:
+    void
+    SetUp() override
+    {
+        char tmpl[] = "/tmp/store_image.test.XXXXXX";
+        ASSERT_NE(mkdtemp(tmpl), nullptr);
+        dir = tmpl;
+    }
+
+    void
+    TearDown() override
+    {
+        for (const auto &file : files)
+            unlink(file.c_str());
+        rmdir(dir.c_str());
+    }
+
+    std::string
+    file(const std::string &name)
+    {
+        files.push_back(dir + "/" + name);
+        return files.back();
+    }
+
+    static off_t
+    fileSize(const std::string &path)
+    {
+        struct stat st;
+        return stat(path.c_str(), &st) ? -1 : st.st_size;
+    }
+
+    /** A store with some random, some repetitive and some zero chunks. */
+    static std::vector<uint8_t>
+    makeStore(size_t size)
+    {
+        std::vector<uint8_t> store(size, 0);
+        std::mt19937 rng(1);
+        for (size_t i = 0; i < size; i++) {
+            switch ((i / ChunkSize) % 3) {
+              case 0: store[i] = rng(); break;
+              case 1: store[i] = i % 7; break;
+              default: break;
+            }
+        }
+        return store;
+    }
+
+    std::string dir;
+    std::vector<std::string> files;
+};
+
+} // anonymous namespace
+
+TEST_F(StoreImageTest, RoundTrip)
+{
+    // Not a multiple of the chunk size to cover the last partial chunk
+    const size_t size = ChunkSize * 30 + 100;
+    std::vector<uint8_t> store = makeStore(size);
+    std::string path = file("store.img");
+
+    memory::writeStoreImage(path, store.data(), size, "", 4, ChunkSize);
+
+    std::vector<uint8_t> restored(size, 0xff);
+    memory::readStoreImage(path, restored.data(), size, 3);
+    EXPECT_EQ(store, restored);
+}
+
+TEST_F(StoreImageTest, ZeroChunksTakeNoSpace)
+{
+    const size_t size = ChunkSize * 256;
+    std::vector<uint8_t> store(size, 0);
+    std::string path = file("zero.img");
+
+    memory::writeStoreImage(path, store.data(), size, "", 2, ChunkSize);
+    // Only the header and the index are written
+    EXPECT_LT(fileSize(path), (off_t)(size / 64));
+
+    std::vector<uint8_t> restored(size, 0xff);
+    memory::readStoreImage(path, restored.data(), size, 2);
+    EXPECT_EQ(store, restored);
+}
+
+TEST_F(StoreImageTest, Delta)
+{
+    const size_t size = ChunkSize * 30;
+    std::vector<uint8_t> store = makeStore(size);
+    std::string base = file("base.img");
+    memory::writeStoreImage(base, store.data(), size, "", 4, ChunkSize);
+
+    // Change a single random chunk and write a delta against the base
+    store[ChunkSize * 3 + 5] ^= 0x5a;
+    std::string delta = file("delta.img");
+    memory::writeStoreImage(delta, store.data(), size, base, 4, ChunkSize);
+    EXPECT_LT(fileSize(delta), fileSize(base) / 4);
+
+    // And a delta of the delta
+    store[ChunkSize * 9] ^= 0xa5;
+    std::string delta2 = file("delta2.img");
+    memory::writeStoreImage(delta2, store.data(), size, delta, 4, ChunkSize);
+
+    std::vector<uint8_t> restored(size, 0xff);
+    memory::readStoreImage(delta2, restored.data(), size, 4);
+    EXPECT_EQ(store, restored);
+}
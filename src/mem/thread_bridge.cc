@@ -27,15 +27,99 @@
 
 #include "mem/thread_bridge.hh"
 
+#include "base/logging.hh"
 #include "base/trace.hh"
-#include "sim/eventq.hh"
 
 namespace gem5
 {
 
 ThreadBridge::ThreadBridge(const ThreadBridgeParams &p)
-    : SimObject(p), in_port_("in_port", *this), out_port_("out_port", *this)
+    : SimObject(p), in_port_("in_port", *this), out_port_("out_port", *this),
+      delay_(p.delay), req_size_(p.req_size), req_slots_(p.req_size)
 {
+    fatal_if(req_size_ == 0, "%s: req_size must be at least 1\n", name());
+
+    // A bridge without a delay of its own follows the quantum
+    if (delay_)
+        declareQuantumLookahead(delay_);
+}
+
+void
+ThreadBridge::crossTo(EventQueue *queue, std::function<void()> func,
+                      const char *what)
+{
+    // Scheduling on another queue while running in parallel is an
+    // asynchronous insert, which is safe from any thread
+    queue->schedule(new EventFunctionWrapper(std::move(func),
+                                             name() + what, true),
+                    curTick() + crossingDelay());
+}
+
+void
+ThreadBridge::packetDone()
+{
+    if (--in_flight_ == 0 && drainState() == DrainState::Draining)
+        signalDrainDone();
+}
+
+void
+ThreadBridge::recvForwardedReq(PacketPtr pkt)
+{
+    req_queue_.push_back(pkt);
+    if (!waiting_req_retry_)
+        trySendReqs();
+}
+
+void
+ThreadBridge::trySendReqs()
+{
+    while (!req_queue_.empty()) {
+        PacketPtr pkt = req_queue_.front();
+        const bool needs_response = pkt->needsResponse();
+        if (!out_port_.sendTimingReq(pkt)) {
+            waiting_req_retry_ = true;
+            return;
+        }
+        req_queue_.pop_front();
+
+        bool retry;
+        {
+            std::lock_guard<std::mutex> lock(req_slots_mutex_);
+            req_slots_++;
+            retry = retry_req_;
+            retry_req_ = false;
+        }
+        if (retry) {
+            crossTo(requestor_queue_, [this]() { in_port_.sendRetryReq(); },
+                    ".retryReq");
+        }
+
+        // A request that gets a response stays accounted for until the
+        // response has left the bridge
+        if (!needs_response)
+            packetDone();
+    }
+}
+
+void
+ThreadBridge::recvForwardedResp(PacketPtr pkt)
+{
+    resp_queue_.push_back(pkt);
+    if (!waiting_resp_retry_)
+        trySendResps();
+}
+
+void
+ThreadBridge::trySendResps()
+{
+    while (!resp_queue_.empty()) {
+        if (!in_port_.sendTimingResp(resp_queue_.front())) {
+            waiting_resp_retry_ = true;
+            return;
+        }
+        resp_queue_.pop_front();
+        packetDone();
+    }
 }
 
 ThreadBridge::IncomingPort::IncomingPort(const std::string &name,
@@ -54,12 +138,33 @@ ThreadBridge::IncomingPort::getAddrRanges() const
 bool
 ThreadBridge::IncomingPort::recvTimingReq(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    EventQueue *queue = curEventQueue();
+    if (!device_.requestor_queue_)
+        device_.requestor_queue_ = queue;
+    panic_if(device_.requestor_queue_ != queue,
+             "%s: timing requests from more than one event queue.\n",
+             name());
+
+    {
+        std::lock_guard<std::mutex> lock(device_.req_slots_mutex_);
+        if (device_.req_slots_ == 0) {
+            device_.retry_req_ = true;
+            return false;
+        }
+        device_.req_slots_--;
+    }
+
+    device_.in_flight_++;
+    device_.crossTo(device_.eventQueue(),
+                    [this, pkt]() { device_.recvForwardedReq(pkt); },
+                    ".forwardReq");
+    return true;
 }
 void
 ThreadBridge::IncomingPort::recvRespRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    device_.waiting_resp_retry_ = false;
+    device_.trySendResps();
 }
 
 // AtomicResponseProtocol
@@ -94,12 +199,26 @@ ThreadBridge::OutgoingPort::recvRangeChange()
 bool
 ThreadBridge::OutgoingPort::recvTimingResp(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    // The requestor side has no bound on the responses it buffers, so
+    // responses are always accepted
+    device_.in_flight_++;
+    device_.crossTo(device_.requestor_queue_,
+                    [this, pkt]() { device_.recvForwardedResp(pkt); },
+                    ".forwardResp");
+    device_.packetDone();
+    return true;
 }
 void
 ThreadBridge::OutgoingPort::recvReqRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    device_.waiting_req_retry_ = false;
+    device_.trySendReqs();
+}
+
+DrainState
+ThreadBridge::drain()
+{
+    return in_flight_ == 0 ? DrainState::Drained : DrainState::Draining;
 }
 
 Port &
@@ -28,8 +28,15 @@
 #ifndef __MEM_THREAD_BRIDGE_HH__
 #define __MEM_THREAD_BRIDGE_HH__
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+
 #include "mem/port.hh"
 #include "params/ThreadBridge.hh"
+#include "sim/eventq.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -43,6 +50,8 @@ class ThreadBridge : public SimObject
     Port &getPort(const std::string &if_name,
                   PortID idx = InvalidPortID) override;
 
+    DrainState drain() override;
+
   private:
     class IncomingPort : public ResponsePort
     {
@@ -78,8 +87,59 @@ class ThreadBridge : public SimObject
         ThreadBridge &device_;
     };
 
+    /**
+     * Latency of a timing crossing. An event scheduled on another
+     * EventQueue has to be at least a quantum in the future.
+     */
+    Tick crossingDelay() const { return std::max(delay_, simQuantum); }
+
+    /** Schedule a function on a queue, a crossing delay from now. */
+    void crossTo(EventQueue *queue, std::function<void()> func,
+                 const char *what);
+
+    /** Account for a packet leaving the bridge. */
+    void packetDone();
+
+    /** @{ */
+    /** Only called on the EventQueue of the bridge (target side). */
+    void recvForwardedReq(PacketPtr pkt);
+    void trySendReqs();
+    /** @} */
+
+    /** @{ */
+    /** Only called on the EventQueue of the requestor. */
+    void recvForwardedResp(PacketPtr pkt);
+    void trySendResps();
+    /** @} */
+
     IncomingPort in_port_;
     OutgoingPort out_port_;
+
+    const Tick delay_;
+    const unsigned req_size_;
+
+    /** EventQueue of the requestor, learnt from the first request. */
+    EventQueue *requestor_queue_ = nullptr;
+
+    /**
+     * Request buffer space, shared by both sides. Requests take a slot
+     * when they enter the bridge and give it back once the target has
+     * accepted them.
+     */
+    std::mutex req_slots_mutex_;
+    unsigned req_slots_;
+    bool retry_req_ = false;
+
+    /** Requests waiting for the target, target side only. */
+    std::deque<PacketPtr> req_queue_;
+    bool waiting_req_retry_ = false;
+
+    /** Responses waiting for the requestor, requestor side only. */
+    std::deque<PacketPtr> resp_queue_;
+    bool waiting_resp_retry_ = false;
+
+    /** Timing packets crossing or buffered in the bridge. */
+    std::atomic<unsigned> in_flight_{0};
 };
 
 }  // namespace gem5
@@ -337,10 +337,9 @@ BaseXBar::findPort(AddrRange addr_range, PacketPtr pkt)
     // ranges of all connected CPU-side-port modules
     assert(gotAllAddrRanges);
 
-    // Check the address map interval tree
-    auto i = portMap.contains(addr_range);
-    if (i != portMap.end()) {
-        return i->second;
+    // Check the address decoder
+    if (const PortID *id = portDecoder.contains(addr_range)) {
+        return *id;
     }
 
     // Check if this matches the default range
@@ -447,6 +446,8 @@ BaseXBar::recvRangeChange(PortID mem_side_port_id)
     // modules, go ahead and tell our connected memory-side-port modules in
     // turn, this effectively assumes a tree structure of the system
     if (gotAllAddrRanges) {
+        portDecoder.build(portMap);
+
         DPRINTF(AddrRanges, "Aggregating address ranges\n");
         xbarRanges.clear();
 
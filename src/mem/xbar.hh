@@ -49,6 +49,7 @@
 #include <deque>
 #include <unordered_map>
 
+#include "base/addr_range_decoder.hh"
 #include "base/addr_range_map.hh"
 #include "base/types.hh"
 #include "mem/qport.hh"
@@ -318,6 +319,12 @@ class BaseXBar : public ClockedObject
 
     AddrRangeMap<PortID, 3> portMap;
 
+    /**
+     * Flat copy of portMap used for the lookups in findPort, rebuilt
+     * whenever the ranges change once all of them are known.
+     */
+    AddrRangeDecoder<PortID> portDecoder;
+
     /**
      * Remember where request packets came from so that we can route
      * responses to the appropriate port. This relies on the fact that
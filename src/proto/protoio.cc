@@ -100,10 +100,13 @@ ProtoOutputStream::write(const Message& msg)
     msg.SerializeWithCachedSizes(&codedStream);
 }
 
-ProtoInputStream::ProtoInputStream(const std::string& filename) :
+ProtoInputStream::ProtoInputStream(const std::string& filename,
+                                   bool read_ahead) :
     fileStream(filename.c_str(), std::ios::in | std::ios::binary),
     fileName(filename), useGzip(false),
-    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
+    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL),
+    readAhead(read_ahead), readerDone(false), readerStop(false),
+    batchPos(0)
 {
     if (!fileStream.good())
         panic("Could not open %s for reading\n", filename);
@@ -118,6 +121,7 @@ ProtoInputStream::ProtoInputStream(const std::string& filename) :
     fileStream.seekg(0, std::ifstream::beg);
 
     createStreams();
+    startReader();
 }
 
 void
@@ -163,6 +167,7 @@ ProtoInputStream::destroyStreams()
 
 ProtoInputStream::~ProtoInputStream()
 {
+    stopReader();
     destroyStreams();
     fileStream.close();
 }
@@ -171,16 +176,111 @@ ProtoInputStream::~ProtoInputStream()
 void
 ProtoInputStream::reset()
 {
+    stopReader();
     destroyStreams();
     // seek to the start of the input file and clear any flags
     fileStream.clear();
     fileStream.seekg(0, std::ifstream::beg);
     createStreams();
+    startReader();
+}
+
+void
+ProtoInputStream::startReader()
+{
+    if (!readAhead)
+        return;
+
+    batches.clear();
+    batch.clear();
+    batchPos = 0;
+    readerDone = false;
+    readerStop = false;
+    reader = std::thread(&ProtoInputStream::readerMain, this);
+}
+
+void
+ProtoInputStream::stopReader()
+{
+    if (!reader.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(readerMutex);
+        readerStop = true;
+    }
+    readerCond.notify_all();
+    reader.join();
+}
+
+bool
+ProtoInputStream::readEncoded(std::string& buf)
+{
+    uint32_t size;
+
+    // See read() for why the coded stream is created per message
+    io::CodedInputStream codedStream(zeroCopyStream);
+    if (!codedStream.ReadVarint32(&size))
+        return false;
+    if (!codedStream.ReadString(&buf, size))
+        panic("Unable to read message from coded stream %s\n", fileName);
+    return true;
+}
+
+void
+ProtoInputStream::readerMain()
+{
+    bool eof = false;
+    while (!eof) {
+        std::vector<std::string> next;
+        next.reserve(batchMessages);
+        while (next.size() < batchMessages) {
+            std::string buf;
+            if (!readEncoded(buf)) {
+                eof = true;
+                break;
+            }
+            next.push_back(std::move(buf));
+        }
+
+        std::unique_lock<std::mutex> lock(readerMutex);
+        readerCond.wait(lock, [this]{
+            return readerStop || batches.size() < maxBatches;
+        });
+        if (readerStop)
+            return;
+        if (!next.empty())
+            batches.push_back(std::move(next));
+        readerDone = eof;
+        lock.unlock();
+        readerCond.notify_all();
+    }
 }
 
 bool
 ProtoInputStream::read(Message& msg)
 {
+    if (readAhead) {
+        if (batchPos == batch.size()) {
+            std::unique_lock<std::mutex> lock(readerMutex);
+            readerCond.wait(lock, [this]{
+                return readerDone || !batches.empty();
+            });
+            if (batches.empty())
+                return false;
+            batch = std::move(batches.front());
+            batches.pop_front();
+            batchPos = 0;
+            lock.unlock();
+            readerCond.notify_all();
+        }
+
+        if (!msg.ParseFromString(batch[batchPos++]))
+            panic("Unable to read message from coded stream %s\n",
+                  fileName);
+        return true;
+    }
+
     // Read a message from the stream by getting the size, using it as
     // a limit when parsing the message, then popping the limit again
     uint32_t size;
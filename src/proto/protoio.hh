@@ -49,7 +49,13 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/message.h>
 
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 /**
  * A ProtoStream provides the shared functionality of the input and
@@ -136,6 +142,11 @@ class ProtoOutputStream : public ProtoStream
  * stream is done on a per-message basis to avoid having to deal with
  * huge data structures. The latter assumes the length of each message
  * is encoded in the stream when it is written.
+ *
+ * With read-ahead enabled, a background thread does the file I/O and
+ * decompression, and hands the encoded messages over in batches
+ * through a bounded queue. Only the parsing of each message is left
+ * to the reading thread.
  */
 class ProtoInputStream : public ProtoStream
 {
@@ -147,8 +158,9 @@ class ProtoInputStream : public ProtoStream
      * ends with .gz then the file will be decompressed accordingly.
      *
      * @param filename Path to the file to read from
+     * @param read_ahead Read and decompress on a background thread
      */
-    ProtoInputStream(const std::string& filename);
+    ProtoInputStream(const std::string& filename, bool read_ahead = false);
 
     /**
      * Destruct the input stream, and also close the underlying file
@@ -181,6 +193,25 @@ class ProtoInputStream : public ProtoStream
      */
     void destroyStreams();
 
+    /**
+     * Read the size and the encoded bytes of the next message.
+     *
+     * @param buf Buffer to hold the encoded message
+     * @return True if a message was read, false at the end of the file
+     */
+    bool readEncoded(std::string& buf);
+
+    /**
+     * Start and stop the read-ahead thread.
+     * @{
+     */
+    void startReader();
+    void stopReader();
+    /** @} */
+
+    /** Body of the read-ahead thread. */
+    void readerMain();
+
     /// Underlying file input stream
     std::ifstream fileStream;
 
@@ -199,6 +230,37 @@ class ProtoInputStream : public ProtoStream
     /// Top-level zero-copy stream, either with compression or not
     google::protobuf::io::ZeroCopyInputStream* zeroCopyStream;
 
+    /// Messages the read-ahead thread hands over at a time
+    static const size_t batchMessages = 1024;
+
+    /// Batches the read-ahead thread may get ahead of the reader
+    static const size_t maxBatches = 8;
+
+    /// Whether a background thread reads ahead
+    const bool readAhead;
+
+    /// The read-ahead thread
+    std::thread reader;
+
+    /// Protects the members below shared with the read-ahead thread
+    std::mutex readerMutex;
+
+    /// Signalled when a batch is queued or taken, or the reader stops
+    std::condition_variable readerCond;
+
+    /// Batches of encoded messages read ahead
+    std::deque<std::vector<std::string>> batches;
+
+    /// The read-ahead thread reached the end of the file
+    bool readerDone;
+
+    /// The read-ahead thread is asked to stop
+    bool readerStop;
+
+    /// The batch being parsed and the position in it
+    std::vector<std::string> batch;
+    size_t batchPos;
+
 };
 
 #endif //__PROTO_PROTOIO_HH
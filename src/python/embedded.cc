@@ -91,8 +91,13 @@ EmbeddedPython::getCode() const
 bool
 EmbeddedPython::addModule() const
 {
+    // Most of the embedded modules are never imported, so only hand the
+    // importer a function to uncompress and unmarshal the code on its
+    // first import. The compressed code stays in the binary's read-only
+    // data until then.
     auto importer = py::module_::import("importer");
-    importer.attr("add_module")(abspath, modpath, getCode());
+    importer.attr("add_module")(abspath, modpath,
+            py::cpp_function([this]() { return getCode(); }));
     return true;
 }
 
@@ -0,0 +1,288 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Helpers to split a configured system across several event queues.
+
+A partition is a set of SimObject subtrees that share one event queue.
+Every port connection that crosses two partitions is rerouted through a
+ThreadBridge running on the queue of the responder, and the simulation
+quantum is chosen from the latencies the crossings already model so that
+the bridges add as little timing distortion as possible.
+
+Example:
+
+    partitioner = EventQueuePartitioner(root, board)
+    memory = board.get_memory()
+    partitioner.partition_by_memory_channel(
+        memory.get_memory_controllers()
+    )
+    partitioner.apply()
+    print(partitioner.report())
+"""
+
+from typing import Dict, Iterable, List, Optional
+
+import m5
+from m5.objects import (
+    BaseCache,
+    BaseXBar,
+    CoherentXBar,
+    MemCtrl,
+    Root,
+    SimObject,
+    ThreadBridge,
+)
+from m5.proxy import isproxy
+from m5.util import fatal, warn
+
+
+class Crossing:
+    """A requestor to responder connection between two partitions."""
+
+    def __init__(self, requestor, responder, latency: int):
+        self.requestor = requestor
+        self.responder = responder
+        # Latency, in ticks, that the crossing already models on top of
+        # the bridge. The quantum must not exceed it to keep timing intact.
+        self.latency = latency
+        self.bridge: Optional[ThreadBridge] = None
+
+    def src_queue(self) -> int:
+        return _queue_of(self.requestor.simobj)
+
+    def dst_queue(self) -> int:
+        return _queue_of(self.responder.simobj)
+
+
+def _queue_of(obj: SimObject) -> int:
+    index = obj.eventq_index
+    if isproxy(index):
+        index = index.unproxy(obj)
+    return int(index)
+
+
+def _clock_period(obj: SimObject) -> int:
+    try:
+        domain = obj.clk_domain
+        if isproxy(domain):
+            domain = domain.unproxy(obj)
+        return domain.clock[0].getValue()
+    except Exception:
+        # Objects without a clock domain contribute no cycle latency.
+        return 0
+
+
+def _boundary_latency(obj: SimObject, request: bool) -> int:
+    """The latency, in ticks, that obj adds to a packet at its port."""
+    period = _clock_period(obj)
+    if isinstance(obj, BaseXBar):
+        cycles = int(obj.frontend_latency) + int(obj.forward_latency)
+        if not request:
+            cycles = int(obj.response_latency)
+        return cycles * period
+    if isinstance(obj, BaseCache):
+        cycles = int(obj.tag_latency)
+        if not request:
+            cycles = int(obj.response_latency)
+        return cycles * period
+    if isinstance(obj, MemCtrl):
+        return obj.static_frontend_latency.getValue()
+    return 0
+
+
+class EventQueuePartitioner:
+    """
+    Assign a system to several event queues and bridge the boundaries.
+
+    Queue 0 keeps everything that is not explicitly assigned, so the
+    partitions created by the helpers start at queue 1.
+    """
+
+    def __init__(self, root: Root, system: SimObject):
+        self._root = root
+        self._system = system
+        self._partitions: Dict[int, List[SimObject]] = {}
+        self._crossings: List[Crossing] = []
+        self._quantum = 0
+
+    def assign(self, objects: Iterable[SimObject], queue: int) -> None:
+        """
+        Run the subtrees rooted at objects on the given event queue.
+        Children inherit the queue unless they set eventq_index
+        themselves.
+        """
+        if queue < 0:
+            fatal(f"Invalid event queue index {queue}")
+        for obj in objects:
+            obj.eventq_index = queue
+            self._partitions.setdefault(queue, []).append(obj)
+
+    def partition_by_cluster(
+        self, clusters: Iterable[Iterable[SimObject]]
+    ) -> None:
+        """
+        Give every core cluster, i.e. its cores and private caches, its
+        own event queue. Cluster boundaries must not cut a coherent
+        crossbar off from the caches it snoops.
+        """
+        for i, cluster in enumerate(clusters):
+            self.assign(cluster, i + 1)
+
+    def partition_by_memory_channel(
+        self, channels: Iterable[SimObject]
+    ) -> None:
+        """Give every memory channel its own event queue."""
+        for i, channel in enumerate(channels):
+            self.assign([channel], i + 1)
+
+    def _find_crossings(self) -> List[Crossing]:
+        crossings = []
+        for obj in self._root.descendants():
+            for ref in obj._port_refs.values():
+                elements = getattr(ref, "elements", [ref])
+                for port in elements:
+                    if port.role != "GEM5 REQUESTOR":
+                        continue
+                    peer = port.peer
+                    if peer is None or isproxy(peer):
+                        continue
+                    if _queue_of(obj) == _queue_of(peer.simobj):
+                        continue
+                    latency = max(
+                        _boundary_latency(obj, True),
+                        _boundary_latency(peer.simobj, False),
+                    )
+                    crossings.append(Crossing(port, peer, latency))
+        return crossings
+
+    def _check(self, crossing: Crossing) -> None:
+        req = crossing.requestor.simobj
+        resp = crossing.responder.simobj
+        # ThreadBridge does not forward snoops, so a snooping requestor
+        # behind it would silently fall out of the coherence domain.
+        if isinstance(resp, CoherentXBar) and isinstance(
+            req, (BaseCache, CoherentXBar)
+        ):
+            fatal(
+                f"Cannot split the coherent connection {crossing.requestor}"
+                f" -> {crossing.responder} across event queues; move the "
+                "partition boundary below the point of coherence."
+            )
+        if not isinstance(req, BaseXBar) and not isinstance(resp, BaseXBar):
+            warn(
+                f"Event queue boundary {crossing.requestor} -> "
+                f"{crossing.responder} is not at a crossbar."
+            )
+
+    def apply(self) -> None:
+        """
+        Insert a ThreadBridge on every crossing and set the simulation
+        quantum. Must be called before m5.instantiate().
+        """
+        self._crossings = self._find_crossings()
+        if not self._crossings:
+            return
+
+        for crossing in self._crossings:
+            self._check(crossing)
+
+        # The quantum is the lookahead of the tightest crossing. Crossings
+        # that model no latency of their own fall back to one cycle of the
+        # slowest clock so that the queues can still make progress.
+        latencies = [c.latency for c in self._crossings if c.latency > 0]
+        if latencies:
+            self._quantum = min(latencies)
+        else:
+            self._quantum = max(
+                _clock_period(c.responder.simobj) for c in self._crossings
+            )
+        if self._quantum <= 0:
+            fatal("Unable to derive a simulation quantum from the crossings")
+        self._root.sim_quantum = self._quantum
+
+        for i, crossing in enumerate(self._crossings):
+            bridge = ThreadBridge(
+                eventq_index=crossing.dst_queue(),
+                delay=f"{self._quantum}t",
+            )
+            setattr(self._system, f"eventq_bridge{i}", bridge)
+            crossing.requestor.peer = None
+            crossing.responder.peer = None
+            crossing.requestor.connect(bridge.in_port)
+            bridge.out_port = crossing.responder
+            crossing.bridge = bridge
+
+    def lookahead(self, queue: int) -> int:
+        """
+        The ticks queue can run ahead of the others, i.e. the smallest
+        latency of any crossing that leaves or enters it.
+        """
+        latencies = [
+            max(c.latency, self._quantum)
+            for c in self._crossings
+            if queue in (c.src_queue(), c.dst_queue())
+        ]
+        return min(latencies) if latencies else 0
+
+    def report(self) -> str:
+        """
+        Summarise the partitions and the expected synchronisation cost:
+        one barrier per quantum, and one quantum of extra latency on
+        every timing crossing.
+        """
+        lines = []
+        queues = sorted(
+            set(self._partitions)
+            | {c.src_queue() for c in self._crossings}
+            | {c.dst_queue() for c in self._crossings}
+        )
+        for queue in queues:
+            objects = self._partitions.get(queue, [])
+            crossings = [
+                c
+                for c in self._crossings
+                if queue in (c.src_queue(), c.dst_queue())
+            ]
+            lines.append(
+                f"queue {queue}: {len(objects)} subtrees, "
+                f"{len(crossings)} crossings, "
+                f"lookahead {self.lookahead(queue)} ticks"
+            )
+
+        if self._quantum == 0:
+            lines.append("single event queue, no synchronisation")
+            return "\n".join(lines)
+
+        per_us = m5.ticks.fromSeconds(1e-6) / self._quantum
+        lines.append(
+            f"sim_quantum {self._quantum} ticks, "
+            f"{per_us:.2f} barriers per simulated microsecond"
+        )
+        for crossing in self._crossings:
+            lines.append(
+                f"  {crossing.requestor} -> {crossing.responder}: "
+                f"models {crossing.latency} ticks, "
+                f"{self._quantum} ticks added by the bridge"
+            )
+        return "\n".join(lines)
@@ -0,0 +1,244 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Evaluate a matrix of prefetchers, workloads and cache levels.
+
+Every point of the matrix is one simulation: a workload, a cache level
+(a list of caches, e.g. all L1D caches) and the prefetcher attached to
+each of those caches. The points run as children of a single configured
+simulator using :func:`gem5.utils.sweep.fork_sweep`, so they run in
+parallel across host cores and share configuration work. Each child
+instantiates its own variant, typically from the workload's post-boot
+checkpoint, so the boot is paid for once per workload.
+
+When every point has finished, the coverage, accuracy, timeliness and
+IPC of each point are collected into one table, written as
+``prefetch_matrix.txt`` and ``prefetch_matrix.json`` to the parent's
+output directory.
+
+Example:
+
+    prefetchers = {
+        "none": None,
+        "stride": StridePrefetcher,
+        "sms": SmsPrefetcher,
+        "stems": STeMSPrefetcher,
+    }
+    levels = {
+        "l1d": [core.l1d for core in caches.l1ds],
+        "l2": [caches.l2cache],
+    }
+
+    def instantiate(workload):
+        m5.instantiate(checkpoints[workload])
+
+    run_prefetch_matrix(
+        prefetchers, levels, instantiate, workloads=["mcf", "lbm"]
+    )
+"""
+
+import itertools
+import json
+import os
+import re
+from typing import (
+    Any,
+    Callable,
+    Dict,
+    Iterable,
+    List,
+    Optional,
+)
+
+import m5
+from m5.params import NULL
+from m5.util import inform, warn
+
+from .sweep import fork_sweep
+
+_STAT_RE = re.compile(r"^(\S+)\s+([-+0-9.eE]+|nan|inf)\b")
+_IPC_RE = re.compile(r"\.ipc$")
+_POINT_FILE = "prefetch_matrix_point.json"
+_COLUMNS = ("coverage", "accuracy", "timeliness", "ipc")
+
+
+def _parse_stats(path: str) -> Dict[str, float]:
+    """Return the last dump in a stats.txt file as a dict of floats."""
+    stats: Dict[str, float] = {}
+    with open(path) as f:
+        for line in f:
+            if line.startswith("---------- Begin"):
+                stats = {}
+            m = _STAT_RE.match(line)
+            if m:
+                stats[m.group(1)] = float(m.group(2))
+    return stats
+
+
+def _ratio(num: float, den: float) -> Optional[float]:
+    return num / den if den else None
+
+
+def _metrics(stats: Dict[str, float], caches: List[str]) -> Dict[str, Any]:
+    """
+    Summarise the prefetchers of one cache level.
+
+    Coverage and accuracy follow the definitions of the prefetcher's own
+    statistics, summed over the level's caches. Timeliness is the share of
+    useful prefetches that arrived before their first demand, counting the
+    demands that found their prefetch still in flight as late.
+    """
+
+    def total(stat: str) -> float:
+        return sum(stats.get(f"{c}.prefetcher.{stat}", 0.0) for c in caches)
+
+    issued = total("pfIssued")
+    useful = total("pfUseful")
+    late = total("pfLateDemand")
+    misses = total("demandMshrMisses")
+    ipcs = [v for k, v in stats.items() if _IPC_RE.search(k)]
+
+    return {
+        "issued": issued,
+        "coverage": _ratio(useful, useful + misses),
+        "accuracy": _ratio(useful, issued),
+        "timeliness": _ratio(useful, useful + late),
+        "ipc": sum(ipcs) / len(ipcs) if ipcs else None,
+    }
+
+
+def _default_run(workload: str) -> int:
+    return m5.simulate().getCode()
+
+
+def format_table(rows: Iterable[Dict[str, Any]]) -> str:
+    """Format the rows returned by run_prefetch_matrix as a text table."""
+    header = ("workload", "level", "prefetcher") + _COLUMNS
+    lines = [header]
+    for row in rows:
+        cells = [row["workload"], row["level"], row["prefetcher"]]
+        for col in _COLUMNS:
+            value = row.get(col)
+            cells.append("-" if value is None else f"{value:.4f}")
+        lines.append(tuple(cells))
+
+    widths = [max(len(line[i]) for line in lines) for i in range(len(header))]
+    return "\n".join(
+        "  ".join(cell.ljust(w) for cell, w in zip(line, widths)).rstrip()
+        for line in lines
+    )
+
+
+def run_prefetch_matrix(
+    prefetchers: Dict[str, Optional[Callable[[], Any]]],
+    levels: Dict[str, List[Any]],
+    instantiate: Callable[[str], None],
+    workloads: Iterable[str] = ("default",),
+    setup: Optional[Callable[[str], None]] = None,
+    run: Callable[[str], int] = _default_run,
+    jobs: Optional[int] = None,
+) -> List[Dict[str, Any]]:
+    """
+    Run every prefetcher, workload and cache level combination.
+
+    This must be called before the simulator is instantiated.
+
+    :param prefetchers: Prefetcher factories by name, e.g. a prefetcher
+        class. A factory of None runs the level without a prefetcher,
+        which is the reference for the IPC column.
+    :param levels: The caches making up each cache level, by name. Every
+        cache of a level gets its own prefetcher from the factory.
+    :param instantiate: Instantiates the simulator for a workload in the
+        child, e.g. from the workload's post-boot checkpoint.
+    :param workloads: The workload names.
+    :param setup: If given, configures a workload in the child before
+        instantiation.
+    :param run: Simulates a workload and returns its exit code. By default
+        the child simulates until the first exit event.
+    :param jobs: Number of simulations to run at a time, all host CPUs by
+        default.
+
+    :returns: One row per point with the point's workload, level and
+        prefetcher names and its metrics. Points that failed only have
+        their names and exit code.
+    """
+    points = list(itertools.product(workloads, levels, prefetchers))
+    parent = m5.options.outdir
+
+    # fork_sweep forks before instantiation; the workload of the point
+    # being applied is remembered for the instantiate callback.
+    current: List[str] = []
+
+    def apply(point) -> None:
+        workload, level, prefetcher = point
+        current[:] = [workload]
+        factory = prefetchers[prefetcher]
+        for cache in levels[level]:
+            cache.prefetcher = NULL if factory is None else factory()
+        if setup is not None:
+            setup(workload)
+
+    def child(point) -> int:
+        workload, level, _ = point
+        code = run(workload)
+        m5.stats.dump()
+        caches = [cache.path() for cache in levels[level]]
+        stats = _parse_stats(os.path.join(m5.options.outdir, "stats.txt"))
+        with open(os.path.join(m5.options.outdir, _POINT_FILE), "w") as f:
+            json.dump(_metrics(stats, caches), f)
+        return code
+
+    results = fork_sweep(
+        points,
+        apply,
+        run=child,
+        instantiate=lambda: instantiate(current[0]),
+        jobs=jobs,
+        outdir="%(parent)s/pfmatrix%(index)d",
+    )
+
+    rows = []
+    for index, (workload, level, prefetcher) in enumerate(points):
+        row: Dict[str, Any] = {
+            "workload": workload,
+            "level": level,
+            "prefetcher": prefetcher,
+            "exit_code": results.get(index),
+        }
+        path = os.path.join(parent, f"pfmatrix{index}", _POINT_FILE)
+        if os.path.isfile(path):
+            with open(path) as f:
+                row.update(json.load(f))
+        else:
+            warn(f"No results for {workload}/{level}/{prefetcher}")
+        rows.append(row)
+
+    table = format_table(rows)
+    with open(os.path.join(parent, "prefetch_matrix.txt"), "w") as f:
+        f.write(table + "\n")
+    with open(os.path.join(parent, "prefetch_matrix.json"), "w") as f:
+        json.dump(rows, f, indent=2)
+    inform(f"Prefetch matrix:\n{table}")
+
+    return rows
@@ -0,0 +1,143 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Run a parameter sweep from one configured simulator.
+
+Each point of the sweep runs in a child process forked from a parent
+that has already done the expensive setup, so Python configuration,
+SimObject creation, workload loading and checkpoint restore are paid
+for once. The children share the parent's memory, including simulated
+physical memory, copy-on-write.
+
+Parameters of C++ SimObjects are fixed once they are instantiated. A
+sweep over such parameters (cache sizes, replacement policies,
+prefetchers) therefore forks before instantiation and each child
+instantiates its own variant, which still saves the configuration
+work. A sweep over run-time state (switching CPUs, stats, work to run)
+can fork after instantiation and also share the restored state.
+
+Example:
+
+    def apply(size):
+        board.cache_hierarchy.l2cache.size = size
+
+    def instantiate():
+        m5.instantiate(checkpoint_dir)
+
+    results = fork_sweep(["256KiB", "1MiB"], apply, instantiate=instantiate)
+"""
+
+import os
+from typing import (
+    Any,
+    Callable,
+    Dict,
+    Iterable,
+    Optional,
+)
+
+import m5
+from m5.util import inform
+
+import _m5.core
+
+
+def _default_run(point: Any) -> int:
+    return m5.simulate().getCode()
+
+
+def _outdir(pattern: str, index: int) -> str:
+    return pattern % {"parent": m5.options.outdir, "index": index}
+
+
+def fork_sweep(
+    points: Iterable[Any],
+    apply: Callable[[Any], None],
+    run: Callable[[Any], int] = _default_run,
+    instantiate: Optional[Callable[[], None]] = None,
+    jobs: Optional[int] = None,
+    outdir: str = "%(parent)s/sweep%(index)d",
+) -> Dict[int, int]:
+    """
+    Run every point of a sweep in its own forked child.
+
+    :param points: The sweep points, passed to apply and run.
+    :param apply: Applies a point to the configuration in the child.
+    :param run: Simulates a point in the child and returns its exit
+        code. By default the child simulates until the first exit event.
+    :param instantiate: If given, the sweep forks before instantiation
+        and each child calls this after apply, e.g. to instantiate from
+        a checkpoint. Otherwise the simulator must already be
+        instantiated.
+    :param jobs: Number of children to run at a time, all host CPUs by
+        default.
+    :param outdir: Output directory of each child. "%(parent)s" is the
+        parent's output directory, "%(index)d" the point's index.
+
+    :returns: The exit code of each point's child, by point index.
+    """
+    jobs = jobs or os.cpu_count() or 1
+    running: Dict[int, int] = {}
+    results: Dict[int, int] = {}
+
+    def reap() -> None:
+        pid, status = os.wait()
+        index = running.pop(pid)
+        if os.WIFEXITED(status):
+            results[index] = os.WEXITSTATUS(status)
+        else:
+            results[index] = -os.WTERMSIG(status)
+        inform(f"Sweep point {index} finished with {results[index]}")
+
+    for index, point in enumerate(points):
+        while len(running) >= jobs:
+            reap()
+
+        path = _outdir(outdir, index)
+        if instantiate is None:
+            pid = m5.fork(path.replace("%", "%%"))
+        else:
+            pid = os.fork()
+
+        if pid == 0:
+            code = 1
+            try:
+                if instantiate is not None:
+                    os.makedirs(path, exist_ok=True)
+                    m5.options.outdir = path
+                    _m5.core.setOutputDir(path)
+                apply(point)
+                if instantiate is not None:
+                    instantiate()
+                code = run(point)
+            finally:
+                # Never return into the parent's sweep loop
+                os._exit(code)
+
+        running[pid] = index
+
+    while running:
+        reap()
+
+    return results
@@ -44,7 +44,9 @@ class ByteCodeLoader(importlib.abc.Loader):
 
 # Simple importer that allows python to import data from a dict of
 # code objects.  The keys are the module path, and the items are the
-# filename and bytecode of the file.
+# filename and bytecode of the file.  The bytecode may also be given as a
+# function which returns it, which is called when the module is first
+# imported.
 class CodeImporter:
     def __init__(self):
         self.modules = {}
@@ -66,6 +68,9 @@ class CodeImporter:
         if self.override and os.path.exists(abspath):
             src = open(abspath).read()
             code = compile(src, abspath, "exec")
+        elif callable(code):
+            code = code()
+            self.modules[fullname] = (abspath, code)
 
         is_package = os.path.basename(abspath) == "__init__.py"
         spec = importlib.util.spec_from_loader(
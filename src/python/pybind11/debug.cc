@@ -42,13 +42,17 @@
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
+#include <fstream>
 #include <map>
 #include <vector>
 
+#include "base/binary_trace.hh"
 #include "base/compiler.hh"
 #include "base/debug.hh"
+#include "base/logging.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
 
 namespace py = pybind11;
@@ -67,6 +71,24 @@ output(const char *filename)
     trace::setDebugLogger(new trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+binaryOutput(const char *filename)
+{
+    auto *logger = new trace::BinaryLogger(simout.resolve(filename));
+    trace::setDebugLogger(logger);
+    registerExitCallback([logger]() { logger->flush(); });
+}
+
+static bool
+decodeBinary(const char *in_name, const char *out_name)
+{
+    std::ifstream in(in_name, std::ios::binary);
+    fatal_if(!in, "Could not open %s for reading\n", in_name);
+    std::ofstream out(out_name);
+    fatal_if(!out, "Could not open %s for writing\n", out_name);
+    return trace::decodeBinaryTrace(in, out);
+}
+
 static void
 activate(const char *expr)
 {
@@ -94,6 +116,7 @@ pybind_init_debug(py::module_ &m_native)
         .def("allFlags", &debug::allFlags, py::return_value_policy::reference)
 
         .def("schedBreak", &schedBreak)
+        .def("schedTraceWindows", &schedTraceWindows)
         ;
 
     py::class_<debug::Flag> c_flag(m_debug, "Flag");
@@ -114,8 +137,12 @@ pybind_init_debug(py::module_ &m_native)
                           }
                       })
         .def("__bool__", [](const debug::Flag *flag) {
-                return (bool)*flag;
+                return flag->tracing();
             })
+        .def_property("sampleRate", &debug::Flag::sampleRate,
+                      &debug::Flag::setSampleRate)
+        .def("setAddrRange", &debug::Flag::setAddrRange)
+        .def("clearAddrRange", &debug::Flag::clearAddrRange)
         ;
 
     py::class_<debug::SimpleFlag>(m_debug, "SimpleFlag", c_flag)
@@ -129,6 +156,8 @@ pybind_init_debug(py::module_ &m_native)
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("binaryOutput", &binaryOutput)
+        .def("decodeBinary", &decodeBinary)
         .def("activate", &activate)
         .def("ignore", &ignore)
         .def("enable", &trace::enable)
@@ -44,6 +44,9 @@
 #include "pybind11/stl.h"
 
 #include "base/logging.hh"
+#include "base/output.hh"
+#include "sim/core.hh"
+#include "sim/event_profiler.hh"
 #include "sim/eventq.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
@@ -100,6 +103,30 @@ class PyEvent : public Event
     }
 };
 
+/**
+ * Profile the host time of events, and write the profile to
+ * eventprofile.folded and eventprofile.txt in the output directory when
+ * gem5 exits.
+ */
+static void
+profileEvents(unsigned period)
+{
+    static bool dumpAtExit = false;
+    if (!dumpAtExit) {
+        dumpAtExit = true;
+        registerExitCallback([]() {
+            OutputStream *folded = simout.create("eventprofile.folded");
+            EventProfiler::dumpFolded(*folded->stream());
+            simout.close(folded);
+
+            OutputStream *summary = simout.create("eventprofile.txt");
+            EventProfiler::dumpSummary(*summary->stream());
+            simout.close(summary);
+        });
+    }
+    EventProfiler::enable(period);
+}
+
 void
 pybind_init_event(py::module_ &m_native)
 {
@@ -112,6 +139,9 @@ pybind_init_event(py::module_ &m_native)
     m.def("terminateEventQueueThreads", &terminateEventQueueThreads);
     m.def("exitSimLoop", &exitSimLoop);
     m.def("exitSimulationLoop", &exitSimulationLoop);
+    m.def("profileEvents", &profileEvents, py::arg("period") = 100);
+    m.def("stopProfilingEvents", &EventProfiler::disable);
+    m.def("resetEventProfile", &EventProfiler::reset);
     m.def("getEventQueue", []() { return curEventQueue(); },
           py::return_value_policy::reference);
     m.def("setEventQueue", [](EventQueue *q) { return curEventQueue(q); });
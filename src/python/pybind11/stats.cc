@@ -38,10 +38,15 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/binary.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -50,6 +55,7 @@
 
 #endif
 #include "sim/stat_control.hh"
+#include "sim/stat_publisher.hh"
 #include "sim/stat_register.hh"
 
 namespace py = pybind11;
@@ -85,6 +91,147 @@ cast_stat_info(const statistics::Info *info)
 #undef TRY_CAST
 }
 
+/**
+ * Read only view of a vector of values, which Python can read through
+ * the buffer protocol without converting each value. The view is only
+ * valid until the values are next updated.
+ */
+static py::memoryview
+values_view(const statistics::VCounter &values)
+{
+    return py::memoryview::from_buffer(values.data(),
+        { (py::ssize_t)values.size() },
+        { (py::ssize_t)sizeof(statistics::Counter) });
+}
+
+/**
+ * The values of all the stats below a group, copied into one contiguous
+ * array of doubles. The layout is fixed when the snapshot is created, so
+ * a script can keep the buffer and the offsets and just call update()
+ * each time it wants new values.
+ *
+ * A scalar takes one value, a vector or formula one per element, a 2d
+ * vector x * y values, and a distribution its underflow, its buckets and
+ * its overflow. Sparse histograms are not included.
+ */
+class StatSnapshot
+{
+  public:
+    StatSnapshot(const statistics::Group &root)
+    {
+        add(root, "");
+        values.resize(numValues);
+        update();
+    }
+
+    /** Copy the current values of the stats into the buffer */
+    void
+    update()
+    {
+        for (const auto &entry : entries) {
+            entry.info->prepare();
+            copy(*entry.info, &values[entry.offset], entry.size);
+        }
+    }
+
+    const std::vector<std::string> &names() const { return _names; }
+
+    std::vector<size_t>
+    offsets() const
+    {
+        std::vector<size_t> offs;
+        for (const auto &entry : entries)
+            offs.push_back(entry.offset);
+        return offs;
+    }
+
+    std::vector<size_t>
+    sizes() const
+    {
+        std::vector<size_t> szs;
+        for (const auto &entry : entries)
+            szs.push_back(entry.size);
+        return szs;
+    }
+
+    py::buffer_info
+    buffer()
+    {
+        return py::buffer_info(values.data(), sizeof(double),
+            py::format_descriptor<double>::format(), 1,
+            { (py::ssize_t)values.size() }, { (py::ssize_t)sizeof(double) },
+            true);
+    }
+
+  private:
+    struct Entry
+    {
+        statistics::Info *info;
+        size_t offset;
+        size_t size;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<std::string> _names;
+    std::vector<double> values;
+    size_t numValues = 0;
+
+    void
+    add(const statistics::Group &group, const std::string &prefix)
+    {
+        for (auto *info : group.getStats()) {
+            info->prepare();
+            size_t size = count(*info);
+            if (size == 0)
+                continue;
+            entries.push_back({ info, numValues, size });
+            _names.push_back(prefix + info->name);
+            numValues += size;
+        }
+
+        for (const auto &sub : group.getStatGroups())
+            add(*sub.second, prefix + sub.first + ".");
+    }
+
+    static size_t
+    count(const statistics::Info &info)
+    {
+        if (dynamic_cast<const statistics::ScalarInfo *>(&info))
+            return 1;
+        if (auto vec = dynamic_cast<const statistics::VectorInfo *>(&info))
+            return vec->size();
+        if (auto vec = dynamic_cast<const statistics::Vector2dInfo *>(&info))
+            return vec->x * vec->y;
+        if (auto dist = dynamic_cast<const statistics::DistInfo *>(&info))
+            return dist->data.cvec.size() + 2;
+        return 0;
+    }
+
+    static void
+    copy(const statistics::Info &info, double *dst, size_t size)
+    {
+        if (auto scalar =
+                dynamic_cast<const statistics::ScalarInfo *>(&info)) {
+            dst[0] = scalar->result();
+        } else if (auto vec =
+                dynamic_cast<const statistics::VectorInfo *>(&info)) {
+            const statistics::VResult &result = vec->result();
+            std::copy_n(result.begin(), std::min(size, result.size()), dst);
+        } else if (auto vec =
+                dynamic_cast<const statistics::Vector2dInfo *>(&info)) {
+            const statistics::VCounter &cvec = vec->cvec;
+            std::copy_n(cvec.begin(), std::min(size, cvec.size()), dst);
+        } else if (auto dist =
+                dynamic_cast<const statistics::DistInfo *>(&info)) {
+            const statistics::DistData &data = dist->data;
+            size_t buckets = std::min(size - 2, data.cvec.size());
+            dst[0] = data.underflow;
+            std::copy_n(data.cvec.begin(), buckets, dst + 1);
+            dst[size - 1] = data.overflow;
+        }
+    }
+};
+
 namespace statistics
 {
 
@@ -113,6 +260,8 @@ pybind_init_stats(py::module_ &m_native)
         .def("initSimStats", &statistics::initSimStats)
         .def("initText", &statistics::initText,
             py::return_value_policy::reference)
+        .def("initBinary", &statistics::initBinary,
+            py::return_value_policy::reference)
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
@@ -120,6 +269,10 @@ pybind_init_stats(py::module_ &m_native)
              &statistics::registerPythonStatsHandlers)
         .def("schedStatEvent", &statistics::schedStatEvent)
         .def("periodicStatDump", &statistics::periodicStatDump)
+        .def("startPublishing", &statistics::startPublishing,
+             py::arg("config"), py::arg("period"),
+             py::arg("patterns") = std::vector<std::string>())
+        .def("stopPublishing", &statistics::stopPublishing)
         .def("updateEvents", &statistics::updateEvents)
         .def("processResetQueue", &statistics::processResetQueue)
         .def("processDumpQueue", &statistics::processDumpQueue)
@@ -134,6 +287,9 @@ pybind_init_stats(py::module_ &m_native)
         .def("valid", &statistics::Output::valid)
         .def("beginGroup", &statistics::Output::beginGroup)
         .def("endGroup", &statistics::Output::endGroup)
+        .def("setFilter", &statistics::Output::setFilter)
+        .def("filtered", &statistics::Output::filtered)
+        .def("selected", &statistics::Output::selected)
         ;
 
     py::class_<statistics::Info,
@@ -183,6 +339,10 @@ pybind_init_stats(py::module_ &m_native)
             [](const statistics::VectorInfo &info) { return info.result(); })
         .def_property_readonly("total",
             [](const statistics::VectorInfo &info) { return info.total(); })
+        .def_property_readonly("values_view",
+            [](const statistics::VectorInfo &info) {
+                return values_view(info.value());
+            })
         ;
 
     py::class_<statistics::Vector2dInfo, statistics::Info,
@@ -194,6 +354,10 @@ pybind_init_stats(py::module_ &m_native)
         .def_readonly("subdescs", &statistics::Vector2dInfo::subdescs)
         .def_readonly("ysubnames", &statistics::Vector2dInfo::y_subnames)
         .def_readonly("value", &statistics::Vector2dInfo::cvec)
+        .def_property_readonly("values_view",
+            [](const statistics::Vector2dInfo &info) {
+                return values_view(info.cvec);
+            })
         ;
 
     py::class_<statistics::SparseHistInfo, statistics::Info,
@@ -225,6 +389,10 @@ pybind_init_stats(py::module_ &m_native)
             })
         .def_property_readonly("values",
             [](const statistics::DistInfo &info) { return info.data.cvec; })
+        .def_property_readonly("values_view",
+            [](const statistics::DistInfo &info) {
+                return values_view(info.data.cvec);
+            })
         .def_property_readonly("overflow",
             [](const statistics::DistInfo &info) {
                 return info.data.overflow;
@@ -268,6 +436,15 @@ pybind_init_stats(py::module_ &m_native)
                  return cast_stat_info(stat);
              })
         ;
+
+    py::class_<StatSnapshot>(m, "Snapshot", py::buffer_protocol())
+        .def(py::init<const statistics::Group &>())
+        .def("update", &StatSnapshot::update)
+        .def_property_readonly("names", &StatSnapshot::names)
+        .def_property_readonly("offsets", &StatSnapshot::offsets)
+        .def_property_readonly("sizes", &StatSnapshot::sizes)
+        .def_buffer(&StatSnapshot::buffer)
+        ;
 }
 
 } // namespace gem5
@@ -67,6 +67,49 @@ class Root(SimObject):
     # Simulation Quantum for multiple main event queue simulation.
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
+    # Let the quantum adapt to the traffic between the event queues. It
+    # shrinks when many events cross queues, as each of them is delayed
+    # to the next quantum, and grows when few do, to synchronize less
+    # often. It never grows beyond the latency declared by the links
+    # between the queues (ThreadBridge, garnet links). Other crossings,
+    # such as Ruby message buffers, need max_sim_quantum to be set.
+    adaptive_quantum = Param.Bool(
+        False, "adapt sim_quantum to the traffic between event queues"
+    )
+    min_sim_quantum = Param.Tick(
+        0, "smallest adaptive quantum (0: sim_quantum / 16)"
+    )
+    max_sim_quantum = Param.Tick(
+        0,
+        "largest adaptive quantum (0: the shortest link latency, or "
+        "sim_quantum without links)",
+    )
+    quantum_crossings = Param.UInt64(
+        16, "events crossing event queues per quantum to adapt towards"
+    )
+    # Number of host threads running the event queues. When smaller than
+    # the number of event queues, the queues are scheduled on a
+    # work-stealing thread pool instead of one thread per queue.
+    sim_threads = Param.UInt32(
+        0, "host threads for the event queues (0: one per queue)"
+    )
+    # Pinning the simulator threads keeps each one next to the memory it
+    # uses on hosts with several NUMA nodes, see
+    # AbstractMemory.host_numa_node.
+    sim_thread_cpus = VectorParam.Int(
+        [], "host CPUs to pin the simulator threads to (empty: no pinning)"
+    )
+    # Keep scheduled events in a calendar queue instead of a sorted
+    # list. Scales better with many pending events, same event order.
+    calendar_event_queue = Param.Bool(
+        False, "use calendar queues to store scheduled events"
+    )
+
+    # Periodically print the simulation throughput, overall and per
+    # event queue, to tune sim_quantum and the event queue partitioning.
+    progress_period = Param.Tick(
+        0, "ticks between simulation throughput reports (0: never)"
+    )
 
     full_system = Param.Bool("if this is a full system simulation")
 
@@ -113,6 +113,43 @@ class System(SimObject):
         "shared_backstore is non-empty.",
     )
 
+    # Checkpoints of large memories take long to write and restore with
+    # gzip. The chunked format compresses chunks in parallel, skips zero
+    # chunks and can store the memory as a delta against a base checkpoint.
+    chunked_memory_checkpoint = Param.Bool(
+        False, "Checkpoint physical memory in the chunked image format"
+    )
+    memory_checkpoint_base = Param.String(
+        "",
+        "Checkpoint directory whose physical memory images new checkpoints "
+        "are stored as deltas against (needs chunked_memory_checkpoint)",
+    )
+    mmap_memory_checkpoint = Param.Bool(
+        False,
+        "Checkpoint physical memory uncompressed so that restores map it "
+        "copy-on-write, sharing unmodified pages between processes",
+    )
+    memory_checkpoint_threads = Param.Unsigned(
+        0,
+        "Threads compressing and decompressing chunked memory images "
+        "(0 uses all host cores)",
+    )
+
+    # Simulated systems with large memories spend a long time faulting in
+    # host pages, and in host TLB misses on them.
+    mmap_populate = Param.Bool(
+        False,
+        "Fault in the whole backing store, in parallel, when creating it",
+    )
+    mmap_huge_pages = Param.Bool(
+        False, "Ask the host for transparent huge pages for the backing store"
+    )
+    mmap_huge_page_size = Param.MemorySize(
+        "0",
+        "Back the backing store with explicit huge pages of this size, "
+        "e.g. 2MiB or 1GiB, reserved on the host (0: don't)",
+    )
+
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
     redirect_paths = VectorParam.RedirectPath([], "Path redirections")
@@ -142,6 +179,9 @@ class System(SimObject):
     work_cpus_ckpt_count = Param.Counter(
         0, "create checkpoint when active cpu count value is reached"
     )
+    work_mark_buffer_size = Param.Unsigned(
+        65536, "number of work marks buffered before writing them out"
+    )
 
     workload = Param.Workload(StubWorkload(), "Workload to run on this system")
     init_param = Param.UInt64(0, "numerical value to pass into simulator")
@@ -0,0 +1,313 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/calendar_queue.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/logging.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+bool
+binLess(const Event *l, const Event *r)
+{
+    return *l < *r;
+}
+
+} // anonymous namespace
+
+CalendarQueue::CalendarQueue()
+    : buckets(MinBuckets, nullptr), mask(MinBuckets - 1), width(1),
+      numBins(0), _head(nullptr), directSearches(0)
+{
+}
+
+bool
+CalendarQueue::insertInBucket(Event *event)
+{
+    Event *&top = buckets[bucket(event->when())];
+    if (!top || *event <= *top) {
+        top = Event::insertBefore(event, top);
+    } else {
+        Event *prev = top;
+        Event *curr = top->nextBin;
+        while (curr && *curr < *event) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
+        prev->nextBin = Event::insertBefore(event, curr);
+    }
+
+    // insertBefore() pushes the event on an existing bin, or starts a
+    // new bin with no other events in it
+    return !event->nextInBin;
+}
+
+void
+CalendarQueue::insertBin(Event *bin)
+{
+    Event *&top = buckets[bucket(bin->when())];
+    if (!top || *bin < *top) {
+        bin->nextBin = top;
+        top = bin;
+        return;
+    }
+
+    Event *prev = top;
+    while (prev->nextBin && *prev->nextBin < *bin)
+        prev = prev->nextBin;
+    bin->nextBin = prev->nextBin;
+    prev->nextBin = bin;
+}
+
+Event *
+CalendarQueue::insert(Event *event)
+{
+    if (insertInBucket(event))
+        numBins++;
+
+    if (!_head || *event <= *_head)
+        _head = event;
+
+    maybeResize();
+    return _head;
+}
+
+Event *
+CalendarQueue::remove(Event *event)
+{
+    Event *&top = buckets[bucket(event->when())];
+    if (!top)
+        panic("event not found!");
+
+    Event *bin;
+    if (*top == *event) {
+        bin = top;
+        top = Event::removeItem(event, top);
+    } else {
+        Event *prev = top;
+        Event *curr = top->nextBin;
+        while (curr && *curr < *event) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
+
+        if (!curr || *curr != *event)
+            panic("event not found!");
+
+        bin = curr;
+        prev->nextBin = Event::removeItem(event, curr);
+    }
+
+    const bool removed_bin = bin == event && !event->nextInBin;
+    if (removed_bin)
+        numBins--;
+
+    if (event == _head) {
+        _head = removed_bin ? findHead(event->when()) : event->nextInBin;
+    }
+
+    maybeResize();
+    return _head;
+}
+
+Event *
+CalendarQueue::pop()
+{
+    assert(_head);
+
+    Event *event = _head;
+    Event *&top = buckets[bucket(event->when())];
+    assert(top == event);
+
+    Event *next = event->nextInBin;
+    if (next) {
+        // update the next bin pointer since it could be stale
+        next->nextBin = event->nextBin;
+        top = next;
+        _head = next;
+    } else {
+        top = event->nextBin;
+        numBins--;
+        _head = findHead(event->when());
+        maybeResize();
+    }
+
+    return _head;
+}
+
+Event *
+CalendarQueue::findHead(Tick from)
+{
+    if (!numBins)
+        return nullptr;
+
+    // Scan one year worth of buckets, starting with the bucket of
+    // 'from', for a bin that belongs to the current year. The end of
+    // the bucket window saturates at MaxTick; no bin can be scheduled
+    // a year after such a window, so any bin in the bucket is then in
+    // the current year.
+    size_t idx = bucket(from);
+    Tick window_end = from - from % width;
+    for (size_t n = 0; n < buckets.size(); n++, idx = (idx + 1) & mask) {
+        window_end = window_end > MaxTick - width ?
+            MaxTick : window_end + width;
+        Event *bin = buckets[idx];
+        if (bin && (bin->when() < window_end || window_end == MaxTick))
+            return bin;
+    }
+
+    // Nothing scheduled within a year, fall back to a direct search
+    // of the earliest bin in any bucket.
+    directSearches++;
+    Event *earliest = nullptr;
+    for (Event *bin : buckets) {
+        if (bin && (!earliest || *bin < *earliest))
+            earliest = bin;
+    }
+    return earliest;
+}
+
+void
+CalendarQueue::maybeResize()
+{
+    if (numBins > 2 * buckets.size())
+        resize(2 * buckets.size());
+    else if (numBins < buckets.size() / 2 && buckets.size() > MinBuckets)
+        resize(buckets.size() / 2);
+    else if (directSearches > buckets.size())
+        resize(buckets.size());
+}
+
+Tick
+CalendarQueue::computeWidth(std::vector<Event *> &bins)
+{
+    const size_t samples = std::min(bins.size(), WidthSamples);
+    if (samples < 2)
+        return 1;
+
+    std::partial_sort(bins.begin(), bins.begin() + samples, bins.end(),
+                      binLess);
+
+    // Average separation between consecutive bins, recomputed without
+    // the separations that are more than twice the average so that a
+    // few far away events (e.g., the simulation limit) don't inflate
+    // the width.
+    const Tick span = bins[samples - 1]->when() - bins[0]->when();
+    const Tick average = span / (samples - 1);
+    Tick sum = 0;
+    size_t count = 0;
+    for (size_t i = 1; i < samples; i++) {
+        const Tick sep = bins[i]->when() - bins[i - 1]->when();
+        if (sep <= 2 * average) {
+            sum += sep;
+            count++;
+        }
+    }
+
+    const Tick separation = count ? sum / count : average;
+    if (separation > MaxTick / 12)
+        return MaxTick / 4;
+    return std::max<Tick>(1, 3 * separation);
+}
+
+void
+CalendarQueue::resize(size_t num_buckets)
+{
+    std::vector<Event *> all_bins;
+    all_bins.reserve(numBins);
+    for (Event *bin : buckets) {
+        for (; bin; bin = bin->nextBin)
+            all_bins.push_back(bin);
+    }
+    assert(all_bins.size() == numBins);
+
+    width = computeWidth(all_bins);
+    directSearches = 0;
+    buckets.assign(num_buckets, nullptr);
+    mask = num_buckets - 1;
+
+    // The samples are sorted, inserting them from last to first puts
+    // each of them at the front of its bucket.
+    for (auto it = all_bins.rbegin(); it != all_bins.rend(); ++it)
+        insertBin(*it);
+}
+
+std::vector<Event *>
+CalendarQueue::bins() const
+{
+    std::vector<Event *> all_bins;
+    all_bins.reserve(numBins);
+    for (Event *bin : buckets) {
+        for (; bin; bin = bin->nextBin)
+            all_bins.push_back(bin);
+    }
+    std::sort(all_bins.begin(), all_bins.end(), binLess);
+    return all_bins;
+}
+
+Event *
+CalendarQueue::release()
+{
+    std::vector<Event *> all_bins = bins();
+    for (size_t i = 0; i + 1 < all_bins.size(); i++)
+        all_bins[i]->nextBin = all_bins[i + 1];
+    if (!all_bins.empty())
+        all_bins.back()->nextBin = nullptr;
+
+    buckets.assign(MinBuckets, nullptr);
+    mask = MinBuckets - 1;
+    width = 1;
+    numBins = 0;
+    _head = nullptr;
+    directSearches = 0;
+
+    return all_bins.empty() ? nullptr : all_bins.front();
+}
+
+Event *
+CalendarQueue::adopt(Event *list)
+{
+    while (list) {
+        Event *next = list->nextBin;
+        insertBin(list);
+        numBins++;
+        if (!_head || *list < *_head)
+            _head = list;
+        maybeResize();
+        list = next;
+    }
+
+    return _head;
+}
+
+} // namespace gem5
@@ -0,0 +1,159 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_CALENDAR_QUEUE_HH__
+#define __SIM_CALENDAR_QUEUE_HH__
+
+#include <cstddef>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+class Event;
+
+/**
+ * Calendar queue (R. Brown, "Calendar Queues: A Fast O(1) Priority
+ * Queue Implementation for the Simulation Event Set Problem", CACM
+ * 1988) of event bins.
+ *
+ * A bin is the stack of all events that have the same when() and
+ * priority(), exactly as in the sorted bin list used by default by
+ * EventQueue. Instead of keeping all bins in a single sorted list, the
+ * bins are hashed by when() into an array of buckets that each cover
+ * 'width' ticks of a 'year' of numBuckets * width ticks. Each bucket
+ * is a short list of bins sorted by when() and priority(), linked
+ * through Event::nextBin. When the number of bins grows too large or
+ * too small compared to the number of buckets, the bucket array is
+ * resized and the bucket width recomputed from the spacing of the
+ * earliest bins, so that inserting, removing and finding the next bin
+ * are O(1) amortized.
+ *
+ * The ordering of the events is identical to that of the bin list:
+ * events are ordered by when() and priority(), and events with the
+ * same when() and priority() are serviced in LIFO order.
+ */
+class CalendarQueue
+{
+  public:
+    CalendarQueue();
+
+    /**
+     * Insert an event in the calendar.
+     *
+     * @return The event at the head of the calendar.
+     */
+    Event *insert(Event *event);
+
+    /**
+     * Remove an event from the calendar.
+     *
+     * @return The event at the head of the calendar.
+     */
+    Event *remove(Event *event);
+
+    /**
+     * Remove the event at the head of the calendar.
+     *
+     * @return The new event at the head of the calendar.
+     */
+    Event *pop();
+
+    /** Event at the head of the calendar (nullptr if empty). */
+    Event *head() const { return _head; }
+
+    /** Number of bins in the calendar. */
+    size_t size() const { return numBins; }
+
+    /**
+     * Move all the bins of the calendar to a sorted bin list, leaving
+     * the calendar empty.
+     *
+     * @return The head of the bin list.
+     */
+    Event *release();
+
+    /**
+     * Insert all the bins of a sorted bin list in the calendar.
+     *
+     * @return The event at the head of the calendar.
+     */
+    Event *adopt(Event *list);
+
+    /** All bins of the calendar, sorted. */
+    std::vector<Event *> bins() const;
+
+  private:
+    /** Lower bound on the number of buckets. */
+    static constexpr size_t MinBuckets = 16;
+
+    /** Number of bins sampled to recompute the bucket width. */
+    static constexpr size_t WidthSamples = 32;
+
+    size_t bucket(Tick when) const { return (when / width) & mask; }
+
+    /**
+     * Insert an event in its bucket.
+     *
+     * @return true if a new bin was created for this event.
+     */
+    bool insertInBucket(Event *event);
+
+    /** Insert a whole bin, which must not exist yet, in its bucket. */
+    void insertBin(Event *bin);
+
+    /**
+     * Find the earliest bin, assuming that no bin is scheduled
+     * before from.
+     */
+    Event *findHead(Tick from);
+
+    /**
+     * Resize the bucket array after numBins changed, or recompute the
+     * bucket width if it frequently failed to find the next bin
+     * within a year.
+     */
+    void maybeResize();
+
+    /** Compute a bucket width from the spacing of the earliest bins. */
+    static Tick computeWidth(std::vector<Event *> &bins);
+
+    void resize(size_t num_buckets);
+
+    std::vector<Event *> buckets;
+    size_t mask;
+    Tick width;
+    size_t numBins;
+    Event *_head;
+
+    /** Number of direct searches since the width was last computed. */
+    size_t directSearches;
+};
+
+} // namespace gem5
+
+#endif // __SIM_CALENDAR_QUEUE_HH__
@@ -41,6 +41,7 @@
 #include <algorithm>
 #include <functional>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/ClockDomain.hh"
@@ -67,10 +68,48 @@ ClockDomain::ClockDomain(const Params &p, VoltageDomain *voltage_domain)
     : SimObject(p),
       _clockPeriod(0),
       _voltageDomain(voltage_domain),
+      _periodVersion(0),
       stats(*this)
 {
 }
 
+void
+ClockDomain::setClockPeriod(Tick clock_period)
+{
+    if (periodChanges.size() == maxPeriodChanges) {
+        // Align all members to the current tick so that the history
+        // can be dropped
+        for (auto m = members.begin(); m != members.end(); ++m) {
+            (*m)->updateClockPeriod();
+        }
+        periodChanges.clear();
+    } else {
+        for (auto l = listeners.begin(); l != listeners.end(); ++l) {
+            (*l)->updateClockPeriod();
+        }
+    }
+
+    periodChanges.push_back({curTick(), _clockPeriod});
+    _periodVersion++;
+    _clockPeriod = clock_period;
+}
+
+void
+ClockDomain::alignMember(Tick &tick, Cycles &cycle, uint64_t &version) const
+{
+    uint64_t first = _periodVersion - periodChanges.size();
+    assert(version >= first);
+
+    for (; version < _periodVersion; version++) {
+        const PeriodChange &change = periodChanges[version - first];
+        if (tick < change.when) {
+            Cycles elapsed(divCeil(change.when - tick, change.period));
+            cycle += elapsed;
+            tick += elapsed * change.period;
+        }
+    }
+}
+
 double
 ClockDomain::voltage() const
 {
@@ -118,12 +157,7 @@ SrcClockDomain::clockPeriod(Tick clock_period)
         fatal("%s has a clock period of zero\n", name());
     }
 
-    // Align all members to the current tick
-    for (auto m = members.begin(); m != members.end(); ++m) {
-        (*m)->updateClockPeriod();
-    }
-
-    _clockPeriod = clock_period;
+    setClockPeriod(clock_period);
 
     DPRINTF(ClockDomain,
             "Setting clock period to %d ticks for source clock %s\n",
@@ -208,14 +242,9 @@ DerivedClockDomain::DerivedClockDomain(const Params &p) :
 void
 DerivedClockDomain::updateClockPeriod()
 {
-    // Align all members to the current tick
-    for (auto m = members.begin(); m != members.end(); ++m) {
-        (*m)->updateClockPeriod();
-    }
-
     // recalculate the clock period, relying on the fact that changes
     // propagate downwards in the tree
-    _clockPeriod = parent.clockPeriod() * clockDivider;
+    setClockPeriod(parent.clockPeriod() * clockDivider);
 
     DPRINTF(ClockDomain,
             "Setting clock period to %d ticks for derived clock %s\n",
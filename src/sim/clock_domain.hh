@@ -45,6 +45,7 @@
 #define __SIM_CLOCK_DOMAIN_HH__
 
 #include <algorithm>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "params/ClockDomain.hh"
@@ -95,6 +96,21 @@ class ClockDomain : public SimObject
      */
     std::vector<Clocked *> members;
 
+    /**
+     * Members that are told about clock period changes as they happen,
+     * rather than catching up the next time they use their clock.
+     */
+    std::vector<Clocked *> listeners;
+
+    /**
+     * Change the clock period at the current tick. Members align their
+     * next clock edge lazily, using the history of period changes, so
+     * the cost of a change does not grow with the number of members.
+     *
+     * @param clock_period New clock period in ticks
+     */
+    void setClockPeriod(Tick clock_period);
+
   public:
 
     typedef ClockDomainParams Params;
@@ -119,6 +135,32 @@ class ClockDomain : public SimObject
         members.push_back(c);
     }
 
+    /**
+     * Register a member that must be notified of every clock period
+     * change as it happens.
+     *
+     * @param Clocked member to notify
+     */
+    void registerClockPeriodListener(Clocked *c) { listeners.push_back(c); }
+
+    /**
+     * Get the number of clock period changes so far. Members compare it
+     * with the version they last aligned to.
+     *
+     * @return Version of the clock period
+     */
+    uint64_t periodVersion() const { return _periodVersion; }
+
+    /**
+     * Align the clock edge of a member with all the period changes it
+     * has not seen yet, as if it had been updated at each of them.
+     *
+     * @param tick Next clock edge of the member
+     * @param cycle Cycle count of the member at that edge
+     * @param version Period version the member is aligned to
+     */
+    void alignMember(Tick &tick, Cycles &cycle, uint64_t &version) const;
+
     /**
      * Get the voltage domain.
      *
@@ -143,6 +185,24 @@ class ClockDomain : public SimObject
     { children.push_back(clock_domain); }
 
   private:
+    /** A change of the clock period, and the period before it */
+    struct PeriodChange
+    {
+        Tick when;
+        Tick period;
+    };
+
+    /**
+     * Period changes not yet seen by every member. When the history
+     * grows to maxPeriodChanges, all members are aligned and it is
+     * dropped.
+     */
+    std::vector<PeriodChange> periodChanges;
+    static constexpr size_t maxPeriodChanges = 256;
+
+    /** Number of clock period changes since the domain was created */
+    uint64_t _periodVersion;
+
     struct ClockDomainStats : public statistics::Group
     {
         ClockDomainStats(ClockDomain &cd);
@@ -71,6 +71,10 @@ class Clocked
     // 'tick'
     mutable Cycles cycle;
 
+    // The version of the clock domain period that 'tick' and 'cycle'
+    // account for
+    mutable uint64_t periodVersion;
+
     /**
      *  Align cycle and tick to the next clock edge if not already done. When
      *  complete, tick must be at least curTick().
@@ -78,6 +82,10 @@ class Clocked
     void
     update() const
     {
+        // catch up with any clock period changes since the last update
+        if (periodVersion != clockDomain.periodVersion())
+            clockDomain.alignMember(tick, cycle, periodVersion);
+
         // both tick and cycle are up-to-date and we are done, note
         // that the >= is important as it captures cases where tick
         // has already passed curTick()
@@ -113,7 +121,8 @@ class Clocked
      * parameters.
      */
     Clocked(ClockDomain &clk_domain)
-        : tick(0), cycle(0), clockDomain(clk_domain)
+        : tick(0), cycle(0), periodVersion(clk_domain.periodVersion()),
+          clockDomain(clk_domain)
     {
         // Register with the clock domain, so that if the clock domain
         // frequency changes, we can update this object's tick.
@@ -139,11 +148,24 @@ class Clocked
         Cycles elapsedCycles(divCeil(curTick(), clockPeriod()));
         cycle = elapsedCycles;
         tick = elapsedCycles * clockPeriod();
+        periodVersion = clockDomain.periodVersion();
+    }
+
+    /**
+     * Ask to have clockPeriodUpdated() called as soon as the period of
+     * the clock domain changes. Other objects only align their clock
+     * the next time they use it.
+     */
+    void
+    watchClockPeriod()
+    {
+        clockDomain.registerClockPeriodListener(this);
     }
 
     /**
      * A hook subclasses can implement so they can do any extra work that's
-     * needed when the clock rate is changed.
+     * needed when the clock rate is changed. It is called on every change
+     * only for objects that called watchClockPeriod().
      */
     virtual void clockPeriodUpdated() {}
 
@@ -648,6 +648,14 @@ CxxConfigManager::forEachObject(void (SimObject::*mem_func)())
         ((*i)->*mem_func)();
 }
 
+void
+CxxConfigManager::forEachObjectInParallel(void (SimObject::*mem_func)())
+{
+    std::vector<SimObject *> objects(objectsInOrder.begin(),
+        objectsInOrder.end());
+    SimObject::forEachInParallel(objects, mem_func, initThreads);
+}
+
 void
 CxxConfigManager::instantiate(bool build_all)
 {
@@ -657,7 +665,7 @@ CxxConfigManager::instantiate(bool build_all)
     }
 
     DPRINTF(CxxConfig, "Initialising all objects\n");
-    forEachObject(&SimObject::init);
+    forEachObjectInParallel(&SimObject::init);
 
     DPRINTF(CxxConfig, "Registering stats\n");
     forEachObject(&SimObject::regStats);
@@ -673,14 +681,14 @@ void
 CxxConfigManager::initState()
 {
     DPRINTF(CxxConfig, "Calling initState on all objects\n");
-    forEachObject(&SimObject::initState);
+    forEachObjectInParallel(&SimObject::initState);
 }
 
 void
 CxxConfigManager::startup()
 {
     DPRINTF(CxxConfig, "Starting up all objects\n");
-    forEachObject(&SimObject::startup);
+    forEachObjectInParallel(&SimObject::startup);
 }
 
 unsigned int
@@ -120,6 +120,10 @@ class CxxConfigManager
     /** SimObjects in order.  This is populated by findAllObjects */
     std::list<SimObject *> objectsInOrder;
 
+    /** Number of threads to call init, initState and startup on for the
+     *  objects which are parallelInitSafe */
+    unsigned int initThreads = 1;
+
   protected:
     /** While configuring, inVisit contains names of SimObjects visited in
      *  this recursive configuration walk */
@@ -265,6 +269,10 @@ class CxxConfigManager
     /** Perform mem_func on each SimObject */
     void forEachObject(void (SimObject::*mem_func)());
 
+    /** Perform an initialization phase on each SimObject, using up to
+     *  initThreads threads.  See SimObject::forEachInParallel */
+    void forEachObjectInParallel(void (SimObject::*mem_func)());
+
     /** Find all objects by iterating over the object names in the config
      *  file with findObject.  Also populate the traversal order */
     void findAllObjects();
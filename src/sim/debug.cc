@@ -28,10 +28,12 @@
 
 #include "sim/debug.hh"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
 #include "base/debug.hh"
+#include "base/trace.hh"
 #include "cpu/pc_event.hh"
 #include "sim/eventq.hh"
 #include "sim/global_event.hh"
@@ -95,6 +97,52 @@ schedRelBreak(Tick delta)
     schedBreak(curTick() + delta);
 }
 
+//
+// Trace window event: enables tracing at the start of every window and
+// disables it again at the end
+//
+class TraceWindowEvent : public Event
+{
+  private:
+    const Tick length;
+    const Tick period;
+    bool open = false;
+
+  public:
+    TraceWindowEvent(Tick _length, Tick _period)
+        : Event(Debug_Enable_Pri, AutoDelete),
+          length(_length), period(_period)
+    {}
+
+    void
+    process() override
+    {
+        if (!open) {
+            trace::enable();
+            open = true;
+            mainEventQueue[0]->schedule(this, curTick() + length);
+        } else {
+            trace::disable();
+            open = false;
+            if (period)
+                mainEventQueue[0]->schedule(this, when() - length + period);
+        }
+    }
+
+    const char *description() const override { return "trace window"; }
+};
+
+void
+schedTraceWindows(Tick start, Tick length, Tick period)
+{
+    fatal_if(!length, "Trace windows must not be empty.");
+    fatal_if(period && period < length,
+             "Trace windows of %d ticks don't fit a period of %d ticks.",
+             length, period);
+    mainEventQueue[0]->schedule(new TraceWindowEvent(length, period),
+                                std::max(start, curTick()));
+}
+
 ///
 /// Function to cause the simulator to take a checkpoint from the debugger
 ///
@@ -51,6 +51,15 @@ void schedBreak(Tick when);
  */
 void schedRelBreak(Tick delta);
 
+/**
+ * Trace only in windows of ticks, which repeat every period. This is
+ * a periodic version of --debug-start and --debug-end.
+ * @param start the tick the first window opens
+ * @param length the number of ticks each window stays open
+ * @param period the ticks between window starts, 0 for one window
+ */
+void schedTraceWindows(Tick start, Tick length, Tick period);
+
 /** Cause the simulator to return to python to create a checkpoint
  * @param when the cycle to break
  */
@@ -69,16 +69,39 @@ DrainManager::tryDrain()
     panic_if(_count != 0,
              "Drain counter must be zero at the start of a drain cycle\n");
 
-    DPRINTF(Drain, "Trying to drain %u objects.\n", drainableCount());
-    _state = DrainState::Draining;
-    for (auto *obj : _allDrainable) {
-        DrainState status = obj->dmDrain();
-        if (debug::Drain && status != DrainState::Drained) {
-            Named *temp = dynamic_cast<Named*>(obj);
-            if (temp)
-                DPRINTF(Drain, "Failed to drain %s\n", temp->name());
+    ++_pass;
+    if (_state != DrainState::Draining) {
+        // The first pass of a drain cycle goes over all the objects.
+        DPRINTF(Drain, "Trying to drain %u objects.\n", drainableCount());
+        _state = DrainState::Draining;
+
+        {
+            std::lock_guard<std::mutex> lock(globalLock);
+            _disturbed.clear();
+        }
+        _polled.clear();
+        for (auto *obj : _allDrainable) {
+            if (drainObject(obj))
+                _polled.push_back(obj);
+        }
+    } else {
+        // Later passes only go over the objects that may not be drained,
+        // as the others would have told us if they had been disturbed.
+        std::vector<Drainable *> disturbed;
+        {
+            std::lock_guard<std::mutex> lock(globalLock);
+            disturbed.swap(_disturbed);
+        }
+        DPRINTF(Drain, "Trying to drain %u of %u objects.\n",
+                _polled.size() + disturbed.size(), drainableCount());
+
+        std::vector<Drainable *> polled;
+        polled.swap(_polled);
+        polled.insert(polled.end(), disturbed.begin(), disturbed.end());
+        for (auto *obj : polled) {
+            if (drainObject(obj))
+                _polled.push_back(obj);
         }
-        _count += status == DrainState::Drained ? 0 : 1;
     }
 
     if (_count == 0) {
@@ -92,6 +115,30 @@ DrainManager::tryDrain()
     }
 }
 
+bool
+DrainManager::drainObject(Drainable *obj)
+{
+    if (obj->_drainPass == _pass)
+        return false;
+    obj->_drainPass = _pass;
+
+    if (obj->drainIdle()) {
+        obj->_drainState = DrainState::Drained;
+        return false;
+    }
+
+    DrainState status = obj->dmDrain();
+    if (debug::Drain && status != DrainState::Drained) {
+        Named *temp = dynamic_cast<Named*>(obj);
+        if (temp)
+            DPRINTF(Drain, "Failed to drain %s\n", temp->name());
+    }
+    _count += status == DrainState::Drained ? 0 : 1;
+
+    // drain() may have found that it always drains, see drainAlwaysDone()
+    return !obj->drainIdle();
+}
+
 void
 DrainManager::resume()
 {
@@ -163,6 +210,10 @@ DrainManager::registerDrainable(Drainable *obj)
     assert(std::find(_allDrainable.begin(), _allDrainable.end(), obj) ==
            _allDrainable.end());
     _allDrainable.push_back(obj);
+
+    // Objects created while draining have to be drained in the next pass.
+    if (_state == DrainState::Draining)
+        _disturbed.push_back(obj);
 }
 
 void
@@ -172,6 +223,18 @@ DrainManager::unregisterDrainable(Drainable *obj)
     auto o = std::find(_allDrainable.begin(), _allDrainable.end(), obj);
     assert(o != _allDrainable.end());
     _allDrainable.erase(o);
+
+    _polled.erase(std::remove(_polled.begin(), _polled.end(), obj),
+                  _polled.end());
+    _disturbed.erase(std::remove(_disturbed.begin(), _disturbed.end(), obj),
+                     _disturbed.end());
+}
+
+void
+DrainManager::drainDisturbed(Drainable *obj)
+{
+    std::lock_guard<std::mutex> lock(globalLock);
+    _disturbed.push_back(obj);
 }
 
 bool
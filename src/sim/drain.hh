@@ -163,6 +163,12 @@ class DrainManager
     void registerDrainable(Drainable *obj);
     void unregisterDrainable(Drainable *obj);
 
+    /**
+     * Notify the DrainManager that a tracked object that was idle when
+     * it was drained has become busy, and needs to be drained again.
+     */
+    void drainDisturbed(Drainable *obj);
+
   private:
     /**
      * Helper function to check if all Drainable objects are in a
@@ -182,6 +188,31 @@ class DrainManager
     /** Set of all drainable objects */
     std::vector<Drainable *> _allDrainable;
 
+    /**
+     * Objects drained by the passes of the current drain cycle. The
+     * objects that are always drained or that are tracked and idle are
+     * left out, so later passes only visit the objects that may still
+     * have something to drain.
+     */
+    std::vector<Drainable *> _polled;
+
+    /**
+     * Objects that have become busy or have been created since the last
+     * pass, protected by globalLock.
+     */
+    std::vector<Drainable *> _disturbed;
+
+    /** Number of the current drain pass, to visit objects only once */
+    uint64_t _pass = 0;
+
+    /**
+     * Drain an object in the current pass, unless it has nothing to
+     * drain.
+     *
+     * @return Whether the object has to be drained in later passes.
+     */
+    bool drainObject(Drainable *obj);
+
     /**
      * Number of objects still draining. This is flagged atomic since
      * it can be manipulated by SimObjects living in different
@@ -343,6 +374,41 @@ class Drainable
      */
     virtual void notifyFork() {};
 
+  protected:
+    /**
+     * Opt in to drain tracking. A tracked object tells the drain manager
+     * with drainBusy() whether it has any state to drain, and drain() is
+     * only called while it is busy. drain() of an idle tracked object
+     * must return DrainState::Drained.
+     *
+     * @ingroup api_drain
+     */
+    void trackDrain() { _drainTracked = true; }
+
+    /**
+     * Tell the drain manager whether a tracked object has any state to
+     * drain. This is cheap, so it can be called whenever the state of
+     * the object changes.
+     *
+     * @ingroup api_drain
+     */
+    void
+    drainBusy(bool busy)
+    {
+        if (busy && !_drainBusy && _drainState == DrainState::Drained &&
+                _drainManager.state() == DrainState::Draining) {
+            _drainManager.drainDisturbed(this);
+        }
+        _drainBusy = busy;
+    }
+
+    /**
+     * Tell the drain manager that drain() always returns
+     * DrainState::Drained, so that it doesn't need to be called at all.
+     * Called by the default implementation of drain() of SimObject.
+     */
+    void drainAlwaysDone() { _drainAlwaysDone = true; }
+
   private:
     /** DrainManager interface to request a drain operation */
     DrainState dmDrain();
@@ -358,6 +424,22 @@ class Drainable
      * into a Drained state even if the calling method is const.
      */
     mutable DrainState _drainState;
+
+    /** Whether drain() needs to be called, see drainAlwaysDone() */
+    bool _drainAlwaysDone = false;
+    /** Whether the object is tracked, see trackDrain() */
+    bool _drainTracked = false;
+    /** Whether a tracked object has state to drain */
+    bool _drainBusy = false;
+    /** Last drain pass that visited the object */
+    uint64_t _drainPass = 0;
+
+    /** Whether the object has nothing to drain right now */
+    bool
+    drainIdle() const
+    {
+        return _drainAlwaysDone || (_drainTracked && !_drainBusy);
+    }
 };
 
 } // namespace gem5
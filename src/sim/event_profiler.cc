@@ -0,0 +1,146 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/event_profiler.hh"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+bool EventProfiler::_enabled = false;
+unsigned EventProfiler::_period = 1;
+thread_local unsigned EventProfiler::countdown = 1;
+std::mutex EventProfiler::samplesMutex;
+EventProfiler::SampleMap EventProfiler::samples;
+
+namespace
+{
+
+/** The name of an event without the parts that differ per instance */
+std::string
+ownerName(const Event *event)
+{
+    std::string name = event->name();
+
+    // Events without a name of their own are called Event_<instance>
+    if (name.compare(0, 6, "Event_") == 0)
+        return "unnamed";
+
+    const std::string wrapped(".wrapped_function_event");
+    if (name.size() > wrapped.size() &&
+        name.compare(name.size() - wrapped.size(), wrapped.size(),
+                     wrapped) == 0) {
+        name.resize(name.size() - wrapped.size());
+    }
+    return name;
+}
+
+} // anonymous namespace
+
+void
+EventProfiler::enable(unsigned period)
+{
+    _period = std::max(period, 1U);
+    countdown = _period;
+    _enabled = true;
+}
+
+void
+EventProfiler::disable()
+{
+    _enabled = false;
+}
+
+void
+EventProfiler::reset()
+{
+    std::lock_guard<std::mutex> lock(samplesMutex);
+    samples.clear();
+}
+
+void
+EventProfiler::process(Event *event)
+{
+    // The event may delete itself, so name it first
+    auto key = std::make_pair(ownerName(event),
+                              std::string(event->description()));
+
+    const uint64_t start = hostCycles();
+    event->process();
+    const uint64_t cycles = hostCycles() - start;
+
+    std::lock_guard<std::mutex> lock(samplesMutex);
+    Samples &s = samples[std::move(key)];
+    s.count++;
+    s.cycles += cycles;
+}
+
+void
+EventProfiler::dumpFolded(std::ostream &os)
+{
+    std::lock_guard<std::mutex> lock(samplesMutex);
+    for (const auto &[key, s] : samples) {
+        std::string stack = key.first;
+        std::replace(stack.begin(), stack.end(), '.', ';');
+        // Spaces would end the stack
+        std::string desc = key.second;
+        std::replace(desc.begin(), desc.end(), ' ', '_');
+        ccprintf(os, "%s;%s %d\n", stack, desc, s.cycles * _period);
+    }
+}
+
+void
+EventProfiler::dumpSummary(std::ostream &os)
+{
+    std::lock_guard<std::mutex> lock(samplesMutex);
+    std::vector<SampleMap::const_iterator> sorted;
+    uint64_t total = 0;
+    for (auto it = samples.begin(); it != samples.end(); ++it) {
+        sorted.push_back(it);
+        total += it->second.cycles;
+    }
+    std::sort(sorted.begin(), sorted.end(), [](auto a, auto b) {
+        return a->second.cycles > b->second.cycles;
+    });
+
+    ccprintf(os, "# One in %d events sampled, counts are estimates\n",
+             _period);
+    ccprintf(os, "%16s %7s %12s %10s  %s\n", "cycles", "share", "events",
+             "cycles/ev", "event");
+    for (const auto &it : sorted) {
+        const Samples &s = it->second;
+        ccprintf(os, "%16d %6.2f%% %12d %10.1f  %s (%s)\n",
+                 s.cycles * _period, total ? 100.0 * s.cycles / total : 0.0,
+                 s.count * _period, (double)s.cycles / s.count,
+                 it->first.first, it->first.second);
+    }
+}
+
+} // namespace gem5
@@ -0,0 +1,139 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A profiler of the host time spent processing events. One in every
+ * sample period events is timed with the host cycle counter, and its
+ * cycles are attributed to the name of the event and its description.
+ * Event names mostly start with the name of the SimObject that owns
+ * the event, so the report breaks the host time down by SimObject.
+ */
+
+#ifndef __SIM_EVENT_PROFILER_HH__
+#define __SIM_EVENT_PROFILER_HH__
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+#include "base/compiler.hh"
+
+namespace gem5
+{
+
+class Event;
+
+class EventProfiler
+{
+  public:
+    /** Host cycles, or nanoseconds where there is no cycle counter. */
+    static uint64_t
+    hostCycles()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t cycles;
+        asm volatile("mrs %0, cntvct_el0" : "=r" (cycles));
+        return cycles;
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    /**
+     * Start profiling.
+     * @param period Time one in this many events, at least 1
+     */
+    static void enable(unsigned period);
+    static void disable();
+    static bool enabled() { return _enabled; }
+
+    /** Forget the samples taken so far. */
+    static void reset();
+
+    /**
+     * Whether the event about to be processed should be timed. This is
+     * called for every event and only counts down while enabled.
+     */
+    static bool
+    sampleNext()
+    {
+        if (GEM5_LIKELY(!_enabled))
+            return false;
+        if (GEM5_LIKELY(--countdown != 0))
+            return false;
+        countdown = _period;
+        return true;
+    }
+
+    /** Process the event and record the host cycles it took. */
+    static void process(Event *event);
+
+    /**
+     * Write the samples in the folded stack format of flame graph
+     * tools: the dot separated parts of the event name, then the event
+     * description, then the estimated host cycles.
+     */
+    static void dumpFolded(std::ostream &os);
+
+    /**
+     * Write a table of the estimated host cycles and event counts
+     * of each event, with the most expensive events first.
+     */
+    static void dumpSummary(std::ostream &os);
+
+  private:
+    struct Samples
+    {
+        uint64_t count = 0;
+        uint64_t cycles = 0;
+    };
+
+    /** Samples by event name and description */
+    using SampleMap = std::map<std::pair<std::string, std::string>, Samples>;
+
+    static bool _enabled;
+    static unsigned _period;
+    static thread_local unsigned countdown;
+
+    static std::mutex samplesMutex;
+    static SampleMap samples;
+};
+
+} // namespace gem5
+
+#endif // __SIM_EVENT_PROFILER_HH__
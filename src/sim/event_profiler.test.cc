@@ -0,0 +1,115 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "sim/event_profiler.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Run count events of each of two owners on a fresh queue. */
+void
+runEvents(int count)
+{
+    EventQueue eventq("test");
+    curEventQueue(&eventq);
+
+    int processed = 0;
+    EventFunctionWrapper cpu([&]{ processed++; }, "system.cpu.tickEvent");
+    EventFunctionWrapper mem([&]{ processed++; }, "system.mem.respEvent");
+    for (int i = 0; i < count; i++) {
+        eventq.schedule(&cpu, 2 * i + 1);
+        eventq.serviceOne();
+        eventq.schedule(&mem, 2 * i + 2);
+        eventq.serviceOne();
+    }
+    ASSERT_EQ(processed, 2 * count);
+}
+
+} // anonymous namespace
+
+/** Every event is attributed to its owner when all events are timed. */
+TEST(EventProfilerTest, Folded)
+{
+    EventProfiler::reset();
+    EventProfiler::enable(1);
+    runEvents(10);
+    EventProfiler::disable();
+
+    std::ostringstream os;
+    EventProfiler::dumpFolded(os);
+    std::istringstream lines(os.str());
+    std::string stack;
+    uint64_t cycles;
+
+    ASSERT_TRUE(lines >> stack >> cycles);
+    ASSERT_EQ(stack, "system;cpu;tickEvent;EventFunctionWrapped");
+    ASSERT_TRUE(lines >> stack >> cycles);
+    ASSERT_EQ(stack, "system;mem;respEvent;EventFunctionWrapped");
+    ASSERT_FALSE(lines >> stack >> cycles);
+}
+
+/** Only one in every period events is sampled, counts are scaled. */
+TEST(EventProfilerTest, Summary)
+{
+    EventProfiler::reset();
+    EventProfiler::enable(4);
+    runEvents(100);
+    EventProfiler::disable();
+
+    std::ostringstream os;
+    EventProfiler::dumpSummary(os);
+    std::istringstream lines(os.str());
+    std::string line;
+    std::getline(lines, line);
+    ASSERT_EQ(line, "# One in 4 events sampled, counts are estimates");
+    std::getline(lines, line);
+
+    // Every other event belongs to each owner, so one of them gets all
+    // of the samples
+    uint64_t cycles, events;
+    std::string share, per_event, name;
+    ASSERT_TRUE(lines >> cycles >> share >> events >> per_event >> name);
+    ASSERT_EQ(events, 200);
+    ASSERT_FALSE(lines >> cycles);
+}
+
+/** Nothing is sampled while the profiler is disabled. */
+TEST(EventProfilerTest, Disabled)
+{
+    EventProfiler::reset();
+    runEvents(10);
+
+    std::ostringstream os;
+    EventProfiler::dumpFolded(os);
+    ASSERT_TRUE(os.str().empty());
+}
@@ -0,0 +1,167 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/microbench.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class CountingEvent : public Event
+{
+  public:
+    uint64_t count = 0;
+
+    void process() override { ++count; }
+    const char *description() const override { return "counting"; }
+};
+
+/** Event that reschedules itself a random delay in the future. */
+class HoldEvent : public Event
+{
+  public:
+    HoldEvent(EventQueue &_eventq, std::mt19937 &_rng)
+        : eventq(_eventq), rng(_rng)
+    {}
+
+    void
+    process() override
+    {
+        std::uniform_int_distribution<Tick> delay(1, 100000);
+        eventq.schedule(this, eventq.getCurTick() + delay(rng));
+    }
+
+    const char *description() const override { return "hold"; }
+
+    EventQueue &eventq;
+    std::mt19937 &rng;
+};
+
+/**
+ * The classic hold model: service an event, which schedules itself a
+ * random delay later, with a fixed number of events pending.
+ */
+void
+holdModel(microbench::State &state, bool calendar)
+{
+    const size_t pending = state.range();
+    EventQueue eq("bench");
+    eq.useCalendarQueue(calendar);
+    curEventQueue(&eq);
+    std::mt19937 rng(0);
+
+    std::vector<std::unique_ptr<HoldEvent>> events;
+    std::uniform_int_distribution<Tick> tick(0, 100000);
+    for (size_t i = 0; i < pending; i++) {
+        events.emplace_back(new HoldEvent(eq, rng));
+        eq.schedule(events.back().get(), tick(rng));
+    }
+
+    for (auto _ : state)
+        eq.serviceOne();
+    state.setItemsProcessed(state.iterations());
+
+    for (auto &event : events)
+        eq.deschedule(event.get());
+    curEventQueue(nullptr);
+}
+
+} // anonymous namespace
+
+/**
+ * Schedule a batch of events at spread out ticks, then service them all,
+ * the basic work of every simulated cycle.
+ */
+static void
+eventQueueScheduleService(microbench::State &state)
+{
+    const size_t num_events = state.range();
+    EventQueue eq("bench");
+    curEventQueue(&eq);
+    std::vector<CountingEvent> events(num_events);
+
+    Tick now = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < num_events; i++) {
+            // Several events share each tick, as in a clocked system
+            eq.schedule(&events[i], now + 1 + (i * 7919 % num_events) / 4);
+        }
+        while (!eq.empty())
+            eq.serviceOne();
+        now = eq.getCurTick();
+    }
+    state.setItemsProcessed(state.iterations() * num_events);
+    curEventQueue(nullptr);
+}
+GEM5_BENCHMARK(eventQueueScheduleService)->arg(16)->arg(256)->arg(4096);
+
+/** Move a scheduled event around a populated queue. */
+static void
+eventQueueReschedule(microbench::State &state)
+{
+    const size_t num_events = state.range();
+    EventQueue eq("bench");
+    curEventQueue(&eq);
+    std::vector<CountingEvent> events(num_events);
+    for (size_t i = 0; i < num_events; i++)
+        eq.schedule(&events[i], 1000 + i * 10);
+
+    CountingEvent moving;
+    eq.schedule(&moving, 1000);
+    Tick when = 1000;
+    for (auto _ : state) {
+        when = 1000 + (when * 7919) % (num_events * 10);
+        eq.reschedule(&moving, when);
+    }
+
+    eq.deschedule(&moving);
+    for (auto &event : events)
+        eq.deschedule(&event);
+    curEventQueue(nullptr);
+}
+GEM5_BENCHMARK(eventQueueReschedule)->arg(16)->arg(4096);
+
+/** Hold model on the sorted list backend. */
+static void
+eventQueueHoldList(microbench::State &state)
+{
+    holdModel(state, false);
+}
+GEM5_BENCHMARK(eventQueueHoldList)->arg(10)->arg(100)->arg(1000)->arg(10000);
+
+/** Hold model on the calendar queue backend. */
+static void
+eventQueueHoldCalendar(microbench::State &state)
+{
+    holdModel(state, true);
+}
+GEM5_BENCHMARK(eventQueueHoldCalendar)
+    ->arg(10)->arg(100)->arg(1000)->arg(10000);
@@ -30,7 +30,9 @@
 
 #include "sim/eventq.hh"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <mutex>
 #include <string>
@@ -41,11 +43,19 @@
 #include "base/trace.hh"
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
+#include "sim/event_profiler.hh"
 
 namespace gem5
 {
 
 Tick simQuantum = 0;
+Tick simQuantumLookahead = MaxTick;
+
+void
+declareQuantumLookahead(Tick lookahead)
+{
+    simQuantumLookahead = std::min(simQuantumLookahead, lookahead);
+}
 
 //
 // Main Event Queues
@@ -57,6 +67,7 @@ uint32_t numMainEventQueues = 0;
 std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
+bool calendarEventQueues = false;
 
 EventQueue *
 getEventQueue(uint32_t index)
@@ -137,6 +148,11 @@ Event::releaseImpl()
 void
 EventQueue::insert(Event *event)
 {
+    if (calendarEnabled) {
+        head = calendar.insert(event);
+        return;
+    }
+
     // Deal with the head case
     if (!head || *event <= *head) {
         head = Event::insertBefore(event, head);
@@ -196,6 +212,11 @@ EventQueue::remove(Event *event)
 
     assert(event->queue == this);
 
+    if (calendarEnabled) {
+        head = calendar.remove(event);
+        return;
+    }
+
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
@@ -228,7 +249,9 @@ EventQueue::serviceOne()
     Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
-    if (next) {
+    if (calendarEnabled) {
+        head = calendar.pop();
+    } else if (next) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -242,11 +265,16 @@ EventQueue::serviceOne()
 
     // handle action
     if (!event->squashed()) {
+        hostStats.serviced++;
+
         // forward current cycle to the time when this event occurs.
         setCurTick(event->when());
         if (debug::Event)
             event->trace("executed");
-        event->process();
+        if (GEM5_UNLIKELY(EventProfiler::sampleNext()))
+            EventProfiler::process(event);
+        else
+            event->process();
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -321,15 +349,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
+        for (Event *nextBin : bins()) {
             Event *nextInBin = nextBin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -344,8 +369,7 @@ EventQueue::debugVerify() const
     Tick time = 0;
     short priority = 0;
 
-    Event *nextBin = head;
-    while (nextBin) {
+    for (Event *nextBin : bins()) {
         Event *nextInBin = nextBin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
@@ -371,8 +395,6 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
@@ -381,6 +403,14 @@ EventQueue::debugVerify() const
 Event*
 EventQueue::replaceHead(Event* s)
 {
+    if (calendarEnabled) {
+        // Hand out the events as a bin list so that they can be put
+        // back in the calendar (or in a list based queue) later.
+        Event *t = calendar.release();
+        head = calendar.adopt(s);
+        return t;
+    }
+
     Event* t = head;
     head = s;
     return t;
@@ -442,30 +472,124 @@ Event::dump() const
 }
 
 EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+    : objName(n), head(NULL), _curTick(0), calendarEnabled(false),
+      async_queue(nullptr)
 {
+    useCalendarQueue(calendarEventQueues);
+}
+
+void
+EventQueue::useCalendarQueue(bool enable)
+{
+    if (enable == calendarEnabled)
+        return;
+
+    if (enable) {
+        head = calendar.adopt(head);
+    } else {
+        head = calendar.release();
+    }
+    calendarEnabled = enable;
+}
+
+std::vector<Event *>
+EventQueue::bins() const
+{
+    if (calendarEnabled)
+        return calendar.bins();
+
+    std::vector<Event *> all_bins;
+    for (Event *bin = head; bin; bin = bin->nextBin)
+        all_bins.push_back(bin);
+    return all_bins;
+}
+
+namespace
+{
+
+double
+hostNow()
+{
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // anonymous namespace
+
+void
+EventQueue::hostState(HostStats::State state)
+{
+    const double now = hostNow();
+    if (hostStats.state == HostStats::Running)
+        hostStats.busy += now - hostStats.since;
+    else if (hostStats.state == HostStats::Waiting)
+        hostStats.waiting += now - hostStats.since;
+    hostStats.state = state;
+    hostStats.since = now;
+}
+
+double
+EventQueue::hostBusySeconds() const
+{
+    if (hostStats.state != HostStats::Running)
+        return hostStats.busy;
+    return hostStats.busy + hostNow() - hostStats.since;
+}
+
+double
+EventQueue::hostBarrierSeconds() const
+{
+    if (hostStats.state != HostStats::Waiting)
+        return hostStats.waiting;
+    return hostStats.waiting + hostNow() - hostStats.since;
 }
 
 void
 EventQueue::asyncInsert(Event *event)
 {
-    async_queue_mutex.lock();
-    async_queue.push_back(event);
-    async_queue_mutex.unlock();
+    Event *top = async_queue.load(std::memory_order_relaxed);
+    event->nextBin = top;
+    while (!async_queue.compare_exchange_weak(top, event,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed)) {
+        // top has been reloaded by the failed exchange
+        event->nextBin = top;
+        asyncStats.contended++;
+    }
+
+    asyncStats.inserts++;
 }
 
 void
 EventQueue::handleAsyncInsertions()
 {
     assert(this == curEventQueue());
-    async_queue_mutex.lock();
 
-    while (!async_queue.empty()) {
-        insert(async_queue.front());
-        async_queue.pop_front();
+    Event *top = async_queue.exchange(nullptr, std::memory_order_acquire);
+    if (!top)
+        return;
+
+    // The list is in LIFO order, reverse it so that events are inserted
+    // in the order in which they were scheduled.
+    Event *list = nullptr;
+    Counter batch = 0;
+    while (top) {
+        Event *next = top->nextBin;
+        top->nextBin = list;
+        list = top;
+        top = next;
+        batch++;
+    }
+
+    while (list) {
+        Event *next = list->nextBin;
+        insert(list);
+        list = next;
     }
 
-    async_queue_mutex.unlock();
+    asyncStats.drains++;
+    asyncStats.maxBatch = std::max(asyncStats.maxBatch, batch);
+    DPRINTF(Event, "%s: drained %d async events\n", name(), batch);
 }
 
 } // namespace gem5
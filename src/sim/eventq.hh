@@ -36,6 +36,7 @@
 #define __SIM_EVENTQ_HH__
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <climits>
 #include <functional>
@@ -43,6 +44,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
@@ -52,6 +54,7 @@
 #include "base/types.hh"
 #include "base/uncontended_mutex.hh"
 #include "debug/Event.hh"
+#include "sim/calendar_queue.hh"
 #include "sim/cur_tick.hh"
 #include "sim/serialize.hh"
 
@@ -66,8 +69,19 @@ class BaseGlobalEvent;
 //! synchronize themselves with each other. This means that any
 //! event to scheduled on Queue A which is generated by an event on
 //! Queue B should be at least simQuantum ticks away in future.
+//! The quantum may change at the synchronization points when it adapts
+//! to the simulation, see Root::adaptQuantum().
 extern Tick simQuantum;
 
+//! Shortest delay with which a link between event queues hands events
+//! over, as declared by the links, or MaxTick if none declared one. An
+//! adaptive quantum never grows beyond it.
+extern Tick simQuantumLookahead;
+
+//! Declare that a link hands events over to another event queue after
+//! at least lookahead ticks.
+void declareQuantumLookahead(Tick lookahead);
+
 //! Current number of allocated main event queues.
 extern uint32_t numMainEventQueues;
 
@@ -82,6 +96,14 @@ extern __thread EventQueue *_curEventQueue;
 //! Current mode of execution: parallel / serial
 extern bool inParallelMode;
 
+/**
+ * Whether new event queues keep their events in a calendar queue
+ * instead of a sorted bin list.
+ *
+ * @see EventQueue::useCalendarQueue()
+ */
+extern bool calendarEventQueues;
+
 //! Function for returning eventq queue for the provided
 //! index. The function allocates a new queue in case one
 //! does not exist for the index, provided that the index
@@ -253,6 +275,7 @@ class EventBase
  */
 class Event : public EventBase, public Serializable
 {
+    friend class CalendarQueue;
     friend class EventQueue;
 
   private:
@@ -611,6 +634,19 @@ operator!=(const Event &l, const Event &r)
  * events must happen at least one simulation quantum into the future,
  * otherwise they risk being scheduled in the past by
  * handleAsyncInsertions().
+ *
+ * The async queue is a lock-free multi-producer, single-consumer
+ * list. Producers push with a CAS on the list head and link events
+ * through their (otherwise unused) nextBin pointer, so no memory is
+ * allocated on the cross-queue path. The owning thread detaches the
+ * whole list in one atomic exchange and inserts the events in the
+ * order they were pushed.
+ *
+ * Scheduled events are grouped in bins of events with the same time
+ * and priority. The bins are kept either in a list sorted by time and
+ * priority (the default), which makes insertion linear in the number
+ * of bins, or in a CalendarQueue, which makes insertion and removal
+ * O(1) amortized. Both backends service events in the same order.
  */
 class EventQueue
 {
@@ -621,11 +657,54 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
-    //! Mutex to protect async queue.
-    UncontendedMutex async_queue_mutex;
+    //! Bins of the queue when using the calendar queue backend, head
+    //! is then the event at the head of the calendar.
+    CalendarQueue calendar;
+    bool calendarEnabled;
 
-    //! List of events added by other threads to this event queue.
-    std::list<Event*> async_queue;
+    //! Most recently pushed event of the lock-free list of events added
+    //! by other threads to this event queue. Events are chained through
+    //! Event::nextBin until they are moved to the main queue.
+    std::atomic<Event *> async_queue;
+
+    //! Counters describing the use of the async queue.
+    struct AsyncQueueStats
+    {
+        //! Number of events pushed onto the async queue.
+        std::atomic<Counter> inserts;
+        //! Number of failed CAS attempts while pushing, i.e., the
+        //! number of times a producer raced with another producer.
+        std::atomic<Counter> contended;
+        //! Number of non-empty drains done by handleAsyncInsertions().
+        Counter drains;
+        //! Largest number of events moved by a single drain.
+        Counter maxBatch;
+
+        AsyncQueueStats() : inserts(0), contended(0), drains(0), maxBatch(0)
+        {}
+    } asyncStats;
+
+    //! Host time accounting of the thread running this queue.
+    struct HostStats
+    {
+        enum State { Idle, Running, Waiting };
+
+        State state;
+        //! Host time at which the current state was entered.
+        double since;
+        //! Number of events serviced.
+        Counter serviced;
+        //! Host seconds spent servicing events.
+        double busy;
+        //! Host seconds spent waiting for other queues at barriers.
+        double waiting;
+
+        HostStats()
+            : state(Idle), since(0), serviced(0), busy(0), waiting(0)
+        {}
+    } hostStats;
+
+    void hostState(HostStats::State state);
 
     /**
      * Lock protecting event handling.
@@ -654,6 +733,9 @@ class EventQueue
     void insert(Event *event);
     void remove(Event *event);
 
+    //! All bins of the queue, sorted by time and priority.
+    std::vector<Event *> bins() const;
+
     //! Function for adding events to the async queue. The added events
     //! are added to main event queue later. Threads, other than the
     //! owning thread, should call this function instead of insert().
@@ -900,11 +982,49 @@ class EventQueue
 
     bool debugVerify() const;
 
+    /**
+     * Select the backend storing the events of this queue: a calendar
+     * queue if enable is true, or the default sorted bin list
+     * otherwise. Events already scheduled are moved to the new
+     * backend. Must not be called while the queue is being serviced
+     * by another thread.
+     */
+    void useCalendarQueue(bool enable);
+    bool usingCalendarQueue() const { return calendarEnabled; }
+
     /**
      * Function for moving events from the async_queue to the main queue.
      */
     void handleAsyncInsertions();
 
+    /**
+     * @{
+     * Accessors for the async queue counters. The average drain batch
+     * size is asyncInserts() / asyncDrains().
+     */
+    Counter asyncInserts() const { return asyncStats.inserts; }
+    Counter asyncContention() const { return asyncStats.contended; }
+    Counter asyncDrains() const { return asyncStats.drains; }
+    Counter asyncMaxBatch() const { return asyncStats.maxBatch; }
+    /** @} */
+
+    /**
+     * @{
+     * Host time accounting. The thread running the queue marks when it
+     * starts servicing events, when it waits for the other queues at a
+     * global barrier and when it leaves the simulation loop. Time spent
+     * in each state is accumulated, so the counters are only stable when
+     * the queue isn't running, e.g., in a global event.
+     */
+    void hostRunning() { hostState(HostStats::Running); }
+    void hostWaiting() { hostState(HostStats::Waiting); }
+    void hostIdle() { hostState(HostStats::Idle); }
+
+    Counter eventsServiced() const { return hostStats.serviced; }
+    double hostBusySeconds() const;
+    double hostBarrierSeconds() const;
+    /** @} */
+
     /**
      *  Function to signal that the event loop should be woken up because
      *  an event has been scheduled by an agent outside the gem5 event
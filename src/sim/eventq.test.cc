@@ -0,0 +1,189 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Event recording its id in a trace when processed. */
+class TraceEvent : public Event
+{
+  public:
+    TraceEvent(int _id, std::vector<int> &_trace, Priority p)
+        : Event(p), id(_id), trace(_trace)
+    {}
+
+    void process() override { trace.push_back(id); }
+
+    const int id;
+    std::vector<int> &trace;
+};
+
+/**
+ * Schedule, reschedule and deschedule events at random, with many
+ * events sharing the same tick and priority, then run the queue and
+ * return the order in which the events were processed.
+ */
+std::vector<int>
+randomSchedule(bool calendar, unsigned seed)
+{
+    EventQueue eventq("test");
+    eventq.useCalendarQueue(calendar);
+    curEventQueue(&eventq);
+
+    std::vector<int> trace;
+    std::vector<std::unique_ptr<TraceEvent>> events;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<Tick> tick(1, 200);
+    std::uniform_int_distribution<int> prio(-2, 2);
+
+    for (int i = 0; i < 2000; i++) {
+        events.emplace_back(new TraceEvent(i, trace, prio(rng)));
+        eventq.schedule(events.back().get(), tick(rng));
+    }
+
+    std::uniform_int_distribution<size_t> pick(0, events.size() - 1);
+    for (int i = 0; i < 1000; i++) {
+        TraceEvent *event = events[pick(rng)].get();
+        if (rng() % 2) {
+            eventq.reschedule(event, tick(rng), true);
+        } else if (event->scheduled()) {
+            eventq.deschedule(event);
+        }
+    }
+    EXPECT_TRUE(eventq.debugVerify());
+
+    while (!eventq.empty())
+        eventq.serviceOne();
+
+    return trace;
+}
+
+} // anonymous namespace
+
+/** The calendar queue processes events in the same order as the list. */
+TEST(EventQueueTest, CalendarMatchesList)
+{
+    for (unsigned seed = 0; seed < 8; seed++) {
+        std::vector<int> list_trace = randomSchedule(false, seed);
+        std::vector<int> calendar_trace = randomSchedule(true, seed);
+        ASSERT_FALSE(list_trace.empty());
+        ASSERT_EQ(list_trace, calendar_trace);
+    }
+}
+
+/** Events with the same tick and priority are processed in LIFO order. */
+TEST(EventQueueTest, CalendarSameBinOrder)
+{
+    EventQueue eventq("test");
+    eventq.useCalendarQueue(true);
+
+    std::vector<int> trace;
+    TraceEvent a(0, trace, Event::Default_Pri);
+    TraceEvent b(1, trace, Event::Default_Pri);
+    TraceEvent c(2, trace, Event::Maximum_Pri);
+    TraceEvent d(3, trace, Event::Minimum_Pri);
+
+    eventq.schedule(&a, 10);
+    eventq.schedule(&b, 10);
+    eventq.schedule(&c, 10);
+    eventq.schedule(&d, 10);
+
+    while (!eventq.empty())
+        eventq.serviceOne();
+
+    ASSERT_EQ(trace, (std::vector<int>{3, 1, 0, 2}));
+}
+
+/** Switching backend and replacing the head keep the pending events. */
+TEST(EventQueueTest, SwitchBackend)
+{
+    EventQueue eventq("test");
+
+    std::vector<int> trace;
+    std::vector<std::unique_ptr<TraceEvent>> events;
+    for (int i = 0; i < 100; i++) {
+        events.emplace_back(new TraceEvent(i, trace, Event::Default_Pri));
+        eventq.schedule(events.back().get(), 1000 - 10 * i);
+    }
+
+    eventq.useCalendarQueue(true);
+    ASSERT_TRUE(eventq.debugVerify());
+
+    Event *saved = eventq.replaceHead(nullptr);
+    ASSERT_TRUE(eventq.empty());
+    eventq.replaceHead(saved);
+    ASSERT_EQ(eventq.nextTick(), 10);
+
+    eventq.useCalendarQueue(false);
+    ASSERT_TRUE(eventq.debugVerify());
+
+    while (!eventq.empty())
+        eventq.serviceOne();
+
+    ASSERT_EQ(trace.size(), 100);
+    for (int i = 0; i < 100; i++)
+        ASSERT_EQ(trace[i], 99 - i);
+}
+
+/** Serviced events and host time are accounted to the right state. */
+TEST(EventQueueTest, HostStats)
+{
+    EventQueue eventq("test");
+
+    std::vector<int> trace;
+    TraceEvent a(0, trace, Event::Default_Pri);
+    TraceEvent b(1, trace, Event::Default_Pri);
+    eventq.schedule(&a, 10);
+    eventq.schedule(&b, 20);
+    eventq.deschedule(&b);
+    eventq.schedule(&b, 30);
+
+    ASSERT_EQ(eventq.hostBusySeconds(), 0);
+    eventq.hostRunning();
+    while (!eventq.empty())
+        eventq.serviceOne();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    eventq.hostWaiting();
+    const double busy = eventq.hostBusySeconds();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    eventq.hostIdle();
+
+    ASSERT_EQ(eventq.eventsServiced(), 2);
+    ASSERT_GE(busy, 0.002);
+    ASSERT_EQ(eventq.hostBusySeconds(), busy);
+    ASSERT_GE(eventq.hostBarrierSeconds(), 0.002);
+}
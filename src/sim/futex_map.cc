@@ -65,18 +65,16 @@ FutexMap::wakeup(Addr addr, uint64_t tgid, int count)
         return 0;
 
     int woken_up = 0;
-    auto &waiterList = it->second;
+    auto &waiterList = it->second.waiters;
 
     while (!waiterList.empty() && woken_up < count) {
         // Threads may be woken up by access to locked
         // memory addresses outside of syscalls, so we
         // must only count threads that were actually
         // woken up by this syscall.
-        auto& tc = waiterList.front().tc;
-        tc->activate();
+        wake(waiterList.front().tc);
         woken_up++;
         waiterList.pop_front();
-        waitingTcs.erase(tc);
     }
 
     if (waiterList.empty())
@@ -89,49 +87,51 @@ void
 FutexMap::suspend_bitset(Addr addr, uint64_t tgid, ThreadContext *tc,
                int bitmask)
 {
-    FutexKey key(addr, tgid);
-    auto it = find(key);
-
-    if (it == end()) {
-        WaiterList waiterList {WaiterState(tc, bitmask)};
-        insert({key, waiterList});
-    } else {
-        it->second.push_back(WaiterState(tc, bitmask));
+    (*this)[FutexKey(addr, tgid)].push(WaiterState(tc, bitmask));
+
+    {
+        std::lock_guard<std::mutex> lock(waitingMutex);
+        const ContextID id = tc->contextId();
+        if (id >= waitingTcs.size())
+            waitingTcs.resize(id + 1, false);
+        waitingTcs[id] = true;
     }
-    waitingTcs.emplace(tc);
 
     /** Suspend the thread context */
     tc->suspend();
 }
 
 int
-FutexMap::wakeup_bitset(Addr addr, uint64_t tgid, int bitmask)
+FutexMap::wakeup_bitset(Addr addr, uint64_t tgid, int bitmask, int count)
 {
     FutexKey key(addr, tgid);
     auto it = find(key);
 
-    if (it == end())
+    // No waiter shares a bit with the wakeup mask
+    if (it == end() || !(it->second.maskUnion & bitmask))
         return 0;
 
     int woken_up = 0;
 
-    auto &waiterList = it->second;
-    auto iter = waiterList.begin();
+    auto &waiters = it->second;
+    auto iter = waiters.waiters.begin();
 
-    while (iter != waiterList.end()) {
+    // Recompute the mask union of the waiters that stay
+    waiters.maskUnion = 0;
+    while (iter != waiters.waiters.end()) {
         WaiterState& waiter = *iter;
 
-        if (waiter.checkMask(bitmask)) {
-            waiter.tc->activate();
-            waitingTcs.erase(waiter.tc);
-            iter = waiterList.erase(iter);
+        if (woken_up < count && waiter.checkMask(bitmask)) {
+            wake(waiter.tc);
+            iter = waiters.waiters.erase(iter);
             woken_up++;
         } else {
+            waiters.maskUnion |= waiter.bitmask;
             ++iter;
         }
     }
 
-    if (waiterList.empty())
+    if (waiters.waiters.empty())
         erase(it);
 
     return woken_up;
@@ -147,32 +147,27 @@ FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
         return 0;
 
     int woken_up = 0;
-    auto &waiterList1 = it1->second;
+    auto &waiterList1 = it1->second.waiters;
 
     while (!waiterList1.empty() && woken_up < count) {
-        waiterList1.front().tc->activate();
+        wake(waiterList1.front().tc);
         waiterList1.pop_front();
         woken_up++;
     }
 
-    WaiterList tmpList;
     int requeued = 0;
-
-    while (!waiterList1.empty() && requeued < count2) {
-      auto w = waiterList1.front();
-      waiterList1.pop_front();
-      tmpList.push_back(w);
-      requeued++;
-    }
-
-    FutexKey key2(addr2, tgid);
-    auto it2 = find(key2);
-
-    if (it2 == end() && requeued > 0) {
-        insert({key2, tmpList});
-    } else {
-        it2->second.insert(it2->second.end(),
-                           tmpList.begin(), tmpList.end());
+    if (!waiterList1.empty() && count2 > 0) {
+        // Move the waiters without copying them, the map nodes and
+        // so waiterList1 stay put if the insertion below rehashes
+        auto &waiters2 = (*this)[FutexKey(addr2, tgid)];
+        auto last = waiterList1.begin();
+        while (last != waiterList1.end() && requeued < count2) {
+            waiters2.maskUnion |= last->bitmask;
+            ++last;
+            requeued++;
+        }
+        waiters2.waiters.splice(waiters2.waiters.end(), waiterList1,
+                                waiterList1.begin(), last);
     }
 
     if (waiterList1.empty())
@@ -181,10 +176,22 @@ FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
     return woken_up + requeued;
 }
 
+void
+FutexMap::wake(ThreadContext *tc)
+{
+    {
+        std::lock_guard<std::mutex> lock(waitingMutex);
+        waitingTcs[tc->contextId()] = false;
+    }
+    runOnContextQueue(tc, [tc]() { tc->activate(); });
+}
+
 bool
 FutexMap::is_waiting(ThreadContext *tc)
 {
-    return waitingTcs.find(tc) != waitingTcs.end();
+    std::lock_guard<std::mutex> lock(waitingMutex);
+    const ContextID id = tc->contextId();
+    return id < waitingTcs.size() && waitingTcs[id];
 }
 
 } // namespace gem5
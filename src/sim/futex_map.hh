@@ -29,8 +29,10 @@
 #ifndef __FUTEX_MAP_HH__
 #define __FUTEX_MAP_HH__
 
+#include <list>
+#include <mutex>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 #include <cpu/thread_context.hh>
 
@@ -66,12 +68,11 @@ namespace std
     {
         size_t operator()(const gem5::FutexKey& in) const
         {
-            size_t hash = 65521;
-            for (int i = 0; i < sizeof(uint64_t) / sizeof(size_t); i++) {
-                hash ^= (size_t)(in.addr >> sizeof(size_t) * i) ^
-                        (size_t)(in.tgid >> sizeof(size_t) * i);
-            }
-            return hash;
+            // Futex words are aligned and often share their upper bits,
+            // so mix the key rather than just folding it.
+            uint64_t hash = (in.addr ^ (in.tgid << 32)) *
+                0x9e3779b97f4a7c15ULL;
+            return hash ^ (hash >> 29);
         }
     };
 } // namespace std
@@ -103,10 +104,27 @@ class WaiterState
 
 typedef std::list<WaiterState> WaiterList;
 
+/**
+ * The waiters of one futex, in wait order, with the union of their
+ * bitmasks so that bitset wakeups matching no waiter return at once.
+ */
+struct FutexWaiters
+{
+    WaiterList waiters;
+    int maskUnion = 0;
+
+    void
+    push(const WaiterState &waiter)
+    {
+        waiters.push_back(waiter);
+        maskUnion |= waiter.bitmask;
+    }
+};
+
 /**
  * FutexMap class holds a map of all futexes used in the system
  */
-class FutexMap : public std::unordered_map<FutexKey, WaiterList>
+class FutexMap : public std::unordered_map<FutexKey, FutexWaiters>
 {
   public:
     /** Inserts a futex into the map with one waiting TC */
@@ -118,7 +136,11 @@ class FutexMap : public std::unordered_map<FutexKey, WaiterList>
     void suspend_bitset(Addr addr, uint64_t tgid, ThreadContext *tc,
                    int bitmask);
 
-    int wakeup_bitset(Addr addr, uint64_t tgid, int bitmask);
+    /**
+     * Wakes up at most count waiting threads on a futex whose bitmask
+     * intersects the given one
+     */
+    int wakeup_bitset(Addr addr, uint64_t tgid, int bitmask, int count);
 
     /**
      * This operation wakes a given number (val) of waiters. If there are
@@ -139,8 +161,18 @@ class FutexMap : public std::unordered_map<FutexKey, WaiterList>
     bool is_waiting(ThreadContext *tc);
 
   private:
+    /** Wake up a waiter, possibly simulated by another event queue */
+    void wake(ThreadContext *tc);
 
-    std::unordered_set<ThreadContext *> waitingTcs;
+    /** Whether each context, indexed by its id, waits on a futex */
+    std::vector<bool> waitingTcs;
+
+    /**
+     * Guards waitingTcs, which CPUs query from their own event queue
+     * when an interrupt is posted. The futex operations themselves are
+     * serialized by the syscall emulation lock.
+     */
+    mutable std::mutex waitingMutex;
 };
 
 } // namespace gem5
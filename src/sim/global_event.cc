@@ -35,6 +35,7 @@ namespace gem5
 {
 
 std::mutex BaseGlobalEvent::globalQMutex;
+bool BaseGlobalEvent::sequentialBarriers = false;
 
 BaseGlobalEvent::BaseGlobalEvent(Priority p, Flags f)
     : barrier(numMainEventQueues),
@@ -158,6 +159,8 @@ void
 GlobalSyncEvent::process()
 {
     if (repeat) {
+        if (adaptRepeat)
+            repeat = adaptRepeat(repeat);
         schedule(curTick() + repeat);
     }
 }
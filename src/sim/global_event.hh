@@ -30,6 +30,7 @@
 #ifndef __SIM_GLOBAL_EVENT_HH__
 #define __SIM_GLOBAL_EVENT_HH__
 
+#include <functional>
 #include <mutex>
 #include <vector>
 
@@ -100,8 +101,19 @@ class BaseGlobalEvent : public EventBase
             // locked when entering this method. We need to unlock it
             // while waiting on the barrier to prevent deadlocks if
             // another thread wants to lock the event queue.
-            EventQueue::ScopedRelease release(curEventQueue());
-            return _globalEvent->barrier.wait();
+            //
+            // With sequential barriers, every queue has already
+            // arrived and the local events are serviced one after the
+            // other, starting with the last queue, by a single thread.
+            if (sequentialBarriers)
+                return this == _globalEvent->barrierEvent.back();
+
+            EventQueue *eventq = curEventQueue();
+            EventQueue::ScopedRelease release(eventq);
+            eventq->hostWaiting();
+            const bool last = _globalEvent->barrier.wait();
+            eventq->hostRunning();
+            return last;
         }
 
       public:
@@ -116,6 +128,11 @@ class BaseGlobalEvent : public EventBase
     std::vector<BarrierEvent *> barrierEvent;
 
   public:
+    //! Set when the event queues are run on a thread pool. The local
+    //! barrier events are then serviced in sequence once all queues
+    //! have reached them, instead of each queue waiting on the barrier.
+    static bool sequentialBarriers;
+
     BaseGlobalEvent(Priority p, Flags f);
 
     virtual ~BaseGlobalEvent();
@@ -238,6 +255,12 @@ class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
     const char *description() const;
 
     Tick repeat;
+
+    /**
+     * If set, picks the interval to the next sync from the one that just
+     * ended. It runs while all the queues are stopped at the barrier.
+     */
+    std::function<Tick(Tick)> adaptRepeat;
 };
 
 } // namespace gem5
@@ -317,7 +317,9 @@ class InstRecord
  * It also provides a base implementation which is
  * simply calling the StaticInst::disassemble method, which
  * is the usual interface for disassembling
- * a gem5 instruction.
+ * a gem5 instruction. Disassemblers hand out references to the
+ * strings they cache, so tracing an instruction again builds no new
+ * string.
  */
 class InstDisassembler : public SimObject
 {
@@ -326,7 +328,7 @@ class InstDisassembler : public SimObject
       : SimObject(params)
     {}
 
-    virtual std::string
+    virtual const std::string &
     disassemble(StaticInstPtr inst,
                 const PCStateBase &pc,
                 const loader::SymbolTable *symtab) const
@@ -350,7 +352,7 @@ class InstTracer : public SimObject
                 const StaticInstPtr staticInst, const PCStateBase &pc,
                 const StaticInstPtr macroStaticInst=nullptr) = 0;
 
-    std::string
+    const std::string &
     disassemble(StaticInstPtr inst,
                 const PCStateBase &pc,
                 const loader::SymbolTable *symtab=nullptr) const
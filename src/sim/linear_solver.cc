@@ -37,6 +37,10 @@
 
 #include "sim/linear_solver.hh"
 
+#include <cmath>
+#include <numeric>
+#include <utility>
+
 namespace gem5
 {
 
@@ -87,4 +91,123 @@ LinearSystem::solve() const
     return ret;
 }
 
+void
+LUSolver::factorize(const LinearSystem &ls)
+{
+    unsigned order = ls.size();
+
+    coeffs.assign(order, {});
+    std::vector < std::vector <double> > a(order);
+    for (unsigned row = 0; row < order; row++) {
+        a[row].resize(order);
+        for (unsigned col = 0; col < order; col++) {
+            a[row][col] = ls[row][col];
+            if (a[row][col] != 0.0)
+                coeffs[row].push_back({col, a[row][col]});
+        }
+    }
+
+    perm.resize(order);
+    std::iota(perm.begin(), perm.end(), 0);
+
+    // Gaussian elimination with partial pivoting, keeping the multipliers
+    // in the eliminated entries. Zero entries are skipped so sparse
+    // systems with little fill-in are cheap to factorize.
+    std::vector <unsigned> pivot_cols;
+    for (unsigned k = 0; k < order; k++) {
+        unsigned pivot = k;
+        for (unsigned i = k + 1; i < order; i++) {
+            if (std::fabs(a[i][k]) > std::fabs(a[pivot][k]))
+                pivot = i;
+        }
+        if (pivot != k) {
+            std::swap(a[pivot], a[k]);
+            std::swap(perm[pivot], perm[k]);
+        }
+
+        pivot_cols.clear();
+        for (unsigned j = k + 1; j < order; j++) {
+            if (a[k][j] != 0.0)
+                pivot_cols.push_back(j);
+        }
+
+        for (unsigned i = k + 1; i < order; i++) {
+            if (a[i][k] == 0.0)
+                continue;
+            double f = a[i][k] / a[k][k];
+            a[i][k] = f;
+            for (auto j : pivot_cols)
+                a[i][j] -= f * a[k][j];
+        }
+    }
+
+    lower.assign(order, {});
+    upper.assign(order, {});
+    diag.resize(order);
+    for (unsigned row = 0; row < order; row++) {
+        for (unsigned col = 0; col < order; col++) {
+            double v = a[row][col];
+            if (col == row)
+                diag[row] = v;
+            else if (v == 0.0)
+                continue;
+            else if (col < row)
+                lower[row].push_back({col, v});
+            else
+                upper[row].push_back({col, v});
+        }
+    }
+
+    factorized = true;
+}
+
+bool
+LUSolver::matches(const LinearSystem &ls) const
+{
+    if (!factorized || ls.size() != coeffs.size())
+        return false;
+
+    unsigned order = ls.size();
+    for (unsigned row = 0; row < order; row++) {
+        auto entry = coeffs[row].begin();
+        for (unsigned col = 0; col < order; col++) {
+            double expected = 0.0;
+            if (entry != coeffs[row].end() && entry->col == col) {
+                expected = entry->value;
+                ++entry;
+            }
+            if (ls[row][col] != expected)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+std::vector <double>
+LUSolver::solve(const LinearSystem &ls) const
+{
+    assert(factorized && ls.size() == diag.size());
+
+    // The equations read A*x + c = 0, so solve L*U*x = -c
+    unsigned order = ls.size();
+    std::vector <double> ret(order);
+    for (unsigned row = 0; row < order; row++) {
+        const LinearEquation &eq = ls[perm[row]];
+        double v = -eq[eq.cnt()];
+        for (const auto &e : lower[row])
+            v -= e.value * ret[e.col];
+        ret[row] = v;
+    }
+
+    for (int row = order - 1; row >= 0; row--) {
+        double v = ret[row];
+        for (const auto &e : upper[row])
+            v -= e.value * ret[e.col];
+        ret[row] = v / diag[row];
+    }
+
+    return ret;
+}
+
 } // namespace gem5
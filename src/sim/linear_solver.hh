@@ -85,6 +85,11 @@ class LinearEquation
         return eq[unkw];
     }
 
+    double operator[] (unsigned unkw) const {
+        assert(unkw < eq.size());
+        return eq[unkw];
+    }
+
     // Get a string representation
     std::string toStr() const {
         std::ostringstream oss;
@@ -121,6 +126,13 @@ class LinearSystem
         return matrix[eq];
     }
 
+    const LinearEquation & operator[] (unsigned eq) const {
+        assert(eq < matrix.size());
+        return matrix[eq];
+    }
+
+    unsigned size() const { return matrix.size(); }
+
     std::string toStr() const {
         std::string r;
         for (auto & eq: matrix)
@@ -134,6 +146,47 @@ class LinearSystem
     std::vector < LinearEquation > matrix;
 };
 
+/**
+ * Solves linear systems through an LU factorization of their
+ * coefficients. The factors are stored sparsely and reused, so a series
+ * of systems that only differ in their constant terms (e.g. the nodal
+ * equations of a thermal circuit with a fixed topology) is solved with
+ * two sparse triangular substitutions per system.
+ */
+class LUSolver
+{
+  public:
+    /** Factorize the coefficients of a system, ignoring constant terms */
+    void factorize(const LinearSystem &ls);
+
+    /** Check if a system has the coefficients that were factorized */
+    bool matches(const LinearSystem &ls) const;
+
+    /** Solve a system whose coefficients match the factorized ones */
+    std::vector <double> solve(const LinearSystem &ls) const;
+
+  private:
+    struct Entry
+    {
+        unsigned col;
+        double value;
+    };
+    typedef std::vector < std::vector <Entry> > SparseRows;
+
+    bool factorized = false;
+
+    /** Equation of the original system used for each row of the factors */
+    std::vector <unsigned> perm;
+    /** Non-zero coefficients of the factorized system */
+    SparseRows coeffs;
+    /** Strictly lower part of L, whose diagonal is 1 */
+    SparseRows lower;
+    /** Strictly upper part of U */
+    SparseRows upper;
+    /** Diagonal of U */
+    std::vector <double> diag;
+};
+
 } // namespace gem5
 
 #endif
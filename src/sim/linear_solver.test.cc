@@ -0,0 +1,98 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "sim/linear_solver.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+// Build the system A*x + c = 0
+LinearSystem
+makeSystem(const std::vector<std::vector<double>> &a,
+           const std::vector<double> &c)
+{
+    LinearSystem ls(a.size());
+    for (unsigned row = 0; row < a.size(); row++) {
+        for (unsigned col = 0; col < a.size(); col++)
+            ls[row][col] = a[row][col];
+        ls[row][ls[row].cnt()] = c[row];
+    }
+    return ls;
+}
+
+} // anonymous namespace
+
+TEST(LUSolverTest, MatchesGaussianElimination)
+{
+    // The first pivot is zero, so rows have to be swapped
+    LinearSystem ls = makeSystem(
+        {{0, 2, 1}, {1, -1, 0}, {3, 0, -2}}, {-5, 1, 4});
+
+    LUSolver solver;
+    EXPECT_FALSE(solver.matches(ls));
+    solver.factorize(ls);
+    EXPECT_TRUE(solver.matches(ls));
+
+    std::vector<double> expected = ls.solve();
+    std::vector<double> x = solver.solve(ls);
+    ASSERT_EQ(x.size(), expected.size());
+    for (unsigned i = 0; i < x.size(); i++)
+        EXPECT_NEAR(x[i], expected[i], 1e-9);
+}
+
+TEST(LUSolverTest, ReuseFactorization)
+{
+    // Tridiagonal system, like a chain of thermal resistors
+    std::vector<std::vector<double>> a = {
+        {-2, 1, 0, 0}, {1, -2, 1, 0}, {0, 1, -2, 1}, {0, 0, 1, -2}};
+    LinearSystem ls = makeSystem(a, {1, 0, 0, 1});
+
+    LUSolver solver;
+    solver.factorize(ls);
+
+    // Changing constant terms keeps the factorization valid
+    LinearSystem ls2 = makeSystem(a, {3, -1, 2, 0});
+    EXPECT_TRUE(solver.matches(ls2));
+    std::vector<double> expected = ls2.solve();
+    std::vector<double> x = solver.solve(ls2);
+    for (unsigned i = 0; i < x.size(); i++)
+        EXPECT_NEAR(x[i], expected[i], 1e-9);
+
+    // Changing a coefficient, even a zero one, does not
+    ls2[0][3] = 0.5;
+    EXPECT_FALSE(solver.matches(ls2));
+    ls2[0][3] = 0;
+    ls2[1][1] = -3;
+    EXPECT_FALSE(solver.matches(ls2));
+
+    // A system of a different size does not match either
+    EXPECT_FALSE(solver.matches(LinearSystem(3)));
+}
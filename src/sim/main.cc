@@ -35,6 +35,7 @@
 
 #include "python/embedded.hh"
 #include "sim/init_signals.hh"
+#include "sim/root.hh"
 
 using namespace gem5;
 
@@ -83,6 +84,8 @@ main(int argc, char **argv)
     auto importer = py::module_::import("importer");
     importer.attr("install")();
 
+    gem5::rootStats.markStartup(gem5::Root::RootStats::StartupPython);
+
     try {
         py::module_::import("m5").attr("main")();
     } catch (py::error_already_set &e) {
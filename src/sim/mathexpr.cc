@@ -150,7 +150,7 @@ MathExpr::parse(std::string expr) {
 }
 
 double
-MathExpr::eval(const Node *n, EvalCallback fn) const {
+MathExpr::eval(const Node *n, const EvalCallback &fn) const {
     if (!n)
         return 0;
     else if (n->op == sValue)
@@ -166,6 +166,65 @@ MathExpr::eval(const Node *n, EvalCallback fn) const {
     return 0;
 }
 
+MathExpr::Program
+MathExpr::compile(BindCallback fn) const
+{
+    Program prog;
+    prog.stack.resize(compile(root, fn, prog));
+    return prog;
+}
+
+unsigned
+MathExpr::compile(const Node *n, const BindCallback &fn,
+                  Program &prog) const
+{
+    // Missing operands evaluate to 0, as in eval()
+    if (!n) {
+        prog.code.push_back({sValue, nullptr, 0, nullptr});
+        return 1;
+    } else if (n->op == sValue) {
+        prog.code.push_back({sValue, nullptr, n->value, nullptr});
+        return 1;
+    } else if (n->op == sVariable) {
+        prog.code.push_back({sVariable, nullptr, 0, fn(n->variable)});
+        return 1;
+    }
+
+    for (auto & opt : ops) {
+        if (opt.op == n->op) {
+            unsigned l = compile(n->l, fn, prog);
+            unsigned r = compile(n->r, fn, prog);
+            prog.code.push_back({n->op, opt.fn, 0, nullptr});
+            return std::max(l, r + 1);
+        }
+    }
+
+    panic("Invalid node!\n");
+    return 0;
+}
+
+double
+MathExpr::Program::eval() const
+{
+    unsigned sp = 0;
+    for (const auto &i : code) {
+        switch (i.op) {
+          case sValue:
+            stack[sp++] = i.value;
+            break;
+          case sVariable:
+            stack[sp++] = i.var();
+            break;
+          default:
+            sp--;
+            stack[sp - 1] = i.fn(stack[sp - 1], stack[sp]);
+            break;
+        }
+    }
+    assert(sp == 1);
+    return stack[0];
+}
+
 std::string
 MathExpr::toStr(Node *n, std::string prefix) const {
     std::string ret;
@@ -55,6 +55,12 @@ class MathExpr
 
     typedef std::function<double(std::string)> EvalCallback;
 
+    /** A function returning the current value of a variable */
+    typedef std::function<double()> Variable;
+    typedef std::function<Variable(const std::string &)> BindCallback;
+
+    class Program;
+
     /**
      * Prints an ASCII representation of the expression tree
      *
@@ -87,6 +93,17 @@ class MathExpr
         return vars;
     }
 
+    /**
+     * Compiles the expression into a Program
+     *
+     * @param fn A callback function binding each variable name to a
+     * function returning its value. It is called once per variable
+     * occurrence.
+     *
+     * @return A Program evaluating this expression
+     */
+    Program compile(BindCallback fn) const;
+
   private:
     enum Operator
     {
@@ -96,7 +113,36 @@ class MathExpr
     // Match operators
     const int MAX_PRIO = 4;
     typedef double (*binOp)(double, double);
-    struct OpSearch
+
+  public:
+    /**
+     * An expression flattened into postfix order, with its variables
+     * already bound. Evaluating it neither walks the expression tree nor
+     * looks variables up by name.
+     */
+    class Program
+    {
+      public:
+        /** Evaluates the compiled expression */
+        double eval() const;
+
+      private:
+        friend class MathExpr;
+
+        struct Instr
+        {
+            Operator op;
+            binOp fn;
+            double value;
+            Variable var;
+        };
+
+        std::vector<Instr> code;
+        /** Evaluation stack, sized for the deepest point of the code */
+        mutable std::vector<double> stack;
+    };
+
+  private:    struct OpSearch
     {
         bool binary;
         Operator op;
@@ -142,7 +188,11 @@ class MathExpr
     std::string toStr(Node *n, std::string prefix) const;
 
     /** Eval a node */
-    double eval(const Node *n, EvalCallback fn) const;
+    double eval(const Node *n, const EvalCallback &fn) const;
+
+    /** Append the code for a node to a program, return the stack depth */
+    unsigned compile(const Node *n, const BindCallback &fn,
+                     Program &prog) const;
 
     /** Return all variable reachable from a node to a vector of
      * strings */
@@ -34,6 +34,7 @@
 #include "debug/Vma.hh"
 #include "mem/se_translating_port_proxy.hh"
 #include "sim/process.hh"
+#include "sim/se_workload.hh"
 #include "sim/syscall_debug_macros.hh"
 #include "sim/system.hh"
 #include "sim/vma.hh"
@@ -386,6 +387,13 @@ MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
 bool
 MemState::fixupFault(Addr vaddr)
 {
+    std::lock_guard<std::recursive_mutex> lock(SEWorkload::emulationLock());
+
+    // Another thread of the process may have fixed up the same page
+    // while this one waited for the lock
+    if (_ownerProcess->pTable->translate(vaddr))
+        return true;
+
     /**
      * Check if we are accessing a mapped virtual address. If so then we
      * just haven't allocated it a physical page yet and can do so here.
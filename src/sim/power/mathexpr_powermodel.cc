@@ -71,6 +71,10 @@ MathExprPowerModel::startup()
             statsMap[var] = info;
         }
     }
+
+    auto bind_fn = [this](const std::string &name) { return bind(name); };
+    dyn_prog = dyn_expr.compile(bind_fn);
+    st_prog = st_expr.compile(bind_fn);
 }
 
 double
@@ -111,6 +115,35 @@ MathExprPowerModel::getStatValue(const std::string &name) const
     panic("Unknown stat type!\n");
 }
 
+MathExpr::Variable
+MathExprPowerModel::bind(const std::string &name) const
+{
+    using namespace statistics;
+
+    // Automatic variables:
+    if (name == "temp") {
+        return [this]() { return _temp.toCelsius(); };
+    } else if (name == "voltage") {
+        return [this]() { return clocked_object->voltage(); };
+    } else if (name=="clock_period") {
+        return [this]() { return (double)clocked_object->clockPeriod(); };
+    }
+
+    const auto it = statsMap.find(name);
+    assert(it != statsMap.cend());
+    const Info *info = it->second;
+
+    // Try to cast the stat, only these are supported right now
+    auto si = dynamic_cast<const ScalarInfo *>(info);
+    if (si)
+        return [si]() { return (double)si->value(); };
+    auto fi = dynamic_cast<const FormulaInfo *>(info);
+    if (fi)
+        return [fi]() { return (double)fi->total(); };
+
+    panic("Unknown stat type!\n");
+}
+
 void
 MathExprPowerModel::regStats()
 {
@@ -68,14 +68,14 @@ class MathExprPowerModel : public PowerModelState
      *
      * @return Power (Watts) consumed by this object (dynamic component)
      */
-    double getDynamicPower() const override { return eval(dyn_expr); }
+    double getDynamicPower() const override { return dyn_prog.eval(); }
 
     /**
      * Get the static power consumption.
      *
      * @return Power (Watts) consumed by this object (static component)
      */
-    double getStaticPower() const override { return eval(st_expr); }
+    double getStaticPower() const override { return st_prog.eval(); }
 
     /**
      * Get the value for a variable (maps to a stat)
@@ -99,9 +99,20 @@ class MathExprPowerModel : public PowerModelState
      */
     double eval(const MathExpr &expr) const;
 
+    /**
+     * Bind a variable of an expression to the value it maps to.
+     *
+     * @param name Name of the variable
+     * @return Function returning the current value of the variable
+     */
+    MathExpr::Variable bind(const std::string &name) const;
+
     // Math expressions for dynamic and static power
     MathExpr dyn_expr, st_expr;
 
+    // Compiled forms of the expressions, built at startup
+    MathExpr::Program dyn_prog, st_prog;
+
     // Map that contains relevant stats for this power model
     std::unordered_map<std::string, const statistics::Info*> statsMap;
 };
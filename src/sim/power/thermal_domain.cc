@@ -87,9 +87,10 @@ LinearEquation
 ThermalDomain::getEquation(ThermalNode * tn, unsigned n, double step) const
 {
     LinearEquation eq(n);
-    double power = subsystem->getDynamicPower() + subsystem->getStaticPower();
-    if (tn == node)
-        eq[eq.cnt()] = power;
+    if (tn == node) {
+        eq[eq.cnt()] = subsystem->getDynamicPower() +
+            subsystem->getStaticPower();
+    }
     return eq;
 }
 
@@ -163,8 +163,12 @@ ThermalModel::doStep()
         ls[i] = node_equation;
     }
 
-    // Get temperatures for this iteration
-    std::vector <double> temps = ls.solve();
+    // Get temperatures for this iteration. Only the constant terms
+    // depend on the temperatures and powers, so the factorization of
+    // the previous step can usually be reused.
+    if (!solver.matches(ls))
+        solver.factorize(ls);
+    std::vector <double> temps = solver.solve(ls);
     for (unsigned i = 0; i < eq_nodes.size(); i++)
         eq_nodes[i]->temp = Temperature::fromKelvin(temps[i]);
 
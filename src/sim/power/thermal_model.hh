@@ -42,6 +42,7 @@
 
 #include "base/temperature.hh"
 #include "sim/clocked_object.hh"
+#include "sim/linear_solver.hh"
 #include "sim/power/thermal_domain.hh"
 #include "sim/power/thermal_entity.hh"
 #include "sim/power/thermal_node.hh"
@@ -173,6 +174,12 @@ class ThermalModel : public ClockedObject
     std::vector <ThermalNode*> nodes;
     std::vector <ThermalNode*> eq_nodes;
 
+    /**
+     * Factorization of the nodal equations, reused for as long as the
+     * circuit coefficients do not change.
+     */
+    LUSolver solver;
+
     /** Stepping event to update the model values */
     EventFunctionWrapper stepEvent;
 
@@ -608,6 +608,19 @@ workend(ThreadContext *tc, uint64_t workid, uint64_t threadid)
     }
 }
 
+//
+// Work marks only record the tick and instruction count, and leave all the
+// accounting to offline processing of the recorded marks.
+//
+void
+workmark(ThreadContext *tc, uint64_t markid)
+{
+    DPRINTF(PseudoInst, "pseudo_inst::workmark(%i)\n", markid);
+    BaseCPU *cpu = tc->getCpuPtr();
+    tc->getSystemPtr()->recordWorkMark(cpu->cpuId(), markid,
+                                       cpu->totalInsts());
+}
+
 void
 m5Hypercall(ThreadContext *tc, uint64_t hypercall_id)
 {
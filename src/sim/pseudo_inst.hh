@@ -110,6 +110,7 @@ void debugbreak(ThreadContext *tc);
 void switchcpu(ThreadContext *tc);
 void workbegin(ThreadContext *tc, uint64_t workid, uint64_t threadid);
 void workend(ThreadContext *tc, uint64_t workid, uint64_t threadid);
+void workmark(ThreadContext *tc, uint64_t markid);
 void m5Syscall(ThreadContext *tc);
 void togglesync(ThreadContext *tc);
 void triggerWorkloadEvent(ThreadContext *tc);
@@ -233,6 +234,10 @@ pseudoInstWork(ThreadContext *tc, uint8_t func, uint64_t &result)
         invokeSimcall<ABI>(tc, workend);
         return true;
 
+      case M5OP_WORK_MARK:
+        invokeSimcall<ABI>(tc, workmark);
+        return true;
+
       case M5OP_RESERVED1:
       case M5OP_RESERVED2:
       case M5OP_RESERVED3:
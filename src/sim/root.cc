@@ -39,15 +39,21 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
+#include <functional>
+
 #include "base/hostinfo.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/TimeSync.hh"
+#include "mem/packet_pool.hh"
 #include "sim/core.hh"
 #include "sim/cur_tick.hh"
 #include "sim/eventq.hh"
 #include "sim/full_system.hh"
+#include "sim/global_event.hh"
 #include "sim/root.hh"
+#include "sim/simulate.hh"
 
 namespace gem5
 {
@@ -75,9 +81,12 @@ Root::RootStats::RootStats()
              "The number of ticks simulated per host second (ticks/s)"),
     ADD_STAT(hostMemory, statistics::units::Byte::get(),
              "Number of bytes of host memory used"),
+    ADD_STAT(hostStartupSeconds, statistics::units::Second::get(),
+             "Real time spent in each phase of the simulator start up"),
 
     statTime(true),
-    startTick(0)
+    startTick(0),
+    lastStartupMark(true)
 {
     simFreq.scalar(sim_clock::Frequency);
     simTicks.functor([this]() { return curTick() - startTick; });
@@ -99,6 +108,15 @@ Root::RootStats::RootStats()
 
     hostTickRate.precision(0);
 
+    hostStartupSeconds
+        .init(NumStartupPhases)
+        .subname(StartupPython, "python")
+        .subname(StartupConfig, "config")
+        .subname(StartupInstantiate, "instantiate")
+        .subname(StartupStartup, "startup")
+        .precision(3)
+        ;
+
     simSeconds = simTicks / simFreq;
     hostTickRate = simTicks / hostSeconds;
 }
@@ -110,6 +128,163 @@ Root::RootStats::resetStats()
     startTick = curTick();
 
     statistics::Group::resetStats();
+
+    for (int phase = 0; phase < NumStartupPhases; ++phase)
+        hostStartupSeconds[phase] = startupSeconds[phase];
+}
+
+void
+Root::RootStats::markStartup(StartupPhase phase)
+{
+    if (startupMarked[phase])
+        return;
+
+    Time now;
+    now.setTimer();
+    startupSeconds[phase] = now - lastStartupMark;
+    startupMarked[phase] = true;
+    lastStartupMark = now;
+
+    hostStartupSeconds[phase] = startupSeconds[phase];
+}
+
+Root::EventQueueStats::EventQueueStats(statistics::Group *parent,
+                                       uint32_t index)
+    : statistics::Group(parent, csprintf("queue%d", index).c_str()),
+    ADD_STAT(events, statistics::units::Count::get(),
+             "Number of events serviced"),
+    ADD_STAT(asyncInserts, statistics::units::Count::get(),
+             "Number of events scheduled from other threads"),
+    ADD_STAT(hostSeconds, statistics::units::Second::get(),
+             "Host time spent servicing events"),
+    ADD_STAT(barrierSeconds, statistics::units::Second::get(),
+             "Host time spent waiting for the other queues"),
+    ADD_STAT(eventRate, statistics::units::Rate<
+                statistics::units::Count, statistics::units::Second>::get(),
+             "Events serviced per host second while running (events/s)"),
+    ADD_STAT(barrierFraction, statistics::units::Ratio::get(),
+             "Fraction of the host time spent waiting for the other queues"),
+    eventq(mainEventQueue[index]),
+    startEvents(0), startInserts(0), startBusy(0), startBarrier(0)
+{
+    events.functor([this]() {
+            return eventq->eventsServiced() - startEvents;
+        });
+    asyncInserts.functor([this]() {
+            return eventq->asyncInserts() - startInserts;
+        });
+    hostSeconds
+        .functor([this]() { return eventq->hostBusySeconds() - startBusy; })
+        .precision(2)
+        ;
+    barrierSeconds
+        .functor([this]() {
+                return eventq->hostBarrierSeconds() - startBarrier;
+            })
+        .precision(2)
+        ;
+
+    eventRate.precision(0);
+    eventRate = events / hostSeconds;
+    barrierFraction = barrierSeconds / (hostSeconds + barrierSeconds);
+}
+
+Root::QuantumStats::QuantumStats(statistics::Group *parent)
+    : statistics::Group(parent, "quantum"),
+    ADD_STAT(quantum, statistics::units::Tick::get(),
+             "Current simulation quantum"),
+    ADD_STAT(quanta, statistics::units::Tick::get(),
+             "Length of the quanta"),
+    ADD_STAT(crossings, statistics::units::Count::get(),
+             "Number of events that crossed event queues in a quantum"),
+    ADD_STAT(grows, statistics::units::Count::get(),
+             "Number of times the quantum grew"),
+    ADD_STAT(shrinks, statistics::units::Count::get(),
+             "Number of times the quantum shrank")
+{
+    quantum.functor([]() { return simQuantum; });
+    quanta.init(16);
+    crossings.init(16);
+}
+
+void
+Root::EventQueueStats::resetStats()
+{
+    startEvents = eventq->eventsServiced();
+    startInserts = eventq->asyncInserts();
+    startBusy = eventq->hostBusySeconds();
+    startBarrier = eventq->hostBarrierSeconds();
+
+    statistics::Group::resetStats();
+}
+
+namespace
+{
+
+/** Calls Root::reportProgress() with all the event queues stopped. */
+class ProgressEvent : public GlobalEvent
+{
+  private:
+    std::function<void()> report;
+
+  public:
+    ProgressEvent(Tick when, std::function<void()> _report)
+        : GlobalEvent(when, Stat_Event_Pri, AutoDelete), report(_report)
+    {
+    }
+
+    void process() override { report(); }
+
+    const char *description() const override { return "ProgressEvent"; }
+};
+
+Counter
+simulatedInsts(const statistics::Group &root)
+{
+    auto *info = dynamic_cast<const statistics::ScalarInfo *>(
+            root.resolveStat("simInsts"));
+    return info ? info->result() : 0;
+}
+
+} // anonymous namespace
+
+void
+Root::reportProgress()
+{
+    Time now;
+    now.setTimer();
+    const double seconds = now - progress.time;
+    const Counter insts = simulatedInsts(*this);
+
+    Counter events = 0;
+    for (uint32_t i = 0; i < numMainEventQueues; i++)
+        events += mainEventQueue[i]->eventsServiced() - progress.events[i];
+
+    // The instruction count restarts when the stats are reset.
+    const Counter new_insts =
+        insts >= progress.insts ? insts - progress.insts : insts;
+    inform("progress: tick %d, %.2f host s, %.3f MIPS, %.0f events/s",
+           curTick(), seconds, new_insts / seconds / 1e6, events / seconds);
+
+    for (uint32_t i = 0; i < numMainEventQueues; i++) {
+        EventQueue *eventq = mainEventQueue[i];
+        const Counter serviced =
+            eventq->eventsServiced() - progress.events[i];
+        const double barrier =
+            eventq->hostBarrierSeconds() - progress.barrier[i];
+        if (numMainEventQueues > 1) {
+            inform("progress:   queue %d: %.0f events/s, %.1f%% in barriers",
+                   i, serviced / seconds, 100 * barrier / seconds);
+        }
+        progress.events[i] = eventq->eventsServiced();
+        progress.barrier[i] = eventq->hostBarrierSeconds();
+    }
+
+    progress.time = now;
+    progress.insts = insts;
+
+    const Tick period = params().progress_period;
+    new ProgressEvent(curTick() + period, [this]() { reportProgress(); });
 }
 
 /*
@@ -177,7 +352,11 @@ Root::timeSyncSpinThreshold(Time newThreshold)
 
 Root::Root(const RootParams &p, int)
     : SimObject(p), _enabled(false), _periodTick(p.time_sync_period),
-      syncEvent([this]{ timeSync(); }, name())
+      syncEvent([this]{ timeSync(); }, name()),
+      eventQueueGroup(this, "eventQueues"),
+      _adaptiveQuantum(p.adaptive_quantum), minQuantum(0), maxQuantum(0),
+      quantumCrossings(p.quantum_crossings), lastCrossings(0),
+      avgCrossings(0)
 {
     _period.setTick(p.time_sync_period);
     _spinThreshold.setTick(p.time_sync_spin_threshold);
@@ -186,19 +365,115 @@ Root::Root(const RootParams &p, int)
     _root = this;
     lastTime.setTimer();
 
+    rootStats.markStartup(RootStats::StartupConfig);
+
     simQuantum = p.sim_quantum;
+    numSimulatorThreads = p.sim_threads;
+    simulatorThreadCpus = p.sim_thread_cpus;
+
+    calendarEventQueues = p.calendar_event_queue;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->useCalendarQueue(calendarEventQueues);
 
     // Some of the statistics are global and need to be accessed by
     // stat formulas. The most convenient way to implement that is by
     // having a single global stat group for global stats. Merge that
     // group into the root object here.
     mergeStatGroup(&Root::RootStats::instance);
+
+    // The packet pools are process wide as well; report their hit and
+    // miss counts under the root object.
+    addStatGroup("packetPools", &packetPoolStats());
+
+    for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+        eventQueueStats.push_back(
+            std::make_unique<EventQueueStats>(&eventQueueGroup, i));
+    }
+
+    if (_adaptiveQuantum)
+        quantumStats = std::make_unique<QuantumStats>(this);
+}
+
+void
+Root::startQuantumAdaptation()
+{
+    // Without an explicit bound, the quantum grows up to the latency of
+    // the links between the queues, and doesn't grow if there is none.
+    const Tick base = params().sim_quantum;
+    maxQuantum = params().max_sim_quantum;
+    if (!maxQuantum) {
+        maxQuantum =
+            simQuantumLookahead != MaxTick ? simQuantumLookahead : base;
+    }
+    maxQuantum = std::min(maxQuantum, simQuantumLookahead);
+
+    minQuantum = params().min_sim_quantum;
+    if (!minQuantum)
+        minQuantum = std::max<Tick>(base / 16, 1);
+    minQuantum = std::min(minQuantum, maxQuantum);
+
+    simQuantum = std::clamp(simQuantum, minQuantum, maxQuantum);
+
+    lastCrossings = 0;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        lastCrossings += mainEventQueue[i]->asyncInserts();
+}
+
+Tick
+Root::adaptQuantum(Tick quantum)
+{
+    Counter inserts = 0;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        inserts += mainEventQueue[i]->asyncInserts();
+
+    // Each sync schedules itself on every queue through the async queues,
+    // which isn't traffic between the queues.
+    const Counter since_last = inserts - lastCrossings;
+    const Counter crossings = since_last > numMainEventQueues ?
+        since_last - numMainEventQueues : 0;
+    lastCrossings = inserts;
+
+    quantumStats->quanta.sample(quantum);
+    quantumStats->crossings.sample(crossings);
+
+    // Smooth the traffic over a few quanta so that a single burst doesn't
+    // move the quantum. Halving or doubling the quantum moves the traffic
+    // by a factor of two, which stays inside the band around the target
+    // and lets the quantum settle.
+    avgCrossings = (3 * avgCrossings + crossings) / 4;
+    if (avgCrossings > 2.0 * quantumCrossings && quantum > minQuantum) {
+        quantum = std::max(quantum / 2, minQuantum);
+        avgCrossings /= 2;
+        ++quantumStats->shrinks;
+    } else if (avgCrossings < quantumCrossings / 2.0 &&
+               quantum < maxQuantum) {
+        quantum = std::min(quantum * 2, maxQuantum);
+        avgCrossings *= 2;
+        ++quantumStats->grows;
+    }
+
+    simQuantum = quantum;
+    return quantum;
 }
 
 void
 Root::startup()
 {
+    rootStats.markStartup(RootStats::StartupInstantiate);
+
     timeSyncEnable(params().time_sync_enable);
+
+    if (params().progress_period) {
+        progress.time.setTimer();
+        progress.insts = simulatedInsts(*this);
+        for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+            progress.events.push_back(mainEventQueue[i]->eventsServiced());
+            progress.barrier.push_back(
+                    mainEventQueue[i]->hostBarrierSeconds());
+        }
+        new ProgressEvent(curTick() + params().progress_period,
+                          [this]() { reportProgress(); });
+    }
 }
 
 void
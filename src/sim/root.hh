@@ -51,6 +51,10 @@
 #ifndef __SIM_ROOT_HH__
 #define __SIM_ROOT_HH__
 
+#include <array>
+#include <memory>
+#include <vector>
+
 #include "base/statistics.hh"
 #include "base/time.hh"
 #include "base/types.hh"
@@ -110,6 +114,32 @@ class Root : public SimObject
         statistics::Formula hostTickRate;
         statistics::Value hostMemory;
 
+        /** Phases of the start up of the simulator, in order. */
+        enum StartupPhase
+        {
+            /** Starting the Python interpreter */
+            StartupPython,
+            /** Importing m5 and running the configuration script */
+            StartupConfig,
+            /** Creating the SimObjects, init() and initState() */
+            StartupInstantiate,
+            /** startup() and anything else until the first tick */
+            StartupStartup,
+            NumStartupPhases
+        };
+
+        /**
+         * Host time spent in each start up phase. These are not reset with
+         * the other stats.
+         */
+        statistics::Vector hostStartupSeconds;
+
+        /**
+         * Record the end of a start up phase. Only the first call for each
+         * phase counts.
+         */
+        void markStartup(StartupPhase phase);
+
         static RootStats instance;
 
       private:
@@ -120,8 +150,103 @@ class Root : public SimObject
 
         Time statTime;
         Tick startTick;
+
+        /** The end of the last start up phase, or the process start */
+        Time lastStartupMark;
+        std::array<double, NumStartupPhases> startupSeconds = {};
+        std::array<bool, NumStartupPhases> startupMarked = {};
     };
 
+    /** Simulation throughput of one of the main event queues. */
+    struct EventQueueStats : public statistics::Group
+    {
+        EventQueueStats(statistics::Group *parent, uint32_t index);
+
+        void resetStats() override;
+
+        statistics::Value events;
+        statistics::Value asyncInserts;
+        statistics::Value hostSeconds;
+        statistics::Value barrierSeconds;
+
+        statistics::Formula eventRate;
+        statistics::Formula barrierFraction;
+
+      private:
+        EventQueue *eventq;
+
+        Counter startEvents;
+        Counter startInserts;
+        double startBusy;
+        double startBarrier;
+    };
+
+    /** The quantum of a multi-queue simulation, when it adapts. */
+    struct QuantumStats : public statistics::Group
+    {
+        QuantumStats(statistics::Group *parent);
+
+        statistics::Value quantum;
+        statistics::Histogram quanta;
+        statistics::Histogram crossings;
+        statistics::Scalar grows;
+        statistics::Scalar shrinks;
+    };
+
+  protected:
+    statistics::Group eventQueueGroup;
+    std::vector<std::unique_ptr<EventQueueStats>> eventQueueStats;
+
+    /** Host time and counters at the previous progress report. */
+    struct Progress
+    {
+        Time time;
+        Counter insts;
+        std::vector<Counter> events;
+        std::vector<double> barrier;
+    } progress;
+
+    /**
+     * Print how fast the simulation ran since the previous report,
+     * overall and for every event queue, and schedule the next report.
+     */
+    void reportProgress();
+
+    /** @{ */
+    /** Adaptive quantum, see adaptQuantum(). */
+    const bool _adaptiveQuantum;
+    Tick minQuantum;
+    Tick maxQuantum;
+    const Counter quantumCrossings;
+    /** Events inserted asynchronously by the previous sync */
+    Counter lastCrossings;
+    /** Smoothed number of events crossing queues per quantum */
+    double avgCrossings;
+    std::unique_ptr<QuantumStats> quantumStats;
+    /** @} */
+
+  public:
+    /** Check whether the quantum adapts to the cross-queue traffic. */
+    bool adaptiveQuantum() const { return _adaptiveQuantum; }
+
+    /**
+     * Work out the bounds of the quantum, once all the links between the
+     * event queues declared their lookahead, before the queues start
+     * running in parallel.
+     */
+    void startQuantumAdaptation();
+
+    /**
+     * Pick the quantum that follows the one that just ended, from the
+     * number of events that crossed event queues during it. Many
+     * crossings shrink the quantum, as every one of them is delayed to
+     * the next quantum, and few grow it to synchronize less often.
+     *
+     * @param quantum The quantum that just ended.
+     * @return The next quantum, which also becomes simQuantum.
+     */
+    Tick adaptQuantum(Tick quantum);
+
   public:
 
     /// Check whether time syncing is enabled.
@@ -71,6 +71,13 @@ SEWorkload::syscall(ThreadContext *tc)
     tc->getProcessPtr()->syscall(tc);
 }
 
+std::recursive_mutex &
+SEWorkload::emulationLock()
+{
+    static std::recursive_mutex lock;
+    return lock;
+}
+
 Addr
 SEWorkload::allocPhysPages(int npages, int pool_id)
 {
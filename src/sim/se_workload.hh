@@ -28,6 +28,8 @@
 #ifndef __SIM_SE_WORKLOAD_HH__
 #define __SIM_SE_WORKLOAD_HH__
 
+#include <mutex>
+
 #include "params/SEWorkload.hh"
 #include "sim/mem_pool.hh"
 #include "sim/workload.hh"
@@ -89,6 +91,15 @@ class SEWorkload : public Workload
     // For now, assume the only type of events are system calls.
     void event(ThreadContext *tc) override { syscall(tc); }
 
+    /**
+     * Lock serializing the emulated OS, i.e. syscalls and page fault
+     * fixups. The threads of one process may be simulated by different
+     * event queues in parallel mode, and they share the process state,
+     * its memory state and the futex map. The lock is recursive since
+     * fault fixups also happen while syscalls copy data in and out.
+     */
+    static std::recursive_mutex &emulationLock();
+
     Addr allocPhysPages(int npages, int pool_id=0);
     void deallocPhysPage(Addr paddr, int pool_id=0);
     Addr memSize(int pool_id=0) const;
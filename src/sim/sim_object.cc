@@ -29,7 +29,10 @@
 
 #include "sim/sim_object.hh"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <thread>
 
 #include "base/logging.hh"
 #include "base/match.hh"
@@ -145,6 +148,35 @@ SimObject::serializeAll(const std::string &cpt_dir)
    }
 }
 
+void
+SimObject::forEachInParallel(const std::vector<SimObject *> &objects,
+                             void (SimObject::*phase)(), unsigned threads)
+{
+    std::vector<SimObject *> parallel;
+    for (auto *obj : objects) {
+        if (threads > 1 && obj->parallelInitSafe())
+            parallel.push_back(obj);
+        else
+            (obj->*phase)();
+    }
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < parallel.size(); i = next++)
+            (parallel[i]->*phase)();
+    };
+
+    // The calling thread is one of the workers.
+    std::vector<std::thread> pool;
+    size_t num_threads = std::min<size_t>(threads, parallel.size());
+    for (size_t t = 1; t < num_threads; t++)
+        pool.emplace_back(worker);
+    worker();
+
+    for (auto &thread : pool)
+        thread.join();
+}
+
 SimObject *
 SimObject::find(const char *name)
 {
@@ -279,11 +279,44 @@ class SimObject : public EventManager, public Serializable, public Drainable,
      */
     virtual void startup();
 
+    /**
+     * Whether init(), initState() and startup() of this object may run at
+     * the same time as those of other objects that say so. They must then
+     * only touch the state of this object: no other objects, no events,
+     * and nothing shared between objects other than the heap.
+     *
+     * @ingroup api_simobject
+     */
+    virtual bool parallelInitSafe() const { return false; }
+
+    /**
+     * Call one of the initialization phases, like init() or startup(), on
+     * each of the objects. The objects that aren't parallelInitSafe() are
+     * called first, in order, then the others are called on up to the
+     * given number of threads.
+     *
+     * @param objects Objects to initialize
+     * @param phase The phase to call
+     * @param threads Maximum number of threads to use
+     *
+     * @ingroup api_simobject
+     */
+    static void forEachInParallel(const std::vector<SimObject *> &objects,
+                                  void (SimObject::*phase)(),
+                                  unsigned threads);
+
     /**
      * Provide a default implementation of the drain interface for
-     * objects that don't need draining.
+     * objects that don't need draining. This also tells the drain
+     * manager that it doesn't need to call drain() again, so objects
+     * overriding drain() must not call it.
      */
-    DrainState drain() override { return DrainState::Drained; }
+    DrainState
+    drain() override
+    {
+        drainAlwaysDone();
+        return DrainState::Drained;
+    }
 
     /**
      * Write back dirty buffers to memory using functional writes.
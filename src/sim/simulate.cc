@@ -42,8 +42,19 @@
 
 #include "sim/simulate.hh"
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+
+#endif
+
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "base/logging.hh"
 #include "base/pollevent.hh"
@@ -52,7 +63,9 @@
 #include "debug/EnteringEventQueue.hh"
 #include "sim/async.hh"
 #include "sim/eventq.hh"
+#include "sim/global_event.hh"
 #include "sim/init_signals.hh"
+#include "sim/root.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
 #include "sim/stat_control.hh"
@@ -62,9 +75,31 @@ namespace gem5
 
 //! forward declaration
 Event *doSimLoop(EventQueue *);
+static bool processAsyncEvents(EventQueue *eventq);
 
 GlobalSimLoopExitEvent *simulate_limit_event = nullptr;
 
+uint32_t numSimulatorThreads = 0;
+std::vector<int> simulatorThreadCpus;
+
+/**
+ * Host threads running the main event queues.
+ *
+ * By default, every event queue is pinned to its own host thread and
+ * the threads synchronize on the barrier of each global event.
+ *
+ * When fewer host threads than event queues are requested (see
+ * numSimulatorThreads), the queues are instead multiplexed onto a
+ * work-stealing pool. A queue is a task that runs until its head is
+ * the local instance of a global event, at which point the queue has
+ * arrived at the barrier and the worker picks another runnable queue,
+ * stealing from the other workers if its own deque is empty. The last
+ * queue to arrive services the local barrier events of all queues in
+ * turn (see BaseGlobalEvent::sequentialBarriers) and makes the queues
+ * runnable again. GlobalSyncEvent therefore still enforces the
+ * simulation quantum, but a thread is never blocked on a barrier while
+ * there are queues left to run.
+ */
 class SimulatorThreads
 {
   public:
@@ -72,12 +107,19 @@ class SimulatorThreads
     SimulatorThreads(const SimulatorThreads &) = delete;
     SimulatorThreads &operator=(SimulatorThreads &) = delete;
 
-    SimulatorThreads(uint32_t num_queues)
+    SimulatorThreads(uint32_t num_queues, uint32_t num_threads = 0)
         : terminate(false),
           numQueues(num_queues),
-          barrier(num_queues)
+          numThreads(num_threads && num_threads < num_queues ?
+                     num_threads : num_queues),
+          barrier(num_queues),
+          work(new WorkDeque[numThreads]),
+          runnable(0), arrived(0), running(false), exitEvent(nullptr)
     {
-        threads.reserve(num_queues);
+        threads.reserve(numThreads);
+
+        // The main thread runs queue 0, or is worker 0 of the pool.
+        pinThread(0);
     }
 
     ~SimulatorThreads()
@@ -92,9 +134,12 @@ class SimulatorThreads
         terminateThreads();
     }
 
+    bool pooled() const { return numThreads < numQueues; }
+
     void runUntilLocalExit()
     {
         assert(!terminate);
+        assert(!pooled());
 
         // Start subordinate threads if needed.
         if (threads.empty()) {
@@ -103,7 +148,8 @@ class SimulatorThreads
             // We'll call these the "subordinate" threads.
             for (uint32_t i = 1; i < numQueues; i++) {
                 threads.emplace_back(
-                    [this](EventQueue *eq) {
+                    [this, i](EventQueue *eq) {
+                        pinThread(i);
                         thread_main(eq);
                     }, mainEventQueue[i]);
             }
@@ -116,6 +162,47 @@ class SimulatorThreads
         barrier.wait();
     }
 
+    /**
+     * Run the event queues on the work-stealing pool until queue 0
+     * services an exit event. Must be called from the main thread,
+     * which acts as worker 0.
+     *
+     * @return The local exit event serviced by queue 0.
+     */
+    Event *
+    runPool()
+    {
+        assert(pooled());
+
+        if (threads.empty()) {
+            for (uint32_t i = 1; i < numThreads; i++)
+                threads.emplace_back([this, i]() { pool_main(i); });
+        }
+
+        // Merge events inserted while the simulation was stopped, this
+        // is what doSimLoop() does when entering the loop.
+        EventQueue *main_queue = curEventQueue();
+        for (uint32_t i = 0; i < numQueues; i++) {
+            curEventQueue(mainEventQueue[i]);
+            mainEventQueue[i]->handleAsyncInsertions();
+        }
+        curEventQueue(main_queue);
+
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            running = true;
+            exitEvent = nullptr;
+        }
+        enqueueAll();
+
+        workerLoop(0);
+
+        for (uint32_t i = 0; i < numQueues; i++)
+            mainEventQueue[i]->hostIdle();
+        curEventQueue(mainEventQueue[0]);
+        return exitEvent;
+    }
+
     void
     terminateThreads()
     {
@@ -126,10 +213,15 @@ class SimulatorThreads
         /* This function should only be called when the simulator is
          * handling a global exit event (typically from Python). This
          * means that the helper threads will be waiting on the
-         * barrier. Tell the helper threads to exit and release them from
-         * their barrier. */
+         * barrier (or idle in the pool). Tell the helper threads to exit
+         * and release them. */
         terminate = true;
-        barrier.wait();
+        if (pooled()) {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            poolCond.notify_all();
+        } else {
+            barrier.wait();
+        }
 
         /* Wait for all of the threads to terminate */
         for (auto &t : threads) {
@@ -161,10 +253,193 @@ class SimulatorThreads
         }
     }
 
+    /** Main function of the subordinate workers of the pool. */
+    void
+    pool_main(uint32_t worker)
+    {
+        pinThread(worker);
+        workerLoop(worker);
+    }
+
+    /** Pin the calling thread to its host CPU, if any were given. */
+    static void
+    pinThread(uint32_t index)
+    {
+        if (simulatorThreadCpus.empty())
+            return;
+
+        int cpu = simulatorThreadCpus[index % simulatorThreadCpus.size()];
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        warn_if(pthread_setaffinity_np(pthread_self(), sizeof(set), &set),
+                "Could not pin simulator thread %d to host CPU %d\n",
+                index, cpu);
+#else
+        warn_once("Simulator threads can only be pinned on Linux hosts\n");
+#endif
+    }
+
+    /** Runnable queues owned by a worker. */
+    struct WorkDeque
+    {
+        std::mutex mutex;
+        std::deque<uint32_t> queues;
+    };
+
+    /**
+     * Get a runnable queue, first from the front of the worker's own
+     * deque and otherwise from the back of another worker's deque.
+     */
+    bool
+    nextQueue(uint32_t worker, uint32_t &queue)
+    {
+        for (uint32_t i = 0; i < numThreads; i++) {
+            WorkDeque &wd = work[(worker + i) % numThreads];
+            std::lock_guard<std::mutex> lock(wd.mutex);
+            if (wd.queues.empty())
+                continue;
+
+            if (i == 0) {
+                queue = wd.queues.front();
+                wd.queues.pop_front();
+            } else {
+                queue = wd.queues.back();
+                wd.queues.pop_back();
+            }
+            runnable--;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Make all queues runnable. Queues are always handed back to the
+     * same worker to keep their state in that worker's caches unless
+     * the queue is stolen.
+     */
+    void
+    enqueueAll()
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        for (uint32_t i = 0; i < numQueues; i++) {
+            WorkDeque &wd = work[i % numThreads];
+            std::lock_guard<std::mutex> wd_lock(wd.mutex);
+            wd.queues.push_back(i);
+        }
+        runnable += numQueues;
+        poolCond.notify_all();
+    }
+
+    void
+    workerLoop(uint32_t worker)
+    {
+        const bool main_thread = worker == 0;
+        while (true) {
+            uint32_t queue;
+            if (nextQueue(worker, queue)) {
+                runQueue(queue);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(poolMutex);
+            poolCond.wait(lock, [&]() {
+                return terminate || runnable > 0 ||
+                    (main_thread && !running);
+            });
+            if (terminate || (main_thread && !running))
+                return;
+        }
+    }
+
+    /**
+     * Service events on a queue until it arrives at the next global
+     * event.
+     */
+    void
+    runQueue(uint32_t index)
+    {
+        EventQueue *eventq = mainEventQueue[index];
+        curEventQueue(eventq);
+        eventq->hostRunning();
+
+        while (true) {
+            assert(!eventq->empty());
+            assert(curTick() <= eventq->nextTick() &&
+                   "event scheduled in the past");
+
+            if (eventq->getHead()->globalEvent())
+                break;
+
+            if (index == 0 && async_event && !processAsyncEvents(eventq))
+                panic("Asynchronous exception while running the event "
+                      "queues on a thread pool.\n");
+
+            Event *exit_event = eventq->serviceOne();
+            panic_if(exit_event, "Local exit event '%s' is not supported "
+                     "when running the event queues on a thread pool.",
+                     exit_event->description());
+        }
+
+        // Waiting for the other queues to reach the global event, and
+        // then for a worker to pick this queue up again.
+        eventq->hostWaiting();
+        if (++arrived == numQueues) {
+            arrived = 0;
+            serviceGlobalEvent();
+        }
+    }
+
+    /**
+     * Service the local instances of the global event at the head of
+     * every queue. Called by the worker running the last queue to
+     * arrive, so no other queue is running. Queues are serviced from
+     * last to first: the first one runs the global event's process()
+     * method (which typically schedules the next global event on all
+     * queues) and queue 0, which owns the global event if it is
+     * auto-deleted, comes last.
+     */
+    void
+    serviceGlobalEvent()
+    {
+        BaseGlobalEvent *global_event =
+            mainEventQueue[0]->getHead()->globalEvent();
+        Event *exit_event = nullptr;
+
+        for (uint32_t i = numQueues; i-- > 0;) {
+            EventQueue *eventq = mainEventQueue[i];
+            assert(eventq->getHead()->globalEvent() == global_event);
+            curEventQueue(eventq);
+            exit_event = eventq->serviceOne();
+        }
+
+        if (exit_event) {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            exitEvent = exit_event;
+            running = false;
+            poolCond.notify_all();
+        } else {
+            enqueueAll();
+        }
+    }
+
     std::atomic<bool> terminate;
     uint32_t numQueues;
+    uint32_t numThreads;
     std::vector<std::thread> threads;
     Barrier barrier;
+
+    /** @{ */
+    /** Work-stealing pool state. */
+    std::unique_ptr<WorkDeque[]> work;
+    std::atomic<uint32_t> runnable;
+    std::atomic<uint32_t> arrived;
+    std::mutex poolMutex;
+    std::condition_variable poolCond;
+    bool running;
+    Event *exitEvent;
+    /** @} */
 };
 
 static std::unique_ptr<SimulatorThreads> simulatorThreads;
@@ -195,6 +470,8 @@ simulate(Tick num_cycles)
     initSigInt();
     initSigCont();
 
+    rootStats.markStartup(Root::RootStats::StartupStartup);
+
     if (global_exit_event)//cleaning last global exit event
         global_exit_event->clean();
     std::unique_ptr<GlobalSyncEvent, DescheduleDeleter> quantum_event;
@@ -202,8 +479,11 @@ simulate(Tick num_cycles)
     DPRINTF(EnteringEventQueue, "Entering event queue @ %d. Starting "
         "simulation...\n", curTick());
 
-    if (!simulatorThreads)
-        simulatorThreads.reset(new SimulatorThreads(numMainEventQueues));
+    if (!simulatorThreads) {
+        simulatorThreads.reset(new SimulatorThreads(numMainEventQueues,
+                                                    numSimulatorThreads));
+        BaseGlobalEvent::sequentialBarriers = simulatorThreads->pooled();
+    }
 
     if (!simulate_limit_event) {
         // If the simulate_limit_event is not set, we set it to MaxTick.
@@ -227,15 +507,30 @@ simulate(Tick num_cycles)
         fatal_if(simQuantum == 0,
                  "Quantum for multi-eventq simulation not specified");
 
+        Root *root = Root::root();
+        if (root->adaptiveQuantum())
+            root->startQuantumAdaptation();
+
         quantum_event.reset(
             new GlobalSyncEvent(curTick() + simQuantum, simQuantum,
                                 EventBase::Progress_Event_Pri, 0));
+        if (root->adaptiveQuantum()) {
+            quantum_event->adaptRepeat = [root](Tick quantum) {
+                return root->adaptQuantum(quantum);
+            };
+        }
 
         inParallelMode = true;
     }
 
-    simulatorThreads->runUntilLocalExit();
-    Event *local_event = doSimLoop(mainEventQueue[0]);
+    Event *local_event = nullptr;
+    if (simulatorThreads->pooled()) {
+        curEventQueue(mainEventQueue[0]);
+        local_event = simulatorThreads->runPool();
+    } else {
+        simulatorThreads->runUntilLocalExit();
+        local_event = doSimLoop(mainEventQueue[0]);
+    }
     assert(local_event);
 
     // Restore normal ctrl-c operation as soon as the event queue is done
@@ -284,6 +579,48 @@ terminateEventQueueThreads()
 }
 
 
+/**
+ * Service asynchronous requests (signals, IO, stat dumps, ...) flagged
+ * by async_event. Must be called from the thread running queue 0.
+ *
+ * @return false if the simulation loop should be aborted.
+ */
+static bool
+processAsyncEvents(EventQueue *eventq)
+{
+    async_event = false;
+    // Take the event queue lock in case any of the service
+    // routines want to schedule new events.
+    std::lock_guard<EventQueue> lock(*eventq);
+    if (async_statdump || async_statreset) {
+        statistics::schedStatEvent(async_statdump, async_statreset);
+        async_statdump = false;
+        async_statreset = false;
+    }
+
+    if (async_io) {
+        async_io = false;
+        pollQueue.service();
+    }
+
+    if (async_exit) {
+        async_exit = false;
+        exitSimLoop("user interrupt received");
+    }
+
+    if (async_exception) {
+        async_exception = false;
+        return false;
+    }
+
+    if (async_hypercall) {
+        async_hypercall = false;
+        processExternalSignal();
+    }
+
+    return true;
+}
+
 /**
  * The main per-thread simulation loop. This loop is executed by all
  * simulation threads (the main thread and the subordinate threads) in
@@ -295,6 +632,7 @@ doSimLoop(EventQueue *eventq)
     // set the per thread current eventq pointer
     curEventQueue(eventq);
     eventq->handleAsyncInsertions();
+    eventq->hostRunning();
 
     bool mainQueue = eventq == getEventQueue(0);
 
@@ -305,39 +643,14 @@ doSimLoop(EventQueue *eventq)
         assert(curTick() <= eventq->nextTick() &&
                "event scheduled in the past");
 
-        if (mainQueue && async_event) {
-            async_event = false;
-            // Take the event queue lock in case any of the service
-            // routines want to schedule new events.
-            std::lock_guard<EventQueue> lock(*eventq);
-            if (async_statdump || async_statreset) {
-                statistics::schedStatEvent(async_statdump, async_statreset);
-                async_statdump = false;
-                async_statreset = false;
-            }
-
-            if (async_io) {
-                async_io = false;
-                pollQueue.service();
-            }
-
-            if (async_exit) {
-                async_exit = false;
-                exitSimLoop("user interrupt received");
-            }
-
-            if (async_exception) {
-                async_exception = false;
-                return NULL;
-            }
-            if (async_hypercall) {
-                async_hypercall = false;
-                processExternalSignal();
-            }
+        if (mainQueue && async_event && !processAsyncEvents(eventq)) {
+            eventq->hostIdle();
+            return NULL;
         }
 
         Event *exit_event = eventq->serviceOne();
         if (exit_event != NULL) {
+            eventq->hostIdle();
             return exit_event;
         }
     }
@@ -41,6 +41,8 @@
 #ifndef __SIMULATE_HH__
 #define __SIMULATE_HH__
 
+#include <vector>
+
 #include "base/types.hh"
 
 namespace gem5
@@ -80,6 +82,21 @@ void terminateEventQueueThreads();
 
 extern GlobalSimLoopExitEvent *simulate_limit_event;
 
+/**
+ * Number of host threads used to run the main event queues. Zero (the
+ * default) runs every event queue on its own thread. A smaller,
+ * non-zero number multiplexes the queues onto a work-stealing pool of
+ * that many threads.
+ */
+extern uint32_t numSimulatorThreads;
+
+/**
+ * Host CPUs to pin the simulator threads to. Thread i, which runs event
+ * queue i or is worker i of the pool, is pinned to entry i modulo the
+ * size of the list. Threads aren't pinned if the list is empty.
+ */
+extern std::vector<int> simulatorThreadCpus;
+
 } // namespace gem5
 
 #endif // __SIMULATE_HH__
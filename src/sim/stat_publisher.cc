@@ -0,0 +1,463 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/stat_publisher.hh"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "base/logging.hh"
+#include "base/statistics.hh"
+#include "base/stats/output.hh"
+#include "sim/global_event.hh"
+#include "sim/root.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+/** Samples waiting for the writer before the oldest is dropped. */
+constexpr size_t MaxQueuedSamples = 64;
+
+struct Column
+{
+    std::string name;
+    /** Report the change since the last sample rather than the value */
+    bool delta;
+};
+
+using Columns = std::vector<Column>;
+
+std::string
+subname(const std::vector<std::string> &subnames, size_t i)
+{
+    if (i < subnames.size() && !subnames[i].empty())
+        return subnames[i];
+    return std::to_string(i);
+}
+
+/**
+ * Reads the values of the selected stats. The tree is walked once to
+ * find the stats and name their columns; later samples only evaluate
+ * the stats found by that walk.
+ */
+class Collector : public Output
+{
+  public:
+    std::shared_ptr<const Columns> columns;
+    std::vector<double> values;
+
+    void
+    collect(Group &root)
+    {
+        if (!columns)
+            find(root, "");
+
+        values.clear();
+        for (current = 0; current < stats.size(); current++) {
+            stats[current]->prepare();
+            stats[current]->visit(*this);
+        }
+
+        if (names) {
+            columns = std::move(names);
+            statNames.clear();
+        }
+        assert(values.size() == columns->size());
+    }
+
+    void begin() override {}
+    void end() override {}
+    bool valid() const override { return true; }
+    void beginGroup(const char *name) override {}
+    void endGroup() override {}
+
+    void
+    visit(const ScalarInfo &info) override
+    {
+        add(info.result(), true, "");
+    }
+
+    void
+    visit(const VectorInfo &info) override
+    {
+        const VResult &result = info.result();
+        for (size_t i = 0; i < result.size(); i++)
+            add(result[i], true, subname(info.subnames, i));
+    }
+
+    void
+    visit(const DistInfo &info) override
+    {
+        const DistData &data = info.data;
+        add(data.samples, true, "samples");
+        add(data.samples ? data.sum / data.samples : 0, false, "mean");
+    }
+
+    void
+    visit(const FormulaInfo &info) override
+    {
+        const VResult &result = info.result();
+        if (result.size() == 1) {
+            add(result[0], false, "");
+            return;
+        }
+        for (size_t i = 0; i < result.size(); i++)
+            add(result[i], false, subname(info.subnames, i));
+    }
+
+    void visit(const VectorDistInfo &info) override {}
+    void visit(const Vector2dInfo &info) override {}
+    void visit(const SparseHistInfo &info) override {}
+
+  private:
+    /** Selected stats in the order they are sampled */
+    std::vector<Info *> stats;
+    /** Full names of the selected stats, only kept for the first sample */
+    std::vector<std::string> statNames;
+    /** Columns being named during the first sample */
+    std::unique_ptr<Columns> names;
+    /** Stat being visited */
+    size_t current = 0;
+
+    void
+    find(const Group &group, const std::string &path)
+    {
+        for (auto *info : group.getStats()) {
+            if (!info->flags.isSet(display))
+                continue;
+            std::string name = path.empty() ?
+                info->name : path + "." + info->name;
+            if (selected(name)) {
+                stats.push_back(info);
+                statNames.push_back(std::move(name));
+            }
+        }
+        for (const auto &[name, child] : group.getStatGroups())
+            find(*child, path.empty() ? name : path + "." + name);
+
+        if (path.empty())
+            names = std::make_unique<Columns>();
+    }
+
+    void
+    add(double value, bool delta, const std::string &sub)
+    {
+        if (names) {
+            const std::string &stat = statNames[current];
+            names->push_back({sub.empty() ? stat :
+                              stat + Info::separatorString + sub, delta});
+        }
+        values.push_back(value);
+    }
+};
+
+/**
+ * Owns the listen socket and the writer thread that turns samples into
+ * lines of JSON and sends them to the connected clients.
+ */
+class Publisher
+{
+  public:
+    Publisher(const ListenSocketConfig &config,
+              const std::vector<std::string> &patterns)
+        : listener(config.build("stats_publisher"))
+    {
+        collector.setFilter(patterns);
+        listener->listen();
+        inform("Publishing stats on %s", *listener);
+
+        panic_if(::pipe(wakeup) == -1, "Failed to create a pipe: %s",
+                 strerror(errno));
+        ::fcntl(wakeup[0], F_SETFL, O_NONBLOCK);
+        writer = std::thread([this]() { writerLoop(); });
+    }
+
+    ~Publisher()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake();
+        writer.join();
+
+        for (const auto &client : clients)
+            ::close(client.fd);
+        ::close(wakeup[0]);
+        ::close(wakeup[1]);
+    }
+
+    /** Read the stats and hand them to the writer. */
+    void
+    sample()
+    {
+        panic_if(!Root::root(), "Can't publish stats without a Root.");
+        collector.collect(*Root::root());
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queue.size() == MaxQueuedSamples) {
+                queue.pop_front();
+                dropped++;
+            }
+            queue.push_back({curTick(), collector.columns,
+                             collector.values});
+        }
+        wake();
+    }
+
+  private:
+    struct Sample
+    {
+        Tick tick;
+        std::shared_ptr<const Columns> columns;
+        std::vector<double> values;
+    };
+
+    struct Client
+    {
+        int fd;
+        /** Still needs the running totals */
+        bool fresh;
+    };
+
+    Collector collector;
+    ListenSocketPtr listener;
+
+    std::thread writer;
+    std::mutex mutex;
+    std::deque<Sample> queue;
+    uint64_t dropped = 0;
+    bool stopping = false;
+    int wakeup[2];
+
+    /** @{ */
+    /** Only used by the writer thread */
+    std::vector<Client> clients;
+    Sample last;
+    /** @} */
+
+    void
+    wake()
+    {
+        const char byte = 0;
+        [[maybe_unused]] auto ret = ::write(wakeup[1], &byte, 1);
+    }
+
+    void
+    writerLoop()
+    {
+        while (true) {
+            pollfd fds[] = {
+                { listener->getfd(), POLLIN, 0 },
+                { wakeup[0], POLLIN, 0 },
+            };
+            if (::poll(fds, 2, -1) == -1) {
+                if (errno == EINTR)
+                    continue;
+                panic("Stats publisher failed to poll: %s", strerror(errno));
+            }
+
+            if (fds[0].revents & POLLIN)
+                clients.push_back({ listener->accept(), true });
+
+            if (fds[1].revents & POLLIN) {
+                char buf[64];
+                while (::read(wakeup[0], buf, sizeof(buf)) > 0);
+            }
+
+            std::deque<Sample> samples;
+            uint64_t lost;
+            bool stop;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                samples.swap(queue);
+                lost = dropped;
+                dropped = 0;
+                stop = stopping;
+            }
+
+            for (auto &sample : samples) {
+                send(format(sample, lost), false);
+                lost = 0;
+                last = std::move(sample);
+            }
+            if (last.columns)
+                send(format(last, 0, true), true);
+
+            if (stop)
+                return;
+        }
+    }
+
+    /**
+     * Format a sample as the changes since the last one, or as the
+     * running totals for newly connected clients.
+     */
+    std::string
+    format(const Sample &sample, uint64_t lost, bool full = false) const
+    {
+        const bool same = last.columns == sample.columns;
+
+        std::ostringstream line;
+        line.precision(12);
+        line << "{\"tick\":" << sample.tick;
+        if (full)
+            line << ",\"full\":true";
+        if (lost)
+            line << ",\"dropped\":" << lost;
+        line << ",\"stats\":{";
+
+        bool first = true;
+        for (size_t i = 0; i < sample.values.size(); i++) {
+            const Column &column = (*sample.columns)[i];
+            double value = sample.values[i];
+            const double prev = same && !full ? last.values[i] : 0;
+            if (column.delta && !full)
+                value -= prev;
+            else if (!full && same && value == prev)
+                continue;
+            if (value == 0 && (column.delta || full))
+                continue;
+
+            line << (first ? "" : ",") << '"';
+            for (char c : column.name) {
+                if (c == '"' || c == '\\')
+                    line << '\\';
+                line << c;
+            }
+            line << "\":";
+            if (std::isfinite(value))
+                line << value;
+            else
+                line << "null";
+            first = false;
+        }
+        line << "}}\n";
+        return line.str();
+    }
+
+    /** Send a line to the clients, dropping those that went away. */
+    void
+    send(const std::string &line, bool fresh)
+    {
+        for (auto it = clients.begin(); it != clients.end();) {
+            if (it->fresh != fresh) {
+                ++it;
+                continue;
+            }
+            it->fresh = false;
+
+            bool ok = true;
+            for (size_t sent = 0; ok && sent < line.size();) {
+                const ssize_t ret = ::send(it->fd, line.data() + sent,
+                                           line.size() - sent, MSG_NOSIGNAL);
+                if (ret > 0)
+                    sent += ret;
+                else
+                    ok = ret == -1 && errno == EINTR;
+            }
+
+            if (ok) {
+                ++it;
+            } else {
+                ::close(it->fd);
+                it = clients.erase(it);
+            }
+        }
+    }
+};
+
+std::unique_ptr<Publisher> publisher;
+
+class PublishEvent : public GlobalEvent
+{
+  private:
+    Tick period;
+
+  public:
+    PublishEvent(Tick when, Tick _period)
+        : GlobalEvent(when, Stat_Event_Pri, AutoDelete), period(_period)
+    {
+    }
+
+    void
+    process() override
+    {
+        publisher->sample();
+        publishEvent = new PublishEvent(curTick() + period, period);
+    }
+
+    const char *description() const override { return "StatPublishEvent"; }
+
+    static PublishEvent *publishEvent;
+};
+
+PublishEvent *PublishEvent::publishEvent = nullptr;
+
+} // anonymous namespace
+
+void
+startPublishing(const ListenSocketConfig &config, Tick period,
+                const std::vector<std::string> &patterns)
+{
+    fatal_if(period == 0, "Stats must be published with a non-zero period.");
+    fatal_if(!config, "No socket to publish the stats on.");
+
+    stopPublishing();
+    publisher = std::make_unique<Publisher>(config, patterns);
+    // As with periodic dumps, wait for the event queues to sync.
+    PublishEvent::publishEvent =
+        new PublishEvent(curTick() + period + simQuantum, period);
+}
+
+void
+stopPublishing()
+{
+    auto *&event = PublishEvent::publishEvent;
+    if (event && event->scheduled())
+        event->deschedule();
+    event = nullptr;
+    publisher = nullptr;
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,74 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_STAT_PUBLISHER_HH__
+#define __SIM_STAT_PUBLISHER_HH__
+
+#include <string>
+#include <vector>
+
+#include "base/socket.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+/**
+ * Periodically stream the stats whose full names match one of the
+ * regular expressions to every client connected to a listen socket.
+ * Each sample is a JSON object on its own line:
+ *
+ *   {"tick":<tick>,"stats":{"<name>":<value>,...}}
+ *
+ * Scalars, vectors and distribution sample counts are reported as the
+ * change since the previous line; formulas and distribution means are
+ * reported as their current value, so counters go negative after a
+ * stats reset. Only values that changed are sent.
+ * A newly connected client first gets a line with "full":true holding
+ * the running totals.
+ *
+ * The stats are read on the simulation thread, while formatting and
+ * socket writes happen on a background thread. Samples are dropped,
+ * oldest first, if the clients can't keep up; the next line then
+ * carries a "dropped" count.
+ *
+ * @param config Socket to listen on, e.g. a TCP port or a UNIX socket.
+ * @param period Ticks between samples.
+ * @param patterns Regular expressions selecting the stats to send. All
+ *                 stats are sent if empty.
+ */
+void startPublishing(const ListenSocketConfig &config, Tick period,
+                     const std::vector<std::string> &patterns);
+
+/** Stop publishing and disconnect all clients. */
+void stopPublishing();
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __SIM_STAT_PUBLISHER_HH__
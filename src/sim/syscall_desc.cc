@@ -31,6 +31,7 @@
 
 #include "base/types.hh"
 #include "sim/eventq.hh"
+#include "sim/se_workload.hh"
 #include "sim/syscall_debug_macros.hh"
 
 namespace gem5
@@ -41,6 +42,8 @@ class ThreadContext;
 void
 SyscallDesc::doSyscall(ThreadContext *tc)
 {
+    std::lock_guard<std::recursive_mutex> lock(SEWorkload::emulationLock());
+
     DPRINTF_SYSCALL(Base, "Calling %s...\n", dumper(name(), tc));
 
     SyscallReturn retval = executor(this, tc);
@@ -60,6 +63,8 @@ SyscallDesc::doSyscall(ThreadContext *tc)
 void
 SyscallDesc::retrySyscall(ThreadContext *tc)
 {
+    std::lock_guard<std::recursive_mutex> lock(SEWorkload::emulationLock());
+
     DPRINTF_SYSCALL(Base, "Retrying %s...\n", dumper(name(), tc));
 
     SyscallReturn retval = executor(this, tc);
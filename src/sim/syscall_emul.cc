@@ -130,6 +130,7 @@ exitImpl(SyscallDesc *desc, ThreadContext *tc, bool group, int status)
         exitFutexWake(tc, p->childClearTID, p->tgid());
 
     bool last_thread = true;
+    int pending_halts = 0;
     Process *parent = nullptr, *tg_lead = nullptr;
     for (int i = 0; last_thread && i < sys->threads.size(); i++) {
         Process *walk;
@@ -169,7 +170,13 @@ exitImpl(SyscallDesc *desc, ThreadContext *tc, bool group, int status)
                  * all threads in the group.
                  */
                 if (*(p->exitGroup)) {
-                    tc->halt();
+                    runOnContextQueue(tc, [tc]() { tc->halt(); });
+                    // The halt is deferred if tc is simulated by
+                    // another event queue
+                    if (tc->status() != ThreadContext::Halted &&
+                        tc->status() != ThreadContext::Halting) {
+                        pending_halts++;
+                    }
                 } else {
                     last_thread = false;
                 }
@@ -213,7 +220,7 @@ exitImpl(SyscallDesc *desc, ThreadContext *tc, bool group, int status)
     if (!p->vforkContexts.empty()) {
         ThreadContext *vtc = sys->threads[p->vforkContexts.front()];
         assert(vtc->status() == ThreadContext::Suspended);
-        vtc->activate();
+        runOnContextQueue(vtc, [vtc]() { vtc->activate(); });
     }
 
     tc->halt();
@@ -222,7 +229,7 @@ exitImpl(SyscallDesc *desc, ThreadContext *tc, bool group, int status)
      * check to see if there is no more active thread in the system. If so,
      * exit the simulation loop
      */
-    int activeContexts = 0;
+    int activeContexts = -pending_halts;
     for (auto &system: sys->systemList)
         activeContexts += system->threads.numRunning();
 
@@ -416,7 +416,8 @@ futexFunc(SyscallDesc *desc, ThreadContext *tc,
     } else if (OS::TGT_FUTEX_WAKE == op) {
         return futex_map.wakeup(uaddr, process->tgid(), val);
     } else if (OS::TGT_FUTEX_WAKE_BITSET == op) {
-        return futex_map.wakeup_bitset(uaddr, process->tgid(), val3);
+        return futex_map.wakeup_bitset(uaddr, process->tgid(), val3,
+                                       val);
     } else if (OS::TGT_FUTEX_REQUEUE == op ||
                OS::TGT_FUTEX_CMP_REQUEUE == op) {
 
@@ -1854,7 +1855,7 @@ doClone(SyscallDesc *desc, ThreadContext *tc, RegVal flags, RegVal newStack,
 
     desc->returnInto(ctc, 0);
 
-    ctc->activate();
+    runOnContextQueue(ctc, [ctc]() { ctc->activate(); });
 
     if (flags & OS::TGT_CLONE_VFORK) {
         tc->suspend();
@@ -1935,25 +1936,21 @@ readvFunc(SyscallDesc *desc, ThreadContext *tc,
     int sim_fd = ffdp->getSimFD();
 
     SETranslatingPortProxy prox(tc);
-    auto tiov = std::make_unique<typename OS::tgt_iovec[]>(count);
-    auto hiov = std::make_unique<struct iovec[]>(count);
+    GuestIoBuffer buf(tc, true);
     for (typename OS::size_t i = 0; i < count; ++i) {
+        typename OS::tgt_iovec tiov;
+
         prox.readBlob(tiov_base + (i * sizeof(typename OS::tgt_iovec)),
-                      &tiov[i], sizeof(typename OS::tgt_iovec));
-        hiov[i].iov_len = gtoh(tiov[i].iov_len, OS::byteOrder);
-        hiov[i].iov_base = new char [hiov[i].iov_len];
+                      &tiov, sizeof(typename OS::tgt_iovec));
+        buf.add(gtoh(tiov.iov_base, OS::byteOrder),
+                gtoh(tiov.iov_len, OS::byteOrder));
     }
 
-    int result = readv(sim_fd, hiov.get(), count);
+    int result = readv(sim_fd, buf.iov(), buf.iovcnt());
     int local_errno = errno;
 
-    for (typename OS::size_t i = 0; i < count; ++i) {
-        if (result != -1) {
-            prox.writeBlob(htog(tiov[i].iov_base, OS::byteOrder),
-                           hiov[i].iov_base, hiov[i].iov_len);
-        }
-        delete [] (char *)hiov[i].iov_base;
-    }
+    if (result > 0)
+        buf.copyOut(result);
 
     return (result == -1) ? -local_errno : result;
 }
@@ -1973,22 +1970,18 @@ writevFunc(SyscallDesc *desc, ThreadContext *tc,
     int sim_fd = hbfdp->getSimFD();
 
     SETranslatingPortProxy prox(tc);
-    auto hiov = std::make_unique<struct iovec[]>(count);
+    GuestIoBuffer buf(tc, false);
     for (typename OS::size_t i = 0; i < count; ++i) {
         typename OS::tgt_iovec tiov;
 
         prox.readBlob(tiov_base + i*sizeof(typename OS::tgt_iovec),
                       &tiov, sizeof(typename OS::tgt_iovec));
-        hiov[i].iov_len = gtoh(tiov.iov_len, OS::byteOrder);
-        hiov[i].iov_base = new char [hiov[i].iov_len];
-        prox.readBlob(gtoh(tiov.iov_base, OS::byteOrder), hiov[i].iov_base,
-                      hiov[i].iov_len);
+        buf.add(gtoh(tiov.iov_base, OS::byteOrder),
+                gtoh(tiov.iov_len, OS::byteOrder));
     }
+    buf.copyIn();
 
-    int result = writev(sim_fd, hiov.get(), count);
-
-    for (typename OS::size_t i = 0; i < count; ++i)
-        delete [] (char *)hiov[i].iov_base;
+    int result = writev(sim_fd, buf.iov(), buf.iovcnt());
 
     return (result == -1) ? -errno : result;
 }
@@ -2149,11 +2142,13 @@ pread64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
-    BufferArg bufArg(bufPtr, nbytes);
+    GuestIoBuffer buf(tc, true);
+    buf.add(bufPtr, nbytes);
 
-    int bytes_read = pread(sim_fd, bufArg.bufferPtr(), nbytes, offset);
+    int bytes_read = preadv(sim_fd, buf.iov(), buf.iovcnt(), offset);
 
-    bufArg.copyOut(SETranslatingPortProxy(tc));
+    if (bytes_read > 0)
+        buf.copyOut(bytes_read);
 
     return (bytes_read == -1) ? -errno : bytes_read;
 }
@@ -2171,10 +2166,11 @@ pwrite64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
-    BufferArg bufArg(bufPtr, nbytes);
-    bufArg.copyIn(SETranslatingPortProxy(tc));
+    GuestIoBuffer buf(tc, false);
+    buf.add(bufPtr, nbytes);
+    buf.copyIn();
 
-    int bytes_written = pwrite(sim_fd, bufArg.bufferPtr(), nbytes, offset);
+    int bytes_written = pwritev(sim_fd, buf.iov(), buf.iovcnt(), offset);
 
     return (bytes_written == -1) ? -errno : bytes_written;
 }
@@ -2383,7 +2379,7 @@ execveFunc(SyscallDesc *desc, ThreadContext *tc,
     if (!p->vforkContexts.empty()) {
         ThreadContext *vtc = p->system->threads[p->vforkContexts.front()];
         assert(vtc->status() == ThreadContext::Suspended);
-        vtc->activate();
+        runOnContextQueue(vtc, [vtc]() { vtc->activate(); });
     }
 
     /**
@@ -2812,11 +2808,12 @@ readFunc(SyscallDesc *desc, ThreadContext *tc,
         && !(hbfdp->getFlags() & OS::TGT_O_NONBLOCK))
         return SyscallReturn::retry();
 
-    BufferArg buf_arg(buf_ptr, nbytes);
-    int bytes_read = read(sim_fd, buf_arg.bufferPtr(), nbytes);
+    GuestIoBuffer buf(tc, true);
+    buf.add(buf_ptr, nbytes);
+    int bytes_read = readv(sim_fd, buf.iov(), buf.iovcnt());
 
     if (bytes_read > 0)
-        buf_arg.copyOut(SETranslatingPortProxy(tc));
+        buf.copyOut(bytes_read);
 
     return (bytes_read == -1) ? -errno : bytes_read;
 }
@@ -2833,9 +2830,6 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = hbfdp->getSimFD();
 
-    BufferArg buf_arg(buf_ptr, nbytes);
-    buf_arg.copyIn(SETranslatingPortProxy(tc));
-
     struct pollfd pfd;
     pfd.fd = sim_fd;
     pfd.events = POLLOUT;
@@ -2852,7 +2846,11 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
             return SyscallReturn::retry();
     }
 
-    int bytes_written = write(sim_fd, buf_arg.bufferPtr(), nbytes);
+    GuestIoBuffer buf(tc, false);
+    buf.add(buf_ptr, nbytes);
+    buf.copyIn();
+
+    int bytes_written = writev(sim_fd, buf.iov(), buf.iovcnt());
 
     if (bytes_written != -1)
         fsync(sim_fd);
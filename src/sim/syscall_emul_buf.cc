@@ -0,0 +1,74 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/syscall_emul_buf.hh"
+
+#include <algorithm>
+
+namespace gem5
+{
+
+void
+GuestIoBuffer::add(Addr addr, uint64_t size)
+{
+    if (size == 0)
+        return;
+
+    const size_t old_size = hostIov.size();
+    if (proxy.hostRanges(addr, size, hostWrites, hostIov)) {
+        if (hostIov.size() <= MaxIovecs) {
+            totalSize += size;
+            return;
+        }
+        hostIov.resize(old_size);
+    }
+
+    // Some page has no back door, or the buffer is too fragmented on
+    // the host, so copy it as a whole
+    Bounce bounce{addr, size, totalSize, std::make_unique<uint8_t[]>(size)};
+    hostIov.push_back({bounce.data.get(), size});
+    bounces.push_back(std::move(bounce));
+    totalSize += size;
+}
+
+void
+GuestIoBuffer::copyIn()
+{
+    for (auto &bounce : bounces)
+        proxy.readBlob(bounce.addr, bounce.data.get(), bounce.size);
+}
+
+void
+GuestIoBuffer::copyOut(uint64_t len)
+{
+    for (auto &bounce : bounces) {
+        if (bounce.offset >= len)
+            break;
+        proxy.writeBlob(bounce.addr, bounce.data.get(),
+                        std::min(bounce.size, len - bounce.offset));
+    }
+}
+
+} // namespace gem5
@@ -35,7 +35,11 @@
 /// This file defines buffer classes used to handle pointer arguments
 /// in emulated syscalls.
 
+#include <sys/uio.h>
+
 #include <cstring>
+#include <memory>
+#include <vector>
 
 #include "base/types.hh"
 #include "mem/se_translating_port_proxy.hh"
@@ -168,6 +172,60 @@ class TypedBufferArg : public BaseBufferArg
     T &operator[](int i) { return ((T *)bufPtr)[i]; }
 };
 
+/**
+ * GuestIoBuffer gathers buffers in target user space into host iovecs
+ * for the vectored host I/O syscalls. Pages the CPU grants a back door
+ * to are accessed in place, without copying them; the others go through
+ * simulator-space bounce buffers, which copyIn() and copyOut() fill from
+ * and drain to target memory like BufferArg does.
+ */
+class GuestIoBuffer
+{
+  public:
+    /**
+     * @param tc Thread context whose address space holds the buffers.
+     * @param host_writes Whether the host syscall writes the buffers,
+     *        e.g. read() or readv().
+     */
+    GuestIoBuffer(ThreadContext *tc, bool host_writes)
+        : proxy(tc), hostWrites(host_writes)
+    {}
+
+    /** Append the buffer [addr, addr + size) to the iovecs. */
+    void add(Addr addr, uint64_t size);
+
+    const struct iovec *iov() const { return hostIov.data(); }
+    int iovcnt() const { return hostIov.size(); }
+
+    /** Copy target memory into the bounce buffers, if any. */
+    void copyIn();
+
+    /**
+     * Copy the first len bytes of the buffers back to target memory,
+     * where they went through bounce buffers.
+     */
+    void copyOut(uint64_t len);
+
+  private:
+    /** Linux' UIO_MAXIOV, past which readv and friends fail */
+    static constexpr size_t MaxIovecs = 1024;
+
+    struct Bounce
+    {
+        Addr addr;
+        uint64_t size;
+        /** Offset of the buffer in the data of the syscall */
+        uint64_t offset;
+        std::unique_ptr<uint8_t[]> data;
+    };
+
+    SETranslatingPortProxy proxy;
+    const bool hostWrites;
+    uint64_t totalSize = 0;
+    std::vector<struct iovec> hostIov;
+    std::vector<Bounce> bounces;
+};
+
 } // namespace gem5
 
 #endif // __SIM_SYSCALL_EMUL_BUF_HH__
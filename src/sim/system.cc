@@ -47,6 +47,7 @@
 #include "base/cprintf.hh"
 #include "base/loader/object_file.hh"
 #include "base/loader/symtab.hh"
+#include "base/output.hh"
 #include "base/str.hh"
 #include "base/trace.hh"
 #include "cpu/base.hh"
@@ -58,6 +59,7 @@
 #include "mem/physical.hh"
 #include "params/System.hh"
 #include "sim/byteswap.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
 #include "sim/redirect_path.hh"
 #include "sim/serialize_handlers.hh"
@@ -170,10 +172,16 @@ System::System(const Params &p)
                          p.external_memory_ranges.end()),
       multiThread(p.multi_thread),
       init_param(p.init_param),
-      physProxy(_systemPort, p.cache_line_size),
+      physProxy([this](PacketPtr pkt) { _systemPort.sendFunctional(pkt); },
+                [this](const MemBackdoorReq &req, MemBackdoorPtr &bd) {
+                    physBackdoorReq(req, bd);
+                }, p.cache_line_size),
       workload(p.workload),
       physmem(name() + ".physmem", p.memories, p.mmap_using_noreserve,
-              p.shared_backstore, p.auto_unlink_shared_backstore),
+              p.shared_backstore, p.auto_unlink_shared_backstore,
+              p.chunked_memory_checkpoint, p.memory_checkpoint_base,
+              p.memory_checkpoint_threads, p.mmap_memory_checkpoint,
+              p.mmap_populate, p.mmap_huge_pages, p.mmap_huge_page_size),
       ShadowRomRanges(p.shadow_rom_ranges.begin(),
                       p.shadow_rom_ranges.end()),
       memoryMode(p.mem_mode),
@@ -183,6 +191,7 @@ System::System(const Params &p)
       _m5opRange(p.m5ops_base ?
                  RangeSize(p.m5ops_base, 0x10000) :
                  AddrRange(1, 0)), // Create an empty range if disabled
+      workMarkBufferSize(std::max<size_t>(p.work_mark_buffer_size, 1)),
       redirectPaths(p.redirect_paths)
 {
     panic_if(!workload, "No workload set for system %s "
@@ -213,6 +222,9 @@ System::System(const Params &p)
     // Set back pointers to the system in all memories
     for (int x = 0; x < params().memories.size(); x++)
         params().memories[x]->system(this);
+
+    // Write out the work marks that are still buffered at exit
+    registerExitCallback([this]() { flushWorkMarks(); });
 }
 
 System::~System()
@@ -221,6 +233,40 @@ System::~System()
         delete workItemStats[j];
 }
 
+void
+System::flushWorkMarks()
+{
+    if (workMarks.empty())
+        return;
+
+    if (!workMarkStream) {
+        workMarkStream = simout.create(name() + ".work_marks.csv", false);
+        *workMarkStream->stream() << "tick,cpu,mark,insts\n";
+    }
+
+    std::ostream &os = *workMarkStream->stream();
+    for (const auto &mark : workMarks) {
+        ccprintf(os, "%d,%d,%d,%d\n", mark.tick, mark.cpuId, mark.markId,
+                 mark.insts);
+    }
+    os.flush();
+    workMarks.clear();
+}
+
+void
+System::startup()
+{
+    SimObject::startup();
+    started = true;
+}
+
+void
+System::physBackdoorReq(const MemBackdoorReq &req, MemBackdoorPtr &backdoor)
+{
+    if (!started || bypassCaches())
+        _systemPort.sendMemBackdoorReq(req, backdoor);
+}
+
 Port &
 System::getPort(const std::string &if_name, PortID idx)
 {
@@ -68,6 +68,7 @@ namespace gem5
 {
 
 class BaseRemoteGDB;
+class OutputStream;
 class KvmVM;
 class ThreadContext;
 
@@ -107,6 +108,18 @@ class System : public SimObject, public PCEventScope
     std::list<PCEvent *> liveEvents;
     SystemPort _systemPort;
 
+    /**
+     * Set once the simulation starts. Until then the caches are empty,
+     * so physProxy may access the memories through back doors.
+     */
+    bool started = false;
+
+    /**
+     * Forward a back door request from physProxy, unless a cache may hold
+     * newer data than the memory.
+     */
+    void physBackdoorReq(const MemBackdoorReq &req, MemBackdoorPtr &backdoor);
+
     // Map of memory address ranges for devices with their own backing stores
     std::unordered_map<RequestorID, std::vector<memory::AbstractMemory *>>
         deviceMemMap;
@@ -514,6 +527,7 @@ class System : public SimObject, public PCEventScope
   public:
 
     void regStats() override;
+    void startup() override;
     /**
      * Called by pseudo_inst to track the number of work items started by this
      * system.
@@ -555,6 +569,22 @@ class System : public SimObject, public PCEventScope
 
     void workItemEnd(uint32_t tid, uint32_t workid);
 
+    /**
+     * Called by pseudo_inst to record a work mark. This only buffers the
+     * mark, which is written out with the others once the buffer is full
+     * or the simulation exits.
+     */
+    void
+    recordWorkMark(int cpu_id, uint64_t mark_id, Counter insts)
+    {
+        if (workMarks.size() >= workMarkBufferSize)
+            flushWorkMarks();
+        workMarks.push_back({curTick(), insts, mark_id, cpu_id});
+    }
+
+    /** Write the buffered work marks out to <name>.work_marks.csv */
+    void flushWorkMarks();
+
     /* Returns whether we successfully trapped into GDB. */
     bool trapToGdb(GDBSignal signal, ContextID ctx_id) const;
 
@@ -589,6 +619,25 @@ class System : public SimObject, public PCEventScope
     std::map<std::pair<uint32_t, uint32_t>, Tick>  lastWorkItemStarted;
     std::map<uint32_t, statistics::Histogram*> workItemStats;
 
+  protected:
+    /** A mark recorded by the m5_work_mark pseudo op */
+    struct WorkMark
+    {
+        Tick tick;
+        Counter insts;
+        uint64_t markId;
+        int cpuId;
+    };
+
+    /** Work marks not written out yet */
+    std::vector<WorkMark> workMarks;
+    const size_t workMarkBufferSize;
+
+    /** File the work marks are written to, created with the first mark */
+    OutputStream *workMarkStream = nullptr;
+
+  public:
+
     ////////////////////////////////////////////
     //
     // STATIC GLOBAL SYSTEM LIST
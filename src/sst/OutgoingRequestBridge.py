@@ -37,3 +37,13 @@ class OutgoingRequestBridge(SimObject):
     physical_address_ranges = VectorParam.AddrRange(
         [AddrRange(0x80000000, MaxAddr)], "Physical address ranges."
     )
+    batch_requests = Param.Bool(
+        False,
+        "Buffer timing requests and forward them to SST in batches "
+        "instead of one at a time",
+    )
+    batch_lookahead = Param.Latency(
+        "0ns",
+        "Forward a batch once its oldest request has waited this long, "
+        "0 forwards batches only when SST regains control",
+    )
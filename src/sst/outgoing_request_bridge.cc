@@ -41,7 +41,10 @@ OutgoingRequestBridge::OutgoingRequestBridge(
     outgoingPort(std::string(name()), this),
     sstResponder(nullptr),
     physicalAddressRanges(params.physical_address_ranges.begin(),
-                          params.physical_address_ranges.end())
+                          params.physical_address_ranges.end()),
+    batchRequests(params.batch_requests),
+    batchLookahead(params.batch_lookahead),
+    flushEvent([this]{ flushRequests(); }, name() + ".flushEvent")
 {
 }
 
@@ -93,6 +96,31 @@ OutgoingRequestBridge::setResponder(SSTResponderInterface* responder)
     sstResponder = responder;
 }
 
+void
+OutgoingRequestBridge::handleRecvTimingReq(PacketPtr pkt)
+{
+    if (!batchRequests) {
+        sstResponder->handleRecvTimingReq(pkt);
+        return;
+    }
+
+    pendingRequests.push_back(pkt);
+    if (batchLookahead != 0 && !flushEvent.scheduled())
+        schedule(flushEvent, curTick() + batchLookahead);
+}
+
+void
+OutgoingRequestBridge::flushRequests()
+{
+    if (flushEvent.scheduled())
+        deschedule(flushEvent);
+    if (pendingRequests.empty())
+        return;
+
+    sstResponder->handleRecvTimingReqs(pendingRequests);
+    pendingRequests.clear();
+}
+
 bool
 OutgoingRequestBridge::sendTimingResp(gem5::PacketPtr pkt)
 {
@@ -133,7 +161,7 @@ bool
 OutgoingRequestBridge::
 OutgoingRequestPort::recvTimingReq(PacketPtr pkt)
 {
-    owner->sstResponder->handleRecvTimingReq(pkt);
+    owner->handleRecvTimingReq(pkt);
     return true;
 }
 
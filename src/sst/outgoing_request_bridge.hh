@@ -32,6 +32,7 @@
 
 #include "mem/port.hh"
 #include "params/OutgoingRequestBridge.hh"
+#include "sim/eventq.hh"
 #include "sim/sim_object.hh"
 #include "sst/sst_responder_interface.hh"
 
@@ -79,6 +80,17 @@ class OutgoingRequestBridge: public SimObject
 
     AddrRangeList physicalAddressRanges;
 
+  private:
+    // When batching, timing requests are buffered here and forwarded to
+    // SST together, either when SST regains control at the end of its
+    // clock period or once the oldest request has waited batchLookahead.
+    const bool batchRequests;
+    const Tick batchLookahead;
+    std::vector<PacketPtr> pendingRequests;
+    EventFunctionWrapper flushEvent;
+
+    void handleRecvTimingReq(PacketPtr pkt);
+
   public:
     OutgoingRequestBridge(const OutgoingRequestBridgeParams &params);
     ~OutgoingRequestBridge();
@@ -105,6 +117,10 @@ class OutgoingRequestBridge: public SimObject
     // corresponding port in SST.
     void setResponder(SSTResponderInterface* responder);
 
+    // Forwards the buffered timing requests to SST. gem5 Component (from
+    // SST) calls this after each simulated quantum.
+    void flushRequests();
+
     // This function is called when SST wants to sent a timing response to gem5
     bool sendTimingResp(PacketPtr pkt);
 
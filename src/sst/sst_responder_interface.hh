@@ -29,6 +29,7 @@
 #define __SST_RESPONDER_INTERFACE_HH__
 
 #include <string>
+#include <vector>
 
 #include "mem/port.hh"
 
@@ -54,6 +55,11 @@ class SSTResponderInterface
     // is called.
     virtual bool handleRecvTimingReq(PacketPtr pkt) = 0;
 
+    // This function is called when OutgoingRequestBridge forwards a batch
+    // of buffered gem5 requests to SST. By default, the requests are
+    // handled one by one.
+    virtual void handleRecvTimingReqs(const std::vector<PacketPtr> &pkts);
+
     // This function is called when OutogingRequestPort::recvRespRetry() is
     // called.
     virtual void handleRecvRespRetry() = 0;
@@ -28,8 +28,8 @@
 #ifndef __SYSTEMC_CORE_SCHED_EVENT_HH__
 #define __SYSTEMC_CORE_SCHED_EVENT_HH__
 
+#include <cassert>
 #include <functional>
-#include <list>
 
 #include "base/types.hh"
 
@@ -38,7 +38,30 @@ namespace sc_gem5
 
 class ScEvent;
 
-typedef std::list<ScEvent *> ScEvents;
+// An intrusive list of scheduled events. Delta and timed notifications are
+// constantly added to and removed from these lists, so the links live in
+// the events themselves and scheduling never allocates.
+class ScEvents
+{
+  private:
+    ScEvent *head = nullptr;
+    ScEvent *tail = nullptr;
+
+  public:
+    ScEvents() {}
+    ScEvents(const ScEvents &) = delete;
+    ScEvents &operator=(const ScEvents &) = delete;
+
+    bool empty() const { return head == nullptr; }
+    ScEvent *front() const { return head; }
+
+    // Forget the events without unlinking them, like clearing a list of
+    // pointers would.
+    void clear() { head = tail = nullptr; }
+
+    inline void push_back(ScEvent *e);
+    inline void erase(ScEvent *e);
+};
 
 class ScEvent
 {
@@ -46,9 +69,11 @@ class ScEvent
     std::function<void()> work;
     gem5::Tick _when;
     ScEvents *_events;
-    ScEvents::iterator _it;
+    ScEvent *_next;
+    ScEvent *_prev;
 
     friend class Scheduler;
+    friend class ScEvents;
 
     void
     schedule(ScEvents &events, gem5::Tick w)
@@ -57,20 +82,19 @@ class ScEvent
         assert(!scheduled());
         _events = &events;
         _events->push_back(this);
-        _it = _events->end();
-        _it--;
     }
 
     void
     deschedule()
     {
         assert(scheduled());
-        _events->erase(_it);
+        _events->erase(this);
         _events = nullptr;
     }
   public:
     ScEvent(std::function<void()> work) :
-        work(work), _when(gem5::MaxTick), _events(nullptr)
+        work(work), _when(gem5::MaxTick), _events(nullptr),
+        _next(nullptr), _prev(nullptr)
     {}
 
     ~ScEvent();
@@ -84,6 +108,32 @@ class ScEvent
     void run() { deschedule(); work(); }
 };
 
+inline void
+ScEvents::push_back(ScEvent *e)
+{
+    e->_next = nullptr;
+    e->_prev = tail;
+    if (tail)
+        tail->_next = e;
+    else
+        head = e;
+    tail = e;
+}
+
+inline void
+ScEvents::erase(ScEvent *e)
+{
+    if (e->_prev)
+        e->_prev->_next = e->_next;
+    else
+        head = e->_next;
+    if (e->_next)
+        e->_next->_prev = e->_prev;
+    else
+        tail = e->_prev;
+    e->_next = e->_prev = nullptr;
+}
+
 } // namespace sc_gem5
 
 #endif // __SYSTEMC_CORE_SCHED_EVENT_HH__
@@ -30,7 +30,6 @@
 
 #include <atomic>
 #include <functional>
-#include <list>
 #include <map>
 #include <mutex>
 #include <set>
@@ -147,8 +146,6 @@ typedef NodeList<Channel> ChannelList;
 class Scheduler
 {
   public:
-    typedef std::list<ScEvent *> ScEvents;
-
     class TimeSlot : public gem5::Event
     {
       public:
@@ -172,7 +169,8 @@ class Scheduler
 
     };
 
-    typedef std::list<TimeSlot *> TimeSlots;
+    // Pending time slots, ordered by when they're targeted to happen.
+    typedef std::map<gem5::Tick, TimeSlot *> TimeSlots;
 
     Scheduler();
     ~Scheduler();
@@ -265,14 +263,14 @@ class Scheduler
         }
 
         // Timed notification/timeout.
-        auto it = timeSlots.begin();
-        while (it != timeSlots.end() && (*it)->targeted_when < tick)
-            it++;
-        if (it == timeSlots.end() || (*it)->targeted_when != tick) {
-            it = timeSlots.emplace(it, acquireTimeSlot(tick));
-            schedule(*it, tick);
+        // All the notifications for the same tick share one time slot and
+        // therefore one gem5 event.
+        auto it = timeSlots.lower_bound(tick);
+        if (it == timeSlots.end() || it->first != tick) {
+            it = timeSlots.emplace_hint(it, tick, acquireTimeSlot(tick));
+            schedule(it->second, tick);
         }
-        event->schedule((*it)->events, tick);
+        event->schedule(it->second->events, tick);
     }
 
     // For descheduling delayed/timed notifications/timeouts.
@@ -289,15 +287,10 @@ class Scheduler
         }
 
         // Timed notification/timeout.
-        auto tsit = timeSlots.begin();
-        while (tsit != timeSlots.end() &&
-               (*tsit)->targeted_when < event->when())
-            tsit++;
-
-        panic_if(tsit == timeSlots.end() ||
-                 (*tsit)->targeted_when != event->when(),
+        auto tsit = timeSlots.find(event->when());
+        panic_if(tsit == timeSlots.end(),
                 "Descheduling event at time with no events.");
-        TimeSlot *ts = *tsit;
+        TimeSlot *ts = tsit->second;
         ScEvents &events = ts->events;
         assert(on == &events);
         event->deschedule();
@@ -312,7 +305,7 @@ class Scheduler
     void
     completeTimeSlot(TimeSlot *ts)
     {
-        assert(ts == timeSlots.front());
+        assert(ts == timeSlots.begin()->second);
         timeSlots.erase(timeSlots.begin());
         if (!runToTime && starved())
             scheduleStarvationEvent();
@@ -348,7 +341,7 @@ class Scheduler
         if (pendingCurr())
             return 0;
         if (pendingFuture())
-            return timeSlots.front()->targeted_when - getCurTick();
+            return timeSlots.begin()->first - getCurTick();
         return gem5::MaxTick - getCurTick();
     }
 
@@ -481,7 +474,7 @@ class Scheduler
         return (readyListMethods.empty() && readyListThreads.empty() &&
                 updateList.empty() && deltas.empty() &&
                 (timeSlots.empty() ||
-                 timeSlots.front()->targeted_when > maxTick) &&
+                 timeSlots.begin()->first > maxTick) &&
                 initList.empty());
     }
     gem5::MemberEventWrapper<&Scheduler::pause> starvationEvent;
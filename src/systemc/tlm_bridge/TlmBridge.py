@@ -44,6 +44,11 @@ class Gem5ToTlmBridgeBase(SystemC_ScModule):
     addr_ranges = VectorParam.AddrRange(
         [], "Addresses served by this port's TLM side"
     )
+    use_dmi = Param.Bool(
+        False,
+        "Serve atomic accesses to DMI regions granted by the TLM target "
+        "directly, without a b_transport call",
+    )
 
 
 class TlmToGem5BridgeBase(SystemC_ScModule):
@@ -55,6 +60,12 @@ class TlmToGem5BridgeBase(SystemC_ScModule):
     system = Param.System(Parent.any, "system")
 
     gem5 = RequestPort("gem5 request port")
+    sync_quantum = Param.Latency(
+        "0ns",
+        "Synchronise a temporally decoupled TLM initiator with the "
+        "SystemC kernel once its local time offset reaches this value, "
+        "0 leaves synchronisation to the initiator",
+    )
 
 
 class Gem5ToTlmBridge32(Gem5ToTlmBridgeBase):
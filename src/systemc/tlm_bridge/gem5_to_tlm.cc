@@ -291,10 +291,50 @@ Gem5ToTlmBridge<BITWIDTH>::getBackdoor(tlm::tlm_generic_payload &trans)
     backdoor->writeable(dmi_data.is_write_allowed());
 
     backdoorMap.insert(dmi_r, backdoor);
+    dmiLatencies[backdoor] = {dmi_data.get_read_latency(),
+                              dmi_data.get_write_latency()};
 
     return backdoor;
 }
 
+template <unsigned int BITWIDTH>
+bool
+Gem5ToTlmBridge<BITWIDTH>::tryDmiAccess(PacketPtr packet, Tick &latency)
+{
+    // Only plain reads and writes can be handled with a memcpy.
+    if (!useDmi || packet->isRead() == packet->isWrite() ||
+            packet->isLLSC() || packet->isAtomicOp() ||
+            packet->isMaskedWrite()) {
+        return false;
+    }
+
+    auto it = backdoorMap.contains(packet->getAddrRange());
+    if (it == backdoorMap.end())
+        return false;
+
+    MemBackdoorPtr backdoor = it->second;
+    uint8_t *ptr = backdoor->ptr() +
+        (packet->getAddr() - backdoor->range().start());
+    const auto &lat = dmiLatencies[backdoor];
+
+    if (packet->isRead()) {
+        if (!backdoor->readable())
+            return false;
+        packet->setData(ptr);
+        latency = lat.first.value();
+    } else {
+        if (!backdoor->writeable())
+            return false;
+        packet->writeData(ptr);
+        latency = lat.second.value();
+    }
+
+    if (packet->needsResponse())
+        packet->makeResponse();
+
+    return true;
+}
+
 // Similar to TLM's blocking transport (LT)
 template <unsigned int BITWIDTH>
 Tick
@@ -303,6 +343,10 @@ Gem5ToTlmBridge<BITWIDTH>::recvAtomic(PacketPtr packet)
     panic_if(packet->cacheResponding(),
              "Should not see packets where cache is responding");
 
+    Tick dmi_latency;
+    if (tryDmiAccess(packet, dmi_latency))
+        return dmi_latency;
+
     // Prepare the transaction.
     auto *trans = packet2payload(packet);
 
@@ -311,6 +355,10 @@ Gem5ToTlmBridge<BITWIDTH>::recvAtomic(PacketPtr packet)
     if (trans->get_command() != tlm::TLM_IGNORE_COMMAND) {
         // Execute b_transport:
         socket->b_transport(*trans, delay);
+        // Remember the region the target offered so that later accesses
+        // to it can skip the transaction.
+        if (useDmi && trans->is_dmi_allowed())
+            getBackdoor(*trans);
     }
 
     if (packet->needsResponse())
@@ -563,6 +611,7 @@ Gem5ToTlmBridge<BITWIDTH>::invalidate_direct_mem_ptr(
             break;
 
         it->second->invalidate();
+        dmiLatencies.erase(it->second);
         delete it->second;
         backdoorMap.erase(it);
     };
@@ -577,7 +626,8 @@ Gem5ToTlmBridge<BITWIDTH>::Gem5ToTlmBridge(
     wrapper(socket, std::string(name()) + ".tlm", InvalidPortID),
     system(params.system), blockingRequest(nullptr),
     needToSendRequestRetry(false), blockingResponse(nullptr),
-    addrRanges(params.addr_ranges.begin(), params.addr_ranges.end())
+    addrRanges(params.addr_ranges.begin(), params.addr_ranges.end()),
+    useDmi(params.use_dmi)
 {
 }
 
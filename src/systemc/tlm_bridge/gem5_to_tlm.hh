@@ -62,6 +62,7 @@
 #include <functional>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 #include "mem/backdoor.hh"
 #include "mem/port.hh"
@@ -182,6 +183,29 @@ class Gem5ToTlmBridge : public Gem5ToTlmBridgeBase
 
     gem5::AddrRangeList addrRanges;
 
+    /**
+     * Whether atomic accesses that fall into a cached DMI region are
+     * served from the DMI pointer instead of through b_transport.
+     */
+    const bool useDmi;
+
+    /**
+     * The read and write latencies the target annotated on each DMI
+     * region, charged for accesses served through the DMI pointer.
+     */
+    std::unordered_map<gem5::MemBackdoorPtr,
+        std::pair<sc_core::sc_time, sc_core::sc_time>> dmiLatencies;
+
+    /**
+     * Serve an atomic access from a cached DMI region, if there is one
+     * which covers it with the required permissions.
+     *
+     * @param packet Packet to complete.
+     * @param latency Set to the DMI latency if the access was served.
+     * @return Whether the access was served.
+     */
+    bool tryDmiAccess(gem5::PacketPtr packet, gem5::Tick &latency);
+
   protected:
     void pec(tlm::tlm_generic_payload &trans, const tlm::tlm_phase &phase);
 
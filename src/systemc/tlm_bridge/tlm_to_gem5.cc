@@ -424,6 +424,12 @@ TlmToGem5Bridge<BITWIDTH>::b_transport(tlm::tlm_generic_payload &trans,
 
     if (pkt_created)
         destroyPacket(pkt);
+
+    // Keep a loosely timed initiator from running too far ahead of gem5.
+    if (syncQuantum != sc_core::SC_ZERO_TIME && t >= syncQuantum) {
+        sc_core::wait(t);
+        t = sc_core::SC_ZERO_TIME;
+    }
 }
 
 template <unsigned int BITWIDTH>
@@ -599,6 +605,7 @@ TlmToGem5Bridge<BITWIDTH>::TlmToGem5Bridge(
     TlmToGem5BridgeBase(mn), peq(this, &TlmToGem5Bridge<BITWIDTH>::peq_cb),
     waitForRetry(false), pendingRequest(nullptr), pendingPacket(nullptr),
     needToSendRetry(false), responseInProgress(false),
+    syncQuantum(sc_core::sc_time::from_value(params.sync_quantum)),
     bmp(std::string(name()) + "master", *this), socket("tlm_socket"),
     wrapper(socket, std::string(name()) + ".tlm", InvalidPortID),
     system(params.system),
@@ -125,6 +125,13 @@ class TlmToGem5Bridge : public TlmToGem5BridgeBase
 
     std::unordered_set<gem5::MemBackdoorPtr> requestedBackdoors;
 
+    /**
+     * Local time offset at which a temporally decoupled initiator is
+     * synchronised with the SystemC kernel in b_transport. Zero leaves
+     * synchronisation entirely to the initiator.
+     */
+    const sc_core::sc_time syncQuantum;
+
     BridgeRequestPort bmp;
     tlm_utils::simple_target_socket<
         TlmToGem5Bridge<BITWIDTH>, BITWIDTH> socket;
@@ -44,8 +44,10 @@
  *  without carrying the integration cost of the fully-featured
  *  configuration system.
  *
- *  This file contains a demonstration main using CxxConfigManager.
- *  Build with something like:
+ *  This file contains a main using CxxConfigManager which runs a
+ *  config.ini written by a Python configured gem5, with checkpointing
+ *  and stats dumps but without an interpreter.  Build with something
+ *  like:
  *
  *      scons --without-python build/ARM/libgem5_opt.so
  *
@@ -58,6 +60,7 @@
 #include <sstream>
 
 #include "base/inifile.hh"
+#include "base/output.hh"
 #include "base/statistics.hh"
 #include "base/str.hh"
 #include "base/trace.hh"
@@ -93,6 +96,13 @@ usage(const std::string &prog_name)
         "    -c <from> <to> <ticks>       -- switch from cpu 'from' to cpu"
         " 'to' after\n"
         "                                    the given number of ticks\n"
+        "    -t <ticks>                   -- stop after the given number"
+        " of ticks\n"
+        "    -o <dir>                     -- write output files to dir"
+        " (default m5out)\n"
+        "    -S <file>                    -- write stats to file in the"
+        " output dir\n"
+        "                                    (default stats.txt)\n"
         "\n"
         );
 
@@ -139,8 +149,11 @@ main(int argc, char **argv)
     std::string checkpoint_dir = "";
     std::string from_cpu = "";
     std::string to_cpu = "";
+    std::string out_dir = "m5out";
+    std::string stats_file = "stats.txt";
     Tick pre_run_time = 1000000;
     Tick pre_switch_time = 1000000;
+    Tick run_time = MaxTick;
 
     try {
         while (arg_ptr < argc) {
@@ -192,6 +205,21 @@ main(int argc, char **argv)
                 to_cpu = argv[arg_ptr + 1];
                 std::istringstream(argv[arg_ptr + 2]) >> pre_switch_time;
                 arg_ptr += 3;
+            } else if (option == "-t") {
+                if (num_args < 1)
+                    usage(prog_name);
+                std::istringstream(argv[arg_ptr]) >> run_time;
+                arg_ptr++;
+            } else if (option == "-o") {
+                if (num_args < 1)
+                    usage(prog_name);
+                out_dir = argv[arg_ptr];
+                arg_ptr++;
+            } else if (option == "-S") {
+                if (num_args < 1)
+                    usage(prog_name);
+                stats_file = argv[arg_ptr];
+                arg_ptr++;
             } else {
                 usage(prog_name);
             }
@@ -207,11 +235,17 @@ main(int argc, char **argv)
         return EXIT_FAILURE;
     }
 
-    CxxConfig::statsEnable();
+    simout.setDirectory(out_dir);
     getEventQueue(0)->dump();
 
     try {
         config_manager->instantiate();
+
+        /* The stats can only be checked once they have all been
+         *  registered in instantiate */
+        CxxConfig::statsInit(*config_manager, stats_file);
+        CxxConfig::statsEnable();
+
         if (!checkpoint_restore) {
             config_manager->initState();
             config_manager->startup();
@@ -299,18 +333,21 @@ main(int argc, char **argv)
         std::cerr << "Switched CPU\n";
     }
 
-    exit_event = simulate();
+    exit_event = simulate(run_time);
 
     std::cerr << "Exit at tick " << curTick()
         << ", cause: " << exit_event->getCause() << '\n';
 
     getEventQueue(0)->dump();
 
+    CxxConfig::statsDump();
+    int exit_code = exit_event->getCode();
+
 #if TRY_CLEAN_DELETE
     config_manager->deleteObjects();
 #endif
 
     delete config_manager;
 
-    return EXIT_SUCCESS;
+    return exit_code;
 }
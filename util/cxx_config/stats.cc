@@ -38,81 +38,156 @@
 /**
  * @file
  *
- *  C++-only configuration stats handling example
+ *  C++-only configuration stats handling.  This walks the objects built
+ *  by a CxxConfigManager in the same way as the Python stats code walks
+ *  the SimObject tree, so the text stats file looks like the one from a
+ *  Python configured run.
  *
  *  Register with: gem5::statistics::registerHandlers(statsReset, statsDump)
  */
 
 #include <iostream>
 #include <list>
+#include <string>
+#include <vector>
 
+#include "base/logging.hh"
 #include "base/statistics.hh"
+#include "base/stats/text.hh"
+#include "base/str.hh"
+#include "sim/cxx_manager.hh"
+#include "sim/sim_object.hh"
 #include "stats.hh"
 
 namespace CxxConfig
 {
 
+namespace
+{
+
+gem5::CxxConfigManager *statsManager = nullptr;
+std::string statsFile = "stats.txt";
+
+/** Apply fn to the stats of a group and all of its groups */
+void
+forEachStat(const gem5::statistics::Group &group,
+    void (*fn)(gem5::statistics::Info &))
+{
+    for (auto *info : group.getStats())
+        fn(*info);
+
+    for (const auto &sub : group.getStatGroups())
+        forEachStat(*sub.second, fn);
+}
+
+/** Apply fn to the legacy stats and to the stats of all the objects */
+void
+forEachStat(void (*fn)(gem5::statistics::Info &))
+{
+    for (auto *info : gem5::statistics::statsList())
+        fn(*info);
+
+    if (statsManager) {
+        for (auto *object : statsManager->objectsInOrder)
+            forEachStat(*object, fn);
+    }
+}
+
+void
+dumpGroup(gem5::statistics::Output &output,
+    const gem5::statistics::Group &group)
+{
+    for (auto *info : group.getStats())
+        info->visit(output);
+
+    for (const auto &sub : group.getStatGroups()) {
+        output.beginGroup(sub.first.c_str());
+        dumpGroup(output, *sub.second);
+        output.endGroup();
+    }
+}
+
+} // anonymous namespace
+
+void statsInit(gem5::CxxConfigManager &manager, const std::string &file)
+{
+    statsManager = &manager;
+    statsFile = file;
+}
+
 void statsPrepare()
 {
-    std::list<gem5::statistics::Info *> stats = gem5::statistics::statsList();
+    if (statsManager) {
+        for (auto *object : statsManager->objectsInOrder)
+            object->preDumpStats();
+    }
 
     /* gather_stats -> prepare */
-    for (auto i = stats.begin(); i != stats.end(); ++i)
-        (*i)->prepare();
+    forEachStat([](gem5::statistics::Info &info) { info.prepare(); });
 }
 
 void statsDump()
 {
-    std::cerr << "Stats dump\n";
-
     gem5::statistics::processDumpQueue();
 
-    std::list<gem5::statistics::Info *> stats = gem5::statistics::statsList();
-
     statsPrepare();
 
-    /* gather_stats -> convert_value */
-    for (auto i = stats.begin(); i != stats.end(); ++i) {
-        gem5::statistics::Info *stat = *i;
-
-        gem5::statistics::ScalarInfo *scalar =
-            dynamic_cast<gem5::statistics::ScalarInfo *>(stat);
-        gem5::statistics::VectorInfo *vector =
-            dynamic_cast<gem5::statistics::VectorInfo *>(stat);
-
-        if (scalar) {
-            std::cerr << "SCALAR " << stat->name << ' '
-                << scalar->value() << '\n';
-        } else if (vector) {
-            gem5::statistics::VResult results = vector->value();
-
-            unsigned int index = 0;
-            for (auto e = results.begin(); e != results.end(); ++e) {
-                std::cerr << "VECTOR " << stat->name << '[' << index
-                    << "] " << (*e) << '\n';
-                index++;
-            }
-            std::cerr << "VTOTAL " << stat->name << ' '
-                << vector->total() << '\n';
-        } else {
-            std::cerr << "?????? " << stat->name << '\n';
+    gem5::statistics::Output *output =
+        gem5::statistics::initText(statsFile, true, true);
+
+    if (!output->valid())
+        fatal("Can't write stats to: %s\n", statsFile);
+
+    output->begin();
+
+    for (auto *info : gem5::statistics::statsList())
+        info->visit(*output);
+
+    /* The SimObjects aren't stats groups of their parents when built from
+     *  C++, so open the groups of each object's path here.  The root's
+     *  stats are at the top level, as they are in a Python configured
+     *  run */
+    if (statsManager) {
+        for (auto *object : statsManager->objectsInOrder) {
+            std::vector<std::string> path;
+            gem5::tokenize(path, object->name(), '.');
+            if (!path.empty() && path.front() == "root")
+                path.erase(path.begin());
+
+            for (const auto &name : path)
+                output->beginGroup(name.c_str());
+
+            dumpGroup(*output, *object);
+
+            for (unsigned int i = 0; i < path.size(); i++)
+                output->endGroup();
         }
     }
+
+    output->end();
 }
 
 void statsReset()
 {
-    std::cerr << "Stats reset\n";
-
     gem5::statistics::processResetQueue();
+
+    if (statsManager) {
+        for (auto *object : statsManager->objectsInOrder)
+            object->resetStats();
+    }
 }
 
 void statsEnable()
 {
-    std::list<gem5::statistics::Info *> stats = gem5::statistics::statsList();
+    forEachStat([](gem5::statistics::Info &info) {
+        if (!info.check() || !info.baseCheck()) {
+            fatal("Statistic '%s' (%d) was not properly initialized by a "
+                "regStats() function\n", info.name, info.id);
+        }
+        info.enable();
+    });
 
-    for (auto i = stats.begin(); i != stats.end(); ++i)
-        (*i)->enable();
+    gem5::statistics::enable();
 }
 
 }
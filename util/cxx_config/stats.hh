@@ -38,7 +38,7 @@
 /**
  * @file
  *
- *  C++-only configuration stats handling example
+ *  C++-only configuration stats handling
  *
  *  Register with: statistics::registerHandlers(statsReset, statsDump)
  */
@@ -46,9 +46,22 @@
 #ifndef __UTIL_CXX_CONFIG_STATS_H__
 #define __UTIL_CXX_CONFIG_STATS_H__
 
+#include <string>
+
+namespace gem5
+{
+
+class CxxConfigManager;
+
+} // namespace gem5
+
 namespace CxxConfig
 {
 
+/** Dump the stats of the objects in manager to file in the output
+ *  directory */
+void statsInit(gem5::CxxConfigManager &manager, const std::string &file);
+
 void statsDump();
 void statsReset();
 void statsEnable();
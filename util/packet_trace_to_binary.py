@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Convert a protobuf packet trace to a binary packet trace.
+
+The binary format is described in src/mem/binary_packet_trace.hh. It
+can be read by TraceGen and by the TraceCPU instruction fetch trace
+without any decoding. Gzip compressed input is detected automatically.
+The pkt_id field of the packets and the id strings of the header are
+not kept.
+
+Usage: packet_trace_to_binary.py [--index-stride N] <input> <output>
+"""
+
+import argparse
+import gzip
+import struct
+import sys
+
+PROTO_MAGIC = 0x356D6567
+BINARY_MAGIC = b"g5pkbin1"
+HEADER = struct.Struct("<8sIIQQQQIIQ")
+RECORD = struct.Struct("<QQQIIII")
+INDEX = struct.Struct("<Q")
+
+
+def open_trace(path):
+    with open(path, "rb") as f:
+        gzipped = f.read(2) == b"\x1f\x8b"
+    return gzip.open(path, "rb") if gzipped else open(path, "rb")
+
+
+def read_varint(buf, pos):
+    result = 0
+    shift = 0
+    while True:
+        byte = buf[pos]
+        pos += 1
+        result |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return result, pos
+        shift += 7
+
+
+def read_messages(stream):
+    """Yield the encoded messages of a gem5 protobuf stream."""
+    data = stream.read()
+    if len(data) < 4 or struct.unpack_from("<I", data)[0] != PROTO_MAGIC:
+        sys.exit("Not a gem5 protobuf trace")
+    pos = 4
+    while pos < len(data):
+        size, pos = read_varint(data, pos)
+        yield data[pos : pos + size]
+        pos += size
+
+
+def decode_fields(msg):
+    """Decode the varint and length-delimited fields of a message."""
+    fields = {}
+    pos = 0
+    while pos < len(msg):
+        key, pos = read_varint(msg, pos)
+        number, wire_type = key >> 3, key & 0x7
+        if wire_type == 0:
+            value, pos = read_varint(msg, pos)
+        elif wire_type == 2:
+            size, pos = read_varint(msg, pos)
+            value = msg[pos : pos + size]
+            pos += size
+        else:
+            sys.exit(f"Unexpected wire type {wire_type}")
+        fields[number] = value
+    return fields
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert a protobuf packet trace to a binary trace"
+    )
+    parser.add_argument("input", help="protobuf packet trace to read")
+    parser.add_argument("output", help="binary packet trace to write")
+    parser.add_argument(
+        "--index-stride",
+        type=int,
+        default=4096,
+        help="records per index entry, 0 for no index (default: 4096)",
+    )
+    args = parser.parse_args()
+
+    with open_trace(args.input) as stream:
+        messages = read_messages(stream)
+        header = decode_fields(next(messages))
+        tick_freq = header[3]
+
+        num = 0
+        index = []
+        with open(args.output, "wb") as out:
+            out.write(bytes(HEADER.size))
+            for msg in messages:
+                pkt = decode_fields(msg)
+                tick = pkt[1]
+                if args.index_stride and num % args.index_stride == 0:
+                    index.append(tick)
+                out.write(
+                    RECORD.pack(
+                        tick,
+                        pkt[3],
+                        pkt.get(7, 0),
+                        pkt[4],
+                        pkt[2],
+                        pkt.get(5, 0) & 0xFFFFFFFF,
+                        0,
+                    )
+                )
+                num += 1
+
+            index_offset = 0
+            if index:
+                index_offset = HEADER.size + num * RECORD.size
+                for tick in index:
+                    out.write(INDEX.pack(tick))
+
+            out.seek(0)
+            out.write(
+                HEADER.pack(
+                    BINARY_MAGIC,
+                    1,
+                    RECORD.size,
+                    tick_freq,
+                    num,
+                    HEADER.size,
+                    index_offset,
+                    args.index_stride if index else 0,
+                    0,
+                    0,
+                )
+            )
+
+    print(f"Converted {num} packets")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,69 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Account regions between work marks.
+
+m5_work_mark(id) only records the tick and instruction count of the CPU
+in <system>.work_marks.csv. This script attributes the time and the
+instructions from each mark to the next mark on the same CPU to the id
+of the first one, and prints the number of regions, total ticks and
+total instructions per id.
+
+Usage: work_marks.py [--cpu N] <system>.work_marks.csv
+"""
+
+import argparse
+import csv
+from collections import defaultdict
+
+parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+parser.add_argument("marks", help="work marks file written by gem5")
+parser.add_argument(
+    "--cpu", type=int, default=None, help="only account regions of this CPU"
+)
+args = parser.parse_args()
+
+marks = defaultdict(list)
+with open(args.marks) as f:
+    for row in csv.DictReader(f):
+        cpu = int(row["cpu"])
+        if args.cpu is None or cpu == args.cpu:
+            marks[cpu].append(
+                (int(row["tick"]), int(row["mark"]), int(row["insts"]))
+            )
+
+regions = defaultdict(lambda: [0, 0, 0])
+for cpu_marks in marks.values():
+    cpu_marks.sort()
+    for (tick, mark, insts), (next_tick, _, next_insts) in zip(
+        cpu_marks, cpu_marks[1:]
+    ):
+        region = regions[mark]
+        region[0] += 1
+        region[1] += next_tick - tick
+        region[2] += next_insts - insts
+
+row = "{:>12} {:>10} {:>16} {:>14} {:>14}"
+print(row.format("mark", "regions", "ticks", "insts", "avg ticks"))
+for mark, (count, ticks, insts) in sorted(regions.items()):
+    print(row.format(mark, count, ticks, insts, ticks // count))